@@ -27,12 +27,14 @@
 #include <migraphx/ranges.hpp>
 #include <migraphx/shape.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/replica_runner.hpp>
 #include <migraphx/onnx.hpp>
 #include <migraphx/tf.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/quantization.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/register_op.hpp>
@@ -209,6 +211,47 @@ run_async(program& p, const parameter_map& params, void* s, std::string_view nam
     return p.eval(params, exec_env);
 }
 
+std::vector<argument> run_async_with_callback(program& p,
+                                              const parameter_map& params,
+                                              void* s,
+                                              std::string_view name,
+                                              migraphx_completion_callback callback,
+                                              void* data)
+{
+    execution_environment exec_env{any_ptr(s, name), true};
+    if(callback != nullptr)
+        exec_env.on_complete = [=] { callback(data); };
+    return p.eval(params, exec_env);
+}
+
+std::vector<argument> run_with_priority(program& p, const parameter_map& params, int priority)
+{
+    execution_environment exec_env;
+    exec_env.priority = priority;
+    return p.eval(params, exec_env);
+}
+
+template <class T>
+std::vector<std::vector<argument>>
+run_many(const program& p, const T* params, std::size_t size, std::size_t depth)
+{
+    return p.eval_many(to_obj_vector(params, size), depth);
+}
+
+std::size_t memory_usage(const program& p, const char* name)
+{
+    return p.memory_report().get(name, std::size_t{0});
+}
+
+replica_runner make_replica_runner(const program& p,
+                                   const std::vector<std::size_t>& device_ids,
+                                   bool queue_depth)
+{
+    return {p,
+            device_ids,
+            queue_depth ? replica_runner::queue_depth : replica_runner::round_robin};
+}
+
 template <class Value>
 std::vector<const char*> get_names(const std::unordered_map<std::string, Value>& m)
 {
@@ -234,6 +277,16 @@ void quantize_fp16_with_op_names(program& prog, std::vector<std::string>& names)
     migraphx::quantize_fp16(prog, names);
 }
 
+void quantize_bf16_with_op_names(program& prog, std::vector<std::string>& names)
+{
+    if(names.empty())
+    {
+        names = {"all"};
+    }
+
+    migraphx::quantize_bf16(prog, names);
+}
+
 struct quantize_int8_options
 {
     std::vector<parameter_map> calibration   = {};
@@ -548,6 +601,17 @@ struct migraphx_arguments
     std::vector<migraphx::argument> object;
 };
 
+extern "C" struct migraphx_arguments_list;
+struct migraphx_arguments_list
+{
+    template <class... Ts>
+    migraphx_arguments_list(Ts&&... xs)
+        : object(std::forward<Ts>(xs)...) // NOLINT(readability-redundant-member-init)
+    {
+    }
+    std::vector<std::vector<migraphx::argument>> object;
+};
+
 extern "C" struct migraphx_shapes;
 struct migraphx_shapes
 {
@@ -614,6 +678,17 @@ struct migraphx_program
     migraphx::program object;
 };
 
+extern "C" struct migraphx_replica_runner;
+struct migraphx_replica_runner
+{
+    template <class... Ts>
+    migraphx_replica_runner(Ts&&... xs)
+        : object(std::forward<Ts>(xs)...) // NOLINT(readability-redundant-member-init)
+    {
+    }
+    migraphx::replica_runner object;
+};
+
 extern "C" struct migraphx_operation;
 struct migraphx_operation
 {
@@ -1256,6 +1331,20 @@ extern "C" migraphx_status migraphx_target_create(migraphx_target_t* target, con
     return api_error_result;
 }
 
+extern "C" migraphx_status migraphx_target_allocate_pinned(migraphx_argument_t* out,
+                                                           const_migraphx_target_t target,
+                                                           const_migraphx_shape_t s)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(target == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter target: Null pointer");
+        if(s == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter s: Null pointer");
+        *out = allocate<migraphx_argument_t>((target->object).allocate_pinned((s->object)));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status migraphx_program_parameter_shapes_destroy(
     migraphx_program_parameter_shapes_t program_parameter_shapes)
 {
@@ -1389,6 +1478,42 @@ migraphx_arguments_get(const_migraphx_argument_t* out, migraphx_arguments_t argu
     return api_error_result;
 }
 
+extern "C" migraphx_status migraphx_arguments_list_destroy(migraphx_arguments_list_t arguments_list)
+{
+    auto api_error_result = migraphx::try_([&] { destroy((arguments_list)); });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_arguments_list_assign_to(migraphx_arguments_list_t output,
+                                                             const_migraphx_arguments_list_t input)
+{
+    auto api_error_result = migraphx::try_([&] { *output = *input; });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_arguments_list_size(size_t* out,
+                                                        migraphx_arguments_list_t arguments_list)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(arguments_list == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter arguments_list: Null pointer");
+        *out = (arguments_list->object).size();
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_arguments_list_get(migraphx_arguments_t* out,
+                                                       migraphx_arguments_list_t arguments_list,
+                                                       size_t idx)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(arguments_list == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter arguments_list: Null pointer");
+        *out = object_cast<migraphx_arguments_t>(&((arguments_list->object).at((idx))));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status migraphx_shapes_destroy(migraphx_shapes_t shapes)
 {
     auto api_error_result = migraphx::try_([&] { destroy((shapes)); });
@@ -1738,6 +1863,82 @@ extern "C" migraphx_status migraphx_program_run_async(migraphx_arguments_t* out,
     return api_error_result;
 }
 
+extern "C" migraphx_status
+migraphx_program_run_async_with_callback(migraphx_arguments_t* out,
+                                         migraphx_program_t program,
+                                         migraphx_program_parameters_t params,
+                                         void* s,
+                                         const char* name,
+                                         migraphx_completion_callback callback,
+                                         void* data)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        *out = allocate<migraphx_arguments_t>(migraphx::run_async_with_callback(
+            (program->object), (params->object), (s), (name), (callback), (data)));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_program_run_with_priority(migraphx_arguments_t* out,
+                                                              migraphx_program_t program,
+                                                              migraphx_program_parameters_t params,
+                                                              int priority)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        *out = allocate<migraphx_arguments_t>(
+            migraphx::run_with_priority((program->object), (params->object), (priority)));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_run_many(migraphx_arguments_list_t* out,
+                          const_migraphx_program_t program,
+                          const const_migraphx_program_parameters_t* params,
+                          size_t size,
+                          size_t depth)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        *out = allocate<migraphx_arguments_list_t>(
+            migraphx::run_many((program->object), (params), (size), (depth)));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_bind(migraphx_program_t program, migraphx_program_parameters_t params)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        (program->object).bind((params->object));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_run_bound(migraphx_arguments_t* out, migraphx_program_t program)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        *out = object_cast<migraphx_arguments_t>(&((program->object).run_bound()));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status
 migraphx_program_equal(bool* out, const_migraphx_program_t program, const_migraphx_program_t x)
 {
@@ -1762,6 +1963,89 @@ migraphx_program_experimental_get_context(migraphx_context_t* out, const_migraph
     return api_error_result;
 }
 
+extern "C" migraphx_status migraphx_program_create_session(migraphx_program_t* out,
+                                                           const_migraphx_program_t program)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        *out = allocate<migraphx_program_t>((program->object).create_session());
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_program_memory_usage(size_t* out, const_migraphx_program_t program, const char* name)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(program == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter program: Null pointer");
+        *out = migraphx::memory_usage((program->object), (name));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_replica_runner_destroy(migraphx_replica_runner_t replica_runner)
+{
+    auto api_error_result = migraphx::try_([&] { destroy((replica_runner)); });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_replica_runner_assign_to(migraphx_replica_runner_t output,
+                                                             const_migraphx_replica_runner_t input)
+{
+    auto api_error_result = migraphx::try_([&] { *output = *input; });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_replica_runner_create(migraphx_replica_runner_t* replica_runner,
+                                                          const_migraphx_program_t p,
+                                                          size_t* device_ids,
+                                                          size_t device_ids_size,
+                                                          bool queue_depth)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(p == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter p: Null pointer");
+        if(device_ids == nullptr and device_ids_size != 0)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter device_ids: Null pointer");
+        *replica_runner = object_cast<migraphx_replica_runner_t>(
+            allocate<migraphx::replica_runner>(migraphx::make_replica_runner(
+                (p->object),
+                (std::vector<size_t>(device_ids, device_ids + device_ids_size)),
+                (queue_depth))));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_replica_runner_size(size_t* out, const_migraphx_replica_runner_t replica_runner)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(replica_runner == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter replica_runner: Null pointer");
+        *out = (replica_runner->object).size();
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status
+migraphx_replica_runner_run(migraphx_arguments_t* out,
+                            const_migraphx_replica_runner_t replica_runner,
+                            migraphx_program_parameters_t params)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(replica_runner == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param,
+                           "Bad parameter replica_runner: Null pointer");
+        if(params == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter params: Null pointer");
+        *out = allocate<migraphx_arguments_t>((replica_runner->object).run((params->object)));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status migraphx_operation_destroy(migraphx_operation_t operation)
 {
     auto api_error_result = migraphx::try_([&] { destroy((operation)); });
@@ -2199,6 +2483,29 @@ extern "C" migraphx_status migraphx_quantize_fp16(migraphx_program_t prog)
     return api_error_result;
 }
 
+extern "C" migraphx_status migraphx_quantize_bf16_with_op_names(migraphx_program_t prog,
+                                                                migraphx_quantize_op_names_t name)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(prog == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter prog: Null pointer");
+        if(name == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter name: Null pointer");
+        migraphx::quantize_bf16_with_op_names((prog->object), (name->object));
+    });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_quantize_bf16(migraphx_program_t prog)
+{
+    auto api_error_result = migraphx::try_([&] {
+        if(prog == nullptr)
+            MIGRAPHX_THROW(migraphx_status_bad_param, "Bad parameter prog: Null pointer");
+        migraphx::quantize_bf16((prog->object));
+    });
+    return api_error_result;
+}
+
 extern "C" migraphx_status
 migraphx_quantize_int8_options_destroy(migraphx_quantize_int8_options_t quantize_int8_options)
 {
@@ -2267,6 +2574,18 @@ extern "C" migraphx_status migraphx_quantize_int8(migraphx_program_t prog,
     return api_error_result;
 }
 
+extern "C" migraphx_status migraphx_get_metric(size_t* out, const char* name)
+{
+    auto api_error_result = migraphx::try_([&] { *out = migraphx::get_metric((name)); });
+    return api_error_result;
+}
+
+extern "C" migraphx_status migraphx_reset_metrics()
+{
+    auto api_error_result = migraphx::try_([&] { migraphx::reset_metrics(); });
+    return api_error_result;
+}
+
 extern "C" migraphx_status migraphx_context_finish(const_migraphx_context_t context)
 {
     auto api_error_result = migraphx::try_([&] {
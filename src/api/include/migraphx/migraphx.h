@@ -47,7 +47,8 @@
     m(uint64_type, uint64_t) \
     m(fp8e4m3fnuz_type, migraphx::fp8::fp8e4m3fnuz) \
     m(fp8e4m3fn_type, migraphx::fp8::fp8e4m3fn) \
-    m(fp8e5m2_type, migraphx::fp8::fp8e5m2)
+    m(fp8e5m2_type, migraphx::fp8::fp8e5m2) \
+    m(bf16_type, migraphx::bf16)
 // clang-format on
 
 #ifdef __cplusplus
@@ -73,6 +74,10 @@ typedef enum
 } migraphx_shape_datatype_t;
 #undef MIGRAPHX_SHAPE_GENERATE_ENUM_TYPES
 
+/// Called with the data passed to migraphx_program_run_async_with_callback once the outputs are
+/// ready. It runs on a thread of the runtime and should return quickly.
+typedef void (*migraphx_completion_callback)(void* data);
+
 typedef struct migraphx_optimals* migraphx_optimals_t;
 typedef const struct migraphx_optimals* const_migraphx_optimals_t;
 
@@ -100,6 +105,9 @@ typedef const struct migraphx_program_parameters* const_migraphx_program_paramet
 typedef struct migraphx_arguments* migraphx_arguments_t;
 typedef const struct migraphx_arguments* const_migraphx_arguments_t;
 
+typedef struct migraphx_arguments_list* migraphx_arguments_list_t;
+typedef const struct migraphx_arguments_list* const_migraphx_arguments_list_t;
+
 typedef struct migraphx_shapes* migraphx_shapes_t;
 typedef const struct migraphx_shapes* const_migraphx_shapes_t;
 
@@ -118,6 +126,9 @@ typedef const struct migraphx_module* const_migraphx_module_t;
 typedef struct migraphx_program* migraphx_program_t;
 typedef const struct migraphx_program* const_migraphx_program_t;
 
+typedef struct migraphx_replica_runner* migraphx_replica_runner_t;
+typedef const struct migraphx_replica_runner* const_migraphx_replica_runner_t;
+
 typedef struct migraphx_operation* migraphx_operation_t;
 typedef const struct migraphx_operation* const_migraphx_operation_t;
 
@@ -315,6 +326,10 @@ MIGRAPHX_C_EXPORT migraphx_status migraphx_target_assign_to(migraphx_target_t ou
 MIGRAPHX_C_EXPORT migraphx_status migraphx_target_create(migraphx_target_t* target,
                                                          const char* name);
 
+MIGRAPHX_C_EXPORT migraphx_status migraphx_target_allocate_pinned(migraphx_argument_t* out,
+                                                                  const_migraphx_target_t target,
+                                                                  const_migraphx_shape_t s);
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_program_parameter_shapes_destroy(
     migraphx_program_parameter_shapes_t program_parameter_shapes);
 
@@ -358,6 +373,18 @@ MIGRAPHX_C_EXPORT migraphx_status migraphx_arguments_get(const_migraphx_argument
                                                          migraphx_arguments_t arguments,
                                                          size_t idx);
 
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_arguments_list_destroy(migraphx_arguments_list_t arguments_list);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_arguments_list_assign_to(
+    migraphx_arguments_list_t output, const_migraphx_arguments_list_t input);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_arguments_list_size(size_t* out, migraphx_arguments_list_t arguments_list);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_arguments_list_get(
+    migraphx_arguments_t* out, migraphx_arguments_list_t arguments_list, size_t idx);
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_shapes_destroy(migraphx_shapes_t shapes);
 
 MIGRAPHX_C_EXPORT migraphx_status migraphx_shapes_assign_to(migraphx_shapes_t output,
@@ -464,6 +491,34 @@ MIGRAPHX_C_EXPORT migraphx_status migraphx_program_run_async(migraphx_arguments_
                                                              void* s,
                                                              const char* name);
 
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_program_run_async_with_callback(migraphx_arguments_t* out,
+                                         migraphx_program_t program,
+                                         migraphx_program_parameters_t params,
+                                         void* s,
+                                         const char* name,
+                                         migraphx_completion_callback callback,
+                                         void* data);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_program_run_with_priority(migraphx_arguments_t* out,
+                                   migraphx_program_t program,
+                                   migraphx_program_parameters_t params,
+                                   int priority);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_program_run_many(migraphx_arguments_list_t* out,
+                          const_migraphx_program_t program,
+                          const const_migraphx_program_parameters_t* params,
+                          size_t size,
+                          size_t depth);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_program_bind(migraphx_program_t program,
+                                                        migraphx_program_parameters_t params);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_program_run_bound(migraphx_arguments_t* out,
+                                                             migraphx_program_t program);
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_program_equal(bool* out,
                                                          const_migraphx_program_t program,
                                                          const_migraphx_program_t x);
@@ -471,6 +526,34 @@ MIGRAPHX_C_EXPORT migraphx_status migraphx_program_equal(bool* out,
 MIGRAPHX_C_EXPORT migraphx_status migraphx_program_experimental_get_context(
     migraphx_context_t* out, const_migraphx_program_t program);
 
+MIGRAPHX_C_EXPORT migraphx_status migraphx_program_create_session(migraphx_program_t* out,
+                                                                  const_migraphx_program_t program);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_program_memory_usage(size_t* out,
+                                                                const_migraphx_program_t program,
+                                                                const char* name);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_replica_runner_destroy(migraphx_replica_runner_t replica_runner);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_replica_runner_assign_to(
+    migraphx_replica_runner_t output, const_migraphx_replica_runner_t input);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_replica_runner_create(migraphx_replica_runner_t* replica_runner,
+                               const_migraphx_program_t p,
+                               size_t* device_ids,
+                               size_t device_ids_size,
+                               bool queue_depth);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_replica_runner_size(size_t* out, const_migraphx_replica_runner_t replica_runner);
+
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_replica_runner_run(migraphx_arguments_t* out,
+                            const_migraphx_replica_runner_t replica_runner,
+                            migraphx_program_parameters_t params);
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_operation_destroy(migraphx_operation_t operation);
 
 MIGRAPHX_C_EXPORT migraphx_status migraphx_operation_assign_to(migraphx_operation_t output,
@@ -602,6 +685,11 @@ migraphx_quantize_fp16_with_op_names(migraphx_program_t prog, migraphx_quantize_
 
 MIGRAPHX_C_EXPORT migraphx_status migraphx_quantize_fp16(migraphx_program_t prog);
 
+MIGRAPHX_C_EXPORT migraphx_status
+migraphx_quantize_bf16_with_op_names(migraphx_program_t prog, migraphx_quantize_op_names_t name);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_quantize_bf16(migraphx_program_t prog);
+
 MIGRAPHX_C_EXPORT migraphx_status
 migraphx_quantize_int8_options_destroy(migraphx_quantize_int8_options_t quantize_int8_options);
 
@@ -621,6 +709,10 @@ MIGRAPHX_C_EXPORT migraphx_status migraphx_quantize_int8(migraphx_program_t prog
                                                          migraphx_target_t target,
                                                          migraphx_quantize_int8_options_t options);
 
+MIGRAPHX_C_EXPORT migraphx_status migraphx_get_metric(size_t* out, const char* name);
+
+MIGRAPHX_C_EXPORT migraphx_status migraphx_reset_metrics();
+
 MIGRAPHX_C_EXPORT migraphx_status migraphx_context_finish(const_migraphx_context_t context);
 
 MIGRAPHX_C_EXPORT migraphx_status migraphx_context_get_queue(void** out,
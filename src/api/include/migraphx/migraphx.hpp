@@ -876,6 +876,14 @@ struct target : MIGRAPHX_HANDLE_BASE(target)
 
     /// Construct a target from its name
     target(const char* name) { this->make_handle(&migraphx_target_create, name); }
+
+    /// Allocate host memory that the target can copy from asynchronously
+    argument allocate_pinned(const shape& s) const
+    {
+        return {make<migraphx_argument>(
+                    &migraphx_target_allocate_pinned, this->get_handle_ptr(), s.get_handle_ptr()),
+                own{}};
+    }
 };
 
 struct program_parameter_shapes : MIGRAPHX_HANDLE_BASE(program_parameter_shapes)
@@ -956,6 +964,26 @@ struct arguments : MIGRAPHX_HANDLE_BASE(arguments), array_base<arguments>
     }
 };
 
+/// The outputs of each of the requests run by program::eval_many
+struct arguments_list : MIGRAPHX_HANDLE_BASE(arguments_list), array_base<arguments_list>
+{
+    MIGRAPHX_HANDLE_CONSTRUCTOR(arguments_list)
+
+    size_t size() const
+    {
+        size_t pout;
+        call(&migraphx_arguments_list_size, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    arguments operator[](size_t pidx) const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_arguments_list_get, &pout, this->get_handle_ptr(), pidx);
+        return {pout, this->share_handle()};
+    }
+};
+
 struct shapes : MIGRAPHX_HANDLE_BASE(shapes), array_base<shapes>
 {
     MIGRAPHX_HANDLE_CONSTRUCTOR(shapes)
@@ -1202,6 +1230,39 @@ struct program : MIGRAPHX_HANDLE_BASE(program)
         return arguments(pout, own{});
     }
 
+    /// Run the program with the priority of the queues it runs on, where a lower value is a
+    /// higher priority and 0 is the default priority
+    arguments eval(const program_parameters& pparams, int priority) const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_program_run_with_priority,
+             &pout,
+             this->get_handle_ptr(),
+             pparams.get_handle_ptr(),
+             priority);
+        return arguments(pout, own{});
+    }
+
+    /// Run each of the requests with up to depth of them running at once, so the uploads,
+    /// compute and downloads of different requests overlap, and return the outputs of each one
+    arguments_list eval_many(const std::vector<program_parameters>& requests,
+                             size_t depth = 2) const
+    {
+        std::vector<const_migraphx_program_parameters_t> handles;
+        std::transform(requests.begin(),
+                       requests.end(),
+                       std::back_inserter(handles),
+                       [](const program_parameters& pp) { return pp.get_handle_ptr(); });
+        migraphx_arguments_list_t pout;
+        call(&migraphx_program_run_many,
+             &pout,
+             this->get_handle_ptr(),
+             handles.data(),
+             handles.size(),
+             depth);
+        return arguments_list(pout, own{});
+    }
+
     template <class Stream>
     /// Overloaded to allow for execution_environment input
     arguments run_async(const program_parameters& pparams, Stream* s) const
@@ -1216,6 +1277,45 @@ struct program : MIGRAPHX_HANDLE_BASE(program)
         return arguments(pout, own{});
     }
 
+    /// Run the program asynchronously on the stream and call f on the host once the outputs are
+    /// ready, without synchronizing the stream. f runs on a thread of the runtime and should
+    /// return quickly without throwing.
+    template <class Stream, class F>
+    arguments run_async(const program_parameters& pparams, Stream* s, F f) const
+    {
+        auto data = std::make_unique<F>(std::move(f));
+        migraphx_arguments_t pout;
+        call(&migraphx_program_run_async_with_callback,
+             &pout,
+             this->get_handle_ptr(),
+             pparams.get_handle_ptr(),
+             s,
+             get_type_name<Stream>().c_str(),
+             +[](void* x) {
+                 std::unique_ptr<F> g{static_cast<F*>(x)};
+                 (*g)();
+             },
+             data.get());
+        // The callback owns it once the run is started
+        data.release(); // NOLINT(bugprone-unused-return-value)
+        return arguments(pout, own{});
+    }
+
+    /// Bind the inputs, and the output buffers passed as #output_N parameters, for run_bound
+    void bind(const program_parameters& pparams)
+    {
+        call(&migraphx_program_bind, this->get_handle_ptr(), pparams.get_handle_ptr());
+    }
+
+    /// Run the program with the bound parameters without looking them up again. The returned
+    /// arguments are owned by the program and are overwritten by the next run.
+    arguments run_bound()
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_program_run_bound, &pout, this->get_handle_ptr());
+        return arguments(pout, this->share_handle());
+    }
+
     void print() const { call(&migraphx_program_print, this->get_handle_ptr()); }
 
     program sort()
@@ -1245,6 +1345,25 @@ struct program : MIGRAPHX_HANDLE_BASE(program)
         return context{ctx, this->share_handle()};
     }
 
+    /// Create a program that shares the compiled weights but can be run
+    /// concurrently with this one
+    program create_session() const
+    {
+        return program(make<migraphx_program>(&migraphx_program_create_session,
+                                              this->get_handle_ptr()),
+                       own{});
+    }
+
+    /// Bytes of memory the compiled program uses for a category of the memory
+    /// report, such as "scratch", "literals", "code_objects", "allocations"
+    /// or "total"
+    size_t memory_usage(const std::string& name) const
+    {
+        size_t pout;
+        call(&migraphx_program_memory_usage, &pout, this->get_handle_ptr(), name.c_str());
+        return pout;
+    }
+
     module create_module(const std::string& name)
     {
         migraphx_module_t p_modu;
@@ -1255,6 +1374,39 @@ struct program : MIGRAPHX_HANDLE_BASE(program)
     friend bool operator!=(const program& px, const program& py) { return not(px == py); }
 };
 
+/// Runs copies of a compiled program on several devices, sending each call to one of them
+struct replica_runner : MIGRAPHX_HANDLE_BASE(replica_runner)
+{
+    MIGRAPHX_HANDLE_CONSTRUCTOR(replica_runner)
+
+    /// Create a replica of the compiled program for each device. The calls are sent to the
+    /// replicas in turn, or to the one with the fewest calls running when queue_depth is set.
+    replica_runner(const program& p, std::vector<size_t> device_ids, bool queue_depth = false)
+    {
+        this->make_handle(&migraphx_replica_runner_create,
+                          p.get_handle_ptr(),
+                          device_ids.data(),
+                          device_ids.size(),
+                          queue_depth);
+    }
+
+    /// Number of replicas
+    size_t size() const
+    {
+        size_t pout;
+        call(&migraphx_replica_runner_size, &pout, this->get_handle_ptr());
+        return pout;
+    }
+
+    /// Run the inputs on one of the replicas, which can be called from several threads at once
+    arguments eval(const program_parameters& pparams) const
+    {
+        migraphx_arguments_t pout;
+        call(&migraphx_replica_runner_run, &pout, this->get_handle_ptr(), pparams.get_handle_ptr());
+        return arguments(pout, own{});
+    }
+};
+
 // options for migraphx file format options
 struct file_options : MIGRAPHX_HANDLE_BASE(file_options)
 {
@@ -1484,6 +1636,18 @@ inline void quantize_fp16(const program& prog)
     call(&migraphx_quantize_fp16, prog.get_handle_ptr());
 }
 
+/// Quantize program to use bf16
+inline void quantize_bf16(const program& prog, const quantize_op_names& names)
+{
+    call(&migraphx_quantize_bf16_with_op_names, prog.get_handle_ptr(), names.get_handle_ptr());
+}
+
+/// Quantize program to use bf16
+inline void quantize_bf16(const program& prog)
+{
+    call(&migraphx_quantize_bf16, prog.get_handle_ptr());
+}
+
 /// Options to be passed when quantizing for int8
 struct quantize_int8_options : MIGRAPHX_HANDLE_BASE(quantize_int8_options)
 {
@@ -1516,6 +1680,18 @@ quantize_int8(const program& prog, const target& ptarget, const quantize_int8_op
          options.get_handle_ptr());
 }
 
+/// Get the value of a runtime metric such as "eval" or "eval_latency_us.count", which is zero
+/// when it has not been recorded
+inline size_t get_metric(const std::string& name)
+{
+    size_t result;
+    call(&migraphx_get_metric, &result, name.c_str());
+    return result;
+}
+
+/// Set all the runtime metrics back to zero
+inline void reset_metrics() { call(&migraphx_reset_metrics); }
+
 struct experimental_custom_op_base
 {
     experimental_custom_op_base()                                              = default;
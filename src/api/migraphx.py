@@ -161,6 +161,10 @@ def target(h):
     h.constructor('create',
                   api.params(name='const char*'),
                   fname='migraphx::get_target')
+    h.method('allocate_pinned',
+             api.params(s='const migraphx::shape&'),
+             const=True,
+             returns='migraphx::argument')
 
 
 @api.handle('migraphx_program_parameter_shapes',
@@ -197,6 +201,17 @@ def arguments(h):
              returns='const migraphx::argument&')
 
 
+@api.handle('migraphx_arguments_list',
+            'std::vector<std::vector<migraphx::argument>>')
+def arguments_list(h):
+    h.method('size', returns='size_t')
+    h.method('get',
+             api.params(idx='size_t'),
+             fname='at',
+             cpp_name='operator[]',
+             returns='std::vector<migraphx::argument>&')
+
+
 @api.handle('migraphx_shapes', 'std::vector<migraphx::shape>')
 def shapes(h):
     h.method('size', returns='size_t')
@@ -286,6 +301,32 @@ def program(h):
                  name='const char *'),
              invoke='migraphx::run_async($@)',
              returns='std::vector<migraphx::argument>')
+    h.method('run_async_with_callback',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>',
+                 s='void*',
+                 name='const char *',
+                 callback='migraphx_completion_callback',
+                 data='void*'),
+             invoke='migraphx::run_async_with_callback($@)',
+             returns='std::vector<migraphx::argument>')
+    h.method('run_with_priority',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>',
+                 priority='int'),
+             invoke='migraphx::run_with_priority($@)',
+             returns='std::vector<migraphx::argument>')
+    h.method('run_many',
+             api.params(params='const const_migraphx_program_parameters_t*',
+                        size='size_t',
+                        depth='size_t'),
+             invoke='migraphx::run_many($@)',
+             const=True,
+             returns='std::vector<std::vector<migraphx::argument>>')
+    h.method('bind',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>'))
+    h.method('run_bound', returns='std::vector<migraphx::argument>&')
     h.method('equal',
              api.params(x='const migraphx::program&'),
              invoke='migraphx::equal($@)',
@@ -295,6 +336,27 @@ def program(h):
              invoke='migraphx::get_context($@)',
              const=True,
              returns='migraphx::context')
+    h.method('create_session', const=True, returns='migraphx::program')
+    h.method('memory_usage',
+             api.params(name='const char*'),
+             invoke='migraphx::memory_usage($@)',
+             const=True,
+             returns='size_t')
+
+
+@auto_handle()
+def replica_runner(h):
+    h.constructor('create',
+                  api.params(p='const migraphx::program&',
+                             device_ids='std::vector<size_t>',
+                             queue_depth='bool'),
+                  fname='migraphx::make_replica_runner')
+    h.method('size', returns='size_t', const=True)
+    h.method('run',
+             api.params(
+                 params='std::unordered_map<std::string, migraphx::argument>'),
+             const=True,
+             returns='std::vector<migraphx::argument>')
 
 
 @auto_handle()
@@ -444,6 +506,15 @@ api.add_function('migraphx_quantize_fp16',
                  api.params(prog='migraphx::program&'),
                  fname='migraphx::quantize_fp16')
 
+api.add_function('migraphx_quantize_bf16_with_op_names',
+                 api.params(prog='migraphx::program&',
+                            name='std::vector<std::string>&'),
+                 fname='migraphx::quantize_bf16_with_op_names')
+
+api.add_function('migraphx_quantize_bf16',
+                 api.params(prog='migraphx::program&'),
+                 fname='migraphx::quantize_bf16')
+
 
 @auto_handle()
 def quantize_int8_options(h):
@@ -466,6 +537,13 @@ api.add_function('migraphx_quantize_int8',
                             options='migraphx::quantize_int8_options'),
                  fname='migraphx::quantize_int8_wrap')
 
+api.add_function('migraphx_get_metric',
+                 api.params(name='const char*'),
+                 fname='migraphx::get_metric',
+                 returns='size_t')
+
+api.add_function('migraphx_reset_metrics', fname='migraphx::reset_metrics')
+
 
 @auto_handle(ref=True)
 def context(h):
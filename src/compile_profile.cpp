@@ -0,0 +1,198 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_COMPILE_PROFILE)
+
+struct compile_profile
+{
+    std::atomic<bool> enabled{not string_value_of(MIGRAPHX_COMPILE_PROFILE{}).empty()};
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::mutex m;
+    std::vector<compile_span> spans;
+    std::unordered_map<std::thread::id, std::size_t> threads;
+
+    std::size_t thread_number()
+    {
+        auto id = std::this_thread::get_id();
+        auto it = threads.find(id);
+        if(it != threads.end())
+            return it->second;
+        auto n = threads.size();
+        threads.emplace(id, n);
+        return n;
+    }
+};
+
+static compile_profile& get_compile_profile_state()
+{
+    static compile_profile p;
+    return p;
+}
+
+bool compile_profile_enabled()
+{
+    return get_compile_profile_state().enabled.load(std::memory_order_relaxed);
+}
+
+void enable_compile_profile(bool b) { get_compile_profile_state().enabled = b; }
+
+compile_profile_scope::compile_profile_scope(std::string category, std::string name, value args)
+    : active(compile_profile_enabled())
+{
+    if(not active)
+        return;
+    span.category = std::move(category);
+    span.name     = std::move(name);
+    span.args     = std::move(args);
+    begin         = std::chrono::steady_clock::now();
+}
+
+compile_profile_scope::~compile_profile_scope()
+{
+    if(not active)
+        return;
+    using microseconds = std::chrono::duration<double, std::micro>;
+    auto end           = std::chrono::steady_clock::now();
+    auto& p            = get_compile_profile_state();
+    span.start         = std::chrono::duration_cast<microseconds>(begin - p.begin).count();
+    span.duration      = std::chrono::duration_cast<microseconds>(end - begin).count();
+    std::lock_guard<std::mutex> lock(p.m);
+    span.thread = p.thread_number();
+    p.spans.push_back(std::move(span));
+}
+
+void compile_profile_scope::add(const std::string& key, value v)
+{
+    if(active)
+        span.args[key] = std::move(v);
+}
+
+std::vector<compile_span> get_compile_profile()
+{
+    auto& p = get_compile_profile_state();
+    std::lock_guard<std::mutex> lock(p.m);
+    return p.spans;
+}
+
+void reset_compile_profile()
+{
+    auto& p = get_compile_profile_state();
+    std::lock_guard<std::mutex> lock(p.m);
+    p.spans.clear();
+}
+
+void write_compile_profile(std::ostream& os)
+{
+    auto spans           = get_compile_profile();
+    std::size_t nthreads = 0;
+    for(const auto& s : spans)
+        nthreads = std::max(nthreads, s.thread + 1);
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[" << std::endl;
+    for(std::size_t t = 0; t < nthreads; t++)
+    {
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << t
+           << ",\"args\":{\"name\":\"thread " << t << "\"}}";
+        if(t + 1 < nthreads or not spans.empty())
+            os << ",";
+        os << std::endl;
+    }
+    for(std::size_t i = 0; i < spans.size(); i++)
+    {
+        const auto& s = spans[i];
+        os << "{\"name\":" << to_json_string(s.name) << ",\"cat\":" << to_json_string(s.category)
+           << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << s.thread << ",\"ts\":" << s.start
+           << ",\"dur\":" << s.duration << ",\"args\":" << to_json_string(s.args) << "}";
+        if(i + 1 < spans.size())
+            os << ",";
+        os << std::endl;
+    }
+    os << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+void save_compile_profile()
+{
+    auto path = string_value_of(MIGRAPHX_COMPILE_PROFILE{});
+    if(path.empty())
+        return;
+    std::stringstream ss;
+    write_compile_profile(ss);
+    write_string(path, ss.str());
+}
+
+void print_compile_profile_summary(std::ostream& os, std::size_t top)
+{
+    auto spans = get_compile_profile();
+    struct summary
+    {
+        std::size_t count = 0;
+        double ms         = 0;
+        std::vector<const compile_span*> slowest;
+    };
+    std::map<std::string, summary> categories;
+    for(const auto& s : spans)
+    {
+        auto& c = categories[s.category];
+        c.count++;
+        c.ms += s.duration / 1000.0;
+        c.slowest.push_back(&s);
+    }
+    os << std::fixed << std::setprecision(3);
+    for(auto& [category, c] : categories)
+    {
+        os << category << ": " << c.count << " spans, " << c.ms << "ms" << std::endl;
+        auto n = std::min(top, c.slowest.size());
+        std::partial_sort(c.slowest.begin(),
+                          c.slowest.begin() + n,
+                          c.slowest.end(),
+                          [](const auto* x, const auto* y) { return x->duration > y->duration; });
+        for(std::size_t i = 0; i < n; i++)
+        {
+            const auto* s = c.slowest[i];
+            os << "    " << std::setw(12) << s->duration / 1000.0 << "ms  " << s->name;
+            if(not s->args.empty())
+                os << " " << to_json_string(s->args);
+            os << std::endl;
+        }
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
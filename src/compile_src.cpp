@@ -27,12 +27,88 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/errors.hpp>
 #include <migraphx/fileutils.hpp>
+#include <migraphx/hash.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <cassert>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+static bool is_header(const src_file& src)
+{
+    auto ext = src.path.extension().string();
+    return ext == ".hpp" or ext == ".h";
+}
+
+static void write_src(const fs::path& dir, const src_file& src)
+{
+    fs::path full_path = dir / src.path;
+    fs::create_directories(full_path.parent_path());
+    write_buffer(full_path, src.content.data(), src.content.size());
+}
+
+// Most compiles use the same headers, so they are written once to a directory that is kept for
+// the rest of the process, and linked into the directory of each compile
+struct header_dir
+{
+    std::once_flag written;
+    tmp_dir td{"headers"};
+};
+
+static std::shared_ptr<header_dir> get_header_dir(const std::vector<const src_file*>& headers)
+{
+    static std::mutex m;
+    static std::unordered_map<std::string, std::shared_ptr<header_dir>> dirs;
+    std::size_t seed = 0;
+    std::size_t size = 0;
+    for(const auto* header : headers)
+    {
+        hash_combine(seed, header->path.string());
+        hash_combine(seed, header->content);
+        size += header->content.size();
+    }
+    auto key = std::to_string(seed) + ":" + std::to_string(headers.size()) + ":" +
+               std::to_string(size);
+    std::lock_guard<std::mutex> lock(m);
+    auto& dir = dirs[key];
+    if(dir == nullptr)
+        dir = std::make_shared<header_dir>();
+    return dir;
+}
+
+static void add_headers(const fs::path& dir, const std::vector<const src_file*>& headers)
+{
+    auto hd = get_header_dir(headers);
+    std::call_once(hd->written, [&] {
+        for(const auto* header : headers)
+            write_src(hd->td.path, *header);
+    });
+    std::vector<fs::path> links;
+    std::error_code ec;
+    for(const auto& entry : fs::directory_iterator{hd->td.path})
+    {
+        auto link = dir / entry.path().filename();
+        if(fs::is_directory(entry.path()))
+            fs::create_directory_symlink(entry.path(), link, ec);
+        else
+            fs::create_symlink(entry.path(), link, ec);
+        if(ec)
+            break;
+        links.push_back(link);
+    }
+    if(not ec)
+        return;
+    // Write the headers to each compile when links can't be created
+    for(const auto& link : links)
+        fs::remove(link);
+    for(const auto* header : headers)
+        write_src(dir, *header);
+}
+
 std::vector<char> src_compiler::compile(const std::vector<src_file>& srcs) const
 {
     assert(not srcs.empty());
@@ -43,12 +119,15 @@ std::vector<char> src_compiler::compile(const std::vector<src_file>& srcs) const
 
     auto out = output;
 
+    std::vector<const src_file*> headers;
     for(const auto& src : srcs)
     {
-        fs::path full_path   = td.path / src.path;
-        fs::path parent_path = full_path.parent_path();
-        fs::create_directories(parent_path);
-        write_buffer(full_path, src.content.data(), src.content.size());
+        if(is_header(src))
+        {
+            headers.push_back(&src);
+            continue;
+        }
+        write_src(td.path, src);
         if(src.path.extension().string() == ".cpp")
         {
             params.emplace_back(src.path.filename().string());
@@ -56,6 +135,8 @@ std::vector<char> src_compiler::compile(const std::vector<src_file>& srcs) const
                 out = src.path.stem().string() + out_ext;
         }
     }
+    if(not headers.empty())
+        add_headers(td.path, headers);
 
     params.emplace_back("-o " + out);
 
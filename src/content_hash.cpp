@@ -0,0 +1,220 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/content_hash.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/thread_pool.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The hash follows the structure of xxHash3: 8 independent 64-bit lanes are updated with a
+// 32x32->64 multiply per 8 bytes, which the compiler vectorizes, and the lanes are scrambled
+// every block so bits spread across the whole input. It doesn't produce the same values as
+// xxHash3.
+constexpr std::size_t lanes             = 8;
+constexpr std::size_t stripe_bytes      = lanes * sizeof(std::uint64_t);
+constexpr std::size_t stripes_per_block = 16;
+// Fixed so the hash doesn't depend on the number of threads
+constexpr std::size_t chunk_bytes = std::size_t{4} << 20u;
+
+constexpr std::uint64_t prime32_1 = 0x9E3779B1u;
+constexpr std::uint64_t prime32_2 = 0x85EBCA77u;
+constexpr std::uint64_t prime32_3 = 0xC2B2AE3Du;
+constexpr std::uint64_t prime64_1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t prime64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t prime64_3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t prime64_4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t prime64_5 = 0x27D4EB2F165667C5ull;
+
+// Keys for the accumulate, scramble and both merges, generated with splitmix64
+static constexpr std::array<std::uint64_t, 4 * lanes> make_secret()
+{
+    std::array<std::uint64_t, 4 * lanes> result{};
+    std::uint64_t x = 0;
+    for(auto& s : result)
+    {
+        x += prime64_1;
+        auto z = x;
+        z      = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9ull;
+        z      = (z ^ (z >> 27u)) * 0x94D049BB133111EBull;
+        s      = z ^ (z >> 31u);
+    }
+    return result;
+}
+
+static constexpr auto secret = make_secret();
+
+using hash128 = std::array<std::uint64_t, 2>;
+
+static std::uint64_t mul_fold(std::uint64_t a, std::uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    auto r = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64u);
+#else
+    std::uint64_t a_lo = a & 0xffffffffu;
+    std::uint64_t a_hi = a >> 32u;
+    std::uint64_t b_lo = b & 0xffffffffu;
+    std::uint64_t b_hi = b >> 32u;
+    std::uint64_t ll   = a_lo * b_lo;
+    std::uint64_t hl   = a_hi * b_lo;
+    std::uint64_t lh   = a_lo * b_hi;
+    std::uint64_t hh   = a_hi * b_hi;
+    std::uint64_t mid  = (ll >> 32u) + (hl & 0xffffffffu) + lh;
+    std::uint64_t lo   = (mid << 32u) | (ll & 0xffffffffu);
+    std::uint64_t hi   = hh + (hl >> 32u) + (mid >> 32u);
+    return lo ^ hi;
+#endif
+}
+
+static std::uint64_t avalanche(std::uint64_t h)
+{
+    h ^= h >> 37u;
+    h *= prime64_3;
+    h ^= h >> 32u;
+    return h;
+}
+
+struct hash_state
+{
+    std::array<std::uint64_t, lanes> acc = {
+        prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1};
+
+    void accumulate(const char* p)
+    {
+        std::array<std::uint64_t, lanes> v;
+        std::memcpy(v.data(), p, stripe_bytes);
+        for(std::size_t i = 0; i < lanes; i++)
+        {
+            auto k = v[i] ^ secret[i];
+            acc[i] += v[i ^ 1u] + (k & 0xffffffffu) * (k >> 32u);
+        }
+    }
+
+    void scramble()
+    {
+        for(std::size_t i = 0; i < lanes; i++)
+        {
+            acc[i] ^= acc[i] >> 47u;
+            acc[i] ^= secret[lanes + i];
+            acc[i] *= prime32_1;
+        }
+    }
+
+    std::uint64_t merge(std::size_t offset, std::uint64_t start) const
+    {
+        std::uint64_t result = start;
+        for(std::size_t i = 0; i < lanes; i += 2)
+            result += mul_fold(acc[i] ^ secret[offset + i], acc[i + 1] ^ secret[offset + i + 1]);
+        return avalanche(result);
+    }
+};
+
+static hash128 hash_block(const char* data, std::size_t n, std::uint64_t seed)
+{
+    hash_state s;
+    constexpr std::size_t block_bytes = stripe_bytes * stripes_per_block;
+    std::size_t nblocks               = n / block_bytes;
+    for(std::size_t b = 0; b < nblocks; b++)
+    {
+        for(std::size_t i = 0; i < stripes_per_block; i++)
+            s.accumulate(data + b * block_bytes + i * stripe_bytes);
+        s.scramble();
+    }
+    std::size_t nstripes = n / stripe_bytes;
+    for(std::size_t i = nblocks * stripes_per_block; i < nstripes; i++)
+        s.accumulate(data + i * stripe_bytes);
+    // The tail is padded with zeros, which can't collide with a longer input since the length
+    // is mixed into the result
+    std::size_t tail = n % stripe_bytes;
+    if(tail != 0)
+    {
+        std::array<char, stripe_bytes> last{};
+        std::memcpy(last.data(), data + nstripes * stripe_bytes, tail);
+        s.accumulate(last.data());
+    }
+    return {s.merge(2 * lanes, n * prime64_1 + seed), s.merge(3 * lanes, ~n * prime64_2 + seed)};
+}
+
+std::string content_hash(const char* data, std::size_t n)
+{
+    hash128 h;
+    if(n <= chunk_bytes)
+    {
+        h = hash_block(data, n, 0);
+    }
+    else
+    {
+        // Large buffers are hashed as a tree of chunks, with a different seed at the root so it
+        // can't collide with a buffer holding the chunk hashes
+        std::size_t nchunks = (n + chunk_bytes - 1) / chunk_bytes;
+        std::vector<hash128> chunks(nchunks);
+        get_thread_pool().run(nchunks, [&](std::size_t i) {
+            auto start = i * chunk_bytes;
+            chunks[i]  = hash_block(data + start, std::min(chunk_bytes, n - start), 0);
+        });
+        h = hash_block(reinterpret_cast<const char*>(chunks.data()),
+                       chunks.size() * sizeof(hash128),
+                       prime64_4);
+    }
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << h[0] << std::setw(16) << h[1];
+    return ss.str();
+}
+
+std::string content_hash(const argument& a)
+{
+    auto subs = a.get_sub_objects();
+    if(subs.empty())
+        return content_hash(a.data(), a.get_shape().bytes());
+    std::string hashes;
+    for(const auto& sub : subs)
+        hashes += content_hash(sub);
+    return content_hash(hashes.data(), hashes.size());
+}
+
+void compute_content_hashes(const std::vector<literal>& lits)
+{
+    // Nested runs on the thread pool are serial, so the large literals are hashed one at a time
+    // with their chunks in parallel
+    std::vector<const literal*> small;
+    for(const auto& l : lits)
+    {
+        if(l.get_shape().bytes() > chunk_bytes)
+            l.content_hash();
+        else
+            small.push_back(&l);
+    }
+    get_thread_pool().run(small.size(), [&](std::size_t i) { small[i]->content_hash(); });
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
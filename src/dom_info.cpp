@@ -96,5 +96,10 @@ dominator_info compute_dominator(const module& m)
     return compute_dominator_generic(module_visitor{&m});
 }
 
+std::shared_ptr<const dominator_info> get_dominator_info(const module& m)
+{
+    return m.get_analysis<dominator_info>(&compute_dominator);
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
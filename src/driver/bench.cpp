@@ -0,0 +1,182 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "bench.hpp"
+
+#include <migraphx/errors.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/serialize.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+using bench_clock = std::chrono::steady_clock;
+
+std::string bench_result::key() const
+{
+    return model + ":" + std::to_string(batch) + ":" + precision;
+}
+
+std::vector<bench_model> read_bench_manifest(const std::string& file)
+{
+    auto v = from_json_string(read_string(file));
+    if(not v.contains("models"))
+        MIGRAPHX_THROW("Benchmark manifest has no models: " + file);
+    auto models = from_value<std::vector<bench_model>>(v.at("models"));
+    for(auto& m : models)
+    {
+        if(m.file.empty())
+            MIGRAPHX_THROW("Benchmark manifest has a model without a file: " + file);
+        if(m.name.empty())
+            m.name = m.file;
+    }
+    return models;
+}
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    auto i = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+void time_runs(program& p, const parameter_map& m, std::size_t n, bench_result& r)
+{
+    // Warm up
+    p.eval(m);
+    p.finish();
+    std::vector<double> times;
+    times.reserve(n);
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto start = bench_clock::now();
+        p.eval(m);
+        p.finish();
+        times.push_back(
+            std::chrono::duration<double, std::milli>(bench_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    r.p50_ms = percentile(times, 0.5);
+    r.p99_ms = percentile(times, 0.99);
+
+    auto start = bench_clock::now();
+    for(std::size_t i = 0; i < n; i++)
+        p.eval(m);
+    p.finish();
+    auto total = std::chrono::duration<double>(bench_clock::now() - start).count();
+    r.throughput = total > 0 ? double(n * r.batch) / total : 0;
+}
+
+std::size_t program_memory(const program& p)
+{
+    std::size_t result = 0;
+    for(const auto* mod : p.get_modules())
+    {
+        for(auto ins : iterator_for(*mod))
+        {
+            if(contains({"@literal", "hip::hip_allocate_memory", "hip::hip_copy_literal"},
+                        ins->name()))
+                result += ins->get_shape().bytes();
+        }
+    }
+    return result;
+}
+
+void write_bench_results(const std::vector<bench_result>& results, const std::string& file)
+{
+    value v;
+    v["results"] = to_value(results);
+    write_string(file, to_pretty_json_string(v));
+}
+
+std::vector<bench_result> read_bench_results(const std::string& file)
+{
+    auto v = from_json_string(read_string(file));
+    return from_value<std::vector<bench_result>>(v.at("results"));
+}
+
+void print_bench_results(const std::vector<bench_result>& results, std::ostream& os)
+{
+    os << std::left << std::setw(32) << "Model" << std::right << std::setw(7) << "Batch"
+       << std::setw(10) << "Precision" << std::setw(12) << "Load (ms)" << std::setw(14)
+       << "Compile (ms)" << std::setw(10) << "p50 (ms)" << std::setw(10) << "p99 (ms)"
+       << std::setw(14) << "Inferences/s" << std::setw(14) << "Memory (MB)" << std::endl;
+    for(const auto& r : results)
+    {
+        os << std::left << std::setw(32) << r.model << std::right << std::setw(7) << r.batch
+           << std::setw(10) << r.precision << std::fixed << std::setprecision(1)
+           << std::setw(12) << r.load_ms << std::setw(14) << r.compile_ms
+           << std::setprecision(3) << std::setw(10) << r.p50_ms << std::setw(10) << r.p99_ms
+           << std::setprecision(1) << std::setw(14) << r.throughput << std::setw(14)
+           << r.memory / (1024.0 * 1024.0) << std::endl;
+    }
+}
+
+std::vector<std::string> compare_bench(const std::vector<bench_result>& baseline,
+                                       const std::vector<bench_result>& results,
+                                       const bench_thresholds& t)
+{
+    std::unordered_map<std::string, const bench_result*> base;
+    for(const auto& r : baseline)
+        base[r.key()] = &r;
+    std::vector<std::string> regressions;
+    // Reports a measurement that moved from y to x by more than the limit in the worse direction
+    auto check = [&](const bench_result& r, const char* what, double x, double y, double limit) {
+        if(y == 0 or (limit >= 0 ? x <= y * (1 + limit) : x >= y * (1 + limit)))
+            return;
+        std::stringstream ss;
+        ss << r.key() << " " << what << ": " << y << " -> " << x << " (" << std::showpos
+           << std::setprecision(3) << 100 * (x - y) / y << "%)";
+        regressions.push_back(ss.str());
+    };
+    for(const auto& r : results)
+    {
+        auto it = base.find(r.key());
+        if(it == base.end())
+            continue;
+        const auto& b = *it->second;
+        check(r, "p50_ms", r.p50_ms, b.p50_ms, t.latency);
+        check(r, "p99_ms", r.p99_ms, b.p99_ms, t.latency);
+        check(r, "compile_ms", r.compile_ms, b.compile_ms, t.compile);
+        check(r, "memory", r.memory, b.memory, t.memory);
+        // Lower throughput is worse
+        check(r, "throughput", r.throughput, b.throughput, -t.throughput);
+    }
+    return regressions;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
@@ -0,0 +1,124 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_RTGLIB_DRIVER_BENCH_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DRIVER_BENCH_HPP
+
+#include <migraphx/program.hpp>
+#include <migraphx/reflect.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// One model of a benchmark manifest, run at each batch size and precision
+struct bench_model
+{
+    std::string name;
+    std::string file;
+    std::vector<std::size_t> batch_sizes = {1};
+    std::vector<std::string> precisions  = {"fp32"};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.name, "name"),
+                    f(self.file, "file"),
+                    f(self.batch_sizes, "batch_sizes"),
+                    f(self.precisions, "precisions"));
+    }
+};
+
+struct bench_result
+{
+    std::string model;
+    std::size_t batch = 1;
+    std::string precision;
+    double load_ms    = 0;
+    double compile_ms = 0;
+    double p50_ms     = 0;
+    double p99_ms     = 0;
+    // Inferences per second when runs are issued back to back
+    double throughput = 0;
+    // Bytes of the weights and preallocated buffers the compiled program holds
+    std::size_t memory = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.model, "model"),
+                    f(self.batch, "batch"),
+                    f(self.precision, "precision"),
+                    f(self.load_ms, "load_ms"),
+                    f(self.compile_ms, "compile_ms"),
+                    f(self.p50_ms, "p50_ms"),
+                    f(self.p99_ms, "p99_ms"),
+                    f(self.throughput, "throughput"),
+                    f(self.memory, "memory"));
+    }
+
+    std::string key() const;
+};
+
+/// Relative slowdowns, and growth for memory, tolerated when comparing with a baseline
+struct bench_thresholds
+{
+    double latency    = 0.05;
+    double throughput = 0.05;
+    double compile    = 0.25;
+    double memory     = 0.05;
+};
+
+std::vector<bench_model> read_bench_manifest(const std::string& file);
+
+/**
+ * @brief Time n runs of a compiled program one at a time for the latency percentiles, then n
+ * runs back to back for the throughput.
+ */
+void time_runs(program& p, const parameter_map& m, std::size_t n, bench_result& r);
+
+/// Bytes of the literals and preallocated buffers held by a compiled program
+std::size_t program_memory(const program& p);
+
+void write_bench_results(const std::vector<bench_result>& results, const std::string& file);
+std::vector<bench_result> read_bench_results(const std::string& file);
+
+void print_bench_results(const std::vector<bench_result>& results, std::ostream& os);
+
+/**
+ * @brief Compare results with a baseline from another build and return a description of each
+ * measurement that got worse by more than the thresholds. Results without a baseline are
+ * skipped.
+ */
+std::vector<std::string> compare_bench(const std::vector<bench_result>& baseline,
+                                       const std::vector<bench_result>& results,
+                                       const bench_thresholds& t);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
@@ -25,10 +25,13 @@
 #include "verify.hpp"
 #include "verify_options.hpp"
 #include "argument_parser.hpp"
+#include "bench.hpp"
 #include "command.hpp"
 #include "precision.hpp"
 #include "passes.hpp"
 #include "perf.hpp"
+#include "serve.hpp"
+#include "tune.hpp"
 #include "models.hpp"
 #include "marker_roctx.hpp"
 
@@ -43,6 +46,7 @@
 #include <migraphx/json.hpp>
 #include <migraphx/version.h>
 
+#include <migraphx/compile_profile.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
@@ -55,7 +59,10 @@
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/register_target.hpp>
 
+#include <chrono>
 #include <fstream>
+#include <iomanip>
+#include <map>
 
 namespace migraphx {
 namespace driver {
@@ -81,6 +88,7 @@ struct loader
     bool brief                  = false;
     std::string output_type;
     std::string output;
+    std::string compression = "none";
     std::string default_dyn_dim;
     std::vector<std::string> param_dims;
     std::vector<std::string> dim_params;
@@ -163,6 +171,13 @@ struct loader
            {"--binary"},
            ap.help("Print out program in binary format."),
            ap.set_value("binary"));
+        ap(output_type,
+           {"--chunked"},
+           ap.help("Print out program in the chunked binary format."),
+           ap.set_value("chunked"));
+        ap(compression,
+           {"--compression"},
+           ap.help("Compression used for the chunks of the chunked format (none or zstd)."));
         ap(output, {"--output", "-o"}, ap.help("Output to file."));
     }
 
@@ -413,6 +428,13 @@ struct loader
             *os << to_json_string(p.to_value()) << std::endl;
         else if(type == "binary")
             write(*os, save_buffer(p));
+        else if(type == "chunked")
+        {
+            file_options options;
+            options.format      = "chunked";
+            options.compression = compression;
+            write(*os, save_buffer(p, options));
+        }
     }
 };
 
@@ -426,7 +448,8 @@ struct program_params
         ap(fill1, {"--fill1"}, ap.help("Fill parameter with 1s"), ap.append(), ap.nargs(2));
     }
 
-    auto generate(const program& p, const target& t, bool offload, unsigned batch)
+    auto generate(
+        const program& p, const target& t, bool offload, unsigned batch, std::size_t session = 0)
     {
         parameter_map m;
         auto param_shapes = p.get_parameter_shapes();
@@ -440,7 +463,7 @@ struct program_params
             m[s] = fill_argument(static_param_shapes.at(s), 0);
         for(auto&& s : fill1)
             m[s] = fill_argument(static_param_shapes.at(s), 1);
-        fill_param_map(m, static_param_shapes, t, offload);
+        fill_param_map(m, static_param_shapes, t, offload, session);
         return m;
     }
 };
@@ -470,6 +493,37 @@ struct compiler_target
     target get_target() const { return make_target(target_name); }
 };
 
+// Sums the stats of each pass over every module and call
+static void print_pass_stats(std::ostream& os, const std::vector<pass_stats>& stats)
+{
+    struct summary
+    {
+        std::size_t calls    = 0;
+        double ms            = 0;
+        std::ptrdiff_t delta = 0;
+    };
+    std::map<std::string, summary> passes;
+    for(const auto& ps : stats)
+    {
+        auto& s = passes[ps.name];
+        s.calls++;
+        s.ms += ps.ms;
+        s.delta += std::ptrdiff_t(ps.instructions_after) - std::ptrdiff_t(ps.instructions_before);
+    }
+    std::vector<std::pair<std::string, summary>> sorted(passes.begin(), passes.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& x, const auto& y) {
+        return x.second.ms > y.second.ms;
+    });
+    os << std::left << std::setw(40) << "Pass" << std::right << std::setw(8) << "Calls"
+       << std::setw(14) << "Time (ms)" << std::setw(16) << "Instructions" << std::endl;
+    for(const auto& [name, s] : sorted)
+    {
+        os << std::left << std::setw(40) << name << std::right << std::setw(8) << s.calls
+           << std::setw(14) << std::fixed << std::setprecision(3) << s.ms << std::setw(16)
+           << std::showpos << s.delta << std::noshowpos << std::endl;
+    }
+}
+
 struct compiler
 {
     loader l;
@@ -477,9 +531,15 @@ struct compiler
     compiler_target ct;
     compile_options co;
     bool to_fp16 = false;
+    bool to_bf16 = false;
     bool to_fp8  = false;
     bool to_int8 = false;
     bool to_int4 = false;
+    quantize_8bits_options qo;
+    std::string calibration = "max";
+    std::string reuse_compiled;
+    bool show_pass_stats      = false;
+    bool show_compile_profile = false;
 
     std::vector<std::string> fill0;
     std::vector<std::string> fill1;
@@ -500,10 +560,68 @@ struct compiler
            {"--exhaustive-tune"},
            ap.help("Exhastively search for best tuning parameters for kernels"),
            ap.set_value(true));
+        ap(co.background_tune,
+           {"--background-tune"},
+           ap.help("Tune the kernels in the background while the program runs"),
+           ap.set_value(true));
+        ap(co.lazy_compile,
+           {"--lazy-compile"},
+           ap.help("Compile the kernels of control flow branches the first time they run"),
+           ap.set_value(true));
+        ap(co.capture_graph,
+           {"--capture-graph"},
+           ap.help("Capture the program into a graph that is replayed on each run"),
+           ap.set_value(true));
+        ap(co.record_weights,
+           {"--record-weights"},
+           ap.help("Record where the weights end up so they can be replaced without recompiling"),
+           ap.set_value(true));
+        ap(co.memory_budget,
+           {"--memory-budget"},
+           ap.help("Recompute cheap activations to keep the peak memory under this many bytes"));
+        ap(co.weight_budget,
+           {"--weight-budget"},
+           ap.help("Keep at most this many bytes of weights on the device and stream the rest"));
+        ap(co.checkpoint_pass,
+           {"--checkpoint-pass"},
+           ap.help("Save the program to --checkpoint after the first pass with this name"));
+        ap(co.checkpoint_file, {"--checkpoint"}, ap.help("File to save the checkpoint to"));
+        ap(co.resume_pass,
+           {"--resume-pass"},
+           ap.help("Skip the passes up to this one for a program loaded from a checkpoint"));
+        ap(reuse_compiled,
+           {"--reuse-compiled"},
+           ap.help("Reuse a program compiled with --record-weights when only the weights changed"));
+        ap(show_pass_stats,
+           {"--pass-stats"},
+           ap.help("Print the time and instruction count change of each compile pass"),
+           ap.set_value(true));
+        ap(show_compile_profile,
+           {"--compile-profile"},
+           ap.help("Print where compile time went by pass, kernel compile and benchmark"),
+           ap.set_value(true));
         ap(to_fp16, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(true));
+        ap(to_bf16, {"--bf16"}, ap.help("Quantize for bf16"), ap.set_value(true));
         ap(to_int8, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(true));
         ap(to_fp8, {"--fp8"}, ap.help("Quantize for fp8"), ap.set_value(true));
         ap(to_int4, {"--int4-weights"}, ap.help("Quantize weights for int4"), ap.set_value(true));
+        ap(calibration,
+           {"--calibration"},
+           ap.help("Pick the int8 and fp8 scales with max, percentile or entropy calibration"));
+        ap(qo.percentile,
+           {"--percentile"},
+           ap.help("Percent of the values kept in range with percentile calibration"));
+        ap(qo.per_channel,
+           {"--per-channel"},
+           ap.help("Quantize weights with one int8 or fp8 scale per output channel"),
+           ap.set_value(true));
+        ap(qo.group_size,
+           {"--group-size"},
+           ap.help("Quantize dot weights with one int8 or fp8 scale per group of rows"));
+        ap(qo.smooth_alpha,
+           {"--smooth-alpha"},
+           ap.help("Move activation outliers of dots into their weights before int8 or fp8 "
+                   "quantization, with this migration strength (SmoothQuant)"));
     }
 
     auto params(const program& p)
@@ -516,6 +634,33 @@ struct compiler
         return parameters.generate(p, ct.get_target(), true, l.batch);
     }
 
+    void quantize(program& p)
+    {
+        auto t = ct.get_target();
+        if(to_fp16)
+        {
+            quantize_fp16(p);
+        }
+        if(to_bf16)
+        {
+            quantize_bf16(p);
+        }
+        if(to_int8)
+        {
+            qo.calibration = to_calibration_mode(calibration);
+            quantize_int8(p, t, {host_params(p)}, {"dot", "convolution"}, qo);
+        }
+        if(to_fp8)
+        {
+            qo.calibration = to_calibration_mode(calibration);
+            quantize_fp8(p, t, {host_params(p)}, qo);
+        }
+        if(to_int4)
+        {
+            quantize_int4_weights(p);
+        }
+    }
+
     program compile()
     {
         auto p = l.load();
@@ -546,23 +691,28 @@ struct compiler
             return p;
         }
         auto t = ct.get_target();
-        if(to_fp16)
-        {
-            quantize_fp16(p);
-        }
-        if(to_int8)
-        {
-            quantize_int8(p, t, {host_params(p)});
-        }
-        if(to_fp8)
+        quantize(p);
+        if(not reuse_compiled.empty())
         {
-            quantize_fp8(p, t, {host_params(p)});
-        }
-        if(to_int4)
-        {
-            quantize_int4_weights(p);
+            auto compiled = migraphx::load(reuse_compiled);
+            if(compiled.update_weights(p))
+            {
+                l.save(compiled);
+                return compiled;
+            }
+            std::cout << "[WARNING]: " << reuse_compiled
+                      << " can't be reused with the weights of this model, compiling it.\n";
+            co.record_weights = true;
         }
+        if(show_pass_stats)
+            co.trace.record_pass_stats();
+        if(show_compile_profile)
+            enable_compile_profile();
         p.compile(t, co);
+        if(show_pass_stats)
+            print_pass_stats(std::cout, co.trace.get_pass_stats());
+        if(show_compile_profile)
+            print_compile_profile_summary(std::cout);
         l.save(p);
         return p;
     }
@@ -601,6 +751,7 @@ struct verify : command<verify>
     std::optional<double> rtol;
     bool per_instruction = false;
     bool reduce          = false;
+    bool bisect          = false;
     verify_options vo;
     void parse(argument_parser& ap)
     {
@@ -613,6 +764,10 @@ struct verify : command<verify>
            ap.help("Verify each instruction"),
            ap.set_value(true));
         ap(reduce, {"-r", "--reduce"}, ap.help("Reduce program and verify"), ap.set_value(true));
+        ap(bisect,
+           {"-b", "--bisect"},
+           ap.help("Bisect the program to find the first instruction that fails to verify"),
+           ap.set_value(true));
         ap(vo.ref_use_double,
            {"--ref-use-double"},
            ap.help("Convert floating point values to double on ref"),
@@ -632,6 +787,10 @@ struct verify : command<verify>
         {
             vo.quantize = precision::fp16;
         }
+        if(c.to_bf16)
+        {
+            vo.quantize = precision::bf16;
+        }
         if(c.to_int8)
         {
             vo.quantize = precision::int8;
@@ -650,6 +809,10 @@ struct verify : command<verify>
         {
             verify_reduced_program(p, t, c.co, vo, m, tols);
         }
+        else if(bisect)
+        {
+            verify_bisect_program(p, t, c.co, vo, m, tols);
+        }
         else
         {
             verify_program(c.l.file, p, t, c.co, vo, m, tols);
@@ -682,14 +845,19 @@ struct run_cmd : command<run_cmd>
         auto m = c.params(p);
         p.eval(m);
         std::cout << p << std::endl;
+        p.print_trace(std::cout);
     }
 };
 
 struct perf : command<perf>
 {
     compiler c;
-    unsigned n    = 100;
-    bool detailed = false;
+    unsigned n              = 100;
+    bool detailed           = false;
+    std::size_t concurrency = 1;
+    std::size_t instances   = 1;
+    bool memory             = false;
+    std::string timeline;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
@@ -698,16 +866,285 @@ struct perf : command<perf>
            {"--detailed", "-d"},
            ap.help("Show a more detailed summary report"),
            ap.set_value(true));
+        ap(timeline,
+           {"--timeline"},
+           ap.help("Write a Chrome trace of a single run, timed with gpu events, to this file"));
+        ap(concurrency,
+           {"--concurrency"},
+           ap.help("Number of requests in flight on each instance, which reports the throughput "
+                   "instead of the per instruction summary"));
+        ap(instances,
+           {"--instances"},
+           ap.help("Number of separately compiled instances of the program sharing the device"));
+        ap(memory,
+           {"--memory"},
+           ap.help("Print how much memory the compiled program uses on the device"),
+           ap.set_value(true));
+    }
+
+    void run_throughput(const program& p)
+    {
+        std::vector<program> progs = {p};
+        while(progs.size() < instances)
+        {
+            std::cout << "Compiling instance " << progs.size() << " ... " << std::endl;
+            progs.push_back(c.compile());
+        }
+        auto t = c.ct.get_target();
+        throughput_options options;
+        options.iterations  = n;
+        options.concurrency = concurrency;
+        options.batch       = c.l.batch;
+        std::cout << "Running throughput report ... " << std::endl;
+        throughput(
+            progs,
+            [&](const program& prog, std::size_t session) {
+                return c.parameters.generate(prog, t, c.co.offload_copy, c.l.batch, session);
+            },
+            options,
+            std::cout);
     }
 
     void run()
     {
         std::cout << "Compiling ... " << std::endl;
         auto p = c.compile();
+        if(memory)
+            print_memory_report(p, std::cout);
+        if(concurrency > 1 or instances > 1)
+        {
+            run_throughput(p);
+            return;
+        }
         std::cout << "Allocating params ... " << std::endl;
         auto m = c.params(p);
         std::cout << "Running performance report ... " << std::endl;
         p.perf_report(std::cout, n, m, c.l.batch, detailed);
+        if(not timeline.empty())
+        {
+            std::cout << "Recording timeline ... " << std::endl;
+            write_timeline(p, m, timeline, std::cout);
+        }
+    }
+};
+
+struct tune : command<tune>
+{
+    compiler c;
+    std::string export_file;
+    std::string import_file;
+    void parse(argument_parser& ap)
+    {
+        c.parse(ap);
+        ap(export_file,
+           {"--export"},
+           ap.help("Tune the model exhaustively and add the results to this tuning bundle"));
+        ap(import_file,
+           {"--import"},
+           ap.help("Add the results for this gpu from a tuning bundle to the problem cache and "
+                   "MLIR tuning db"));
+    }
+
+    void run()
+    {
+        if(not import_file.empty())
+        {
+            import_tuning(import_file, std::cout);
+            return;
+        }
+        if(export_file.empty())
+            MIGRAPHX_THROW("Either --export or --import is required");
+        c.co.exhaustive_tune = true;
+        std::cout << "Tuning ... " << std::endl;
+        auto p = c.compile();
+        export_tuning(p, export_file, std::cout);
+    }
+};
+
+struct serve_cmd : command<serve_cmd>
+{
+    compiler c;
+    serve_options options;
+    std::vector<std::size_t> batch_sizes;
+    void parse(argument_parser& ap)
+    {
+        c.parse(ap);
+        ap(options.requests, {"--requests", "-n"}, ap.help("Number of requests to send"));
+        ap(options.clients, {"--clients"}, ap.help("Number of client threads sending requests"));
+        ap(options.rate,
+           {"--rate"},
+           ap.help("Total requests per second, or 0 to send requests back to back"));
+        ap(options.max_delay_ms,
+           {"--max-delay"},
+           ap.help("Milliseconds a request can wait for its batch to fill"));
+        ap(batch_sizes,
+           {"--batch-sizes"},
+           ap.help("Batch sizes to run, defaults to the compiled batch size or to the optimal "
+                   "sizes of a dynamic batch"),
+           ap.append());
+    }
+
+    // Batch sizes the compiled program can run without recompiling
+    std::vector<std::size_t> default_batch_sizes(const program& p) const
+    {
+        for(auto&& [name, s] : p.get_parameter_shapes())
+        {
+            if(not s.dynamic() or s.dyn_dims().empty() or s.dyn_dims().front().is_fixed())
+                continue;
+            const auto& dd = s.dyn_dims().front();
+            std::vector<std::size_t> result;
+            std::copy_if(dd.optimals.begin(),
+                         dd.optimals.end(),
+                         std::back_inserter(result),
+                         [&](auto x) { return x >= dd.min and x < dd.max; });
+            if(result.empty())
+            {
+                result.resize(dd.max - dd.min);
+                std::iota(result.begin(), result.end(), dd.min);
+            }
+            result.push_back(dd.max);
+            return result;
+        }
+        return {c.l.batch};
+    }
+
+    void run()
+    {
+        std::cout << "Compiling ... " << std::endl;
+        auto p = c.compile();
+        if(batch_sizes.empty())
+            batch_sizes = default_batch_sizes(p);
+        std::cout << "Allocating params ... " << std::endl;
+        auto t = c.ct.get_target();
+        std::cout << "Serving ... " << std::endl;
+        serve(
+            p,
+            batch_sizes,
+            [&](std::size_t batch) {
+                return c.parameters.generate(p, t, c.co.offload_copy, batch);
+            },
+            options,
+            std::cout);
+    }
+};
+
+struct bench : command<bench>
+{
+    std::string manifest;
+    compiler_target ct;
+    compile_options co;
+    unsigned n = 100;
+    std::string output;
+    std::string baseline;
+    bench_thresholds thresholds;
+    void parse(argument_parser& ap)
+    {
+        ap(manifest,
+           {},
+           ap.metavar("<manifest file>"),
+           ap.help("JSON file with the models to run, and the batch sizes and precisions for each"),
+           ap.file_exist(),
+           ap.required());
+        ct.parse(ap);
+        ap(co.offload_copy,
+           {"--enable-offload-copy"},
+           ap.help("Enable implicit offload copying"),
+           ap.set_value(true));
+        ap(co.fast_math,
+           {"--disable-fast-math"},
+           ap.help("Disable fast math optimization"),
+           ap.set_value(false));
+        ap(co.exhaustive_tune,
+           {"--exhaustive-tune"},
+           ap.help("Exhastively search for best tuning parameters for kernels"),
+           ap.set_value(true));
+        ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to time for each run"));
+        ap(output, {"--output", "-o"}, ap.help("Write the results as JSON to this file"));
+        ap(baseline,
+           {"--baseline"},
+           ap.help("Fail when the results regress from the JSON results of another build"));
+        ap(thresholds.latency,
+           {"--latency-threshold"},
+           ap.help("Fraction the p50 and p99 latency can grow over the baseline"));
+        ap(thresholds.throughput,
+           {"--throughput-threshold"},
+           ap.help("Fraction the throughput can drop under the baseline"));
+        ap(thresholds.compile,
+           {"--compile-threshold"},
+           ap.help("Fraction the compile time can grow over the baseline"));
+        ap(thresholds.memory,
+           {"--memory-threshold"},
+           ap.help("Fraction the memory can grow over the baseline"));
+    }
+
+    static double ms_since(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                         start)
+            .count();
+    }
+
+    bench_result
+    run_model(const bench_model& model, std::size_t batch, const std::string& precision) const
+    {
+        compiler c;
+        c.ct      = ct;
+        c.co      = co;
+        c.l.file  = model.file;
+        c.l.batch = batch;
+        if(precision == "fp16")
+            c.to_fp16 = true;
+        else if(precision == "bf16")
+            c.to_bf16 = true;
+        else if(precision == "int8")
+            c.to_int8 = true;
+        else if(precision == "fp8")
+            c.to_fp8 = true;
+        else if(precision != "fp32")
+            MIGRAPHX_THROW("Unknown precision for " + model.name + ": " + precision);
+
+        bench_result r;
+        r.model     = model.name;
+        r.batch     = batch;
+        r.precision = precision;
+        auto start  = std::chrono::steady_clock::now();
+        auto p      = c.l.load();
+        r.load_ms   = ms_since(start);
+        start       = std::chrono::steady_clock::now();
+        c.quantize(p);
+        p.compile(ct.get_target(), co);
+        r.compile_ms = ms_since(start);
+        r.memory     = program_memory(p);
+        time_runs(p, c.params(p), n, r);
+        return r;
+    }
+
+    void run()
+    {
+        std::vector<bench_result> results;
+        for(const auto& model : read_bench_manifest(manifest))
+        {
+            for(auto batch : model.batch_sizes)
+            {
+                for(const auto& precision : model.precisions)
+                {
+                    std::cout << "Benchmarking " << model.name << " batch " << batch << " "
+                              << precision << " ... " << std::endl;
+                    results.push_back(run_model(model, batch, precision));
+                }
+            }
+        }
+        print_bench_results(results, std::cout);
+        if(not output.empty())
+            write_bench_results(results, output);
+        if(baseline.empty())
+            return;
+        auto regressions = compare_bench(read_bench_results(baseline), results, thresholds);
+        for(const auto& r : regressions)
+            std::cout << "[REGRESSION]: " << r << std::endl;
+        if(not regressions.empty())
+            MIGRAPHX_THROW(std::to_string(regressions.size()) + " regressions from " + baseline);
+        std::cout << "No regressions from " << baseline << std::endl;
     }
 };
 
@@ -27,9 +27,17 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/marker.hpp>
+#include <migraphx/stringutils.hpp>
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/timeline.hpp>
 #endif
+#include <fstream>
+#include <functional>
+#include <unordered_map>
 
 namespace migraphx {
 namespace driver {
@@ -41,10 +49,58 @@ auto get_hash(const T& x)
     return std::hash<T>{}(x);
 }
 
+// Generated inputs are kept for the life of the driver, so sweeping batch sizes or running the
+// same model again doesn't regenerate them. They are kept for each session, so concurrent
+// sessions don't share buffers.
+static argument cached_argument(const std::string& key, const std::function<argument()>& f)
+{
+    static std::unordered_map<std::string, argument> cache;
+    auto it = cache.find(key);
+    if(it == cache.end())
+        it = cache.emplace(key, f()).first;
+    return it->second;
+}
+
+static bool is_output_param(const std::string& name)
+{
+    return name.find("#output_") != std::string::npos;
+}
+
+static argument generate_param(
+    const std::string& name, const shape& s, const target& t, bool offload, std::size_t session)
+{
+    auto generate = [&] {
+#ifdef HAVE_GPU
+        // Generate the values on the device instead of generating them on the host and copying
+        // them over
+        if(not offload and t.name() == "gpu")
+        {
+            auto ctx   = t.get_context();
+            auto* gctx = ctx.any_cast<gpu::context>();
+            auto arg   = gpu::allocate_gpu(s);
+            gpu::gpu_generate(*gctx, arg, get_hash(name));
+            gctx->finish();
+            return arg;
+        }
+#endif
+        auto arg = generate_argument(s, get_hash(name), random_mode::random);
+        if(not offload)
+            arg = t.copy_to(arg);
+        return arg;
+    };
+    // Outputs are written by the program, so they are never shared
+    if(is_output_param(name))
+        return generate();
+    auto key = std::to_string(session) + ":" + t.name() + ":" + std::to_string(offload) + ":" +
+               name + ":" + to_string(s);
+    return cached_argument(key, generate);
+}
+
 parameter_map fill_param_map(parameter_map& m,
                              const std::unordered_map<std::string, shape>& param_shapes,
                              const target& t,
-                             bool offload)
+                             bool offload,
+                             std::size_t session)
 {
     for(auto&& x : param_shapes)
     {
@@ -52,10 +108,12 @@ parameter_map fill_param_map(parameter_map& m,
         if(arg.empty())
         {
             assert(not x.second.dynamic());
-            arg = generate_argument(x.second, get_hash(x.first), random_mode::random);
+            arg = generate_param(x.first, x.second, t, offload, session);
         }
-        if(not offload)
+        else if(not offload)
+        {
             arg = t.copy_to(arg);
+        }
     }
     return m;
 }
@@ -132,6 +190,46 @@ bool is_offload_copy_set(const program& p)
     return param_ins.empty();
 }
 
+void write_timeline(program& p, const parameter_map& m, const std::string& file, std::ostream& os)
+{
+#ifdef HAVE_GPU
+    auto* gctx = p.get_context().any_cast<gpu::context>();
+    if(gctx == nullptr)
+        MIGRAPHX_THROW("A timeline is only supported for programs compiled for the gpu");
+    // Run once by itself
+    p.eval(m);
+    p.finish();
+    gpu::timeline t{*gctx};
+    p.mark(m, t);
+    std::ofstream fs(file);
+    t.write_trace(fs);
+    t.print_summary(os);
+    os << "Timeline written to " << file << std::endl;
+    // Saves the measured costs for the scheduler when MIGRAPHX_SCHEDULE_PROFILE is set
+    gctx->get_kernel_costs().save();
+#else
+    (void)p;
+    (void)m;
+    (void)file;
+    (void)os;
+    MIGRAPHX_THROW("A timeline is only supported for programs compiled for the gpu");
+#endif
+}
+
+void print_memory_report(const program& p, std::ostream& os)
+{
+    auto to_mb  = [](const value& v) { return v.to<std::size_t>() / (1024.0 * 1024.0); };
+    auto report = p.memory_report();
+    os << "Memory:" << std::endl;
+    for(const auto& x : report)
+    {
+        if(x.get_key() == "total")
+            continue;
+        os << "    " << x.get_key() << ": " << to_mb(x) << "MB" << std::endl;
+    }
+    os << "Peak memory: " << to_mb(report.at("total")) << "MB" << std::endl;
+}
+
 } // namespace  MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
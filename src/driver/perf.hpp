@@ -30,10 +30,12 @@ namespace migraphx {
 namespace driver {
 inline namespace MIGRAPHX_INLINE_NS {
 
+// The generated parameters are reused by later calls for the same session, except for the outputs
 parameter_map fill_param_map(parameter_map& m,
                              const std::unordered_map<std::string, shape>& param_shapes,
                              const target& t,
-                             bool offload = false);
+                             bool offload        = false,
+                             std::size_t session = 0);
 parameter_map create_param_map(const program& p, const target& t, bool offload = false);
 
 parameter_map fill_param_map(parameter_map& m, const program& p, bool gpu);
@@ -49,6 +51,18 @@ target get_target(bool gpu);
  */
 bool is_offload_copy_set(const program& p);
 
+/**
+ * @brief Record the start and end of each instruction with gpu events while the streams run
+ * concurrently, then write a Chrome trace to file and print the stream concurrency achieved.
+ */
+void write_timeline(program& p, const parameter_map& m, const std::string& file, std::ostream& os);
+
+/**
+ * @brief Print how the memory the compiled program uses on its targets splits between the
+ * scratch buffer, literals, code objects and the allocations made on each run, and the peak.
+ */
+void print_memory_report(const program& p, std::ostream& os);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
@@ -0,0 +1,361 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "serve.hpp"
+
+#include <migraphx/errors.hpp>
+#include <migraphx/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+using serve_clock = std::chrono::steady_clock;
+
+struct serve_request
+{
+    std::atomic<serve_request*> next{nullptr};
+    serve_clock::time_point arrival{};
+};
+
+// Intrusive multi-producer single-consumer queue. Producers only do an exchange and a store so
+// pushing never blocks, and the single consumer pops without any locking.
+struct mpsc_queue
+{
+    mpsc_queue() : head(&stub), tail(&stub) {}
+
+    void push(serve_request* r)
+    {
+        r->next.store(nullptr, std::memory_order_relaxed);
+        auto* prev = head.exchange(r, std::memory_order_acq_rel);
+        prev->next.store(r, std::memory_order_release);
+    }
+
+    // Returns nullptr when the queue is empty, or when a producer is midway through a push
+    serve_request* pop()
+    {
+        auto* t    = tail;
+        auto* next = t->next.load(std::memory_order_acquire);
+        if(t == &stub)
+        {
+            if(next == nullptr)
+                return nullptr;
+            tail = next;
+            t    = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if(next != nullptr)
+        {
+            tail = next;
+            return t;
+        }
+        if(t != head.load(std::memory_order_acquire))
+            return nullptr;
+        push(&stub);
+        next = t->next.load(std::memory_order_acquire);
+        if(next == nullptr)
+            return nullptr;
+        tail = next;
+        return t;
+    }
+
+    private:
+    serve_request stub;
+    std::atomic<serve_request*> head;
+    serve_request* tail;
+};
+
+static double to_ms(serve_clock::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    auto i = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+void serve(const program& p,
+           const std::vector<std::size_t>& batch_sizes,
+           const std::function<parameter_map(std::size_t batch)>& make_params,
+           const serve_options& options,
+           std::ostream& os)
+{
+    if(batch_sizes.empty())
+        MIGRAPHX_THROW("No batch sizes to serve");
+    if(options.clients == 0 or options.requests == 0)
+        MIGRAPHX_THROW("Need at least one client and one request");
+    std::vector<std::size_t> buckets = batch_sizes;
+    std::sort(buckets.begin(), buckets.end());
+    buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+    auto max_batch = buckets.back();
+
+    std::vector<parameter_map> params;
+    std::transform(buckets.begin(), buckets.end(), std::back_inserter(params), make_params);
+    // Warm up every bucket so the first requests do not pay for it
+    for(const auto& m : params)
+        p.eval(m);
+    p.finish();
+
+    std::vector<serve_request> requests(options.requests);
+    std::vector<double> latencies;
+    latencies.reserve(requests.size());
+    std::vector<std::size_t> bucket_counts(buckets.size());
+    mpsc_queue queue;
+    auto max_delay = std::chrono::duration_cast<serve_clock::duration>(
+        std::chrono::duration<double, std::milli>(options.max_delay_ms));
+
+    auto start = serve_clock::now();
+    std::vector<std::thread> clients;
+    for(std::size_t c = 0; c < options.clients; c++)
+    {
+        clients.emplace_back([&, c] {
+            std::mt19937 gen(c);
+            std::exponential_distribution<double> interval(
+                options.rate > 0 ? options.rate / options.clients : 1.0);
+            auto next = serve_clock::now();
+            for(std::size_t i = c; i < requests.size(); i += options.clients)
+            {
+                if(options.rate > 0)
+                {
+                    next += std::chrono::duration_cast<serve_clock::duration>(
+                        std::chrono::duration<double>(interval(gen)));
+                    std::this_thread::sleep_until(next);
+                }
+                requests[i].arrival = serve_clock::now();
+                queue.push(&requests[i]);
+            }
+        });
+    }
+
+    std::size_t completed = 0;
+    std::size_t nbatches  = 0;
+    std::vector<serve_request*> batch;
+    while(completed < requests.size())
+    {
+        batch.clear();
+        for(;;)
+        {
+            auto* r = queue.pop();
+            if(r != nullptr)
+            {
+                batch.push_back(r);
+                if(batch.size() == max_batch)
+                    break;
+                continue;
+            }
+            if(completed + batch.size() == requests.size())
+                break;
+            if(not batch.empty() and serve_clock::now() - batch.front()->arrival >= max_delay)
+                break;
+            std::this_thread::yield();
+        }
+        auto bucket = std::lower_bound(buckets.begin(), buckets.end(), batch.size());
+        auto i      = bucket - buckets.begin();
+        p.eval(params[i]);
+        p.finish();
+        auto done = serve_clock::now();
+        for(const auto* r : batch)
+            latencies.push_back(to_ms(done - r->arrival));
+        completed += batch.size();
+        bucket_counts[i]++;
+        nbatches++;
+    }
+    auto elapsed = to_ms(serve_clock::now() - start);
+    for(auto& t : clients)
+        t.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto mean_latency = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    os << std::fixed << std::setprecision(3);
+    os << "Requests: " << requests.size() << ", clients: " << options.clients;
+    if(options.rate > 0)
+        os << ", rate: " << options.rate << "/s";
+    os << ", max delay: " << options.max_delay_ms << "ms" << std::endl;
+    os << "Batches: " << nbatches
+       << ", mean batch size: " << static_cast<double>(requests.size()) / nbatches << std::endl;
+    for(std::size_t i = 0; i < buckets.size(); i++)
+        os << "    batch " << buckets[i] << ": " << bucket_counts[i] << std::endl;
+    os << "Total time: " << elapsed << "ms" << std::endl;
+    os << "Throughput: " << requests.size() / (elapsed / 1000.0) << " requests/s" << std::endl;
+    os << "Latency: mean " << mean_latency << "ms, p50 " << percentile(latencies, 0.5)
+       << "ms, p90 " << percentile(latencies, 0.9) << "ms, p99 " << percentile(latencies, 0.99)
+       << "ms, max " << latencies.back() << "ms" << std::endl;
+}
+
+// The busy percent files of the gpus the amdgpu driver exposes, such as
+// /sys/class/drm/card0/device/gpu_busy_percent
+static std::vector<fs::path> busy_percent_files()
+{
+    std::vector<fs::path> result;
+    const fs::path drm{"/sys/class/drm"};
+    std::error_code ec;
+    if(not fs::is_directory(drm, ec))
+        return result;
+    for(const auto& entry : fs::directory_iterator{drm, ec})
+    {
+        auto name = entry.path().filename().string();
+        // Skip the connectors, such as card0-DP-1
+        if(name.rfind("card", 0) != 0 or name.find('-') != std::string::npos)
+            continue;
+        auto f = entry.path() / "device" / "gpu_busy_percent";
+        if(fs::exists(f, ec))
+            result.push_back(f);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Samples the busy percent of each gpu on a background thread until it is stopped
+struct busy_sampler
+{
+    busy_sampler() : files(busy_percent_files()), totals(files.size())
+    {
+        if(files.empty())
+            return;
+        sampler = std::thread{[&] {
+            while(not done.load())
+            {
+                for(std::size_t i = 0; i < files.size(); i++)
+                {
+                    std::ifstream is(files[i]);
+                    double busy = 0;
+                    if(is >> busy)
+                        totals[i] += busy;
+                }
+                samples++;
+                std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            }
+        }};
+    }
+
+    busy_sampler(const busy_sampler&)            = delete;
+    busy_sampler& operator=(const busy_sampler&) = delete;
+
+    ~busy_sampler() { stop(); }
+
+    void stop()
+    {
+        done = true;
+        if(sampler.joinable())
+            sampler.join();
+    }
+
+    void print(std::ostream& os) const
+    {
+        os << "GPU utilization:";
+        if(samples == 0)
+            os << " not available";
+        for(std::size_t i = 0; i < files.size() and samples > 0; i++)
+            os << " " << files[i].parent_path().parent_path().filename().string() << " "
+               << totals[i] / samples << "%";
+        os << std::endl;
+    }
+
+    private:
+    std::vector<fs::path> files;
+    std::vector<double> totals;
+    std::size_t samples = 0;
+    std::atomic<bool> done{false};
+    std::thread sampler;
+};
+
+void throughput(const std::vector<program>& instances,
+                const std::function<parameter_map(const program&, std::size_t)>& make_params,
+                const throughput_options& options,
+                std::ostream& os)
+{
+    if(instances.empty() or options.concurrency == 0 or options.iterations == 0)
+        MIGRAPHX_THROW("Need at least one instance, one request in flight and one iteration");
+    std::vector<program> sessions;
+    std::vector<parameter_map> params;
+    for(const auto& p : instances)
+    {
+        for(std::size_t c = 0; c < options.concurrency; c++)
+        {
+            params.push_back(make_params(p, sessions.size()));
+            sessions.push_back(p.create_session());
+        }
+    }
+    // Warm up every session so the first requests do not pay for it
+    for(std::size_t i = 0; i < sessions.size(); i++)
+    {
+        sessions[i].eval(params[i]);
+        sessions[i].finish();
+    }
+
+    std::vector<std::vector<double>> session_latencies(sessions.size());
+    busy_sampler sampler;
+    auto start = serve_clock::now();
+    std::vector<std::thread> workers;
+    for(std::size_t i = 0; i < sessions.size(); i++)
+    {
+        workers.emplace_back([&, i] {
+            auto& latencies = session_latencies[i];
+            latencies.reserve(options.iterations);
+            for(std::size_t n = 0; n < options.iterations; n++)
+            {
+                auto arrival = serve_clock::now();
+                sessions[i].eval(params[i]);
+                sessions[i].finish();
+                latencies.push_back(to_ms(serve_clock::now() - arrival));
+            }
+        });
+    }
+    for(auto& t : workers)
+        t.join();
+    auto elapsed = to_ms(serve_clock::now() - start);
+    sampler.stop();
+
+    std::vector<double> latencies;
+    for(const auto& l : session_latencies)
+        latencies.insert(latencies.end(), l.begin(), l.end());
+    std::sort(latencies.begin(), latencies.end());
+    auto mean_latency = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    auto rate         = latencies.size() / (elapsed / 1000.0);
+    os << std::fixed << std::setprecision(3);
+    os << "Instances: " << instances.size() << ", concurrency: " << options.concurrency
+       << ", requests: " << latencies.size() << std::endl;
+    os << "Total time: " << elapsed << "ms" << std::endl;
+    os << "Throughput: " << rate << " requests/s, " << rate * options.batch << " samples/s"
+       << std::endl;
+    os << "Latency: mean " << mean_latency << "ms, p50 " << percentile(latencies, 0.5)
+       << "ms, p90 " << percentile(latencies, 0.9) << "ms, p99 " << percentile(latencies, 0.99)
+       << "ms, max " << latencies.back() << "ms" << std::endl;
+    sampler.print(os);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
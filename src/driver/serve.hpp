@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_RTGLIB_DRIVER_SERVE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DRIVER_SERVE_HPP
+
+#include <migraphx/program.hpp>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct serve_options
+{
+    std::size_t requests = 1000;
+    std::size_t clients  = 4;
+    // Total request rate across all clients, 0 sends requests back to back
+    double rate = 0;
+    // How long the oldest request in a batch can wait for the batch to fill
+    double max_delay_ms = 5;
+};
+
+struct throughput_options
+{
+    // Requests each in-flight slot runs back to back
+    std::size_t iterations = 100;
+    // Requests in flight on each program instance
+    std::size_t concurrency = 1;
+    // Batch size of each request, used to report samples per second
+    std::size_t batch = 1;
+};
+
+/**
+ * Simulate serving traffic against a compiled program: client threads push requests into a
+ * queue, and they are grouped into batches of up to the largest of the batch sizes within the
+ * batching deadline. Each batch runs with the parameters of the smallest batch size that holds
+ * it, and the latency and throughput are reported.
+ */
+void serve(const program& p,
+           const std::vector<std::size_t>& batch_sizes,
+           const std::function<parameter_map(std::size_t batch)>& make_params,
+           const serve_options& options,
+           std::ostream& os);
+
+/**
+ * Measure throughput with several requests in flight: each instance of the program gets a
+ * session (see program::create_session) with its own parameters for every concurrent request,
+ * and each session runs its requests back to back on its own thread. The aggregate throughput,
+ * the latency percentiles and the gpu utilization sampled from the amdgpu driver are reported.
+ * make_params is called with the instance and the index of the session the parameters are for.
+ */
+void throughput(const std::vector<program>& instances,
+                const std::function<parameter_map(const program&, std::size_t)>& make_params,
+                const throughput_options& options,
+                std::ostream& os);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "tune.hpp"
+#include <migraphx/register_target.hpp>
+#include <migraphx/errors.hpp>
+#ifdef HAVE_GPU
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/tuning_bundle.hpp>
+#endif
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+void export_tuning(program& p, const std::string& file, std::ostream& os)
+{
+#ifdef HAVE_GPU
+    auto* gctx = p.get_context().any_cast<gpu::context>();
+    if(gctx == nullptr)
+        MIGRAPHX_THROW("Tuning can only be exported for programs compiled for the gpu");
+    gpu::export_tuning_bundle(*gctx, file);
+    os << "Tuning results for " << gpu::get_tuning_target(*gctx).at("gfx").to<std::string>()
+       << " written to " << file << std::endl;
+#else
+    (void)p;
+    (void)file;
+    (void)os;
+    MIGRAPHX_THROW("Tuning bundles are only supported for the gpu");
+#endif
+}
+
+void import_tuning(const std::string& file, std::ostream& os)
+{
+#ifdef HAVE_GPU
+    auto ctx   = make_target("gpu").get_context();
+    auto* gctx = ctx.any_cast<gpu::context>();
+    assert(gctx != nullptr);
+    auto n = gpu::import_tuning_bundle(*gctx, file);
+    if(n == 0)
+        os << "No tuning results for " << gpu::get_tuning_target(*gctx) << " in " << file
+           << std::endl;
+    else
+        os << "Imported " << n << " tuning results from " << file << std::endl;
+#else
+    (void)file;
+    (void)os;
+    MIGRAPHX_THROW("Tuning bundles are only supported for the gpu");
+#endif
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
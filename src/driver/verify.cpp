@@ -32,6 +32,8 @@
 #include <migraphx/quantization.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/fp_to_double.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <future>
 
 namespace migraphx {
 namespace driver {
@@ -40,7 +42,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 /**
  * Gives tolerances based on user input (`rms_tol`, `atol`, `rtol` parameters) and defaults.
  * Sets to fp16 tolerances if `quantize` input is fp16 or any fp16 instruction in found in the
- * model.
+ * model, and likewise for bf16.
  */
 verify::tolerance get_tolerances(const program& p,
                                  verify_options vo,
@@ -51,6 +53,9 @@ verify::tolerance get_tolerances(const program& p,
     bool has_fp16 = any_of(p.get_modules(), [](auto&& m) {
         return any_of(*m, [](auto&& ins) { return (ins.get_shape().type() == shape::half_type); });
     });
+    bool has_bf16 = any_of(p.get_modules(), [](auto&& m) {
+        return any_of(*m, [](auto&& ins) { return (ins.get_shape().type() == shape::bf16_type); });
+    });
     migraphx::verify::tolerance result{};
     if(has_fp16 or vo.quantize == precision::fp16)
     {
@@ -58,6 +63,12 @@ verify::tolerance get_tolerances(const program& p,
         result.atol    = 4e-2;
         result.rtol    = 4e-2;
     }
+    if(has_bf16 or vo.quantize == precision::bf16)
+    {
+        result.rms_tol = 1e-1;
+        result.atol    = 8e-2;
+        result.rtol    = 8e-2;
+    }
     if(rms_tol)
     {
         result.rms_tol = *rms_tol;
@@ -73,33 +84,38 @@ verify::tolerance get_tolerances(const program& p,
     return result;
 }
 
-std::vector<argument> run_ref(program p,
-                              const compile_options& options,
-                              const verify_options& vo,
-                              const parameter_map& inputs)
+program compile_ref(program p, const compile_options& options, const verify_options& vo)
 {
     if(vo.ref_use_double)
     {
         run_passes(p, {fp_to_double{}});
     }
     p.compile(migraphx::make_target("ref"), options);
-    auto out = p.eval(inputs);
-    std::cout << p << std::endl;
-    return out;
+    return p;
 }
 
-std::vector<argument> run_target(program p,
-                                 const target& t,
-                                 const compile_options& options,
-                                 const verify_options& vo,
-                                 const parameter_map& inputs)
+program compile_target(program p,
+                       const target& t,
+                       const compile_options& options,
+                       const verify_options& vo)
 {
     if(vo.quantize == precision::fp16)
     {
         quantize_fp16(p);
     }
+    if(vo.quantize == precision::bf16)
+    {
+        quantize_bf16(p);
+    }
     p.compile(t, options);
+    return p;
+}
 
+std::vector<argument> eval_target(program& p,
+                                  const target& t,
+                                  const compile_options& options,
+                                  const parameter_map& inputs)
+{
     parameter_map m;
     for(auto&& x : p.get_parameter_shapes())
     {
@@ -108,24 +124,40 @@ std::vector<argument> run_target(program p,
     }
     auto gpu_out = p.eval(m);
     std::vector<argument> output(gpu_out.size());
-    std::cout << p << std::endl;
     std::transform(gpu_out.begin(), gpu_out.end(), output.begin(), [&](auto& argu) {
         return options.offload_copy ? argu : t.copy_from(argu);
     });
     return output;
 }
 
-void verify_program(const std::string& name,
-                    const program& p,
-                    const target& t,
-                    compile_options options,
-                    verify_options vo,
-                    const parameter_map& inputs,
-                    verify::tolerance tols)
+std::vector<argument> run_ref(program p,
+                              const compile_options& options,
+                              const verify_options& vo,
+                              const parameter_map& inputs)
 {
-    auto ref_outs    = run_ref(p, options, vo, inputs);
-    auto target_outs = run_target(p, t, options, vo, inputs);
+    p        = compile_ref(std::move(p), options, vo);
+    auto out = p.eval(inputs);
+    std::cout << p << std::endl;
+    return out;
+}
+
+std::vector<argument> run_target(program p,
+                                 const target& t,
+                                 const compile_options& options,
+                                 const verify_options& vo,
+                                 const parameter_map& inputs)
+{
+    p           = compile_target(std::move(p), t, options, vo);
+    auto output = eval_target(p, t, options, inputs);
+    std::cout << p << std::endl;
+    return output;
+}
 
+bool compare_outputs(const std::string& name,
+                     const std::vector<argument>& ref_outs,
+                     const std::vector<argument>& target_outs,
+                     verify::tolerance tols)
+{
     std::size_t output_num = ref_outs.size();
     bool passed            = true;
     for(std::size_t i = 0; i < output_num; ++i)
@@ -136,14 +168,31 @@ void verify_program(const std::string& name,
             std::cout << "FAILED: " << name << std::endl;
             std::cout << "Shape mismatch {" << ref_outs[i].get_shape() << "} != {"
                       << target_outs[i].get_shape() << "}" << std::endl;
+            passed = false;
         }
         else
         {
             passed &= verify_args(name, target_outs[i], verify::expected{ref_outs[i]}, tols);
         }
     }
+    return passed;
+}
+
+bool verify_program(const std::string& name,
+                    const program& p,
+                    const target& t,
+                    compile_options options,
+                    verify_options vo,
+                    const parameter_map& inputs,
+                    verify::tolerance tols)
+{
+    auto ref_outs    = run_ref(p, options, vo, inputs);
+    auto target_outs = run_target(p, t, options, vo, inputs);
+
+    bool passed = compare_outputs(name, ref_outs, target_outs, tols);
     if(passed)
         std::cout << "MIGraphX verification passed successfully." << std::endl;
+    return passed;
 }
 
 void verify_instructions(const program& prog,
@@ -237,6 +286,81 @@ void verify_reduced_program(const program& p,
     }
 }
 
+/**
+ * Verifies the main module truncated after its first `n` instructions. The ref program is
+ * evaluated on a worker thread while the target runs, and only the value of the last kept
+ * instruction is brought back to the host.
+ */
+bool verify_prefix(program p,
+                   std::size_t n,
+                   const target& t,
+                   const compile_options& options,
+                   const verify_options& vo,
+                   const parameter_map& inputs,
+                   verify::tolerance tols)
+{
+    auto* mm = p.get_main_module();
+    mm->remove_instructions(std::next(mm->begin(), n), mm->end());
+    try
+    {
+        auto ref         = compile_ref(p, options, vo);
+        auto target      = compile_target(p, t, options, vo);
+        auto ref_outs    = std::async(std::launch::async, [&] { return ref.eval(inputs); });
+        auto target_outs = eval_target(target, t, options, inputs);
+        return compare_outputs(std::to_string(n), ref_outs.get(), target_outs, tols);
+    }
+    catch(const std::exception& e)
+    {
+        std::cout << "FAILED: " << n << std::endl;
+        std::cout << "Exception: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void verify_bisect_program(const program& p,
+                           const target& t,
+                           compile_options options,
+                           verify_options vo,
+                           const parameter_map& inputs,
+                           verify::tolerance tols)
+{
+    const auto* mm = p.get_main_module();
+    // Number of instructions to keep so that each candidate is the last instruction
+    std::vector<std::size_t> prefixes;
+    std::vector<instruction_ref> candidates;
+    std::size_t n = 0;
+    for(auto ins : iterator_for(*mm))
+    {
+        n++;
+        if(ins->name().front() == '@' or ins->get_shape().type() == shape::tuple_type)
+            continue;
+        prefixes.push_back(n);
+        candidates.push_back(ins);
+    }
+    std::cout << "Bisect candidates: " << candidates.size() << std::endl;
+
+    // Once an instruction diverges everything that depends on it is expected to as well, so
+    // search for the first failing prefix
+    std::size_t first = 0;
+    std::size_t last  = candidates.size();
+    while(first < last)
+    {
+        auto mid = first + (last - first) / 2;
+        std::cout << "Verify: " << prefixes[mid] << std::endl;
+        if(verify_prefix(p, prefixes[mid], t, options, vo, inputs, tols))
+            first = mid + 1;
+        else
+            last = mid;
+    }
+    if(first == candidates.size())
+    {
+        std::cout << "MIGraphX verification passed successfully." << std::endl;
+        return;
+    }
+    std::cout << "First divergent instruction:" << std::endl;
+    mm->debug_print(candidates[first]);
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
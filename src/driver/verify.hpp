@@ -38,7 +38,7 @@ verify::tolerance get_tolerances(const program& p,
                                  std::optional<double> atol,
                                  std::optional<double> rtol);
 
-void verify_program(const std::string& name,
+bool verify_program(const std::string& name,
                     const program& p,
                     const target& t,
                     compile_options options     = compile_options{},
@@ -56,6 +56,12 @@ void verify_reduced_program(const program& p,
                             verify_options vo           = verify_options{},
                             const parameter_map& inputs = {},
                             verify::tolerance tols      = verify::tolerance{});
+void verify_bisect_program(const program& p,
+                           const target& t,
+                           compile_options options     = compile_options{},
+                           verify_options vo           = verify_options{},
+                           const parameter_map& inputs = {},
+                           verify::tolerance tols      = verify::tolerance{});
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
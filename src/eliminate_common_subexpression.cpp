@@ -27,50 +27,82 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/functional.hpp>
+#include <migraphx/hash.hpp>
+#include <migraphx/module.hpp>
 
-#include <unordered_set>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
-template <class Range>
-void cse_range(module& m, Range&& r)
+static std::size_t hash_shape(const shape& s)
 {
-    std::unordered_multimap<std::string, instruction_ref> instructions;
-    std::unordered_set<instruction_ref> processed_ins;
-    for(auto ins : r)
+    std::size_t h = hash_value(s.type());
+    for(auto len : s.lens())
+        hash_combine(h, len);
+    for(auto stride : s.strides())
+        hash_combine(h, stride);
+    return h;
+}
+
+// Instructions are hash-consed on their operator, inputs and module arguments. The data of a
+// literal is only hashed when another literal has the same shape, to avoid reading the weights
+// that cant be shared.
+static std::size_t
+hash_instruction(instruction_ref ins,
+                 const std::unordered_map<std::size_t, std::size_t>& literal_shapes)
+{
+    std::size_t h = hash_value(ins->name());
+    hash_combine(h, ins->get_operator().to_value());
+    for(auto input : ins->inputs())
+        hash_combine(h, input);
+    for(auto* smod : ins->module_inputs())
+        hash_combine(h, smod);
+    if(ins->name() == "@literal")
+    {
+        auto sh = hash_shape(ins->get_shape());
+        hash_combine(h, sh);
+        const auto& lit = ins->get_literal();
+        if(literal_shapes.at(sh) > 1 and not lit.empty())
+            hash_combine(h, std::string_view{lit.data(), lit.get_shape().bytes()});
+    }
+    return h;
+}
+
+void eliminate_common_subexpression::apply(module& m) const
+{
+    std::unordered_map<std::size_t, std::size_t> literal_shapes;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "@literal")
+            literal_shapes[hash_shape(ins->get_shape())]++;
+    }
+    // Instructions are visited in order, so the inputs of an instruction have already been
+    // replaced by their first equivalent instruction when it is hashed
+    std::unordered_multimap<std::size_t, instruction_ref> instructions;
+    for(auto ins : iterator_for(m))
     {
         // Skip dead instructions
         if(ins->outputs().empty())
             continue;
+        // Every seed must produce a different sequence
+        if(ins->name() == "random_seed")
+            continue;
 
-        // Find instruction with the same name
-        auto found_instructions = range(instructions.equal_range(ins->name()));
-        for(const auto& pp : found_instructions)
+        auto h     = hash_instruction(ins, literal_shapes);
+        auto found = range(instructions.equal_range(h));
+        auto it    = std::find_if(
+            found.begin(), found.end(), [&](const auto& pp) { return *pp.second == *ins; });
+        if(it != found.end())
         {
-            auto eq = pp.second;
-            if(contains(processed_ins, eq))
-                continue;
-            if(*eq != *ins)
-                continue;
-            m.replace_instruction(ins, eq);
-            processed_ins.emplace(ins);
-            std::vector<instruction_ref> outputs;
-            std::copy_if(eq->outputs().begin(),
-                         eq->outputs().end(),
-                         std::back_inserter(outputs),
-                         [&](auto x) { return m.has_instruction(x); });
-
-            std::sort(outputs.begin(), outputs.end(), [&](auto x, auto y) {
-                return std::distance(eq, x) < std::distance(eq, y);
-            });
-            cse_range(m, outputs);
+            m.replace_instruction(ins, it->second);
+            continue;
         }
-        instructions.emplace(ins->name(), ins);
+        instructions.emplace(h, ins);
     }
 }
 
-void eliminate_common_subexpression::apply(module& m) const { cse_range(m, iterator_for(m)); }
-
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
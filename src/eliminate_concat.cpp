@@ -54,56 +54,75 @@ void eliminate_concat::apply(module& m) const
                       arg->outputs().size() > 1;
            }))
             continue;
-        // We can only do this optimization when concat axis is either the leftmost
-        // axis OR the sizes to the left of this axis are all equal to 1
+        // When the concat axis is the leftmost axis OR the sizes to the left of this axis are all
+        // equal to 1, each input is a contiguous chunk of the output. Otherwise each input is a
+        // strided view of the output, which every producer has to be able to write.
         // Since we've already checked that the non-axis dimensions are identical
         // we only need to check the first input
         auto lens              = ins->inputs().front()->get_shape().lens();
         std::size_t axis_index = tune_axis(lens.size(), concat_op->axis, concat_op->name());
-        if(axis_index == 0 or
-           std::all_of(lens.begin(), lens.begin() + axis_index, [](auto x) { return x == 1; }))
-        {
-            // Last input should be an allocation
-            auto last = ins->inputs().back();
-            if(last->name() != concat_opt.allocate())
-                continue;
-            // Where are the allocations for the tensors to be concatenated?
-            std::vector<instruction_ref> allocations;
+        bool strided           = std::any_of(
+            lens.begin(), lens.begin() + axis_index, [](auto x) { return x != 1; });
+        // Last input should be an allocation
+        auto last = ins->inputs().back();
+        if(last->name() != concat_opt.allocate())
+            continue;
+        // Where are the allocations for the tensors to be concatenated?
+        std::vector<instruction_ref> allocations;
 
-            std::transform(
-                ins->inputs().begin(),
-                std::prev(ins->inputs().end()),
-                std::back_inserter(allocations),
-                [&](instruction_ref x) { return instruction::get_output_alias(x, true); });
+        std::transform(ins->inputs().begin(),
+                       std::prev(ins->inputs().end()),
+                       std::back_inserter(allocations),
+                       [&](instruction_ref x) { return instruction::get_output_alias(x, true); });
 
-            if(std::any_of(allocations.begin(), allocations.end(), [&](auto x) {
-                   return x->name() != concat_opt.allocate();
-               }))
-                continue;
+        if(std::any_of(allocations.begin(), allocations.end(), [&](auto x) {
+               return x->name() != concat_opt.allocate();
+           }))
+            continue;
 
-            // Need to sort the allocations, so that we know where to
-            // insert the "super"-allocation
-            auto sorted_allocations = allocations;
-            std::sort(sorted_allocations.begin(),
-                      sorted_allocations.end(),
-                      [&](instruction_ref x, instruction_ref y) {
-                          return std::distance(m.begin(), x) < std::distance(m.begin(), y);
-                      });
-            // Move "super" allocation to the front
-            auto first = sorted_allocations.front();
-            auto super = m.move_instruction(last, first);
-            // Replace each allocation with a load
-            std::size_t offset = 0;
-            for(auto alloc : allocations)
+        // A strided view is only written by a producer that takes the allocation directly
+        auto writes_strided = [&](instruction_ref x) {
+            if(x->inputs().empty() or x->inputs().back()->name() != concat_opt.allocate())
+                return false;
+            return concat_opt.supports_strided_output(x);
+        };
+        if(strided and (not last->get_shape().standard() or
+                        not std::all_of(
+                            ins->inputs().begin(), std::prev(ins->inputs().end()), writes_strided)))
+            continue;
+
+        // Need to sort the allocations, so that we know where to
+        // insert the "super"-allocation
+        auto sorted_allocations = allocations;
+        std::sort(sorted_allocations.begin(),
+                  sorted_allocations.end(),
+                  [&](instruction_ref x, instruction_ref y) {
+                      return std::distance(m.begin(), x) < std::distance(m.begin(), y);
+                  });
+        // Move "super" allocation to the front
+        auto first = sorted_allocations.front();
+        auto super = m.move_instruction(last, first);
+        // Replace each allocation with a load
+        std::size_t offset = 0;
+        for(auto alloc : allocations)
+        {
+            if(strided)
+            {
+                const auto& s = super->get_shape();
+                shape view{s.type(), alloc->get_shape().lens(), s.strides()};
+                m.replace_instruction(alloc, op::load{view, offset}, {super});
+                offset += view.lens()[axis_index] * s.strides()[axis_index] * s.type_size();
+            }
+            else
             {
                 op::load op{alloc->get_shape(), offset};
                 m.replace_instruction(alloc, op, {super});
                 offset += alloc->get_shape().bytes();
             }
-            std::vector<instruction_ref> args = {super};
-            std::copy(ins->inputs().begin(), ins->inputs().end() - 1, std::back_inserter(args));
-            m.replace_instruction(ins, migraphx::make_op("identity"), args);
         }
+        std::vector<instruction_ref> args = {super};
+        std::copy(ins->inputs().begin(), ins->inputs().end() - 1, std::back_inserter(args));
+        m.replace_instruction(ins, migraphx::make_op("identity"), args);
     }
 }
 } // namespace MIGRAPHX_INLINE_NS
@@ -118,6 +118,8 @@ void eliminate_data_type::apply(module& m) const
             continue;
         if(contains(skip_op_names, ins->name()) and not contains(unsupported_ops, ins->name()))
             continue;
+        if(contains(supported_ops, ins->name()))
+            continue;
         if(contains(unsupported_ops, "all") or contains(unsupported_ops, ins->name()))
             insert_convert_to_supported_type(m, ins, target_type, unsupported_types);
     }
@@ -31,6 +31,7 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/stringutils.hpp>
+#include <migraphx/float_equal.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -66,14 +67,31 @@ static void update_op(const instruction_ref& input, const instruction_ref& ins,
 
 static void update_pooling(const instruction_ref& input, const instruction_ref& ins, module& m)
 {
-    auto op = any_cast<op::pooling>(ins->get_operator());
+    auto op     = any_cast<op::pooling>(ins->get_operator());
+    auto pad_op = any_cast<op::pad>(input->get_operator());
+
+    auto kdims = input->get_shape().lens().size() - 2;
+    if(op.padding.size() == kdims)
+    {
+        auto padding = op.padding;
+        op.padding.insert(op.padding.end(), padding.begin(), padding.end());
+    }
+
     if(op.mode == op::pooling_mode::average)
+    {
+        // The padded zeros are counted by the average, so the implicit padding must be included
+        // as well, which would change the result if the op already excludes its own padding
+        bool has_padding =
+            std::any_of(op.padding.begin(), op.padding.end(), [](auto p) { return p != 0; });
+        if(not float_equal(pad_op.value, 0) or (has_padding and not op.count_include_pad))
+            return;
+        op.count_include_pad = true;
+    }
+    else if(op.mode == op::pooling_mode::lpnorm and not float_equal(pad_op.value, 0))
     {
         return;
     }
-    auto pad_op = any_cast<op::pad>(input->get_operator());
 
-    auto kdims    = input->get_shape().lens().size() - 2;
     auto kdims_it = pad_op.pads.begin() + 2;
 
     std::vector<size_t> pads_l(kdims_it, kdims_it + kdims);
@@ -103,8 +121,16 @@ void eliminate_pad::apply(module& m) const
         auto input = ins->inputs().front();
         if(input->name() != "pad")
             continue;
+        // Only constant padding can be done implicitly by the consumer
+        auto pad_op = any_cast<op::pad>(input->get_operator());
+        if(pad_op.mode != op::pad::constant_pad)
+            continue;
         if(op_name == "convolution" or op_name == "im2col")
+        {
+            if(not float_equal(pad_op.value, 0))
+                continue;
             update_op(input, ins, m);
+        }
         else if(op_name == "pooling")
             update_pooling(input, ins, m);
     }
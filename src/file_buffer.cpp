@@ -27,6 +27,13 @@
 #include <fstream>
 #include <iostream>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
@@ -65,6 +72,40 @@ std::string read_string(const fs::path& filename)
     return generic_read_file<std::string>(filename);
 }
 
+mapped_buffer map_buffer(const fs::path& filename)
+{
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY); // NOLINT
+    if(fd < 0)
+        MIGRAPHX_THROW("Failure opening file: " + filename);
+    struct stat st
+    {
+    };
+    if(fstat(fd, &st) != 0 or st.st_size < 1)
+    {
+        close(fd);
+        MIGRAPHX_THROW("Invalid size for: " + filename);
+    }
+    std::size_t nbytes = st.st_size;
+    void* ptr          = mmap(nullptr, nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed
+    close(fd);
+    if(ptr != MAP_FAILED) // NOLINT
+    {
+        // Pages are read sequentially while deserializing
+        madvise(ptr, nbytes, MADV_SEQUENTIAL);
+        return {std::shared_ptr<const char>(static_cast<const char*>(ptr),
+                                            [nbytes](const char* p) {
+                                                munmap(const_cast<char*>(p), nbytes); // NOLINT
+                                            }),
+                nbytes};
+    }
+#endif
+    // Fallback to reading the file when it can't be mapped
+    auto v = std::make_shared<std::vector<char>>(read_buffer(filename));
+    return {std::shared_ptr<const char>(v, v->data()), v->size()};
+}
+
 void write_string(const fs::path& filename, const std::string& buffer)
 {
     write_buffer(filename, buffer.data(), buffer.size());
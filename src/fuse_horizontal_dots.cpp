@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/fuse_horizontal_dots.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static bool is_horizontal_dot(instruction_ref ins, std::size_t max_multiply_adds)
+{
+    if(not contains({"dot", "quant_dot"}, ins->name()))
+        return false;
+    if(std::any_of(ins->inputs().begin(), ins->inputs().end(), [](auto input) {
+           return input->get_shape().dynamic();
+       }))
+        return false;
+    auto k = ins->inputs().front()->get_shape().lens().back();
+    return ins->get_shape().elements() * k <= max_multiply_adds;
+}
+
+static bool same_dot(instruction_ref x, instruction_ref y)
+{
+    if(x->get_operator() != y->get_operator())
+        return false;
+    return std::equal(x->inputs().begin(),
+                      x->inputs().end(),
+                      y->inputs().begin(),
+                      y->inputs().end(),
+                      [](auto a, auto b) {
+                          return a->get_shape().type() == b->get_shape().type() and
+                                 a->get_shape().lens() == b->get_shape().lens();
+                      });
+}
+
+// Move the instructions, along with the inputs they depend on, so they come
+// before pos
+static void move_before(module& m,
+                        instruction_ref pos,
+                        const std::vector<instruction_ref>& inss,
+                        std::unordered_set<instruction_ref>& before)
+{
+    for(auto ins : inss)
+    {
+        if(contains(before, ins))
+            continue;
+        move_before(m, pos, ins->inputs(), before);
+        m.move_instruction(ins, pos);
+        before.insert(ins);
+    }
+}
+
+// Keep the dots that do not depend on each other, in program order
+static std::vector<instruction_ref> independent_dots(const module& m,
+                                                     const std::vector<instruction_ref>& dots)
+{
+    std::vector<instruction_ref> result;
+    for(auto ins : iterator_for(m))
+    {
+        if(not contains(dots, ins))
+            continue;
+        // Only a later dot can depend on an earlier one
+        if(std::any_of(
+               result.begin(), result.end(), [&](auto dot) { return reaches(dot, ins); }))
+            continue;
+        result.push_back(ins);
+    }
+    return result;
+}
+
+static void fuse_dots(module& m, const std::vector<instruction_ref>& group)
+{
+    // Fusing an earlier group can move instructions and add dependencies
+    // between the dots, so check them again
+    auto dots = independent_dots(m, group);
+    if(dots.size() < 2)
+        return;
+    auto pos = dots.front();
+    std::unordered_set<instruction_ref> before;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins == pos)
+            break;
+        before.insert(ins);
+    }
+    std::vector<instruction_ref> inputs;
+    for(auto dot : dots)
+        inputs.insert(inputs.end(), dot->inputs().begin(), dot->inputs().end());
+    move_before(m, pos, inputs, before);
+
+    auto stack = [&](std::size_t i) {
+        std::vector<instruction_ref> args;
+        std::transform(dots.begin(), dots.end(), std::back_inserter(args), [&](auto dot) {
+            return m.insert_instruction(
+                pos, make_op("unsqueeze", {{"axes", {0}}}), dot->inputs().at(i));
+        });
+        return m.insert_instruction(pos, make_op("concat", {{"axis", 0}}), args);
+    };
+    auto a     = stack(0);
+    auto b     = stack(1);
+    auto fused = m.insert_instruction(pos, pos->get_operator(), a, b);
+    for(auto i : range(dots.size()))
+    {
+        auto slice = m.insert_instruction(
+            pos, make_op("slice", {{"axes", {0}}, {"starts", {i}}, {"ends", {i + 1}}}), fused);
+        m.replace_instruction(dots[i], make_op("squeeze", {{"axes", {0}}}), slice);
+    }
+}
+
+void fuse_horizontal_dots::apply(module& m) const
+{
+    std::vector<instruction_ref> candidates;
+    for(auto ins : iterator_for(m))
+    {
+        if(is_horizontal_dot(ins, max_multiply_adds))
+            candidates.push_back(ins);
+    }
+    std::unordered_set<instruction_ref> grouped;
+    std::vector<std::vector<instruction_ref>> groups;
+    for(auto i : range(candidates.size()))
+    {
+        auto ins = candidates[i];
+        if(contains(grouped, ins))
+            continue;
+        std::vector<instruction_ref> group = {ins};
+        std::copy_if(candidates.begin() + i + 1,
+                     candidates.end(),
+                     std::back_inserter(group),
+                     [&](auto next) {
+                         return not contains(grouped, next) and same_dot(ins, next);
+                     });
+        if(group.size() < 2)
+            continue;
+        grouped.insert(group.begin(), group.end());
+        groups.push_back(group);
+    }
+    for(const auto& group : groups)
+        fuse_dots(m, group);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -33,6 +33,9 @@
 #include <migraphx/matcher.hpp>
 #include <migraphx/param_utils.hpp>
 #include <migraphx/rewrite_reshapes.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/op/pointwise.hpp>
 #include <iterator>
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_POINTWISE_FUSION)
@@ -40,6 +43,48 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_POINTWISE_FUSION)
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+// A gather whose result is only read by a pointwise module. The first two inputs are the data
+// and the indices of the gather, followed by the remaining inputs of the pointwise module. The
+// gathered value is passed as the first parameter of the module.
+struct fused_gather
+{
+    int64_t axis = 0;
+
+    std::string name() const { return "fused_gather"; }
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"));
+    }
+
+    operation gather_op() const { return make_op("gather", {{"axis", axis}}); }
+
+    shape compute_shape(std::vector<shape> inputs, const std::vector<module_ref>& mods) const
+    {
+        check_shapes{inputs, *this}.has_at_least(2);
+        auto gather_shape = gather_op().compute_shape({inputs[0], inputs[1]});
+        inputs.erase(inputs.begin(), inputs.begin() + 2);
+        inputs.insert(inputs.begin(), gather_shape);
+        return op::pointwise{}.compute_shape(inputs, mods);
+    }
+
+    argument compute(const shape& output_shape,
+                     std::vector<argument> args,
+                     const std::vector<module_ref>& mods,
+                     const std::function<std::vector<argument>(
+                         module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
+    {
+        auto gather       = gather_op();
+        auto gather_shape = gather.compute_shape({args[0].get_shape(), args[1].get_shape()});
+        auto gathered     = gather.compute(gather_shape, {args[0], args[1]});
+        args.erase(args.begin(), args.begin() + 2);
+        args.insert(args.begin(), gathered);
+        return op::pointwise{}.compute(output_shape, args, mods, run);
+    }
+};
+MIGRAPHX_REGISTER_OP(fused_gather);
+
 static literal get_scalar(instruction_ref ins)
 {
     if(contains({"contiguous", "broadcast", "multibroadcast"}, ins->name()))
@@ -194,6 +239,46 @@ static bool find_pointwise_modules(module_pass_manager& mpm)
     return changed;
 }
 
+// Fuse a gather that is only used by a pointwise module, so the gathered tensor is never written
+// to memory
+static void find_gather_pointwise(module_pass_manager& mpm)
+{
+    for(auto ins : iterator_for(mpm.get_module()))
+    {
+        if(ins->name() != "pointwise")
+            continue;
+        if(ins->get_shape().type() == shape::tuple_type)
+            continue;
+        auto it = std::find_if(ins->inputs().begin(), ins->inputs().end(), [&](auto i) {
+            return i->name() == "gather" and i->outputs().size() == 1 and
+                   not i->get_shape().dynamic();
+        });
+        if(it == ins->inputs().end())
+            continue;
+        auto gather_ins = *it;
+
+        auto* pm                       = ins->module_inputs().front();
+        auto* gm                       = mpm.create_module(pm->name() + ":gather", *pm);
+        std::vector<std::string> names = gm->get_parameter_names();
+        std::sort(names.begin(), names.end());
+        auto gather_param_name = names[it - ins->inputs().begin()];
+        auto gather_param      = gm->get_parameter(gather_param_name);
+        // Sorts before the other parameters so the gathered value is the first argument
+        auto param = gm->add_parameter("!" + gather_param_name, gather_param->get_shape());
+        gm->replace_instruction(gather_param, param);
+        gm->remove_instruction(gather_param);
+
+        std::vector<instruction_ref> inputs = gather_ins->inputs();
+        std::copy_if(ins->inputs().begin(),
+                     ins->inputs().end(),
+                     std::back_inserter(inputs),
+                     [&](auto input) { return input != gather_ins; });
+        auto axis = gather_ins->normalized_operator().to_value()["axis"];
+        mpm.get_module().replace_instruction(
+            ins, make_op("fused_gather", {{"axis", axis}}), inputs, {gm});
+    }
+}
+
 namespace {
 struct pointwise_reshape : rewrite_reshapes_base
 {
@@ -256,6 +341,11 @@ void fuse_pointwise::apply(module_pass_manager& mpm) const
             break;
         mpm.run_pass(dead_code_elimination{});
     }
+    if(enable_gather_fusion)
+    {
+        find_gather_pointwise(mpm);
+        mpm.run_pass(dead_code_elimination{});
+    }
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -34,8 +34,9 @@ void fuse_pointwise_reduce::apply(module_pass_manager& mpm) const
 {
     mpm.run_pass(fuse_pointwise{.enable_rewrite_reshapes = false});
     mpm.run_pass(fuse_reduce{.enable_rewrite_reshapes = false});
-    mpm.run_pass(fuse_pointwise{.enable_rewrite_reshapes = true});
-    mpm.run_pass(fuse_reduce{.enable_rewrite_reshapes = true});
+    // Gathers are fused last so the reductions can still absorb the pointwise modules first
+    mpm.run_pass(fuse_pointwise{.enable_rewrite_reshapes = true, .enable_gather_fusion = true});
+    mpm.run_pass(fuse_reduce{.enable_rewrite_reshapes = true, .enable_multi_output = true});
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -58,8 +58,6 @@ struct fused_reduce
         if(mods.size() != 1)
             MIGRAPHX_THROW("should have one submodule.");
         const auto* sm = mods.front();
-        if(sm->get_output_shapes().size() != 1)
-            MIGRAPHX_THROW("Only one output supported");
         if(not sm->bypass())
             MIGRAPHX_THROW("fused_reduce: bypass flag is not set");
         auto names = sm->get_parameter_names();
@@ -72,9 +70,14 @@ struct fused_reduce
            }))
             MIGRAPHX_THROW("Input dimension does not match the submodule.");
 
-        return shape::from_permutation(sm->get_output_shapes().front().type(),
-                                       sm->get_output_shapes().front().lens(),
-                                       find_permutation(inputs));
+        auto perm = find_permutation(inputs);
+        std::vector<shape> outputs;
+        transform(sm->get_output_shapes(), std::back_inserter(outputs), [&](const shape& output) {
+            return shape::from_permutation(output.type(), output.lens(), perm);
+        });
+        if(outputs.size() == 1)
+            return outputs.front();
+        return shape{outputs};
     }
 
     std::string name() const { return "fused_reduce"; }
@@ -92,6 +95,8 @@ MIGRAPHX_PRED_MATCHER(input_output_ndim_match, instruction_ref ins)
     return input_shape.ndim() == output_shape.ndim();
 }
 
+static bool is_arg_reduce(const operation& op) { return contains({"argmax", "argmin"}, op.name()); }
+
 static auto
 insert_module_in_submodule(module_ref sm,
                            instruction_ref ins,
@@ -118,8 +123,11 @@ static void create_reduce_modules(module_pass_manager& mpm)
 
         rm->add_return(rm->fuse({ins}));
         auto v = ins->get_operator().to_value();
+        // Arg reductions only reduce a single axis
+        auto axes = v.contains("axis") ? std::vector<std::int64_t>{v.at("axis").to<std::int64_t>()}
+                                       : v.at("axes").to_vector<std::int64_t>();
         mpm.get_module().replace_instruction(
-            ins, make_op("fused_reduce", {{"axes", v["axes"]}}), ins->inputs(), {rm});
+            ins, make_op("fused_reduce", {{"axes", axes}}), ins->inputs(), {rm});
     }
 }
 
@@ -316,6 +324,81 @@ struct find_reduce_reduce
     }
 };
 
+// Fuse a pointwise input that has other users into the reduction, and also return it from the
+// fused_reduce so the other users read it from there instead of it being written separately.
+struct find_pointwise_reduce_multi_output
+{
+    auto matcher() const
+    {
+        return match::name("fused_reduce")(any_input(match::name("pointwise").bind("pointwise")));
+    }
+
+    void apply(module_pass_manager& mpm, const match::matcher_result& r) const
+    {
+        auto& m     = mpm.get_module();
+        auto reduce = r.result;
+        auto input  = r.instructions["pointwise"];
+        if(input->outputs().size() < 2 or input->get_shape().type() == shape::tuple_type)
+            return;
+        // The pointwise output is written with the lens of the input to the reduction
+        auto rinput = std::max_element(reduce->inputs().begin(),
+                                       reduce->inputs().end(),
+                                       by(std::less<>{}, [](instruction_ref i) {
+                                           return i->get_shape().elements();
+                                       }));
+        if(input->get_shape().lens() != (*rinput)->get_shape().lens())
+            return;
+        std::vector<instruction_ref> others;
+        std::copy_if(input->outputs().begin(),
+                     input->outputs().end(),
+                     std::back_inserter(others),
+                     [&](instruction_ref output) { return output != reduce; });
+        // The other users need to come after the reduction since they will use its output
+        if(std::any_of(others.begin(), others.end(), [&](instruction_ref output) {
+               return std::find(std::next(reduce), m.end(), output) == m.end();
+           }))
+            return;
+
+        const auto* pm     = input->module_inputs().front();
+        const auto* old_rm = reduce->module_inputs().front();
+
+        auto* rm = mpm.create_module(pm->name() + ":" + old_rm->name());
+        rm->set_bypass();
+        std::unordered_map<instruction_ref, instruction_ref> map_ins;
+        auto rins      = rm->fuse({input}, &map_ins).front();
+        map_ins[input] = rins;
+        auto outs      = insert_module_in_submodule(rm, reduce, &map_ins);
+        auto noutputs  = outs.size();
+        outs.push_back(rins);
+        rm->add_return(outs);
+        finalize_reduce_module(rm);
+
+        auto new_inputs = find_inputs(map_ins, &m, rm);
+        auto fused      = m.insert_instruction(reduce, reduce->get_operator(), new_inputs, {rm});
+
+        auto get_output = [&](std::size_t i) {
+            return m.insert_instruction(reduce, make_op("get_tuple_elem", {{"index", i}}), fused);
+        };
+        auto pointwise_output = get_output(noutputs);
+        for(auto output : others)
+        {
+            auto args = output->inputs();
+            std::replace(args.begin(), args.end(), input, pointwise_output);
+            m.replace_instruction(output, output->get_operator(), args, output->module_inputs());
+        }
+        if(noutputs == 1)
+        {
+            m.replace_instruction(reduce, get_output(0));
+        }
+        else
+        {
+            // Already a tuple, so the users just select from the new fused_reduce
+            for(auto output : reduce->outputs())
+                m.replace_instruction(output, output->get_operator(), fused);
+        }
+    }
+};
+
 struct reduce_reshape : rewrite_reshapes_base
 {
     static std::string name() { return "fused_reduce"; }
@@ -354,6 +437,12 @@ struct reduce_reshape : rewrite_reshapes_base
         auto outs = sm->fuse(*oldm, inputs, nullptr, transform_op([&](const operation& sop) {
             if(contains(sop.name(), "reduce"))
                 return make_op(sop.name(), {{"axes", axes}});
+            if(is_arg_reduce(sop))
+            {
+                auto v    = sop.to_value();
+                v["axis"] = axes.front();
+                return make_op(sop.name(), v);
+            }
             if(sop.name() == "multibroadcast")
                 return make_op("multibroadcast", {{"out_lens", dims}});
             assert(sop.name() == "pointwise");
@@ -363,6 +452,20 @@ struct reduce_reshape : rewrite_reshapes_base
         return mpm.get_module().insert_instruction(ins, fused_reduce{axes}, inputs, {sm});
     }
 
+    // Arg reductions only have one axis, so it can't be split into several axes by the reshape
+    template <class AxesMap>
+    static bool supports(instruction_ref ins, std::vector<std::size_t>&, const AxesMap& am)
+    {
+        const auto* rm = ins->module_inputs().front();
+        if(std::none_of(rm->begin(), rm->end(), [](const auto& i) {
+               return is_arg_reduce(i.get_operator());
+           }))
+            return true;
+        auto op = any_cast<fused_reduce>(ins->get_operator());
+        return std::all_of(
+            op.axes.begin(), op.axes.end(), [&](auto axis) { return am.at(axis).size() == 1; });
+    }
+
     static std::vector<std::size_t> base_dims(const std::vector<instruction_ref>& inputs)
     {
         auto input = std::max_element(inputs.begin(), inputs.end(), by(std::less<>{}, [](auto i) {
@@ -393,6 +496,13 @@ void fuse_reduce::apply(module_pass_manager& mpm) const
             mpm, find_reduce_pointwise{}, find_pointwise_reduce{}, find_reduce_reduce{});
         mpm.run_pass(dead_code_elimination{});
     }
+    // Only done once everything else is fused, since the other fusions don't go through the
+    // tuple outputs
+    if(enable_multi_output)
+    {
+        match::find_matches(mpm, find_pointwise_reduce_multi_output{});
+        mpm.run_pass(dead_code_elimination{});
+    }
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -22,10 +22,100 @@
  * THE SOFTWARE.
  */
 #include <migraphx/generate.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/par_for.hpp>
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+// A step of the xorshf96 generator is linear over the bits of its state, so it can be written as
+// a matrix with a column for each bit. Jumping ahead n steps is then a multiply by its nth power.
+struct xorshf96_matrix
+{
+    static constexpr std::size_t bits = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<xorshf96_state> columns;
+
+    static xorshf96_matrix step()
+    {
+        xorshf96_matrix result;
+        for(std::size_t i = 0; i < 3 * bits; ++i)
+        {
+            xorshf96_state e{};
+            e[i / bits] = 1UL << (i % bits);
+            xorshf96_generator<unsigned long> gen{e, random_mode::legacy};
+            gen.step();
+            result.columns.push_back({gen.x, gen.y, gen.z});
+        }
+        return result;
+    }
+
+    xorshf96_state operator()(const xorshf96_state& v) const
+    {
+        xorshf96_state result{};
+        for(std::size_t i = 0; i < 3 * bits; ++i)
+        {
+            if(((v[i / bits] >> (i % bits)) & 1UL) == 0)
+                continue;
+            const auto& c = columns[i];
+            std::transform(
+                result.begin(), result.end(), c.begin(), result.begin(), std::bit_xor<>{});
+        }
+        return result;
+    }
+
+    friend xorshf96_matrix operator*(const xorshf96_matrix& a, const xorshf96_matrix& b)
+    {
+        xorshf96_matrix result;
+        std::transform(b.columns.begin(),
+                       b.columns.end(),
+                       std::back_inserter(result.columns),
+                       [&](const auto& c) { return a(c); });
+        return result;
+    }
+
+    static xorshf96_matrix power(std::size_t n)
+    {
+        assert(n > 0);
+        auto x = step();
+        optional<xorshf96_matrix> result;
+        for(; n > 0; n >>= 1U)
+        {
+            if((n & 1U) != 0)
+                result = result.has_value() ? *result * x : x;
+            if(n > 1)
+                x = x * x;
+        }
+        return *result;
+    }
+};
+
+void par_generate(std::size_t n,
+                  unsigned long seed,
+                  const std::function<void(std::size_t, std::size_t, const xorshf96_state&)>& f)
+{
+    // Fixed so the values don't depend on the number of threads
+    const std::size_t chunk_size = 1UL << 16U;
+    xorshf96_generator<unsigned long> gen{seed, random_mode::legacy};
+    xorshf96_state state{gen.x, gen.y, gen.z};
+    if(n <= chunk_size)
+    {
+        f(0, n, state);
+        return;
+    }
+    static const auto jump = xorshf96_matrix::power(chunk_size);
+    std::vector<xorshf96_state> states{state};
+    while(states.size() * chunk_size < n)
+        states.push_back(jump(states.back()));
+    par_for(states.size(), 1, [&](std::size_t i) {
+        auto start = i * chunk_size;
+        f(start, std::min(n, start + chunk_size), states[i]);
+    });
+}
+
 argument fill_argument(shape s, double value)
 {
     argument result;
@@ -91,7 +181,7 @@ literal generate_literal(shape s, unsigned long seed)
     s.visit_type([&](auto as) {
         using type = typename decltype(as)::type;
         auto v     = generate_tensor_data<type>(s, seed);
-        result     = {s, reinterpret_cast<char*>(v.get())};
+        result     = {s, std::shared_ptr<char>(v, reinterpret_cast<char*>(v.get()))};
     });
     return result;
 }
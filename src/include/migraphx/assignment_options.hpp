@@ -32,6 +32,12 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct assignment_options
 {
     support_metric metric = support_metric::latency;
+    // Weigh the metrics of the supported segments against the cost of copying values between
+    // targets, instead of using the first target that supports each instruction
+    bool minimize_cost = true;
+    // Cost of copying one byte between targets in the units of the segment metrics, which by
+    // default is the time in milliseconds over a 16 GB/s link
+    double copy_cost = 1.0 / 16e6;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
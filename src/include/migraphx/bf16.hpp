@@ -0,0 +1,194 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MIGRAPHX_GUARD_RTGLIB_BF16_HPP
+#define MIGRAPHX_GUARD_RTGLIB_BF16_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <migraphx/config.hpp>
+#include <migraphx/bit_cast.hpp>
+#include <migraphx/half.hpp>
+#include <migraphx/float8.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// brain floating point: the upper 16 bits of an IEEE float (s1e8m7). Arithmetic is done in float,
+// and values are rounded to nearest even when converting back.
+struct bf16
+{
+    uint16_t data = 0x0000;
+
+    constexpr bf16()              = default;
+    constexpr bf16(const bf16& y) = default;
+    struct from_bits_t
+    {
+    };
+    static constexpr from_bits_t from_bits() { return from_bits_t(); }
+
+    explicit constexpr bf16(uint16_t bits, from_bits_t) : data(bits) {}
+
+    explicit constexpr bf16(float v) : data(round_to_bits(v)) {}
+
+    inline constexpr operator float() const
+    {
+        return migraphx::bit_cast<float>(static_cast<uint32_t>(data) << 16u);
+    }
+
+    inline explicit constexpr operator bool() const { return not is_zero(); }
+
+    inline constexpr bool is_zero() const { return (data & 0x7FFF) == 0; }
+
+    inline constexpr bool is_nan() const
+    {
+        return (data & 0x7F80) == 0x7F80 and (data & 0x007F) != 0;
+    }
+
+    inline constexpr bool is_inf() const { return (data & 0x7FFF) == 0x7F80; }
+
+// NOLINTNEXTLINE
+#define MIGRAPHX_BF16_UNARY_OP(unary_op, binary_op)                                   \
+    constexpr bf16& operator unary_op(const bf16& rhs)                                \
+    {                                                                                 \
+        const auto tmp = static_cast<float>(*this) binary_op static_cast<float>(rhs); \
+        *this          = static_cast<bf16>(tmp);                                      \
+        return *this;                                                                 \
+    }                                                                                 \
+    constexpr bf16& operator unary_op(const float& rhs)                               \
+    {                                                                                 \
+        const auto tmp = static_cast<float>(*this) binary_op rhs;                     \
+        *this          = static_cast<bf16>(tmp);                                      \
+        return *this;                                                                 \
+    }
+
+    MIGRAPHX_BF16_UNARY_OP(*=, *)
+    MIGRAPHX_BF16_UNARY_OP(-=, -)
+    MIGRAPHX_BF16_UNARY_OP(+=, +)
+    MIGRAPHX_BF16_UNARY_OP(/=, /)
+
+    inline constexpr bf16& operator=(const bf16& rhs)     = default;
+    inline constexpr bf16& operator=(bf16&& rhs) noexcept = default;
+
+    inline constexpr bf16& operator=(float rhs)
+    {
+        *this = static_cast<bf16>(rhs);
+        return *this;
+    }
+
+    private:
+    static constexpr uint16_t round_to_bits(float v)
+    {
+        auto bits = migraphx::bit_cast<uint32_t>(v);
+        // Keep nans quiet, truncating could turn them into infinities
+        if((bits & 0x7F800000u) == 0x7F800000u and (bits & 0x007FFFFFu) != 0)
+            return static_cast<uint16_t>((bits >> 16u) | 0x0040u);
+        // Round to nearest even
+        bits += 0x7FFFu + ((bits >> 16u) & 1u);
+        return static_cast<uint16_t>(bits >> 16u);
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const bf16& rhs)
+{
+    return os << static_cast<float>(rhs);
+}
+
+inline bf16 fabs(bf16 v)
+{
+    v.data = v.data & 0x7FFF; // NOLINT
+    return v;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+// NOLINTBEGIN
+namespace std {
+
+inline bool isfinite(migraphx::bf16 x) { return not x.is_inf() and not x.is_nan(); }
+inline bool isnan(migraphx::bf16 x) { return x.is_nan(); }
+inline bool isinf(migraphx::bf16 x) { return x.is_inf(); }
+
+template <>
+class numeric_limits<migraphx::bf16> : public numeric_limits<float>
+{
+    using type = migraphx::bf16;
+
+    public:
+    static constexpr int digits       = 8;
+    static constexpr int digits10     = 2;
+    static constexpr int max_digits10 = 4;
+
+    static constexpr type epsilon() { return type(0x3C00, type::from_bits()); }
+    static constexpr type quiet_NaN() { return type(0x7FC0, type::from_bits()); }
+    static constexpr type signaling_NaN() { return type(0x7FA0, type::from_bits()); }
+    static constexpr type infinity() { return type(0x7F80, type::from_bits()); }
+    static constexpr type max() { return type(0x7F7F, type::from_bits()); }
+    static constexpr type min() { return type(0x0080, type::from_bits()); }
+    static constexpr type lowest() { return type(0xFF7F, type::from_bits()); }
+    static constexpr type denorm_min() { return type(0x0001, type::from_bits()); }
+    static constexpr type round_error() { return type(0x3F00, type::from_bits()); }
+};
+
+template <class U>
+struct common_type<migraphx::bf16, U> : std::common_type<float, U>
+{
+};
+
+template <class U>
+struct common_type<U, migraphx::bf16> : std::common_type<U, float>
+{
+};
+
+template <>
+struct common_type<migraphx::bf16, migraphx::bf16>
+{
+    using type = migraphx::bf16;
+};
+
+// needed to resolve between multiple ambiguous definition from previous templates
+#define MIGRAPHX_BF16_COMMON_TYPE_OVERLOAD_RESOLUTION(T)                   \
+    template <>                                                            \
+    struct common_type<migraphx::bf16, T> : std::common_type<float, float> \
+    {                                                                      \
+    };                                                                     \
+    template <>                                                            \
+    struct common_type<T, migraphx::bf16> : std::common_type<float, float> \
+    {                                                                      \
+    };
+
+MIGRAPHX_BF16_COMMON_TYPE_OVERLOAD_RESOLUTION(migraphx::half)
+MIGRAPHX_BF16_COMMON_TYPE_OVERLOAD_RESOLUTION(migraphx::fp8::fp8e4m3fn)
+MIGRAPHX_BF16_COMMON_TYPE_OVERLOAD_RESOLUTION(migraphx::fp8::fp8e5m2)
+MIGRAPHX_BF16_COMMON_TYPE_OVERLOAD_RESOLUTION(migraphx::fp8::fp8e4m3fnuz)
+MIGRAPHX_BF16_COMMON_TYPE_OVERLOAD_RESOLUTION(migraphx::fp8::fp8e5m2fnuz)
+
+} // namespace std
+// NOLINTEND
+
+#endif // MIGRAPHX_GUARD_RTGLIB_BF16_HPP
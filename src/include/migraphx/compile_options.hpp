@@ -26,6 +26,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/tracer.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,6 +42,60 @@ struct compile_options
     bool fast_math       = true;
     bool exhaustive_tune = false;
 
+    /**
+     * Start with the default tuning solutions and tune the kernels in the background
+     * after the program is compiled, for targets that support it. Faster kernels are
+     * swapped in as they are found and the solutions are saved to the problem cache.
+     */
+    bool background_tune = false;
+
+    /**
+     * Compile the kernels of control flow submodules, such as the branches of an if
+     * or the select_module variants, the first time they run instead of up front,
+     * for targets that support it.
+     */
+    bool lazy_compile = false;
+
+    /**
+     * Capture the device work of the program the first time it runs and
+     * replay it on later evaluations, for targets that support it.
+     */
+    bool capture_graph = false;
+
+    /**
+     * Record where the literals end up in the compiled program, so
+     * program::update_weights can later swap in the weights of a program
+     * with the same structure without recompiling it.
+     */
+    bool record_weights = false;
+
+    /**
+     * When nonzero, recompute cheap activations close to their late uses instead of
+     * keeping them live, until the estimated peak memory (in bytes) fits this budget.
+     */
+    std::size_t memory_budget = 0;
+
+    /**
+     * When nonzero, keep at most this many bytes of literals on the device, for
+     * targets that support it. The rest stay in pinned host memory and are
+     * copied to the device ahead of their use each time the program runs.
+     */
+    std::size_t weight_budget = 0;
+
+    /**
+     * Save the program to checkpoint_file right after the first pass named
+     * checkpoint_pass runs. The snapshot is saved as an uncompiled program, so it can
+     * be loaded, changed and compiled again with resume_pass to skip the passes before it.
+     */
+    std::string checkpoint_pass = "";
+    std::string checkpoint_file = "";
+
+    /**
+     * Skip the passes up to and including the first one with this name, for a
+     * program loaded from a checkpoint saved after that pass.
+     */
+    std::string resume_pass = "";
+
     tracer trace{};
 };
 
@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_COMPILE_PROFILE_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_COMPILE_PROFILE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// A timed piece of compile work, such as a pass, a kernel compile or a benchmark
+struct compile_span
+{
+    /// The kind of work, such as "pass", "compile" or "benchmark"
+    std::string category;
+    std::string name;
+    value args         = value::object{};
+    /// Microseconds since the profile started
+    double start       = 0;
+    double duration    = 0;
+    /// A small number for the thread the work ran on
+    std::size_t thread = 0;
+};
+
+/// Whether spans are recorded, which is enabled when MIGRAPHX_COMPILE_PROFILE is set to the path
+/// of the trace that program::compile writes.
+///
+/// The profile is shared by the whole process: each program::compile resets it and writes it out,
+/// so spans of compiles that run at the same time end up mixed in one trace. Profiling concurrent
+/// compiles is not supported; compile one program at a time while the profile is enabled.
+MIGRAPHX_EXPORT bool compile_profile_enabled();
+
+MIGRAPHX_EXPORT void enable_compile_profile(bool b = true);
+
+/// Records a span from its construction to its destruction when the profile is enabled, and
+/// otherwise does nothing. Can be used from any thread, and spans on the same thread nest.
+struct MIGRAPHX_EXPORT compile_profile_scope
+{
+    compile_profile_scope(std::string category, std::string name, value args = value::object{});
+    compile_profile_scope(const compile_profile_scope&)            = delete;
+    compile_profile_scope& operator=(const compile_profile_scope&) = delete;
+    ~compile_profile_scope();
+
+    bool enabled() const { return active; }
+
+    /// Add an argument found while the work runs, such as whether it hit a cache
+    void add(const std::string& key, value v);
+
+    private:
+    bool active = false;
+    compile_span span;
+    std::chrono::steady_clock::time_point begin;
+};
+
+MIGRAPHX_EXPORT std::vector<compile_span> get_compile_profile();
+
+MIGRAPHX_EXPORT void reset_compile_profile();
+
+/// Write the spans as a Chrome trace, which can be opened with chrome://tracing or Perfetto
+MIGRAPHX_EXPORT void write_compile_profile(std::ostream& os);
+
+/// Write the trace to the path in MIGRAPHX_COMPILE_PROFILE when it is set
+MIGRAPHX_EXPORT void save_compile_profile();
+
+/// Print the total time of each category and of the slowest spans of each category
+MIGRAPHX_EXPORT void print_compile_profile_summary(std::ostream& os, std::size_t top = 10);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_COMPILE_PROFILE_HPP
@@ -31,6 +31,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <migraphx/instruction_ref.hpp>
 #include <migraphx/operation.hpp>
 #include <migraphx/op/concat.hpp>
 #include <migraphx/optional.hpp>
@@ -48,10 +49,23 @@ struct concat_optimization
     std::string allocate() const;
     /// Return the target-independent concat operator
     optional<op::concat> get_concat(const operation& op) const;
+    /// Whether the instruction can write its output into a strided view of the concat buffer,
+    /// which is needed to concat along an axis that is not the outermost
+    bool supports_strided_output(instruction_ref ins) const;
 };
 
 #else
 
+namespace detail {
+
+template <class T>
+bool concat_opt_supports_strided_output(const T&, instruction_ref)
+{
+    return false;
+}
+
+} // namespace detail
+
 #ifdef TYPE_ERASED_DECLARATION
 
 // Type-erased interface for:
@@ -61,6 +75,8 @@ struct MIGRAPHX_EXPORT concat_optimization
     std::string allocate() const;
     //
     optional<op::concat> get_concat(const operation& op) const;
+    //
+    bool supports_strided_output(instruction_ref ins) const;
 };
 
 #else
@@ -68,6 +84,23 @@ struct MIGRAPHX_EXPORT concat_optimization
 struct concat_optimization
 {
     private:
+    template <class T>
+    static auto private_detail_te_default_supports_strided_output(char,
+                                                                  T&& private_detail_te_self,
+                                                                  instruction_ref ins)
+        -> decltype(private_detail_te_self.supports_strided_output(ins))
+    {
+        return private_detail_te_self.supports_strided_output(ins);
+    }
+
+    template <class T>
+    static bool private_detail_te_default_supports_strided_output(float,
+                                                                  T&& private_detail_te_self,
+                                                                  instruction_ref ins)
+    {
+        return migraphx::detail::concat_opt_supports_strided_output(private_detail_te_self, ins);
+    }
+
     template <class PrivateDetailTypeErasedT>
     struct private_te_unwrap_reference
     {
@@ -87,6 +120,10 @@ struct concat_optimization
         decltype(std::declval<PrivateDetailTypeErasedT>().allocate(),
                  std::declval<PrivateDetailTypeErasedT>().get_concat(
                      std::declval<const operation&>()),
+                 private_detail_te_default_supports_strided_output(
+                     char(0),
+                     std::declval<PrivateDetailTypeErasedT>(),
+                     std::declval<instruction_ref>()),
                  void());
 
     template <class PrivateDetailTypeErasedT>
@@ -175,6 +212,12 @@ struct concat_optimization
         return (*this).private_detail_te_get_handle().get_concat(op);
     }
 
+    bool supports_strided_output(instruction_ref ins) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().supports_strided_output(ins);
+    }
+
     friend bool is_shared(const concat_optimization& private_detail_x,
                           const concat_optimization& private_detail_y)
     {
@@ -191,6 +234,7 @@ struct concat_optimization
 
         virtual std::string allocate() const                               = 0;
         virtual optional<op::concat> get_concat(const operation& op) const = 0;
+        virtual bool supports_strided_output(instruction_ref ins) const    = 0;
     };
 
     template <typename PrivateDetailTypeErasedT>
@@ -229,6 +273,13 @@ struct concat_optimization
             return private_detail_te_value.get_concat(op);
         }
 
+        bool supports_strided_output(instruction_ref ins) const override
+        {
+
+            return private_detail_te_default_supports_strided_output(
+                char(0), private_detail_te_value, ins);
+        }
+
         PrivateDetailTypeErasedT private_detail_te_value;
     };
 
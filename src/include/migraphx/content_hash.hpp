@@ -0,0 +1,51 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_CONTENT_HASH_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_CONTENT_HASH_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct argument;
+struct literal;
+
+/// A 128-bit hash of the bytes as a hex string, which is stable across builds so it can be used
+/// in on-disk keys. Buffers larger than a few megabytes are hashed in chunks on the thread pool.
+MIGRAPHX_EXPORT std::string content_hash(const char* data, std::size_t n);
+
+/// Hash of the data of an argument, where tuples combine the hashes of their elements
+MIGRAPHX_EXPORT std::string content_hash(const argument& a);
+
+/// Computes the cached hashes of the literals, in parallel across the small literals and within
+/// each large one
+MIGRAPHX_EXPORT void compute_content_hashes(const std::vector<literal>& lits);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_CONTENT_HASH_HPP
@@ -50,6 +50,8 @@ struct context
 
 #else
 
+struct context;
+
 template <class T>
 value to_value_context(const T&)
 {
@@ -77,6 +79,30 @@ void finish_on_context(T&, any_ptr)
 {
 }
 
+template <class T>
+void on_finish_context(T& ctx, any_ptr, std::function<void()> callback)
+{
+    ctx.finish();
+    callback();
+}
+
+template <class T>
+void set_priority_context(T&, int)
+{
+}
+
+template <class T>
+value memory_usage_context(const T&)
+{
+    return value::object{};
+}
+
+template <class T>
+context create_session_context(const T& x);
+
+template <class T>
+context create_replica_context(const T& x, std::size_t);
+
 #ifdef TYPE_ERASED_DECLARATION
 
 // Type-erased interface for:
@@ -92,6 +118,16 @@ struct MIGRAPHX_EXPORT context
     void wait_for(any_ptr queue);
     // (optional)
     void finish_on(any_ptr queue);
+    // (optional)
+    void on_finish(any_ptr queue, std::function<void()> callback);
+    // (optional)
+    void set_priority(int priority);
+    // (optional)
+    value memory_usage() const;
+    // (optional)
+    context create_session() const;
+    // (optional)
+    context create_replica(std::size_t device_id) const;
     //
     void finish() const;
 };
@@ -169,6 +205,83 @@ struct context
         finish_on_context(private_detail_te_self, queue);
     }
 
+    template <class T>
+    static auto private_detail_te_default_on_finish(char,
+                                                    T&& private_detail_te_self,
+                                                    any_ptr queue,
+                                                    std::function<void()> callback)
+        -> decltype(private_detail_te_self.on_finish(queue, callback))
+    {
+        private_detail_te_self.on_finish(queue, callback);
+    }
+
+    template <class T>
+    static void private_detail_te_default_on_finish(float,
+                                                    T&& private_detail_te_self,
+                                                    any_ptr queue,
+                                                    std::function<void()> callback)
+    {
+        on_finish_context(private_detail_te_self, queue, callback);
+    }
+
+    template <class T>
+    static auto
+    private_detail_te_default_set_priority(char, T&& private_detail_te_self, int priority)
+        -> decltype(private_detail_te_self.set_priority(priority))
+    {
+        private_detail_te_self.set_priority(priority);
+    }
+
+    template <class T>
+    static void
+    private_detail_te_default_set_priority(float, T&& private_detail_te_self, int priority)
+    {
+        set_priority_context(private_detail_te_self, priority);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_memory_usage(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.memory_usage())
+    {
+        return private_detail_te_self.memory_usage();
+    }
+
+    template <class T>
+    static value private_detail_te_default_memory_usage(float, T&& private_detail_te_self)
+    {
+        return memory_usage_context(private_detail_te_self);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_create_session(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.create_session())
+    {
+        return private_detail_te_self.create_session();
+    }
+
+    template <class T>
+    static context private_detail_te_default_create_session(float, T&& private_detail_te_self)
+    {
+        return create_session_context(private_detail_te_self);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_create_replica(char,
+                                                         T&& private_detail_te_self,
+                                                         std::size_t device_id)
+        -> decltype(private_detail_te_self.create_replica(device_id))
+    {
+        return private_detail_te_self.create_replica(device_id);
+    }
+
+    template <class T>
+    static context private_detail_te_default_create_replica(float,
+                                                            T&& private_detail_te_self,
+                                                            std::size_t device_id)
+    {
+        return create_replica_context(private_detail_te_self, device_id);
+    }
+
     template <class PrivateDetailTypeErasedT>
     struct private_te_unwrap_reference
     {
@@ -196,6 +309,19 @@ struct context
                      char(0), std::declval<PrivateDetailTypeErasedT>(), std::declval<any_ptr>()),
                  private_detail_te_default_finish_on(
                      char(0), std::declval<PrivateDetailTypeErasedT>(), std::declval<any_ptr>()),
+                 private_detail_te_default_on_finish(char(0),
+                                                     std::declval<PrivateDetailTypeErasedT>(),
+                                                     std::declval<any_ptr>(),
+                                                     std::declval<std::function<void()>>()),
+                 private_detail_te_default_set_priority(
+                     char(0), std::declval<PrivateDetailTypeErasedT>(), std::declval<int>()),
+                 private_detail_te_default_memory_usage(char(0),
+                                                        std::declval<PrivateDetailTypeErasedT>()),
+                 private_detail_te_default_create_session(char(0),
+                                                          std::declval<PrivateDetailTypeErasedT>()),
+                 private_detail_te_default_create_replica(char(0),
+                                                          std::declval<PrivateDetailTypeErasedT>(),
+                                                          std::declval<std::size_t>()),
                  std::declval<PrivateDetailTypeErasedT>().finish(),
                  void());
 
@@ -301,6 +427,36 @@ struct context
         (*this).private_detail_te_get_handle().finish_on(queue);
     }
 
+    void on_finish(any_ptr queue, std::function<void()> callback)
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        (*this).private_detail_te_get_handle().on_finish(queue, std::move(callback));
+    }
+
+    void set_priority(int priority)
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        (*this).private_detail_te_get_handle().set_priority(priority);
+    }
+
+    value memory_usage() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().memory_usage();
+    }
+
+    context create_session() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().create_session();
+    }
+
+    context create_replica(std::size_t device_id) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().create_replica(device_id);
+    }
+
     void finish() const
     {
         assert((*this).private_detail_te_handle_mem_var);
@@ -320,12 +476,17 @@ struct context
         virtual std::shared_ptr<private_detail_te_handle_base_type> clone() const = 0;
         virtual const std::type_info& type() const                                = 0;
 
-        virtual value to_value() const          = 0;
-        virtual void from_value(const value& v) = 0;
-        virtual any_ptr get_queue()             = 0;
-        virtual void wait_for(any_ptr queue)    = 0;
-        virtual void finish_on(any_ptr queue)   = 0;
-        virtual void finish() const             = 0;
+        virtual value to_value() const                                        = 0;
+        virtual void from_value(const value& v)                               = 0;
+        virtual any_ptr get_queue()                                           = 0;
+        virtual void wait_for(any_ptr queue)                                  = 0;
+        virtual void finish_on(any_ptr queue)                                 = 0;
+        virtual void on_finish(any_ptr queue, std::function<void()> callback) = 0;
+        virtual void set_priority(int priority)                               = 0;
+        virtual value memory_usage() const                                    = 0;
+        virtual context create_session() const                                = 0;
+        virtual context create_replica(std::size_t device_id) const           = 0;
+        virtual void finish() const                                           = 0;
     };
 
     template <typename PrivateDetailTypeErasedT>
@@ -386,6 +547,38 @@ struct context
             private_detail_te_default_finish_on(char(0), private_detail_te_value, queue);
         }
 
+        void on_finish(any_ptr queue, std::function<void()> callback) override
+        {
+
+            private_detail_te_default_on_finish(
+                char(0), private_detail_te_value, queue, std::move(callback));
+        }
+
+        void set_priority(int priority) override
+        {
+
+            private_detail_te_default_set_priority(char(0), private_detail_te_value, priority);
+        }
+
+        value memory_usage() const override
+        {
+
+            return private_detail_te_default_memory_usage(char(0), private_detail_te_value);
+        }
+
+        context create_session() const override
+        {
+
+            return private_detail_te_default_create_session(char(0), private_detail_te_value);
+        }
+
+        context create_replica(std::size_t device_id) const override
+        {
+
+            return private_detail_te_default_create_replica(
+                char(0), private_detail_te_value, device_id);
+        }
+
         void finish() const override { private_detail_te_value.finish(); }
 
         PrivateDetailTypeErasedT private_detail_te_value;
@@ -454,6 +647,18 @@ inline const ValueType& any_cast(const context& x)
 }
 #endif
 
+template <class T>
+context create_session_context(const T& x)
+{
+    return x;
+}
+
+template <class T>
+context create_replica_context(const T& x, std::size_t)
+{
+    return x;
+}
+
 inline void migraphx_to_value(value& v, const context& ctx) { v = ctx.to_value(); }
 
 inline void migraphx_from_value(const value& v, context& ctx) { ctx.from_value(v); }
@@ -46,6 +46,10 @@ void convolution(
     auto wei_c    = wei_lens[1];
     std::vector<std::size_t> win_size(wei_lens.begin() + 1, wei_lens.end());
 
+    const auto& in_strides  = input.get_shape().strides();
+    const auto& wei_strides = weights.get_shape().strides();
+    shape win_shape{output_shape.type(), win_size};
+
     par_for(output_shape.elements(), [&](auto i) {
         auto idx_o = output_shape.multi(i);
         auto w     = idx_o[1];
@@ -60,37 +64,28 @@ void convolution(
         }
         const auto group_id = w / (wei_n / group);
 
-        shape win_shape{output_shape.type(), win_size};
+        // Offsets are built from the strides directly so the window loop does not allocate
+        const auto in_base  = idx_o[0] * in_strides[0];
+        const auto wei_base = w * wei_strides[0];
 
         double acc = 0.0;
         shape_for_each(win_shape, [&](const auto& idx_win) {
             auto k           = idx_win[0];
             const auto in_ch = group_id * wei_c + k;
-            std::vector<std::ptrdiff_t> idx(idx_o.begin(), idx_o.end());
-            idx[1] = in_ch;
-            std::vector<std::ptrdiff_t> idx_dil(idx_win.size() - 1);
-            std::transform(idx_win.cbegin() + 1,
-                           idx_win.cend(),
-                           dilation.cbegin(),
-                           idx_dil.begin(),
-                           [](std::ptrdiff_t ii, std::ptrdiff_t d) { return d * ii; });
-            std::transform(idx_dil.begin(),
-                           idx_dil.end(),
-                           win_start.begin(),
-                           idx.begin() + 2,
-                           [](std::ptrdiff_t ii, std::ptrdiff_t jj) { return ii + jj; });
-            std::vector<std::ptrdiff_t> idx_wei(idx_o.size());
-            idx_wei[0] = w;
-            std::copy(idx_win.begin(), idx_win.end(), idx_wei.begin() + 1);
-            if(std::all_of(idx.begin() + 2, idx.end(), [&](auto ii) { return ii >= 0; }) and
-               std::equal(idx.begin(),
-                          idx.end(),
-                          in_lens.begin(),
-                          in_lens.end(),
-                          std::less<std::ptrdiff_t>{}))
+            if(in_ch >= in_lens[1])
+                return;
+            std::size_t in_off  = in_base + in_ch * in_strides[1];
+            std::size_t wei_off = wei_base + k * wei_strides[1];
+            for(std::size_t dim = 2; dim < n_dim; ++dim)
             {
-                acc += input(idx.begin(), idx.end()) * weights(idx_wei.begin(), idx_wei.end());
+                auto d_2 = dim - 2;
+                auto x   = win_start[d_2] + std::ptrdiff_t(dilation[d_2] * idx_win[dim - 1]);
+                if(x < 0 or x >= std::ptrdiff_t(in_lens[dim]))
+                    return;
+                in_off += x * in_strides[dim];
+                wei_off += idx_win[dim - 1] * wei_strides[dim];
             }
+            acc += input.data()[in_off] * weights.data()[wei_off];
         });
 
         output[i] = acc;
@@ -42,6 +42,7 @@ struct MIGRAPHX_EXPORT dead_code_elimination
     std::string name() const { return "dead_code_elimination"; }
     void apply(module& m) const;
     void apply(program& p) const;
+    bool parallel() const { return true; }
 };
 
 } // namespace MIGRAPHX_INLINE_NS
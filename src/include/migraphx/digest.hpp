@@ -0,0 +1,85 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_DIGEST_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_DIGEST_HPP
+
+#include <migraphx/config.hpp>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// FNV-1a is used instead of std::hash so keys are stable across builds and
+// standard libraries sharing the same cache directory
+struct fnv1a
+{
+    std::uint64_t state = 0;
+
+    explicit fnv1a(std::uint64_t seed) : state(seed) {}
+
+    void update(std::string_view s)
+    {
+        std::uint64_t n = s.size();
+        for(std::size_t i = 0; i < sizeof(n); i++)
+            update_byte((n >> (8 * i)) & 0xffu);
+        for(char c : s)
+            update_byte(static_cast<unsigned char>(c));
+    }
+
+    void update_byte(std::uint64_t b)
+    {
+        state ^= b;
+        state *= 0x100000001b3ull;
+    }
+};
+
+// A 128-bit key for the on-disk caches
+struct digest
+{
+    // Two independent hashes to make accidental collisions negligible
+    fnv1a h1{0xcbf29ce484222325ull};
+    fnv1a h2{0x84222325cbf29ce4ull};
+
+    void update(std::string_view s)
+    {
+        h1.update(s);
+        h2.update(s);
+    }
+
+    std::string str() const
+    {
+        std::stringstream ss;
+        ss << std::hex << std::setfill('0') << std::setw(16) << h1.state << std::setw(16)
+           << h2.state;
+        return ss.str();
+    }
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_DIGEST_HPP
@@ -27,6 +27,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/instruction.hpp>
+#include <memory>
 #include <unordered_map>
 
 namespace migraphx {
@@ -42,6 +43,8 @@ struct MIGRAPHX_EXPORT dominator_info
 };
 
 MIGRAPHX_EXPORT dominator_info compute_dominator(const module& m);
+// Same as compute_dominator, but cached on the module until it changes
+MIGRAPHX_EXPORT std::shared_ptr<const dominator_info> get_dominator_info(const module& m);
 // MIGRAPHX_EXPORT dominator_info compute_dominator_naive(const module& m);
 
 } // namespace MIGRAPHX_INLINE_NS
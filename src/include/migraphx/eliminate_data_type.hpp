@@ -43,6 +43,8 @@ struct MIGRAPHX_EXPORT eliminate_data_type
     std::set<shape::type_t> unsupported_types;
     shape::type_t target_type;
     std::set<std::string> unsupported_ops = {"all"};
+    // Ops that are left in the unsupported types, since the target has its own implementation
+    std::set<std::string> supported_ops = {};
     std::string name() const { return "eliminate_data_type"; }
     void apply(module& m) const;
 };
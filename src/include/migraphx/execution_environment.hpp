@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_MIGRAPHLIB_EXECUTION_ENV_HPP
 
 #include <migraphx/any_ptr.hpp>
+#include <functional>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -33,6 +34,12 @@ struct execution_environment
 {
     any_ptr queue = any_ptr{};
     bool async    = false;
+    // Priority of the queues the program runs on, where a lower value is a higher priority and 0
+    // is the default priority of the target
+    int priority = 0;
+    // Called on the host once the outputs are ready. With async it is called from the queue after
+    // the work the program added to it, so it should return quickly and not wait on the queue.
+    std::function<void()> on_complete = nullptr;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -26,6 +26,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/filesystem.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,20 @@ MIGRAPHX_EXPORT std::vector<char>
 read_buffer(const fs::path& filename, size_t offset = 0, size_t nbytes = 0);
 MIGRAPHX_EXPORT std::string read_string(const fs::path& filename);
 
+/// A read-only view of a whole file. On POSIX systems the file is mapped
+/// into memory rather than read, and it is unmapped once the last copy is
+/// destroyed.
+struct MIGRAPHX_EXPORT mapped_buffer
+{
+    std::shared_ptr<const char> buffer = nullptr;
+    std::size_t nbytes                 = 0;
+
+    const char* data() const { return buffer.get(); }
+    std::size_t size() const { return nbytes; }
+};
+
+MIGRAPHX_EXPORT mapped_buffer map_buffer(const fs::path& filename);
+
 MIGRAPHX_EXPORT void write_string(const fs::path& filename, const std::string& buffer);
 MIGRAPHX_EXPORT void write_buffer(const fs::path& filename, const char* buffer, std::size_t size);
 MIGRAPHX_EXPORT void write_buffer(const fs::path& filename, const std::vector<char>& buffer);
@@ -39,6 +39,9 @@ struct MIGRAPHX_EXPORT fuse_pointwise
 
     bool enable_rewrite_reshapes = true;
     bool enable_rewrite_broadcasts = false;
+    // Fuse a gather into the pointwise module that reads it, which needs target support for the
+    // fused_gather operator
+    bool enable_gather_fusion = false;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
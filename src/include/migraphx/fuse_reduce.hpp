@@ -38,6 +38,7 @@ struct MIGRAPHX_EXPORT fuse_reduce
     void apply(module_pass_manager& mpm) const;
 
     bool enable_rewrite_reshapes = true;
+    bool enable_multi_output     = false;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -25,9 +25,9 @@
 #define MIGRAPHX_GUARD_RTGLIB_GEMM_HPP
 
 #include <migraphx/config.hpp>
-#include <migraphx/dfor.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/tensor_view.hpp>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -44,18 +44,48 @@ void gemm(tensor_view<T> cmat, tensor_view<U> amat, tensor_view<U> bmat, F alpha
     assert(cmat.get_shape().lens()[dim_0] == amat.get_shape().lens()[dim_0]);
     assert(cmat.get_shape().lens()[dim_1] == bmat.get_shape().lens()[dim_1]);
     auto cs = cmat.get_shape();
+    auto as = amat.get_shape();
+    auto bs = bmat.get_shape();
+    auto n  = cs.lens()[dim_1];
+    if(cs.elements() == 0)
+        return;
 
-    par_for(cs.elements(), [&](auto i) {
-        auto c_idx = cs.multi(i);
-        auto a_idx = c_idx;
-        auto b_idx = c_idx;
-        double s   = 0.0;
-        dfor(k)([&](auto kk) {
-            a_idx[dim_1] = b_idx[dim_0] = kk;
-            s += static_cast<double>(amat(a_idx.begin(), a_idx.end())) *
-                 static_cast<double>(bmat(b_idx.begin(), b_idx.end()));
-        });
-        cmat(c_idx.begin(), c_idx.end()) = alpha * s + cmat(c_idx.begin(), c_idx.end()) * beta;
+    // Each task computes one row of C. The row is accumulated in k order with the products
+    // streamed over the columns, so every element is summed in the same order as a naive dot
+    // product while the inner loop runs over contiguous memory and can be vectorized.
+    par_for(cs.elements() / n, [&](auto row) {
+        auto c_idx   = cs.multi(row * n);
+        auto a_idx   = c_idx;
+        auto b_idx   = c_idx;
+        a_idx[dim_1] = 0;
+        b_idx[dim_0] = 0;
+
+        const auto* a  = amat.data() + as.index(a_idx);
+        const auto* b  = bmat.data() + bs.index(b_idx);
+        auto* c        = cmat.data() + cs.index(c_idx);
+        const auto a_k = as.strides()[dim_1];
+        const auto b_k = bs.strides()[dim_0];
+        const auto b_n = bs.strides()[dim_1];
+        const auto c_n = cs.strides()[dim_1];
+
+        std::vector<double> s(n, 0.0);
+        for(std::size_t kk = 0; kk < k; kk++)
+        {
+            const auto x  = static_cast<double>(a[kk * a_k]);
+            const auto* y = b + kk * b_k;
+            if(b_n == 1)
+            {
+                for(std::size_t j = 0; j < n; j++)
+                    s[j] += x * static_cast<double>(y[j]);
+            }
+            else
+            {
+                for(std::size_t j = 0; j < n; j++)
+                    s[j] += x * static_cast<double>(y[j * b_n]);
+            }
+        }
+        for(std::size_t j = 0; j < n; j++)
+            c[j * c_n] = alpha * s[j] + c[j * c_n] * beta;
     });
 }
 
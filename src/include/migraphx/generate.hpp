@@ -28,6 +28,8 @@
 #include <migraphx/literal.hpp>
 #include <migraphx/type_traits.hpp>
 #include <migraphx/config.hpp>
+#include <array>
+#include <functional>
 #include <random>
 
 namespace migraphx {
@@ -78,6 +80,9 @@ constexpr bool normalize(unsigned long z, random_mode)
     return static_cast<bool>(z % 2);
 }
 
+// The x, y and z of a xorshf96_generator
+using xorshf96_state = std::array<unsigned long, 3>;
+
 template <class T>
 struct xorshf96_generator
 {
@@ -88,7 +93,12 @@ struct xorshf96_generator
 
     xorshf96_generator(unsigned long seed, random_mode m) : z(521288629ULL ^ seed), mode(m) {}
 
-    constexpr T operator()() noexcept
+    xorshf96_generator(const xorshf96_state& state, random_mode m)
+        : x(state[0]), y(state[1]), z(state[2]), mode(m)
+    {
+    }
+
+    constexpr void step() noexcept
     {
         x ^= x << 16U;
         x ^= x >> 5U;
@@ -98,7 +108,11 @@ struct xorshf96_generator
         x               = y;
         y               = z;
         z               = t ^ x ^ y;
+    }
 
+    constexpr T operator()() noexcept
+    {
+        step();
         return normalize<T>(z, mode);
     }
 };
@@ -120,13 +134,26 @@ struct xorshift_generator
     }
 };
 
+/**
+ * Calls `f(start, end, state)` for chunks of the `n` values of the xorshf96 generator seeded with
+ * `seed`, where `state` is the state of the generator before the value at `start`. The chunks have
+ * a fixed size and run in parallel, so the values are the same as generating them serially
+ * regardless of the number of threads.
+ */
+MIGRAPHX_EXPORT void
+par_generate(std::size_t n,
+             unsigned long seed,
+             const std::function<void(std::size_t, std::size_t, const xorshf96_state&)>& f);
+
 template <class T>
 auto generate_tensor_data(const migraphx::shape& s,
                           unsigned long seed,
                           random_mode m = random_mode::legacy)
 {
     auto result = make_shared_array<T>(s.element_space());
-    std::generate(result.get(), result.get() + s.element_space(), xorshf96_generator<T>{seed, m});
+    par_generate(s.element_space(), seed, [&](auto start, auto end, const auto& state) {
+        std::generate(result.get() + start, result.get() + end, xorshf96_generator<T>{state, m});
+    });
     return result;
 }
 
@@ -134,7 +161,7 @@ template <class T>
 auto fill_tensor_data(const migraphx::shape& s, double value = 0)
 {
     auto result = make_shared_array<T>(s.element_space());
-    std::generate(result.get(), result.get() + s.element_space(), [=] { return value; });
+    std::fill_n(result.get(), s.element_space(), T(value));
     return result;
 }
 
@@ -28,16 +28,19 @@
 #include <functional>
 #include <migraphx/config.hpp>
 #include <migraphx/requires.hpp>
+#include <migraphx/pool_allocator.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 struct instruction;
+// Instructions of a module are allocated from a per-module pool
+using instruction_list = std::list<instruction, pool_allocator<instruction>>;
 #if defined(_WIN32) && !defined(NDEBUG) && !defined(CPPCHECK)
-struct instruction_ref : std::list<instruction>::iterator
+struct instruction_ref : instruction_list::iterator
 {
-    using instruction_iter       = std::list<instruction>::iterator;
-    using instruction_const_iter = std::list<instruction>::const_iterator;
+    using instruction_iter       = instruction_list::iterator;
+    using instruction_const_iter = instruction_list::const_iterator;
 
     instruction_ref() = default;
     instruction_ref(const instruction_iter& other) : instruction_iter(other) {}
@@ -61,7 +64,7 @@ struct instruction_ref : std::list<instruction>::iterator
     }
 };
 #else
-using instruction_ref = std::list<instruction>::iterator;
+using instruction_ref = instruction_list::iterator;
 #endif
 
 MIGRAPHX_EXPORT migraphx::instruction* as_address(const instruction_ref& ins) noexcept;
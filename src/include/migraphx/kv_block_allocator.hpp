@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_KV_BLOCK_ALLOCATOR_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_KV_BLOCK_ALLOCATOR_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Hands out blocks of a paged kv cache to sequences, and builds the block tables used by the
+ * kv_cache_update and paged_attention operators. The cache itself is a tensor of shape
+ * [num_blocks, block_size, kv_heads, head_dim] owned by the caller, so the allocator only
+ * tracks which blocks belong to each sequence. Blocks can be shared by several sequences, such
+ * as the beams of a beam search, and are freed when no sequence uses them anymore. It is safe
+ * to use from multiple threads.
+ */
+struct MIGRAPHX_EXPORT kv_block_allocator
+{
+    kv_block_allocator() = default;
+    kv_block_allocator(std::size_t num_blocks, std::size_t block_size);
+
+    kv_block_allocator(const kv_block_allocator&)            = delete;
+    kv_block_allocator& operator=(const kv_block_allocator&) = delete;
+
+    std::size_t num_blocks() const;
+    std::size_t block_size() const;
+    std::size_t free_blocks() const;
+
+    /// Make sure the sequence has enough blocks for ntokens tokens. Returns false, without
+    /// allocating anything, when there are not enough free blocks.
+    bool reserve(std::size_t seq, std::size_t ntokens);
+    /// Return all the blocks of the sequence to the free list
+    void release(std::size_t seq);
+    /// Continue each sequence seqs[i] from the sequence seqs[parents[i]], which both hold ntokens
+    /// tokens, such as with the parents returned by beam_step. The full blocks are shared instead
+    /// of copied, so the cache is reordered by only changing the block tables. A partially
+    /// filled last block is kept by one of the sequences continuing it, and the others get a
+    /// new block. The copies filling these in are returned as an int32 tensor of shape
+    /// [seqs.size(), 2] for kv_cache_copy_blocks, with -1 for sequences that need no copy.
+    argument fork(const std::vector<std::size_t>& seqs,
+                  const std::vector<std::size_t>& parents,
+                  std::size_t ntokens);
+    /// Blocks used by the sequence, in token order
+    std::vector<std::int32_t> blocks(std::size_t seq) const;
+
+    /// Build an int32 block table of shape [seqs.size(), max_blocks], padded with -1
+    argument block_table(const std::vector<std::size_t>& seqs, std::size_t max_blocks) const;
+
+    private:
+    std::size_t m_num_blocks                                             = 0;
+    std::size_t m_block_size                                             = 0;
+    std::vector<std::int32_t> free_list                                  = {};
+    std::vector<std::size_t> refs                                        = {};
+    std::unordered_map<std::size_t, std::vector<std::int32_t>> sequences = {};
+    mutable std::mutex mutex;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_KV_BLOCK_ALLOCATOR_HPP
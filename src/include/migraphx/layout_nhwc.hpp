@@ -38,6 +38,11 @@ struct module_pass_manager;
  */
 struct MIGRAPHX_EXPORT layout_nhwc
 {
+    /// Group the convolutions into regions connected through pointwise ops, and only transform
+    /// the regions where the estimated speedup of the convolutions outweighs the layout ops
+    /// needed at the boundaries of the region
+    bool select_regions = false;
+
     std::string name() const { return "layout_nhwc"; }
     void apply(module_pass_manager& mpm) const;
 };
@@ -30,9 +30,14 @@
 #include <migraphx/tensor_view.hpp>
 #include <migraphx/raw_data.hpp>
 #include <migraphx/make_shared_array.hpp>
+#include <migraphx/content_hash.hpp>
 #include <migraphx/config.hpp>
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -87,11 +92,29 @@ struct literal : raw_data<literal>
         std::copy(x, x + s.bytes(), buffer.get());
     }
 
+    /// Shares the buffer instead of copying it, which must hold at least the bytes of the shape
+    literal(const shape& s, std::shared_ptr<char> x) : buffer(std::move(x)), m_shape(s) {}
+
+    /// Defers loading the data until it is first accessed, the loader must return a buffer
+    /// holding at least the bytes of the shape. Copies of the literal share the loaded buffer.
+    literal(const shape& s, std::function<std::shared_ptr<char>()> loader)
+        : lazy(std::make_shared<lazy_buffer>(std::move(loader))), m_shape(s)
+    {
+    }
+
     /// Whether data is available
-    bool empty() const { return this->buffer == nullptr; }
+    bool empty() const { return this->buffer == nullptr and this->lazy == nullptr; }
+
+    /// Whether the data is in memory, which is false for a lazy literal that is not accessed yet
+    bool is_loaded() const { return this->lazy == nullptr or this->lazy->loaded; }
 
     /// Provides a raw pointer to the data
-    const char* data() const { return this->buffer.get(); }
+    const char* data() const
+    {
+        if(this->lazy != nullptr)
+            return this->lazy->get();
+        return this->buffer.get();
+    }
 
     const shape& get_shape() const { return this->m_shape; }
 
@@ -100,12 +123,50 @@ struct literal : raw_data<literal>
     /// Convert the data to an argument
     argument get_argument() const
     {
-        auto b = make_shared_array<char>(buffer.get(), buffer.get() + m_shape.bytes());
+        const char* d = this->data();
+        auto b        = make_shared_array<char>(d, d + m_shape.bytes());
         return {m_shape, [b]() { return b.get(); }};
     }
 
+    /// Hash of the data, which is computed on first use and shared by copies of the literal
+    const std::string& content_hash() const
+    {
+        std::call_once(hash->flag, [&] {
+            hash->value = migraphx::content_hash(this->data(), m_shape.bytes());
+        });
+        return hash->value;
+    }
+
     private:
+    struct lazy_buffer
+    {
+        explicit lazy_buffer(std::function<std::shared_ptr<char>()> f) : loader(std::move(f)) {}
+
+        const char* get()
+        {
+            std::call_once(flag, [&] {
+                buffer = loader();
+                loader = nullptr;
+                loaded = true;
+            });
+            return buffer.get();
+        }
+
+        std::function<std::shared_ptr<char>()> loader;
+        std::once_flag flag;
+        std::shared_ptr<char> buffer;
+        std::atomic<bool> loaded{false};
+    };
+
+    struct hash_cache
+    {
+        std::once_flag flag;
+        std::string value;
+    };
+
     std::shared_ptr<char> buffer;
+    std::shared_ptr<lazy_buffer> lazy;
+    std::shared_ptr<hash_cache> hash = std::make_shared<hash_cache>();
     shape m_shape;
 
     // Keeps the same data ordering as the given container
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_LOAD_SAVE_HPP
 
 #include <migraphx/program.hpp>
+#include <migraphx/value.hpp>
 #include <string>
 #include <vector>
 
@@ -33,7 +34,12 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 struct file_options
 {
+    /// Either "msgpack", "json" or "chunked". The chunked format stores the literals and code
+    /// objects as separate chunks after a small metadata section, so they can be compressed and
+    /// decoded in parallel.
     std::string format = "msgpack";
+    /// Compression used for the chunks of the chunked format, either "none" or "zstd"
+    std::string compression = "none";
 };
 
 MIGRAPHX_EXPORT program load(const std::string& filename,
@@ -49,6 +55,10 @@ save(const program& p, const std::string& filename, const file_options& options
 MIGRAPHX_EXPORT std::vector<char> save_buffer(const program& p,
                                               const file_options& options = file_options{});
 
+/// Read only the code objects from a program saved in the chunked format, without decoding the
+/// rest of the program
+MIGRAPHX_EXPORT std::vector<value::binary> load_code_objects(const std::string& filename);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
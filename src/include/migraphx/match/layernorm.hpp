@@ -78,6 +78,28 @@ struct layernorm_matcher
         return any(any_of(div_sqrt, mul_rsqrt));
     }
 
+    auto squared() const
+    {
+        return any_of(f("pow")(arg(0)(any().bind("sq_x")), arg(1)(has_value(2.0f))),
+                      f("mul")(same_inputs(), arg(0)(any().bind("sq_x"))));
+    }
+
+    auto mean_squared() const { return reduce_mean()(arg(0)(squared())); }
+
+    auto sqrt_add_eps_rms(const std::string& name) const
+    {
+        auto add_eps = f("add")(either_arg(0, 1)(mean_squared(), is_constant().bind("eps")));
+        return skip_broadcasts(f(name)(arg(0)(any_of(add_eps, mean_squared()))));
+    }
+
+    // The squared input is bound to "sq_x" and has to be checked against "x" by the caller
+    auto rms_norm_onnx() const
+    {
+        auto div_sqrt  = f("div")(arg(0)(any().bind("x")), arg(1)(sqrt_add_eps_rms("sqrt")));
+        auto mul_rsqrt = f("mul")(either_arg(0, 1)(any().bind("x"), sqrt_add_eps_rms("rsqrt")));
+        return any(any_of(div_sqrt, mul_rsqrt));
+    }
+
     auto matcher() const { return layernorm_onnx(); }
 };
 } // namespace detail
@@ -93,6 +115,17 @@ inline auto layernorm()
     return layernorm([](auto x) { return name(x); });
 }
 
+template <class F>
+auto rms_norm(F f)
+{
+    return detail::layernorm_matcher<F>{f}.rms_norm_onnx();
+}
+
+inline auto rms_norm()
+{
+    return rms_norm([](auto x) { return name(x); });
+}
+
 } // namespace match
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
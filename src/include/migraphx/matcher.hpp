@@ -33,8 +33,10 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/type_name.hpp>
 #include <migraphx/source_location.hpp>
+#include <migraphx/rank.hpp>
 #include <migraphx/config.hpp>
 #include <array>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -98,6 +100,50 @@ struct matcher_context
     module* mod = nullptr;
 };
 
+/// The op names an instruction must have for a matcher to match it, null when any name can match
+using op_names = std::shared_ptr<const std::unordered_set<std::string>>;
+
+template <class M>
+auto root_names_impl(rank<1>, const M& m) -> decltype(m.root_names())
+{
+    return m.root_names();
+}
+
+template <class M>
+op_names root_names_impl(rank<0>, const M&)
+{
+    return nullptr;
+}
+
+/// Get the op names the matcher can match at the instruction it starts from
+template <class M>
+op_names root_names(const M& m)
+{
+    return root_names_impl(rank<1>{}, m);
+}
+
+/// A matcher that can only match instructions with one of the names
+template <class M>
+struct rooted_matcher
+{
+    M m;
+    op_names names;
+
+    template <class Context>
+    auto match(Context& ctx, instruction_ref ins) const
+    {
+        return m.match(ctx, ins);
+    }
+
+    op_names root_names() const { return names; }
+};
+
+template <class M>
+rooted_matcher<M> make_rooted_matcher(M m, op_names names)
+{
+    return {m, std::move(names)};
+}
+
 /// Convert a predicate function into a matcher
 template <class P>
 struct predicate_matcher
@@ -139,18 +185,21 @@ function_matcher<F> make_function_matcher(F f)
 template <class M>
 auto bind_match(M m, std::string name)
 {
-    return make_function_matcher(
-        [=, m_name = std::move(name)](matcher_context& ctx,
-                                      instruction_ref ins) -> optional<instruction_ref> {
-            auto result = m.match(ctx, ins);
-            if(result)
-            {
-                if(not ctx.has_instruction(ins))
-                    return nullopt;
-                ctx.instructions[m_name] = ins;
-            }
-            return result;
-        });
+    auto names = root_names(m);
+    return make_rooted_matcher(
+        make_function_matcher(
+            [=, m_name = std::move(name)](matcher_context& ctx,
+                                          instruction_ref ins) -> optional<instruction_ref> {
+                auto result = m.match(ctx, ins);
+                if(result)
+                {
+                    if(not ctx.has_instruction(ins))
+                        return nullopt;
+                    ctx.instructions[m_name] = ins;
+                }
+                return result;
+            }),
+        std::move(names));
 }
 
 /// Convert a matcher to a bindable matcher
@@ -162,6 +211,8 @@ struct bindable_matcher
     auto bind(std::string name) const { return bind_match(m, std::move(name)); }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    op_names root_names() const { return match::root_names(m); }
 };
 
 /// Create a bindable matcher
@@ -231,8 +282,7 @@ struct basic_matcher
     {
         // Copy m because we cant capture `this` by value
         auto mm = m;
-        return make_basic_fun_matcher([=](matcher_context& ctx,
-                                          instruction_ref ins) -> optional<instruction_ref> {
+        auto f  = [=](matcher_context& ctx, instruction_ref ins) -> optional<instruction_ref> {
             auto result = mm.match(ctx, ins);
             if(result)
             {
@@ -242,12 +292,15 @@ struct basic_matcher
                     return result;
             }
             return nullopt;
-        });
+        };
+        return make_basic_matcher(make_rooted_matcher(make_function_matcher(f), root_names()));
     }
 
     auto bind(std::string name) const { return bind_match(m, std::move(name)); }
 
     auto match(matcher_context& ctx, instruction_ref ins) const { return m.match(ctx, ins); }
+
+    op_names root_names() const { return match::root_names(m); }
 };
 
 /// Create a typed-erased matcher
@@ -396,16 +449,43 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES_FOR)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_VALIDATE_MATCHES)
 
-/// Find matches for an instruction in the module for per section of matchers
-template <class Mod, class... Ms>
-void find_matches_for(source_location location, Mod& mod, instruction_ref ins, Ms&&... ms)
+/// Which finders can match an instruction, looked up by the name of the instruction
+struct finder_table
+{
+    finder_table(std::vector<op_names> names) : roots(std::move(names)) {}
+
+    const std::vector<bool>& get(const std::string& name)
+    {
+        auto it = masks.find(name);
+        if(it != masks.end())
+            return it->second;
+        std::vector<bool> mask(roots.size());
+        std::transform(roots.begin(), roots.end(), mask.begin(), [&](const op_names& r) {
+            return r == nullptr or r->count(name) > 0;
+        });
+        return masks.emplace(name, std::move(mask)).first->second;
+    }
+
+    private:
+    std::vector<op_names> roots;
+    std::unordered_map<std::string, std::vector<bool>> masks;
+};
+
+/// Find matches for an instruction in the module for per section of matchers, only trying the
+/// finders where try_finder returns true for their index
+template <class Mod, class Select, class... Ms>
+void find_enabled_matches_for(
+    source_location location, Mod& mod, instruction_ref ins, Select try_finder, Ms&&... ms)
 {
     const int trace         = value_of(MIGRAPHX_TRACE_MATCHES{});
     const bool validate     = enabled(MIGRAPHX_VALIDATE_MATCHES{});
     const auto trace_filter = string_value_of(MIGRAPHX_TRACE_MATCHES_FOR{});
     bool match              = false;
+    std::size_t i           = 0;
     each_args(
         [&](auto&& m) {
+            if(not try_finder(i++))
+                return;
             const auto& matcher_name = get_type_name(m);
             const bool trace_for     = not trace_filter.empty() and
                                    (contains(std::string{location.file_name()}, trace_filter) or
@@ -442,15 +522,28 @@ void find_matches_for(source_location location, Mod& mod, instruction_ref ins, M
         ms...);
 }
 
-/// Find matches in a module
+/// Find matches for an instruction in the module for per section of matchers
+template <class Mod, class... Ms>
+void find_matches_for(source_location location, Mod& mod, instruction_ref ins, Ms&&... ms)
+{
+    find_enabled_matches_for(location, mod, ins, always(true), ms...);
+}
+
+/// Find matches in a module. The finders are dispatched on the name of each instruction, so a
+/// finder whose matcher starts with match::name is only tried on instructions with that name.
 template <class Mod, class... Ms>
 struct find_matches
 {
     find_matches(Mod& mod, Ms&&... ms, source_location location = source_location::current())
     {
+        finder_table table{{root_names(ms.matcher())...}};
         for(auto ins : iterator_for(get_module(mod)))
         {
-            find_matches_for(location, mod, ins, ms...);
+            if(not get_module(mod).is_dirty(ins))
+                continue;
+            const auto& mask = table.get(ins->name());
+            find_enabled_matches_for(
+                location, mod, ins, [&](std::size_t i) { return mask[i]; }, ms...);
         }
     }
 };
@@ -524,16 +617,39 @@ struct match_fold_f
         return p([&](auto... ms) { return match_fold_f::fold_matchers(ctx, ins, ms...); });
     }
 
+    // The names an all_of match must have are the names of any of its matchers, and the names
+    // an any_of match can have are the union of the names of all of its matchers
+    template <class... Ts>
+    static op_names fold_root_names(const Ts&... ms)
+    {
+        std::vector<op_names> names = {root_names(ms)...};
+        if(names.empty() or not Matches)
+            return nullptr;
+        if(std::is_same<Op, lazy_and>{})
+        {
+            auto it = std::find_if(
+                names.begin(), names.end(), [](const op_names& n) { return n != nullptr; });
+            return it == names.end() ? nullptr : *it;
+        }
+        if(std::any_of(names.begin(), names.end(), [](const op_names& n) { return n == nullptr; }))
+            return nullptr;
+        auto result = std::make_shared<std::unordered_set<std::string>>();
+        for(const auto& n : names)
+            result->insert(n->begin(), n->end());
+        return result;
+    }
+
     template <class... Ts>
     auto operator()(Ts... ms) const
     {
-        return make_bf_matcher(
-            [=](matcher_context& ctx, instruction_ref ins) -> optional<instruction_ref> {
-                bool matches = match_fold_f::fold_matchers(ctx, ins, ms...);
-                if(matches == Matches)
-                    return {ins};
-                return nullopt;
-            });
+        auto f = [=](matcher_context& ctx, instruction_ref ins) -> optional<instruction_ref> {
+            bool matches = match_fold_f::fold_matchers(ctx, ins, ms...);
+            if(matches == Matches)
+                return {ins};
+            return nullopt;
+        };
+        return make_bindable_matcher(
+            make_rooted_matcher(make_function_matcher(f), fold_root_names(ms...)));
     }
 
     template <class Selector>
@@ -768,8 +884,12 @@ inline auto var(std::string s)
 
 inline auto name(std::string s)
 {
-    return make_basic_pred_matcher(
-        [=, m_s = std::move(s)](instruction_ref ins) { return ins->name() == m_s; });
+    auto names = std::make_shared<const std::unordered_set<std::string>>(
+        std::unordered_set<std::string>{s});
+    return make_basic_matcher(make_rooted_matcher(
+        make_predicate_matcher(
+            [=, m_s = std::move(s)](instruction_ref ins) { return ins->name() == m_s; }),
+        std::move(names)));
 }
 
 inline auto name_contains(const std::string& name)
@@ -780,9 +900,11 @@ inline auto name_contains(const std::string& name)
 
 inline auto name(std::unordered_set<std::string> names)
 {
-    return make_basic_pred_matcher([=, m_names = std::move(names)](instruction_ref ins) {
-        return m_names.count(ins->name()) > 0;
-    });
+    auto m_names = std::make_shared<const std::unordered_set<std::string>>(std::move(names));
+    return make_basic_matcher(make_rooted_matcher(
+        make_predicate_matcher(
+            [=](instruction_ref ins) { return m_names->count(ins->name()) > 0; }),
+        m_names));
 }
 
 template <class... Ts>
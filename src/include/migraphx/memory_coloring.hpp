@@ -31,16 +31,36 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 struct module;
+struct module_pass_manager;
 
 /**
  * Remove multiple memory allocations using graph coloring to find memory allocations that can be
  * reused.
+ *
+ * When run by the pass manager, the scratch of the submodules of an instruction, such as the
+ * branches of an if or the variants of a select_module, is planned as one allocation in the
+ * parent that is live only at the call site. The submodules only run one at a time so they share
+ * it, and it can reuse the parent's memory that is dead at the call site. This is skipped for
+ * modules scheduled on several streams, where the submodules keep their own scratch.
+ *
+ * By default the allocations are packed with each strategy and the smallest scratch is kept.
  */
 struct MIGRAPHX_EXPORT memory_coloring
 {
+    enum class packing
+    {
+        smallest,
+        first_fit,
+        // Best-fit in decreasing order of size
+        best_fit_size,
+        // Best-fit in decreasing order of size times lifetime
+        best_fit_lifetime
+    };
     std::string allocation_op{};
-    bool verify = false;
+    bool verify      = false;
+    packing strategy = packing::smallest;
     std::string name() const { return "memory_coloring"; }
+    void apply(module_pass_manager& mpm) const;
     void apply(module& m) const;
 };
 
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_METRICS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_METRICS_HPP
+
+#include <migraphx/config.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// A counter that can be updated from any thread. Call sites keep a reference to it, usually in
+/// a function-local static, so updating it is a single relaxed atomic add.
+struct MIGRAPHX_EXPORT metric_counter
+{
+    void add(std::uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t get() const { return value.load(std::memory_order_relaxed); }
+    void reset() { value.store(0, std::memory_order_relaxed); }
+
+    private:
+    std::atomic<std::uint64_t> value{0};
+};
+
+/// A histogram with power of two buckets, where bucket i counts the values below 2^i that are
+/// not in an earlier bucket. Values past the last bucket are counted in the last bucket.
+struct MIGRAPHX_EXPORT metric_histogram
+{
+    static constexpr std::size_t nbuckets = 32;
+
+    void record(std::uint64_t x);
+    std::uint64_t count() const { return n.load(std::memory_order_relaxed); }
+    std::uint64_t sum() const { return total.load(std::memory_order_relaxed); }
+    std::uint64_t bucket(std::size_t i) const { return buckets[i].load(std::memory_order_relaxed); }
+    void reset();
+
+    private:
+    std::array<std::atomic<std::uint64_t>, nbuckets> buckets{};
+    std::atomic<std::uint64_t> n{0};
+    std::atomic<std::uint64_t> total{0};
+};
+
+/// Get the counter registered under `name`, creating it on first use. The reference stays valid
+/// for the lifetime of the process.
+MIGRAPHX_EXPORT metric_counter& get_metric_counter(const std::string& name);
+
+/// Get the histogram registered under `name`, creating it on first use. The reference stays
+/// valid for the lifetime of the process.
+MIGRAPHX_EXPORT metric_histogram& get_metric_histogram(const std::string& name);
+
+/// A snapshot of every metric. Histograms are flattened into `<name>.count`, `<name>.sum` and
+/// the cumulative `<name>.le_<bound>` buckets, up to the last bucket that is not empty.
+MIGRAPHX_EXPORT std::map<std::string, std::uint64_t> get_metrics();
+
+/// The value of a single metric from `get_metrics`, or zero when it has not been recorded
+MIGRAPHX_EXPORT std::uint64_t get_metric(const std::string& name);
+
+/// Set every metric back to zero
+MIGRAPHX_EXPORT void reset_metrics();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_METRICS_HPP
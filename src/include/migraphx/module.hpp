@@ -34,6 +34,7 @@
 #include <migraphx/target.hpp>
 #include <migraphx/module_ref.hpp>
 #include <migraphx/compile_options.hpp>
+#include <migraphx/type_name.hpp>
 #include <migraphx/env.hpp>
 #include <migraphx/config.hpp>
 #include <algorithm>
@@ -326,6 +327,30 @@ struct MIGRAPHX_EXPORT module
 
     void repeat_while_changes(std::size_t n, const std::function<void()>& f);
 
+    /* When enabled, the module records which instructions are inserted, replaced, moved or lose
+     * an output. Matchers then skip instructions whose neighbourhood has not been touched in the
+     * current or previous rewrite epoch, since they would not match anything new there.
+     */
+    void set_incremental_rewrites(bool b = true);
+    // Start a new epoch; instructions untouched since the start of the last epoch become clean
+    void next_rewrite_epoch();
+    // Returns true if a matcher could find something new at this instruction
+    bool is_dirty(instruction_ref ins) const;
+
+    /* Returns the analysis of type T computed by f(*this). The result is cached on the module, so
+     * passes running one after another can share it, and it is recomputed once the module is
+     * modified or the inputs of any of its instructions change.
+     */
+    template <class T, class F>
+    std::shared_ptr<const T> get_analysis(F f) const
+    {
+        const auto& key = get_type_name<T>();
+        auto result     = find_analysis(key);
+        if(result == nullptr)
+            result = add_analysis(key, std::make_shared<const T>(f(*this)));
+        return std::static_pointer_cast<const T>(result);
+    }
+
     MIGRAPHX_EXPORT friend std::ostream& operator<<(std::ostream& os, const module& m);
     MIGRAPHX_EXPORT friend bool operator==(const module& x, const module& y);
     friend bool operator!=(const module& x, const module& y) { return not(x == y); }
@@ -335,6 +360,12 @@ struct MIGRAPHX_EXPORT module
     private:
     void set_name(const std::string& name);
     void assign(const module& m);
+    // Returns a function that will return true once the instructions in the
+    // module have been changed
+    std::function<bool()> track_changes();
+    std::shared_ptr<const void> find_analysis(const std::string& key) const;
+    std::shared_ptr<const void> add_analysis(const std::string& key,
+                                             std::shared_ptr<const void> a) const;
     void calc_implicit_deps(const module& smod,
                             const module& pmod,
                             instruction_ref ins,
@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_ALL_GATHER_HPP
+#define MIGRAPHX_GUARD_OPERATORS_ALL_GATHER_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Joins the slices computed by each shard of a tensor-parallel layer along
+ * axis, in shard order.
+ */
+struct all_gather
+{
+    std::size_t axis = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"));
+    }
+
+    std::string name() const { return "all_gather"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has_at_least(1).same_type().same_ndims();
+        if(axis >= inputs.front().ndim())
+            MIGRAPHX_THROW("ALL_GATHER: axis is out of range");
+        auto lens = inputs.front().lens();
+        for(const auto& s : inputs)
+        {
+            auto slens  = s.lens();
+            slens[axis] = lens[axis];
+            if(slens != lens)
+                MIGRAPHX_THROW("ALL_GATHER: inputs must only differ along axis " +
+                               std::to_string(axis));
+        }
+        lens[axis] = std::accumulate(
+            inputs.begin(), inputs.end(), std::size_t{0}, [&](auto n, const auto& s) {
+                return n + s.lens()[axis];
+            });
+        return {inputs.front().type(), lens};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        std::size_t offset = 0;
+        for(const auto& arg : args)
+        {
+            visit_all(result, arg)([&](auto output, auto input) {
+                shape_for_each(input.get_shape(), [&](const auto& idx) {
+                    auto out_idx = idx;
+                    out_idx[axis] += offset;
+                    output(out_idx.begin(), out_idx.end()) = input(idx.begin(), idx.end());
+                });
+            });
+            offset += arg.get_shape().lens()[axis];
+        }
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
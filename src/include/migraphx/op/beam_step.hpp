@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_BEAM_STEP_HPP
+#define MIGRAPHX_GUARD_OPERATORS_BEAM_STEP_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * One step of a beam search. Every beam is extended with every token of the vocabulary, and
+ * the beams with the best scores are kept:
+ *
+ *   logprobs: [batch, beams, vocab], log probability of the next token of each beam
+ *   scores:   [batch, beams], score of each beam so far
+ *
+ * The output is a tuple of the new scores, the tokens appended, and the parent beam each new
+ * beam continues, all of shape [batch, beams]. Beams are ordered by their score, and equal
+ * scores by parent beam and then token. On the first step every beam is the same, so all but
+ * the first should start with the lowest score.
+ *
+ * The parents are used to reorder the kv cache, which can be done without copying it with
+ * kv_block_allocator::fork and kv_cache_copy_blocks.
+ */
+struct beam_step
+{
+    std::string name() const { return "beam_step"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(2).standard().same_type();
+        check_shapes{inputs.begin(), inputs.begin() + 1, *this}.only_dims(3);
+        check_shapes{inputs.begin() + 1, inputs.end(), *this}.only_dims(2);
+        const auto& lens = inputs[0].lens();
+        if(not std::equal(lens.begin(), lens.begin() + 2, inputs[1].lens().begin()))
+            MIGRAPHX_THROW("BEAM_STEP: scores must have a score for each beam");
+        if(lens[2] == 0)
+            MIGRAPHX_THROW("BEAM_STEP: the vocabulary must not be empty");
+        shape indices{shape::int64_type, inputs[1].lens()};
+        return shape{{inputs[1], indices, indices}};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        auto outputs = output_shape.sub_shapes();
+        argument new_scores{outputs[0]};
+        argument tokens{outputs[1]};
+        argument parents{outputs[2]};
+        const auto& lens  = args[0].get_shape().lens();
+        std::size_t batch = lens[0];
+        std::size_t beams = lens[1];
+        std::size_t vocab = lens[2];
+        auto* out_tokens  = tokens.cast<std::int64_t>();
+        auto* out_parents = parents.cast<std::int64_t>();
+        visit_all(new_scores, args[0], args[1])([&](auto output, auto logprobs, auto scores) {
+            std::vector<std::size_t> candidates(beams * vocab);
+            for(std::size_t b = 0; b < batch; b++)
+            {
+                auto score = [&](std::size_t i) {
+                    return scores[b * beams + i / vocab] + logprobs[b * beams * vocab + i];
+                };
+                std::iota(candidates.begin(), candidates.end(), 0);
+                std::partial_sort(candidates.begin(),
+                                  candidates.begin() + beams,
+                                  candidates.end(),
+                                  [&](std::size_t x, std::size_t y) {
+                                      auto sx = score(x);
+                                      auto sy = score(y);
+                                      if(sx != sy)
+                                          return sx > sy;
+                                      return x < y;
+                                  });
+                for(std::size_t j = 0; j < beams; j++)
+                {
+                    auto i                     = candidates[j];
+                    output[b * beams + j]      = score(i);
+                    out_tokens[b * beams + j]  = i % vocab;
+                    out_parents[b * beams + j] = i / vocab;
+                }
+            }
+        });
+        return {{new_scores, tokens, parents}};
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
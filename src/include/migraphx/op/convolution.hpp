@@ -201,6 +201,15 @@ struct convolution
         return stride.size();
     }
 
+    // A multiply and add for each output element and each weight of its output channel
+    std::size_t flops(const std::vector<shape>& inputs) const
+    {
+        if(inputs.size() < 2 or inputs[0].dynamic() or inputs[1].dynamic())
+            return 0;
+        const auto& w = inputs[1];
+        return 2 * static_compute_shape(inputs[0], w).elements() * (w.elements() / w.lens()[0]);
+    }
+
     argument compute(shape output_shape, std::vector<argument> args) const
     {
         std::vector<std::size_t> new_padding;
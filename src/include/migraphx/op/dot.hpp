@@ -123,6 +123,14 @@ struct dot
         }
     }
 
+    // A multiply and add for each element of a and each column of b
+    std::size_t flops(const std::vector<shape>& inputs) const
+    {
+        if(inputs.size() < 2 or inputs[0].dynamic() or inputs[1].dynamic())
+            return 0;
+        return 2 * inputs[0].elements() * inputs[1].lens().back();
+    }
+
     argument compute(const dyn_output& dyn_out, std::vector<argument> args) const
     {
         argument result = argument{dyn_out.computed_shape};
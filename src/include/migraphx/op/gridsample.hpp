@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MIGRAPHX_GUARD_OPERATORS_GRIDSAMPLE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_GRIDSAMPLE_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/op/resize.hpp>
+#include <migraphx/config.hpp>
+#include <cmath>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Samples an NCHW input at the positions given by a grid, like the onnx GridSample operator.
+ * The grid has the shape {N, H_out, W_out, 2}, and holds the x and y coordinates of each position
+ * normalized to [-1, 1]. The output has the shape {N, C, H_out, W_out}.
+ */
+struct gridsample
+{
+    // nearest, linear or cubic
+    std::string mode = "linear";
+    // What is read outside of the input: zeros, border or reflection
+    std::string padding_mode = "zeros";
+    // Whether -1 and 1 are the centers of the corner pixels instead of their edges
+    bool align_corners = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.mode, "mode"),
+                    f(self.padding_mode, "padding_mode"),
+                    f(self.align_corners, "align_corners"));
+    }
+
+    std::string name() const { return "gridsample"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(2).only_dims(4);
+        const auto& x    = inputs[0];
+        const auto& grid = inputs[1];
+        if(shape::is_integral(grid.type()))
+            MIGRAPHX_THROW("GRIDSAMPLE: grid must have a floating point type");
+        if(grid.lens()[0] != x.lens()[0] or grid.lens()[3] != 2)
+            MIGRAPHX_THROW("GRIDSAMPLE: grid must have the shape {N, H_out, W_out, 2}");
+        if(not contains({"nearest", "linear", "cubic"}, mode))
+            MIGRAPHX_THROW("GRIDSAMPLE: unsupported mode " + mode);
+        if(not contains({"zeros", "border", "reflection"}, padding_mode))
+            MIGRAPHX_THROW("GRIDSAMPLE: unsupported padding_mode " + padding_mode);
+        return {x.type(), {x.lens()[0], x.lens()[1], grid.lens()[1], grid.lens()[2]}};
+    }
+
+    // The "a" coefficient of the cubic convolution
+    static constexpr double cubic_coeff_a = -0.75;
+
+    // Maps a normalized coordinate to a position along an axis of the input
+    double unnormalize(double x, std::size_t size) const
+    {
+        if(align_corners)
+            return (x + 1) * (size - 1) / 2;
+        return (x + 1) * size / 2 - 0.5;
+    }
+
+    // Reflects a position by the edges of the input until it is inside of it
+    double reflect_coordinate(double x, std::size_t size) const
+    {
+        double start  = align_corners ? 0 : -0.5;
+        double length = align_corners ? size - 1 : size;
+        auto dist     = std::abs(x - start);
+        auto flips    = std::floor(std::floor(dist) / length);
+        auto extra    = dist - flips * length;
+        if(std::fmod(flips, 2) == 0)
+            return start + extra;
+        return start + length - extra;
+    }
+
+    // Applies the padding mode to a position, so only zeros padding reads outside of the input
+    double pad(double x, std::size_t size) const
+    {
+        double last = size - 1.0;
+        if(padding_mode == "reflection")
+            x = reflect_coordinate(x, size);
+        if(padding_mode == "zeros")
+            return x;
+        return std::max(0.0, std::min(last, x));
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        const auto& in_lens = args[0].get_shape().lens();
+        auto height         = in_lens[2];
+        auto width          = in_lens[3];
+        visit_all(result, args[0])([&](auto output, auto input) {
+            using type = typename decltype(output)::value_type;
+            args[1].visit([&](auto grid) {
+                shape_for_each(output_shape, [&](const auto& idx, std::size_t i) {
+                    auto n = idx[0];
+                    auto c = idx[1];
+                    auto h = idx[2];
+                    auto w = idx[3];
+                    auto x = pad(unnormalize(grid(n, h, w, 0), width), width);
+                    auto y = pad(unnormalize(grid(n, h, w, 1), height), height);
+                    // Positions outside of the input read zeros
+                    auto at = [&](double yy, double xx) -> double {
+                        if(yy < 0 or xx < 0 or yy > height - 1.0 or xx > width - 1.0)
+                            return 0;
+                        auto iy = static_cast<std::size_t>(yy);
+                        auto ix = static_cast<std::size_t>(xx);
+                        return input(n, c, iy, ix);
+                    };
+                    double v = 0;
+                    if(mode == "nearest")
+                    {
+                        v = at(std::nearbyint(y), std::nearbyint(x));
+                    }
+                    else if(mode == "linear")
+                    {
+                        auto x0 = std::floor(x);
+                        auto y0 = std::floor(y);
+                        auto fx = x - x0;
+                        auto fy = y - y0;
+                        v       = at(y0, x0) * (1 - fy) * (1 - fx) +
+                                  at(y0, x0 + 1) * (1 - fy) * fx +
+                                  at(y0 + 1, x0) * fy * (1 - fx) +
+                                  at(y0 + 1, x0 + 1) * fy * fx;
+                    }
+                    else
+                    {
+                        auto x0 = std::floor(x);
+                        auto y0 = std::floor(y);
+                        auto wx = resize::get_cubic_coeffs(x - x0, cubic_coeff_a);
+                        auto wy = resize::get_cubic_coeffs(y - y0, cubic_coeff_a);
+                        for(int i = 0; i < 4; ++i)
+                        {
+                            for(int j = 0; j < 4; ++j)
+                            {
+                                auto yy = pad(y0 - 1 + i, height);
+                                auto xx = pad(x0 - 1 + j, width);
+                                v += wy[i] * wx[j] * at(yy, xx);
+                            }
+                        }
+                    }
+                    output[i] = static_cast<type>(v);
+                });
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MIGRAPHX_GUARD_OPERATORS_IMAGE_PREPROCESS_HPP
+#define MIGRAPHX_GUARD_OPERATORS_IMAGE_PREPROCESS_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/op/resize.hpp>
+#include <migraphx/config.hpp>
+#include <cmath>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Prepares a batch of images for a vision model in one pass. The input is a uint8 tensor in NHWC
+ * layout, which is resized in height and width, normalized with a mean and standard deviation
+ * for each channel, and written as NCHW in the output type. This is the same as converting the
+ * input to float, transposing it to NCHW, resizing it like the onnx Resize operator, and then
+ * subtracting the mean and dividing by the standard deviation.
+ */
+struct image_preprocess
+{
+    // Height and width of the output
+    std::vector<std::size_t> sizes;
+    // Scales of the height and width used for the coordinate transformation
+    std::vector<double> scales;
+    // nearest or linear
+    std::string mode = "nearest";
+    std::string nearest_mode                   = "round_prefer_floor";
+    std::string coordinate_transformation_mode = "half_pixel";
+    // Values for each channel, which default to 0 and 1 when empty
+    std::vector<float> mean;
+    std::vector<float> stddev;
+    shape::type_t type = shape::float_type;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.sizes, "sizes"),
+                    f(self.scales, "scales"),
+                    f(self.mode, "mode"),
+                    f(self.nearest_mode, "nearest_mode"),
+                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"),
+                    f(self.mean, "mean"),
+                    f(self.stddev, "stddev"),
+                    f(self.type, "type"));
+    }
+
+    std::string name() const { return "image_preprocess"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).only_dims(4);
+        if(inputs.front().type() != shape::uint8_type)
+            MIGRAPHX_THROW("IMAGE_PREPROCESS: input must be uint8");
+        if(sizes.size() != 2 or scales.size() != 2)
+            MIGRAPHX_THROW("IMAGE_PREPROCESS: sizes and scales must have the height and width");
+        if(mode != "nearest" and mode != "linear")
+            MIGRAPHX_THROW("IMAGE_PREPROCESS: unsupported mode " + mode);
+        auto channels = inputs.front().lens()[3];
+        if((not mean.empty() and mean.size() != channels) or
+           (not stddev.empty() and stddev.size() != channels))
+            MIGRAPHX_THROW("IMAGE_PREPROCESS: mean and stddev must have a value for each channel");
+        return {type, {inputs.front().lens()[0], channels, sizes[0], sizes[1]}};
+    }
+
+    float channel_mean(std::size_t c) const { return mean.empty() ? 0.0f : mean[c]; }
+
+    float channel_stddev(std::size_t c) const { return stddev.empty() ? 1.0f : stddev[c]; }
+
+    // The pixels read for each position of the output along the height (axis 0) or the width
+    // (axis 1), and the weight of the high pixel. Nearest mode reads the same pixel twice.
+    struct axis_samples
+    {
+        std::vector<std::size_t> low;
+        std::vector<std::size_t> high;
+        std::vector<float> delta;
+    };
+
+    axis_samples samples(std::size_t axis, std::size_t in_len) const
+    {
+        auto idx_op     = resize::get_original_idx_op(coordinate_transformation_mode);
+        auto nearest_op = resize::get_nearest_op(nearest_mode);
+        auto floor_op   = resize::get_nearest_op("floor");
+        auto ceil_op    = resize::get_nearest_op("ceil");
+        axis_samples result;
+        for(std::size_t i = 0; i < sizes[axis]; i++)
+        {
+            auto x = idx_op(in_len, sizes[axis], i, scales[axis]);
+            if(mode == "nearest")
+            {
+                result.low.push_back(nearest_op(in_len, x));
+                result.high.push_back(result.low.back());
+                result.delta.push_back(0);
+            }
+            else
+            {
+                result.low.push_back(floor_op(in_len, x));
+                result.high.push_back(ceil_op(in_len, x));
+                result.delta.push_back(x - result.low.back());
+            }
+        }
+        return result;
+    }
+
+    // Interpolates in the same order as the linear resize from the onnx parser
+    static float lerp(float low, float high, float d) { return (high - low) * d + low; }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        auto in_lens = args[0].get_shape().lens();
+        auto ys      = samples(0, in_lens[1]);
+        auto xs      = samples(1, in_lens[2]);
+        result.visit([&](auto output) {
+            args[0].visit([&](auto input) {
+                shape_for_each(output_shape, [&](const auto& idx, std::size_t i) {
+                    auto n  = idx[0];
+                    auto c  = idx[1];
+                    auto y  = idx[2];
+                    auto x  = idx[3];
+                    auto at = [&](std::size_t yy, std::size_t xx) -> float {
+                        return input(n, yy, xx, c);
+                    };
+                    auto row = [&](std::size_t yy) {
+                        return lerp(at(yy, xs.low[x]), at(yy, xs.high[x]), xs.delta[x]);
+                    };
+                    auto v    = lerp(row(ys.low[y]), row(ys.high[y]), ys.delta[y]);
+                    output[i] = (v - channel_mean(c)) / channel_stddev(c);
+                });
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_KV_CACHE_COPY_BLOCKS_HPP
+#define MIGRAPHX_GUARD_OPERATORS_KV_CACHE_COPY_BLOCKS_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <cstdint>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Copies blocks of a paged cache in place:
+ *
+ *   cache:  [num_blocks, block_size, heads, head_dim]
+ *   copies: [n, 2], the source and destination block of each copy
+ *
+ * Rows with a negative or out of range block are skipped, and a block should not be both a
+ * source and a destination. This is used with the copies returned by kv_block_allocator::fork,
+ * when beams that share a partially filled block are given their own block before appending to
+ * it. The output aliases the cache, and it should be used as the cache input of the
+ * instructions reading or updating it.
+ */
+struct kv_cache_copy_blocks
+{
+    std::string name() const { return "kv_cache_copy_blocks"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(2).standard();
+        check_shapes{inputs.begin(), inputs.begin() + 1, *this}.only_dims(4);
+        const auto& copies = inputs[1];
+        if(not shape::is_integral(copies.type()) or copies.ndim() != 2 or copies.lens()[1] != 2)
+            MIGRAPHX_THROW("KV_CACHE_COPY_BLOCKS: copies must be an integral tensor of [n, 2]");
+        return inputs[0];
+    }
+
+    argument compute(const shape&, std::vector<argument> args) const
+    {
+        const auto& lens        = args[0].get_shape().lens();
+        std::int64_t num_blocks = lens[0];
+        std::size_t block       = args[0].get_shape().elements() / lens[0];
+        auto copies             = args[1].to_vector<std::int64_t>();
+        args[0].visit([&](auto cache) {
+            for(std::size_t i = 0; i < copies.size(); i += 2)
+            {
+                auto src = copies[i];
+                auto dst = copies[i + 1];
+                if(src < 0 or dst < 0 or src >= num_blocks or dst >= num_blocks)
+                    continue;
+                std::copy(cache.begin() + src * block,
+                          cache.begin() + (src + 1) * block,
+                          cache.begin() + dst * block);
+            }
+        });
+        return args[0];
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 0; }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_KV_CACHE_UPDATE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_KV_CACHE_UPDATE_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Writes new key or value rows into a paged cache in place, so decoding one token at a time
+ * appends to the cache instead of concatenating and copying it on every step.
+ *
+ * The cache is split into blocks of block_size tokens, and each sequence has a row in the
+ * block table listing the blocks it uses in order:
+ *
+ *   cache:       [num_blocks, block_size, heads, head_dim]
+ *   update:      [batch, seq_len, heads, head_dim]
+ *   block_table: [batch, max_blocks]
+ *   positions:   [batch], position in the sequence of the first row of update
+ *   scales:      [heads], optional
+ *
+ * With scales, the cache can be stored in a smaller type than the update, such as int8 or fp8.
+ * Each row is divided by the scale of its head, rounded for integral caches, and saturated to
+ * the range of the cache type.
+ *
+ * Rows that land outside of the block table, or in a negative block, are skipped. The output
+ * aliases the cache, and it should be used as the cache input of the instructions reading it so
+ * they are ordered after the update.
+ */
+struct kv_cache_update
+{
+    std::string name() const { return "kv_cache_update"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(4, 5).standard();
+        check_shapes{inputs.begin(), inputs.begin() + 2, *this}.only_dims(4);
+        if(inputs.size() == 4)
+            check_shapes{inputs.begin(), inputs.begin() + 2, *this}.same_type();
+        const auto& cache       = inputs[0];
+        const auto& update      = inputs[1];
+        const auto& block_table = inputs[2];
+        const auto& positions   = inputs[3];
+        if(not std::equal(
+               cache.lens().begin() + 2, cache.lens().end(), update.lens().begin() + 2))
+            MIGRAPHX_THROW("KV_CACHE_UPDATE: heads and head_dim of the update and cache differ");
+        if(not shape::is_integral(block_table.type()) or block_table.ndim() != 2)
+            MIGRAPHX_THROW("KV_CACHE_UPDATE: block table must be a 2D integral tensor");
+        if(not shape::is_integral(positions.type()) or positions.ndim() != 1)
+            MIGRAPHX_THROW("KV_CACHE_UPDATE: positions must be a 1D integral tensor");
+        if(block_table.lens()[0] != update.lens()[0] or positions.lens()[0] != update.lens()[0])
+            MIGRAPHX_THROW("KV_CACHE_UPDATE: batch size mismatch");
+        if(inputs.size() == 5 and inputs[4].lens() != std::vector<std::size_t>{cache.lens()[2]})
+            MIGRAPHX_THROW("KV_CACHE_UPDATE: scales must have one element for each head");
+        return cache;
+    }
+
+    argument compute(const shape&, std::vector<argument> args) const
+    {
+        const auto& cshape      = args[0].get_shape();
+        const auto& ushape      = args[1].get_shape();
+        std::size_t num_blocks  = cshape.lens()[0];
+        std::size_t block_size  = cshape.lens()[1];
+        std::size_t head_dim    = cshape.lens()[3];
+        std::size_t row         = cshape.lens()[2] * head_dim;
+        std::size_t batch       = ushape.lens()[0];
+        std::size_t seq_len     = ushape.lens()[1];
+        std::size_t max_blocks  = args[2].get_shape().lens()[1];
+        std::size_t max_context = max_blocks * block_size;
+        auto block_table        = args[2].to_vector<std::int64_t>();
+        auto positions          = args[3].to_vector<std::int64_t>();
+        std::vector<double> scales;
+        if(args.size() == 5)
+            scales = args[4].to_vector<double>();
+        args[0].visit([&](auto cache) {
+            using type = typename decltype(cache)::value_type;
+            // Rows are copied as is, or quantized with the scale of their head
+            auto store = [&](auto x, std::size_t j) -> type {
+                if constexpr(std::is_same<decltype(x), type>{})
+                {
+                    if(scales.empty())
+                        return x;
+                }
+                double q = static_cast<float>(x);
+                if(not scales.empty())
+                    q /= scales[j / head_dim];
+                if(std::is_integral<type>{})
+                    q = std::nearbyint(q);
+                q = std::clamp<double>(q,
+                                       static_cast<float>(std::numeric_limits<type>::lowest()),
+                                       static_cast<float>(std::numeric_limits<type>::max()));
+                return static_cast<type>(static_cast<float>(q));
+            };
+            args[1].visit([&](auto update) {
+                for(std::size_t b = 0; b < batch; b++)
+                {
+                    if(positions[b] < 0)
+                        continue;
+                    for(std::size_t t = 0; t < seq_len; t++)
+                    {
+                        std::size_t pos = positions[b] + t;
+                        if(pos >= max_context)
+                            continue;
+                        auto blk = block_table[b * max_blocks + pos / block_size];
+                        if(blk < 0 or static_cast<std::size_t>(blk) >= num_blocks)
+                            continue;
+                        auto src = (b * seq_len + t) * row;
+                        auto dst = (blk * block_size + pos % block_size) * row;
+                        for(std::size_t j = 0; j < row; j++)
+                            cache[dst + j] = store(update[src + j], j);
+                    }
+                }
+            });
+        });
+        return args[0];
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 0; }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_LSTM_RECURRENCE_HPP
+#define MIGRAPHX_GUARD_OPERATORS_LSTM_RECURRENCE_HPP
+
+#include <migraphx/op/common.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/config.hpp>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * The recurrent part of an lstm with the default activations over every timestep, so the lstm
+ * doesn't have to be unrolled. The inputs are:
+ *
+ * gates: [seq_length, num_directions, batch_size, 4*hidden_size] the input projection X*W^T with
+ * both biases already added, in the iofc gate order of the lstm
+ * rt: [num_directions, hidden_size, 4*hidden_size] the recurrence weights R transposed
+ * initial_h, initial_c: [num_directions, batch_size, hidden_size]
+ * p (optional): [num_directions, 3*hidden_size] the peephole weights
+ *
+ * The output is a tuple of the hidden states of every timestep, the last hidden state and the
+ * last cell state.
+ */
+struct lstm_recurrence
+{
+    rnn_direction direction = rnn_direction::forward;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.direction, "direction"));
+    }
+
+    std::string name() const { return "lstm_recurrence"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(4, 5);
+        check_shapes{inputs.begin(), inputs.begin() + 4, *this}.same_type();
+        auto gates_lens = inputs[0].lens();
+        if(gates_lens.size() != 4 or gates_lens[3] != 4 * inputs[1].lens().at(1))
+            MIGRAPHX_THROW("LSTM_RECURRENCE: gates and recurrence weights mismatch");
+        std::size_t num_directions = direction == rnn_direction::bidirectional ? 2 : 1;
+        if(gates_lens[1] != num_directions)
+            MIGRAPHX_THROW("LSTM_RECURRENCE: num_direction does not match the direction");
+        std::vector<std::size_t> last_lens(gates_lens.begin() + 1, gates_lens.end());
+        last_lens.back() /= 4;
+        std::vector<std::size_t> hs_lens = gates_lens;
+        hs_lens.back() /= 4;
+        auto type = inputs[0].type();
+        return shape{{shape{type, hs_lens}, shape{type, last_lens}, shape{type, last_lens}}};
+    }
+
+    bool is_reverse(std::size_t d) const
+    {
+        return direction == rnn_direction::reverse or
+               (direction == rnn_direction::bidirectional and d == 1);
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        auto sub_shapes = output_shape.sub_shapes();
+        argument hidden{sub_shapes[0]};
+        argument last_h{sub_shapes[1]};
+        argument last_c{sub_shapes[2]};
+        auto lens           = sub_shapes[0].lens();
+        auto seq_len        = lens[0];
+        auto num_directions = lens[1];
+        auto batch_size     = lens[2];
+        auto hidden_size    = lens[3];
+        auto sigmoid        = [](double x) { return 1.0 / (1.0 + std::exp(-x)); };
+        visit_all(hidden, last_h, last_c, args[0], args[1], args[2], args[3])(
+            [&](auto hs, auto lh, auto lc, auto gates, auto rt, auto ih, auto ic) {
+                par_for(num_directions * batch_size, [&](auto i) {
+                    auto d = i / batch_size;
+                    auto b = i % batch_size;
+                    std::vector<double> h(hidden_size);
+                    std::vector<double> c(hidden_size);
+                    for(std::size_t k = 0; k < hidden_size; k++)
+                    {
+                        h[k] = ih(d, b, k);
+                        c[k] = ic(d, b, k);
+                    }
+                    auto peephole = [&](std::size_t gate, std::size_t k) {
+                        double result = 0;
+                        if(args.size() == 5)
+                            args[4].visit([&](auto p) { result = p(d, gate * hidden_size + k); });
+                        return result;
+                    };
+                    std::vector<double> next_h(hidden_size);
+                    for(std::size_t step = 0; step < seq_len; step++)
+                    {
+                        auto t = is_reverse(d) ? seq_len - 1 - step : step;
+                        for(std::size_t k = 0; k < hidden_size; k++)
+                        {
+                            std::array<double, 4> g;
+                            for(std::size_t gate = 0; gate < 4; gate++)
+                            {
+                                auto j  = gate * hidden_size + k;
+                                g[gate] = gates(t, d, b, j);
+                                for(std::size_t col = 0; col < hidden_size; col++)
+                                    g[gate] += h[col] * rt(d, col, j);
+                            }
+                            auto it        = sigmoid(g[0] + peephole(0, k) * c[k]);
+                            auto ft        = sigmoid(g[2] + peephole(2, k) * c[k]);
+                            c[k]           = ft * c[k] + it * std::tanh(g[3]);
+                            auto ot        = sigmoid(g[1] + peephole(1, k) * c[k]);
+                            next_h[k]      = ot * std::tanh(c[k]);
+                            hs(t, d, b, k) = next_h[k];
+                        }
+                        std::swap(h, next_h);
+                    }
+                    for(std::size_t k = 0; k < hidden_size; k++)
+                    {
+                        lh(d, b, k) = h[k];
+                        lc(d, b, k) = c[k];
+                    }
+                });
+            });
+        return argument{{hidden, last_h, last_c}};
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_PAGED_ATTENTION_HPP
+#define MIGRAPHX_GUARD_OPERATORS_PAGED_ATTENTION_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Attention of the query tokens over a paged key and value cache, as written by
+ * kv_cache_update:
+ *
+ *   query:        [batch, seq_len, heads, head_dim]
+ *   key_cache:    [num_blocks, block_size, kv_heads, head_dim]
+ *   value_cache:  [num_blocks, block_size, kv_heads, head_dim]
+ *   block_table:  [batch, max_blocks]
+ *   context_lens: [batch], number of tokens in each sequence including the query tokens
+ *   key_scales:   [kv_heads], optional
+ *   value_scales: [kv_heads], optional
+ *
+ * With scales, the caches can be stored quantized in another type than the query, such as int8
+ * or fp8, and each kv head is multiplied by its scale as it is read.
+ *
+ * The query tokens are the last seq_len tokens of each sequence, and each one only attends to
+ * the tokens up to and including itself. When there are fewer kv_heads than heads, each kv
+ * head is shared by a group of heads. A scale of 0 uses 1/sqrt(head_dim).
+ */
+struct paged_attention
+{
+    float scale = 0.0f;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scale, "scale"));
+    }
+
+    std::string name() const { return "paged_attention"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(5, 7).standard();
+        check_shapes{inputs.begin(), inputs.begin() + 3, *this}.only_dims(4);
+        check_shapes{inputs.begin() + 1, inputs.begin() + 3, *this}.same_type().same_dims();
+        if(inputs.size() == 5)
+            check_shapes{inputs.begin(), inputs.begin() + 3, *this}.same_type();
+        const auto& query        = inputs[0];
+        const auto& key_cache    = inputs[1];
+        const auto& block_table  = inputs[3];
+        const auto& context_lens = inputs[4];
+        auto heads               = query.lens()[2];
+        auto kv_heads            = key_cache.lens()[2];
+        if(query.lens()[3] != key_cache.lens()[3])
+            MIGRAPHX_THROW("PAGED_ATTENTION: head_dim of the query and cache differ");
+        if(kv_heads == 0 or heads % kv_heads != 0)
+            MIGRAPHX_THROW("PAGED_ATTENTION: heads must be a multiple of kv_heads");
+        if(not shape::is_integral(block_table.type()) or block_table.ndim() != 2)
+            MIGRAPHX_THROW("PAGED_ATTENTION: block table must be a 2D integral tensor");
+        if(not shape::is_integral(context_lens.type()) or context_lens.ndim() != 1)
+            MIGRAPHX_THROW("PAGED_ATTENTION: context lengths must be a 1D integral tensor");
+        if(block_table.lens()[0] != query.lens()[0] or context_lens.lens()[0] != query.lens()[0])
+            MIGRAPHX_THROW("PAGED_ATTENTION: batch size mismatch");
+        if(inputs.size() == 7 and
+           (inputs[5].lens() != std::vector<std::size_t>{kv_heads} or
+            inputs[6].lens() != std::vector<std::size_t>{kv_heads}))
+            MIGRAPHX_THROW("PAGED_ATTENTION: scales must have one element for each kv head");
+        return query;
+    }
+
+    float get_scale(std::size_t head_dim) const
+    {
+        if(scale == 0.0f)
+            return 1.0f / std::sqrt(static_cast<float>(head_dim));
+        return scale;
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        const auto& qlens      = args[0].get_shape().lens();
+        const auto& klens      = args[1].get_shape().lens();
+        std::size_t batch      = qlens[0];
+        std::size_t seq_len    = qlens[1];
+        std::size_t heads      = qlens[2];
+        std::size_t head_dim   = qlens[3];
+        std::size_t num_blocks = klens[0];
+        std::size_t block_size = klens[1];
+        std::size_t kv_heads   = klens[2];
+        std::size_t max_blocks = args[3].get_shape().lens()[1];
+        std::size_t group      = heads / kv_heads;
+        float s                = get_scale(head_dim);
+        auto block_table       = args[3].to_vector<std::int64_t>();
+        auto context_lens      = args[4].to_vector<std::int64_t>();
+        std::vector<float> key_scales(kv_heads, 1.0f);
+        std::vector<float> value_scales(kv_heads, 1.0f);
+        if(args.size() == 7)
+        {
+            key_scales   = args[5].to_vector<float>();
+            value_scales = args[6].to_vector<float>();
+        }
+        // offset of the token in the cache, or -1 if it is not in a block
+        auto cache_offset = [&](std::size_t b, std::size_t pos, std::size_t kvh) {
+            auto blk = block_table[b * max_blocks + pos / block_size];
+            if(blk < 0 or static_cast<std::size_t>(blk) >= num_blocks)
+                return std::ptrdiff_t{-1};
+            return static_cast<std::ptrdiff_t>(
+                ((blk * block_size + pos % block_size) * kv_heads + kvh) * head_dim);
+        };
+        visit_all(result, args[0])([&](auto output, auto query) {
+            visit_all(args[1], args[2])([&](auto key_cache, auto value_cache) {
+                std::vector<float> scores;
+                std::vector<float> acc(head_dim);
+                for(std::size_t b = 0; b < batch; b++)
+                {
+                    std::size_t context_len = std::min<std::size_t>(
+                        std::max<std::int64_t>(context_lens[b], 0), max_blocks * block_size);
+                    for(std::size_t t = 0; t < seq_len; t++)
+                    {
+                        // number of tokens visible to this query token
+                        std::size_t n = 0;
+                        if(context_len + t >= seq_len)
+                            n = std::min(context_len, context_len + t + 1 - seq_len);
+                        for(std::size_t h = 0; h < heads; h++)
+                        {
+                            auto kvh  = h / group;
+                            auto qoff = ((b * seq_len + t) * heads + h) * head_dim;
+                            scores.assign(n, std::numeric_limits<float>::lowest());
+                            for(std::size_t pos = 0; pos < n; pos++)
+                            {
+                                auto koff = cache_offset(b, pos, kvh);
+                                if(koff < 0)
+                                    continue;
+                                float dot = 0;
+                                for(std::size_t d = 0; d < head_dim; d++)
+                                    dot += static_cast<float>(query[qoff + d]) *
+                                           static_cast<float>(key_cache[koff + d]);
+                                scores[pos] = dot * s * key_scales[kvh];
+                            }
+                            auto m = std::accumulate(
+                                scores.begin(),
+                                scores.end(),
+                                std::numeric_limits<float>::lowest(),
+                                [](float x, float y) { return std::max(x, y); });
+                            float sum = 0;
+                            std::fill(acc.begin(), acc.end(), 0.0f);
+                            for(std::size_t pos = 0; pos < n; pos++)
+                            {
+                                auto voff = cache_offset(b, pos, kvh);
+                                if(voff < 0)
+                                    continue;
+                                float p = std::exp(scores[pos] - m);
+                                sum += p;
+                                for(std::size_t d = 0; d < head_dim; d++)
+                                    acc[d] += p * static_cast<float>(value_cache[voff + d]);
+                            }
+                            for(std::size_t d = 0; d < head_dim; d++)
+                                output[qoff + d] =
+                                    sum > 0 ? acc[d] * value_scales[kvh] / sum : 0.0f;
+                        }
+                    }
+                }
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
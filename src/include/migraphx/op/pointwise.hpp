@@ -70,26 +70,30 @@ struct pointwise
         auto pnames = pm->get_parameter_names();
         std::sort(pnames.begin(), pnames.end());
 
-        par_for(args[0].get_shape().elements(), [&](auto i) {
-            std::unordered_map<std::string, argument> params;
+        std::vector<argument> outputs;
+        if(output.get_sub_objects().empty())
+            outputs = {output.share()};
+        else
+            outputs = output.share().get_sub_objects();
 
-            std::transform(
-                pnames.begin(),
-                pnames.end(),
-                args.begin(),
-                std::inserter(params, params.end()),
-                [&](auto&& name, auto&& arg) { return std::make_pair(name, arg.element(i)); });
+        // Elements are evaluated in blocks so the parameter map is only built once per block
+        const std::size_t block = 256;
+        const std::size_t n     = args[0].get_shape().elements();
+        par_for((n + block - 1) / block, [&](auto b) {
+            std::unordered_map<std::string, argument> params;
+            for(std::size_t i = b * block; i < std::min(n, (b + 1) * block); i++)
+            {
+                for(auto j : range(pnames.size()))
+                    params[pnames[j]] = args[j].element(i);
 
-            auto results = run(pm, params);
-            assert(results.size() == output.get_sub_objects().size() or
-                   (results.size() == 1 and output.get_sub_objects().empty()));
-            std::vector<argument> outputs;
-            if(results.size() == 1)
-                outputs = {output.share()};
-            else
-                outputs = output.share().get_sub_objects();
-            for(auto j : range(results.size()))
-                visit_all(outputs[j], results[j])([&](auto out, auto x) { out[i] = x.front(); });
+                auto results = run(pm, params);
+                assert(results.size() == outputs.size());
+                for(auto j : range(results.size()))
+                {
+                    visit_all(outputs[j], results[j])(
+                        [&](auto out, auto x) { out[i] = x.front(); });
+                }
+            }
         });
         return output;
     }
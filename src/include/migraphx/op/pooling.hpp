@@ -311,8 +311,9 @@ struct pooling
                       const std::vector<std::size_t>& padding_vals,
                       Op op) const
     {
-        auto in_s    = input.get_shape();
-        auto in_lens = in_s.lens();
+        auto in_s       = input.get_shape();
+        auto in_lens    = in_s.lens();
+        auto in_strides = in_s.strides();
 
         // For each element of output; i.e., for each placement of pooling kernel...
         par_for(output_shape.elements(), [&](auto i) {
@@ -338,8 +339,11 @@ struct pooling
                     // padding.  Clip out-of-bounds indexes but not padding.
 
                     // Check if this kernel extends beyond the padding at end of dimension
+                    auto end_padding = padding_vals.size() == 2 * kernel_dims.size()
+                                           ? padding_vals[d_2 + kernel_dims.size()]
+                                           : padding_vals[d_2];
                     end = std::min(start + dilated_kernel_dim,
-                                   in_lens[dim] + static_cast<int>(padding_vals[d_2]));
+                                   in_lens[dim] + static_cast<int>(end_padding));
                 }
                 else
                 {
@@ -359,6 +363,7 @@ struct pooling
 
             auto pool_size    = win_shape.elements();
             double output_val = op.template init<Type>();
+            auto base_offset  = idx_o[0] * in_strides[0] + idx_o[1] * in_strides[1];
 
             // for each element in the window...
             shape_for_each(win_shape, [&](const auto& idx_w) {
@@ -372,24 +377,25 @@ struct pooling
                     }
                 }
 
-                // the coordinates of this element
-                auto idx = idx_o;
-
-                // Add the kernel location idx_w and the offset win_start, for each dimension.
-                // Negative results are cast to very large unsigned integers.
-                std::transform(idx_w.begin(),
-                               idx_w.end(),
-                               win_start.begin(),
-                               idx.begin() + 2,
-                               [](auto ii, auto jj) { return ii + jj; });
-                // Check if any of coordinates are out of input tensor's range
-                if(std::equal(idx.begin() + 2,
-                              idx.end(),
-                              in_lens.begin() + 2,
-                              in_lens.end(),
-                              std::less<>{}))
+                // the offset of this element. Add the kernel location idx_w and the offset
+                // win_start, for each dimension. Negative results are cast to very large
+                // unsigned integers, so they fail the range check like any other
+                // out-of-bounds coordinate.
+                std::size_t offset = base_offset;
+                bool in_bounds     = true;
+                for(std::size_t axis = 0; axis < idx_w.size(); ++axis)
                 {
-                    output_val = op(output_val, input[idx]);
+                    std::size_t x = idx_w[axis] + win_start[axis];
+                    if(x >= in_lens[axis + 2])
+                    {
+                        in_bounds = false;
+                        break;
+                    }
+                    offset += x * in_strides[axis + 2];
+                }
+                if(in_bounds)
+                {
+                    output_val = op(output_val, input.data()[offset]);
                 }
                 else
                 {
@@ -85,6 +85,14 @@ struct quant_dot
         } // else int8 gemm
         return {shape::int32_type, out_lens};
     }
+
+    // A multiply and add for each element of a and each column of b
+    std::size_t flops(const std::vector<shape>& inputs) const
+    {
+        if(inputs.size() < 2 or inputs[0].dynamic() or inputs[1].dynamic())
+            return 0;
+        return 2 * inputs[0].elements() * inputs[1].lens().back();
+    }
 };
 
 } // namespace op
@@ -27,6 +27,7 @@
 
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/context.hpp>
 #include <random>
 
 namespace migraphx {
@@ -56,7 +57,9 @@ struct random_seed
         return shape{dtype};
     }
 
-    argument compute(const shape& output_shape, const std::vector<argument>&) const
+    // Taking the context keeps the op from being evaluated as a constant at compile time, as the
+    // seed must be drawn on every run
+    argument compute(context&, const shape& output_shape, const std::vector<argument>&) const
     {
         argument result(output_shape);
 
@@ -195,19 +195,19 @@ struct reduce_op : op_name<Derived>
     template <class T>
     void reduce(const tensor_view<T>& input,
                 const shape& batch_shape,
-                const std::vector<int64_t>& tuned_axes,
+                const std::vector<std::size_t>& offsets,
                 const std::vector<std::size_t>& out_idx,
                 tensor_view<T>& output) const
     {
         using accumulator = accumulator_type<T>;
         auto& self        = static_cast<const Derived&>(*this);
-        auto data_idx     = out_idx;
+        const auto* data  = input.data() + input.get_shape().index(out_idx);
         accumulator val   = self.init();
-        shape_for_each(batch_shape, [&](const auto& b_idx) {
-            this->tune_dims(tuned_axes, b_idx, data_idx);
-            accumulator x = input(data_idx.begin(), data_idx.end());
+        for(auto offset : offsets)
+        {
+            accumulator x = data[offset];
             val           = self.op()(accumulator{self.input()(x)}, val);
-        });
+        }
 
         output(out_idx.begin(), out_idx.end()) =
             static_cast<const Derived&>(*this).output(batch_shape)(val);
@@ -223,10 +223,17 @@ struct reduce_op : op_name<Derived>
         shape batch_shape{computed_shape.type(), batch_lens};
         argument result{computed_shape};
 
+        // The reduced axes are zero in every output index, so the input offsets of the
+        // reduction window are the same for every output and only need computing once
+        std::vector<std::size_t> offsets(batch_shape.elements());
+        shape_for_each(batch_shape, [&](const auto& b_idx, auto i) {
+            offsets[i] = data_arg.get_shape().index(b_idx);
+        });
+
         visit_all(result, data_arg)([&](auto output, auto input) {
             par_for(computed_shape.elements(), [&](auto i) {
                 auto out_idx = computed_shape.multi(i);
-                this->reduce(input, batch_shape, reduce_axes, out_idx, output);
+                this->reduce(input, batch_shape, offsets, out_idx, output);
             });
         });
 
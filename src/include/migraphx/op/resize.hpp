@@ -41,7 +41,8 @@ namespace op {
 
 /**
  * The Resize operation mirrors the Onnx Resize operation with some differences.
- * Currently, only Nearest mode is supported.  "Axes" and "ROI" attributes not recognized.
+ * Nearest, linear and cubic modes are supported, with exclude_outside always 0.  "Axes" and
+ * "ROI" attributes not recognized.
  *
  * Accepts either one or two runtime inputs.
  * Input 0 - data to be resized
@@ -124,15 +125,25 @@ struct resize
         return idx_ops.at(s_mode);
     }
 
+    // Computes the cubic convolution weights of the four positions around a coordinate, where
+    // ratio is the distance of the coordinate from the second position.
+    static std::array<double, 4> get_cubic_coeffs(double ratio, double a)
+    {
+        auto far  = [&](double t) { return ((a * t - 5 * a) * t + 8 * a) * t - 4 * a; };
+        auto near = [&](double t) { return ((a + 2) * t - (a + 3)) * t * t + 1; };
+        return {far(ratio + 1), near(ratio), near(1 - ratio), far(2 - ratio)};
+    }
+
     std::vector<float> scales;
     std::vector<size_t> sizes;
     // what integer rounding rule to use with Nearest mode.
     std::string nearest_mode{"floor"};
-    // Resizing modes.  1: nearest 2: bilinear/linear 3: cubic
-    // Only "nearest" currently supported.
+    // Resizing modes: nearest, linear or cubic
     std::string mode{"nearest"};
     // What floating-point conversion rule to use (any resizing mode)
     std::string coordinate_transformation_mode;
+    // The "a" coefficient of the cubic convolution
+    float cubic_coeff_a = -0.75f;
 
     std::string name() const { return "resize"; }
 
@@ -143,15 +154,88 @@ struct resize
                     f(self.sizes, "sizes"),
                     f(self.nearest_mode, "nearest_mode"),
                     f(self.mode, "mode"),
-                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"));
+                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"),
+                    f(self.cubic_coeff_a, "cubic_coeff_a"));
+    }
+
+    // The scales of the coordinate transformation when the sizes or scales are attributes
+    std::vector<float> get_scales(const std::vector<std::size_t>& in_lens) const
+    {
+        if(not scales.empty())
+            return scales;
+        std::vector<float> result(in_lens.size());
+        std::transform(sizes.begin(),
+                       sizes.end(),
+                       in_lens.begin(),
+                       result.begin(),
+                       [](size_t out_len, size_t in_len) {
+                           return (in_len == 0 ? 1.f : static_cast<float>(out_len) / in_len);
+                       });
+        return result;
+    }
+
+    // The number of positions of the input read along each axis
+    std::size_t sample_count() const
+    {
+        if(mode == "linear")
+            return 2;
+        if(mode == "cubic")
+            return 4;
+        return 1;
+    }
+
+    // The positions of the input read along an axis for each position of the output, and their
+    // weights.  There are sample_count() of them for each position of the output, and positions
+    // outside of the input are clamped to its edges.
+    struct axis_samples
+    {
+        std::vector<std::size_t> indices;
+        std::vector<float> weights;
+    };
+
+    axis_samples samples(std::size_t in_len, std::size_t out_len, double scale) const
+    {
+        auto idx_op = get_original_idx_op(coordinate_transformation_mode);
+        auto last   = static_cast<std::int64_t>(in_len) - 1;
+        axis_samples result;
+        for(std::size_t i = 0; i < out_len; ++i)
+        {
+            auto x = idx_op(in_len, out_len, i, scale);
+            if(mode == "nearest")
+            {
+                result.indices.push_back(get_nearest_op(nearest_mode)(in_len, x));
+                result.weights.push_back(1.0f);
+            }
+            else if(mode == "linear")
+            {
+                x          = std::max(0.0, std::min<double>(last, x));
+                auto low   = static_cast<std::size_t>(std::floor(x));
+                auto high  = static_cast<std::size_t>(std::ceil(x));
+                auto delta = static_cast<float>(x - low);
+                result.indices.insert(result.indices.end(), {low, high});
+                result.weights.insert(result.weights.end(), {1.0f - delta, delta});
+            }
+            else
+            {
+                auto start  = static_cast<std::int64_t>(std::floor(x)) - 1;
+                auto coeffs = get_cubic_coeffs(x - std::floor(x), cubic_coeff_a);
+                for(std::int64_t k = 0; k < 4; ++k)
+                {
+                    auto j = std::max<std::int64_t>(0, std::min(last, start + k));
+                    result.indices.push_back(j);
+                    result.weights.push_back(static_cast<float>(coeffs[k]));
+                }
+            }
+        }
+        return result;
     }
 
     shape compute_shape(std::vector<shape> inputs) const
     {
         check_shapes{inputs, *this, true}.has(1, 2);
 
-        if(mode != "nearest")
-            MIGRAPHX_THROW("RESIZE: Only Nearest mode is supported");
+        if(not contains({"nearest", "linear", "cubic"}, mode))
+            MIGRAPHX_THROW("RESIZE: unsupported mode " + mode);
 
         // Inputs are X, sizes or scale, ROI and axes not supported.
         if(inputs.size() == 1)
@@ -221,22 +305,13 @@ struct resize
         {
             // single input argument; sizes or scales is constant.
             // In practice, the input is never a dynamic shape.
+            vec_scale = get_scales(in_lens);
             if(not sizes.empty())
             {
                 out_lens = sizes;
-                // compute scales
-                std::transform(out_lens.begin(),
-                               out_lens.end(),
-                               in_lens.begin(),
-                               vec_scale.begin(),
-                               [](size_t out_len, size_t in_len) {
-                                   return (in_len == 0 ? 1.f
-                                                       : static_cast<float>(out_len) / in_len);
-                               });
             }
             else
             {
-                vec_scale = this->scales;
                 // compute output sizes
                 std::transform(in_lens.begin(),
                                in_lens.end(),
@@ -286,6 +361,9 @@ struct resize
 
         shape output_shape = {args[0].get_shape().type(), out_lens};
         argument result{output_shape};
+        if(mode != "nearest")
+            return interpolate(output_shape, args[0], vec_scale);
+
         auto nearest_op = get_nearest_op(nearest_mode);
         auto idx_op     = get_original_idx_op(coordinate_transformation_mode);
 
@@ -304,6 +382,41 @@ struct resize
         });
         return result;
     }
+
+    // Linear and cubic modes take the weighted sum of the positions read along each axis
+    argument interpolate(const shape& output_shape,
+                         const argument& input,
+                         const std::vector<float>& vec_scale) const
+    {
+        const auto& in_lens  = input.get_shape().lens();
+        const auto& out_lens = output_shape.lens();
+        std::vector<axis_samples> axes;
+        for(std::size_t ii = 0; ii < in_lens.size(); ++ii)
+            axes.push_back(samples(in_lens[ii], out_lens[ii], vec_scale[ii]));
+
+        auto count = sample_count();
+        shape neighbors{shape::float_type, std::vector<std::size_t>(in_lens.size(), count)};
+        argument result{output_shape};
+        visit_all(result, input)([&](auto output, auto data) {
+            using type = typename decltype(output)::value_type;
+            shape_for_each(output_shape, [&](const auto& out_idx_v, std::size_t out_idx) {
+                std::vector<std::size_t> in_idx(out_idx_v.size());
+                double acc = 0;
+                shape_for_each(neighbors, [&](const auto& k, std::size_t) {
+                    double weight = 1;
+                    for(std::size_t ii = 0; ii < in_idx.size(); ++ii)
+                    {
+                        auto j     = out_idx_v[ii] * count + k[ii];
+                        in_idx[ii] = axes[ii].indices[j];
+                        weight *= axes[ii].weights[j];
+                    }
+                    acc += weight * data(in_idx.begin(), in_idx.end());
+                });
+                output[out_idx] = static_cast<type>(acc);
+            });
+        });
+        return result;
+    }
 };
 
 } // namespace op
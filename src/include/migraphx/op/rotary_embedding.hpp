@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_ROTARY_EMBEDDING_HPP
+#define MIGRAPHX_GUARD_OPERATORS_ROTARY_EMBEDDING_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/value.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Rotary position embedding over the last axis of the input:
+ *
+ *     output = x * cos + rotate(x) * sin
+ *
+ * The cos and sin tables have the same shape as the input, usually broadcast over the batch and
+ * the heads. rotate pairs each element with the one half of the axis away, as
+ * concat(-x[d/2:], x[:d/2]), or with its neighbour when interleaved, as (-x[2i+1], x[2i]).
+ */
+struct rotary_embedding
+{
+    bool interleaved = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.interleaved, "interleaved"));
+    }
+
+    std::string name() const { return "rotary_embedding"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(3).same_type().same_dims();
+        const auto& s = inputs.front();
+        if(s.ndim() == 0 or s.lens().back() % 2 != 0)
+            MIGRAPHX_THROW("ROTARY_EMBEDDING: last dimension must be even");
+        return {s.type(), s.lens()};
+    }
+
+    // Index of the element on the last axis that j is rotated with, and whether it is negated
+    std::pair<std::size_t, bool> partner(std::size_t j, std::size_t d) const
+    {
+        if(interleaved)
+            return {j ^ 1u, j % 2 == 0};
+        return {(j + d / 2) % d, j < d / 2};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        auto d = output_shape.lens().back();
+        visit_all(result, args[0], args[1], args[2])([&](auto output, auto x, auto c, auto s) {
+            shape_for_each(output_shape, [&](const auto& idx, std::size_t i) {
+                auto [j, negate] = partner(idx.back(), d);
+                auto pidx        = idx;
+                pidx.back()      = j;
+                auto rotated     = x[x.get_shape().index(pidx)];
+                if(negate)
+                    rotated = -rotated;
+                output[i] = x[x.get_shape().index(idx)] * c[c.get_shape().index(idx)] +
+                            rotated * s[s.get_shape().index(idx)];
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -26,21 +26,72 @@
 
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/module.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/stringutils.hpp>
+#include <memory>
+#include <mutex>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace op {
 
+/**
+ * Runs the submodule whose parameter shapes match the input arguments. When no submodule
+ * matches exactly, the smallest submodule that every input fits into is used instead: the
+ * inputs are padded up to its shapes and the outputs are sliced back along the dynamic
+ * dimensions. This allows the submodules to be compiled for only a few bucket sizes.
+ *
+ * If `inputs_padded` is set, the inputs are already laid out in buffers with the strides of the
+ * submodule they are padded to, so they are reinterpreted at the larger shape rather than copied.
+ * This works for a dynamic dimension on any axis, but an input that isn't laid out that way is
+ * an error.
+ *
+ * When only one dimension of the inputs is dynamic, `make_dispatch_table` precomputes the
+ * submodule for each of its sizes, so the submodule is picked by a lookup of the size of
+ * `dispatch_axis` of input `dispatch_input` instead of by matching every parameter shape. The
+ * shapes are still matched when the submodule from the table doesn't fit the inputs.
+ */
 struct select_module
 {
     shape output_dyn_shapes;
+    bool inputs_padded                      = false;
+    std::size_t dispatch_input              = 0;
+    std::size_t dispatch_axis               = 0;
+    std::size_t dispatch_min                = 0;
+    std::vector<std::size_t> dispatch_table = {};
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
-        return pack(f(self.output_dyn_shapes, "output_dyn_shapes"));
+        return pack(f(self.output_dyn_shapes, "output_dyn_shapes"),
+                    f(self.inputs_padded, "inputs_padded"),
+                    f(self.dispatch_input, "dispatch_input"),
+                    f(self.dispatch_axis, "dispatch_axis"),
+                    f(self.dispatch_min, "dispatch_min"),
+                    f(self.dispatch_table, "dispatch_table"));
     }
 
+    // The parameters of a submodule in the order they are passed to it
+    struct variant
+    {
+        std::vector<std::string> input_names;
+        std::vector<std::string> output_names;
+        std::vector<shape> input_shapes;
+        std::vector<shape> output_shapes;
+        std::size_t elements = 0;
+    };
+
+    // The variants are computed once for the submodules rather than on every call
+    struct variant_cache
+    {
+        std::mutex m;
+        std::vector<module_ref> modules;
+        std::shared_ptr<const std::vector<variant>> variants = nullptr;
+    };
+    std::shared_ptr<variant_cache> cache = std::make_shared<variant_cache>();
+
     std::string name() const { return "select_module"; }
 
     shape compute_shape(const std::vector<shape>& inputs, const std::vector<module_ref>&) const
@@ -74,66 +125,254 @@ struct select_module
         return ret;
     }
 
+    static std::size_t module_elements(module_ref mr)
+    {
+        auto param_shapes = mr->get_parameter_shapes();
+        return std::accumulate(
+            param_shapes.begin(), param_shapes.end(), std::size_t{0}, [](auto n, const auto& p) {
+                return n + p.second.elements();
+            });
+    }
+
+    variant make_variant(module_ref mr) const
+    {
+        variant v;
+        v.input_names     = get_input_parameter_names(mr);
+        v.output_names    = get_output_parameter_names(mr);
+        auto param_shapes = mr->get_parameter_shapes();
+        auto get_shape    = [&](const std::string& pname) { return param_shapes.at(pname); };
+        std::transform(v.input_names.begin(),
+                       v.input_names.end(),
+                       std::back_inserter(v.input_shapes),
+                       get_shape);
+        std::transform(v.output_names.begin(),
+                       v.output_names.end(),
+                       std::back_inserter(v.output_shapes),
+                       get_shape);
+        v.elements = module_elements(mr);
+        return v;
+    }
+
+    std::shared_ptr<const std::vector<variant>>
+    get_variants(const std::vector<module_ref>& submodule_list) const
+    {
+        std::lock_guard<std::mutex> lock(cache->m);
+        if(cache->variants == nullptr or cache->modules != submodule_list)
+        {
+            std::vector<variant> variants;
+            std::transform(submodule_list.begin(),
+                           submodule_list.end(),
+                           std::back_inserter(variants),
+                           [&](module_ref mr) { return make_variant(mr); });
+            cache->modules  = submodule_list;
+            cache->variants = std::make_shared<const std::vector<variant>>(std::move(variants));
+        }
+        return cache->variants;
+    }
+
+    static const shape& input_shape(const shape& s) { return s; }
+    static const shape& input_shape(const argument& a) { return a.get_shape(); }
+
+    template <class Inputs>
+    static bool fits_variant(const variant& v, const Inputs& inputs)
+    {
+        assert(v.input_shapes.size() <= inputs.size());
+        return std::equal(v.input_shapes.begin(),
+                          v.input_shapes.end(),
+                          inputs.begin(),
+                          [](const shape& ps, const auto& input) {
+                              const auto& as = input_shape(input);
+                              return as.type() == ps.type() and as.ndim() == ps.ndim() and
+                                     std::equal(as.lens().begin(),
+                                                as.lens().end(),
+                                                ps.lens().begin(),
+                                                std::less_equal<>{});
+                          });
+    }
+
+    /// Returns the index of the submodule to run for the input shapes, or the number of
+    /// submodules when none of them fit
+    static std::size_t find_variant(const std::vector<variant>& variants,
+                                    const std::vector<shape>& inputs)
+    {
+        // Find submodule with input parameter shapes exactly the same as the inputs. Assuming
+        // the inputs are in the same order as the parameters.
+        auto exact = std::find_if(variants.begin(), variants.end(), [&](const variant& v) {
+            assert(v.input_shapes.size() <= inputs.size());
+            return std::equal(v.input_shapes.begin(), v.input_shapes.end(), inputs.begin());
+        });
+        if(exact != variants.end())
+            return exact - variants.begin();
+        // Otherwise the smallest submodule they fit into
+        std::size_t result = variants.size();
+        for(std::size_t i = 0; i < variants.size(); ++i)
+        {
+            if(not fits_variant(variants[i], inputs))
+                continue;
+            if(result == variants.size() or variants[i].elements < variants[result].elements)
+                result = i;
+        }
+        return result;
+    }
+
+    /// Fill the dispatch table for the dynamic input shapes, when there is only a single dynamic
+    /// dimension across all of the inputs, with few enough sizes
+    void make_dispatch_table(const std::vector<shape>& inputs,
+                             const std::vector<module_ref>& submodule_list)
+    {
+        const std::size_t max_table_size = 1u << 16u;
+        dispatch_table.clear();
+        optional<shape::dynamic_dimension> dim;
+        for(std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            if(not inputs[i].dynamic())
+                continue;
+            const auto& dds = inputs[i].dyn_dims();
+            for(std::size_t axis = 0; axis < dds.size(); ++axis)
+            {
+                if(dds[axis].is_fixed())
+                    continue;
+                // The lookup only reads one dimension, so the others couldn't be told apart
+                if(dim.has_value())
+                    return;
+                dim            = dds[axis];
+                dispatch_input = i;
+                dispatch_axis  = axis;
+            }
+        }
+        if(not dim.has_value() or dim->max - dim->min >= max_table_size)
+            return;
+        dispatch_min  = dim->min;
+        auto variants = get_variants(submodule_list);
+        std::vector<shape> static_inputs(inputs.size());
+        for(std::size_t n = dim->min; n <= dim->max; ++n)
+        {
+            std::transform(inputs.begin(), inputs.end(), static_inputs.begin(), [&](auto s) {
+                return s.dynamic() ? s.to_static(n) : s;
+            });
+            dispatch_table.push_back(find_variant(*variants, static_inputs));
+        }
+    }
+
+    std::size_t select(const std::vector<variant>& variants,
+                       const std::vector<argument>& args) const
+    {
+        if(not dispatch_table.empty() and dispatch_input < args.size())
+        {
+            const auto& lens = args[dispatch_input].get_shape().lens();
+            if(dispatch_axis < lens.size() and lens[dispatch_axis] >= dispatch_min and
+               lens[dispatch_axis] - dispatch_min < dispatch_table.size())
+            {
+                auto index = dispatch_table[lens[dispatch_axis] - dispatch_min];
+                // Fall back to matching the shapes if the other dimensions don't fit
+                if(index < variants.size() and fits_variant(variants[index], args))
+                    return index;
+            }
+        }
+        std::vector<shape> inputs;
+        std::transform(args.begin(), args.end(), std::back_inserter(inputs), [](const auto& a) {
+            return a.get_shape();
+        });
+        return find_variant(variants, inputs);
+    }
+
+    argument pad_argument(const argument& a, const shape& s) const
+    {
+        if(inputs_padded)
+        {
+            if(a.get_shape().strides() != s.strides())
+                MIGRAPHX_THROW("SELECT_MODULE: input " + to_string(a.get_shape()) +
+                               " is not laid out for the padded shape " + to_string(s));
+            auto data = a.share();
+            return {s, [data]() mutable { return data.data(); }};
+        }
+        argument result{s};
+        visit_all(result, a)([&](auto output, auto input) {
+            std::fill(output.begin(), output.end(), 0);
+            shape_for_each(input.get_shape(), [&](const auto& idx) {
+                output(idx.begin(), idx.end()) = input(idx.begin(), idx.end());
+            });
+        });
+        return result;
+    }
+
     argument compute(const shape&,
                      const std::vector<argument>& args,
                      const std::vector<module_ref>& submodule_list,
                      const std::function<std::vector<argument>(
                          module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
     {
-        // Find submodule with input parameter shapes exactly the same as the input instruction
-        // arguments. Assuming instruction arguments are in the same order as the instruction
-        // parameters.
-        auto module_iter =
-            std::find_if(submodule_list.cbegin(), submodule_list.cend(), [&](module_ref mr) {
-                auto in_param_names = get_input_parameter_names(mr);
-                auto param_shapes   = mr->get_parameter_shapes();
-                assert(in_param_names.size() <= args.size());
-                return std::equal(
-                    in_param_names.cbegin(),
-                    in_param_names.cend(),
-                    args.cbegin(),
-                    [&](auto p_name, auto a) { return a.get_shape() == param_shapes[p_name]; });
-            });
-
-        if(module_iter == submodule_list.end())
+        auto variants = get_variants(submodule_list);
+        auto index    = select(*variants, args);
+        if(index >= variants->size())
         {
             MIGRAPHX_THROW("SELECT_MODULE: no compatible submodules found for given input shapes");
         }
-
-        auto* module_to_run = *module_iter;
+        const auto& v       = (*variants)[index];
+        auto* module_to_run = submodule_list[index];
         std::unordered_map<std::string, argument> p_map;
 
-        // add input parameters to parameter_map
-        auto in_param_names = get_input_parameter_names(module_to_run);
-        assert(in_param_names.size() <= args.size());
-        std::transform(in_param_names.begin(),
-                       in_param_names.end(),
-                       args.begin(),
-                       std::inserter(p_map, p_map.end()),
-                       [&](auto&& name, auto&& a) { return std::make_pair(name, a); });
+        // add input parameters to parameter_map, padding them when a larger submodule is used
+        assert(v.input_names.size() <= args.size());
+        // actual and padded size of the dynamic dimension
+        std::size_t dim_size    = 0;
+        std::size_t padded_size = 0;
+        for(std::size_t i = 0; i < v.input_names.size(); ++i)
+        {
+            const auto& ps = v.input_shapes[i];
+            const auto& a  = args[i];
+            if(a.get_shape() == ps)
+            {
+                p_map.emplace(v.input_names[i], a);
+                continue;
+            }
+            auto [it, pit] = std::mismatch(
+                a.get_shape().lens().begin(), a.get_shape().lens().end(), ps.lens().begin());
+            if(it != a.get_shape().lens().end())
+            {
+                dim_size    = *it;
+                padded_size = *pit;
+            }
+            p_map.emplace(v.input_names[i], pad_argument(a, ps));
+        }
 
         // One tuple output parameter in main module to multiple output parameters in submodule
-        auto out_param_names    = get_output_parameter_names(module_to_run);
-        auto param_shapes       = module_to_run->get_parameter_shapes();
         auto output_sub_objects = args.back().get_sub_objects();
-        assert(out_param_names.size() == output_sub_objects.size());
-        std::transform(out_param_names.begin(),
-                       out_param_names.end(),
-                       output_sub_objects.begin(),
-                       std::inserter(p_map, p_map.end()),
-                       [&](auto&& name, auto&& a) {
-                           auto ps = param_shapes.at(name);
-                           if(a.get_shape() != ps)
-                           {
-                               assert(ps.bytes() <= a.get_shape().bytes());
-                               return std::make_pair(name, a.reshape(ps));
-                           }
-                           else
-                           {
-                               return std::make_pair(name, a);
-                           }
-                       });
+        assert(v.output_names.size() == output_sub_objects.size());
+        for(std::size_t i = 0; i < v.output_names.size(); ++i)
+        {
+            const auto& ps = v.output_shapes[i];
+            const auto& a  = output_sub_objects[i];
+            if(a.get_shape() != ps)
+            {
+                assert(ps.bytes() <= a.get_shape().bytes());
+                p_map.emplace(v.output_names[i], a.reshape(ps));
+            }
+            else
+            {
+                p_map.emplace(v.output_names[i], a);
+            }
+        }
         auto results = run(module_to_run, p_map);
+        if(padded_size != dim_size)
+        {
+            // slice the outputs back along the dynamic dimensions
+            const auto& out_shapes = output_dyn_shapes.sub_shapes();
+            for(std::size_t i = 0; i < results.size() and i < out_shapes.size(); ++i)
+            {
+                if(not out_shapes[i].dynamic())
+                    continue;
+                const auto& rs  = results[i].get_shape();
+                const auto& dds = out_shapes[i].dyn_dims();
+                auto lens       = rs.lens();
+                for(std::size_t axis = 0; axis < lens.size() and axis < dds.size(); ++axis)
+                {
+                    if(not dds[axis].is_fixed() and lens[axis] == padded_size)
+                        lens[axis] = dim_size;
+                }
+                results[i] = results[i].reshape({rs.type(), lens, rs.strides()});
+            }
+        }
         return argument{results};
     }
 
@@ -0,0 +1,170 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_VARLEN_ATTENTION_HPP
+#define MIGRAPHX_GUARD_OPERATORS_VARLEN_ATTENTION_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Attention over a batch of sequences of different lengths, packed one after the other without
+ * padding:
+ *
+ *   query:      [tokens, heads, head_dim]
+ *   key:        [tokens, kv_heads, head_dim]
+ *   value:      [tokens, kv_heads, head_dim]
+ *   cu_seqlens: [batch + 1], the first token of each sequence followed by the number of tokens
+ *
+ * Each token only attends to the tokens of its own sequence, and with causal only to the ones up
+ * to and including itself, so a batch costs its number of tokens instead of batch times the
+ * longest sequence. Tokens past the last sequence are set to zero. When there are fewer kv_heads
+ * than heads, each kv head is shared by a group of heads. A scale of 0 uses 1/sqrt(head_dim).
+ */
+struct varlen_attention
+{
+    float scale = 0.0f;
+    bool causal = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scale, "scale"), f(self.causal, "causal"));
+    }
+
+    std::string name() const { return "varlen_attention"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(4).standard();
+        check_shapes{inputs.begin(), inputs.begin() + 3, *this}.same_type().only_dims(3);
+        check_shapes{inputs.begin() + 1, inputs.begin() + 3, *this}.same_dims();
+        const auto& query      = inputs[0];
+        const auto& key        = inputs[1];
+        const auto& cu_seqlens = inputs[3];
+        auto heads             = query.lens()[1];
+        auto kv_heads          = key.lens()[1];
+        if(query.lens()[0] != key.lens()[0] or query.lens()[2] != key.lens()[2])
+            MIGRAPHX_THROW("VARLEN_ATTENTION: tokens or head_dim of the query and key differ");
+        if(kv_heads == 0 or heads % kv_heads != 0)
+            MIGRAPHX_THROW("VARLEN_ATTENTION: heads must be a multiple of kv_heads");
+        if(not shape::is_integral(cu_seqlens.type()) or cu_seqlens.ndim() != 1 or
+           cu_seqlens.elements() < 2)
+            MIGRAPHX_THROW("VARLEN_ATTENTION: sequence offsets must be a 1D integral tensor with "
+                           "at least two elements");
+        return query;
+    }
+
+    float get_scale(std::size_t head_dim) const
+    {
+        if(scale == 0.0f)
+            return 1.0f / std::sqrt(static_cast<float>(head_dim));
+        return scale;
+    }
+
+    // The range of keys visible to token t, which is empty when t is not in a sequence
+    std::pair<std::size_t, std::size_t> visible(const std::vector<std::int64_t>& cu_seqlens,
+                                                std::size_t t) const
+    {
+        auto it = std::upper_bound(cu_seqlens.begin(), cu_seqlens.end(), std::int64_t(t));
+        if(it == cu_seqlens.begin() or it == cu_seqlens.end())
+            return {0, 0};
+        auto start = static_cast<std::size_t>(std::max<std::int64_t>(*std::prev(it), 0));
+        auto end   = causal ? t + 1 : static_cast<std::size_t>(*it);
+        return {start, end};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        const auto& qlens    = args[0].get_shape().lens();
+        std::size_t tokens   = qlens[0];
+        std::size_t heads    = qlens[1];
+        std::size_t head_dim = qlens[2];
+        std::size_t kv_heads = args[1].get_shape().lens()[1];
+        std::size_t group    = heads / kv_heads;
+        float s              = get_scale(head_dim);
+        auto cu_seqlens      = args[3].to_vector<std::int64_t>();
+        visit_all(result, args[0])([&](auto output, auto query) {
+            visit_all(args[1], args[2])([&](auto key, auto value) {
+                std::vector<float> scores;
+                std::vector<float> acc(head_dim);
+                for(std::size_t t = 0; t < tokens; t++)
+                {
+                    auto [start, end] = visible(cu_seqlens, t);
+                    end               = std::max(start, std::min(end, tokens));
+                    for(std::size_t h = 0; h < heads; h++)
+                    {
+                        auto kvh  = h / group;
+                        auto qoff = (t * heads + h) * head_dim;
+                        scores.assign(end - start, 0.0f);
+                        for(std::size_t j = start; j < end; j++)
+                        {
+                            auto koff = (j * kv_heads + kvh) * head_dim;
+                            float dot = 0;
+                            for(std::size_t d = 0; d < head_dim; d++)
+                                dot += static_cast<float>(query[qoff + d]) *
+                                       static_cast<float>(key[koff + d]);
+                            scores[j - start] = dot * s;
+                        }
+                        auto m = std::accumulate(
+                            scores.begin(),
+                            scores.end(),
+                            std::numeric_limits<float>::lowest(),
+                            [](float x, float y) { return std::max(x, y); });
+                        float sum = 0;
+                        std::fill(acc.begin(), acc.end(), 0.0f);
+                        for(std::size_t j = start; j < end; j++)
+                        {
+                            auto voff = (j * kv_heads + kvh) * head_dim;
+                            float p   = std::exp(scores[j - start] - m);
+                            sum += p;
+                            for(std::size_t d = 0; d < head_dim; d++)
+                                acc[d] += p * static_cast<float>(value[voff + d]);
+                        }
+                        for(std::size_t d = 0; d < head_dim; d++)
+                            output[qoff + d] = sum > 0 ? acc[d] / sum : 0.0f;
+                    }
+                }
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
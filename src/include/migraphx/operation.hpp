@@ -82,6 +82,9 @@ struct operation
     /// An optional method to return which argument the output will alias. If
     /// there is no aliased output then -1 can be returned.
     std::ptrdiff_t output_alias(const std::vector<shape>& input) const;
+    /// An optional estimate of the arithmetic operations done for these inputs, used to report
+    /// the achieved flops. Pointwise and reduce operators count one per element by default.
+    std::size_t flops(const std::vector<shape>& input) const;
     /// An optional stream operator to print the operation. When this is not
     /// implemented, it will just print the operation's name.
     friend std::ostream& operator<<(std::ostream& os, const operation& op);
@@ -479,6 +482,30 @@ value attributes_op(const T&)
     return value::object{};
 }
 
+template <class T>
+auto flops_attributes(rank<1>, const T& x) -> decltype(x.attributes())
+{
+    return x.attributes();
+}
+
+template <class T>
+value flops_attributes(rank<0>, const T&)
+{
+    return value::object{};
+}
+
+template <class T>
+std::size_t flops_op(const T& x, const std::vector<shape>& inputs)
+{
+    auto attr = flops_attributes(rank<1>{}, x);
+    if(not attr.contains("pointwise") and not attr.contains("reduce"))
+        return 0;
+    std::size_t n = 0;
+    for(const auto& s : inputs)
+        n = std::max(n, s.elements());
+    return n;
+}
+
 template <class T>
 value to_value_op(const T& x)
 {
@@ -550,6 +577,8 @@ struct MIGRAPHX_EXPORT operation
     void from_value(const value& v);
     // (optional)
     value attributes() const;
+    // (optional)
+    std::size_t flops(const std::vector<shape>& input) const;
     //
     friend std::ostream& operator<<(std::ostream& os, const operation& op);
     //
@@ -847,6 +876,23 @@ struct operation
         return detail::attributes_op(private_detail_te_self);
     }
 
+    template <class T>
+    static auto private_detail_te_default_flops(char,
+                                                T&& private_detail_te_self,
+                                                const std::vector<shape>& input)
+        -> decltype(private_detail_te_self.flops(input))
+    {
+        return private_detail_te_self.flops(input);
+    }
+
+    template <class T>
+    static std::size_t private_detail_te_default_flops(float,
+                                                       T&& private_detail_te_self,
+                                                       const std::vector<shape>& input)
+    {
+        return detail::flops_op(private_detail_te_self, input);
+    }
+
     template <class PrivateDetailTypeErasedT>
     struct private_te_unwrap_reference
     {
@@ -926,6 +972,9 @@ struct operation
                                                       std::declval<const value&>()),
                  private_detail_te_default_attributes(char(0),
                                                       std::declval<PrivateDetailTypeErasedT>()),
+                 private_detail_te_default_flops(char(0),
+                                                 std::declval<PrivateDetailTypeErasedT>(),
+                                                 std::declval<const std::vector<shape>&>()),
                  static_cast<void>(void()),
                  static_cast<void>(void()),
                  void());
@@ -1116,6 +1165,12 @@ struct operation
         return (*this).private_detail_te_get_handle().attributes();
     }
 
+    std::size_t flops(const std::vector<shape>& input) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().flops(input);
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const operation& op)
     {
         assert(op.private_detail_te_handle_mem_var);
@@ -1173,6 +1228,7 @@ struct operation
         virtual value to_value() const                                                         = 0;
         virtual void from_value(const value& v)                                                = 0;
         virtual value attributes() const                                                       = 0;
+        virtual std::size_t flops(const std::vector<shape>& input) const                      = 0;
         virtual std::ostream& operator_shift_left(std::ostream& os) const                      = 0;
         virtual bool operator==(const operation& y) const                                      = 0;
     };
@@ -1324,6 +1380,12 @@ struct operation
             return private_detail_te_default_attributes(char(0), private_detail_te_value);
         }
 
+        std::size_t flops(const std::vector<shape>& input) const override
+        {
+
+            return private_detail_te_default_flops(char(0), private_detail_te_value, input);
+        }
+
         std::ostream& operator_shift_left(std::ostream& os) const override
         {
             using migraphx::detail::operation_operators::operator<<;
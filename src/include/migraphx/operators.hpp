@@ -28,6 +28,8 @@
 #include <migraphx/op/acos.hpp>
 #include <migraphx/op/acosh.hpp>
 #include <migraphx/op/add.hpp>
+#include <migraphx/op/all_gather.hpp>
+#include <migraphx/op/all_reduce.hpp>
 #include <migraphx/op/argmax.hpp>
 #include <migraphx/op/argmin.hpp>
 #include <migraphx/op/asin.hpp>
@@ -35,6 +37,7 @@
 #include <migraphx/op/as_shape.hpp>
 #include <migraphx/op/atan.hpp>
 #include <migraphx/op/atanh.hpp>
+#include <migraphx/op/beam_step.hpp>
 #include <migraphx/op/binary.hpp>
 #include <migraphx/op/bitwise_and.hpp>
 #include <migraphx/op/broadcast.hpp>
@@ -64,11 +67,15 @@
 #include <migraphx/op/gathernd.hpp>
 #include <migraphx/op/get_tuple_elem.hpp>
 #include <migraphx/op/greater.hpp>
+#include <migraphx/op/gridsample.hpp>
 #include <migraphx/op/gru.hpp>
 #include <migraphx/op/identity.hpp>
 #include <migraphx/op/if_op.hpp>
 #include <migraphx/op/im2col.hpp>
+#include <migraphx/op/image_preprocess.hpp>
 #include <migraphx/op/isnan.hpp>
+#include <migraphx/op/kv_cache_copy_blocks.hpp>
+#include <migraphx/op/kv_cache_update.hpp>
 #include <migraphx/op/leaky_relu.hpp>
 #include <migraphx/op/less.hpp>
 #include <migraphx/op/load.hpp>
@@ -81,6 +88,7 @@
 #include <migraphx/op/loop.hpp>
 #include <migraphx/op/lrn.hpp>
 #include <migraphx/op/lstm.hpp>
+#include <migraphx/op/lstm_recurrence.hpp>
 #include <migraphx/op/max.hpp>
 #include <migraphx/op/min.hpp>
 #include <migraphx/op/mod.hpp>
@@ -92,6 +100,7 @@
 #include <migraphx/op/nonzero.hpp>
 #include <migraphx/op/outline.hpp>
 #include <migraphx/op/pad.hpp>
+#include <migraphx/op/paged_attention.hpp>
 #include <migraphx/op/pooling.hpp>
 #include <migraphx/op/pow.hpp>
 #include <migraphx/op/prefix_scan_sum.hpp>
@@ -113,6 +122,7 @@
 #include <migraphx/op/rnn_variable_seq_lens.hpp>
 #include <migraphx/op/rnn_var_sl_last_output.hpp>
 #include <migraphx/op/roialign.hpp>
+#include <migraphx/op/rotary_embedding.hpp>
 #include <migraphx/op/rsqrt.hpp>
 #include <migraphx/op/scalar.hpp>
 #include <migraphx/op/scan_slice.hpp>
@@ -147,6 +157,7 @@
 #include <migraphx/op/unique.hpp>
 #include <migraphx/op/unknown.hpp>
 #include <migraphx/op/unsqueeze.hpp>
+#include <migraphx/op/varlen_attention.hpp>
 #include <migraphx/op/where.hpp>
 
 #endif
@@ -0,0 +1,57 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_PARTITION_TARGETS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_PARTITION_TARGETS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/module_ref.hpp>
+#include <migraphx/supported_segments.hpp>
+#include <migraphx/target_assignments.hpp>
+#include <migraphx/assignment_options.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Assign the instructions of the module to the targets so the total cost is
+ * as low as possible. The cost is the time to run each instruction on its
+ * target plus the time to copy every value that crosses targets. The metric
+ * of a segment is spread evenly over its instructions. Instructions that no
+ * target supports are left unassigned.
+ *
+ * With two targets the assignment is a minimum cut of the instruction graph.
+ * With more targets, alpha-expansion repeats that cut for one target at a
+ * time, starting from the first target that supports each instruction.
+ */
+MIGRAPHX_EXPORT target_assignments
+partition_targets(const_module_ref mod,
+                  const std::vector<std::pair<std::string, supported_segments>>& target_segments,
+                  const assignment_options& options = assignment_options{});
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_PARTITION_TARGETS_HPP
@@ -53,6 +53,9 @@ struct pass
     void apply(module& m) const;
     /// Run the pass on the program
     void apply(program& p) const;
+    /// Whether the pass can run on independent modules at the same time. Such a pass must only
+    /// read and modify the module it is applied to.
+    bool parallel() const;
 };
 
 #else
@@ -80,6 +83,12 @@ void module_pass_manager_apply(const T& x, module_pass_manager& mpm)
     module_pass_manager_apply(rank<1>{}, x, mpm);
 }
 
+template <class T>
+bool pass_parallel(const T&)
+{
+    return false;
+}
+
 } // namespace detail
 
 #ifdef TYPE_ERASED_DECLARATION
@@ -93,6 +102,8 @@ struct MIGRAPHX_EXPORT pass
     void apply(module_pass_manager& mpm) const;
     // (optional)
     void apply(program& p) const;
+    // (optional)
+    bool parallel() const;
 };
 
 #else
@@ -128,6 +139,19 @@ struct pass
         migraphx::nop(private_detail_te_self, p);
     }
 
+    template <class T>
+    static auto private_detail_te_default_parallel(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.parallel())
+    {
+        return private_detail_te_self.parallel();
+    }
+
+    template <class T>
+    static bool private_detail_te_default_parallel(float, T&& private_detail_te_self)
+    {
+        return migraphx::detail::pass_parallel(private_detail_te_self);
+    }
+
     template <class PrivateDetailTypeErasedT>
     struct private_te_unwrap_reference
     {
@@ -150,6 +174,8 @@ struct pass
                                                  std::declval<module_pass_manager&>()),
                  private_detail_te_default_apply(
                      char(0), std::declval<PrivateDetailTypeErasedT>(), std::declval<program&>()),
+                 private_detail_te_default_parallel(char(0),
+                                                    std::declval<PrivateDetailTypeErasedT>()),
                  void());
 
     template <class PrivateDetailTypeErasedT>
@@ -242,6 +268,12 @@ struct pass
         (*this).private_detail_te_get_handle().apply(p);
     }
 
+    bool parallel() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().parallel();
+    }
+
     friend bool is_shared(const pass& private_detail_x, const pass& private_detail_y)
     {
         return private_detail_x.private_detail_te_handle_mem_var ==
@@ -258,6 +290,7 @@ struct pass
         virtual std::string name() const                   = 0;
         virtual void apply(module_pass_manager& mpm) const = 0;
         virtual void apply(program& p) const               = 0;
+        virtual bool parallel() const                      = 0;
     };
 
     template <typename PrivateDetailTypeErasedT>
@@ -302,6 +335,12 @@ struct pass
             private_detail_te_default_apply(char(0), private_detail_te_value, p);
         }
 
+        bool parallel() const override
+        {
+
+            return private_detail_te_default_parallel(char(0), private_detail_te_value);
+        }
+
         PrivateDetailTypeErasedT private_detail_te_value;
     };
 
@@ -27,6 +27,7 @@
 #include <migraphx/config.hpp>
 #include <migraphx/pass.hpp>
 #include <migraphx/module_ref.hpp>
+#include <migraphx/module.hpp>
 #include <migraphx/tracer.hpp>
 #include <vector>
 
@@ -45,6 +46,13 @@ struct module_pass_manager
     virtual module* get_root_module()                      = 0;
     virtual void run_pass(const pass& p)                   = 0;
 
+    // Analyses are cached on the module, so they are shared with later passes on the module
+    template <class T, class F>
+    std::shared_ptr<const T> get_analysis(F f)
+    {
+        return get_module().template get_analysis<T>(f);
+    }
+
     protected:
     virtual ~module_pass_manager() {}
 };
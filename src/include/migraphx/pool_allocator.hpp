@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_POOL_ALLOCATOR_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_POOL_ALLOCATOR_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * An arena for small, fixed-size nodes. Memory is carved out of large chunks and freed nodes are
+ * kept on a free list per size so they can be reused, and everything is released at once when
+ * the pool is destroyed. It is not thread-safe, so a pool should only be used by one container
+ * (or a group of containers that are only used together, such as those of a module).
+ */
+struct MIGRAPHX_EXPORT node_pool
+{
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+    static constexpr std::size_t max_size  = 512;
+
+    node_pool();
+
+    node_pool(const node_pool&)            = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    ~node_pool();
+
+    /// Allocate size bytes; sizes above max_size are forwarded to operator new
+    void* allocate(std::size_t size);
+    void deallocate(void* p, std::size_t size) noexcept;
+
+    /// Total bytes reserved from the system for pooled nodes
+    std::size_t capacity() const;
+
+    private:
+    struct free_node
+    {
+        free_node* next;
+    };
+    std::vector<free_node*> free_lists = {};
+    std::vector<char*> chunks          = {};
+    char* current                      = nullptr;
+    char* last                         = nullptr;
+    std::size_t reserved               = 0;
+};
+
+/// Allocator for node-based containers that takes single nodes from a shared node_pool. Copies
+/// of a container get their own pool so that they can be used independently.
+template <class T>
+struct pool_allocator
+{
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    pool_allocator() : pool(std::make_shared<node_pool>()) {}
+
+    // Moving is a copy, so that a moved-from container still has a pool
+    pool_allocator(const pool_allocator&) noexcept = default;
+
+    template <class U>
+    pool_allocator(const pool_allocator<U>& a) noexcept : pool(a.pool)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if(n == 1 and alignof(T) <= node_pool::alignment)
+            return static_cast<T*>(pool->allocate(sizeof(T)));
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if(n == 1 and alignof(T) <= node_pool::alignment)
+            pool->deallocate(p, sizeof(T));
+        else
+            std::allocator<T>{}.deallocate(p, n);
+    }
+
+    pool_allocator select_on_container_copy_construction() const { return {}; }
+
+    template <class U>
+    friend bool operator==(const pool_allocator& x, const pool_allocator<U>& y)
+    {
+        return x.pool == y.pool;
+    }
+
+    template <class U>
+    friend bool operator!=(const pool_allocator& x, const pool_allocator<U>& y)
+    {
+        return not(x == y);
+    }
+
+    std::shared_ptr<node_pool> pool;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_POOL_ALLOCATOR_HPP
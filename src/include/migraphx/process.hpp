@@ -60,6 +60,14 @@ struct MIGRAPHX_EXPORT process
     void write(std::function<void(writer)> pipe_in);
     void read(const writer& output) const;
 
+    // Starts the process in the background with its stdin and stdout connected to a pipe, which
+    // is written with send and read with receive until the process is stopped
+    void start();
+    void send(const char* buffer, std::size_t n);
+    // Reads exactly n bytes, throws when the process closes its output first
+    void receive(char* buffer, std::size_t n);
+    void stop();
+
     private:
     std::unique_ptr<process_impl> impl;
 };
@@ -39,6 +39,7 @@
 #include <migraphx/config.hpp>
 #include <migraphx/execution_environment.hpp>
 #include <algorithm>
+#include <functional>
 #include <iostream>
 
 namespace migraphx {
@@ -77,13 +78,62 @@ struct MIGRAPHX_EXPORT program
 
     std::unordered_map<std::string, shape> get_parameter_shapes() const;
 
+    // Can be called from several threads at once. Calls that overlap with one already running
+    // use session contexts (see create_session), which are kept by the program for reuse.
     std::vector<argument> eval(parameter_map params,
                                execution_environment exec_env = execution_environment{}) const;
 
     std::vector<argument> eval_with_context(std::vector<context>& ctx, parameter_map params) const;
 
+    // Evaluate several micro-batches, returning the outputs of each one. The run_on_target
+    // modules of the main module work on different micro-batches at the same time, so the stages
+    // of a pipeline run concurrently, while each one still sees the micro-batches in order. The
+    // stages should be compiled with offload_copy so their results do not alias target memory.
+    std::vector<std::vector<argument>> eval_pipeline(std::vector<parameter_map> micro_batches) const;
+
+    using result_callback = std::function<void(std::size_t, std::vector<argument>)>;
+
+    // Evaluate a sequence of requests with up to depth of them running at once. Each request that
+    // overlaps with another uses session contexts, so the uploads, compute and downloads of the
+    // requests overlap on their own streams and scratch memory. The results are returned in the
+    // order of the requests, or passed to on_result as each one completes, one at a time, when it
+    // is set. The program should be compiled with offload_copy so the results don't alias memory
+    // the next request overwrites.
+    std::vector<std::vector<argument>> eval_many(std::vector<parameter_map> requests,
+                                                 std::size_t depth                = 2,
+                                                 const result_callback& on_result = nullptr) const;
+
+    // Bind the parameters, including the output buffers passed as #output_N parameters, so the
+    // program can be run repeatedly with run_bound without looking them up or checking them again
+    void bind(parameter_map params);
+
+    // Run the program with the bound parameters. The results are kept in the program and are
+    // overwritten by the next run.
+    std::vector<argument>& run_bound();
+
+    // Create a copy of the program that shares the weights already loaded on
+    // the targets but has its own contexts, so it can be evaluated concurrently
+    program create_session() const;
+
+    // Create a copy of the compiled program that runs on another device. The code objects and
+    // literals are loaded again on that device, while the tuning results are still shared.
+    program create_replica(std::size_t device_id) const;
+
+    // Bytes of memory the compiled program uses on its targets by category, such as the scratch
+    // buffer, the literals and the code objects, along with the allocations made each time it
+    // runs and the total, which is the peak the program can use while running
+    value memory_report() const;
+
     void finish() const;
 
+    // Record the instructions run by eval into a ring buffer that keeps the last n of them,
+    // without synchronizing the device. A size of zero disables the trace. This is also
+    // enabled with MIGRAPHX_TRACE_EVAL_BUFFER and should not be changed while evaluating.
+    void enable_trace(std::size_t n);
+
+    // Print the instructions recorded by enable_trace, oldest first
+    void print_trace(std::ostream& os) const;
+
     std::size_t size() const;
 
     std::vector<shape> get_output_shapes() const;
@@ -102,6 +152,16 @@ struct MIGRAPHX_EXPORT program
 
     bool is_compiled() const;
 
+    // Write the weights of p, an uncompiled program with the same structure as this one before
+    // it was compiled with record_weights, into this compiled program. Returns false when the
+    // structure differs or a changed weight was transformed while compiling, in which case p
+    // has to be compiled instead.
+    bool update_weights(const program& p);
+
+    // Save the program without its targets, as a snapshot of a compile that can be resumed
+    // with compile_options::resume_pass
+    void save_checkpoint(const std::string& filename) const;
+
     void finalize();
 
     void perf_report(std::ostream& os,
@@ -159,6 +219,8 @@ struct MIGRAPHX_EXPORT program
 
     private:
     void assign(const program& p);
+    void create_execution_plan();
+    bool has_execution_plan() const;
     std::unique_ptr<program_impl> impl;
 };
 } // namespace MIGRAPHX_INLINE_NS
@@ -35,10 +35,14 @@ struct module;
 
 /**
  * Replace instructions which take all literals with a literal of the computation.
+ * Independent constant subgraphs are evaluated concurrently. Folded results can be kept in a
+ * cache directory, set by cache_dir or MIGRAPHX_CONSTANT_FOLD_CACHE, so recompiling the same
+ * model skips the evaluation.
  */
 struct MIGRAPHX_EXPORT propagate_constant
 {
     std::unordered_set<std::string> skip_ops = {};
+    std::string cache_dir                    = {};
     std::string name() const { return "propagate_constant"; }
     void apply(module& m) const;
 };
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_QUANTIZATION_HPP
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/operation.hpp>
@@ -32,6 +33,7 @@
 #include <migraphx/target.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/quantize_8bits.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,16 +43,40 @@ struct program;
 MIGRAPHX_EXPORT void quantize_fp16(program& prog,
                                    const std::vector<std::string>& ins_names = {"all"});
 
+MIGRAPHX_EXPORT void quantize_bf16(program& prog,
+                                   const std::vector<std::string>& ins_names = {"all"});
+
 MIGRAPHX_EXPORT void quantize_int8(program& prog,
                                    const target& t,
                                    const std::vector<parameter_map>& calibration,
                                    const std::unordered_set<std::string>& ins_names = {
-                                       "dot", "convolution"});
-MIGRAPHX_EXPORT void
-quantize_fp8(program& prog, const target& t, const std::vector<parameter_map>& calibration);
+                                       "dot", "convolution"},
+                                   const quantize_8bits_options& options = {});
+MIGRAPHX_EXPORT void quantize_fp8(program& prog,
+                                  const target& t,
+                                  const std::vector<parameter_map>& calibration,
+                                  const quantize_8bits_options& options = {});
 
 MIGRAPHX_EXPORT void quantize_int4_weights(program& prog);
 
+struct mixed_precision_options
+{
+    /// Largest rms error of each output, relative to its magnitude, allowed compared to the
+    /// original program
+    double tolerance = 1e-3;
+    /// Types the instructions can be computed in, the smallest type within the tolerance is
+    /// picked for each instruction
+    std::vector<shape::type_t> precisions = {shape::half_type, shape::bf16_type};
+    /// Instructions to lower, or "all"
+    std::unordered_set<std::string> ins_names = {"dot", "convolution"};
+};
+
+/// Lowers each instruction of the main module to the cheapest of the precisions that keeps the
+/// outputs for the calibration data within the tolerance, measured with the ref target
+MIGRAPHX_EXPORT void quantize_mixed_precision(program& prog,
+                                              const std::vector<parameter_map>& calibration,
+                                              const mixed_precision_options& options = {});
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
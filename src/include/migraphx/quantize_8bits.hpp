@@ -37,6 +37,34 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct program;
 struct module;
 
+enum class calibration_mode
+{
+    max,
+    percentile,
+    entropy
+};
+
+MIGRAPHX_EXPORT calibration_mode to_calibration_mode(const std::string& name);
+
+struct quantize_8bits_options
+{
+    /// How the scales of the activations are picked from the calibration data
+    calibration_mode calibration = calibration_mode::max;
+    /// Percent of the calibration values that are kept in range with calibration_mode::percentile
+    float percentile = 99.99f;
+    /// Quantize constant weights of dots and convolutions with one scale per output channel
+    bool per_channel = false;
+    /// Quantize constant weights of dots with one scale for each group of this many rows along
+    /// the k dimension, leaving their activations unquantized. Zero disables it.
+    std::size_t group_size = 0;
+    /// Migrate activation outliers into the constant weights of dots before quantizing, as in
+    /// SmoothQuant, with this migration strength in (0, 1]. Zero disables it.
+    float smooth_alpha = 0.0f;
+};
+
+/// Largest magnitude that can be represented by the quantized type
+MIGRAPHX_EXPORT float get_quantized_range(shape::type_t precision);
+
 /**
  * capture inputs of operators to be quantized to int8 or fp8
  */
@@ -45,6 +73,8 @@ struct MIGRAPHX_EXPORT capture_arguments_pass
     std::unordered_set<std::string> ins_names = {"dot", "convolution"};
     std::function<void(std::size_t, std::vector<argument>)> f{};
     std::size_t* param_index = nullptr;
+    /// Dots whose weights are quantized in groups do not capture their activations
+    std::size_t group_size = 0;
     std::string name() const { return "capture_arguments"; }
     void apply(module& m) const;
 };
@@ -56,6 +86,7 @@ struct MIGRAPHX_EXPORT quantize_8bits_pass
 {
     shape::type_t precision = shape::int8_type;
     std::vector<std::pair<float, float>> quant_params;
+    quantize_8bits_options options = {};
     std::string name() const { return "quantize_8bits"; }
     void apply(module& m) const;
 };
@@ -27,6 +27,8 @@
 #include <string>
 #include <vector>
 #include <migraphx/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/shape.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -34,6 +36,13 @@ inline namespace MIGRAPHX_INLINE_NS {
 struct program;
 struct module;
 
+/**
+ * compute ins in target_type, converting its floating point inputs to target_type and its
+ * result back to the original type
+ */
+MIGRAPHX_EXPORT void
+quantize_instruction(module& m, instruction_ref ins, shape::type_t target_type);
+
 /**
  * quantize a program to fp16
  */
@@ -44,6 +53,16 @@ struct MIGRAPHX_EXPORT quantize_fp16_pass
     void apply(module& m) const;
 };
 
+/**
+ * quantize a program to bf16
+ */
+struct MIGRAPHX_EXPORT quantize_bf16_pass
+{
+    std::vector<std::string> ins_names = {"all"};
+    std::string name() const { return "quantize_bf16"; }
+    void apply(module& m) const;
+};
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
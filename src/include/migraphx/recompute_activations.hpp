@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,25 +21,30 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_KERNELS_HPP
-#define MIGRAPHX_GUARD_MIGRAPHLIB_KERNELS_HPP
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_RECOMPUTE_ACTIVATIONS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_RECOMPUTE_ACTIVATIONS_HPP
 
-#include <migraphx/argument.hpp>
-#include <migraphx/gpu/device/config.hpp>
-#include <hip/hip_runtime_api.h>
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-namespace device {
 
-void MIGRAPHX_DEVICE_EXPORT contiguous(hipStream_t stream,
-                                       const argument& result,
-                                       const argument& arg);
+struct module;
+
+/**
+ * Recompute pointwise instructions right before their late users instead of keeping their outputs
+ * live in between, until the estimated peak memory of the module fits in the budget (in bytes).
+ */
+struct MIGRAPHX_EXPORT recompute_activations
+{
+    std::size_t budget = 0;
+    std::string name() const { return "recompute_activations"; }
+    void apply(module& m) const;
+};
 
-} // namespace device
-} // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
-#endif
+#endif // MIGRAPHX_GUARD_MIGRAPHX_RECOMPUTE_ACTIVATIONS_HPP
@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_REPLICA_RUNNER_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_REPLICA_RUNNER_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/program.hpp>
+#include <memory>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct replica_runner_impl;
+
+/// Runs copies of a compiled program on several devices, sending each call to one of them.
+/// The program is compiled once and its replicas share the tuning results.
+struct MIGRAPHX_EXPORT replica_runner
+{
+    enum dispatch_mode
+    {
+        /// Send the calls to the replicas in turn
+        round_robin,
+        /// Send each call to the replica with the fewest calls still running
+        queue_depth
+    };
+
+    replica_runner();
+
+    /// Create a replica of the compiled program for each device in `device_ids`
+    replica_runner(const program& p,
+                   const std::vector<std::size_t>& device_ids,
+                   dispatch_mode mode = round_robin);
+
+    /// Number of replicas
+    std::size_t size() const;
+
+    const program& get_replica(std::size_t i) const;
+
+    /// Run the parameters on one of the replicas. Can be called from several threads at once.
+    std::vector<argument> run(parameter_map params) const;
+
+    /// Run each of the batches, keeping all of the replicas busy, and return their outputs
+    std::vector<std::vector<argument>> run_batches(std::vector<parameter_map> batches) const;
+
+    private:
+    std::shared_ptr<replica_runner_impl> impl;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_REPLICA_RUNNER_HPP
@@ -38,6 +38,8 @@ struct module;
  */
 struct MIGRAPHX_EXPORT rewrite_pooling
 {
+    /// Rewrite dilated pooling into gathers followed by pooling without dilations
+    bool rewrite_dilations = true;
     std::string name() const { return "rewrite_pooling"; }
     void apply(module& m) const;
 };
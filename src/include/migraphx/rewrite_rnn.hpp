@@ -41,6 +41,10 @@ struct module;
  */
 struct MIGRAPHX_EXPORT rewrite_rnn
 {
+    // Replace supported lstm operators with a single dot for the input projection and an
+    // lstm_recurrence, instead of unrolling every timestep
+    bool fuse_lstm = false;
+
     std::string name() const { return "rewrite_rnn"; }
     void apply(module& m) const;
 
@@ -78,6 +82,9 @@ struct MIGRAPHX_EXPORT rewrite_rnn
 
     std::vector<operation> lstm_actv_funcs(instruction_ref ins) const;
 
+    bool is_fusible_lstm(const module& m, instruction_ref ins) const;
+    void apply_fused_lstm(module& m, instruction_ref ins) const;
+
     bool is_variable_seq_lens(const module& m, instruction_ref seq_lens) const;
     instruction_ref replace_last_hs_output(module& m,
                                            instruction_ref ins,
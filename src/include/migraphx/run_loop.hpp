@@ -30,14 +30,31 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/context.hpp>
 #include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/builtin.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/ranges.hpp>
+#include <algorithm>
 #include <array>
+#include <iterator>
 #include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+// The condition only has to be read back after every iteration when the body computes it, which
+// it doesn't when it returns its condition parameter unchanged
+inline bool loop_body_updates_cond(const module& m, const std::string& cond_name)
+{
+    auto last = std::prev(m.end());
+    if(last->name() != "@return" or last->inputs().empty())
+        return true;
+    auto cond = instruction::get_output_alias(last->inputs().front());
+    if(cond->name() != "@param")
+        return true;
+    return any_cast<builtin::param>(cond->get_operator()).parameter != cond_name;
+}
+
 template <class LoopModel, class T>
 argument run_loop(const LoopModel& model,
                   const std::vector<int64_t>& scan_output_directions,
@@ -75,6 +92,18 @@ argument run_loop(const LoopModel& model,
 
     auto out_param_indices = model.get_output_params(*mod);
 
+    // the second input parameter of the body is the condition
+    std::vector<std::string> in_param_names;
+    std::copy_if(param_names.begin(),
+                 param_names.end(),
+                 std::back_inserter(in_param_names),
+                 [&](const auto& name) {
+                     return mod->get_parameter_shape(name) != shape{} and
+                            not contains(out_param_indices, name);
+                 });
+    bool update_cond =
+        in_param_names.size() < 2 or loop_body_updates_cond(*mod, in_param_names.at(1));
+
     int64_t iter = 0;
     for(iter = 0; iter < iter_num and cond; ++iter)
     {
@@ -120,8 +149,9 @@ argument run_loop(const LoopModel& model,
 
         auto mod_args = run(mod, params);
 
-        // copy back cond to be used next iteration
-        model.copy(ctx, mod_args.at(0), cond);
+        // copy back cond to be used next iteration, which synchronizes with the device
+        if(update_cond)
+            model.copy(ctx, mod_args.at(0), cond);
 
         // mod outputs are used as next loop input
         std::copy(mod_args.begin(), mod_args.begin() + dep_num + 1, in_args.begin() + 1);
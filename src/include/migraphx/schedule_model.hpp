@@ -40,6 +40,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 struct module;
 struct operation;
+struct shape;
 
 #ifdef DOXYGEN
 
@@ -54,8 +55,8 @@ struct schedule_model
     void wait(module& m, instruction_ref ins, std::size_t wait_id) const;
     // Insert necessary records after an instruction
     void record(module& m, instruction_ref ins, std::size_t wait_id) const;
-    /// Compute weights for an operation
-    std::size_t weight(const operation& op) const;
+    /// Compute weights for an operation given the shapes of its inputs
+    std::size_t weight(const operation& op, const std::vector<shape>& inputs) const;
 };
 
 #else
@@ -74,7 +75,7 @@ struct MIGRAPHX_EXPORT schedule_model
     //
     void record(module& m, instruction_ref ins, std::size_t wait_id) const;
     //
-    std::size_t weight(const operation& op) const;
+    std::size_t weight(const operation& op, const std::vector<shape>& inputs) const;
 };
 
 #else
@@ -108,7 +109,8 @@ struct schedule_model
                  std::declval<PrivateDetailTypeErasedT>().record(std::declval<module&>(),
                                                                  std::declval<instruction_ref>(),
                                                                  std::declval<std::size_t>()),
-                 std::declval<PrivateDetailTypeErasedT>().weight(std::declval<const operation&>()),
+                 std::declval<PrivateDetailTypeErasedT>().weight(
+                     std::declval<const operation&>(), std::declval<const std::vector<shape>&>()),
                  void());
 
     template <class PrivateDetailTypeErasedT>
@@ -209,10 +211,10 @@ struct schedule_model
         (*this).private_detail_te_get_handle().record(m, ins, wait_id);
     }
 
-    std::size_t weight(const operation& op) const
+    std::size_t weight(const operation& op, const std::vector<shape>& inputs) const
     {
         assert((*this).private_detail_te_handle_mem_var);
-        return (*this).private_detail_te_get_handle().weight(op);
+        return (*this).private_detail_te_get_handle().weight(op, inputs);
     }
 
     friend bool is_shared(const schedule_model& private_detail_x,
@@ -233,7 +235,8 @@ struct schedule_model
         virtual void sched(module& m, instruction_ref ins, std::size_t n) const        = 0;
         virtual void wait(module& m, instruction_ref ins, std::size_t wait_id) const   = 0;
         virtual void record(module& m, instruction_ref ins, std::size_t wait_id) const = 0;
-        virtual std::size_t weight(const operation& op) const                          = 0;
+        virtual std::size_t weight(const operation& op,
+                                   const std::vector<shape>& inputs) const             = 0;
     };
 
     template <typename PrivateDetailTypeErasedT>
@@ -284,10 +287,10 @@ struct schedule_model
             private_detail_te_value.record(m, ins, wait_id);
         }
 
-        std::size_t weight(const operation& op) const override
+        std::size_t weight(const operation& op, const std::vector<shape>& inputs) const override
         {
 
-            return private_detail_te_value.weight(op);
+            return private_detail_te_value.weight(op, inputs);
         }
 
         PrivateDetailTypeErasedT private_detail_te_value;
@@ -150,6 +150,13 @@ value to_value_impl(rank<13>, const T& x)
     return x;
 }
 
+// Keep binary blobs such as code objects as binary values instead of arrays of bytes
+template <class T, MIGRAPHX_REQUIRES(std::is_same<T, value::binary>{})>
+value to_value_impl(rank<14>, const T& x)
+{
+    return x;
+}
+
 template <class T, MIGRAPHX_REQUIRES(std::is_empty<T>{})>
 void from_value_impl(rank<0>, const value& v, T& x)
 {
@@ -269,7 +276,7 @@ void from_value_impl(rank<11>, const value& v, T& x)
 template <class T>
 value to_value(const T& x)
 {
-    return detail::to_value_impl(rank<13>{}, x);
+    return detail::to_value_impl(rank<14>{}, x);
 }
 
 template <class T>
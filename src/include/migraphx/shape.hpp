@@ -35,6 +35,7 @@
 #include <migraphx/errors.hpp>
 #include <migraphx/half.hpp>
 #include <migraphx/float8.hpp>
+#include <migraphx/bf16.hpp>
 #include <migraphx/serialize.hpp>
 #include <migraphx/config.hpp>
 
@@ -64,7 +65,8 @@ struct MIGRAPHX_EXPORT shape
     m(uint64_type, uint64_t) \
     m(fp8e4m3fnuz_type, migraphx::fp8::fp8e4m3fnuz) \
     m(fp8e4m3fn_type, migraphx::fp8::fp8e4m3fn) \
-    m(fp8e5m2_type, migraphx::fp8::fp8e5m2)
+    m(fp8e5m2_type, migraphx::fp8::fp8e5m2) \
+    m(bf16_type, migraphx::bf16)
 // clang-format on
 
 #define MIGRAPHX_SHAPE_GENERATE_ENUM_TYPES(x, t) x,
@@ -310,6 +312,9 @@ struct MIGRAPHX_EXPORT shape
     /// Return true if this shape or any of the sub_shapes are dynamic
     bool any_of_dynamic() const;
 
+    /// Hash of the type and dimensions, computed once when the shape is created
+    std::size_t hash() const;
+
     shape normalize_standard() const;
 
     shape as_standard() const;
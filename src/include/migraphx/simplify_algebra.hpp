@@ -39,6 +39,7 @@ struct MIGRAPHX_EXPORT simplify_algebra
 {
     std::string name() const { return "simplify_algebra"; }
     void apply(module& m) const;
+    bool parallel() const { return true; }
 };
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -42,6 +42,10 @@ struct module_pass_manager;
 struct MIGRAPHX_EXPORT split_reduce
 {
     std::size_t split_size = 8192;
+    /// Reductions with at least this many outputs already run on enough
+    /// blocks to fill the target, so they are not split. Zero splits them
+    /// regardless of the number of outputs.
+    std::size_t max_outputs = 0;
     std::string name() const { return "split_reduce"; }
     void apply(module_pass_manager& mpm) const;
 };
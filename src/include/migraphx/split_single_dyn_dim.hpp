@@ -35,9 +35,18 @@ inline namespace MIGRAPHX_INLINE_NS {
 /**
  * Split dynamic dimension over submodules if exactly one dimension in the parameter list is
  * dynamic.
+ *
+ * When the dynamic dimension has optimal sizes, only those get a submodule and the inputs are
+ * padded up to the nearest one. With mask_padding set, softmaxes that reduce along the dynamic
+ * dimension then ignore the padded positions: the actual size is passed to each submodule in a
+ * `dim_size_name` parameter.
  */
 struct MIGRAPHX_EXPORT split_single_dyn_dim
 {
+    static constexpr const char* dim_size_name = "#dim_size";
+
+    bool mask_padding = true;
+
     std::string name() const { return "split_single_dyn_dim"; }
     void apply(module_pass_manager&) const;
 };
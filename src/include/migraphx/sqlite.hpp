@@ -27,6 +27,7 @@
 #include <migraphx/config.hpp>
 #include <migraphx/filesystem.hpp>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -41,6 +42,10 @@ struct MIGRAPHX_EXPORT sqlite
     static sqlite read(const fs::path& p);
     static sqlite write(const fs::path& p);
     std::vector<std::unordered_map<std::string, std::string>> execute(const std::string& s);
+    // Runs a single statement with its `?` parameters bound to params, so the values never need
+    // to be quoted into the SQL
+    std::vector<std::unordered_map<std::string, std::string>>
+    execute(const std::string& s, const std::vector<std::string>& params);
 
     private:
     std::shared_ptr<sqlite_impl> impl;
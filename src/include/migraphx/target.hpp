@@ -95,6 +95,14 @@ struct target
      * @return Allocated argument in the target.
      */
     argument allocate(const shape& s) const;
+    /**
+     * @brief Allocate a host argument that the target can transfer from asynchronously
+     *
+     * @param s Shape of the argument to be allocated on the host
+     * @return Allocated argument in page-locked host memory, or pageable host memory when the
+     * target has no pinned allocator.
+     */
+    argument allocate_pinned(const shape& s) const;
 };
 
 #else
@@ -106,6 +114,12 @@ argument target_allocate(T& x, const shape&)
     MIGRAPHX_THROW("Not computable: " + name);
 }
 
+template <class T>
+argument target_allocate_pinned(T&, const shape& s)
+{
+    return argument{s};
+}
+
 template <class T>
 argument copy_to_target(T&, const argument& arg)
 {
@@ -143,6 +157,8 @@ struct MIGRAPHX_EXPORT target
     argument copy_from(const argument& input) const;
     // (optional)
     argument allocate(const shape& s) const;
+    // (optional)
+    argument allocate_pinned(const shape& s) const;
 };
 
 #else
@@ -213,6 +229,21 @@ struct target
         return target_allocate(private_detail_te_self, s);
     }
 
+    template <class T>
+    static auto
+    private_detail_te_default_allocate_pinned(char, T&& private_detail_te_self, const shape& s)
+        -> decltype(private_detail_te_self.allocate_pinned(s))
+    {
+        return private_detail_te_self.allocate_pinned(s);
+    }
+
+    template <class T>
+    static argument
+    private_detail_te_default_allocate_pinned(float, T&& private_detail_te_self, const shape& s)
+    {
+        return target_allocate_pinned(private_detail_te_self, s);
+    }
+
     template <class PrivateDetailTypeErasedT>
     struct private_te_unwrap_reference
     {
@@ -246,6 +277,10 @@ struct target
                  private_detail_te_default_allocate(char(0),
                                                     std::declval<PrivateDetailTypeErasedT>(),
                                                     std::declval<const shape&>()),
+                 private_detail_te_default_allocate_pinned(
+                     char(0),
+                     std::declval<PrivateDetailTypeErasedT>(),
+                     std::declval<const shape&>()),
                  void());
 
     template <class PrivateDetailTypeErasedT>
@@ -362,6 +397,12 @@ struct target
         return (*this).private_detail_te_get_handle().allocate(s);
     }
 
+    argument allocate_pinned(const shape& s) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().allocate_pinned(s);
+    }
+
     friend bool is_shared(const target& private_detail_x, const target& private_detail_y)
     {
         return private_detail_x.private_detail_te_handle_mem_var ==
@@ -383,6 +424,7 @@ struct target
         virtual argument copy_to(const argument& input) const                                   = 0;
         virtual argument copy_from(const argument& input) const                                 = 0;
         virtual argument allocate(const shape& s) const                                         = 0;
+        virtual argument allocate_pinned(const shape& s) const                                  = 0;
     };
 
     template <typename PrivateDetailTypeErasedT>
@@ -448,6 +490,12 @@ struct target
             return private_detail_te_default_allocate(char(0), private_detail_te_value, s);
         }
 
+        argument allocate_pinned(const shape& s) const override
+        {
+
+            return private_detail_te_default_allocate_pinned(char(0), private_detail_te_value, s);
+        }
+
         PrivateDetailTypeErasedT private_detail_te_value;
     };
 
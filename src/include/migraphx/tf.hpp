@@ -39,6 +39,8 @@ struct tf_options
     /// Explicitly specify the dims of an input
     std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims = {};
     std::vector<std::string> output_node_names                               = {};
+    /// Maximum number of iterations of the while loops, which tf doesn't bound
+    int64_t max_loop_iterations = 10;
 };
 
 /// Create a program from a tf pb file (default is nhwc format)
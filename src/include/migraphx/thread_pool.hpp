@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_THREAD_POOL_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_THREAD_POOL_HPP
+
+#include <migraphx/config.hpp>
+#include <functional>
+#include <memory>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct thread_pool_impl;
+
+/// A pool of persistent worker threads. The tasks of a run are split into one contiguous block
+/// per thread, so the same task index always lands on the same thread, and idle threads steal
+/// the remaining tasks from the other blocks.
+struct MIGRAPHX_EXPORT thread_pool
+{
+    /// Create a pool with `nthreads` threads including the calling thread. When `pin` is set the
+    /// workers are pinned to the cpus ordered node by node.
+    thread_pool(std::size_t nthreads, bool pin = false);
+    thread_pool(const thread_pool&)            = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    ~thread_pool();
+
+    /// Number of threads used by a run, including the calling thread
+    std::size_t size() const;
+
+    /// Whether the workers are pinned to cpus
+    bool pinned() const;
+
+    /// Call `f(i)` for every i in [0, n) and wait for them to complete. The first exception
+    /// thrown by a task is rethrown. Runs from a worker or while the pool is busy with another
+    /// caller are executed serially on the calling thread.
+    void run(std::size_t n, const std::function<void(std::size_t)>& f);
+
+    private:
+    std::unique_ptr<thread_pool_impl> impl;
+};
+
+/// The process-wide pool, configured with MIGRAPHX_NUM_THREADS and MIGRAPHX_CPU_AFFINITY
+MIGRAPHX_EXPORT thread_pool& get_thread_pool();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_THREAD_POOL_HPP
@@ -25,12 +25,29 @@
 #define MIGRAPHX_GUARD_RTGLIB_TRACER_HPP
 
 #include <ostream>
+#include <memory>
+#include <string>
+#include <vector>
 #include <migraphx/functional.hpp>
 #include <migraphx/config.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+/// Time and instruction counts of a pass run on one module
+struct pass_stats
+{
+    std::string name;
+    /// The module the pass ran on, empty for the passes that run on the whole program
+    std::string module;
+    /// How many passes this one is nested in, such as the passes run by optimize_module
+    std::size_t depth               = 0;
+    double ms                       = 0;
+    std::size_t instructions_before = 0;
+    std::size_t instructions_after  = 0;
+    std::size_t modules             = 0;
+};
+
 struct tracer
 {
     tracer() {}
@@ -39,6 +56,27 @@ struct tracer
 
     bool enabled() const { return os != nullptr; }
 
+    /// Print the trace to s, keeping the pass stats that are recorded
+    void print_to(std::ostream& s) { os = &s; }
+
+    /// Record the stats of every pass run with this tracer or its copies
+    void record_pass_stats() { stats = std::make_shared<std::vector<pass_stats>>(); }
+
+    bool records_pass_stats() const { return stats != nullptr; }
+
+    void add_pass_stats(pass_stats ps) const
+    {
+        if(stats != nullptr)
+            stats->push_back(std::move(ps));
+    }
+
+    std::vector<pass_stats> get_pass_stats() const
+    {
+        if(stats == nullptr)
+            return {};
+        return *stats;
+    }
+
     template <class... Ts>
     void operator()(const Ts&... xs) const
     {
@@ -50,7 +88,8 @@ struct tracer
     }
 
     private:
-    std::ostream* os = nullptr;
+    std::ostream* os                               = nullptr;
+    std::shared_ptr<std::vector<pass_stats>> stats = nullptr;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -196,13 +196,16 @@ struct MIGRAPHX_EXPORT value
     value() = default;
 
     value(const value& rhs);
+    value(value&& rhs) noexcept;
     value& operator=(value rhs);
     value(const std::string& pkey, const value& rhs);
 
     value(const std::initializer_list<value>& i);
     value(const std::vector<value>& v, bool array_on_empty = true);
+    value(std::vector<value>&& v, bool array_on_empty = true);
     value(const std::unordered_map<std::string, value>& m);
     value(const std::string& pkey, const std::vector<value>& v, bool array_on_empty = true);
+    value(const std::string& pkey, std::vector<value>&& v, bool array_on_empty = true);
     value(const std::string& pkey, const std::unordered_map<std::string, value>& m);
     value(const std::string& pkey, std::nullptr_t);
     value(std::nullptr_t);
@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_WEIGHT_MAP_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_WEIGHT_MAP_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/literal.hpp>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct program;
+struct context;
+
+/// Digest of the program without the data of its literals, so programs that only differ in
+/// their weights have the same fingerprint
+MIGRAPHX_EXPORT std::string structure_fingerprint(const program& p);
+
+/**
+ * Records where the literals of a program end up once it is compiled. A literal is located when
+ * the compiled program holds exactly one copy of its data, either as a literal or in an op the
+ * target lowered it to. New values of located literals can then be written into the compiled
+ * program without recompiling it.
+ */
+struct MIGRAPHX_EXPORT weight_map
+{
+    struct entry
+    {
+        std::string digest = {};
+        std::string module = {};
+        std::size_t index  = 0;
+        bool located       = false;
+
+        template <class Self, class F>
+        static auto reflect(Self& self, F f)
+        {
+            return pack(f(self.digest, "digest"),
+                        f(self.module, "module"),
+                        f(self.index, "index"),
+                        f(self.located, "located"));
+        }
+    };
+
+    std::string fingerprint    = {};
+    std::vector<entry> entries = {};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.fingerprint, "fingerprint"), f(self.entries, "entries"));
+    }
+
+    bool empty() const { return fingerprint.empty(); }
+
+    /// Fingerprint and literal digests of a program before it is compiled
+    static weight_map from_source(const program& p);
+
+    /// Find the source literals in the compiled program
+    void locate(const program& compiled);
+
+    /// Write the literals of p that changed into the compiled program, and finalize them with
+    /// ctx. Returns false, and leaves the compiled program unchanged, when p has a different
+    /// structure or a literal that changed was transformed while compiling.
+    bool update(program& compiled, std::vector<context>& ctx, const program& p);
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MIGRAPHX_WEIGHT_MAP_HPP
@@ -0,0 +1,203 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/kv_block_allocator.hpp>
+#include <migraphx/errors.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Drop a reference to each block, and return the unused ones to the free list
+static void release_blocks(const std::vector<std::int32_t>& blocks,
+                           std::vector<std::size_t>& refs,
+                           std::vector<std::int32_t>& free_list)
+{
+    std::for_each(blocks.rbegin(), blocks.rend(), [&](auto blk) {
+        if(--refs[blk] == 0)
+            free_list.push_back(blk);
+    });
+}
+
+kv_block_allocator::kv_block_allocator(std::size_t num_blocks, std::size_t block_size)
+    : m_num_blocks(num_blocks), m_block_size(block_size)
+{
+    if(block_size == 0)
+        MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: block size must be greater than zero");
+    if(num_blocks > std::numeric_limits<std::int32_t>::max())
+        MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: too many blocks: " + std::to_string(num_blocks));
+    // Hand out the lowest block first
+    free_list.resize(num_blocks);
+    std::iota(free_list.rbegin(), free_list.rend(), 0);
+    refs.resize(num_blocks);
+}
+
+std::size_t kv_block_allocator::num_blocks() const { return m_num_blocks; }
+
+std::size_t kv_block_allocator::block_size() const { return m_block_size; }
+
+std::size_t kv_block_allocator::free_blocks() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return free_list.size();
+}
+
+bool kv_block_allocator::reserve(std::size_t seq, std::size_t ntokens)
+{
+    if(m_block_size == 0)
+        MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: allocator has no blocks");
+    std::size_t needed = (ntokens + m_block_size - 1) / m_block_size;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& blocks = sequences[seq];
+    if(needed <= blocks.size())
+        return true;
+    std::size_t n = needed - blocks.size();
+    if(n > free_list.size())
+    {
+        if(blocks.empty())
+            sequences.erase(seq);
+        return false;
+    }
+    blocks.insert(blocks.end(), free_list.rbegin(), free_list.rbegin() + n);
+    free_list.resize(free_list.size() - n);
+    std::for_each(blocks.end() - n, blocks.end(), [&](auto blk) { refs[blk] = 1; });
+    return true;
+}
+
+void kv_block_allocator::release(std::size_t seq)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sequences.find(seq);
+    if(it == sequences.end())
+        return;
+    release_blocks(it->second, refs, free_list);
+    sequences.erase(it);
+}
+
+argument kv_block_allocator::fork(const std::vector<std::size_t>& seqs,
+                                  const std::vector<std::size_t>& parents,
+                                  std::size_t ntokens)
+{
+    if(m_block_size == 0)
+        MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: allocator has no blocks");
+    if(parents.size() != seqs.size())
+        MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: expected a parent for each sequence");
+    if(std::any_of(parents.begin(), parents.end(), [&](auto p) { return p >= seqs.size(); }))
+        MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: parent out of range");
+    argument result{shape{shape::int32_type, {seqs.size(), 2}}};
+    auto* copies = reinterpret_cast<std::int32_t*>(result.data());
+    std::fill(copies, copies + seqs.size() * 2, -1);
+    std::size_t nblocks = (ntokens + m_block_size - 1) / m_block_size;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Work on copies so nothing changes when there are not enough free blocks
+    auto new_refs      = refs;
+    auto new_free_list = free_list;
+    std::vector<std::vector<std::int32_t>> blocks(seqs.size());
+    for(std::size_t i = 0; i < seqs.size(); i++)
+    {
+        auto parent   = seqs[parents[i]];
+        auto it       = sequences.find(parent);
+        std::size_t n = it == sequences.end() ? 0 : it->second.size();
+        if(n < nblocks)
+            MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: sequence " + std::to_string(parent) +
+                           " does not have blocks for " + std::to_string(ntokens) + " tokens");
+        if(nblocks == 0)
+            continue;
+        blocks[i].assign(it->second.begin(), it->second.begin() + nblocks);
+        for(auto blk : blocks[i])
+            new_refs[blk]++;
+    }
+    for(auto seq : seqs)
+    {
+        auto it = sequences.find(seq);
+        if(it != sequences.end())
+            release_blocks(it->second, new_refs, new_free_list);
+    }
+    // The tokens after ntokens are written to the last block, so it cannot stay shared when it is
+    // partially filled
+    if(ntokens % m_block_size != 0)
+    {
+        for(std::size_t i = 0; i < seqs.size(); i++)
+        {
+            auto& last = blocks[i].back();
+            if(new_refs[last] == 1)
+                continue;
+            if(new_free_list.empty())
+                MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: not enough free blocks to fork");
+            copies[2 * i]     = last;
+            copies[2 * i + 1] = new_free_list.back();
+            new_refs[last]--;
+            last           = new_free_list.back();
+            new_refs[last] = 1;
+            new_free_list.pop_back();
+        }
+    }
+
+    refs      = std::move(new_refs);
+    free_list = std::move(new_free_list);
+    for(std::size_t i = 0; i < seqs.size(); i++)
+    {
+        if(blocks[i].empty())
+            sequences.erase(seqs[i]);
+        else
+            sequences[seqs[i]] = std::move(blocks[i]);
+    }
+    return result;
+}
+
+std::vector<std::int32_t> kv_block_allocator::blocks(std::size_t seq) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sequences.find(seq);
+    if(it == sequences.end())
+        return {};
+    return it->second;
+}
+
+argument kv_block_allocator::block_table(const std::vector<std::size_t>& seqs,
+                                         std::size_t max_blocks) const
+{
+    argument result{shape{shape::int32_type, {seqs.size(), max_blocks}}};
+    auto* table = reinterpret_cast<std::int32_t*>(result.data());
+    std::fill(table, table + seqs.size() * max_blocks, -1);
+    std::lock_guard<std::mutex> lock(mutex);
+    for(std::size_t i = 0; i < seqs.size(); i++)
+    {
+        auto it = sequences.find(seqs[i]);
+        if(it == sequences.end())
+            continue;
+        if(it->second.size() > max_blocks)
+            MIGRAPHX_THROW("KV_BLOCK_ALLOCATOR: sequence " + std::to_string(seqs[i]) + " has " +
+                           std::to_string(it->second.size()) + " blocks which is more than " +
+                           std::to_string(max_blocks));
+        std::copy(it->second.begin(), it->second.end(), table + i * max_blocks);
+    }
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -32,6 +32,8 @@
 #include <migraphx/eliminate_contiguous.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -70,16 +72,143 @@ void preserve_output_layout(module& m)
     }
 }
 
-void transform_convolutions(module& m)
+bool is_nhwc_candidate(instruction_ref ins)
 {
+    if(ins->name() != "convolution")
+        return false;
+    if(ins->get_shape().dynamic() or ins->get_shape().lens().size() != 4)
+        return false;
+    auto v = ins->get_operator().to_value();
+    return v.at("group").to<int>() <= 1;
+}
+
+// Runs just as fast on nhwc data, so a region of nhwc convolutions extends through it
+bool is_layout_agnostic(instruction_ref ins)
+{
+    if(ins->get_shape().dynamic() or ins->get_shape().lens().size() != 4)
+        return false;
+    if(contains({"contiguous", "identity"}, ins->name()))
+        return true;
+    return ins->get_operator().attributes().get("pointwise", false);
+}
+
+// Estimated cost of a convolution, in flops
+double convolution_cost(instruction_ref ins, bool nhwc)
+{
+    auto w = ins->inputs()[1]->get_shape();
+    // Each output is a dot product over the input channels and the kernel window
+    double flops = 2.0 * ins->get_shape().elements() * (w.elements() / w.lens().front());
+    if(not nhwc)
+        return flops;
+    // Channels-last kernels can use the matrix cores when the channels can be vectorized for
+    // the reduced precision types, otherwise they are a little slower than the nchw kernels
+    auto t             = ins->inputs().front()->get_shape().type();
+    bool low_precision = contains({shape::half_type,
+                                   shape::int8_type,
+                                   shape::fp8e4m3fnuz_type,
+                                   shape::fp8e4m3fn_type,
+                                   shape::fp8e5m2_type},
+                                  t);
+    bool vectorizable  = w.lens()[0] % 8 == 0 and w.lens()[1] % 8 == 0;
+    if(low_precision and vectorizable)
+        return flops / 1.5;
+    return flops / 0.9;
+}
+
+// Estimated cost of a layout op, in flops. The transpose reads and writes every byte, and a
+// gpu does roughly 64 flops in the time it moves a byte from memory.
+double transpose_cost(const shape& s) { return 64.0 * 2 * s.bytes(); }
+
+// Whether an input can be read in any layout without a transpose
+bool is_free_input(instruction_ref ins)
+{
+    return ins->can_eval() or ins->get_shape().broadcasted() or ins->get_shape().scalar();
+}
+
+/* Group the convolutions into regions connected through layout agnostic instructions, and pick
+ * the regions where the convolutions are estimated to be faster in nhwc than the layout ops needed
+ * at the boundaries of the region.
+ */
+std::unordered_set<instruction_ref> select_nhwc_convolutions(const module& m)
+{
+    std::vector<std::size_t> parent;
+    auto find_root = fix<std::size_t>([&](auto self, std::size_t i) -> std::size_t {
+        if(parent[i] == i)
+            return i;
+        return parent[i] = self(parent[i]);
+    });
+    std::unordered_map<instruction_ref, std::size_t> region_of;
     for(auto ins : iterator_for(m))
     {
-        if(ins->name() != "convolution")
-            continue;
-        if(ins->get_shape().lens().size() != 4)
+        bool conv = is_nhwc_candidate(ins);
+        if(not conv and not is_layout_agnostic(ins))
             continue;
-        auto v = ins->get_operator().to_value();
-        if(v.at("group").to<int>() > 1)
+        // The weights of a convolution dont connect it to the region they come from
+        auto inputs = conv ? std::vector<instruction_ref>{ins->inputs().front()} : ins->inputs();
+        std::vector<std::size_t> input_regions;
+        for(auto input : inputs)
+        {
+            if(contains(region_of, input))
+                input_regions.push_back(find_root(region_of.at(input)));
+        }
+        if(input_regions.empty())
+        {
+            if(not conv)
+                continue;
+            parent.push_back(parent.size());
+            input_regions.push_back(parent.back());
+        }
+        for(auto r : input_regions)
+            parent[r] = input_regions.front();
+        region_of[ins] = input_regions.front();
+    }
+
+    struct region_cost
+    {
+        double nchw = 0;
+        double nhwc = 0;
+        std::vector<instruction_ref> convolutions;
+        std::unordered_set<instruction_ref> transposed_inputs;
+    };
+    std::unordered_map<std::size_t, region_cost> costs;
+    for(const auto& [ins, r] : region_of)
+    {
+        auto& cost  = costs[find_root(r)];
+        auto inputs = ins->inputs();
+        if(is_nhwc_candidate(ins))
+        {
+            cost.nchw += convolution_cost(ins, false);
+            cost.nhwc += convolution_cost(ins, true);
+            cost.convolutions.push_back(ins);
+        }
+        for(auto input : inputs)
+        {
+            if(contains(region_of, input) or is_free_input(input))
+                continue;
+            if(cost.transposed_inputs.insert(input).second)
+                cost.nhwc += transpose_cost(input->get_shape());
+        }
+        if(std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](auto output) {
+               return not contains(region_of, output);
+           }) or ins == std::prev(m.end()))
+            cost.nhwc += transpose_cost(ins->get_shape());
+    }
+
+    std::unordered_set<instruction_ref> result;
+    for(const auto& p : costs)
+    {
+        const auto& cost = p.second;
+        if(cost.nhwc < cost.nchw)
+            result.insert(cost.convolutions.begin(), cost.convolutions.end());
+    }
+    return result;
+}
+
+void transform_convolutions(module& m, const std::unordered_set<instruction_ref>& convolutions)
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(not contains(convolutions, ins))
             continue;
         auto args = ins->inputs();
         std::transform(args.begin(), args.end(), args.begin(), [&](const auto& i) {
@@ -105,8 +234,23 @@ void remove_layout(module& m)
 
 void layout_nhwc::apply(module_pass_manager& mpm) const
 {
+    std::unordered_set<instruction_ref> convolutions;
+    if(select_regions)
+    {
+        convolutions = select_nhwc_convolutions(mpm.get_module());
+        if(convolutions.empty())
+            return;
+    }
+    else
+    {
+        for(auto ins : iterator_for(mpm.get_module()))
+        {
+            if(is_nhwc_candidate(ins))
+                convolutions.insert(ins);
+        }
+    }
     preserve_output_layout(mpm.get_module());
-    transform_convolutions(mpm.get_module());
+    transform_convolutions(mpm.get_module(), convolutions);
     mpm.run_pass(dead_code_elimination{});
     mpm.run_pass(eliminate_contiguous{"contiguous"});
     mpm.run_pass(dead_code_elimination{});
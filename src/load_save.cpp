@@ -26,14 +26,196 @@
 #include <migraphx/file_buffer.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/msgpack.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/reflect.hpp>
+#include <migraphx/serialize.hpp>
+#include <array>
+#include <cstring>
 #include <fstream>
+#if MIGRAPHX_HAS_ZSTD
+#include <zstd.h>
+#endif
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+// The chunked format is a fixed header, the metadata as msgpack, and then the chunks:
+//
+//     "MXRC" | version (uint32) | metadata size (uint64) | metadata | chunks...
+//
+// The metadata holds the program value with every binary replaced by {"@chunk": index}, and the
+// offset, size and compression of every chunk so each one can be decoded on its own.
+namespace {
+constexpr std::array<char, 4> chunked_magic = {'M', 'X', 'R', 'C'};
+constexpr std::uint32_t chunked_version     = 1;
+constexpr std::size_t chunked_header_size   = 16;
+
+struct chunk_info
+{
+    std::string kind        = "data";
+    std::string compression = "none";
+    std::size_t offset      = 0;
+    std::size_t size        = 0;
+    std::size_t bytes       = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.kind, "kind"),
+                    f(self.compression, "compression"),
+                    f(self.offset, "offset"),
+                    f(self.size, "size"),
+                    f(self.bytes, "bytes"));
+    }
+};
+
+struct chunked_buffer
+{
+    value metadata;
+    std::vector<chunk_info> chunks;
+    const char* data = nullptr;
+};
+} // namespace
+
+static bool is_chunked(const char* buffer, std::size_t size)
+{
+    return size >= chunked_header_size and
+           std::equal(chunked_magic.begin(), chunked_magic.end(), buffer);
+}
+
+static std::vector<char> encode_chunk(const value::binary& b, const std::string& compression)
+{
+    if(compression == "none")
+        return {b.begin(), b.end()};
+#if MIGRAPHX_HAS_ZSTD
+    if(compression == "zstd")
+    {
+        std::vector<char> result(ZSTD_compressBound(b.size()));
+        auto n = ZSTD_compress(result.data(), result.size(), b.data(), b.size(), 1);
+        if(ZSTD_isError(n) != 0)
+            MIGRAPHX_THROW("Compressing chunk failed: " + std::string{ZSTD_getErrorName(n)});
+        result.resize(n);
+        return result;
+    }
+#endif
+    MIGRAPHX_THROW("Unsupported compression: " + compression);
+}
+
+static value::binary decode_chunk(const char* data, const chunk_info& chunk)
+{
+    if(chunk.compression == "none")
+        return {data + chunk.offset, chunk.size};
+#if MIGRAPHX_HAS_ZSTD
+    if(chunk.compression == "zstd")
+    {
+        value::binary result(chunk.bytes);
+        auto n = ZSTD_decompress(result.data(), result.size(), data + chunk.offset, chunk.size);
+        if(ZSTD_isError(n) != 0 or n != chunk.bytes)
+            MIGRAPHX_THROW("Decompressing chunk failed");
+        return result;
+    }
+#endif
+    MIGRAPHX_THROW("Unsupported compression: " + chunk.compression);
+}
+
+static void collect_binaries(value& v, std::vector<value*>& binaries)
+{
+    if(v.is_binary())
+        binaries.push_back(&v);
+    else if(v.is_object() or v.is_array())
+        std::for_each(v.begin(), v.end(), [&](value& x) { collect_binaries(x, binaries); });
+}
+
+static void collect_chunk_refs(value& v, std::vector<value*>& refs)
+{
+    if(v.is_object() and v.contains("@chunk"))
+        refs.push_back(&v);
+    else if(v.is_object() or v.is_array())
+        std::for_each(v.begin(), v.end(), [&](value& x) { collect_chunk_refs(x, refs); });
+}
+
+static std::vector<char> save_chunked(value v, const std::string& compression)
+{
+    std::vector<value*> binaries;
+    collect_binaries(v, binaries);
+    std::vector<std::vector<char>> encoded(binaries.size());
+    par_for(binaries.size(), 1, [&](auto i) {
+        encoded[i] = encode_chunk(binaries[i]->get_binary(), compression);
+    });
+
+    std::vector<chunk_info> chunks;
+    std::size_t offset = 0;
+    for(auto i : range(binaries.size()))
+    {
+        chunk_info chunk;
+        chunk.kind        = binaries[i]->get_key() == "code_object" ? "code_object" : "data";
+        chunk.compression = compression;
+        chunk.offset      = offset;
+        chunk.size        = encoded[i].size();
+        chunk.bytes       = binaries[i]->get_binary().size();
+        offset += chunk.size;
+        chunks.push_back(chunk);
+        *binaries[i] = value{{"@chunk", i}};
+    }
+
+    auto metadata = to_msgpack({{"program", v}, {"chunks", to_value(chunks)}});
+    std::uint64_t metadata_size = metadata.size();
+    std::vector<char> buffer(chunked_header_size + metadata.size() + offset);
+    std::copy(chunked_magic.begin(), chunked_magic.end(), buffer.begin());
+    std::memcpy(buffer.data() + 4, &chunked_version, sizeof(chunked_version));
+    std::memcpy(buffer.data() + 8, &metadata_size, sizeof(metadata_size));
+    auto* data = std::copy(metadata.begin(), metadata.end(), buffer.data() + chunked_header_size);
+    par_for(encoded.size(), 1, [&](auto i) {
+        std::copy(encoded[i].begin(), encoded[i].end(), data + chunks[i].offset);
+    });
+    return buffer;
+}
+
+static chunked_buffer read_chunked(const char* buffer, std::size_t size)
+{
+    if(not is_chunked(buffer, size))
+        MIGRAPHX_THROW("Not a chunked MIGraphX program");
+    std::uint32_t version       = 0;
+    std::uint64_t metadata_size = 0;
+    std::memcpy(&version, buffer + 4, sizeof(version));
+    std::memcpy(&metadata_size, buffer + 8, sizeof(metadata_size));
+    if(version != chunked_version)
+        MIGRAPHX_THROW("Unsupported chunked format version: " + std::to_string(version));
+    if(chunked_header_size + metadata_size > size)
+        MIGRAPHX_THROW("Truncated chunked MIGraphX program");
+    chunked_buffer result;
+    result.metadata = from_msgpack(buffer + chunked_header_size, metadata_size);
+    result.chunks   = from_value<std::vector<chunk_info>>(result.metadata.at("chunks"));
+    result.data     = buffer + chunked_header_size + metadata_size;
+    auto data_size  = size - chunked_header_size - metadata_size;
+    if(std::any_of(result.chunks.begin(), result.chunks.end(), [&](const chunk_info& chunk) {
+           return chunk.offset + chunk.size > data_size;
+       }))
+        MIGRAPHX_THROW("Truncated chunked MIGraphX program");
+    return result;
+}
+
+static program load_chunked(const char* buffer, std::size_t size)
+{
+    auto cb = read_chunked(buffer, size);
+    std::vector<value::binary> decoded(cb.chunks.size());
+    par_for(cb.chunks.size(), 1, [&](auto i) { decoded[i] = decode_chunk(cb.data, cb.chunks[i]); });
+
+    auto& v = cb.metadata.at("program");
+    std::vector<value*> refs;
+    collect_chunk_refs(v, refs);
+    for(auto* ref : refs)
+        *ref = value(decoded.at(ref->at("@chunk").to<std::size_t>()));
+    program p;
+    p.from_value(v);
+    return p;
+}
+
 program load(const std::string& filename, const file_options& options)
 {
-    return load_buffer(read_buffer(filename), options);
+    // Map the file instead of reading it to avoid an extra copy of the weights
+    auto buffer = map_buffer(filename);
+    return load_buffer(buffer.data(), buffer.size(), options);
 }
 program load_buffer(const std::vector<char>& buffer, const file_options& options)
 {
@@ -41,6 +223,9 @@ program load_buffer(const std::vector<char>& buffer, const file_options& options
 }
 program load_buffer(const char* buffer, std::size_t size, const file_options& options)
 {
+    // A chunked program is recognized by its header whatever format was asked for
+    if(options.format == "chunked" or is_chunked(buffer, size))
+        return load_chunked(buffer, size);
     program p;
     if(options.format == "msgpack")
     {
@@ -57,18 +242,34 @@ program load_buffer(const char* buffer, std::size_t size, const file_options& op
     return p;
 }
 
+std::vector<value::binary> load_code_objects(const std::string& filename)
+{
+    auto buffer = map_buffer(filename);
+    auto cb     = read_chunked(buffer.data(), buffer.size());
+    std::vector<chunk_info> chunks;
+    std::copy_if(cb.chunks.begin(),
+                 cb.chunks.end(),
+                 std::back_inserter(chunks),
+                 [](const chunk_info& chunk) { return chunk.kind == "code_object"; });
+    std::vector<value::binary> result(chunks.size());
+    par_for(chunks.size(), 1, [&](auto i) { result[i] = decode_chunk(cb.data, chunks[i]); });
+    return result;
+}
+
 void save(const program& p, const std::string& filename, const file_options& options)
 {
     write_buffer(filename, save_buffer(p, options));
 }
 
-// MIOpen doesn't support serializing fusion plans with Find-2.0 APIs
+// MIOpen fusions only store their solution when built with the Find-2.0 fusion API, otherwise
+// they have to be compiled again after loading
 void print_miopen_warning(const program& p)
 {
     auto mods = p.get_modules();
     if(std::any_of(mods.begin(), mods.end(), [](const auto* m) {
            return std::any_of(m->begin(), m->end(), [](const instruction& i) {
-               return i.name() == "gpu::miopen_fusion";
+               return i.name() == "gpu::miopen_fusion" and
+                      not i.get_operator().to_value().contains("solution_object");
            });
        }))
     {
@@ -94,6 +295,10 @@ std::vector<char> save_buffer(const program& p, const file_options& options)
         std::string s = to_json_string(v);
         buffer        = std::vector<char>(s.begin(), s.end());
     }
+    else if(options.format == "chunked")
+    {
+        buffer = save_chunked(std::move(v), options.compression);
+    }
     else
     {
         MIGRAPHX_THROW("Unknown format: " + options.format);
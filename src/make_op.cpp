@@ -35,11 +35,11 @@ operation make_op_generic(const std::string& name, F for_each)
     auto op = load_op(name);
     // Merge values
     value w = op.to_value();
-    for_each([&](const auto& key, const auto& x) {
+    for_each([&](const auto& key, auto&& x) {
         if(not w.contains(key))
             // NOLINTNEXTLINE(performance-inefficient-string-concatenation)
             MIGRAPHX_THROW("No key '" + key + "' in " + name);
-        w.at(key) = x;
+        w.at(key) = std::forward<decltype(x)>(x);
     });
     op.from_value(w);
     return op;
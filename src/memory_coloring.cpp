@@ -23,17 +23,21 @@
  */
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/module.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/liveness.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/functional.hpp>
 #include <migraphx/algorithm.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/stringutils.hpp>
 #include <unordered_set>
 #include <unordered_map>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <set>
 
 namespace migraphx {
@@ -50,7 +54,7 @@ using instruction_set_map = std::unordered_map<instruction_ref, instruction_set>
 instruction_set_map build_conflict_table(const module& m, std::string allocation_op)
 {
     instruction_set_map conflict_table;
-    liveness(m, [&](auto ins, auto live_set) {
+    liveness(m, [&](auto ins, const auto& live_set) {
         // Skip variables that aren't allocations
         if(ins->name() != allocation_op)
             return;
@@ -197,6 +201,40 @@ struct allocation_segment
         return s;
     }
 
+    // Place the allocation in the smallest gap between the segments that it
+    // fits in, or at the end if there is no such gap
+    static segment best_fit_segment(std::set<segment>& segments,
+                                    instruction_ref ins,
+                                    std::size_t alignment)
+    {
+        assert(ins->get_shape().bytes() > 0);
+        auto n = 1 + (ins->get_shape().bytes() - 1) / alignment;
+        std::size_t max_end  = 0;
+        std::size_t start    = 0;
+        std::size_t best_gap = std::numeric_limits<std::size_t>::max();
+        bool found           = false;
+        for(const auto& s : segments)
+        {
+            if(s.first >= max_end)
+            {
+                auto gap = s.first - max_end;
+                if(gap >= n and gap < best_gap)
+                {
+                    best_gap = gap;
+                    start    = max_end;
+                    found    = true;
+                }
+            }
+            max_end = std::max(max_end, s.second);
+        }
+        if(not found)
+            start = max_end;
+        auto s = segment{start, start + n};
+        assert(not overlaps(segments, s));
+        segments.insert(s);
+        return s;
+    }
+
     static std::unordered_map<instruction_ref, int>
     create_allocation_index(const module& m, const instruction_set_map& conflict_table)
     {
@@ -211,9 +249,47 @@ struct allocation_segment
         return result;
     }
 
+    // Collect the segments already assigned to the adjacent allocations
+    std::set<segment> child_segments(const instruction_set& children) const
+    {
+        std::set<segment> segments;
+        transform_if(
+            children.begin(),
+            children.end(),
+            std::inserter(segments, segments.begin()),
+            [&](auto child) { return this->get_segment(child); },
+            [&](auto child) { return *this->get_segment(child); });
+        return segments;
+    }
+
+    // Try to move allocations to a lower segment
+    void reduce(const std::vector<instruction_ref>& conflict_queue,
+                const instruction_set_map& conflict_table,
+                std::size_t alignment)
+    {
+        // Reduce the number of segments
+        for(std::size_t n = 0; n < 3; n++)
+        {
+            for(auto parent : conflict_queue)
+            {
+                auto segments = child_segments(conflict_table.at(parent));
+                // Get the segment for the parent
+                const auto* parent_segment = this->get_segment(parent);
+                assert(parent_segment != nullptr);
+
+                auto s = next_segment(segments, parent, alignment);
+                if(s != *parent_segment and s.second <= this->max())
+                {
+                    this->add_segment(parent, s);
+                }
+            }
+        }
+    }
+
     // Build the allocation_color class from the conflict_table
-    static allocation_segment
-    build(const module& m, const instruction_set_map& conflict_table, std::size_t alignment)
+    static allocation_segment build_first_fit(const module& m,
+                                              const instruction_set_map& conflict_table,
+                                              std::size_t alignment)
     {
         allocation_segment as{};
         std::vector<instruction_ref> conflict_queue;
@@ -255,36 +331,121 @@ struct allocation_segment
             assert(as.get_segment(parent) == nullptr);
             as.add_segment(parent, next_segment(segments, parent, alignment));
         }
-        // Reduce the number of segments
-        for(std::size_t n = 0; n < 3; n++)
+        as.reduce(conflict_queue, conflict_table, alignment);
+        return as;
+    }
+
+    // Best-fit-decreasing: allocations are placed in decreasing order of the
+    // weight into the tightest gap left by the adjacent allocations
+    template <class Weight>
+    static allocation_segment build_best_fit(const module& m,
+                                             const instruction_set_map& conflict_table,
+                                             std::size_t alignment,
+                                             Weight weight)
+    {
+        allocation_segment as{};
+        std::vector<instruction_ref> conflict_queue;
+        std::transform(conflict_table.begin(),
+                       conflict_table.end(),
+                       std::back_inserter(conflict_queue),
+                       [](auto&& pp) { return pp.first; });
+
+        auto alloc_index = create_allocation_index(m, conflict_table);
+        std::sort(conflict_queue.begin(), conflict_queue.end(), by(std::greater<>{}, [&](auto x) {
+                      return std::make_tuple(weight(x), x->get_shape().bytes(), -alloc_index.at(x));
+                  }));
+        for(auto parent : conflict_queue)
         {
-            for(auto parent : conflict_queue)
-            {
-                auto children = conflict_table.at(parent);
-                // This set is to track the segments already processed
-                std::set<segment> segments;
-                // Add all segments for the children to the segments already processed
-                transform_if(
-                    children.begin(),
-                    children.end(),
-                    std::inserter(segments, segments.begin()),
-                    [&](auto child) { return as.get_segment(child); },
-                    [&](auto child) { return *as.get_segment(child); });
-                // Get the segment for the parent
-                const auto* parent_segment = as.get_segment(parent);
-                assert(parent_segment != nullptr);
+            auto segments = as.child_segments(conflict_table.at(parent));
+            assert(as.get_segment(parent) == nullptr);
+            as.add_segment(parent, best_fit_segment(segments, parent, alignment));
+        }
+        as.reduce(conflict_queue, conflict_table, alignment);
+        return as;
+    }
 
-                auto s = next_segment(segments, parent, alignment);
-                if(s != *parent_segment and s.second <= as.max())
-                {
-                    as.add_segment(parent, s);
-                }
+    // Pack with the strategy, or with all of them and keep the smallest
+    static allocation_segment build(const module& m,
+                                    const instruction_set_map& conflict_table,
+                                    std::size_t alignment,
+                                    memory_coloring::packing strategy)
+    {
+        using packing  = memory_coloring::packing;
+        auto lifetimes = compute_lifetimes(m, conflict_table);
+        auto by_size   = [](auto x) { return x->get_shape().bytes(); };
+        auto by_area   = [&](auto x) { return x->get_shape().bytes() * lifetimes.at(x); };
+        switch(strategy)
+        {
+        case packing::first_fit: return build_first_fit(m, conflict_table, alignment);
+        case packing::best_fit_size: return build_best_fit(m, conflict_table, alignment, by_size);
+        case packing::best_fit_lifetime:
+            return build_best_fit(m, conflict_table, alignment, by_area);
+        case packing::smallest: break;
+        }
+        std::vector<allocation_segment> candidates;
+        candidates.push_back(build_first_fit(m, conflict_table, alignment));
+        candidates.push_back(build_best_fit(m, conflict_table, alignment, by_size));
+        candidates.push_back(build_best_fit(m, conflict_table, alignment, by_area));
+        // Prefer the earlier strategies when there is a tie
+        auto it = std::min_element(candidates.begin(),
+                                   candidates.end(),
+                                   by(std::less<>{}, [](auto& as) { return as.max(); }));
+        return std::move(*it);
+    }
+
+    // The number of instructions from the allocation to its last use
+    static std::unordered_map<instruction_ref, std::size_t>
+    compute_lifetimes(const module& m, const instruction_set_map& conflict_table)
+    {
+        std::unordered_map<instruction_ref, std::size_t> first;
+        std::unordered_map<instruction_ref, std::size_t> last;
+        std::size_t i = 0;
+        for(auto ins : iterator_for(m))
+        {
+            if(contains(conflict_table, ins))
+                first[ins] = i;
+            for(auto input : ins->inputs())
+            {
+                auto alias = instruction::get_output_alias(input);
+                if(contains(conflict_table, alias))
+                    last[alias] = i;
             }
+            i++;
         }
-        return as;
+        std::unordered_map<instruction_ref, std::size_t> result;
+        for(auto&& pp : first)
+        {
+            auto it          = last.find(pp.first);
+            result[pp.first] = 1 + (it == last.end() ? 0 : it->second - pp.second);
+        }
+        return result;
     }
 };
 
+// The largest total size of the allocations that are live at the same time,
+// which is a lower bound for the scratch memory
+static std::size_t
+max_live_bytes(const module& m, const std::string& allocation_op, std::size_t alignment)
+{
+    auto aligned_bytes = [&](instruction_ref ins) {
+        auto n = ins->get_shape().bytes();
+        return (n + alignment - 1) / alignment * alignment;
+    };
+    std::size_t result = 0;
+    liveness(m, [&](auto ins, const auto& live_set) {
+        if(ins->name() != allocation_op)
+            return;
+        auto live = std::accumulate(
+            live_set.begin(), live_set.end(), aligned_bytes(ins), [&](auto n, auto i) {
+                if(i->name() != allocation_op)
+                    return n;
+                return n + aligned_bytes(i);
+            });
+        result = std::max(result, live);
+    });
+    return result;
+}
+
 static std::size_t find_max_alignment(const module& m, const std::string& allocation_op)
 {
     std::size_t alignment = 1;
@@ -301,7 +462,7 @@ void memory_coloring::apply(module& m) const
 {
     const std::size_t alignment = find_max_alignment(m, allocation_op);
     auto conflict_table         = build_conflict_table(m, allocation_op);
-    auto as                     = allocation_segment::build(m, conflict_table, alignment);
+    auto as                     = allocation_segment::build(m, conflict_table, alignment, strategy);
 
     // All allocations should have a segment
     assert(std::all_of(conflict_table.begin(), conflict_table.end(), [&](auto&& pp) {
@@ -339,6 +500,18 @@ void memory_coloring::apply(module& m) const
     // Total memory
     std::size_t n = as.max() * alignment;
 
+    if(enabled(MIGRAPHX_DEBUG_MEMORY_COLORING{}))
+    {
+        auto max_live = max_live_bytes(m, allocation_op, alignment);
+        std::cout << "Scratch: " << n << " bytes, max live: " << max_live << " bytes";
+        if(max_live > 0)
+            std::cout << " (" << (100.0 * n / max_live - 100.0) << "% above)";
+        std::cout << std::endl;
+    }
+
+    static auto& scratch_bytes = get_metric_counter("scratch_bytes");
+    scratch_bytes.add(n);
+
     // Replace allocations
     auto mem = m.add_parameter("scratch", shape{shape::int8_type, {n}});
     for(auto&& [ins, seg] : as.ins2segment)
@@ -368,5 +541,124 @@ void memory_coloring::apply(module& m) const
     }
 }
 
+// Every allocation is aligned to at most the size of the largest type times 4
+constexpr std::size_t max_alignment = 32;
+
+// Submodules that are called by only one instruction, so their scratch can be placed in the
+// scratch of the parent
+static std::unordered_set<const module*> single_call_modules(const module& root)
+{
+    std::unordered_map<const module*, std::size_t> calls;
+    std::vector<const module*> mods = {&root};
+    auto sub_mods                   = root.get_sub_modules();
+    mods.insert(mods.end(), sub_mods.begin(), sub_mods.end());
+    for(const auto* mod : mods)
+    {
+        for(const auto& ins : *mod)
+        {
+            for(const auto* smod : ins.module_inputs())
+                calls[smod]++;
+        }
+    }
+    std::unordered_set<const module*> result;
+    for(auto&& [mod, n] : calls)
+    {
+        if(n == 1)
+            result.insert(mod);
+    }
+    return result;
+}
+
+// The scratch of the call site is only live in program order, which does not cover the
+// instructions that the schedule runs concurrently on other streams
+static bool has_streams(const module& m)
+{
+    return std::any_of(
+        m.begin(), m.end(), [](const auto& ins) { return ends_with(ins.name(), "::set_stream"); });
+}
+
+struct submodule_scratch
+{
+    // Allocation for the scratch of the submodules, which is kept live over the call site by
+    // the use inserted after it
+    instruction_ref alloc;
+    instruction_ref use;
+    std::vector<module_ref> mods;
+};
+
+static std::vector<submodule_scratch>
+insert_submodule_scratch(module& m,
+                         const std::string& allocation_op,
+                         const std::unordered_set<const module*>& shared)
+{
+    std::vector<submodule_scratch> result;
+    for(auto ins : iterator_for(m))
+    {
+        std::vector<module_ref> mods;
+        std::size_t bytes = 0;
+        for(auto* smod : ins->module_inputs())
+        {
+            if(not contains(shared, smod))
+                continue;
+            auto scratch = smod->get_parameter("scratch");
+            if(scratch == smod->end())
+                continue;
+            bytes = std::max(bytes, scratch->get_shape().bytes());
+            mods.push_back(smod);
+        }
+        if(mods.empty() or bytes == 0)
+            continue;
+        // Use the largest type so its offset is aligned for every allocation of the submodules
+        auto n = (bytes + max_alignment - 1) / max_alignment;
+        shape s{shape::uint64_type, {n * max_alignment / sizeof(std::uint64_t)}};
+        auto alloc = m.insert_instruction(ins, make_op(allocation_op, {{"shape", to_value(s)}}));
+        auto use   = m.insert_instruction(std::next(ins), make_op("identity"), alloc);
+        result.push_back({alloc, use, mods});
+    }
+    return result;
+}
+
+// Move the loads from the scratch of the submodule, and of its own submodules that were placed
+// in it, to the scratch of the parent at the offset
+static void rebase_scratch(module_ref smod, instruction_ref mem, std::size_t offset)
+{
+    auto scratch = smod->get_parameter("scratch");
+    auto mods    = smod->get_sub_modules();
+    mods.push_back(smod);
+    auto loads = scratch->outputs();
+    for(auto load : loads)
+    {
+        assert(load->name() == "load");
+        auto it = std::find_if(
+            mods.begin(), mods.end(), [&](module_ref mod) { return mod->has_instruction(load); });
+        assert(it != mods.end());
+        auto v      = load->get_operator().to_value();
+        v["offset"] = v.at("offset").to<std::size_t>() + offset;
+        (*it)->replace_instruction(load, make_op("load", v), mem);
+    }
+    smod->remove_instruction(scratch);
+}
+
+void memory_coloring::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    std::vector<submodule_scratch> call_sites;
+    if(not has_streams(m))
+        call_sites =
+            insert_submodule_scratch(m, allocation_op, single_call_modules(*mpm.get_root_module()));
+    this->apply(m);
+    for(const auto& site : call_sites)
+    {
+        // The allocation was replaced with a load from the scratch
+        assert(site.alloc->name() == "load");
+        auto mem    = site.alloc->inputs().front();
+        auto offset = site.alloc->get_operator().to_value().at("offset").to<std::size_t>();
+        for(auto* smod : site.mods)
+            rebase_scratch(smod, mem, offset);
+        m.remove_instruction(site.use);
+        m.remove_instruction(site.alloc);
+    }
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
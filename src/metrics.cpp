@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/metrics.hpp>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+void metric_histogram::record(std::uint64_t x)
+{
+    std::size_t i = 0;
+    while(i < nbuckets - 1 and (x >> i) != 0)
+        i++;
+    buckets[i].fetch_add(1, std::memory_order_relaxed);
+    n.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(x, std::memory_order_relaxed);
+}
+
+void metric_histogram::reset()
+{
+    for(auto& b : buckets)
+        b.store(0, std::memory_order_relaxed);
+    n.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+}
+
+namespace {
+// The metrics are held by pointer so the references handed out stay valid as the maps grow
+struct metric_registry
+{
+    std::mutex m;
+    std::unordered_map<std::string, std::unique_ptr<metric_counter>> counters;
+    std::unordered_map<std::string, std::unique_ptr<metric_histogram>> histograms;
+
+    template <class T>
+    static T& get(std::unordered_map<std::string, std::unique_ptr<T>>& metrics,
+                  const std::string& name)
+    {
+        auto& p = metrics[name];
+        if(p == nullptr)
+            p = std::make_unique<T>();
+        return *p;
+    }
+};
+} // namespace
+
+static metric_registry& get_metric_registry()
+{
+    // Never destroyed so metrics can still be updated while other statics are destroyed
+    static auto* r = new metric_registry; // NOLINT
+    return *r;
+}
+
+metric_counter& get_metric_counter(const std::string& name)
+{
+    auto& r = get_metric_registry();
+    std::lock_guard<std::mutex> lock(r.m);
+    return metric_registry::get(r.counters, name);
+}
+
+metric_histogram& get_metric_histogram(const std::string& name)
+{
+    auto& r = get_metric_registry();
+    std::lock_guard<std::mutex> lock(r.m);
+    return metric_registry::get(r.histograms, name);
+}
+
+std::map<std::string, std::uint64_t> get_metrics()
+{
+    auto& r = get_metric_registry();
+    std::lock_guard<std::mutex> lock(r.m);
+    std::map<std::string, std::uint64_t> result;
+    for(const auto& [name, c] : r.counters)
+        result[name] = c->get();
+    for(const auto& [name, h] : r.histograms)
+    {
+        result[name + ".count"] = h->count();
+        result[name + ".sum"]   = h->sum();
+        std::size_t last        = metric_histogram::nbuckets;
+        while(last > 0 and h->bucket(last - 1) == 0)
+            last--;
+        std::uint64_t cumulative = 0;
+        for(std::size_t i = 0; i < last; i++)
+        {
+            cumulative += h->bucket(i);
+            result[name + ".le_" + std::to_string(std::uint64_t{1} << i)] = cumulative;
+        }
+    }
+    return result;
+}
+
+std::uint64_t get_metric(const std::string& name)
+{
+    auto metrics = get_metrics();
+    auto it      = metrics.find(name);
+    if(it == metrics.end())
+        return 0;
+    return it->second;
+}
+
+void reset_metrics()
+{
+    auto& r = get_metric_registry();
+    std::lock_guard<std::mutex> lock(r.m);
+    for(auto& p : r.counters)
+        p.second->reset();
+    for(auto& p : r.histograms)
+        p.second->reset();
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -25,6 +25,8 @@
 #include <migraphx/algorithm.hpp>
 #include <migraphx/module.hpp>
 #include <migraphx/bit_signal.hpp>
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/hash.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/target.hpp>
@@ -33,6 +35,7 @@
 #include <migraphx/time.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/iterator.hpp>
+#include <migraphx/functional.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/param_utils.hpp>
@@ -55,13 +58,110 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_FINALIZE)
 struct module_impl
 {
     // A list is used to keep references to an instruction stable
-    std::list<instruction> instructions;
-    std::unordered_set<instruction*> instruction_set;
+    instruction_list instructions;
+    // Shares the pool of the instructions
+    std::unordered_set<instruction*,
+                       std::hash<instruction*>,
+                       std::equal_to<instruction*>,
+                       pool_allocator<instruction*>>
+        instruction_set{pool_allocator<instruction*>{instructions.get_allocator()}};
     std::string name;
     uint32_t nparams = 0;
     bool bypass      = false;
     bit_signal<64> changed{};
 
+    // Instructions touched by rewrites while incremental rewrites are enabled
+    struct rewrite_tracker
+    {
+        // Nothing has been tracked yet, so every instruction is dirty
+        bool full = true;
+        std::unordered_set<const instruction*> previous;
+        std::unordered_set<const instruction*> current;
+    };
+    std::shared_ptr<rewrite_tracker> rewrites = nullptr;
+
+    // Results of module::get_analysis for the current state of the module
+    struct analysis_cache
+    {
+        bit_signal<64>::slot changed = {};
+        std::size_t fingerprint      = 0;
+        std::unordered_map<std::string, std::shared_ptr<const void>> results;
+    };
+    std::shared_ptr<analysis_cache> analyses = nullptr;
+
+    // Passes can also rewire instructions directly (ie instruction::replace_argument) without
+    // going through the module, so analyses are also checked against the order and inputs of the
+    // instructions
+    std::size_t fingerprint() const
+    {
+        std::size_t h = instructions.size();
+        for(const auto& ins : instructions)
+        {
+            hash_combine(h, std::addressof(ins));
+            for(auto input : ins.inputs())
+                hash_combine(h, as_address(input));
+            for(auto* smod : ins.module_inputs())
+                hash_combine(h, smod);
+        }
+        return h;
+    }
+
+    void touch(instruction_ref ins)
+    {
+        if(rewrites != nullptr)
+            rewrites->current.insert(std::addressof(*ins));
+    }
+
+    // Touch an instruction whose outputs changed, along with its outputs, since matchers can look
+    // at the siblings of the instruction they start from
+    void touch_outputs(instruction_ref ins)
+    {
+        if(rewrites == nullptr)
+            return;
+        touch(ins);
+        for(auto output : ins->outputs())
+            touch(output);
+    }
+
+    // Touch the inputs that are added or removed when the inputs of ins are replaced by args
+    void touch_replaced_inputs(instruction_ref ins, const std::vector<instruction_ref>& args)
+    {
+        if(rewrites == nullptr)
+            return;
+        for(auto input : ins->inputs())
+        {
+            if(not migraphx::contains(args, input))
+                touch_outputs(input);
+        }
+        for(auto arg : args)
+        {
+            if(not migraphx::contains(ins->inputs(), arg))
+                touch_outputs(arg);
+        }
+    }
+
+    void touch_inputs(const instruction& ins)
+    {
+        if(rewrites == nullptr)
+            return;
+        for(auto input : ins.inputs())
+            touch(input);
+    }
+
+    void forget(const instruction& ins)
+    {
+        if(rewrites == nullptr)
+            return;
+        rewrites->previous.erase(std::addressof(ins));
+        rewrites->current.erase(std::addressof(ins));
+    }
+
+    bool touched(instruction_ref ins) const
+    {
+        const auto* p = std::addressof(*ins);
+        return rewrites->current.count(p) > 0 or rewrites->previous.count(p) > 0;
+    }
+
     bool contains(instruction_ref ins) const
     {
         if(is_end(ins, instructions.end()))
@@ -76,6 +176,7 @@ struct module_impl
         // cppcheck-suppress redundantInitialization
         auto r = instructions.emplace(pos, std::forward<Ts>(xs)...);
         instruction_set.insert(std::addressof(*r));
+        touch(r);
         return r;
     }
     instruction_ref insert(instruction_ref pos, const instruction& ins)
@@ -112,13 +213,17 @@ struct module_impl
     {
         changed.notify();
         instruction_set.erase(std::addressof(*pos));
+        forget(*pos);
         return instructions.erase(pos);
     }
 
     instruction_ref erase(instruction_ref start, instruction_ref last)
     {
         changed.notify();
-        std::for_each(start, last, [&](auto& ins) { instruction_set.erase(std::addressof(ins)); });
+        std::for_each(start, last, [&](auto& ins) {
+            instruction_set.erase(std::addressof(ins));
+            forget(ins);
+        });
         return instructions.erase(start, last);
     }
 };
@@ -156,6 +261,9 @@ void module::assign(const module& m)
     if(not impl)
         impl = std::make_unique<module_impl>();
     *impl = *m.impl;
+    // The tracked instructions and analyses belong to the other module
+    impl->rewrites = nullptr;
+    impl->analyses = nullptr;
 
     // clear instructions
     if(not impl->instructions.empty())
@@ -332,6 +440,8 @@ instruction_ref module::replace_instruction(instruction_ref ins,
     assert(not starts_with(op.name(), "@"));
 
     shape r = compute_shape(op, args);
+    impl->touch(ins);
+    impl->touch_replaced_inputs(ins, args);
     instruction::replace(ins, op, r, std::move(args));
     assert(ins->valid(begin()));
     return ins;
@@ -346,6 +456,8 @@ instruction_ref module::replace_instruction(instruction_ref ins,
     assert(has_instruction(ins));
     assert(not starts_with(op.name(), "@"));
     auto out_shape = compute_shape(op, args, module_args);
+    impl->touch(ins);
+    impl->touch_replaced_inputs(ins, args);
     instruction::replace(ins, op, out_shape, std::move(args), std::move(module_args));
     assert(ins->valid(begin()));
     return ins;
@@ -372,11 +484,14 @@ instruction_ref module::replace_instruction(instruction_ref ins, instruction_ref
     }
     // Make a copy of outputs which can be changed when calling replace_argument
     auto outputs = ins->outputs();
+    impl->touch(ins);
+    impl->touch_outputs(rep);
     for(auto out : outputs)
     {
         // TODO: Check for possible cycles
         if(out != rep)
         {
+            impl->touch(out);
             instruction::replace_argument(out, ins, rep);
         }
         assert(out->valid(begin()));
@@ -396,6 +511,7 @@ instruction_ref module::remove_instruction(instruction_ref ins)
 {
     assert(has_instruction(ins));
     assert(ins->outputs().empty());
+    impl->touch_inputs(*ins);
     ins->clear_arguments();
     return impl->erase(ins);
 }
@@ -406,7 +522,10 @@ instruction_ref module::remove_instructions(instruction_ref first, instruction_r
         return first;
     // TODO: Check every element
     assert(has_instruction(first));
-    std::for_each(first, last, [&](instruction& ins) { ins.clear_arguments(); });
+    std::for_each(first, last, [&](instruction& ins) {
+        impl->touch_inputs(ins);
+        ins.clear_arguments();
+    });
     assert(std::all_of(first, last, [&](const instruction& ins) { return ins.outputs().empty(); }));
     return impl->erase(first, last);
 }
@@ -416,6 +535,7 @@ instruction_ref module::move_instruction(instruction_ref src, instruction_ref ds
     impl->changed.notify();
     assert(has_instruction(src));
     assert(has_instruction(dst) or is_end(dst, this->end()));
+    impl->touch(src);
     impl->instructions.splice(dst, impl->instructions, src);
     return src;
 }
@@ -808,7 +928,11 @@ void module::finalize(std::vector<context>& contexts)
             std::cout << "Finalize: ";
             this->debug_print(ins);
         }
-        ins->finalize(contexts[ins->get_target_id()]);
+        {
+            compile_profile_scope profile{"finalize", ins->name()};
+            profile.add("module", this->name());
+            ins->finalize(contexts[ins->get_target_id()]);
+        }
         for(const auto& smod : ins->module_inputs())
         {
             smod->finalize(contexts);
@@ -1539,6 +1663,79 @@ void module::repeat_while_changes(std::size_t n, const std::function<void()>& f)
     }
 }
 
+void module::set_incremental_rewrites(bool b)
+{
+    if(not b)
+        impl->rewrites = nullptr;
+    else if(impl->rewrites == nullptr)
+        impl->rewrites = std::make_shared<module_impl::rewrite_tracker>();
+}
+
+void module::next_rewrite_epoch()
+{
+    if(impl->rewrites == nullptr)
+        return;
+    impl->rewrites->full     = false;
+    impl->rewrites->previous = std::move(impl->rewrites->current);
+    impl->rewrites->current.clear();
+}
+
+// How far up the inputs a matcher is expected to look from the root instruction
+static constexpr std::size_t rewrite_match_depth = 3;
+
+bool module::is_dirty(instruction_ref ins) const
+{
+    if(impl->rewrites == nullptr or impl->rewrites->full)
+        return true;
+    if(std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](instruction_ref out) {
+           return impl->touched(out);
+       }))
+        return true;
+    return fix<bool>([&](auto self, instruction_ref i, std::size_t depth) -> bool {
+        if(impl->touched(i))
+            return true;
+        if(depth == 0)
+            return false;
+        return std::any_of(i->inputs().begin(), i->inputs().end(), [&](instruction_ref input) {
+            return self(input, depth - 1);
+        });
+    })(ins, rewrite_match_depth);
+}
+
+std::function<bool()> module::track_changes()
+{
+    auto has_changed = std::make_shared<bit_signal<64>::slot>(impl->changed.subscribe());
+    return [has_changed] { return has_changed->triggered(); };
+}
+
+std::shared_ptr<const void> module::find_analysis(const std::string& key) const
+{
+    if(impl->analyses == nullptr)
+        return nullptr;
+    if(impl->analyses->changed.triggered() or impl->analyses->fingerprint != impl->fingerprint())
+    {
+        impl->analyses = nullptr;
+        return nullptr;
+    }
+    auto it = impl->analyses->results.find(key);
+    if(it == impl->analyses->results.end())
+        return nullptr;
+    return it->second;
+}
+
+std::shared_ptr<const void> module::add_analysis(const std::string& key,
+                                                 std::shared_ptr<const void> a) const
+{
+    if(impl->analyses == nullptr)
+    {
+        impl->analyses              = std::make_shared<module_impl::analysis_cache>();
+        impl->analyses->changed     = impl->changed.subscribe();
+        impl->analyses->fingerprint = impl->fingerprint();
+    }
+    impl->analyses->results[key] = a;
+    return a;
+}
+
 bool operator==(const module& x, const module& y) { return to_string(x) == to_string(y); }
 
 std::ostream& operator<<(std::ostream& os, const module& m)
@@ -57,84 +57,6 @@ MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
 {
     namespace adaptor {
 
-    template <>
-    struct convert<migraphx::value>
-    {
-        const msgpack::object& operator()(const msgpack::object& o, migraphx::value& v) const
-        {
-            switch(o.type)
-            {
-            case msgpack::type::NIL: {
-                v = nullptr;
-                break;
-            }
-            case msgpack::type::BOOLEAN: {
-                v = o.as<bool>();
-                break;
-            }
-            case msgpack::type::POSITIVE_INTEGER: {
-                v = o.as<std::uint64_t>();
-                break;
-            }
-            case msgpack::type::NEGATIVE_INTEGER: {
-                v = o.as<std::int64_t>();
-                break;
-            }
-            case msgpack::type::FLOAT32:
-            case msgpack::type::FLOAT64: {
-                v = o.as<double>();
-                break;
-            }
-            case msgpack::type::STR: {
-                v = o.as<std::string>();
-                break;
-            }
-            case msgpack::type::BIN: {
-                // For backwards compatibility
-                v = migraphx::value::binary{o.via.bin.ptr, o.via.bin.size};
-                break;
-            }
-            case msgpack::type::ARRAY: {
-                if(o.via.array.size != 0 and o.via.array.ptr->type == msgpack::type::BIN)
-                {
-                    auto bin = migraphx::value::binary{};
-                    std::for_each(
-                        o.via.array.ptr,
-                        o.via.array.ptr + o.via.array.size,
-                        [&](const msgpack::object& so) {
-                            bin.insert(bin.end(), so.via.bin.ptr, so.via.bin.ptr + so.via.bin.size);
-                        });
-                    v = bin;
-                }
-                else
-                {
-                    migraphx::value r = migraphx::value::array{};
-                    std::for_each(
-                        o.via.array.ptr,
-                        o.via.array.ptr + o.via.array.size,
-                        [&](const msgpack::object& so) { r.push_back(so.as<migraphx::value>()); });
-                    v = r;
-                }
-                break;
-            }
-            case msgpack::type::MAP: {
-                migraphx::value r = migraphx::value::object{};
-                std::for_each(o.via.map.ptr,
-                              o.via.map.ptr + o.via.map.size,
-                              [&](const msgpack::object_kv& p) {
-                                  r[p.key.as<std::string>()] = p.val.as<migraphx::value>();
-                              });
-                v = r;
-                break;
-            }
-            case msgpack::type::EXT: {
-                MIGRAPHX_THROW("msgpack EXT type not supported.");
-            }
-            }
-            return o;
-        }
-    };
-
     template <>
     struct pack<migraphx::value::binary>
     {
@@ -242,10 +164,127 @@ std::vector<char> to_msgpack(const value& v)
     msgpack::pack(vs, v);
     return vs.buffer;
 }
+// Builds the value directly from the msgpack tokens instead of unpacking into msgpack objects
+// first. Each finished array or map is moved into its parent, so nothing is copied.
+struct value_builder : msgpack::null_visitor
+{
+    struct frame
+    {
+        std::vector<value> items = {};
+        bool is_map              = false;
+        std::string key          = {};
+        // Binary data is packed as an array of bin chunks, which are joined as they are read
+        bool is_binary     = false;
+        value::binary data = {};
+    };
+    std::vector<frame> stack = {};
+    bool in_key              = false;
+    value result             = {};
+
+    template <class... Ts>
+    bool add(Ts&&... xs)
+    {
+        if(in_key)
+            MIGRAPHX_THROW("msgpack: map keys must be strings");
+        if(stack.empty())
+        {
+            result = value(std::forward<Ts>(xs)...);
+            return true;
+        }
+        auto& f = stack.back();
+        if(f.is_binary)
+            MIGRAPHX_THROW("msgpack: expected a bin chunk");
+        if(f.is_map)
+            f.items.emplace_back(f.key, std::forward<Ts>(xs)...);
+        else
+            f.items.emplace_back(std::forward<Ts>(xs)...);
+        return true;
+    }
+
+    bool start(std::uint32_t n, bool is_map)
+    {
+        if(in_key)
+            MIGRAPHX_THROW("msgpack: map keys must be strings");
+        stack.emplace_back();
+        stack.back().items.reserve(n);
+        stack.back().is_map = is_map;
+        return true;
+    }
+
+    frame finish()
+    {
+        auto f = std::move(stack.back());
+        stack.pop_back();
+        return f;
+    }
+
+    bool visit_nil() { return add(nullptr); }
+    bool visit_boolean(bool x) { return add(x); }
+    bool visit_positive_integer(std::uint64_t x) { return add(x); }
+    bool visit_negative_integer(std::int64_t x) { return add(x); }
+    bool visit_float32(float x) { return add(double{x}); }
+    bool visit_float64(double x) { return add(x); }
+    bool visit_str(const char* x, std::uint32_t n)
+    {
+        if(not in_key)
+            return add(std::string(x, n));
+        stack.back().key.assign(x, n);
+        return true;
+    }
+    bool visit_bin(const char* x, std::uint32_t n)
+    {
+        if(not in_key and not stack.empty() and not stack.back().is_map)
+        {
+            auto& f = stack.back();
+            if(f.items.empty())
+                f.is_binary = true;
+            if(f.is_binary)
+            {
+                f.data.insert(f.data.end(), x, x + n);
+                return true;
+            }
+        }
+        // For backwards compatibility
+        return add(value::binary{x, n});
+    }
+    bool visit_ext(const char*, std::uint32_t)
+    {
+        MIGRAPHX_THROW("msgpack EXT type not supported.");
+    }
+    bool start_array(std::uint32_t n) { return start(n, false); }
+    bool end_array()
+    {
+        auto f = finish();
+        if(f.is_binary)
+            return add(std::move(f.data));
+        return add(std::move(f.items));
+    }
+    bool start_map(std::uint32_t n) { return start(n, true); }
+    bool start_map_key()
+    {
+        in_key = true;
+        return true;
+    }
+    bool end_map_key()
+    {
+        in_key = false;
+        return true;
+    }
+    bool end_map() { return add(finish().items, false); }
+    void parse_error(std::size_t, std::size_t) { MIGRAPHX_THROW("msgpack: parse error"); }
+    void insufficient_bytes(std::size_t, std::size_t)
+    {
+        MIGRAPHX_THROW("msgpack: insufficient bytes");
+    }
+};
+
 value from_msgpack(const char* buffer, std::size_t size)
 {
-    msgpack::object_handle oh = msgpack::unpack(buffer, size);
-    return oh.get().as<value>();
+    value_builder builder;
+    std::size_t offset = 0;
+    if(not msgpack::parse(buffer, size, offset, builder))
+        MIGRAPHX_THROW("Failed to parse msgpack");
+    return std::move(builder.result);
 }
 value from_msgpack(const std::vector<char>& buffer)
 {
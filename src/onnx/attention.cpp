@@ -0,0 +1,124 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/attention.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/literal.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+instruction_ref
+split_heads(const onnx_parser::node_info& info, instruction_ref ins, std::size_t num_heads)
+{
+    auto lens = ins->get_shape().lens();
+    if(lens.size() != 3 or num_heads == 0 or lens[2] % num_heads != 0)
+        MIGRAPHX_THROW("Attention: hidden size is not divisible by the number of heads");
+    ins = info.add_instruction(
+        make_op("reshape", {{"dims", {lens[0], lens[1], num_heads, lens[2] / num_heads}}}), ins);
+    return info.add_instruction(make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), ins);
+}
+
+instruction_ref merge_heads(const onnx_parser::node_info& info, instruction_ref ins)
+{
+    auto lens = ins->get_shape().lens();
+    ins = info.add_instruction(make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), ins);
+    return info.add_instruction(
+        make_op("reshape", {{"dims", {lens[0], lens[2], lens[1] * lens[3]}}}), ins);
+}
+
+instruction_ref
+repeat_kv_heads(const onnx_parser::node_info& info, instruction_ref ins, std::size_t num_heads)
+{
+    auto lens = ins->get_shape().lens();
+    if(lens[1] == num_heads)
+        return ins;
+    if(lens[1] == 0 or num_heads % lens[1] != 0)
+        MIGRAPHX_THROW("Attention: num_heads must be a multiple of kv_num_heads");
+    std::vector<std::size_t> bc_lens = {lens[0], lens[1], num_heads / lens[1], lens[2], lens[3]};
+    ins = info.add_instruction(make_op("unsqueeze", {{"axes", {2}}}), ins);
+    ins = info.add_instruction(make_op("multibroadcast", {{"out_lens", bc_lens}}), ins);
+    lens[1] = num_heads;
+    return info.add_instruction(make_op("reshape", {{"dims", lens}}), ins);
+}
+
+instruction_ref
+expand_rotary_table(const onnx_parser::node_info& info, instruction_ref table, bool interleaved)
+{
+    auto axis = table->get_shape().ndim() - 1;
+    if(not interleaved)
+        return info.add_instruction(make_op("concat", {{"axis", axis}}), table, table);
+    auto lens = table->get_shape().lens();
+    lens.push_back(2);
+    table = info.add_instruction(make_op("unsqueeze", {{"axes", {axis + 1}}}), table);
+    table = info.add_instruction(make_op("multibroadcast", {{"out_lens", lens}}), table);
+    lens.pop_back();
+    lens.back() *= 2;
+    return info.add_instruction(make_op("reshape", {{"dims", lens}}), table);
+}
+
+instruction_ref scaled_dot_product_attention(const onnx_parser::node_info& info,
+                                             instruction_ref q,
+                                             instruction_ref k,
+                                             instruction_ref v,
+                                             float scale,
+                                             std::optional<instruction_ref> bias,
+                                             std::optional<instruction_ref> mask,
+                                             std::optional<float> mask_value,
+                                             float softcap)
+{
+    auto type   = q->get_shape().type();
+    auto kt     = info.add_instruction(make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), k);
+    auto scores = info.add_instruction(make_op("dot"), q, kt);
+    auto factor = info.add_literal(literal{shape{type}, {scale}});
+    scores      = info.add_common_op("mul", scores, factor);
+    if(softcap != 0)
+    {
+        auto cap = info.add_literal(literal{shape{type}, {softcap}});
+        scores   = info.add_common_op("div", scores, cap);
+        scores   = info.add_instruction(make_op("tanh"), scores);
+        scores   = info.add_common_op("mul", scores, cap);
+    }
+    if(bias.has_value())
+        scores = info.add_common_op("add", scores, *bias);
+    auto lens = scores->get_shape().lens();
+    if(mask.has_value())
+    {
+        literal fill;
+        if(mask_value.has_value())
+            fill = literal{shape{type}, {*mask_value}};
+        else
+            shape::visit(type, [&](auto as) { fill = literal{shape{type}, {double(as.min())}}; });
+        auto bc     = make_op("multibroadcast", {{"out_lens", lens}});
+        auto masked = info.add_instruction(bc, info.add_literal(fill));
+        auto cond   = info.add_instruction(bc, *mask);
+        scores      = info.add_instruction(make_op("where"), cond, scores, masked);
+    }
+    auto probs = info.add_instruction(make_op("softmax", {{"axis", 3}}), scores);
+    return info.add_instruction(make_op("dot"), probs, v);
+}
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
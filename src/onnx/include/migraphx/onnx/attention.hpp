@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_ONNX_ATTENTION_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_ONNX_ATTENTION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/onnx/onnx_parser.hpp>
+#include <migraphx/instruction.hpp>
+#include <optional>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+// Splits (batch, sequence, num_heads * head_size) into (batch, num_heads, sequence, head_size)
+instruction_ref
+split_heads(const onnx_parser::node_info& info, instruction_ref ins, std::size_t num_heads);
+
+// Merges (batch, num_heads, sequence, head_size) into (batch, sequence, num_heads * head_size)
+instruction_ref merge_heads(const onnx_parser::node_info& info, instruction_ref ins);
+
+// Repeats each kv head of (batch, kv_num_heads, sequence, head_size) for the query heads that
+// share it
+instruction_ref
+repeat_kv_heads(const onnx_parser::node_info& info, instruction_ref ins, std::size_t num_heads);
+
+// Expands a rotary cos or sin table to the full rotary dimension, where each value is used by a
+// pair of elements that are either half the axis apart or next to each other when interleaved
+instruction_ref
+expand_rotary_table(const onnx_parser::node_info& info, instruction_ref table, bool interleaved);
+
+/**
+ * softmax(q * k^T * scale + bias) * v over (batch, num_heads, sequence, head_size) inputs.
+ *
+ * Keys where the boolean mask is false are replaced by mask_value before the softmax, and a
+ * non-zero softcap applies softcap * tanh(x / softcap) to the scaled scores. The bias and mask
+ * are broadcast to the (batch, num_heads, sequence, total_sequence) scores. This is the
+ * dot -> pointwise -> softmax -> dot form that the fused attention passes match.
+ */
+instruction_ref scaled_dot_product_attention(const onnx_parser::node_info& info,
+                                             instruction_ref q,
+                                             instruction_ref k,
+                                             instruction_ref v,
+                                             float scale,
+                                             std::optional<instruction_ref> bias,
+                                             std::optional<instruction_ref> mask,
+                                             std::optional<float> mask_value = std::nullopt,
+                                             float softcap                   = 0);
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
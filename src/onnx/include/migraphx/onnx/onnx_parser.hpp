@@ -26,12 +26,14 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/filesystem.hpp>
+#include <migraphx/file_buffer.hpp>
 #include <migraphx/program.hpp>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <onnx.pb.h>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -108,6 +110,25 @@ struct onnx_parser
 
     std::unordered_map<std::string, op_func> ops;
 
+    // External data files are mapped once, on first access, and shared by the initializers
+    // stored in them
+    struct external_data_file
+    {
+        fs::path path;
+        std::size_t size = 0;
+        std::once_flag mapped;
+        mapped_buffer buffer;
+
+        const mapped_buffer& get()
+        {
+            std::call_once(mapped, [&] { buffer = map_buffer(path); });
+            return buffer;
+        }
+    };
+    mutable std::unordered_map<std::string, std::shared_ptr<external_data_file>>
+        external_data_files;
+    mutable std::mutex external_data_mutex;
+
     onnx_parser();
     operation load(const std::string& name, const node_info& info) const;
 
@@ -117,10 +138,14 @@ struct onnx_parser
 
     void parse_from(std::istream& is, std::string name = "");
     void parse_from(const void* data, std::size_t size);
+    // Parse a model file without decoding it as a single protobuf message, so models are not
+    // limited to 2GB and the weights are loaded lazily from the mapped file
+    void parse_from(const fs::path& file);
     std::vector<instruction_ref>
     parse_graph(module* mod, const onnx::GraphProto& graph, bool inlining = false);
     literal parse_value(const onnx::AttributeProto& attr) const;
     literal parse_tensor(const onnx::TensorProto& t) const;
+    std::shared_ptr<external_data_file> get_external_data(const fs::path& p) const;
     shape parse_type(const onnx::TypeProto& t) const;
     shape parse_type(const onnx::TypeProto& t, const std::vector<std::size_t>& input_dims) const;
 };
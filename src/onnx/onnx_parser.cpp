@@ -36,6 +36,7 @@
 #include <migraphx/op/unknown.hpp>
 #include <migraphx/float8.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/thread_pool.hpp>
 #include <onnx.pb.h>
 
 namespace migraphx {
@@ -329,13 +330,20 @@ std::unordered_map<std::string, instruction_ref>
 parse_intializer(const onnx_parser& parser, module* mod, const onnx::GraphProto& graph)
 {
     std::unordered_map<std::string, instruction_ref> mod_insts;
-    for(auto&& f : graph.initializer())
+    const auto& initializers = graph.initializer();
+    // Decode the tensors in parallel, each one is a task so idle threads pick up the remaining
+    // tensors when the sizes are uneven
+    std::vector<literal> literals(initializers.size());
+    get_thread_pool().run(literals.size(), [&](std::size_t i) {
+        literals[i] = parser.parse_tensor(initializers.Get(i));
+    });
+    for(auto i : range(initializers.size()))
     {
+        const auto& f = initializers.Get(i);
         if(enabled(MIGRAPHX_TRACE_ONNX_PARSER{}))
             std::cout << "initializer: " << f.name() << std::endl;
         // backup instructions in parent mod
-        auto pt  = parser.parse_tensor(f);
-        auto lit = mod->add_literal(pt);
+        auto lit = mod->add_literal(std::move(literals[i]));
 
         if(is_type_packed_int4(f))
             lit = mod->add_instruction(migraphx::make_op("unpack_int4"), lit);
@@ -520,10 +528,10 @@ static shape parse_tensor_shape(const onnx::TensorProto& t)
 
 literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
 {
-    auto tensor_shape  = parse_tensor_shape(t);
-    const auto& dims   = tensor_shape.lens();
-    auto type          = tensor_shape.type();
-    auto external_data = t.external_data();
+    auto tensor_shape         = parse_tensor_shape(t);
+    const auto& dims          = tensor_shape.lens();
+    auto type                 = tensor_shape.type();
+    const auto& external_data = t.external_data();
 
     if(not external_data.empty())
     {
@@ -540,17 +548,29 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
         {
             nbytes = std::stoull(t.external_data().at(2).value());
         }
-        std::vector<char> raw_buffer;
+        fs::path file = path / data_file;
         if(not external_data_path.empty())
-        {
-            raw_buffer = read_buffer(fs::path{external_data_path} / data_file, offset, nbytes);
-        }
-        else
-        {
-            raw_buffer = read_buffer(path / data_file, offset, nbytes);
-        }
-        std::string s(raw_buffer.begin(), raw_buffer.end());
-        return create_literal(type, dims, s.data());
+            file = fs::path{external_data_path} / data_file;
+        auto data_source = get_external_data(file);
+        if(offset + nbytes > data_source->size or
+           (tensor_shape.elements() > 0 and nbytes < tensor_shape.bytes()))
+            MIGRAPHX_THROW("PARSE_TENSOR: external data out of range for " + t.name());
+        if(tensor_shape.elements() == 0)
+            return literal{type};
+        if(dims.empty())
+            return create_literal(type, dims, data_source->get().data() + offset);
+        // The data is only read once the literal is accessed, so initializers that are folded
+        // or eliminated are never loaded
+        return literal{tensor_shape, [data_source, offset, tensor_shape] {
+                           const auto& buffer = data_source->get();
+                           const char* data   = buffer.data() + offset;
+                           // Elements must be aligned to be read in place, otherwise copy them
+                           if(offset % tensor_shape.type_size() != 0)
+                               return make_shared_array<char>(data, data + tensor_shape.bytes());
+                           return std::shared_ptr<char>(
+                               std::const_pointer_cast<char>(buffer.buffer),
+                               const_cast<char*>(data)); // NOLINT
+                       }};
     }
 
     if(t.has_raw_data())
@@ -591,6 +611,18 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
         return create_literal(shape::half_type, dims, data_half);
     }
 
+    case onnx::TensorProto::BFLOAT16: {
+        std::vector<migraphx::bf16> data_bf16;
+        std::transform(t.int32_data().begin(),
+                       t.int32_data().end(),
+                       std::back_inserter(data_bf16),
+                       [](int32_t raw_val) {
+                           return migraphx::bf16{static_cast<uint16_t>(raw_val),
+                                                 migraphx::bf16::from_bits()};
+                       });
+        return create_literal(shape::bf16_type, dims, data_bf16);
+    }
+
     case onnx::TensorProto::DOUBLE:
         return create_literal(shape::double_type, dims, t.double_data());
 
@@ -617,6 +649,24 @@ literal onnx_parser::parse_tensor(const onnx::TensorProto& t) const
     MIGRAPHX_THROW("PARSE_TENSOR: Invalid tensor type");
 }
 
+std::shared_ptr<onnx_parser::external_data_file>
+onnx_parser::get_external_data(const fs::path& p) const
+{
+    std::lock_guard<std::mutex> lock(external_data_mutex);
+    auto it = external_data_files.find(p.string());
+    if(it != external_data_files.end())
+        return it->second;
+    std::error_code ec;
+    auto size = fs::file_size(p, ec);
+    if(ec)
+        MIGRAPHX_THROW("PARSE_TENSOR: Failure opening external data file: " + p.string());
+    auto f  = std::make_shared<external_data_file>();
+    f->path = p;
+    f->size = size;
+    external_data_files.emplace(p.string(), f);
+    return f;
+}
+
 shape onnx_parser::parse_type(const onnx::TypeProto& t) const
 {
     shape::type_t shape_type = get_type(t.tensor_type().elem_type());
@@ -682,6 +732,7 @@ shape::type_t get_type(int dtype)
     case 11: return shape::double_type;
     case 12: return shape::uint32_type;
     case 13: return shape::uint64_type;
+    case 16: return shape::bf16_type;
     case 18: {
         std::cout << "[Warning] : MIGraphX has BETA support for FP8. Using FP8 may result in "
                      "incorrect final outputs\n";
@@ -691,7 +742,6 @@ shape::type_t get_type(int dtype)
     case 22: return shape::int8_type;
     case 14:
     case 15:
-    case 16:
     case 17:
     case 19:
     case 20:
@@ -704,7 +754,8 @@ shape::type_t get_type(int dtype)
 bool is_type_float(shape::type_t dtype)
 {
     bool r = false;
-    if(dtype == shape::float_type or dtype == shape::double_type or dtype == shape::half_type)
+    if(dtype == shape::float_type or dtype == shape::double_type or dtype == shape::half_type or
+       dtype == shape::bf16_type)
     {
         r = true;
     }
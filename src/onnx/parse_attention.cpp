@@ -0,0 +1,298 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/attention.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
+#include <cmath>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+// com.microsoft.MultiHeadAttention and com.microsoft.Attention
+// Both are parsed into the dot -> softmax -> dot attention form, with any masks folded into a
+// where before the softmax, so they reach the fused attention kernels.
+
+// MultiHeadAttention inputs
+// query, key, value, bias, key_padding_mask, attention_bias, past_key, past_value
+// query : (batch_size, sequence_length, hidden_size), or packed qkv as (batch_size,
+// sequence_length, num_heads, 3, head_size) without key and value
+// key, value : (batch_size, kv_sequence_length, hidden_size), (batch_size, num_heads,
+// kv_sequence_length, head_size), or packed kv as a key of (batch_size, kv_sequence_length,
+// num_heads, 2, head_size) without value
+// bias : (q_hidden_size + k_hidden_size + v_hidden_size) added to the projected inputs
+// past_key, past_value : (batch_size, num_heads, past_sequence_length, head_size)
+
+// Attention inputs
+// input, weights, bias, mask_index, past, attention_bias
+// weights : (input_hidden_size, q_hidden_size + k_hidden_size + v_hidden_size)
+// past : (2, batch_size, num_heads, past_sequence_length, head_size)
+
+// key_padding_mask and mask_index are either the valid key lengths of each batch
+// (batch_size), or (batch_size, total_sequence_length) and (batch_size, sequence_length,
+// total_sequence_length) with 1 for the keys to attend to.
+// attention_bias : broadcastable to (batch_size, num_heads, sequence_length,
+// total_sequence_length)
+
+struct parse_attention : op_parser<parse_attention>
+{
+    std::vector<op_desc> operators() const { return {{"Attention"}, {"MultiHeadAttention"}}; }
+
+    static bool has_input(const std::vector<instruction_ref>& args, std::size_t i)
+    {
+        return args.size() > i and not args[i]->is_undefined();
+    }
+
+    static instruction_ref slice_last(const onnx_parser::node_info& info,
+                                      instruction_ref ins,
+                                      std::size_t start,
+                                      std::size_t end)
+    {
+        auto axis = ins->get_shape().ndim() - 1;
+        return info.add_instruction(
+            make_op("slice", {{"axes", {axis}}, {"starts", {start}}, {"ends", {end}}}), ins);
+    }
+
+    // Unpacks (batch_size, sequence_length, num_heads, n, head_size) into n tensors of
+    // (batch_size, num_heads, sequence_length, head_size)
+    static std::vector<instruction_ref> unpack_heads(const onnx_parser::node_info& info,
+                                                     instruction_ref ins)
+    {
+        std::vector<instruction_ref> result;
+        for(std::size_t i = 0; i < ins->get_shape().lens()[3]; ++i)
+        {
+            auto x = info.add_instruction(
+                make_op("slice", {{"axes", {3}}, {"starts", {i}}, {"ends", {i + 1}}}), ins);
+            x = info.add_instruction(make_op("squeeze", {{"axes", {3}}}), x);
+            result.push_back(
+                info.add_instruction(make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), x));
+        }
+        return result;
+    }
+
+    // Boolean mask broadcastable to (batch_size, num_heads, sequence_length,
+    // total_sequence_length)
+    static instruction_ref
+    padding_mask(const onnx_parser::node_info& info, instruction_ref mask, std::size_t t)
+    {
+        auto lens = mask->get_shape().lens();
+        if(lens.size() == 1)
+        {
+            std::vector<int64_t> range(t);
+            std::iota(range.begin(), range.end(), 0);
+            auto r   = info.add_literal(literal{shape{mask->get_shape().type(), {1, t}}, range});
+            auto len = info.add_instruction(make_op("reshape", {{"dims", {lens[0], 1}}}), mask);
+            mask     = info.add_common_op("less", r, len);
+            return info.add_instruction(make_op("reshape", {{"dims", {lens[0], 1, 1, t}}}), mask);
+        }
+        if(lens.size() != 2 and lens.size() != 3)
+            MIGRAPHX_THROW("Attention: unsupported mask shape " + to_string_range(lens));
+        if(lens.back() != t)
+            MIGRAPHX_THROW("Attention: mask does not match the total sequence length");
+        mask = info.add_instruction(make_op("convert", {{"target_type", shape::bool_type}}), mask);
+        auto s = lens.size() == 3 ? lens[1] : 1;
+        return info.add_instruction(make_op("reshape", {{"dims", {lens[0], 1, s, t}}}), mask);
+    }
+
+    // Query i, at position i + t - s of the total sequence, only attends to keys up to itself
+    static instruction_ref
+    causal_mask(const onnx_parser::node_info& info, std::size_t s, std::size_t t)
+    {
+        std::vector<char> data(s * t);
+        for(std::size_t i = 0; i < s; ++i)
+        {
+            for(std::size_t j = 0; j < t; ++j)
+                data[i * t + j] = j <= i + t - s;
+        }
+        return info.add_literal(literal{shape{shape::bool_type, {s, t}}, data});
+    }
+
+    std::vector<instruction_ref> parse(const op_desc& opd,
+                                       const onnx_parser& /*parser*/,
+                                       const onnx_parser::node_info& info,
+                                       std::vector<instruction_ref> args) const
+    {
+        if(not contains(info.attributes, "num_heads"))
+            MIGRAPHX_THROW(opd.onnx_name + ": num_heads attribute is required");
+        std::size_t num_heads = info.attributes.at("num_heads").i();
+        float scale           = 0;
+        bool unidirectional   = false;
+        float mask_value      = -10000.0f;
+        if(contains(info.attributes, "scale"))
+            scale = info.attributes.at("scale").f();
+        if(contains(info.attributes, "unidirectional"))
+            unidirectional = info.attributes.at("unidirectional").i() != 0;
+        if(contains(info.attributes, "mask_filter_value"))
+            mask_value = info.attributes.at("mask_filter_value").f();
+
+        instruction_ref q;
+        instruction_ref k;
+        instruction_ref v;
+        std::optional<instruction_ref> mask;
+        std::optional<instruction_ref> attn_bias;
+        std::optional<instruction_ref> past_k;
+        std::optional<instruction_ref> past_v;
+        bool is_mha = opd.onnx_name == "MultiHeadAttention";
+        if(is_mha)
+        {
+            auto query = args.at(0);
+            if(query->get_shape().ndim() == 5)
+            {
+                if(has_input(args, 3))
+                    MIGRAPHX_THROW(opd.onnx_name + ": bias with packed qkv is not supported");
+                auto qkv = unpack_heads(info, query);
+                q        = qkv[0];
+                k        = qkv[1];
+                v        = qkv[2];
+            }
+            else
+            {
+                auto key    = args.at(1);
+                auto q_size = query->get_shape().lens().back();
+                if(has_input(args, 3))
+                    query = info.add_common_op("add", query, slice_last(info, args[3], 0, q_size));
+                q = split_heads(info, query, num_heads);
+                if(key->get_shape().ndim() == 5)
+                {
+                    auto kv = unpack_heads(info, key);
+                    k       = kv[0];
+                    v       = kv[1];
+                }
+                else if(key->get_shape().ndim() == 4)
+                {
+                    k = key;
+                    v = args.at(2);
+                }
+                else
+                {
+                    auto value  = args.at(2);
+                    auto k_size = key->get_shape().lens().back();
+                    auto v_size = value->get_shape().lens().back();
+                    if(has_input(args, 3))
+                    {
+                        auto kb = slice_last(info, args[3], q_size, q_size + k_size);
+                        auto vb = slice_last(
+                            info, args[3], q_size + k_size, q_size + k_size + v_size);
+                        key     = info.add_common_op("add", key, kb);
+                        value   = info.add_common_op("add", value, vb);
+                    }
+                    k = split_heads(info, key, num_heads);
+                    v = split_heads(info, value, num_heads);
+                }
+            }
+            if(has_input(args, 4))
+                mask = args[4];
+            if(has_input(args, 5))
+                attn_bias = args[5];
+            if(has_input(args, 6) and has_input(args, 7))
+            {
+                past_k = args[6];
+                past_v = args[7];
+            }
+        }
+        else
+        {
+            auto input   = args.at(0);
+            auto weights = args.at(1);
+            auto lens    = input->get_shape().lens();
+            auto w_lens  = weights->get_shape().lens();
+            if(lens.size() != 3 or w_lens.size() != 2)
+                MIGRAPHX_THROW(opd.onnx_name + ": input must be 3D and weights 2D");
+            std::vector<std::size_t> sizes(3, w_lens[1] / 3);
+            if(contains(info.attributes, "qkv_hidden_sizes"))
+            {
+                auto&& attr = info.attributes.at("qkv_hidden_sizes").ints();
+                sizes.assign(attr.begin(), attr.end());
+            }
+            if(sizes.size() != 3 or std::accumulate(sizes.begin(), sizes.end(), 0ul) != w_lens[1])
+                MIGRAPHX_THROW(opd.onnx_name + ": invalid qkv_hidden_sizes");
+            if(contains(info.attributes, "do_rotary") and
+               info.attributes.at("do_rotary").i() != 0)
+                MIGRAPHX_THROW(opd.onnx_name + ": do_rotary is not supported");
+
+            weights = info.add_instruction(
+                make_op("multibroadcast", {{"out_lens", {lens[0], w_lens[0], w_lens[1]}}}),
+                weights);
+            auto qkv = info.add_instruction(make_op("dot"), input, weights);
+            if(has_input(args, 2))
+                qkv = info.add_common_op("add", qkv, args[2]);
+            q = split_heads(info, slice_last(info, qkv, 0, sizes[0]), num_heads);
+            k = split_heads(info, slice_last(info, qkv, sizes[0], sizes[0] + sizes[1]), num_heads);
+            v = split_heads(info, slice_last(info, qkv, sizes[0] + sizes[1], w_lens[1]), num_heads);
+            if(has_input(args, 3))
+                mask = args[3];
+            if(has_input(args, 4))
+            {
+                auto past = args[4];
+                auto take = [&](std::size_t i) {
+                    auto x = info.add_instruction(
+                        make_op("slice", {{"axes", {0}}, {"starts", {i}}, {"ends", {i + 1}}}),
+                        past);
+                    return info.add_instruction(make_op("squeeze", {{"axes", {0}}}), x);
+                };
+                past_k = take(0);
+                past_v = take(1);
+            }
+            if(has_input(args, 5))
+                attn_bias = args[5];
+        }
+
+        if(past_k.has_value())
+        {
+            k = info.add_instruction(make_op("concat", {{"axis", 2}}), *past_k, k);
+            v = info.add_instruction(make_op("concat", {{"axis", 2}}), *past_v, v);
+        }
+
+        auto s = q->get_shape().lens()[2];
+        auto t = k->get_shape().lens()[2];
+        if(mask.has_value())
+            mask = padding_mask(info, *mask, t);
+        if(unidirectional)
+        {
+            auto causal = causal_mask(info, s, t);
+            if(mask.has_value())
+                causal = info.add_common_op("logical_and", *mask, causal);
+            mask = causal;
+        }
+        if(scale == 0)
+            scale = 1.0f / std::sqrt(static_cast<float>(q->get_shape().lens().back()));
+
+        auto out = scaled_dot_product_attention(info, q, k, v, scale, attn_bias, mask, mask_value);
+        out      = merge_heads(info, out);
+        if(is_mha)
+            return {out, k, v};
+        auto present_k = info.add_instruction(make_op("unsqueeze", {{"axes", {0}}}), k);
+        auto present_v = info.add_instruction(make_op("unsqueeze", {{"axes", {0}}}), v);
+        return {out,
+                info.add_instruction(make_op("concat", {{"axis", 0}}), present_k, present_v)};
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
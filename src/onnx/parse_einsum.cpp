@@ -32,6 +32,9 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/lexing.hpp>
 #include <migraphx/onnx/op_parser.hpp>
+#include <functional>
+#include <optional>
+#include <tuple>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -51,6 +54,9 @@ struct parse_einsum : op_parser<parse_einsum>
         size_t ellipsis_ndim = 0;
     };
 
+    // Most operands that the contraction order is searched exhaustively for
+    static constexpr size_t max_optimal_operands = 8;
+
     std::vector<op_desc> operators() const { return {{"Einsum"}}; }
 
     instruction_ref parse(const op_desc&,
@@ -68,31 +74,38 @@ struct parse_einsum : op_parser<parse_einsum>
         terms.push_back(eq_info.output_term);
         const auto map_mat = make_mapping_matrix(terms, eq_info.label_count, eq_info.ellipsis_ndim);
 
-        // Holds the mapping matrix representations of the two terms being processed
-        // cur_pair[0] acts as the accumulator for previously processed inputs
-        // cur_pair[1] holds the representation for the current input
-        // As operations are added to the einsum graph, cur_pair gets manipulated
-        int_mat cur_pair = make_matrix(2, map_mat[0].size(), -1);
-
-        instruction_ref cur_op;
-        std::optional<instruction_ref> last_op;
-        // Perform a left fold on the inputs
+        // rows[i] maps each label to its axis in ops[i], or is -1 when ops[i] does not have the
+        // label. After preprocessing, the inputs have an axis for every label in the equation.
+        std::vector<instruction_ref> ops;
+        int_mat rows;
         for(auto arg_idx = 0; arg_idx < args.size(); ++arg_idx)
         {
-            cur_op      = args[arg_idx];
-            cur_pair[1] = map_mat[arg_idx];
+            std::vector<bool> others(args.size(), true);
+            others[arg_idx] = false;
+            auto needed     = needed_labels(map_mat, map_mat.back(), others);
 
-            cur_op = preprocess_input(
-                info, cur_op, eq_info.duplicates[arg_idx], map_mat, arg_idx, cur_pair);
-
-            if(last_op)
-                cur_op = process_pair(info, *last_op, cur_op, map_mat, arg_idx, cur_pair);
+            rows.push_back(map_mat[arg_idx]);
+            ops.push_back(preprocess_input(
+                info, args[arg_idx], eq_info.duplicates[arg_idx], needed, rows.back()));
+        }
 
-            last_op     = cur_op;
-            cur_pair[0] = cur_pair[1];
+        // Contract the operands in pairs, the result of each contraction is added as a new
+        // operand
+        std::vector<bool> alive(ops.size(), true);
+        for(auto [i, j] : plan_contractions(rows, map_mat.back(), label_lens(map_mat, args)))
+        {
+            alive[i]    = false;
+            alive[j]    = false;
+            auto needed = needed_labels(rows, map_mat.back(), alive);
+
+            int_mat cur_pair{rows[i], rows[j]};
+            ops.push_back(process_pair(info, ops[i], ops[j], needed, cur_pair));
+            rows.push_back(cur_pair[1]);
+            alive.push_back(true);
         }
 
-        return finalize_output(info, cur_op, map_mat, cur_pair);
+        int_mat cur_pair{rows.back(), rows.back()};
+        return finalize_output(info, ops.back(), map_mat, cur_pair);
     }
 
     // Equation Parsing
@@ -344,14 +357,227 @@ struct parse_einsum : op_parser<parse_einsum>
         return duplicates;
     }
 
+    // Contraction Planning
+
+    // Marks the labels that are present in the output or in any of the included rows
+    std::vector<bool> needed_labels(const int_mat& rows,
+                                    const std::vector<int>& output,
+                                    const std::vector<bool>& include) const
+    {
+        std::vector<bool> ret(output.size());
+        std::transform(
+            output.begin(), output.end(), ret.begin(), [](auto i) { return i != -1; });
+        for(auto i = 0; i < include.size(); ++i)
+        {
+            if(not include[i])
+                continue;
+            for(auto d = 0; d < ret.size(); ++d)
+                ret[d] = ret[d] or rows[i][d] != -1;
+        }
+
+        return ret;
+    }
+
+    // The dimension of each label, which is the largest one for broadcasted labels
+    std::vector<double> label_lens(const int_mat& map_mat,
+                                   const std::vector<instruction_ref>& args) const
+    {
+        std::vector<double> ret(map_mat[0].size(), 1);
+        for(auto i = 0; i < args.size(); ++i)
+        {
+            const auto& lens = args[i]->get_shape().lens();
+            for(auto d = 0; d < ret.size(); ++d)
+            {
+                if(map_mat[i][d] != -1)
+                    ret[d] = std::max<double>(ret[d], lens[map_mat[i][d]]);
+            }
+        }
+
+        return ret;
+    }
+
+    // Picks the order in which the operands are contracted in pairs. Operands are numbered in
+    // order of creation: the inputs first, then the result of each contraction. The order
+    // minimizes the flops and then the total size of the intermediate results. All orders are
+    // searched when there are few operands, otherwise the cheapest pair is picked greedily.
+    std::vector<std::pair<size_t, size_t>> plan_contractions(const int_mat& rows,
+                                                             const std::vector<int>& output,
+                                                             const std::vector<double>& lens) const
+    {
+        const auto n = rows.size();
+        std::vector<std::pair<size_t, size_t>> path;
+        if(n < 2)
+            return path;
+
+        auto size_of = [&](const std::vector<bool>& labels) {
+            double ret = 1;
+            for(auto d = 0; d < labels.size(); ++d)
+            {
+                if(labels[d])
+                    ret *= lens[d];
+            }
+            return ret;
+        };
+        auto union_of = [](std::vector<bool> lhs, const std::vector<bool>& rhs) {
+            std::transform(
+                lhs.begin(), lhs.end(), rhs.begin(), lhs.begin(), std::logical_or<>{});
+            return lhs;
+        };
+        // Labels of the result of contracting the operands in the group, which drops the labels
+        // that are not needed outside of the group
+        const std::vector<int> no_output(output.size(), -1);
+        auto result_labels = [&](const std::vector<bool>& group) {
+            std::vector<bool> outside(n);
+            std::transform(group.begin(), group.end(), outside.begin(), std::logical_not<>{});
+            std::vector<bool> inside = needed_labels(rows, no_output, group);
+            std::vector<bool> ret    = needed_labels(rows, output, outside);
+            std::transform(
+                ret.begin(), ret.end(), inside.begin(), ret.begin(), std::logical_and<>{});
+            return ret;
+        };
+
+        if(n <= max_optimal_operands)
+            plan_optimal(n, size_of, union_of, result_labels, path);
+        else
+            plan_greedy(n, size_of, union_of, result_labels, path);
+        return path;
+    }
+
+    struct contraction_cost
+    {
+        double flops = 0;
+        double size  = 0;
+
+        friend bool operator<(const contraction_cost& x, const contraction_cost& y)
+        {
+            return std::tie(x.flops, x.size) < std::tie(y.flops, y.size);
+        }
+    };
+
+    // Searches every contraction tree, with dynamic programming over the subsets of operands
+    template <class SizeOf, class UnionOf, class ResultLabels>
+    void plan_optimal(size_t n,
+                      SizeOf size_of,
+                      UnionOf union_of,
+                      ResultLabels result_labels,
+                      std::vector<std::pair<size_t, size_t>>& path) const
+    {
+        const size_t nsets = size_t{1} << n;
+        auto group_of      = [&](size_t set) {
+            std::vector<bool> ret(n);
+            for(auto i = 0; i < n; ++i)
+                ret[i] = ((set >> i) & 1u) != 0;
+            return ret;
+        };
+
+        std::vector<std::vector<bool>> labels(nsets);
+        std::vector<contraction_cost> best(nsets);
+        std::vector<size_t> split(nsets, 0);
+        for(size_t set = 1; set < nsets; ++set)
+        {
+            labels[set] = result_labels(group_of(set));
+            // Single operands cost nothing
+            if((set & (set - 1)) == 0)
+                continue;
+            const size_t lowest = set & (~set + 1);
+            std::optional<contraction_cost> cost;
+            // Each split of set into two groups is visited once, with the lowest operand in
+            // the left group
+            for(size_t left = (set - 1) & set; left > 0; left = (left - 1) & set)
+            {
+                if((left & lowest) == 0)
+                    continue;
+                const size_t right = set ^ left;
+                contraction_cost c;
+                c.flops = best[left].flops + best[right].flops +
+                          size_of(union_of(labels[left], labels[right]));
+                c.size = best[left].size + best[right].size + size_of(labels[set]);
+                if(not cost.has_value() or c < *cost)
+                {
+                    cost       = c;
+                    split[set] = left;
+                }
+            }
+            best[set] = *cost;
+        }
+
+        // Emit the contractions of the best tree in post order
+        fix<size_t>([&](auto self, size_t set) -> size_t {
+            if((set & (set - 1)) == 0)
+            {
+                size_t i = 0;
+                while(((set >> i) & 1u) == 0)
+                    ++i;
+                return i;
+            }
+            auto left  = self(split[set]);
+            auto right = self(set ^ split[set]);
+            path.emplace_back(left, right);
+            return n + path.size() - 1;
+        })(nsets - 1);
+    }
+
+    // Repeatedly contracts the pair that shrinks the operands the most, breaking ties by flops
+    template <class SizeOf, class UnionOf, class ResultLabels>
+    void plan_greedy(size_t n,
+                     SizeOf size_of,
+                     UnionOf union_of,
+                     ResultLabels result_labels,
+                     std::vector<std::pair<size_t, size_t>>& path) const
+    {
+        // Each operand is the group of inputs that it was contracted from
+        std::vector<std::vector<bool>> groups;
+        std::vector<std::vector<bool>> labels;
+        std::vector<size_t> alive;
+        for(auto i = 0; i < n; ++i)
+        {
+            std::vector<bool> group(n, false);
+            group[i] = true;
+            groups.push_back(group);
+            labels.push_back(result_labels(group));
+            alive.push_back(i);
+        }
+
+        while(alive.size() > 1)
+        {
+            std::pair<size_t, size_t> pick;
+            std::optional<std::pair<double, double>> pick_cost;
+            for(auto x = 0; x < alive.size(); ++x)
+            {
+                for(auto y = x + 1; y < alive.size(); ++y)
+                {
+                    auto i      = alive[x];
+                    auto j      = alive[y];
+                    auto result = result_labels(union_of(groups[i], groups[j]));
+                    std::pair<double, double> cost{
+                        size_of(result) - size_of(labels[i]) - size_of(labels[j]),
+                        size_of(union_of(labels[i], labels[j]))};
+                    if(not pick_cost.has_value() or cost < *pick_cost)
+                    {
+                        pick      = {x, y};
+                        pick_cost = cost;
+                    }
+                }
+            }
+
+            auto i = alive[pick.first];
+            auto j = alive[pick.second];
+            path.emplace_back(i, j);
+            groups.push_back(union_of(groups[i], groups[j]));
+            labels.push_back(result_labels(groups.back()));
+            alive.erase(alive.begin() + pick.second);
+            alive.erase(alive.begin() + pick.first);
+            alive.push_back(groups.size() - 1);
+        }
+    }
+
     // Graph Building
 
     instruction_ref preprocess_input(const onnx_parser::node_info& info,
                                      instruction_ref op,
                                      const std::map<char, std::vector<int>>& duplicates,
-                                     const int_mat& map_mat,
-                                     size_t input_idx,
-                                     int_mat& cur_pair) const
+                                     const std::vector<bool>& needed,
+                                     std::vector<int>& row) const
     {
         if(not duplicates.empty())
         {
@@ -362,29 +588,27 @@ struct parse_einsum : op_parser<parse_einsum>
                            std::back_inserter(diag),
                            [](const auto& d) { return d.second; });
 
-            op = gather_diagonal(info, cur_pair, op, diag);
+            op = gather_diagonal(info, row, op, diag);
         }
 
         // Unsqueeze the input shape in the dimensions marked as -1 in the mapping_matrix
         // Transpose the input shape so the labels are in alphabetical order
-        op = transpose_unsqueeze(info, cur_pair, op);
+        op = transpose_unsqueeze(info, row, op);
 
         std::vector<int> red;
-        // Check if a given label appears in any of the subsequent mapping matrix terms(this
-        // includes the output). If does not, it is reduced and marked as -1 in cur_pair.
-        for(int d = 0; d < map_mat[0].size(); ++d)
+        // Labels that are not in any of the other terms (this includes the output) are reduced
+        // and marked as -1 in row
+        for(int d = 0; d < row.size(); ++d)
         {
-            bool all_neg_one = all_of(extract_column(map_mat, d, input_idx + 1, map_mat.size()),
-                                      [](auto i) { return i == -1; });
-            if(all_neg_one and cur_pair[1][d] != -1 and cur_pair[0][d] == -1)
+            if(row[d] != -1 and not needed[d])
                 red.push_back(d);
         }
 
-        return apply_reduce_sum_op(info, op, red, cur_pair[1]);
+        return apply_reduce_sum_op(info, op, red, row);
     }
 
     instruction_ref gather_diagonal(const onnx_parser::node_info& info,
-                                    int_mat& cur_pair,
+                                    std::vector<int>& row,
                                     instruction_ref op,
                                     const int_mat& diag) const
     {
@@ -430,17 +654,12 @@ struct parse_einsum : op_parser<parse_einsum>
 
         // compute output row
         std::replace_if(
-            cur_pair[1].begin(),
-            cur_pair[1].end(),
-            [&](auto r) { return contains(axes, r); },
-            first_axis);
+            row.begin(), row.end(), [&](auto r) { return contains(axes, r); }, first_axis);
 
         for(auto t : range(axes.begin() + 1, axes.end()))
         {
-            std::transform(cur_pair[1].begin(),
-                           cur_pair[1].end(),
-                           cur_pair[1].begin(),
-                           [t](auto r) { return r > t ? r - 1 : r; });
+            std::transform(
+                row.begin(), row.end(), row.begin(), [t](auto r) { return r > t ? r - 1 : r; });
         }
 
         return op;
@@ -449,28 +668,27 @@ struct parse_einsum : op_parser<parse_einsum>
     instruction_ref process_pair(const onnx_parser::node_info& info,
                                  instruction_ref op1,
                                  instruction_ref op2,
-                                 const int_mat& map_mat,
-                                 size_t input_idx,
+                                 const std::vector<bool>& needed,
                                  int_mat& cur_pair) const
     {
-        // Label is present in current two terms and somewhere in subsequent terms
+        // Label is present in current two terms and in the remaining terms
         std::vector<int> batch_axes;
         // Label is present in only left term
         std::vector<int> left_only;
         // Label is present in only right term
         std::vector<int> right_only;
-        // Label is present in current two terms, but not in the subsequent terms
+        // Label is present in current two terms, but not in the remaining terms
         std::vector<int> sum_axes;
 
         auto not_neg_one = [](auto i) { return i != -1; };
         // Categorize axes according to label distribution in equation
-        for(int d = 0; d < map_mat[0].size(); ++d)
+        for(int d = 0; d < needed.size(); ++d)
         {
             // The label is present in both terms of cur_pair
             if(all_of(extract_column(cur_pair, d, 0, cur_pair.size()), not_neg_one))
             {
-                // The label is present in at least one of the subsequent terms
-                if(any_of(extract_column(map_mat, d, input_idx + 1, map_mat.size()), not_neg_one))
+                // The label is present in at least one of the remaining terms
+                if(needed[d])
                     batch_axes.push_back(d);
                 else
                     sum_axes.push_back(d);
@@ -571,20 +789,20 @@ struct parse_einsum : op_parser<parse_einsum>
     // Permutes the labels so they are in alphabetical order and expands the input dimensions to
     // match the number of unique labels in the entire equation.
     instruction_ref transpose_unsqueeze(const onnx_parser::node_info& info,
-                                        int_mat& cur_pair,
+                                        std::vector<int>& row,
                                         instruction_ref op) const
     {
         std::vector<int> perm;
         std::vector<int> unsq_axes;
 
-        for(auto i = 0; i < cur_pair[1].size(); ++i)
+        for(auto i = 0; i < row.size(); ++i)
         {
-            if(cur_pair[1][i] == -1)
+            if(row[i] == -1)
                 // unsqueeze the dimensions corresponding to the missing labels
                 unsq_axes.push_back(i);
             else
                 // permute the rest
-                perm.push_back(cur_pair[1][i]);
+                perm.push_back(row[i]);
         }
 
         std::vector<int64_t> perm64(perm.begin(), perm.end());
@@ -595,7 +813,7 @@ struct parse_einsum : op_parser<parse_einsum>
         {
             perm.insert(perm.begin() + axis, -1);
         }
-        cur_pair[1] = perm;
+        row = perm;
 
         return info.add_instruction(make_op("unsqueeze", {{"axes", unsq_axes}}), op);
     }
@@ -0,0 +1,244 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/attention.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
+#include <cmath>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+// com.microsoft.GroupQueryAttention
+// Causal attention where groups of query heads share a key and value head. The kv heads are
+// broadcast to the query heads, and the op is parsed into the dot -> softmax -> dot attention
+// form so it reaches the fused attention kernels.
+
+// Inputs
+// query, key, value, past_key, past_value, seqlens_k, total_sequence_length, cos_cache,
+// sin_cache
+// query : (batch_size, sequence_length, num_heads * head_size), or packed qkv as (batch_size,
+// sequence_length, (num_heads + 2 * kv_num_heads) * head_size) without key and value
+// key, value : (batch_size, sequence_length, kv_num_heads * head_size)
+// past_key, past_value : (batch_size, kv_num_heads, past_sequence_length, head_size)
+// seqlens_k : (batch_size) total sequence length of each batch minus one
+// cos_cache, sin_cache : (max_sequence_length, rotary_dim / 2), used with do_rotary
+
+// The new keys and values are appended after the past ones, so present_key and present_value
+// are (batch_size, kv_num_heads, past_sequence_length + sequence_length, head_size). Past
+// entries beyond the length given by seqlens_k are masked out, which keeps the attention
+// correct for batches that use less of the past buffer than others.
+
+struct parse_group_query_attention : op_parser<parse_group_query_attention>
+{
+    std::vector<op_desc> operators() const { return {{"GroupQueryAttention"}}; }
+
+    static bool has_input(const std::vector<instruction_ref>& args, std::size_t i)
+    {
+        return args.size() > i and not args[i]->is_undefined();
+    }
+
+    static instruction_ref iota(const onnx_parser::node_info& info,
+                                std::size_t n,
+                                const std::vector<std::size_t>& lens,
+                                int64_t start = 0)
+    {
+        std::vector<int32_t> range(n);
+        std::iota(range.begin(), range.end(), start);
+        return info.add_literal(literal{shape{shape::int32_type, lens}, range});
+    }
+
+    // Rotates (batch_size, sequence_length, heads, head_size) by the positions in pos
+    static instruction_ref rotate(const onnx_parser::node_info& info,
+                                  instruction_ref x,
+                                  instruction_ref cos,
+                                  instruction_ref sin,
+                                  instruction_ref pos,
+                                  bool interleaved)
+    {
+        auto lens = x->get_shape().lens();
+        if(cos->get_shape().lens().back() * 2 != lens.back())
+            MIGRAPHX_THROW("GroupQueryAttention: rotary dimension must match the head size");
+        auto bc = make_op("multibroadcast", {{"out_lens", lens}});
+        auto table = [&](instruction_ref t) {
+            t = info.add_instruction(make_op("gather", {{"axis", 0}}), t, pos);
+            t = expand_rotary_table(info, t, interleaved);
+            t = info.add_instruction(make_op("unsqueeze", {{"axes", {2}}}), t);
+            return info.add_instruction(bc, t);
+        };
+        return info.add_instruction(make_op("rotary_embedding", {{"interleaved", interleaved}}),
+                                    x,
+                                    table(cos),
+                                    table(sin));
+    }
+
+    std::vector<instruction_ref> parse(const op_desc& opd,
+                                       const onnx_parser& /*parser*/,
+                                       const onnx_parser::node_info& info,
+                                       std::vector<instruction_ref> args) const
+    {
+        auto get_int = [&](const std::string& name, int64_t def) {
+            return contains(info.attributes, name) ? info.attributes.at(name).i() : def;
+        };
+        std::size_t num_heads    = get_int("num_heads", 0);
+        std::size_t kv_num_heads = get_int("kv_num_heads", 0);
+        int64_t local_window     = get_int("local_window_size", -1);
+        bool do_rotary           = get_int("do_rotary", 0) != 0;
+        bool interleaved         = get_int("rotary_interleaved", 0) != 0;
+        float scale              = 0;
+        float softcap            = 0;
+        if(contains(info.attributes, "scale"))
+            scale = info.attributes.at("scale").f();
+        if(contains(info.attributes, "softcap"))
+            softcap = info.attributes.at("softcap").f();
+        if(num_heads == 0 or kv_num_heads == 0 or num_heads % kv_num_heads != 0)
+            MIGRAPHX_THROW(opd.onnx_name + ": num_heads must be a multiple of kv_num_heads");
+
+        auto query = args.at(0);
+        auto lens  = query->get_shape().lens();
+        if(lens.size() != 3)
+            MIGRAPHX_THROW(opd.onnx_name + ": query must be 3D");
+        auto batch = lens[0];
+        auto s     = lens[1];
+        instruction_ref q;
+        instruction_ref k;
+        instruction_ref v;
+        if(has_input(args, 1))
+        {
+            q = query;
+            k = args.at(1);
+            v = args.at(2);
+        }
+        else
+        {
+            auto head_size = lens[2] / (num_heads + 2 * kv_num_heads);
+            auto q_size    = num_heads * head_size;
+            auto kv_size   = kv_num_heads * head_size;
+            auto part      = [&](std::size_t start, std::size_t end) {
+                return info.add_instruction(
+                    make_op("slice", {{"axes", {2}}, {"starts", {start}}, {"ends", {end}}}),
+                    query);
+            };
+            q = part(0, q_size);
+            k = part(q_size, q_size + kv_size);
+            v = part(q_size + kv_size, q_size + 2 * kv_size);
+        }
+        auto head_size = q->get_shape().lens()[2] / num_heads;
+        auto to_heads  = [&](instruction_ref x, std::size_t heads) {
+            return info.add_instruction(
+                make_op("reshape", {{"dims", {batch, s, heads, head_size}}}), x);
+        };
+        q = to_heads(q, num_heads);
+        k = to_heads(k, kv_num_heads);
+        v = to_heads(v, kv_num_heads);
+
+        std::size_t past_len = 0;
+        if(has_input(args, 3))
+            past_len = args[3]->get_shape().lens()[2];
+        auto t = past_len + s;
+
+        auto int_lit = [&](int64_t x) {
+            return info.add_literal(literal{shape{shape::int32_type}, {x}});
+        };
+        auto to_int = make_op("convert", {{"target_type", shape::int32_type}});
+
+        // Number of valid past entries of each batch, as (batch_size, 1)
+        instruction_ref valid_past;
+        if(has_input(args, 5))
+        {
+            auto seqlens = info.add_instruction(to_int, args[5]);
+            seqlens = info.add_instruction(make_op("reshape", {{"dims", {batch, 1}}}), seqlens);
+            valid_past = info.add_common_op("add", seqlens, int_lit(1 - int64_t(s)));
+        }
+        else
+        {
+            valid_past = info.add_instruction(make_op("multibroadcast", {{"out_lens", {batch, 1}}}),
+                                              int_lit(past_len));
+        }
+        // Position of each query in the total sequence, as (batch_size, sequence_length)
+        auto q_pos = info.add_common_op("add", valid_past, iota(info, s, {1, s}));
+
+        if(do_rotary)
+        {
+            if(not has_input(args, 7) or not has_input(args, 8))
+                MIGRAPHX_THROW(opd.onnx_name + ": do_rotary requires cos_cache and sin_cache");
+            q = rotate(info, q, args[7], args[8], q_pos, interleaved);
+            k = rotate(info, k, args[7], args[8], q_pos, interleaved);
+        }
+
+        auto to_bnsh = make_op("transpose", {{"permutation", {0, 2, 1, 3}}});
+        q            = info.add_instruction(to_bnsh, q);
+        k            = info.add_instruction(to_bnsh, k);
+        v            = info.add_instruction(to_bnsh, v);
+        if(past_len > 0)
+        {
+            k = info.add_instruction(make_op("concat", {{"axis", 2}}), args[3], k);
+            v = info.add_instruction(make_op("concat", {{"axis", 2}}), args.at(4), v);
+        }
+
+        // Position of each key in the total sequence, where the new keys follow the valid
+        // part of the past, as (batch_size, 1, total_sequence_length)
+        auto j      = iota(info, t, {1, 1, t});
+        auto is_new = info.add_common_op("greater", j, int_lit(int64_t(past_len) - 1));
+        auto vp     = info.add_instruction(make_op("unsqueeze", {{"axes", {2}}}), valid_past);
+        auto shift  = info.add_common_op("sub", vp, int_lit(past_len));
+        shift       = info.add_common_op("mul", shift, info.add_instruction(to_int, is_new));
+        auto k_pos  = info.add_common_op("add", j, shift);
+
+        // Queries attend to the valid past and to the new keys up to themselves
+        auto qp      = info.add_instruction(make_op("unsqueeze", {{"axes", {2}}}), q_pos);
+        auto future  = info.add_common_op("greater", k_pos, qp);
+        auto in_past = info.add_common_op("less", j, vp);
+        auto valid   = info.add_common_op("logical_or", is_new, in_past);
+        auto mask    = info.add_common_op(
+            "logical_and", info.add_instruction(make_op("not"), future), valid);
+        if(local_window > 0)
+        {
+            auto dist   = info.add_common_op("sub", qp, k_pos);
+            auto inside = info.add_common_op("less", dist, int_lit(local_window));
+            mask        = info.add_common_op("logical_and", mask, inside);
+        }
+        mask = info.add_instruction(make_op("unsqueeze", {{"axes", {1}}}), mask);
+
+        if(scale == 0)
+            scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+        auto out = scaled_dot_product_attention(info,
+                                                q,
+                                                repeat_kv_heads(info, k, num_heads),
+                                                repeat_kv_heads(info, v, num_heads),
+                                                scale,
+                                                std::nullopt,
+                                                mask,
+                                                std::nullopt,
+                                                softcap);
+        return {merge_heads(info, out), k, v};
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/quantize_dequantize_linear.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/literal.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+/*
+ * MatMulNBits (com.microsoft) multiplies A by weights that are quantized block-wise along K.
+ * B holds the packed weights as [N, k_blocks, blob_size], scales are [N, k_blocks] and the
+ * optional zero points are packed the same way as B. The weights are rebuilt as a [K, N]
+ * unpack_int4 -> dequantizelinear chain, which is the form the int4 weight-only gemm path
+ * recognizes, so GPTQ and AWQ checkpoints exported through this contrib op reach the same
+ * fused kernel as QDQ models.
+ */
+struct parse_matmulnbits : op_parser<parse_matmulnbits>
+{
+    std::vector<op_desc> operators() const { return {{"MatMulNBits"}}; }
+
+    static bool has_input(const std::vector<instruction_ref>& args, std::size_t i)
+    {
+        return args.size() > i and not args[i]->is_undefined();
+    }
+
+    // Turn an [N, cols] tensor, optionally with two nibbles per element, into [len, N]
+    static instruction_ref unpack_transpose(const onnx_parser::node_info& info,
+                                            instruction_ref ins,
+                                            std::size_t cols,
+                                            bool unpack,
+                                            std::size_t len)
+    {
+        auto rows = ins->get_shape().elements() / cols;
+        ins       = info.add_instruction(make_op("reshape", {{"dims", {rows, cols}}}), ins);
+        ins       = info.add_instruction(make_op("transpose", {{"permutation", {1, 0}}}), ins);
+        if(unpack)
+            ins = info.add_instruction(make_op("unpack_int4", {{"axis", 0}}), ins);
+        if(ins->get_shape().lens()[0] != len)
+            ins = info.add_instruction(
+                make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {len}}}), ins);
+        return ins;
+    }
+
+    static void check_g_idx(instruction_ref g_idx, std::size_t k, std::size_t block_size)
+    {
+        auto g = g_idx->eval();
+        if(g.empty())
+            MIGRAPHX_THROW("MatMulNBits: g_idx must be a constant");
+        std::vector<int64_t> groups;
+        g.visit([&](auto v) { groups.assign(v.begin(), v.end()); });
+        if(groups.size() != k)
+            MIGRAPHX_THROW("MatMulNBits: g_idx must have K elements");
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            if(groups[i] != static_cast<int64_t>(i / block_size))
+                MIGRAPHX_THROW("MatMulNBits: reordered g_idx (act-order) is not supported");
+        }
+    }
+
+    instruction_ref parse(const op_desc& opd,
+                          const onnx_parser& /*parser*/,
+                          const onnx_parser::node_info& info,
+                          std::vector<instruction_ref> args) const
+    {
+        if(args.size() < 3)
+            MIGRAPHX_THROW("MatMulNBits: requires at least 3 inputs");
+
+        auto get_attr = [&](const std::string& name) -> std::size_t {
+            if(not contains(info.attributes, name))
+                MIGRAPHX_THROW("MatMulNBits: missing attribute " + name);
+            return info.attributes.at(name).i();
+        };
+        auto k          = get_attr("K");
+        auto n          = get_attr("N");
+        auto block_size = get_attr("block_size");
+        int bits        = contains(info.attributes, "bits") ? info.attributes.at("bits").i() : 4;
+        if(bits != 4 and bits != 8)
+            MIGRAPHX_THROW("MatMulNBits: only 4 and 8 bits are supported, got " +
+                           std::to_string(bits));
+        if(block_size < 16 or (block_size & (block_size - 1)) != 0)
+            MIGRAPHX_THROW("MatMulNBits: block_size must be a power of 2 and at least 16");
+
+        auto k_blocks = (k + block_size - 1) / block_size;
+        auto a        = args[0];
+        auto b        = args[1];
+        auto scales   = args[2];
+        if(b->get_shape().type() != shape::uint8_type)
+            MIGRAPHX_THROW("MatMulNBits: B must be uint8");
+        if(b->get_shape().elements() != n * k_blocks * block_size * bits / 8)
+            MIGRAPHX_THROW("MatMulNBits: B does not match K, N and block_size");
+        if(scales->get_shape().elements() != n * k_blocks)
+            MIGRAPHX_THROW("MatMulNBits: scales must have N * k_blocks elements");
+        if(has_input(args, 4))
+            check_g_idx(args[4], k, block_size);
+
+        // [N, k_blocks, blob_size] -> [K, N]
+        auto w  = unpack_transpose(info, b, k_blocks * block_size * bits / 8, bits == 4, k);
+        auto sc = unpack_transpose(info, scales, k_blocks, false, k_blocks);
+
+        instruction_ref zp;
+        bool float_zp = false;
+        if(has_input(args, 3))
+        {
+            zp       = args[3];
+            float_zp = zp->get_shape().type() != shape::uint8_type;
+            if(float_zp)
+                zp = unpack_transpose(info, zp, k_blocks, false, k_blocks);
+            else
+                zp = unpack_transpose(info, zp, (k_blocks * bits + 7) / 8, bits == 4, k_blocks);
+        }
+        else
+        {
+            // Zero points default to the middle of the unsigned range
+            uint8_t mid = 1u << (bits - 1);
+            zp          = info.add_literal(literal{shape{shape::uint8_type}, {mid}});
+            zp = info.add_instruction(make_op("multibroadcast", {{"out_lens", {k_blocks, n}}}),
+                                      zp);
+        }
+
+        auto dq_args = transform_quantize_dequantize_linear_inputs(
+            info, opd.op_name, block_size, 0, {w, sc, zp});
+        if(float_zp)
+        {
+            // Floating point zero points are not quantized, so w = (q - zp) * scale is computed
+            // directly instead of through dequantizelinear
+            auto q = info.add_instruction(
+                make_op("convert", {{"target_type", sc->get_shape().type()}}), dq_args[0]);
+            w = info.add_instruction(make_op("sub"), q, dq_args[2]);
+            w = info.add_instruction(make_op("mul"), w, dq_args[1]);
+        }
+        else
+        {
+            w = info.add_instruction(make_op("dequantizelinear"), dq_args);
+        }
+
+        auto a_lens = a->get_shape().lens();
+        if(a_lens.size() == 1)
+            a = info.add_instruction(make_op("unsqueeze", {{"axes", {0}}}), a);
+        if(a_lens.size() > 2)
+        {
+            std::vector<std::size_t> w_lens(a_lens.begin(), a_lens.end() - 2);
+            w_lens.insert(w_lens.end(), {k, n});
+            w = info.add_instruction(make_op("multibroadcast", {{"out_lens", w_lens}}), w);
+        }
+        auto result = info.add_instruction(make_op("dot"), a, w);
+        if(a_lens.size() == 1)
+            result = info.add_instruction(make_op("squeeze", {{"axes", {0}}}), result);
+
+        if(has_input(args, 5))
+            result = info.add_common_op("add", result, args[5]);
+        return result;
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -28,56 +28,12 @@
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/make_op.hpp>
+#include <optional>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace onnx {
 
-static std::vector<int>
-calc_neighbor_points(const std::vector<std::vector<std::vector<std::size_t>>>& vvv_ind,
-                     int i_dim,
-                     std::vector<std::vector<std::size_t>> vec_dims,
-                     const shape& in_s)
-{
-    if(i_dim == vvv_ind.size())
-    {
-        std::vector<int> vec_ind(vec_dims.size());
-        std::transform(vec_dims.begin(), vec_dims.end(), vec_ind.begin(), [&](auto idx) {
-            return static_cast<int>(in_s.index(idx));
-        });
-        return vec_ind;
-    }
-
-    const auto& vv_lo = vvv_ind[i_dim][0];
-    std::vector<std::vector<std::size_t>> vec_dims1;
-    for(std::size_t start = 0; start < vec_dims.size(); start += vv_lo.size())
-    {
-        std::transform(vv_lo.begin(),
-                       vv_lo.end(),
-                       vec_dims.begin() + start,
-                       std::back_inserter(vec_dims1),
-                       [](auto i, auto dim) {
-                           dim.push_back(i);
-                           return dim;
-                       });
-    }
-
-    const auto& vv_hi = vvv_ind[i_dim][1];
-    for(std::size_t start = 0; start < vec_dims.size(); start += vv_hi.size())
-    {
-        std::transform(vv_hi.begin(),
-                       vv_hi.end(),
-                       vec_dims.begin() + start,
-                       std::back_inserter(vec_dims1),
-                       [](auto i, auto dim) {
-                           dim.push_back(i);
-                           return dim;
-                       });
-    }
-    vec_dims.clear();
-    return calc_neighbor_points(vvv_ind, i_dim + 1, std::move(vec_dims1), in_s);
-}
-
 static std::string get_coord_trans_mode(const onnx_parser::attribute_map& attr)
 {
     std::string coord_trans_mode = "half_pixel";
@@ -100,9 +56,9 @@ static std::string get_mode(const onnx_parser::attribute_map& attr)
     if(contains(attr, "mode"))
     {
         mode = attr.at("mode").s();
-        if(mode != "nearest" and mode != "linear")
+        if(not contains({"nearest", "linear", "cubic"}, mode))
         {
-            MIGRAPHX_THROW("PARSE_RESIZE: only nearest and linear modes are supported!");
+            MIGRAPHX_THROW("PARSE_RESIZE: only nearest, linear and cubic modes are supported!");
         }
     }
 
@@ -120,6 +76,17 @@ static std::string get_nearest_mode(const onnx_parser::attribute_map& attr)
     return nearest_mode;
 }
 
+static float get_cubic_coeff_a(const onnx_parser::attribute_map& attr)
+{
+    float cubic_coeff_a = -0.75f;
+    if(contains(attr, "cubic_coeff_a"))
+    {
+        cubic_coeff_a = attr.at("cubic_coeff_a").f();
+    }
+
+    return cubic_coeff_a;
+}
+
 // "scales" is an attribute of the deprecated Upsample op. ver7 only
 static std::vector<double> get_scales(const onnx_parser::attribute_map& attr)
 {
@@ -198,6 +165,33 @@ static bool parse_args(const std::vector<instruction_ref>& args,
     MIGRAPHX_THROW("PARSE_" + op_name + ": no shapes or scales input provided");
 }
 
+// Finds the uint8 NHWC image the input of the resize was converted to float and transposed to NCHW
+// from, in either order, so the preprocessing of the image can be done by one operator
+static std::optional<instruction_ref> find_nhwc_image(instruction_ref ins)
+{
+    auto is_transpose = [](instruction_ref i) {
+        if(i->name() != "transpose")
+            return false;
+        auto perm = i->get_operator().to_value()["permutation"].to_vector<int64_t>();
+        return perm == std::vector<int64_t>{0, 3, 1, 2};
+    };
+    auto is_convert = [](instruction_ref i) {
+        return i->name() == "convert" and i->get_shape().type() == shape::float_type;
+    };
+    auto input = [](instruction_ref i) { return i->inputs().front(); };
+    std::optional<instruction_ref> image;
+    if(is_convert(ins) and is_transpose(input(ins)))
+        image = input(input(ins));
+    else if(is_transpose(ins) and is_convert(input(ins)))
+        image = input(input(ins));
+    if(not image.has_value())
+        return std::nullopt;
+    const auto& s = (*image)->get_shape();
+    if(s.dynamic() or s.type() != shape::uint8_type or s.ndim() != 4)
+        return std::nullopt;
+    return image;
+}
+
 struct parse_resize : op_parser<parse_resize>
 {
     std::vector<op_desc> operators() const
@@ -252,13 +246,14 @@ struct parse_resize : op_parser<parse_resize>
         // coord transform mode
         std::string coord_trans_mode = get_coord_trans_mode(info.attributes);
 
-        // mode: only nearest and linear modes are supported for now
+        // mode: nearest, linear or cubic
         std::string mode = get_mode(info.attributes);
 
         // nearest mode
         std::string nearest_mode = get_nearest_mode(info.attributes);
 
-        auto idx_op = op::resize::get_original_idx_op(coord_trans_mode);
+        // throws for an unsupported coord transform mode
+        op::resize::get_original_idx_op(coord_trans_mode);
 
         // check exclude_outside, only support 0
         if(contains(info.attributes, "exclude_outside") and
@@ -285,6 +280,8 @@ struct parse_resize : op_parser<parse_resize>
         // at compile time, i.e. its values come from literal input(s) and have
         // no dependencies anywhere in the graph on runtime inputs.
         bool is_constant_scale_input(not vec_scale.empty());
+        // whether the output size is computed from the scales, instead of given by an input
+        bool is_scaled = false;
         if(not is_constant_scale_input)
         {
             // Depending on the args, it *must* populate the `vec_scale`, and might populate
@@ -304,6 +301,7 @@ struct parse_resize : op_parser<parse_resize>
             // if the output was not calculated yet, we update it based on the scales
             if(all_of(out_lens.cbegin(), out_lens.cend(), [](auto o) { return o == 0; }))
             {
+                is_scaled = true;
                 std::transform(
                     in_lens.begin(),
                     in_lens.end(),
@@ -313,6 +311,21 @@ struct parse_resize : op_parser<parse_resize>
             }
         }
 
+        // Only the height and width of an image are resized
+        auto image = find_nhwc_image(args[0]);
+        if(image.has_value() and mode != "cubic" and is_constant_scale_input and
+           out_lens[0] == in_lens[0] and out_lens[1] == in_lens[1])
+        {
+            return info.add_instruction(
+                make_op("image_preprocess",
+                        {{"sizes", {out_lens[2], out_lens[3]}},
+                         {"scales", {vec_scale[2], vec_scale[3]}},
+                         {"mode", mode},
+                         {"nearest_mode", nearest_mode},
+                         {"coordinate_transformation_mode", coord_trans_mode}}),
+                *image);
+        }
+
         if(mode == "nearest")
         {
             if(args[0]->get_shape().dynamic() or not is_constant_scale_input)
@@ -340,78 +353,24 @@ struct parse_resize : op_parser<parse_resize>
                     info, out_elements, in_s, out_s, in_lens, out_lens, vec_scale, args[0]);
             }
         }
-        // linear mode
+        // linear and cubic modes
         else
         {
             // out_lens and other variables can't be populated if non-constant (runtime) size
             // inputs.
             if(not is_constant_scale_input)
-                MIGRAPHX_THROW("PARSE_" + opd.op_name +
-                               ": linear mode not supported for non-constant inputs");
-
-            shape out_s{in_s.type(), out_lens};
-            std::size_t out_elements = out_s.elements();
-
-            // reshape input to one-dimension
-            std::vector<int64_t> rsp_lens = {static_cast<int64_t>(in_s.elements())};
-            auto rsp = info.add_instruction(make_op("reshape", {{"dims", rsp_lens}}), args[0]);
-
-            auto nearest_floor = op::resize::get_nearest_op("floor");
-            auto nearest_ceil  = op::resize::get_nearest_op("ceil");
-
-            // get the number of dimensions
-            std::size_t n_dim = out_lens.size();
-            std::vector<std::vector<std::size_t>> vv_ind(2, std::vector<std::size_t>(out_elements));
-            std::vector<std::vector<std::vector<std::size_t>>> vvv_ind(n_dim, vv_ind);
-            std::vector<std::vector<float>> delta(n_dim, std::vector<float>(out_elements));
-
-            shape_for_each(out_s, [&](const auto& out_idx_v, size_t out_idx) {
-                for(auto ii = 0; ii < in_lens.size(); ++ii)
-                {
-                    auto idx_val = idx_op(in_lens[ii], out_lens[ii], out_idx_v[ii], vec_scale[ii]);
-                    vvv_ind[ii][0][out_idx] = nearest_floor(in_lens[ii], idx_val);
-                    vvv_ind[ii][1][out_idx] = nearest_ceil(in_lens[ii], idx_val);
-                    delta[ii][out_idx]      = idx_val - vvv_ind[ii][0][out_idx];
-                }
-            });
-
-            auto ind = calc_neighbor_points(
-                vvv_ind, 0, std::vector<std::vector<std::size_t>>(out_elements), in_s);
-            auto ind_lens = out_lens;
-            ind_lens[0] *= (std::size_t{1} << n_dim);
-            shape ind_s{shape::int32_type, ind_lens};
-            auto ins_ind = info.add_literal(literal(ind_s, ind));
-            auto data    = info.add_instruction(make_op("gather", {{"axis", 0}}), rsp, ins_ind);
-
-            auto dim_lens = out_lens;
-            dim_lens[0] *= (std::size_t{1} << (n_dim - 1));
-            for(std::size_t i = 0; i < n_dim; ++i)
-            {
-                shape dim_s{shape::float_type, dim_lens};
-                const auto& dim_delta = delta[n_dim - i - 1];
-                std::vector<float> delta_data;
-                for(std::size_t j = 0; j < dim_lens[0] / out_lens[0]; ++j)
-                {
-                    delta_data.insert(delta_data.begin(), dim_delta.begin(), dim_delta.end());
-                }
-                auto ins_delta = info.add_literal(dim_s, delta_data);
-
-                // slice the data
-                int64_t slc_stride = dim_lens[0];
-                auto low           = info.add_instruction(
-                    make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {slc_stride}}}),
-                    data);
-                auto hi = info.add_instruction(
-                    make_op("slice",
-                            {{"axes", {0}}, {"starts", {slc_stride}}, {"ends", {2 * slc_stride}}}),
-                    data);
-                auto diff = info.add_instruction(make_op("sub"), hi, low);
-                auto ddf  = info.add_instruction(make_op("mul"), diff, ins_delta);
-                data      = info.add_instruction(make_op("add"), ddf, low);
-                dim_lens[0] /= 2;
-            }
-
-            return data;
+                MIGRAPHX_THROW("PARSE_" + opd.op_name + ": " + mode +
+                               " mode not supported for non-constant inputs");
+
+            // The resize computes the output size from the scales when they were given
+            value resize_v = {{"mode", mode},
+                              {"coordinate_transformation_mode", coord_trans_mode},
+                              {"cubic_coeff_a", get_cubic_coeff_a(info.attributes)}};
+            if(is_scaled)
+                resize_v["scales"] = vec_scale;
+            else
+                resize_v["sizes"] = out_lens;
+            return info.add_instruction(make_op("resize", resize_v), args[0]);
         }
     }
 };
@@ -0,0 +1,171 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/attention.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/instruction.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+// com.microsoft.RotaryEmbedding and RotaryEmbedding-23
+// Rotary position embedding of the query or key, using the cos and sin tables of the positions.
+
+// Inputs
+// com.microsoft: input, position_ids, cos_cache, sin_cache
+// ai.onnx:       input, cos_cache, sin_cache, position_ids (optional)
+// input : 3D (batch_size, sequence_length, hidden_size) or 4D (batch_size, num_heads,
+// sequence_length, head_size)
+// position_ids : (1) offset of the first position, or (batch_size, sequence_length)
+// cos_cache, sin_cache : (max_sequence_length, rotary_embedding_dim / 2), or (batch_size,
+// sequence_length, rotary_embedding_dim / 2) without position_ids
+
+struct parse_rotary_embedding : op_parser<parse_rotary_embedding>
+{
+    std::vector<op_desc> operators() const { return {{"RotaryEmbedding"}}; }
+
+    std::vector<instruction_ref> parse(const op_desc& /*opd*/,
+                                       const onnx_parser& parser,
+                                       const onnx_parser::node_info& info,
+                                       std::vector<instruction_ref> args) const
+    {
+        if(args.size() < 3 or args.size() > 4)
+            MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: invalid input count");
+
+        bool interleaved       = false;
+        std::size_t num_heads  = 0;
+        std::size_t rotary_dim = 0;
+        if(contains(info.attributes, "interleaved"))
+            interleaved = parser.parse_value(info.attributes.at("interleaved")).at<int>() != 0;
+        if(contains(info.attributes, "num_heads"))
+            num_heads = parser.parse_value(info.attributes.at("num_heads")).at<std::size_t>();
+        if(contains(info.attributes, "rotary_embedding_dim"))
+            rotary_dim =
+                parser.parse_value(info.attributes.at("rotary_embedding_dim")).at<std::size_t>();
+
+        // The contrib op has the position ids second, which are integral unlike the tables
+        auto x = args[0];
+        instruction_ref cos;
+        instruction_ref sin;
+        std::optional<instruction_ref> pos;
+        if(shape::is_integral(args[1]->get_shape().type()))
+        {
+            if(args.size() != 4)
+                MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: missing cos and sin caches");
+            pos = args[1];
+            cos = args[2];
+            sin = args[3];
+        }
+        else
+        {
+            cos = args[1];
+            sin = args[2];
+            if(args.size() == 4)
+                pos = args[3];
+        }
+
+        auto xs = x->get_shape();
+        if(xs.dynamic() or (xs.ndim() != 3 and xs.ndim() != 4))
+            MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: input must be 3D or 4D");
+        if(cos->get_shape().type() != xs.type() or sin->get_shape().type() != xs.type())
+            MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: cos and sin caches must match the input type");
+
+        auto lens     = xs.lens();
+        auto seq_len  = xs.ndim() == 3 ? lens[1] : lens[2];
+        auto half_dim = cos->get_shape().lens().back();
+        if(rotary_dim == 0)
+            rotary_dim = 2 * half_dim;
+        std::size_t head_size = lens.back();
+        if(xs.ndim() == 3)
+        {
+            if(num_heads == 0)
+                num_heads = lens[2] / rotary_dim;
+            if(num_heads == 0 or lens[2] % num_heads != 0)
+                MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: hidden size is not divisible by num_heads");
+            head_size = lens[2] / num_heads;
+            x         = info.add_instruction(
+                make_op("reshape", {{"dims", {lens[0], lens[1], num_heads, head_size}}}), x);
+        }
+        if(rotary_dim != 2 * half_dim or rotary_dim > head_size)
+            MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: invalid rotary_embedding_dim");
+
+        if(pos.has_value())
+        {
+            auto ids = *pos;
+            // A single offset is the position of the first token in the sequence
+            if(ids->get_shape().elements() == 1)
+            {
+                std::vector<int64_t> range(seq_len);
+                std::iota(range.begin(), range.end(), 0);
+                auto r = info.add_literal(
+                    literal{shape{ids->get_shape().type(), {1, seq_len}}, range});
+                ids = info.add_common_op("add", r, ids);
+            }
+            cos = info.add_instruction(make_op("gather", {{"axis", 0}}), cos, ids);
+            sin = info.add_instruction(make_op("gather", {{"axis", 0}}), sin, ids);
+        }
+        if(cos->get_shape().ndim() != 3)
+            MIGRAPHX_THROW("PARSE_ROTARYEMBEDDING: invalid cos and sin caches");
+        cos = expand_rotary_table(info, cos, interleaved);
+        sin = expand_rotary_table(info, sin, interleaved);
+
+        auto head_axis = xs.ndim() == 3 ? 2 : 1;
+        // Tables are (batch, sequence, rotary_dim) and are broadcast over the heads
+        cos = info.add_instruction(make_op("unsqueeze", {{"axes", {head_axis}}}), cos);
+        sin = info.add_instruction(make_op("unsqueeze", {{"axes", {head_axis}}}), sin);
+
+        auto rot  = x;
+        auto last = x->get_shape().ndim() - 1;
+        if(rotary_dim < head_size)
+        {
+            rot = info.add_instruction(
+                make_op("slice", {{"axes", {last}}, {"starts", {0}}, {"ends", {rotary_dim}}}), x);
+        }
+        auto rot_lens = rot->get_shape().lens();
+
+        cos = info.add_instruction(make_op("multibroadcast", {{"out_lens", rot_lens}}), cos);
+        sin = info.add_instruction(make_op("multibroadcast", {{"out_lens", rot_lens}}), sin);
+
+        auto result = info.add_instruction(
+            make_op("rotary_embedding", {{"interleaved", interleaved}}), rot, cos, sin);
+        if(rotary_dim < head_size)
+        {
+            auto pass = info.add_instruction(
+                make_op("slice",
+                        {{"axes", {last}}, {"starts", {rotary_dim}}, {"ends", {head_size}}}),
+                x);
+            result = info.add_instruction(make_op("concat", {{"axis", last}}), result, pass);
+        }
+        if(xs.ndim() == 3)
+            result = info.add_instruction(make_op("reshape", {{"dims", lens}}), result);
+        return {result};
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
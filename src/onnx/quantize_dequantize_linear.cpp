@@ -27,6 +27,7 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/tune_axis.hpp>
 #include <migraphx/common.hpp>
+#include <limits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -98,11 +99,13 @@ transform_quantize_dequantize_linear_inputs(const onnx_parser::node_info& info,
         }
 
         // Given x shape (D0, ..., Di, ..., Dn), y_scale shape (S0, ... Si, ...Sn) and
-        // axis=i, the accepted range is [ceil(Di/Si), ceil(Di/(Si-1))-1]
+        // axis=i, the accepted range is [ceil(Di/Si), ceil(Di/(Si-1))-1]. A single block along
+        // the axis has no upper bound.
         float di           = x_lens[axis];
         float si           = y_scale_lens[axis];
         int block_size_min = std::ceil(di / si);
-        int block_size_max = std::ceil(di / (si - 1)) - 1;
+        int block_size_max =
+            si > 1 ? int(std::ceil(di / (si - 1)) - 1) : std::numeric_limits<int>::max();
         if(block_size < block_size_min or block_size > block_size_max)
             MIGRAPHX_THROW(op_name + ": Block size(actual: " + to_string(block_size) +
                            ") must be within range [" + to_string(block_size_min) + ", " +
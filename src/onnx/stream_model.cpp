@@ -0,0 +1,215 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/onnx/onnx_parser.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/filesystem.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <onnx.pb.h>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+namespace {
+
+// Field numbers from onnx.proto
+constexpr uint64_t model_graph       = 7;
+constexpr uint64_t graph_initializer = 5;
+constexpr uint64_t tensor_raw_data   = 9;
+
+// Wire types
+constexpr uint64_t wire_varint  = 0;
+constexpr uint64_t wire_fixed64 = 1;
+constexpr uint64_t wire_length  = 2;
+constexpr uint64_t wire_fixed32 = 5;
+
+struct wire_field
+{
+    uint64_t number   = 0;
+    uint64_t type     = 0;
+    const char* start = nullptr;
+    const char* data  = nullptr;
+    const char* last  = nullptr;
+
+    // The encoded field, including its tag
+    std::string_view bytes() const { return {start, static_cast<std::size_t>(last - start)}; }
+    std::string_view payload() const { return {data, static_cast<std::size_t>(last - data)}; }
+};
+
+uint64_t read_varint(const char*& p, const char* last)
+{
+    uint64_t result = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if(p == last)
+            MIGRAPHX_THROW("PARSE_FROM: Truncated field in onnx file");
+        auto b = static_cast<unsigned char>(*p++);
+        result |= uint64_t{b & 0x7fu} << shift;
+        if((b & 0x80u) == 0)
+            return result;
+    }
+    MIGRAPHX_THROW("PARSE_FROM: Invalid varint in onnx file");
+}
+
+// Visit the top-level fields of an encoded message without decoding it, so the size of the
+// message is not bounded by protobuf
+template <class F>
+void for_each_field(std::string_view message, F f)
+{
+    const char* p    = message.data();
+    const char* last = p + message.size();
+    while(p != last)
+    {
+        wire_field field;
+        field.start     = p;
+        auto tag        = read_varint(p, last);
+        field.number    = tag >> 3u;
+        field.type      = tag & 7u;
+        field.data      = p;
+        std::size_t len = 0;
+        switch(field.type)
+        {
+        case wire_varint: read_varint(p, last); break;
+        case wire_fixed64: len = 8; break;
+        case wire_fixed32: len = 4; break;
+        case wire_length:
+            len        = read_varint(p, last);
+            field.data = p;
+            break;
+        default: MIGRAPHX_THROW("PARSE_FROM: Unsupported wire type in onnx file");
+        }
+        if(len > static_cast<std::size_t>(last - p))
+            MIGRAPHX_THROW("PARSE_FROM: Truncated field in onnx file");
+        p += len;
+        field.last = p;
+        f(field);
+    }
+}
+
+template <class Message>
+void parse_message(Message& m, const std::string& bytes)
+{
+    if(not m.ParseFromString(bytes))
+        MIGRAPHX_THROW("PARSE_FROM: Failed reading onnx file");
+}
+
+// Decode an initializer without its raw data, which is instead referenced as external data
+// in the model file itself. This way the tensor is loaded lazily from the mapped file and
+// the weights are never copied into a protobuf message.
+onnx::TensorProto read_initializer(std::string_view tensor, const char* base, const fs::path& file)
+{
+    std::string stripped;
+    const char* raw    = nullptr;
+    std::size_t nbytes = 0;
+    for_each_field(tensor, [&](const wire_field& field) {
+        if(field.number == tensor_raw_data and field.type == wire_length and
+           not field.payload().empty())
+        {
+            raw    = field.data;
+            nbytes = field.payload().size();
+            return;
+        }
+        stripped.append(field.bytes());
+    });
+    onnx::TensorProto t;
+    parse_message(t, stripped);
+    if(raw == nullptr or t.external_data_size() > 0)
+        return t;
+    auto add_entry = [&](const std::string& key, const std::string& value) {
+        auto* entry = t.add_external_data();
+        entry->set_key(key);
+        entry->set_value(value);
+    };
+    add_entry("location", file.string());
+    add_entry("offset", std::to_string(raw - base));
+    add_entry("length", std::to_string(nbytes));
+    t.set_data_location(onnx::TensorProto::EXTERNAL);
+    return t;
+}
+
+} // namespace
+
+void onnx_parser::parse_from(const fs::path& file)
+{
+    auto* mm       = prog.get_main_module();
+    this->filename = file.string();
+    if(file.has_parent_path())
+        this->path = file.parent_path();
+
+    std::error_code ec;
+    auto size = fs::file_size(file, ec);
+    if(ec)
+        MIGRAPHX_THROW("PARSE_FROM: Failed reading onnx file: " + this->filename);
+    if(size == 0)
+        return;
+
+    // The model file is registered as an external data file so the mapping is shared with the
+    // initializers that reference it
+    auto location     = fs::absolute(file);
+    const auto& model = get_external_data(location)->get();
+    const char* base  = model.data();
+
+    // Everything except the initializers is gathered into small messages that are decoded
+    // with protobuf
+    std::string model_fields;
+    std::string graph_fields;
+    std::vector<std::string_view> initializers;
+    bool has_graph = false;
+    for_each_field(std::string_view{base, model.size()}, [&](const wire_field& field) {
+        if(field.number != model_graph or field.type != wire_length)
+        {
+            model_fields.append(field.bytes());
+            return;
+        }
+        has_graph = true;
+        for_each_field(field.payload(), [&](const wire_field& graph_field) {
+            if(graph_field.number == graph_initializer and graph_field.type == wire_length)
+                initializers.push_back(graph_field.payload());
+            else
+                graph_fields.append(graph_field.bytes());
+        });
+    });
+
+    onnx::ModelProto model_proto;
+    parse_message(model_proto, model_fields);
+    auto version  = get_opset_version(model_proto);
+    opset_version = (version == -1) ? opset_version : version;
+    if(not has_graph)
+        return;
+
+    onnx::GraphProto graph;
+    parse_message(graph, graph_fields);
+    for(auto tensor : initializers)
+    {
+        auto t = read_initializer(tensor, base, location);
+        graph.add_initializer()->Swap(&t);
+    }
+    (void)this->parse_graph(mm, graph);
+}
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
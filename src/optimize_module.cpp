@@ -30,12 +30,18 @@
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/module.hpp>
+#include <migraphx/env.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_INCREMENTAL_REWRITES)
+
 void optimize_module::apply(module_pass_manager& mpm) const
 {
+    // Later iterations only need to revisit instructions touched by the previous one
+    mpm.get_module().set_incremental_rewrites(
+        not enabled(MIGRAPHX_DISABLE_INCREMENTAL_REWRITES{}));
     mpm.get_module().repeat_while_changes(2, [&] {
         // loop to further optimize after initial transformations
         mpm.get_module().repeat_while_changes(4, [&] {
@@ -43,12 +49,14 @@ void optimize_module::apply(module_pass_manager& mpm) const
             mpm.run_pass(eliminate_convert{});
             mpm.run_pass(dead_code_elimination{});
             mpm.run_pass(simplify_algebra{});
+            mpm.get_module().next_rewrite_epoch();
         });
         mpm.run_pass(eliminate_common_subexpression{});
         mpm.run_pass(dead_code_elimination{});
         mpm.run_pass(propagate_constant{propagate_constant_skip_ops});
         mpm.run_pass(dead_code_elimination{});
     });
+    mpm.get_module().set_incremental_rewrites(false);
 }
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,310 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/partition_targets.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+namespace {
+
+// Dinic's max flow, the nodes left reachable from the source give the minimum cut
+struct flow_graph
+{
+    struct edge
+    {
+        std::size_t to;
+        double capacity;
+    };
+    std::vector<edge> edges;
+    std::vector<std::vector<std::size_t>> adjacent;
+    std::vector<int> level;
+    std::vector<std::size_t> next_edge;
+
+    static constexpr double epsilon = 1e-12;
+
+    explicit flow_graph(std::size_t n) : adjacent(n) {}
+
+    void add_edge(std::size_t from, std::size_t to, double capacity)
+    {
+        if(capacity <= epsilon)
+            return;
+        adjacent[from].push_back(edges.size());
+        edges.push_back({to, capacity});
+        adjacent[to].push_back(edges.size());
+        edges.push_back({from, 0});
+    }
+
+    bool find_levels(std::size_t s, std::size_t t)
+    {
+        level.assign(adjacent.size(), -1);
+        level[s] = 0;
+        std::queue<std::size_t> q;
+        q.push(s);
+        while(not q.empty())
+        {
+            auto v = q.front();
+            q.pop();
+            for(auto e : adjacent[v])
+            {
+                if(edges[e].capacity <= epsilon or level[edges[e].to] >= 0)
+                    continue;
+                level[edges[e].to] = level[v] + 1;
+                q.push(edges[e].to);
+            }
+        }
+        return level[t] >= 0;
+    }
+
+    bool usable(std::size_t v, std::size_t e) const
+    {
+        return edges[e].capacity > epsilon and level[edges[e].to] == level[v] + 1;
+    }
+
+    // Push the bottleneck flow along a path to t in the level graph, found with a stack of the
+    // edges taken so far instead of recursion so long graphs can't overflow the call stack
+    double push(std::size_t s, std::size_t t)
+    {
+        std::vector<std::size_t> path;
+        auto v = s;
+        while(v != t)
+        {
+            auto& i = next_edge[v];
+            while(i < adjacent[v].size() and not usable(v, adjacent[v][i]))
+                i++;
+            if(i < adjacent[v].size())
+            {
+                path.push_back(adjacent[v][i]);
+                v = edges[path.back()].to;
+                continue;
+            }
+            // A dead end, so go back and skip the edge that led here
+            if(path.empty())
+                return 0;
+            v = edges[path.back() ^ 1u].to;
+            path.pop_back();
+            next_edge[v]++;
+        }
+        double flow = std::numeric_limits<double>::max();
+        for(auto e : path)
+            flow = std::min(flow, edges[e].capacity);
+        for(auto e : path)
+        {
+            edges[e].capacity -= flow;
+            edges[e ^ 1u].capacity += flow;
+        }
+        return flow;
+    }
+
+    std::vector<bool> min_cut(std::size_t s, std::size_t t)
+    {
+        while(find_levels(s, t))
+        {
+            next_edge.assign(adjacent.size(), 0);
+            while(push(s, t) > epsilon)
+                ;
+        }
+        // The last search marked the nodes still reachable from the source
+        std::vector<bool> source_side(adjacent.size());
+        std::transform(
+            level.begin(), level.end(), source_side.begin(), [](int l) { return l >= 0; });
+        return source_side;
+    }
+};
+
+struct partition_problem
+{
+    // Cost of running each instruction on each target, infinite when it is not supported
+    std::vector<std::vector<double>> costs;
+    // Instructions that use the value of another instruction, with the cost of copying it
+    std::vector<std::tuple<std::size_t, std::size_t, double>> edges;
+
+    double energy(const std::vector<std::size_t>& labels) const
+    {
+        double result = 0;
+        for(std::size_t i = 0; i < labels.size(); i++)
+            result += costs[i][labels[i]];
+        for(const auto& [p, q, w] : edges)
+        {
+            if(labels[p] != labels[q])
+                result += w;
+        }
+        return result;
+    }
+
+    // Let every instruction either keep its target or move to alpha, whichever gives the lowest
+    // cost. The copy cost between two instructions is a metric, so this is a single min cut.
+    std::vector<std::size_t> expand(const std::vector<std::size_t>& labels,
+                                    std::size_t alpha,
+                                    double forbidden) const
+    {
+        auto n = labels.size();
+        auto s = n;
+        auto t = n + 1;
+        flow_graph g{n + 2};
+        // Unary terms are on the nodes: x = 0 keeps the target, x = 1 moves to alpha
+        std::vector<double> unary(n, 0);
+        auto cost = [&](std::size_t i, std::size_t label) {
+            return std::isinf(costs[i][label]) ? forbidden : costs[i][label];
+        };
+        for(std::size_t i = 0; i < n; i++)
+        {
+            if(labels[i] != alpha)
+                unary[i] += cost(i, alpha) - cost(i, labels[i]);
+        }
+        for(const auto& [p, q, w] : edges)
+        {
+            double a = labels[p] != labels[q] ? w : 0;
+            double b = labels[p] != alpha ? w : 0;
+            double c = alpha != labels[q] ? w : 0;
+            unary[p] += c - a;
+            unary[q] -= c;
+            // Paid when p keeps its target and q moves to alpha
+            g.add_edge(p, q, b + c - a);
+        }
+        for(std::size_t i = 0; i < n; i++)
+        {
+            if(unary[i] > 0)
+                g.add_edge(s, i, unary[i]);
+            else
+                g.add_edge(i, t, -unary[i]);
+        }
+        auto source_side = g.min_cut(s, t);
+        std::vector<std::size_t> result = labels;
+        for(std::size_t i = 0; i < n; i++)
+        {
+            if(not source_side[i])
+                result[i] = alpha;
+        }
+        return result;
+    }
+};
+
+} // namespace
+
+target_assignments
+partition_targets(const_module_ref mod,
+                  const std::vector<std::pair<std::string, supported_segments>>& target_segments,
+                  const assignment_options& options)
+{
+    const auto inf = std::numeric_limits<double>::infinity();
+    const auto k   = target_segments.size();
+
+    std::unordered_map<instruction_ref, std::vector<double>> supported;
+    for(std::size_t i = 0; i < k; i++)
+    {
+        for(const auto& segment : target_segments[i].second)
+        {
+            if(segment.instructions.empty())
+                continue;
+            double share = segment.metric / segment.instructions.size();
+            for(auto ins : segment.instructions)
+            {
+                auto& c = supported.emplace(ins, std::vector<double>(k, inf)).first->second;
+                c[i]    = std::min(c[i], share);
+            }
+        }
+    }
+
+    std::vector<instruction_ref> instructions;
+    std::unordered_map<instruction_ref, std::size_t> index;
+    partition_problem problem;
+    for(auto ins : iterator_for(*mod))
+    {
+        if(not contains(supported, ins))
+            continue;
+        index[ins] = instructions.size();
+        instructions.push_back(ins);
+        problem.costs.push_back(supported.at(ins));
+    }
+    for(std::size_t p = 0; p < instructions.size(); p++)
+    {
+        auto ins = instructions[p];
+        double w = ins->get_shape().dynamic() ? 0 : ins->get_shape().bytes() * options.copy_cost;
+        for(auto output : ins->outputs())
+        {
+            auto it = index.find(output);
+            if(it != index.end())
+                problem.edges.emplace_back(p, it->second, w);
+        }
+    }
+
+    // Start from the first target that supports each instruction
+    std::vector<std::size_t> labels(instructions.size());
+    std::transform(problem.costs.begin(),
+                   problem.costs.end(),
+                   labels.begin(),
+                   [](const auto& c) {
+                       return std::find_if(c.begin(), c.end(), [](double x) {
+                                  return not std::isinf(x);
+                              }) -
+                              c.begin();
+                   });
+
+    // Any assignment the cut picks is cheaper than using an unsupported target
+    double forbidden = 1;
+    for(const auto& c : problem.costs)
+    {
+        for(auto x : c)
+        {
+            if(not std::isinf(x))
+                forbidden += std::abs(x);
+        }
+    }
+    for(const auto& e : problem.edges)
+        forbidden += std::get<2>(e);
+
+    auto best = problem.energy(labels);
+    for(bool improved = k > 1; improved;)
+    {
+        improved = false;
+        for(std::size_t alpha = 0; alpha < k; alpha++)
+        {
+            auto next   = problem.expand(labels, alpha, forbidden);
+            auto energy = problem.energy(next);
+            if(energy >= best - 1e-9 * std::abs(best))
+                continue;
+            best     = energy;
+            labels   = std::move(next);
+            improved = true;
+        }
+    }
+
+    target_assignments result;
+    for(std::size_t i = 0; i < instructions.size(); i++)
+        result.insert(result.end(), {instructions[i], target_segments[labels[i]].first});
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -29,10 +29,14 @@
 #include <migraphx/env.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/time.hpp>
+#include <migraphx/compile_profile.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/algorithm.hpp>
+#include <migraphx/thread_pool.hpp>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <functional>
 #include <utility>
 
 namespace migraphx {
@@ -40,6 +44,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_PASSES);
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TIME_PASSES);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_PARALLEL_PASSES);
 
 void validate_pass(module& mod, const pass& p, tracer trace)
 {
@@ -58,10 +63,32 @@ void validate_pass(module& mod, const pass& p, tracer trace)
     trace();
 #endif
 }
+using milliseconds = std::chrono::duration<double, std::milli>;
+
+static std::size_t count_instructions(const program& prog)
+{
+    auto mods = prog.get_modules();
+    return transform_accumulate(
+        mods.begin(), mods.end(), std::size_t{0}, std::plus<>{}, [](const module* m) {
+            return m->size();
+        });
+}
+
 void run_pass(program& prog, const pass& p, tracer trace)
 {
     trace("Pass: ", p.name());
-    p.apply(prog);
+    pass_stats ps;
+    ps.name = p.name();
+    if(trace.records_pass_stats())
+        ps.instructions_before = count_instructions(prog);
+    compile_profile_scope profile{"pass", p.name()};
+    ps.ms = time<milliseconds>([&] { p.apply(prog); });
+    if(trace.records_pass_stats())
+    {
+        ps.instructions_after = count_instructions(prog);
+        ps.modules            = prog.get_modules().size();
+        trace.add_pass_stats(std::move(ps));
+    }
     trace(prog);
 }
 
@@ -72,6 +99,8 @@ struct module_pm : module_pass_manager
     tracer* t             = nullptr;
     module* common_parent = nullptr;
     program* prog         = nullptr;
+    // How many passes are running on this module, when a pass runs other passes
+    std::size_t nesting = 0;
 
     module_pm(module* pmod = nullptr, tracer* pt = nullptr) : mod(pmod), t(pt) {}
 
@@ -129,16 +158,23 @@ struct module_pm : module_pass_manager
         trace("Pass: ", p.name());
         assert(mod);
         assert(mod->validate() == mod->end());
-        if(enabled(MIGRAPHX_TIME_PASSES{}))
-        {
-            using milliseconds = std::chrono::duration<double, std::milli>;
-            auto ms            = time<milliseconds>([&] { p.apply(*this); });
-            std::cout << p.name() << ": " << ms << "ms\n";
-        }
-        else
+        pass_stats ps;
+        ps.name                = p.name();
+        ps.module              = mod->name();
+        ps.depth               = nesting;
+        ps.instructions_before = mod->size();
+        nesting++;
         {
-            p.apply(*this);
+            compile_profile_scope profile{"pass", p.name()};
+            profile.add("module", mod->name());
+            ps.ms = time<milliseconds>([&] { p.apply(*this); });
         }
+        nesting--;
+        if(enabled(MIGRAPHX_TIME_PASSES{}))
+            std::cout << p.name() << ": " << ps.ms << "ms\n";
+        ps.instructions_after = mod->size();
+        ps.modules            = prog == nullptr ? 1 : prog->get_modules().size();
+        t->add_pass_stats(std::move(ps));
         trace(*mod);
         validate_pass(*mod, p, *t);
     }
@@ -146,10 +182,29 @@ struct module_pm : module_pass_manager
 
 module& get_module(module_pass_manager& mpm) { return mpm.get_module(); }
 
+// A module that neither uses instructions from its parents nor has submodules of its own can be
+// changed without touching any other module
+static bool is_independent(const module& m)
+{
+    return all_of(iterator_for(m), [&](instruction_ref ins) {
+        return ins->module_inputs().empty() and all_of(ins->inputs(), [&](instruction_ref input) {
+                   return m.has_instruction(input);
+               });
+    });
+}
+
+static bool run_in_parallel(const pass& p, const tracer& trace)
+{
+    // Keep the trace and the pass stats in order
+    if(trace.enabled() or trace.records_pass_stats() or enabled(MIGRAPHX_TIME_PASSES{}))
+        return false;
+    return p.parallel() and not enabled(MIGRAPHX_DISABLE_PARALLEL_PASSES{});
+}
+
 void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& passes, tracer trace)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
-        trace = tracer{std::cout};
+        trace.print_to(std::cout);
     std::unordered_set<module_ref> visited;
     for(const auto& p : passes)
     {
@@ -157,12 +212,16 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
         std::vector<module_ref> sub_mods = root_mod->get_sub_modules();
         sub_mods.insert(sub_mods.begin(), root_mod);
         visited.clear();
+        std::vector<module_ref> mods;
         for(const auto& mod : reverse(sub_mods))
         {
             if(mod->bypass())
                 continue;
             if(not visited.insert(mod).second)
                 continue;
+            mods.push_back(mod);
+        }
+        auto run_module = [&](module_ref mod) {
             module_pm mpm{mod, root_mod, &trace};
             mpm.prog      = &prog;
             auto parents  = range(tree.equal_range(mod));
@@ -176,7 +235,19 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
                 // TODO: Compute the common parent
                 mpm.common_parent = prog.get_main_module();
             mpm.run_pass(p);
+        };
+        if(run_in_parallel(p, trace))
+        {
+            // Submodules are visited before their parents, so the independent ones can all be
+            // run first
+            auto it = std::stable_partition(mods.begin(), mods.end(), [](module_ref mod) {
+                return is_independent(*mod);
+            });
+            get_thread_pool().run(std::distance(mods.begin(), it),
+                                  [&](std::size_t i) { run_module(mods[i]); });
+            mods.erase(mods.begin(), it);
         }
+        std::for_each(mods.begin(), mods.end(), run_module);
         run_pass(prog, p, trace);
     }
 }
@@ -184,7 +255,7 @@ void run_passes(program& prog, module_ref root_mod, const std::vector<pass>& pas
 void run_passes(module& mod, const std::vector<pass>& passes, tracer trace)
 {
     if(enabled(MIGRAPHX_TRACE_PASSES{}))
-        trace = tracer{std::cout};
+        trace.print_to(std::cout);
     for(const auto& p : passes)
     {
         module_pm{&mod, &mod, &trace}.run_pass(p);
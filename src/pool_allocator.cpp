@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pool_allocator.hpp>
+#include <algorithm>
+#include <new>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::size_t size_class(std::size_t size)
+{
+    return (std::max<std::size_t>(size, 1) + node_pool::alignment - 1) / node_pool::alignment;
+}
+
+node_pool::node_pool() : free_lists(size_class(max_size) + 1, nullptr) {}
+
+node_pool::~node_pool()
+{
+    for(auto* chunk : chunks)
+        ::operator delete(chunk);
+}
+
+void* node_pool::allocate(std::size_t size)
+{
+    if(size > max_size)
+        return ::operator new(size);
+    auto n = size_class(size);
+    if(free_lists[n] != nullptr)
+    {
+        auto* node    = free_lists[n];
+        free_lists[n] = node->next;
+        return node;
+    }
+    auto bytes = n * alignment;
+    if(current == nullptr or static_cast<std::size_t>(last - current) < bytes)
+    {
+        // Grow geometrically so small modules stay small, and huge graphs only need a few chunks
+        auto chunk_size = std::min<std::size_t>(std::max<std::size_t>(reserved, 4096), 1 << 20);
+        chunk_size      = std::max(chunk_size, bytes);
+        current         = static_cast<char*>(::operator new(chunk_size));
+        last            = current + chunk_size;
+        chunks.push_back(current);
+        reserved += chunk_size;
+    }
+    auto* result = current;
+    current += bytes;
+    return result;
+}
+
+void node_pool::deallocate(void* p, std::size_t size) noexcept
+{
+    if(p == nullptr)
+        return;
+    if(size > max_size)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto n        = size_class(size);
+    auto* node    = static_cast<free_node*>(p);
+    node->next    = free_lists[n];
+    free_lists[n] = node;
+}
+
+std::size_t node_pool::capacity() const { return reserved; }
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -32,6 +32,17 @@
 #include <functional>
 #include <iostream>
 
+#ifndef _WIN32
+#include <array>
+#include <cerrno>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ; // NOLINT
+#endif
+
 #ifdef _WIN32
 // cppcheck-suppress definePrefix
 #define WIN32_LEAN_AND_MEAN
@@ -336,6 +347,27 @@ struct process_impl
     std::string envs{};
     std::string command{};
     fs::path cwd{};
+#ifndef _WIN32
+    int fd    = -1;
+    pid_t pid = -1;
+
+    process_impl() = default;
+
+    process_impl(const process_impl&)            = delete;
+    process_impl& operator=(const process_impl&) = delete;
+
+    ~process_impl() { stop(); }
+
+    void stop()
+    {
+        if(fd != -1)
+            close(fd);
+        fd = -1;
+        if(pid != -1)
+            waitpid(pid, nullptr, 0);
+        pid = -1;
+    }
+#endif
 
     std::string get_command() const
     {
@@ -457,5 +489,88 @@ void process::write(std::function<void(writer)> pipe_in)
 #endif
 }
 
+void process::start()
+{
+#ifndef _WIN32
+    if(impl->pid != -1)
+        MIGRAPHX_THROW("Process already started: " + impl->get_command());
+    auto cmd = impl->get_command();
+    if(enabled(MIGRAPHX_TRACE_CMD_EXECUTE{}))
+        std::cout << cmd << std::endl;
+    // A socket is used instead of two pipes so writing to a process that exited fails instead
+    // of raising SIGPIPE. Both ends are closed on exec so other processes started concurrently
+    // don't keep the connection open.
+    std::array<int, 2> fds{};
+    if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds.data()) != 0)
+        MIGRAPHX_THROW("socketpair() failed: " + cmd);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    std::string shell = "/bin/sh";
+    std::string flag  = "-c";
+    std::array<char*, 4> argv{shell.data(), flag.data(), cmd.data(), nullptr};
+    auto ec = posix_spawn(&impl->pid, shell.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if(ec != 0)
+    {
+        close(fds[0]);
+        impl->pid = -1;
+        MIGRAPHX_THROW("posix_spawn() failed: " + cmd);
+    }
+    impl->fd = fds[0];
+#else
+    MIGRAPHX_THROW("Starting a background process is not supported on Windows");
+#endif
+}
+
+void process::send(const char* buffer, std::size_t n)
+{
+#ifndef _WIN32
+    while(n > 0)
+    {
+        auto written = ::send(impl->fd, buffer, n, MSG_NOSIGNAL);
+        if(written < 0 and errno == EINTR)
+            continue;
+        if(written < 0)
+            MIGRAPHX_THROW("Failed writing to process: " + impl->get_command());
+        buffer += written;
+        n -= written;
+    }
+#else
+    (void)buffer;
+    (void)n;
+    MIGRAPHX_THROW("Starting a background process is not supported on Windows");
+#endif
+}
+
+void process::receive(char* buffer, std::size_t n)
+{
+#ifndef _WIN32
+    while(n > 0)
+    {
+        auto len = ::read(impl->fd, buffer, n);
+        if(len < 0 and errno == EINTR)
+            continue;
+        if(len <= 0)
+            MIGRAPHX_THROW("Failed reading from process: " + impl->get_command());
+        buffer += len;
+        n -= len;
+    }
+#else
+    (void)buffer;
+    (void)n;
+    MIGRAPHX_THROW("Starting a background process is not supported on Windows");
+#endif
+}
+
+void process::stop()
+{
+#ifndef _WIN32
+    impl->stop();
+#endif
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
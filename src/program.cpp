@@ -24,6 +24,7 @@
 #include <migraphx/version.h>
 #include <migraphx/compile_options.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/compile_profile.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/op/identity.hpp>
@@ -32,6 +33,7 @@
 #include <migraphx/ranges.hpp>
 #include <migraphx/time.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/load_save.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/iterator.hpp>
@@ -39,7 +41,10 @@
 #include <migraphx/output_iterator.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/marker.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/supported_segments.hpp>
+#include <migraphx/partition_targets.hpp>
+#include <migraphx/weight_map.hpp>
 
 #include <iostream>
 #include <queue>
@@ -50,11 +55,19 @@
 #include <utility>
 #include <unordered_set>
 #include <map>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_EXECUTION_PLAN)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_EVAL_BUFFER)
+
 using milliseconds = std::chrono::duration<double, std::milli>;
 
 struct mark_instruction_target
@@ -68,12 +81,216 @@ struct mark_instruction_target
     }
 };
 
+// The main module flattened into a vector of steps with the inputs of each
+// step resolved to slot indices, so it can be evaluated without any lookups
+struct execution_plan
+{
+    enum class step_kind
+    {
+        literal,
+        param,
+        outline,
+        compute
+    };
+
+    // The output shape of a dynamic step resolved for the input shapes of the last call
+    struct shape_cache
+    {
+        std::mutex m;
+        bool resolved = false;
+        std::vector<shape> inputs;
+        shape output;
+    };
+
+    struct step
+    {
+        step_kind kind = step_kind::compute;
+        instruction_ref ins;
+        operation op;
+        std::vector<std::size_t> inputs;
+        argument result;
+        std::string parameter;
+        std::shared_ptr<shape_cache> dynamic_shapes = nullptr;
+    };
+
+    std::vector<step> steps;
+    std::vector<std::size_t> outputs;
+    // The step of each instruction, so submodules can look up the results of the main module
+    std::unordered_map<instruction_ref, std::size_t> slots;
+    std::size_t max_inputs = 0;
+    std::function<bool()> changed;
+};
+
+// The parameters from program::bind with the results of the plan they were resolved for, so only
+// the compute steps are evaluated again by run_bound
+struct bound_parameters
+{
+    parameter_map params;
+    std::shared_ptr<execution_plan> plan = nullptr;
+    std::vector<argument> results;
+    std::vector<argument> values;
+    std::vector<std::size_t> compute;
+    std::vector<argument> outputs;
+};
+
+// Contexts for evaluating the program from several threads at once. The first caller runs with
+// the program's own contexts, while callers that overlap with it take a set of session contexts,
+// which are created when needed and kept for the next calls.
+struct session_pool
+{
+    std::atomic<bool> busy{false};
+    std::mutex m;
+    std::vector<std::vector<context>> idle;
+
+    std::vector<context> acquire(const std::vector<context>& contexts)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if(not idle.empty())
+            {
+                auto result = std::move(idle.back());
+                idle.pop_back();
+                return result;
+            }
+        }
+        std::vector<context> result;
+        std::transform(contexts.begin(),
+                       contexts.end(),
+                       std::back_inserter(result),
+                       [](const context& ctx) { return ctx.create_session(); });
+        return result;
+    }
+
+    void release(std::vector<context> contexts)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        idle.push_back(std::move(contexts));
+    }
+};
+
+// The contexts used by one call to eval, which are given back when the call returns
+struct context_lease
+{
+    context_lease(std::shared_ptr<session_pool> p, std::vector<context>& contexts)
+        : pool(std::move(p))
+    {
+        if(pool->busy.exchange(true))
+            session = pool->acquire(contexts);
+        else
+            owned = &contexts;
+    }
+
+    context_lease(const context_lease&)            = delete;
+    context_lease& operator=(const context_lease&) = delete;
+
+    ~context_lease()
+    {
+        if(owned != nullptr)
+            pool->busy = false;
+        else
+            pool->release(std::move(session));
+    }
+
+    std::vector<context>& get() { return owned != nullptr ? *owned : session; }
+
+    private:
+    std::shared_ptr<session_pool> pool;
+    std::vector<context>* owned = nullptr;
+    std::vector<context> session;
+};
+
+// Fixed size buffer of the instructions run by eval. Writers claim a slot with an atomic counter
+// and publish it with the slot's sequence number, so recording never locks or waits on the device,
+// and the oldest events are overwritten once the buffer is full.
+struct trace_buffer
+{
+    struct event
+    {
+        instruction_ref ins;
+        std::size_t run       = 0;
+        std::int64_t start    = 0;
+        std::int64_t duration = 0;
+    };
+
+    struct slot
+    {
+        // Zero while empty or being written, otherwise one past the index of the event
+        std::atomic<std::size_t> seq{0};
+        event e;
+    };
+
+    explicit trace_buffer(std::size_t n) : slots(n) {}
+
+    std::vector<slot> slots;
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> runs{0};
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+    std::int64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - origin)
+            .count();
+    }
+
+    std::size_t next_run() { return runs.fetch_add(1, std::memory_order_relaxed); }
+
+    void record(const event& e)
+    {
+        auto i  = head.fetch_add(1, std::memory_order_relaxed);
+        auto& s = slots[i % slots.size()];
+        s.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.e = e;
+        s.seq.store(i + 1, std::memory_order_release);
+    }
+
+    // Events that were completely written, oldest first
+    std::vector<event> snapshot() const
+    {
+        std::vector<std::pair<std::size_t, event>> events;
+        for(const auto& s : slots)
+        {
+            auto seq = s.seq.load(std::memory_order_acquire);
+            if(seq == 0)
+                continue;
+            auto e = s.e;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(s.seq.load(std::memory_order_relaxed) != seq)
+                continue;
+            events.emplace_back(seq, e);
+        }
+        std::sort(events.begin(), events.end(), [](const auto& x, const auto& y) {
+            return x.first < y.first;
+        });
+        std::vector<event> result;
+        std::transform(events.begin(),
+                       events.end(),
+                       std::back_inserter(result),
+                       [](const auto& x) { return x.second; });
+        return result;
+    }
+};
+
+std::shared_ptr<trace_buffer> make_trace_buffer(std::size_t n)
+{
+    if(n == 0)
+        return nullptr;
+    return std::make_shared<trace_buffer>(n);
+}
+
 struct program_impl
 {
     // A map is used to keep references to modules of the program
     std::unordered_map<std::string, module> modules;
     std::vector<context> contexts;
     std::vector<target> targets;
+    std::shared_ptr<execution_plan> plan = nullptr;
+    weight_map weights;
+    bound_parameters bound;
+    std::shared_ptr<session_pool> sessions = std::make_shared<session_pool>();
+    std::shared_ptr<trace_buffer> trace =
+        make_trace_buffer(value_of(MIGRAPHX_TRACE_EVAL_BUFFER{}));
 };
 
 program::program() : impl(std::make_unique<program_impl>()) { this->create_module("main"); }
@@ -99,6 +316,14 @@ void program::assign(const program& p)
     }
 
     *impl = *p.impl;
+    // The plan refers to the instructions of the other program
+    impl->plan = nullptr;
+    // The bound buffers would be shared with the other program
+    impl->bound = {};
+    // The sessions were created from the contexts of the other program
+    impl->sessions = std::make_shared<session_pool>();
+    // Each program records its own trace
+    impl->trace = make_trace_buffer(value_of(MIGRAPHX_TRACE_EVAL_BUFFER{}));
 
     // build a map from old ins to new ins
     // Build a map from old module to new module
@@ -127,6 +352,9 @@ void program::assign(const program& p)
         for(auto ins : iterator_for(mp.second))
             instruction::replace_refs(ins, ins_map, mod_map);
     }
+
+    if(p.impl->plan != nullptr)
+        this->create_execution_plan();
 }
 
 shape program::get_parameter_shape(std::string name) const
@@ -188,6 +416,16 @@ target_assignments program::get_target_assignments(const std::vector<target>& ta
                    std::back_inserter(target_subgraphs),
                    [&](const auto& t) { return std::make_pair(t, t.find_supported(mod, m)); });
 
+    if(options.minimize_cost)
+    {
+        std::vector<std::pair<std::string, supported_segments>> named_subgraphs;
+        std::transform(target_subgraphs.begin(),
+                       target_subgraphs.end(),
+                       std::back_inserter(named_subgraphs),
+                       [](const auto& ts) { return std::make_pair(ts.first.name(), ts.second); });
+        return partition_targets(mod, named_subgraphs, options);
+    }
+
     for(const auto ins : iterator_for(*mod))
     {
         if(contains(p, ins))
@@ -220,6 +458,10 @@ bool program::is_compiled() const { return not this->impl->contexts.empty(); }
 
 void program::compile(const std::vector<target>& targets, std::vector<compile_options> compile_opts)
 {
+    static auto& compiles = get_metric_counter("compile");
+    compiles.add();
+    if(compile_profile_enabled())
+        reset_compile_profile();
     // Gather all the target roots
     std::unordered_multimap<std::size_t, module_ref> roots;
     auto mods = this->get_modules();
@@ -301,22 +543,68 @@ void program::compile(const std::vector<target>& targets, std::vector<compile_op
         }
     }
     this->finalize();
+    save_compile_profile();
+}
+
+// The position right after the first pass with the name, or the default when no name is given
+static std::vector<pass>::const_iterator find_pass_boundary(const std::vector<pass>& passes,
+                                                            const std::string& name,
+                                                            std::vector<pass>::const_iterator def)
+{
+    if(name.empty())
+        return def;
+    auto it = std::find_if(
+        passes.begin(), passes.end(), [&](const pass& p) { return p.name() == name; });
+    if(it == passes.end())
+        MIGRAPHX_THROW("COMPILE: No pass named " + name);
+    return std::next(it);
+}
+
+void program::save_checkpoint(const std::string& filename) const
+{
+    if(filename.empty())
+        MIGRAPHX_THROW("COMPILE: No file given for the checkpoint");
+    // Saved without the targets, so it is loaded as a program that still needs to be compiled
+    program snapshot = *this;
+    snapshot.impl->targets.clear();
+    snapshot.impl->contexts.clear();
+    save(snapshot, filename);
 }
 
 void program::compile(const target& t, compile_options options)
 {
+    static auto& compiles = get_metric_counter("compile");
+    compiles.add();
+    if(compile_profile_enabled())
+        reset_compile_profile();
     // todo: combine with multi-target compile method
     assert(not this->is_compiled());
     this->impl->targets  = {t};
     this->impl->contexts = {t.get_context()};
 
     if(enabled(MIGRAPHX_TRACE_COMPILE{}))
-        options.trace = tracer{std::cout};
+        options.trace.print_to(std::cout);
 
     options.trace(*this);
     options.trace();
+    weight_map weights;
+    if(options.record_weights)
+        weights = weight_map::from_source(*this);
     auto&& passes = t.get_passes(this->impl->contexts.front(), options);
-    run_passes(*this, passes, options.trace);
+    auto resume   = find_pass_boundary(passes, options.resume_pass, passes.cbegin());
+    auto stop     = find_pass_boundary(passes, options.checkpoint_pass, passes.cend());
+    if(stop < resume)
+        MIGRAPHX_THROW("COMPILE: Checkpoint pass " + options.checkpoint_pass +
+                       " runs before the resume pass " + options.resume_pass);
+    run_passes(*this, std::vector<pass>(resume, stop), options.trace);
+    if(not options.checkpoint_pass.empty())
+        this->save_checkpoint(options.checkpoint_file);
+    run_passes(*this, std::vector<pass>(stop, passes.cend()), options.trace);
+    if(options.record_weights)
+    {
+        weights.locate(*this);
+        this->impl->weights = std::move(weights);
+    }
     auto mods = this->get_modules();
     // Validate and finalize
     for(const auto& mod : reverse(mods))
@@ -336,12 +624,84 @@ void program::compile(const target& t, compile_options options)
         }
         mod->finalize(this->impl->contexts);
     }
+    this->create_execution_plan();
+    save_compile_profile();
+}
+
+bool program::update_weights(const program& p)
+{
+    if(not this->impl->weights.update(*this, this->impl->contexts, p))
+        return false;
+    this->create_execution_plan();
+    return true;
 }
 
 void program::finalize()
 {
     auto* mm = this->get_main_module();
     mm->finalize(this->impl->contexts);
+    this->create_execution_plan();
+}
+
+void program::create_execution_plan()
+{
+    impl->plan = nullptr;
+    // Sessions created before the program was finalized again would miss its literals
+    impl->sessions = std::make_shared<session_pool>();
+    if(enabled(MIGRAPHX_DISABLE_EXECUTION_PLAN{}))
+        return;
+    auto* mm  = this->get_main_module();
+    auto plan   = std::make_shared<execution_plan>();
+    auto& slots = plan->slots;
+    plan->steps.reserve(mm->size());
+    for(auto ins : iterator_for(*mm))
+    {
+        if(ins->name() == "@return")
+        {
+            std::transform(ins->inputs().begin(),
+                           ins->inputs().end(),
+                           std::back_inserter(plan->outputs),
+                           [&](instruction_ref i) { return slots.at(i); });
+            break;
+        }
+        execution_plan::step s;
+        s.ins = ins;
+        if(ins->name() == "@literal")
+        {
+            s.kind   = execution_plan::step_kind::literal;
+            s.result = ins->get_literal().get_argument();
+        }
+        else if(ins->name() == "@param")
+        {
+            s.kind      = execution_plan::step_kind::param;
+            s.parameter = any_cast<builtin::param>(ins->get_operator()).parameter;
+        }
+        else if(ins->name() == "@outline")
+        {
+            s.kind = execution_plan::step_kind::outline;
+        }
+        else
+        {
+            s.op = ins->normalized_operator();
+            if(ins->get_shape().any_of_dynamic() and ins->module_inputs().empty())
+                s.dynamic_shapes = std::make_shared<execution_plan::shape_cache>();
+            std::transform(ins->inputs().begin(),
+                           ins->inputs().end(),
+                           std::back_inserter(s.inputs),
+                           [&](instruction_ref i) { return slots.at(i); });
+            plan->max_inputs = std::max(plan->max_inputs, s.inputs.size());
+        }
+        slots[ins] = plan->steps.size();
+        plan->steps.push_back(std::move(s));
+    }
+    if(plan->steps.empty())
+        return;
+    if(std::none_of(mm->begin(), mm->end(), [](const instruction& ins) {
+           return ins.name() == "@return";
+       }))
+        plan->outputs = {plan->steps.size() - 1};
+    plan->changed = mm->track_changes();
+    impl->plan    = plan;
 }
 
 template <class T>
@@ -453,15 +813,31 @@ static bool is_compatible_shape(const shape& actual, const shape& expected)
 }
 #endif
 
+// Looks up the results of the instructions of the enclosing modules, which a submodule can refer
+// to, and returns nullptr for the ones that haven't been evaluated
+using outer_results = std::function<const argument*(instruction_ref)>;
+
 template <class F>
 std::vector<argument> generic_eval(const module* mod,
                                    std::vector<context>& ctx,
                                    std::unordered_map<std::string, argument> params,
-                                   std::unordered_map<instruction_ref, argument> results,
+                                   const outer_results& outer,
                                    F trace)
 {
     assert(mod->validate() == mod->end());
+    std::unordered_map<instruction_ref, argument> results;
     results.reserve(mod->size() * 2);
+    auto find_result = [&](instruction_ref i) -> const argument* {
+        auto it = results.find(i);
+        if(it != results.end())
+            return &it->second;
+        return outer ? outer(i) : nullptr;
+    };
+    auto get_result = [&](instruction_ref i) {
+        const auto* r = find_result(i);
+        assert(r != nullptr);
+        return r == nullptr ? argument{} : *r;
+    };
     std::vector<argument> values;
     values.reserve(16);
     for(auto ins : iterator_for(*mod))
@@ -501,25 +877,18 @@ std::vector<argument> generic_eval(const module* mod,
             std::transform(ins->inputs().begin(),
                            ins->inputs().end(),
                            std::back_inserter(prog_outputs),
-                           [&](instruction_ref i) {
-                               assert(results.find(i) != results.end());
-                               return results[i];
-                           });
+                           get_result);
 
             return prog_outputs;
         }
         else
         {
             values.resize(ins->inputs().size());
-            std::transform(
-                ins->inputs().begin(), ins->inputs().end(), values.begin(), [&](instruction_ref i) {
-                    assert(results.find(i) != results.end());
-                    return results[i];
-                });
+            std::transform(ins->inputs().begin(), ins->inputs().end(), values.begin(), get_result);
             const auto& mod_args = ins->module_inputs();
             auto module_eval     = [&](module_ref smod,
                                    const std::unordered_map<std::string, argument>& inputs) {
-                return generic_eval(smod, ctx, inputs, results, trace);
+                return generic_eval(smod, ctx, inputs, find_result, trace);
             };
 
             results.emplace(
@@ -539,6 +908,126 @@ std::vector<argument> generic_eval(const module* mod,
     return {results.at(std::prev(mod->end()))};
 }
 
+static argument get_plan_parameter(const execution_plan::step& s,
+                                   const std::unordered_map<std::string, argument>& params)
+{
+    auto it = params.find(s.parameter);
+    if(it == params.end())
+        MIGRAPHX_THROW("Parameter not found: " + s.parameter);
+    const auto& param = it->second;
+    if(not s.ins->get_shape().any_of_dynamic() and param.get_shape() != s.ins->get_shape())
+    {
+        MIGRAPHX_THROW("Incorrect shape {" + to_string(param.get_shape()) +
+                       "} for parameter: " + s.parameter +
+                       " should be: " + to_string(s.ins->get_shape()));
+    }
+    return param;
+}
+
+// Resolve the output shape of a dynamic step, which is passed to compute so the op doesn't compute
+// it again. Repeated calls with the same input shapes skip the shape computation.
+static shape get_plan_output_shape(const execution_plan::step& s,
+                                   const std::vector<argument>& values)
+{
+    if(s.dynamic_shapes == nullptr)
+        return s.ins->get_shape();
+    auto& cache = *s.dynamic_shapes;
+    std::lock_guard<std::mutex> lock(cache.m);
+    auto same_shape = [](const argument& a, const shape& x) { return a.get_shape() == x; };
+    if(cache.resolved and std::equal(values.begin(),
+                                     values.end(),
+                                     cache.inputs.begin(),
+                                     cache.inputs.end(),
+                                     same_shape))
+        return cache.output;
+    cache.inputs   = to_shapes(values);
+    cache.resolved = true;
+    try
+    {
+        cache.output = s.op.compute_shape(cache.inputs);
+    }
+    catch(const std::exception&)
+    {
+        // Let the op handle the dynamic shape itself
+        cache.output = s.ins->get_shape();
+    }
+    if(cache.output.any_of_dynamic())
+        cache.output = s.ins->get_shape();
+    return cache.output;
+}
+
+template <class F>
+void plan_compute(const execution_plan& plan,
+                  std::size_t i,
+                  std::vector<context>& ctx,
+                  std::vector<argument>& results,
+                  std::vector<argument>& values,
+                  F trace)
+{
+    const auto& s = plan.steps[i];
+    values.clear();
+    std::transform(s.inputs.begin(),
+                   s.inputs.end(),
+                   std::back_inserter(values),
+                   [&](std::size_t j) { return results[j]; });
+    const auto& mod_args = s.ins->module_inputs();
+    // Submodules can refer to any instruction evaluated before it, which are looked up through
+    // the slots of the plan instead of being copied into a map for every call
+    auto find_result = [&](instruction_ref x) -> const argument* {
+        auto it = plan.slots.find(x);
+        if(it == plan.slots.end() or it->second >= i)
+            return nullptr;
+        return &results[it->second];
+    };
+    auto module_eval = [&](module_ref smod,
+                           const std::unordered_map<std::string, argument>& inputs) {
+        return generic_eval(smod, ctx, inputs, find_result, trace);
+    };
+    auto output_shape = get_plan_output_shape(s, values);
+    results[i]        = trace(s.ins, [&] {
+        if(s.op.is_context_free())
+            return s.op.compute(output_shape, values, mod_args, module_eval);
+        if(s.ins->get_target_id() >= ctx.size())
+            MIGRAPHX_THROW("No context available for " + s.op.name());
+        return s.op.compute(
+            ctx[s.ins->get_target_id()], output_shape, values, mod_args, module_eval);
+    });
+    assert(is_compatible_shape(results[i].get_shape(), s.ins->get_shape()));
+}
+
+template <class F>
+std::vector<argument> plan_eval(const execution_plan& plan,
+                                std::vector<context>& ctx,
+                                const std::unordered_map<std::string, argument>& params,
+                                F trace)
+{
+    std::vector<argument> results(plan.steps.size());
+    std::vector<argument> values;
+    values.reserve(plan.max_inputs);
+    for(std::size_t i = 0; i < plan.steps.size(); i++)
+    {
+        const auto& s = plan.steps[i];
+        switch(s.kind)
+        {
+        case execution_plan::step_kind::literal: results[i] = s.result; break;
+        case execution_plan::step_kind::outline:
+            results[i] = argument{s.ins->get_shape(), nullptr};
+            break;
+        case execution_plan::step_kind::param: results[i] = get_plan_parameter(s, params); break;
+        case execution_plan::step_kind::compute:
+            plan_compute(plan, i, ctx, results, values, trace);
+            break;
+        }
+    }
+    std::vector<argument> outputs;
+    outputs.reserve(plan.outputs.size());
+    std::transform(plan.outputs.begin(),
+                   plan.outputs.end(),
+                   std::back_inserter(outputs),
+                   [&](std::size_t j) { return results[j]; });
+    return outputs;
+}
+
 template <class F>
 std::vector<argument> generic_eval(const program& p,
                                    std::vector<context>& ctx,
@@ -546,19 +1035,34 @@ std::vector<argument> generic_eval(const program& p,
                                    F trace)
 {
     const module* mm = p.get_main_module();
-    return generic_eval(mm, ctx, params, {}, trace);
+    return generic_eval(mm, ctx, params, nullptr, trace);
+}
+
+bool program::has_execution_plan() const
+{
+    return impl->plan != nullptr and not impl->plan->changed();
 }
 
 std::vector<argument> program::eval_with_context(std::vector<context>& ctx,
                                                  parameter_map params) const
 {
+    auto no_trace = [](auto&&, auto f) { return f(); };
+    if(this->has_execution_plan())
+        return plan_eval(*impl->plan, ctx, params, no_trace);
     const module* mm = this->get_main_module();
-    return generic_eval(mm, ctx, std::move(params), {}, [](auto&&, auto f) { return f(); });
+    return generic_eval(mm, ctx, std::move(params), nullptr, no_trace);
 }
 
 std::vector<argument> program::eval(parameter_map params, execution_environment exec_env) const
 {
-    auto& contexts = this->impl->contexts;
+    static auto& evals        = get_metric_counter("eval");
+    static auto& eval_latency = get_metric_histogram("eval_latency_us");
+    auto eval_start           = std::chrono::steady_clock::now();
+
+    context_lease lease{this->impl->sessions, this->impl->contexts};
+    auto& contexts = lease.get();
+    for(auto& ctx : contexts)
+        ctx.set_priority(exec_env.priority);
 
     auto trace_level = value_of(MIGRAPHX_TRACE_EVAL{});
     std::vector<argument> ret;
@@ -623,6 +1127,27 @@ std::vector<argument> program::eval(parameter_map params, execution_environment
             return result;
         });
     }
+    else if(impl->trace != nullptr)
+    {
+        // Only the launch is timed, the device is never synchronized
+        auto& trace = *impl->trace;
+        auto run    = trace.next_run();
+        auto record = [&](instruction_ref ins, auto f) {
+            auto start  = trace.now();
+            auto result = f();
+            if(ins->name().front() != '@')
+                trace.record({ins, run, start, trace.now() - start});
+            return result;
+        };
+        if(this->has_execution_plan())
+            ret = plan_eval(*impl->plan, contexts, params, record);
+        else
+            ret = generic_eval(*this, contexts, std::move(params), record);
+    }
+    else if(this->has_execution_plan())
+    {
+        ret = plan_eval(*impl->plan, contexts, params, [&](auto&&, auto f) { return f(); });
+    }
     else
     {
         ret = generic_eval(*this, contexts, std::move(params), [&](auto&&, auto f) { return f(); });
@@ -632,17 +1157,311 @@ std::vector<argument> program::eval(parameter_map params, execution_environment
     {
         assert(contexts.size() == 1);
         contexts.front().finish_on(exec_env.queue);
+        if(exec_env.on_complete != nullptr)
+            contexts.front().on_finish(exec_env.queue, exec_env.on_complete);
+    }
+    else if(exec_env.on_complete != nullptr)
+    {
+        for(const auto& ctx : contexts)
+            ctx.finish();
+        exec_env.on_complete();
     }
 
+    evals.add();
+    eval_latency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - eval_start)
+                            .count());
     return ret;
 }
 
+// Lets the micro-batches through a run_on_target instruction one at a time and in order
+struct pipeline_stage
+{
+    std::size_t target_id = 0;
+    std::size_t next      = 0;
+    std::mutex m;
+    std::condition_variable cv;
+
+    template <class F>
+    argument run(std::size_t batch, std::mutex& target_lock, F f)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return next == batch; });
+        argument result;
+        {
+            std::lock_guard<std::mutex> guard(target_lock);
+            result = f();
+        }
+        next++;
+        cv.notify_all();
+        return result;
+    }
+
+    // Skip the stage for a micro-batch that did not run it, such as one that failed earlier
+    void release(std::size_t batch)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return next >= batch; });
+        if(next != batch)
+            return;
+        next++;
+        cv.notify_all();
+    }
+};
+
+std::vector<std::vector<argument>>
+program::eval_pipeline(std::vector<parameter_map> micro_batches) const
+{
+    auto& contexts = this->impl->contexts;
+    const auto* mm = this->get_main_module();
+    std::unordered_map<instruction_ref, pipeline_stage> stages;
+    for(auto ins : iterator_for(*mm))
+    {
+        if(ins->name() != "run_on_target")
+            continue;
+        stages[ins].target_id = ins->get_operator().to_value().at("target_id").to<std::size_t>();
+    }
+    std::vector<std::vector<argument>> results(micro_batches.size());
+    // Without stages the micro-batches would share the same contexts, so run them one by one
+    if(stages.empty())
+    {
+        std::transform(micro_batches.begin(),
+                       micro_batches.end(),
+                       results.begin(),
+                       [&](auto& params) { return this->eval(std::move(params)); });
+        return results;
+    }
+
+    std::vector<std::mutex> target_locks(contexts.size());
+    std::atomic<std::size_t> next_batch{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error = nullptr;
+    std::mutex error_lock;
+    auto worker = [&] {
+        for(auto b = next_batch++; b < micro_batches.size(); b = next_batch++)
+        {
+            try
+            {
+                if(not failed)
+                {
+                    results[b] = generic_eval(
+                        *this, contexts, std::move(micro_batches[b]), [&](auto ins, auto f) {
+                            auto it = stages.find(ins);
+                            if(it == stages.end())
+                                return f();
+                            auto& stage = it->second;
+                            return stage.run(b, target_locks.at(stage.target_id), f);
+                        });
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(error_lock);
+                if(error == nullptr)
+                    error = std::current_exception();
+                failed = true;
+            }
+            for(auto& [ins, stage] : stages)
+                stage.release(b);
+        }
+    };
+    // More workers than stages can't keep more of the pipeline busy
+    std::vector<std::thread> threads;
+    auto nthreads = std::min(stages.size(), micro_batches.size());
+    std::generate_n(std::back_inserter(threads), nthreads, [&] { return std::thread{worker}; });
+    for(auto& t : threads)
+        t.join();
+    if(error != nullptr)
+        std::rethrow_exception(error);
+    for(auto& ctx : contexts)
+        ctx.finish();
+    return results;
+}
+
+std::vector<std::vector<argument>> program::eval_many(std::vector<parameter_map> requests,
+                                                      std::size_t depth,
+                                                      const result_callback& on_result) const
+{
+    std::vector<std::vector<argument>> results(requests.size());
+    std::atomic<std::size_t> next_request{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error = nullptr;
+    std::mutex error_lock;
+    std::mutex result_lock;
+    auto worker = [&] {
+        for(auto r = next_request++; r < requests.size() and not failed; r = next_request++)
+        {
+            try
+            {
+                auto result = this->eval(std::move(requests[r]));
+                if(on_result == nullptr)
+                {
+                    results[r] = std::move(result);
+                    continue;
+                }
+                std::lock_guard<std::mutex> guard(result_lock);
+                on_result(r, std::move(result));
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(error_lock);
+                if(error == nullptr)
+                    error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+    // Every worker after the first evaluates with its own session contexts, which are kept by the
+    // program for the next call
+    std::vector<std::thread> threads;
+    auto nthreads = std::min(std::max<std::size_t>(depth, 1), requests.size());
+    std::generate_n(std::back_inserter(threads), nthreads, [&] { return std::thread{worker}; });
+    for(auto& t : threads)
+        t.join();
+    if(error != nullptr)
+        std::rethrow_exception(error);
+    return results;
+}
+
+void program::bind(parameter_map params)
+{
+    auto& b  = impl->bound;
+    b        = {};
+    b.params = std::move(params);
+    if(not this->has_execution_plan())
+        return;
+    const auto& plan = *impl->plan;
+    b.results.resize(plan.steps.size());
+    for(std::size_t i = 0; i < plan.steps.size(); i++)
+    {
+        const auto& s = plan.steps[i];
+        switch(s.kind)
+        {
+        case execution_plan::step_kind::literal: b.results[i] = s.result; break;
+        case execution_plan::step_kind::outline:
+            b.results[i] = argument{s.ins->get_shape(), nullptr};
+            break;
+        case execution_plan::step_kind::param:
+            b.results[i] = get_plan_parameter(s, b.params);
+            break;
+        case execution_plan::step_kind::compute: b.compute.push_back(i); break;
+        }
+    }
+    b.values.reserve(plan.max_inputs);
+    b.outputs.resize(plan.outputs.size());
+    b.plan = impl->plan;
+}
+
+std::vector<argument>& program::run_bound()
+{
+    auto& b = impl->bound;
+    // Fall back to a full eval when the program changed after it was bound
+    if(b.plan == nullptr or b.plan != impl->plan or b.plan->changed())
+    {
+        b.outputs = this->eval(b.params);
+        return b.outputs;
+    }
+    auto no_trace = [](auto&&, auto f) { return f(); };
+    for(auto i : b.compute)
+        plan_compute(*b.plan, i, impl->contexts, b.results, b.values, no_trace);
+    for(std::size_t j = 0; j < b.outputs.size(); j++)
+        b.outputs[j] = b.results[b.plan->outputs[j]];
+    return b.outputs;
+}
+
+program program::create_session() const
+{
+    program result = *this;
+    std::transform(impl->contexts.begin(),
+                   impl->contexts.end(),
+                   result.impl->contexts.begin(),
+                   [](const context& ctx) { return ctx.create_session(); });
+    return result;
+}
+
+program program::create_replica(std::size_t device_id) const
+{
+    program result = *this;
+    std::transform(impl->contexts.begin(),
+                   impl->contexts.end(),
+                   result.impl->contexts.begin(),
+                   [&](const context& ctx) { return ctx.create_replica(device_id); });
+    // The replica is finalized with its device current, which is per thread, so it runs on its
+    // own thread and leaves the caller's current device alone. Getting a queue makes its device
+    // current.
+    std::async(std::launch::async, [&] {
+        for(auto& ctx : result.impl->contexts)
+            ctx.get_queue();
+        result.finalize();
+    }).get();
+    return result;
+}
+
+// Allocations that are not planned into the scratch buffer are made each time the program runs
+static bool is_eval_allocation(const instruction& ins)
+{
+    if(ins.get_shape().dynamic())
+        return false;
+    return ins.name() == "allocate" or ends_with(ins.name(), "::allocate");
+}
+
+value program::memory_report() const
+{
+    value result = value::object{};
+    auto add     = [&](const std::string& name, std::size_t bytes) {
+        result[name] = result.get(name, std::size_t{0}) + bytes;
+    };
+    for(const auto& ctx : impl->contexts)
+    {
+        for(const auto& x : ctx.memory_usage())
+            add(x.get_key(), x.to<std::size_t>());
+    }
+    std::size_t allocations = 0;
+    for(const auto* m : this->get_modules())
+    {
+        for(const auto& ins : *m)
+        {
+            if(is_eval_allocation(ins))
+                allocations += ins.get_shape().bytes();
+        }
+    }
+    add("allocations", allocations);
+    std::size_t total = 0;
+    for(const auto& x : result)
+        total += x.to<std::size_t>();
+    result["total"] = total;
+    return result;
+}
+
 void program::finish() const
 {
     for(const auto& ctx : this->impl->contexts)
         ctx.finish();
 }
 
+void program::enable_trace(std::size_t n) { impl->trace = make_trace_buffer(n); }
+
+void program::print_trace(std::ostream& os) const
+{
+    if(impl->trace == nullptr)
+        return;
+    std::unordered_map<instruction_ref, std::string> ins_out;
+    this->print([&](auto x, auto ins_names) {
+        std::stringstream ss;
+        instruction::print(ss, x, ins_names);
+        ins_out[x] = ss.str();
+    });
+    for(const auto& e : impl->trace->snapshot())
+    {
+        auto it = ins_out.find(e.ins);
+        if(it == ins_out.end())
+            continue;
+        os << "Run " << e.run << ": " << it->second << std::endl;
+        os << "Start: " << e.start / 1000.0 << "us, Launch: " << e.duration / 1000.0 << "us"
+           << std::endl;
+    }
+}
+
 std::string get_migraphx_version()
 {
     std::stringstream ss;
@@ -669,7 +1488,7 @@ value program::to_value() const
     for(auto& mod : this->get_modules())
     {
         value mod_val;
-        value nodes;
+        std::vector<value> nodes;
         mod_val["name"] = mod->name();
         names           = mod->print(
             [&](auto ins, auto ins_names) {
@@ -701,15 +1520,17 @@ value program::to_value() const
                     node["module_inputs"] = module_inputs;
                 }
 
-                nodes.push_back(node);
+                nodes.push_back(std::move(node));
             },
             names);
-        mod_val["nodes"] = nodes;
+        mod_val["nodes"] = value(std::move(nodes));
 
-        module_vals[mod->name()] = mod_val;
+        module_vals[mod->name()] = std::move(mod_val);
     }
 
-    result["modules"] = module_vals;
+    result["modules"] = std::move(module_vals);
+    if(not this->impl->weights.empty())
+        result["weights"] = migraphx::to_value(this->impl->weights);
 
     return result;
 }
@@ -723,14 +1544,14 @@ static void mod_from_val(module_ref mod,
     for(const value& node : module_val.at("nodes"))
     {
         instruction_ref output;
-        auto name       = node.at("name").to<std::string>();
-        auto fields     = node.at("operator");
-        auto normalized = node.at("normalized").to<bool>();
+        auto name          = node.at("name").to<std::string>();
+        const auto& fields = node.at("operator");
+        auto normalized    = node.at("normalized").to<bool>();
 
         if(name == "@param")
         {
             output = mod->insert_parameter(mod->end(),
-                                           fields["parameter"].to<std::string>(),
+                                           fields.at("parameter").to<std::string>(),
                                            migraphx::from_value<shape>(node.at("shape")));
         }
         else if(name == "@literal")
@@ -811,7 +1632,7 @@ void program::from_value(const value& v)
         this->impl->contexts.back().from_value(v.at("contexts")[i]);
     }
 
-    auto module_vals = v.at("modules");
+    const auto& module_vals = v.at("modules");
     for(const auto& vv : module_vals)
     {
         const auto& name = vv.get_key();
@@ -828,6 +1649,8 @@ void program::from_value(const value& v)
     std::unordered_map<std::string, instruction_ref> map_insts;
     auto* mm = get_main_module();
     mod_from_val(mm, module_vals, map_insts, map_mods);
+    if(v.contains("weights"))
+        migraphx::from_value(v.at("weights"), this->impl->weights);
 
     // Finalize a compiled model
     if(not this->impl->contexts.empty())
@@ -867,6 +1690,71 @@ std::string perf_group(instruction_ref ins, bool detailed)
     return result;
 }
 
+// Bytes read and written by an instruction. Instructions without inputs, and views that only
+// alias their input, don't move any data.
+std::size_t perf_bytes(instruction_ref ins)
+{
+    if(ins->inputs().empty() or starts_with(ins->name(), "@"))
+        return 0;
+    auto inputs = to_shapes(ins->inputs());
+    auto alias  = ins->get_operator().output_alias(inputs);
+    if(alias >= 0 and inputs.size() == 1)
+        return 0;
+    auto result = std::accumulate(inputs.begin(), inputs.end(), std::size_t{0}, [](auto n, auto s) {
+        return n + s.bytes();
+    });
+    if(alias < 0)
+        result += ins->get_shape().bytes();
+    return result;
+}
+
+struct roofline
+{
+    double peak_bandwidth = 0;
+    double peak_flops     = 0;
+
+    // Percent of the attainable flops at the arithmetic intensity, or of the peak bandwidth
+    // when there are no flops
+    double percent(double ms, std::size_t bytes, std::size_t flops) const
+    {
+        if(ms <= 0 or peak_bandwidth <= 0 or bytes == 0)
+            return 0;
+        auto bandwidth = bytes / (ms / 1000.0);
+        if(flops == 0 or peak_flops <= 0)
+            return 100.0 * bandwidth / peak_bandwidth;
+        auto intensity  = double(flops) / bytes;
+        auto attainable = std::min(peak_flops, intensity * peak_bandwidth);
+        return 100.0 * (flops / (ms / 1000.0)) / attainable;
+    }
+
+    void print(std::ostream& os, double ms, std::size_t bytes, std::size_t flops) const
+    {
+        if(ms <= 0 or bytes == 0)
+            return;
+        os << ", " << bytes / (ms * 1e6) << " GB/s";
+        if(flops > 0)
+            os << ", " << flops / (ms * 1e9) << " TFLOPs, " << double(flops) / bytes
+               << " flops/byte";
+        if(peak_bandwidth > 0)
+            os << ", " << std::round(percent(ms, bytes, flops)) << "% of roofline";
+    }
+};
+
+// Counters reported by the target for an instruction, such as the occupancy of its kernel
+static value perf_counters(instruction_ref ins)
+{
+    auto attr = ins->get_operator().attributes();
+    if(not attr.contains("counters"))
+        return value::object{};
+    return attr.at("counters");
+}
+
+static void print_counters(std::ostream& os, const value& counters)
+{
+    for(const auto& c : counters)
+        os << ", " << c.get_key() << ": " << c.without_key().to<std::string>();
+}
+
 void program::mark(const parameter_map& params, marker&& m)
 {
     auto& ctx = this->impl->contexts;
@@ -949,6 +1837,41 @@ void program::perf_report(
     double calculate_overhead_time    = total_time - total_instruction_time;
     double calculate_overhead_percent = calculate_overhead_time * 100.0 / total_time;
 
+    // Estimate the bytes and flops of each instruction for the roofline
+    std::unordered_map<instruction_ref, std::pair<std::size_t, std::size_t>> ins_work;
+    std::unordered_map<std::string, std::pair<std::size_t, std::size_t>> op_work;
+    for(auto&& p : ins_vec)
+    {
+        auto ins   = p.first;
+        auto bytes = perf_bytes(ins);
+        auto flops = ins->get_operator().flops(to_shapes(ins->inputs()));
+        ins_work[ins] = {bytes, flops};
+        auto& w = op_work[perf_group(ins, detailed)];
+        w.first += bytes;
+        w.second += flops;
+    }
+    // Average the counters of the instructions in a group weighted by their time
+    std::unordered_map<instruction_ref, value> ins_counters;
+    std::unordered_map<std::string, std::map<std::string, double>> op_counters;
+    for(auto&& p : ins_vec)
+    {
+        auto counters = perf_counters(p.first);
+        if(counters.empty())
+            continue;
+        auto avg   = common_average(p.second);
+        auto& sums = op_counters[perf_group(p.first, detailed)];
+        for(const auto& c : counters)
+            sums[c.get_key()] += avg * c.without_key().to<double>();
+        ins_counters[p.first] = counters;
+    }
+    std::vector<roofline> rooflines(ctx.size());
+    std::transform(ctx.begin(), ctx.end(), rooflines.begin(), [](const context& c) {
+        auto v = c.to_value();
+        return roofline{v.get("peak_bandwidth", 0.0), v.get("peak_flops", 0.0)};
+    });
+    // Groups can mix instructions of several targets, so they use the first one with peaks
+    auto summary_roofline = rooflines.empty() ? roofline{} : rooflines.front();
+
     std::unordered_map<instruction_ref, std::string> names;
     this->print(names, [&](auto ins, auto ins_names) {
         instruction::print(std::cout, ins, ins_names);
@@ -960,6 +1883,10 @@ void program::perf_report(
         double avg     = common_average(ins_vec[ins]);
         double percent = std::ceil(100.0 * avg / total_instruction_time);
         os << ": " << avg << "ms, " << percent << "%";
+        auto [bytes, flops] = ins_work[ins];
+        rooflines.at(ins->get_target_id()).print(os, avg, bytes, flops);
+        if(contains(ins_counters, ins))
+            print_counters(os, ins_counters.at(ins));
         os << std::endl;
     });
 
@@ -976,8 +1903,14 @@ void program::perf_report(
     {
         double percent = std::ceil(100.0 * avg / total_instruction_time);
         double per_ins = avg / nn;
-        os << name << ": " << avg << "ms / " << nn << " = " << per_ins << "ms, " << percent << "%"
-           << std::endl;
+        os << name << ": " << avg << "ms / " << nn << " = " << per_ins << "ms, " << percent << "%";
+        summary_roofline.print(os, avg, op_work[name].first, op_work[name].second);
+        if(contains(op_counters, name) and avg > 0)
+        {
+            for(auto&& [key, sum] : op_counters.at(name))
+                os << ", " << key << ": " << sum / avg;
+        }
+        os << std::endl;
     }
 
     os << std::endl;
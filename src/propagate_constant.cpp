@@ -26,15 +26,27 @@
 #include <migraphx/matcher.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/functional.hpp>
-#include <migraphx/simple_par_for.hpp>
+#include <migraphx/thread_pool.hpp>
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/content_hash.hpp>
+#include <migraphx/digest.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/msgpack.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/stringutils.hpp>
 #include <migraphx/env.hpp>
-#include <thread>
+#include <migraphx/version.h>
+#include <random>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_PROPAGATE_CONSTANT)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CONSTANT_FOLD_CACHE)
 
 bool skip_propagate(instruction_ref ins)
 {
@@ -67,6 +79,219 @@ argument as_packed(const argument& c)
     return result;
 }
 
+namespace {
+
+// Reads the literal in place, the ops only read their inputs
+argument literal_view(instruction_ref ins)
+{
+    const auto& l = ins->get_literal();
+    return {l.get_shape(), const_cast<char*>(l.data())}; // NOLINT
+}
+
+// Evaluates the roots wave by wave, where a wave holds the instructions whose inputs were all
+// computed by the earlier waves. Independent subgraphs run concurrently, and an instruction
+// shared by several roots is only evaluated once.
+std::vector<argument> eval_constants(const std::vector<instruction_ref>& roots)
+{
+    std::unordered_map<instruction_ref, std::size_t> depths;
+    std::unordered_map<instruction_ref, std::size_t> uses;
+    std::vector<std::vector<instruction_ref>> waves;
+    auto visit = fix<std::size_t>([&](auto self, instruction_ref ins) -> std::size_t {
+        if(ins->name() == "@literal")
+            return 0;
+        auto it = depths.find(ins);
+        if(it != depths.end())
+            return it->second;
+        std::size_t depth = 1;
+        for(auto input : ins->inputs())
+        {
+            depth = std::max(depth, self(input) + 1);
+            if(input->name() != "@literal")
+                uses[input]++;
+        }
+        depths[ins] = depth;
+        if(waves.size() < depth)
+            waves.resize(depth);
+        waves[depth - 1].push_back(ins);
+        return depth;
+    });
+    for(auto root : roots)
+        visit(root);
+
+    std::unordered_set<instruction_ref> root_set{roots.begin(), roots.end()};
+    std::unordered_map<instruction_ref, argument> results;
+    for(const auto& wave : waves)
+    {
+        std::vector<argument> wave_results(wave.size());
+        auto eval = [&](std::size_t i) {
+            auto ins = wave[i];
+            std::vector<argument> args;
+            std::transform(ins->inputs().begin(),
+                           ins->inputs().end(),
+                           std::back_inserter(args),
+                           [&](auto input) {
+                               if(input->name() == "@literal")
+                                   return literal_view(input);
+                               return results.at(input);
+                           });
+            wave_results[i] = ins->normalized_operator().compute(ins->get_shape(), args);
+        };
+        // A single large fold runs on this thread so the op itself can use the thread pool
+        if(wave.size() == 1)
+            eval(0);
+        else
+            get_thread_pool().run(wave.size(), eval);
+        for(auto i : range(wave.size()))
+            results[wave[i]] = std::move(wave_results[i]);
+        // Release the intermediate results once all their users have run
+        for(auto ins : wave)
+        {
+            for(auto input : ins->inputs())
+            {
+                if(input->name() == "@literal" or contains(root_set, input))
+                    continue;
+                if(--uses[input] == 0)
+                    results.erase(input);
+            }
+        }
+    }
+
+    std::vector<argument> output(roots.size());
+    get_thread_pool().run(roots.size(),
+                          [&](std::size_t i) { output[i] = as_packed(results.at(roots[i])); });
+    return output;
+}
+
+// Folded results smaller than this are cheaper to recompute than to read back
+constexpr std::size_t min_cached_bytes = 64 * 1024;
+
+// A directory of folded constants keyed by a digest of the subgraph computing them, including
+// the data of the literals it reads. Entries are written atomically so the directory can be
+// shared across processes.
+struct constant_cache
+{
+    fs::path dir;
+    std::unordered_map<instruction_ref, std::string> literal_keys = {};
+
+    // Hashes the literals read by the roots, which is the bulk of the work, in parallel
+    void hash_literals(const std::vector<instruction_ref>& roots)
+    {
+        std::vector<instruction_ref> lits;
+        std::unordered_set<instruction_ref> visited;
+        for(auto root : roots)
+        {
+            fix([&](auto self, instruction_ref ins) {
+                if(not visited.insert(ins).second)
+                    return;
+                if(ins->name() == "@literal")
+                    lits.push_back(ins);
+                for(auto input : ins->inputs())
+                    self(input);
+            })(root);
+        }
+        std::vector<literal> ls(lits.size());
+        std::transform(
+            lits.begin(), lits.end(), ls.begin(), [](auto ins) { return ins->get_literal(); });
+        compute_content_hashes(ls);
+        for(auto i : range(lits.size()))
+            literal_keys[lits[i]] = ls[i].content_hash();
+    }
+
+    std::string make_key(instruction_ref root) const
+    {
+        digest d;
+        d.update(std::to_string(MIGRAPHX_VERSION_MAJOR) + "." +
+                 std::to_string(MIGRAPHX_VERSION_MINOR) + "." +
+                 std::to_string(MIGRAPHX_VERSION_PATCH) + "." MIGRAPHX_VERSION_TWEAK);
+        // Instructions are numbered in the order they are hashed so the key doesn't depend on
+        // where the subgraph is in the module
+        std::unordered_map<instruction_ref, std::size_t> ids;
+        fix([&](auto self, instruction_ref ins) {
+            if(contains(ids, ins))
+                return;
+            for(auto input : ins->inputs())
+                self(input);
+            d.update(ins->name());
+            d.update(to_string(ins->get_shape()));
+            if(ins->name() == "@literal")
+            {
+                d.update(literal_keys.at(ins));
+            }
+            else
+            {
+                auto v = to_msgpack(ins->get_operator().to_value());
+                d.update({v.data(), v.size()});
+            }
+            d.update(std::to_string(ins->inputs().size()));
+            for(auto input : ins->inputs())
+                d.update(std::to_string(ids.at(input)));
+            auto id = ids.size();
+            ids.emplace(ins, id);
+        })(root);
+        return d.str();
+    }
+
+    fs::path entry(const std::string& key) const { return dir / (key + ".lit"); }
+
+    optional<argument> load(const std::string& key) const
+    {
+        auto p = entry(key);
+        std::error_code ec;
+        if(not fs::exists(p, ec))
+            return nullopt;
+        try
+        {
+            auto v        = from_msgpack(read_buffer(p));
+            auto s        = from_value<shape>(v.at("shape"));
+            const auto& b = v.at("data").get_binary();
+            if(b.size() != s.bytes())
+                return nullopt;
+            argument result{s};
+            std::copy(b.begin(), b.end(), result.data());
+            return result;
+        }
+        catch(...)
+        {
+            // A truncated or corrupt entry is treated as a miss and overwritten
+            return nullopt;
+        }
+    }
+
+    void store(const std::string& key, const argument& a) const
+    {
+        std::error_code ec;
+        fs::create_directories(dir, ec);
+        if(ec)
+            return;
+        // Write to a unique file first and rename it so that concurrent readers never see a
+        // partially written entry
+        std::mt19937_64 rg{std::random_device{}()};
+        auto tmp = dir / (key + ".tmp-" + std::to_string(rg()));
+        try
+        {
+            write_buffer(tmp, to_msgpack(to_value(a)));
+        }
+        catch(...)
+        {
+            fs::remove(tmp, ec);
+            return;
+        }
+        fs::rename(tmp, entry(key), ec);
+        if(ec)
+            fs::remove(tmp, ec);
+    }
+};
+
+optional<constant_cache> get_constant_cache(const std::string& cache_dir)
+{
+    auto d = cache_dir.empty() ? string_value_of(MIGRAPHX_CONSTANT_FOLD_CACHE{}) : cache_dir;
+    if(d.empty())
+        return nullopt;
+    return constant_cache{d};
+}
+
+} // namespace
+
 void propagate_constant::apply(module& m) const
 {
     std::unordered_set<instruction_ref> const_instrs;
@@ -94,17 +319,60 @@ void propagate_constant::apply(module& m) const
         }
     }
 
-    // Compute literals in parallel
     std::vector<instruction_ref> const_instrs_vec{const_instrs.begin(), const_instrs.end()};
     std::vector<argument> literals(const_instrs_vec.size());
-    std::size_t grainsize = 1;
-#if !MIGRAPHX_HAS_EXECUTORS
-    std::size_t n = std::max<std::size_t>(2048 / std::thread::hardware_concurrency(), 1);
-    grainsize     = const_instrs_vec.size() / n;
-#endif
-    simple_par_for(const_instrs_vec.size(), grainsize, [&](const auto i) {
-        literals[i] = as_packed(const_instrs_vec[i]->eval());
-    });
+
+    // Look up the large folds in the cache first
+    auto cache = get_constant_cache(cache_dir);
+    std::vector<std::string> keys(const_instrs_vec.size());
+    if(cache)
+    {
+        auto is_large = [](instruction_ref ins) {
+            return ins->get_shape().bytes() >= min_cached_bytes;
+        };
+        std::vector<instruction_ref> cached_roots;
+        std::copy_if(const_instrs_vec.begin(),
+                     const_instrs_vec.end(),
+                     std::back_inserter(cached_roots),
+                     is_large);
+        compile_profile_scope profile{"propagate_constant", "load_cache"};
+        cache->hash_literals(cached_roots);
+        std::size_t hits = 0;
+        for(auto i : range(const_instrs_vec.size()))
+        {
+            if(not is_large(const_instrs_vec[i]))
+                continue;
+            keys[i] = cache->make_key(const_instrs_vec[i]);
+            if(auto a = cache->load(keys[i]))
+            {
+                literals[i] = *a;
+                hits++;
+            }
+        }
+        profile.add("roots", cached_roots.size());
+        profile.add("hits", hits);
+    }
+
+    // Compute the remaining literals in parallel
+    std::vector<std::size_t> missing;
+    std::vector<instruction_ref> roots;
+    for(auto i : range(const_instrs_vec.size()))
+    {
+        if(not literals[i].empty())
+            continue;
+        missing.push_back(i);
+        roots.push_back(const_instrs_vec[i]);
+    }
+    compile_profile_scope profile{"propagate_constant", "eval"};
+    profile.add("roots", roots.size());
+    auto results = eval_constants(roots);
+    for(auto j : range(missing.size()))
+    {
+        auto i      = missing[j];
+        literals[i] = std::move(results[j]);
+        if(cache and not keys[i].empty() and not literals[i].empty())
+            cache->store(keys[i], literals[i]);
+    }
 
     // Replace instructions in m
     for(size_t i = 0; i < const_instrs_vec.size(); i++)
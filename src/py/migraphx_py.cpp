@@ -26,6 +26,7 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 #include <migraphx/program.hpp>
+#include <migraphx/replica_runner.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/operation.hpp>
 #include <migraphx/quantization.hpp>
@@ -40,12 +41,14 @@
 #include <migraphx/register_target.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/op/common.hpp>
 #include <migraphx/float8.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/version.h>
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
+#include <migraphx/gpu/device_name.hpp>
 #endif
 
 using half   = half_float::half;
@@ -180,6 +183,17 @@ struct npy_format_descriptor<migraphx::fp8::fp8e5m2>
     static constexpr auto name() { return _("fp8e5m2"); }
 };
 
+template <>
+struct npy_format_descriptor<migraphx::bf16>
+{
+    static std::string format()
+    {
+        // TODO: no standard format in numpy for bf16
+        return "z";
+    }
+    static constexpr auto name() { return _("bf16"); }
+};
+
 } // namespace detail
 } // namespace pybind11
 
@@ -277,6 +291,260 @@ migraphx::shape to_shape(const py::buffer_info& info)
     }
 }
 
+// The DLPack structures, which are a stable ABI shared by the frameworks that exchange tensors
+namespace dlpack {
+
+enum device_type : int32_t
+{
+    cpu  = 1,
+    rocm = 10,
+};
+
+enum type_code : uint8_t
+{
+    int_code   = 0,
+    uint_code  = 1,
+    float_code = 2,
+    bf16_code  = 4,
+    bool_code  = 6,
+};
+
+struct device
+{
+    int32_t device_type;
+    int32_t device_id;
+};
+
+struct data_type
+{
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+};
+
+struct tensor
+{
+    void* data;
+    device dev;
+    int32_t ndim;
+    data_type dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+};
+
+struct managed_tensor
+{
+    tensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(managed_tensor*);
+};
+
+} // namespace dlpack
+
+// Returns zero bits for the types that have no DLPack equivalent
+dlpack::data_type to_dlpack_type(migraphx::shape::type_t t)
+{
+    dlpack::data_type result{0, 0, 1};
+    if(t == migraphx::shape::tuple_type)
+        return result;
+    migraphx::shape::visit(t, [&](auto as) {
+        using type  = decltype(as());
+        result.bits = static_cast<uint8_t>(sizeof(type) * 8);
+        if(t == migraphx::shape::bool_type)
+            result.code = dlpack::bool_code;
+        else if(t == migraphx::shape::half_type or t == migraphx::shape::float_type or
+                t == migraphx::shape::double_type)
+            result.code = dlpack::float_code;
+        else if(t == migraphx::shape::bf16_type)
+            result.code = dlpack::bf16_code;
+        else if(std::is_integral<type>{} and std::is_signed<type>{})
+            result.code = dlpack::int_code;
+        else if(std::is_integral<type>{})
+            result.code = dlpack::uint_code;
+        else
+            result.bits = 0;
+    });
+    return result;
+}
+
+migraphx::shape::type_t from_dlpack_type(dlpack::data_type dtype)
+{
+    if(dtype.lanes == 1)
+    {
+        for(auto t : migraphx::shape::types())
+        {
+            auto candidate = to_dlpack_type(t);
+            if(candidate.bits == dtype.bits and candidate.code == dtype.code and dtype.bits != 0)
+                return t;
+        }
+    }
+    MIGRAPHX_THROW("MIGRAPHX PYTHON: Unsupported DLPack data type code " +
+                   std::to_string(dtype.code) + " with " + std::to_string(dtype.bits) + " bits");
+}
+
+dlpack::device get_dlpack_device(const migraphx::argument& x)
+{
+#ifdef HAVE_GPU
+    if(migraphx::gpu::is_device_ptr(x.data()))
+        return {dlpack::rocm, migraphx::gpu::get_device_id()};
+#endif
+    (void)x;
+    return {dlpack::cpu, 0};
+}
+
+// Exports the argument without copying it. The capsule keeps a reference to the argument's data
+// until the consumer calls the deleter.
+py::capsule to_dlpack(const migraphx::argument& x, bool sync)
+{
+    struct context
+    {
+        migraphx::argument arg;
+        std::vector<int64_t> lens;
+        std::vector<int64_t> strides;
+        dlpack::managed_tensor managed;
+    };
+    const auto& s = x.get_shape();
+    if(s.dynamic() or s.type() == migraphx::shape::tuple_type)
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Only static arguments can be exported to DLPack");
+    auto dtype = to_dlpack_type(s.type());
+    if(dtype.bits == 0)
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: No DLPack data type for " + s.type_string());
+
+    auto* ctx = new context{x, {}, {}, {}}; // NOLINT
+    ctx->lens.assign(s.lens().begin(), s.lens().end());
+    ctx->strides.assign(s.strides().begin(), s.strides().end());
+    auto& t       = ctx->managed.dl_tensor;
+    t.data        = x.data();
+    t.dev         = get_dlpack_device(x);
+#ifdef HAVE_GPU
+    // The program isn't waited on after it runs, so the consumer's stream isn't ordered after it
+    if(t.dev.device_type == dlpack::rocm and sync)
+        migraphx::gpu::gpu_sync();
+#else
+    (void)sync;
+#endif
+    t.ndim        = static_cast<int32_t>(s.ndim());
+    t.dtype       = dtype;
+    t.shape       = ctx->lens.data();
+    t.strides     = ctx->strides.data();
+    t.byte_offset = 0;
+
+    ctx->managed.manager_ctx = ctx;
+    ctx->managed.deleter     = [](dlpack::managed_tensor* m) {
+        delete static_cast<context*>(m->manager_ctx); // NOLINT
+    };
+    // The capsule only deletes the tensor when no consumer took ownership by renaming it
+    return py::capsule(&ctx->managed, "dltensor", [](PyObject* cap) {
+        if(PyCapsule_IsValid(cap, "dltensor") == 0)
+            return;
+        auto* m = static_cast<dlpack::managed_tensor*>(PyCapsule_GetPointer(cap, "dltensor"));
+        m->deleter(m);
+    });
+}
+
+// Wraps a tensor from another framework without copying it. The argument keeps the producer's
+// tensor alive, and device tensors are synchronized since the producer's stream isn't known.
+migraphx::argument from_dlpack(const py::object& x)
+{
+    py::object cap = py::hasattr(x, "__dlpack__") ? x.attr("__dlpack__")() : x;
+    if(PyCapsule_IsValid(cap.ptr(), "dltensor") == 0)
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Expected a DLPack capsule");
+    auto* m = static_cast<dlpack::managed_tensor*>(PyCapsule_GetPointer(cap.ptr(), "dltensor"));
+    const auto& t = m->dl_tensor;
+    switch(t.dev.device_type)
+    {
+    case dlpack::cpu: break;
+#ifdef HAVE_GPU
+    case dlpack::rocm: migraphx::gpu::gpu_sync(); break;
+#endif
+    default:
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Unsupported DLPack device type " +
+                       std::to_string(t.dev.device_type));
+    }
+
+    auto type = from_dlpack_type(t.dtype);
+    std::vector<std::size_t> lens(t.shape, t.shape + t.ndim);
+    std::vector<std::size_t> strides;
+    if(t.strides != nullptr)
+    {
+        if(std::any_of(t.strides, t.strides + t.ndim, [](auto i) { return i < 0; }))
+            MIGRAPHX_THROW("MIGRAPHX PYTHON: Negative DLPack strides are not supported");
+        strides.assign(t.strides, t.strides + t.ndim);
+    }
+    else
+        strides = migraphx::shape{type, lens}.strides();
+    migraphx::shape s = lens.empty() ? migraphx::shape{type} : migraphx::shape{type, lens, strides};
+
+    // The consumer owns the tensor once the capsule is renamed
+    PyCapsule_SetName(cap.ptr(), "used_dltensor");
+    std::shared_ptr<char> data(static_cast<char*>(t.data) + t.byte_offset, [m](char*) {
+        if(m->deleter != nullptr)
+            m->deleter(m);
+    });
+    return {s, data};
+}
+
+migraphx::argument to_argument(const py::object& x)
+{
+    if(py::isinstance<migraphx::argument>(x))
+        return x.cast<migraphx::argument>();
+    if(not py::isinstance<py::buffer>(x) and py::hasattr(x, "__dlpack__"))
+        return from_dlpack(x);
+    py::buffer_info info = x.cast<py::buffer>().request();
+    return migraphx::argument(to_shape(info), info.ptr);
+}
+
+migraphx::parameter_map to_parameter_map(const py::dict& params)
+{
+    migraphx::parameter_map pm;
+    for(auto x : params)
+    {
+        std::string key = x.first.cast<std::string>();
+        pm[key]         = to_argument(py::reinterpret_borrow<py::object>(x.second));
+    }
+    return pm;
+}
+
+// Other python threads can run while the program is evaluated, since the parameters were already
+// converted and the results are only converted after the GIL is taken back
+std::vector<migraphx::argument>
+eval_without_gil(const migraphx::program& p,
+                 const migraphx::parameter_map& pm,
+                 migraphx::execution_environment exec_env = migraphx::execution_environment{})
+{
+    py::gil_scoped_release release;
+    return p.eval(pm, exec_env);
+}
+
+// Evaluates the program on a python thread and returns a concurrent.futures.Future, which is set
+// once the program has finished on the device. The thread keeps the program and the parameters
+// alive until then. The same program should not be run concurrently, so each concurrent caller
+// needs its own session from create_session.
+py::object run_in_thread(const py::object& self, migraphx::parameter_map pm)
+{
+    auto future = py::module_::import("concurrent.futures").attr("Future")();
+    auto run    = py::cpp_function([self, pm = std::move(pm), future] {
+        const auto& p = self.cast<const migraphx::program&>();
+        std::vector<migraphx::argument> result;
+        try
+        {
+            py::gil_scoped_release release;
+            result = p.eval(pm);
+            p.finish();
+        }
+        catch(const std::exception& e)
+        {
+            auto error = py::module_::import("builtins").attr("RuntimeError")(e.what());
+            future.attr("set_exception")(error);
+            return;
+        }
+        future.attr("set_result")(result);
+    });
+    py::module_::import("threading").attr("Thread")(py::arg("target") = run).attr("start")();
+    return future;
+}
+
 MIGRAPHX_PYBIND11_MODULE(migraphx, m)
 {
     py::class_<migraphx::shape> shape_cls(m, "shape");
@@ -335,6 +603,18 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
             return migraphx::argument(to_shape(info), info.ptr);
         }))
         .def("get_shape", &migraphx::argument::get_shape)
+        .def(
+            "__dlpack__",
+            [](const migraphx::argument& x, const py::object& stream, const py::kwargs&) {
+                // A stream of -1 means the consumer does its own synchronization
+                return to_dlpack(x, stream.is_none() or stream.cast<int64_t>() != -1);
+            },
+            py::arg("stream") = py::none())
+        .def("__dlpack_device__",
+             [](const migraphx::argument& x) {
+                 auto d = get_dlpack_device(x);
+                 return py::make_tuple(d.device_type, d.device_id);
+             })
         .def("data_ptr",
              [](migraphx::argument& x) { return reinterpret_cast<std::uintptr_t>(x.data()); })
         .def("tolist",
@@ -401,50 +681,102 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
                const migraphx::target& t,
                bool offload_copy,
                bool fast_math,
-               bool exhaustive_tune) {
+               bool exhaustive_tune,
+               bool background_tune,
+               bool lazy_compile,
+               bool capture_graph,
+               bool record_weights,
+               std::size_t memory_budget,
+               std::size_t weight_budget,
+               const std::string& checkpoint_pass,
+               const std::string& checkpoint_file,
+               const std::string& resume_pass) {
                 migraphx::compile_options options;
                 options.offload_copy    = offload_copy;
                 options.fast_math       = fast_math;
                 options.exhaustive_tune = exhaustive_tune;
+                options.background_tune = background_tune;
+                options.lazy_compile    = lazy_compile;
+                options.capture_graph   = capture_graph;
+                options.record_weights  = record_weights;
+                options.memory_budget   = memory_budget;
+                options.weight_budget   = weight_budget;
+                options.checkpoint_pass = checkpoint_pass;
+                options.checkpoint_file = checkpoint_file;
+                options.resume_pass     = resume_pass;
                 p.compile(t, options);
             },
             py::arg("t"),
             py::arg("offload_copy")    = true,
             py::arg("fast_math")       = true,
-            py::arg("exhaustive_tune") = false)
+            py::arg("exhaustive_tune") = false,
+            py::arg("background_tune") = false,
+            py::arg("lazy_compile")    = false,
+            py::arg("capture_graph")   = false,
+            py::arg("record_weights")  = false,
+            py::arg("memory_budget")   = 0,
+            py::arg("weight_budget")   = 0,
+            py::arg("checkpoint_pass") = "",
+            py::arg("checkpoint_file") = "",
+            py::arg("resume_pass")     = "")
+        .def("update_weights", &migraphx::program::update_weights, py::arg("p"))
         .def("get_main_module", [](const migraphx::program& p) { return p.get_main_module(); })
         .def(
             "create_module",
             [](migraphx::program& p, const std::string& name) { return p.create_module(name); },
             py::arg("name"))
-        .def("run",
-             [](migraphx::program& p, py::dict params) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
-                 return p.eval(pm);
-             })
+        .def(
+            "run",
+            [](migraphx::program& p, py::dict params, int priority) {
+                migraphx::execution_environment exec_env{};
+                exec_env.priority = priority;
+                return eval_without_gil(p, to_parameter_map(params), exec_env);
+            },
+            py::arg("params"),
+            py::arg("priority") = 0)
         .def("run_async",
              [](migraphx::program& p,
                 py::dict params,
                 std::uintptr_t stream,
                 std::string stream_name) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
                  migraphx::execution_environment exec_env{
                      migraphx::any_ptr(reinterpret_cast<void*>(stream), stream_name), true};
-                 return p.eval(pm, exec_env);
+                 return eval_without_gil(p, to_parameter_map(params), exec_env);
+             })
+        .def("run_async",
+             [](const py::object& self, py::dict params) {
+                 return run_in_thread(self, to_parameter_map(params));
+             })
+        .def(
+            "run_many",
+            [](const migraphx::program& p,
+               const std::vector<py::dict>& requests,
+               std::size_t depth,
+               const py::object& callback) {
+                std::vector<migraphx::parameter_map> pms;
+                std::transform(requests.begin(),
+                               requests.end(),
+                               std::back_inserter(pms),
+                               [](const py::dict& params) { return to_parameter_map(params); });
+                py::gil_scoped_release release;
+                if(callback.is_none())
+                    return p.eval_many(std::move(pms), depth);
+                return p.eval_many(
+                    std::move(pms), depth, [&](std::size_t i, std::vector<migraphx::argument> r) {
+                        py::gil_scoped_acquire acquire;
+                        callback(i, r);
+                    });
+            },
+            py::arg("requests"),
+            py::arg("depth")    = 2,
+            py::arg("callback") = py::none())
+        .def("create_session", &migraphx::program::create_session)
+        .def("memory_report",
+             [](const migraphx::program& p) {
+                 std::unordered_map<std::string, std::size_t> result;
+                 for(const auto& x : p.memory_report())
+                     result[x.get_key()] = x.to<std::size_t>();
+                 return result;
              })
         .def("sort", &migraphx::program::sort)
         .def("print", [](const migraphx::program& p) { std::cout << p << std::endl; })
@@ -452,6 +784,39 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         .def("__ne__", std::not_equal_to<migraphx::program>{})
         .def("__repr__", [](const migraphx::program& p) { return migraphx::to_string(p); });
 
+    py::class_<migraphx::replica_runner> runner(m, "replica_runner");
+    py::enum_<migraphx::replica_runner::dispatch_mode>(runner, "dispatch_mode")
+        .value("round_robin", migraphx::replica_runner::round_robin)
+        .value("queue_depth", migraphx::replica_runner::queue_depth);
+    runner
+        .def(py::init<const migraphx::program&,
+                      const std::vector<std::size_t>&,
+                      migraphx::replica_runner::dispatch_mode>(),
+             py::arg("p"),
+             py::arg("device_ids"),
+             py::arg("mode") = migraphx::replica_runner::round_robin)
+        .def("__len__", &migraphx::replica_runner::size)
+        .def(
+            "run",
+            [](const migraphx::replica_runner& r, py::dict params) {
+                auto pm = to_parameter_map(params);
+                py::gil_scoped_release release;
+                return r.run(pm);
+            },
+            py::arg("params"))
+        .def(
+            "run_batches",
+            [](const migraphx::replica_runner& r, const std::vector<py::dict>& batches) {
+                std::vector<migraphx::parameter_map> pms;
+                std::transform(batches.begin(),
+                               batches.end(),
+                               std::back_inserter(pms),
+                               [](const py::dict& params) { return to_parameter_map(params); });
+                py::gil_scoped_release release;
+                return r.run_batches(pms);
+            },
+            py::arg("batches"));
+
     py::class_<migraphx::operation> op(m, "op");
     op.def(py::init([](const std::string& name, py::kwargs kwargs) {
           migraphx::value v = migraphx::value::object{};
@@ -481,22 +846,28 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         py::arg("shape"),
         py::arg("address"));
 
+    m.def("from_dlpack", &from_dlpack, py::arg("x"));
+
     m.def(
         "parse_tf",
         [](const std::string& filename,
            bool is_nhwc,
            unsigned int batch_size,
            std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims,
-           std::vector<std::string> output_names) {
-            return migraphx::parse_tf(
-                filename, migraphx::tf_options{is_nhwc, batch_size, map_input_dims, output_names});
+           std::vector<std::string> output_names,
+           int64_t max_loop_iterations) {
+            migraphx::tf_options options{is_nhwc, batch_size, map_input_dims, output_names};
+            options.max_loop_iterations = max_loop_iterations;
+            return migraphx::parse_tf(filename, options);
         },
         "Parse tf protobuf (default format is nhwc)",
         py::arg("filename"),
-        py::arg("is_nhwc")        = true,
-        py::arg("batch_size")     = 1,
-        py::arg("map_input_dims") = std::unordered_map<std::string, std::vector<std::size_t>>(),
-        py::arg("output_names")   = std::vector<std::string>());
+        py::arg("is_nhwc")             = true,
+        py::arg("batch_size")          = 1,
+        py::arg("map_input_dims") =
+            std::unordered_map<std::string, std::vector<std::size_t>>(),
+        py::arg("output_names")        = std::vector<std::string>(),
+        py::arg("max_loop_iterations") = 10);
 
     m.def(
         "parse_onnx",
@@ -610,12 +981,31 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
           &migraphx::quantize_fp16,
           py::arg("prog"),
           py::arg("ins_names") = std::vector<std::string>{"all"});
+    m.def("quantize_bf16",
+          &migraphx::quantize_bf16,
+          py::arg("prog"),
+          py::arg("ins_names") = std::vector<std::string>{"all"});
     m.def("quantize_int8",
           &migraphx::quantize_int8,
           py::arg("prog"),
           py::arg("t"),
           py::arg("calibration") = std::vector<migraphx::parameter_map>{},
           py::arg("ins_names")   = std::unordered_set<std::string>{"dot", "convolution"});
+    m.def(
+        "quantize_mixed_precision",
+        [](migraphx::program& prog,
+           const std::vector<migraphx::parameter_map>& calibration,
+           double tolerance,
+           const std::unordered_set<std::string>& ins_names) {
+            migraphx::mixed_precision_options options;
+            options.tolerance = tolerance;
+            options.ins_names = ins_names;
+            migraphx::quantize_mixed_precision(prog, calibration, options);
+        },
+        py::arg("prog"),
+        py::arg("calibration"),
+        py::arg("tolerance") = 1e-3,
+        py::arg("ins_names") = std::unordered_set<std::string>{"dot", "convolution"});
     m.def(
         "autocast_fp8",
         [](migraphx::program& prog) {
@@ -623,9 +1013,12 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         },
         "Auto-convert FP8 parameters and return values to Float for MIGraphX Program",
         py::arg("prog"));
+    m.def("get_metrics", &migraphx::get_metrics, "Get a snapshot of the runtime metrics");
+    m.def("reset_metrics", &migraphx::reset_metrics, "Set the runtime metrics back to zero");
 
 #ifdef HAVE_GPU
     m.def("allocate_gpu", &migraphx::gpu::allocate_gpu, py::arg("s"), py::arg("host") = false);
+    m.def("allocate_pinned", &migraphx::gpu::allocate_pinned, py::arg("s"));
     m.def("to_gpu", &migraphx::gpu::to_gpu, py::arg("arg"), py::arg("host") = false);
     m.def("from_gpu", &migraphx::gpu::from_gpu);
     m.def("gpu_sync", [] { migraphx::gpu::gpu_sync(); });
@@ -31,6 +31,7 @@
 #include <migraphx/simplify_qdq.hpp>
 #include <migraphx/eliminate_common_subexpression.hpp>
 #include <migraphx/optimize_module.hpp>
+#include <migraphx/propagate_constant.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/instruction.hpp>
@@ -42,6 +43,16 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/normalize_ops.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/common.hpp>
+#include <migraphx/literal.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <set>
 #include <map>
 
@@ -64,58 +75,153 @@ void quantize_fp16(program& prog, const std::vector<std::string>& ins_names)
                 optimize_module{{"quantizelinear", "dequantizelinear"}}});
 }
 
-void quantize_8bits(program& prog,
-                    const target& t,
-                    shape::type_t precision,
-                    const std::vector<parameter_map>& calibration,
-                    const std::unordered_set<std::string>& ins_names)
+// Same as quantize_fp16 but converts to bf16, which keeps the range of float so it doesn't
+// overflow, at the cost of fewer bits of precision.
+void quantize_bf16(program& prog, const std::vector<std::string>& ins_names)
 {
-    // Run optimize_module() before converting to int8/fp8 to const eval and fold in FP32 to
-    // avoid loss of precision.
-    run_passes(prog, {normalize_ops{}, optimize_module{}});
+    run_passes(prog,
+               {normalize_ops{},
+                optimize_module{{"quantizelinear", "dequantizelinear"}},
+                quantize_bf16_pass{ins_names},
+                optimize_module{{"quantizelinear", "dequantizelinear"}}});
+}
 
-    std::shared_ptr<std::vector<std::pair<float, float>>> quant_8bit_params =
-        std::make_shared<std::vector<std::pair<float, float>>>();
-    std::shared_ptr<std::vector<float>> max_abs_vals = std::make_shared<std::vector<float>>();
-    std::map<shape::type_t, float> type_ranges       = {{shape::type_t::int8_type, 127.0},
-                                                        {shape::type_t::fp8e4m3fnuz_type, 240.0},
-                                                        {shape::type_t::fp8e4m3fn_type, 448.0}};
-    float quantized_range                            = type_ranges.at(precision);
-    auto calc_quant_params = [&](std::size_t ins_index, std::vector<argument> args) {
-        std::pair<float, float> param_pair{64.0f, 0.0f};
-        // scale and shift is need for only int8 type, and we do not
-        // consider shift, so set shift to 0
-        std::vector<float> vec_val;
-        argument arg = t.copy_from(args.front());
-        arg.visit([&](auto output) { vec_val.assign(output.begin(), output.end()); });
-        auto max_val                = *std::max_element(vec_val.begin(), vec_val.end());
-        auto min_val                = *std::min_element(vec_val.begin(), vec_val.end());
-        auto max_abs                = std::max(std::fabs(max_val), std::fabs(min_val));
-        max_abs_vals->at(ins_index) = std::max(max_abs_vals->at(ins_index), max_abs);
-        // if all values are 0, no need to do scaling
-        if(float_equal(max_abs_vals->at(ins_index), 0.0f))
+// Number of bins in the histograms of the calibration data
+constexpr std::size_t calibration_bins = 2048;
+// Number of positive levels of the quantized type compared against by the entropy calibration
+constexpr std::size_t entropy_levels = 128;
+// Probability given to the empty levels so the divergence stays finite
+constexpr double entropy_epsilon = 1e-4;
+
+namespace {
+
+struct calibration_stats
+{
+    bool captured = false;
+    float max_abs = 0.0f;
+    // Histogram of the absolute values over [0, range)
+    float range = 0.0f;
+    std::vector<double> hist;
+
+    void add(const std::vector<float>& values, float batch_max)
+    {
+        captured = true;
+        max_abs  = std::max(max_abs, batch_max);
+        if(hist.empty())
+            hist.resize(calibration_bins, 0.0);
+        if(batch_max > range)
+            rebin(batch_max);
+        if(float_equal(range, 0.0f))
         {
-            param_pair.first = 1.0f;
+            hist.front() += values.size();
+            return;
         }
-        else
+        for(auto x : values)
         {
-            param_pair.first = quantized_range / max_abs_vals->at(ins_index);
+            auto bin = static_cast<std::size_t>(std::fabs(x) / range * calibration_bins);
+            hist[std::min(bin, calibration_bins - 1)] += 1;
         }
-        quant_8bit_params->at(ins_index) = param_pair;
-    };
+    }
 
-    // pass to add capture argument op
-    std::size_t param_num = 0;
-    run_passes(prog, {capture_arguments_pass{ins_names, calc_quant_params, &param_num}});
-    quant_8bit_params->resize(param_num, std::pair<float, float>(64.0f, 0.0f));
-    max_abs_vals->resize(param_num, 0.0f);
+    // Grow the range of the histogram, moving each bin by its center
+    void rebin(float new_range)
+    {
+        std::vector<double> result(calibration_bins, 0.0);
+        for(std::size_t i = 0; i < calibration_bins; i++)
+        {
+            auto center = (i + 0.5) * range / calibration_bins;
+            auto bin    = static_cast<std::size_t>(center / new_range * calibration_bins);
+            result[std::min(bin, calibration_bins - 1)] += hist[i];
+        }
+        hist  = std::move(result);
+        range = new_range;
+    }
 
-    // use the calibration data to compute the quantization scale
-    auto capture_prog = prog;
-    capture_prog.compile(t);
+    float bin_width() const { return range / calibration_bins; }
 
-    // use all calibration data to run the program to calculate the
-    // quantization scale and shift
+    // Smallest threshold that keeps the percent of the values in range
+    float percentile_threshold(float percent) const
+    {
+        auto total  = std::accumulate(hist.begin(), hist.end(), 0.0);
+        auto target = total * percent / 100.0;
+        double sum  = 0;
+        for(std::size_t i = 0; i < calibration_bins; i++)
+        {
+            sum += hist[i];
+            if(sum >= target)
+                return (i + 1) * bin_width();
+        }
+        return max_abs;
+    }
+
+    // Threshold that minimizes the KL divergence between the clipped histogram and the histogram
+    // after quantizing it to the levels of the quantized type
+    float entropy_threshold() const
+    {
+        std::size_t best = calibration_bins;
+        double best_kl   = std::numeric_limits<double>::max();
+        std::vector<double> p;
+        std::vector<double> q;
+        for(std::size_t i = entropy_levels; i <= calibration_bins; i++)
+        {
+            // Clip at bin i, folding the outliers into the last bin
+            p.assign(hist.begin(), hist.begin() + i);
+            p.back() += std::accumulate(hist.begin() + i, hist.end(), 0.0);
+            // Merge the clipped bins into the quantized levels, spreading each level over the
+            // nonzero bins of p
+            q.assign(i, 0.0);
+            for(std::size_t level = 0; level < entropy_levels; level++)
+            {
+                auto start   = level * i / entropy_levels;
+                auto stop    = (level + 1) * i / entropy_levels;
+                auto sum     = std::accumulate(hist.begin() + start, hist.begin() + stop, 0.0);
+                auto nonzero = std::count_if(
+                    p.begin() + start, p.begin() + stop, [](auto x) { return x > 0; });
+                if(nonzero == 0)
+                    continue;
+                for(auto j = start; j < stop; j++)
+                    q[j] = p[j] > 0 ? sum / nonzero : 0.0;
+            }
+            auto psum = std::accumulate(p.begin(), p.end(), 0.0);
+            auto qsum = std::accumulate(q.begin(), q.end(), 0.0);
+            if(psum <= 0 or qsum <= 0)
+                continue;
+            double kl = 0;
+            for(std::size_t j = 0; j < i; j++)
+            {
+                if(p[j] <= 0)
+                    continue;
+                // Smooth the levels that only the outliers fall into
+                auto pj = p[j] / psum;
+                auto qj = std::max(q[j] / qsum, entropy_epsilon);
+                kl += pj * std::log(pj / qj);
+            }
+            if(kl < best_kl)
+            {
+                best_kl = kl;
+                best    = i;
+            }
+        }
+        return (best + 0.5) * bin_width();
+    }
+
+    float threshold(const quantize_8bits_options& options) const
+    {
+        if(float_equal(range, 0.0f) or options.calibration == calibration_mode::max)
+            return max_abs;
+        if(options.calibration == calibration_mode::percentile)
+            return std::min(max_abs, percentile_threshold(options.percentile));
+        return std::min(max_abs, entropy_threshold());
+    }
+};
+
+// Compile a copy of the program with capture instructions and run it on all of the
+// calibration data
+void run_calibration(program capture_prog,
+                     const target& t,
+                     const std::vector<parameter_map>& calibration)
+{
+    capture_prog.compile(t);
     for(auto&& arg : calibration)
     {
         parameter_map m;
@@ -133,13 +239,190 @@ void quantize_8bits(program& prog,
         }
         capture_prog.eval(m);
     }
+}
+
+// Largest magnitude of each row of the weights of a dot, which are the input channels
+std::vector<float> weight_channel_max(instruction_ref w)
+{
+    auto s    = w->get_shape();
+    auto axis = s.ndim() - 2;
+    std::vector<float> result(s.lens()[axis], 0.0f);
+    w->eval().visit([&](auto x) {
+        for(std::size_t i = 0; i < s.elements(); i++)
+        {
+            auto c    = s.multi(i)[axis];
+            result[c] = std::max<float>(result[c], std::fabs(static_cast<float>(x[i])));
+        }
+    });
+    return result;
+}
+
+// SmoothQuant: activations of transformers have a few input channels with much larger values
+// than the rest, which a per-tensor scale can not represent. Each input channel k of the
+// activation is divided by s_k = max|x_k|^alpha / max|w_k|^(1 - alpha) and the matching row of
+// the weights is multiplied by it, which leaves the dot unchanged but moves the outliers into
+// the weights where per-channel scales handle them. Dots sharing an activation, like the q, k
+// and v projections, share the factors so the activation is only scaled once. The scaling of
+// the activation is a pointwise mul that gets fused into the norm or pointwise producing it.
+void smooth_activations(program& prog,
+                        const target& t,
+                        const std::vector<parameter_map>& calibration,
+                        float alpha)
+{
+    auto* mm = prog.get_main_module();
+    std::vector<instruction_ref> activations;
+    std::unordered_map<instruction_ref, std::vector<instruction_ref>> dots;
+    for(auto ins : iterator_for(*mm))
+    {
+        if(ins->name() != "dot")
+            continue;
+        auto x = ins->inputs().front();
+        auto w = ins->inputs().back();
+        if(x->can_eval() or not w->can_eval() or shape::is_integral(x->get_shape().type()))
+            continue;
+        if(not contains(dots, x))
+            activations.push_back(x);
+        dots[x].push_back(ins);
+    }
+    if(activations.empty())
+        return;
+
+    auto x_max = std::make_shared<std::vector<std::vector<float>>>(activations.size());
+    auto f     = [=, &t](std::size_t i, std::vector<argument> args) {
+        argument arg = t.copy_from(args.front());
+        auto k       = arg.get_shape().lens().back();
+        auto& m      = x_max->at(i);
+        m.resize(k, 0.0f);
+        arg.visit([&](auto x) {
+            for(std::size_t j = 0; j < x.size(); j++)
+                m[j % k] = std::max<float>(m[j % k], std::fabs(static_cast<float>(x[j])));
+        });
+    };
+    std::vector<instruction_ref> captures;
+    for(std::size_t i = 0; i < activations.size(); i++)
+    {
+        auto x   = activations[i];
+        auto cap = mm->insert_instruction(std::next(x), op::capture{i, f}, x);
+        for(auto dot : dots[x])
+            instruction::replace_argument(dot, x, cap);
+        captures.push_back(cap);
+    }
+    run_calibration(prog, t, calibration);
+    for(auto cap : captures)
+    {
+        mm->replace_instruction(cap, cap->inputs().front());
+        mm->remove_instruction(cap);
+    }
+
+    for(std::size_t i = 0; i < activations.size(); i++)
+    {
+        const auto& xm = x_max->at(i);
+        if(xm.empty())
+            continue;
+        auto x = activations[i];
+        std::vector<float> w_max(xm.size(), 0.0f);
+        for(auto dot : dots[x])
+        {
+            auto m = weight_channel_max(dot->inputs().back());
+            std::transform(w_max.begin(),
+                           w_max.end(),
+                           m.begin(),
+                           w_max.begin(),
+                           [](auto a, auto b) { return std::max(a, b); });
+        }
+        std::vector<float> factors(xm.size(), 1.0f);
+        std::vector<float> inv_factors(xm.size(), 1.0f);
+        for(std::size_t k = 0; k < xm.size(); k++)
+        {
+            if(float_equal(xm[k], 0.0f) or float_equal(w_max[k], 0.0f))
+                continue;
+            auto factor    = std::pow(xm[k], alpha) / std::pow(w_max[k], 1.0f - alpha);
+            factors[k]     = std::max(factor, 1e-5f);
+            inv_factors[k] = 1.0f / factors[k];
+        }
+        auto k   = xm.size();
+        auto inv = mm->add_literal(literal{shape{x->get_shape().type(), {k}}, inv_factors});
+        auto sx  = insert_common_op(*mm, std::next(x), make_op("mul"), {x, inv});
+        for(auto dot : dots[x])
+        {
+            auto w  = dot->inputs().back();
+            auto s  = mm->add_literal(literal{shape{w->get_shape().type(), {k, 1}}, factors});
+            auto sw = insert_common_op(*mm, dot, make_op("mul"), {w, s});
+            mm->replace_instruction(dot, dot->get_operator(), sx, sw);
+        }
+    }
+    run_passes(prog, {propagate_constant{}, dead_code_elimination{}});
+}
+
+} // namespace
+
+void quantize_8bits(program& prog,
+                    const target& t,
+                    shape::type_t precision,
+                    const std::vector<parameter_map>& calibration,
+                    const std::unordered_set<std::string>& ins_names,
+                    const quantize_8bits_options& options)
+{
+    // Run optimize_module() before converting to int8/fp8 to const eval and fold in FP32 to
+    // avoid loss of precision.
+    run_passes(prog, {normalize_ops{}, optimize_module{}});
+    if(options.smooth_alpha > 0)
+        smooth_activations(prog, t, calibration, options.smooth_alpha);
+
+    std::shared_ptr<std::vector<calibration_stats>> stats =
+        std::make_shared<std::vector<calibration_stats>>();
+    float quantized_range  = get_quantized_range(precision);
+    bool needs_histogram   = options.calibration != calibration_mode::max;
+    auto calc_quant_params = [&](std::size_t ins_index, std::vector<argument> args) {
+        std::vector<float> vec_val;
+        argument arg = t.copy_from(args.front());
+        arg.visit([&](auto output) { vec_val.assign(output.begin(), output.end()); });
+        auto [min_val, max_val] = std::minmax_element(vec_val.begin(), vec_val.end());
+        auto max_abs            = std::max(std::fabs(*max_val), std::fabs(*min_val));
+        auto& s                 = stats->at(ins_index);
+        if(needs_histogram)
+        {
+            s.add(vec_val, max_abs);
+        }
+        else
+        {
+            s.captured = true;
+            s.max_abs  = std::max(s.max_abs, max_abs);
+        }
+    };
+
+    // pass to add capture argument op
+    std::size_t param_num = 0;
+    run_passes(prog,
+               {capture_arguments_pass{
+                   ins_names, calc_quant_params, &param_num, options.group_size}});
+    stats->resize(param_num);
+
+    // use all calibration data to run the program to calculate the
+    // quantization scale and shift
+    run_calibration(prog, t, calibration);
+
+    // scale and shift is need for only int8 type, and we do not
+    // consider shift, so set shift to 0
+    std::vector<std::pair<float, float>> quant_8bit_params(param_num, {64.0f, 0.0f});
+    par_for(param_num, [&](auto i) {
+        const auto& s = stats->at(i);
+        if(not s.captured)
+            return;
+        auto max_abs = s.threshold(options);
+        // if all values are 0, no need to do scaling
+        if(float_equal(max_abs, 0.0f))
+            quant_8bit_params[i].first = 1.0f;
+        else
+            quant_8bit_params[i].first = quantized_range / max_abs;
+    });
 
     // print the quantization parameters in only the main module
     if(enabled(MIGRAPHX_8BITS_QUANTIZATION_PARAMS{}))
     {
-        for(std::size_t i = 0; i < quant_8bit_params->size(); ++i)
+        for(std::size_t i = 0; i < quant_8bit_params.size(); ++i)
         {
-            auto param = quant_8bit_params->at(i);
+            auto param = quant_8bit_params[i];
             std::cout << "ins_index = " << i << ", scale = " << param.first
                       << ", shift = " << param.second << std::endl;
         }
@@ -147,23 +430,27 @@ void quantize_8bits(program& prog,
     }
 
     run_passes(prog,
-               {quantize_8bits_pass{precision, *quant_8bit_params},
-                simplify_qdq{},
-                optimize_module{},
-                dead_code_elimination{}});
+               {quantize_8bits_pass{precision, quant_8bit_params, options}, simplify_qdq{}});
+    // Only fold constants when the weights are quantized in groups, since the rewrites in
+    // optimize_module would move their dequantizelinear and fold them back to full precision
+    if(options.group_size > 0)
+        run_passes(prog, {propagate_constant{{"dequantizelinear"}}, dead_code_elimination{}});
+    else
+        run_passes(prog, {optimize_module{}, dead_code_elimination{}});
 }
 
 void quantize_int8(program& prog,
                    const target& t,
                    const std::vector<parameter_map>& calibration,
-                   const std::unordered_set<std::string>& ins_names)
+                   const std::unordered_set<std::string>& ins_names,
+                   const quantize_8bits_options& options)
 {
     std::unordered_set<std::string> op_names = {"convolution", "dot"};
     if(op_names != ins_names)
     {
         MIGRAPHX_THROW("QUANTIZE_INT8: only support DOT and CONVOLUTION operation");
     }
-    quantize_8bits(prog, t, shape::int8_type, calibration, ins_names);
+    quantize_8bits(prog, t, shape::int8_type, calibration, ins_names, options);
 }
 
 void quantize_int4_weights(program& prog)
@@ -171,7 +458,122 @@ void quantize_int4_weights(program& prog)
     run_passes(prog, {normalize_ops{}, optimize_module{}, quantize_int4_pass{}});
 }
 
-void quantize_fp8(program& prog, const target& t, const std::vector<parameter_map>& calibration)
+namespace {
+
+using output_list = std::vector<std::vector<double>>;
+
+// Outputs of p on the ref target for each of the calibration inputs
+std::vector<output_list> run_ref(program p, const std::vector<parameter_map>& calibration)
+{
+    p.compile(make_target("ref"));
+    std::vector<output_list> result;
+    for(const auto& params : calibration)
+    {
+        output_list outputs;
+        for(const auto& arg : p.eval(params))
+            outputs.push_back(arg.to_vector<double>());
+        result.push_back(outputs);
+    }
+    return result;
+}
+
+// Largest relative rms error of any output
+double output_error(const std::vector<output_list>& expected,
+                    const std::vector<output_list>& actual)
+{
+    double result = 0;
+    for(auto i : range(expected.size()))
+    {
+        for(auto j : range(expected[i].size()))
+        {
+            auto error = verify::rms_range(actual[i][j], expected[i][j]);
+            if(std::isnan(error))
+                return std::numeric_limits<double>::max();
+            result = std::max(result, error);
+        }
+    }
+    return result;
+}
+
+// Copy of p with the instructions at the positions in the main module computed in their type
+program lower_instructions(program p, const std::map<std::size_t, shape::type_t>& lowered)
+{
+    auto* mm = p.get_main_module();
+    std::vector<instruction_ref> inss;
+    for(auto ins : iterator_for(*mm))
+        inss.push_back(ins);
+    for(const auto& [i, t] : lowered)
+        quantize_instruction(*mm, inss[i], t);
+    run_passes(p, {dead_code_elimination{}});
+    return p;
+}
+
+} // namespace
+
+// Each candidate instruction is lowered on its own to every precision to measure how sensitive
+// the outputs are to it, and the smallest precision within the tolerance is picked. When the
+// errors of all of them together go over the tolerance, the most sensitive instructions are put
+// back to full precision one at a time until it fits.
+void quantize_mixed_precision(program& prog,
+                              const std::vector<parameter_map>& calibration,
+                              const mixed_precision_options& options)
+{
+    if(calibration.empty())
+        MIGRAPHX_THROW("QUANTIZE_MIXED_PRECISION: no calibration data");
+    run_passes(prog, {normalize_ops{}, optimize_module{{"quantizelinear", "dequantizelinear"}}});
+    auto expected = run_ref(prog, calibration);
+
+    std::vector<std::size_t> candidates;
+    std::size_t n = 0;
+    for(auto ins : iterator_for(*prog.get_main_module()))
+    {
+        auto t = ins->get_shape().type();
+        if((contains(options.ins_names, ins->name()) or contains(options.ins_names, "all")) and
+           not ins->inputs().empty() and not contains({"@return", "convert"}, ins->name()) and
+           contains({shape::float_type, shape::double_type}, t))
+            candidates.push_back(n);
+        n++;
+    }
+
+    std::map<std::size_t, shape::type_t> lowered;
+    std::map<std::size_t, double> errors;
+    for(auto i : candidates)
+    {
+        optional<std::pair<std::size_t, double>> best;
+        for(auto t : options.precisions)
+        {
+            auto error = output_error(
+                expected, run_ref(lower_instructions(prog, {{i, t}}), calibration));
+            if(error > options.tolerance)
+                continue;
+            auto size = shape{t}.type_size();
+            if(best.has_value() and std::make_pair(size, error) >= *best)
+                continue;
+            best       = std::make_pair(size, error);
+            lowered[i] = t;
+            errors[i]  = error;
+        }
+    }
+
+    while(not lowered.empty() and
+          output_error(expected, run_ref(lower_instructions(prog, lowered), calibration)) >
+              options.tolerance)
+    {
+        auto it = std::max_element(errors.begin(), errors.end(), [](const auto& x, const auto& y) {
+            return x.second < y.second;
+        });
+        lowered.erase(it->first);
+        errors.erase(it);
+    }
+
+    prog = lower_instructions(prog, lowered);
+    run_passes(prog, {optimize_module{{"quantizelinear", "dequantizelinear"}}});
+}
+
+void quantize_fp8(program& prog,
+                  const target& t,
+                  const std::vector<parameter_map>& calibration,
+                  const quantize_8bits_options& options)
 {
     std::cout << "[Warning] : MIGraphX has BETA support for FP8. Using FP8 may result in "
                  "incorrect final outputs\n";
@@ -200,11 +602,13 @@ void quantize_fp8(program& prog, const target& t, const std::vector<parameter_ma
     };
     if(gfx_has_fp8fnuz())
     {
-        quantize_8bits(prog, t, shape::fp8e4m3fnuz_type, calibration, supported_ins_names);
+        quantize_8bits(
+            prog, t, shape::fp8e4m3fnuz_type, calibration, supported_ins_names, options);
     }
     else
     {
-        quantize_8bits(prog, t, shape::fp8e4m3fn_type, calibration, supported_ins_names);
+        quantize_8bits(
+            prog, t, shape::fp8e4m3fn_type, calibration, supported_ins_names, options);
     }
 }
 } // namespace MIGRAPHX_INLINE_NS
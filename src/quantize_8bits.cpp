@@ -35,8 +35,13 @@
 #include <migraphx/target.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/optional.hpp>
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <map>
 #include <set>
+#include <unordered_map>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -48,6 +53,126 @@ static std::vector<shape::type_t>& get_quantizable_type()
     return quantable_types;
 }
 
+calibration_mode to_calibration_mode(const std::string& name)
+{
+    static const std::unordered_map<std::string, calibration_mode> modes = {
+        {"max", calibration_mode::max},
+        {"percentile", calibration_mode::percentile},
+        {"entropy", calibration_mode::entropy}};
+    auto it = modes.find(name);
+    if(it == modes.end())
+        MIGRAPHX_THROW("Unknown calibration mode: " + name);
+    return it->second;
+}
+
+float get_quantized_range(shape::type_t precision)
+{
+    static const std::map<shape::type_t, float> type_ranges = {
+        {shape::type_t::int8_type, 127.0},
+        {shape::type_t::fp8e4m3fnuz_type, 240.0},
+        {shape::type_t::fp8e4m3fn_type, 448.0}};
+    if(not contains(type_ranges, precision))
+        MIGRAPHX_THROW("Unsupported type for 8-bit quantization: " + shape::cpp_type(precision));
+    return type_ranges.at(precision);
+}
+
+static instruction_ref skip_capture(instruction_ref ins)
+{
+    if(ins->name() == "capture")
+        return ins->inputs().front();
+    return ins;
+}
+
+// Dots with constant weights whose k dimension splits into groups
+static bool is_group_quantized(instruction_ref ins, std::size_t group_size)
+{
+    if(group_size == 0 or ins->name() != "dot")
+        return false;
+    auto w = skip_capture(ins->inputs().back());
+    if(not w->can_eval())
+        return false;
+    const auto& lens = w->get_shape().lens();
+    auto k           = lens[lens.size() - 2];
+    return k > group_size and k % group_size == 0;
+}
+
+static float to_scale(float max_abs, float range)
+{
+    // if all values are 0, no need to do scaling
+    return float_equal(max_abs, 0.0f) ? 1.0f : max_abs / range;
+}
+
+// The axis of the output channels when the input is the weights of the quantized op
+static optional<std::size_t> get_channel_axis(instruction_ref ins, instruction_ref input)
+{
+    if(ins->inputs().size() < 2 or ins->inputs()[1] != input or not skip_capture(input)->can_eval())
+        return nullopt;
+    if(ins->name() == "dot")
+        return input->get_shape().ndim() - 1;
+    if(ins->name() == "convolution")
+        return 0;
+    return nullopt;
+}
+
+// Scales for each output channel of the weights, broadcast along the axis
+static instruction_ref insert_channel_scales(
+    module& m, instruction_ref pos, instruction_ref input, std::size_t axis, float range)
+{
+    auto s = input->get_shape();
+    std::vector<float> max_abs(s.lens()[axis], 0.0f);
+    input->eval().visit([&](auto x) {
+        for(std::size_t i = 0; i < s.elements(); i++)
+        {
+            auto c     = s.multi(i)[axis];
+            max_abs[c] = std::max<float>(max_abs[c], std::fabs(static_cast<float>(x[i])));
+        }
+    });
+    std::vector<float> scales(max_abs.size());
+    std::transform(max_abs.begin(), max_abs.end(), scales.begin(), [&](auto x) {
+        return to_scale(x, range);
+    });
+    auto scale = m.add_literal(literal{shape{s.type(), {scales.size()}}, scales});
+    return m.insert_instruction(
+        pos, make_op("broadcast", {{"axis", axis}, {"out_lens", s.lens()}}), scale);
+}
+
+// Scales for each group of rows along k of the weights of a dot, for each output channel
+static instruction_ref insert_group_scales(
+    module& m, instruction_ref pos, instruction_ref input, std::size_t group_size, float range)
+{
+    auto s     = input->get_shape();
+    auto lens  = s.lens();
+    auto rank  = lens.size();
+    auto n     = lens[rank - 1];
+    auto k     = lens[rank - 2];
+    auto batch = s.elements() / (k * n);
+    std::vector<float> max_abs(batch * (k / group_size) * n, 0.0f);
+    input->eval().visit([&](auto x) {
+        for(std::size_t i = 0; i < s.elements(); i++)
+        {
+            auto b     = i / (k * n);
+            auto g     = (i / n) % k / group_size;
+            auto j     = (b * (k / group_size) + g) * n + i % n;
+            max_abs[j] = std::max<float>(max_abs[j], std::fabs(static_cast<float>(x[i])));
+        }
+    });
+    std::vector<float> scales(max_abs.size());
+    std::transform(max_abs.begin(), max_abs.end(), scales.begin(), [&](auto x) {
+        return to_scale(x, range);
+    });
+    // [..., k/g, 1, n] -> [..., k/g, g, n] -> [..., k, n]
+    auto group_lens      = lens;
+    group_lens[rank - 2] = k / group_size;
+    group_lens.insert(group_lens.end() - 1, 1);
+    auto scale = m.add_literal(literal{shape{s.type(), group_lens}, scales});
+
+    group_lens[rank - 1] = group_size;
+    scale                = m.insert_instruction(
+        pos, make_op("multibroadcast", {{"out_lens", group_lens}}), scale);
+    scale = m.insert_instruction(pos, make_op("contiguous"), scale);
+    return m.insert_instruction(pos, make_op("reshape", {{"dims", lens}}), scale);
+}
+
 void quantize_8bits_pass::apply(module& m) const // NOLINT
 {
     const auto& quantizable_types = get_quantizable_type();
@@ -66,16 +191,39 @@ void quantize_8bits_pass::apply(module& m) const // NOLINT
         auto s     = input->get_shape();
         if(contains(quantizable_types, s.type()) and s.type() != precision)
         {
+            auto qop  = ins->outputs().front();
+            auto axis = get_channel_axis(qop, ins);
             auto zero_point =
                 m.add_literal(migraphx::literal{migraphx::shape{precision}, {param.second}});
-            auto scale       = m.add_literal(literal({s.type()}, {1.0f / param.first}));
             const auto& lens = s.lens();
-            scale =
-                m.insert_instruction(ins, make_op("multibroadcast", {{"out_lens", lens}}), scale);
+            instruction_ref scale;
+            if(axis and is_group_quantized(qop, options.group_size))
+            {
+                scale = insert_group_scales(
+                    m, ins, input, options.group_size, get_quantized_range(precision));
+            }
+            else if(axis and options.per_channel)
+            {
+                scale =
+                    insert_channel_scales(m, ins, input, *axis, get_quantized_range(precision));
+            }
+            else
+            {
+                scale = m.add_literal(literal({s.type()}, {1.0f / param.first}));
+                scale = m.insert_instruction(
+                    ins, make_op("multibroadcast", {{"out_lens", lens}}), scale);
+            }
             zero_point = m.insert_instruction(
                 ins, make_op("multibroadcast", {{"out_lens", lens}}), zero_point);
             auto q_in =
                 m.insert_instruction(ins, make_op("quantizelinear"), input, scale, zero_point);
+            // Fold the grouped weights to a literal now, since simplify_qdq would otherwise
+            // remove the pair
+            if(axis and is_group_quantized(qop, options.group_size))
+            {
+                auto q_arg = q_in->eval();
+                q_in       = m.add_literal(q_arg.get_shape(), q_arg.data());
+            }
             auto dq_in =
                 m.insert_instruction(ins, make_op("dequantizelinear"), q_in, scale, zero_point);
             m.replace_instruction(ins, dq_in);
@@ -99,7 +247,9 @@ void capture_arguments_pass::apply(module& m) const // NOLINT
         std::vector<instruction_ref> new_args;
         for(auto input : inputs)
         {
-            if(contains(quantizable_types, input->get_shape().type()))
+            // Only the weights are quantized for dots with group-wise weights
+            bool is_activation = input == inputs.front() and is_group_quantized(ins, group_size);
+            if(contains(quantizable_types, input->get_shape().type()) and not is_activation)
             {
                 auto new_in = m.insert_instruction(ins, op::capture{(*param_index)++, f}, input);
                 new_args.push_back(new_in);
@@ -35,68 +35,78 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
-static void quantize_module(module& m, const std::vector<std::string>& ins_names)
+void quantize_instruction(module& m, instruction_ref ins, shape::type_t target_type)
 {
-    for(auto ins : iterator_for(m))
-    {
-        // instructions are not in the set to be quantized
-        if(not(contains(ins_names, ins->name()) or contains(ins_names, "all")))
-            continue;
+    // skip return and convert instructions
+    if(contains({"@return", "convert"}, ins->name()))
+        return;
 
-        // skip return and convert instructions
-        if(contains({"@return", "convert"}, ins->name()))
-            continue;
+    if(ins->inputs().empty())
+        return;
 
-        if(ins->inputs().empty())
-            continue;
+    auto mod_inputs = ins->module_inputs();
+    auto s          = ins->get_shape();
+    // Convert each of the inputs that are floating point to the target type
+    auto inputs = ins->inputs();
+    std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
+        auto input_type = input->get_shape().type();
+        if(input_type != shape::float_type and input_type != shape::double_type)
+            return input;
+        return m.insert_instruction(ins, make_op("convert", {{"target_type", target_type}}), input);
+    });
 
-        auto mod_inputs = ins->module_inputs();
-        auto s          = ins->get_shape();
-        // Convert each of the inputs that are floating point to fp16
-        auto inputs = ins->inputs();
-        std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
-            auto input_type = input->get_shape().type();
-            if(input_type != shape::float_type and input_type != shape::double_type)
-                return input;
-            return m.insert_instruction(
-                ins, make_op("convert", {{"target_type", shape::half_type}}), input);
-        });
+    // Insert quantized ins
+    auto converted_ins = m.insert_instruction(ins, ins->get_operator(), inputs, mod_inputs);
 
-        // Insert quantized ins
-        auto converted_ins = m.insert_instruction(ins, ins->get_operator(), inputs, mod_inputs);
-
-        // tuple can't be directly converted, get_tuple_elem needs conversion
-        if(ins->get_shape().type() == shape::tuple_type)
-        {
-            auto outputs = ins->outputs();
-            std::transform(
-                outputs.begin(), outputs.end(), outputs.begin(), [&](const auto gte_ins) {
-                    auto gte_ins_half =
-                        m.insert_instruction(ins, gte_ins->get_operator(), converted_ins);
-                    // Convert back to output type after quantizing
-                    auto gte_converted = m.insert_instruction(
-                        ins,
-                        make_op("convert", {{"target_type", gte_ins->get_shape().type()}}),
-                        gte_ins_half);
-                    // Replace output instruction
-                    return m.replace_instruction(gte_ins, gte_converted);
-                });
-        }
-        else
+    // tuple can't be directly converted, get_tuple_elem needs conversion
+    if(ins->get_shape().type() == shape::tuple_type)
+    {
+        auto outputs = ins->outputs();
+        std::transform(outputs.begin(), outputs.end(), outputs.begin(), [&](const auto gte_ins) {
+            auto gte_ins_half = m.insert_instruction(ins, gte_ins->get_operator(), converted_ins);
+            // Convert back to output type after quantizing
+            auto gte_converted = m.insert_instruction(
+                ins,
+                make_op("convert", {{"target_type", gte_ins->get_shape().type()}}),
+                gte_ins_half);
+            // Replace output instruction
+            return m.replace_instruction(gte_ins, gte_converted);
+        });
+    }
+    else
+    {
+        // Convert back to original type after quantizing
+        if(mod_inputs.empty())
         {
-            // Convert back to original type after quantizing
-            if(mod_inputs.empty())
-            {
-                converted_ins = m.insert_instruction(
-                    ins, make_op("convert", {{"target_type", s.type()}}), converted_ins);
-            }
-            // Replace original instruction
-            m.replace_instruction(ins, converted_ins);
+            converted_ins = m.insert_instruction(
+                ins, make_op("convert", {{"target_type", s.type()}}), converted_ins);
         }
+        // Replace original instruction
+        m.replace_instruction(ins, converted_ins);
     }
 }
 
-void quantize_fp16_pass::apply(module& m) const { quantize_module(m, ins_names); }
+static void
+quantize_module(module& m, const std::vector<std::string>& ins_names, shape::type_t target_type)
+{
+    for(auto ins : iterator_for(m))
+    {
+        // instructions are not in the set to be quantized
+        if(not(contains(ins_names, ins->name()) or contains(ins_names, "all")))
+            continue;
+        quantize_instruction(m, ins, target_type);
+    }
+}
+
+void quantize_fp16_pass::apply(module& m) const
+{
+    quantize_module(m, ins_names, shape::half_type);
+}
+
+void quantize_bf16_pass::apply(module& m) const
+{
+    quantize_module(m, ins_names, shape::bf16_type);
+}
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -0,0 +1,204 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/recompute_activations.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/optional.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+namespace {
+
+struct memory_estimate
+{
+    std::unordered_map<instruction_ref, std::size_t> positions;
+    // Position of the last instruction that reads each buffer, directly or through an alias
+    std::unordered_map<instruction_ref, std::size_t> last_use;
+    std::size_t peak          = 0;
+    std::size_t peak_position = 0;
+
+    static bool owns_buffer(instruction_ref ins)
+    {
+        return ins->name().front() != '@' and instruction::get_output_alias(ins) == ins;
+    }
+
+    // Each instruction that doesn't alias an input holds its output from where it is computed to
+    // its last use. This is the order lowering allocates in, so it only estimates what
+    // memory_coloring ends up with after scheduling.
+    explicit memory_estimate(const module& m)
+    {
+        std::size_t n = 0;
+        for(auto ins : iterator_for(m))
+        {
+            positions[ins] = n;
+            for(auto input : ins->inputs())
+                last_use[instruction::get_output_alias(input)] = n;
+            n++;
+        }
+        std::vector<std::int64_t> delta(positions.size() + 1);
+        for(auto ins : iterator_for(m))
+        {
+            if(not owns_buffer(ins))
+                continue;
+            auto start = positions[ins];
+            auto end   = std::max(start, get_last_use(ins));
+            delta[start] += ins->get_shape().bytes();
+            delta[end + 1] -= ins->get_shape().bytes();
+        }
+        std::int64_t live = 0;
+        for(std::size_t i = 0; i < n; i++)
+        {
+            live += delta[i];
+            if(live <= std::int64_t(peak))
+                continue;
+            peak          = live;
+            peak_position = i;
+        }
+    }
+
+    std::size_t get_last_use(instruction_ref ins) const
+    {
+        auto it = last_use.find(instruction::get_output_alias(ins));
+        if(it == last_use.end())
+            return positions.at(ins);
+        return it->second;
+    }
+
+    // Inputs that stay live up to pos anyway can be read again there for free
+    bool is_live_at(instruction_ref ins, std::size_t pos) const
+    {
+        auto root = instruction::get_output_alias(ins);
+        if(root->name().front() == '@')
+            return true;
+        return get_last_use(root) >= pos;
+    }
+};
+
+struct use
+{
+    instruction_ref user;
+    // The input of the user, which is either the pointwise instruction or a view of it
+    instruction_ref via;
+};
+
+struct candidate
+{
+    instruction_ref ins;
+    std::vector<use> late_uses;
+    instruction_ref first_late_user;
+};
+
+std::vector<use> find_uses(instruction_ref ins)
+{
+    std::vector<use> uses;
+    for(auto output : ins->outputs())
+    {
+        if(output->inputs().size() == 1 and output->get_operator().is_context_free() and
+           instruction::get_output_alias(output, true) == ins)
+        {
+            for(auto user : output->outputs())
+                uses.push_back({user, output});
+        }
+        else
+        {
+            uses.push_back({output, ins});
+        }
+    }
+    return uses;
+}
+
+// Find the pointwise instruction that frees the most memory at the peak when its uses after the
+// peak read a recomputed copy instead
+optional<candidate> find_candidate(const module& m, const memory_estimate& est)
+{
+    optional<candidate> result;
+    std::size_t best = 0;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "pointwise")
+            continue;
+        auto bytes = ins->get_shape().bytes();
+        if(bytes <= best or est.positions.at(ins) >= est.peak_position)
+            continue;
+        auto uses = find_uses(ins);
+        auto late = std::partition(uses.begin(), uses.end(), [&](const use& u) {
+            return est.positions.at(u.user) <= est.peak_position;
+        });
+        if(late == uses.begin() or late == uses.end())
+            continue;
+        auto first_late_user =
+            std::min_element(late, uses.end(), [&](const use& x, const use& y) {
+                return est.positions.at(x.user) < est.positions.at(y.user);
+            })->user;
+        auto pos = est.positions.at(first_late_user);
+        // Recomputing must not keep any of the inputs live for longer
+        if(not std::all_of(ins->inputs().begin(), ins->inputs().end(), [&](auto input) {
+               return est.is_live_at(input, pos);
+           }))
+            continue;
+        best   = bytes;
+        result = candidate{ins, {late, uses.end()}, first_late_user};
+    }
+    return result;
+}
+
+void recompute(module& m, const candidate& c)
+{
+    auto copy = m.insert_instruction(
+        c.first_late_user, c.ins->get_operator(), c.ins->inputs(), c.ins->module_inputs());
+    // Views read after the peak are recreated on top of the copy
+    std::unordered_map<instruction_ref, instruction_ref> views = {{c.ins, copy}};
+    for(const auto& u : c.late_uses)
+    {
+        if(not contains(views, u.via))
+            views[u.via] = m.insert_instruction(c.first_late_user, u.via->get_operator(), copy);
+        instruction::replace_argument(u.user, u.via, views.at(u.via));
+    }
+}
+
+} // namespace
+
+void recompute_activations::apply(module& m) const
+{
+    // Every step makes one pointwise instruction no longer live across the peak, so this is
+    // bounded by the number of instructions
+    for(auto n = m.size(); n > 0; n--)
+    {
+        memory_estimate est{m};
+        if(est.peak <= budget)
+            return;
+        auto c = find_candidate(m, est);
+        if(not c.has_value())
+            return;
+        recompute(m, *c);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
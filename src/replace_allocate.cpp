@@ -62,6 +62,24 @@ std::unordered_map<instruction_ref, std::string> create_output_names(const modul
     return mod_output_names;
 }
 
+// Use the layout the producer writes for the output parameter, when it only differs in its strides,
+// so the producer writes straight into the buffer bound by the user. Otherwise adjust_allocation
+// would write into a scratch buffer and copy it into the output parameter afterwards.
+static shape output_param_shape(instruction_ref alloc)
+{
+    const auto& s = alloc->get_shape();
+    auto producer = std::find_if(alloc->outputs().begin(), alloc->outputs().end(), [&](auto out) {
+        return not out->get_operator().is_context_free() and
+               instruction::get_output_alias(out, true) == alloc;
+    });
+    if(producer == alloc->outputs().end())
+        return s;
+    const auto& ps = (*producer)->get_shape();
+    if(ps.type() != s.type() or ps.lens() != s.lens() or not ps.packed())
+        return s;
+    return ps;
+}
+
 void insert_submod_allocations(instruction_ref ins, module& mod, const allocation_model& model)
 {
     std::vector<instruction_ref> inputs = ins->inputs();
@@ -89,7 +107,8 @@ void replace_allocate::apply(module_pass_manager& mpm) const
 {
     module& m              = mpm.get_module();
     auto mod_output_names  = create_output_names(m);
-    bool root_offload_copy = (*mpm.get_root_module() == m) ? this->offload_copy : false;
+    bool root              = *mpm.get_root_module() == m;
+    bool root_offload_copy = root ? this->offload_copy : false;
     for(auto ins : iterator_for(m))
     {
         auto op      = ins->get_operator();
@@ -108,7 +127,9 @@ void replace_allocate::apply(module_pass_manager& mpm) const
         auto s = ins->get_shape();
         if(not root_offload_copy and model.needs_out_params() and contains(mod_output_names, ins))
         {
-            auto out_param = m.add_parameter(mod_output_names[ins], s);
+            // Submodule output parameters are bound by their parent with the allocated shape
+            auto out_param =
+                m.add_parameter(mod_output_names[ins], root ? output_param_shape(ins) : s);
             m.replace_instruction(ins, out_param);
         }
         else
@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/replica_runner.hpp>
+#include <migraphx/errors.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct replica_runner_impl
+{
+    std::vector<program> replicas;
+    // Calls currently running on each replica
+    std::vector<std::atomic<std::size_t>> in_flight;
+    std::atomic<std::size_t> next{0};
+    replica_runner::dispatch_mode mode = replica_runner::round_robin;
+
+    replica_runner_impl(const program& p,
+                        const std::vector<std::size_t>& device_ids,
+                        replica_runner::dispatch_mode m)
+        : in_flight(device_ids.size()), mode(m)
+    {
+        std::transform(device_ids.begin(),
+                       device_ids.end(),
+                       std::back_inserter(replicas),
+                       [&](std::size_t id) { return p.create_replica(id); });
+    }
+
+    std::size_t select()
+    {
+        if(mode == replica_runner::round_robin)
+            return next++ % replicas.size();
+        // Start from the next replica in turn so ties are spread over the replicas
+        auto start  = next++;
+        auto result = start % replicas.size();
+        for(std::size_t i = 1; i < replicas.size(); i++)
+        {
+            auto r = (start + i) % replicas.size();
+            if(in_flight[r] < in_flight[result])
+                result = r;
+        }
+        return result;
+    }
+};
+
+replica_runner::replica_runner() = default;
+
+replica_runner::replica_runner(const program& p,
+                               const std::vector<std::size_t>& device_ids,
+                               dispatch_mode mode)
+{
+    if(device_ids.empty())
+        MIGRAPHX_THROW("REPLICA_RUNNER: No devices given");
+    if(not p.is_compiled())
+        MIGRAPHX_THROW("REPLICA_RUNNER: Program is not compiled");
+    impl = std::make_shared<replica_runner_impl>(p, device_ids, mode);
+}
+
+std::size_t replica_runner::size() const
+{
+    if(impl == nullptr)
+        return 0;
+    return impl->replicas.size();
+}
+
+const program& replica_runner::get_replica(std::size_t i) const { return impl->replicas.at(i); }
+
+std::vector<argument> replica_runner::run(parameter_map params) const
+{
+    if(impl == nullptr)
+        MIGRAPHX_THROW("REPLICA_RUNNER: No replicas");
+    auto r = impl->select();
+    impl->in_flight[r]++;
+    try
+    {
+        auto result = impl->replicas[r].eval(std::move(params));
+        impl->in_flight[r]--;
+        return result;
+    }
+    catch(...)
+    {
+        impl->in_flight[r]--;
+        throw;
+    }
+}
+
+std::vector<std::vector<argument>>
+replica_runner::run_batches(std::vector<parameter_map> batches) const
+{
+    if(impl == nullptr)
+        MIGRAPHX_THROW("REPLICA_RUNNER: No replicas");
+    std::vector<std::vector<argument>> results(batches.size());
+    std::atomic<std::size_t> next_batch{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error = nullptr;
+    std::mutex error_lock;
+    auto worker = [&] {
+        for(auto b = next_batch++; b < batches.size() and not failed; b = next_batch++)
+        {
+            try
+            {
+                results[b] = this->run(std::move(batches[b]));
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(error_lock);
+                if(error == nullptr)
+                    error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+    // One worker for each replica keeps all of them busy
+    std::vector<std::thread> threads;
+    auto nthreads = std::min(this->size(), batches.size());
+    std::generate_n(std::back_inserter(threads), nthreads, [&] { return std::thread{worker}; });
+    for(auto& t : threads)
+        t.join();
+    if(error != nullptr)
+        std::rethrow_exception(error);
+    return results;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
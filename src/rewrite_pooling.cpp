@@ -161,7 +161,7 @@ void rewrite_pooling::apply(module& m) const
         {
             replace_with_reduce(m, ins);
         }
-        else if(not default_dilations)
+        else if(not default_dilations and rewrite_dilations)
         {
             // Dilated AvgPool with padding is not supported
             if(not default_padding and op.mode == op::pooling_mode::average)
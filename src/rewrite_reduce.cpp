@@ -55,6 +55,30 @@ struct find_softmax
     }
 };
 
+struct find_logsoftmax
+{
+    auto matcher() const { return match::name("logsoftmax"); }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins  = r.result;
+        auto op   = ins->get_operator().to_value();
+        auto axis = op["axis"].to<std::int64_t>();
+
+        auto input = ins->inputs().front();
+        auto max   = m.insert_instruction(ins, make_op("reduce_max", {{"axes", {axis}}}), input);
+        auto maxb  = m.insert_instruction(
+            ins, make_op("multibroadcast", {{"out_lens", input->get_shape().lens()}}), max);
+        auto sub  = m.insert_instruction(ins, make_op("sub"), input, maxb);
+        auto exp  = m.insert_instruction(ins, make_op("exp"), sub);
+        auto sum  = m.insert_instruction(ins, make_op("reduce_sum", {{"axes", {axis}}}), exp);
+        auto log  = m.insert_instruction(ins, make_op("log"), sum);
+        auto logb = m.insert_instruction(
+            ins, make_op("multibroadcast", {{"out_lens", input->get_shape().lens()}}), log);
+        m.replace_instruction(ins, make_op("sub"), sub, logb);
+    }
+};
+
 struct find_reduce_mean_variance
 {
     auto matcher() const
@@ -145,7 +169,7 @@ struct find_reduce_mean
 
 void rewrite_reduce::apply(module& m) const
 {
-    match::find_matches(m, find_softmax{}, find_reduce_mean_variance{});
+    match::find_matches(m, find_softmax{}, find_logsoftmax{}, find_reduce_mean_variance{});
     match::find_matches(m, find_reduce_mean{});
 }
 
@@ -30,6 +30,7 @@
 #include <migraphx/op/dot.hpp>
 #include <migraphx/op/gru.hpp>
 #include <migraphx/op/lstm.hpp>
+#include <migraphx/op/lstm_recurrence.hpp>
 #include <migraphx/op/mul.hpp>
 #include <migraphx/op/rnn.hpp>
 #include <migraphx/op/slice.hpp>
@@ -46,6 +47,7 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/dfor.hpp>
 #include <migraphx/ranges.hpp>
+#include <migraphx/float_equal.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -64,7 +66,10 @@ void rewrite_rnn::apply(module& m) const
         }
         else if(ins->name() == "lstm")
         {
-            apply_lstm(m, ins);
+            if(fuse_lstm and is_fusible_lstm(m, ins))
+                apply_fused_lstm(m, ins);
+            else
+                apply_lstm(m, ins);
         }
     }
 }
@@ -1280,6 +1285,124 @@ std::vector<operation> rewrite_rnn::lstm_actv_funcs(instruction_ref ins) const
     }
 }
 
+// The lstm_recurrence only implements the default activations, and variable sequence lengths,
+// clip and coupled input and forget gates are left to the unrolled lstm
+bool rewrite_rnn::is_fusible_lstm(const module& m, instruction_ref ins) const
+{
+    auto lstm_op = any_cast<op::lstm>(ins->get_operator());
+    if(not float_equal(lstm_op.clip, 0.0f) or lstm_op.input_forget != 0)
+        return false;
+    auto args                = ins->inputs();
+    instruction_ref seq_lens = m.end();
+    if((args.size() >= 5) and not args[4]->is_undefined())
+    {
+        seq_lens = args[4];
+    }
+    if(is_variable_seq_lens(m, seq_lens))
+        return false;
+    auto actv_funcs = lstm_actv_funcs(ins);
+    for(std::size_t i = 0; i < actv_funcs.size(); i++)
+    {
+        if(actv_funcs[i].name() != (i % 3 == 0 ? "sigmoid" : "tanh"))
+            return false;
+    }
+    return true;
+}
+
+void rewrite_rnn::apply_fused_lstm(module& m, instruction_ref ins) const
+{
+    auto args               = ins->inputs();
+    auto lstm_op            = any_cast<op::lstm>(ins->get_operator());
+    op::rnn_direction dirct = lstm_op.direction;
+
+    instruction_ref seq_lens = m.end();
+    if((args.size() >= 5) and not args[4]->is_undefined())
+    {
+        seq_lens = args[4];
+    }
+
+    auto seq                   = args[0];
+    std::size_t seq_len        = get_seq_len(m, seq, seq_lens);
+    auto seq_lens_max          = seq->get_shape().lens();
+    std::size_t batch_size     = seq_lens_max[1];
+    std::size_t input_size     = seq_lens_max[2];
+    std::size_t num_directions = args[2]->get_shape().lens()[0];
+    std::size_t hidden_size    = args[2]->get_shape().lens()[2];
+    shape::type_t type         = seq->get_shape().type();
+
+    if(seq_len < seq_lens_max[0])
+    {
+        seq = m.insert_instruction(
+            ins, make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {seq_len}}}), seq);
+    }
+    if(not seq->get_shape().standard())
+    {
+        seq = m.insert_instruction(ins, make_op("contiguous"), seq);
+    }
+
+    // the input projection of every timestep and direction is a single dot
+    auto x = m.insert_instruction(
+        ins, make_op("reshape", {{"dims", {seq_len * batch_size, input_size}}}), seq);
+    auto w = m.insert_instruction(
+        ins,
+        make_op("reshape", {{"dims", {num_directions * 4 * hidden_size, input_size}}}),
+        args[1]);
+    auto wt    = m.insert_instruction(ins, make_op("transpose", {{"permutation", {1, 0}}}), w);
+    auto xw    = m.insert_instruction(ins, make_op("dot"), x, wt);
+    auto gates = m.insert_instruction(
+        ins,
+        make_op("reshape", {{"dims", {seq_len, batch_size, num_directions, 4 * hidden_size}}}),
+        xw);
+    gates = m.insert_instruction(ins, make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), gates);
+    if(args.size() >= 4 and not args[3]->is_undefined())
+    {
+        auto wb = m.insert_instruction(
+            ins,
+            make_op("slice", {{"axes", {1}}, {"starts", {0}}, {"ends", {4 * hidden_size}}}),
+            args[3]);
+        auto rb = m.insert_instruction(
+            ins,
+            make_op("slice",
+                    {{"axes", {1}}, {"starts", {4 * hidden_size}}, {"ends", {8 * hidden_size}}}),
+            args[3]);
+        auto wrb  = m.insert_instruction(ins, make_op("add"), wb, rb);
+        auto uwrb = m.insert_instruction(ins, make_op("unsqueeze", {{"axes", {1}}}), wrb);
+        auto bias = m.insert_instruction(
+            ins, make_op("multibroadcast", {{"out_lens", gates->get_shape().lens()}}), uwrb);
+        gates = m.insert_instruction(ins, make_op("add"), gates, bias);
+    }
+
+    auto rt =
+        m.insert_instruction(ins, make_op("transpose", {{"permutation", {0, 2, 1}}}), args[2]);
+
+    // initial hidden state and cell value
+    migraphx::shape ihc_shape{type, {num_directions, batch_size, hidden_size}};
+    std::vector<float> ihc_data(ihc_shape.elements(), 0.0);
+    auto ih = (args.size() >= 6 and not args[5]->is_undefined())
+                  ? args[5]
+                  : m.add_literal(migraphx::literal{ihc_shape, ihc_data});
+    auto ic = (args.size() >= 7 and not args[6]->is_undefined())
+                  ? args[6]
+                  : m.add_literal(migraphx::literal{ihc_shape, ihc_data});
+
+    std::vector<instruction_ref> rec_args = {gates, rt, ih, ic};
+    if(args.size() == 8 and not args[7]->is_undefined())
+    {
+        rec_args.push_back(args[7]);
+    }
+    auto rec =
+        m.insert_instruction(ins, make_op("lstm_recurrence", {{"direction", dirct}}), rec_args);
+    auto last_hs_output =
+        m.insert_instruction(ins, make_op("get_tuple_elem", {{"index", 1}}), rec);
+    auto last_cell_output =
+        m.insert_instruction(ins, make_op("get_tuple_elem", {{"index", 2}}), rec);
+    auto hidden_state = m.replace_instruction(ins, make_op("get_tuple_elem", {{"index", 0}}), rec);
+
+    hidden_state = pad_hidden_states(m, args[0], seq_lens, hidden_state);
+    ins          = replace_last_hs_output(m, hidden_state, seq_lens, last_hs_output, dirct);
+    replace_last_cell_output(m, ins, seq_lens, last_cell_output, last_cell_output, dirct);
+}
+
 bool rewrite_rnn::is_variable_seq_lens(const module& m, instruction_ref seq_lens) const
 {
     bool is_var_lens = false;
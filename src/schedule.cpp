@@ -33,6 +33,7 @@
 #include <migraphx/dom_info.hpp>
 #include <unordered_map>
 #include <unordered_set>
+#include <numeric>
 #include <queue>
 #include <thread>
 #include <mutex>
@@ -75,7 +76,7 @@ struct stream_info
                 std::size_t weight = 0;
                 auto&& op          = ins->get_operator();
                 if(not is_context_free(op) and op.name()[0] != '@')
-                    weight = model.weight(op);
+                    weight = model.weight(op, to_shapes(ins->inputs()));
                 // This will ensure a stream will be assigned to return
                 if(op.name() == "@return")
                     weight = 1;
@@ -391,7 +392,7 @@ struct stream_info
     {
         std::unordered_map<instruction_ref, std::vector<std::vector<instruction_ref>>> result;
         std::unordered_map<instruction_ref, std::unordered_set<instruction_ref>> merge_from;
-        dominator_info di = compute_dominator(m);
+        auto di = get_dominator_info(m);
         result.reserve(m.size());
         merge_from.reserve(m.size());
         for(auto ins : reverse_iterator_for(m))
@@ -408,7 +409,7 @@ struct stream_info
             if(is_split_point(ins))
             {
                 erase_if(merge_from[ins],
-                         [&](auto merge) { return di.strictly_dominate(ins, merge); });
+                         [&](auto merge) { return di->strictly_dominate(ins, merge); });
             }
 
             auto streams = this->get_streams(ins);
@@ -566,15 +567,53 @@ void schedule::apply(module& m) const
     if(nstreams < 2)
         return;
 
-    // Schedule instructions
-    std::size_t wait_id = 0;
-    std::unordered_map<instruction_ref, std::size_t> ins2wait;
-    std::unordered_map<std::size_t, std::unordered_set<std::size_t>> waited_for;
-    std::unordered_map<instruction_ref, std::unordered_set<std::size_t>> ins2waited;
-    ins2wait.reserve(m.size());
-    ins2waited.reserve(m.size());
+    // Schedule instructions. Each stream keeps a vector clock of how far it has synchronized with
+    // every other stream, so a wait is only added when it is not already implied by an earlier
+    // wait, either directly or transitively through another stream.
+    auto n = model.concurrency();
+    std::vector<std::vector<std::size_t>> clocks(n, std::vector<std::size_t>(n));
+    std::unordered_map<instruction_ref, std::vector<std::size_t>> ins2clock;
+    std::unordered_map<instruction_ref, std::size_t> ins2index;
+    std::unordered_map<instruction_ref, std::vector<instruction_ref>> ins2waits;
+    ins2clock.reserve(m.size());
+    ins2index.reserve(m.size());
+    auto covers = [&](const std::vector<std::size_t>& clock, instruction_ref i) {
+        auto s = si.get_stream(i);
+        return clock[s] >= ins2clock.at(i)[s];
+    };
+    auto add_waits = [&](instruction_ref ins, std::size_t stream, std::vector<instruction_ref> xs) {
+        auto& clock = clocks[stream];
+        xs.erase(std::remove_if(xs.begin(),
+                                xs.end(),
+                                [&](auto i) {
+                                    return not si.has_stream(i) or si.get_stream(i) == stream or
+                                           covers(clock, i);
+                                }),
+                 xs.end());
+        // Skip instructions that another wait will already synchronize with
+        auto candidates = xs;
+        xs.erase(std::remove_if(xs.begin(),
+                                xs.end(),
+                                [&](auto i) {
+                                    return std::any_of(
+                                        candidates.begin(), candidates.end(), [&](auto j) {
+                                            return i != j and covers(ins2clock.at(j), i);
+                                        });
+                                }),
+                 xs.end());
+        for(auto i : xs)
+        {
+            ins2waits[i].push_back(ins);
+            const auto& c = ins2clock.at(i);
+            std::transform(c.begin(), c.end(), clock.begin(), clock.begin(), [](auto x, auto y) {
+                return std::max(x, y);
+            });
+        }
+    };
+    std::size_t index = 0;
     for(auto ins : iterator_for(m))
     {
+        ins2index[ins] = index++;
         // Only schedule instructions that have a stream
         if(not si.has_stream(ins))
             continue;
@@ -585,35 +624,35 @@ void schedule::apply(module& m) const
         model.sched(m, ins, stream);
         // Insert wait instructions
         if(si.is_merge_point(ins, stream))
-        {
-            for(auto i : si.get_recorded_instructions(ins))
-            {
-                if(not si.has_stream(i) or si.get_stream(i) == stream)
-                    continue;
+            add_waits(ins, stream, si.get_recorded_instructions(ins));
+        clocks[stream][stream]++;
+        ins2clock[ins] = clocks[stream];
+    }
 
-                // Create a new event if it hasn't been recorded
-                if(not contains(ins2wait, i))
-                {
-                    ins2wait[i] = wait_id;
-                    model.record(m, i, wait_id);
-                    wait_id++;
-                }
-                auto w = ins2wait.at(i);
-                // If we already waited for the event on this stream then dont
-                // insert another wait event
-                if(not contains(waited_for[stream], w))
-                    model.wait(m, ins, w);
-                // Store the event as waited
-                waited_for[stream].insert(w);
-                // Store all wait events that have been waited on prior to the recorded instruction
-                waited_for[stream].insert(ins2waited[i].begin(), ins2waited[i].end());
-            }
-        }
-        // Store wait events that have already been waited on
-        if(si.is_split_point(ins, stream))
-        {
-            ins2waited[ins] = waited_for[stream];
-        }
+    // Reuse an event once every wait on its previous record has been issued
+    std::vector<instruction_ref> recorded;
+    std::transform(ins2waits.begin(), ins2waits.end(), std::back_inserter(recorded), [](auto&& p) {
+        return p.first;
+    });
+    std::sort(recorded.begin(), recorded.end(), by(std::less<>{}, [&](auto i) {
+                  return ins2index.at(i);
+              }));
+    std::vector<std::size_t> event_free;
+    for(auto i : recorded)
+    {
+        const auto& waits   = ins2waits.at(i);
+        std::size_t wait_id = 0;
+        while(wait_id < event_free.size() and event_free[wait_id] > ins2index.at(i))
+            wait_id++;
+        if(wait_id == event_free.size())
+            event_free.push_back(0);
+        event_free[wait_id] =
+            std::accumulate(waits.begin(), waits.end(), std::size_t{0}, [&](auto x, auto w) {
+                return std::max(x, ins2index.at(w));
+            });
+        model.record(m, i, wait_id);
+        for(auto w : waits)
+            model.wait(m, w, wait_id);
     }
 
     // Add memory conflicts
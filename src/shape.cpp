@@ -27,11 +27,14 @@
 #include <migraphx/serialize.hpp>
 #include <migraphx/permutation.hpp>
 #include <migraphx/ranges.hpp>
+#include <migraphx/hash.hpp>
 #include <numeric>
 #include <algorithm>
 #include <functional>
 #include <unordered_map>
 #include <iostream>
+#include <array>
+#include <mutex>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -40,7 +43,7 @@ struct shape_impl
 {
     static std::shared_ptr<shape_impl> default_shape()
     {
-        static const std::shared_ptr<shape_impl> result = std::make_shared<shape_impl>();
+        static const std::shared_ptr<shape_impl> result = intern(std::make_shared<shape_impl>());
         return result;
     }
 
@@ -112,6 +115,76 @@ struct shape_impl
 
     std::vector<shape::dynamic_dimension> m_dyn_dims = {};
 
+    // Properties derived from the dimensions. A shape is never modified after it is created, so
+    // these are computed once by finalize instead of on every query.
+    std::size_t m_hash          = 0;
+    std::size_t m_elements      = 0;
+    std::size_t m_element_space = 0;
+    std::size_t m_bytes         = 0;
+    bool m_packed               = false;
+    bool m_transposed           = false;
+    bool m_broadcasted          = false;
+    bool m_scalar               = false;
+
+    static std::shared_ptr<shape_impl> intern(std::shared_ptr<shape_impl> s);
+
+    void finalize()
+    {
+        m_hash          = compute_hash();
+        m_element_space = element_space();
+        if(m_type == shape::tuple_type)
+        {
+            m_bytes = std::accumulate(
+                m_shapes.begin(), m_shapes.end(), std::size_t{0}, [](auto x, const shape& y) {
+                    return x + y.bytes();
+                });
+        }
+        else
+        {
+            shape::visit(m_type, [&](auto as) { m_bytes = as.size() * m_element_space; });
+        }
+        if(not m_dyn_dims.empty())
+            return;
+        m_elements    = elements();
+        m_broadcasted = std::any_of(m_strides.begin(), m_strides.end(), [](auto x) {
+            return x == 0;
+        });
+        m_scalar      = m_shapes.empty() and
+                   std::accumulate(m_strides.begin(), m_strides.end(), std::size_t(0)) == 0;
+        m_packed      = m_shapes.empty() and not skips() and m_elements == m_element_space;
+        // Broadcasted axes do not affect whether the shape is transposed
+        std::vector<std::size_t> s;
+        s.reserve(m_strides.size());
+        std::copy_if(m_strides.begin(), m_strides.end(), std::back_inserter(s), [](auto x) {
+            return x != 0;
+        });
+        m_transposed = not std::is_sorted(s.rbegin(), s.rend());
+    }
+
+    std::size_t compute_hash() const
+    {
+        std::size_t h = hash_value(static_cast<int>(m_type));
+        for(auto len : m_lens)
+            hash_combine(h, len);
+        // Strides are hashed from the innermost axis, so standard strides can be hashed while
+        // they are computed
+        std::for_each(
+            m_strides.rbegin(), m_strides.rend(), [&](auto stride) { hash_combine(h, stride); });
+        for(const auto& dd : m_dyn_dims)
+        {
+            hash_combine(h, dd.min);
+            hash_combine(h, dd.max);
+            // Optimals are ignored when comparing fixed dimensions
+            if(dd.is_fixed())
+                continue;
+            for(auto opt : dd.optimals)
+                hash_combine(h, opt);
+        }
+        for(const auto& sub : m_shapes)
+            hash_combine(h, sub.hash());
+        return h;
+    }
+
     void calculate_strides()
     {
         m_strides.clear();
@@ -227,6 +300,150 @@ struct shape_impl
     std::shared_ptr<shape_impl> copy() const { return std::make_shared<shape_impl>(*this); }
 };
 
+// Shapes are immutable, so equal shapes can share one shape_impl. Large graphs only have a few
+// distinct shapes, so this avoids keeping a separate copy of the lens and strides for every
+// instruction, and lets most comparisons be done by pointer.
+struct shape_table
+{
+    std::mutex mutex;
+    std::unordered_map<std::size_t, std::vector<std::weak_ptr<shape_impl>>> shapes;
+    std::size_t entries    = 0;
+    std::size_t next_sweep = 1024;
+
+    template <class Match, class Make>
+    std::shared_ptr<shape_impl> get(std::size_t h, Match match, Make make)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& bucket = shapes[h];
+        for(const auto& w : bucket)
+        {
+            auto p = w.lock();
+            if(p != nullptr and match(*p))
+                return p;
+        }
+        auto result = make();
+        assert(result->m_hash == h);
+        bucket.push_back(result);
+        entries++;
+        if(entries > next_sweep)
+            sweep();
+        return result;
+    }
+
+    // Drop the entries of shapes that no longer exist
+    void sweep()
+    {
+        entries = 0;
+        for(auto it = shapes.begin(); it != shapes.end();)
+        {
+            auto& bucket = it->second;
+            bucket.erase(std::remove_if(bucket.begin(),
+                                        bucket.end(),
+                                        [](const auto& w) { return w.expired(); }),
+                         bucket.end());
+            entries += bucket.size();
+            if(bucket.empty())
+                it = shapes.erase(it);
+            else
+                ++it;
+        }
+        next_sweep = std::max<std::size_t>(1024, 2 * entries);
+    }
+};
+
+// The table is split by hash so that threads compiling different modules rarely contend
+static shape_table& interned_shapes(std::size_t h)
+{
+    static std::array<shape_table, 16> tables;
+    return tables[h % tables.size()];
+}
+
+static std::size_t hash_standard_shape(shape::type_t t, const std::vector<std::size_t>& lens)
+{
+    std::size_t h = hash_value(static_cast<int>(t));
+    for(auto len : lens)
+        hash_combine(h, len);
+    std::size_t stride = 1;
+    std::for_each(lens.rbegin(), lens.rend(), [&](auto len) {
+        hash_combine(h, stride);
+        stride *= len;
+    });
+    return h;
+}
+
+static std::size_t hash_shape(shape::type_t t,
+                              const std::vector<std::size_t>& lens,
+                              const std::vector<std::size_t>& strides)
+{
+    std::size_t h = hash_value(static_cast<int>(t));
+    for(auto len : lens)
+        hash_combine(h, len);
+    std::for_each(strides.rbegin(), strides.rend(), [&](auto stride) { hash_combine(h, stride); });
+    return h;
+}
+
+static bool has_standard_strides(const shape_impl& x)
+{
+    std::size_t stride = 1;
+    for(auto i : reverse(range(x.m_lens.size())))
+    {
+        if(x.m_strides[i] != stride)
+            return false;
+        stride *= x.m_lens[i];
+    }
+    return true;
+}
+
+static bool same_dyn_dims(const std::vector<shape::dynamic_dimension>& x,
+                          const std::vector<shape::dynamic_dimension>& y)
+{
+    return std::equal(x.begin(), x.end(), y.begin(), y.end(), [](const auto& a, const auto& b) {
+        return a.min == b.min and a.max == b.max and a.optimals == b.optimals;
+    });
+}
+
+std::shared_ptr<shape_impl> shape_impl::intern(std::shared_ptr<shape_impl> s)
+{
+    s->finalize();
+    return interned_shapes(s->m_hash).get(
+        s->m_hash,
+        [&](const shape_impl& x) {
+            return x.m_type == s->m_type and x.m_standard == s->m_standard and
+                   x.m_lens == s->m_lens and x.m_strides == s->m_strides and
+                   x.m_shapes == s->m_shapes and same_dyn_dims(x.m_dyn_dims, s->m_dyn_dims);
+        },
+        [&] { return s; });
+}
+
+static std::shared_ptr<shape_impl> intern_shape(shape::type_t t, std::vector<std::size_t> l)
+{
+    auto h = hash_standard_shape(t, l);
+    return interned_shapes(h).get(
+        h,
+        [&](const shape_impl& x) {
+            return x.m_type == t and x.m_standard and x.m_lens == l and has_standard_strides(x);
+        },
+        [&] {
+            auto result = std::make_shared<shape_impl>(t, std::move(l));
+            result->finalize();
+            return result;
+        });
+}
+
+static std::shared_ptr<shape_impl>
+intern_shape(shape::type_t t, std::vector<std::size_t> l, std::vector<std::size_t> s)
+{
+    auto h = hash_shape(t, l, s);
+    return interned_shapes(h).get(
+        h,
+        [&](const shape_impl& x) { return x.m_type == t and x.m_lens == l and x.m_strides == s; },
+        [&] {
+            auto result = std::make_shared<shape_impl>(t, std::move(l), std::move(s));
+            result->finalize();
+            return result;
+        });
+}
+
 const std::vector<shape::type_t>& shape::types()
 {
     static const std::vector<shape::type_t> result = {
@@ -301,15 +518,12 @@ bool shape::is_unsigned(shape::type_t t)
 
 shape::shape() : impl(shape_impl::default_shape()) {}
 
-shape::shape(type_t t) : impl(std::make_shared<shape_impl>(t)) {}
+shape::shape(type_t t) : impl(intern_shape(t, {1}, {0})) {}
 
-shape::shape(type_t t, std::vector<std::size_t> l)
-    : impl(std::make_shared<shape_impl>(t, std::move(l)))
-{
-}
+shape::shape(type_t t, std::vector<std::size_t> l) : impl(intern_shape(t, std::move(l))) {}
 
 shape::shape(type_t t, std::vector<std::size_t> l, std::vector<std::size_t> s)
-    : impl(std::make_shared<shape_impl>(t, std::move(l), std::move(s)))
+    : impl(intern_shape(t, std::move(l), std::move(s)))
 {
 }
 
@@ -319,7 +533,7 @@ shape::shape(type_t t, std::initializer_list<std::size_t> d)
 }
 
 shape::shape(type_t t, std::vector<shape::dynamic_dimension> dims)
-    : impl(std::make_shared<shape_impl>(t, std::move(dims)))
+    : impl(shape_impl::intern(std::make_shared<shape_impl>(t, std::move(dims))))
 {
 }
 
@@ -327,12 +541,15 @@ shape::shape(type_t t,
              std::vector<std::size_t> mins,
              std::vector<std::size_t> maxes,
              std::vector<std::set<std::size_t>> optimals_list)
-    : impl(std::make_shared<shape_impl>(
-          t, std::move(mins), std::move(maxes), std::move(optimals_list)))
+    : impl(shape_impl::intern(std::make_shared<shape_impl>(
+          t, std::move(mins), std::move(maxes), std::move(optimals_list))))
 {
 }
 
-shape::shape(const std::vector<shape>& subs) : impl(std::make_shared<shape_impl>(subs)) {}
+shape::shape(const std::vector<shape>& subs)
+    : impl(shape_impl::intern(std::make_shared<shape_impl>(subs)))
+{
+}
 
 shape::shape(std::shared_ptr<shape_impl> pimpl) : impl(std::move(pimpl)) {}
 
@@ -375,25 +592,17 @@ std::size_t shape::ndim() const
     return lens().size();
 }
 
-std::size_t shape::elements() const { return impl->elements(); }
-
-std::size_t shape::bytes() const
+std::size_t shape::elements() const
 {
-    if(this->sub_shapes().empty())
-    {
-        std::size_t n = 0;
-        this->visit_type([&](auto as) { n = as.size(); });
-        return n * this->element_space();
-    }
-    else
+    if(this->dynamic())
     {
-        return std::accumulate(this->sub_shapes().begin(),
-                               this->sub_shapes().end(),
-                               std::size_t{0},
-                               [&](auto x, auto y) { return x + y.bytes(); });
+        MIGRAPHX_THROW("SHAPE: elements() called on dynamic shape");
     }
+    return impl->m_elements;
 }
 
+std::size_t shape::bytes() const { return impl->m_bytes; }
+
 std::size_t shape::type_size() const
 {
     std::size_t n = 0;
@@ -465,61 +674,13 @@ bool shape::multi_within_bounds(std::vector<std::size_t> multi) const
     return std::equal(multi.begin(), multi.end(), this->lens().begin(), std::less<>{});
 }
 
-bool shape::packed() const
-{
-    if(this->dynamic())
-    {
-        return false;
-    }
-    return this->sub_shapes().empty() and not impl->skips() and
-           this->elements() == this->element_space();
-}
+bool shape::packed() const { return impl->m_packed; }
 
-bool shape::transposed() const
-{
-    if(this->dynamic())
-    {
-        return false;
-    }
-    if(this->broadcasted())
-    {
-        // TODO: Use a filter_iterator instead
-        std::vector<std::size_t> s;
-        s.reserve(this->strides().size());
-        std::copy_if(this->strides().begin(),
-                     this->strides().end(),
-                     std::back_inserter(s),
-                     [](std::size_t x) { return x != 0; });
-        return not std::is_sorted(s.rbegin(), s.rend());
-    }
-    else
-    {
-        return not std::is_sorted(this->strides().rbegin(), this->strides().rend());
-    }
-}
+bool shape::transposed() const { return impl->m_transposed; }
 
-bool shape::broadcasted() const
-{
-    if(this->dynamic())
-    {
-        return false;
-    }
-    assert(this->lens().size() == this->strides().size());
-    return std::any_of(
-        this->strides().begin(), this->strides().end(), [](auto x) { return x == 0; });
-}
+bool shape::broadcasted() const { return impl->m_broadcasted; }
 
-bool shape::scalar() const
-{
-    if(this->dynamic())
-    {
-        return false;
-    }
-    assert(this->lens().size() == this->strides().size());
-    // if any stride > 0, then accumulate will return false
-    return this->sub_shapes().empty() and
-           std::accumulate(this->strides().begin(), this->strides().end(), std::size_t(0)) == 0;
-}
+bool shape::scalar() const { return impl->m_scalar; }
 
 bool shape::standard() const { return impl->m_standard; }
 
@@ -563,7 +724,7 @@ shape shape::with_type(type_t t) const
 {
     auto c    = impl->copy();
     c->m_type = t;
-    return {c};
+    return {shape_impl::intern(c)};
 }
 
 shape shape::to_dynamic() const
@@ -608,7 +769,9 @@ shape shape::to_static(std::size_t x) const
     return {type(), static_lens};
 }
 
-std::size_t shape::element_space() const { return impl->element_space(); }
+std::size_t shape::element_space() const { return impl->m_element_space; }
+
+std::size_t shape::hash() const { return impl->m_hash; }
 
 std::string shape::type_string() const { return name(this->type()); }
 
@@ -725,6 +888,11 @@ shape::dynamic_dimension operator-(const shape::dynamic_dimension& x, const std:
 
 bool operator==(const shape& x, const shape& y)
 {
+    if(x.impl == y.impl)
+        return true;
+    // Equal shapes are nearly always interned to the same impl, so this rejects almost everything
+    if(x.impl->m_hash != y.impl->m_hash)
+        return false;
     if(x.dynamic() and y.dynamic())
     {
         return x.impl == y.impl or (x.type() == y.type() and x.dyn_dims() == y.dyn_dims() and
@@ -0,0 +1,209 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/shard_dots.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/param_utils.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/ranges.hpp>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The constant weights of a dot, looking through the broadcast of the batch dimensions
+static instruction_ref get_weights(instruction_ref dot)
+{
+    auto w = dot->inputs().at(1);
+    if(w->name() == "multibroadcast")
+        return w->inputs().front();
+    return w;
+}
+
+static bool has_constant_weights(instruction_ref ins)
+{
+    if(ins->name() != "dot")
+        return false;
+    if(std::any_of(ins->inputs().begin(), ins->inputs().end(), [](auto input) {
+           return input->get_shape().dynamic();
+       }))
+        return false;
+    auto w = get_weights(ins);
+    return w->get_shape().ndim() >= 2 and w->can_eval();
+}
+
+// A dot that consumes a column split result reduces over the split dimension, so its weights can
+// be split by row
+static bool is_row_dot(instruction_ref ins, instruction_ref input)
+{
+    return has_constant_weights(ins) and ins->inputs().front() == input;
+}
+
+static bool is_pointwise_of(instruction_ref ins, instruction_ref input)
+{
+    if(not ins->get_operator().attributes().contains("pointwise"))
+        return false;
+    return std::all_of(ins->inputs().begin(), ins->inputs().end(), [&](auto x) {
+        return x->get_shape().lens() == input->get_shape().lens();
+    });
+}
+
+// Collect the dot along with the pointwise ops and the row split dot that can run in the same
+// shard
+static std::vector<instruction_ref> find_chain(instruction_ref dot)
+{
+    std::vector<instruction_ref> chain = {dot};
+    auto last                          = dot;
+    while(last->outputs().size() == 1)
+    {
+        auto next = last->outputs().front();
+        if(is_row_dot(next, last))
+        {
+            chain.push_back(next);
+            break;
+        }
+        if(not is_pointwise_of(next, last))
+            break;
+        chain.push_back(next);
+        last = next;
+    }
+    return chain;
+}
+
+static literal
+slice_literal(const argument& a, std::size_t axis, std::size_t start, std::size_t end)
+{
+    auto op = make_op("slice", {{"axes", {axis}}, {"starts", {start}}, {"ends", {end}}});
+    auto s  = op.compute_shape({a.get_shape()});
+    auto r  = op.compute(s, {a});
+    literal result;
+    r.visit([&](auto x) { result = literal{shape{s.type(), s.lens()}, x.begin(), x.end()}; });
+    return result;
+}
+
+void shard_dots::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    // Only the top level is split, the modules created for the shards are left alone
+    if(shards < 2 or &m != mpm.get_root_module())
+        return;
+    std::unordered_set<instruction_ref> sharded;
+    std::size_t n = 0;
+    for(auto ins : iterator_for(m))
+    {
+        if(contains(sharded, ins) or not has_constant_weights(ins))
+            continue;
+        if(ins->get_shape().lens().back() % shards != 0)
+            continue;
+        auto chain = find_chain(ins);
+        sharded.insert(chain.begin(), chain.end());
+        auto last   = chain.back();
+        bool by_row = chain.size() > 1 and last->name() == "dot";
+        auto cols   = ins->get_shape().lens().back() / shards;
+
+        std::unordered_map<instruction_ref, argument> weights;
+        for(auto x : chain)
+        {
+            if(x->name() == "dot")
+                weights[x] = get_weights(x)->eval();
+        }
+
+        std::vector<instruction_ref> results;
+        for(auto i : range(shards))
+        {
+            auto start = i * cols;
+            auto end   = start + cols;
+            auto* sm   = mpm.create_module(m.name() + ":shard" + std::to_string(n) + ":" +
+                                         std::to_string(i));
+            std::vector<instruction_ref> inputs;
+            std::unordered_map<instruction_ref, instruction_ref> params;
+            std::unordered_map<instruction_ref, instruction_ref> map_ins;
+            auto add_input = [&](instruction_ref input) {
+                if(not contains(params, input))
+                {
+                    params[input] =
+                        sm->add_parameter(param_name(inputs.size()), input->get_shape());
+                    inputs.push_back(input);
+                }
+                return params.at(input);
+            };
+            for(auto x : chain)
+            {
+                if(x->name() == "dot")
+                {
+                    bool row  = x != ins;
+                    auto w    = get_weights(x);
+                    auto axis = w->get_shape().ndim() - (row ? 2 : 1);
+                    auto wi   = sm->add_literal(slice_literal(weights.at(x), axis, start, end));
+                    if(w != x->inputs().at(1))
+                    {
+                        auto lens = x->inputs().at(1)->get_shape().lens();
+                        lens[lens.size() - (row ? 2 : 1)] = cols;
+                        wi = sm->add_instruction(make_op("multibroadcast", {{"out_lens", lens}}),
+                                                 wi);
+                    }
+                    auto input = x->inputs().front();
+                    auto a     = row ? map_ins.at(input) : add_input(input);
+                    map_ins[x] = sm->add_instruction(x->get_operator(), a, wi);
+                    continue;
+                }
+                // Inputs from outside the chain hold the full columns, so only this shard's part
+                // is used
+                std::vector<instruction_ref> args;
+                std::transform(
+                    x->inputs().begin(), x->inputs().end(), std::back_inserter(args), [&](auto y) {
+                        if(contains(map_ins, y))
+                            return map_ins.at(y);
+                        auto axis = y->get_shape().ndim() - 1;
+                        return sm->add_instruction(
+                            make_op("slice",
+                                    {{"axes", {axis}}, {"starts", {start}}, {"ends", {end}}}),
+                            add_input(y));
+                    });
+                map_ins[x] = sm->add_instruction(x->get_operator(), args);
+            }
+            sm->add_return({map_ins.at(last)});
+
+            auto r = m.insert_instruction(
+                last, make_op("run_on_target", {{"target_id", i}}), inputs, {sm});
+            results.push_back(
+                m.insert_instruction(last, make_op("get_tuple_elem", {{"index", 0}}), r));
+        }
+        if(by_row)
+            m.replace_instruction(last, make_op("all_reduce"), results);
+        else
+            m.replace_instruction(
+                last, make_op("all_gather", {{"axis", last->get_shape().ndim() - 1}}), results);
+        n++;
+    }
+    mpm.run_pass(dead_code_elimination{});
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
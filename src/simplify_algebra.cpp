@@ -30,6 +30,7 @@
 #include <migraphx/op/broadcast.hpp>
 #include <migraphx/op/reshape.hpp>
 #include <migraphx/op/transpose.hpp>
+#include <migraphx/op/image_preprocess.hpp>
 #include <migraphx/matcher.hpp>
 #include <migraphx/common.hpp>
 #include <migraphx/literal.hpp>
@@ -37,6 +38,9 @@
 #include <migraphx/serialize.hpp>
 
 #include <migraphx/algorithm.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <optional>
 #include <unordered_set>
 
 namespace migraphx {
@@ -1595,6 +1599,102 @@ struct find_div_const
     }
 };
 
+// Folds the normalization of an image with a constant for each channel into image_preprocess
+struct find_image_preprocess_normalize
+{
+    auto matcher() const
+    {
+        auto image = match::name("image_preprocess")(match::used_once()).bind("x");
+        return match::name("add", "sub", "mul", "div")(
+            match::either_arg(0, 1)(image, match::is_constant().bind("c")));
+    }
+
+    // The values of a constant in NCHW layout that only change along the channels
+    static std::optional<std::vector<float>> channel_values(const argument& a)
+    {
+        std::optional<std::vector<float>> result;
+        a.visit([&](auto v) {
+            auto s = v.get_shape();
+            if(s.ndim() != 4)
+                return;
+            std::vector<float> values(s.lens()[1]);
+            for(std::size_t c = 0; c < values.size(); c++)
+                values[c] = v(0, c, 0, 0);
+            bool same = true;
+            shape_for_each(s, [&](const auto& idx) {
+                same = same and float_equal(float(v(idx.begin(), idx.end())), values[idx[1]]);
+            });
+            if(same)
+                result = values;
+        });
+        return result;
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins   = r.result;
+        auto x_ins = r.instructions["x"];
+        auto c_ins = r.instructions["c"];
+        if(contains({"sub", "div"}, ins->name()) and ins->inputs().front() != x_ins)
+            return;
+        auto op = any_cast<op::image_preprocess>(x_ins->get_operator());
+        if(op.type != shape::float_type)
+            return;
+        auto c = c_ins->eval();
+        if(c.empty())
+            return;
+        auto values = channel_values(c);
+        if(not values.has_value())
+            return;
+        auto channels = x_ins->get_shape().lens()[1];
+        std::vector<float> mean(channels);
+        std::vector<float> stddev(channels);
+        for(std::size_t i = 0; i < channels; i++)
+        {
+            auto v    = values->at(i);
+            mean[i]   = op.channel_mean(i);
+            stddev[i] = op.channel_stddev(i);
+            // (x - mean) / stddev with the constant applied is still of the same form
+            if(ins->name() == "add")
+                mean[i] -= v * stddev[i];
+            else if(ins->name() == "sub")
+                mean[i] += v * stddev[i];
+            else if(float_equal(v, 0.0f))
+                return;
+            else if(ins->name() == "mul")
+                stddev[i] /= v;
+            else
+                stddev[i] *= v;
+        }
+        op.mean   = mean;
+        op.stddev = stddev;
+        m.replace_instruction(ins, op, x_ins->inputs());
+    }
+};
+
+// Writes the output of image_preprocess directly in the type it is converted to
+struct find_image_preprocess_convert
+{
+    auto matcher() const
+    {
+        return match::name("convert")(
+            match::arg(0)(match::name("image_preprocess")(match::used_once()).bind("x")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins   = r.result;
+        auto x_ins = r.instructions["x"];
+        auto op    = any_cast<op::image_preprocess>(x_ins->get_operator());
+        auto t     = ins->get_shape().type();
+        if(op.type != shape::float_type or
+           not contains({shape::half_type, shape::bf16_type, shape::double_type}, t))
+            return;
+        op.type = t;
+        m.replace_instruction(ins, op, x_ins->inputs());
+    }
+};
+
 struct find_unit_ops
 {
     auto matcher() const
@@ -1981,6 +2081,8 @@ void simplify_algebra::apply(module& m) const
                             find_dot_slice{},
                             find_dot_mul{},
                             find_mul_add{},
+                            find_image_preprocess_normalize{},
+                            find_image_preprocess_convert{},
                             find_unit_ops{},
                             find_neg_unit_ops{},
                             eliminate_zero_point{},
@@ -95,6 +95,8 @@ struct find_resize_static
         auto ins       = mr.result;
         auto inputs    = ins->inputs();
         auto resize_op = any_cast<op::resize>(ins->get_operator());
+        if(resize_op.mode != "nearest")
+            return;
 
         auto in_lens = inputs.at(0)->get_shape().lens();
         std::vector<size_t> sizes_vec(inputs.at(0)->get_shape().ndim());
@@ -435,12 +435,47 @@ void add_int4_pack_unpack_pair(module& m)
     }
 }
 
+// Int4 weights are often stored as [N, K] and transposed after the dequantize. Moving the
+// transpose onto the packed weights, scales and zero points leaves the dequantize directly in
+// front of the dot, which is the form the weight-only gemm fusion looks for.
+void move_transpose_before_int4_dequantize(module& m)
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "transpose")
+            continue;
+        auto dq = ins->inputs().front();
+        if(dq->name() != "dequantizelinear" or dq->outputs().size() != 1)
+            continue;
+        auto unpack = dq->inputs().front();
+        if(unpack->name() != "unpack_int4" or unpack->outputs().size() != 1)
+            continue;
+        auto perm  = ins->get_operator().to_value()["permutation"].to_vector<int64_t>();
+        auto axis  = unpack->get_operator().to_value()["axis"].to<int64_t>();
+        auto ndim  = static_cast<int64_t>(perm.size());
+        axis       = axis < 0 ? axis + ndim : axis;
+        auto it    = std::find(perm.begin(), perm.end(), axis);
+        auto trans = ins->get_operator();
+
+        auto packed = m.insert_instruction(ins, trans, unpack->inputs().front());
+        std::vector<instruction_ref> inputs;
+        inputs.push_back(m.insert_instruction(
+            ins, make_op("unpack_int4", {{"axis", it - perm.begin()}}), packed));
+        std::transform(dq->inputs().begin() + 1,
+                       dq->inputs().end(),
+                       std::back_inserter(inputs),
+                       [&](auto arg) { return m.insert_instruction(ins, trans, arg); });
+        m.replace_instruction(ins, dq->get_operator(), inputs);
+    }
+}
+
 } // namespace
 
 void simplify_qdq::apply(module& m) const
 {
     // first step: add pack/unpack pair between qdq for int4 weights
     add_int4_pack_unpack_pair(m);
+    move_transpose_before_int4_dequantize(m);
     match::find_matches(m, match_find_quantizable_ops{});
     migraphx::run_passes(m, {migraphx::dead_code_elimination{}});
     remove_qdq_pairs(m);
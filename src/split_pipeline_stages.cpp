@@ -0,0 +1,162 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/split_pipeline_stages.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/param_utils.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/ranges.hpp>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Rough amount of work done by the instruction, dots and convolutions do a multiply-add per
+// output for each element they reduce over
+static std::size_t estimate_cost(instruction_ref ins)
+{
+    auto n = ins->get_shape().elements();
+    if(contains({"dot", "quant_dot"}, ins->name()))
+        return n * ins->inputs().front()->get_shape().lens().back();
+    if(contains({"convolution", "quant_convolution"}, ins->name()))
+    {
+        const auto& wlens = ins->inputs().at(1)->get_shape().lens();
+        return n * std::accumulate(
+                       wlens.begin() + 1, wlens.end(), std::size_t{1}, std::multiplies<>{});
+    }
+    return n;
+}
+
+// Split the instructions into consecutive groups with about the same cost
+static std::vector<std::vector<instruction_ref>>
+group_stages(const std::vector<instruction_ref>& inss, std::size_t stages)
+{
+    std::vector<std::size_t> costs;
+    std::transform(inss.begin(), inss.end(), std::back_inserter(costs), &estimate_cost);
+    auto total = std::accumulate(costs.begin(), costs.end(), std::size_t{0});
+    std::vector<std::vector<instruction_ref>> groups(1);
+    std::size_t acc = 0;
+    for(auto i : range(inss.size()))
+    {
+        if(groups.size() < stages and not groups.back().empty() and
+           acc * stages >= total * groups.size())
+            groups.emplace_back();
+        groups.back().push_back(inss[i]);
+        acc += costs[i];
+    }
+    return groups;
+}
+
+static void move_stage(module_pass_manager& mpm,
+                       const std::vector<instruction_ref>& group,
+                       std::size_t target_id)
+{
+    auto& m = mpm.get_module();
+    std::unordered_set<instruction_ref> in_stage(group.begin(), group.end());
+    auto* sm = mpm.create_module(m.name() + ":stage" + std::to_string(target_id));
+    std::vector<instruction_ref> inputs;
+    std::unordered_map<instruction_ref, instruction_ref> map_ins;
+    auto get_input = [&](instruction_ref input) {
+        if(contains(map_ins, input))
+            return map_ins.at(input);
+        // Keep the weights with the stage that uses them
+        if(input->name() == "@literal")
+        {
+            map_ins[input] = sm->add_literal(input->get_literal());
+        }
+        else
+        {
+            map_ins[input] = sm->add_parameter(param_name(inputs.size()), input->get_shape());
+            inputs.push_back(input);
+        }
+        return map_ins.at(input);
+    };
+    for(auto ins : group)
+    {
+        std::vector<instruction_ref> args;
+        std::transform(
+            ins->inputs().begin(), ins->inputs().end(), std::back_inserter(args), get_input);
+        map_ins[ins] = sm->add_instruction(ins->get_operator(), args);
+    }
+
+    std::vector<instruction_ref> outputs;
+    std::copy_if(group.begin(), group.end(), std::back_inserter(outputs), [&](auto ins) {
+        return std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](auto output) {
+            return not contains(in_stage, output);
+        });
+    });
+    std::vector<instruction_ref> returns;
+    std::transform(outputs.begin(), outputs.end(), std::back_inserter(returns), [&](auto ins) {
+        return map_ins.at(ins);
+    });
+    sm->add_return(returns);
+
+    auto pos = std::next(group.back());
+    auto r   = m.insert_instruction(
+        pos, make_op("run_on_target", {{"target_id", target_id}}), inputs, {sm});
+    for(auto i : range(outputs.size()))
+    {
+        auto elem  = m.insert_instruction(pos, make_op("get_tuple_elem", {{"index", i}}), r);
+        auto users = outputs[i]->outputs();
+        for(auto user : users)
+        {
+            if(not contains(in_stage, user))
+                instruction::replace_argument(user, outputs[i], elem);
+        }
+    }
+}
+
+void split_pipeline_stages::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    if(stages < 2 or &m != mpm.get_root_module())
+        return;
+    std::vector<instruction_ref> inss;
+    for(auto ins : iterator_for(m))
+    {
+        if(contains({"@param", "@literal", "@return"}, ins->name()))
+            continue;
+        // Submodules can refer to the instructions of the module, so they can't be moved into a
+        // stage
+        if(ins->name() == "run_on_target" or not ins->module_inputs().empty())
+            return;
+        if(ins->get_shape().any_of_dynamic())
+            return;
+        inss.push_back(ins);
+    }
+    if(inss.size() < stages)
+        return;
+    auto groups = group_stages(inss, stages);
+    for(auto i : range(groups.size()))
+        move_stage(mpm, groups[i], i);
+    mpm.run_pass(dead_code_elimination{});
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
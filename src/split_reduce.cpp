@@ -38,6 +38,7 @@
 #include <migraphx/fuse_pointwise.hpp>
 #include <migraphx/algorithm.hpp>
 #include <migraphx/param_utils.hpp>
+#include <limits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -53,7 +54,15 @@ struct split_fused_reduce
         return pack(f(self.axes, "axes"), f(self.assign, "assign"));
     }
 
-    value attributes() const { return {{"prefill", 0}}; }
+    // The output is filled with the identity of the assign before the groups are combined into it
+    value attributes() const
+    {
+        if(assign == "assign_max")
+            return {{"prefill", -std::numeric_limits<float>::infinity()}};
+        if(assign == "assign_min")
+            return {{"prefill", std::numeric_limits<float>::infinity()}};
+        return {{"prefill", 0}};
+    }
 
     shape compute_shape(const std::vector<shape>& inputs, std::vector<module_ref> mods) const
     {
@@ -74,7 +83,10 @@ struct split_fused_reduce
 };
 MIGRAPHX_REGISTER_OP(split_fused_reduce);
 
-static bool is_reduce(const instruction& ins) { return contains(ins.name(), "reduce"); }
+static bool is_reduce(const instruction& ins)
+{
+    return ins.get_operator().attributes().get("reduce", false);
+}
 
 namespace {
 struct splitter
@@ -94,12 +106,14 @@ struct splitter
         copy_if(iterator_for(*rm), std::back_inserter(result), [](auto ins) {
             return is_reduce(*ins);
         });
-        if(result.size() > 2)
+        if(result.empty() or result.size() > 2)
+            return {};
+        // Each group is combined into the output with an atomic, so all the reductions must use
+        // the same one
+        if(not contains({"reduce_sum", "reduce_max", "reduce_min"}, result.front()->name()))
             return {};
-        // Only handle reduce_sum for now
-        // TODO: Support other reduction types
-        if(not std::all_of(result.begin(), result.end(), [](instruction_ref ins) {
-               return ins->name() == "reduce_sum";
+        if(not std::all_of(result.begin(), result.end(), [&](instruction_ref ins) {
+               return ins->name() == result.front()->name();
            }))
             return {};
         if(result.size() < 2)
@@ -171,6 +185,13 @@ static std::size_t get_reduce_size(const_module_ref rm)
     return ins->inputs().front()->get_shape().elements() / ins->get_shape().elements();
 }
 
+static std::size_t get_reduce_outputs(const_module_ref rm)
+{
+    auto ins = std::find_if(rm->begin(), rm->end(), &is_reduce);
+    assert(ins != rm->end());
+    return ins->get_shape().elements();
+}
+
 void split_reduce::apply(module_pass_manager& mpm) const
 {
     for(auto ins : iterator_for(mpm.get_module()))
@@ -178,16 +199,25 @@ void split_reduce::apply(module_pass_manager& mpm) const
         if(ins->name() != "fused_reduce")
             continue;
         auto* rm = ins->module_inputs().front();
+        // TODO: Split fused reductions with multiple outputs
+        if(rm->get_output_shapes().size() != 1)
+            continue;
         if(get_reduce_size(rm) < split_size)
             continue;
+        if(max_outputs > 0 and get_reduce_outputs(rm) >= max_outputs)
+            continue;
         splitter s{rm};
         auto splits = s.find_splits();
         if(splits.empty())
             continue;
-        // Only use split reduce with float for now
+        // Only use split reduce with float for now, and only with half for sums since there is
+        // no atomic max or min for half
         // TODO: Support other data types
-        if(not std::all_of(splits.begin(), splits.end(), [](instruction_ref split) {
-               return contains({shape::float_type, shape::half_type}, split->get_shape().type());
+        std::vector<shape::type_t> types = {shape::float_type};
+        if(splits.front()->name() == "reduce_sum")
+            types.push_back(shape::half_type);
+        if(not std::all_of(splits.begin(), splits.end(), [&](instruction_ref split) {
+               return contains(types, split->get_shape().type());
            }))
             continue;
         auto v    = ins->get_operator().to_value();
@@ -29,6 +29,9 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/matcher.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/literal.hpp>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -109,7 +112,84 @@ bool any_sm_next(const_module_ref mm, const std::vector<dynamic_dimensions_check
 }
 
 /**
- * Makes all the shapes in the dynamic_dimension range.  Probably won't work for `if`
+ * Returns the sizes to create submodules for. When the dynamic_dimension has optimal values
+ * only those are used as buckets, along with the max so that every size in the range fits into
+ * a bucket; select_module pads the inputs up to the nearest bucket. Otherwise all the sizes in
+ * the range are used.
+ */
+std::vector<std::size_t> get_dim_sizes(const shape::dynamic_dimension& dd)
+{
+    std::vector<std::size_t> result;
+    if(dd.optimals.empty())
+    {
+        auto r = migraphx::range(dd.min, dd.max + 1);
+        result.assign(r.begin(), r.end());
+        return result;
+    }
+    std::copy_if(dd.optimals.begin(),
+                 dd.optimals.end(),
+                 std::back_inserter(result),
+                 [&](auto opt) { return opt >= dd.min and opt < dd.max; });
+    result.push_back(dd.max);
+    return result;
+}
+
+/**
+ * Returns the softmax instructions that reduce along the dynamic dimension. When the inputs are
+ * padded up to a bucket, the padded positions along that axis must not take part in them.
+ */
+std::vector<instruction_ref> find_padded_softmaxes(const_module_ref mm)
+{
+    std::vector<instruction_ref> result;
+    for(auto ins : iterator_for(*mm))
+    {
+        if(ins->name() != "softmax")
+            continue;
+        const auto& s = ins->inputs().front()->get_shape();
+        if(not s.dynamic())
+            continue;
+        auto axis = ins->get_operator().to_value()["axis"].to<std::int64_t>();
+        if(axis < 0)
+            axis += s.ndim();
+        if(not s.dyn_dims().at(axis).is_fixed())
+            result.push_back(ins);
+    }
+    return result;
+}
+
+/**
+ * Keeps the positions past the actual size of the dynamic dimension out of the softmax, by
+ * selecting the lowest value for them. The actual size is passed to the submodule in the
+ * `dim_size` parameter. This is the same masked softmax the fused attention kernels match.
+ */
+void mask_padded_softmax(module& m, instruction_ref softmax, instruction_ref dim_size)
+{
+    auto x     = softmax->inputs().front();
+    auto lens  = x->get_shape().lens();
+    auto axis  = softmax->get_operator().to_value()["axis"].to<std::int64_t>();
+    if(axis < 0)
+        axis += lens.size();
+    std::vector<std::int64_t> positions(lens[axis]);
+    std::iota(positions.begin(), positions.end(), 0);
+    auto pos = m.add_literal(literal{shape{shape::int64_type, {lens[axis]}}, positions});
+    literal lowest;
+    x->get_shape().visit_type(
+        [&](auto as) { lowest = literal{shape{x->get_shape().type(), {1}}, {as.min()}}; });
+    auto low    = m.add_literal(lowest);
+    auto bpos   = m.insert_instruction(
+        softmax, make_op("broadcast", {{"axis", axis}, {"out_lens", lens}}), pos);
+    auto bsize  = m.insert_instruction(
+        softmax, make_op("multibroadcast", {{"out_lens", lens}}), dim_size);
+    auto blow   = m.insert_instruction(
+        softmax, make_op("multibroadcast", {{"out_lens", lens}}), low);
+    auto mask   = m.insert_instruction(softmax, make_op("less"), bpos, bsize);
+    auto masked = m.insert_instruction(softmax, make_op("where"), mask, x, blow);
+    instruction::replace_argument(softmax, x, masked);
+}
+
+/**
+ * Makes all the shapes in the dynamic_dimension range, or only the optimal sizes if the
+ * dynamic_dimension has them.  Probably won't work for `if`
  * and `loop` instructions, depending on how the submodules for those
  * work. Inserts select_module instruction to the top. Replaces return, bypassing other
  * instructions. Skips if the dynamic parameter outputs to a select_module operator.
@@ -125,9 +205,14 @@ void split_single_dyn_dim::apply(module_pass_manager& mpm) const
     {
         // all dynamic dimension objects should be the same for all parameters in dd_check_vec
         auto dyn_dim = dd_check_vec->at(0).dd;
+        // With buckets the inputs can be padded, so softmaxes along the dynamic dimension are
+        // masked with the actual size
+        auto softmaxes = dyn_dim.optimals.empty() or not mask_padding
+                             ? std::vector<instruction_ref>{}
+                             : find_padded_softmaxes(mm);
         // create submodules for each dimension size
         std::vector<module_ref> submodules;
-        for(size_t dim_size : migraphx::range(dyn_dim.min, dyn_dim.max + 1))
+        for(size_t dim_size : get_dim_sizes(dyn_dim))
         {
             auto* submod = mpm.create_module("dim_" + std::to_string(dim_size));
             // instruction map for new static shaped submodule parameters
@@ -142,8 +227,32 @@ void split_single_dyn_dim::apply(module_pass_manager& mpm) const
             }
             auto outputs = submod->add_instructions(mm, &map_ins);
             submod->add_return({outputs});
+            if(not softmaxes.empty())
+            {
+                auto size_param =
+                    submod->add_parameter(dim_size_name, shape{shape::int64_type, {1}});
+                for(auto softmax : softmaxes)
+                    mask_padded_softmax(*submod, map_ins.at(softmax), size_param);
+            }
             submodules.push_back(submod);
         }
+        auto output_shapes       = mm->get_output_shapes();
+        migraphx::shape out_attr = migraphx::shape{output_shapes};
+        // The actual size of the dynamic dimension of the first dynamic parameter
+        optional<instruction_ref> size_ins;
+        if(not softmaxes.empty())
+        {
+            const auto& dd_check = dd_check_vec->front();
+            const auto& dds      = mm->get_parameter_shape(dd_check.dyn_param_str).dyn_dims();
+            auto axis            = std::distance(
+                dds.begin(), std::find_if(dds.begin(), dds.end(), [](const auto& dd) {
+                    return not dd.is_fixed();
+                }));
+            size_ins = mm->add_instruction(
+                make_op("dimensions_of", {{"start", axis}, {"end", axis + 1}}),
+                mm->get_parameter(dd_check.dyn_param_str));
+            param_names.push_back(dim_size_name);
+        }
         // sort parameters by name for consistency (vs. parameter order attr)
         std::sort(param_names.begin(), param_names.end());
         // redirect to select_module operator and return
@@ -151,9 +260,11 @@ void split_single_dyn_dim::apply(module_pass_manager& mpm) const
         std::transform(param_names.cbegin(),
                        param_names.cend(),
                        std::back_inserter(sm_inputs),
-                       [&](auto pn) { return mm->get_parameter(pn); });
-        auto output_shapes       = mm->get_output_shapes();
-        migraphx::shape out_attr = migraphx::shape{output_shapes};
+                       [&](auto pn) {
+                           if(pn == dim_size_name)
+                               return *size_ins;
+                           return mm->get_parameter(pn);
+                       });
         auto sm_ins              = mm->add_instruction(
             migraphx::make_op("select_module",
                               {{"output_dyn_shapes", migraphx::to_value(out_attr)}}),
@@ -31,7 +31,8 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
-using sqlite3_ptr = MIGRAPHX_MANAGE_PTR(sqlite3*, sqlite3_close);
+using sqlite3_ptr      = MIGRAPHX_MANAGE_PTR(sqlite3*, sqlite3_close);
+using sqlite3_stmt_ptr = MIGRAPHX_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
 
 struct sqlite_impl
 {
@@ -66,6 +67,17 @@ struct sqlite_impl
             MIGRAPHX_THROW(error_message());
     }
 
+    sqlite3_stmt_ptr prepare(const std::string& sql)
+    {
+        sqlite3_stmt* stmt = nullptr;
+        int rc             = sqlite3_prepare_v2(
+            get(), sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr);
+        sqlite3_stmt_ptr result{stmt};
+        if(rc != SQLITE_OK)
+            MIGRAPHX_THROW(error_message());
+        return result;
+    }
+
     std::string error_message() const
     {
         std::string msg = "sqlite3: ";
@@ -108,5 +120,42 @@ std::vector<std::unordered_map<std::string, std::string>> sqlite::execute(const
     return result;
 }
 
+std::vector<std::unordered_map<std::string, std::string>>
+sqlite::execute(const std::string& s, const std::vector<std::string>& params)
+{
+    auto stmt = impl->prepare(s);
+    for(std::size_t i = 0; i < params.size(); i++)
+    {
+        const auto& param = params[i];
+        auto index        = static_cast<int>(i + 1);
+        auto size         = static_cast<int>(param.size());
+        // SQLITE_TRANSIENT makes sqlite copy the text
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        int rc = sqlite3_bind_text(stmt.get(), index, param.data(), size, SQLITE_TRANSIENT);
+        if(rc != SQLITE_OK)
+            MIGRAPHX_THROW(impl->error_message());
+    }
+    std::vector<std::unordered_map<std::string, std::string>> result;
+    for(;;)
+    {
+        int rc = sqlite3_step(stmt.get());
+        if(rc == SQLITE_DONE)
+            break;
+        if(rc != SQLITE_ROW)
+            MIGRAPHX_THROW(impl->error_message());
+        std::unordered_map<std::string, std::string> row;
+        int n = sqlite3_column_count(stmt.get());
+        row.reserve(n);
+        for(int i = 0; i < n; i++)
+        {
+            const auto* text = sqlite3_column_text(stmt.get(), i);
+            row.emplace(sqlite3_column_name(stmt.get(), i),
+                        text == nullptr ? "" : reinterpret_cast<const char*>(text));
+        }
+        result.push_back(std::move(row));
+    }
+    return result;
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
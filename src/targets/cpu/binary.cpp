@@ -65,7 +65,7 @@ struct dnnl_binary : dnnl_op<dnnl_binary, dnnl::binary>
             }
         }
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 
@@ -0,0 +1,343 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/compile_pointwise.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/compile_src.hpp>
+#include <migraphx/cpp_generator.hpp>
+#include <migraphx/dynamic_loader.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/fileutils.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/reduce_dims.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_NATIVE_ARCH)
+
+using pointwise_kernel = std::function<void(std::size_t, std::size_t, void**)>;
+
+// NOLINTNEXTLINE
+static const char* const pointwise_preamble = R"__migraphx__(
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace migraphx {
+
+template <class T, class U>
+T convert(U x)
+{
+    return static_cast<T>(x);
+}
+
+template <class T, class U>
+std::common_type_t<T, U> max(T x, U y)
+{
+    return x > y ? x : y;
+}
+
+template <class T, class U>
+std::common_type_t<T, U> min(T x, U y)
+{
+    return x < y ? x : y;
+}
+
+template <class C, class T, class U>
+std::common_type_t<T, U> where(C c, T x, U y)
+{
+    return c ? x : y;
+}
+
+template <class T>
+T abs(T x)
+{
+    return x < 0 ? -x : x;
+}
+
+template <class T>
+auto rsqrt(T x)
+{
+    return 1 / std::sqrt(x);
+}
+
+template <class T, class U>
+auto mod(T x, U y)
+{
+    return std::fmod(std::remainder(x, y) + y, y);
+}
+
+#define MIGRAPHX_CPU_POINTWISE_FUNCTION(name) \
+    template <class... Ts>                    \
+    auto name(Ts... xs)                       \
+    {                                         \
+        return std::name(xs...);              \
+    }
+
+MIGRAPHX_CPU_POINTWISE_FUNCTION(acos)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(acosh)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(asin)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(asinh)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(atan)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(atanh)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(ceil)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(cos)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(cosh)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(erf)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(exp)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(floor)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(fmod)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(isinf)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(isnan)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(log)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(log2)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(nearbyint)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(pow)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(sin)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(sinh)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(sqrt)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(tan)
+MIGRAPHX_CPU_POINTWISE_FUNCTION(tanh)
+
+} // namespace migraphx
+
+)__migraphx__";
+
+static const std::vector<std::string>& supported_pointwise_ops()
+{
+    static const std::vector<std::string> ops = {
+        "abs",         "acos",        "acosh",      "add",   "asin",    "asinh",      "atan",
+        "atanh",       "bitwise_and", "ceil",       "clip",  "convert", "cos",        "cosh",
+        "div",         "elu",         "equal",      "erf",   "exp",     "floor",      "fmod",
+        "greater",     "isinf",       "isnan",      "leaky_relu",       "less",       "log",
+        "log2",        "logical_and", "logical_or", "logical_xor",      "max",        "min",
+        "mod",         "mul",         "nearbyint",  "neg",   "not",     "pow",        "prelu",
+        "recip",       "relu",        "rsqrt",      "sigmoid",          "sign",       "sin",
+        "sinh",        "sqdiff",      "sqrt",       "sub",   "tan",     "tanh",       "where"};
+    return ops;
+}
+
+static bool is_supported_type(shape::type_t t)
+{
+    return contains({shape::bool_type,
+                     shape::float_type,
+                     shape::double_type,
+                     shape::int8_type,
+                     shape::uint8_type,
+                     shape::int16_type,
+                     shape::uint16_type,
+                     shape::int32_type,
+                     shape::uint32_type,
+                     shape::int64_type,
+                     shape::uint64_type},
+                    t);
+}
+
+bool is_pointwise_compilable(const module& m)
+{
+    return std::all_of(m.begin(), m.end(), [](const instruction& ins) {
+        if(ins.name() == "@return")
+            return ins.inputs().size() == 1;
+        if(ins.get_shape().dynamic() or not is_supported_type(ins.get_shape().type()))
+            return false;
+        if(contains({"@param", "@literal"}, ins.name()))
+            return true;
+        return contains(supported_pointwise_ops(), ins.name());
+    });
+}
+
+// Offset expression of element `i` of a standard iteration over the lens of `s`
+static std::string index_expression(const shape& s)
+{
+    std::vector<std::string> terms;
+    std::size_t divisor = 1;
+    for(std::size_t j = s.ndim(); j > 0; j--)
+    {
+        auto len    = s.lens()[j - 1];
+        auto stride = s.strides()[j - 1];
+        if(len != 1 and stride != 0)
+        {
+            std::string term = "i";
+            if(divisor != 1)
+                term = "(" + term + " / " + std::to_string(divisor) + ")";
+            if(j != 1)
+                term = "(" + term + " % " + std::to_string(len) + ")";
+            if(stride != 1)
+                term += " * " + std::to_string(stride);
+            terms.push_back(term);
+        }
+        divisor *= len;
+    }
+    if(terms.empty())
+        return "0";
+    return join_strings(terms, " + ");
+}
+
+std::string generate_pointwise(const module& m, const std::vector<shape>& inputs)
+{
+    auto shapes       = reduce_dims(inputs);
+    const auto& out_s = shapes.back();
+    auto is_scalar    = [](const shape& s) {
+        return std::all_of(
+            s.strides().begin(), s.strides().end(), [](auto stride) { return stride == 0; });
+    };
+    // Walk the elements in memory order when every argument has the same packed layout
+    bool linear = out_s.packed() and std::all_of(shapes.begin(), shapes.end(), [&](const shape& s) {
+                      return s.strides() == out_s.strides() or is_scalar(s);
+                  });
+    std::vector<std::string> indices;
+    std::transform(shapes.begin(), shapes.end(), std::back_inserter(indices), [&](const shape& s) {
+        if(is_scalar(s))
+            return std::string{"0"};
+        if(linear or s.standard())
+            return std::string{"i"};
+        return index_expression(s);
+    });
+
+    cpp_generator g;
+    g.fmap([](const std::string& fname) { return "migraphx::" + fname; });
+    g.add_point_op("prelu", "${function:where}(${0} < 0, ${0} * ${1}, ${0})");
+    g.add_point_op("sign", "${function:where}(${0} > 0, 1, ${function:where}(${0} < 0, -1, 0))");
+    g.fresult(
+        [](const shape& s) { return "migraphx::convert<" + shape::cpp_type(s.type()) + ">"; });
+    auto f = g.create_function(
+        g.generate_module(m).set_attributes({"static", "inline"}).set_name("pointwise_op"));
+
+    auto ntypes = m.get_parameter_shapes();
+    auto pnames = m.get_parameter_names();
+    std::sort(pnames.begin(), pnames.end());
+    auto out_type = shape::cpp_type(out_s.type());
+
+    std::stringstream ss;
+    ss << pointwise_preamble << g.str() << "\n";
+    ss << "EXPORT extern \"C\" void migraphx_cpu_pointwise(std::size_t start, std::size_t end, "
+          "void** args)\n{\n";
+    for(auto i : range(pnames.size()))
+    {
+        auto type = shape::cpp_type(ntypes.at(pnames[i]).type());
+        ss << "    const auto* x" << i << " = reinterpret_cast<const " << type << "*>(args[" << i
+           << "]);\n";
+    }
+    ss << "    auto* y = reinterpret_cast<" << out_type << "*>(args[" << pnames.size() << "]);\n";
+    ss << "    for(std::size_t i = start; i < end; i++)\n";
+    std::vector<std::string> args;
+    for(auto i : range(pnames.size()))
+        args.push_back("x" + std::to_string(i) + "[" + indices[i] + "]");
+    ss << "        y[" << indices.back() << "] = " << f << "(" << join_strings(args, ", ")
+       << ");\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+static pointwise_kernel compile_pointwise_kernel(const std::string& src)
+{
+    static std::mutex m;
+    static std::unordered_map<std::string, pointwise_kernel> kernels;
+    std::lock_guard<std::mutex> lock(m);
+    auto it = kernels.find(src);
+    if(it != kernels.end())
+        return it->second;
+    src_compiler compiler;
+    compiler.flags = {"-std=c++17", "-O3", "-shared"};
+    // Tuning for the host is opt-in, since not every compiler accepts -march=native and the
+    // results could then differ between machines
+    if(enabled(MIGRAPHX_CPU_NATIVE_ARCH{}))
+        compiler.flags.emplace_back("-march=native");
+#ifndef _WIN32
+    compiler.flags.emplace_back("-fPIC");
+    compiler.flags.emplace_back("-DEXPORT=\"\"");
+#else
+    compiler.flags.emplace_back("-DEXPORT=__declspec(dllexport)");
+#endif
+    compiler.output = make_shared_object_filename("pointwise");
+    auto image      = compiler.compile({src_file{"pointwise.cpp", src}});
+    auto k =
+        dynamic_loader{image}.get_function<void(std::size_t, std::size_t, void**)>(
+            "migraphx_cpu_pointwise");
+    kernels.emplace(src, k);
+    return k;
+}
+
+struct cpu_pointwise
+{
+    std::string source;
+    std::shared_ptr<pointwise_kernel> kernel = nullptr;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.source, "source"));
+    }
+
+    std::string name() const { return "cpu::pointwise"; }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has_at_least(2);
+        return inputs.back();
+    }
+
+    void finalize(context&, const shape&, const std::vector<shape>&)
+    {
+        kernel = std::make_shared<pointwise_kernel>(compile_pointwise_kernel(source));
+    }
+
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
+    {
+        if(kernel == nullptr)
+            MIGRAPHX_THROW("cpu::pointwise: kernel has not been compiled");
+        std::vector<void*> ptrs;
+        std::transform(args.begin(), args.end(), std::back_inserter(ptrs), [](auto& arg) {
+            return static_cast<void*>(arg.data());
+        });
+        ctx.bulk_execute(output_shape.elements(), 1024, [&](std::size_t start, std::size_t end) {
+            (*kernel)(start, end, ptrs.data());
+        });
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+MIGRAPHX_REGISTER_OP(cpu_pointwise)
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
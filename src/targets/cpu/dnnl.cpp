@@ -49,7 +49,10 @@ namespace cpu {
 
 dnnl_context& get_dnnl_context()
 {
-    static dnnl_context ctx{}; // NOLINT
+    // Primitives run concurrently on the threads of the cpu streams, so each thread has its own
+    // dnnl stream on the shared engine
+    static dnnl::engine engine{dnnl::engine::kind::cpu, 0}; // NOLINT
+    thread_local dnnl_context ctx{engine};                  // NOLINT
     return ctx;
 }
 
@@ -64,6 +67,7 @@ dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t)
     switch(t)
     {
     case st::half_type: return dt::f16;
+    case st::bf16_type: return dt::bf16;
     case st::float_type: return dt::f32;
     case st::int32_type: return dt::s32;
     case st::int8_type: return dt::s8;
@@ -76,6 +80,17 @@ dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t)
 #pragma clang diagnostic pop
 #endif
 
+bool dnnl_supports_bf16()
+{
+#ifdef MIGRAPHX_ENABLE_ZENDNN
+    return false;
+#else
+    // Only use bf16 when the cpu has native instructions for it
+    auto isa = dnnl::get_effective_cpu_isa();
+    return isa == dnnl::cpu_isa::avx512_core_bf16 or isa == dnnl::cpu_isa::avx512_core_amx;
+#endif
+}
+
 dnnl::memory::format_tag to_dnnl_memory_format_tag(std::size_t n)
 {
     switch(n)
@@ -54,7 +54,7 @@ struct dnnl_eltwise : dnnl_op<dnnl_eltwise, dnnl::eltwise_forward>
         if(not s.packed())
             r = shape{s.type(), s.lens()};
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 
@@ -51,7 +51,8 @@ MIGRAPHX_PRED_MATCHER(without_post_ops, instruction_ref ins)
 
 bool workaround_dnnl_broken_post_ops(const operation& op, const operation& post_op)
 {
-    if(contains({"dnnl::dot", "dnnl::convolution"}, op.name()))
+    if(contains({"dnnl::dot", "dnnl::convolution", "dnnl::quant_dot", "dnnl::quant_convolution"},
+                op.name()))
         return true;
     auto pv = post_op.to_value();
     if(not pv.at("post_ops").empty())
@@ -101,14 +102,17 @@ struct find_post_ops
         auto x_ins = ins->inputs().front();
         auto x     = x_ins->get_operator();
 
-        if(workaround_dnnl_broken_post_ops(x, ins->get_operator()))
+        if(not enabled(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND{}) and
+           workaround_dnnl_broken_post_ops(x, ins->get_operator()))
             return;
 
         auto op       = merge_post_ops(x, ins->get_operator());
         auto inputs   = x_ins->inputs();
         inputs.back() = ins->inputs().back();
-        if(ins->name() == "dnnl::binary")
-            inputs.insert(std::prev(inputs.end()), ins->inputs().at(1));
+        // Pass the second input of a binary op and the inputs of its own binary post ops
+        inputs.insert(std::prev(inputs.end()),
+                      std::next(ins->inputs().begin()),
+                      std::prev(ins->inputs().end()));
         auto input_shapes = to_shapes(inputs);
         auto new_shape    = try_compute_shape(op, input_shapes);
         if(new_shape.empty() or new_shape.front() != ins->get_shape())
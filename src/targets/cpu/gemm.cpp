@@ -34,7 +34,8 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
-struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
+template <class Base>
+struct dnnl_gemm_base : Base
 {
     std::vector<int> arg_map(int) const
     {
@@ -57,6 +58,15 @@ struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
     }
 };
 
+struct dnnl_gemm : dnnl_gemm_base<dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>>
+{
+};
+
+struct dnnl_quant_gemm
+    : dnnl_gemm_base<dnnl_quant_op<dnnl_quant_gemm, dnnl::matmul, op::quant_dot>>
+{
+};
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,32 +21,32 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#ifndef MIGRAPHX_GUARD_CPU_COMPILE_POINTWISE_HPP
+#define MIGRAPHX_GUARD_CPU_COMPILE_POINTWISE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/export.h>
 #include <migraphx/shape.hpp>
-#include <migraphx/argument.hpp>
-#include <migraphx/gpu/device/argmax.hpp>
-#include <migraphx/gpu/device/tensor.hpp>
-#include <migraphx/gpu/device/launch.hpp>
-#include <migraphx/gpu/device/types.hpp>
-#include <migraphx/gpu/device/arg_op.hpp>
+#include <string>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-namespace device {
-
-void argmax(hipStream_t stream,
-            const argument& result,
-            const argument& arg,
-            int64_t axis,
-            bool select_last_index)
-{
-    if(select_last_index)
-        arg_op(argmax_op_last_index{}, stream, result, arg, axis);
-    else
-        arg_op(argmax_op_first_index{}, stream, result, arg, axis);
-}
-
-} // namespace device
-} // namespace gpu
+
+struct module;
+
+namespace cpu {
+
+/// Check that every instruction in the pointwise module can be generated as plain C++
+MIGRAPHX_CPU_EXPORT bool is_pointwise_compilable(const module& m);
+
+/// Generate the source of a kernel that evaluates the pointwise module over a range of elements.
+/// The inputs are the shapes of the arguments followed by the output shape.
+MIGRAPHX_CPU_EXPORT std::string generate_pointwise(const module& m,
+                                                   const std::vector<shape>& inputs);
+
+} // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_CPU_COMPILE_POINTWISE_HPP
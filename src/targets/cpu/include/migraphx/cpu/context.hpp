@@ -27,16 +27,47 @@
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/dnnl.hpp>
 #include <migraphx/cpu/parallel.hpp>
+#include <migraphx/cpu/stream.hpp>
 #include <migraphx/par_for.hpp>
+#include <migraphx/env.hpp>
 #include <migraphx/cpu/export.h>
+#include <memory>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_STREAMS)
+
 struct context
 {
-    void finish() const {}
+    // Number of streams the schedule pass can spread independent instructions over
+    std::size_t nstreams = value_of(MIGRAPHX_CPU_STREAMS{}, 1);
+
+    void finish() const
+    {
+        for(const auto& s : state->streams)
+            s->wait();
+    }
+
+    void set_stream(std::size_t n) { state->current = n; }
+
+    stream& get_stream()
+    {
+        // The threads of the streams are only started once they are used
+        while(state->streams.size() <= state->current)
+            state->streams.push_back(std::make_unique<stream>());
+        return *state->streams[state->current];
+    }
+
+    void create_events(std::size_t n)
+    {
+        while(state->events.size() <= n)
+            state->events.push_back(std::make_unique<event>());
+    }
+
+    event& get_event(std::size_t i) const { return *state->events.at(i); }
 
     template <class F>
     void bulk_execute(std::size_t n, std::size_t min_grain, F f)
@@ -49,6 +80,16 @@ struct context
     {
         this->bulk_execute(n, 256, f);
     }
+
+    private:
+    // Copies of the context share the same streams
+    struct stream_state
+    {
+        std::vector<std::unique_ptr<stream>> streams;
+        std::vector<std::unique_ptr<event>> events;
+        std::size_t current = 0;
+    };
+    std::shared_ptr<stream_state> state = std::make_shared<stream_state>();
 };
 
 } // namespace cpu
@@ -29,6 +29,10 @@
 #include <migraphx/reflect.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/serialize.hpp>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <unordered_map>
 #include <migraphx/errors.hpp>
 #include <migraphx/assert.hpp>
@@ -54,13 +58,15 @@ struct dnnl_context
 {
     dnnl::engine engine;
     dnnl::stream stream;
-    dnnl_context() : engine(dnnl::engine::kind::cpu, 0), stream(engine) {}
+    explicit dnnl_context(const dnnl::engine& e) : engine(e), stream(engine) {}
 };
 
 dnnl_context& get_dnnl_context();
 
 dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t);
 
+bool dnnl_supports_bf16();
+
 dnnl::memory::format_tag to_dnnl_memory_format_tag(std::size_t n);
 
 template <class R>
@@ -104,16 +110,67 @@ execute_wrapper<F> make_execute_wrapper(F f)
     return {std::move(f)};
 }
 
+// Identical ops share their primitive, since creating one picks the implementation each time
+template <class Primitive>
+struct dnnl_primitive_cache
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, Primitive> primitives;
+
+    template <class F>
+    Primitive get(const std::string& key, F make)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = primitives.find(key);
+        if(it == primitives.end())
+            it = primitives.emplace(key, make()).first;
+        return it->second;
+    }
+};
+
+template <class Primitive>
+dnnl_primitive_cache<Primitive>& get_dnnl_primitive_cache()
+{
+    static dnnl_primitive_cache<Primitive> cache{}; // NOLINT
+    return cache;
+}
+
+// Constant weights reordered into the blocked layout of the primitive. The reorder runs on the
+// first execution and is reused as long as the same weights are passed.
+struct dnnl_packed_weights
+{
+    std::mutex mutex;
+    const char* source = nullptr;
+    dnnl::memory packed;
+
+    dnnl::memory get(const dnnl::memory::desc& src, const dnnl::memory::desc& dst, char* data)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(source != data)
+        {
+            auto& ctx = get_dnnl_context();
+            dnnl::memory from{src, ctx.engine, data};
+            packed = dnnl::memory{dst, ctx.engine};
+            dnnl::reorder(from, packed).execute(ctx.stream, from, packed);
+            ctx.stream.wait();
+            source = data;
+        }
+        return packed;
+    }
+};
+
 template <class Derived, class Primitive>
 struct dnnl_op : auto_register_op<Derived>
 {
     std::vector<post_op> post_ops;
+    // Let dnnl pick the layout of the weights, which are then reordered once
+    bool pack_weights = false;
     std::function<argument(context& ctx, const std::vector<argument>& args)> execute;
 
     template <class Self, class F>
     static auto reflect_base(Self& self, F f)
     {
-        return pack(f(self.post_ops, "post_ops"));
+        return pack(f(self.post_ops, "post_ops"), f(self.pack_weights, "pack_weights"));
     }
 
     template <class Self, class F>
@@ -247,6 +304,11 @@ struct dnnl_op : auto_register_op<Derived>
         for(int i = 0; i < inputs.size(); i++)
         {
             result[m[i]] = to_dnnl_memory_desc(self.adjust_shape(inputs[i], i, output_shape));
+            if(pack_weights and m[i] == MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS))
+            {
+                const auto& d = result[m[i]];
+                result[m[i]]  = {d.dims(), d.data_type(), dnnl::memory::format_tag::any};
+            }
         }
         return result;
     }
@@ -274,8 +336,11 @@ struct dnnl_op : auto_register_op<Derived>
                 MIGRAPHX_THROW("Unknown post op algo: " + op.algo);
         });
         result.set_post_ops(po);
+        const auto& self = static_cast<const Derived&>(*this);
+        self.set_attr(result);
         return result;
     }
+    void set_attr(dnnl::primitive_attr&) const {}
     template <class T>
     auto get_primitive_desc(const T& desc, const dnnl::primitive_attr& attr) const
         -> decltype(typename Primitive::primitive_desc(desc, attr, get_dnnl_context().engine))
@@ -290,6 +355,27 @@ struct dnnl_op : auto_register_op<Derived>
         auto pd          = self.get_primitive_desc(desc, attr);
         return Primitive(pd);
     }
+    Primitive get_primitive(const shape& output_shape, const std::vector<shape>& inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        std::stringstream ss;
+        ss << self.name() << to_value(self) << output_shape;
+        for(const auto& input : inputs)
+            ss << input;
+        return get_dnnl_primitive_cache<Primitive>().get(
+            ss.str(), [&] { return get_primitive(to_memory_desc(output_shape, inputs)); });
+    }
+    // The blocked layout the primitive picked for the weights
+    static dnnl::memory::desc get_weights_desc(const Primitive& prim)
+    {
+        auto desc = prim.get_primitive_desc();
+#ifdef MIGRAPHX_ENABLE_ZENDNN
+        const auto* md = zendnn_primitive_desc_query_md(desc, zendnn_query_weights_md, 0);
+#else
+        const auto* md = dnnl_primitive_desc_query_md(desc, dnnl_query_weights_md, 0);
+#endif
+        return dnnl::memory::desc{*md};
+    }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
         return execute(ctx, args);
@@ -303,8 +389,7 @@ struct dnnl_op : auto_register_op<Derived>
     {
         // Compensate for allocation
         inputs.pop_back();
-        auto md        = to_memory_desc(output_shape, inputs);
-        auto prim      = get_primitive(md);
+        auto prim      = get_primitive(output_shape, inputs);
         auto impl_name = impl(prim);
         return {{"impl", impl_name}};
     }
@@ -316,8 +401,12 @@ struct dnnl_op : auto_register_op<Derived>
         const auto& self = static_cast<const Derived&>(*this);
         auto name        = self.name();
         auto md          = to_memory_desc(output_shape, inputs);
-        auto prim        = get_primitive(md);
+        auto prim        = get_primitive(output_shape, inputs);
         auto arg_lookup  = create_arg_map(inputs.size());
+        auto weights     = MIGRAPHX_DNNL_PREFIX(ARG_WEIGHTS);
+        std::shared_ptr<dnnl_packed_weights> packed;
+        if(pack_weights)
+            packed = std::make_shared<dnnl_packed_weights>();
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
 #endif
@@ -389,7 +478,14 @@ struct dnnl_op : auto_register_op<Derived>
             m[MIGRAPHX_DNNL_PREFIX(ARG_DST)] =
                 to_dnnl_memory(md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), args.back());
             for(int i = 0; i < args.size() - 1; i++)
-                m[arg_lookup[i]] = to_dnnl_memory(md.at(arg_lookup[i]), args[i]);
+            {
+                if(packed != nullptr and arg_lookup[i] == weights)
+                    m[weights] = packed->get(to_dnnl_memory_desc(args[i].get_shape()),
+                                             get_weights_desc(prim),
+                                             args[i].data());
+                else
+                    m[arg_lookup[i]] = to_dnnl_memory(md.at(arg_lookup[i]), args[i]);
+            }
             prim.execute(get_dnnl_context().stream, m);
             return args.back();
         });
@@ -428,11 +524,46 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
         self.required(check_shapes(inputs, self));
         auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 };
 
+// Quantized ops that can rescale the int32 accumulator to a float output in the primitive
+template <class Derived, class Primitive, class Op>
+struct dnnl_quant_op : dnnl_extend_op<Derived, Primitive, Op>
+{
+    std::vector<float> scales;
+    int scale_mask = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack_join(dnnl_extend_op<Derived, Primitive, Op>::reflect(self, f),
+                         pack(f(self.scales, "scales"), f(self.scale_mask, "scale_mask")));
+    }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        // Compensate for allocation
+        inputs.pop_back();
+        self.required(check_shapes(inputs, self));
+        auto r = migraphx::compute_shape(this->op, this->trim_post_op_inputs(inputs));
+        if(not scales.empty())
+            r = r.with_type(shape::float_type);
+        // Call to get_primitive to make sure an algo is available
+        this->get_primitive(r, inputs);
+        return r;
+    }
+
+    void set_attr(dnnl::primitive_attr& attr) const
+    {
+        if(not scales.empty())
+            attr.set_output_scales(scale_mask, scales);
+    }
+};
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,24 +21,30 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/nonzero.hpp>
-#include <migraphx/gpu/context.hpp>
-#include <migraphx/gpu/device/nonzero.hpp>
+#ifndef MIGRAPHX_GUARD_CPU_PREFUSE_OPS_HPP
+#define MIGRAPHX_GUARD_CPU_PREFUSE_OPS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/export.h>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-shape hip_nonzero::compute_shape(std::vector<shape> inputs) const
-{
-    return op.compute_shape({inputs.front()});
-}
+struct module;
 
-argument hip_nonzero::compute(context& ctx, const shape&, const std::vector<argument>& args) const
+namespace cpu {
+
+/// Replace gelu and layernorm patterns with their dnnl primitives before the pointwise operators
+/// are fused
+struct MIGRAPHX_CPU_EXPORT prefuse_ops
 {
-    return device::nonzero(ctx.get_stream().get(), args.back(), args.front());
-}
+    std::string name() const { return "cpu::prefuse_ops"; }
+    void apply(module& m) const;
+};
 
-} // namespace gpu
+} // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_CPU_PREFUSE_OPS_HPP
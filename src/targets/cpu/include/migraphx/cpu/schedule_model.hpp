@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,26 +21,33 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_DEVICE_ARGMAX_HPP
-#define MIGRAPHX_GUARD_RTGLIB_DEVICE_ARGMAX_HPP
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_SCHEDULE_MODEL_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_SCHEDULE_MODEL_HPP
 
-#include <migraphx/argument.hpp>
-#include <migraphx/gpu/device/config.hpp>
-#include <hip/hip_runtime_api.h>
+#include <migraphx/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-namespace device {
 
-void MIGRAPHX_DEVICE_EXPORT argmax(hipStream_t stream,
-                                   const argument& result,
-                                   const argument& arg,
-                                   int64_t axis,
-                                   bool select_last_index);
+struct module;
+struct operation;
+struct shape;
 
-} // namespace device
-} // namespace gpu
+namespace cpu {
+
+struct schedule_model
+{
+    std::size_t streams = 0;
+    std::size_t concurrency() const;
+    void sched(module& m, instruction_ref ins, std::size_t n) const;
+    void wait(module& m, instruction_ref ins, std::size_t wait_id) const;
+    void record(module& m, instruction_ref ins, std::size_t wait_id) const;
+    std::size_t weight(const operation& op, const std::vector<shape>& inputs) const;
+};
+
+} // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,22 +21,28 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_DEVICE_FILL_HPP
-#define MIGRAPHX_GUARD_RTGLIB_DEVICE_FILL_HPP
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_SCHEDULE_STREAMS_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_SCHEDULE_STREAMS_HPP
 
-#include <migraphx/argument.hpp>
-#include <migraphx/gpu/device/config.hpp>
-#include <hip/hip_runtime_api.h>
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/export.h>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-namespace device {
+struct module;
+namespace cpu {
 
-void MIGRAPHX_DEVICE_EXPORT fill(hipStream_t stream, const argument& result, unsigned long val);
+/// Spread the independent instructions of the module over the streams of the context, so
+/// branches of the graph run concurrently instead of one instruction after another
+struct MIGRAPHX_CPU_EXPORT schedule_streams
+{
+    std::size_t streams = 0;
+    std::string name() const { return "cpu::schedule_streams"; }
+    void apply(module& m) const;
+};
 
-} // namespace device
-} // namespace gpu
+} // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_STREAM_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_STREAM_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/export.h>
+#include <functional>
+#include <memory>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+struct stream_impl;
+struct event_impl;
+
+/// A queue of tasks that run in order on a dedicated thread, so the tasks of different streams
+/// run concurrently. Parallel loops in the tasks still share the process-wide thread pool.
+struct MIGRAPHX_CPU_EXPORT stream
+{
+    stream();
+    stream(const stream&)            = delete;
+    stream& operator=(const stream&) = delete;
+    ~stream();
+
+    void enqueue(std::function<void()> f);
+
+    /// Block until every task enqueued so far has run. The first exception thrown by a task is
+    /// rethrown.
+    void wait();
+
+    private:
+    std::unique_ptr<stream_impl> impl;
+};
+
+/// A point in a stream that other streams can wait for. Like a hip event, a wait is for the last
+/// record issued before it, so the event can be recorded again once it has been waited on.
+struct MIGRAPHX_CPU_EXPORT event
+{
+    event();
+    event(const event&)            = delete;
+    event& operator=(const event&) = delete;
+    ~event();
+
+    void record(stream& s);
+    void wait(stream& s);
+
+    private:
+    std::shared_ptr<event_impl> impl;
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
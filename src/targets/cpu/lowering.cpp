@@ -53,10 +53,9 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/tune_axis.hpp>
-#include <migraphx/match/layernorm.hpp>
-#include <migraphx/match/gelu_erf.hpp>
-#include <migraphx/match/gelu_tanh.hpp>
-#include <migraphx/matcher.hpp>
+#include <migraphx/cpu/compile_pointwise.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/stringutils.hpp>
 #include <unordered_map>
 #include <utility>
 #include <iostream>
@@ -65,6 +64,8 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND);
+
 template <typename T>
 T zero(const T&)
 {
@@ -278,6 +279,28 @@ struct cpu_apply
         });
     }
 
+    // Constant weights are passed in the blocked layout dnnl picks, so they are only reordered once
+    void extend_weights_op(const std::string& op_name, const std::string& cpu_name)
+    {
+        apply_map.emplace(op_name, [=](instruction_ref ins) {
+            auto v            = ins->get_operator().to_value();
+            v["pack_weights"] = ins->inputs().at(1)->can_eval();
+            return replace(ins, make_op(cpu_name, v));
+        });
+    }
+
+    // dnnl only has int8 kernels for signed weights, so the others are left to the reference ops
+    void extend_quant_op(const std::string& op_name, const std::string& cpu_name)
+    {
+        apply_map.emplace(op_name, [=](instruction_ref ins) {
+            if(ins->inputs().at(1)->get_shape().type() != shape::int8_type)
+                return ins;
+            auto v            = ins->get_operator().to_value();
+            v["pack_weights"] = ins->inputs().at(1)->can_eval();
+            return replace(ins, make_op(cpu_name, v));
+        });
+    }
+
     void extend_dnnl_algos(const std::string& dnnl_name,
                            const std::vector<std::pair<std::string, std::string>>& algos)
     {
@@ -296,21 +319,6 @@ struct cpu_apply
         }
     }
 
-    template <class M>
-    auto fuse_match(M matcher, const operation& op, const std::vector<std::string>& bind_inputs)
-    {
-        return match::make_match_finder(matcher, [=](auto&, const auto& r) {
-            auto ins = r.result;
-            std::vector<instruction_ref> inputs;
-            std::transform(bind_inputs.begin(),
-                           bind_inputs.end(),
-                           std::back_inserter(inputs),
-                           [&](const auto& s) { return r.instructions[s]; });
-            inputs.push_back(this->insert_allocation(ins, ins->get_shape()));
-            modl->replace_instruction(ins, op, inputs);
-        });
-    }
-
     void init()
     {
         extend_dnnl_algos("dnnl::binary",
@@ -342,10 +350,12 @@ struct cpu_apply
                           });
         extend_op("concat", "dnnl::concat");
         extend_op("contiguous", "dnnl::reorder");
-        extend_op("convolution", "dnnl::convolution");
+        extend_weights_op("convolution", "dnnl::convolution");
 #ifndef MIGRAPHX_ENABLE_ZENDNN
-        extend_op("convolution_backwards", "dnnl::convolution_backwards");
-        extend_op("dot", "dnnl::dot");
+        extend_weights_op("convolution_backwards", "dnnl::convolution_backwards");
+        extend_weights_op("dot", "dnnl::dot");
+        extend_quant_op("quant_convolution", "dnnl::quant_convolution");
+        extend_quant_op("quant_dot", "dnnl::quant_dot");
 #endif
         extend_op("erf", "cpu::erf");
         extend_op("gather", "cpu::gather");
@@ -362,15 +372,13 @@ struct cpu_apply
     void apply()
     {
         init();
-        // Apply fusion matchers first
-        match::find_matches(*modl,
-                            fuse_match(match::gelu_erf(),
-                                       make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_erf"}}),
-                                       {"x"}),
-                            fuse_match(match::gelu_tanh(),
-                                       make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_tanh"}}),
-                                       {"x"}),
-                            fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}));
+        // Compile the fused pointwise modules first, or inline them back so the remaining
+        // operators are lowered individually
+        for(auto it : iterator_for(*modl))
+        {
+            if(it->name() == "pointwise")
+                apply_pointwise(it);
+        }
         // Apply these operators first so the inputs can be const folded
         for(auto it : iterator_for(*modl))
         {
@@ -408,6 +416,175 @@ struct cpu_apply
         }
     }
 
+    instruction_ref apply_pointwise(instruction_ref ins) const
+    {
+        if(ins->get_shape().type() == shape::tuple_type)
+            return ins;
+        auto dnnl_ins = apply_dnnl_post_ops(ins);
+        if(dnnl_ins != ins)
+            return dnnl_ins;
+        const auto* pm = ins->module_inputs().front();
+        auto ops       = std::count_if(pm->begin(), pm->end(), [](const instruction& i) {
+            return not contains({"@param", "@literal", "@return"}, i.name());
+        });
+        bool has_literals = std::any_of(pm->begin(), pm->end(), [](const instruction& i) {
+            return i.name() == "@literal";
+        });
+        bool compilable = is_pointwise_compilable(*pm);
+        // A single operator that has a dnnl primitive is left to dnnl so it can still be fused
+        // as a post op
+        bool use_dnnl = ops == 1 and not has_literals and
+                        std::any_of(pm->begin(), pm->end(), [&](const instruction& i) {
+                            return apply_map.count(i.name()) > 0;
+                        });
+        if(compilable and not use_dnnl)
+        {
+            auto inputs = to_shapes(ins->inputs());
+            inputs.push_back(ins->get_shape());
+            auto src = generate_pointwise(*pm, inputs);
+            return replace(ins, make_op("cpu::pointwise", {{"source", src}}));
+        }
+        // The literals in the module are scalars so they can only be evaluated by the module
+        if(has_literals)
+            return ins;
+        auto outputs = modl->insert_inline(ins, *pm, ins->inputs());
+        return modl->replace_instruction(ins, outputs.front());
+    }
+
+    static value make_post_op(const std::string& algo, float alpha = 0, float beta = 0)
+    {
+        return {{"algo", algo}, {"alpha", alpha}, {"beta", beta}};
+    }
+
+    // A pointwise module that is a chain of operators on one of its inputs runs as a single dnnl
+    // primitive with the rest of the chain as post ops, which fuse_ops can then fold into the
+    // primitive that produces that input
+    instruction_ref apply_dnnl_post_ops(instruction_ref ins) const
+    {
+        static const std::unordered_map<std::string, std::string> eltwise_algos = {
+            {"abs", "eltwise_abs"},
+            {"exp", "eltwise_exp"},
+            {"log", "eltwise_log"},
+            {"relu", "eltwise_relu"},
+            {"sigmoid", "eltwise_logistic"},
+            {"sqrt", "eltwise_sqrt"},
+            {"tanh", "eltwise_tanh"},
+        };
+        static const std::unordered_map<std::string, std::string> binary_algos = {
+            {"add", "binary_add"},
+            {"max", "binary_max"},
+            {"min", "binary_min"},
+            {"mul", "binary_mul"},
+        };
+        if(ins->get_shape().type() != shape::float_type or
+           std::any_of(ins->inputs().begin(), ins->inputs().end(), [](auto input) {
+               return input->get_shape().type() != shape::float_type;
+           }))
+            return ins;
+        const auto* pm = ins->module_inputs().front();
+        auto param_map = pm->get_ins_param_map(ins->inputs(), true);
+        auto is_scalar = [](instruction_ref i) {
+            return i->name() == "@literal" and i->get_shape().elements() == 1;
+        };
+        auto get_scalar = [](instruction_ref i) { return i->get_literal().at<float>(); };
+        std::vector<value> post_ops;
+        std::vector<instruction_ref> inputs;
+        auto x = pm->end();
+        for(auto i : iterator_for(*pm))
+        {
+            if(contains({"@param", "@literal"}, i->name()))
+                continue;
+            if(i->name() == "@return")
+            {
+                if(i->inputs().front() != x)
+                    return ins;
+                break;
+            }
+            // Each result can only be used by the next operator in the chain
+            if(i->outputs().size() != 1)
+                return ins;
+            auto pos = std::find_if(i->inputs().begin(), i->inputs().end(), [&](auto input) {
+                if(x == pm->end())
+                    return input->name() == "@param";
+                return input == x;
+            });
+            if(pos == i->inputs().end())
+                return ins;
+            if(x == pm->end())
+                inputs.push_back(param_map.at(*pos));
+            bool first = pos == i->inputs().begin();
+            auto n     = i->inputs().size();
+            if(n == 1 and contains(eltwise_algos, i->name()))
+            {
+                post_ops.push_back(make_post_op(eltwise_algos.at(i->name())));
+            }
+            else if(n == 1 and i->name() == "neg")
+            {
+                post_ops.push_back(make_post_op("eltwise_linear", -1, 0));
+            }
+            else if(n == 3 and i->name() == "clip" and first and is_scalar(i->inputs()[1]) and
+                    is_scalar(i->inputs()[2]))
+            {
+                post_ops.push_back(make_post_op(
+                    "eltwise_clip", get_scalar(i->inputs()[1]), get_scalar(i->inputs()[2])));
+            }
+            else if(n == 2 and is_scalar(i->inputs()[first ? 1 : 0]))
+            {
+                auto c = get_scalar(i->inputs()[first ? 1 : 0]);
+                if(i->name() == "add")
+                    post_ops.push_back(make_post_op("eltwise_linear", 1, c));
+                else if(i->name() == "mul")
+                    post_ops.push_back(make_post_op("eltwise_linear", c, 0));
+                else if(i->name() == "sub")
+                    post_ops.push_back(first ? make_post_op("eltwise_linear", 1, -c)
+                                             : make_post_op("eltwise_linear", -1, c));
+                else if(i->name() == "div" and first and c != 0)
+                    post_ops.push_back(make_post_op("eltwise_linear", 1 / c, 0));
+                else
+                    return ins;
+            }
+            else if(n == 2 and i->inputs()[first ? 1 : 0]->name() == "@param")
+            {
+                if(contains(binary_algos, i->name()))
+                    post_ops.push_back(make_post_op(binary_algos.at(i->name())));
+                else if(i->name() == "div" and first)
+                    post_ops.push_back(make_post_op("binary_div"));
+                else
+                    return ins;
+                inputs.push_back(param_map.at(i->inputs()[first ? 1 : 0]));
+            }
+            else
+            {
+                return ins;
+            }
+            x = i;
+        }
+        if(post_ops.empty())
+            return ins;
+        // Same combinations that fuse_ops avoids when merging post ops
+        if(not enabled(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND{}) and
+           std::adjacent_find(post_ops.begin(), post_ops.end(), [](const auto& a, const auto& b) {
+               auto a_algo = a.at("algo").template to<std::string>();
+               auto b_algo = b.at("algo").template to<std::string>();
+               return a_algo == b_algo or
+                      (starts_with(a_algo, "eltwise") and starts_with(b_algo, "eltwise"));
+           }) != post_ops.end())
+            return ins;
+        auto v         = post_ops.front();
+        auto algo      = v.at("algo").to<std::string>();
+        bool is_binary = starts_with(algo, "binary");
+        if(is_binary)
+            v = {{"algo", algo}};
+        v["post_ops"] = value::array(post_ops.begin() + 1, post_ops.end());
+        auto op       = make_op(is_binary ? "dnnl::binary" : "dnnl::eltwise", v);
+        auto shapes   = to_shapes(inputs);
+        shapes.push_back(ins->get_shape());
+        auto r = try_compute_shape(op, shapes);
+        if(r.empty() or r.front() != ins->get_shape())
+            return ins;
+        return replace(ins, op, inputs);
+    }
+
     instruction_ref apply_pow(instruction_ref ins) const
     {
         auto beta = read_scalar<float>(ins->inputs()[1]);
@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/prefuse_ops.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/matcher.hpp>
+#include <migraphx/match/layernorm.hpp>
+#include <migraphx/match/gelu_erf.hpp>
+#include <migraphx/match/gelu_tanh.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <functional>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+template <class M>
+static auto fuse_match(module& m,
+                       M matcher,
+                       const operation& op,
+                       const std::vector<std::string>& bind_inputs)
+{
+    return match::make_match_finder(matcher, [=, &m](auto&, const auto& r) {
+        auto ins = r.result;
+        std::vector<instruction_ref> inputs;
+        std::transform(bind_inputs.begin(),
+                       bind_inputs.end(),
+                       std::back_inserter(inputs),
+                       [&](const auto& s) { return r.instructions[s]; });
+        inputs.push_back(m.insert_instruction(
+            ins, make_op("allocate", {{"shape", to_value(ins->get_shape())}})));
+        m.replace_instruction(ins, op, inputs);
+    });
+}
+
+// Fold the dequantization scale into the int8 gemm or convolution, so dnnl can produce the
+// float output directly instead of a separate convert and mul
+struct find_quant_scale
+{
+    auto matcher() const
+    {
+        auto quant =
+            match::name("quant_dot", "quant_convolution")(match::used_once()).bind("quant");
+        auto convert = match::name("convert")(match::used_once(), match::arg(0)(quant));
+        return match::name("mul")(
+            match::either_arg(0, 1)(convert, match::is_constant().bind("scale")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins   = r.result;
+        auto quant = r.instructions["quant"];
+        auto scale = r.instructions["scale"];
+        if(ins->get_shape().type() != shape::float_type)
+            return;
+        if(quant->inputs().at(1)->get_shape().type() != shape::int8_type)
+            return;
+        auto name = "dnnl::" + quant->name();
+        if(not has_op(name))
+            return;
+        // The scale can only vary along the output channels
+        auto axis = quant->name() == "quant_dot" ? ins->get_shape().ndim() - 1 : 1;
+        auto arg  = scale->eval();
+        std::vector<float> scales(ins->get_shape().lens().at(axis));
+        std::vector<bool> found(scales.size(), false);
+        bool per_channel = true;
+        arg.visit([&](auto s) {
+            shape_for_each(arg.get_shape(), [&](const auto& idx) {
+                auto c = idx[axis];
+                auto x = float(s(idx.begin(), idx.end()));
+                if(not found[c])
+                    scales[c] = x;
+                else if(scales[c] != x)
+                    per_channel = false;
+                found[c] = true;
+            });
+        });
+        if(not per_channel)
+            return;
+        int mask = 1 << axis;
+        if(std::adjacent_find(scales.begin(), scales.end(), std::not_equal_to<>{}) ==
+           scales.end())
+        {
+            scales.resize(1);
+            mask = 0;
+        }
+        auto v            = quant->get_operator().to_value();
+        v["scales"]       = scales;
+        v["scale_mask"]   = mask;
+        v["pack_weights"] = quant->inputs().at(1)->can_eval();
+        auto inputs       = quant->inputs();
+        inputs.push_back(m.insert_instruction(
+            ins, make_op("allocate", {{"shape", to_value(ins->get_shape())}})));
+        m.replace_instruction(ins, make_op(name, v), inputs);
+    }
+};
+
+void prefuse_ops::apply(module& m) const
+{
+    match::find_matches(
+        m,
+        fuse_match(m,
+                   match::gelu_erf(),
+                   make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_erf"}}),
+                   {"x"}),
+        fuse_match(m,
+                   match::gelu_tanh(),
+                   make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_tanh"}}),
+                   {"x"}),
+        fuse_match(m, match::layernorm(), make_op("dnnl::layernorm"), {"x"}),
+        find_quant_scale{});
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -54,7 +54,7 @@ struct dnnl_reduction : dnnl_op<dnnl_reduction, dnnl::reduction>
         }
         auto r = shape{s.type(), lens};
         // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        this->get_primitive(r, inputs);
         return r;
     }
 
@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/schedule_streams.hpp>
+#include <migraphx/cpu/schedule_model.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/schedule.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/register_op.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Waits for every stream so the results can be read on the calling thread
+struct sync_stream
+{
+    std::string name() const { return "cpu::sync_stream"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        if(inputs.empty())
+            return {};
+        return inputs.front();
+    }
+
+    argument compute(const context& ctx, const shape&, const std::vector<argument>& args) const
+    {
+        ctx.finish();
+        if(args.empty())
+            return {};
+        return args.front();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& args) const
+    {
+        if(args.empty())
+            return -1;
+        return 0;
+    }
+};
+MIGRAPHX_REGISTER_OP(sync_stream)
+
+// Instructions without a context are not scheduled and run on the calling thread, which is only
+// safe for the ones that never read the data of their inputs such as views
+static bool reads_on_calling_thread(const instruction& ins)
+{
+    if(ins.name().front() == '@' or ins.inputs().empty())
+        return false;
+    const auto& op = ins.get_operator();
+    if(not op.is_context_free())
+        return false;
+    return not ins.module_inputs().empty() or op.output_alias(to_shapes(ins.inputs())) < 0;
+}
+
+void schedule_streams::apply(module& m) const
+{
+    if(streams < 2)
+        return;
+    if(std::any_of(m.begin(), m.end(), &reads_on_calling_thread))
+        return;
+    schedule{schedule_model{streams}}.apply(m);
+    if(std::none_of(m.begin(), m.end(), [](const instruction& ins) {
+           return ins.name() == "cpu::set_stream";
+       }))
+        return;
+    auto last = std::prev(m.end());
+    if(last->name() == "@return")
+    {
+        auto inputs  = last->inputs();
+        auto sync_in = m.insert_instruction(last, sync_stream{}, inputs);
+        // Only the return reads the synchronized value, the value can also have users before it
+        if(not inputs.empty())
+            instruction::replace_argument(last, inputs.front(), sync_in);
+    }
+    else
+    {
+        m.add_instruction(sync_stream{}, last);
+    }
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
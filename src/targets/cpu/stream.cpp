@@ -0,0 +1,158 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/stream.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+struct stream_impl
+{
+    std::mutex m;
+    std::condition_variable cv;
+    std::condition_variable done;
+    std::deque<std::function<void()>> tasks;
+    std::size_t pending          = 0;
+    bool stop                    = false;
+    std::exception_ptr exception = nullptr;
+    std::thread worker;
+
+    void run()
+    {
+        for(;;)
+        {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return stop or not tasks.empty(); });
+                if(tasks.empty())
+                    return;
+                f = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            try
+            {
+                f();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(m);
+                if(not exception)
+                    exception = std::current_exception();
+            }
+            std::lock_guard<std::mutex> guard(m);
+            if(--pending == 0)
+                done.notify_all();
+        }
+    }
+};
+
+stream::stream() : impl(std::make_unique<stream_impl>())
+{
+    impl->worker = std::thread([this] { impl->run(); });
+}
+
+stream::~stream()
+{
+    {
+        std::lock_guard<std::mutex> guard(impl->m);
+        impl->stop = true;
+    }
+    impl->cv.notify_all();
+    impl->worker.join();
+}
+
+void stream::enqueue(std::function<void()> f)
+{
+    {
+        std::lock_guard<std::mutex> guard(impl->m);
+        impl->tasks.push_back(std::move(f));
+        impl->pending++;
+    }
+    impl->cv.notify_one();
+}
+
+void stream::wait()
+{
+    std::unique_lock<std::mutex> lock(impl->m);
+    impl->done.wait(lock, [&] { return impl->pending == 0; });
+    if(impl->exception)
+        std::rethrow_exception(std::exchange(impl->exception, nullptr));
+}
+
+struct event_impl
+{
+    std::mutex m;
+    std::condition_variable cv;
+    // Records are numbered in the order they are issued, and completed holds the number of the
+    // last record that its stream reached
+    std::size_t recorded  = 0;
+    std::size_t completed = 0;
+};
+
+event::event() : impl(std::make_shared<event_impl>()) {}
+
+event::~event() = default;
+
+void event::record(stream& s)
+{
+    std::size_t n = 0;
+    {
+        std::lock_guard<std::mutex> guard(impl->m);
+        n = ++impl->recorded;
+    }
+    s.enqueue([e = impl, n] {
+        {
+            std::lock_guard<std::mutex> guard(e->m);
+            e->completed = std::max(e->completed, n);
+        }
+        e->cv.notify_all();
+    });
+}
+
+void event::wait(stream& s)
+{
+    std::size_t n = 0;
+    {
+        std::lock_guard<std::mutex> guard(impl->m);
+        n = impl->recorded;
+    }
+    if(n == 0)
+        return;
+    s.enqueue([e = impl, n] {
+        std::unique_lock<std::mutex> lock(e->m);
+        e->cv.wait(lock, [&] { return e->completed >= n; });
+    });
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -33,6 +33,7 @@
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/eliminate_convert.hpp>
+#include <migraphx/fuse_pointwise.hpp>
 #include <migraphx/layout_nhwc.hpp>
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/propagate_constant.hpp>
@@ -46,14 +47,19 @@
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/preallocate_param.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
+#include <migraphx/cpu/prefuse_ops.hpp>
+#include <migraphx/cpu/schedule_streams.hpp>
 #include <migraphx/cpu/write_literals.hpp>
 #include <migraphx/cpu/allocation_model.hpp>
 #include <migraphx/cpu/target.hpp>
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/lowering.hpp>
+#include <migraphx/cpu/dnnl.hpp>
 #include <migraphx/pass.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
+#include <algorithm>
+#include <iterator>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -69,10 +75,27 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
     std::set<std::string> unsupported_ops{
         "all", "scatternd_add", "scatternd_mul", "scatternd_none"};
     unsupported_types.erase(shape::type_t::float_type);
+    // Int8 gemms and convolutions run in dnnl, as do the bf16 ones when the cpu supports bf16
+    std::set<shape::type_t> quant_types{
+        shape::type_t::int8_type, shape::type_t::uint8_type, shape::type_t::int32_type};
+    std::set<std::string> quant_ops{"quant_dot", "quant_convolution"};
+    if(dnnl_supports_bf16())
+    {
+        quant_types.insert(shape::type_t::bf16_type);
+        quant_ops.insert({"dot", "convolution"});
+    }
+    std::set<shape::type_t> other_types;
+    std::set_difference(unsupported_types.begin(),
+                        unsupported_types.end(),
+                        quant_types.begin(),
+                        quant_types.end(),
+                        std::inserter(other_types, other_types.begin()));
     return {normalize_ops{},
             rewrite_quantization{},
             dead_code_elimination{},
-            eliminate_data_type{unsupported_types, shape::type_t::float_type, unsupported_ops},
+            eliminate_data_type{other_types, shape::type_t::float_type, unsupported_ops},
+            eliminate_data_type{
+                quant_types, shape::type_t::float_type, unsupported_ops, quant_ops},
             dead_code_elimination{},
             simplify_reshapes{},
             eliminate_convert{},
@@ -96,6 +119,10 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             propagate_constant{},
             dead_code_elimination{},
+            prefuse_ops{},
+            dead_code_elimination{},
+            fuse_pointwise{},
+            dead_code_elimination{},
             auto_contiguous{},
             lowering{},
             eliminate_contiguous{"dnnl::reorder"},
@@ -108,8 +135,11 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             write_literals{},
             dead_code_elimination{},
+            schedule_streams{ctx.nstreams},
             memory_coloring{"cpu::allocate"},
             dead_code_elimination{},
+            eliminate_identity{},
+            dead_code_elimination{},
             preallocate_param{"scratch", cpu_allocation_model{}},
             dead_code_elimination{}};
 }
@@ -26,6 +26,9 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/register_op.hpp>
+#include <migraphx/thread_pool.hpp>
+#include <algorithm>
+#include <memory>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -55,13 +58,33 @@ struct cpu_literal
 };
 MIGRAPHX_REGISTER_OP(cpu_literal);
 
+// Copy the literal from the pool so its pages are first touched by the threads, which places each
+// block on the numa node of the thread that processes the same block during bulk execution
+static argument first_touch_copy(const argument& a)
+{
+    auto& pool  = get_thread_pool();
+    auto bytes  = a.get_shape().bytes();
+    auto n      = pool.size();
+    auto buffer = std::shared_ptr<char>(new char[bytes], std::default_delete<char[]>()); // NOLINT
+    pool.run(n, [&](std::size_t t) {
+        auto first = (bytes * t) / n;
+        auto last  = (bytes * (t + 1)) / n;
+        std::copy(a.data() + first, a.data() + last, buffer.get() + first);
+    });
+    return {a.get_shape(), buffer};
+}
+
 void write_literals::apply(module& m) const
 {
+    bool first_touch = get_thread_pool().pinned();
     for(auto ins : iterator_for(m))
     {
         if(ins->name() != "@literal")
             continue;
-        m.replace_instruction(ins, cpu_literal{ins->get_literal().get_argument()});
+        auto data = ins->get_literal().get_argument();
+        if(first_touch)
+            data = first_touch_copy(data);
+        m.replace_instruction(ins, cpu_literal{data});
     }
 }
 
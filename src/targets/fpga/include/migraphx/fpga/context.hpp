@@ -26,16 +26,24 @@
 #define MIGRAPHX_GUARD_FPGA_CONTEXT_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/env.hpp>
+#include <memory>
+
+#include "migraphx/fpga/vitis_ai_adapter.hpp"
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace fpga {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_VITIS_AI_RUNNERS);
+
 struct context
 {
     int id = 0;
+    std::shared_ptr<vitis_ai::runner_queue> queue =
+        std::make_shared<vitis_ai::runner_queue>(value_of(MIGRAPHX_VITIS_AI_RUNNERS{}, 1));
 
-    void finish() const {}
+    void finish() const { queue->finish(); }
 };
 
 } // namespace fpga
@@ -25,7 +25,11 @@
 #ifndef MIGRAPHX_GUARD_FPGA_VITIS_AI_ADAPTER_HPP
 #define MIGRAPHX_GUARD_FPGA_VITIS_AI_ADAPTER_HPP
 
+#include <cstdint>
+#include <future>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <migraphx/instruction.hpp>
 #include <migraphx/pass_manager.hpp>
@@ -47,6 +51,24 @@ migraphx::argument execute(const x_model& xmodel,
                            const migraphx::shape& output_shape,
                            std::vector<migraphx::argument>& args);
 
+// Runs the fpga subgraphs in the background, so the host ops between submitting a job and waiting
+// on it overlap with the fpga. At most one job per runner is in flight.
+class runner_queue
+{
+    std::mutex mutex;
+    std::unordered_map<std::uint64_t, std::shared_future<migraphx::argument>> jobs;
+    std::uint64_t next_ticket = 0;
+    std::size_t runners       = 1;
+
+    public:
+    explicit runner_queue(std::size_t n);
+    std::uint64_t submit(const x_model& xmodel,
+                         const migraphx::shape& output_shape,
+                         std::vector<migraphx::argument> args);
+    migraphx::argument wait(std::uint64_t ticket);
+    void finish();
+};
+
 } // namespace vitis_ai
 
 #endif // MIGRAPHX_GUARD_FPGA_VITIS_AI_ADAPTER_HPP
@@ -27,6 +27,9 @@
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/stringutils.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/ranges.hpp>
 #include <iostream>
 
 #include "migraphx/fpga/vitis_ai_adapter.hpp"
@@ -36,6 +39,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 namespace fpga {
 
+// Submits the subgraph to the fpga and returns a ticket for the job
 struct fpga_vitis_op
 {
     fpga_vitis_op() = default;
@@ -56,18 +60,43 @@ struct fpga_vitis_op
     shape compute_shape(const std::vector<shape>& inputs) const
     {
         (void)inputs;
-        return xmodel.get_shape();
+        return shape{shape::uint64_type};
     }
 
-    argument
-    compute(const context& ctx, const shape& output_shape, std::vector<argument> args) const
+    argument compute(context& ctx, const shape& output_shape, std::vector<argument> args) const
     {
-        std::cout << "The context is " << ctx.id << std::endl;
-        return ::vitis_ai::execute(xmodel, output_shape, args);
+        auto ticket = ctx.queue->submit(xmodel, xmodel.get_shape(), std::move(args));
+        return literal{output_shape, std::vector<std::uint64_t>{ticket}}.get_argument();
     }
 };
 MIGRAPHX_REGISTER_OP(fpga_vitis_op)
 
+// Waits for the fpga job to finish and returns its output
+struct fpga_vitis_wait
+{
+    shape s;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.s, "shape"));
+    }
+
+    std::string name() const { return "fpga::vitis_ai_wait"; }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(1);
+        return s;
+    }
+
+    argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
+    {
+        return ctx.queue->wait(args.front().at<std::uint64_t>());
+    }
+};
+MIGRAPHX_REGISTER_OP(fpga_vitis_wait)
+
 void lowering::apply(module& m) const
 {
     auto* mod = &m;
@@ -75,14 +104,31 @@ void lowering::apply(module& m) const
     // test modifying the context from a pass
     ctx->id = 2;
 
+    std::vector<instruction_ref> placeholders;
     for(auto it : iterator_for(*mod))
     {
         if(it->name() == "fpga::vitis_placeholder")
-        {
-            assert(it->module_inputs().size() == 1);
-            auto xmodel = ::vitis_ai::create_xmodel(it->module_inputs()[0]);
-            mod->replace_instruction(it, fpga_vitis_op{xmodel}, it->inputs());
-        }
+            placeholders.push_back(it);
+    }
+
+    for(auto it : placeholders)
+    {
+        assert(it->module_inputs().size() == 1);
+        auto xmodel = ::vitis_ai::create_xmodel(it->module_inputs()[0]);
+        auto job    = mod->insert_instruction(it, fpga_vitis_op{xmodel}, it->inputs());
+        auto wait   = mod->replace_instruction(it, fpga_vitis_wait{xmodel.get_shape()}, job);
+        // Submit right after the inputs are ready and wait right before the first use, so the
+        // host ops in between overlap with the fpga
+        auto submit_pos = job;
+        while(submit_pos != mod->begin() and not contains(job->inputs(), std::prev(submit_pos)))
+            submit_pos--;
+        if(submit_pos != job)
+            mod->move_instruction(job, submit_pos);
+        auto wait_pos = std::next(wait);
+        while(wait_pos != mod->end() and not contains(wait->outputs(), wait_pos))
+            wait_pos++;
+        if(wait_pos != mod->end() and wait_pos != std::next(wait))
+            mod->move_instruction(wait, wait_pos);
     }
 }
 
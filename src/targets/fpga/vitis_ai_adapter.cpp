@@ -27,6 +27,10 @@
 #include "migraphx/module.hpp"
 
 #include "migraphx/stringutils.hpp"
+#include "migraphx/errors.hpp"
+
+#include <algorithm>
+#include <chrono>
 namespace vitis_ai {
 
 migraphx::shape x_model::get_shape() const { return shape; };
@@ -62,4 +66,65 @@ migraphx::argument execute(const x_model& xmodel,
     return result;
 }
 
+runner_queue::runner_queue(std::size_t n) : runners(std::max<std::size_t>(n, 1)) {}
+
+static bool is_ready(const std::shared_future<migraphx::argument>& job)
+{
+    return job.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::uint64_t runner_queue::submit(const x_model& xmodel,
+                                   const migraphx::shape& output_shape,
+                                   std::vector<migraphx::argument> args)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    // When all runners are busy wait for the oldest job that is still running
+    for(;;)
+    {
+        std::vector<std::uint64_t> running;
+        for(const auto& p : jobs)
+        {
+            if(not is_ready(p.second))
+                running.push_back(p.first);
+        }
+        if(running.size() < runners)
+            break;
+        auto job = jobs.at(*std::min_element(running.begin(), running.end()));
+        lock.unlock();
+        job.wait();
+        lock.lock();
+    }
+    auto ticket  = next_ticket++;
+    jobs[ticket] = std::async(std::launch::async, [=]() mutable {
+                       return execute(xmodel, output_shape, args);
+                   }).share();
+    return ticket;
+}
+
+migraphx::argument runner_queue::wait(std::uint64_t ticket)
+{
+    std::shared_future<migraphx::argument> job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = jobs.find(ticket);
+        if(it == jobs.end())
+            MIGRAPHX_THROW("Unknown fpga job: " + std::to_string(ticket));
+        job = it->second;
+        jobs.erase(it);
+    }
+    return job.get();
+}
+
+void runner_queue::finish()
+{
+    std::vector<std::shared_future<migraphx::argument>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const auto& p : jobs)
+            pending.push_back(p.second);
+    }
+    for(const auto& job : pending)
+        job.wait();
+}
+
 } // namespace vitis_ai
@@ -0,0 +1,197 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/code_object_cache.hpp>
+#include <migraphx/digest.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/msgpack.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/version.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <sstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_CODE_OBJECT_CACHE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_CODE_OBJECT_CACHE_SIZE)
+
+namespace {
+
+const std::string& entry_ext()
+{
+    static const std::string result = ".co";
+    return result;
+}
+
+std::string random_suffix()
+{
+    std::mt19937_64 rg{std::random_device{}()};
+    std::stringstream ss;
+    ss << std::hex << rg();
+    return ss.str();
+}
+
+} // namespace
+
+code_object_cache::code_object_cache(fs::path d, std::size_t msize)
+    : dir(std::move(d)), max_size(msize)
+{
+}
+
+optional<code_object_cache> code_object_cache::from_env()
+{
+    auto d = string_value_of(MIGRAPHX_GPU_CODE_OBJECT_CACHE{});
+    if(d.empty())
+        return nullopt;
+    // Size is given in megabytes
+    auto msize = value_of(MIGRAPHX_GPU_CODE_OBJECT_CACHE_SIZE{}, 2048);
+    return code_object_cache{d, msize * 1024 * 1024};
+}
+
+std::string code_object_cache::make_key(const std::vector<src_file>& srcs,
+                                        const std::vector<std::string>& params,
+                                        const std::string& arch)
+{
+    digest d;
+    d.update(std::to_string(MIGRAPHX_VERSION_MAJOR) + "." + std::to_string(MIGRAPHX_VERSION_MINOR) +
+             "." + std::to_string(MIGRAPHX_VERSION_PATCH) + "." MIGRAPHX_VERSION_TWEAK);
+    d.update(arch);
+    d.update(std::to_string(params.size()));
+    for(const auto& param : params)
+        d.update(param);
+    d.update(std::to_string(srcs.size()));
+    for(const auto& src : srcs)
+    {
+        d.update(src.path.string());
+        d.update(src.content);
+    }
+    return d.str();
+}
+
+optional<std::vector<std::vector<char>>> code_object_cache::load(const std::string& key) const
+{
+    auto p = dir / (key + entry_ext());
+    std::error_code ec;
+    if(not fs::exists(p, ec))
+        return nullopt;
+    try
+    {
+        auto v = from_msgpack(read_buffer(p));
+        std::vector<std::vector<char>> result;
+        std::transform(v.begin(), v.end(), std::back_inserter(result), [](const value& x) {
+            const auto& b = x.get_binary();
+            return std::vector<char>(b.begin(), b.end());
+        });
+        // Touch the entry so eviction is least recently used
+        fs::last_write_time(p, fs::file_time_type::clock::now(), ec);
+        return result;
+    }
+    catch(...)
+    {
+        // A truncated or corrupt entry is treated as a miss and overwritten
+        return nullopt;
+    }
+}
+
+void code_object_cache::store(const std::string& key,
+                              const std::vector<std::vector<char>>& cos) const
+{
+    value::array a;
+    std::transform(cos.begin(), cos.end(), std::back_inserter(a), [](const auto& co) {
+        return value::binary{co};
+    });
+    auto buffer = to_msgpack(value{a});
+    if(buffer.size() > max_size)
+        return;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if(ec)
+        return;
+    auto p = dir / (key + entry_ext());
+    // Write to a unique file first and rename it so that concurrent readers
+    // never see a partially written entry
+    auto tmp = dir / (key + ".tmp-" + random_suffix());
+    try
+    {
+        write_buffer(tmp, buffer);
+    }
+    catch(...)
+    {
+        fs::remove(tmp, ec);
+        return;
+    }
+    fs::rename(tmp, p, ec);
+    if(ec)
+    {
+        fs::remove(tmp, ec);
+        return;
+    }
+    this->evict();
+}
+
+void code_object_cache::evict() const
+{
+    struct entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        std::uintmax_t size;
+    };
+    std::vector<entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for(auto it = fs::directory_iterator(dir, ec); not ec and it != fs::directory_iterator();
+        it.increment(ec))
+    {
+        if(it->path().extension() != entry_ext())
+            continue;
+        std::error_code eec;
+        auto size = fs::file_size(it->path(), eec);
+        auto time = fs::last_write_time(it->path(), eec);
+        if(eec)
+            continue;
+        total += size;
+        entries.push_back({it->path(), time, size});
+    }
+    if(total <= max_size)
+        return;
+    std::sort(entries.begin(), entries.end(), [](const entry& x, const entry& y) {
+        return x.time < y.time;
+    });
+    for(const auto& e : entries)
+    {
+        if(total <= max_size)
+            break;
+        // Another process may have already removed it
+        fs::remove(e.path, ec);
+        total -= e.size;
+    }
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -24,13 +24,33 @@
 #include <migraphx/gpu/code_object_op.hpp>
 #include <migraphx/gpu/context.hpp>
 #include <migraphx/register_op.hpp>
+#include <migraphx/env.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PERF_COUNTERS)
+
 MIGRAPHX_REGISTER_OP(code_object_op);
 
+value code_object_op::attributes() const
+{
+    value result = {{"group", group()}};
+    if(not enabled(MIGRAPHX_PERF_COUNTERS{}) or k.empty())
+        return result;
+    auto resources = k.resources(local);
+    if(swap != nullptr)
+    {
+        if(auto tk = swap->get())
+            resources = tk->k.resources(tk->local);
+    }
+    result["counters"] = {{"registers", resources.registers},
+                          {"lds_bytes", resources.lds_bytes},
+                          {"occupancy", resources.occupancy}};
+    return result;
+}
+
 shape code_object_op::compute_shape(std::vector<shape> inputs) const
 {
     std::transform(inputs.begin(), inputs.end(), inputs.begin(), [](const shape& s) {
@@ -45,21 +65,42 @@ shape code_object_op::compute_shape(std::vector<shape> inputs) const
                        to_string_range(inputs) + "]");
     return output;
 }
+static void append_kernargs(std::vector<void*>& kernargs, const std::vector<argument>& args)
+{
+    for(const auto& arg : args)
+    {
+        if(arg.get_shape().type() == shape::tuple_type)
+            append_kernargs(kernargs, arg.get_sub_objects());
+        else
+            kernargs.push_back(arg.data());
+    }
+}
+
 argument
 code_object_op::compute(context& ctx, const shape&, const std::vector<argument>& args) const
 {
-    auto fargs = flatten(args);
-    std::vector<void*> kargs(fargs.size());
-    std::transform(
-        fargs.begin(), fargs.end(), kargs.begin(), [](const argument& a) { return a.data(); });
+    // The op can be computed from several threads at once, so the pointers are collected in a
+    // buffer owned by the thread, which keeps its capacity between launches
+    static thread_local std::vector<void*> kernargs; // NOLINT
+    kernargs.clear();
+    append_kernargs(kernargs, args);
     auto [start, stop] = ctx.get_perf_events();
-    k.launch(ctx.get_stream().get(), global, local, std::move(kargs), start, stop);
+    if(swap != nullptr)
+    {
+        if(auto tk = swap->get())
+        {
+            tk->k.launch(ctx.get_stream().get(), tk->global, tk->local, kernargs, start, stop);
+            return args[get_output_arg(args.size())];
+        }
+    }
+    k.launch(ctx.get_stream().get(), global, local, kernargs, start, stop);
     return args[get_output_arg(args.size())];
 }
-void code_object_op::finalize(context&, const shape&, const std::vector<shape>&)
+void code_object_op::finalize(context& ctx, const shape&, const std::vector<shape>&)
 {
     assert(not code_object.empty());
     k = kernel(code_object, symbol_name);
+    ctx.get_current_device().add_code_object(k.module(), code_object.size());
 }
 
 } // namespace gpu
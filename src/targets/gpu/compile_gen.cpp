@@ -40,6 +40,7 @@
 #include <migraphx/array.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/fp8_types.hpp>
+#include <sstream>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -127,6 +128,35 @@ vectorize vectorize::elements(std::size_t axis, const std::vector<shape>& inputs
     return elements(axis, inputs, vector_sizes(inputs));
 }
 
+vectorize vectorize::elements(context& ctx,
+                              std::size_t axis,
+                              const std::vector<shape>& inputs,
+                              const value& v)
+{
+    if(not v.contains("vector_size"))
+        return elements(ctx, axis, inputs);
+    auto n = v.at("vector_size").to<std::size_t>();
+    std::vector<std::size_t> sizes;
+    for(std::size_t size : {8, 4, 2})
+    {
+        if(size <= n)
+            sizes.push_back(size);
+    }
+    if(sizes.empty())
+        return {1, axis};
+    return elements(axis, inputs, sizes);
+}
+
+std::vector<std::size_t> vectorize::tunable_sizes(std::size_t axis,
+                                                  const std::vector<shape>& inputs)
+{
+    auto vec = elements(axis, inputs, {8, 4, 2});
+    std::vector<std::size_t> result;
+    for(std::size_t n = 1; n <= vec.size; n *= 2)
+        result.push_back(n);
+    return result;
+}
+
 std::string vectorize::str() const
 {
     return "vectorize<" + to_string(size) + ", " + to_string(axis) + ">()";
@@ -194,6 +224,20 @@ static std::size_t compute_tile_factor(std::size_t r, std::size_t max_size = 64)
     return n;
 }
 
+static std::size_t tile_bytes(const tile& t, const std::vector<shape>& inputs, std::size_t pad)
+{
+    auto rows = std::accumulate(
+        t.inner.begin(), t.inner.end() - 1, std::size_t{1}, std::multiplies<>{});
+    auto row_size      = t.inner.back() + pad;
+    std::size_t result = 0;
+    for(std::size_t i = 0; i < inputs.size(); i++)
+    {
+        if(t.args[i] != tile::none)
+            result += rows * row_size * inputs[i].type_size();
+    }
+    return result;
+}
+
 tile tile::elements(const std::vector<shape>& inputs, std::size_t noutputs)
 {
     tile result;
@@ -201,9 +245,6 @@ tile tile::elements(const std::vector<shape>& inputs, std::size_t noutputs)
     std::vector<std::size_t> faxes;
     std::transform(
         inputs.begin(), inputs.end(), std::back_inserter(faxes), MIGRAPHX_LIFT(find_fast_axis));
-    result.axis = std::accumulate(faxes.begin(), faxes.end(), ndim, MIGRAPHX_LIFT(std::min));
-    if(result.axis >= (ndim - 1))
-        return {};
     auto select = [&](auto m) {
         return [&, m](std::size_t faxis, shape input) {
             if(input.broadcasted())
@@ -224,11 +265,18 @@ tile tile::elements(const std::vector<shape>& inputs, std::size_t noutputs)
                    std::back_inserter(result.args),
                    select(store));
 
-    auto nargs = std::count_if(
-        result.args.begin(), result.args.end(), [](auto m) { return m != mode::none; });
-    // TODO: Handle tiling more than one arguments
-    if(nargs != 1)
+    // All the tiled arguments need to be transposed along the same axis
+    std::vector<std::size_t> taxes;
+    for(std::size_t i = 0; i < inputs.size(); i++)
+    {
+        if(result.args[i] != none)
+            taxes.push_back(faxes[i]);
+    }
+    if(taxes.empty())
         return {};
+    if(std::adjacent_find(taxes.begin(), taxes.end(), std::not_equal_to<>{}) != taxes.end())
+        return {};
+    result.axis = taxes.front();
 
     const auto& s = inputs.front();
     auto dim1     = compute_tile_factor(s.lens()[result.axis]);
@@ -247,15 +295,36 @@ tile tile::elements(const std::vector<shape>& inputs, std::size_t noutputs)
 
     auto tile_size = dim1 * dim2;
     result.ntiles  = s.elements() / tile_size;
-    // equivalent to dim1 * (dim2 + 1) to avoid bank conflicts
-    auto tile_bytes = (tile_size + dim1) * s.type_size();
-    if(tile_bytes > 65536)
+    if(tile_bytes(result, inputs, result.pad) > 65536)
         return {};
 
     result.block_size = std::min<std::size_t>(256, integer_divide_ceil(tile_size / 4, 64) * 64);
     return result;
 }
 
+vectorize tile::vectorize_elements(context& ctx, const std::vector<shape>& inputs, const value& v)
+{
+    auto axis = inputs.front().ndim() - 1;
+    if(ntiles == 0)
+        return {1, axis};
+    // The tiles are read from LDS, so only their inner lens need to be divisible
+    std::vector<shape> vinputs;
+    std::transform(inputs.begin(),
+                   inputs.end(),
+                   args.begin(),
+                   std::back_inserter(vinputs),
+                   [&](const shape& input, mode m) {
+                       if(m == none)
+                           return input;
+                       return shape{input.type(), inner};
+                   });
+    auto vec = vectorize::elements(ctx, axis, vinputs, v);
+    while(vec.size > 1 and tile_bytes(*this, inputs, vec.size) > 65536)
+        vec.size /= 2;
+    pad = vec.size;
+    return vec;
+}
+
 std::string tile::str() const
 {
     if(args.empty())
@@ -270,11 +339,12 @@ std::string tile::str() const
         }
         MIGRAPHX_THROW("Invalid mode");
     });
-    const std::string auto_tile = "auto_tile<${modes}>(${inner}, ${outer})";
+    const std::string auto_tile = "auto_tile<${modes}>(${inner}, ${outer}, _c<${pad}>)";
     return interpolate_string(auto_tile,
                               {{"modes", join_strings(strs, ", ")},
                                {"inner", generate_index_ints(inner)},
-                               {"outer", generate_index_ints(outer)}});
+                               {"outer", generate_index_ints(outer)},
+                               {"pad", std::to_string(pad)}});
 }
 
 std::size_t find_fast_axis(const shape& input)
@@ -308,6 +378,15 @@ std::string make_transformer_args(std::vector<std::string> transformers)
     return join_strings(std::move(transformers), ", ");
 }
 
+std::string generate_float_list(const std::vector<float>& v)
+{
+    std::stringstream ss;
+    ss << std::hexfloat;
+    for(auto x : v)
+        ss << x << "f, ";
+    return ss.str();
+}
+
 static void generate_pointwise(cpp_generator& gg,
                                const module& pm,
                                const std::string& name,
@@ -343,7 +422,7 @@ std::string generate_pointwise(const module& pm, const std::string& name, bool a
 
 std::string reduce_op::str() const
 {
-    return write + "(r.reduce(" + reduction + ", " + init + ", " + read + ")(" +
+    return write + "(r." + method + "(" + reduction + ", " + init + ", " + read + ")(" +
            join_strings(inputs, ", ") + "))";
 }
 void reduce_op::set(const std::string& name, const shape& input, const shape& output)
@@ -353,6 +432,9 @@ void reduce_op::set(const std::string& name, const shape& input, const shape& ou
     if(name == "reduce_sum")
     {
         reduction = "op::sum{}";
+        // bf16 only has 8 bits of precision so always accumulate in float
+        if(input.type() == shape::bf16_type)
+            read = "op::convert_to<float>{}";
     }
     else if(name == "reduce_mean")
     {
@@ -361,7 +443,8 @@ void reduce_op::set(const std::string& name, const shape& input, const shape& ou
         reduction            = "op::sum{}";
         std::string mean     = "op::mean<" + std::to_string(reduce_elements) + ">{}";
         // Use float accumulator when reduction size is too large for half
-        if(reduce_type == shape::half_type and reduce_elements > 16384)
+        if((reduce_type == shape::half_type and reduce_elements > 16384) or
+           reduce_type == shape::bf16_type)
             read = "compose(" + mean + ", op::convert_to<float>{})";
         else if(contains({shape::float_type, shape::half_type, shape::double_type}, reduce_type))
             read = mean;
@@ -409,11 +492,23 @@ void reduce_op::set(instruction_ref ins, const operation& op)
         set(rop.name(), input, output);
         read = "compose(array_apply(" + read + "), MIGRAPHX_LIFT(make_array))";
     }
+    else if(is_arg_reduce(op.name()))
+    {
+        auto select_last = op.to_value().at("select_last_index").to<bool>();
+        method           = "reduce_with_index";
+        reduction        = "op::" + op.name() + "<" + (select_last ? "true" : "false") + ">{}";
+        init             = op.name() == "argmax" ? "lowest{}" : "highest{}";
+        read             = "op::make_arg_value{}";
+        write            = "op::get_arg_index{}";
+    }
     else
     {
         set(op.name(), ins->inputs().front()->get_shape(), ins->get_shape());
     }
 }
+
+bool is_arg_reduce(const std::string& name) { return contains({"argmax", "argmin"}, name); }
+
 std::string reduce_op::generate(instruction_ref ins, const std::vector<std::string>& x)
 {
     reduce_op r{x};
@@ -435,7 +530,8 @@ static bool use_lazy_inner(instruction_ref ins)
        }))
         return false;
     auto output = ins->outputs().front();
-    return contains(output->name(), "reduce") or output->name() == "@return";
+    return contains(output->name(), "reduce") or is_arg_reduce(output->name()) or
+           output->name() == "@return";
 }
 
 void preload_params(module& m)
@@ -466,7 +562,7 @@ std::string generate_reduce(module m, const std::string& name)
     auto ilens    = max_shape->second.lens();
     std::size_t i = 0;
     auto f        = g.generate_module(m, [&](instruction_ref ins, const auto& names) {
-        if(contains(ins->name(), "reduce"))
+        if(contains(ins->name(), "reduce") or is_arg_reduce(ins->name()))
         {
             return reduce_op::generate(ins, cpp_generator::to_args(ins->inputs(), names));
         }
@@ -22,17 +22,30 @@
  * THE SOFTWARE.
  */
 #include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/code_object_cache.hpp>
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/errors.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/env.hpp>
 #include <migraphx/fileutils.hpp>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef MIGRAPHX_USE_HIPRTC
 #include <hip/hiprtc.h>
+#include <hip/hip_runtime_api.h>
 #include <migraphx/manage_ptr.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/tmp_dir.hpp>
@@ -55,6 +68,8 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_DEBUG_SYM);
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_OPTIMIZE);
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_DUMP_ASM);
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_DUMP_SRC);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_COMPILE_BATCH);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_OFFLOAD_ARCHS);
 
 #ifdef MIGRAPHX_USE_HIPRTC
 
@@ -79,6 +94,24 @@ void hiprtc_check_error(hiprtcResult err, const std::string& msg, const std::str
 void hiprtc_program_destroy(hiprtcProgram prog) { hiprtcDestroyProgram(&prog); }
 using hiprtc_program_ptr = MIGRAPHX_MANAGE_PTR(hiprtcProgram, hiprtc_program_destroy);
 
+// The hiprtc version and the version of the HIP runtime it is released with, which also fixes the
+// comgr it compiles with, so code objects are not reused by another build of the compiler
+static const std::string& hip_compiler_version()
+{
+    static const std::string result = [] {
+        std::string out = "hiprtc";
+        int major       = 0;
+        int minor       = 0;
+        if(hiprtcVersion(&major, &minor) == HIPRTC_SUCCESS)
+            out += " " + std::to_string(major) + "." + std::to_string(minor);
+        int hip_version = 0;
+        if(hipRuntimeGetVersion(&hip_version) == hipSuccess)
+            out += " hip " + std::to_string(hip_version);
+        return out;
+    }();
+    return result;
+}
+
 template <class... Ts>
 hiprtc_program_ptr hiprtc_program_create(Ts... xs)
 {
@@ -239,48 +272,273 @@ bool hip_has_flags(const std::vector<std::string>& flags)
     }
 }
 
-std::vector<std::vector<char>> compile_hip_src(const std::vector<src_file>& srcs,
-                                               const std::vector<std::string>& params,
-                                               const std::string& arch)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_HIPRTC_DRIVER);
+
+static fs::path find_hiprtc_driver()
 {
-    std::vector<hiprtc_src_file> hsrcs{srcs.begin(), srcs.end()};
-    if(enabled(MIGRAPHX_GPU_DUMP_SRC{}))
+    auto custom = string_value_of(MIGRAPHX_GPU_HIPRTC_DRIVER{});
+    if(not custom.empty())
+        return custom;
+    auto fname  = make_executable_filename("migraphx-hiprtc-driver");
+    auto p      = dynamic_loader::path(&compile_hip_src_with_hiprtc);
+    auto driver = p.parent_path() / fname;
+    if(fs::exists(driver))
+        return driver;
+    driver = p.parent_path().parent_path() / "bin" / fname;
+    if(fs::exists(driver))
+        return driver;
+    return {};
+}
+
+static std::size_t compile_batch_size()
+{
+    return value_of(MIGRAPHX_GPU_COMPILE_BATCH{}, 8);
+}
+
+struct hiprtc_job
+{
+    std::vector<hiprtc_src_file> srcs;
+    std::vector<std::string> params;
+    std::string arch;
+    std::promise<std::vector<std::vector<char>>> result = {};
+
+    value to_value() const
     {
-        for(const auto& src : srcs)
+        value v;
+        v["srcs"]   = migraphx::to_value(srcs);
+        v["params"] = migraphx::to_value(params);
+        v["arch"]   = migraphx::to_value(arch);
+        return v;
+    }
+};
+
+// A driver process kept running in server mode and reused for many batches
+struct hiprtc_server
+{
+    process p;
+
+    explicit hiprtc_server(const fs::path& driver) : p(driver, {"--server"}) { p.start(); }
+
+    value compile(const value& v)
+    {
+        auto request    = to_msgpack(v);
+        std::uint64_t n = request.size();
+        p.send(reinterpret_cast<const char*>(&n), sizeof(n));
+        p.send(request.data(), request.size());
+        p.receive(reinterpret_cast<char*>(&n), sizeof(n));
+        std::vector<char> response(n);
+        p.receive(response.data(), response.size());
+        return from_msgpack(response);
+    }
+};
+
+// Compiles the jobs with a driver process that exits after the batch
+static value run_hiprtc_driver(const fs::path& driver, const value& v)
+{
+    tmp_dir td{};
+    auto out = td.path / "output";
+    process(driver, {quote_string(out.string())}).write([&](auto writer) {
+        to_msgpack(v, writer);
+    });
+    if(fs::exists(out))
+        return from_msgpack(read_buffer(out));
+    return value::array{};
+}
+
+// Any job the driver could not compile is compiled again in-process so the error is reported to
+// the caller that submitted it
+static void set_hiprtc_results(const std::vector<hiprtc_job*>& jobs, const value& results)
+{
+    for(std::size_t i = 0; i < jobs.size(); i++)
+    {
+        auto* job = jobs[i];
+        try
         {
-            if(src.path.extension() != ".cpp")
-                continue;
-            std::cout << std::string(src.content) << std::endl;
+            if(i < results.size() and results[i].contains("code_object"))
+            {
+                auto co = results[i].at("code_object").get_binary();
+                job->result.set_value({std::vector<char>(co.begin(), co.end())});
+            }
+            else
+            {
+                job->result.set_value(
+                    compile_hip_src_with_hiprtc(std::move(job->srcs), job->params, job->arch));
+            }
+        }
+        catch(...)
+        {
+            job->result.set_exception(std::current_exception());
         }
     }
+}
 
-    auto fname  = make_executable_filename("migraphx-hiprtc-driver");
-    auto p      = dynamic_loader::path(&compile_hip_src_with_hiprtc);
-    auto driver = p.parent_path() / fname;
+// Gathers the compiles submitted concurrently from the compile threads so that many small
+// kernels share one driver process, which amortizes the process and compiler startup. The
+// first threads to submit become runners and drain the queue in batches while the other
+// threads wait for their results. Fewer runners than compile threads are allowed so batches
+// can fill up; the driver compiles the jobs of a batch in parallel.
+//
+// The drivers run as servers that stay alive for the rest of the process, with the sources
+// and code objects sent over a pipe, so later batches and later programs don't start a new
+// process. Each runner takes an idle server or starts one. When a server can't be started
+// or dies the driver is started for each batch instead.
+struct hiprtc_batcher
+{
+    std::mutex m;
+    std::deque<hiprtc_job*> queue;
+    std::size_t active = 0;
+    std::vector<std::unique_ptr<hiprtc_server>> servers;
+    bool use_servers = true;
 
-    bool found = fs::exists(driver);
-    if(not found)
+    static std::size_t max_active()
     {
-        driver = p.parent_path().parent_path() / "bin" / fname;
-        found  = fs::exists(driver);
+        std::size_t n = std::thread::hardware_concurrency();
+        return std::max<std::size_t>(1, n / compile_batch_size());
     }
 
-    if(found)
+    // Called with the lock held
+    std::unique_ptr<hiprtc_server> get_server(const fs::path& driver)
     {
+        if(not use_servers)
+            return nullptr;
+        if(not servers.empty())
+        {
+            auto server = std::move(servers.back());
+            servers.pop_back();
+            return server;
+        }
+        try
+        {
+            return std::make_unique<hiprtc_server>(driver);
+        }
+        catch(...)
+        {
+            use_servers = false;
+            return nullptr;
+        }
+    }
+
+    value compile_batch(const fs::path& driver,
+                        const std::vector<hiprtc_job*>& batch,
+                        std::unique_ptr<hiprtc_server>& server)
+    {
+        value::array a;
+        std::transform(batch.begin(), batch.end(), std::back_inserter(a), [](const auto* job) {
+            return job->to_value();
+        });
         value v;
-        v["srcs"]   = to_value(hsrcs);
-        v["params"] = to_value(params);
-        v["arch"]   = to_value(arch);
+        v["jobs"] = a;
 
-        tmp_dir td{};
-        auto out = td.path / "output";
+        value results = value::array{};
+        bool done     = false;
+        if(server != nullptr)
+        {
+            try
+            {
+                results = server->compile(v);
+                done    = true;
+            }
+            catch(...)
+            {
+                server = nullptr;
+                std::lock_guard<std::mutex> lock(m);
+                use_servers = false;
+            }
+        }
+        if(not done)
+            results = run_hiprtc_driver(driver, v);
+        return results;
+    }
 
-        process(driver, {quote_string(out.string())}).write([&](auto writer) {
-            to_msgpack(v, writer);
-        });
-        if(fs::exists(out))
-            return {read_buffer(out)};
+    // Every job of the batch gets a result, since the threads that submitted them are waiting
+    // on it. When the driver fails, such as when it crashes, the jobs are compiled in-process.
+    void run_batch(const fs::path& driver,
+                   const std::vector<hiprtc_job*>& batch,
+                   std::unique_ptr<hiprtc_server>& server)
+    {
+        value results = value::array{};
+        try
+        {
+            results = compile_batch(driver, batch, server);
+        }
+        catch(...)
+        {
+            results = value::array{};
+        }
+        set_hiprtc_results(batch, results);
     }
+
+    // Gives back the runner slot and its server when the runner stops, even when a batch throws
+    struct runner_guard
+    {
+        hiprtc_batcher* b;
+        std::unique_lock<std::mutex>* lock;
+        std::unique_ptr<hiprtc_server> server = nullptr;
+
+        runner_guard(hiprtc_batcher* pb, std::unique_lock<std::mutex>* plock) : b(pb), lock(plock)
+        {
+            b->active++;
+        }
+        runner_guard(const runner_guard&)            = delete;
+        runner_guard& operator=(const runner_guard&) = delete;
+        ~runner_guard()
+        {
+            if(not lock->owns_lock())
+                lock->lock();
+            if(server != nullptr)
+                b->servers.push_back(std::move(server));
+            b->active--;
+        }
+    };
+
+    std::vector<std::vector<char>> compile(const fs::path& driver, hiprtc_job job)
+    {
+        auto f = job.result.get_future();
+        std::unique_lock<std::mutex> lock(m);
+        queue.push_back(&job);
+        if(active < max_active())
+        {
+            runner_guard runner{this, &lock};
+            runner.server = get_server(driver);
+            while(not queue.empty())
+            {
+                auto n = std::min(queue.size(), compile_batch_size());
+                std::vector<hiprtc_job*> batch(queue.begin(), queue.begin() + n);
+                queue.erase(queue.begin(), queue.begin() + n);
+                lock.unlock();
+                run_batch(driver, batch, runner.server);
+                lock.lock();
+            }
+        }
+        lock.unlock();
+        return f.get();
+    }
+};
+
+static hiprtc_batcher& get_hiprtc_batcher()
+{
+    static hiprtc_batcher b;
+    return b;
+}
+
+static std::vector<std::vector<char>> compile_hip_src_impl(const std::vector<src_file>& srcs,
+                                                           const std::vector<std::string>& params,
+                                                           const std::string& arch)
+{
+    std::vector<hiprtc_src_file> hsrcs{srcs.begin(), srcs.end()};
+    if(enabled(MIGRAPHX_GPU_DUMP_SRC{}))
+    {
+        for(const auto& src : srcs)
+        {
+            if(src.path.extension() != ".cpp")
+                continue;
+            std::cout << std::string(src.content) << std::endl;
+        }
+    }
+
+    auto driver = find_hiprtc_driver();
+    if(not driver.empty())
+        return get_hiprtc_batcher().compile(driver, {std::move(hsrcs), params, arch});
     return compile_hip_src_with_hiprtc(std::move(hsrcs), params, arch);
 }
 
@@ -300,6 +558,25 @@ bool is_hip_clang_compiler()
     return result;
 }
 
+// What the compiler prints for --version, so files it builds are not reused by another build of
+// the compiler
+static const std::string& hip_compiler_version()
+{
+    static const std::string result = [] {
+        std::string out;
+        try
+        {
+            process{MIGRAPHX_HIP_COMPILER, {"--version"}}.read(
+                [&](const char* buffer, std::size_t n) { out.append(buffer, n); });
+        }
+        catch(const std::exception&)
+        {
+        }
+        return out;
+    }();
+    return result;
+}
+
 #ifdef MIGRAPHX_HIP_COMPILER_LAUNCHER
 
 bool has_compiler_launcher()
@@ -317,9 +594,171 @@ src_compiler assemble(src_compiler compiler)
     return compiler;
 }
 
-std::vector<std::vector<char>> compile_hip_src(const std::vector<src_file>& srcs,
-                                               const std::vector<std::string>& params,
-                                               const std::string& arch)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_GPU_PCH);
+
+static bool is_kernel_header(const src_file& src)
+{
+    return starts_with(src.path.string(), "migraphx/kernels/");
+}
+
+// The kernel library headers included at the top of main.cpp. Kernels of the same kind include
+// the same headers, so they are parsed once into a precompiled header.
+static std::vector<std::string> get_preamble_includes(const std::vector<src_file>& srcs)
+{
+    auto main_src = std::find_if(srcs.begin(), srcs.end(), [](const src_file& src) {
+        return src.path.extension() == ".cpp";
+    });
+    if(main_src == srcs.end())
+        return {};
+    std::unordered_set<std::string> headers;
+    for(const auto& src : srcs)
+    {
+        if(is_kernel_header(src))
+            headers.insert(src.path.string());
+    }
+    std::vector<std::string> result;
+    std::istringstream is{std::string{main_src->content}};
+    for(std::string line; std::getline(is, line);)
+    {
+        line = trim(line);
+        if(line.empty())
+            continue;
+        if(not starts_with(line, "#include <") or not ends_with(line, ">"))
+            break;
+        auto header = line.substr(10, line.size() - 11);
+        if(not contains(headers, header))
+            break;
+        result.push_back(header);
+    }
+    return result;
+}
+
+// Macros defined on the command line that the kernel library doesn't use, such as the parameters
+// of a single kernel, can differ between the precompiled header and the kernel
+static bool is_header_param(const std::string& param, const std::vector<src_file>& srcs)
+{
+    if(not starts_with(param, "-D"))
+        return true;
+    auto name = param.substr(2, param.find('=') - 2);
+    return std::any_of(srcs.begin(), srcs.end(), [&](const src_file& src) {
+        return is_kernel_header(src) and src.content.find(name) != std::string_view::npos;
+    });
+}
+
+static std::vector<char> build_pch(src_compiler compiler,
+                                   std::vector<src_file> srcs,
+                                   const std::vector<std::string>& includes)
+{
+    std::string preamble;
+    for(const auto& header : includes)
+        preamble += "#include <" + header + ">\n";
+    srcs.emplace_back("preamble.cpp", preamble);
+    const std::string syntax_only = "-fsyntax-only";
+    std::replace(compiler.flags.begin(), compiler.flags.end(), std::string{"-c"}, syntax_only);
+    compiler.flags.emplace_back("-Xclang -emit-pch -Xclang -fno-pch-timestamp");
+    // The kernels are compiled in a different directory than the one the header is built in, so
+    // the headers are embedded for the compiler to validate against
+    compiler.flags.emplace_back("-Xclang -fmodules-embed-all-files");
+    compiler.flags.emplace_back("-Xclang -o -Xclang preamble.pch");
+    compiler.output = "preamble.pch";
+    return compiler.compile(srcs);
+}
+
+using pch_entry = std::shared_future<std::shared_ptr<const std::vector<char>>>;
+
+static std::mutex& pch_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+static std::unordered_map<std::string, pch_entry>& pch_entries()
+{
+    static std::unordered_map<std::string, pch_entry> pchs;
+    return pchs;
+}
+
+struct precompiled_header
+{
+    std::string key;
+    std::shared_ptr<const std::vector<char>> data = nullptr;
+};
+
+// Precompiled headers are built once for each compiler, arch, set of flags and preamble, and kept
+// for the rest of the process and in the code object cache when there is one. The data is null
+// when the kernel can't use one.
+static precompiled_header
+get_pch(const src_compiler& compiler, const std::vector<src_file>& srcs, const std::string& arch)
+{
+    static const auto cache = code_object_cache::from_env();
+
+    auto includes = get_preamble_includes(srcs);
+    if(includes.empty())
+        return {};
+    src_compiler pch_compiler = compiler;
+    pch_compiler.flags.clear();
+    std::copy_if(compiler.flags.begin(),
+                 compiler.flags.end(),
+                 std::back_inserter(pch_compiler.flags),
+                 [&](const std::string& param) { return is_header_param(param, srcs); });
+    std::vector<src_file> headers;
+    std::copy_if(srcs.begin(), srcs.end(), std::back_inserter(headers), &is_kernel_header);
+    std::vector<std::string> key_params = {
+        "pch", compiler.compiler.string(), hip_compiler_version()};
+    key_params.insert(key_params.end(), pch_compiler.flags.begin(), pch_compiler.flags.end());
+    key_params.insert(key_params.end(), includes.begin(), includes.end());
+    auto key = code_object_cache::make_key(headers, key_params, arch);
+
+    std::promise<std::shared_ptr<const std::vector<char>>> p;
+    pch_entry e;
+    {
+        std::lock_guard<std::mutex> lock(pch_mutex());
+        auto it = pch_entries().find(key);
+        if(it != pch_entries().end())
+            e = it->second;
+        else
+            pch_entries().emplace(key, p.get_future().share());
+    }
+    if(e.valid())
+        return {key, e.get()};
+
+    std::shared_ptr<const std::vector<char>> result = nullptr;
+    if(auto cached = cache.has_value() ? cache->load(key) : nullopt; cached and cached->size() == 1)
+    {
+        result = std::make_shared<const std::vector<char>>(std::move(cached->front()));
+    }
+    else
+    {
+        try
+        {
+            result = std::make_shared<const std::vector<char>>(
+                build_pch(pch_compiler, headers, includes));
+            if(cache.has_value())
+                cache->store(key, {*result});
+        }
+        catch(const std::exception& ex)
+        {
+            // Compile without a precompiled header when the compiler can't build one
+            if(enabled(MIGRAPHX_TRACE_HIPRTC{}))
+                std::cerr << "Failed to build precompiled header: " << ex.what() << std::endl;
+        }
+    }
+    p.set_value(result);
+    return {key, result};
+}
+
+// Later kernels compile without the precompiled header once the compiler rejects it
+static void reject_pch(const std::string& key)
+{
+    std::promise<std::shared_ptr<const std::vector<char>>> p;
+    p.set_value(nullptr);
+    std::lock_guard<std::mutex> lock(pch_mutex());
+    pch_entries()[key] = p.get_future().share();
+}
+
+static std::vector<std::vector<char>> compile_hip_src_impl(const std::vector<src_file>& srcs,
+                                                           const std::vector<std::string>& params,
+                                                           const std::string& arch)
 {
     assert(not srcs.empty());
 
@@ -369,6 +808,34 @@ std::vector<std::vector<char>> compile_hip_src(const std::vector<src_file>& srcs
         std::cout << assemble(compiler).compile(srcs).data() << std::endl;
     }
 
+    if(enabled(MIGRAPHX_ENABLE_GPU_PCH{}))
+    {
+        auto pch = get_pch(compiler, srcs, arch);
+        if(pch.data != nullptr)
+        {
+            auto pch_srcs = srcs;
+            pch_srcs.emplace_back("preamble.pch",
+                                  std::string_view{pch.data->data(), pch.data->size()});
+            auto pch_compiler = compiler;
+            pch_compiler.flags.emplace_back("-include-pch preamble.pch");
+            try
+            {
+                return {pch_compiler.compile(pch_srcs)};
+            }
+            catch(const std::exception& ex)
+            {
+                // The compiler validates the precompiled header against the flags and headers
+                // of the kernel, so compile without it when it doesn't match. Errors in the
+                // kernel itself are reported by the compile without it.
+                auto result = compiler.compile(srcs);
+                reject_pch(pch.key);
+                if(enabled(MIGRAPHX_TRACE_HIPRTC{}))
+                    std::cerr << "Precompiled header rejected: " << ex.what() << std::endl;
+                return {result};
+            }
+        }
+    }
+
     return {compiler.compile(srcs)};
 }
 
@@ -398,6 +865,147 @@ bool hip_has_flags(const std::vector<std::string>& flags)
 
 #endif // MIGRAPHX_USE_HIPRTC
 
+static std::string gfx_name(const std::string& arch)
+{
+    return trim(split_string(arch, ':').front());
+}
+
+// Kernels are compiled for 32 lanes on gfx10 and later, and for 64 lanes before that
+static std::size_t wavefront_size(const std::string& arch)
+{
+    return starts_with(gfx_name(arch), "gfx1") ? 32 : 64;
+}
+
+std::vector<std::string> get_offload_archs(const std::string& arch)
+{
+    std::vector<std::string> result = {arch};
+    for(const auto& s : split_string(string_value_of(MIGRAPHX_GPU_OFFLOAD_ARCHS{}), ','))
+    {
+        auto extra = trim(s);
+        if(extra.empty())
+            continue;
+        // The launch parameters and tile sizes are chosen for the wavefront size of the device
+        // compiled on, so a kernel can't be shared with archs that have another one
+        if(wavefront_size(extra) != wavefront_size(arch))
+            continue;
+        if(std::any_of(result.begin(), result.end(), [&](const std::string& a) {
+               return gfx_name(a) == gfx_name(extra);
+           }))
+            continue;
+        result.push_back(extra);
+    }
+    return result;
+}
+
+static void write_u64(std::vector<char>& buffer, std::size_t pos, std::uint64_t x)
+{
+    std::memcpy(buffer.data() + pos, &x, sizeof(x));
+}
+
+std::vector<char> make_offload_bundle(const std::vector<std::string>& archs,
+                                      const std::vector<std::vector<char>>& cos)
+{
+    assert(archs.size() == cos.size());
+    const std::string magic     = "__CLANG_OFFLOAD_BUNDLE__";
+    const std::size_t alignment = 4096;
+    // The bundle always starts with an empty host entry, just like the ones clang creates
+    std::vector<std::string> triples = {"host-x86_64-unknown-linux-gnu"};
+    std::transform(archs.begin(), archs.end(), std::back_inserter(triples), [](const auto& arch) {
+        return "hipv4-amdgcn-amd-amdhsa--" + arch;
+    });
+    std::vector<const std::vector<char>*> entries = {nullptr};
+    std::transform(cos.begin(), cos.end(), std::back_inserter(entries), [](const auto& co) {
+        return &co;
+    });
+
+    std::size_t header = magic.size() + sizeof(std::uint64_t);
+    for(const auto& triple : triples)
+        header += 3 * sizeof(std::uint64_t) + triple.size();
+
+    std::vector<std::size_t> offsets;
+    std::size_t size = header;
+    for(const auto* entry : entries)
+    {
+        if(entry == nullptr)
+        {
+            offsets.push_back(header);
+            continue;
+        }
+        size = (size + alignment - 1) / alignment * alignment;
+        offsets.push_back(size);
+        size += entry->size();
+    }
+
+    std::vector<char> result(size);
+    std::copy(magic.begin(), magic.end(), result.begin());
+    std::size_t pos = magic.size();
+    write_u64(result, pos, triples.size());
+    pos += sizeof(std::uint64_t);
+    for(std::size_t i = 0; i < triples.size(); i++)
+    {
+        write_u64(result, pos, offsets[i]);
+        write_u64(result, pos + 8, entries[i] == nullptr ? 0 : entries[i]->size());
+        write_u64(result, pos + 16, triples[i].size());
+        pos += 3 * sizeof(std::uint64_t);
+        std::copy(triples[i].begin(), triples[i].end(), result.begin() + pos);
+        pos += triples[i].size();
+        if(entries[i] != nullptr)
+            std::copy(entries[i]->begin(), entries[i]->end(), result.begin() + offsets[i]);
+    }
+    return result;
+}
+
+// The compiler version and the environment variables that change the
+// generated code object must be part of the cache key as well
+static std::vector<std::string> cache_params(std::vector<std::string> params)
+{
+#ifdef MIGRAPHX_USE_HIPRTC
+    if(enabled(MIGRAPHX_ENABLE_HIPRTC_WORKAROUNDS{}))
+        params.push_back("hiprtc_workarounds");
+#else
+    params.push_back(MIGRAPHX_HIP_COMPILER);
+#endif
+    params.push_back(hip_compiler_version());
+    if(enabled(MIGRAPHX_GPU_DEBUG{}))
+        params.push_back("debug");
+    if(enabled(MIGRAPHX_GPU_DEBUG_SYM{}))
+        params.push_back("debug_sym");
+    params.push_back("-O" + string_value_of(MIGRAPHX_GPU_OPTIMIZE{}, "3"));
+    return params;
+}
+
+std::vector<std::vector<char>> compile_hip_src(const std::vector<src_file>& srcs,
+                                               const std::vector<std::string>& params,
+                                               const std::string& arch)
+{
+    static const auto cache = code_object_cache::from_env();
+    static auto& compiles   = get_metric_counter("jit_compile");
+    static auto& hits       = get_metric_counter("code_object_cache_hit");
+    static auto& misses     = get_metric_counter("code_object_cache_miss");
+    compile_profile_scope profile{"compile_hip_src", arch};
+    // Always compile when dumping so the source or assembly is printed
+    if(not cache.has_value() or enabled(MIGRAPHX_GPU_DUMP_SRC{}) or
+       enabled(MIGRAPHX_GPU_DUMP_ASM{}))
+    {
+        compiles.add();
+        return compile_hip_src_impl(srcs, params, arch);
+    }
+    auto key = code_object_cache::make_key(srcs, cache_params(params), arch);
+    profile.add("cache_key", key);
+    if(auto cos = cache->load(key))
+    {
+        hits.add();
+        profile.add("cache", "hit");
+        return *cos;
+    }
+    misses.add();
+    profile.add("cache", "miss");
+    compiles.add();
+    auto cos = compile_hip_src_impl(srcs, params, arch);
+    cache->store(key, cos);
+    return cos;
+}
+
 std::string enum_params(std::size_t count, std::string param)
 {
     std::vector<std::string> items(count);
@@ -26,6 +26,8 @@
 #include <migraphx/gpu/code_object_op.hpp>
 #include <migraphx/gpu/context.hpp>
 #include <migraphx/gpu/device_name.hpp>
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/content_hash.hpp>
 #include <migraphx/context.hpp>
 #include <migraphx_kernels.hpp>
 #include <migraphx/stringutils.hpp>
@@ -172,6 +174,13 @@ operation compile_hip_code_object(const std::string& content, hip_compile_option
     assert(not options.inputs.empty());
     assert(options.inputs.size() == options.virtual_inputs.size() or
            options.virtual_inputs.empty());
+    compile_profile_scope profile{"compile_hip", options.kernel_name};
+    if(profile.enabled())
+    {
+        profile.add("source_hash", content_hash(content.data(), content.size()));
+        profile.add("global", options.global);
+        profile.add("local", options.local);
+    }
     std::vector<src_file> srcs = options.additional_src_files;
     static auto kernels{::migraphx_kernels()};
     std::transform(
@@ -195,10 +204,17 @@ operation compile_hip_code_object(const std::string& content, hip_compile_option
     options.params.insert(options.params.end(), warnings.begin(), warnings.end());
     options.emplace_param("-ftemplate-backtrace-limit=0");
     options.emplace_param("-Werror");
-    auto cos = compile_hip_src(srcs, options.params, get_device_name());
-    if(cos.size() != 1)
-        MIGRAPHX_THROW("No code object");
-    return code_object_op{value::binary{cos.front()},
+    auto archs = get_offload_archs(get_device_name());
+    std::vector<std::vector<char>> cos;
+    for(const auto& arch : archs)
+    {
+        auto arch_cos = compile_hip_src(srcs, options.params, arch);
+        if(arch_cos.size() != 1)
+            MIGRAPHX_THROW("No code object");
+        cos.push_back(std::move(arch_cos.front()));
+    }
+    auto co = archs.size() == 1 ? cos.front() : make_offload_bundle(archs, cos);
+    return code_object_op{value::binary{co},
                           options.kernel_name,
                           options.global,
                           options.local,
@@ -68,15 +68,17 @@ std::size_t compile_miopen::compile(operation& op, instruction_ref ins) const
 void compile_miopen::apply(module& m) const
 {
     assert(ctx);
+    // The finds benchmark the solutions on the device, so they run one at a time on the
+    // context's stream to not time each other. Convolutions with the same problem as an earlier
+    // one take its solution from the problem cache instead of running the find again.
     for(auto ins : iterator_for(m))
     {
         if(ins->name() != "gpu::miopen_op")
             continue;
-        auto op        = any_cast<miopen_op>(ins->get_operator()).op;
-        std::size_t ws = 0;
-        ws             = compile(op, ins);
-        auto inputs    = ins->inputs();
-        auto alloc     = m.insert_instruction(
+        auto op     = any_cast<miopen_op>(ins->get_operator()).op;
+        auto ws     = compile(op, ins);
+        auto inputs = ins->inputs();
+        auto alloc  = m.insert_instruction(
             ins, make_op("allocate", {{"shape", to_value(shape{shape::int8_type, {ws}})}}));
         inputs.insert(std::prev(inputs.end()), alloc);
 
@@ -24,15 +24,32 @@
 #include <migraphx/program.hpp>
 #include <migraphx/module.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/algorithm.hpp>
+#include <migraphx/compile_profile.hpp>
+#include <migraphx/functional.hpp>
 #include <migraphx/op/identity.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/gpu/code_object_op.hpp>
 #include <migraphx/gpu/compiler.hpp>
 #include <migraphx/gpu/compile_ops.hpp>
 #include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/hip.hpp>
 #include <migraphx/gpu/time_op.hpp>
+#include <migraphx/param_utils.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -40,6 +57,15 @@ namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_COMPILE_PARALLEL);
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_BENCHMARKING);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_GPU_DYNAMIC_CACHE_SIZE);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_LIMIT);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_PATIENCE);
+
+// Benchmarked solutions within this fraction of the fastest one are timed again interleaved
+constexpr double contender_margin    = 0.05;
+constexpr std::size_t max_contenders = 4;
+
+struct background_task;
 
 struct precompile_op
 {
@@ -78,10 +104,223 @@ struct precompile_op
 
 MIGRAPHX_REGISTER_OP(precompile_op);
 
+// Compiles pre for the concrete input shapes into a module with the compiled kernels
+static std::shared_ptr<module> compile_module(context& ctx,
+                                              const precompile_op& pre,
+                                              const std::vector<shape>& inputs,
+                                              const std::vector<module_ref>& mods)
+{
+    auto m = std::make_shared<module>();
+    std::vector<instruction_ref> params;
+    for(auto i : range(inputs.size()))
+        params.push_back(m->add_parameter("x" + std::to_string(i), inputs[i]));
+    auto static_pre         = pre;
+    static_pre.output_shape = inputs.back();
+    auto ins                = m->add_instruction(static_pre, params, mods);
+    m->add_return({ins});
+
+    // Use the tuned solution when there is one
+    value solution{};
+    if(auto config = get_tuning_config(ctx, ins, pre.op, false))
+    {
+        if(auto sol = ctx.get_problem_cache().get(pre.op.name(), config->problem))
+            solution = *sol;
+        else if(not config->solutions.empty())
+            solution = config->solutions.front();
+    }
+    compile(ctx, ins, pre.op, solution).replace(*m, ins);
+    migraphx::context mctx{ctx};
+    for(auto i : iterator_for(*m))
+        i->finalize(mctx);
+    return m;
+}
+
+// Compiled modules for the shapes an op with dynamic shapes has seen, which
+// are evicted least recently used first. Concurrent requests for a shape
+// that is still compiling wait for the same compile.
+struct dynamic_kernel_cache
+{
+    using entry = std::shared_future<std::shared_ptr<module>>;
+
+    std::mutex m;
+    std::list<std::string> order;
+    std::unordered_map<std::string, std::pair<entry, std::list<std::string>::iterator>> entries;
+
+    static std::size_t capacity()
+    {
+        static const std::size_t n = value_of(MIGRAPHX_GPU_DYNAMIC_CACHE_SIZE{}, 32);
+        return std::max<std::size_t>(n, 1);
+    }
+
+    template <class F>
+    std::shared_ptr<module> get(const std::string& key, F compile)
+    {
+        std::promise<std::shared_ptr<module>> p;
+        entry e;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            auto it = entries.find(key);
+            if(it != entries.end())
+            {
+                order.splice(order.begin(), order, it->second.second);
+                e = it->second.first;
+            }
+        }
+        if(e.valid())
+            return e.get();
+        {
+            std::lock_guard<std::mutex> lock(m);
+            // Another thread may have started the compile in the meantime
+            auto it = entries.find(key);
+            if(it != entries.end())
+                e = it->second.first;
+            else
+                insert(key, p.get_future().share());
+        }
+        if(e.valid())
+            return e.get();
+        try
+        {
+            auto result = compile();
+            p.set_value(result);
+            return result;
+        }
+        catch(...)
+        {
+            p.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(m);
+            auto it = entries.find(key);
+            if(it != entries.end())
+            {
+                order.erase(it->second.second);
+                entries.erase(it);
+            }
+            throw;
+        }
+    }
+
+    private:
+    void insert(const std::string& key, entry e)
+    {
+        order.push_front(key);
+        entries.emplace(key, std::make_pair(std::move(e), order.begin()));
+        while(order.size() > capacity())
+        {
+            entries.erase(order.back());
+            order.pop_back();
+        }
+    }
+};
+
+// Runs a precompile_op whose shapes are only known at runtime. The kernels
+// are compiled the first time a set of input shapes is seen, and kept in a
+// cache for the next runs with the same shapes.
+struct dynamic_code_object
+{
+    precompile_op pre;
+    std::shared_ptr<dynamic_kernel_cache> cache = std::make_shared<dynamic_kernel_cache>();
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.pre, "pre"));
+    }
+
+    std::string name() const { return "gpu::dynamic_code_object"; }
+
+    shape compute_shape(std::vector<shape> inputs, const std::vector<module_ref>& mods) const
+    {
+        return pre.compute_shape(std::move(inputs), mods);
+    }
+
+    template <class F>
+    argument compute(context& ctx,
+                     const shape&,
+                     const std::vector<argument>& args,
+                     const std::vector<module_ref>& mods,
+                     F run) const
+    {
+        auto inputs   = to_shapes(args);
+        inputs.back() = pre.compute_shape(inputs, mods);
+        std::string key;
+        for(const auto& s : inputs)
+            key += to_string(s) + ";";
+        auto m = cache->get(key, [&] { return compile_module(ctx, pre, inputs, mods); });
+
+        std::unordered_map<std::string, argument> params;
+        for(auto i : range(args.size()))
+            params["x" + std::to_string(i)] = args[i];
+        params["x" + std::to_string(args.size() - 1)] = args.back().reshape(inputs.back());
+        module_ref mref = m.get();
+        return run(mref, params).front();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+MIGRAPHX_REGISTER_OP(dynamic_code_object);
+
+// Runs a precompile_op from a submodule of control flow, such as a branch of an if or one of
+// the select_module variants, whose kernels are only compiled the first time it runs. Copies of
+// the op share the compiled module.
+struct lazy_code_object
+{
+    struct state
+    {
+        std::once_flag once;
+        std::shared_ptr<module> compiled = nullptr;
+    };
+
+    precompile_op pre;
+    std::shared_ptr<state> s = std::make_shared<state>();
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.pre, "pre"));
+    }
+
+    std::string name() const { return "gpu::lazy_code_object"; }
+
+    shape compute_shape(std::vector<shape> inputs, const std::vector<module_ref>& mods) const
+    {
+        return pre.compute_shape(std::move(inputs), mods);
+    }
+
+    template <class F>
+    argument compute(context& ctx,
+                     const shape&,
+                     const std::vector<argument>& args,
+                     const std::vector<module_ref>& mods,
+                     F run) const
+    {
+        // A compile that throws leaves the flag unset so the next run tries again
+        std::call_once(s->once,
+                       [&] { s->compiled = compile_module(ctx, pre, to_shapes(args), mods); });
+
+        std::unordered_map<std::string, argument> params;
+        for(auto i : range(args.size()))
+            params["x" + std::to_string(i)] = args[i];
+        module_ref mref = s->compiled.get();
+        return run(mref, params).front();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+MIGRAPHX_REGISTER_OP(lazy_code_object);
+
 struct compiled_result
 {
     compiler_replace replace;
     instruction_ref ins;
+    value solution = {};
 
     friend std::ostream& operator<<(std::ostream& os, const compiled_result& cr)
     {
@@ -97,17 +336,41 @@ struct compile_plan
     instruction_ref ins;
     optional<tuning_config> config                 = nullopt;
     std::vector<optional<compiled_result>> results = {};
+    // Instructions with the same structure as ins, which reuse its compiled kernels
+    std::vector<instruction_ref> duplicates = {};
+    // Set when the kernel is compiled with the default solution and tuned in the background
+    std::shared_ptr<background_task> background = nullptr;
     void update_config(bool exhaustive)
     {
         config = get_tuning_config(*ctx, ins, preop, exhaustive);
     }
+    // Order the solutions so the ones that won the most for other problems with the same op are
+    // compiled and benchmarked first, and only keep the best MIGRAPHX_TUNE_LIMIT of them
+    void rank_solutions(const std::unordered_map<value, std::size_t>& counts)
+    {
+        if(not config.has_value())
+            return;
+        auto& solutions = config->solutions;
+        auto count      = [&](const value& solution) {
+            auto it = counts.find(solution);
+            return it == counts.end() ? 0 : it->second;
+        };
+        std::stable_sort(solutions.begin(), solutions.end(), [&](const auto& x, const auto& y) {
+            return count(x) > count(y);
+        });
+        auto limit = value_of(MIGRAPHX_TUNE_LIMIT{});
+        if(limit > 0 and solutions.size() > limit)
+            solutions.resize(limit);
+    }
     template <class Vector>
     void insert_compiles(Vector& compiles, const value& solution, std::size_t i)
     {
         compiles.emplace_back([=] {
+            compile_profile_scope profile{"compile", preop.name()};
+            profile.add("solution", solution);
             try
             {
-                results[i] = compiled_result{compile(*ctx, ins, preop, solution), ins};
+                results[i] = compiled_result{compile(*ctx, ins, preop, solution), ins, solution};
             }
             catch(const std::exception& e)
             {
@@ -168,6 +431,8 @@ struct compile_plan
 
     const compiled_result& benchmark() const
     {
+        compile_profile_scope profile{"benchmark", preop.name()};
+        profile.add("configs", results.size());
         const auto trace_level = value_of(MIGRAPHX_TRACE_BENCHMARKING{});
         if(trace_level > 0 and not results.empty())
         {
@@ -188,58 +453,123 @@ struct compile_plan
             MIGRAPHX_THROW("Multiple kernels without config for " + preop.name());
         if(trace_level > 1)
             std::cout << "Problem: " << config->problem << std::endl;
-        std::vector<double> times;
-        times.reserve(results.size());
-        std::transform(results.begin(),
-                       results.end(),
-                       config->solutions.begin(),
-                       std::back_inserter(times),
-                       [&](const auto& cr, const auto& solution) {
-                           if(trace_level > 1)
-                               std::cout << "Benchmarking solution: " << solution << std::endl;
-                           if(not cr.has_value())
-                           {
-                               if(trace_level > 1)
-                                   std::cout << "No binary" << std::endl;
-                               return std::numeric_limits<double>::max();
-                           }
-                           if(trace_level > 2)
-                               std::cout << *cr << std::endl;
-                           /*
-                           create a small program with insturction being compiled and call "replace"
-                           on that which would insert all the compiled code objects, prefills etc.
-                           necessary to run candidate code object
-                           */
-                           program bench_prog;
-                           auto* bench_mm = bench_prog.get_main_module();
-                           std::vector<instruction_ref> bench_ins_inputs;
-
-                           std::transform(cr->ins->inputs().begin(),
-                                          cr->ins->inputs().end(),
-                                          std::back_inserter(bench_ins_inputs),
-                                          [&](const auto& arg) {
-                                              return bench_mm->add_parameter(
-                                                  std::to_string(bench_ins_inputs.size()),
-                                                  arg->get_shape());
-                                          });
-                           auto bench_ins = bench_mm->add_instruction(
-                               cr->ins->get_operator(), bench_ins_inputs, cr->ins->module_inputs());
-                           cr->replace.replace(*bench_mm, bench_ins);
-                           // do dead code elimination by directly removing instruction
-                           bench_mm->remove_instruction(bench_ins);
-                           auto t = time_program(*ctx, bench_prog, 20);
-                           if(trace_level > 1)
-                               std::cout << t << "ms" << std::endl;
-                           return t;
-                       });
+        /*
+        create a small program with insturction being compiled and call "replace"
+        on that which would insert all the compiled code objects, prefills etc.
+        necessary to run candidate code object
+        */
+        auto make_bench_prog = [&](const auto& cr) {
+            program bench_prog;
+            auto* bench_mm = bench_prog.get_main_module();
+            std::vector<instruction_ref> bench_ins_inputs;
+
+            std::transform(cr->ins->inputs().begin(),
+                           cr->ins->inputs().end(),
+                           std::back_inserter(bench_ins_inputs),
+                           [&](const auto& arg) {
+                               return bench_mm->add_parameter(
+                                   std::to_string(bench_ins_inputs.size()), arg->get_shape());
+                           });
+            auto bench_ins = bench_mm->add_instruction(
+                cr->ins->get_operator(), bench_ins_inputs, cr->ins->module_inputs());
+            cr->replace.replace(*bench_mm, bench_ins);
+            // do dead code elimination by directly removing instruction
+            bench_mm->remove_instruction(bench_ins);
+            return bench_prog;
+        };
+        auto bench = [&](const auto& cr, const auto& solution) {
+            if(trace_level > 1)
+                std::cout << "Benchmarking solution: " << solution << std::endl;
+            if(not cr.has_value())
+            {
+                if(trace_level > 1)
+                    std::cout << "No binary" << std::endl;
+                return std::numeric_limits<double>::max();
+            }
+            if(trace_level > 2)
+                std::cout << *cr << std::endl;
+            auto t = time_program(*ctx, make_bench_prog(cr), 20);
+            if(trace_level > 1)
+                std::cout << t << "ms" << std::endl;
+            return t;
+        };
+        // The solutions are ranked, so stop once MIGRAPHX_TUNE_PATIENCE solutions in a row
+        // didn't improve on the fastest one
+        const auto patience = value_of(MIGRAPHX_TUNE_PATIENCE{});
+        std::vector<double> times(results.size(), std::numeric_limits<double>::max());
+        auto fastest           = std::numeric_limits<double>::max();
+        std::size_t since_best = 0;
+        for(auto j : range(results.size()))
+        {
+            times[j] = bench(results[j], config->solutions[j]);
+            if(times[j] < fastest)
+            {
+                fastest    = times[j];
+                since_best = 0;
+            }
+            else
+            {
+                since_best++;
+            }
+            if(patience > 0 and since_best >= patience)
+            {
+                if(trace_level > 0)
+                    std::cout << "Stopped after " << j + 1 << " configs" << std::endl;
+                break;
+            }
+        }
+        // Solutions this close to the fastest one can swap places from run to run, so they are
+        // timed again interleaved until their times separate
+        std::vector<std::size_t> contenders(results.size());
+        std::iota(contenders.begin(), contenders.end(), 0);
+        std::sort(contenders.begin(), contenders.end(), by(std::less<>{}, [&](auto j) {
+                      return times[j];
+                  }));
+        auto close = std::find_if(contenders.begin(), contenders.end(), [&](auto j) {
+            return not results[j].has_value() or times[j] > fastest * (1 + contender_margin);
+        });
+        contenders.erase(close, contenders.end());
+        if(contenders.size() > max_contenders)
+            contenders.resize(max_contenders);
+        if(contenders.size() > 1)
+        {
+            std::vector<program> progs;
+            std::transform(contenders.begin(),
+                           contenders.end(),
+                           std::back_inserter(progs),
+                           [&](auto j) { return make_bench_prog(results[j]); });
+            auto retimes = time_programs(*ctx, std::move(progs));
+            for(auto j : range(contenders.size()))
+            {
+                if(trace_level > 1)
+                    std::cout << "Retimed solution " << config->solutions[contenders[j]] << ": "
+                              << retimes[j] << "ms" << std::endl;
+                times[contenders[j]] = retimes[j];
+            }
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds{50});
         auto i = std::distance(times.begin(), std::min_element(times.begin(), times.end()));
+        // Only the retimed solutions are compared once they are retimed
+        if(contenders.size() > 1)
+        {
+            i = *std::min_element(contenders.begin(),
+                                  contenders.end(),
+                                  by(std::less<>{}, [&](auto j) { return times[j]; }));
+        }
         if(trace_level > 0)
             std::cout << "Fastest solution: " << config->solutions.at(i) << std::endl;
         ctx->get_problem_cache().insert(preop.name(), config->problem, config->solutions.at(i));
         if(not results[i].has_value())
             MIGRAPHX_THROW("No valid tuned compilation for " + preop.name() + " with " +
                            problem_string());
+        // Keep the measured time so the scheduler can use it
+        const auto& code_objects = results[i]->replace.code_objects;
+        if(code_objects.size() == 1)
+        {
+            const auto* co = code_objects.front().any_cast<code_object_op>();
+            if(co != nullptr)
+                ctx->get_kernel_costs().insert(*co, co->expected_inputs, times[i]);
+        }
         auto skipped = std::count_if(
             results.begin(), results.end(), [](const auto& cr) { return not cr.has_value(); });
         if(skipped > 0)
@@ -248,13 +578,206 @@ struct compile_plan
         return *results[i];
     }
 
-    void replace(module& m) const
+    // Estimated flops of the instructions the kernel is compiled from. Pointwise modules work on
+    // scalars, so their flops are counted for each element of the output.
+    std::size_t estimate_flops() const
     {
-        const auto& cr = benchmark();
-        cr.replace.replace(m, cr.ins);
+        if(ins->module_inputs().empty())
+        {
+            auto inputs = to_shapes(ins->inputs());
+            inputs.resize(inputs.size() -
+                          any_cast<precompile_op>(ins->get_operator()).additional_args);
+            return preop.flops(inputs);
+        }
+        std::size_t result = 0;
+        for(const auto* mod : ins->module_inputs())
+        {
+            std::size_t n = 0;
+            for(auto i : iterator_for(*mod))
+                n += i->get_operator().flops(to_shapes(i->inputs()));
+            auto param_shapes = mod->get_parameter_shapes();
+            if(std::all_of(param_shapes.begin(), param_shapes.end(), [](const auto& p) {
+                   return p.second.elements() == 1;
+               }))
+                n *= ins->get_shape().elements();
+            result += n;
+        }
+        return result;
     }
+
+    void replace(module& m, const compiled_result& cr) const;
 };
 
+// Copies m and the modules it uses into p
+static module_ref copy_module(program& p,
+                              const_module_ref m,
+                              std::unordered_map<const_module_ref, module_ref>& copies)
+{
+    auto it = copies.find(m);
+    if(it != copies.end())
+        return it->second;
+    auto* result = p.create_module(m->name(), *m);
+    copies[m]    = result;
+    for(auto ins : iterator_for(*result))
+    {
+        if(ins->module_inputs().empty())
+            continue;
+        std::vector<module_ref> mods;
+        std::transform(ins->module_inputs().begin(),
+                       ins->module_inputs().end(),
+                       std::back_inserter(mods),
+                       [&](auto sm) { return copy_module(p, sm, copies); });
+        result->replace_instruction(ins, ins->get_operator(), ins->inputs(), mods);
+    }
+    return result;
+}
+
+// An instruction to tune in the background. It has its own copy of the instruction, so the
+// compiled program doesn't need to be kept as it was.
+struct background_task
+{
+    program p;
+    compile_plan plan;
+    std::weak_ptr<kernel_swap> swap = {};
+    // The candidate kernels have to take the same arguments as the default one
+    std::vector<shape> inputs = {};
+    shape output              = {};
+    std::size_t cost          = 0;
+
+    background_task(const compile_plan& cp, tuning_config config)
+        : plan{cp.ctx, cp.preop, cp.ins, std::move(config)}
+    {
+        auto* mm = p.get_main_module();
+        std::vector<instruction_ref> params;
+        for(auto input : cp.ins->inputs())
+            params.push_back(mm->add_parameter(param_name(params.size()), input->get_shape()));
+        std::unordered_map<const_module_ref, module_ref> copies;
+        std::vector<module_ref> mods;
+        std::transform(cp.ins->module_inputs().begin(),
+                       cp.ins->module_inputs().end(),
+                       std::back_inserter(mods),
+                       [&](auto sm) { return copy_module(p, sm, copies); });
+        plan.ins = mm->add_instruction(cp.ins->get_operator(), params, mods);
+    }
+};
+
+// Tunes the kernels on a thread of its own, with its own streams, after the program is
+// compiled. The most expensive kernels are tuned first, and the fastest kernel is published to
+// the ops using it as soon as it is found. Destroying the tuner waits for the kernel being
+// benchmarked and drops the rest.
+struct background_tuner
+{
+    struct state
+    {
+        context ctx;
+        std::vector<std::shared_ptr<background_task>> tasks = {};
+        std::atomic<bool> stop{false};
+
+        explicit state(context c) : ctx(std::move(c)) {}
+    };
+
+    explicit background_tuner(const context& ctx)
+        : s(std::make_shared<state>(ctx.create_session()))
+    {
+    }
+
+    background_tuner(const background_tuner&)            = delete;
+    background_tuner& operator=(const background_tuner&) = delete;
+
+    ~background_tuner()
+    {
+        s->stop = true;
+        if(not t.joinable())
+            return;
+        // The tuner can be released by the thread itself when it is the last one to use it
+        if(t.get_id() == std::this_thread::get_id())
+            t.detach();
+        else
+            t.join();
+    }
+
+    void add(std::shared_ptr<background_task> task) { s->tasks.push_back(std::move(task)); }
+
+    void start()
+    {
+        std::stable_sort(s->tasks.begin(), s->tasks.end(), [](const auto& x, const auto& y) {
+            return x->cost > y->cost;
+        });
+        t = std::thread{[st = s] { run(*st); }};
+    }
+
+    private:
+    static void run(state& st)
+    {
+        const auto trace_level = value_of(MIGRAPHX_TRACE_BENCHMARKING{});
+        set_device(st.ctx);
+        auto& pc = st.ctx.get_problem_cache();
+        for(auto& task : st.tasks)
+        {
+            if(st.stop)
+                return;
+            if(task->swap.expired())
+                continue;
+            auto& cp = task->plan;
+            cp.ctx   = &st.ctx;
+            // Another instruction with the same problem may have been tuned already
+            auto sol = pc.get(cp.preop.name(), cp.config->problem);
+            if(sol.has_value() and not sol->is_null())
+                cp.config->solutions = {*sol};
+            else
+                cp.rank_solutions(pc.solution_counts(cp.preop.name()));
+            std::vector<std::function<void()>> compiles;
+            cp.results.resize(cp.config->solutions.size());
+            for(auto i : range(cp.config->solutions.size()))
+                cp.insert_compiles(compiles, cp.config->solutions[i], i);
+            for(const auto& f : compiles)
+            {
+                if(st.stop)
+                    return;
+                f();
+            }
+            try
+            {
+                const auto& cr           = cp.benchmark();
+                const auto& cos          = cr.replace.code_objects;
+                const code_object_op* co = nullptr;
+                if(cos.size() == 1)
+                    co = cos.front().any_cast<code_object_op>();
+                if(co != nullptr and co->expected_inputs == task->inputs and
+                   co->output == task->output)
+                {
+                    tuned_kernel tk{
+                        kernel{co->code_object, co->symbol_name}, co->global, co->local};
+                    if(auto swap = task->swap.lock())
+                        swap->publish(std::move(tk));
+                    if(trace_level > 0)
+                        std::cout << "Swapped in tuned kernel for " << cp.preop.name() << std::endl;
+                }
+            }
+            catch(const std::exception& e)
+            {
+                if(trace_level > 0)
+                    std::cerr << "Background tuning of " + cp.preop.name() + " failed: " + e.what()
+                              << std::endl;
+            }
+            // Release the copy of the instruction and the candidates once they are benchmarked
+            cp.results.clear();
+            task->p = program{};
+        }
+    }
+
+    std::shared_ptr<state> s;
+    std::thread t;
+};
+
+static std::size_t compile_threads()
+{
+    auto n = value_of(MIGRAPHX_GPU_COMPILE_PARALLEL{});
+    if(n == 0)
+        n = std::thread::hardware_concurrency();
+    return std::max<std::size_t>(n, 1);
+}
+
 template <class F>
 void par_compile(std::size_t n, F f)
 {
@@ -266,10 +789,181 @@ void par_compile(std::size_t n, F f)
     par_for(n, n / d, f);
 }
 
+static code_object_op* get_code_object(compiler_replace& r)
+{
+    if(r.code_objects.size() != 1)
+        return nullptr;
+    return r.code_objects.front().any_cast<code_object_op>();
+}
+
+void compile_plan::replace(module& m, const compiled_result& cr) const
+{
+    auto r     = cr.replace;
+    auto flops = estimate_flops();
+    // The replace function may read the inputs of the instruction it was compiled for, in which
+    // case the duplicates are compiled with the same solution to get their own
+    bool reuse = r.is_instruction_independent();
+    if(auto* co = get_code_object(r))
+    {
+        co->estimated_flops = flops;
+        if(background != nullptr)
+        {
+            co->swap           = std::make_shared<kernel_swap>();
+            background->swap   = co->swap;
+            background->inputs = co->expected_inputs;
+            background->output = co->output;
+            background->cost   = flops * (reuse ? duplicates.size() + 1 : 1);
+        }
+    }
+    std::vector<compiler_replace> dup_replaces(duplicates.size(), r);
+    if(not reuse)
+    {
+        par_compile(duplicates.size(), [&](auto i) {
+            dup_replaces[i] = compile(*ctx, duplicates[i], preop, cr.solution);
+            if(auto* co = get_code_object(dup_replaces[i]))
+                co->estimated_flops = flops;
+        });
+    }
+    r.replace(m, cr.ins);
+    for(auto i : range(duplicates.size()))
+        dup_replaces[i].replace(m, duplicates[i]);
+}
+
+// Runs the compiles of each plan on a pool of worker threads that pull from a
+// shared queue. As soon as all the compiles of a plan are finished, ready is
+// called with the plan index on the calling thread, so benchmarking on the
+// GPU overlaps with the remaining compiles.
+template <class F>
+void schedule_compiles(const std::vector<std::vector<std::function<void()>>>& compiles, F ready)
+{
+    // Plans with the most candidates go first since they take the longest
+    // to both compile and benchmark, while the many single kernels fill in
+    // the gaps at the end
+    std::vector<std::size_t> order;
+    for(auto i : range(compiles.size()))
+    {
+        if(not compiles[i].empty())
+            order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](auto x, auto y) {
+        return compiles[x].size() > compiles[y].size();
+    });
+    std::vector<std::pair<std::size_t, const std::function<void()>*>> tasks;
+    for(auto i : order)
+    {
+        std::transform(compiles[i].begin(),
+                       compiles[i].end(),
+                       std::back_inserter(tasks),
+                       [&](const auto& f) { return std::make_pair(i, &f); });
+    }
+    if(tasks.empty())
+        return;
+
+    std::vector<std::atomic<std::size_t>> remaining(compiles.size());
+    for(auto i : order)
+        remaining[i] = compiles[i].size();
+    std::atomic<std::size_t> next{0};
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::size_t> finished;
+
+    std::vector<std::thread> threads(std::min(compile_threads(), tasks.size()));
+    std::generate(threads.begin(), threads.end(), [&] {
+        return std::thread{[&] {
+            for(auto t = next++; t < tasks.size(); t = next++)
+            {
+                auto [plan, f] = tasks[t];
+                (*f)();
+                if(--remaining[plan] > 0)
+                    continue;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    finished.push_back(plan);
+                }
+                cv.notify_one();
+            }
+        }};
+    });
+    auto join = [&] {
+        for(auto& t : threads)
+            t.join();
+    };
+    try
+    {
+        for(std::size_t n = 0; n < order.size(); n++)
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return not finished.empty(); });
+            auto plan = finished.front();
+            finished.pop_front();
+            lock.unlock();
+            ready(plan);
+        }
+    }
+    catch(...)
+    {
+        // Stop picking up new compiles
+        next = tasks.size();
+        join();
+        throw;
+    }
+    join();
+}
+
+// Writes the structure of a module without the names of the module or its instructions, so
+// fused modules with the same instructions, shapes and attributes produce the same text
+static void write_structure(std::ostream& os, const module& m)
+{
+    std::unordered_map<instruction_ref, std::size_t> ids;
+    for(auto ins : iterator_for(m))
+    {
+        auto id  = ids.size();
+        ids[ins] = id;
+        if(ins->name() == "@literal")
+            os << ins->get_literal();
+        else
+            os << ins->get_operator();
+        os << ":" << ins->get_shape() << "(";
+        for(auto input : ins->inputs())
+        {
+            // Inputs from a parent module are unique to this module
+            if(contains(ids, input))
+                os << ids.at(input) << ",";
+            else
+                os << &*input << ",";
+        }
+        os << ")";
+        for(const auto* sm : ins->module_inputs())
+        {
+            os << "{";
+            write_structure(os, *sm);
+            os << "}";
+        }
+        os << ";";
+    }
+}
+
+// Instructions with the same key compile to the same kernels
+static std::string compile_key(instruction_ref ins)
+{
+    std::stringstream ss;
+    ss << ins->get_operator() << ":" << to_string_range(to_shapes(ins->inputs())) << "->"
+       << ins->get_shape();
+    for(const auto* m : ins->module_inputs())
+    {
+        ss << "{";
+        write_structure(ss, *m);
+        ss << "}";
+    }
+    return ss.str();
+}
+
 struct compile_manager
 {
     std::vector<compile_plan> cps;
-    bool exhaustive = false;
+    bool exhaustive                         = false;
+    bool background                         = false;
+    std::shared_ptr<background_tuner> tuner = nullptr;
 
     template <class... Ts>
     void add_plan(Ts&&... xs)
@@ -279,24 +973,62 @@ struct compile_manager
 
     void update_configs()
     {
-        par_compile(cps.size(), [&](auto i) { cps[i].update_config(exhaustive); });
+        par_compile(cps.size(), [&](auto i) {
+            cps[i].update_config(exhaustive);
+            if(background)
+                add_background(cps[i]);
+        });
+        std::unordered_map<std::string, std::unordered_map<value, std::size_t>> counts;
+        for(auto& cp : cps)
+        {
+            if(not cp.config.has_value())
+                continue;
+            auto name = cp.preop.name();
+            if(not contains(counts, name))
+                counts[name] = cp.ctx->get_problem_cache().solution_counts(name);
+            cp.rank_solutions(counts.at(name));
+        }
+    }
+
+    // Kernels with more than one solution to pick from, which aren't tuned yet, are compiled
+    // with the default solution and tuned after the program is compiled
+    static void add_background(compile_plan& cp)
+    {
+        auto config = get_tuning_config(*cp.ctx, cp.ins, cp.preop, true);
+        if(not config.has_value() or config->solutions.size() < 2)
+            return;
+        auto sol = cp.ctx->get_problem_cache().get(cp.preop.name(), config->problem);
+        if(sol.has_value() and not sol->is_null())
+            return;
+        cp.background = std::make_shared<background_task>(cp, *config);
     }
 
     void compile(module& m)
     {
-        std::vector<std::function<void()>> compiles;
-        for(auto& cp : cps)
+        std::vector<std::vector<std::function<void()>>> compiles(cps.size());
+        for(auto i : range(cps.size()))
         {
-            cp.add_compiles(compiles);
+            cps[i].add_compiles(compiles[i]);
         }
-        par_compile(compiles.size(), [&](auto i) { compiles[i](); });
+        // Benchmark each plan as soon as it is compiled
+        std::vector<const compiled_result*> best(cps.size(), nullptr);
+        schedule_compiles(compiles, [&](std::size_t i) { best[i] = &cps[i].benchmark(); });
 
-        // Replace and/or benchmark
-        for(const auto& cp : cps)
+        // Replace the instructions after all the compiles are finished since
+        // the compiles still read from the module
+        for(auto i : range(cps.size()))
         {
-            if(cp.results.empty())
+            if(cps[i].results.empty())
+                continue;
+            assert(best[i] != nullptr);
+            cps[i].replace(m, *best[i]);
+            auto swap = cps[i].background == nullptr ? nullptr : cps[i].background->swap.lock();
+            if(swap == nullptr)
                 continue;
-            cp.replace(m);
+            if(tuner == nullptr)
+                tuner = std::make_shared<background_tuner>(*cps[i].ctx);
+            swap->tuner = tuner;
+            tuner->add(cps[i].background);
         }
 
         // Remove compile_plan already executed
@@ -307,23 +1039,68 @@ struct compile_manager
     }
 };
 
-void compile_ops::apply(module& m) const
+static bool is_dynamic(instruction_ref ins)
 {
+    return ins->get_shape().dynamic() or
+           std::any_of(ins->inputs().begin(), ins->inputs().end(), [](auto i) {
+               return i->get_shape().dynamic();
+           });
+}
+
+void compile_ops::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    if(lazy_compile and &m != mpm.get_root_module())
+    {
+        // Instructions with the same structure share the kernels compiled by the first to run
+        std::unordered_map<std::string, lazy_code_object> lazy;
+        for(auto ins : iterator_for(m))
+        {
+            if(ins->name() != "gpu::precompile_op")
+                continue;
+            if(is_dynamic(ins))
+                continue;
+            const auto& pre = any_cast<precompile_op>(ins->get_operator());
+            auto key        = compile_key(ins);
+            if(not contains(lazy, key))
+                lazy[key] = lazy_code_object{pre};
+            m.replace_instruction(ins, lazy.at(key), ins->inputs(), ins->module_inputs());
+        }
+    }
     compile_manager cm;
     cm.exhaustive = exhaustive_tune;
+    cm.background = background_tune and not exhaustive_tune;
+    std::unordered_map<std::string, std::size_t> plans;
     // Find all precompile ops
     for(auto ins : iterator_for(m))
     {
         if(ins->name() != "gpu::precompile_op")
             continue;
-        operation preop = any_cast<precompile_op>(ins->get_operator()).op;
-        cm.add_plan(ctx, preop, ins);
+        const auto& pre = any_cast<precompile_op>(ins->get_operator());
+        auto inputs     = ins->inputs();
+        if(is_dynamic(ins))
+        {
+            // Compile for each concrete shape as it is seen at runtime
+            m.replace_instruction(ins, dynamic_code_object{pre}, inputs, ins->module_inputs());
+            continue;
+        }
+        // Compile fused modules that are repeated in the model, such as in each layer, only once
+        auto key = compile_key(ins);
+        if(contains(plans, key))
+        {
+            cm.cps[plans.at(key)].duplicates.push_back(ins);
+            continue;
+        }
+        plans[key] = cm.cps.size();
+        cm.add_plan(ctx, pre.op, ins);
     }
     cm.update_configs();
     cm.compile(m);
     // Compile already tuned configs
     cm.compile(m);
     assert(cm.cps.empty());
+    if(cm.tuner != nullptr)
+        cm.tuner->start();
 }
 
 } // namespace gpu
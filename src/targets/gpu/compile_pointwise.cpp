@@ -33,16 +33,19 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
-operation
-compile_pointwise(context& ctx, const std::vector<migraphx::shape>& in_shapes, const_module_ref pm)
+operation compile_pointwise(context& ctx,
+                            const std::vector<migraphx::shape>& in_shapes,
+                            const_module_ref pm,
+                            const value& solution)
 {
     auto pf            = gen::generate_pointwise(*pm, "inner_pointwise", true);
     std::string lambda = "MIGRAPHX_LIFT(inner_pointwise)";
     auto kernel_name   = gen::generate_name_from_ops(*pm, "kernel");
-    return gpu::compile_op("pointwise",
-                           ctx,
-                           in_shapes,
-                           {{"lambda", lambda}, {"preamble", pf}, {"kernel", kernel_name}});
+    value v            = {{"lambda", lambda}, {"preamble", pf}, {"kernel", kernel_name}};
+    // The launch parameters picked by tuning
+    for(const auto& x : solution)
+        v[x.get_key()] = x.without_key();
+    return gpu::compile_op("pointwise", ctx, in_shapes, v);
 }
 
 } // namespace gpu
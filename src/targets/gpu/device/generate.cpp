@@ -0,0 +1,80 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/device/generate.hpp>
+#include <migraphx/gpu/device/launch.hpp>
+#include <migraphx/gpu/device/types.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+namespace device {
+
+MIGRAPHX_DEVICE_CONSTEXPR std::uint64_t splitmix64(std::uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30u)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27u)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31u);
+}
+
+template <class T>
+MIGRAPHX_DEVICE_CONSTEXPR T random_value(std::uint64_t z)
+{
+    if constexpr(std::is_integral<T>{} and std::is_signed<T>{})
+    {
+        const std::int64_t max = 1LL << (sizeof(T) * 6 - 1);
+        return T(max / 2 - static_cast<std::int64_t>(z % max));
+    }
+    else if constexpr(std::is_integral<T>{})
+    {
+        const std::uint64_t max = 1ULL << (sizeof(T) * 8 - 1);
+        return T(z % max);
+    }
+    else
+    {
+        // Top 24 bits scaled to [-1, 1)
+        return T(static_cast<float>(z >> 40u) / static_cast<float>(1u << 23u) - 1.0f);
+    }
+}
+
+void generate(hipStream_t stream, const argument& result, std::uint64_t seed)
+{
+    const auto& s = result.get_shape();
+    bool is_bool  = s.type() == shape::bool_type;
+    index_int n   = s.element_space();
+    seed          = splitmix64(seed);
+    s.visit_type([&](auto as) {
+        auto* data = device_cast(as.from(result.data()));
+        using type = std::remove_pointer_t<decltype(data)>;
+        gs_launch(stream, n)([=](auto i) __device__ {
+            auto z  = splitmix64(seed ^ (static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ULL));
+            data[i] = is_bool ? type(z % 2) : random_value<type>(z);
+        });
+    });
+}
+
+} // namespace device
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
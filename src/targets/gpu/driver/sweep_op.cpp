@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/driver/action.hpp>
+#include <migraphx/gpu/time_op.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/target.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+namespace driver {
+
+// Compiles an operator with the gpu target for each combination of input shapes, type and
+// layout, then reports the bandwidth and flops achieved against the peak of the device.
+struct sweep_op : action<sweep_op>
+{
+    static program create_program(const operation& op, const std::vector<shape>& inputs)
+    {
+        program p;
+        auto* mm = p.get_main_module();
+        std::vector<instruction_ref> args;
+        transform(inputs, range(inputs.size()), std::back_inserter(args), [&](auto input, auto i) {
+            return mm->add_parameter("x" + std::to_string(i), input);
+        });
+        mm->add_return({mm->add_instruction(op, args)});
+        return p;
+    }
+
+    // Only floating point inputs change type, so indices stay integers
+    static std::vector<shape> with_type(std::vector<shape> inputs, const std::string& type)
+    {
+        if(type.empty())
+            return inputs;
+        auto t = shape::parse_type(type);
+        for(auto& s : inputs)
+        {
+            if(not shape::is_integral(s.type()) and s.type() != shape::bool_type)
+                s = s.with_type(t);
+        }
+        return inputs;
+    }
+
+    static std::vector<shape> with_layout(std::vector<shape> inputs,
+                                          const std::vector<int64_t>& perm)
+    {
+        if(perm.empty())
+            return inputs;
+        for(auto& s : inputs)
+        {
+            if(s.ndim() == perm.size() and s.standard())
+                s = shape::from_permutation(s.type(), s.lens(), perm);
+        }
+        return inputs;
+    }
+
+    // A dot does a multiply and add for each element of the reduced dimension, other operators
+    // are counted as one operation per element.
+    static double estimate_flops(const operation& op,
+                                 const std::vector<shape>& inputs,
+                                 const shape& output)
+    {
+        if(contains({"dot", "quant_dot"}, op.name()))
+            return 2.0 * output.elements() * inputs.front().lens().back();
+        std::size_t n = output.elements();
+        for(const auto& s : inputs)
+            n = std::max(n, s.elements());
+        return n;
+    }
+
+    static void apply(const parser& p, const value& v)
+    {
+        auto name = v.at("name").to<std::string>();
+        auto op   = make_op(name);
+        if(v.contains("fields"))
+            op.from_value(v.at("fields"));
+        auto types   = p.get(v, "types", std::vector<std::string>{""});
+        auto layouts = p.get(v, "layouts", std::vector<std::vector<int64_t>>{{}});
+        auto n       = p.get(v, "iterations", 100);
+
+        context ctx;
+        const auto& device = ctx.get_current_device();
+        std::cout << "Peak: " << device.get_peak_bandwidth() / 1e9 << " GB/s, "
+                  << device.get_peak_flops() / 1e12 << " TFLOPs" << std::endl;
+        for(const auto& input_list : v.at("inputs"))
+        {
+            for(const auto& type : types)
+            {
+                for(const auto& layout : layouts)
+                {
+                    auto inputs = with_layout(with_type(p.parse_shapes(input_list), type), layout);
+                    auto output = op.compute_shape(inputs);
+                    auto prog   = create_program(op, inputs);
+                    prog.compile(target{});
+                    auto t     = time_program(ctx, prog, n);
+                    auto bytes = std::accumulate(
+                        inputs.begin(), inputs.end(), output.bytes(), [](auto x, const auto& s) {
+                            return x + s.bytes();
+                        });
+                    auto bandwidth = bytes / (t / 1000.0);
+                    auto flops     = estimate_flops(op, inputs, output) / (t / 1000.0);
+                    std::cout << op << " " << to_string_range(inputs) << " -> " << output
+                              << ": " << t << "ms, " << std::setprecision(4)
+                              << bandwidth / 1e9 << " GB/s ("
+                              << 100 * bandwidth / device.get_peak_bandwidth() << "%), "
+                              << flops / 1e12 << " TFLOPs ("
+                              << 100 * flops / device.get_peak_flops() << "%)" << std::endl;
+                }
+            }
+        }
+    }
+};
+
+} // namespace driver
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,149 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/eliminate_fill.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// Whether the instruction writes every byte of its input at index i without reading it first
+static bool overwrites(instruction_ref ins, std::size_t i)
+{
+    if(ins->name() == "hip::fill")
+        return true;
+    if(not contains({"hip::copy", "hip::copy_to_gpu"}, ins->name()) or i != 1)
+        return false;
+    const auto& src = ins->inputs().front()->get_shape();
+    const auto& dst = ins->inputs().back()->get_shape();
+    if(src.dynamic() or dst.dynamic())
+        return false;
+    return dst.standard() and src.bytes() == dst.bytes();
+}
+
+static bool is_redundant(instruction_ref fill)
+{
+    if(fill->outputs().size() != 1)
+        return false;
+    auto next = fill->outputs().front();
+    const auto& inputs = next->inputs();
+    if(std::count(inputs.begin(), inputs.end(), fill) != 1)
+        return false;
+    auto i = std::distance(inputs.begin(), std::find(inputs.begin(), inputs.end(), fill));
+    return overwrites(next, i);
+}
+
+static std::size_t load_offset(instruction_ref ins)
+{
+    return ins->get_operator().to_value().at("offset").to<std::size_t>();
+}
+
+static bool is_zero_fill_of_load(instruction_ref ins)
+{
+    if(ins->name() != "hip::fill")
+        return false;
+    if(ins->get_operator().to_value().at("value").to<double>() != 0)
+        return false;
+    auto load = ins->inputs().front();
+    return load->name() == "load" and load->get_shape().standard();
+}
+
+// Merge zero fills of adjacent loads from the same memory into one fill of the whole range,
+// and load each original range from the result so its users still depend on the fill
+static void merge_fills(module& m, std::vector<instruction_ref> fills)
+{
+    std::sort(fills.begin(), fills.end(), [](auto x, auto y) {
+        return load_offset(x->inputs().front()) < load_offset(y->inputs().front());
+    });
+    auto first = fills.begin();
+    while(first != fills.end())
+    {
+        auto mem   = (*first)->inputs().front()->inputs().front();
+        auto start = load_offset((*first)->inputs().front());
+        auto end   = start + (*first)->get_shape().bytes();
+        auto last  = std::next(first);
+        while(last != fills.end() and (*last)->inputs().front()->inputs().front() == mem and
+              load_offset((*last)->inputs().front()) == end)
+        {
+            end += (*last)->get_shape().bytes();
+            last++;
+        }
+        if(std::distance(first, last) > 1)
+        {
+            auto pos = *std::min_element(first, last, [&](auto x, auto y) {
+                return std::distance(m.begin(), x) < std::distance(m.begin(), y);
+            });
+            shape s{shape::uint8_type, {end - start}};
+            auto load = m.insert_instruction(
+                pos, make_op("load", {{"shape", to_value(s)}, {"offset", start}}), mem);
+            auto fill = m.insert_instruction(pos, make_op("hip::fill", {{"value", 0}}), load);
+            std::for_each(first, last, [&](auto ins) {
+                auto offset = load_offset(ins->inputs().front()) - start;
+                m.replace_instruction(
+                    ins,
+                    make_op("load", {{"shape", to_value(ins->get_shape())}, {"offset", offset}}),
+                    fill);
+            });
+        }
+        first = last;
+    }
+}
+
+void eliminate_fill::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "hip::fill" and is_redundant(ins))
+            m.replace_instruction(ins, ins->inputs().front());
+    }
+
+    // Zero fills are only merged when nothing else runs between them, other than the loads
+    // that they fill
+    std::vector<instruction_ref> run;
+    for(auto ins : iterator_for(m))
+    {
+        if(is_zero_fill_of_load(ins))
+        {
+            run.push_back(ins);
+            continue;
+        }
+        if(ins->name() == "load")
+            continue;
+        if(run.size() > 1)
+            merge_fills(m, run);
+        run.clear();
+    }
+    if(run.size() > 1)
+        merge_fills(m, run);
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,169 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/fuse_dequant_dot.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/env.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_DEQUANT_DOT)
+
+struct dequant_dot
+{
+    bool int4    = false;
+    int64_t axis = -1;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.int4, "int4"), f(self.axis, "axis"));
+    }
+
+    std::string name() const { return "gpu::dequant_dot"; }
+
+    // Shape of the weights after unpacking and dequantizing
+    shape weight_shape(const std::vector<shape>& inputs) const
+    {
+        const auto& w = inputs.at(1);
+        auto lens     = w.lens();
+        if(int4)
+        {
+            if(axis < 0 or axis >= static_cast<int64_t>(w.ndim()))
+                MIGRAPHX_THROW("DEQUANT_DOT: invalid axis " + std::to_string(axis));
+            lens[axis] *= 2;
+        }
+        return {inputs.at(2).type(), lens};
+    }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(3, 4).same_ndims();
+        const auto& a = inputs.front();
+        const auto& w = inputs.at(1);
+        if(not contains({shape::int8_type, shape::uint8_type}, w.type()))
+            MIGRAPHX_THROW("DEQUANT_DOT: weights must be int8 or uint8");
+        auto ws = weight_shape(inputs);
+        if(not std::all_of(inputs.begin() + 2, inputs.end(), [&](const shape& s) {
+               return s.lens() == ws.lens();
+           }))
+            MIGRAPHX_THROW("DEQUANT_DOT: scales and zero points must match the weights");
+        if(a.type() != ws.type())
+            MIGRAPHX_THROW("DEQUANT_DOT: scales must have the same type as the activations");
+        return make_op("dot").compute_shape({a, ws});
+    }
+};
+MIGRAPHX_REGISTER_OP(dequant_dot);
+
+static bool is_quantized_weight(instruction_ref ins)
+{
+    return contains({shape::int8_type, shape::uint8_type}, ins->get_shape().type());
+}
+
+// Apply the broadcast of the dequantized weights to the quantized inputs
+static std::vector<instruction_ref> broadcast_inputs(module& m,
+                                                     instruction_ref pos,
+                                                     instruction_ref mb,
+                                                     std::vector<instruction_ref> inputs,
+                                                     const dequant_dot& op)
+{
+    if(mb == instruction_ref{})
+        return inputs;
+    auto out_lens = mb->get_shape().lens();
+    std::transform(inputs.begin() + 1, inputs.end(), inputs.begin() + 1, [&](auto input) {
+        auto lens = out_lens;
+        if(op.int4 and input == inputs.at(1))
+            lens[op.axis] /= 2;
+        return m.insert_instruction(pos, make_op("multibroadcast", {{"out_lens", lens}}), input);
+    });
+    return inputs;
+}
+
+void fuse_dequant_dot::apply(module& m) const
+{
+    if(enabled(MIGRAPHX_DISABLE_DEQUANT_DOT{}))
+        return;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "dot" or ins->get_shape().dynamic())
+            continue;
+        if(not contains({shape::float_type, shape::half_type}, ins->get_shape().type()))
+            continue;
+        auto a = ins->inputs().front();
+        // A constant dot is folded instead
+        if(a->can_eval())
+            continue;
+        auto b  = ins->inputs().back();
+        auto mb = instruction_ref{};
+        if(b->name() == "multibroadcast")
+        {
+            mb = b;
+            b  = b->inputs().front();
+        }
+        if(b->name() != "dequantizelinear" or b->get_shape().ndim() < 2)
+            continue;
+        auto dq_inputs = b->inputs();
+        auto x         = dq_inputs.front();
+
+        dequant_dot op;
+        if(x->name() == "unpack_int4")
+        {
+            op.int4 = true;
+            op.axis = x->get_operator().to_value()["axis"].to<int64_t>();
+            x       = x->inputs().front();
+        }
+        if(not is_quantized_weight(x))
+            continue;
+        if(mb != instruction_ref{})
+        {
+            // Only broadcasts of the batch dimensions can be moved to the quantized weights
+            auto rank     = b->get_shape().ndim();
+            auto out_lens = mb->get_shape().lens();
+            auto offset   = out_lens.size() - rank;
+            if(not std::equal(b->get_shape().lens().begin(),
+                              b->get_shape().lens().end(),
+                              out_lens.begin() + offset))
+                continue;
+            op.axis += offset;
+        }
+
+        std::vector<instruction_ref> inputs = {a, x};
+        inputs.insert(inputs.end(), dq_inputs.begin() + 1, dq_inputs.end());
+        inputs = broadcast_inputs(m, ins, mb, inputs, op);
+        if(not op.int4)
+            op.axis = -1;
+        m.replace_instruction(ins, op, inputs);
+    }
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
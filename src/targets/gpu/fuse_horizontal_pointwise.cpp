@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/fuse_horizontal_pointwise.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <numeric>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+struct horizontal_pointwise
+{
+    // The number of inputs of each packed kernel, the outputs are the elements of the tuple
+    // allocation passed last
+    std::vector<std::size_t> ninputs = {};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.ninputs, "ninputs"));
+    }
+
+    std::string name() const { return "gpu::horizontal_pointwise"; }
+
+    shape compute_shape(const std::vector<shape>& inputs, std::vector<module_ref> mods) const
+    {
+        if(mods.size() != ninputs.size())
+            MIGRAPHX_THROW("HORIZONTAL_POINTWISE: expected a module for each kernel");
+        if(inputs.size() != std::accumulate(ninputs.begin(), ninputs.end(), std::size_t{0}))
+            MIGRAPHX_THROW("HORIZONTAL_POINTWISE: wrong number of inputs");
+        std::vector<shape> outputs;
+        auto start = inputs.begin();
+        for(std::size_t i = 0; i < mods.size(); i++)
+        {
+            std::vector<shape> sub_inputs(start, start + ninputs[i]);
+            outputs.push_back(make_op("pointwise").compute_shape(sub_inputs, {mods[i]}));
+            start += ninputs[i];
+        }
+        return shape{outputs};
+    }
+};
+MIGRAPHX_REGISTER_OP(horizontal_pointwise);
+
+static std::string precompile_name(instruction_ref ins)
+{
+    if(ins->name() != "gpu::precompile_op")
+        return "";
+    return ins->get_operator().to_value().at("op").at("name").to<std::string>();
+}
+
+// Whether the output is returned from the module, possibly through views of it
+static bool is_returned(instruction_ref ins)
+{
+    return std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](instruction_ref out) {
+        if(out->name() == "@return")
+            return true;
+        return instruction::get_output_alias(out) == ins and is_returned(out);
+    });
+}
+
+static bool is_candidate(instruction_ref ins, std::size_t max_elements)
+{
+    if(precompile_name(ins) != "pointwise")
+        return false;
+    if(ins->module_inputs().size() != 1 or ins->inputs().size() < 2)
+        return false;
+    auto v = ins->get_operator().to_value();
+    if(v.get("additional_args", std::size_t{1}) != 1)
+        return false;
+    const auto& s = ins->get_shape();
+    if(s.type() == shape::tuple_type or not s.standard() or s.elements() > max_elements)
+        return false;
+    if(ins->inputs().back()->name() != "allocate")
+        return false;
+    return not is_returned(ins);
+}
+
+static void pack_kernels(module& m, const std::vector<instruction_ref>& group)
+{
+    std::vector<instruction_ref> inputs;
+    std::vector<shape> outputs;
+    std::vector<module_ref> mods;
+    std::vector<std::size_t> ninputs;
+    for(auto ins : group)
+    {
+        inputs.insert(inputs.end(), ins->inputs().begin(), ins->inputs().end() - 1);
+        outputs.push_back(ins->get_shape());
+        mods.push_back(ins->module_inputs().front());
+        ninputs.push_back(ins->inputs().size() - 1);
+    }
+    // The packed kernel is placed at the last kernel, so every input is already computed and
+    // none of the outputs are used before it
+    auto last = group.back();
+    auto alloc =
+        m.insert_instruction(last, make_op("allocate", {{"shape", to_value(shape{outputs})}}));
+    inputs.push_back(alloc);
+    auto hop    = make_op("gpu::horizontal_pointwise", {{"ninputs", ninputs}});
+    auto op     = make_op("gpu::precompile_op",
+                      {{"op", to_value(hop)}, {"output_shape", to_value(alloc->get_shape())}});
+    auto packed = m.insert_instruction(last, op, inputs, mods);
+    for(std::size_t i = 0; i < group.size(); i++)
+    {
+        auto elem = m.insert_instruction(last, make_op("get_tuple_elem", {{"index", i}}), packed);
+        m.replace_instruction(group[i], elem);
+    }
+}
+
+void fuse_horizontal_pointwise::apply(module& m) const
+{
+    std::vector<instruction_ref> group;
+    std::unordered_set<instruction_ref> members;
+    auto flush = [&] {
+        if(group.size() > 1)
+            pack_kernels(m, group);
+        group.clear();
+        members.clear();
+    };
+    for(auto ins : iterator_for(m))
+    {
+        // A kernel that uses the output of another member must run after it, so start a new
+        // group from here
+        if(std::any_of(ins->inputs().begin(), ins->inputs().end(), [&](instruction_ref input) {
+               return contains(members, input);
+           }))
+            flush();
+        if(not is_candidate(ins, max_elements))
+            continue;
+        group.push_back(ins);
+        members.insert(ins);
+        if(group.size() == max_kernels)
+            flush();
+    }
+    flush();
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
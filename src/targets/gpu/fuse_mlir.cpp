@@ -35,6 +35,7 @@
 #include <migraphx/param_utils.hpp>
 #include <migraphx/match/softmax.hpp>
 #include <migraphx/fp8_types.hpp>
+#include <migraphx/op/convolution_backwards.hpp>
 #include <optional>
 
 namespace migraphx {
@@ -267,7 +268,8 @@ auto is_mlir_conv(mlir_mode mode)
     return match::make_basic_pred_matcher([=](instruction_ref ins) {
         if(mode == mlir_mode::none)
             return false;
-        if(ins->name() != "convolution" and ins->name() != "quant_convolution")
+        if(not contains({"convolution", "quant_convolution", "convolution_backwards"},
+                        ins->name()))
             return false;
         auto input = ins->inputs().front()->get_shape();
         value v    = ins->get_operator().to_value();
@@ -275,6 +277,17 @@ auto is_mlir_conv(mlir_mode mode)
         // Avoid MLIR assertion: Index < Length && "Invalid index!"
         if(ins->get_shape().lens().size() != 4 and group > 1)
             return false;
+        // Lowered to the backwards data convolution of rocMLIR, which only handles the 2D
+        // convolutions with explicit padding in the float types
+        if(ins->name() == "convolution_backwards")
+        {
+            auto padding_mode =
+                any_cast<op::convolution_backwards>(ins->get_operator()).padding_mode;
+            if(ins->get_shape().lens().size() != 4 or padding_mode != op::default_)
+                return false;
+            return contains({shape::float_type, shape::half_type, shape::bf16_type},
+                            input.type());
+        }
         std::set<shape::type_t> supported_types = {
             shape::fp8e4m3fnuz_type, shape::fp8e4m3fn_type, shape::fp8e5m2_type, shape::int8_type};
         if(contains(supported_types, input.type()))
@@ -339,6 +352,7 @@ bool is_pointwise_op_supported_by_mlir(const instruction& i)
     const auto result_type                            = i.get_shape().type();
     const std::initializer_list<type_t> allowed_types = {type_t::float_type,
                                                          type_t::half_type,
+                                                         type_t::bf16_type,
                                                          type_t::fp8e4m3fnuz_type,
                                                          type_t::fp8e4m3fn_type,
                                                          type_t::fp8e5m2_type,
@@ -354,6 +368,7 @@ bool is_pointwise_op_supported_by_mlir(const instruction& i)
     const std::initializer_list<std::string> no_bool_ops  = {
         "convolution",
         "quant_convolution",
+        "convolution_backwards",
         "dot",
         "quant_dot",
         "add",
@@ -384,6 +399,7 @@ bool is_pointwise_op_supported_by_mlir(const instruction& i)
     };
     std::set<shape::type_t> float_types = {type_t::float_type,
                                            type_t::half_type,
+                                           type_t::bf16_type,
                                            type_t::fp8e4m3fnuz_type,
                                            type_t::fp8e4m3fn_type,
                                            type_t::fp8e5m2_type};
@@ -403,7 +419,8 @@ bool is_pointwise_op_supported_by_mlir(const instruction& i)
             return false;
         } // else
         return std::all_of(i.inputs().begin(), i.inputs().end(), [](const auto& arg) {
-            return contains({type_t::float_type, type_t::half_type}, arg->get_shape().type());
+            return contains({type_t::float_type, type_t::half_type, type_t::bf16_type},
+                            arg->get_shape().type());
         });
     }
     return false;
@@ -415,7 +432,7 @@ bool is_reduce_op_supported_by_mlir(const instruction& i)
     const auto& name                                  = i.name();
     const auto result_type                            = i.get_shape().type();
     const std::initializer_list<type_t> allowed_types = {
-        type_t::float_type, type_t::half_type, type_t::fp8e4m3fnuz_type};
+        type_t::float_type, type_t::half_type, type_t::bf16_type, type_t::fp8e4m3fnuz_type};
     // Preliminary type check.
     if(not contains(allowed_types, result_type))
     {
@@ -567,11 +584,24 @@ struct find_mlir_fused_ops
         auto reshapes = reshaper_names();
         // slice is not supported
         reshapes.erase("slice");
+        // The dots that the heuristics leave out are still fused when the pointwise requantizes
+        // the result, so the 32-bit accumulators are never written out
+        auto requant_dot = match::name("quant_dot")(
+            is_mlir_dot(dot_mode == mlir_mode::none ? mlir_mode::none : mlir_mode::all));
         auto dot_or_conv = match::skip(match::name(reshapes))(
-            match::any_of(is_mlir_dot(dot_mode), is_mlir_conv(conv_mode)).bind("gemm_based_op"));
+            match::any_of(is_mlir_dot(dot_mode),
+                          is_mlir_conv(conv_mode),
+                          requant_dot.bind("requant_dot"))
+                .bind("gemm_based_op"));
         return mlir_pointwise()(match::any_of[match::inputs()](dot_or_conv.bind("x")));
     }
 
+    static bool is_requantized(instruction_ref pw_ins)
+    {
+        return contains({shape::int8_type, shape::uint8_type}, pw_ins->get_shape().type()) or
+               contains(fp8_types{}.get(), pw_ins->get_shape().type());
+    }
+
     void apply(module_pass_manager& mpm, const match::matcher_result& r) const
     {
         auto pw_ins        = r.result;
@@ -579,6 +609,8 @@ struct find_mlir_fused_ops
         auto x_ins         = r.instructions["x"]; // input to pointwise after reshaper op stream
         auto* pm           = pw_ins->module_inputs().front();
         auto pw_inputs     = pw_ins->inputs();
+        if(contains(r.instructions, "requant_dot") and not is_requantized(pw_ins))
+            return;
         // only of one of the inputs to pointwise module should be dependent on conv/gemm that is
         // being fused, otherwise it can create invalid graph transformation
         if(std::any_of(pw_inputs.begin(), pw_inputs.end(), [&](const auto& i) {
@@ -660,10 +692,11 @@ struct find_mlir_standalone_op
     void apply(module_pass_manager& mpm, const match::matcher_result& r) const
     {
         auto gemm_based_op = r.result;
-        // enable only for fp32/fp16/i8/fp8 types
+        // enable only for fp32/fp16/bf16/i8/fp8 types
         if(std::any_of(gemm_based_op->inputs().begin(), gemm_based_op->inputs().end(), [&](auto i) {
                return not contains({shape::type_t::float_type,
                                     shape::type_t::half_type,
+                                    shape::type_t::bf16_type,
                                     shape::type_t::int8_type,
                                     shape::type_t::fp8e4m3fnuz_type,
                                     shape::type_t::fp8e4m3fn_type,
@@ -723,6 +756,148 @@ struct find_mlir_standalone_attention_op
         dead_code_elimination{}.apply(*m);
     }
 
+    // Finds the pointwise ops between the gemms that do not depend on the scores, when some of
+    // them are not supported by MLIR. These compute a mask or bias from the inputs, such as a
+    // padding or causal mask built with compare and logical ops.
+    static std::optional<std::unordered_set<instruction_ref>>
+    find_mask_ops(instruction_ref gemm1, instruction_ref softmax)
+    {
+        std::unordered_set<instruction_ref> scores = {gemm1};
+        std::unordered_set<instruction_ref> mask_ops;
+        bool unsupported = false;
+        for(auto ins = std::next(gemm1); ins != softmax; ins++)
+        {
+            bool supported = is_pointwise_op_supported_by_mlir(*ins) or
+                             contains(reshaper_names(), ins->name());
+            if(std::any_of(ins->inputs().begin(), ins->inputs().end(), [&](auto input) {
+                   return contains(scores, input);
+               }))
+            {
+                if(not supported)
+                    return std::nullopt;
+                scores.insert(ins);
+            }
+            else if(ins->get_operator().attributes().get("pointwise", false))
+            {
+                unsupported = unsupported or not supported;
+                mask_ops.insert(ins);
+            }
+            else if(not supported)
+            {
+                return std::nullopt;
+            }
+        }
+        if(not unsupported)
+            return std::unordered_set<instruction_ref>{};
+        // Other inputs have to be parameters or scalar literals
+        auto is_input = [&](auto input) {
+            return contains(mask_ops, input) or input->name() == "@param";
+        };
+        auto is_scalar = [](auto input) {
+            if(input->name() == "multibroadcast")
+                input = input->inputs().front();
+            return input->name() == "@literal" and input->get_shape().elements() == 1;
+        };
+        if(not std::all_of(mask_ops.begin(), mask_ops.end(), [&](auto ins) {
+               const auto& inputs = ins->inputs();
+               return std::any_of(inputs.begin(), inputs.end(), is_input) and
+                      std::all_of(inputs.begin(), inputs.end(), [&](auto input) {
+                          return is_input(input) or is_scalar(input);
+                      });
+           }))
+            return std::nullopt;
+        return mask_ops;
+    }
+
+    // Computes each mask op used by the scores with a pointwise module in the main module. It is
+    // computed at the shape of its inputs before they were broadcasted, and passed to the
+    // attention as a broadcasted input, so the mask is never expanded to the size of the scores.
+    void hoist_mask_ops(module_pass_manager& mpm,
+                        module& m_attn,
+                        const std::unordered_set<instruction_ref>& mask_ops,
+                        instruction_ref pos,
+                        const std::string& name,
+                        std::unordered_map<instruction_ref, instruction_ref>& map_main_to_mattn)
+        const
+    {
+        auto& mm               = mpm.get_module();
+        auto map_mattn_to_main = invert_map_ins(map_main_to_mattn);
+        std::vector<instruction_ref> roots;
+        std::copy_if(mask_ops.begin(), mask_ops.end(), std::back_inserter(roots), [&](auto ins) {
+            return std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](auto output) {
+                return not contains(mask_ops, output);
+            });
+        });
+        std::sort(roots.begin(), roots.end(), [&](auto x, auto y) {
+            return std::distance(m_attn.begin(), x) < std::distance(m_attn.begin(), y);
+        });
+        for(auto i : range(roots.size()))
+        {
+            auto root = roots[i];
+            std::unordered_set<instruction_ref> inss;
+            fix([&](auto self, instruction_ref ins) {
+                if(not contains(mask_ops, ins) or not inss.insert(ins).second)
+                    return;
+                for(auto input : ins->inputs())
+                    self(input);
+            })(root);
+
+            module pm;
+            std::unordered_map<instruction_ref, instruction_ref> map_ins;
+            std::vector<instruction_ref> inputs;
+            for(auto ins : iterator_for(m_attn))
+            {
+                if(not contains(inss, ins))
+                    continue;
+                for(auto input : ins->inputs())
+                {
+                    if(contains(map_ins, input))
+                        continue;
+                    if(input->name() == "@param")
+                    {
+                        auto x = map_mattn_to_main.at(input);
+                        if(x->name() == "multibroadcast" and
+                           x->inputs().front()->get_shape().ndim() == x->get_shape().ndim())
+                            x = x->inputs().front();
+                        map_ins[input] = pm.add_parameter(param_name(inputs.size()),
+                                                          shape{input->get_shape().type()});
+                        inputs.push_back(x);
+                    }
+                    else
+                    {
+                        auto lit = input->name() == "@literal" ? input : input->inputs().front();
+                        map_ins[input] = pm.add_literal(lit->get_literal());
+                    }
+                }
+                std::vector<instruction_ref> args;
+                std::transform(ins->inputs().begin(),
+                               ins->inputs().end(),
+                               std::back_inserter(args),
+                               [&](auto input) { return map_ins.at(input); });
+                map_ins[ins] = pm.add_instruction(ins->get_operator(), args);
+            }
+            pm.add_return({map_ins.at(root)});
+
+            auto lens = inputs.front()->get_shape().lens();
+            for(auto x : inputs)
+                lens = compute_broadcasted_lens(lens, x->get_shape().lens());
+            std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto x) {
+                if(x->get_shape().lens() == lens)
+                    return x;
+                return mm.insert_instruction(
+                    pos, make_op("multibroadcast", {{"out_lens", lens}}), x);
+            });
+            auto* mpm_mask = mpm.create_module(name + ":mask" + std::to_string(i), std::move(pm));
+            mpm_mask->set_bypass();
+            auto mask = mm.insert_instruction(pos, make_op("pointwise"), inputs, {mpm_mask});
+            if(lens != root->get_shape().lens())
+                mask = mm.insert_instruction(
+                    pos, make_op("multibroadcast", {{"out_lens", root->get_shape().lens()}}), mask);
+            m_attn.add_params({mask}, &map_main_to_mattn);
+            m_attn.replace_instruction(root, map_main_to_mattn.at(mask));
+        }
+    }
+
     void apply(module_pass_manager& mpm, const match::matcher_result& r) const
     {
         auto gemm2        = r.instructions["gemm2"];
@@ -774,12 +949,18 @@ struct find_mlir_standalone_attention_op
             std::next(softmax_in), make_op("softmax", {{"axis", axes.front()}}), softmax_in);
         map_main_to_mattn[fused_reduce] = softmax;
 
-        // all preceeding ops should be fusable ops
-        if(not std::all_of(m_gemm1, softmax, [](auto i) {
-               return (is_pointwise_op_supported_by_mlir(i) or
-                       contains(reshaper_names(), i.name()));
-           }))
+        // all preceeding ops should be fusable ops, except for masks computed from the inputs,
+        // which are moved out of the attention
+        auto mask_ops = find_mask_ops(m_gemm1, softmax);
+        if(not mask_ops.has_value())
             return;
+        if(not mask_ops->empty())
+            hoist_mask_ops(mpm,
+                           m_attn,
+                           *mask_ops,
+                           fused_reduce,
+                           fused_reduce->module_inputs().front()->name(),
+                           map_main_to_mattn);
 
         // Add second gemm and fuse any input shape ops
         module fuse_gemm2;
@@ -812,6 +993,12 @@ struct find_mlir_standalone_attention_op
         }
 
         finalize_attention_module(&m_attn);
+        // Remove the parameters only used by the masks moved out of the attention
+        for(auto param : m_attn.get_parameters())
+        {
+            if(param->outputs().empty() and not mask_ops->empty())
+                m_attn.remove_instruction(param);
+        }
         auto map_mattn_to_main = invert_map_ins(map_main_to_mattn);
         auto new_inputs        = m_attn.get_inputs(map_mattn_to_main);
 
@@ -835,6 +1022,113 @@ struct find_mlir_attention_fused_ops : public find_mlir_standalone_attention_op
     }
 };
 
+// Fuses the two gemms of an mlp with the activation between them, so the intermediate
+// activations are never written out. A gated activation, such as swiglu, reads two gemms with the
+// same input, which are both fused. Only done for a few rows, where the traffic of the
+// intermediate activations dominates.
+struct find_mlir_mlp_op : find_mlir_standalone_attention_op
+{
+    std::size_t max_rows = 32;
+
+    auto matcher() const
+    {
+        auto gemm1 =
+            match::skip(match::name("contiguous"))(match::used_once(), is_mlir_dot(dot_mode));
+        auto activation = mlir_pointwise()(match::used_once(),
+                                           match::any_of[match::inputs()](gemm1.bind("gemm1")))
+                              .bind("activation");
+        return is_mlir_dot(dot_mode)(match::arg(0)(activation)).bind("gemm2");
+    }
+
+    static instruction_ref skip_contiguous(instruction_ref ins)
+    {
+        while(ins->name() == "contiguous")
+            ins = ins->inputs().front();
+        return ins;
+    }
+
+    void apply(module_pass_manager& mpm, const match::matcher_result& r) const
+    {
+        auto gemm2      = r.instructions["gemm2"];
+        auto activation = r.instructions["activation"];
+        auto gemm1      = r.instructions["gemm1"];
+        const auto& s   = gemm2->get_shape();
+        if(s.elements() / s.lens().back() > max_rows)
+            return;
+
+        // The gemms read by the activation, which must all have the same input for a gated
+        // activation
+        std::vector<instruction_ref> gemms;
+        for(auto input : activation->inputs())
+        {
+            auto gemm = skip_contiguous(input);
+            if(gemm->name() != gemm1->name() or gemm->outputs().size() != 1 or
+               (input != gemm and input->outputs().size() != 1))
+                continue;
+            if(gemm->inputs().front() != gemm1->inputs().front())
+                return;
+            if(match::match_instruction(mpm.get_module(), gemm, is_mlir_dot(dot_mode)).result !=
+               gemm)
+                return;
+            if(not contains(gemms, gemm))
+                gemms.push_back(gemm);
+        }
+        if(gemms.empty() or gemms.size() > 2)
+            return;
+
+        module m_mlp;
+        std::unordered_map<instruction_ref, instruction_ref> map_main_to_mmlp;
+        for(auto gemm : gemms)
+        {
+            module fuse_gemm;
+            auto [anchor_op, top_inputs] =
+                fuse_input_ops_and_gemm_based_op(&fuse_gemm, gemm->inputs(), gemm->get_operator());
+            fuse_gemm.add_return({anchor_op});
+            m_mlp.add_params(top_inputs, &map_main_to_mmlp);
+            std::unordered_map<instruction_ref, instruction_ref> map_gemm_to_mmlp(
+                map_main_to_mmlp);
+            map_main_to_mmlp[gemm] = m_mlp.fuse(fuse_gemm, top_inputs, &map_gemm_to_mmlp).front();
+        }
+        for(auto input : activation->inputs())
+        {
+            auto gemm = skip_contiguous(input);
+            if(contains(gemms, gemm))
+                map_main_to_mmlp[input] = map_main_to_mmlp[gemm];
+        }
+
+        // Add the activation, unrolling the pointwise module back to base ops
+        m_mlp.add_params(activation->inputs(), &map_main_to_mmlp);
+        std::unordered_map<instruction_ref, instruction_ref> map_pw_to_mmlp(map_main_to_mmlp);
+        auto m_activation = m_mlp
+                                .fuse(*activation->module_inputs().front(),
+                                      activation->inputs(),
+                                      &map_pw_to_mmlp,
+                                      &unroll_pointwise)
+                                .front();
+        map_main_to_mmlp[activation] = m_activation;
+
+        module fuse_gemm2;
+        auto [anchor_op2, top_inputs2] =
+            fuse_input_ops_and_gemm_based_op(&fuse_gemm2, gemm2->inputs(), gemm2->get_operator());
+        fuse_gemm2.add_return({anchor_op2});
+        m_mlp.add_params(top_inputs2, &map_main_to_mmlp);
+        std::unordered_map<instruction_ref, instruction_ref> map_gemm2_to_mmlp(map_main_to_mmlp);
+        auto m_gemm2 = m_mlp.fuse(fuse_gemm2, top_inputs2, &map_gemm2_to_mmlp).front();
+        m_mlp.add_return({m_gemm2});
+
+        finalize_attention_module(&m_mlp);
+        auto map_mmlp_to_main = invert_map_ins(map_main_to_mmlp);
+        auto new_inputs       = m_mlp.get_inputs(map_mmlp_to_main);
+
+        module_ref mpm_mlp = mpm.create_module(
+            "mlir_mlp_" + activation->module_inputs().front()->name(), std::move(m_mlp));
+        mpm_mlp->set_bypass();
+
+        mpm.get_module().replace_instruction(
+            gemm2, mlir_op{gemm1->get_operator()}, mlir_contiguous(mpm, new_inputs), {mpm_mlp});
+    }
+};
+
 struct find_pointwise_mlir
 {
     auto matcher() const
@@ -886,7 +1180,8 @@ void fuse_mlir::apply(module_pass_manager& mpm) const
 {
 #ifdef MIGRAPHX_MLIR
     const auto& device_name = ctx == nullptr ? "" : ctx->get_current_device().get_gfx_name();
-    const bool is_navi      = starts_with(device_name, "gfx11");
+    // RDNA devices have no MFMA instructions, so mlir's WMMA kernels are used for all gemms
+    const bool is_navi = starts_with(device_name, "gfx11") or starts_with(device_name, "gfx12");
 
     auto get_mode = [&](std::string_view option, mlir_mode m1, mlir_mode m2 = mlir_mode::fast) {
         if(specific_op<rejected>(option))
@@ -907,6 +1202,13 @@ void fuse_mlir::apply(module_pass_manager& mpm) const
         mpm.run_pass(dead_code_elimination{});
     }
 
+    // Mlp offloads; default disabled
+    if(specific_op<requested>("mlp") or enable_extra)
+    {
+        match::find_matches(mpm, find_mlir_mlp_op{mlir_mode::all});
+        mpm.run_pass(dead_code_elimination{});
+    }
+
     match::find_matches(
         mpm,
         find_mlir_fused_ops{.conv_mode = get_mode("fused_convolution", mlir_mode::fast),
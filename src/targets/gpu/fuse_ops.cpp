@@ -29,11 +29,15 @@
 #include <migraphx/gpu/device_name.hpp>
 #include <migraphx/gpu/oper.hpp>
 #include <migraphx/gpu/gemm.hpp>
+#include <migraphx/gpu/hip_gemm.hpp>
+#include <migraphx/fp8_types.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/array.hpp>
 #include <migraphx/permutation.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/gpu/hip.hpp>
 #include <cmath>
 #include <set>
 
@@ -254,12 +258,21 @@ struct miopen_fusion
         }
     };
     std::vector<fuse_op> ops = {};
-    fusion f                 = {};
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+    value::binary solution_object{};
+    shared<miopen_solution> solution_ptr = nullptr;
+#else
+    fusion f = {};
     std::function<void(context&, const fusion&, const std::vector<argument>&)> execute;
+#endif
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
-        return pack(f(self.ops, "ops"));
+        return pack(
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+            f(self.solution_object, "solution_object"),
+#endif
+            f(self.ops, "ops"));
     }
 
     std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
@@ -267,6 +280,178 @@ struct miopen_fusion
         return shapes.size() - 1;
     }
 
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+    // The inputs are {x, w, bias..., workspace, allocation}, where the workspace is used as the
+    // limit while searching for a solution and is then resized to what the solution needs
+    value compile(context& ctx, const shape& output_shape, std::vector<shape> inputs)
+    {
+        // Compensate for workspace and allocation
+        inputs.pop_back();
+        auto workspace_shape = inputs.back();
+        inputs.pop_back();
+        if(not std::all_of(ops.begin(), ops.end(), [](const fuse_op& fop) {
+               return contains({"convolution", "add", "relu"}, fop.op.name());
+           }))
+            return {};
+        auto ids = tensor_ids();
+        if(ids.size() != inputs.size() + 1)
+            return {};
+        auto problem = create_problem(inputs, output_shape);
+
+        bool preallocate = false;
+#ifdef MIGRAPHX_PREALLOCATE_MIOPEN_BUFFERS
+        preallocate = true;
+#endif
+        unsigned long seed = 0;
+        std::vector<argument> args;
+        std::transform(inputs.begin(), inputs.end(), std::back_inserter(args), [&](const auto& s) {
+            return preallocate ? to_gpu(generate_argument(s, seed++, random_mode::random))
+                               : argument{s};
+        });
+        args.push_back(preallocate ? allocate_gpu(output_shape) : argument{output_shape});
+        auto workspace =
+            preallocate ? allocate_gpu(workspace_shape) : argument{workspace_shape};
+
+        std::vector<miopenTensorArgument_t> tensor_args;
+        std::transform(ids.begin(),
+                       ids.end(),
+                       args.begin(),
+                       std::back_inserter(tensor_args),
+                       [](auto id, const argument& arg) {
+                           return miopenTensorArgument_t{id, nullptr, arg.implicit()};
+                       });
+        // MIOpen reports a fusion it has no solver for as a failed find, so skip fusing it
+        try
+        {
+            solution_ptr = find_solution(ctx.get_stream().get_miopen(),
+                                         tensor_args.size(),
+                                         tensor_args.data(),
+                                         workspace.implicit(),
+                                         workspace_shape.bytes(),
+                                         problem.get(),
+                                         ctx.get_exhaustive_tune_flag());
+        }
+        catch(const exception&)
+        {
+            solution_ptr = nullptr;
+            return {};
+        }
+
+        std::size_t workspace_size = 0;
+        auto status = miopenGetSolutionWorkspaceSize(solution_ptr.get(), &workspace_size);
+        if(status != miopenStatusSuccess)
+            MIGRAPHX_THROW("MIOpen fusion: failed to get solution's workspace size");
+
+        std::size_t solution_size = 0;
+        status                    = miopenGetSolutionSize(solution_ptr.get(), &solution_size);
+        if(status != miopenStatusSuccess)
+            MIGRAPHX_THROW("MIOpen fusion: failed to fetch solution size");
+
+        std::vector<char> solution_binary(solution_size);
+        status = miopenSaveSolution(solution_ptr.get(), solution_binary.data());
+        if(status != miopenStatusSuccess)
+            MIGRAPHX_THROW("MIOpen fusion: saving solution failed");
+        solution_object = value::binary{solution_binary.data(), solution_size};
+        return {{"workspace", workspace_size}};
+    }
+
+    // Each operator is its own problem fused onto the convolution. The tensors between them never
+    // reach memory, so they all share the output descriptor.
+    miopen_problem create_problem(const std::vector<shape>& inputs, const shape& output_shape) const
+    {
+        auto y_desc = make_tensor(output_shape);
+        miopen_problem result{};
+        std::size_t i = 0;
+        for(auto&& fop : ops)
+        {
+            miopen_problem problem{};
+            if(fop.op.name() == "convolution")
+            {
+                auto cd = make_conv(any_cast<op::convolution>(fop.op));
+                problem = make_obj<miopen_problem>(
+                    &miopenCreateConvProblem, cd.get(), miopenProblemDirectionForward);
+
+                auto x_desc = make_tensor(inputs.at(i++));
+                auto w_desc = make_tensor(inputs.at(i++));
+                set_tensor_descriptor(miopenTensorConvolutionX, x_desc, problem);
+                set_tensor_descriptor(miopenTensorConvolutionW, w_desc, problem);
+                set_tensor_descriptor(miopenTensorConvolutionY, y_desc, problem);
+            }
+            else if(fop.op.name() == "add")
+            {
+                problem = make_obj<miopen_problem>(&miopenCreateBiasProblem,
+                                                   miopenProblemDirectionForward);
+                const auto& bias = inputs.at(i++);
+                auto b_desc      = make_tensor(shape{bias.type(), {1, bias.lens().at(1), 1, 1}});
+                set_tensor_descriptor(miopenTensorBiasX, y_desc, problem);
+                set_tensor_descriptor(miopenTensorBias, b_desc, problem);
+                set_tensor_descriptor(miopenTensorBiasY, y_desc, problem);
+            }
+            else if(fop.op.name() == "relu")
+            {
+                auto ad = make_relu();
+                problem = make_obj<miopen_problem>(
+                    &miopenCreateActivationProblem, ad.get(), miopenProblemDirectionForward);
+                set_tensor_descriptor(miopenTensorActivationX, y_desc, problem);
+                set_tensor_descriptor(miopenTensorActivationY, y_desc, problem);
+            }
+            else
+            {
+                MIGRAPHX_THROW("MIOpen fusion: unsupported operator " + fop.op.name());
+            }
+            if(result == nullptr)
+            {
+                result = std::move(problem);
+                continue;
+            }
+            auto status = miopenFuseProblems(result.get(), problem.get());
+            if(status != miopenStatusSuccess)
+                MIGRAPHX_THROW("MIOpen fusion: fusing " + fop.op.name() + " failed");
+        }
+        return result;
+    }
+
+    // The ids of the tensor inputs in order, followed by the id of the output of the last operator
+    std::vector<miopenTensorArgumentId_t> tensor_ids() const
+    {
+        std::vector<miopenTensorArgumentId_t> result;
+        miopenTensorArgumentId_t output = miopenTensorConvolutionY;
+        for(auto&& fop : ops)
+        {
+            if(fop.op.name() == "convolution")
+            {
+                result.push_back(miopenTensorConvolutionX);
+                result.push_back(miopenTensorConvolutionW);
+                output = miopenTensorConvolutionY;
+            }
+            else if(fop.op.name() == "add")
+            {
+                result.push_back(miopenTensorBias);
+                output = miopenTensorBiasY;
+            }
+            else if(fop.op.name() == "relu")
+            {
+                output = miopenTensorActivationY;
+            }
+        }
+        result.push_back(output);
+        return result;
+    }
+
+    void finalize(context&, const shape&, const std::vector<shape>&)
+    {
+        if(solution_ptr != nullptr)
+            return;
+        if(solution_object.empty())
+            MIGRAPHX_THROW("MIOpen fusion: no solution to load");
+        miopenSolution_t ptr;
+        auto status = miopenLoadSolution(
+            &ptr, reinterpret_cast<const char*>(solution_object.data()), solution_object.size());
+        solution_ptr = miopen_solution{ptr};
+        if(status != miopenStatusSuccess)
+            MIGRAPHX_THROW("MIOpen fusion: loading solution failed");
+    }
+#else
     value compile(context& ctx, const shape&, std::vector<shape> inputs)
     {
         // Compensate for allocation
@@ -338,6 +523,7 @@ struct miopen_fusion
         if(not v.is_object())
             MIGRAPHX_THROW("Failed to compile fusion plan");
     }
+#endif
     std::string name() const { return "gpu::miopen_fusion"; }
     shape compute_shape(const std::vector<shape>& inputs) const
     {
@@ -348,7 +534,33 @@ struct miopen_fusion
     }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+        if(solution_ptr == nullptr)
+            MIGRAPHX_THROW("MIOpen fusion: load MIOpen solution before running it");
+        auto ids = tensor_ids();
+        // The workspace sits between the tensor inputs and the output
+        std::vector<argument> tensors(args.begin(), args.end() - 2);
+        tensors.push_back(args.back());
+        std::vector<miopenTensorArgument_t> tensor_args;
+        std::transform(ids.begin(),
+                       ids.end(),
+                       tensors.begin(),
+                       std::back_inserter(tensor_args),
+                       [](auto id, const argument& arg) {
+                           return miopenTensorArgument_t{id, nullptr, arg.implicit()};
+                       });
+        const auto& workspace = args[args.size() - 2];
+        auto status           = miopenRunSolution(ctx.get_stream().get_miopen(),
+                                        solution_ptr.get(),
+                                        tensor_args.size(),
+                                        tensor_args.data(),
+                                        workspace.implicit(),
+                                        workspace.get_shape().bytes());
+        if(status != miopenStatusSuccess)
+            MIGRAPHX_THROW("MIOpen fusion: running solution failed");
+#else
         execute(ctx, f, args);
+#endif
         return args.back();
     }
 };
@@ -547,9 +759,18 @@ struct find_conv_pointwise
             op.ops.push_back({{i.get_operator()}});
         }
         std::vector<instruction_ref> inputs = {input_ins, weights_ins, bias_ins, alloc_ins};
-        auto v                              = op.compile(*ctx, ins->get_shape(), to_shapes(inputs));
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+        // Search within the workspace of the convolution
+        inputs.insert(std::prev(inputs.end()), conv_ins->inputs().at(2));
+#endif
+        auto v = op.compile(*ctx, ins->get_shape(), to_shapes(inputs));
         if(not v.is_object())
             return;
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+        auto ws = shape{shape::int8_type, {v.at("workspace").to<std::size_t>()}};
+        inputs[inputs.size() - 2] =
+            m.insert_instruction(ins, make_op("allocate", {{"shape", to_value(ws)}}));
+#endif
         m.replace_instruction(ins, op, inputs);
     }
 };
@@ -560,7 +781,7 @@ struct find_gemm_pointwise
 {
     auto matcher() const
     {
-        auto gemm_op   = match::name("gpu::gemm")(match::nargs(3), match::used_once()).bind("gemm");
+        auto gemm_op   = match::name("gpu::gemm")(match::nargs(4), match::used_once()).bind("gemm");
         auto binary_op = match::all_of(
             match::nargs(3),
             match::either_arg(0, 1)(
@@ -662,6 +883,8 @@ struct find_gemm_pointwise
 
         auto inputs = gemm_ins->inputs();
         inputs.pop_back();
+        auto workspace = inputs.back();
+        inputs.pop_back();
 
         if(ins->inputs().size() == 3)
         {
@@ -678,6 +901,7 @@ struct find_gemm_pointwise
             inputs.push_back(c_ins);
         }
 
+        inputs.push_back(workspace);
         inputs.push_back(ins->inputs().back());
 
         m.replace_instruction(ins, gemm, inputs);
@@ -685,6 +909,151 @@ struct find_gemm_pointwise
 };
 #endif
 
+#if MIGRAPHX_USE_HIPBLASLT
+// Fold a pointwise of the form relu(scale * alpha * x + bias), where any part can
+// be missing, into the hipBLASLt epilogue of the gemm that produces x. The scale
+// is a runtime float, which hipBLASLt can only apply to fp8 gemms.
+struct find_hip_gemm_pointwise
+{
+    auto matcher() const
+    {
+        auto gemm_op = match::name("gpu::hip_gemm", "gpu::hip_quant_gemm")(match::nargs(4),
+                                                                          match::used_once())
+                           .bind("gemm");
+        return precompile_name("pointwise")(match::any_of[match::inputs()](gemm_op));
+    }
+
+    static bool is_bias(instruction_ref ins, const shape& output)
+    {
+        const auto& s = ins->get_shape();
+        if(s.type() != output.type() or s.lens() != output.lens())
+            return false;
+        return s.strides().back() == 1 and
+               std::all_of(s.strides().begin(), s.strides().end() - 1, [](auto x) {
+                   return x == 0;
+               });
+    }
+
+    static bool is_scale(instruction_ref ins)
+    {
+        const auto& s = ins->get_shape();
+        return s.type() == shape::float_type and s.element_space() == 1;
+    }
+
+    static bool is_fp8_gemm(instruction_ref gemm_ins)
+    {
+        return contains(fp8_types{}.get(), gemm_ins->inputs().front()->get_shape().type());
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto gemm_ins = r.instructions["gemm"];
+        if(gemm_ins->name() == "gpu::hip_gemm")
+        {
+            apply_gemm(
+                m, r.result, gemm_ins, any_cast<hip_gemm<op::dot>>(gemm_ins->get_operator()));
+        }
+        // The int8 gemms produce int32 which the epilogue can't scale
+        else if(is_fp8_gemm(gemm_ins))
+        {
+            apply_gemm(
+                m, r.result, gemm_ins, any_cast<hip_gemm<op::quant_dot>>(gemm_ins->get_operator()));
+        }
+    }
+
+    template <class Op>
+    void
+    apply_gemm(module& m, instruction_ref ins, instruction_ref gemm_ins, hip_gemm<Op> gemm) const
+    {
+        if(gemm.bias or not gemm.activation.empty() or gemm.scale or not float_equal(gemm.beta, 0))
+            return;
+        // The result is written with the layout of the gemm
+        if(ins->get_shape() != gemm_ins->get_shape())
+            return;
+
+        auto* pm    = ins->module_inputs().front();
+        auto names  = pm->get_parameter_names();
+        auto inputs = ins->inputs();
+        inputs.pop_back();
+        if(names.size() != inputs.size())
+            return;
+        std::sort(names.begin(), names.end());
+        auto param_input = [&](instruction_ref p) {
+            auto name = any_cast<builtin::param>(p->get_operator()).parameter;
+            auto it   = std::find(names.begin(), names.end(), name);
+            return inputs[std::distance(names.begin(), it)];
+        };
+
+        auto ret = std::prev(pm->end());
+        if(ret->name() != "@return" or ret->inputs().size() != 1)
+            return;
+        auto x = ret->inputs().front();
+        std::string activation;
+        optional<instruction_ref> bias;
+        optional<instruction_ref> scale;
+        float alpha = gemm.alpha;
+        if(x->name() == "relu")
+        {
+            activation = "relu";
+            x          = x->inputs().front();
+        }
+        if(x->name() == "add")
+        {
+            auto args = x->inputs();
+            auto it   = std::find_if(args.begin(), args.end(), [&](auto arg) {
+                return arg->name() == "@param" and param_input(arg) != gemm_ins and
+                       is_bias(param_input(arg), gemm_ins->get_shape());
+            });
+            if(it == args.end())
+                return;
+            bias = param_input(*it);
+            x    = args[it == args.begin() ? 1 : 0];
+        }
+        if(x->name() == "mul")
+        {
+            auto args = x->inputs();
+            auto it   = std::find_if(args.begin(), args.end(), [](auto arg) {
+                return arg->name() == "@literal" and arg->get_shape().elements() == 1;
+            });
+            if(it != args.end())
+            {
+                alpha *= (*it)->get_literal().template at<float>();
+            }
+            else
+            {
+                it = std::find_if(args.begin(), args.end(), [&](auto arg) {
+                    return arg->name() == "@param" and param_input(arg) != gemm_ins and
+                           is_scale(param_input(arg));
+                });
+                if(it == args.end() or not is_fp8_gemm(gemm_ins))
+                    return;
+                scale = param_input(*it);
+            }
+            x = args[it == args.begin() ? 1 : 0];
+        }
+        if(x->name() != "@param" or param_input(x) != gemm_ins)
+            return;
+        // Nothing to fold
+        if(activation.empty() and not bias.has_value() and not scale.has_value() and
+           float_equal(alpha, gemm.alpha))
+            return;
+
+        gemm.alpha      = alpha;
+        gemm.activation = activation;
+        gemm.bias       = bias.has_value();
+        gemm.scale      = scale.has_value();
+        auto new_inputs = gemm_ins->inputs();
+        // Replace the output allocation of the gemm with the one from the pointwise
+        new_inputs.back() = ins->inputs().back();
+        if(bias.has_value())
+            new_inputs.insert(new_inputs.end() - 2, *bias);
+        if(scale.has_value())
+            new_inputs.insert(new_inputs.end() - 2, *scale);
+        m.replace_instruction(ins, gemm, new_inputs);
+    }
+};
+#endif
+
 struct find_contiguous_tranpose_gemm
 {
     auto matcher() const
@@ -831,12 +1200,58 @@ struct find_pointwise_layout_contiguous
     }
 };
 
+// Write the output of a pointwise kernel in the permuted layout that a following
+// transpose+contiguous would produce, so the copy kernel is not needed. The pointwise kernel
+// stores through a transposed view of the allocation, which is tiled through LDS when the fast
+// axis of the output changes.
+struct find_contiguous_transpose_pointwise
+{
+    auto matcher() const
+    {
+        return match::name("gpu::contiguous")(match::arg(0)(
+            match::name("transpose")(
+                match::used_once(),
+                match::arg(0)(precompile_name("pointwise")(match::used_once()).bind("pw")))
+                .bind("transpose")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins       = r.result;
+        auto pw        = r.instructions["pw"];
+        auto transpose = r.instructions["transpose"];
+        if(pw->get_shape().type() == shape::tuple_type)
+            return;
+        auto perm  = transpose->get_operator().to_value()["permutation"].to_vector<int64_t>();
+        auto iperm = invert_permutation(perm);
+
+        auto alloc = m.insert_instruction(
+            pw, make_op("allocate", {{"shape", to_value(ins->get_shape())}}));
+        auto alloc_transpose =
+            m.insert_instruction(pw, make_op("transpose", {{"permutation", iperm}}), alloc);
+
+        auto args   = pw->inputs();
+        args.back() = alloc_transpose;
+
+        auto pw_op_val            = pw->get_operator().to_value();
+        pw_op_val["output_shape"] = to_value(alloc_transpose->get_shape());
+
+        auto new_pw =
+            m.insert_instruction(pw, make_op(pw->name(), pw_op_val), args, pw->module_inputs());
+        m.replace_instruction(ins, transpose->get_operator(), new_pw);
+    }
+};
+
 struct find_layernorm_pointwise
 {
     auto matcher() const
     {
-        return precompile_name("pointwise")(match::any_of[match::inputs()](
-            precompile_name("gpu::prelayernorm", "gpu::preadd_layernorm").bind("layernorm")));
+        return precompile_name("pointwise")(
+            match::any_of[match::inputs()](precompile_name("gpu::prelayernorm",
+                                                           "gpu::preadd_layernorm",
+                                                           "gpu::prerms_norm",
+                                                           "gpu::preadd_rms_norm")
+                                               .bind("layernorm")));
     }
 
     void apply(module& m, const match::matcher_result& r) const
@@ -862,6 +1277,121 @@ struct find_layernorm_pointwise
     }
 };
 
+// Same as find_layernorm_pointwise when the kernel also writes the sum of its inputs, so the
+// pointwise module is applied to the first element of the tuple
+struct find_layernorm_residual_pointwise
+{
+    auto matcher() const
+    {
+        auto layernorm = precompile_name("gpu::preadd_layernorm", "gpu::preadd_rms_norm");
+        auto elem      = match::name("get_tuple_elem")(match::used_once(),
+                                                       match::arg(0)(layernorm.bind("layernorm")));
+        return precompile_name("pointwise")(match::any_of[match::inputs()](elem.bind("elem")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto pw_ins    = r.result;
+        auto elem      = r.instructions["elem"];
+        auto layernorm = r.instructions["layernorm"];
+        if(not layernorm->module_inputs().empty())
+            return;
+        if(elem->get_operator().to_value()["index"].to<std::size_t>() != 0)
+            return;
+        // The sum is selected after the fused kernel so its users have to come after it
+        if(std::any_of(layernorm->outputs().begin(), layernorm->outputs().end(), [&](auto output) {
+               return output != elem and std::find(std::next(pw_ins), m.end(), output) == m.end();
+           }))
+            return;
+        auto* pm       = pw_ins->module_inputs().front();
+        auto pw_inputs = pw_ins->inputs();
+        pw_inputs.erase(std::find(pw_inputs.begin(), pw_inputs.end(), elem));
+        pw_inputs.pop_back();
+        auto inputs = layernorm->inputs();
+        inputs.pop_back();
+        inputs.insert(inputs.end(), pw_inputs.begin(), pw_inputs.end());
+
+        auto sum_shape    = layernorm->get_shape().sub_shapes().at(1);
+        auto output_shape = shape{{pw_ins->get_shape(), sum_shape}};
+        inputs.push_back(
+            m.insert_instruction(pw_ins, make_op("allocate", {{"shape", to_value(output_shape)}})));
+
+        // Ensure the output shape retains the memory layout
+        auto layernorm_op_val            = layernorm->get_operator().to_value();
+        layernorm_op_val["output_shape"] = to_value(output_shape);
+
+        auto fused = m.insert_instruction(
+            pw_ins, make_op(layernorm->name(), layernorm_op_val), inputs, {pm});
+        for(auto output : layernorm->outputs())
+        {
+            if(output == elem)
+                continue;
+            m.replace_instruction(output, output->get_operator(), fused);
+        }
+        m.replace_instruction(pw_ins, make_op("get_tuple_elem", {{"index", 0}}), fused);
+    }
+};
+
+struct find_softmax_pointwise
+{
+    // The softmax result is passed as the first argument to the fused pointwise module
+    auto matcher() const
+    {
+        return precompile_name("pointwise")(
+            match::arg(0)(precompile_name("softmax")(match::used_once()).bind("softmax")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto pw_ins  = r.result;
+        auto softmax = r.instructions["softmax"];
+        if(not softmax->module_inputs().empty())
+            return;
+        if(pw_ins->get_shape().type() == shape::tuple_type)
+            return;
+        auto* pm    = pw_ins->module_inputs().front();
+        auto inputs = softmax->inputs();
+        inputs.pop_back();
+        inputs.insert(inputs.end(), pw_ins->inputs().begin() + 1, pw_ins->inputs().end());
+
+        // Ensure the output shape retains the memory layout
+        auto softmax_op_val            = softmax->get_operator().to_value();
+        softmax_op_val["output_shape"] = to_value(pw_ins->get_shape());
+
+        m.replace_instruction(pw_ins, make_op(softmax->name(), softmax_op_val), inputs, {pm});
+    }
+};
+
+struct find_group_conv_pointwise
+{
+    // The convolution result is passed as the first argument to the fused pointwise module
+    auto matcher() const
+    {
+        return precompile_name("pointwise")(
+            match::arg(0)(precompile_name("gpu::group_conv")(match::used_once()).bind("conv")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto pw_ins = r.result;
+        auto conv   = r.instructions["conv"];
+        if(not conv->module_inputs().empty())
+            return;
+        if(pw_ins->get_shape().type() == shape::tuple_type)
+            return;
+        auto* pm    = pw_ins->module_inputs().front();
+        auto inputs = conv->inputs();
+        inputs.pop_back();
+        inputs.insert(inputs.end(), pw_ins->inputs().begin() + 1, pw_ins->inputs().end());
+
+        // Ensure the output shape retains the memory layout
+        auto conv_op_val            = conv->get_operator().to_value();
+        conv_op_val["output_shape"] = to_value(pw_ins->get_shape());
+
+        m.replace_instruction(pw_ins, make_op(conv->name(), conv_op_val), inputs, {pm});
+    }
+};
+
 struct find_concat_pointwise
 {
     auto matcher() const
@@ -897,7 +1427,10 @@ struct find_concat_pointwise
 
 void fuse_ops::apply(module& m) const
 {
-    match::find_matches(m, find_pointwise_layout_contiguous{}, find_contiguous_layout_pointwise{});
+    match::find_matches(m,
+                        find_pointwise_layout_contiguous{},
+                        find_contiguous_layout_pointwise{},
+                        find_contiguous_transpose_pointwise{});
     run_passes(m, {dead_code_elimination{}});
 #if MIGRAPHX_USE_MIOPEN
     match::find_matches(m, find_conv_pointwise{ctx}, find_conv_bias_relu{ctx}, find_conv_bias{ctx});
@@ -906,8 +1439,14 @@ void fuse_ops::apply(module& m) const
     match::find_matches(m,
 #if MIGRAPHX_USE_ROCBLAS
                         find_gemm_pointwise{},
+#endif
+#if MIGRAPHX_USE_HIPBLASLT
+                        find_hip_gemm_pointwise{},
 #endif
                         find_layernorm_pointwise{},
+                        find_layernorm_residual_pointwise{},
+                        find_softmax_pointwise{},
+                        find_group_conv_pointwise{},
                         find_concat_pointwise{},
                         find_contiguous_tranpose_gemm{},
                         find_commutative_broadcast{});
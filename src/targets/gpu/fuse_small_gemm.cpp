@@ -0,0 +1,181 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/fuse_small_gemm.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/op/pointwise.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/env.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_SMALL_GEMM)
+
+// A dot with optional pointwise modules fused before and after it. When there is a prologue,
+// the first `prologue` inputs are passed to the first module to compute the first input of the
+// dot, otherwise the first input is used directly. This is followed by the second input of the
+// dot and, with an epilogue, the remaining inputs of the last module. The result of the dot is
+// passed as the first parameter of the epilogue.
+struct small_gemm
+{
+    std::size_t prologue = 0;
+    bool epilogue        = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.prologue, "prologue"), f(self.epilogue, "epilogue"));
+    }
+
+    std::string name() const { return "gpu::small_gemm"; }
+
+    std::size_t a_inputs() const { return std::max<std::size_t>(prologue, 1); }
+
+    shape compute_shape(std::vector<shape> inputs, const std::vector<module_ref>& mods) const
+    {
+        check_shapes{inputs, *this}.has_at_least(a_inputs() + 1);
+        if(mods.size() != std::size_t{prologue > 0} + std::size_t{epilogue})
+            MIGRAPHX_THROW("SMALL_GEMM: expected a module for each fused pointwise");
+        auto na = a_inputs();
+        auto a  = inputs.front();
+        if(prologue > 0)
+        {
+            std::vector<shape> pinputs(inputs.begin(), inputs.begin() + na);
+            a = op::pointwise{}.compute_shape(pinputs, {mods.front()});
+        }
+        auto result = make_op("dot").compute_shape({a, inputs[na]});
+        if(not epilogue)
+            return result;
+        inputs.erase(inputs.begin(), inputs.begin() + na + 1);
+        inputs.insert(inputs.begin(), result);
+        return op::pointwise{}.compute_shape(inputs, {mods.back()});
+    }
+
+    argument compute(const shape& output_shape,
+                     std::vector<argument> args,
+                     const std::vector<module_ref>& mods,
+                     const std::function<std::vector<argument>(
+                         module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
+    {
+        auto na = a_inputs();
+        auto a  = args.front();
+        if(prologue > 0)
+        {
+            std::vector<argument> pargs(args.begin(), args.begin() + na);
+            auto ps = op::pointwise{}.compute_shape(to_shapes(pargs), {mods.front()});
+            a       = op::pointwise{}.compute(ps, pargs, {mods.front()}, run);
+        }
+        auto dot       = make_op("dot");
+        auto dot_shape = dot.compute_shape({a.get_shape(), args[na].get_shape()});
+        auto result    = dot.compute(dot_shape, {a, args[na]});
+        if(not epilogue)
+            return result;
+        args.erase(args.begin(), args.begin() + na + 1);
+        args.insert(args.begin(), result);
+        return op::pointwise{}.compute(output_shape, args, {mods.back()}, run);
+    }
+};
+MIGRAPHX_REGISTER_OP(small_gemm);
+
+static bool is_fusable_pointwise(instruction_ref ins)
+{
+    return ins->name() == "pointwise" and ins->get_shape().type() != shape::tuple_type;
+}
+
+void fuse_small_gemm::apply(module_pass_manager& mpm) const
+{
+    if(enabled(MIGRAPHX_DISABLE_SMALL_GEMM{}))
+        return;
+    auto& m = mpm.get_module();
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "dot" or ins->get_shape().dynamic())
+            continue;
+        if(not contains({shape::float_type, shape::half_type}, ins->get_shape().type()))
+            continue;
+        // A constant dot is folded instead
+        if(ins->can_eval())
+            continue;
+        const auto& s  = ins->get_shape();
+        const auto& bs = ins->inputs().back()->get_shape();
+        auto rows      = s.lens()[s.ndim() - 2];
+        if(rows > max_m or bs.lens()[bs.ndim() - 2] * bs.lens().back() > max_nk)
+            continue;
+
+        small_gemm op;
+        std::vector<instruction_ref> inputs;
+        std::vector<module_ref> mods;
+        auto a = ins->inputs().front();
+        if(is_fusable_pointwise(a) and a->outputs().size() == 1)
+        {
+            op.prologue = a->inputs().size();
+            inputs      = a->inputs();
+            mods.push_back(a->module_inputs().front());
+        }
+        else
+        {
+            inputs.push_back(a);
+        }
+        inputs.push_back(ins->inputs().back());
+
+        auto output = ins;
+        if(ins->outputs().size() == 1 and is_fusable_pointwise(ins->outputs().front()))
+        {
+            auto pw = ins->outputs().front();
+            auto it = std::find(pw->inputs().begin(), pw->inputs().end(), ins);
+            if(std::count(pw->inputs().begin(), pw->inputs().end(), ins) == 1)
+            {
+                auto* pm                       = pw->module_inputs().front();
+                auto* em                       = mpm.create_module(pm->name() + ":gemm", *pm);
+                std::vector<std::string> names = em->get_parameter_names();
+                std::sort(names.begin(), names.end());
+                auto gemm_param = em->get_parameter(names[it - pw->inputs().begin()]);
+                // Sorts before the other parameters so the result of the dot is the first one
+                auto param = em->add_parameter("!" + names[it - pw->inputs().begin()],
+                                               gemm_param->get_shape());
+                em->replace_instruction(gemm_param, param);
+                em->remove_instruction(gemm_param);
+                std::copy_if(pw->inputs().begin(),
+                             pw->inputs().end(),
+                             std::back_inserter(inputs),
+                             [&](auto input) { return input != ins; });
+                mods.push_back(em);
+                op.epilogue = true;
+                output      = pw;
+            }
+        }
+        m.replace_instruction(output, op, inputs, mods);
+    }
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -26,9 +26,12 @@
 #include <rocblas/rocblas.h>
 #include <migraphx/gpu/rocblas.hpp>
 #include <migraphx/gpu/gemm_impl.hpp>
+#include <migraphx/gpu/problem_cache.hpp>
 #include <migraphx/reduce_dims.hpp>
+#include <migraphx/shape_for_each.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/time.hpp>
+#include <numeric>
 #include <type_traits>
 
 using microseconds = std::chrono::duration<double, std::micro>;
@@ -59,6 +62,7 @@ rocblas_datatype get_type(shape::type_t type)
     case shape::double_type: return rocblas_datatype_f64_r;
     case shape::float_type: return rocblas_datatype_f32_r;
     case shape::half_type: return rocblas_datatype_f16_r;
+    case shape::bf16_type: return rocblas_datatype_bf16_r;
     case shape::int8_type: return rocblas_datatype_i8_r;
     case shape::uint8_type: return rocblas_datatype_u8_r;
     case shape::int32_type: return rocblas_datatype_i32_r;
@@ -85,14 +89,46 @@ void blas_shape(const shape& s)
         MIGRAPHX_THROW("GPU_GEMM: needs to have one matrix stride as 1");
     if(std::any_of(s.strides().end() - 2, s.strides().end(), [](auto i) { return i == 0; }))
         MIGRAPHX_THROW("GPU_GEMM: matrix dimensions can't be broadcasted");
-    if(s.lens().size() < 3)
-        return;
+    // Batch dimensions that don't collapse are run as separate gemms, see split_batch
+}
+
+static bool is_batch_collapsible(const shape& s, std::size_t start)
+{
+    // A single batch dimension always has one stride
+    if(s.lens().size() < start + 4)
+        return true;
     shape batch_shape{s.type(),
-                      {s.lens().begin(), s.lens().end() - 2},
-                      {s.strides().begin(), s.strides().end() - 2}};
-    auto batch_shapes = reduce_dims({batch_shape});
-    if(batch_shapes.front().lens().size() != 1)
-        MIGRAPHX_THROW("GPU_GEMM: Batch dimension is not collapsible");
+                      {s.lens().begin() + start, s.lens().end() - 2},
+                      {s.strides().begin() + start, s.strides().end() - 2}};
+    return reduce_dims({batch_shape}).front().lens().size() == 1;
+}
+
+// Returns how many leading batch dimensions have to be looped over so the remaining batch
+// dimensions collapse into the single stride of a strided batched gemm in every argument. This
+// lets the gemm read transposed batches, such as the heads of attention, without a copy.
+static std::size_t split_batch(const std::vector<shape>& shapes)
+{
+    std::size_t nouter = 0;
+    while(std::any_of(shapes.begin(), shapes.end(), [&](const shape& s) {
+        return not is_batch_collapsible(s, nouter);
+    }))
+        nouter++;
+    return nouter;
+}
+
+static shape remove_outer_batch(const shape& s, std::size_t nouter)
+{
+    return {s.type(),
+            {s.lens().begin() + nouter, s.lens().end()},
+            {s.strides().begin() + nouter, s.strides().end()}};
+}
+
+static std::vector<shape> remove_outer_batch(std::vector<shape> shapes, std::size_t nouter)
+{
+    std::transform(shapes.begin(), shapes.end(), shapes.begin(), [&](const shape& s) {
+        return remove_outer_batch(s, nouter);
+    });
+    return shapes;
 }
 
 shape transpose_batch(const shape& s, unsigned trans_batch)
@@ -113,13 +149,16 @@ shape transpose_batch(const shape& s, unsigned trans_batch)
  * or rocblas_status_invalid_value.  Caller
  * is expected to check for invalid index.  Any other result causes an exception.
  *
+ * The size statuses are only returned while the handle is in device memory size query mode.
+ *
  */
 template <class F, class Pack, class... Ts>
 auto rocblas_invoke(F f, Pack p, Ts... xs)
 {
     return p([=](auto... ws) {
         auto status = f(ws..., xs...);
-        if(status != rocblas_status_success and status != rocblas_status_invalid_value)
+        if(status != rocblas_status_success and status != rocblas_status_invalid_value and
+           status != rocblas_status_size_increased and status != rocblas_status_size_unchanged)
         {
             if(status == rocblas_status_perf_degraded)
             {
@@ -189,7 +228,8 @@ struct gemm_impl
         output_shape.visit_type([&](auto as) {
             auto alpha_r = as(alpha);
             auto beta_r  = as(beta);
-            if(compute_fp32)
+            // rocBLAS only computes bf16 in fp32, so the coefficients must be float as well
+            if(compute_fp32 or output_shape.type() == shape::bf16_type)
             {
                 get_alpha = [=] { return &alpha; };
                 get_beta  = [=] { return &beta; };
@@ -224,6 +264,10 @@ struct gemm_impl
             if(arg_type == rocblas_datatype_f16_r)
                 compute_type = rocblas_datatype_f32_r;
         }
+        if(arg_type == rocblas_datatype_bf16_r)
+        {
+            compute_type = rocblas_datatype_f32_r;
+        }
         if(arg_type == rocblas_datatype_f8_r)
         {
             assert(get_type(input_shapes[1].type()) == rocblas_datatype_f8_r);
@@ -308,6 +352,22 @@ struct gemm_impl
         }
     }
 
+    /**
+     * Returns the workspace rocBLAS needs to run the solution. The handle is put in device memory
+     * size query mode, so nothing is launched and the arguments are not read.
+     */
+    std::size_t workspace_size(context& ctx,
+                               const std::vector<argument>& input_args,
+                               int32_t solution_idx = 0) const
+    {
+        auto* handle = ctx.get_stream().get_rocblas();
+        rocblas_start_device_memory_size_query(handle);
+        run(ctx, input_args, solution_idx);
+        std::size_t size = 0;
+        rocblas_stop_device_memory_size_query(handle, &size);
+        return size;
+    }
+
 #ifdef MIGRAPHX_USE_ROCBLAS_TUNING_API
     auto validate(context& ctx, const std::vector<shape>& input_shapes, int32_t solution_idx) const
     {
@@ -334,6 +394,40 @@ struct gemm_impl
      */
     int32_t
     validate(context& ctx, const std::vector<argument>& input_args, int32_t solution_idx) const
+    {
+        if(not is_valid(ctx, input_args, solution_idx))
+        {
+            std::cerr << "WARNING:  tuned solution is invalid; reverting to default" << std::endl;
+            return 0;
+        }
+        return solution_idx;
+    }
+
+    /**
+     * Checks a solution tuned for another problem, which must be valid for this gemm and fit in
+     * max_workspace bytes.
+     *
+     * @return Returns either solution_idx if it can be used, or else the default value 0.
+     */
+    int32_t borrow(context& ctx,
+                   const std::vector<shape>& input_shapes,
+                   int32_t solution_idx,
+                   std::size_t max_workspace) const
+    {
+        // Checking the solution doesn't read the buffers, so they are left uninitialized
+        std::vector<argument> input_args;
+        std::transform(input_shapes.begin(),
+                       input_shapes.end(),
+                       std::back_inserter(input_args),
+                       [&](const shape& x) { return allocate_gpu(x); });
+        if(not is_valid(ctx, input_args, solution_idx))
+            return 0;
+        if(workspace_size(ctx, input_args, solution_idx) > max_workspace)
+            return 0;
+        return solution_idx;
+    }
+
+    bool is_valid(context& ctx, const std::vector<argument>& input_args, int32_t solution_idx) const
     {
         rocblas_status_ check_valid(rocblas_status_success);
 
@@ -355,13 +449,7 @@ struct gemm_impl
                                          solution_idx,
                                          rocblas_gemm_flags_check_solution_index);
         }
-
-        if(check_valid == rocblas_status_invalid_value)
-        {
-            std::cerr << "WARNING:  tuned solution is invalid; reverting to default" << std::endl;
-            return 0;
-        }
-        return solution_idx;
+        return check_valid != rocblas_status_invalid_value;
     }
 #endif
 
@@ -446,9 +534,9 @@ struct gemm_impl
 #ifdef MIGRAPHX_USE_ROCBLAS_TUNING_API
     /**
      * Find best rocBLAS solution:  Get list of solutions and try them all, returning the index
-     * of the fastest one.
+     * of the fastest one. Solutions that need more than max_workspace bytes are skipped.
      */
-    int tune(context& ctx, const std::vector<shape>& input_shapes) const
+    int tune(context& ctx, const std::vector<shape>& input_shapes, std::size_t max_workspace) const
     {
         // tuning meta parameters
         const int hot_calls = 40;
@@ -520,6 +608,8 @@ struct gemm_impl
         rocblas_int best_sol = 0;
         for(auto sol : solution_indices)
         {
+            if(workspace_size(ctx, input_args, sol) > max_workspace)
+                continue;
             // Warmup: the first call to an op. may not be representative since there is
             // more time taken initializing caches, etc. so we won't time it.
             run(ctx, input_args, sol);
@@ -577,42 +667,114 @@ struct gemm_impl
     bool compute_fp32             = true;
 }; // gemm_impl
 
+// The workspace is passed just before the output, but rocBLAS takes it from the handle
+template <class T>
+static std::vector<T> remove_workspace(std::vector<T> xs)
+{
+    xs.erase(xs.end() - 2);
+    return xs;
+}
+
+// Points the rocBLAS handle at the workspace planned with the rest of the scratch memory, and
+// gives the handle back its own memory afterwards
+struct rocblas_workspace
+{
+    rocblas_workspace(context& ctx, const argument& ws) : handle(ctx.get_stream().get_rocblas())
+    {
+        if(ws.get_shape().bytes() == 0)
+            return;
+        rocblas_set_workspace(handle, ws.data(), ws.get_shape().bytes());
+        set = true;
+    }
+
+    rocblas_workspace(const rocblas_workspace&)            = delete;
+    rocblas_workspace& operator=(const rocblas_workspace&) = delete;
+
+    ~rocblas_workspace()
+    {
+        if(set)
+            rocblas_set_workspace(handle, nullptr, 0);
+    }
+
+    rocblas_handle handle;
+    bool set = false;
+};
+
+template <class T>
+static void gemm_compute_impl(context& ctx,
+                              const std::vector<argument>& all_args,
+                              T alpha,
+                              T beta,
+                              bool compute_fp32,
+                              int32_t solution_idx)
+{
+    rocblas_workspace ws{ctx, all_args[all_args.size() - 2]};
+    auto args         = remove_workspace(all_args);
+    auto input_shapes = to_shapes(args);
+    auto nouter       = split_batch(input_shapes);
+    auto inner_shapes = remove_outer_batch(input_shapes, nouter);
+    auto gemm_item    = gemm_impl<T>(inner_shapes.back(), inner_shapes, alpha, beta, compute_fp32);
+    if(nouter == 0)
+    {
+        gemm_item.run(ctx, args, solution_idx);
+        return;
+    }
+    const auto& out_lens = input_shapes.back().lens();
+    std::vector<std::size_t> outer_lens(out_lens.begin(), out_lens.begin() + nouter);
+    shape outer_shape{shape::float_type, outer_lens};
+    std::vector<argument> inner_args(args.size());
+    shape_for_each(outer_shape, [&](const auto& idx) {
+        for(std::size_t i = 0; i < args.size(); i++)
+        {
+            const auto& strides = input_shapes[i].strides();
+            auto offset =
+                std::inner_product(idx.begin(), idx.end(), strides.begin(), std::size_t{0});
+            inner_args[i] = argument{inner_shapes[i],
+                                     args[i].data() + offset * input_shapes[i].type_size()};
+        }
+        gemm_item.run(ctx, inner_args, solution_idx);
+    });
+}
+
 void gemm_compute(context& ctx,
-                  const shape& output_shape,
+                  const shape&,
                   const std::vector<argument>& args,
                   float alpha,
                   float beta,
                   bool compute_fp32,
                   int32_t solution_idx)
 {
-    std::vector<shape> input_shapes;
-    std::transform(args.begin(),
-                   args.end(),
-                   std::back_inserter(input_shapes),
-                   [](const argument& x) { return x.get_shape(); });
-    auto gemm_item = gemm_impl<float>(output_shape, input_shapes, alpha, beta, compute_fp32);
-    gemm_item.run(ctx, args, solution_idx);
+    gemm_compute_impl(ctx, args, alpha, beta, compute_fp32, solution_idx);
 }
 
 void gemm_compute(context& ctx,
-                  const shape& output_shape,
+                  const shape&,
                   const std::vector<argument>& args,
                   int32_t alpha,
                   int32_t beta,
                   bool compute_fp32,
                   int32_t solution_idx)
 {
-    std::vector<shape> input_shapes;
-    std::transform(args.begin(),
-                   args.end(),
-                   std::back_inserter(input_shapes),
-                   [](const argument& x) { return x.get_shape(); });
-    auto gemm_item = gemm_impl<int32_t>(output_shape, input_shapes, alpha, beta, compute_fp32);
-    gemm_item.run(ctx, args, solution_idx);
+    gemm_compute_impl(ctx, args, alpha, beta, compute_fp32, solution_idx);
 }
 
+std::size_t
+gemm_workspace_size(context& ctx, const std::vector<shape>& input_shapes, bool compute_fp32)
+{
+    auto inner_shapes = remove_outer_batch(input_shapes, split_batch(input_shapes));
+    std::vector<argument> args;
+    std::transform(inner_shapes.begin(),
+                   inner_shapes.end(),
+                   std::back_inserter(args),
+                   [](const shape& x) { return argument{x, nullptr}; });
+    auto gemm_item = gemm_impl<float>(inner_shapes.back(), inner_shapes, 1, 0, compute_fp32);
+    return gemm_item.workspace_size(ctx, args);
+}
+
+// The workspace is not part of the problem, so tuned solutions are found for any workspace
 static value gemm_problem(const shape& output_shape, std::vector<shape> input_shapes)
 {
+    input_shapes = remove_workspace(input_shapes);
     input_shapes.push_back(output_shape);
     return to_value(input_shapes);
 }
@@ -638,6 +800,56 @@ int32_t gemm_default_solution(context& ctx,
     return 0;
 }
 
+template <class T>
+int32_t gemm_nearest_solution_impl(context& ctx,
+                                   const shape& output_shape,
+                                   const std::vector<shape>& input_shapes,
+                                   T alpha,
+                                   T beta,
+                                   bool compute_fp32)
+{
+#ifdef MIGRAPHX_USE_ROCBLAS_TUNING_API
+    auto problem = remove_workspace(input_shapes);
+    problem.push_back(output_shape);
+    auto sol = ctx.get_problem_cache().nearest("rocblas", [&](const value& v) {
+        return shapes_distance(problem, from_value<std::vector<shape>>(v));
+    });
+    if(not sol.has_value())
+        return 0;
+    auto max_workspace = input_shapes[input_shapes.size() - 2].bytes();
+    auto gemm_shapes   = remove_workspace(input_shapes);
+    auto inner_shapes  = remove_outer_batch(gemm_shapes, split_batch(gemm_shapes));
+    auto gemm_item     = gemm_impl<T>(inner_shapes.back(), inner_shapes, alpha, beta, compute_fp32);
+    return gemm_item.borrow(ctx, inner_shapes, sol->to<int32_t>(), max_workspace);
+#else
+    (void)ctx, (void)output_shape, (void)input_shapes;
+    (void)alpha, (void)beta, (void)compute_fp32;
+    return 0;
+#endif
+}
+
+int32_t gemm_nearest_solution(context& ctx,
+                              const shape& output_shape,
+                              const std::vector<shape>& input_shapes,
+                              float alpha,
+                              float beta,
+                              bool compute_fp32)
+{
+    return gemm_nearest_solution_impl(
+        ctx, output_shape, input_shapes, alpha, beta, compute_fp32);
+}
+
+int32_t gemm_nearest_solution(context& ctx,
+                              const shape& output_shape,
+                              const std::vector<shape>& input_shapes,
+                              int32_t alpha,
+                              int32_t beta,
+                              bool compute_fp32)
+{
+    return gemm_nearest_solution_impl(
+        ctx, output_shape, input_shapes, alpha, beta, compute_fp32);
+}
+
 /**
  * Decides if the tune() or validate() method is appropriate and calls it.
  * Return value is the chosen solution index, or 0 to let picker choose it.
@@ -656,18 +868,23 @@ int32_t gemm_finalize_impl(context& ctx,
     // This code should be called only if either the environment var.
     // MIGRAPHX_ENABLE_GEMM_TUNING, or option --exhaustive-tune, is set
 
+    // Solutions are limited to the workspace that was planned for the gemm
+    auto max_workspace = input_shapes[input_shapes.size() - 2].bytes();
+    auto gemm_shapes   = remove_workspace(input_shapes);
+
+    // Gemms with outer batch dimensions are tuned on the gemm run for each of them
+    auto inner_shapes = remove_outer_batch(gemm_shapes, split_batch(gemm_shapes));
+    auto gemm_item    = gemm_impl<T>(inner_shapes.back(), inner_shapes, alpha, beta, compute_fp32);
     if(solution_idx == 0)
     {
-        auto gemm_item = gemm_impl<T>(output_shape, input_shapes, alpha, beta, compute_fp32);
-        solution_idx   = gemm_item.tune(ctx, input_shapes);
+        solution_idx = gemm_item.tune(ctx, inner_shapes, max_workspace);
         gemm_save_solution(ctx, output_shape, input_shapes, solution_idx);
     }
     else
     {
         // If a tuned solution index is already given, don't tune again but validate
         // in case the data was tuned with a different rocBLAS version
-        auto gemm_item = gemm_impl<T>(output_shape, input_shapes, alpha, beta, compute_fp32);
-        solution_idx   = gemm_item.validate(ctx, input_shapes, solution_idx);
+        solution_idx = gemm_item.validate(ctx, inner_shapes, solution_idx);
     }
 #else
     (void)ctx, (void)output_shape, (void)input_shapes;
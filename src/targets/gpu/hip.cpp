@@ -24,28 +24,60 @@
 
 #include <migraphx/gpu/hip.hpp>
 #include <migraphx/manage_ptr.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/gpu/context.hpp>
-#include <migraphx/gpu/device/contiguous.hpp>
+#include <migraphx/gpu/device_name.hpp>
+#include <migraphx/gpu/code_object_op.hpp>
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/device/generate.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/digest.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/optional.hpp>
 #if MIGRAPHX_USE_MIOPEN
 #include <miopen/miopen.h>
 #endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <random>
+#include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 MIGRAPHX_REGISTER_OP(hip_allocate)
 MIGRAPHX_REGISTER_OP(hip_fill)
+MIGRAPHX_REGISTER_OP(hip_random_seed)
 MIGRAPHX_REGISTER_OP(hip_sync_stream)
 MIGRAPHX_REGISTER_OP(hip_copy_to_gpu)
 MIGRAPHX_REGISTER_OP(hip_copy_from_gpu)
 MIGRAPHX_REGISTER_OP(hip_copy)
+MIGRAPHX_REGISTER_OP(hip_pad_copy)
 MIGRAPHX_REGISTER_OP(hip_allocate_memory)
 MIGRAPHX_REGISTER_OP(hip_copy_literal)
+MIGRAPHX_REGISTER_OP(hip_stream_literal)
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_GPU_MEMORY_POOL)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_IPC_LITERALS)
 
 using hip_ptr      = MIGRAPHX_MANAGE_PTR(void, hipFree);
 using hip_host_ptr = MIGRAPHX_MANAGE_PTR(void, hipHostUnregister);
@@ -61,6 +93,15 @@ bool is_device_ptr(const void* ptr)
     return attr.type == hipMemoryTypeDevice;
 }
 
+bool is_pinned_ptr(const void* ptr)
+{
+    hipPointerAttribute_t attr;
+    auto status = hipPointerGetAttributes(&attr, ptr);
+    if(status != hipSuccess)
+        return false;
+    return attr.type == hipMemoryTypeHost;
+}
+
 std::size_t get_available_gpu_memory()
 {
     size_t free;
@@ -106,21 +147,220 @@ static host_ptr_cache& get_host_ptr_cache()
     return cache;
 }
 
-std::shared_ptr<void> allocate_gpu(std::size_t sz, bool host = false)
+static void count_hip_malloc(std::size_t n)
 {
-    if(sz > get_available_gpu_memory())
-        MIGRAPHX_THROW("Memory not available to allocate buffer: " + std::to_string(sz));
-    void* alloc_ptr = nullptr;
-    auto status     = host ? hipHostMalloc(&alloc_ptr, sz) : hipMalloc(&alloc_ptr, sz);
-    if(status != hipSuccess)
+    static auto& calls = get_metric_counter("hip_malloc");
+    static auto& bytes = get_metric_counter("hip_malloc_bytes");
+    calls.add();
+    bytes.add(n);
+}
+
+// Caches the device and pinned host memory that is released, so dynamic shapes
+// don't go through the hip allocator on every run. Blocks are rounded up to a
+// size class and reused for requests up to twice smaller. Kernels that are
+// still queued may use a block after it is released, so released blocks are
+// only handed out again once the device has been synchronized. That is done
+// once for all the blocks released since the last time, when a request
+// misses the cache. The lock isn't held while synchronizing, so other threads
+// can keep allocating and releasing blocks. There is a pool for each device,
+// and one pinned host pool shared by all of them, which synchronizes every
+// device since any of them may still be using its blocks. The cached blocks
+// can be given back to hip with trim_memory_pools.
+struct memory_pool : std::enable_shared_from_this<memory_pool>
+{
+    static constexpr std::size_t small_size  = 1024u * 1024u;
+    static constexpr std::size_t small_align = 512;
+    static constexpr std::size_t large_align = 2u * 1024u * 1024u;
+
+    explicit memory_pool(bool h) : host(h) {}
+
+    memory_pool(const memory_pool&)            = delete;
+    memory_pool& operator=(const memory_pool&) = delete;
+
+    ~memory_pool()
     {
+        for(auto&& p : free_blocks)
+            free_block(p.second);
+        for(auto&& p : pending)
+            free_block(p.second);
+    }
+
+    static std::size_t round_size(std::size_t sz)
+    {
+        auto align = sz < small_size ? small_align : large_align;
+        return std::max<std::size_t>(1, (sz + align - 1) / align) * align;
+    }
+
+    std::shared_ptr<void> allocate(std::size_t sz)
+    {
+        auto n   = round_size(sz);
+        auto ptr = take(n);
+        if(ptr.first == nullptr)
+            ptr = {malloc_block(n), n};
+        if(ptr.first == nullptr)
+            return nullptr;
+        auto self = shared_from_this();
+        return {ptr.first, [self, n = ptr.second](void* p) { self->release(p, n); }};
+    }
+
+    // Gives the cached memory back to hip
+    void trim()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        synchronize(lock);
+        auto blocks = std::move(free_blocks);
+        free_blocks.clear();
+        lock.unlock();
+        for(auto&& p : blocks)
+            free_block(p.second);
+    }
+
+    private:
+    bool host;
+    std::mutex m;
+    std::multimap<std::size_t, void*> free_blocks;
+    std::vector<std::pair<std::size_t, void*>> pending;
+
+    void release(void* p, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        pending.emplace_back(n, p);
+    }
+
+    void synchronize(std::unique_lock<std::mutex>& lock)
+    {
+        if(pending.empty())
+            return;
+        auto blocks = std::move(pending);
+        pending.clear();
+        lock.unlock();
         if(host)
-            MIGRAPHX_THROW("Gpu allocation failed: " + hip_error(status));
+            sync_all_devices();
         else
-            return allocate_gpu(sz, true);
+            gpu_sync();
+        lock.lock();
+        free_blocks.insert(blocks.begin(), blocks.end());
     }
-    assert(alloc_ptr != nullptr);
-    std::shared_ptr<void> result = share(hip_ptr{alloc_ptr});
+
+    static void sync_all_devices()
+    {
+        int n       = 0;
+        auto status = hipGetDeviceCount(&n);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed getting device count: " + hip_error(status));
+        device_guard guard;
+        for(int device = 0; device < n; device++)
+        {
+            status = hipSetDevice(device);
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Error setting device: " + hip_error(status));
+            gpu_sync();
+        }
+    }
+
+    std::pair<void*, std::size_t> take(std::size_t n)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        auto fit = [&] {
+            auto it = free_blocks.lower_bound(n);
+            if(it != free_blocks.end() and it->first < 2 * n)
+                return it;
+            return free_blocks.end();
+        };
+        auto it = fit();
+        if(it == free_blocks.end())
+        {
+            synchronize(lock);
+            it = fit();
+        }
+        if(it == free_blocks.end())
+            return {nullptr, 0};
+        auto result = std::make_pair(it->second, it->first);
+        free_blocks.erase(it);
+        return result;
+    }
+
+    void free_block(void* p) const
+    {
+        if(host)
+            (void)hipHostFree(p);
+        else
+            (void)hipFree(p);
+    }
+
+    void* malloc_block(std::size_t n)
+    {
+        if(n > get_available_gpu_memory())
+            trim();
+        if(n > get_available_gpu_memory())
+            MIGRAPHX_THROW("Memory not available to allocate buffer: " + std::to_string(n));
+        void* result = nullptr;
+        count_hip_malloc(n);
+        auto status = host ? hipHostMalloc(&result, n) : hipMalloc(&result, n);
+        if(status == hipSuccess)
+            return result;
+        trim();
+        count_hip_malloc(n);
+        status = host ? hipHostMalloc(&result, n) : hipMalloc(&result, n);
+        if(status == hipSuccess)
+            return result;
+        if(host)
+            MIGRAPHX_THROW("Gpu allocation failed: " + hip_error(status));
+        return nullptr;
+    }
+};
+
+static std::shared_ptr<memory_pool> get_memory_pool(bool host, bool create = true)
+{
+    static std::mutex m;
+    static std::unordered_map<int, std::shared_ptr<memory_pool>> pools;
+    // Pinned host memory is shared by all the devices
+    int id = host ? -1 : get_device_id();
+    std::lock_guard<std::mutex> lock(m);
+    auto& pool = pools[id];
+    if(pool == nullptr and create)
+        pool = std::make_shared<memory_pool>(host);
+    return pool;
+}
+
+void trim_memory_pools()
+{
+    for(bool host : {false, true})
+    {
+        auto pool = get_memory_pool(host, false);
+        if(pool != nullptr)
+            pool->trim();
+    }
+}
+
+std::shared_ptr<void> allocate_gpu(std::size_t sz, bool host = false)
+{
+    if(enabled(MIGRAPHX_DISABLE_GPU_MEMORY_POOL{}))
+    {
+        if(sz > get_available_gpu_memory())
+            MIGRAPHX_THROW("Memory not available to allocate buffer: " + std::to_string(sz));
+        void* alloc_ptr = nullptr;
+        count_hip_malloc(sz);
+        auto status = host ? hipHostMalloc(&alloc_ptr, sz) : hipMalloc(&alloc_ptr, sz);
+        if(status != hipSuccess)
+        {
+            if(host)
+                MIGRAPHX_THROW("Gpu allocation failed: " + hip_error(status));
+            else
+                return allocate_gpu(sz, true);
+        }
+        assert(alloc_ptr != nullptr);
+        std::shared_ptr<void> result = share(hip_ptr{alloc_ptr});
+        if(host)
+        {
+            get_host_ptr_cache().put(result);
+        }
+        return result;
+    }
+    auto result = get_memory_pool(host)->allocate(sz);
+    // Fall back to host memory when the device is out of memory
+    if(result == nullptr)
+        return allocate_gpu(sz, true);
     if(host)
     {
         get_host_ptr_cache().put(result);
@@ -186,6 +426,8 @@ argument allocate_gpu(const shape& s, bool host)
     return {s, [p]() mutable { return reinterpret_cast<char*>(p.get()); }};
 }
 
+argument allocate_pinned(const shape& s) { return allocate_gpu(s, true); }
+
 argument register_on_gpu(const argument& arg)
 {
     auto arg_shared = arg.share();
@@ -240,6 +482,8 @@ void set_device(std::size_t id)
         MIGRAPHX_THROW("Error setting device");
 }
 
+void set_device(context& ctx) { ctx.get_stream().setup(); }
+
 void gpu_sync()
 {
     auto status = hipDeviceSynchronize();
@@ -268,10 +512,43 @@ void hip_async_copy(context& ctx, const argument& src, const argument& dst, hipM
         MIGRAPHX_THROW("Gpu copy failed: " + hip_error(status));
 }
 
+// Copies use the jit contiguous kernel, which is compiled once for each pair of shapes on a
+// device. The ops that copy compile it when they are finalized, so it is only compiled here for
+// dynamic shapes.
+static code_object_op get_copy_kernel(context& ctx, const shape& src, const shape& dst)
+{
+    static std::mutex m;
+    static std::unordered_map<std::string, code_object_op> kernels;
+    auto key = std::to_string(ctx.get_current_device().get_device_id()) + ":" + to_string(src) +
+               ":" + to_string(dst);
+    std::lock_guard<std::mutex> lock(m);
+    auto it = kernels.find(key);
+    if(it == kernels.end())
+    {
+        auto op = any_cast<code_object_op>(
+            compile_op("contiguous",
+                       ctx,
+                       {src, dst},
+                       {{"lambda", "[](auto x) { return make_tuple(x); }"},
+                        {"kernel", "contiguous_kernel"}}));
+        op.finalize(ctx, dst, {src, dst});
+        it = kernels.emplace(key, op).first;
+    }
+    return it->second;
+}
+
+void compile_copy(context& ctx, const shape& src, const shape& dst)
+{
+    if(src.dynamic() or dst.dynamic())
+        return;
+    get_copy_kernel(ctx, src, dst);
+}
+
 void gpu_copy(context& ctx, const argument& src, const argument& dst)
 {
     // Workaround: Use contiguous as hip's memcpy is broken
-    device::contiguous(ctx.get_stream().get(), dst, src);
+    get_copy_kernel(ctx, src.get_shape(), dst.get_shape())
+        .compute(ctx, dst.get_shape(), {src, dst});
     // hip_async_copy(ctx, src, dst, hipMemcpyDeviceToDevice);
 }
 
@@ -299,18 +576,715 @@ void copy_from_gpu(context& ctx, const argument& src, const argument& dst)
     }
 }
 
+using hip_pinned_ptr     = MIGRAPHX_MANAGE_PTR(void, hipHostFree);
+using hip_sync_event_ptr = MIGRAPHX_MANAGE_PTR(hipEvent_t, hipEventDestroy);
+using hip_stream_ptr     = hip_device::stream::hip_stream_ptr;
+
+// Copies literals to the gpu on a dedicated stream through a ring of pinned
+// staging buffers, so the host copy into one buffer overlaps the transfer of
+// the others. Small literals are packed into shared device allocations and
+// transferred together in one copy.
+struct literal_uploader
+{
+    // Size of each staging buffer and of the allocations small literals are
+    // packed into
+    static constexpr std::size_t chunk_size = 4u * 1024u * 1024u;
+    static constexpr std::size_t small_size = 64u * 1024u;
+    static constexpr std::size_t alignment  = 256;
+    static constexpr std::size_t nslots     = 4;
+
+    struct slot
+    {
+        std::shared_ptr<void> buffer     = nullptr;
+        shared<hip_sync_event_ptr> event = nullptr;
+        bool recorded                    = false;
+    };
+
+    // A run of small literals which are contiguous on the device
+    struct batch
+    {
+        std::size_t slot_index = 0;
+        char* device_start     = nullptr;
+        std::size_t nbytes     = 0;
+    };
+
+    std::mutex m;
+    std::atomic<bool> pending{false};
+    shared<hip_stream_ptr> stream = nullptr;
+    std::vector<slot> slots;
+    std::size_t next_slot         = 0;
+    std::shared_ptr<void> arena   = nullptr;
+    std::size_t arena_offset      = 0;
+    optional<batch> current_batch = nullopt;
+
+    explicit literal_uploader(std::size_t device_id)
+    {
+        set_device(device_id);
+        hipStream_t result = nullptr;
+        auto status        = hipStreamCreateWithFlags(&result, hipStreamNonBlocking);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to create upload stream: " + hip_error(status));
+        stream = share(hip_stream_ptr{result});
+    }
+
+    // Waits for the slot's previous transfer before it is reused
+    std::size_t acquire_slot()
+    {
+        if(slots.empty())
+            slots.resize(nslots);
+        auto i    = next_slot;
+        next_slot = (next_slot + 1) % slots.size();
+        auto& sl  = slots[i];
+        if(sl.buffer == nullptr)
+        {
+            void* ptr   = nullptr;
+            auto status = hipHostMalloc(&ptr, chunk_size);
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Failed to allocate staging buffer: " + hip_error(status));
+            sl.buffer        = share(hip_pinned_ptr{ptr});
+            hipEvent_t event = nullptr;
+            status           = hipEventCreateWithFlags(&event, hipEventDisableTiming);
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Failed to create event: " + hip_error(status));
+            sl.event = share(hip_sync_event_ptr{event});
+        }
+        if(sl.recorded)
+        {
+            auto status = hipEventSynchronize(sl.event.get());
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Failed to wait for upload: " + hip_error(status));
+            sl.recorded = false;
+        }
+        return i;
+    }
+
+    char* staging(std::size_t i) const { return static_cast<char*>(slots[i].buffer.get()); }
+
+    void transfer(std::size_t i, char* dst, std::size_t nbytes)
+    {
+        auto status = hipMemcpyAsync(dst, staging(i), nbytes, hipMemcpyHostToDevice, stream.get());
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Copy to gpu failed: " + hip_error(status));
+        status = hipEventRecord(slots[i].event.get(), stream.get());
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to record upload: " + hip_error(status));
+        slots[i].recorded = true;
+    }
+
+    void flush()
+    {
+        if(not current_batch.has_value())
+            return;
+        transfer(current_batch->slot_index, current_batch->device_start, current_batch->nbytes);
+        current_batch = nullopt;
+    }
+
+    char* allocate_small(std::size_t nbytes)
+    {
+        auto offset = (arena_offset + alignment - 1) / alignment * alignment;
+        if(arena == nullptr or offset + nbytes > chunk_size)
+        {
+            flush();
+            arena  = allocate_gpu(chunk_size);
+            offset = 0;
+        }
+        arena_offset = offset + nbytes;
+        return static_cast<char*>(arena.get()) + offset;
+    }
+
+    void copy_small(const char* src, char* dst, std::size_t nbytes)
+    {
+        // The padding between literals is copied as well to keep the batch
+        // as a single transfer
+        if(not current_batch.has_value() or
+           std::size_t(dst + nbytes - current_batch->device_start) > chunk_size)
+        {
+            flush();
+            current_batch = batch{acquire_slot(), dst, 0};
+        }
+        auto offset = dst - current_batch->device_start;
+        std::copy(src, src + nbytes, staging(current_batch->slot_index) + offset);
+        current_batch->nbytes = offset + nbytes;
+    }
+
+    void copy_large(const char* src, char* dst, std::size_t nbytes)
+    {
+        flush();
+        for(std::size_t pos = 0; pos < nbytes; pos += chunk_size)
+        {
+            auto n = std::min(chunk_size, nbytes - pos);
+            auto i = acquire_slot();
+            std::copy(src + pos, src + pos + n, staging(i));
+            transfer(i, dst + pos, n);
+        }
+    }
+
+    std::shared_ptr<char> upload(const literal& l)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto nbytes = l.get_shape().bytes();
+        std::shared_ptr<void> owner;
+        char* dst = nullptr;
+        if(nbytes <= small_size)
+        {
+            dst   = allocate_small(nbytes);
+            owner = arena;
+            copy_small(l.data(), dst, nbytes);
+        }
+        else
+        {
+            owner = allocate_gpu(nbytes);
+            dst   = static_cast<char*>(owner.get());
+            copy_large(l.data(), dst, nbytes);
+        }
+        pending = true;
+        return {owner, dst};
+    }
+
+    void wait()
+    {
+        if(not pending)
+            return;
+        std::lock_guard<std::mutex> lock(m);
+        if(not pending)
+            return;
+        flush();
+        auto status = hipStreamSynchronize(stream.get());
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to wait for upload: " + hip_error(status));
+        // Release the pinned staging memory once everything is uploaded
+        slots.clear();
+        next_slot = 0;
+        pending   = false;
+    }
+};
+
+// A shared lock on a record file, held by the process that published the record for as long as
+// its buffer is alive. The system releases the lock when the process exits, so a record that
+// isn't locked is stale even when its process id was reused. The record is removed before the
+// lock is released, unless another process replaced it.
+struct ipc_lease
+{
+#ifndef _WIN32
+    int fd = -1;
+#endif
+    fs::path file;
+
+    ipc_lease()                            = default;
+    ipc_lease(const ipc_lease&)            = delete;
+    ipc_lease& operator=(const ipc_lease&) = delete;
+
+    static std::unique_ptr<ipc_lease> acquire(const fs::path& p)
+    {
+#ifndef _WIN32
+        auto lease  = std::make_unique<ipc_lease>();
+        lease->file = p;
+        lease->fd   = open(p.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT
+        if(lease->fd < 0 or flock(lease->fd, LOCK_SH | LOCK_NB) != 0)
+            return nullptr;
+        return lease;
+#else
+        (void)p;
+        return nullptr;
+#endif
+    }
+
+    // Whether any process still holds a lease on the record
+    static bool is_held(const fs::path& p)
+    {
+#ifndef _WIN32
+        int fd = open(p.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT
+        if(fd < 0)
+            return false;
+        bool held = flock(fd, LOCK_EX | LOCK_NB) != 0 and errno == EWOULDBLOCK;
+        close(fd);
+        return held;
+#else
+        (void)p;
+        return false;
+#endif
+    }
+
+    static bool is_alive(std::int64_t pid)
+    {
+#ifndef _WIN32
+        return kill(static_cast<pid_t>(pid), 0) == 0 or errno == EPERM;
+#else
+        (void)pid;
+        return false;
+#endif
+    }
+
+    static std::int64_t current_pid()
+    {
+#ifndef _WIN32
+        return getpid();
+#else
+        return 0;
+#endif
+    }
+
+    ~ipc_lease()
+    {
+#ifndef _WIN32
+        if(fd < 0)
+            return;
+        struct stat mine    = {};
+        struct stat current = {};
+        if(fstat(fd, &mine) == 0 and stat(file.c_str(), &current) == 0 and
+           mine.st_ino == current.st_ino and mine.st_dev == current.st_dev)
+        {
+            std::error_code ec;
+            fs::remove(file, ec);
+        }
+        close(fd);
+#endif
+    }
+};
+
+// Shares the device buffers of large literals with other processes through hip ipc handles. Each
+// buffer is published as a file in the directory set by MIGRAPHX_IPC_LITERALS, named by the
+// device and the content of the literal, so a process loading the same program maps the buffer
+// of the first process instead of uploading another copy. The memory of a released buffer is
+// reused by the memory pool, so a record is only imported while the process that published it
+// is alive and still holds the lease on it, and only for the content it was published for.
+struct ipc_literals
+{
+    struct record
+    {
+        hipIpcMemHandle_t handle;
+        std::size_t offset;
+        std::size_t nbytes;
+        std::int64_t pid;
+        std::array<char, 64> content;
+    };
+
+    // Keeps the lease on the record until the published buffer is released
+    struct published
+    {
+        std::shared_ptr<char> data;
+        std::unique_ptr<ipc_lease> lease;
+    };
+
+    fs::path dir;
+
+    static optional<ipc_literals> from_env()
+    {
+#ifdef _WIN32
+        return nullopt;
+#else
+        auto d = string_value_of(MIGRAPHX_IPC_LITERALS{});
+        if(d.empty())
+            return nullopt;
+        return ipc_literals{d};
+#endif
+    }
+
+    // Device ids are not the same in every process, so the device is named by its pci bus
+    static std::string key(std::size_t device_id, const std::string& content)
+    {
+        std::array<char, 64> bus{};
+        auto status = hipDeviceGetPCIBusId(bus.data(), bus.size(), device_id);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to get pci bus id: " + hip_error(status));
+        std::string result = bus.data();
+        std::replace(result.begin(), result.end(), ':', '_');
+        return result + "-" + content;
+    }
+
+    fs::path path(const std::string& k) const { return dir / (k + ".ipc"); }
+
+    static bool is_content(const record& r, const std::string& content)
+    {
+        auto last = std::find(r.content.begin(), r.content.end(), '\0');
+        return std::string(r.content.begin(), last) == content;
+    }
+
+    std::shared_ptr<char>
+    import(const std::string& k, const std::string& content, std::size_t nbytes) const
+    {
+        static auto& imports = get_metric_counter("ipc_literal_imports");
+        auto p               = path(k);
+        std::error_code ec;
+        if(not fs::exists(p, ec) or not ipc_lease::is_held(p))
+            return nullptr;
+        record r{};
+        try
+        {
+            auto buffer = read_buffer(p);
+            if(buffer.size() != sizeof(r))
+                return nullptr;
+            std::memcpy(&r, buffer.data(), sizeof(r));
+        }
+        catch(...)
+        {
+            return nullptr;
+        }
+        if(r.nbytes != nbytes or not is_content(r, content) or not ipc_lease::is_alive(r.pid))
+            return nullptr;
+        void* base = nullptr;
+        if(hipIpcOpenMemHandle(&base, r.handle, hipIpcMemLazyEnablePeerAccess) != hipSuccess)
+            return nullptr;
+        std::shared_ptr<void> owner{base, [](void* ptr) { (void)hipIpcCloseMemHandle(ptr); }};
+        // The owner could have released the buffer while it was opened
+        if(not ipc_lease::is_held(p))
+            return nullptr;
+        imports.add();
+        return {owner, static_cast<char*>(base) + r.offset};
+    }
+
+    // Returns the buffer with the lease on its record, or the buffer itself when it can't be
+    // published
+    std::shared_ptr<char> publish(const std::string& k,
+                                  const std::string& content,
+                                  std::shared_ptr<char> data,
+                                  std::size_t nbytes) const
+    {
+        hipDeviceptr_t base = nullptr;
+        std::size_t size    = 0;
+        if(hipMemGetAddressRange(&base, &size, data.get()) != hipSuccess)
+            return data;
+        record r{};
+        if(content.size() >= r.content.size() or hipIpcGetMemHandle(&r.handle, base) != hipSuccess)
+            return data;
+        r.offset = data.get() - static_cast<char*>(base);
+        r.nbytes = nbytes;
+        r.pid    = ipc_lease::current_pid();
+        std::copy(content.begin(), content.end(), r.content.begin());
+        std::error_code ec;
+        fs::create_directories(dir, ec);
+        if(ec)
+            return data;
+        // Write to a unique file first and rename it so that other processes never read a
+        // partially written record. The lease is taken before the rename so the record is never
+        // visible without it.
+        auto tmp = path(k);
+        tmp += ".tmp-" + std::to_string(std::random_device{}());
+        try
+        {
+            write_buffer(tmp, reinterpret_cast<const char*>(&r), sizeof(r));
+        }
+        catch(...)
+        {
+            fs::remove(tmp, ec);
+            return data;
+        }
+        auto lease = ipc_lease::acquire(tmp);
+        if(lease != nullptr)
+            fs::rename(tmp, path(k), ec);
+        if(lease == nullptr or ec)
+        {
+            fs::remove(tmp, ec);
+            return data;
+        }
+        lease->file = path(k);
+        auto* ptr   = data.get();
+        auto holder = std::make_shared<published>(published{std::move(data), std::move(lease)});
+        return {holder, ptr};
+    }
+};
+
+// The large literals uploaded by every program in the process, by device and content, so
+// programs with the same weights share one copy on the device. The entries don't keep the
+// memory alive, it is released once no program uses it.
+struct literal_registry
+{
+    struct entry
+    {
+        std::weak_ptr<char> data;
+        // Uploads are asynchronous, so a program reusing the data has to wait for the uploader
+        std::weak_ptr<literal_uploader> uploader;
+    };
+
+    std::mutex m;
+    std::unordered_map<std::string, entry> entries;
+    optional<ipc_literals> ipc = ipc_literals::from_env();
+
+    static std::string content_key(const literal& l)
+    {
+        digest d;
+        d.update(to_string(l.get_shape()));
+        d.update(l.content_hash());
+        return d.str();
+    }
+
+    std::shared_ptr<char> upload(const std::shared_ptr<literal_uploader>& uploader,
+                                 std::size_t device_id,
+                                 const literal& l)
+    {
+        auto content = content_key(l);
+        auto k       = std::to_string(device_id) + ":" + content;
+        std::shared_ptr<char> data;
+        std::shared_ptr<literal_uploader> pending;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            auto& e = entries[k];
+            data    = e.data.lock();
+            if(data == nullptr and not ipc.has_value())
+            {
+                data = uploader->upload(l);
+                e    = {data, uploader};
+                return data;
+            }
+            pending = e.uploader.lock();
+        }
+        if(data == nullptr)
+            return upload_ipc(k, uploader, device_id, content, l);
+        if(pending != nullptr)
+            pending->wait();
+        return data;
+    }
+
+    // Maps the buffer published by another process, or uploads the literal and publishes it. The
+    // upload is waited on before it is published, since the other processes can't wait for it.
+    // Both are done without holding the lock, as they wait on the device and the file system.
+    std::shared_ptr<char> upload_ipc(const std::string& k,
+                                     const std::shared_ptr<literal_uploader>& uploader,
+                                     std::size_t device_id,
+                                     const std::string& content,
+                                     const literal& l)
+    {
+        auto ipc_key = ipc_literals::key(device_id, content);
+        auto nbytes  = l.get_shape().bytes();
+        auto data    = ipc->import(ipc_key, content, nbytes);
+        if(data == nullptr)
+        {
+            data = uploader->upload(l);
+            uploader->wait();
+            data = ipc->publish(ipc_key, content, std::move(data), nbytes);
+        }
+        std::lock_guard<std::mutex> lock(m);
+        auto& e = entries[k];
+        // Another thread could have added it in the meantime
+        if(auto current = e.data.lock())
+            return current;
+        e = {data, {}};
+        return data;
+    }
+};
+
+static literal_registry& get_literal_registry()
+{
+    static literal_registry registry;
+    return registry;
+}
+
+argument upload_literal(context& ctx, const literal& l)
+{
+    set_device(ctx);
+    if(l.get_shape().bytes() == 0)
+        return to_gpu(l.get_argument());
+    auto& device   = ctx.get_current_device();
+    auto& uploader = device.uploader;
+    if(uploader == nullptr)
+        uploader = std::make_shared<literal_uploader>(device.get_device_id());
+    // Small literals are packed together, they aren't worth hashing
+    if(l.get_shape().bytes() <= literal_uploader::small_size)
+        return {l.get_shape(), uploader->upload(l)};
+    return {l.get_shape(), get_literal_registry().upload(uploader, device.get_device_id(), l)};
+}
+
+void wait_for_literals(const context& ctx)
+{
+    const auto& uploader = ctx.get_current_device().uploader;
+    if(uploader != nullptr)
+        uploader->wait();
+}
+
+argument pin_literal(const literal& l)
+{
+    auto result = allocate_gpu(l.get_shape(), true);
+    std::memcpy(result.data(), l.data(), l.get_shape().bytes());
+    return result;
+}
+
+// Pinned staging buffers for the parameters copied to the gpu. Each destination
+// gets two buffers that are used in turn, so the host can fill one while the
+// transfer from the previous run may still be reading the other.
+struct param_stager
+{
+    struct slot
+    {
+        std::shared_ptr<void> buffer     = nullptr;
+        std::size_t size                 = 0;
+        shared<hip_sync_event_ptr> event = nullptr;
+        bool recorded                    = false;
+    };
+
+    struct slot_pair
+    {
+        std::array<slot, 2> slots;
+        std::size_t next = 0;
+    };
+
+    std::unordered_map<const void*, slot_pair> staging;
+
+    slot& acquire(const void* dst, std::size_t nbytes)
+    {
+        auto& sp = staging[dst];
+        auto& sl = sp.slots[sp.next];
+        sp.next  = (sp.next + 1) % sp.slots.size();
+        if(sl.event == nullptr)
+        {
+            hipEvent_t event = nullptr;
+            auto status      = hipEventCreateWithFlags(&event, hipEventDisableTiming);
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Failed to create event: " + hip_error(status));
+            sl.event = share(hip_sync_event_ptr{event});
+        }
+        if(sl.recorded)
+        {
+            auto status = hipEventSynchronize(sl.event.get());
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Failed to wait for copy: " + hip_error(status));
+            sl.recorded = false;
+        }
+        if(sl.size < nbytes)
+        {
+            void* ptr   = nullptr;
+            auto status = hipHostMalloc(&ptr, nbytes);
+            if(status != hipSuccess)
+                MIGRAPHX_THROW("Failed to allocate staging buffer: " + hip_error(status));
+            sl.buffer = share(hip_pinned_ptr{ptr});
+            sl.size   = nbytes;
+        }
+        return sl;
+    }
+
+    void copy(context& ctx, const argument& src, const argument& dst)
+    {
+        auto nbytes = src.get_shape().bytes();
+        auto& sl    = acquire(dst.data(), nbytes);
+        std::memcpy(sl.buffer.get(), src.data(), nbytes);
+        auto stream = ctx.get_stream().get();
+        auto status =
+            hipMemcpyAsync(dst.data(), sl.buffer.get(), nbytes, hipMemcpyHostToDevice, stream);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Copy to gpu failed: " + hip_error(status));
+        status = hipEventRecord(sl.event.get(), stream);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to record copy: " + hip_error(status));
+        sl.recorded = true;
+    }
+};
+
+void staged_copy_to_gpu(context& ctx, const argument& src, const argument& dst)
+{
+    if(src.get_shape() != dst.get_shape() or not dst.get_shape().packed() or
+       is_device_ptr(src.data()) or is_pinned_ptr(src.data()))
+    {
+        copy_to_gpu(ctx, src, dst);
+        return;
+    }
+    auto& stager = ctx.get_current_device().stager;
+    if(stager == nullptr)
+        stager = std::make_shared<param_stager>();
+    stager->copy(ctx, src, dst);
+}
+
 argument get_preallocation(context& ctx, const std::string& id)
 {
     return ctx.get_current_device().preallocations.at(id);
 }
 
-void gpu_fill(context& ctx, const argument& dst, int value)
+static std::vector<char> fill_element(const shape& s, double value)
+{
+    literal l{shape{s.type()}, std::vector<double>{value}};
+    return {l.data(), l.data() + l.get_shape().bytes()};
+}
+
+static std::vector<std::uint32_t> get_words(const std::vector<char>& element)
+{
+    std::vector<std::uint32_t> words(element.size() / sizeof(std::uint32_t));
+    std::memcpy(words.data(), element.data(), words.size() * sizeof(std::uint32_t));
+    return words;
+}
+
+static bool is_repeated_word(const std::vector<std::uint32_t>& words)
+{
+    return std::all_of(words.begin(), words.end(), [&](auto w) { return w == words.front(); });
+}
+
+// Elements that don't repeat one 32-bit word are written once and then copied to the rest of the
+// buffer with the copy kernel, reading the first element through a broadcast
+static std::pair<shape, shape> broadcast_fill_shapes(const shape& s)
+{
+    auto n = s.elements() - 1;
+    return {shape{s.type(), {n}, {0}}, shape{s.type(), {n}}};
+}
+
+void compile_fill(context& ctx, const shape& dst, optional<double> value)
+{
+    if(not dst.sub_shapes().empty())
+    {
+        for(const auto& sub : dst.sub_shapes())
+            compile_fill(ctx, sub, value);
+        return;
+    }
+    if(dst.dynamic() or dst.elements() < 2 or dst.type_size() <= sizeof(std::uint32_t))
+        return;
+    if(value.has_value() and is_repeated_word(get_words(fill_element(dst, *value))))
+        return;
+    auto shapes = broadcast_fill_shapes(dst);
+    compile_copy(ctx, shapes.first, shapes.second);
+}
+
+// Fills the buffer by repeating the bytes of one element. Memsets take the value directly, so
+// there is no host memory that has to outlive the fill. Only packed buffers can be filled, since
+// a memset would also write the gaps between the elements of other buffers.
+static void hip_async_fill(context& ctx, const argument& dst, const std::vector<char>& element)
+{
+    const auto& s = dst.get_shape();
+    if(not s.packed())
+        MIGRAPHX_THROW("Gpu fill of a buffer that is not packed: " + to_string(s));
+    auto n      = s.elements();
+    auto size   = element.size();
+    auto stream = ctx.get_stream().get();
+    auto check  = [](hipError_t status) {
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Gpu fill failed: " + hip_error(status));
+    };
+    if(size == 1)
+    {
+        check(hipMemsetD8Async(dst.data(), static_cast<unsigned char>(element.front()), n, stream));
+    }
+    else if(size == 2)
+    {
+        std::uint16_t x = 0;
+        std::memcpy(&x, element.data(), size);
+        check(hipMemsetD16Async(dst.data(), x, n, stream));
+    }
+    else if(size % sizeof(std::uint32_t) == 0)
+    {
+        auto words = get_words(element);
+        if(is_repeated_word(words))
+        {
+            check(hipMemsetD32Async(
+                dst.data(), static_cast<int>(words.front()), n * words.size(), stream));
+            return;
+        }
+        for(std::size_t i = 0; i < words.size(); i++)
+            check(hipMemsetD32Async(dst.data() + i * sizeof(std::uint32_t),
+                                    static_cast<int>(words[i]),
+                                    1,
+                                    stream));
+        if(n < 2)
+            return;
+        auto shapes = broadcast_fill_shapes(s);
+        gpu_copy(
+            ctx, argument{shapes.first, dst.data()}, argument{shapes.second, dst.data() + size});
+    }
+    else
+    {
+        MIGRAPHX_THROW("Unsupported type for gpu fill: " + s.type_string());
+    }
+}
+
+void gpu_fill(context& ctx, const argument& dst, double value)
 {
     if(dst.get_sub_objects().empty())
     {
-        // TODO: Handle non-packed tensor when value is not 0
-        assert(dst.get_shape().packed() and value == 0);
-        hip_async_memset(ctx, dst, value);
+        hip_async_fill(ctx, dst, fill_element(dst.get_shape(), value));
     }
     else
     {
@@ -319,11 +1293,41 @@ void gpu_fill(context& ctx, const argument& dst, int value)
     }
 }
 
+void gpu_generate(context& ctx, const argument& dst, unsigned long seed)
+{
+    if(dst.get_sub_objects().empty())
+    {
+        device::generate(ctx.get_stream().get(), dst, seed);
+    }
+    else
+    {
+        for(const auto& arg : dst.get_sub_objects())
+            gpu_generate(ctx, arg, seed++);
+    }
+}
+
+void gpu_random_seed(context& ctx, const argument& dst)
+{
+    auto seed      = ctx.next_random_seed();
+    auto type_size = dst.get_shape().type_size();
+    if(type_size != sizeof(std::uint32_t) and type_size != sizeof(std::uint64_t))
+        MIGRAPHX_THROW("Unsupported type for random seed: " + dst.get_shape().type_string());
+    std::vector<char> element(type_size);
+    std::memcpy(element.data(), &seed, type_size);
+    hip_async_fill(ctx, dst, element);
+}
+
 void store_preallocated_param(context& ctx, const std::string& id, const argument& a)
 {
     ctx.get_current_device().preallocations[id] = a;
 }
 
+void store_preallocated_literal(context& ctx, const std::string& id, const argument& a)
+{
+    store_preallocated_param(ctx, id, a);
+    ctx.get_current_device().literal_preallocations.insert(id);
+}
+
 // clang-format off
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
@@ -28,7 +28,9 @@
 #include <limits>
 #include <migraphx/gpu/hipblaslt.hpp>
 #include <migraphx/gpu/hip_gemm_impl.hpp>
+#include <migraphx/gpu/problem_cache.hpp>
 #include <migraphx/reduce_dims.hpp>
+#include <migraphx/ranges.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/time.hpp>
 
@@ -65,13 +67,14 @@ hipDataType get_type_hipblas(shape::type_t type)
     case shape::double_type: return HIP_R_64F;
     case shape::float_type: return HIP_R_32F;
     case shape::half_type: return HIP_R_16F;
+    case shape::bf16_type: return HIP_R_16BF;
     case shape::int8_type: return HIP_R_8I;
     case shape::uint8_type: return HIP_R_8U;
     case shape::int32_type: return HIP_R_32I;
     case shape::uint32_type: return HIP_R_32U;
     case shape::fp8e4m3fnuz_type: return HIP_R_8F_E4M3_FNUZ;
-    case shape::fp8e4m3fn_type:
-    case shape::fp8e5m2_type:
+    case shape::fp8e4m3fn_type: return HIP_R_8F_E4M3;
+    case shape::fp8e5m2_type: return HIP_R_8F_E5M2;
     case shape::tuple_type:
     case shape::bool_type:
     case shape::uint16_type:
@@ -103,6 +106,42 @@ void blas_shape_hip(const shape& s)
 
 static bool is_transposed_hip(const shape& s) { return s.transposed() and s.strides().back() != 1; }
 
+static hipblasLtEpilogue_t get_epilogue_hip(const hip_gemm_epilogue& epilogue)
+{
+    if(epilogue.activation == "relu")
+        return epilogue.bias ? HIPBLASLT_EPILOGUE_RELU_BIAS : HIPBLASLT_EPILOGUE_RELU;
+    if(not epilogue.activation.empty())
+        MIGRAPHX_THROW("HIPBLAS_GEMM: unsupported epilogue activation: " + epilogue.activation);
+    return epilogue.bias ? HIPBLASLT_EPILOGUE_BIAS : HIPBLASLT_EPILOGUE_DEFAULT;
+}
+
+static bool is_fp8_hip(hipDataType type)
+{
+    return contains({HIP_R_8F_E4M3_FNUZ, HIP_R_8F_E4M3, HIP_R_8F_E5M2}, type);
+}
+
+// The bias and scale are passed just before the workspace and output, but
+// hipBLASLt takes them as attributes of the matmul instead of as matrices
+template <class T>
+static std::vector<T> remove_epilogue_inputs(std::vector<T> xs, const hip_gemm_epilogue& epilogue)
+{
+    std::size_t n = (epilogue.bias ? 1 : 0) + (epilogue.scale ? 1 : 0);
+    xs.erase(xs.end() - 2 - n, xs.end() - 2);
+    return xs;
+}
+
+template <class T>
+static const T& get_bias(const std::vector<T>& xs, const hip_gemm_epilogue& epilogue)
+{
+    return xs.at(xs.size() - (epilogue.scale ? 4 : 3));
+}
+
+template <class T>
+static const T& get_scale(const std::vector<T>& xs)
+{
+    return xs.at(xs.size() - 3);
+}
+
 static int32_t get_batch_stride_hip(const shape& s)
 {
     // This value is not needed for non-strided inputs
@@ -122,8 +161,15 @@ struct hip_gemm_impl
     hip_gemm_impl(const shape& output_shape,
                   const std::vector<shape>& input_shapes,
                   float alpha_param,
-                  float beta_param)
-        : alpha(alpha_param), beta(beta_param), is_3inputs(input_shapes.size() == 5)
+                  float beta_param,
+                  const hip_gemm_epilogue& epilogue_param = {})
+        : alpha(alpha_param),
+          beta(beta_param),
+          is_3inputs(input_shapes.size() == 5),
+          has_bias(epilogue_param.bias),
+          has_scale(epilogue_param.scale),
+          workspace_bytes(input_shapes[input_shapes.size() - 2].bytes()),
+          epilogue(get_epilogue_hip(epilogue_param))
     {
         if(not is_3inputs)
         {
@@ -186,6 +232,8 @@ struct hip_gemm_impl
         {
             compute_type = HIPBLAS_COMPUTE_32F;
         }
+        if(has_scale and not is_fp8_hip(arg_type))
+            MIGRAPHX_THROW("HIPBLAS_GEMM: scale epilogue is only supported for fp8 inputs");
         if(op_a == HIPBLAS_OP_T)
         {
             hipblaslt_invoke(
@@ -286,6 +334,22 @@ struct hip_gemm_impl
             return hipblasLtMatmulDescSetAttribute(
                 hipblaslt_desc, HIPBLASLT_MATMUL_DESC_TRANSA, &op_b, sizeof(int32_t));
         });
+        if(epilogue != HIPBLASLT_EPILOGUE_DEFAULT)
+        {
+            hipblaslt_invoke([&]() {
+                return hipblasLtMatmulDescSetAttribute(
+                    hipblaslt_desc, HIPBLASLT_MATMUL_DESC_EPILOGUE, &epilogue, sizeof(epilogue));
+            });
+        }
+        if(has_bias)
+        {
+            hipblaslt_invoke([&]() {
+                return hipblasLtMatmulDescSetAttribute(hipblaslt_desc,
+                                                       HIPBLASLT_MATMUL_DESC_BIAS_DATA_TYPE,
+                                                       &output_type,
+                                                       sizeof(output_type));
+            });
+        }
 
         // Transfer ownership of raw pointers to managed pointers.
         managed_hipblaslt_desc.reset(hipblaslt_desc);
@@ -332,7 +396,7 @@ struct hip_gemm_impl
                 const int n_sol = 1;
                 int returned_algo_count;
                 heuristic_result.resize(n_sol);
-                uint64_t max_workspace = std::numeric_limits<uint64_t>::max();
+                uint64_t max_workspace = gemm.workspace_bytes;
                 hipblaslt_invoke([&]() {
                     return hipblasLtMatmulPreferenceSetAttribute(
                         preference,
@@ -393,6 +457,27 @@ struct hip_gemm_impl
                                       const std::vector<argument>& args,
                                       int32_t solution_idx)
     {
+        if(has_bias)
+        {
+            assert(bias_data != nullptr);
+            hipblaslt_invoke([&]() {
+                return hipblasLtMatmulDescSetAttribute(hipblaslt_desc,
+                                                       HIPBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                       &bias_data,
+                                                       sizeof(bias_data));
+            });
+        }
+        if(has_scale)
+        {
+            assert(scale_data != nullptr);
+            // The scales of A and B are multiplied together, so the whole scale is put on A
+            hipblaslt_invoke([&]() {
+                return hipblasLtMatmulDescSetAttribute(hipblaslt_desc,
+                                                       HIPBLASLT_MATMUL_DESC_A_SCALE_POINTER,
+                                                       &scale_data,
+                                                       sizeof(scale_data));
+            });
+        }
         auto* algo = &solution.get_result(ctx, *this, solution_idx)[0].algo;
         return pack(ctx.get_stream().get_hipblaslt(),
                     hipblaslt_desc,
@@ -473,6 +558,38 @@ struct hip_gemm_impl
         return solution_idx;
     }
 
+    /**
+     * Checks a solution tuned for another problem, which hipBLASLt must support for this gemm
+     * within the workspace planned for it.
+     *
+     * @return Returns either solution_idx if it can be used, or else the default value 0.
+     */
+    int32_t borrow(context& ctx, int32_t solution_idx) const
+    {
+        try
+        {
+            std::vector<hipblasLtMatmulHeuristicResult_t> result;
+            std::vector<int32_t> algo_index = {solution_idx};
+            hipblaslt_invoke([&]() {
+                return hipblaslt_ext::getAlgosFromIndex(
+                    ctx.get_stream().get_hipblaslt(), algo_index, result);
+            });
+            if(result.empty())
+                return 0;
+            size_t ret_workspace_size = 0;
+            auto supporting_args      = create_hipblaslt_supporting_args_common(
+                ctx, {}, result.front().algo, ret_workspace_size);
+            hipblaslt_invoke(&hipblaslt_ext::matmulIsAlgoSupported, supporting_args);
+            if(ret_workspace_size > workspace_bytes)
+                return 0;
+        }
+        catch(...)
+        {
+            return 0;
+        }
+        return solution_idx;
+    }
+
     /**
      * Find best hipBLASLt solution:  Get list of solutions and try them all, returning the index
      * of the fastest one.
@@ -512,6 +629,9 @@ struct hip_gemm_impl
             try
             {
                 hipblaslt_invoke(&hipblaslt_ext::matmulIsAlgoSupported, supporting_args);
+                // Any algorithm that fits in the workspace planned for the gemm can be picked
+                if(ret_workspace_size > workspace_bytes)
+                    continue;
                 solution_indices.push_back(hipblaslt_ext::getIndexFromAlgo(algo));
             }
             catch(...)
@@ -577,7 +697,15 @@ struct hip_gemm_impl
     int64_t c_stride = 0;
     int64_t d_stride = 0;
     bool is_3inputs  = true;
-
+    bool has_bias    = false;
+    bool has_scale   = false;
+    // The size of the workspace input, which is planned with the rest of the scratch memory
+    std::size_t workspace_bytes = 0;
+    // Set before each call when there is a bias or scale
+    const void* bias_data  = nullptr;
+    const void* scale_data = nullptr;
+
+    hipblasLtEpilogue_t epilogue      = HIPBLASLT_EPILOGUE_DEFAULT;
     hipDataType arg_type              = HIP_R_32F;
     hipblasComputeType_t compute_type = HIPBLAS_COMPUTE_32F;
     hipDataType output_type           = HIP_R_32F;
@@ -600,30 +728,48 @@ void hip_gemm_compute(context& ctx,
                       const std::vector<argument>& args,
                       float alpha,
                       float beta,
-                      int32_t solution_idx)
+                      int32_t solution_idx,
+                      const hip_gemm_epilogue& epilogue)
 {
+    auto gemm_args = remove_epilogue_inputs(args, epilogue);
     std::vector<shape> input_shapes;
-    std::transform(args.begin(),
-                   args.end(),
+    std::transform(gemm_args.begin(),
+                   gemm_args.end(),
                    std::back_inserter(input_shapes),
                    [](const argument& x) { return x.get_shape(); });
-    auto gemm_item = hip_gemm_impl(output_shape, input_shapes, alpha, beta);
-    gemm_item.run(ctx, args, solution_idx);
+    auto gemm_item = hip_gemm_impl(output_shape, input_shapes, alpha, beta, epilogue);
+    if(epilogue.bias)
+        gemm_item.bias_data = get_bias(args, epilogue).data();
+    if(epilogue.scale)
+        gemm_item.scale_data = get_scale(args).data();
+    gemm_item.run(ctx, gemm_args, solution_idx);
 }
 
-static value hip_gemm_problem(const shape& output_shape, std::vector<shape> input_shapes)
+static value hip_gemm_problem(const shape& output_shape,
+                              std::vector<shape> input_shapes,
+                              const hip_gemm_epilogue& epilogue)
 {
     input_shapes.push_back(output_shape);
-    return to_value(input_shapes);
+    // Keep the same key for gemms without an epilogue
+    if(not epilogue.bias and epilogue.activation.empty() and not epilogue.scale)
+        return to_value(input_shapes);
+    value problem = {{"shapes", to_value(input_shapes)},
+                     {"bias", epilogue.bias},
+                     {"activation", epilogue.activation}};
+    // Keep the same key as before for epilogues without a scale
+    if(epilogue.scale)
+        problem["scale"] = true;
+    return problem;
 }
 
 static void hip_gemm_save_solution(context& ctx,
                                    const shape& output_shape,
                                    const std::vector<shape>& input_shapes,
-                                   int32_t solution_idx)
+                                   int32_t solution_idx,
+                                   const hip_gemm_epilogue& epilogue)
 {
     ctx.get_problem_cache().insert(
-        "hipblaslt", hip_gemm_problem(output_shape, input_shapes), solution_idx);
+        "hipblaslt", hip_gemm_problem(output_shape, input_shapes, epilogue), solution_idx);
 }
 
 int32_t hip_gemm_finalize(context& ctx,
@@ -631,25 +777,69 @@ int32_t hip_gemm_finalize(context& ctx,
                           const std::vector<shape>& input_shapes,
                           float alpha,
                           float beta,
-                          int32_t solution_idx)
+                          int32_t solution_idx,
+                          const hip_gemm_epilogue& epilogue)
 {
-    auto gemm_item   = hip_gemm_impl(output_shape, input_shapes, alpha, beta);
-    int32_t solution = gemm_item.tune(ctx, input_shapes);
-    hip_gemm_save_solution(ctx, output_shape, input_shapes, solution_idx);
+    auto gemm_shapes = remove_epilogue_inputs(input_shapes, epilogue);
+    auto gemm_item   = hip_gemm_impl(output_shape, gemm_shapes, alpha, beta, epilogue);
+    argument bias;
+    argument scale;
+    if(epilogue.bias)
+    {
+        bias                = to_gpu(generate_argument(get_bias(input_shapes, epilogue)));
+        gemm_item.bias_data = bias.data();
+    }
+    if(epilogue.scale)
+    {
+        scale                = to_gpu(generate_argument(get_scale(input_shapes)));
+        gemm_item.scale_data = scale.data();
+    }
+    int32_t solution = gemm_item.tune(ctx, gemm_shapes);
+    hip_gemm_save_solution(ctx, output_shape, input_shapes, solution, epilogue);
     return solution;
 }
 
 int32_t hip_gemm_default_solution(context& ctx,
                                   const shape& output_shape,
-                                  const std::vector<shape>& input_shapes)
+                                  const std::vector<shape>& input_shapes,
+                                  const hip_gemm_epilogue& epilogue)
 {
-    auto sol =
-        ctx.get_problem_cache().get("hipblaslt", hip_gemm_problem(output_shape, input_shapes));
+    auto sol = ctx.get_problem_cache().get(
+        "hipblaslt", hip_gemm_problem(output_shape, input_shapes, epilogue));
     if(sol.has_value())
         return sol->to<int32_t>();
     return 0;
 }
 
+int32_t hip_gemm_nearest_solution(context& ctx,
+                                  const shape& output_shape,
+                                  const std::vector<shape>& input_shapes,
+                                  float alpha,
+                                  float beta,
+                                  const hip_gemm_epilogue& epilogue)
+{
+    auto problem = hip_gemm_problem(output_shape, input_shapes, epilogue);
+    auto shapes  = input_shapes;
+    shapes.push_back(output_shape);
+    auto distance = [&](const value& v) -> optional<double> {
+        if(v.is_object() != problem.is_object())
+            return nullopt;
+        if(not v.is_object())
+            return shapes_distance(shapes, from_value<std::vector<shape>>(v));
+        if(v.at("bias").to<bool>() != epilogue.bias or
+           v.at("activation").to<std::string>() != epilogue.activation or
+           v.get("scale", false) != epilogue.scale)
+            return nullopt;
+        return shapes_distance(shapes, from_value<std::vector<shape>>(v.at("shapes")));
+    };
+    auto sol = ctx.get_problem_cache().nearest("hipblaslt", distance);
+    if(not sol.has_value())
+        return 0;
+    auto gemm_shapes = remove_epilogue_inputs(input_shapes, epilogue);
+    auto gemm_item   = hip_gemm_impl(output_shape, gemm_shapes, alpha, beta, epilogue);
+    return gemm_item.borrow(ctx, sol->to<int32_t>());
+}
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
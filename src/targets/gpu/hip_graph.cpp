@@ -0,0 +1,304 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/hip_graph.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/manage_ptr.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/param_utils.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/stringutils.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+using hip_graph_ptr      = MIGRAPHX_MANAGE_PTR(hipGraph_t, hipGraphDestroy);
+using hip_graph_exec_ptr = MIGRAPHX_MANAGE_PTR(hipGraphExec_t, hipGraphExecDestroy);
+
+struct hip_graph_entry
+{
+    hip_graph_ptr graph           = nullptr;
+    hip_graph_exec_ptr exec       = nullptr;
+    std::vector<char*> inputs     = {};
+    std::vector<argument> results = {};
+    // Set when the submodule could not be captured, it is then always run eagerly
+    bool eager = false;
+};
+
+// The graphs captured for each stream. Concurrent evals run on the streams of their own session
+// contexts, so an entry is only used by one eval at a time and the lock only guards the lookup.
+struct hip_graph_cache
+{
+    std::mutex m;
+    std::unordered_map<hipStream_t, hip_graph_entry> entries;
+
+    hip_graph_entry& get(hipStream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return entries[stream];
+    }
+};
+
+struct hip_graph
+{
+    std::shared_ptr<hip_graph_cache> cache = std::make_shared<hip_graph_cache>();
+
+    template <class Self, class F>
+    static auto reflect(Self&, F)
+    {
+        return pack();
+    }
+
+    std::string name() const { return "gpu::hip_graph"; }
+
+    shape compute_shape(const std::vector<shape>&, std::vector<module_ref> mods) const
+    {
+        if(mods.size() != 1)
+            MIGRAPHX_THROW("gpu::hip_graph: should have one submodule.");
+        return shape{mods.front()->get_output_shapes()};
+    }
+
+    template <class F>
+    static bool capture(hip_graph_entry& entry,
+                        hipStream_t stream,
+                        module_ref mod,
+                        const parameter_map& params,
+                        const F& run)
+    {
+        auto status = hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to begin graph capture: " + hip_error(status));
+        std::vector<argument> results;
+        hipGraph_t raw_graph = nullptr;
+        try
+        {
+            results = run(mod, params);
+        }
+        catch(...)
+        {
+            // An operator that synchronizes with the host will invalidate the
+            // capture, so end the capture and let the caller run it eagerly
+            (void)hipStreamEndCapture(stream, &raw_graph);
+            if(raw_graph != nullptr)
+                (void)hipGraphDestroy(raw_graph);
+            return false;
+        }
+        status = hipStreamEndCapture(stream, &raw_graph);
+        hip_graph_ptr graph{raw_graph};
+        if(status != hipSuccess)
+            return false;
+        hipGraphExec_t raw_exec = nullptr;
+        status                  = hipGraphInstantiate(&raw_exec, graph.get(), nullptr, nullptr, 0);
+        if(status != hipSuccess)
+            return false;
+        entry.graph   = std::move(graph);
+        entry.exec    = hip_graph_exec_ptr{raw_exec};
+        entry.results = std::move(results);
+        return true;
+    }
+
+    argument
+    compute(context& ctx,
+            const shape&,
+            const std::vector<argument>& args,
+            const std::vector<module_ref>& mods,
+            const std::function<std::vector<argument>(
+                module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
+    {
+        module_ref mod = mods.front();
+        parameter_map params;
+        for(auto i : range(args.size()))
+            params[param_name(i)] = args[i];
+        auto* stream = ctx.get_stream().get();
+        auto& entry  = cache->get(stream);
+        if(entry.eager)
+            return argument{run(mod, params)};
+
+        // The graph records the device addresses, so it has to be captured
+        // again when the parameters are passed in different buffers
+        std::vector<char*> inputs;
+        std::transform(args.begin(), args.end(), std::back_inserter(inputs), [](const auto& arg) {
+            return arg.data();
+        });
+        if(entry.exec == nullptr or inputs != entry.inputs)
+        {
+            if(not capture(entry, stream, mod, params, run))
+            {
+                entry.eager = true;
+                return argument{run(mod, params)};
+            }
+            entry.inputs = inputs;
+        }
+        auto status = hipGraphLaunch(entry.exec.get(), stream);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to launch graph: " + hip_error(status));
+        return argument{entry.results};
+    }
+};
+MIGRAPHX_REGISTER_OP(hip_graph);
+
+namespace {
+
+// Operators that execute on the host or synchronize with it cannot be captured
+bool is_host_op(instruction_ref ins)
+{
+    return contains({"hip::copy_to_gpu", "hip::copy_from_gpu", "hip::sync_stream"},
+                    ins->name()) or
+           starts_with(ins->name(), "check_context");
+}
+
+// Operators that only compute a view or an allocation and never use the stream
+bool is_view_op(instruction_ref ins)
+{
+    if(contains({"@param", "@literal", "hip::hip_allocate_memory", "hip::hip_copy_literal"},
+                ins->name()))
+        return true;
+    return ins->get_operator().is_context_free();
+}
+
+} // namespace
+
+void capture_hip_graph::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    if(m.name() != "main")
+        return;
+    if(std::any_of(m.begin(), m.end(), [](const instruction& ins) {
+           return not ins.module_inputs().empty() or ins.name() == "gpu::set_stream" or
+                  ins.get_shape().dynamic();
+       }))
+        return;
+
+    // Instructions that dont depend on the device work stay before the graph,
+    // and the host operators that use the results of the device work are run
+    // after it
+    std::vector<instruction_ref> pre_ins;
+    std::vector<instruction_ref> device_ins;
+    std::unordered_set<instruction_ref> device_set;
+    std::unordered_set<instruction_ref> after_set;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "@return")
+            continue;
+        const auto& inputs = ins->inputs();
+        bool from_device   = std::any_of(
+            inputs.begin(), inputs.end(), [&](auto input) { return contains(device_set, input); });
+        bool from_after = std::any_of(
+            inputs.begin(), inputs.end(), [&](auto input) { return contains(after_set, input); });
+        if(from_after or (is_host_op(ins) and from_device))
+        {
+            if(not is_host_op(ins) and not is_view_op(ins))
+                return;
+            after_set.insert(ins);
+        }
+        else if(is_host_op(ins) or (is_view_op(ins) and not from_device))
+        {
+            pre_ins.push_back(ins);
+        }
+        else
+        {
+            device_ins.push_back(ins);
+            device_set.insert(ins);
+        }
+    }
+    if(device_ins.empty())
+        return;
+
+    std::vector<instruction_ref> inputs;
+    std::vector<instruction_ref> outputs;
+    for(auto ins : device_ins)
+    {
+        for(auto input : ins->inputs())
+        {
+            if(contains(device_set, input) or contains(inputs, input))
+                continue;
+            inputs.push_back(input);
+        }
+        // Without a return instruction the last instruction is the result
+        if(ins == std::prev(m.end()) or
+           std::any_of(ins->outputs().begin(), ins->outputs().end(), [&](auto output) {
+               return not contains(device_set, output);
+           }))
+            outputs.push_back(ins);
+    }
+
+    // The graph is inserted before the first instruction that uses its
+    // results, so the instructions it depends on are moved before it
+    auto pos = m.end();
+    std::unordered_set<instruction_ref> before_pos;
+    for(auto ins : iterator_for(m))
+    {
+        if(contains(after_set, ins) or ins->name() == "@return")
+        {
+            pos = ins;
+            break;
+        }
+        before_pos.insert(ins);
+    }
+    for(auto ins : pre_ins)
+    {
+        if(not contains(before_pos, ins))
+            m.move_instruction(ins, pos);
+    }
+
+    auto* gm = mpm.create_module(m.name() + ":hip_graph");
+    std::unordered_map<instruction_ref, instruction_ref> map_ins;
+    for(auto i : range(inputs.size()))
+        map_ins[inputs[i]] = gm->add_parameter(param_name(i), inputs[i]->get_shape());
+    gm->add_instructions(device_ins, &map_ins);
+    std::vector<instruction_ref> returns;
+    std::transform(outputs.begin(),
+                   outputs.end(),
+                   std::back_inserter(returns),
+                   [&](auto output) { return map_ins.at(output); });
+    gm->add_return(returns);
+
+    auto graph = m.insert_instruction(pos, make_op("gpu::hip_graph"), inputs, {gm});
+    for(auto i : range(outputs.size()))
+    {
+        auto elem = m.insert_instruction(pos, make_op("get_tuple_elem", {{"index", i}}), graph);
+        auto users = outputs[i]->outputs();
+        for(auto user : users)
+        {
+            if(contains(device_set, user))
+                continue;
+            instruction::replace_argument(user, outputs[i], elem);
+        }
+    }
+    for(auto ins : reverse(device_ins))
+        m.remove_instruction(ins);
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -25,6 +25,7 @@
 #include <migraphx/ranges.hpp>
 #include <migraphx/gpu/hipblaslt.hpp>
 #include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/device_name.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -61,6 +62,11 @@ bool hipblaslt_supported()
             not starts_with(device_name, "gfx10"));
 }
 
+bool hipblaslt_fp8ocp_supported()
+{
+    return hipblaslt_supported() and gfx_has_fp8ocp_intrinsics();
+}
+
 #endif // MIGRAPHX_USE_HIPBLASLT
 
 } // namespace gpu
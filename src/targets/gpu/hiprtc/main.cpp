@@ -27,15 +27,56 @@
 #include <migraphx/msgpack.hpp>
 #include <migraphx/file_buffer.hpp>
 #include <migraphx/ranges.hpp>
+#include <migraphx/par_for.hpp>
 #include <array>
 #include <iostream>
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
 
 #ifdef _WIN32
 #include <fcntl.h>
 #include <io.h>
+#else
+#include <unistd.h>
 #endif
 
+std::vector<char> compile(const migraphx::value& v)
+{
+    std::vector<migraphx::gpu::hiprtc_src_file> srcs;
+    migraphx::from_value(v.at("srcs"), srcs);
+    auto out = migraphx::gpu::compile_hip_src_with_hiprtc(std::move(srcs),
+                                                          v.at("params").to_vector<std::string>(),
+                                                          v.at("arch").to<std::string>());
+    if(out.empty())
+        return {};
+    return out.front();
+}
+
+// Compiles a batch of jobs in parallel and returns one result per job, either the code object or
+// the error that was raised
+migraphx::value compile_jobs(const migraphx::value& jobs)
+{
+    std::vector<migraphx::value> results(jobs.size());
+    migraphx::par_for(jobs.size(), 1, [&](auto i) {
+        migraphx::value result;
+        try
+        {
+            auto co = compile(jobs[i]);
+            if(co.empty())
+                result["error"] = "No code object";
+            else
+                result["code_object"] = migraphx::value::binary{co};
+        }
+        catch(const std::exception& err)
+        {
+            result["error"] = std::string(err.what());
+        }
+        results[i] = result;
+    });
+    return migraphx::value{results};
+}
+
 std::vector<char> read_stdin()
 {
 #ifdef _WIN32
@@ -62,6 +103,71 @@ std::vector<char> read_stdin()
     return result;
 }
 
+#ifndef _WIN32
+static bool read_exactly(int fd, char* buffer, std::size_t n)
+{
+    while(n > 0)
+    {
+        auto len = ::read(fd, buffer, n);
+        if(len < 0 and errno == EINTR)
+            continue;
+        if(len <= 0)
+            return false;
+        buffer += len;
+        n -= len;
+    }
+    return true;
+}
+
+static bool write_exactly(int fd, const char* buffer, std::size_t n)
+{
+    while(n > 0)
+    {
+        auto len = ::write(fd, buffer, n);
+        if(len < 0 and errno == EINTR)
+            continue;
+        if(len <= 0)
+            return false;
+        buffer += len;
+        n -= len;
+    }
+    return true;
+}
+
+// Compiles batches of jobs until stdin is closed, so the process and compiler startup is only paid
+// once. Each request and response is a msgpack value prefixed with its size. Anything printed to
+// stdout while compiling goes to stderr instead so it can't corrupt the responses.
+int serve()
+{
+    int out = dup(STDOUT_FILENO);
+    if(out == -1 or dup2(STDERR_FILENO, STDOUT_FILENO) == -1)
+        return 1;
+    for(;;)
+    {
+        std::uint64_t n = 0;
+        if(not read_exactly(STDIN_FILENO, reinterpret_cast<char*>(&n), sizeof(n)))
+            return 0;
+        std::vector<char> request(n);
+        if(not read_exactly(STDIN_FILENO, request.data(), request.size()))
+            return 1;
+        migraphx::value results = migraphx::value::array{};
+        try
+        {
+            results = compile_jobs(migraphx::from_msgpack(request).at("jobs"));
+        }
+        catch(const std::exception& err)
+        {
+            std::cerr << err.what() << std::endl;
+        }
+        auto response = migraphx::to_msgpack(results);
+        n             = response.size();
+        if(not write_exactly(out, reinterpret_cast<const char*>(&n), sizeof(n)) or
+           not write_exactly(out, response.data(), response.size()))
+            return 1;
+    }
+}
+#endif
+
 int main(int argc, char const* argv[])
 {
     if(argc < 2 or migraphx::contains({"-h", "--help", "-v", "--version"}, std::string(argv[1])))
@@ -73,17 +179,21 @@ int main(int argc, char const* argv[])
         std::exit(0);
     }
     std::string output_name = argv[1];
+#ifndef _WIN32
+    if(output_name == "--server")
+        return serve();
+#endif
     try
     {
         auto v = migraphx::from_msgpack(read_stdin());
-        std::vector<migraphx::gpu::hiprtc_src_file> srcs;
-        migraphx::from_value(v.at("srcs"), srcs);
-        auto out =
-            migraphx::gpu::compile_hip_src_with_hiprtc(std::move(srcs),
-                                                       v.at("params").to_vector<std::string>(),
-                                                       v.at("arch").to<std::string>());
+        if(v.contains("jobs"))
+        {
+            migraphx::write_buffer(output_name, migraphx::to_msgpack(compile_jobs(v.at("jobs"))));
+            return 0;
+        }
+        auto out = compile(v);
         if(not out.empty())
-            migraphx::write_buffer(output_name, out.front());
+            migraphx::write_buffer(output_name, out);
     }
     catch(const std::exception& err)
     {
@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/hipsparselt.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/device_name.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+#if MIGRAPHX_USE_HIPSPARSELT
+
+bool hipsparselt_supported()
+{
+    const auto device_name = trim(split_string(get_device_name(), ':').front());
+    return contains({"gfx942", "gfx950"}, device_name);
+}
+
+bool hipsparselt_supported_type(shape::type_t t)
+{
+    return contains({shape::half_type, shape::bf16_type}, t);
+}
+
+hipDataType hipsparselt_type(shape::type_t t)
+{
+    switch(t)
+    {
+    case shape::half_type: return HIP_R_16F;
+    case shape::bf16_type: return HIP_R_16BF;
+    default: MIGRAPHX_THROW("hipSPARSELt: unsupported type " + shape::cpp_type(t));
+    }
+}
+
+void hipsparselt_init_weights(hipsparselt_handle& handle,
+                              hipsparselt_matrix& desc,
+                              const shape& weights)
+{
+    assert(weights.ndim() == 2);
+    auto k = weights.lens().front();
+    auto n = weights.lens().back();
+    desc.init([&](auto* d) {
+        return hipsparseLtStructuredDescriptorInit(handle.get(),
+                                                   d,
+                                                   n,
+                                                   k,
+                                                   n,
+                                                   hipsparselt_alignment,
+                                                   hipsparselt_type(weights.type()),
+                                                   HIPSPARSE_ORDER_COL,
+                                                   HIPSPARSELT_SPARSITY_50_PERCENT);
+    });
+}
+
+argument hipsparselt_compress(context& ctx, const argument& weights)
+{
+    hipsparselt_handle handle;
+    handle.init(&hipsparseLtInit);
+    hipsparselt_matrix desc;
+    hipsparselt_init_weights(handle, desc, weights.get_shape());
+
+    std::size_t compressed_size = 0;
+    std::size_t buffer_size     = 0;
+    hipsparselt_invoke(&hipsparseLtSpMMACompressedSize2,
+                       handle.get(),
+                       desc.get(),
+                       &compressed_size,
+                       &buffer_size);
+    auto dense       = to_gpu(weights);
+    auto compressed  = allocate_gpu(shape{shape::uint8_type, {compressed_size}});
+    auto buffer_lens = std::max<std::size_t>(buffer_size, 1);
+    auto buffer      = allocate_gpu(shape{shape::uint8_type, {buffer_lens}});
+    hipsparselt_invoke(&hipsparseLtSpMMACompress2,
+                       handle.get(),
+                       desc.get(),
+                       1,
+                       HIPSPARSE_OPERATION_NON_TRANSPOSE,
+                       dense.data(),
+                       compressed.data(),
+                       buffer.data(),
+                       ctx.get_stream().get());
+    ctx.finish();
+    return from_gpu(compressed);
+}
+
+#endif // MIGRAPHX_USE_HIPSPARSELT
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
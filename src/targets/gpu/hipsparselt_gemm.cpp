@@ -0,0 +1,162 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/hipsparselt_gemm.hpp>
+#include <migraphx/gpu/hipsparselt.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+#if MIGRAPHX_USE_HIPSPARSELT
+// The gemm is computed transposed in column-major order, so the sparse weights are the first
+// operand: C^T[n, m] = W^T[n, k] * A^T[k, m]
+struct hipsparselt_gemm_state
+{
+    hipsparselt_handle handle;
+    hipsparselt_matrix weights;
+    hipsparselt_matrix input;
+    hipsparselt_matrix output;
+    hipsparseLtMatmulDescriptor_t matmul{};
+    hipsparselt_alg_selection alg;
+    hipsparselt_plan plan;
+    std::size_t workspace_size = 0;
+    // Concurrent evals run on different streams, so each stream gets its own workspace
+    std::mutex m;
+    std::unordered_map<hipStream_t, argument> workspaces;
+
+    void* get_workspace(hipStream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto& workspace = workspaces[stream];
+        if(workspace.empty())
+            workspace = allocate_gpu(shape{shape::uint8_type, {workspace_size}});
+        return workspace.data();
+    }
+};
+#else
+struct hipsparselt_gemm_state
+{
+};
+#endif
+
+shape hipsparselt_gemm::compute_shape(const std::vector<shape>& inputs) const
+{
+    check_shapes{inputs, *this}.has(3);
+    check_shapes{{inputs.front()}, *this}.only_dims(2).standard();
+    if(weights.ndim() != 2)
+        MIGRAPHX_THROW(name() + ": weights must be 2D");
+    const auto& a = inputs.front();
+    if(a.type() != weights.type())
+        MIGRAPHX_THROW(name() + ": type mismatch with the weights");
+    if(a.lens().back() != weights.lens().front())
+        MIGRAPHX_THROW(name() + ": inner dimensions do not match");
+    if(inputs[1].type() != shape::uint8_type)
+        MIGRAPHX_THROW(name() + ": compressed weights must be uint8");
+    return {a.type(), {a.lens().front(), weights.lens().back()}};
+}
+
+#if MIGRAPHX_USE_HIPSPARSELT
+void hipsparselt_gemm::finalize(context&, const shape&, const std::vector<shape>& inputs)
+{
+    auto m       = inputs.front().lens().front();
+    auto k       = weights.lens().front();
+    auto n       = weights.lens().back();
+    auto t       = hipsparselt_type(weights.type());
+    auto s       = std::make_shared<hipsparselt_gemm_state>();
+    auto* handle = s->handle.get();
+    s->handle.init(&hipsparseLtInit);
+    hipsparselt_init_weights(s->handle, s->weights, weights);
+    auto init_dense = [&](hipsparselt_matrix& desc, std::size_t rows, std::size_t cols) {
+        desc.init([&](auto* d) {
+            return hipsparseLtDenseDescriptorInit(
+                handle, d, rows, cols, rows, hipsparselt_alignment, t, HIPSPARSE_ORDER_COL);
+        });
+    };
+    init_dense(s->input, k, m);
+    init_dense(s->output, n, m);
+    hipsparselt_invoke(&hipsparseLtMatmulDescriptorInit,
+                       handle,
+                       &s->matmul,
+                       HIPSPARSE_OPERATION_NON_TRANSPOSE,
+                       HIPSPARSE_OPERATION_NON_TRANSPOSE,
+                       s->weights.get(),
+                       s->input.get(),
+                       s->output.get(),
+                       s->output.get(),
+                       HIPSPARSELT_COMPUTE_32F);
+    s->alg.init([&](auto* alg) {
+        return hipsparseLtMatmulAlgSelectionInit(
+            handle, alg, &s->matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+    });
+    s->plan.init([&](auto* plan) {
+        return hipsparseLtMatmulPlanInit(handle, plan, &s->matmul, s->alg.get());
+    });
+    std::size_t workspace_size = 0;
+    hipsparselt_invoke(&hipsparseLtMatmulGetWorkspace, handle, s->plan.get(), &workspace_size);
+    s->workspace_size = std::max<std::size_t>(workspace_size, 1);
+    state             = s;
+}
+
+argument hipsparselt_gemm::compute(context& ctx,
+                                   const shape&,
+                                   const std::vector<argument>& args) const
+{
+    if(state == nullptr)
+        MIGRAPHX_THROW(name() + ": not finalized");
+    float alpha         = 1;
+    float beta          = 0;
+    hipStream_t streams = ctx.get_stream().get();
+    auto* workspace     = state->get_workspace(streams);
+    hipsparselt_invoke(&hipsparseLtMatmul,
+                       state->handle.get(),
+                       state->plan.get(),
+                       &alpha,
+                       args[1].data(),
+                       args[0].data(),
+                       &beta,
+                       args[2].data(),
+                       args[2].data(),
+                       workspace,
+                       &streams,
+                       1);
+    return args.back();
+}
+#else
+void hipsparselt_gemm::finalize(context&, const shape&, const std::vector<shape>&) {}
+
+argument hipsparselt_gemm::compute(context&, const shape&, const std::vector<argument>&) const
+{
+    MIGRAPHX_THROW(name() + ": MIGraphX was built without hipSPARSELt");
+}
+#endif
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
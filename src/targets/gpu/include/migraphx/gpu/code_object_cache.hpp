@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_GPU_CODE_OBJECT_CACHE_HPP
+#define MIGRAPHX_GUARD_GPU_CODE_OBJECT_CACHE_HPP
+
+#include <migraphx/gpu/config.hpp>
+#include <migraphx/compile_src.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/optional.hpp>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// A content-addressed directory of compiled code objects. Entries are keyed
+// by a digest of the kernel sources, compile flags, target arch and the
+// MIGraphX version, and are evicted least recently used first once the
+// directory grows past max_size bytes. Entries are written atomically so
+// the directory can be shared across processes.
+struct MIGRAPHX_GPU_EXPORT code_object_cache
+{
+    fs::path dir;
+    std::size_t max_size = 0;
+
+    code_object_cache() = default;
+    code_object_cache(fs::path d, std::size_t msize);
+
+    // Returns the cache set with MIGRAPHX_GPU_CODE_OBJECT_CACHE or nullopt
+    static optional<code_object_cache> from_env();
+
+    static std::string make_key(const std::vector<src_file>& srcs,
+                                const std::vector<std::string>& params,
+                                const std::string& arch);
+
+    optional<std::vector<std::vector<char>>> load(const std::string& key) const;
+    void store(const std::string& key, const std::vector<std::vector<char>>& cos) const;
+    // Remove the least recently used entries until the cache fits in max_size
+    void evict() const;
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_CODE_OBJECT_CACHE_HPP
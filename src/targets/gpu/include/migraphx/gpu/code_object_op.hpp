@@ -29,12 +29,47 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/functional.hpp>
 #include <migraphx/gpu/kernel.hpp>
+#include <memory>
+#include <mutex>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 struct context;
+struct background_tuner;
+
+// A faster kernel for a code object, found by tuning it in the background while the program runs
+struct tuned_kernel
+{
+    kernel k{};
+    std::size_t global = 0;
+    std::size_t local  = 0;
+};
+
+// Shared by the copies of a code object that is still being tuned. The tuner publishes the kernel
+// it found, which is launched from then on instead of the one the op was compiled with.
+struct kernel_swap
+{
+    std::shared_ptr<background_tuner> tuner = nullptr;
+
+    std::shared_ptr<const tuned_kernel> get() const
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return tuned;
+    }
+
+    void publish(tuned_kernel tk)
+    {
+        auto p = std::make_shared<const tuned_kernel>(std::move(tk));
+        std::lock_guard<std::mutex> lock(m);
+        tuned = std::move(p);
+    }
+
+    private:
+    mutable std::mutex m;
+    std::shared_ptr<const tuned_kernel> tuned = nullptr;
+};
 
 struct code_object_op
 {
@@ -45,7 +80,11 @@ struct code_object_op
     std::vector<shape> expected_inputs{};
     shape output{};
     std::int64_t output_arg = -1;
+    // Flops of the instructions the kernel was compiled from
+    std::size_t estimated_flops = 0;
     kernel k{};
+    // Set when the kernel is tuned in the background after the program is compiled
+    std::shared_ptr<kernel_swap> swap = nullptr;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
@@ -55,13 +94,17 @@ struct code_object_op
                     f(self.global, "global"),
                     f(self.local, "local"),
                     f(self.expected_inputs, "expected_inputs"),
-                    f(self.output, "output"));
+                    f(self.output, "output"),
+                    f(self.estimated_flops, "estimated_flops"));
     }
 
-    value attributes() const { return {{"group", group()}}; }
+    // With MIGRAPHX_PERF_COUNTERS the resources of the loaded kernel are reported as counters
+    value attributes() const;
 
     std::string group() const { return "gpu::code_object::" + symbol_name; }
 
+    std::size_t flops(const std::vector<shape>&) const { return estimated_flops; }
+
     std::string name() const { return "gpu::code_object"; }
     shape compute_shape(std::vector<shape> inputs) const;
     argument
@@ -38,6 +38,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 struct shape;
 struct operation;
+struct value;
 
 namespace gpu {
 
@@ -54,6 +55,12 @@ struct vectorize
     static vectorize elements(std::size_t axis,
                               const std::vector<shape>& inputs,
                               const std::vector<std::size_t>& sizes);
+    // Use the vector_size picked by tuning when v has one
+    static vectorize
+    elements(context& ctx, std::size_t axis, const std::vector<shape>& inputs, const value& v);
+    // The vector sizes a tuned kernel can pick from
+    static std::vector<std::size_t> tunable_sizes(std::size_t axis,
+                                                  const std::vector<shape>& inputs);
     std::string str() const;
 };
 struct preload
@@ -77,7 +84,11 @@ struct tile
     std::size_t block_size = 0;
     std::vector<std::size_t> inner{};
     std::vector<std::size_t> outer{};
+    std::size_t pad        = 1;
     static tile elements(const std::vector<shape>& inputs, std::size_t noutputs);
+    // Vectorize along the last axis, reading the arguments that are not tiled directly from
+    // global memory. The tiles are padded by the vector size so they are read with the same loads.
+    vectorize vectorize_elements(context& ctx, const std::vector<shape>& inputs, const value& v);
     // bool is_preloading() const;
     std::string str() const;
 };
@@ -93,11 +104,18 @@ std::string make_transformer_args(Ts... xs)
     return make_transformer_args({xs.str()...});
 }
 
+// Writes the floats in hex for an initializer list, so a kernel uses exactly the same values as the
+// host
+std::string generate_float_list(const std::vector<float>& v);
+
 std::string
 generate_pointwise(const module& pm, const std::string& name, bool always_return_tuple = false);
 
 std::string generate_reduce(module m, const std::string& name);
 
+// Returns true for argmax and argmin, which reduce to the index of an element
+bool is_arg_reduce(const std::string& name);
+
 std::string generate_name_from_ops(const module& m, const std::string& postname = "");
 
 struct reduce_op
@@ -107,6 +125,8 @@ struct reduce_op
     std::string init      = "0";
     std::string read      = "op::id{}";
     std::string write     = "op::id{}";
+    // Arg reductions use reduce_with_index so read also gets the index of each element
+    std::string method = "reduce";
 
     void set(instruction_ref ins, const operation& op);
     void set(const std::string& name, const shape& input, const shape& output);
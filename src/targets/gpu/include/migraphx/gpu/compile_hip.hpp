@@ -67,6 +67,16 @@ compile_hip_src(const std::vector<src_file>& srcs,
                 const std::vector<std::string>& params,
                 const std::string& arch);
 
+// Returns arch followed by the additional archs from MIGRAPHX_GPU_OFFLOAD_ARCHS that kernels
+// should be compiled for. Archs with a different wavefront size than arch are left out.
+MIGRAPHX_GPU_EXPORT std::vector<std::string> get_offload_archs(const std::string& arch);
+
+// Packs one code object for each arch into a clang offload bundle, the hip runtime picks the
+// code object matching the device when the module is loaded
+MIGRAPHX_GPU_EXPORT std::vector<char>
+make_offload_bundle(const std::vector<std::string>& archs,
+                    const std::vector<std::vector<char>>& cos);
+
 MIGRAPHX_GPU_EXPORT std::string enum_params(std::size_t count, std::string param);
 
 } // namespace gpu
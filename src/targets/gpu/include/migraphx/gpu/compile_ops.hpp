@@ -31,6 +31,7 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 struct module;
+struct module_pass_manager;
 
 namespace gpu {
 
@@ -40,8 +41,13 @@ struct MIGRAPHX_GPU_EXPORT compile_ops
 {
     context* ctx         = nullptr;
     bool exhaustive_tune = false;
+    // Compile with the default solutions and tune the kernels on a background thread
+    bool background_tune = false;
+    // Compile the kernels in submodules, such as the branches of an if or the select_module
+    // variants, the first time they run
+    bool lazy_compile = false;
     std::string name() const { return "gpu::compile_ops"; }
-    void apply(module& m) const;
+    void apply(module_pass_manager& mpm) const;
 };
 
 } // namespace gpu
@@ -30,14 +30,17 @@
 #include <migraphx/shape.hpp>
 #include <migraphx/module_ref.hpp>
 #include <migraphx/operation.hpp>
+#include <migraphx/value.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 namespace gpu {
 
-operation
-compile_pointwise(context& ctx, const std::vector<migraphx::shape>& in_shapes, const_module_ref pm);
+operation compile_pointwise(context& ctx,
+                            const std::vector<migraphx::shape>& in_shapes,
+                            const_module_ref pm,
+                            const value& solution = value{});
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
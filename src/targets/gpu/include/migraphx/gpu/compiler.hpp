@@ -74,6 +74,11 @@ struct compiler_replace
     std::function<void(const compiler_replace& cr, module& m, instruction_ref ins)> replace_fn =
         nullptr;
     std::function<void(std::ostream& os, instruction_ref ins)> trace_fn = nullptr;
+    // Set when the replace function only reads the instruction it is passed, so the code objects
+    // can be reused to replace other instructions with the same structure
+    bool independent = false;
+
+    bool is_instruction_independent() const { return replace_fn == nullptr or independent; }
 
     template <class F>
     static auto make_replace(F f)
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_CONCAT_GPU_OPT_HPP
 
 #include <migraphx/op/concat.hpp>
+#include <migraphx/instruction.hpp>
 #include <migraphx/operation.hpp>
 #include <migraphx/serialize.hpp>
 
@@ -33,7 +34,8 @@ namespace gpu {
 
 struct concat_gpu_optimization
 {
-    std::string allocate() const { return "hip::allocate"; }
+    // The pass runs right after lowering, before allocations are replaced with hip::allocate
+    std::string allocate() const { return "allocate"; }
     optional<migraphx::op::concat> get_concat(const migraphx::operation& op) const
     {
         if(op.name() != "gpu::precompile_op")
@@ -43,6 +45,17 @@ struct concat_gpu_optimization
             return any_cast<migraphx::op::concat>(r);
         return nullopt;
     }
+    // rocBLAS takes the leading dimension and batch stride of the output, and pointwise kernels
+    // index the output through its shape, so both can write into a strided slice of the concat
+    bool supports_strided_output(instruction_ref ins) const
+    {
+        if(contains({"gpu::gemm", "gpu::quant_gemm"}, ins->name()))
+            return true;
+        if(ins->name() != "gpu::precompile_op")
+            return false;
+        return from_value<operation>(ins->get_operator().to_value().at("op")).name() ==
+               "pointwise";
+    }
 };
 
 } // namespace gpu
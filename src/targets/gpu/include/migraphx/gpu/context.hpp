@@ -39,8 +39,17 @@
 #include <migraphx/config.hpp>
 #include <migraphx/gpu/device_name.hpp>
 #include <migraphx/gpu/problem_cache.hpp>
+#include <migraphx/gpu/kernel_costs.hpp>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <random>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -51,6 +60,17 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_NSTREAMS)
 
 using hip_event_ptr = MIGRAPHX_MANAGE_PTR(hipEvent_t, hipEventDestroy);
 
+// Makes the device that was current when it was created current again when it goes out of scope
+struct device_guard
+{
+    int device = get_device_id();
+
+    device_guard()                               = default;
+    device_guard(const device_guard&)            = delete;
+    device_guard& operator=(const device_guard&) = delete;
+    ~device_guard() { (void)hipSetDevice(device); }
+};
+
 struct hip_device
 {
     hip_device() : device_props{} { add_stream(); }
@@ -71,26 +91,43 @@ struct hip_device
 
         stream() {}
 
-        stream(std::size_t device_number) : id(device_number) {}
+        stream(std::size_t device_number, int p = 0) : id(device_number), priority(p) {}
 
         void setup() const { set_device(id); }
 
-        static hip_stream_ptr create_stream()
+        static hip_stream_ptr create_stream(int priority = 0)
         {
             hipStream_t result = nullptr;
-            auto status        = hipStreamCreateWithFlags(&result, hipStreamNonBlocking);
+            auto status        =
+                hipStreamCreateWithPriority(&result, hipStreamNonBlocking, priority);
             if(status != hipSuccess)
                 MIGRAPHX_THROW("Failed to allocate stream");
             return hip_stream_ptr{result};
         }
 
+        // The stream and the handles bound to it are created again with the new priority
+        void set_priority(int p)
+        {
+            if(p == priority)
+                return;
+            wait();
+            priority = p;
+            s        = nullptr;
+#if MIGRAPHX_USE_MIOPEN
+            mihandle = nullptr;
+#endif
+#if MIGRAPHX_USE_ROCBLAS
+            rbhandle = nullptr;
+#endif
+        }
+
         hipStream_t get()
         {
             if(not enabled(MIGRAPHX_ENABLE_NULL_STREAM{}))
             {
                 setup();
                 if(s == nullptr)
-                    s = create_stream();
+                    s = create_stream(priority);
                 assert(s.get() != nullptr);
                 return s.get();
             }
@@ -168,6 +205,7 @@ struct hip_device
 
         private:
         std::size_t id           = 0;
+        int priority             = 0;
         shared<hip_stream_ptr> s = nullptr;
 #if MIGRAPHX_USE_MIOPEN
         shared<miopen_handle> mihandle = nullptr;
@@ -181,7 +219,13 @@ struct hip_device
 #endif
     };
 
-    void add_stream() { streams.emplace_back(device_id); }
+    void add_stream() { streams.emplace_back(device_id, priority); }
+
+    void reserve_streams(std::size_t n)
+    {
+        while(streams.size() < n)
+            add_stream();
+    }
 
     stream& get_stream() { return streams.at(current_stream); }
 
@@ -193,10 +237,21 @@ struct hip_device
 
     void set_stream(std::size_t n) { current_stream = n; }
 
+    void set_priority(int p)
+    {
+        for(auto& st : streams)
+            st.set_priority(p);
+        priority = p;
+    }
+
+    int get_priority() const { return priority; }
+
     std::size_t nstreams() const { return streams.size(); }
 
     std::size_t stream_id() const { return current_stream; }
 
+    std::size_t get_device_id() const { return device_id; }
+
     std::string get_device_name() const { return device_props.gcnArchName; }
 
     std::string get_gfx_name() const { return trim(split_string(get_device_name(), ':').front()); }
@@ -216,14 +271,50 @@ struct hip_device
 
     std::size_t get_wavefront_size() const { return device_props.warpSize; }
 
+    // Peak memory bandwidth in bytes per second, from the memory clock and bus width
+    double get_peak_bandwidth() const
+    {
+        // Double data rate
+        return 2.0 * device_props.memoryClockRate * 1000.0 * device_props.memoryBusWidth / 8.0;
+    }
+
+    // Peak fp32 vector flops per second, with each of the 64 lanes of a CU doing an fma per cycle
+    double get_peak_flops() const
+    {
+        return 2.0 * 64 * get_cu_count() * device_props.clockRate * 1000.0;
+    }
+
     private:
     std::size_t device_id      = 0;
     std::size_t current_stream = 0;
+    int priority               = 0;
     std::vector<stream> streams;
     hipDeviceProp_t device_props;
 
     public:
     std::unordered_map<std::string, argument> preallocations{};
+    std::unordered_set<std::string> literal_preallocations{};
+    // Bytes of the code objects of each module loaded on the device for the kernels. A module is
+    // counted once however many kernels share it or how often they are finalized, and stops being
+    // counted once it is unloaded.
+    std::map<std::weak_ptr<const void>, std::size_t, std::owner_less<>> code_objects{};
+    std::shared_ptr<literal_uploader> uploader = nullptr;
+    std::shared_ptr<param_stager> stager       = nullptr;
+
+    void add_code_object(const std::shared_ptr<const void>& module, std::size_t bytes)
+    {
+        for(auto it = code_objects.begin(); it != code_objects.end();)
+            it = it->first.expired() ? code_objects.erase(it) : std::next(it);
+        code_objects[module] = bytes;
+    }
+
+    std::size_t code_object_bytes() const
+    {
+        return std::accumulate(
+            code_objects.begin(), code_objects.end(), std::size_t{0}, [](auto n, const auto& p) {
+                return p.first.expired() ? n : n + p.second;
+            });
+    }
 };
 
 struct context
@@ -246,7 +337,8 @@ struct context
         : current_device(std::make_shared<hip_device>(device_id, n)),
           begin_event(create_event()),
           finish_event(create_event()),
-          pc(std::make_shared<auto_save_problem_cache>())
+          pc(std::make_shared<auto_save_problem_cache>()),
+          costs(std::make_shared<kernel_costs>())
     {
     }
 
@@ -277,6 +369,20 @@ struct context
 
     void set_stream(std::size_t n) { get_current_device().set_stream(n); }
 
+    // Lower values are higher priorities, which are clamped to the range the device supports
+    void set_priority(int priority)
+    {
+        auto& device = get_current_device();
+        if(priority == device.get_priority())
+            return;
+        int least    = 0;
+        int greatest = 0;
+        auto status  = hipDeviceGetStreamPriorityRange(&least, &greatest);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to get stream priority range: " + hip_error(status));
+        device.set_priority(std::clamp(priority, greatest, least));
+    }
+
     void create_events(std::size_t num_of_events)
     {
         for(std::size_t i = events.size(); i < num_of_events + 1; ++i)
@@ -312,6 +418,9 @@ struct context
         result["events"]  = events.size();
         result["streams"] = current_device->nstreams();
         result["gfx_name"] = get_current_device().get_gfx_name();
+        // Used by perf_report for the roofline
+        result["peak_bandwidth"] = get_current_device().get_peak_bandwidth();
+        result["peak_flops"]     = get_current_device().get_peak_flops();
 
         return result;
     }
@@ -335,7 +444,10 @@ struct context
         if(status != hipSuccess)
             MIGRAPHX_THROW("failed to record " + hip_error(status));
 
-        get_stream().wait(begin_event.get());
+        // Any stream can run the first instructions, not only the current one
+        auto& device = get_current_device();
+        for(std::size_t i = 0; i < device.nstreams(); i++)
+            device.get_stream(i).wait(begin_event.get());
     }
 
     void finish_on(any_ptr queue)
@@ -347,8 +459,101 @@ struct context
             MIGRAPHX_THROW("Failed to wait on event " + hip_error(status));
     }
 
+    // The callback runs on a thread of the runtime, which blocks the queue until it returns and
+    // can't report errors back
+    static void run_host_callback(void* data)
+    {
+        std::unique_ptr<std::function<void()>> callback{static_cast<std::function<void()>*>(data)};
+        try
+        {
+            (*callback)();
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << "Completion callback failed: " << e.what() << std::endl;
+        }
+    }
+
+    void on_finish(any_ptr queue, std::function<void()> callback)
+    {
+        auto data   = std::make_unique<std::function<void()>>(std::move(callback));
+        auto status = hipLaunchHostFunc(queue.get<hipStream_t>(), &run_host_callback, data.get());
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to launch host callback " + hip_error(status));
+        data.release(); // NOLINT(bugprone-unused-return-value)
+    }
+
     any_ptr get_queue() { return get_stream().get(); }
 
+    value memory_usage() const
+    {
+        const auto& device   = get_current_device();
+        std::size_t scratch  = 0;
+        std::size_t literals = 0;
+        for(const auto& [id, a] : device.preallocations)
+        {
+            if(device.literal_preallocations.count(id) > 0)
+                literals += a.get_shape().bytes();
+            else
+                scratch += a.get_shape().bytes();
+        }
+        value result;
+        result["scratch"]      = scratch;
+        result["literals"]     = literals;
+        result["code_objects"] = device.code_object_bytes();
+        return result;
+    }
+
+    // Create a context that can run the same compiled program concurrently
+    // with this one. The literals already on the device are shared, while the
+    // streams, events and scratch memory are private to the new context.
+    context create_session() const
+    {
+        wait_for_literals(*this);
+        context result        = *this;
+        const auto& device    = get_current_device();
+        result.current_device =
+            std::make_shared<hip_device>(device.get_device_id(), device.nstreams());
+        auto& session_device  = result.get_current_device();
+        for(const auto& [id, a] : device.preallocations)
+        {
+            if(device.literal_preallocations.count(id) > 0)
+                session_device.preallocations[id] = a;
+            else
+                session_device.preallocations[id] = allocate_gpu(a.get_shape());
+        }
+        session_device.literal_preallocations = device.literal_preallocations;
+        session_device.code_objects           = device.code_objects;
+        session_device.set_priority(device.get_priority());
+        std::generate(result.events.begin(), result.events.end(), &create_event);
+        result.begin_event  = create_event();
+        result.finish_event = create_event();
+        return result;
+    }
+
+    // Create a context for running a copy of the compiled program on another device. It
+    // shares the problem cache and settings, but starts with nothing loaded on the device, so
+    // the program has to be finalized again with it. The current device is restored afterwards.
+    context create_replica(std::size_t device_id) const
+    {
+        device_guard guard;
+        set_device(device_id);
+        context result        = *this;
+        const auto& device    = get_current_device();
+        result.current_device = std::make_shared<hip_device>(device_id, device.nstreams());
+        result.get_current_device().set_priority(device.get_priority());
+        std::generate(result.events.begin(), result.events.end(), &create_event);
+        result.begin_event  = create_event();
+        result.finish_event = create_event();
+        if(measure_perf)
+        {
+            result.start_event = create_event_for_timing();
+            result.stop_event  = create_event_for_timing();
+        }
+        result.literals.clear();
+        return result;
+    }
+
     std::pair<hipEvent_t, hipEvent_t> get_perf_events() const
     {
         if(measure_perf)
@@ -375,6 +580,13 @@ struct context
         pc->auto_save = true;
     }
 
+    kernel_costs& get_kernel_costs() { return *costs; }
+    const kernel_costs& get_kernel_costs() const { return *costs; }
+
+    // Every call gives a new seed for the random number generators on the device. Sessions
+    // share the offset so they never draw the same sequence.
+    std::uint64_t next_random_seed() { return random_seed + (*random_offset)++; }
+
     private:
     // TODO: Make this a vector to support multiple devices
     std::shared_ptr<hip_device> current_device;
@@ -388,6 +600,10 @@ struct context
     shared<hip_event_ptr> begin_event  = nullptr;
     shared<hip_event_ptr> finish_event = nullptr;
     std::shared_ptr<auto_save_problem_cache> pc = nullptr;
+    std::shared_ptr<kernel_costs> costs         = nullptr;
+    std::uint64_t random_seed                   = std::random_device{}();
+    std::shared_ptr<std::atomic<std::uint64_t>> random_offset =
+        std::make_shared<std::atomic<std::uint64_t>>(0);
 };
 
 inline void migraphx_to_value(value& v, const context& ctx) { v = ctx.to_value(); }
@@ -27,7 +27,7 @@
 #include <migraphx/shape.hpp>
 #include <migraphx/op/contiguous.hpp>
 #include <migraphx/gpu/oper.hpp>
-#include <migraphx/gpu/device/contiguous.hpp>
+#include <migraphx/gpu/hip.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -35,7 +35,7 @@ namespace gpu {
 
 struct context;
 
-struct miopen_contiguous : unary_device<miopen_contiguous, &device::contiguous>
+struct miopen_contiguous : device_base<miopen_contiguous, 1>
 {
     std::string name() const { return "gpu::contiguous"; }
     shape compute_shape(const std::vector<shape>& inputs) const
@@ -45,6 +45,17 @@ struct miopen_contiguous : unary_device<miopen_contiguous, &device::contiguous>
         auto t    = inputs.at(0).type();
         return {t, lens};
     }
+    argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
+    {
+        gpu_copy(ctx, this->get_arg(args, 0), this->get_arg(args, 1));
+        return args[1];
+    }
+    void finalize(context& ctx, const shape& output_shape, const std::vector<shape>& inputs)
+    {
+        device_base::finalize(ctx, output_shape, inputs);
+        const auto& shapes = reduce_shapes.empty() ? inputs : reduce_shapes;
+        compile_copy(ctx, shapes[0], shapes[1]);
+    }
 };
 
 } // namespace gpu
@@ -34,6 +34,7 @@
 #include <migraphx/op/convolution_backwards.hpp>
 #include <unordered_map>
 #include <migraphx/reflect.hpp>
+#include <migraphx/serialize.hpp>
 #include <migraphx/gpu/context.hpp>
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -78,6 +79,11 @@ struct miopen_convolution
 
     std::string name() const { return "gpu::" + op.name(); }
 
+    std::size_t flops(const std::vector<shape>& inputs) const
+    {
+        return operation{op}.flops({inputs.at(0), inputs.at(1)});
+    }
+
     inline shape compute_shape(const std::vector<shape>& inputs) const
     {
         check_shapes{inputs, op}.has(4);
@@ -150,13 +156,48 @@ struct miopen_convolution
             (op.name() == "convolution_backwards") ? make_convolution_backwards(op) : make_conv(op);
     }
 
+    // Convolutions with the same problem share the solution found for the first one, which is
+    // also kept in the problem cache so later compiles don't run the find again
     value compile(migraphx::context& ctx, const shape& output, const std::vector<shape>& input)
     {
         set_conv_descriptor();
-        auto ws = find(any_cast<migraphx::gpu::context>(ctx), output, input);
+        auto& gctx = any_cast<migraphx::gpu::context>(ctx);
+        auto& pc   = gctx.get_problem_cache();
+        value problem{{"op", to_value(op)},
+                      {"inputs", to_value(std::vector<shape>{input.at(0), input.at(1), output})}};
+        auto solution = pc.get(name(), problem);
+        if(solution.has_value() and not solution->is_null())
+        {
+            load_solution(*solution);
+            return {{"workspace", solution->at("workspace")}};
+        }
+        auto ws = find(gctx, output, input);
+        pc.insert(name(), problem, save_solution(ws));
         return {{"workspace", ws.bytes()}};
     }
 
+    value save_solution(const shape& workspace) const
+    {
+        value result;
+        result["workspace"]   = workspace.bytes();
+        result["algo"]        = to_value(algo);
+        result["solution_id"] = solution_id;
+#ifdef MIGRAPHX_HAS_FIND_2_API
+        result["solution_object"] = solution_object;
+#endif
+        return result;
+    }
+
+    void load_solution(const value& v)
+    {
+        from_value(v.at("algo"), algo);
+        solution_id = v.at("solution_id").to<uint64_t>();
+#ifdef MIGRAPHX_HAS_FIND_2_API
+        solution_object = v.at("solution_object").get_binary();
+        solution_ptr    = nullptr;
+#endif
+    }
+
     shape find(context& ctx, const shape& output_shape, const std::vector<shape>& inputs)
     {
         shape workspace_shape{};
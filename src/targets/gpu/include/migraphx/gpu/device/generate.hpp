@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,23 +21,24 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_DEVICE_ARGMIN_HPP
-#define MIGRAPHX_GUARD_RTGLIB_DEVICE_ARGMIN_HPP
+#ifndef MIGRAPHX_GUARD_RTGLIB_DEVICE_GENERATE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DEVICE_GENERATE_HPP
 
 #include <migraphx/argument.hpp>
 #include <migraphx/gpu/device/config.hpp>
 #include <hip/hip_runtime_api.h>
+#include <cstdint>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 namespace device {
 
-void MIGRAPHX_DEVICE_EXPORT argmin(hipStream_t stream,
-                                   const argument& result,
-                                   const argument& arg,
-                                   int64_t axis,
-                                   bool select_last_index);
+// Fills the buffer with pseudo-random values in the same ranges as random_mode::random, but
+// hashed from the seed and the element index so each element is computed independently
+void MIGRAPHX_DEVICE_EXPORT generate(hipStream_t stream,
+                                     const argument& result,
+                                     std::uint64_t seed);
 
 } // namespace device
 } // namespace gpu
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,39 +21,33 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_MULTINOMIAL_HPP
-#define MIGRAPHX_GUARD_RTGLIB_MULTINOMIAL_HPP
+#ifndef MIGRAPHX_GUARD_GPU_ELIMINATE_FILL_HPP
+#define MIGRAPHX_GUARD_GPU_ELIMINATE_FILL_HPP
 
-#include <migraphx/op/multinomial.hpp>
+#include <migraphx/gpu/config.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-
-struct context;
 
-struct hip_multinomial
-{
-    op::multinomial op;
+struct module;
 
-    template <class Self, class F>
-    static auto reflect(Self& self, F f)
-    {
-        return migraphx::reflect(self.op, f);
-    }
+namespace gpu {
 
-    std::string name() const { return "gpu::multinomial"; }
-    shape compute_shape(std::vector<shape> inputs) const;
-    argument
-    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const;
-    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
-    {
-        return shapes.size() - 1;
-    }
+/**
+ * Remove hip::fill instructions whose buffer is completely overwritten by the
+ * next write before it is read, such as a fill followed by another fill or a
+ * full copy. Zero fills that run back to back on adjacent ranges of the same
+ * scratch memory are merged into a single fill, so this runs after
+ * memory_coloring.
+ */
+struct MIGRAPHX_GPU_EXPORT eliminate_fill
+{
+    std::string name() const { return "gpu::eliminate_fill"; }
+    void apply(module& m) const;
 };
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
-
-#endif
+#endif // MIGRAPHX_GUARD_GPU_ELIMINATE_FILL_HPP
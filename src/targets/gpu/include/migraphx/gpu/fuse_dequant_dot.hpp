@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,32 +21,32 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/shape.hpp>
-#include <migraphx/argument.hpp>
-#include <migraphx/gpu/device/argmin.hpp>
-#include <migraphx/gpu/device/tensor.hpp>
-#include <migraphx/gpu/device/launch.hpp>
-#include <migraphx/gpu/device/types.hpp>
-#include <migraphx/gpu/device/arg_op.hpp>
+#ifndef MIGRAPHX_GUARD_GPU_FUSE_DEQUANT_DOT_HPP
+#define MIGRAPHX_GUARD_GPU_FUSE_DEQUANT_DOT_HPP
+
+#include <migraphx/gpu/config.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
 namespace gpu {
-namespace device {
 
-void argmin(hipStream_t stream,
-            const argument& result,
-            const argument& arg,
-            int64_t axis,
-            bool select_last_index)
+/**
+ * Fuse dots whose weights are dequantized from int8 or packed int4 values
+ * into a gpu::dequant_dot, which reads the quantized weights along with their
+ * scales and zero points and dequantizes them in registers. This keeps the
+ * weights quantized in memory instead of storing them in full precision.
+ */
+struct MIGRAPHX_GPU_EXPORT fuse_dequant_dot
 {
-    if(select_last_index)
-        arg_op(argmin_op_last_index{}, stream, result, arg, axis);
-    else
-        arg_op(argmin_op_first_index{}, stream, result, arg, axis);
-}
+    std::string name() const { return "gpu::fuse_dequant_dot"; }
+    void apply(module& m) const;
+};
 
-} // namespace device
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_FUSE_DEQUANT_DOT_HPP
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,41 +21,36 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_ARGMAX_HPP
-#define MIGRAPHX_GUARD_RTGLIB_ARGMAX_HPP
+#ifndef MIGRAPHX_GUARD_GPU_FUSE_HORIZONTAL_POINTWISE_HPP
+#define MIGRAPHX_GUARD_GPU_FUSE_HORIZONTAL_POINTWISE_HPP
 
-#include <migraphx/argument.hpp>
-#include <migraphx/reflect.hpp>
-#include <migraphx/op/argmax.hpp>
-#include <migraphx/gpu/device/argmax.hpp>
+#include <migraphx/gpu/config.hpp>
+#include <cstddef>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-
-struct context;
 
-struct hip_argmax
-{
-    op::argmax op;
+struct module;
 
-    template <class Self, class F>
-    static auto reflect(Self& self, F f)
-    {
-        return migraphx::reflect(self.op, f);
-    }
+namespace gpu {
 
-    std::string name() const { return "gpu::argmax"; }
-    shape compute_shape(const std::vector<shape>& inputs) const;
-    argument compute(context& ctx, const shape&, const std::vector<argument>& args) const;
-    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
-    {
-        return shapes.size() - 1;
-    }
+/**
+ * Pack small pointwise kernels that don't depend on each other into a single
+ * gpu::horizontal_pointwise launch. Each kernel runs on its own range of
+ * workgroups and writes to its own element of a tuple output, which saves a
+ * launch and the underutilized tail of each kernel.
+ */
+struct MIGRAPHX_GPU_EXPORT fuse_horizontal_pointwise
+{
+    // Kernels with more elements than this already fill the device
+    std::size_t max_elements = 64 * 1024;
+    std::size_t max_kernels  = 8;
+    std::string name() const { return "gpu::fuse_horizontal_pointwise"; }
+    void apply(module& m) const;
 };
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
-
-#endif
+#endif // MIGRAPHX_GUARD_GPU_FUSE_HORIZONTAL_POINTWISE_HPP
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,41 +21,37 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_ARGMIN_HPP
-#define MIGRAPHX_GUARD_RTGLIB_ARGMIN_HPP
+#ifndef MIGRAPHX_GUARD_GPU_FUSE_SMALL_GEMM_HPP
+#define MIGRAPHX_GUARD_GPU_FUSE_SMALL_GEMM_HPP
 
-#include <migraphx/argument.hpp>
-#include <migraphx/reflect.hpp>
-#include <migraphx/op/argmin.hpp>
-#include <migraphx/gpu/device/argmin.hpp>
+#include <migraphx/gpu/config.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-struct context;
+struct module_pass_manager;
 
-struct hip_argmin
-{
-    op::argmin op;
+namespace gpu {
 
-    template <class Self, class F>
-    static auto reflect(Self& self, F f)
-    {
-        return migraphx::reflect(self.op, f);
-    }
+/**
+ * Replace small dots with a gpu::small_gemm, which is compiled into a jit
+ * kernel instead of being dispatched to rocBLAS. A pointwise module that
+ * computes the first input of the dot and a pointwise module that only reads
+ * the result of the dot are fused into the same kernel.
+ */
+struct MIGRAPHX_GPU_EXPORT fuse_small_gemm
+{
+    // Largest number of rows of the output of each gemm in the batch
+    std::size_t max_m = 64;
+    // Largest number of elements of the second input of each gemm in the batch
+    std::size_t max_nk = 256 * 1024;
 
-    std::string name() const { return "gpu::argmin"; }
-    shape compute_shape(const std::vector<shape>& inputs) const;
-    argument compute(context& ctx, const shape&, const std::vector<argument>& args) const;
-    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
-    {
-        return shapes.size() - 1;
-    }
+    std::string name() const { return "gpu::fuse_small_gemm"; }
+    void apply(module_pass_manager& mpm) const;
 };
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
-
-#endif
+#endif // MIGRAPHX_GUARD_GPU_FUSE_SMALL_GEMM_HPP
@@ -72,10 +72,18 @@ struct rocblas_gemm
         return "gpu::gemm";
     }
 
+    std::size_t flops(const std::vector<shape>& inputs) const
+    {
+        return op.flops({inputs.at(0), inputs.at(1)});
+    }
+
+    // The inputs are {a, b, c..., workspace, allocation}, where the workspace is handed to
+    // rocBLAS so it is planned with the rest of the scratch memory
     shape compute_shape(const std::vector<shape>& inputs) const
     {
         std::vector<shape> in_shapes(inputs);
         in_shapes.pop_back();
+        in_shapes.pop_back();
         // When input shapes are A, B, C the GEMM equation is  C  =  α AB+ β C   where α, β are
         // scalars
         check_shapes{in_shapes, *this}.has(2, 3);
@@ -133,7 +141,22 @@ struct rocblas_gemm
 #ifdef MIGRAPHX_USE_ROCBLAS_TUNING_API
         if(solution_idx == 0)
             solution_idx = gemm_default_solution(ctx, output_shape, input_shapes);
-        if(enabled(MIGRAPHX_ENABLE_GEMM_TUNING{}) or ctx.get_exhaustive_tune_flag())
+        bool tuning = enabled(MIGRAPHX_ENABLE_GEMM_TUNING{}) or ctx.get_exhaustive_tune_flag();
+        // Untuned shapes borrow the solution of the closest tuned one, unless they are tuned now
+        if(solution_idx == 0 and not tuning)
+        {
+            if(this->name() == "gpu::gemm")
+            {
+                solution_idx = gemm_nearest_solution(
+                    ctx, output_shape, input_shapes, alpha, beta, compute_fp32);
+            }
+            else
+            {
+                solution_idx = gemm_nearest_solution(
+                    ctx, output_shape, input_shapes, int32_t(alpha), int32_t(beta), compute_fp32);
+            }
+        }
+        if(tuning)
         {
             if(this->name() == "gpu::gemm")
             {
@@ -83,10 +83,37 @@ int32_t gemm_finalize(context& ctx,
                       bool compute_fp32,
                       int32_t solution_idx);
 
+/**
+ * @brief Returns the workspace in bytes that rocBLAS needs for the default solution of the gemm.
+ *
+ * @param input_shapes The inputs of the gemm followed by the output, without the workspace.
+ */
+std::size_t
+gemm_workspace_size(context& ctx, const std::vector<shape>& input_shapes, bool compute_fp32);
+
 int32_t gemm_default_solution(context& ctx,
                               const shape& output_shape,
                               const std::vector<shape>& input_shapes);
 
+/**
+ * @brief Returns the tuned solution of the closest problem in the problem cache with the same
+ * types and layouts, or 0 when there is none that is valid for the gemm. Used for shapes that
+ * were not tuned, such as the buckets of dynamic programs.
+ */
+int32_t gemm_nearest_solution(context& ctx,
+                              const shape& output_shape,
+                              const std::vector<shape>& input_shapes,
+                              float alpha,
+                              float beta,
+                              bool compute_fp32);
+
+int32_t gemm_nearest_solution(context& ctx,
+                              const shape& output_shape,
+                              const std::vector<shape>& input_shapes,
+                              int32_t alpha,
+                              int32_t beta,
+                              bool compute_fp32);
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
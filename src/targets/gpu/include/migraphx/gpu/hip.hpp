@@ -30,6 +30,8 @@
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/functional.hpp>
 #include <migraphx/dyn_output.hpp>
+#include <migraphx/optional.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace migraphx {
@@ -37,11 +39,25 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 struct context;
+struct literal_uploader;
+struct param_stager;
 
 MIGRAPHX_GPU_EXPORT std::string hip_error(int error);
 
+MIGRAPHX_GPU_EXPORT bool is_device_ptr(const void* ptr);
+
+// Checks for page-locked host memory, which the gpu can read with an asynchronous DMA
+MIGRAPHX_GPU_EXPORT bool is_pinned_ptr(const void* ptr);
+
 MIGRAPHX_GPU_EXPORT argument allocate_gpu(const shape& s, bool host = false);
 
+// Allocates page-locked host memory so copies from it to the gpu skip the staging buffers
+MIGRAPHX_GPU_EXPORT argument allocate_pinned(const shape& s);
+
+// Gives the memory cached by the allocator for the current device, and the cached pinned host
+// memory, back to hip. Buffers that are still in use stay allocated.
+MIGRAPHX_GPU_EXPORT void trim_memory_pools();
+
 MIGRAPHX_GPU_EXPORT argument register_on_gpu(const argument& arg);
 
 MIGRAPHX_GPU_EXPORT argument to_gpu(const argument& arg, bool host = false);
@@ -50,16 +66,43 @@ MIGRAPHX_GPU_EXPORT argument from_gpu(const argument& arg);
 
 MIGRAPHX_GPU_EXPORT void set_device(std::size_t id);
 
+// Make the device the context runs on the current one, so allocations are made on it
+MIGRAPHX_GPU_EXPORT void set_device(context& ctx);
+
 MIGRAPHX_GPU_EXPORT void gpu_sync();
 MIGRAPHX_GPU_EXPORT void gpu_sync(const context& ctx);
 
 MIGRAPHX_GPU_EXPORT void gpu_copy(context& ctx, const argument& src, const argument& dst);
+// Compiles the kernel gpu_copy uses for the shapes on the current device, so it is not compiled
+// while the program runs
+MIGRAPHX_GPU_EXPORT void compile_copy(context& ctx, const shape& src, const shape& dst);
 MIGRAPHX_GPU_EXPORT void copy_to_gpu(context& ctx, const argument& src, const argument& dst);
 MIGRAPHX_GPU_EXPORT void copy_from_gpu(context& ctx, const argument& src, const argument& dst);
+// Copies host memory to the gpu through pinned staging buffers that are kept on
+// the context, so the transfer is asynchronous to the host
+MIGRAPHX_GPU_EXPORT void staged_copy_to_gpu(context& ctx, const argument& src, const argument& dst);
 
 MIGRAPHX_GPU_EXPORT argument get_preallocation(context& ctx, const std::string& id);
 
-MIGRAPHX_GPU_EXPORT void gpu_fill(context& ctx, const argument& dst, int value = 0);
+// Starts an asynchronous upload of the literal to the gpu, which must be
+// waited on with wait_for_literals before the data is used
+MIGRAPHX_GPU_EXPORT argument upload_literal(context& ctx, const literal& l);
+MIGRAPHX_GPU_EXPORT void wait_for_literals(const context& ctx);
+// Copies the literal into pinned host memory, which the gpu can copy from asynchronously
+MIGRAPHX_GPU_EXPORT argument pin_literal(const literal& l);
+
+MIGRAPHX_GPU_EXPORT void gpu_fill(context& ctx, const argument& dst, double value = 0);
+// Compiles the kernel that filling the shape needs, when its elements are wider than 32 bits. When
+// the value is not known, as for random seeds, it is compiled for any value.
+MIGRAPHX_GPU_EXPORT void
+compile_fill(context& ctx, const shape& dst, optional<double> value = nullopt);
+
+// Fills the buffer with random values generated on the gpu, so large inputs don't need to be
+// generated on the host and copied
+MIGRAPHX_GPU_EXPORT void gpu_generate(context& ctx, const argument& dst, unsigned long seed);
+
+// Writes the next seed of the context's random number generators
+MIGRAPHX_GPU_EXPORT void gpu_random_seed(context& ctx, const argument& dst);
 
 struct hip_allocate
 {
@@ -77,15 +120,16 @@ struct hip_allocate
         check_shapes{inputs, *this}.has(0);
         return s;
     }
-    argument compute(context&, const shape& output_shape, const std::vector<argument>&) const
+    argument compute(context& ctx, const shape& output_shape, const std::vector<argument>&) const
     {
+        set_device(ctx);
         return allocate_gpu(output_shape);
     }
 };
 
 struct hip_fill
 {
-    int value = 0;
+    double value = 0;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
@@ -104,6 +148,30 @@ struct hip_fill
         gpu_fill(ctx, args.front(), value);
         return args.front();
     }
+    void finalize(context& ctx, const shape&, const std::vector<shape>& inputs) const
+    {
+        compile_fill(ctx, inputs.front(), value);
+    }
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 0; }
+};
+
+struct hip_random_seed
+{
+    std::string name() const { return "hip::random_seed"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).packed();
+        return inputs.front();
+    }
+    argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
+    {
+        gpu_random_seed(ctx, args.front());
+        return args.front();
+    }
+    void finalize(context& ctx, const shape&, const std::vector<shape>& inputs) const
+    {
+        compile_fill(ctx, inputs.front());
+    }
     std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 0; }
 };
 
@@ -136,6 +204,15 @@ struct hip_sync_stream
 
 struct hip_copy_to_gpu
 {
+    // Copy through pinned staging buffers instead of registering the host memory
+    bool staged = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.staged, "staged"));
+    }
+
     std::string name() const { return "hip::copy_to_gpu"; }
     shape compute_shape(std::vector<shape> inputs) const
     {
@@ -144,6 +221,17 @@ struct hip_copy_to_gpu
     }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
+        if(args.size() == 2 and not args[1].get_shape().dynamic() and
+           is_pinned_ptr(args[0].data()))
+        {
+            copy_to_gpu(ctx, args[0], args[1]);
+            return args[1];
+        }
+        if(staged and args.size() == 2 and not args[1].get_shape().dynamic())
+        {
+            staged_copy_to_gpu(ctx, args[0], args[1]);
+            return args[1];
+        }
         auto input = register_on_gpu(args[0]);
         if(args.size() == 1)
             return input;
@@ -156,6 +244,11 @@ struct hip_copy_to_gpu
         // Associate the input since it was registered with hip
         return {result.get_shape(), [input, result]() mutable { return result.data(); }};
     }
+    void finalize(context& ctx, const shape&, const std::vector<shape>& inputs) const
+    {
+        if(inputs.size() == 2)
+            compile_copy(ctx, inputs[0], inputs[1]);
+    }
     std::ptrdiff_t output_alias(const std::vector<shape>& args) const
     {
         if(args.size() == 1)
@@ -189,6 +282,10 @@ struct hip_copy_from_gpu
         copy_from_gpu(ctx, input, args[1]);
         return args[1];
     }
+    void finalize(context& ctx, const shape&, const std::vector<shape>& inputs) const
+    {
+        compile_copy(ctx, inputs.front(), inputs.back());
+    }
     std::ptrdiff_t output_alias(const std::vector<shape>& args) const
     {
         if(args.size() == 1)
@@ -202,13 +299,60 @@ struct hip_copy
     std::string name() const { return "hip::copy"; }
     shape compute_shape(std::vector<shape> inputs) const
     {
-        check_shapes{inputs, *this}.has(2).same_type();
+        check_shapes{inputs, *this, true}.has(2).same_type();
         return inputs.at(1);
     }
     argument compute(context& ctx, const shape&, std::vector<argument> args) const
     {
-        gpu_copy(ctx, args[0], args[1]);
-        return args[1];
+        argument result = args[1];
+        if(result.get_shape().dynamic())
+            result = result.reshape(args[0].get_shape());
+        gpu_copy(ctx, args[0], result);
+        return result;
+    }
+    void finalize(context& ctx, const shape&, const std::vector<shape>& inputs) const
+    {
+        compile_copy(ctx, inputs[0], inputs[1]);
+    }
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 1; }
+};
+
+/**
+ * Copies the input into a buffer laid out for the smallest of `sizes` that fits the `axis`
+ * dimension, zeroing the padding. The result has the actual lens with the strides of the padded
+ * shape, so it can be reinterpreted as the padded shape in place.
+ */
+struct hip_pad_copy
+{
+    std::size_t axis = 0;
+    std::vector<std::size_t> sizes;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"), f(self.sizes, "sizes"));
+    }
+
+    std::string name() const { return "hip::pad_copy"; }
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this, true}.has(2).same_type();
+        return inputs.at(1);
+    }
+    argument compute(context& ctx, const shape&, std::vector<argument> args) const
+    {
+        const auto& s = args[0].get_shape();
+        auto lens     = s.lens();
+        auto it       = std::find_if(
+            sizes.begin(), sizes.end(), [&](auto size) { return size >= lens.at(axis); });
+        if(it == sizes.end() or *it == lens.at(axis))
+            return hip_copy{}.compute(ctx, s, args);
+        lens[axis] = *it;
+        shape padded{s.type(), lens};
+        gpu_fill(ctx, args[1].reshape(padded));
+        argument result = args[1].reshape({s.type(), s.lens(), padded.strides()});
+        gpu_copy(ctx, args[0], result);
+        return result;
     }
     std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 1; }
 };
@@ -216,6 +360,10 @@ struct hip_copy
 MIGRAPHX_GPU_EXPORT void
 store_preallocated_param(context& ctx, const std::string& id, const argument& a);
 
+// Literals are read-only so they are shared with sessions created from the context
+MIGRAPHX_GPU_EXPORT void
+store_preallocated_literal(context& ctx, const std::string& id, const argument& a);
+
 struct hip_allocate_memory
 {
     shape s;
@@ -241,6 +389,7 @@ struct hip_allocate_memory
 
     void finalize(context& ctx, const shape&, const std::vector<shape>&) const
     {
+        set_device(ctx);
         argument a = allocate_gpu(s);
         store_preallocated_param(ctx, id, a);
     }
@@ -266,13 +415,13 @@ struct hip_copy_literal
 
     argument compute(context& ctx, const shape&, const std::vector<argument>&) const
     {
+        wait_for_literals(ctx);
         return get_preallocation(ctx, id);
     }
 
     void finalize(context& ctx, const shape&, const std::vector<shape>&) const
     {
-        argument a = to_gpu(l.get_argument());
-        store_preallocated_param(ctx, id, a);
+        store_preallocated_literal(ctx, id, upload_literal(ctx, l));
     }
     friend std::ostream& operator<<(std::ostream& os, const hip_copy_literal& x)
     {
@@ -281,6 +430,46 @@ struct hip_copy_literal
     }
 };
 
+/**
+ * Keeps the literal in pinned host memory and copies it into the device buffer passed as the
+ * input each time it runs, for weights that don't fit on the device with the rest of the model.
+ */
+struct hip_stream_literal
+{
+    literal l;
+    std::string id{};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.l, "literal"), f(self.id, "id"));
+    }
+
+    std::string name() const { return "hip::stream_literal"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(1);
+        return l.get_shape();
+    }
+
+    argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
+    {
+        copy_to_gpu(ctx, get_preallocation(ctx, id), args[0]);
+        return args[0];
+    }
+
+    void finalize(context& ctx, const shape&, const std::vector<shape>&) const
+    {
+        store_preallocated_literal(ctx, id, pin_literal(l));
+    }
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 0; }
+    friend std::ostream& operator<<(std::ostream& os, const hip_stream_literal& x)
+    {
+        os << x.name() << "[id=" << x.id << "]";
+        return os;
+    }
+};
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -48,16 +48,24 @@ struct hip_gemm
     Op op;
     float alpha          = 1;
     float beta           = 0;
-    int32_t solution_idx = 0;
+    int32_t solution_idx   = 0;
+    bool bias              = false;
+    std::string activation = {};
+    bool scale             = false;
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
         return pack_join(migraphx::reflect(self.op, f),
                          pack(f(self.alpha, "alpha"),
                               f(self.beta, "beta"),
-                              f(self.solution_idx, "solution_idx")));
+                              f(self.solution_idx, "solution_idx"),
+                              f(self.bias, "bias"),
+                              f(self.activation, "activation"),
+                              f(self.scale, "scale")));
     }
 
+    hip_gemm_epilogue epilogue() const { return {bias, activation, scale}; }
+
     std::string name() const
     {
         if(contains(op.name(), "quant_"))
@@ -67,11 +75,43 @@ struct hip_gemm
         return "gpu::hip_gemm";
     }
 
+    std::size_t flops(const std::vector<shape>& inputs) const
+    {
+        return op.flops({inputs.at(0), inputs.at(1)});
+    }
+
     shape compute_shape(const std::vector<shape>& inputs) const
     {
         std::vector<shape> in_shapes(inputs);
         in_shapes.pop_back();
         in_shapes.pop_back();
+        if(not contains({"", "relu"}, activation))
+            MIGRAPHX_THROW(this->name() + ": unsupported activation: " + activation);
+        if(scale)
+        {
+            check_shapes{in_shapes, *this}.has(3, 4);
+            auto scale_shape = in_shapes.back();
+            in_shapes.pop_back();
+            if(scale_shape.type() != shape::float_type or scale_shape.element_space() != 1)
+                MIGRAPHX_THROW(this->name() + ": scale must be a single float");
+        }
+        if(bias)
+        {
+            check_shapes{in_shapes, *this}.has(3);
+            auto bias_shape = in_shapes.back();
+            in_shapes.pop_back();
+            auto op_out_shape   = op.compute_shape(in_shapes);
+            const auto& strides = bias_shape.strides();
+            if(bias_shape.lens() != op_out_shape.lens() or strides.back() != 1 or
+               std::any_of(strides.begin(), strides.end() - 1, [](auto s) { return s != 0; }))
+                MIGRAPHX_THROW(this->name() + ": bias must be broadcasted along the rows of {" +
+                               to_string_range(op_out_shape.lens()) + "}");
+            if(bias_shape.type() != op_out_shape.type())
+                MIGRAPHX_THROW(this->name() + ": bias type mismatch");
+            blas_shape_hip(inputs[0]);
+            blas_shape_hip(inputs[1]);
+            return op_out_shape;
+        }
         // When input shapes are A, B, C the GEMM equation is  C  =  α AB+ β C   where α, β are
         // scalars
         check_shapes{in_shapes, *this}.has(2, 3);
@@ -107,7 +147,7 @@ struct hip_gemm
     argument
     compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
     {
-        hip_gemm_compute(ctx, output_shape, args, alpha, beta, solution_idx);
+        hip_gemm_compute(ctx, output_shape, args, alpha, beta, solution_idx, epilogue());
         return args.back();
     }
 
@@ -119,11 +159,18 @@ struct hip_gemm
     void finalize(context& ctx, const shape& output_shape, const std::vector<shape>& input_shapes)
     {
         if(solution_idx == 0)
-            solution_idx = hip_gemm_default_solution(ctx, output_shape, input_shapes);
-        if(enabled(MIGRAPHX_ENABLE_HIP_GEMM_TUNING{}) or ctx.get_exhaustive_tune_flag())
-        {
             solution_idx =
-                hip_gemm_finalize(ctx, output_shape, input_shapes, alpha, beta, solution_idx);
+                hip_gemm_default_solution(ctx, output_shape, input_shapes, epilogue());
+        bool tuning =
+            enabled(MIGRAPHX_ENABLE_HIP_GEMM_TUNING{}) or ctx.get_exhaustive_tune_flag();
+        // Untuned shapes borrow the solution of the closest tuned one, unless they are tuned now
+        if(solution_idx == 0 and not tuning)
+            solution_idx = hip_gemm_nearest_solution(
+                ctx, output_shape, input_shapes, alpha, beta, epilogue());
+        if(tuning)
+        {
+            solution_idx = hip_gemm_finalize(
+                ctx, output_shape, input_shapes, alpha, beta, solution_idx, epilogue());
         }
     }
 };
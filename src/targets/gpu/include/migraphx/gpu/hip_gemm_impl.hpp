@@ -39,6 +39,23 @@ namespace gpu {
 using milliseconds = std::chrono::duration<double, std::milli>;
 using microseconds = std::chrono::duration<double, std::micro>;
 
+/**
+ * @brief Operations that hipBLASLt applies to the result before it is written.
+ *
+ * When scale is set, a single float is passed as an extra input just before the
+ * workspace, and the product is multiplied by it. This is only supported for fp8
+ * inputs, where it is used for the per-tensor dequantization scale. When bias is
+ * set, a vector broadcasted along the rows of the output is passed as an extra
+ * input before the scale, and added to the result. The activation is then
+ * applied, which can be empty or "relu".
+ */
+struct hip_gemm_epilogue
+{
+    bool bias              = false;
+    std::string activation = {};
+    bool scale             = false;
+};
+
 /**
  * @brief Templated implementations of the compute() and finalize() methods of the Gemm operator.
  *        For each function there are overloads using either float or int32_t for the arguments
@@ -55,18 +72,32 @@ void hip_gemm_compute(context& ctx,
                       const std::vector<argument>& args,
                       float alpha,
                       float beta,
-                      int32_t solution_idx);
+                      int32_t solution_idx,
+                      const hip_gemm_epilogue& epilogue = {});
 
 int32_t hip_gemm_finalize(context& ctx,
                           const shape& output_shape,
                           const std::vector<shape>& input_shapes,
                           float alpha,
                           float beta,
-                          int32_t solution_idx);
+                          int32_t solution_idx,
+                          const hip_gemm_epilogue& epilogue = {});
 
 int32_t hip_gemm_default_solution(context& ctx,
                                   const shape& output_shape,
-                                  const std::vector<shape>& input_shapes);
+                                  const std::vector<shape>& input_shapes,
+                                  const hip_gemm_epilogue& epilogue = {});
+
+/**
+ * @brief Returns the tuned solution of the closest problem in the problem cache with the same
+ * types, layouts and epilogue, or 0 when there is none that hipBLASLt supports for the gemm.
+ */
+int32_t hip_gemm_nearest_solution(context& ctx,
+                                  const shape& output_shape,
+                                  const std::vector<shape>& input_shapes,
+                                  float alpha,
+                                  float beta,
+                                  const hip_gemm_epilogue& epilogue = {});
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,30 +21,33 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/argmax.hpp>
-#include <migraphx/gpu/device/argmax.hpp>
-#include <migraphx/gpu/context.hpp>
-#include <migraphx/tune_axis.hpp>
+#ifndef MIGRAPHX_GUARD_GPU_HIP_GRAPH_HPP
+#define MIGRAPHX_GUARD_GPU_HIP_GRAPH_HPP
+
+#include <migraphx/gpu/config.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-shape hip_argmax::compute_shape(const std::vector<shape>& inputs) const
-{
-    check_shapes{inputs, *this}.has(2);
-    return op.normalize_compute_shape({inputs.at(0)});
-}
+struct module_pass_manager;
 
-argument hip_argmax::compute(context& ctx, const shape&, const std::vector<argument>& args) const
+namespace gpu {
+
+/**
+ * Moves the device work of the main module into a submodule that is run by a
+ * `gpu::hip_graph` instruction. The submodule is captured into a hipGraph the
+ * first time it is evaluated and the graph is replayed on later evaluations.
+ * Modules with control flow, multiple streams or dynamic shapes are left to
+ * launch eagerly.
+ */
+struct MIGRAPHX_GPU_EXPORT capture_hip_graph
 {
-    auto n_dim         = args.front().get_shape().lens().size();
-    int64_t tuned_axis = tune_axis(n_dim, op.axis, op.name());
-    device::argmax(
-        ctx.get_stream().get(), args.back(), args.front(), tuned_axis, op.select_last_index);
-    return args.back();
-}
+    std::string name() const { return "gpu::capture_hip_graph"; }
+    void apply(module_pass_manager& mpm) const;
+};
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_HIP_GRAPH_HPP
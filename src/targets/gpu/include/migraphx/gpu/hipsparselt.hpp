@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_GPU_HIPSPARSELT_HPP
+#define MIGRAPHX_GUARD_GPU_HIPSPARSELT_HPP
+
+#include <migraphx/argument.hpp>
+#include <migraphx/gpu/config.hpp>
+#include <migraphx/errors.hpp>
+#if MIGRAPHX_USE_HIPSPARSELT
+#include <hipsparselt/hipsparselt.h>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+struct context;
+
+// Alignment in bytes of the matrices passed to hipSPARSELt
+constexpr std::size_t hipsparselt_alignment = 16;
+
+template <class F, class... Ts>
+inline auto hipsparselt_invoke(F f, Ts... xs)
+{
+    auto status = f(xs...);
+    if(status != HIPSPARSE_STATUS_SUCCESS)
+        MIGRAPHX_THROW("hipSPARSELt call failed with status " + std::to_string(status));
+    return status;
+}
+
+// hipSPARSELt objects are plain structs that are initialized in place, so they cannot use
+// MIGRAPHX_MANAGE_PTR
+template <class T, hipsparseStatus_t (*Destroy)(const T*)>
+struct hipsparselt_object
+{
+    hipsparselt_object()                                     = default;
+    hipsparselt_object(const hipsparselt_object&)            = delete;
+    hipsparselt_object& operator=(const hipsparselt_object&) = delete;
+    ~hipsparselt_object()
+    {
+        if(initialized)
+            Destroy(&obj);
+    }
+
+    // Call f with a pointer to the object to initialize it
+    template <class F>
+    void init(F f)
+    {
+        hipsparselt_invoke(f, &obj);
+        initialized = true;
+    }
+
+    T* get() { return &obj; }
+    const T* get() const { return &obj; }
+
+    private:
+    T obj{};
+    bool initialized = false;
+};
+
+using hipsparselt_handle = hipsparselt_object<hipsparseLtHandle_t, &hipsparseLtDestroy>;
+using hipsparselt_matrix =
+    hipsparselt_object<hipsparseLtMatDescriptor_t, &hipsparseLtMatDescriptorDestroy>;
+using hipsparselt_alg_selection =
+    hipsparselt_object<hipsparseLtMatmulAlgSelection_t, &hipsparseLtMatmulAlgSelectionDestroy>;
+using hipsparselt_plan = hipsparselt_object<hipsparseLtMatmulPlan_t, &hipsparseLtMatmulPlanDestroy>;
+
+// Structured sparse gemms run on the sparse matrix cores of MI300 and later
+MIGRAPHX_GPU_EXPORT bool hipsparselt_supported();
+
+MIGRAPHX_GPU_EXPORT bool hipsparselt_supported_type(shape::type_t t);
+
+MIGRAPHX_GPU_EXPORT hipDataType hipsparselt_type(shape::type_t t);
+
+/// Describe the 2:4 sparse weights of shape [k, n] in row-major order, which hipSPARSELt sees
+/// as the column-major [n, k] structured matrix of the transposed gemm
+MIGRAPHX_GPU_EXPORT void hipsparselt_init_weights(hipsparselt_handle& handle,
+                                                  hipsparselt_matrix& desc,
+                                                  const shape& weights);
+
+/// Compress 2:4 sparse weights of shape [k, n] into the layout used by hipSPARSELt
+MIGRAPHX_GPU_EXPORT argument hipsparselt_compress(context& ctx, const argument& weights);
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_USE_HIPSPARSELT
+#endif // MIGRAPHX_GUARD_GPU_HIPSPARSELT_HPP
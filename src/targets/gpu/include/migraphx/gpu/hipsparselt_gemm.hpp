@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,32 +21,45 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_LOGSOFTMAX_HPP
-#define MIGRAPHX_GUARD_RTGLIB_LOGSOFTMAX_HPP
+#ifndef MIGRAPHX_GUARD_GPU_HIPSPARSELT_GEMM_HPP
+#define MIGRAPHX_GUARD_GPU_HIPSPARSELT_GEMM_HPP
 
-#include <migraphx/op/logsoftmax.hpp>
+#include <migraphx/argument.hpp>
 #include <migraphx/shape.hpp>
 #include <migraphx/reflect.hpp>
-#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/config.hpp>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
-struct hip_logsoftmax
+struct context;
+struct hipsparselt_gemm_state;
+
+/**
+ * Multiply a [m, k] matrix by 2:4 sparse weights of shape [k, n] that have been compressed by
+ * hipsparselt_compress. The inputs are the dense matrix, the compressed weights and the output
+ * allocation.
+ */
+struct MIGRAPHX_GPU_EXPORT hipsparselt_gemm
 {
-    op::logsoftmax op;
+    shape weights;
+    std::shared_ptr<hipsparselt_gemm_state> state = nullptr;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
-        return migraphx::reflect(self.op, f);
+        return pack(f(self.weights, "weights"));
     }
 
-    std::string name() const { return "gpu::logsoftmax"; }
+    std::string name() const { return "gpu::hipsparselt_gemm"; }
     shape compute_shape(const std::vector<shape>& inputs) const;
     argument
     compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const;
+    void finalize(context& ctx, const shape& output_shape, const std::vector<shape>& inputs);
     std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
     {
         return shapes.size() - 1;
@@ -56,5 +69,4 @@ struct hip_logsoftmax
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
-
-#endif
+#endif // MIGRAPHX_GUARD_GPU_HIPSPARSELT_GEMM_HPP
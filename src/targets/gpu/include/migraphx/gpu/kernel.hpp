@@ -37,13 +37,24 @@ namespace gpu {
 
 struct kernel_impl;
 
+// Resources a kernel uses on each compute unit, which limit how many of its blocks run at once
+struct kernel_resources
+{
+    std::size_t registers = 0;
+    std::size_t lds_bytes = 0;
+    // Percent of the threads a compute unit can hold that are taken by the resident blocks
+    double occupancy = 0;
+};
+
 struct MIGRAPHX_GPU_EXPORT kernel
 {
     kernel() = default;
     kernel(const char* image, const std::string& name);
+    // Kernels made from the same image share one loaded module
+    kernel(const char* image, std::size_t size, const std::string& name);
     template <class T, MIGRAPHX_REQUIRES(sizeof(T) == 1)>
     kernel(const std::vector<T>& image, const std::string& name)
-        : kernel(reinterpret_cast<const char*>(image.data()), name)
+        : kernel(reinterpret_cast<const char*>(image.data()), image.size(), name)
     {
     }
 
@@ -57,7 +68,7 @@ struct MIGRAPHX_GPU_EXPORT kernel
     void launch(hipStream_t stream,
                 std::size_t global,
                 std::size_t local,
-                std::vector<void*> args,
+                const std::vector<void*>& args,
                 hipEvent_t start = nullptr,
                 hipEvent_t stop  = nullptr) const;
 
@@ -69,6 +80,13 @@ struct MIGRAPHX_GPU_EXPORT kernel
         };
     }
 
+    bool empty() const { return impl == nullptr; }
+
+    kernel_resources resources(std::size_t local) const;
+
+    // The loaded module, which is shared by the kernels made from the same image
+    std::shared_ptr<const void> module() const;
+
     private:
     std::shared_ptr<kernel_impl> impl;
 };
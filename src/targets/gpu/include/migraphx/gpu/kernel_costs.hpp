@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_GPU_KERNEL_COSTS_HPP
+#define MIGRAPHX_GUARD_GPU_KERNEL_COSTS_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/gpu/export.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct operation;
+struct shape;
+
+namespace gpu {
+
+// Measured run times, in milliseconds, of the operators in a compiled
+// program. They are collected while benchmarking tuned kernels and from
+// timelines, and are used by the scheduler in place of its static weights.
+struct MIGRAPHX_GPU_EXPORT kernel_costs
+{
+    // A key that identifies the operator and the shapes it is run on,
+    // independent of its code object binary, so it can be matched across
+    // compiles
+    static std::string key(const operation& op, const std::vector<shape>& inputs);
+
+    void insert(const operation& op, const std::vector<shape>& inputs, double ms);
+    optional<double> get(const operation& op, const std::vector<shape>& inputs) const;
+    // The mean of the measured costs
+    double average() const;
+    bool empty() const;
+
+    void load();
+    void load(const fs::path& path);
+    void save() const;
+    void save(const fs::path& path) const;
+    std::unordered_map<std::string, double> costs;
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_KERNEL_COSTS_HPP
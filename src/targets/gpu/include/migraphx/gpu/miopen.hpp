@@ -139,6 +139,8 @@ inline tensor_descriptor make_tensor(const migraphx::shape& os)
         d = miopenFloat;
     else if(s.type() == shape::half_type)
         d = miopenHalf;
+    else if(s.type() == shape::bf16_type)
+        d = miopenBFloat16;
     else if(s.type() == shape::int32_type)
         d = miopenInt32;
     else if(s.type() == shape::int8_type)
@@ -0,0 +1,62 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_GPU_OVERLAP_COPY_HPP
+#define MIGRAPHX_GUARD_GPU_OVERLAP_COPY_HPP
+
+#include <migraphx/gpu/context.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+struct module;
+
+namespace gpu {
+
+/**
+ * Moves the copies of the parameters to the gpu, which lowering puts at the
+ * start of the program when offload_copy is set, onto a stream of their own.
+ * Each copy is issued when the compute that uses the previous parameter
+ * starts, so the upload for the next layer overlaps the current one. The
+ * copy stream waits for the compute issued before the copy, since the
+ * destination can reuse its memory, and the compute stream waits on an event
+ * only right before the first use of the copied value. The copies go through pinned staging buffers so they stay
+ * asynchronous to the host. Literals streamed from pinned host memory by
+ * write_literals are prefetched the same way, so their scratch buffers only
+ * need to hold the weights of about two layers at a time.
+ *
+ * Does nothing when the schedule pass already spread the program over
+ * several streams.
+ */
+struct MIGRAPHX_GPU_EXPORT overlap_copy
+{
+    context* ctx = nullptr;
+    std::string name() const { return "gpu::overlap_copy"; }
+
+    void apply(module& m) const;
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
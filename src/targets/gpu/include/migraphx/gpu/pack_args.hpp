@@ -48,6 +48,10 @@ struct kernel_argument
 
 MIGRAPHX_GPU_EXPORT std::vector<char> pack_args(const std::vector<kernel_argument>& args);
 
+// Packs into an existing buffer so its capacity can be reused across launches
+MIGRAPHX_GPU_EXPORT void pack_args(const std::vector<kernel_argument>& args,
+                                   std::vector<char>& kernargs);
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,30 +21,32 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/multinomial.hpp>
-#include <migraphx/gpu/device/multinomial.hpp>
-#include <migraphx/gpu/context.hpp>
-#include <migraphx/tune_axis.hpp>
-#include <migraphx/check_shapes.hpp>
+#ifndef MIGRAPHX_GUARD_GPU_PACK_WEIGHTS_HPP
+#define MIGRAPHX_GUARD_GPU_PACK_WEIGHTS_HPP
+
+#include <migraphx/gpu/config.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-shape hip_multinomial::compute_shape(std::vector<shape> inputs) const
-{
-    check_shapes{inputs, *this}.has(3).only_dims(2).standard();
-    inputs.pop_back();
-    return op.compute_shape(inputs);
-}
+struct module_pass_manager;
 
-argument
-hip_multinomial::compute(context& ctx, const shape&, const std::vector<argument>& args) const
+namespace gpu {
+
+/**
+ * Pack the constant inputs of the compiled ops into the layout each op prefers, such as the
+ * transposed weights the gemm libraries run fastest with. The repacking is folded into new
+ * literals before they are written to the device, so no transposes of constants are left to run.
+ */
+struct MIGRAPHX_GPU_EXPORT pack_weights
 {
-    device::multinomial(ctx.get_stream().get(), args.back(), args.front(), args[1]);
-    return args.back();
-}
+    std::string name() const { return "gpu::pack_weights"; }
+    void apply(module_pass_manager& mpm) const;
+};
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_GPU_PACK_WEIGHTS_HPP
@@ -37,6 +37,8 @@ namespace gpu {
 struct MIGRAPHX_GPU_EXPORT prefuse_ops
 {
     bool enable_attention = false;
+    // Fuse attention that is not handled by CK or MLIR into the native attention kernel
+    bool enable_native_attention = false;
     std::string name() const { return "gpu::prefuse_ops"; }
     void apply(module_pass_manager& mpm) const;
 };
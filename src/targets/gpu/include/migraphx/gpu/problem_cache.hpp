@@ -28,7 +28,12 @@
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/optional.hpp>
+#include <migraphx/shape.hpp>
+#include <migraphx/sqlite.hpp>
+#include <migraphx/filesystem.hpp>
 #include <migraphx/gpu/export.h>
+#include <functional>
+#include <mutex>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -39,11 +44,38 @@ struct MIGRAPHX_GPU_EXPORT problem_cache
     void insert(const std::string& name, const value& problem, const value& solution);
     void mark(const std::string& name, const value& problem);
     optional<value> get(const std::string& name, const value& problem) const;
+    // The solution of the solved problem for name with the smallest distance, where distance
+    // returns nullopt for the problems that can't share a solution. Disabled with
+    // MIGRAPHX_DISABLE_NEAREST_SOLUTION.
+    optional<value> nearest(const std::string& name,
+                            const std::function<optional<double>(const value&)>& distance) const;
+    // Every solved problem, including the ones only stored in the database. The database is
+    // only read the first time after each load, so once for each compile.
+    std::unordered_map<value, value> solutions() const;
+    // How many of the solved problems for name picked each solution
+    std::unordered_map<value, std::size_t> solution_counts(const std::string& name) const;
     void load();
+    // Paths ending in .db, .sqlite or .sqlite3 are opened as a sqlite
+    // database which is queried lazily and updated on every insert, so
+    // it can be shared by processes tuning at the same time
+    void load(const fs::path& pc_path);
     void save() const;
-    std::unordered_map<value, value> cache;
+    // Solutions read from the database are also added here by get
+    mutable std::unordered_map<value, value> cache;
+    optional<sqlite> db = nullopt;
+    // Every solution in the database, read once by solutions
+    mutable optional<std::unordered_map<value, value>> db_solutions = nullopt;
+
+    private:
+    // Solutions found by background tuning are inserted while the program is running
+    mutable std::mutex m;
 };
 
+// Distance between two problems described by their shapes, which is the sum of the log ratios of
+// the lens. Returns nullopt when the types or layouts are different.
+MIGRAPHX_GPU_EXPORT optional<double> shapes_distance(const std::vector<shape>& x,
+                                                     const std::vector<shape>& y);
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
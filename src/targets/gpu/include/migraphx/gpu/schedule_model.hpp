@@ -33,17 +33,23 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 struct module;
 struct operation;
+struct shape;
 
 namespace gpu {
 
+struct kernel_costs;
+
 struct schedule_model
 {
     std::size_t streams = 0;
+    // When there are measured costs the weights are in microseconds, and
+    // operators that were not measured are estimated from the static weights
+    const kernel_costs* costs = nullptr;
     std::size_t concurrency() const;
     void sched(module& m, instruction_ref ins, std::size_t n) const;
     void wait(module& m, instruction_ref ins, std::size_t wait_id) const;
     void record(module& m, instruction_ref ins, std::size_t wait_id) const;
-    std::size_t weight(const operation& op) const;
+    std::size_t weight(const operation& op, const std::vector<shape>& inputs) const;
 };
 
 } // namespace gpu
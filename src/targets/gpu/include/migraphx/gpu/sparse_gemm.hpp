@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,25 +21,33 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/reverse.hpp>
+#ifndef MIGRAPHX_GUARD_GPU_SPARSE_GEMM_HPP
+#define MIGRAPHX_GUARD_GPU_SPARSE_GEMM_HPP
+
+#include <migraphx/config.hpp>
 #include <migraphx/gpu/context.hpp>
-#include <migraphx/gpu/device/reverse.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-shape hip_reverse::compute_shape(std::vector<shape> inputs) const
-{
-    inputs.pop_back();
-    return op.normalize_compute_shape(inputs);
-}
+struct module;
 
-argument hip_reverse::compute(context& ctx, const shape&, const std::vector<argument>& args) const
+namespace gpu {
+
+/**
+ * Run dots with constant weights that have 2:4 structured sparsity, where at most two of every
+ * four consecutive elements along k are nonzero, on the sparse matrix cores through
+ * hipSPARSELt. The weights are compressed when compiling and the dot is replaced with a
+ * gpu::hipsparselt_gemm.
+ */
+struct MIGRAPHX_GPU_EXPORT sparse_gemm
 {
-    return device::reverse(ctx.get_stream().get(), args.back(), args[0], op.axes);
-}
+    context* ctx = nullptr;
+    std::string name() const { return "gpu::sparse_gemm"; }
+    void apply(module& m) const;
+};
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_SPARSE_GEMM_HPP
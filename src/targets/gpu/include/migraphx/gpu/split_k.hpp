@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,30 +21,37 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/argmin.hpp>
-#include <migraphx/gpu/device/argmin.hpp>
+#ifndef MIGRAPHX_GUARD_GPU_SPLIT_K_HPP
+#define MIGRAPHX_GUARD_GPU_SPLIT_K_HPP
+
+#include <migraphx/config.hpp>
 #include <migraphx/gpu/context.hpp>
-#include <migraphx/tune_axis.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-shape hip_argmin::compute_shape(const std::vector<shape>& inputs) const
-{
-    check_shapes{inputs, *this}.has(2);
-    return op.normalize_compute_shape({inputs.at(0)});
-}
+struct module;
 
-argument hip_argmin::compute(context& ctx, const shape&, const std::vector<argument>& args) const
+namespace gpu {
+
+/**
+ * Split the reduction dimension of dots that produce too few tiles to fill
+ * the device, such as the skinny gemms when decoding. The dot is computed as
+ * a batch of partial products over chunks of k, which are summed in float
+ * with a reduce_sum that can then fuse with the pointwise ops that follow.
+ *
+ * The number of splits is looked up in the problem cache. When exhaustive
+ * tuning it is benchmarked and saved there, and otherwise it is picked from
+ * the number of CUs.
+ */
+struct MIGRAPHX_GPU_EXPORT split_k
 {
-    auto n_dim         = args.front().get_shape().lens().size();
-    int64_t tuned_axis = tune_axis(n_dim, op.axis, op.name());
-    device::argmin(
-        ctx.get_stream().get(), args.back(), args.front(), tuned_axis, op.select_last_index);
-    return args.back();
-}
+    context* ctx = nullptr;
+    std::string name() const { return "gpu::split_k"; }
+    void apply(module& m) const;
+};
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_SPLIT_K_HPP
@@ -27,6 +27,7 @@
 #include <migraphx/program.hpp>
 #include <migraphx/compile_options.hpp>
 #include <migraphx/gpu/config.hpp>
+#include <migraphx/optional.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -34,12 +35,17 @@ namespace gpu {
 
 struct MIGRAPHX_GPU_EXPORT target
 {
+    // Device to compile and run on, the current device is used when it is not set. Passing one
+    // target per device to the multi-target compile places each root module on its own GPU.
+    optional<std::size_t> device_id = nullopt;
+
     std::string name() const;
     std::vector<pass> get_passes(migraphx::context& gctx, const compile_options& options) const;
     migraphx::context get_context() const;
     argument copy_to(const argument& arg) const;
     argument copy_from(const argument& arg) const;
     argument allocate(const shape& s) const;
+    argument allocate_pinned(const shape& s) const;
 };
 
 } // namespace gpu
@@ -28,16 +28,58 @@
 #include <migraphx/config.hpp>
 #include <migraphx/gpu/context.hpp>
 #include <migraphx/operation.hpp>
+#include <functional>
+#include <utility>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+struct benchmark_options
+{
+    // Runs timed together in each sample
+    std::size_t batch = 10;
+    // Samples taken before candidates can be dropped, and the most samples taken
+    std::size_t min_samples = 5;
+    std::size_t max_samples = 50;
+    // Overwrite a buffer larger than the L2 cache before each run so every timed run starts
+    // with a cold cache, which times a single run per sample. Also enabled for every benchmark
+    // with MIGRAPHX_BENCHMARK_FLUSH_CACHE.
+    bool flush_cache = false;
+};
+
+// The time of each sample in ms per run
+struct MIGRAPHX_GPU_EXPORT timing
+{
+    std::vector<double> samples;
+
+    double median() const;
+    // Mean without the fastest and slowest 10% of the samples
+    double trimmed_mean() const;
+    // 95% confidence interval of the median from the order statistics of the samples
+    std::pair<double, double> confidence_interval() const;
+};
+
+/* Time the runs interleaved sample by sample so drift in clocks affects them alike. Each run is
+ * warmed up until its times settle. Once min_samples are taken, runs whose confidence interval
+ * is above the fastest one's are not timed anymore. */
+MIGRAPHX_GPU_EXPORT std::vector<timing>
+time_interleaved(context& ctx,
+                 const std::vector<std::function<void()>>& runs,
+                 const benchmark_options& options = {});
+
+/* median time of the op over n runs */
 MIGRAPHX_GPU_EXPORT double
 time_op(const context& ictx, operation op, const std::vector<shape>& inputs, int n = 100);
 
 MIGRAPHX_GPU_EXPORT double time_program(const context& ictx, program p, int n = 100);
 
+/* median times of the programs, timed with time_interleaved */
+MIGRAPHX_GPU_EXPORT std::vector<double> time_programs(const context& ictx,
+                                                      std::vector<program> ps,
+                                                      const benchmark_options& options = {});
+
 /* benchmark gpu::code_object with expected input shapes over n iterations */
 MIGRAPHX_GPU_EXPORT double time_op(const context& ictx, operation op, int n = 100);
 
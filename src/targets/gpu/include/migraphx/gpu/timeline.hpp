@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_GPU_TIMELINE_HPP
+#define MIGRAPHX_GUARD_GPU_TIMELINE_HPP
+
+#include <migraphx/gpu/config.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/value.hpp>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct program;
+
+namespace gpu {
+
+struct context;
+
+/**
+ * A marker that records a pair of hip events around each instruction on the stream it runs on,
+ * without synchronizing between instructions. The timings are resolved once the program has
+ * finished, so the streams overlap as they would in a normal run. Use it with program::mark:
+ *
+ *     gpu::timeline t{gpu_ctx};
+ *     p.mark(params, t);
+ *     t.write_trace(os);
+ *
+ * Copies share the same recording.
+ */
+struct MIGRAPHX_GPU_EXPORT timeline
+{
+    struct entry
+    {
+        std::string name;
+        std::size_t stream = 0;
+        // milliseconds since the start of the program
+        double start = 0;
+        double end   = 0;
+        // Counters reported by the instruction with MIGRAPHX_PERF_COUNTERS
+        value counters = value::object{};
+    };
+
+    explicit timeline(context& ctx);
+
+    void mark_start(instruction_ref ins);
+    void mark_stop(instruction_ref ins);
+    void mark_start(const program& p);
+    void mark_stop(const program& p);
+
+    const std::vector<entry>& entries() const;
+
+    /// Write the entries as a Chrome trace (also loadable in Perfetto) with a lane per stream
+    void write_trace(std::ostream& os) const;
+    /// Print the busy time of each stream and how much the streams overlapped
+    void print_summary(std::ostream& os) const;
+
+    private:
+    struct impl;
+    std::shared_ptr<impl> pimpl;
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_TIMELINE_HPP
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,42 +21,39 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifndef MIGRAPHX_GUARD_RTGLIB_REVERSE_HPP
-#define MIGRAPHX_GUARD_RTGLIB_REVERSE_HPP
+#ifndef MIGRAPHX_GUARD_GPU_TUNE_SCHEDULE_HPP
+#define MIGRAPHX_GUARD_GPU_TUNE_SCHEDULE_HPP
 
-#include <migraphx/argument.hpp>
-#include <migraphx/reflect.hpp>
-#include <migraphx/op/reverse.hpp>
+#include <migraphx/config.hpp>
 #include <migraphx/gpu/context.hpp>
+#include <migraphx/value.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
 
-struct context;
+struct module;
 
-struct hip_reverse
-{
-    op::reverse op;
+namespace gpu {
 
-    template <class Self, class F>
-    static auto reflect(Self& self, F f)
-    {
-        return migraphx::reflect(self.op, f);
-    }
+/**
+ * Schedule the module over the number of streams that runs it fastest.
+ *
+ * The number of streams is looked up in the problem cache. When exhaustive
+ * tuning, the module is scheduled over each candidate number of streams and
+ * timed, and the fastest is saved there. Otherwise the number of streams of
+ * the context is used.
+ */
+struct MIGRAPHX_GPU_EXPORT tune_schedule
+{
+    context* ctx = nullptr;
+    bool enable  = true;
+    std::string name() const { return "gpu::tune_schedule"; }
+    void apply(module& m) const;
 
-    std::string name() const { return "gpu::reverse"; }
-    shape compute_shape(std::vector<shape> inputs) const;
-    argument
-    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const;
-    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
-    {
-        return shapes.size() - 1;
-    }
+    static value problem(const module& m);
 };
 
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
-
-#endif
+#endif // MIGRAPHX_GUARD_GPU_TUNE_SCHEDULE_HPP
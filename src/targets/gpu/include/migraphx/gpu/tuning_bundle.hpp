@@ -0,0 +1,63 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_GPU_TUNING_BUNDLE_HPP
+#define MIGRAPHX_GUARD_GPU_TUNING_BUNDLE_HPP
+
+#include <migraphx/gpu/config.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/value.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+struct context;
+
+/**
+ * A tuning bundle collects the results of exhaustive tuning, from the problem
+ * cache and the MLIR tuning db, into a single json file that can be shared
+ * between machines. The results are grouped into entries, each keyed by the
+ * target they were tuned on: the gfx arch, the number of CUs and the versions
+ * of MIGraphX and the libraries it calls. Results are only imported on a
+ * machine with the same target, since they are not valid anywhere else.
+ */
+
+/// The gfx arch, CU count and library versions of the current device
+MIGRAPHX_GPU_EXPORT value get_tuning_target(const context& ctx);
+
+/// Adds the solutions from the problem cache of ctx, and the MLIR tuning db
+/// lines for its device, to the bundle file. The entry for the same target is
+/// merged with the new results, and entries for other targets are kept.
+MIGRAPHX_GPU_EXPORT void export_tuning_bundle(context& ctx, const fs::path& bundle_path);
+
+/// Adds the results of the bundle entry matching the current device to the
+/// problem cache in MIGRAPHX_PROBLEM_CACHE and the MLIR tuning db in
+/// MIGRAPHX_MLIR_TUNING_DB. Returns the number of results imported, which is
+/// 0 when no entry matches.
+MIGRAPHX_GPU_EXPORT std::size_t import_tuning_bundle(context& ctx, const fs::path& bundle_path);
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_GPU_TUNING_BUNDLE_HPP
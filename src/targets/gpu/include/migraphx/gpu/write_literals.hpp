@@ -32,9 +32,15 @@ struct module;
 
 namespace gpu {
 
+/**
+ * Uploads the literals to the gpu when the program is finalized. With a nonzero budget, the
+ * largest literals are left in pinned host memory until the rest fits in the budget (in bytes),
+ * and are copied to a scratch buffer right before their first use each time the program runs.
+ */
 struct MIGRAPHX_GPU_EXPORT write_literals
 {
-    context* ctx = nullptr;
+    context* ctx       = nullptr;
+    std::size_t budget = 0;
     std::string name() const { return "gpu::write_literals"; }
 
     void apply(module& m) const;
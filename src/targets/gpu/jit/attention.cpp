@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const attention_kernel = R"__migraphx__(
+#include <migraphx/kernels/attention.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void attention_kernel(${params})
+{
+    make_tensors()(${args})([](${lambda_params}) {
+        attention(a, b, b1, output, ${scale}, make_attention_score(${score_args}));
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct attention_compiler : compiler<attention_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::attention"}; }
+
+    static std::vector<std::string> arg_names(std::size_t ninputs)
+    {
+        // a, b, [bias | cond, value], b1, output
+        if(ninputs == 5)
+            return {"a", "b", "bias", "b1", "output"};
+        if(ninputs == 6)
+            return {"a", "b", "cond", "value", "b1", "output"};
+        return {"a", "b", "b1", "output"};
+    }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& out_s = inputs.back();
+        auto n            = inputs[1].lens().back();
+        auto o            = out_s.lens().back();
+        auto block_size   = compute_block_size(ctx, std::max(n, o), 1024);
+        if(block_size < o)
+            MIGRAPHX_THROW("ATTENTION: output dimension " + std::to_string(o) +
+                           " is larger than the maximum workgroup size");
+        auto ngroups = out_s.elements() / o;
+
+        hip_compile_options options;
+        options.set_launch_params(
+            v, [=](std::size_t local) { return ngroups * local; }, block_size);
+        options.inputs      = inputs;
+        options.output      = out_s;
+        options.kernel_name = "attention_kernel";
+        options.emplace_param("-Wno-float-equal");
+
+        auto names = arg_names(inputs.size());
+        std::vector<std::string> params;
+        std::vector<std::string> lambda_params;
+        std::transform(names.begin(), names.end(), std::back_inserter(params), [](const auto& x) {
+            return "void* " + x;
+        });
+        std::transform(names.begin(),
+                       names.end(),
+                       std::back_inserter(lambda_params),
+                       [](const auto& x) { return "auto " + x; });
+        std::vector<std::string> score_args(names.begin() + 2, names.end() - 2);
+
+        auto src = interpolate_string(attention_kernel,
+                                      {{"params", join_strings(params, ", ")},
+                                       {"args", join_strings(names, ", ")},
+                                       {"lambda_params", join_strings(lambda_params, ", ")},
+                                       {"score_args", join_strings(score_args, ", ")},
+                                       {"scale", to_string(v.get("scale", 1.0f))}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+using namespace migraphx::gpu::gen; // NOLINT
+
+static const char* const beam_step_kernel = R"__migraphx__(
+#include <migraphx/kernels/beam_step.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+MIGRAPHX_GLOBAL void beam_step_kernel(void* logprobs_p,
+                                      void* scores_p,
+                                      void* new_scores_p,
+                                      void* tokens_p,
+                                      void* parents_p)
+{
+    make_tensors()(logprobs_p, scores_p, new_scores_p, tokens_p, parents_p)([](auto... xs) {
+        beam_step(xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct beam_step_compiler : compiler<beam_step_compiler>
+{
+    std::vector<std::string> names() const { return {"beam_step"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& lens = inputs.front().lens();
+        auto beams       = lens[1];
+        // The selected beams are sorted in LDS, like the jit topk
+        if(beams > 1024)
+            MIGRAPHX_THROW("BEAM_STEP: too many beams: " + std::to_string(beams));
+        auto block_size = compute_block_size(ctx, beams * lens[2], 1024);
+        hip_compile_options options;
+        options.set_launch_params(
+            v, compute_global_for(ctx, lens[0] * block_size, 256), block_size);
+        options.inputs      = flatten(inputs);
+        options.output      = inputs.back();
+        options.kernel_name = "beam_step_kernel";
+
+        return compile_hip_code_object(beam_step_kernel, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -201,17 +201,19 @@ struct ck_gemm_softmax_gemm_compiler : compiler<ck_gemm_softmax_gemm_compiler>
         auto v      = create_settings(ins, op);
         if(not solution.is_null())
             v["tuning_value"] = solution;
-        return {compile_op(ctx, shapes, v),
-                [=](module& m, instruction_ref ins2, const operation& code_object) {
-                    if(enabled(MIGRAPHX_LOG_CK_GEMM{}))
-                    {
-                        std::vector<shape> gemm_shapes{
-                            shapes[0], shapes[1], shapes.back().with_type(shapes[0].type())};
-                        std::cout << "gpu::ck_gemm_softmax_gemm: "
-                                  << to_json_string(to_value(gemm_shapes)) << std::endl;
-                    }
-                    m.replace_instruction(ins2, code_object, ins2->inputs());
-                }};
+        auto replace = [=](module& m, instruction_ref ins2, const operation& code_object) {
+            if(enabled(MIGRAPHX_LOG_CK_GEMM{}))
+            {
+                std::vector<shape> gemm_shapes{
+                    shapes[0], shapes[1], shapes.back().with_type(shapes[0].type())};
+                std::cout << "gpu::ck_gemm_softmax_gemm: "
+                          << to_json_string(to_value(gemm_shapes)) << std::endl;
+            }
+            m.replace_instruction(ins2, code_object, ins2->inputs());
+        };
+        compiler_replace result{compile_op(ctx, shapes, v), replace};
+        result.independent = true;
+        return result;
     }
 
     optional<tuning_config>
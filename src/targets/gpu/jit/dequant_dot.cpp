@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const dequant_dot_kernel = R"__migraphx__(
+#include <migraphx/kernels/dequant_dot.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void dequant_dot_kernel(${params})
+{
+    make_tensors()(${args})([](${lambda_params}) {
+        dequant_dot<${tile_m}>(a, make_dequant_weight<${int4}, ${axis}>(${weight_args}), output);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// Largest number of rows of a computed by one workgroup
+constexpr std::size_t max_tile_m = 8;
+
+struct dequant_dot_compiler : compiler<dequant_dot_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::dequant_dot"}; }
+
+    static std::vector<std::string> arg_names(std::size_t ninputs)
+    {
+        if(ninputs == 5)
+            return {"a", "w", "scale", "zero_point", "output"};
+        return {"a", "w", "scale", "output"};
+    }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& out_s = inputs.back();
+        auto rank         = out_s.ndim();
+        auto m            = out_s.lens()[rank - 2];
+        auto n            = out_s.lens()[rank - 1];
+        auto tile_m       = std::min(m, max_tile_m);
+        auto int4         = v.get("int4", false);
+        auto axis         = int4 ? v.at("axis").to<std::size_t>() : 0;
+        auto block_size   = compute_block_size(ctx, n, 256);
+        auto ngroups      = (out_s.elements() / (m * n)) * ((m + tile_m - 1) / tile_m) *
+                       ((n + block_size - 1) / block_size);
+
+        hip_compile_options options;
+        options.set_launch_params(
+            v, [=](std::size_t local) { return ngroups * local; }, block_size);
+        options.inputs      = inputs;
+        options.output      = out_s;
+        options.kernel_name = "dequant_dot_kernel";
+
+        auto names = arg_names(inputs.size());
+        std::vector<std::string> params;
+        std::vector<std::string> lambda_params;
+        std::transform(names.begin(), names.end(), std::back_inserter(params), [](const auto& x) {
+            return "void* " + x;
+        });
+        std::transform(names.begin(),
+                       names.end(),
+                       std::back_inserter(lambda_params),
+                       [](const auto& x) { return "auto " + x; });
+        std::vector<std::string> weight_args(names.begin() + 1, names.end() - 1);
+
+        auto src = interpolate_string(dequant_dot_kernel,
+                                      {{"params", join_strings(params, ", ")},
+                                       {"args", join_strings(names, ", ")},
+                                       {"lambda_params", join_strings(lambda_params, ", ")},
+                                       {"weight_args", join_strings(weight_args, ", ")},
+                                       {"tile_m", std::to_string(tile_m)},
+                                       {"int4", int4 ? "true" : "false"},
+                                       {"axis", std::to_string(axis)}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
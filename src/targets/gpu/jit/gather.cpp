@@ -27,14 +27,20 @@
 
 #include <migraphx/gpu/compile_hip_code_object.hpp>
 #include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+using namespace migraphx::gpu::gen; // NOLINT
+
 // NOLINTNEXTLINE
 static const char* const gather_kernel = R"__migraphx__(
 #include <migraphx/kernels/gather.hpp>
+#include <migraphx/kernels/functional.hpp>
+#include <migraphx/kernels/math.hpp>
 #include <migraphx/kernels/ops.hpp>
 #include <migraphx/kernels/integral_constant.hpp>
 #include <migraphx/kernels/generic_constant.hpp>
@@ -42,12 +48,14 @@ static const char* const gather_kernel = R"__migraphx__(
 
 namespace migraphx {
 
+${preamble}
+
 extern "C" {
 
-MIGRAPHX_GLOBAL void gather_kernel(void* in_data, void* in_indices, void* output) 
+MIGRAPHX_GLOBAL void ${kernel}(${params}) 
 {
-    make_tensors()(in_data, in_indices, output)([](auto&&... xs) { 
-        gather<${axis}>(xs...); 
+    transform_args(make_tensors(), rotate_last())(${args})([](auto output, auto in_data, auto in_indices, auto... xs) { 
+        gather<${axis}>(${post}, output, in_data, in_indices, xs...); 
     });
 }
 
@@ -59,28 +67,70 @@ MIGRAPHX_GLOBAL void gather_kernel(void* in_data, void* in_indices, void* output
 
 struct gather_compiler : compiler<gather_compiler>
 {
-    std::vector<std::string> names() const { return {"gather"}; }
+    std::vector<std::string> names() const { return {"gather", "fused_gather"}; }
+
+    // Collapse the dimensions of a standard data tensor to {outer, axis, inner} so the kernel
+    // computes a rank 3 index. The output and the fused inputs are only accessed by their
+    // element index, so they are flattened in the same way.
+    static std::vector<shape> reduce_gather_dims(const std::vector<shape>& inputs,
+                                                 std::size_t& axis)
+    {
+        const auto& data = inputs.front();
+        bool standard    = std::all_of(
+            inputs.begin() + 2, inputs.end(), [](const shape& s) { return s.standard(); });
+        if(not data.standard() or not standard or data.ndim() <= 3)
+            return inputs;
+        auto lens  = data.lens();
+        auto outer = std::accumulate(
+            lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+        auto inner = std::accumulate(
+            lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+        auto n = inputs[1].elements();
+        std::vector<shape> result;
+        result.push_back(data.with_lens({outer, lens[axis], inner}));
+        result.push_back(inputs[1]);
+        std::transform(inputs.begin() + 2, inputs.end(), std::back_inserter(result), [&](auto s) {
+            return s.with_lens({outer, n, inner});
+        });
+        axis = 1;
+        return result;
+    }
 
     operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
     {
         hip_compile_options options;
         const auto& out_s = inputs.back();
+        auto axis         = v.at("axis").to<std::size_t>();
         options.set_launch_params(v, compute_global_for(ctx, out_s.elements()));
         options.inputs         = inputs;
         options.output         = out_s;
-        options.kernel_name    = "gather_kernel";
-        options.virtual_inputs = inputs;
-
-        auto axis = v.at("axis").to<std::string>();
-
-        auto src = interpolate_string(gather_kernel, {{"axis", axis}});
+        options.kernel_name    = v.get("kernel", "gather_kernel");
+        options.virtual_inputs = reduce_gather_dims(inputs, axis);
+        options.emplace_param("-Wno-float-equal");
+
+        auto src = interpolate_string(gather_kernel,
+                                      {{"kernel", options.kernel_name},
+                                       {"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"post", v.get("post", std::string{"op::id{}"})},
+                                       {"preamble", v.get("preamble", std::string{})},
+                                       {"axis", std::to_string(axis)}});
 
         return compile_hip_code_object(src, options);
     }
 
     compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
     {
-        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+        auto v = op.to_value();
+        if(op.name() == "fused_gather")
+        {
+            // The gathered value is the first argument of the pointwise module
+            auto* pm      = ins->module_inputs().front();
+            v["preamble"] = generate_pointwise(*pm, "post_gather");
+            v["post"]     = "MIGRAPHX_LIFT(post_gather)";
+            v["kernel"]   = "gather_" + generate_name_from_ops(*pm) + "_kernel";
+        }
+        return compile_op(ctx, to_shapes(ins->inputs()), v);
     }
 };
 
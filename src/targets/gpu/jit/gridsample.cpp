@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/op/gridsample.hpp>
+#include <migraphx/serialize.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const gridsample_kernel = R"__migraphx__(
+#include <migraphx/kernels/gridsample.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void gridsample_kernel(void* input_p, void* grid_p, void* output_p)
+{
+    make_tensors()(input_p, grid_p, output_p)([](auto input, auto grid, auto output) {
+        gridsample<gridsample_mode::${mode}, gridsample_padding::${padding}, ${align_corners}>(
+            input, grid, output);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct gridsample_compiler : compiler<gridsample_compiler>
+{
+    std::vector<std::string> names() const { return {"gridsample"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        auto op              = from_value<op::gridsample>(v);
+        const auto& out_lens = inputs.back().lens();
+        // Each thread samples all of the channels at one position of the grid
+        auto positions = out_lens[0] * out_lens[2] * out_lens[3];
+
+        hip_compile_options options;
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "gridsample_kernel";
+        options.set_launch_params(v, compute_global_for(ctx, positions));
+
+        auto src = interpolate_string(gridsample_kernel,
+                                      {{"mode", op.mode},
+                                       {"padding", op.padding_mode},
+                                       {"align_corners", op.align_corners ? "true" : "false"}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
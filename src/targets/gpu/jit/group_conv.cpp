@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <migraphx/env.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_POINTWISE);
+
+using namespace migraphx::gpu::gen; // NOLINT
+
+// NOLINTNEXTLINE
+static const char* const group_conv_kernel = R"__migraphx__(
+#include <migraphx/kernels/group_conv.hpp>
+#include <migraphx/kernels/pooling.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/integral_constant.hpp>
+#include <migraphx/kernels/generic_constant.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+${preamble}
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void ${kernel}(${params})
+{
+    transform_args(make_tensors(), rotate_last())(${args})([](auto... xs) {
+        group_conv<${groups}, ${tile}>(make_window(index_ints<${window}>{}, index_ints<${stride}>{}, index_ints<${padding}>{}, index_ints<${dilation}>{}), ${post}, xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct group_conv_compiler : compiler<group_conv_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::group_conv"}; }
+
+    // Largest number of outputs a thread computes that evenly divides the output
+    static std::size_t compute_tile(const shape& output, std::size_t max_tile = 4)
+    {
+        std::size_t tile = 1;
+        while(tile * 2 <= max_tile and output.elements() % (tile * 2) == 0)
+            tile *= 2;
+        return tile;
+    }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        hip_compile_options options;
+        const auto& out_s   = inputs.back();
+        options.inputs      = inputs;
+        options.output      = out_s;
+        options.kernel_name = v.get("kernel", "group_conv_kernel");
+
+        auto ndim     = out_s.ndim();
+        auto kdims    = ndim - 2;
+        auto get_dims = [&](const std::string& name, std::size_t def) {
+            std::vector<std::size_t> result(2, def);
+            auto x = v.at(name).to_vector<std::size_t>();
+            // Only the padding at the start of each axis is needed, the end is bounds checked
+            result.insert(result.end(), x.begin(), x.begin() + kdims);
+            return result;
+        };
+        auto padding  = get_dims("padding", 0);
+        auto stride   = get_dims("stride", 1);
+        auto dilation = get_dims("dilation", 1);
+        auto window   = inputs[1].lens();
+        std::fill(window.begin(), window.begin() + 2, 1);
+
+        auto tile = v.get("tile", compute_tile(out_s));
+        if(out_s.elements() % tile != 0)
+            tile = 1;
+        options.set_launch_params(v, compute_global_for(ctx, out_s.elements() / tile, 256), 256);
+
+        auto src = interpolate_string(group_conv_kernel,
+                                      {{"kernel", options.kernel_name},
+                                       {"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"post", v.get("post", std::string{"op::id{}"})},
+                                       {"preamble", v.get("preamble", std::string{})},
+                                       {"groups", to_string(v.at("group").to<std::size_t>())},
+                                       {"tile", to_string(tile)},
+                                       {"window", to_string_range(window)},
+                                       {"stride", to_string_range(stride)},
+                                       {"padding", to_string_range(padding)},
+                                       {"dilation", to_string_range(dilation)}});
+
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace
+    compile(context& ctx, instruction_ref ins, const operation& op, const value& solution) const
+    {
+        auto v = op.to_value();
+        for(const auto& x : solution)
+            v[x.get_key()] = x.without_key();
+        // A pointwise module fused after the convolution, such as a bias add and an activation
+        if(not ins->module_inputs().empty())
+        {
+            auto* pm      = ins->module_inputs().front();
+            v["preamble"] = generate_pointwise(*pm, "post_group_conv");
+            v["post"]     = "MIGRAPHX_LIFT(post_group_conv)";
+            v["kernel"]   = "group_conv_" + generate_name_from_ops(*pm) + "_kernel";
+        }
+        return compile_op(ctx, to_shapes(ins->inputs()), v);
+    }
+
+    // Tunes the block size and the number of outputs each thread computes
+    optional<tuning_config>
+    get_tuning_config(context&, instruction_ref ins, const operation& op, bool exhaustive) const
+    {
+        if(not exhaustive and not enabled(MIGRAPHX_TUNE_POINTWISE{}))
+            return nullopt;
+        auto shapes = to_shapes(ins->inputs());
+        std::vector<std::size_t> locals = {128, 256, 512};
+        if(exhaustive)
+            locals = {64, 128, 256, 512, 1024};
+
+        tuning_config tc;
+        tc.problem = {{"op", op.to_value()}, {"shapes", to_value(shapes)}};
+        auto max_tile = compute_tile(shapes.back(), 8);
+        for(std::size_t tile = 1; tile <= max_tile; tile *= 2)
+        {
+            for(auto local : locals)
+                tc.solutions.push_back({{"tile", tile}, {"local", local}});
+        }
+        return tc;
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
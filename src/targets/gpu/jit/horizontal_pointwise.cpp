@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/reduce_dims.hpp>
+#include <migraphx/stringutils.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const horizontal_pointwise_kernel = R"__migraphx__(
+#include <migraphx/kernels/horizontal.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+${preamble}
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void horizontal_pointwise_kernel(${params})
+{
+    auto idx = make_index();
+${kernels}
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct horizontal_pointwise_compiler : compiler<horizontal_pointwise_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::horizontal_pointwise"}; }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto ninputs = op.to_value().at("ninputs").to_vector<std::size_t>();
+        auto shapes  = to_shapes(ins->inputs());
+
+        const std::size_t local = 256;
+
+        hip_compile_options options;
+        options.inputs         = flatten(shapes);
+        options.output         = shapes.back();
+        options.virtual_inputs = options.inputs;
+        options.kernel_name    = "horizontal_pointwise_kernel";
+        options.emplace_param("-Wno-float-equal");
+
+        // The outputs are the flattened elements of the tuple passed last
+        auto first_output = options.inputs.size() - ninputs.size();
+        std::string preamble;
+        std::vector<std::string> kernels;
+        std::size_t ngroups = 0;
+        std::size_t offset  = 0;
+        for(std::size_t i = 0; i < ninputs.size(); i++)
+        {
+            auto fname = "inner_pointwise" + std::to_string(i);
+            preamble += gen::generate_pointwise(*ins->module_inputs()[i], fname, true);
+
+            std::vector<std::size_t> args(ninputs[i]);
+            std::iota(args.begin(), args.end(), offset);
+            args.push_back(first_output + i);
+            offset += ninputs[i];
+
+            // Each kernel indexes its own arguments, so their dims are reduced separately
+            std::vector<shape> sub_inputs;
+            std::transform(args.begin(),
+                           args.end(),
+                           std::back_inserter(sub_inputs),
+                           [&](auto arg) { return options.inputs[arg]; });
+            sub_inputs = reduce_dims(normalize_permutation(sub_inputs));
+            for(std::size_t j = 0; j < args.size(); j++)
+                options.virtual_inputs[args[j]] = sub_inputs[j];
+
+            auto elements = options.inputs[first_output + i].elements();
+            auto global   = compute_global_for(ctx, elements, 256)(local);
+            auto groups   = std::max<std::size_t>(1, (global + local - 1) / local);
+
+            // The output is passed first
+            std::rotate(args.rbegin(), args.rbegin() + 1, args.rend());
+            std::vector<std::string> tensors;
+            std::transform(args.begin(), args.end(), std::back_inserter(tensors), [](auto arg) {
+                auto n = std::to_string(arg);
+                return "make_tensor<" + n + ">::apply(private_p" + n + ")";
+            });
+            kernels.push_back("    horizontal_pointwise<" + std::to_string(ngroups) + ", " +
+                              std::to_string(ngroups + groups) + ">(idx, MIGRAPHX_LIFT(" +
+                              fname + "), " + join_strings(tensors, ", ") + ");");
+            ngroups += groups;
+        }
+        options.set_launch_params(value{}, ngroups * local, local);
+
+        auto src = interpolate_string(
+            horizontal_pointwise_kernel,
+            {{"params", enum_params(options.inputs.size(), "void * private_p")},
+             {"preamble", preamble},
+             {"kernels", join_strings(kernels, "\n")}});
+        return compile_hip_code_object(src, options);
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,117 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <migraphx/op/image_preprocess.hpp>
+#include <migraphx/serialize.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const image_preprocess_kernel = R"__migraphx__(
+#include <migraphx/kernels/image_preprocess.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+__constant__ index_int y_low[] = {${y_low}};
+__constant__ index_int y_high[] = {${y_high}};
+__constant__ float y_delta[] = {${y_delta}};
+__constant__ index_int x_low[] = {${x_low}};
+__constant__ index_int x_high[] = {${x_high}};
+__constant__ float x_delta[] = {${x_delta}};
+__constant__ float channel_mean[] = {${mean}};
+__constant__ float channel_stddev[] = {${stddev}};
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void image_preprocess_kernel(void* input_p, void* output_p)
+{
+    make_tensors()(input_p, output_p)([](auto input, auto output) {
+        image_preprocess(input,
+                         output,
+                         {y_low, y_high, y_delta},
+                         {x_low, x_high, x_delta},
+                         channel_mean,
+                         channel_stddev);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct image_preprocess_compiler : compiler<image_preprocess_compiler>
+{
+    std::vector<std::string> names() const { return {"image_preprocess"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        auto op             = from_value<op::image_preprocess>(v);
+        const auto& in_lens = inputs.front().lens();
+        // The sampled pixels are computed here once, instead of in each thread
+        auto ys = op.samples(0, in_lens[1]);
+        auto xs = op.samples(1, in_lens[2]);
+        std::vector<float> mean(in_lens[3]);
+        std::vector<float> stddev(in_lens[3]);
+        for(std::size_t c = 0; c < in_lens[3]; c++)
+        {
+            mean[c]   = op.channel_mean(c);
+            stddev[c] = op.channel_stddev(c);
+        }
+
+        hip_compile_options options;
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "image_preprocess_kernel";
+        options.set_launch_params(v, compute_global_for(ctx, inputs.back().elements()));
+
+        auto src = interpolate_string(image_preprocess_kernel,
+                                      {{"y_low", to_string_range(ys.low)},
+                                       {"y_high", to_string_range(ys.high)},
+                                       {"y_delta", gen::generate_float_list(ys.delta)},
+                                       {"x_low", to_string_range(xs.low)},
+                                       {"x_high", to_string_range(xs.high)},
+                                       {"x_delta", gen::generate_float_list(xs.delta)},
+                                       {"mean", gen::generate_float_list(mean)},
+                                       {"stddev", gen::generate_float_list(stddev)}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
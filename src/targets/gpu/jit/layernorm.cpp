@@ -50,7 +50,7 @@ ${preamble}
 extern "C" {
 MIGRAPHX_GLOBAL void ${kernel}(${params}) 
 {
-    transform_args(make_tensors(), rotate_last(), ${transformers})(${args})([](auto... xs) {
+    transform_args(make_tensors(), rotate_last<${noutputs}>(), ${transformers})(${args})([](auto... xs) {
         ${layernorm}<${axis}>(${post}, ${eps}, xs...);
     });
 }
@@ -65,35 +65,42 @@ struct layernorm_compiler : compiler<layernorm_compiler>
 {
     std::vector<std::string> names() const
     {
-        return {"layernorm", "gpu::prelayernorm", "gpu::preadd_layernorm"};
+        return {"layernorm",
+                "gpu::prelayernorm",
+                "gpu::preadd_layernorm",
+                "gpu::prerms_norm",
+                "gpu::preadd_rms_norm"};
     }
 
     operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
     {
         // TODO: Use reduce_dims
-        auto axis  = inputs.front().lens().size() - 1;
-        auto faxis = find_fast_axis({inputs.front()});
+        auto finputs  = flatten(inputs);
+        auto noutputs = finputs.size() - inputs.size() + 1;
+        auto axis     = inputs.front().lens().size() - 1;
+        auto faxis    = find_fast_axis({inputs.front()});
         vectorize vec{};
         // Vectorize if the axis is a reduction axis
         if(axis == faxis)
         {
-            vec = vectorize::elements(ctx, faxis, inputs);
+            vec = vectorize::elements(ctx, faxis, finputs);
         }
         auto relements  = inputs[0].lens()[axis] / vec.size;
-        auto nelements  = (inputs.back().elements() / inputs[0].lens()[axis]);
+        auto nelements  = (finputs.back().elements() / inputs[0].lens()[axis]);
         auto block_size = compute_block_size(ctx, relements, 256);
         hip_compile_options options;
         options.set_launch_params(
             v, compute_global_for(ctx, nelements * block_size, 256), block_size);
         options.output      = inputs.back();
-        options.inputs      = inputs;
+        options.inputs      = finputs;
         options.kernel_name = v.get("kernel", "layernorm_kernel");
         auto eps            = v.get("epsilon", 1e-12f);
 
         auto src = interpolate_string(layernorm_kernel,
                                       {{"kernel", options.kernel_name},
-                                       {"params", enum_params(inputs.size(), "void * private_p")},
-                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"params", enum_params(finputs.size(), "void * private_p")},
+                                       {"args", enum_params(finputs.size(), "private_p")},
+                                       {"noutputs", std::to_string(noutputs)},
                                        {"transformers", make_transformer_args(vec)},
                                        {"post", v.get("post", std::string{"op::id{}"})},
                                        {"preamble", v.get("preamble", std::string{})},
@@ -114,6 +121,22 @@ struct layernorm_compiler : compiler<layernorm_compiler>
             v["layernorm"] = "add_layernorm";
             v["kernel"]    = "add_layernorm_kernel";
         }
+        else if(op.name() == "gpu::prerms_norm")
+        {
+            v["layernorm"] = "rms_norm";
+            v["kernel"]    = "rms_norm_kernel";
+        }
+        else if(op.name() == "gpu::preadd_rms_norm")
+        {
+            v["layernorm"] = "add_rms_norm";
+            v["kernel"]    = "add_rms_norm_kernel";
+        }
+        // The sum of the inputs is written as the second output
+        if(v.get("residual", false))
+        {
+            v["layernorm"] = v["layernorm"].to<std::string>() + "_residual";
+            v["kernel"]    = v["layernorm"].to<std::string>() + "_kernel";
+        }
         if(not ins->module_inputs().empty())
         {
             auto* pm      = ins->module_inputs().front();
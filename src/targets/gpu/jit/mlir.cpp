@@ -77,7 +77,9 @@ struct mlir_compiler : compiler<mlir_compiler>
         auto* smod = ins->module_inputs().front();
         assert(smod->get_parameter_names().size() == ins->inputs().size() - 1);
         auto gemm_like_ins = std::find_if(smod->begin(), smod->end(), [&](const auto& i) {
-            return contains({"dot", "quant_dot", "convolution", "quant_convolution"}, i.name());
+            return contains(
+                {"dot", "quant_dot", "convolution", "quant_convolution", "convolution_backwards"},
+                i.name());
         });
         auto pointwise_ins = std::find_if(gemm_like_ins, smod->end(), [&](const auto& i) {
             return i.get_operator().attributes().get("pointwise", false) == true;
@@ -119,21 +121,22 @@ struct mlir_compiler : compiler<mlir_compiler>
 
     compiler_replace insert(const mlir_code_object& mco) const
     {
-        return {std::vector<operation>{mco.cop},
-                [=](module& m, instruction_ref ins, const std::vector<operation>& ops) {
-                    std::vector<instruction_ref> inputs = ins->inputs();
-                    for(const auto i : range(mco.prefill_indices.size()))
-                    {
-                        auto prefilled_ins = m.insert_instruction(
-                            ins,
-                            migraphx::make_op("hip::fill", {{"value", mco.prefill_values[i]}}),
-                            inputs[mco.prefill_indices[i]]);
-                        replace(inputs, inputs[mco.prefill_indices[i]], prefilled_ins);
-                    }
-                    auto mlir = insert_mlir(m, ins, any_cast<code_object_op>(ops.front()), inputs);
-                    return m.replace_instruction(ins, mlir);
-                },
-                &trace};
+        auto insert_fn = [=](module& m, instruction_ref ins, const std::vector<operation>& ops) {
+            std::vector<instruction_ref> inputs = ins->inputs();
+            for(const auto i : range(mco.prefill_indices.size()))
+            {
+                auto prefilled_ins = m.insert_instruction(
+                    ins,
+                    migraphx::make_op("hip::fill", {{"value", mco.prefill_values[i]}}),
+                    inputs[mco.prefill_indices[i]]);
+                replace(inputs, inputs[mco.prefill_indices[i]], prefilled_ins);
+            }
+            auto mlir = insert_mlir(m, ins, any_cast<code_object_op>(ops.front()), inputs);
+            return m.replace_instruction(ins, mlir);
+        };
+        compiler_replace result{std::vector<operation>{mco.cop}, insert_fn, &trace};
+        result.independent = true;
+        return result;
     }
 
     compiler_replace insert(const std::vector<mlir_code_object>& mcos,
@@ -0,0 +1,142 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+using namespace migraphx::gpu::gen; // NOLINT
+
+// NOLINTNEXTLINE
+static const char* const moe_route_kernel = R"__migraphx__(
+#include <migraphx/kernels/moe.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void moe_route_kernel(void* indices, void* output)
+{
+    transform_args(make_tensors(), rotate_last())(indices, output)([](auto... xs) {
+        moe_route<${experts}>(xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// NOLINTNEXTLINE
+static const char* const moe_gemm_kernel = R"__migraphx__(
+#include <migraphx/kernels/moe.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void moe_gemm_kernel(void* x, void* w, void* route, void* output)
+{
+    transform_args(make_tensors(), rotate_last())(x, w, route, output)([](auto... xs) {
+        moe_gemm<${tile_m}>(xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct moe_route_compiler : compiler<moe_route_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::moe_route"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        hip_compile_options options;
+        // The pairs are counted and sorted by a single workgroup
+        auto block_size = compute_block_size(ctx, inputs.front().elements(), 1024);
+        options.set_launch_params(v, block_size, block_size);
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "moe_route_kernel";
+
+        auto src = interpolate_string(
+            moe_route_kernel, {{"experts", std::to_string(v.at("experts").to<std::size_t>())}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+// Number of sorted pairs computed by each workgroup of the grouped gemm
+constexpr std::size_t moe_tile_m = 8;
+
+struct moe_gemm_compiler : compiler<moe_gemm_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::moe_gemm"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& out_s = inputs.back();
+        auto n            = out_s.lens().back();
+        auto rows         = out_s.elements() / n;
+        auto tile_m       = std::min(rows, moe_tile_m);
+        auto ntiles       = (rows + tile_m - 1) / tile_m;
+
+        hip_compile_options options;
+        options.set_launch_params(
+            v,
+            [=](std::size_t local) { return ntiles * ((n + local - 1) / local) * local; },
+            compute_block_size(ctx, n, 256));
+        options.inputs      = inputs;
+        options.output      = out_s;
+        options.kernel_name = "moe_gemm_kernel";
+
+        auto src = interpolate_string(moe_gemm_kernel, {{"tile_m", std::to_string(tile_m)}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+using namespace migraphx::gpu::gen; // NOLINT
+
+static const char* const nonmaxsuppression_kernel = R"__migraphx__(
+#include <migraphx/kernels/nonmaxsuppression.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+MIGRAPHX_GLOBAL void nonmaxsuppression_kernel(${params})
+{
+    transform_args(make_tensors(), rotate_last<3>())(${args})([](auto... xs) {
+        nonmaxsuppression<${center_point_box}>(xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct nonmaxsuppression_compiler : compiler<nonmaxsuppression_compiler>
+{
+    std::vector<std::string> names() const { return {"nonmaxsuppression"}; }
+
+    // The state holds the tile counter and the status of every class, and the workspace holds
+    // the sort keys of every class padded to a power of 2
+    static std::vector<shape> scratch_shapes(const shape& scores)
+    {
+        auto lens        = scores.lens();
+        std::size_t npad = 1;
+        while(npad < lens[2])
+            npad *= 2;
+        auto nclasses = lens[0] * lens[1];
+        return {shape{shape::uint64_type, {nclasses + 1}},
+                shape{shape::uint64_type, {nclasses, npad}}};
+    }
+
+    // The inputs are the boxes, the scores, the optional scalars, the state, the workspace and
+    // the output
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& workspace = inputs.at(inputs.size() - 2);
+        auto block_size       = compute_block_size(ctx, workspace.lens()[1], 1024);
+        hip_compile_options options;
+        // Every class needs its own workgroup since the classes are taken from a counter
+        options.set_launch_params(v, workspace.lens()[0] * block_size, block_size);
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "nonmaxsuppression_kernel";
+
+        auto src = interpolate_string(
+            nonmaxsuppression_kernel,
+            {{"params", enum_params(inputs.size(), "void * private_p")},
+             {"args", enum_params(inputs.size(), "private_p")},
+             {"center_point_box", v.at("center_point_box").to<bool>() ? "true" : "false"}});
+
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto scratch = scratch_shapes(ins->inputs().at(1)->get_shape());
+        auto shapes  = to_shapes(ins->inputs());
+        shapes.insert(std::prev(shapes.end()), scratch.begin(), scratch.end());
+        auto replace = [=](module& m, instruction_ref ins2, const operation& code_object) {
+            auto args   = ins2->inputs();
+            auto output =
+                m.insert_instruction(ins2, make_op("hip::fill", {{"value", 0}}), args.back());
+            args.pop_back();
+            auto state = m.insert_instruction(
+                ins2, make_op("hip::allocate", {{"shape", to_value(scratch.front())}}));
+            args.push_back(m.insert_instruction(ins2, make_op("hip::fill", {{"value", 0}}), state));
+            args.push_back(m.insert_instruction(
+                ins2, make_op("hip::allocate", {{"shape", to_value(scratch.back())}})));
+            args.push_back(output);
+            m.replace_instruction(ins2, code_object, args);
+        };
+        compiler_replace result{compile_op(ctx, shapes, op.to_value()), replace};
+        result.independent = true;
+        return result;
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
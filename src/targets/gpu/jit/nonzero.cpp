@@ -0,0 +1,111 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/gpu/context.hpp>
+
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const nonzero_kernel = R"__migraphx__(
+#include <migraphx/kernels/nonzero.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void nonzero_kernel(void* input, void* state, void* output)
+{
+    make_tensors()(input, state, output)([](auto&&... xs) {
+        nonzero<${items}>(xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct nonzero_compiler : compiler<nonzero_compiler>
+{
+    static constexpr std::size_t block_size       = 256;
+    static constexpr std::size_t items_per_thread = 4;
+    static constexpr std::size_t tile             = block_size * items_per_thread;
+
+    std::vector<std::string> names() const { return {"nonzero"}; }
+
+    // The first word is the tile counter followed by the status of each tile
+    static shape state_shape(const shape& input)
+    {
+        return {shape::uint64_type, {2 + (input.elements() - 1) / tile}};
+    }
+
+    operation compile_op(context&, const std::vector<shape>& inputs, const value& v) const
+    {
+        hip_compile_options options;
+        // Every tile needs its own workgroup since the tiles are taken from a counter
+        auto ntiles = inputs.at(1).elements() - 1;
+        options.set_launch_params(v, ntiles * block_size, block_size);
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "nonzero_kernel";
+        options.emplace_param("-Wno-float-equal");
+
+        auto src =
+            interpolate_string(nonzero_kernel, {{"items", std::to_string(items_per_thread)}});
+
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto state  = state_shape(ins->inputs().front()->get_shape());
+        auto shapes = to_shapes(ins->inputs());
+        shapes.insert(shapes.begin() + 1, state);
+        auto replace = [=](module& m, instruction_ref ins2, const operation& code_object) {
+            auto alloc =
+                m.insert_instruction(ins2, make_op("hip::allocate", {{"shape", to_value(state)}}));
+            auto zero_state =
+                m.insert_instruction(ins2, make_op("hip::fill", {{"value", 0}}), alloc);
+            auto zero_output = m.insert_instruction(
+                ins2, make_op("hip::fill", {{"value", 0}}), ins2->inputs().back());
+            m.replace_instruction(
+                ins2, code_object, {ins2->inputs().front(), zero_state, zero_output});
+        };
+        compiler_replace result{compile_op(ctx, shapes, op.to_value()), replace};
+        result.independent = true;
+        return result;
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/gpu/context.hpp>
+
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const kv_cache_update_kernel = R"__migraphx__(
+#include <migraphx/kernels/paged_attention.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void kv_cache_update_kernel(${params})
+{
+    make_tensors()(${args})([](auto... xs) {
+        kv_cache_update(xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// NOLINTNEXTLINE
+static const char* const kv_cache_copy_blocks_kernel = R"__migraphx__(
+#include <migraphx/kernels/paged_attention.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void kv_cache_copy_blocks_kernel(void* copies_p, void* cache_p)
+{
+    make_tensors()(copies_p, cache_p)([](auto copies, auto cache) {
+        kv_cache_copy_blocks(copies, cache);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// NOLINTNEXTLINE
+static const char* const paged_attention_kernel = R"__migraphx__(
+#include <migraphx/kernels/paged_attention.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void paged_attention_kernel(${params})
+{
+    make_tensors()(${args})([](auto... xs) {
+        paged_attention(xs..., ${scale});
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct kv_cache_update_compiler : compiler<kv_cache_update_compiler>
+{
+    std::vector<std::string> names() const { return {"kv_cache_update"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        hip_compile_options options;
+        options.set_launch_params(v, compute_global_for(ctx, inputs.front().elements()));
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "kv_cache_update_kernel";
+
+        auto src = interpolate_string(kv_cache_update_kernel,
+                                      {{"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")}});
+        return compile_hip_code_object(src, options);
+    }
+
+    // The cache is updated in place, so it is passed as the output of the kernel instead of
+    // the allocation that lowering added. The optional scales stay in front of it.
+    static std::vector<instruction_ref> kernel_args(instruction_ref ins)
+    {
+        auto args = ins->inputs();
+        std::rotate(args.begin(), args.begin() + 1, args.end() - 1);
+        args.pop_back();
+        return args;
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto replace = [](module& m, instruction_ref ins2, const operation& code_object) {
+            return m.replace_instruction(ins2, code_object, kernel_args(ins2));
+        };
+        compiler_replace result{compile_op(ctx, to_shapes(kernel_args(ins)), op.to_value()),
+                                replace};
+        result.independent = true;
+        return result;
+    }
+};
+
+struct kv_cache_copy_blocks_compiler : compiler<kv_cache_copy_blocks_compiler>
+{
+    std::vector<std::string> names() const { return {"kv_cache_copy_blocks"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& cache = inputs.back();
+        auto ncopies      = inputs.front().lens()[0];
+        hip_compile_options options;
+        options.set_launch_params(
+            v, compute_global_for(ctx, ncopies * cache.elements() / cache.lens()[0]));
+        options.inputs      = inputs;
+        options.output      = cache;
+        options.kernel_name = "kv_cache_copy_blocks_kernel";
+        return compile_hip_code_object(kv_cache_copy_blocks_kernel, options);
+    }
+
+    // The blocks are copied in place, so the cache is passed as the output of the kernel
+    // instead of the allocation that lowering added
+    static std::vector<instruction_ref> kernel_args(instruction_ref ins)
+    {
+        return {ins->inputs()[1], ins->inputs()[0]};
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto replace = [](module& m, instruction_ref ins2, const operation& code_object) {
+            return m.replace_instruction(ins2, code_object, kernel_args(ins2));
+        };
+        compiler_replace result{compile_op(ctx, to_shapes(kernel_args(ins)), op.to_value()),
+                                replace};
+        result.independent = true;
+        return result;
+    }
+};
+
+struct paged_attention_compiler : compiler<paged_attention_compiler>
+{
+    std::vector<std::string> names() const { return {"paged_attention"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& qlens = inputs.front().lens();
+        auto head_dim     = qlens[3];
+        auto ngroups      = qlens[0] * qlens[1] * qlens[2];
+        auto context_len  = inputs[3].lens()[1] * inputs[1].lens()[1];
+        auto block_size =
+            compute_block_size(ctx, std::max<std::size_t>(context_len, head_dim), 1024);
+        if(block_size < head_dim)
+            MIGRAPHX_THROW("PAGED_ATTENTION: head_dim " + std::to_string(head_dim) +
+                           " is larger than the maximum workgroup size");
+        auto scale = v.get("scale", 0.0f);
+        if(scale == 0.0f)
+            scale = 1.0f / std::sqrt(static_cast<float>(head_dim));
+
+        hip_compile_options options;
+        options.set_launch_params(
+            v, [=](std::size_t local) { return ngroups * local; }, block_size);
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "paged_attention_kernel";
+
+        auto src = interpolate_string(paged_attention_kernel,
+                                      {{"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"scale", to_string(scale)}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
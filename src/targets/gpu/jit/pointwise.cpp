@@ -28,6 +28,7 @@
 #include <migraphx/gpu/compile_hip.hpp>
 #include <migraphx/gpu/compile_gen.hpp>
 #include <migraphx/gpu/compile_pointwise.hpp>
+#include <migraphx/env.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -35,6 +36,8 @@ namespace gpu {
 
 using namespace migraphx::gpu::gen; // NOLINT
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_POINTWISE);
+
 static const char* const pointwise_kernel = R"__migraphx__(
 #include <migraphx/kernels/index.hpp>
 #include <migraphx/kernels/pointwise.hpp>
@@ -76,14 +79,18 @@ struct pointwise_compiler : compiler<pointwise_compiler>
         options.virtual_inputs = reduce_dims(normalize_permutation(options.inputs));
         options.emplace_param("-Wno-float-equal");
         auto axis              = find_fast_axis(options.virtual_inputs);
-        auto vec               = vectorize::elements(ctx, axis, options.virtual_inputs);
         options.kernel_name    = v.get("kernel", "kernel");
         auto noutputs = options.inputs.size() - inputs.size() + 1;
         auto t                 = tile::elements(options.virtual_inputs, noutputs);
-        // auto t = tile{};
+        // Transposed arguments are staged through LDS while the rest use vector loads
+        auto vec = t.ntiles == 0 ? vectorize::elements(ctx, axis, options.virtual_inputs, v)
+                                 : t.vectorize_elements(ctx, options.virtual_inputs, v);
         if(t.ntiles == 0)
-            options.set_launch_params(
-                v, compute_global_for(ctx, options.inputs.front().elements() / vec.size, 256));
+            options.set_launch_params(v,
+                                      compute_global_for(ctx,
+                                                         options.inputs.front().elements() /
+                                                             vec.size,
+                                                         v.get("over", std::size_t{256})));
         else
             options.set_launch_params(
                 v, compute_global_for(ctx, t.ntiles * t.block_size, 256), t.block_size);
@@ -100,21 +107,60 @@ struct pointwise_compiler : compiler<pointwise_compiler>
         return compile_hip_code_object(src, options);
     }
 
-    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    compiler_replace
+    compile(context& ctx, instruction_ref ins, const operation& op, const value& solution) const
     {
         if(contains({"layout", "contiguous"}, op.name()))
         {
-            return compile_op(ctx,
-                              to_shapes(ins->inputs()),
-                              {{"lambda", "[](auto x) { return make_tuple(x); }"},
-                               {"kernel", op.name() + "_kernel"}});
+            value v = {{"lambda", "[](auto x) { return make_tuple(x); }"},
+                       {"kernel", op.name() + "_kernel"}};
+            for(const auto& x : solution)
+                v[x.get_key()] = x.without_key();
+            return compile_op(ctx, to_shapes(ins->inputs()), v);
         }
         else
         {
             assert(not ins->module_inputs().empty());
             const_module_ref pm = ins->module_inputs().front();
-            return compile_pointwise(ctx, to_shapes(ins->inputs()), pm);
+            return compile_pointwise(ctx, to_shapes(ins->inputs()), pm, solution);
+        }
+    }
+
+    // Tunes the vector size, the block size and how many elements each thread loops over with
+    // the grid stride
+    optional<tuning_config>
+    get_tuning_config(context&, instruction_ref ins, const operation& op, bool exhaustive) const
+    {
+        if(not exhaustive and not enabled(MIGRAPHX_TUNE_POINTWISE{}))
+            return nullopt;
+        auto shapes         = to_shapes(ins->inputs());
+        auto inputs         = flatten(shapes);
+        auto virtual_inputs = reduce_dims(normalize_permutation(inputs));
+        // The block size of tiled kernels is fixed by the tile
+        if(tile::elements(virtual_inputs, inputs.size() - shapes.size() + 1).ntiles > 0)
+            return nullopt;
+        std::string kernel = op.name();
+        if(not ins->module_inputs().empty())
+            kernel = generate_name_from_ops(*ins->module_inputs().front(), "kernel");
+        std::vector<std::size_t> locals = {128, 256, 512};
+        std::vector<std::size_t> overs  = {4, 256};
+        if(exhaustive)
+        {
+            locals = {64, 128, 256, 512, 1024};
+            overs  = {1, 4, 16, 256};
+        }
+        tuning_config tc;
+        tc.problem = {{"kernel", kernel}, {"shapes", to_value(shapes)}};
+        for(auto vec : vectorize::tunable_sizes(find_fast_axis(virtual_inputs), virtual_inputs))
+        {
+            for(auto local : locals)
+            {
+                for(auto over : overs)
+                    tc.solutions.push_back(
+                        {{"vector_size", vec}, {"local", local}, {"over", over}});
+            }
         }
+        return tc;
     }
 };
 } // namespace gpu
@@ -28,11 +28,14 @@
 
 #include <migraphx/gpu/compile_hip_code_object.hpp>
 #include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/env.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_POINTWISE);
+
 // NOLINTNEXTLINE
 static const char* const pooling_kernel = R"__migraphx__(
 #include <migraphx/kernels/pooling.hpp>
@@ -48,7 +51,7 @@ extern "C" {
 MIGRAPHX_GLOBAL void pooling_kernel(void* in_data, void* output)
 {
     transform_args(make_tensors(), rotate_last())(in_data, output)([](auto&&... xs) {
-        pooling<${algo}, ${group_size}>(${op}, make_window(index_ints<${window}>{}, index_ints<${stride}>{}, index_ints<${padding}>{}), xs...);
+        pooling<${algo}, ${group_size}>(${op}, make_window(index_ints<${window}>{}, index_ints<${stride}>{}, index_ints<${padding}>{}, index_ints<${dilation}>{}), xs...);
     });
 }
 
@@ -150,9 +153,10 @@ struct pooling_compiler : compiler<pooling_compiler>
             }
         };
 
-        auto padding = read_value("padding", 0);
-        auto stride  = read_value("stride", 1);
-        auto window  = read_value("lengths", 1);
+        auto padding  = read_value("padding", 0);
+        auto stride   = read_value("stride", 1);
+        auto window   = read_value("lengths", 1);
+        auto dilation = read_value("dilations", 1);
 
         const auto& mode_v = v.at("mode");
         std::string mode =
@@ -165,26 +169,76 @@ struct pooling_compiler : compiler<pooling_compiler>
         if(mode == "lpnorm")
             op += "<" + v.at("lp_order").to<std::string>() + ">";
 
+        normalize(options.virtual_inputs, padding, stride, window, dilation);
         algorithm algo{};
+        if(v.get("algo", std::string{"lane"}) == "window")
+        {
+            algo = algorithm{ctx, options.virtual_inputs.front(), window};
+        }
+        else
+        {
+            // Each thread computes group_size outputs along the fastest axis
+            auto group_size = v.get("group_size", std::size_t{1});
+            if(algorithm::compute_group_size(options.virtual_inputs.back()) % group_size == 0)
+                algo.group_size = group_size;
+        }
         options.set_launch_params(
             v,
             compute_global_for(ctx, (out_s.elements() / algo.group_size) * algo.reduce_size, 256),
             algo.block_size);
-        normalize(options.virtual_inputs, padding, stride, window);
         auto src = interpolate_string(pooling_kernel,
                                       {{"op", op + "{}"},
                                        {"algo", algo.name},
                                        {"group_size", to_string(algo.group_size)},
                                        {"window", to_string_range(window)},
                                        {"stride", to_string_range(stride)},
-                                       {"padding", to_string_range(padding)}});
+                                       {"padding", to_string_range(padding)},
+                                       {"dilation", to_string_range(dilation)}});
 
         return compile_hip_code_object(src, options);
     }
 
-    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    compiler_replace
+    compile(context& ctx, instruction_ref ins, const operation& op, const value& solution) const
     {
-        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+        auto v = op.to_value();
+        for(const auto& x : solution)
+            v[x.get_key()] = x.without_key();
+        return compile_op(ctx, to_shapes(ins->inputs()), v);
+    }
+
+    // Tunes the block size and the number of outputs each thread computes for lane pooling, and
+    // whether to reduce each window with a whole wave or block instead
+    optional<tuning_config>
+    get_tuning_config(context& ctx, instruction_ref ins, const operation& op, bool exhaustive) const
+    {
+        if(not exhaustive and not enabled(MIGRAPHX_TUNE_POINTWISE{}))
+            return nullopt;
+        auto shapes = to_shapes(ins->inputs());
+        auto v      = op.to_value();
+        auto inputs = shapes;
+        auto window = v.at("lengths").to_vector<std::size_t>();
+        window.insert(window.begin(), 2, 1);
+        normalize(inputs, window);
+        std::vector<std::size_t> locals = {128, 256, 512};
+        if(exhaustive)
+            locals = {64, 128, 256, 512, 1024};
+        // Also try a single wave on wave32 devices
+        auto wavefront_size = ctx.get_current_device().get_wavefront_size();
+        if(exhaustive and wavefront_size < locals.front())
+            locals.insert(locals.begin(), wavefront_size);
+
+        tuning_config tc;
+        tc.problem = {{"op", v}, {"shapes", to_value(shapes)}};
+        auto max_group_size = algorithm::compute_group_size(inputs.back());
+        for(std::size_t group_size = 1; group_size <= max_group_size; group_size *= 2)
+        {
+            for(auto local : locals)
+                tc.solutions.push_back({{"group_size", group_size}, {"local", local}});
+        }
+        if(inputs.front().strides().back() == 1 and window.back() > 1)
+            tc.solutions.push_back({{"algo", "window"}});
+        return tc;
     }
 };
 
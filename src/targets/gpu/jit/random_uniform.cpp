@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const random_uniform_kernel = R"__migraphx__(
+#include <migraphx/kernels/random.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void random_uniform_kernel(void* seed_p, void* output_p)
+{
+    make_tensors()(seed_p, output_p)([](auto seed, auto output) {
+        random_uniform(seed, output);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct random_uniform_compiler : compiler<random_uniform_compiler>
+{
+    std::vector<std::string> names() const { return {"random_uniform"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        hip_compile_options options;
+        options.set_launch_params(v, compute_global_for(ctx, inputs.back().elements()));
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "random_uniform_kernel";
+
+        return compile_hip_code_object(random_uniform_kernel, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        // The buffer passed to random_uniform only gives the shape, so its not an input to the
+        // kernel
+        auto seed   = ins->inputs().front()->get_shape();
+        auto output = ins->get_shape();
+        auto replace = [=](module& m, instruction_ref ins2, const operation& code_object) {
+            m.replace_instruction(
+                ins2, code_object, {ins2->inputs().front(), ins2->inputs().back()});
+        };
+        compiler_replace result{compile_op(ctx, {seed, output}, op.to_value()), replace};
+        result.independent = true;
+        return result;
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
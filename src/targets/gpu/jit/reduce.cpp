@@ -29,6 +29,7 @@
 #include <migraphx/reduce_dims.hpp>
 #include <migraphx/algorithm.hpp>
 #include <migraphx/array.hpp>
+#include <migraphx/env.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -36,6 +37,8 @@ namespace gpu {
 
 using namespace migraphx::gpu::gen; // NOLINT
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_POINTWISE);
+
 static const char* const simple_reduce_kernel = R"__migraphx__(
 #include <migraphx/kernels/index.hpp>
 #include <migraphx/kernels/reduce.hpp>
@@ -52,7 +55,7 @@ MIGRAPHX_GLOBAL void reduce_kernel(void* input_p, void* output_p)
     
     transform_args(make_tensors(), ${transformers})(input_p, output_p)([](auto input, auto output) {
 
-        simple_reduce<reduce::${algo}>(${reduction}, ${init}, input, output, ${read}, ${write});
+        simple_${method}<reduce::${algo}>(${reduction}, ${init}, input, output, ${read}, ${write});
     });
 }
     
@@ -113,7 +116,9 @@ static std::string get_reduce_algo(context& ctx, const std::vector<shape>& input
         [](auto len, auto stride) { return len == 1 ? init : stride; });
     if(min_stride > 2)
         return "lane";
-    if(relements <= ctx.get_current_device().get_wavefront_size())
+    // A wave32 device still reduces up to 64 elements in a single wave with two elements per
+    // lane, which avoids the shared memory round trip of a block reduction
+    if(relements <= std::max<std::size_t>(ctx.get_current_device().get_wavefront_size(), 64))
         return "wave";
     return "block";
 }
@@ -205,7 +210,9 @@ struct simple_reduce_compiler : compiler<simple_reduce_compiler>
                 "reduce_min",
                 "reduce_prod",
                 "reduce_any",
-                "reduce_all"};
+                "reduce_all",
+                "argmax",
+                "argmin"};
     }
 
     static std::size_t get_reduce_elements(const std::vector<shape>& inputs)
@@ -223,10 +230,12 @@ struct simple_reduce_compiler : compiler<simple_reduce_compiler>
         vectorize vec{};
         auto nelements = options.virtual_inputs.back().elements();
         auto algo      = v.get("algo", get_reduce_algo(ctx, options.virtual_inputs));
+        auto method    = v.get("method", std::string{"reduce"});
         if(algo == "block" or algo == "wave")
         {
-            // Vectorize if the axis is a reduction axis
-            if(options.virtual_inputs.back().lens()[faxis] == 1)
+            // Vectorize if the axis is a reduction axis, the index of each element is only
+            // tracked without vectorization
+            if(options.virtual_inputs.back().lens()[faxis] == 1 and method == "reduce")
                 vec = vectorize::elements(ctx, faxis, options.virtual_inputs);
             auto relements  = get_reduce_elements(options.virtual_inputs) / vec.size;
             if(algo == "block")
@@ -262,6 +271,7 @@ struct simple_reduce_compiler : compiler<simple_reduce_compiler>
                                        {"read", v.get("read", identity)},
                                        {"write", v.get("write", identity)},
                                        {"algo", algo},
+                                       {"method", method},
                                        {"transformers", make_transformer_args(vec)},
                                        {"preamble", v.get("preamble", std::string{})}});
         options.emplace_param("-Wno-float-equal");
@@ -277,6 +287,7 @@ struct simple_reduce_compiler : compiler<simple_reduce_compiler>
         v["read"]      = r.read;
         v["write"]     = r.write;
         v["init"]      = r.init;
+        v["method"]    = r.method;
         return compile_op(ctx, to_shapes(ins->inputs()), v);
     }
 };
@@ -306,6 +317,12 @@ MIGRAPHX_GLOBAL void ${kernel}(${params})
 
 )__migraphx__";
 
+static bool has_arg_reduce(const module& m)
+{
+    return std::any_of(
+        m.begin(), m.end(), [](const instruction& ins) { return is_arg_reduce(ins.name()); });
+}
+
 struct fused_reduce_compiler : compiler<fused_reduce_compiler>
 {
     std::vector<std::string> names() const { return {"fused_reduce", "split_fused_reduce"}; }
@@ -318,18 +335,44 @@ struct fused_reduce_compiler : compiler<fused_reduce_compiler>
         return *it;
     }
 
-    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    // Picks the size of each group of a split reduction so all the outputs together are split into
+    // about 4 groups per CU, without going below the 1024 elements a block reduces efficiently
+    static std::size_t compute_split_size(context& ctx,
+                                          const std::vector<shape>& finputs,
+                                          const std::vector<std::size_t>& axes)
+    {
+        auto input     = get_input_shape(finputs);
+        auto outputs   = get_output_shape(input, axes).elements();
+        auto relements = input.elements() / outputs;
+        auto groups    = 4 * ctx.get_current_device().get_cu_count();
+        auto size      = std::max<std::size_t>(relements * outputs / groups, 1024);
+        // Always split into at least two groups
+        return std::min(size, relements / 2);
+    }
+
+    // Returns the virtual inputs followed by the reduction shape and the reduced output shape
+    static std::vector<shape> get_virtual_inputs(const std::vector<shape>& finputs,
+                                                 const std::vector<std::size_t>& axes,
+                                                 const std::string& assign,
+                                                 std::size_t split_size)
     {
-        auto assign         = v.get("assign", "assign_none");
-        auto axes           = v.at("axes").to_vector<std::size_t>();
-        auto finputs        = flatten(inputs);
-        auto noutputs       = finputs.size() - inputs.size() + 1;
         auto virtual_inputs = finputs;
         virtual_inputs.push_back(get_reduced_shape(get_input_shape(finputs), axes));
         virtual_inputs.push_back(get_output_shape(get_input_shape(finputs), axes));
-        virtual_inputs           = reduce_dims(normalize_permutation(virtual_inputs));
+        virtual_inputs = reduce_dims(normalize_permutation(virtual_inputs));
         if(assign != "assign_none")
-            virtual_inputs = split_reduce(virtual_inputs);
+            virtual_inputs = split_reduce(virtual_inputs, split_size);
+        return virtual_inputs;
+    }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        auto assign              = v.get("assign", "assign_none");
+        auto axes                = v.at("axes").to_vector<std::size_t>();
+        auto finputs             = flatten(inputs);
+        auto noutputs            = finputs.size() - inputs.size() + 1;
+        auto split_size          = v.get("split_size", compute_split_size(ctx, finputs, axes));
+        auto virtual_inputs      = get_virtual_inputs(finputs, axes, assign, split_size);
         auto reduce_output_shape = virtual_inputs.back();
         virtual_inputs.pop_back();
         auto reduction_shape = virtual_inputs.back();
@@ -348,11 +391,12 @@ struct fused_reduce_compiler : compiler<fused_reduce_compiler>
         {
             // Vectorize if the axis is a reduction axis
             if(reduce_output_shape.lens()[faxis] == 1)
-                vec = vectorize::elements(ctx, faxis, options.virtual_inputs);
+                vec = vectorize::elements(ctx, faxis, options.virtual_inputs, v);
             auto relements  = reduction_shape.elements() / vec.size;
             if(algo == "block")
             {
-                auto block_size = compute_block_size(ctx, relements, 256);
+                auto block_size =
+                    compute_block_size(ctx, relements, v.get("max_block_size", std::size_t{256}));
                 if(relements >= block_size * 256)
                     algo = "block_large";
                 options.set_launch_params(
@@ -392,7 +436,8 @@ struct fused_reduce_compiler : compiler<fused_reduce_compiler>
         return compile_hip_code_object(src, options);
     }
 
-    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    compiler_replace
+    compile(context& ctx, instruction_ref ins, const operation& op, const value& solution) const
     {
         assert(not ins->module_inputs().empty());
         auto v        = op.to_value();
@@ -400,8 +445,91 @@ struct fused_reduce_compiler : compiler<fused_reduce_compiler>
         v["preamble"] = generate_reduce(*rm, "fused_reduce_op");
         v["lambda"]   = "MIGRAPHX_LIFT(fused_reduce_op)";
         v["kernel"]   = generate_name_from_ops(*rm) + "_kernel";
+        // The launch parameters picked by tuning
+        for(const auto& x : solution)
+            v[x.get_key()] = x.without_key();
+        if(has_arg_reduce(*rm))
+            v["vector_size"] = 1;
         return compile_op(ctx, to_shapes(ins->inputs()), v);
     }
+
+    // Tunes the vector size and the block size of block reductions, and the block size of lane
+    // reductions
+    optional<tuning_config>
+    get_tuning_config(context& ctx, instruction_ref ins, const operation& op, bool exhaustive) const
+    {
+        if(not exhaustive and not enabled(MIGRAPHX_TUNE_POINTWISE{}))
+            return nullopt;
+        assert(not ins->module_inputs().empty());
+        auto v                   = op.to_value();
+        auto shapes              = to_shapes(ins->inputs());
+        auto axes                = v.at("axes").to_vector<std::size_t>();
+        auto assign              = v.get("assign", "assign_none");
+        auto split_size          = compute_split_size(ctx, flatten(shapes), axes);
+        auto virtual_inputs      = get_virtual_inputs(flatten(shapes), axes, assign, split_size);
+        auto reduce_output_shape = virtual_inputs.back();
+        virtual_inputs.pop_back();
+        auto reduction_shape = virtual_inputs.back();
+        virtual_inputs.pop_back();
+        auto algo = get_reduce_algo(ctx, virtual_inputs, reduction_shape.lens());
+        std::vector<std::size_t> block_sizes = {64, 128, 256, 512, 1024};
+        if(not exhaustive)
+            block_sizes = {128, 256, 512};
+        // Also try a single wave on wave32 devices, which skips the shared memory reduction
+        auto wavefront_size = ctx.get_current_device().get_wavefront_size();
+        if(exhaustive and wavefront_size < block_sizes.front())
+            block_sizes.insert(block_sizes.begin(), wavefront_size);
+
+        tuning_config tc;
+        tc.problem = {{"kernel", generate_name_from_ops(*ins->module_inputs().front())},
+                      {"axes", to_value(axes)},
+                      {"shapes", to_value(shapes)}};
+        if(algo == "block")
+        {
+            std::vector<std::size_t> vec_sizes = {1};
+            auto faxis                         = find_fast_axis({virtual_inputs.front()});
+            if(reduce_output_shape.lens()[faxis] == 1 and
+               not has_arg_reduce(*ins->module_inputs().front()))
+                vec_sizes = vectorize::tunable_sizes(faxis, virtual_inputs);
+            for(auto vec : vec_sizes)
+            {
+                for(auto block_size : block_sizes)
+                    tc.solutions.push_back({{"vector_size", vec}, {"max_block_size", block_size}});
+            }
+        }
+        else if(algo == "lane")
+        {
+            for(auto local : block_sizes)
+                tc.solutions.push_back({{"local", local}});
+        }
+        else
+        {
+            return nullopt;
+        }
+        // Split reductions also tune the size of each group around the one picked by
+        // compute_split_size, which keeps the reduction algo the same
+        if(assign != "assign_none")
+        {
+            std::vector<std::size_t> split_sizes = {split_size / 2, split_size, split_size * 2};
+            if(exhaustive)
+                split_sizes.insert(split_sizes.end(), {split_size / 4, split_size * 4});
+            auto input     = get_input_shape(flatten(shapes));
+            auto relements = input.elements() / get_output_shape(input, axes).elements();
+            std::vector<value> solutions;
+            for(auto size : split_sizes)
+            {
+                if(size < 256 or size >= relements)
+                    continue;
+                for(auto solution : tc.solutions)
+                {
+                    solution["split_size"] = size;
+                    solutions.push_back(solution);
+                }
+            }
+            tc.solutions = solutions;
+        }
+        return tc;
+    }
 };
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,153 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <migraphx/op/resize.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/serialize.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const resize_kernel = R"__migraphx__(
+#include <migraphx/kernels/resize.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+__constant__ index_int sample_indices[] = {${indices}};
+__constant__ float sample_weights[] = {${weights}};
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void resize_kernel(void* input_p, void* output_p)
+{
+    make_tensors()(input_p, output_p)([](auto input, auto output) {
+        auto samples =
+            make_resize_samples<${count}>(index_ints<${offsets}>{}, sample_indices, sample_weights);
+        resize<${outer}, ${outer_elements}, ${inner_elements}, ${neighbors}, ${group}>(
+            input, output, samples);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct resize_compiler : compiler<resize_compiler>
+{
+    std::vector<std::string> names() const { return {"resize"}; }
+
+    // The number of channels interpolated by each thread
+    static constexpr std::size_t group = 4;
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        if(inputs.size() != 2)
+            MIGRAPHX_THROW("GPU_RESIZE: the sizes or scales must be attributes");
+        auto op              = from_value<op::resize>(v);
+        const auto& in_lens  = inputs.front().lens();
+        const auto& out_lens = inputs.back().lens();
+        auto scales          = op.get_scales(in_lens);
+        auto count           = op.sample_count();
+
+        // The positions read are computed here once, instead of in each thread
+        std::vector<op::resize::axis_samples> axes;
+        for(std::size_t axis = 0; axis < in_lens.size(); ++axis)
+            axes.push_back(op.samples(in_lens[axis], out_lens[axis], scales[axis]));
+
+        // The leading axes that only read the same position are copied, so each thread
+        // interpolates all of them at a position of the remaining axes
+        auto is_copied = [&](std::size_t axis) {
+            if(in_lens[axis] != out_lens[axis])
+                return false;
+            const auto& s = axes[axis];
+            for(std::size_t j = 0; j < s.indices.size(); ++j)
+            {
+                if(not float_equal(s.weights[j], 0.0f) and s.indices[j] != j / count)
+                    return false;
+            }
+            return true;
+        };
+        std::size_t outer = 0;
+        while(outer + 1 < axes.size() and is_copied(outer))
+            outer++;
+
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> indices;
+        std::vector<float> weights;
+        for(std::size_t axis = outer; axis < axes.size(); ++axis)
+        {
+            offsets.push_back(indices.size());
+            indices.insert(indices.end(), axes[axis].indices.begin(), axes[axis].indices.end());
+            weights.insert(weights.end(), axes[axis].weights.begin(), axes[axis].weights.end());
+        }
+        auto product = [](auto first, auto last) {
+            return std::accumulate(first, last, std::size_t{1}, std::multiplies<>{});
+        };
+        auto outer_elements = product(out_lens.begin(), out_lens.begin() + outer);
+        auto inner_elements = product(out_lens.begin() + outer, out_lens.end());
+        auto groups         = (outer_elements + group - 1) / group;
+
+        // The combinations of the positions read along each resized axis
+        std::size_t neighbors = 1;
+        for(std::size_t axis = outer; axis < axes.size(); ++axis)
+            neighbors *= count;
+
+        hip_compile_options options;
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "resize_kernel";
+        options.set_launch_params(v, compute_global_for(ctx, inner_elements * groups));
+
+        auto src = interpolate_string(resize_kernel,
+                                      {{"indices", to_string_range(indices)},
+                                       {"weights", gen::generate_float_list(weights)},
+                                       {"count", std::to_string(count)},
+                                       {"offsets", to_string_range(offsets)},
+                                       {"outer", std::to_string(outer)},
+                                       {"outer_elements", std::to_string(outer_elements)},
+                                       {"inner_elements", std::to_string(inner_elements)},
+                                       {"neighbors", std::to_string(neighbors)},
+                                       {"group", std::to_string(group)}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/op/common.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const rnn_variable_seq_lens_kernel = R"__migraphx__(
+#include <migraphx/kernels/rnn_variable_seq_lens.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void ${kernel}(void* input_p, void* seq_lens_p, void* output_p)
+{
+    make_tensors()(input_p, seq_lens_p, output_p)([](auto input, auto seq_lens, auto output) {
+        ${op}(input, seq_lens, output);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct rnn_variable_seq_lens_compiler : compiler<rnn_variable_seq_lens_compiler>
+{
+    std::vector<std::string> names() const
+    {
+        return {"rnn_var_sl_shift_sequence", "rnn_var_sl_shift_output", "rnn_var_sl_last_output"};
+    }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        auto name = v.at("name").to<std::string>();
+        hip_compile_options options;
+        options.set_launch_params(v, compute_global_for(ctx, inputs.back().elements()));
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = name + "_kernel";
+
+        // Only the shifted sequence is the same for both directions
+        std::string kernel_op = name;
+        if(v.contains("direction"))
+        {
+            bool reverse = v.at("direction").to<op::rnn_direction>() == op::rnn_direction::reverse;
+            kernel_op += reverse ? "<true>" : "<false>";
+        }
+
+        auto src = interpolate_string(rnn_variable_seq_lens_kernel,
+                                      {{"kernel", options.kernel_name}, {"op", kernel_op}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto v    = op.to_value();
+        v["name"] = op.name();
+        return compile_op(ctx, to_shapes(ins->inputs()), v);
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -58,19 +58,30 @@ struct scatter_elements_compiler : scatter_compiler<scatter_elements_compiler>
         return {"scatter_none", "scatter_add", "scatter_mul", "scatter_min", "scatter_max"};
     }
 
+    std::string get_reduction(const operation& op) const
+    {
+        return op.name().substr(std::char_traits<char>::length("scatter_"));
+    }
+
     std::string make_interpolated_string(const operation& op) const
     {
-        const auto reduction = op.name().substr(std::char_traits<char>::length("scatter_"));
-        auto axis            = std::to_string(op.to_value().get("axis", 0));
+        auto axis               = std::to_string(op.to_value().get("axis", 0));
         auto skip_out_of_bounds = std::to_string(op.to_value().get("skip_out_of_bounds", 0));
 
         return interpolate_string(scatter_elements_kernel,
-                                  {{"reduction", "assign_" + reduction},
+                                  {{"reduction", "assign_" + get_reduction(op)},
                                    {"axis", axis},
                                    {"skip_out_of_bounds", skip_out_of_bounds}});
     }
 
     std::string get_kernel_name(const operation&) const { return "scatter_elements_kernel"; }
+
+    std::string get_kernel_header() const { return "scatter.hpp"; }
+
+    std::string get_offset_function(const operation& op) const
+    {
+        return "scatter_offset<" + std::to_string(op.to_value().get("axis", 0)) + ">";
+    }
 };
 
 } // namespace gpu
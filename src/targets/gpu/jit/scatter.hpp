@@ -29,11 +29,87 @@
 #include <migraphx/gpu/context.hpp>
 #include <migraphx/gpu/compile_hip_code_object.hpp>
 #include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/stringutils.hpp>
+#include <limits>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_SORTED_SCATTER)
+
+// NOLINTNEXTLINE
+static const char* const scatter_sorted_keys_kernel = R"__migraphx__(
+#include <migraphx/kernels/scatter_sorted.hpp>
+#include <migraphx/kernels/${header}>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void scatter_sorted_keys_kernel(void* in_indices, void* in_updates, void* output, void* keys) 
+{
+    make_tensors()(in_indices, in_updates, output, keys)([](auto indices, auto updates, auto out, auto ks) { 
+        scatter_sorted_keys<${tile}>(ks, updates.get_shape().elements(), [&](auto i, auto& offset) {
+            return ${offset}(indices, updates, out, i, offset);
+        });
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// NOLINTNEXTLINE
+static const char* const scatter_sorted_merge_kernel = R"__migraphx__(
+#include <migraphx/kernels/scatter_sorted.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void scatter_sorted_merge_kernel(void* input, void* output) 
+{
+    make_tensors()(input, output)([](auto x, auto y) { 
+        scatter_sorted_merge<${width}>(x, y);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// NOLINTNEXTLINE
+static const char* const scatter_sorted_reduce_kernel = R"__migraphx__(
+#include <migraphx/kernels/scatter_sorted.hpp>
+#include <migraphx/kernels/scatter_reduction_modes.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void scatter_sorted_reduce_kernel(void* keys, void* in_updates, void* output) 
+{
+    make_tensors()(keys, in_updates, output)([](auto&&... xs) { 
+        scatter_sorted_reduce(xs..., ${reduction}{});
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
 template <typename Derived>
 struct scatter_compiler : compiler<Derived>
 {
@@ -42,6 +118,9 @@ struct scatter_compiler : compiler<Derived>
         const auto inputs =
             to_shapes(std::vector<instruction_ref>{ins->inputs().begin() + 1, ins->inputs().end()});
 
+        if(use_sorted(op, inputs))
+            return compile_sorted(ctx, op, inputs);
+
         hip_compile_options options;
         options.set_launch_params(op.to_value(), compute_global_for(ctx, inputs.at(1).elements()));
         options.inputs         = inputs;
@@ -54,6 +133,97 @@ struct scatter_compiler : compiler<Derived>
         return prepend_copy_data_to_output(compile_hip_code_object(src, options));
     }
 
+    // Atomics are slow when many updates go to the same element, and the order of float
+    // additions changes between runs. When there are more updates than output elements there
+    // are always collisions, so the updates are sorted by output offset and reduced in order.
+    static bool use_sorted(const operation& op, const std::vector<shape>& inputs)
+    {
+        const auto& updates = inputs.at(1);
+        const auto& output  = inputs.back();
+        // The sort keys hold the output offset and the update index in 32 bits each
+        const std::size_t max_index = std::numeric_limits<uint32_t>::max();
+        if(updates.elements() >= max_index or output.element_space() >= max_index)
+            return false;
+        if(enabled(MIGRAPHX_ENABLE_SORTED_SCATTER{}))
+            return true;
+        if(ends_with(op.name(), "_none"))
+            return false;
+        return updates.elements() > output.elements();
+    }
+
+    // The keys are computed and sorted in tiles of up to 1024 keys in LDS, the tiles are merged
+    // in pairs until there is one sorted run, and then each run of equal output offsets is
+    // reduced by one thread
+    compiler_replace
+    compile_sorted(context& ctx, const operation& op, const std::vector<shape>& inputs) const
+    {
+        const auto& indices = inputs.at(0);
+        const auto& updates = inputs.at(1);
+        const auto& output  = inputs.back();
+        std::size_t npad    = 1;
+        while(npad < updates.elements())
+            npad *= 2;
+        auto tile = std::min<std::size_t>(npad, 1024);
+        shape keys{shape::uint64_type, {npad}};
+
+        std::vector<operation> code_objects;
+        hip_compile_options keys_options;
+        keys_options.set_launch_params(value{}, npad, tile);
+        keys_options.inputs         = {indices, updates, output, keys};
+        keys_options.output         = keys;
+        keys_options.kernel_name    = "scatter_sorted_keys_kernel";
+        keys_options.virtual_inputs = keys_options.inputs;
+        code_objects.push_back(compile_hip_code_object(
+            interpolate_string(scatter_sorted_keys_kernel,
+                               {{"header", derived().get_kernel_header()},
+                                {"offset", derived().get_offset_function(op)},
+                                {"tile", std::to_string(tile)}}),
+            keys_options));
+
+        for(std::size_t width = tile; width < npad; width *= 2)
+        {
+            hip_compile_options options;
+            options.set_launch_params(value{}, compute_global_for(ctx, npad));
+            options.inputs         = {keys, keys};
+            options.output         = keys;
+            options.kernel_name    = "scatter_sorted_merge_kernel";
+            options.virtual_inputs = options.inputs;
+            code_objects.push_back(compile_hip_code_object(
+                interpolate_string(scatter_sorted_merge_kernel,
+                                   {{"width", std::to_string(width)}}),
+                options));
+        }
+
+        hip_compile_options reduce_options;
+        reduce_options.set_launch_params(value{}, compute_global_for(ctx, updates.elements()));
+        reduce_options.inputs         = {keys, updates, output};
+        reduce_options.output         = output;
+        reduce_options.kernel_name    = "scatter_sorted_reduce_kernel";
+        reduce_options.virtual_inputs = reduce_options.inputs;
+        code_objects.push_back(compile_hip_code_object(
+            interpolate_string(scatter_sorted_reduce_kernel,
+                               {{"reduction", "assign_" + derived().get_reduction(op)}}),
+            reduce_options));
+
+        auto replace = [=](module& m, instruction_ref ins, const std::vector<operation>& cos) {
+            auto args = ins->inputs();
+            auto out = m.insert_instruction(ins, make_op("hip::copy"), args.front(), args.back());
+            auto allocate_keys = [&] {
+                return m.insert_instruction(
+                    ins, make_op("hip::allocate", {{"shape", to_value(keys)}}));
+            };
+            auto sorted =
+                m.insert_instruction(ins, cos.front(), {args[1], args[2], out, allocate_keys()});
+            std::for_each(cos.begin() + 1, cos.end() - 1, [&](const operation& co) {
+                sorted = m.insert_instruction(ins, co, {sorted, allocate_keys()});
+            });
+            m.replace_instruction(ins, cos.back(), {sorted, args[2], out});
+        };
+        compiler_replace result{code_objects, replace};
+        result.independent = true;
+        return result;
+    }
+
     // ONNX spec states the following for ScatterElements and ScatterND:
     // "The output of the operation is produced by creating a copy of the input data, ..."
     // The sole responsibility of the MIGraphX Scatter operator implementations being to perform the
@@ -59,13 +59,21 @@ struct scatternd_compiler : scatter_compiler<scatternd_compiler>
             "scatternd_none", "scatternd_add", "scatternd_mul", "scatternd_min", "scatternd_max"};
     }
 
+    std::string get_reduction(const operation& op) const
+    {
+        return op.name().substr(std::char_traits<char>::length("scatternd_"));
+    }
+
     std::string make_interpolated_string(const operation& op) const
     {
-        const auto reduction = op.name().substr(std::char_traits<char>::length("scatternd_"));
-        return interpolate_string(scatternd_kernel, {{"reduction", "assign_" + reduction}});
+        return interpolate_string(scatternd_kernel, {{"reduction", "assign_" + get_reduction(op)}});
     }
 
     std::string get_kernel_name(const operation&) const { return "scatternd_kernel"; }
+
+    std::string get_kernel_header() const { return "scatternd.hpp"; }
+
+    std::string get_offset_function(const operation&) const { return "scatternd_offset"; }
 };
 
 } // namespace gpu
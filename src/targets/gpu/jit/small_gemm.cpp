@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+#include <migraphx/module.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+using namespace migraphx::gpu::gen; // NOLINT
+
+// NOLINTNEXTLINE
+static const char* const small_gemm_kernel = R"__migraphx__(
+#include <migraphx/kernels/small_gemm.hpp>
+#include <migraphx/kernels/functional.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/integral_constant.hpp>
+#include <migraphx/kernels/generic_constant.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+${preamble}
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void ${kernel}(${params})
+{
+    transform_args(make_tensors(), pack_first<${ninputs}>(), rotate_last())(${args})([](auto output, auto as, auto b, auto... xs) {
+        small_gemm<${tile_m}>(${pre}, ${post}, output, as, b, xs...);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+// Largest number of rows of the output computed by one workgroup
+constexpr std::size_t max_tile_m = 8;
+
+struct small_gemm_compiler : compiler<small_gemm_compiler>
+{
+    std::vector<std::string> names() const { return {"gpu::small_gemm"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& out_s = inputs.back();
+        auto rank         = out_s.ndim();
+        auto m            = out_s.lens()[rank - 2];
+        auto n            = out_s.lens()[rank - 1];
+        auto tile_m       = std::min(m, max_tile_m);
+        auto ninputs      = std::max<std::size_t>(v.get("prologue", std::size_t{0}), 1);
+        auto batch_rows   = (out_s.elements() / (m * n)) * ((m + tile_m - 1) / tile_m);
+
+        hip_compile_options options;
+        options.set_launch_params(
+            v,
+            [=](std::size_t local) { return batch_rows * ((n + local - 1) / local) * local; },
+            compute_block_size(ctx, n, 256));
+        options.inputs      = inputs;
+        options.output      = out_s;
+        options.kernel_name = v.get("kernel", "small_gemm_kernel");
+
+        auto src = interpolate_string(small_gemm_kernel,
+                                      {{"kernel", options.kernel_name},
+                                       {"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"pre", v.get("pre", std::string{"op::id{}"})},
+                                       {"post", v.get("post", std::string{"op::id{}"})},
+                                       {"preamble", v.get("preamble", std::string{})},
+                                       {"ninputs", std::to_string(ninputs)},
+                                       {"tile_m", std::to_string(tile_m)}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        auto v           = op.to_value();
+        const auto& mods = ins->module_inputs();
+        std::string preamble;
+        std::string name = "small_gemm";
+        if(v.at("prologue").to<std::size_t>() > 0)
+        {
+            preamble += generate_pointwise(*mods.front(), "small_gemm_pre");
+            v["pre"] = "MIGRAPHX_LIFT(small_gemm_pre)";
+            name     = generate_name_from_ops(*mods.front()) + "_" + name;
+        }
+        if(v.at("epilogue").to<bool>())
+        {
+            preamble += generate_pointwise(*mods.back(), "small_gemm_post");
+            v["post"] = "MIGRAPHX_LIFT(small_gemm_post)";
+            name += "_" + generate_name_from_ops(*mods.back());
+        }
+        v["preamble"] = preamble;
+        v["kernel"]   = name + "_kernel";
+        return compile_op(ctx, to_shapes(ins->inputs()), v);
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -33,6 +33,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_USE_FAST_SOFTMAX)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_USE_ONLINE_SOFTMAX)
 
 using namespace migraphx::gpu::gen; // NOLINT
 
@@ -44,11 +45,13 @@ static const char* const softmax_kernel = R"__migraphx__(
 
 namespace migraphx {
 
+${preamble}
+
 extern "C" {
-MIGRAPHX_GLOBAL void softmax_kernel(void* input_p, void* output_p) 
+MIGRAPHX_GLOBAL void ${kernel}(${params}) 
 {
-    transform_args(make_tensors(), ${transformers})(input_p, output_p)([](auto input, auto output) {
-        softmax<${axis}>(input, output);
+    transform_args(make_tensors(), rotate_last(), ${transformers})(${args})([](auto... xs) {
+        softmax<${axis}>(${post}, xs...);
     });
 }
     
@@ -81,21 +84,38 @@ struct softmax_compiler : compiler<softmax_compiler>
             v, compute_global_for(ctx, nelements * block_size, 256), block_size);
         options.output      = inputs.back();
         options.inputs      = inputs;
-        options.kernel_name = "softmax_kernel";
+        options.kernel_name = v.get("kernel", "softmax_kernel");
+        options.emplace_param("-Wno-float-equal");
 
         if(enabled(MIGRAPHX_USE_FAST_SOFTMAX{}))
             options.emplace_param("-DMIGRAPHX_USE_FAST_SOFTMAX");
+        if(enabled(MIGRAPHX_USE_ONLINE_SOFTMAX{}))
+            options.emplace_param("-DMIGRAPHX_USE_ONLINE_SOFTMAX");
 
-        auto src = interpolate_string(
-            softmax_kernel,
-            {{"transformers", make_transformer_args(vec)}, {"axis", to_string(axis)}});
+        auto src = interpolate_string(softmax_kernel,
+                                      {{"kernel", options.kernel_name},
+                                       {"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"transformers", make_transformer_args(vec)},
+                                       {"post", v.get("post", std::string{"op::id{}"})},
+                                       {"preamble", v.get("preamble", std::string{})},
+                                       {"axis", to_string(axis)}});
 
         return compile_hip_code_object(src, options);
     }
 
     compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
     {
-        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+        auto v = op.to_value();
+        // A pointwise module fused after the softmax, such as a quantizelinear or a convert
+        if(not ins->module_inputs().empty())
+        {
+            auto* pm      = ins->module_inputs().front();
+            v["preamble"] = generate_pointwise(*pm, "post_softmax");
+            v["post"]     = "MIGRAPHX_LIFT(post_softmax)";
+            v["kernel"]   = "softmax_" + generate_name_from_ops(*pm) + "_kernel";
+        }
+        return compile_op(ctx, to_shapes(ins->inputs()), v);
     }
 };
 
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/compile_gen.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+using namespace migraphx::gpu::gen; // NOLINT
+
+static const char* const topk_kernel = R"__migraphx__(
+#include <migraphx/kernels/topk.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+MIGRAPHX_GLOBAL void topk_kernel(void* input_p, void* values_p, void* indices_p)
+{
+    make_tensors()(input_p, values_p, indices_p)([](auto input, auto values, auto indices) {
+        topk<${axis}, ${k}, ${largest}>(input, values, indices);
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct topk_compiler : compiler<topk_compiler>
+{
+    std::vector<std::string> names() const { return {"topk"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        auto axis       = v.at("axis").to<std::size_t>();
+        auto finputs    = flatten(inputs);
+        auto n          = inputs.front().lens()[axis];
+        auto nrows      = inputs.front().elements() / n;
+        auto block_size = compute_block_size(ctx, n, 1024);
+        hip_compile_options options;
+        options.set_launch_params(
+            v, compute_global_for(ctx, nrows * block_size, 256), block_size);
+        options.inputs      = finputs;
+        options.output      = inputs.back();
+        options.kernel_name = "topk_kernel";
+
+        auto src = interpolate_string(topk_kernel,
+                                      {{"axis", std::to_string(axis)},
+                                       {"k", std::to_string(v.at("k").to<std::size_t>())},
+                                       {"largest", v.at("largest").to<bool>() ? "true" : "false"}});
+
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compiler.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/compile_hip_code_object.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+// NOLINTNEXTLINE
+static const char* const varlen_attention_kernel = R"__migraphx__(
+#include <migraphx/kernels/varlen_attention.hpp>
+#include <args.hpp>
+
+namespace migraphx {
+
+extern "C" {
+
+MIGRAPHX_GLOBAL void varlen_attention_kernel(${params})
+{
+    make_tensors()(${args})([](auto... xs) {
+        varlen_attention(xs..., ${scale}, ${causal});
+    });
+}
+
+}
+
+} // namespace migraphx
+
+)__migraphx__";
+
+struct varlen_attention_compiler : compiler<varlen_attention_compiler>
+{
+    std::vector<std::string> names() const { return {"varlen_attention"}; }
+
+    operation compile_op(context& ctx, const std::vector<shape>& inputs, const value& v) const
+    {
+        const auto& qlens = inputs.front().lens();
+        auto tokens       = qlens[0];
+        auto head_dim     = qlens[2];
+        auto ngroups      = tokens * qlens[1];
+        auto block_size   = compute_block_size(ctx, std::max(tokens, head_dim), 1024);
+        if(block_size < head_dim)
+            MIGRAPHX_THROW("VARLEN_ATTENTION: head_dim " + std::to_string(head_dim) +
+                           " is larger than the maximum workgroup size");
+        auto scale = v.get("scale", 0.0f);
+        if(scale == 0.0f)
+            scale = 1.0f / std::sqrt(static_cast<float>(head_dim));
+
+        hip_compile_options options;
+        options.set_launch_params(
+            v, [=](std::size_t local) { return ngroups * local; }, block_size);
+        options.inputs      = inputs;
+        options.output      = inputs.back();
+        options.kernel_name = "varlen_attention_kernel";
+
+        auto src = interpolate_string(varlen_attention_kernel,
+                                      {{"params", enum_params(inputs.size(), "void * private_p")},
+                                       {"args", enum_params(inputs.size(), "private_p")},
+                                       {"scale", to_string(scale)},
+                                       {"causal", v.get("causal", false) ? "true" : "false"}});
+        return compile_hip_code_object(src, options);
+    }
+
+    compiler_replace compile(context& ctx, instruction_ref ins, const operation& op) const
+    {
+        return compile_op(ctx, to_shapes(ins->inputs()), op.to_value());
+    }
+};
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
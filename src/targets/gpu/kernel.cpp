@@ -24,8 +24,12 @@
 #include <migraphx/gpu/kernel.hpp>
 #include <migraphx/manage_ptr.hpp>
 #include <migraphx/errors.hpp>
+#include <migraphx/digest.hpp>
 #include <migraphx/gpu/pack_args.hpp>
+#include <algorithm>
 #include <cassert>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <hip/hip_ext.h>
@@ -57,8 +61,8 @@ using hip_module_ptr = MIGRAPHX_MANAGE_PTR(hipModule_t, hipModuleUnload);
 
 struct kernel_impl
 {
-    hip_module_ptr module = nullptr;
-    hipFunction_t fun     = nullptr;
+    std::shared_ptr<hip_module_ptr> module = nullptr;
+    hipFunction_t fun                      = nullptr;
 };
 
 hip_module_ptr load_module(const char* image)
@@ -71,12 +75,74 @@ hip_module_ptr load_module(const char* image)
     return m;
 }
 
-kernel::kernel(const char* image, const std::string& name) : impl(std::make_shared<kernel_impl>())
+static std::mutex& module_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+static std::unordered_map<std::string, std::weak_ptr<hip_module_ptr>>& loaded_modules()
 {
-    impl->module = load_module(image);
-    auto status  = hipModuleGetFunction(&impl->fun, impl->module.get(), name.c_str());
+    static std::unordered_map<std::string, std::weak_ptr<hip_module_ptr>> modules;
+    return modules;
+}
+
+// Code objects with the same image are loaded once for each device, and the kernels look up their
+// function in the shared module. The module is unloaded, and its entry removed, when the last
+// kernel using it is destroyed.
+static std::shared_ptr<hip_module_ptr> get_module(const char* image, std::size_t size)
+{
+    int device  = 0;
+    auto status = hipGetDevice(&device);
+    if(status != hipSuccess)
+        MIGRAPHX_THROW("Failed to get device: " + hip_error(status));
+    digest d;
+    d.update(std::string_view{image, size});
+    auto key = std::to_string(device) + ":" + d.str();
+
+    std::lock_guard<std::mutex> lock(module_mutex());
+    auto& modules = loaded_modules();
+    auto it       = modules.find(key);
+    if(it != modules.end())
+    {
+        if(auto module = it->second.lock())
+            return module;
+    }
+    auto module = std::shared_ptr<hip_module_ptr>(
+        new hip_module_ptr(load_module(image)), [key](hip_module_ptr* p) {
+            {
+                std::lock_guard<std::mutex> guard(module_mutex());
+                // The module may have been loaded again after this one expired
+                auto entry = loaded_modules().find(key);
+                if(entry != loaded_modules().end() and entry->second.expired())
+                    loaded_modules().erase(entry);
+            }
+            delete p; // NOLINT
+        });
+    modules[key] = module;
+    return module;
+}
+
+static hipFunction_t get_function(const hip_module_ptr& module, const std::string& name)
+{
+    hipFunction_t fun = nullptr;
+    auto status       = hipModuleGetFunction(&fun, module.get(), name.c_str());
     if(hipSuccess != status)
         MIGRAPHX_THROW("Failed to get function: " + name + ": " + hip_error(status));
+    return fun;
+}
+
+kernel::kernel(const char* image, const std::string& name) : impl(std::make_shared<kernel_impl>())
+{
+    impl->module = std::make_shared<hip_module_ptr>(load_module(image));
+    impl->fun    = get_function(*impl->module, name);
+}
+
+kernel::kernel(const char* image, std::size_t size, const std::string& name)
+    : impl(std::make_shared<kernel_impl>())
+{
+    impl->module = get_module(image, size);
+    impl->fun    = get_function(*impl->module, name);
 }
 
 void launch_kernel(hipFunction_t fun,
@@ -129,12 +195,13 @@ void launch_kernel(hipFunction_t fun,
 void kernel::launch(hipStream_t stream,
                     std::size_t global,
                     std::size_t local,
-                    std::vector<void*> args,
+                    const std::vector<void*>& args,
                     hipEvent_t start,
                     hipEvent_t stop) const
 {
     assert(impl != nullptr);
-    void* kernargs   = args.data();
+    // The kernel arguments are copied when the kernel is launched, so they are never written
+    void* kernargs   = const_cast<void**>(args.data()); // NOLINT
     std::size_t size = args.size() * sizeof(void*);
 
     launch_kernel(impl->fun, stream, global, local, kernargs, size, start, stop);
@@ -148,12 +215,53 @@ void kernel::launch(hipStream_t stream,
                     hipEvent_t stop) const
 {
     assert(impl != nullptr);
-    std::vector<char> kernargs = pack_args(args);
-    std::size_t size           = kernargs.size();
+    // The arguments are copied at launch, so the buffer is reused by the next launch on this thread
+    static thread_local std::vector<char> kernargs; // NOLINT
+    pack_args(args, kernargs);
+    std::size_t size = kernargs.size();
 
     launch_kernel(impl->fun, stream, global, local, kernargs.data(), size, start, stop);
 }
 
+static int get_function_attribute(hipFunction_t fun, hipFunction_attribute attr)
+{
+    int result  = 0;
+    auto status = hipFuncGetAttribute(&result, attr, fun);
+    if(status != hipSuccess)
+        MIGRAPHX_THROW("Failed to get function attribute: " + hip_error(status));
+    return result;
+}
+
+std::shared_ptr<const void> kernel::module() const
+{
+    assert(impl != nullptr);
+    return impl->module;
+}
+
+kernel_resources kernel::resources(std::size_t local) const
+{
+    assert(impl != nullptr);
+    kernel_resources result;
+    result.registers = get_function_attribute(impl->fun, HIP_FUNC_ATTRIBUTE_NUM_REGS);
+    result.lds_bytes = get_function_attribute(impl->fun, HIP_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES);
+
+    int blocks  = 0;
+    auto status = hipModuleOccupancyMaxActiveBlocksPerMultiprocessor(&blocks, impl->fun, local, 0);
+    if(status != hipSuccess)
+        MIGRAPHX_THROW("Failed to get occupancy: " + hip_error(status));
+    int device      = 0;
+    int max_threads = 0;
+    status          = hipGetDevice(&device);
+    if(status == hipSuccess)
+        status = hipDeviceGetAttribute(
+            &max_threads, hipDeviceAttributeMaxThreadsPerMultiProcessor, device);
+    if(status != hipSuccess)
+        MIGRAPHX_THROW("Failed to get the threads per compute unit: " + hip_error(status));
+    if(max_threads > 0)
+        result.occupancy = std::min(100.0, 100.0 * blocks * local / max_threads);
+    return result;
+}
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
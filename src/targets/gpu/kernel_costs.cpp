@@ -0,0 +1,98 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/kernel_costs.hpp>
+#include <migraphx/gpu/code_object_op.hpp>
+#include <migraphx/operation.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/stringutils.hpp>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_SCHEDULE_PROFILE)
+
+std::string kernel_costs::key(const operation& op, const std::vector<shape>& inputs)
+{
+    auto args = "(" + to_string_range(inputs) + ")";
+    if(op.name() != "gpu::code_object")
+        return to_string(op) + args;
+    const auto& co = any_cast<code_object_op>(op);
+    return co.symbol_name + "[global=" + std::to_string(co.global) +
+           ",local=" + std::to_string(co.local) + "]" + args + " -> " + to_string(co.output);
+}
+
+void kernel_costs::insert(const operation& op, const std::vector<shape>& inputs, double ms)
+{
+    costs[key(op, inputs)] = ms;
+}
+
+optional<double> kernel_costs::get(const operation& op, const std::vector<shape>& inputs) const
+{
+    auto it = costs.find(key(op, inputs));
+    if(it == costs.end())
+        return nullopt;
+    return it->second;
+}
+
+double kernel_costs::average() const
+{
+    if(costs.empty())
+        return 0;
+    auto total = std::accumulate(
+        costs.begin(), costs.end(), 0.0, [](double x, const auto& p) { return x + p.second; });
+    return total / costs.size();
+}
+
+bool kernel_costs::empty() const { return costs.empty(); }
+
+void kernel_costs::load() { load(string_value_of(MIGRAPHX_SCHEDULE_PROFILE{})); }
+
+void kernel_costs::load(const fs::path& path)
+{
+    if(path.empty() or not fs::exists(path))
+        return;
+    from_value(from_json_string(read_string(path)), costs);
+}
+
+void kernel_costs::save() const
+{
+    auto path = string_value_of(MIGRAPHX_SCHEDULE_PROFILE{});
+    if(path.empty())
+        return;
+    save(path);
+}
+
+void kernel_costs::save(const fs::path& path) const
+{
+    write_string(path, to_pretty_json_string(to_value(costs)));
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
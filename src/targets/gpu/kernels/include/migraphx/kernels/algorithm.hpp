@@ -274,6 +274,29 @@ constexpr Iterator rotate(Iterator first, Iterator middle, Iterator last)
     return write;
 }
 
+template <class Iterator, class T, class Compare>
+constexpr Iterator lower_bound(Iterator first, Iterator last, const T& value, Compare comp)
+{
+    auto count = last - first;
+
+    while(count > 0)
+    {
+        auto it   = first;
+        auto step = count / 2;
+        it += step;
+
+        if(comp(*it, value))
+        {
+            first = ++it;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+
+    return first;
+}
+
 template <class Iterator, class T, class Compare>
 constexpr Iterator upper_bound(Iterator first, Iterator last, const T& value, Compare comp)
 {
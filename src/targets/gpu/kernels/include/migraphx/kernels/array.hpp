@@ -73,7 +73,8 @@ namespace array_detail {
 template <class T>
 constexpr auto is_vectorizable()
 {
-    return not is_same<T, bool>{} and (is_fundamental<T>{} or is_same<T, half>{});
+    return not is_same<T, bool>{} and
+           (is_fundamental<T>{} or is_same<T, half>{} or is_same<T, bf16>{});
 }
 
 template <class T>
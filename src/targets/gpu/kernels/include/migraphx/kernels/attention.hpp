@@ -0,0 +1,149 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_ATTENTION_HPP
+#define MIGRAPHX_GUARD_KERNELS_ATTENTION_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/reduce.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+struct attention_score
+{
+    template <class Index>
+    constexpr float operator()(Index, float x) const
+    {
+        return x;
+    }
+};
+
+template <class Bias>
+struct attention_bias_score
+{
+    Bias bias;
+    template <class Index>
+    constexpr float operator()(Index i, float x) const
+    {
+        return x + migraphx::convert<float>(bias[i]);
+    }
+};
+
+template <class Cond, class Value>
+struct attention_where_score
+{
+    Cond cond;
+    Value value;
+    template <class Index>
+    constexpr float operator()(Index i, float x) const
+    {
+        return cond[i] ? x : migraphx::convert<float>(value[i]);
+    }
+};
+
+template <class Bias>
+constexpr attention_bias_score<Bias> make_attention_score(Bias bias)
+{
+    return {bias};
+}
+
+template <class Cond, class Value>
+constexpr attention_where_score<Cond, Value> make_attention_score(Cond cond, Value value)
+{
+    return {cond, value};
+}
+
+constexpr attention_score make_attention_score() { return {}; }
+
+// Computes output = softmax(score(scale * a * b)) * b1 along the last axis of a * b, where score
+// applies the optional bias or mask. One workgroup computes one row of the output, walking the
+// columns of b in tiles of nlocal with an online softmax, so the [m, n] scores are never stored.
+template <class A, class B, class B1, class Output, class Score>
+__device__ void attention(A a, B b, B1 b1, Output output, float scale, Score score)
+{
+    auto idx            = make_index();
+    constexpr auto lens = get_shape_c<Output>{}.lens;
+    constexpr auto rank = lens.size();
+    constexpr auto k    = get_shape_c<A>{}.lens[rank - 1];
+    constexpr auto n    = get_shape_c<B>{}.lens[rank - 1];
+    constexpr auto o    = lens[rank - 1];
+    MIGRAPHX_ASSERT(idx.nlocal() >= o);
+
+    const auto row = output.get_shape().multi(idx.group * o);
+    // Index into a tensor of shape [..., i, j] in the same batch as the output row
+    auto at = [&](index_int i, index_int j) {
+        auto result      = row;
+        result[rank - 2] = i;
+        result[rank - 1] = j;
+        return result;
+    };
+    auto m_row = row[rank - 2];
+
+    __shared__ float q[k];
+    __shared__ float p[idx.max_nlocal()];
+    idx.local_stride(k,
+                     [&](auto i) { q[i] = migraphx::convert<float>(a[at(m_row, i)]) * scale; });
+    __syncthreads();
+
+    float m   = lowest{};
+    float l   = 0;
+    float acc = 0;
+    for(index_int start = 0; start < n; start += idx.nlocal())
+    {
+        auto j  = start + idx.local;
+        float x = lowest{};
+        if(j < n)
+        {
+            float dot = 0;
+            for(index_int i = 0; i < k; i++)
+                dot += q[i] * migraphx::convert<float>(b[at(i, j)]);
+            x = score(at(m_row, j), dot);
+        }
+        auto tile_max = block_reduce(
+            idx, op::max{}, float(lowest{}), idx.nlocal(), [&](auto) { return x; });
+        auto new_m   = max(m, tile_max);
+        float pj     = (x <= float(lowest{})) ? 0.0f : migraphx::exp(x - new_m);
+        p[idx.local] = pj;
+        __syncthreads();
+        auto tile_sum = block_reduce(idx, op::sum{}, 0.0f, idx.nlocal(), [&](auto) { return pj; });
+        float correction = (m <= float(lowest{})) ? 0.0f : migraphx::exp(m - new_m);
+        l                = l * correction + tile_sum;
+        if(idx.local < o)
+        {
+            acc *= correction;
+            for(index_int jj = 0; jj < idx.nlocal() and start + jj < n; jj++)
+                acc += p[jj] * migraphx::convert<float>(b1[at(start + jj, idx.local)]);
+        }
+        m = new_m;
+        __syncthreads();
+    }
+    using type = typename Output::type;
+    if(idx.local < o)
+        output[at(m_row, idx.local)] = migraphx::convert<type>(l > 0 ? acc / l : 0.0f);
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_ATTENTION_HPP
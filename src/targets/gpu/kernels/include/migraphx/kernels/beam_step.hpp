@@ -0,0 +1,63 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_BEAM_STEP_HPP
+#define MIGRAPHX_GUARD_KERNELS_BEAM_STEP_HPP
+
+#include <migraphx/kernels/topk.hpp>
+
+namespace migraphx {
+
+// One workgroup per batch selects the best beams * vocab candidates with the topk radix
+// select, so the candidate scores are computed as they are read and never written out
+template <class LogProbs, class Scores, class NewScores, class Tokens, class Parents>
+__device__ void
+beam_step(LogProbs logprobs, Scores scores, NewScores new_scores, Tokens tokens, Parents parents)
+{
+    using type                     = typename LogProbs::type;
+    constexpr auto lens            = get_shape_c<LogProbs>{}.lens;
+    constexpr index_int batch      = lens[0];
+    constexpr index_int beams      = lens[1];
+    constexpr index_int vocab      = lens[2];
+    constexpr index_int value_bits = sizeof(type) * 8;
+
+    auto idx = make_index();
+    idx.group_stride(batch, [&](auto b) {
+        auto score = [&](index_int i) -> type {
+            return scores[b * beams + i / vocab] + logprobs[b * beams * vocab + i];
+        };
+        topk_select<value_bits, beams * vocab, beams>(
+            idx,
+            [&](index_int i) -> topk_key {
+                return {topk_value_key<true>(score(i)), uint32_t(i)};
+            },
+            [&](index_int j, index_int i) {
+                new_scores[b * beams + j] = score(i);
+                tokens[b * beams + j]     = i % vocab;
+                parents[b * beams + j]    = i / vocab;
+            });
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_BEAM_STEP_HPP
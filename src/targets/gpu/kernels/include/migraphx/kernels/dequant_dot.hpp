@@ -0,0 +1,160 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_DEQUANT_DOT_HPP
+#define MIGRAPHX_GUARD_KERNELS_DEQUANT_DOT_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+#include <migraphx/kernels/type_traits.hpp>
+
+namespace migraphx {
+
+struct dequant_no_zero_point
+{
+    template <class Index>
+    constexpr float operator[](Index) const
+    {
+        return 0;
+    }
+};
+
+// Reads the weight at index i of the unpacked tensor. Packed int4 weights store two values in
+// each byte along Axis, with the even index in the least significant nibble.
+template <bool Int4, index_int Axis, class W, class Index>
+constexpr float load_weight(W w, Index i)
+{
+    if constexpr(Int4)
+    {
+        using type = typename W::type;
+        auto pi    = i;
+        pi[Axis] /= 2;
+        bool high = i[Axis] % 2 != 0;
+        if constexpr(is_same<type, int8_t>{})
+        {
+            int8_t x = w[pi];
+            if(high)
+                return x >> 4; // NOLINT(hicpp-signed-bitwise)
+            return static_cast<int8_t>(static_cast<uint8_t>(x) << 4) >> 4; // NOLINT
+        }
+        else
+        {
+            uint8_t x = w[pi];
+            return high ? (x >> 4) : (x & 0xf); // NOLINT(hicpp-signed-bitwise)
+        }
+    }
+    else
+    {
+        return migraphx::convert<float>(w[i]);
+    }
+}
+
+template <bool Int4, index_int Axis, class W, class Scale, class ZeroPoint>
+struct dequant_weight
+{
+    W w;
+    Scale scale;
+    ZeroPoint zero_point;
+
+    template <class Index>
+    constexpr float operator()(Index i) const
+    {
+        auto x = load_weight<Int4, Axis>(w, i);
+        return (x - migraphx::convert<float>(zero_point[i])) * migraphx::convert<float>(scale[i]);
+    }
+};
+
+template <bool Int4, index_int Axis, class W, class Scale, class ZeroPoint>
+constexpr dequant_weight<Int4, Axis, W, Scale, ZeroPoint>
+make_dequant_weight(W w, Scale scale, ZeroPoint zero_point)
+{
+    return {w, scale, zero_point};
+}
+
+template <bool Int4, index_int Axis, class W, class Scale>
+constexpr dequant_weight<Int4, Axis, W, Scale, dequant_no_zero_point>
+make_dequant_weight(W w, Scale scale)
+{
+    return {w, scale, {}};
+}
+
+// Computes output = a * dequantize(b), where b reads the quantized weights and dequantizes them in
+// registers so the full precision weights are never stored. Each workgroup computes TileM rows
+// and nlocal columns of the output, staging the rows of a through LDS in chunks of nlocal.
+template <index_int TileM, class A, class B, class Output>
+__device__ void dequant_dot(A a, B b, Output output)
+{
+    auto idx             = make_index();
+    constexpr auto lens  = get_shape_c<Output>{}.lens;
+    constexpr auto rank  = lens.size();
+    constexpr auto m     = lens[rank - 2];
+    constexpr auto n     = lens[rank - 1];
+    constexpr auto k     = get_shape_c<A>{}.lens[rank - 1];
+    constexpr auto nrows = (m + TileM - 1) / TileM;
+    constexpr auto ncols = (n + idx.max_nlocal() - 1) / idx.max_nlocal();
+    constexpr auto batch = get_shape_c<Output>{}.elements() / (m * n);
+
+    __shared__ float tile[TileM][idx.max_nlocal()];
+    idx.group_stride(batch * nrows * ncols, [&](auto g) {
+        const auto row = output.get_shape().multi((g / (nrows * ncols)) * m * n);
+        auto at        = [&](index_int i, index_int j) {
+            auto result      = row;
+            result[rank - 2] = i;
+            result[rank - 1] = j;
+            return result;
+        };
+        const index_int m0 = ((g / ncols) % nrows) * TileM;
+        const index_int j  = (g % ncols) * idx.nlocal() + idx.local;
+
+        float acc[TileM] = {0};
+        for(index_int k0 = 0; k0 < k; k0 += idx.nlocal())
+        {
+            idx.local_stride(TileM * idx.nlocal(), [&](auto i) {
+                auto r  = i / idx.nlocal();
+                auto kk = k0 + i % idx.nlocal();
+                tile[r][i % idx.nlocal()] =
+                    (m0 + r < m and kk < k) ? migraphx::convert<float>(a[at(m0 + r, kk)]) : 0.0f;
+            });
+            __syncthreads();
+            if(j < n)
+            {
+                for(index_int kk = 0; kk < idx.nlocal() and k0 + kk < k; kk++)
+                {
+                    auto x = b(at(k0 + kk, j));
+                    for(index_int r = 0; r < TileM; r++)
+                        acc[r] += tile[r][kk] * x;
+                }
+            }
+            __syncthreads();
+        }
+        if(j >= n)
+            return;
+        using type = typename Output::type;
+        for(index_int r = 0; r < TileM and m0 + r < m; r++)
+            output[at(m0 + r, j)] = migraphx::convert<type>(acc[r]);
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_DEQUANT_DOT_HPP
@@ -28,6 +28,8 @@
 #include <migraphx/kernels/shape.hpp>
 #include <migraphx/kernels/algorithm.hpp>
 #include <migraphx/kernels/tensor_view.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/vec.hpp>
 
 namespace migraphx {
 
@@ -40,8 +42,9 @@ constexpr auto gather_shape(Input input, Indices indices)
     return make_shape(lengths, input.strides);
 }
 
-template <int Axis, class Input, class Indices, class Output>
-__device__ void gather(Input input, Indices indices, Output output)
+// Applies f to each gathered element along with the elements of xs at the same index
+template <int Axis, class F, class Output, class Input, class Indices, class... Inputs>
+__device__ void gather(F f, Output output, Input input, Indices indices, Inputs... xs)
 {
     auto ind           = make_index();
     auto axis_dim_size = input.get_shape().lens[Axis];
@@ -56,9 +59,15 @@ __device__ void gather(Input input, Indices indices, Output output)
 
         idx[Axis] = new_in_index;
 
-        output[i] = input[idx];
+        output[i] = implicit_conversion(f(input[idx], xs[i]...));
     });
 }
 
+template <int Axis, class Input, class Indices, class Output>
+__device__ void gather(Input input, Indices indices, Output output)
+{
+    gather<Axis>(op::id{}, output, input, indices);
+}
+
 } // namespace migraphx
 #endif
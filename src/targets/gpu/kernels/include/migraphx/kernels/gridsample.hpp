@@ -0,0 +1,179 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_GRIDSAMPLE_HPP
+#define MIGRAPHX_GUARD_KERNELS_GRIDSAMPLE_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/types.hpp>
+#include <migraphx/kernels/vec.hpp>
+
+namespace migraphx {
+
+enum class gridsample_mode
+{
+    nearest,
+    linear,
+    cubic
+};
+
+enum class gridsample_padding
+{
+    zeros,
+    border,
+    reflection
+};
+
+template <gridsample_mode Mode, gridsample_padding Padding, bool AlignCorners>
+struct gridsample_settings
+{
+    // The number of positions read along each axis
+    static constexpr index_int samples =
+        Mode == gridsample_mode::nearest ? 1 : (Mode == gridsample_mode::linear ? 2 : 4);
+
+    static constexpr float unnormalize(float x, index_int size)
+    {
+        if constexpr(AlignCorners)
+            return (x + 1) * (size - 1) / 2;
+        else
+            return (x + 1) * size / 2 - 0.5f;
+    }
+
+    static constexpr float reflect_coordinate(float x, index_int size)
+    {
+        float start  = AlignCorners ? 0.0f : -0.5f;
+        float length = AlignCorners ? size - 1 : size;
+        auto dist    = abs(x - start);
+        auto flips   = floor(floor(dist) / length);
+        auto extra   = dist - flips * length;
+        if(fmod(flips, 2.0f) == 0)
+            return start + extra;
+        return start + length - extra;
+    }
+
+    // Only zeros padding reads outside of the input
+    static constexpr float pad(float x, index_int size)
+    {
+        if constexpr(Padding == gridsample_padding::zeros)
+            return x;
+        if constexpr(Padding == gridsample_padding::reflection)
+            x = reflect_coordinate(x, size);
+        return min(static_cast<float>(size - 1), max(0.0f, x));
+    }
+
+    // The positions read along an axis, and their weights
+    static constexpr void
+    sample(float x, index_int size, array<float, samples>& pos, array<float, samples>& weight)
+    {
+        if constexpr(Mode == gridsample_mode::nearest)
+        {
+            pos[0]    = nearbyint(x);
+            weight[0] = 1;
+        }
+        else if constexpr(Mode == gridsample_mode::linear)
+        {
+            auto x0   = floor(x);
+            pos[0]    = x0;
+            pos[1]    = x0 + 1;
+            weight[1] = x - x0;
+            weight[0] = 1 - weight[1];
+        }
+        else
+        {
+            constexpr float a = -0.75f;
+            auto x0           = floor(x);
+            auto far          = [&](float t) { return ((a * t - 5 * a) * t + 8 * a) * t - 4 * a; };
+            auto near         = [&](float t) { return ((a + 2) * t - (a + 3)) * t * t + 1; };
+            auto ratio        = x - x0;
+            weight[0]         = far(ratio + 1);
+            weight[1]         = near(ratio);
+            weight[2]         = near(1 - ratio);
+            weight[3]         = far(2 - ratio);
+            for(index_int k = 0; k < samples; k++)
+                pos[k] = pad(x0 - 1 + k, size);
+        }
+    }
+};
+
+// Each thread computes the positions read for one position of the grid once, and then samples
+// all of the channels at them
+template <gridsample_mode Mode,
+          gridsample_padding Padding,
+          bool AlignCorners,
+          class Input,
+          class Grid,
+          class Output>
+__device__ void gridsample(const Input& input, const Grid& grid, Output& output)
+{
+    using settings        = gridsample_settings<Mode, Padding, AlignCorners>;
+    constexpr index_int k = settings::samples;
+    auto idx              = make_index();
+    auto in_shape         = input.get_shape();
+    auto out_lens         = output.get_shape().lens;
+    auto channels         = in_shape.lens[1];
+    auto height           = in_shape.lens[2];
+    auto width            = in_shape.lens[3];
+    auto positions        = out_lens[0] * out_lens[2] * out_lens[3];
+    idx.global_stride(positions, [&](auto i) {
+        auto w  = i % out_lens[3];
+        auto h  = (i / out_lens[3]) % out_lens[2];
+        auto n  = i / (out_lens[3] * out_lens[2]);
+        auto gx = static_cast<float>(grid[make_array<index_int>(n, h, w, 0)]);
+        auto gy = static_cast<float>(grid[make_array<index_int>(n, h, w, 1)]);
+        auto x  = settings::pad(settings::unnormalize(gx, width), width);
+        auto y  = settings::pad(settings::unnormalize(gy, height), height);
+        array<float, k> xs;
+        array<float, k> wx;
+        array<float, k> ys;
+        array<float, k> wy;
+        settings::sample(x, width, xs, wx);
+        settings::sample(y, height, ys, wy);
+
+        // Positions outside of the input have no weight
+        array<index_int, k * k> offsets;
+        array<float, k * k> weights;
+        for(index_int a = 0; a < k; a++)
+        {
+            for(index_int b = 0; b < k; b++)
+            {
+                auto j     = a * k + b;
+                bool valid = ys[a] >= 0 and xs[b] >= 0 and ys[a] < height and xs[b] < width;
+                offsets[j] = valid ? in_shape.index(make_array<index_int>(0, 0, ys[a], xs[b])) : 0;
+                weights[j] = valid ? wy[a] * wx[b] : 0.0f;
+            }
+        }
+        for(index_int c = 0; c < channels; c++)
+        {
+            auto base = input.data() + in_shape.index(make_array<index_int>(n, c, 0, 0));
+            float acc = 0;
+            for(index_int j = 0; j < k * k; j++)
+                acc += weights[j] * static_cast<float>(base[offsets[j]]);
+            output[make_array<index_int>(n, c, h, w)] = implicit_conversion(acc);
+        }
+    });
+}
+
+} // namespace migraphx
+#endif
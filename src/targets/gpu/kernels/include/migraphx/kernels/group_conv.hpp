@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_GROUP_CONV_HPP
+#define MIGRAPHX_GUARD_KERNELS_GROUP_CONV_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/pooling.hpp>
+#include <migraphx/kernels/permutation.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+// Direct convolution for depthwise and grouped convolutions where each output only reads a few
+// input channels. Each thread computes Tile consecutive outputs in the memory order of the output
+// so both NCHW and NHWC layouts are written coalesced. The window has the same rank as the output
+// with a length of 1 along the batch and channel axes.
+template <index_int Groups,
+          index_int Tile,
+          class Window,
+          class F,
+          class Output,
+          class Input,
+          class Weights,
+          class... Inputs>
+__device__ void
+group_conv(Window w, F f, Output output, Input input, Weights weights, Inputs... inputs)
+{
+    auto idx                      = make_index();
+    constexpr auto out_s          = get_shape_c<Output>{};
+    constexpr auto perm           = find_permutation(out_s);
+    constexpr auto mem_s          = reorder_shape(out_s, perm);
+    constexpr auto inv            = invert_permutation(perm);
+    constexpr index_int channels  = get_shape_c<Weights>{}.lens[1];
+    constexpr index_int out_group = out_s.lens[1] / Groups;
+    using acc_type                = decltype(pool_accumulate(typename Output::type{}));
+
+    idx.global_stride(out_s.elements() / _c<Tile>, [&](auto i) {
+        repeat(_c<Tile>, [&](auto t) {
+            auto out_idx      = reorder_dims(mem_s.multi(i * Tile + t), inv);
+            index_int k       = out_idx[1];
+            index_int c_start = (k / out_group) * channels;
+            acc_type acc      = 0;
+            auto in_window    = w.apply(out_idx, [](auto j) { return j; });
+            for(index_int c = 0; c < channels; c++)
+            {
+                repeat(w.size(), [&](auto j) {
+                    auto in_idx = in_window(j);
+                    in_idx[1]   = c_start + c;
+                    // Skip the padding
+                    for(index_int d = 2; d < in_idx.size(); d++)
+                    {
+                        if(in_idx[d] < 0 or in_idx[d] >= diff_int(input.get_shape().lens[d]))
+                            return;
+                    }
+                    auto w_idx = w.win.multi(j);
+                    w_idx[0]   = k;
+                    w_idx[1]   = c;
+                    acc += pool_accumulate(input[in_idx]) * pool_accumulate(weights[w_idx]);
+                });
+            }
+            output[out_idx] = f(static_cast<typename Output::type>(acc), inputs[out_idx]...);
+        });
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_GROUP_CONV_HPP
@@ -0,0 +1,50 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_HORIZONTAL_HPP
+#define MIGRAPHX_GUARD_KERNELS_HORIZONTAL_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/pointwise.hpp>
+
+namespace migraphx {
+
+// Run one of the pointwise kernels packed into a single launch. The kernel only runs on the
+// workgroups in [Start, End), which stride over its elements as if they were the whole grid.
+template <index_int Start, index_int End, class F, class Output, class... Inputs>
+__device__ void horizontal_pointwise(index idx, F f, Output out, Inputs... xs)
+{
+    static_assert(Start < End, "Each kernel needs at least one workgroup");
+    if(idx.group < Start or idx.group >= End)
+        return;
+    const index_int start  = (idx.group - Start) * idx.max_nlocal() + idx.local;
+    const index_int stride = (End - Start) * idx.max_nlocal();
+    auto sub_stride        = [&](index_int n, auto g) {
+        for(index_int i = start; i < n; i += stride)
+            g(i);
+    };
+    pointwise_tensor(sub_stride, f, [&](auto g) { return g(out); }, xs...);
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_HORIZONTAL_HPP
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_IMAGE_PREPROCESS_HPP
+#define MIGRAPHX_GUARD_KERNELS_IMAGE_PREPROCESS_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/types.hpp>
+
+namespace migraphx {
+
+// The pixels read along an axis of the image for each position of the output, and the weight of
+// the high pixel
+struct image_axis_samples
+{
+    const index_int* low;
+    const index_int* high;
+    const float* delta;
+};
+
+template <class Input, class Output>
+__device__ void image_preprocess(const Input& input,
+                                 Output& output,
+                                 image_axis_samples ys,
+                                 image_axis_samples xs,
+                                 const float* mean,
+                                 const float* stddev)
+{
+    auto idx          = make_index();
+    auto output_shape = output.get_shape();
+    auto lerp         = [](float low, float high, float d) { return (high - low) * d + low; };
+    idx.global_stride(output_shape.elements(), [&](auto i) {
+        // The output is NCHW, while the input is NHWC
+        auto multi = output_shape.multi(i);
+        auto n     = multi[0];
+        auto c     = multi[1];
+        auto y     = multi[2];
+        auto x     = multi[3];
+        auto at    = [&](index_int yy, index_int xx) -> float {
+            return input[make_array(n, yy, xx, c)];
+        };
+        auto row = [&](index_int yy) {
+            return lerp(at(yy, xs.low[x]), at(yy, xs.high[x]), xs.delta[x]);
+        };
+        auto v    = lerp(row(ys.low[y]), row(ys.high[y]), ys.delta[y]);
+        output[i] = implicit_conversion((v - mean[c]) / stddev[c]);
+    });
+}
+
+} // namespace migraphx
+#endif
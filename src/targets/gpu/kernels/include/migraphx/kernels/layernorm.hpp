@@ -48,15 +48,75 @@ constexpr auto vec_reduce(const array<T, N>& a, Op op)
     return a.apply([&](auto x) { return vec_reduce(x, op); });
 }
 
+struct layernorm_normalizer
+{
+    float eps;
+
+    template <class Reducer, class Input, class T>
+    __device__ auto operator()(Reducer r, Input input, T relements_r) const
+    {
+        auto relements_rsqrt = sqrt(relements_r);
+
+        auto means = r.reduce(op::sum{}, make_array<T>(0, 0), [&](auto x) {
+            auto x_out = x * relements_r;
+            // dividing x by sqrt(relements) before squaring allows computing
+            // higher values before overflow in low precision
+            auto x2_sqrt = x * relements_rsqrt;
+            return make_array(x_out, x2_sqrt * x2_sqrt);
+        })(input);
+
+        auto mean_x    = means[0];
+        auto mean_x2   = means[1];
+        auto variance  = mean_x2 - (mean_x * mean_x);
+        T eps_val      = implicit_conversion(eps);
+        auto rsqrt_val = rsqrt(variance + eps_val);
+        return [=](auto x) { return (x - mean_x) * rsqrt_val; };
+    }
+};
+
+struct rms_norm_normalizer
+{
+    float eps;
+
+    template <class Reducer, class Input, class T>
+    __device__ auto operator()(Reducer r, Input input, T relements_r) const
+    {
+        auto relements_rsqrt = sqrt(relements_r);
+
+        // Only the mean of the squares is needed so a single sum is reduced
+        auto mean_x2 = r.reduce(op::sum{}, T{0}, [&](auto x) {
+            auto x2_sqrt = x * relements_rsqrt;
+            return x2_sqrt * x2_sqrt;
+        })(input);
+
+        T eps_val      = implicit_conversion(eps);
+        auto rsqrt_val = rsqrt(mean_x2 + eps_val);
+        return [=](auto x) { return x * rsqrt_val; };
+    }
+};
+
+// Passed as the residual when the sum of the inputs is not written
+struct no_residual
+{
+};
+
 template <index_int Axis,
+          class Normalizer,
           class F,
           class BinOp,
           class Output,
+          class Residual,
           class Input1,
           class Input2,
           class... Inputs>
-__device__ void generic_binary_layernorm(
-    F compute, BinOp op, float eps, Output output, Input1 input1, Input2 input2, Inputs... inputs)
+__device__ void generic_binary_norm(Normalizer normalizer,
+                                    F compute,
+                                    BinOp op,
+                                    Output output,
+                                    Residual residual,
+                                    Input1 input1,
+                                    Input2 input2,
+                                    Inputs... inputs)
 {
     using block         = reduce::auto_block<reduce::reduce_elements_with_axis<Input1, Axis>()>;
     using reduce_output = reduce::with_axis<Input1, Axis>;
@@ -65,30 +125,24 @@ __device__ void generic_binary_layernorm(
         using value_type     = typename Input1::type;
         using vec_value_type = typename acc_type<vec_type<value_type>>::type;
 
+        // The row is kept in registers by the block reducer, so the inputs are only read once
         auto input = r.inner([&](auto x1, auto x2) {
             return migraphx::convert<vec_value_type>(op(x1, x2));
         })(input1, input2);
 
+        if constexpr(not is_same<Residual, no_residual>{})
+        {
+            r.inner([&](auto& y, auto x) {
+                y = migraphx::convert<vec_type<typename Residual::type>>(x);
+            })(residual, input);
+        }
+
         constexpr auto relements   = r.template elements<Input1>();
         constexpr auto relements_r = vec_value_type{1.0 / relements};
-        auto relements_rsqrt       = sqrt(relements_r);
-
-        auto means = r.reduce(op::sum{}, make_array<vec_value_type>(0, 0), [&](auto x) {
-            auto x_out = x * relements_r;
-            // dividing x by sqrt(relements) before squaring allows computing
-            // higher values before overflow in low precision
-            auto x2_sqrt = x * relements_rsqrt;
-            return make_array(x_out, x2_sqrt * x2_sqrt);
-        })(input);
-
-        auto mean_x            = means[0];
-        auto mean_x2           = means[1];
-        auto variance          = mean_x2 - (mean_x * mean_x);
-        vec_value_type eps_val = implicit_conversion(eps);
-        auto rsqrt_val         = rsqrt(variance + eps_val);
+        auto normalize             = normalizer(r, input, relements_r);
 
         r.inner([&](auto& y, auto x, auto... xs) {
-            y = compute(migraphx::convert<vec_type<value_type>>((x - mean_x) * rsqrt_val), xs...);
+            y = compute(migraphx::convert<vec_type<value_type>>(normalize(x)), xs...);
         })(output, input, inputs...);
     });
 }
@@ -96,16 +150,111 @@ __device__ void generic_binary_layernorm(
 template <index_int Axis, class F, class Output, class Input, class... Inputs>
 __device__ void layernorm(F compute, float eps, Output output, Input input, Inputs... inputs)
 {
-    generic_binary_layernorm<Axis>(
-        compute, [](auto x, auto) { return x; }, eps, output, input, input, inputs...);
+    generic_binary_norm<Axis>(
+        layernorm_normalizer{eps},
+        compute,
+        [](auto x, auto) { return x; },
+        output,
+        no_residual{},
+        input,
+        input,
+        inputs...);
 }
 
 template <index_int Axis, class F, class Output, class Input1, class Input2, class... Inputs>
 __device__ void
 add_layernorm(F compute, float eps, Output output, Input1 input1, Input2 input2, Inputs... inputs)
 {
-    generic_binary_layernorm<Axis>(
-        compute, [](auto x1, auto x2) { return x1 + x2; }, eps, output, input1, input2, inputs...);
+    generic_binary_norm<Axis>(
+        layernorm_normalizer{eps},
+        compute,
+        [](auto x1, auto x2) { return x1 + x2; },
+        output,
+        no_residual{},
+        input1,
+        input2,
+        inputs...);
+}
+
+template <index_int Axis,
+          class F,
+          class Output,
+          class Residual,
+          class Input1,
+          class Input2,
+          class... Inputs>
+__device__ void add_layernorm_residual(F compute,
+                                       float eps,
+                                       Output output,
+                                       Residual residual,
+                                       Input1 input1,
+                                       Input2 input2,
+                                       Inputs... inputs)
+{
+    generic_binary_norm<Axis>(
+        layernorm_normalizer{eps},
+        compute,
+        [](auto x1, auto x2) { return x1 + x2; },
+        output,
+        residual,
+        input1,
+        input2,
+        inputs...);
+}
+
+template <index_int Axis, class F, class Output, class Input, class... Inputs>
+__device__ void rms_norm(F compute, float eps, Output output, Input input, Inputs... inputs)
+{
+    generic_binary_norm<Axis>(
+        rms_norm_normalizer{eps},
+        compute,
+        [](auto x, auto) { return x; },
+        output,
+        no_residual{},
+        input,
+        input,
+        inputs...);
+}
+
+template <index_int Axis, class F, class Output, class Input1, class Input2, class... Inputs>
+__device__ void
+add_rms_norm(F compute, float eps, Output output, Input1 input1, Input2 input2, Inputs... inputs)
+{
+    generic_binary_norm<Axis>(
+        rms_norm_normalizer{eps},
+        compute,
+        [](auto x1, auto x2) { return x1 + x2; },
+        output,
+        no_residual{},
+        input1,
+        input2,
+        inputs...);
+}
+
+template <index_int Axis,
+          class F,
+          class Output,
+          class Residual,
+          class Input1,
+          class Input2,
+          class... Inputs>
+__device__ void add_rms_norm_residual(F compute,
+                                      float eps,
+                                      Output output,
+                                      Residual residual,
+                                      Input1 input1,
+                                      Input2 input2,
+                                      Inputs... inputs)
+{
+    generic_binary_norm<Axis>(
+        rms_norm_normalizer{eps},
+        compute,
+        [](auto x1, auto x2) { return x1 + x2; },
+        output,
+        residual,
+        input1,
+        input2,
+        inputs...);
 }
 
 } // namespace migraphx
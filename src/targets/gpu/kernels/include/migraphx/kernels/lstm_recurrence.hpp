@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_LSTM_RECURRENCE_HPP
+#define MIGRAPHX_GUARD_KERNELS_LSTM_RECURRENCE_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/type_traits.hpp>
+#include <migraphx/kernels/functional.hpp>
+
+namespace migraphx {
+
+template <class T>
+constexpr T lstm_sigmoid(T x)
+{
+    return T{1} / (T{1} + migraphx::exp(-x));
+}
+
+// One workgroup runs every timestep of one batch in one direction. Each thread owns the same
+// hidden units for the whole sequence, so the cell state stays in registers, and the hidden state
+// of the previous step is shared through LDS. The gates already hold the input projection and the
+// biases, so only the recurrence with the transposed weights is computed here, which reads
+// consecutive units across the threads.
+template <index_int Direction,
+          class Hidden,
+          class LastH,
+          class LastC,
+          class Gates,
+          class Rt,
+          class InitialH,
+          class InitialC,
+          class... Ps>
+__device__ void lstm_recurrence(Hidden hidden,
+                                LastH last_h,
+                                LastC last_c,
+                                Gates gates,
+                                Rt rt,
+                                InitialH ih,
+                                InitialC ic,
+                                Ps... ps)
+{
+    using type                  = typename Gates::type;
+    using acc                   = conditional_t<is_same<type, double>{}, double, float>;
+    constexpr auto lens         = get_shape_c<Hidden>{}.lens;
+    constexpr index_int seq_len = lens[0];
+    constexpr index_int batch   = lens[2];
+    constexpr index_int hsize   = lens[3];
+    auto idx                    = make_index();
+    constexpr index_int nunits  = (hsize + idx.max_nlocal() - 1) / idx.max_nlocal();
+
+    __shared__ acc h[2][hsize];
+    idx.group_stride(lens[1] * batch, [&](auto group) {
+        const index_int d = group / batch;
+        const index_int b = group % batch;
+        const bool reverse = Direction == 1 or (Direction == 2 and d == 1);
+        auto unit = [&](index_int u) { return idx.local + u * idx.nlocal(); };
+
+        array<acc, nunits> c;
+        for(index_int u = 0; u < nunits; u++)
+        {
+            auto k = unit(u);
+            if(k >= hsize)
+                continue;
+            h[0][k] = migraphx::convert<acc>(ih[make_array(d, b, k)]);
+            c[u]    = migraphx::convert<acc>(ic[make_array(d, b, k)]);
+        }
+        __syncthreads();
+
+        for(index_int step = 0; step < seq_len; step++)
+        {
+            const index_int t = reverse ? seq_len - 1 - step : step;
+            const acc* hprev  = h[step % 2];
+            acc* hnext        = h[(step + 1) % 2];
+            for(index_int u = 0; u < nunits; u++)
+            {
+                auto k = unit(u);
+                if(k >= hsize)
+                    continue;
+                array<acc, 4> g;
+                for(index_int gate = 0; gate < 4; gate++)
+                    g[gate] = migraphx::convert<acc>(gates[make_array(t, d, b, gate * hsize + k)]);
+                for(index_int col = 0; col < hsize; col++)
+                {
+                    const acc hc = hprev[col];
+                    for(index_int gate = 0; gate < 4; gate++)
+                        g[gate] +=
+                            hc * migraphx::convert<acc>(rt[make_array(d, col, gate * hsize + k)]);
+                }
+                // The peephole weights are in the order of the input, output and forget gates
+                array<acc, 3> p{0, 0, 0};
+                if constexpr(sizeof...(Ps) > 0)
+                {
+                    auto pw = arg_c<0>()(ps...);
+                    for(index_int gate = 0; gate < 3; gate++)
+                        p[gate] = migraphx::convert<acc>(pw[make_array(d, gate * hsize + k)]);
+                }
+                acc it   = lstm_sigmoid(g[0] + p[0] * c[u]);
+                acc ft   = lstm_sigmoid(g[2] + p[2] * c[u]);
+                c[u]     = ft * c[u] + it * migraphx::tanh(g[3]);
+                acc ot   = lstm_sigmoid(g[1] + p[1] * c[u]);
+                acc hv   = ot * migraphx::tanh(c[u]);
+                hnext[k] = hv;
+                hidden[make_array(t, d, b, k)] = migraphx::convert<type>(hv);
+            }
+            __syncthreads();
+        }
+
+        for(index_int u = 0; u < nunits; u++)
+        {
+            auto k = unit(u);
+            if(k >= hsize)
+                continue;
+            last_h[make_array(d, b, k)] = migraphx::convert<type>(h[seq_len % 2][k]);
+            last_c[make_array(d, b, k)] = migraphx::convert<type>(c[u]);
+        }
+        // The hidden state in LDS is reused by the next group
+        __syncthreads();
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_LSTM_RECURRENCE_HPP
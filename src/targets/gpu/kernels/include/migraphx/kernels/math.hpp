@@ -36,6 +36,8 @@ namespace migraphx {
 namespace math {
 constexpr float as_float(migraphx::half x) { return x; }
 
+constexpr float as_float(migraphx::bf16 x) { return x; }
+
 constexpr float as_float(migraphx::fp8::fp8e4m3fnuz x) { return x; }
 constexpr float as_float(migraphx::fp8::fp8e4m3fn x) { return x; }
 constexpr float as_float(migraphx::fp8::fp8e5m2 x) { return x; }
@@ -78,6 +80,12 @@ constexpr T as_float(T x)
     auto __device__ name(migraphx::half x, Ts... xs)                   \
         MIGRAPHX_RETURNS(fname(math::as_float(x), math::as_float(xs)...))
 
+// NOLINTNEXTLINE
+#define MIGRAPHX_DEVICE_MATH_BF16(name, fname)                         \
+    template <class... Ts, MIGRAPHX_REQUIRES(not is_any_vec<Ts...>())> \
+    auto __device__ name(migraphx::bf16 x, Ts... xs)                   \
+        MIGRAPHX_RETURNS(migraphx::bf16(fname(math::as_float(x), math::as_float(xs)...)))
+
 // NOLINTNEXTLINE
 #define MIGRAPHX_DEVICE_MATH_FP8(name, fname)                                                      \
     template <class... Ts, MIGRAPHX_REQUIRES(not is_any_vec<Ts...>())>                             \
@@ -214,6 +222,37 @@ MIGRAPHX_DEVICE_MATH_FP8(tan, ::tan)
 MIGRAPHX_DEVICE_MATH_FP8(tanh, ::tanh)
 MIGRAPHX_DEVICE_MATH_FP8(fmod, ::fmod)
 
+// use float to compute bf16 overload
+MIGRAPHX_DEVICE_MATH_BF16(abs, ::abs)
+MIGRAPHX_DEVICE_MATH_BF16(acos, ::acos)
+MIGRAPHX_DEVICE_MATH_BF16(acosh, ::acosh)
+MIGRAPHX_DEVICE_MATH_BF16(asin, ::asin)
+MIGRAPHX_DEVICE_MATH_BF16(asinh, ::asinh)
+MIGRAPHX_DEVICE_MATH_BF16(atan, ::atan)
+MIGRAPHX_DEVICE_MATH_BF16(atanh, ::atanh)
+MIGRAPHX_DEVICE_MATH_BF16(ceil, ::ceil)
+MIGRAPHX_DEVICE_MATH_BF16(cos, ::cos)
+MIGRAPHX_DEVICE_MATH_BF16(cosh, ::cosh)
+MIGRAPHX_DEVICE_MATH_BF16(erf, ::erf)
+MIGRAPHX_DEVICE_MATH_BF16(exp, ::exp)
+MIGRAPHX_DEVICE_MATH_BF16(floor, ::floor)
+MIGRAPHX_DEVICE_MATH_BF16(log, ::log)
+MIGRAPHX_DEVICE_MATH_BF16(log2, ::log2)
+MIGRAPHX_DEVICE_MATH_BF16(nearbyint, ::nearbyint)
+MIGRAPHX_DEVICE_MATH_BF16(pow, ::pow)
+MIGRAPHX_DEVICE_MATH_BF16(remainder, ::remainder)
+MIGRAPHX_DEVICE_MATH_BF16(round, ::round)
+MIGRAPHX_DEVICE_MATH_BF16(rsqrt, ::rsqrt)
+MIGRAPHX_DEVICE_MATH_BF16(sin, ::sin)
+MIGRAPHX_DEVICE_MATH_BF16(sinh, ::sinh)
+MIGRAPHX_DEVICE_MATH_BF16(sqrt, ::sqrt)
+MIGRAPHX_DEVICE_MATH_BF16(tan, ::tan)
+MIGRAPHX_DEVICE_MATH_BF16(tanh, ::tanh)
+MIGRAPHX_DEVICE_MATH_BF16(fmod, ::fmod)
+
+inline bool __device__ isinf(migraphx::bf16 x) { return ::isinf(math::as_float(x)); }
+inline bool __device__ isnan(migraphx::bf16 x) { return ::isnan(math::as_float(x)); }
+
 // Map math functions to hip half2 functions
 // The half2 type is defined in include/hip/amd_detail/hip_fp16_gcc.h and is 2 16-bit floats
 // packed into a 32-bit number.  See include/hip/amd_detail/hip_fp16_math_fwd.h for the HIP names
@@ -0,0 +1,125 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_MOE_HPP
+#define MIGRAPHX_GUARD_KERNELS_MOE_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+// Sorts the (token, slot) pairs picked by a mixture-of-experts router by their expert, using a
+// single workgroup. The output starts with the offset of the pairs of each expert, followed by
+// the flat index of each pair into the indices. The order of the pairs within an expert is not
+// deterministic, but each pair is computed on its own so the results are.
+template <index_int Experts, class Output, class Indices>
+__device__ void moe_route(Output output, Indices indices)
+{
+    auto idx         = make_index();
+    constexpr auto n = get_shape_c<Indices>{}.elements();
+
+    __shared__ index_int offsets[Experts + 1];
+    idx.local_stride(Experts + 1, [&](auto e) { offsets[e] = 0; });
+    __syncthreads();
+    idx.local_stride(n, [&](auto i) { atomicAdd(&offsets[indices[i]], index_int{1}); });
+    __syncthreads();
+    if(idx.local == 0)
+    {
+        index_int sum = 0;
+        for(index_int e = 0; e < Experts + 1; e++)
+        {
+            auto count = offsets[e];
+            offsets[e] = sum;
+            sum += count;
+        }
+    }
+    __syncthreads();
+    idx.local_stride(Experts + 1, [&](auto e) { output[e] = offsets[e]; });
+    __syncthreads();
+    idx.local_stride(n, [&](auto i) {
+        auto pos                  = atomicAdd(&offsets[indices[i]], index_int{1});
+        output[Experts + 1 + pos] = i;
+    });
+}
+
+// Grouped gemm over the pairs sorted by moe_route, which computes x[t] * w[e] for each token t
+// routed to expert e. The output is laid out as {tokens, slots, n}. Each workgroup computes
+// TileM consecutive sorted pairs for nlocal columns, so the weights of an expert are read once
+// for all of its pairs in the tile, and only the experts that were picked are computed.
+template <index_int TileM, class Output, class X, class W, class Route>
+__device__ void moe_gemm(Output output, X x, W w, Route route)
+{
+    auto idx               = make_index();
+    constexpr auto wlens   = get_shape_c<W>{}.lens;
+    constexpr auto experts = wlens[0];
+    constexpr auto k       = wlens[1];
+    constexpr auto n       = wlens[2];
+    constexpr auto slots   = get_shape_c<Output>{}.lens[1];
+    constexpr auto rows    = get_shape_c<Output>{}.elements() / n;
+    constexpr auto nrows   = (rows + TileM - 1) / TileM;
+    constexpr auto ncols   = (n + idx.max_nlocal() - 1) / idx.max_nlocal();
+    using type             = typename Output::type;
+
+    auto offset = [&](index_int e) -> index_int { return route[e]; };
+    auto pair   = [&](index_int r) -> index_int { return route[experts + 1 + r]; };
+
+    idx.group_stride(nrows * ncols, [&](auto g) {
+        const index_int m0 = (g / ncols) * TileM;
+        const index_int m1 = min(m0 + TileM, rows);
+        const index_int j  = (g % ncols) * idx.nlocal() + idx.local;
+        if(j >= n)
+            return;
+        index_int e = 0;
+        // The pairs of an expert are contiguous, so the tile is split at each expert boundary
+        for(index_int r0 = m0; r0 < m1;)
+        {
+            while(offset(e + 1) <= r0)
+                e++;
+            const index_int r1 = min(m1, offset(e + 1));
+            float acc[TileM]   = {0};
+            for(index_int kk = 0; kk < k; kk++)
+            {
+                auto b = migraphx::convert<float>(w[make_array(e, kk, j)]);
+                for(index_int r = 0; r < TileM; r++)
+                {
+                    if(r0 + r < r1)
+                        acc[r] +=
+                            migraphx::convert<float>(x[make_array(pair(r0 + r) / slots, kk)]) * b;
+                }
+            }
+            for(index_int r = 0; r < TileM; r++)
+            {
+                if(r0 + r >= r1)
+                    break;
+                auto p = pair(r0 + r);
+                output[make_array(p / slots, p % slots, j)] = migraphx::convert<type>(acc[r]);
+            }
+            r0 = r1;
+        }
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_MOE_HPP
@@ -0,0 +1,66 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_MULTINOMIAL_HPP
+#define MIGRAPHX_GUARD_KERNELS_MULTINOMIAL_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/algorithm.hpp>
+#include <migraphx/kernels/random.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+// Each sample is the class whose bucket in the cdf of its batch holds the uniform value from
+// dist, scaled by the total of the cdf
+template <class Output, class Cdf, class Dist>
+__device__ void multinomial(Output output, Cdf cdf, Dist dist)
+{
+    auto idx         = make_index();
+    auto class_size  = cdf.get_shape().lens.back();
+    auto sample_size = output.get_shape().lens.back();
+    idx.global_stride(output.get_shape().elements(), [&](auto i) {
+        auto first = cdf.begin() + (i / sample_size) * class_size;
+        auto last  = first + class_size;
+        auto it    = upper_bound(first, last, dist(i) * *(last - 1), less{});
+        output[i]  = it - first;
+    });
+}
+
+template <class Output, class Cdf, class Dist>
+__device__ void multinomial_dist(Output output, Cdf cdf, Dist dist)
+{
+    multinomial(output, cdf, [&](auto i) { return dist[i]; });
+}
+
+// The uniform values of type T are generated from the seed instead of being read from memory, so
+// they are the same as the ones random_uniform would write
+template <class T, class Output, class Cdf, class Seed>
+__device__ void multinomial_random(Output output, Cdf cdf, Seed seed)
+{
+    auto s = get_random_seed(seed);
+    multinomial(output, cdf, [&](auto i) { return random_uniform_value<T>(s, i); });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_MULTINOMIAL_HPP
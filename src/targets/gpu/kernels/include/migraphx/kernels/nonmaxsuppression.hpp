@@ -0,0 +1,215 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_NONMAXSUPPRESSION_HPP
+#define MIGRAPHX_GUARD_KERNELS_NONMAXSUPPRESSION_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/algorithm.hpp>
+#include <migraphx/kernels/scan.hpp>
+#include <migraphx/kernels/topk.hpp>
+#include <migraphx/kernels/functional.hpp>
+#include <migraphx/kernels/math.hpp>
+
+namespace migraphx {
+
+// Computed in double like the reference implementation, so the same boxes are suppressed
+struct nms_box
+{
+    array<double, 2> x;
+    array<double, 2> y;
+
+    constexpr double area() const { return (x[1] - x[0]) * (y[1] - y[0]); }
+};
+
+template <bool CenterPointBox, class Boxes>
+constexpr nms_box nms_load_box(Boxes boxes, index_int batch, index_int i)
+{
+    auto at = [&](index_int k) { return double(boxes[make_array(batch, i, k)]); };
+    nms_box result{};
+    if constexpr(CenterPointBox)
+    {
+        double half_width  = at(2) / 2.0;
+        double half_height = at(3) / 2.0;
+        result.x           = {at(0) - half_width, at(0) + half_width};
+        result.y           = {at(1) - half_height, at(1) + half_height};
+    }
+    else
+    {
+        result.x = {at(1), at(3)};
+        result.y = {at(0), at(2)};
+    }
+    if(result.x[0] > result.x[1])
+        swap(result.x[0], result.x[1]);
+    if(result.y[0] > result.y[1])
+        swap(result.y[0], result.y[1]);
+    return result;
+}
+
+constexpr bool nms_suppress_by_iou(const nms_box& b1, const nms_box& b2, double iou_threshold)
+{
+    const double area1 = b1.area();
+    const double area2 = b2.area();
+    if(area1 <= 0.0 or area2 <= 0.0)
+        return false;
+    nms_box intersection{};
+    intersection.x = {max(b1.x[0], b2.x[0]), min(b1.x[1], b2.x[1])};
+    intersection.y = {max(b1.y[0], b2.y[0]), min(b1.y[1], b2.y[1])};
+    if(intersection.x[0] > intersection.x[1] or intersection.y[0] > intersection.y[1])
+        return false;
+    const double intersection_area = intersection.area();
+    const double union_area        = area1 + area2 - intersection_area;
+    if(union_area <= 0.0)
+        return false;
+    return intersection_area / union_area > iou_threshold;
+}
+
+// Reads the optional scalar inputs, which are max_output_boxes_per_class, iou_threshold and
+// score_threshold
+template <index_int N, class T, class... Ts>
+constexpr T nms_arg(T default_value, Ts... xs)
+{
+    if constexpr(N < sizeof...(Ts))
+        return T(arg_c<N>()(xs...)[0]);
+    else
+        return default_value;
+}
+
+// One workgroup handles one class of one batch. Its candidates are sorted by score in its slice
+// of the workspace, which also keeps the selected boxes at the front. The selected boxes are then
+// written at the offset from a look-back over the counts of the classes before it, so the output
+// has the same order as the reference. The output must be zero-filled.
+template <bool CenterPointBox,
+          class State,
+          class Workspace,
+          class Output,
+          class Boxes,
+          class Scores,
+          class... Ts>
+__device__ void nonmaxsuppression(
+    State state, Workspace workspace, Output output, Boxes boxes, Scores scores, Ts... xs)
+{
+    static_assert(sizeof(typename Scores::type) <= 4, "Scores must fit in 32 bits of the key");
+    constexpr auto lens        = get_shape_c<Scores>{}.lens;
+    constexpr index_int nclass = lens[1];
+    constexpr index_int n      = lens[2];
+    constexpr index_int npad   = get_shape_c<Workspace>{}.lens[1];
+
+    const int64_t max_output     = nms_arg<0>(int64_t{0}, xs...);
+    const double iou_threshold   = nms_arg<1>(0.0, xs...);
+    const double score_threshold = nms_arg<2>(0.0, xs...);
+
+    auto idx              = make_index();
+    const index_int t     = next_tile(idx, state);
+    const index_int batch = t / nclass;
+    const index_int cls   = t % nclass;
+    uint64_t* keys        = workspace.data() + t * npad;
+
+    // Keys sort by score and then by index, both descending like the reference, and zero marks a
+    // box that was filtered or suppressed
+    __shared__ index_int nvalid;
+    if(idx.local == 0)
+        nvalid = 0;
+    __syncthreads();
+    idx.local_stride(npad, [&](auto i) {
+        uint64_t key = 0;
+        if(i < n)
+        {
+            auto score = scores[make_array(batch, cls, index_int{i})];
+            if(score_threshold <= 0.0 or double(score) >= score_threshold)
+                key = (topk_value_key<false>(score) << 32) | i;
+        }
+        keys[i] = key;
+        if(key != 0)
+            atomicAdd(&nvalid, index_int{1});
+    });
+    __syncthreads();
+
+    for(index_int size = 2; size <= npad; size *= 2)
+    {
+        for(index_int stride = size / 2; stride > 0; stride /= 2)
+        {
+            idx.local_stride(npad, [&](auto i) {
+                index_int j = i ^ stride;
+                if(j <= i)
+                    return;
+                bool descending = (i & size) == 0;
+                if((keys[i] < keys[j]) == descending)
+                    swap(keys[i], keys[j]);
+            });
+            __syncthreads();
+        }
+    }
+
+    // Greedy suppression, each selected box suppresses the remaining boxes in parallel
+    __shared__ index_int nselected;
+    __shared__ index_int current;
+    __shared__ index_int selected;
+    __shared__ bool done;
+    if(idx.local == 0)
+    {
+        nselected = 0;
+        current   = 0;
+    }
+    __syncthreads();
+    while(true)
+    {
+        if(idx.local == 0)
+        {
+            while(current < nvalid and keys[current] == 0)
+                current++;
+            done = current >= nvalid or int64_t{nselected} >= max_output;
+            if(not done)
+            {
+                selected        = keys[current] & 0xffffffff;
+                keys[nselected] = keys[current];
+                nselected++;
+                current++;
+            }
+        }
+        __syncthreads();
+        if(done)
+            break;
+        auto selected_box = nms_load_box<CenterPointBox>(boxes, batch, selected);
+        idx.local_stride(nvalid - current, [&](auto k) {
+            auto j = current + k;
+            if(keys[j] == 0)
+                return;
+            auto box = nms_load_box<CenterPointBox>(boxes, batch, keys[j] & 0xffffffff);
+            if(nms_suppress_by_iou(box, selected_box, iou_threshold))
+                keys[j] = 0;
+        });
+        __syncthreads();
+    }
+
+    auto start = tile_exclusive_prefix(idx, state, t, nselected);
+    idx.local_stride(nselected, [&](auto s) {
+        auto i                   = start + s;
+        output[make_array(i, 0)] = batch;
+        output[make_array(i, 1)] = cls;
+        output[make_array(i, 2)] = keys[s] & 0xffffffff;
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_NONMAXSUPPRESSION_HPP
@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,33 +21,33 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/logsoftmax.hpp>
-#include <migraphx/gpu/device/logsoftmax.hpp>
-#include <migraphx/op/logsoftmax.hpp>
-#include <migraphx/manage_ptr.hpp>
-#include <migraphx/gpu/miopen.hpp>
-#include <migraphx/tune_axis.hpp>
-#include <utility>
+#ifndef MIGRAPHX_GUARD_KERNELS_NONZERO_HPP
+#define MIGRAPHX_GUARD_KERNELS_NONZERO_HPP
 
-namespace migraphx {
-inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/scan.hpp>
+#include <migraphx/kernels/shape.hpp>
 
-shape hip_logsoftmax::compute_shape(const std::vector<shape>& inputs) const
-{
-    check_shapes{inputs, *this}.has(2).standard();
-    return op.normalize_compute_shape({inputs.at(0)});
-}
+namespace migraphx {
 
-argument
-hip_logsoftmax::compute(context& ctx, const shape&, const std::vector<argument>& args) const
+// The output must be zero-filled, as only the positions of the nonzero elements are written
+template <index_int ItemsPerThread, class Input, class State, class Output>
+__device__ void nonzero(Input input, State state, Output output)
 {
-    auto n_dim      = args.front().get_shape().lens().size();
-    auto tuned_axis = tune_axis(n_dim, op.axis, op.name());
-    device::logsoftmax(ctx.get_stream().get(), args.back(), args.front(), tuned_axis);
-    return args.back();
+    auto idx         = make_index();
+    constexpr auto s = get_shape_c<Input>{};
+    constexpr auto n = s.elements();
+    scan::compact<ItemsPerThread>(
+        idx,
+        state,
+        n,
+        [&](auto i) { return input[i] != 0; },
+        [&](auto i, auto j) {
+            auto multi = s.multi(i);
+            for(index_int k = 0; k < multi.size(); k++)
+                output[k * n + j] = multi[k];
+        });
 }
 
-} // namespace gpu
-} // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_NONZERO_HPP
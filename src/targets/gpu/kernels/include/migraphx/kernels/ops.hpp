@@ -27,6 +27,22 @@
 #include <migraphx/kernels/math.hpp>
 
 namespace migraphx {
+
+// A value along with its index in the reduction, used for the arg reductions
+template <class T>
+struct arg_value
+{
+    T value;
+    index_int index;
+
+    arg_value() = default;
+
+    template <class U>
+    constexpr arg_value(U v, index_int i = 0) : value(v), index(i)
+    {
+    }
+};
+
 namespace op {
 
 struct sum
@@ -124,6 +140,52 @@ struct logical_or
         return static_cast<T>(0);
     }
 };
+struct make_arg_value
+{
+    template <class T>
+    MIGRAPHX_DEVICE_CONSTEXPR arg_value<T> operator()(T x, index_int i) const
+    {
+        return {x, i};
+    }
+};
+
+struct get_arg_index
+{
+    template <class T>
+    MIGRAPHX_DEVICE_CONSTEXPR index_int operator()(arg_value<T> x) const
+    {
+        return x.index;
+    }
+};
+
+// Ties pick the first index, or the last index with SelectLast
+template <bool SelectLast>
+struct argmax
+{
+    template <class T>
+    MIGRAPHX_DEVICE_CONSTEXPR arg_value<T> operator()(arg_value<T> x, arg_value<T> y) const
+    {
+        if(x.value > y.value)
+            return x;
+        if(x.value < y.value)
+            return y;
+        return (x.index < y.index) != SelectLast ? x : y;
+    }
+};
+
+template <bool SelectLast>
+struct argmin
+{
+    template <class T>
+    MIGRAPHX_DEVICE_CONSTEXPR arg_value<T> operator()(arg_value<T> x, arg_value<T> y) const
+    {
+        if(x.value < y.value)
+            return x;
+        if(x.value > y.value)
+            return y;
+        return (x.index < y.index) != SelectLast ? x : y;
+    }
+};
 } // namespace op
 
 // NOLINTNEXTLINE
@@ -0,0 +1,276 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_PAGED_ATTENTION_HPP
+#define MIGRAPHX_GUARD_KERNELS_PAGED_ATTENTION_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/reduce.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+#include <migraphx/kernels/type_traits.hpp>
+
+namespace migraphx {
+
+// Offset of the row for the token at pos in the cache, or -1 when its block is not mapped
+template <class Cache, class BlockTable>
+__device__ int64_t paged_cache_offset(BlockTable block_table, index_int b, index_int pos)
+{
+    constexpr auto clens      = get_shape_c<Cache>{}.lens;
+    constexpr auto num_blocks = clens[0];
+    constexpr auto block_size = clens[1];
+    constexpr auto row        = clens[2] * clens[3];
+    constexpr auto max_blocks = get_shape_c<BlockTable>{}.lens[1];
+    auto blk = static_cast<int64_t>(block_table[b * max_blocks + pos / block_size]);
+    if(blk < 0 or blk >= static_cast<int64_t>(num_blocks))
+        return -1;
+    return (blk * block_size + pos % block_size) * row;
+}
+
+// Divides x by scale and converts it to the type of a quantized cache, saturating to its range
+template <class T>
+__device__ T quantize_kv(float x, float scale)
+{
+    float y = x / scale;
+    if constexpr(is_integral<T>{})
+        y = migraphx::nearbyint(y);
+    y = min(max(y, migraphx::convert<float>(numeric_lowest<T>())),
+            migraphx::convert<float>(numeric_max<T>()));
+    return migraphx::convert<T>(y);
+}
+
+template <class Update, class BlockTable, class Positions, class Cache, class F>
+__device__ void kv_cache_update_impl(
+    Update update, BlockTable block_table, Positions positions, Cache cache, F store)
+{
+    auto idx                   = make_index();
+    constexpr auto ulens       = get_shape_c<Update>{}.lens;
+    constexpr auto seq_len     = ulens[1];
+    constexpr auto row         = ulens[2] * ulens[3];
+    constexpr auto max_context = get_shape_c<BlockTable>{}.lens[1] * get_shape_c<Cache>{}.lens[1];
+    idx.global_stride(update.get_shape().elements(), [&](auto i) {
+        auto token = i / row;
+        auto b     = token / seq_len;
+        auto start = static_cast<int64_t>(positions[b]);
+        if(start < 0)
+            return;
+        auto pos = start + token % seq_len;
+        if(pos >= static_cast<int64_t>(max_context))
+            return;
+        auto offset = paged_cache_offset<Cache>(block_table, b, pos);
+        if(offset < 0)
+            return;
+        cache[offset + i % row] = store(update[i], i % row);
+    });
+}
+
+template <class Update, class BlockTable, class Positions, class Cache>
+__device__ void
+kv_cache_update(Update update, BlockTable block_table, Positions positions, Cache cache)
+{
+    kv_cache_update_impl(update, block_table, positions, cache, [](auto x, auto) { return x; });
+}
+
+// Quantizes the rows with the scale of their head
+template <class Update, class BlockTable, class Positions, class Scales, class Cache>
+__device__ void kv_cache_update(
+    Update update, BlockTable block_table, Positions positions, Scales scales, Cache cache)
+{
+    using type              = typename Cache::type;
+    constexpr auto head_dim = get_shape_c<Update>{}.lens[3];
+    kv_cache_update_impl(update, block_table, positions, cache, [&](auto x, auto j) {
+        return quantize_kv<type>(migraphx::convert<float>(x),
+                                 migraphx::convert<float>(scales[j / head_dim]));
+    });
+}
+
+// Copies whole blocks of the cache, one element per thread. The sources and destinations do not
+// overlap, so the copies can run in any order.
+template <class Copies, class Cache>
+__device__ void kv_cache_copy_blocks(Copies copies, Cache cache)
+{
+    auto idx                  = make_index();
+    constexpr auto clens      = get_shape_c<Cache>{}.lens;
+    constexpr auto num_blocks = static_cast<int64_t>(clens[0]);
+    constexpr auto block      = clens[1] * clens[2] * clens[3];
+    constexpr auto ncopies    = get_shape_c<Copies>{}.lens[0];
+    idx.global_stride(ncopies * block, [&](auto i) {
+        auto c   = i / block;
+        auto src = static_cast<int64_t>(copies[2 * c]);
+        auto dst = static_cast<int64_t>(copies[2 * c + 1]);
+        if(src < 0 or dst < 0 or src >= num_blocks or dst >= num_blocks)
+            return;
+        cache[dst * block + i % block] = cache[src * block + i % block];
+    });
+}
+
+// One workgroup computes one (batch, token, head) row of the output. The visible tokens are
+// processed in tiles of nlocal with an online softmax, so each thread only keeps the running
+// sum for a single element of head_dim. Quantized caches are dequantized in registers with the
+// scales returned by key_scale and value_scale for the kv head.
+template <class Query,
+          class KeyCache,
+          class ValueCache,
+          class BlockTable,
+          class ContextLens,
+          class Output,
+          class KeyScale,
+          class ValueScale>
+__device__ void paged_attention_impl(Query query,
+                                     KeyCache key_cache,
+                                     ValueCache value_cache,
+                                     BlockTable block_table,
+                                     ContextLens context_lens,
+                                     Output output,
+                                     float scale,
+                                     KeyScale key_scale,
+                                     ValueScale value_scale)
+{
+    auto idx                   = make_index();
+    constexpr auto qlens       = get_shape_c<Query>{}.lens;
+    constexpr auto seq_len     = qlens[1];
+    constexpr auto heads       = qlens[2];
+    constexpr auto head_dim    = qlens[3];
+    constexpr auto kv_heads    = get_shape_c<KeyCache>{}.lens[2];
+    constexpr auto group       = heads / kv_heads;
+    constexpr auto max_context =
+        get_shape_c<BlockTable>{}.lens[1] * get_shape_c<KeyCache>{}.lens[1];
+    MIGRAPHX_ASSERT(idx.nlocal() >= head_dim);
+
+    auto h    = idx.group % heads;
+    auto t    = (idx.group / heads) % seq_len;
+    auto b    = idx.group / (heads * seq_len);
+    auto kvh  = h / group;
+    auto qoff = idx.group * head_dim;
+    auto ks   = scale * key_scale(kvh);
+
+    __shared__ float q[head_dim];
+    __shared__ float p[idx.max_nlocal()];
+    idx.local_stride(head_dim, [&](auto d) { q[d] = migraphx::convert<float>(query[qoff + d]); });
+    __syncthreads();
+
+    int64_t context_len = min(max(static_cast<int64_t>(context_lens[b]), int64_t{0}),
+                              static_cast<int64_t>(max_context));
+    int64_t visible     = context_len + t + 1 - static_cast<int64_t>(seq_len);
+    index_int n         = visible > 0 ? min(context_len, visible) : 0;
+
+    float m   = lowest{};
+    float l   = 0;
+    float acc = 0;
+    for(index_int start = 0; start < n; start += idx.nlocal())
+    {
+        auto pos    = start + idx.local;
+        float score = lowest{};
+        if(pos < n)
+        {
+            auto koff = paged_cache_offset<KeyCache>(block_table, b, pos);
+            if(koff >= 0)
+            {
+                float dot = 0;
+                for(index_int d = 0; d < head_dim; d++)
+                    dot += q[d] * migraphx::convert<float>(key_cache[koff + kvh * head_dim + d]);
+                score = dot * ks;
+            }
+        }
+        auto tile_max = block_reduce(
+            idx, op::max{}, float(lowest{}), idx.nlocal(), [&](auto) { return score; });
+        auto new_m = max(m, tile_max);
+        float pi   = (score == float(lowest{})) ? 0.0f : migraphx::exp(score - new_m);
+        p[idx.local] = pi;
+        __syncthreads();
+        auto tile_sum = block_reduce(idx, op::sum{}, 0.0f, idx.nlocal(), [&](auto) { return pi; });
+        float correction = (m == float(lowest{})) ? 0.0f : migraphx::exp(m - new_m);
+        l                = l * correction + tile_sum;
+        if(idx.local < head_dim)
+        {
+            acc *= correction;
+            for(index_int j = 0; j < idx.nlocal() and start + j < n; j++)
+            {
+                if(p[j] == 0.0f)
+                    continue;
+                auto voff = paged_cache_offset<ValueCache>(block_table, b, start + j);
+                acc += p[j] *
+                       migraphx::convert<float>(value_cache[voff + kvh * head_dim + idx.local]);
+            }
+        }
+        m = new_m;
+        __syncthreads();
+    }
+    using type = typename Output::type;
+    if(idx.local < head_dim)
+        output[qoff + idx.local] =
+            migraphx::convert<type>(l > 0 ? acc * value_scale(kvh) / l : 0.0f);
+}
+
+template <class Query,
+          class KeyCache,
+          class ValueCache,
+          class BlockTable,
+          class ContextLens,
+          class Output>
+__device__ void paged_attention(Query query,
+                                KeyCache key_cache,
+                                ValueCache value_cache,
+                                BlockTable block_table,
+                                ContextLens context_lens,
+                                Output output,
+                                float scale)
+{
+    auto one = [](auto) { return 1.0f; };
+    paged_attention_impl(
+        query, key_cache, value_cache, block_table, context_lens, output, scale, one, one);
+}
+
+template <class Query,
+          class KeyCache,
+          class ValueCache,
+          class BlockTable,
+          class ContextLens,
+          class KeyScales,
+          class ValueScales,
+          class Output>
+__device__ void paged_attention(Query query,
+                                KeyCache key_cache,
+                                ValueCache value_cache,
+                                BlockTable block_table,
+                                ContextLens context_lens,
+                                KeyScales key_scales,
+                                ValueScales value_scales,
+                                Output output,
+                                float scale)
+{
+    paged_attention_impl(
+        query,
+        key_cache,
+        value_cache,
+        block_table,
+        context_lens,
+        output,
+        scale,
+        [&](auto kvh) { return migraphx::convert<float>(key_scales[kvh]); },
+        [&](auto kvh) { return migraphx::convert<float>(value_scales[kvh]); });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_PAGED_ATTENTION_HPP
@@ -35,6 +35,17 @@
 
 namespace migraphx {
 
+// Sums over the window are accumulated in float so low precision and integer types don't lose
+// precision or overflow
+template <class T>
+constexpr auto pool_accumulate(T x)
+{
+    if constexpr(is_same<T, double>{})
+        return x;
+    else
+        return static_cast<float>(x);
+}
+
 template <class Derived>
 struct pool_op
 {
@@ -69,9 +80,9 @@ struct average_pool : pool_op<average_pool>
     MIGRAPHX_DEVICE_CONSTEXPR auto init() const { return make_tuple(0.0, 0); }
 
     template <class T>
-    MIGRAPHX_DEVICE_CONSTEXPR tuple<T, index_int> apply(T x) const
+    MIGRAPHX_DEVICE_CONSTEXPR auto apply(T x) const
     {
-        return {x, 1};
+        return make_tuple(pool_accumulate(x), index_int{1});
     }
 
     MIGRAPHX_DEVICE_CONSTEXPR auto reduce() const { return op::sum{}; }
@@ -89,6 +100,12 @@ struct average_include_pad_pool : pool_op<average_include_pad_pool>
 {
     MIGRAPHX_DEVICE_CONSTEXPR auto init() const { return 0.0; }
 
+    template <class T>
+    MIGRAPHX_DEVICE_CONSTEXPR auto apply(T x) const
+    {
+        return pool_accumulate(x);
+    }
+
     MIGRAPHX_DEVICE_CONSTEXPR auto reduce() const { return op::sum{}; }
 
     template <class T, class U>
@@ -111,16 +128,18 @@ struct lpnorm_pool : lpnorm_pool_base, pool_op<lpnorm_pool<P>>
     MIGRAPHX_DEVICE_CONSTEXPR auto init() const { return 0.0; }
 
     template <class T>
-    MIGRAPHX_DEVICE_CONSTEXPR T apply(T x) const
+    MIGRAPHX_DEVICE_CONSTEXPR auto apply(T x) const
     {
+        auto y    = pool_accumulate(x);
+        using acc = decltype(y);
         if constexpr(P == 0)
-            return 1;
+            return acc{1};
         else if constexpr(P == 1)
-            return migraphx::abs(x);
+            return migraphx::abs(y);
         else if constexpr(P == 2)
-            return x * x;
+            return y * y;
         else
-            return migraphx::pow(migraphx::abs(x), T(P));
+            return migraphx::pow(migraphx::abs(y), acc(P));
     }
 
     MIGRAPHX_DEVICE_CONSTEXPR auto pad() const { return apply(init()); }
@@ -141,12 +160,13 @@ struct lpnorm_pool : lpnorm_pool_base, pool_op<lpnorm_pool<P>>
     }
 };
 
-template <class Window, class Stride, class Padding>
+template <class Window, class Stride, class Padding, class Dilation>
 struct window
 {
-    Window win      = {};
-    Stride stride   = {};
-    Padding padding = {};
+    Window win        = {};
+    Stride stride     = {};
+    Padding padding   = {};
+    Dilation dilation = {};
 
     using rank = decltype(Window{}.size());
 
@@ -170,7 +190,12 @@ struct window
             diff_int p = padding[j];
             return (dim * s) - p;
         });
-        return [=](auto j) { return f(win_start + win.multi(j)); };
+        return [=](auto j) {
+            auto k = win.multi(j);
+            return f(generate_array<diff_int>(rank{}, [&](auto d) {
+                return win_start[d] + diff_int(k[d] * dilation[d]);
+            }));
+        };
     }
 
     template <class Index, class F>
@@ -180,10 +205,11 @@ struct window
     }
 };
 
-template <class Window, class Stride, class Padding>
-constexpr window<Window, Stride, Padding> make_window(Window w, Stride s, Padding p)
+template <class Window, class Stride, class Padding, class Dilation>
+constexpr window<Window, Stride, Padding, Dilation>
+make_window(Window w, Stride s, Padding p, Dilation d)
 {
-    return {w, s, p};
+    return {w, s, p, d};
 }
 
 template <class Algo, index_int GroupSize, class Output, class F>
@@ -198,10 +224,9 @@ __device__ void pooling_reduce(Output output, F f)
     {
         auto goutput = as_vec<GroupSize>(output, output.get_shape().lens.size() - _c<1>);
         Algo::template run<decltype(goutput)>([&](auto out_idx, auto r) {
-            auto i = out_idx;
-            i.back() *= GroupSize;
-            auto result = vec_generate<GroupSize>([&](auto) {
-                i.back()++;
+            auto result = vec_generate<GroupSize>([&](auto k) {
+                auto i = out_idx;
+                i.back() = i.back() * GroupSize + k;
                 return f(i, r);
             });
             r.outer([&] { goutput[out_idx] = result; });
@@ -225,7 +250,7 @@ __device__ void pooling(Op op, Window w, Output output, Input input)
                 return itype(op.pad());
             }
         }))(reduce::make_indices(w.size()));
-        return op.final(x, w.size());
+        return static_cast<typename Output::type>(op.final(x, w.size()));
     });
 }
 
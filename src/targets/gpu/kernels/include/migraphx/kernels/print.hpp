@@ -167,6 +167,10 @@ struct basic_printer
     {
         return print_double(value);
     }
+    __host__ __device__ const basic_printer& operator<<(migraphx::bf16 value) const
+    {
+        return print_double(value);
+    }
     __host__ __device__ const basic_printer& operator<<(float value) const
     {
         return print_double(value);
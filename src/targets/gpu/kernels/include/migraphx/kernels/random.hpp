@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_RANDOM_HPP
+#define MIGRAPHX_GUARD_KERNELS_RANDOM_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/type_traits.hpp>
+#include <migraphx/kernels/types.hpp>
+
+namespace migraphx {
+
+// Philox4x32-10 counter based generator. Each counter maps to four independent random words for a
+// given key, so every element can be generated by its own thread without any state.
+struct philox
+{
+    static constexpr uint32_t m0 = 0xD2511F53;
+    static constexpr uint32_t m1 = 0xCD9E8D57;
+    static constexpr uint32_t w0 = 0x9E3779B9;
+    static constexpr uint32_t w1 = 0xBB67AE85;
+
+    static constexpr array<uint32_t, 4> round(array<uint32_t, 4> c, array<uint32_t, 2> k)
+    {
+        uint64_t p0 = uint64_t{m0} * c[0];
+        uint64_t p1 = uint64_t{m1} * c[2];
+        return {static_cast<uint32_t>(p1 >> 32u) ^ c[1] ^ k[0],
+                static_cast<uint32_t>(p1),
+                static_cast<uint32_t>(p0 >> 32u) ^ c[3] ^ k[1],
+                static_cast<uint32_t>(p0)};
+    }
+
+    static constexpr array<uint32_t, 4> generate(uint64_t counter, uint64_t key)
+    {
+        array<uint32_t, 4> c = {static_cast<uint32_t>(counter),
+                                static_cast<uint32_t>(counter >> 32u),
+                                uint32_t{0},
+                                uint32_t{0}};
+        array<uint32_t, 2> k = {static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32u)};
+        for(index_int i = 0; i < 9; i++)
+        {
+            c = round(c, k);
+            k[0] += w0;
+            k[1] += w1;
+        }
+        return round(c, k);
+    }
+};
+
+// Number of random bits that can be placed in the mantissa of T so that every value is
+// representable and the result stays below 1
+template <class T>
+constexpr index_int random_mantissa_bits()
+{
+    if constexpr(is_same<T, double>{})
+        return 53;
+    else if constexpr(is_same<T, float>{})
+        return 24;
+    else if constexpr(is_same<T, half>{})
+        return 11;
+    else if constexpr(sizeof(T) == 2)
+        return 8;
+    else
+        return 3;
+}
+
+// The i-th random value for the seed, in [0, 1) for floating point types and [0, max] for integers
+template <class T>
+constexpr T random_uniform_value(uint64_t seed, uint64_t i)
+{
+    auto r    = philox::generate(i, seed);
+    auto bits = (uint64_t{r[1]} << 32u) | r[0];
+    if constexpr(is_integral<T>{})
+    {
+        if constexpr(is_unsigned<T>{})
+            return static_cast<T>(bits);
+        else
+            return static_cast<T>(bits & static_cast<uint64_t>(numeric_max<T>()));
+    }
+    else
+    {
+        constexpr auto n = random_mantissa_bits<T>();
+        if constexpr(n > 24)
+            return static_cast<T>(static_cast<double>(bits >> (64u - n)) /
+                                  static_cast<double>(uint64_t{1} << n));
+        else
+            return static_cast<T>(static_cast<float>(r[0] >> (32u - n)) /
+                                  static_cast<float>(uint32_t{1} << n));
+    }
+}
+
+template <class Seed>
+constexpr uint64_t get_random_seed(Seed seed)
+{
+    return static_cast<uint64_t>(seed[0]);
+}
+
+template <class Seed, class Output>
+__device__ void random_uniform(Seed seed, Output output)
+{
+    using type = typename Output::type;
+    auto idx   = make_index();
+    auto s     = get_random_seed(seed);
+    idx.global_stride(output.get_shape().elements(),
+                      [&](auto i) { output[i] = random_uniform_value<type>(s, i); });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_RANDOM_HPP
@@ -434,6 +434,17 @@ struct reducer_base
         return this->reduce(op, init, op::id{});
     }
 
+    // Same as reduce, but the index of the element in the reduction is passed to read as the last
+    // argument
+    template <class Op, class T, class Read>
+    __device__ auto reduce_with_index(Op op, T init, Read read) const
+    {
+        return this->inner_sliced([=](auto n, auto&&... xs) {
+            auto&& derived = static_cast<const Derived&>(*this);
+            return derived.reduce_impl(op, init, read, n, xs..., make_indices(n));
+        });
+    }
+
     template <class F>
     __device__ void outer(F f) const
     {
@@ -760,6 +771,22 @@ simple_reduce(Op op, T init, Input input, Output output, ReadInput read, WriteOu
     });
 }
 
+template <class Algo,
+          class Op,
+          class T,
+          class Input,
+          class Output,
+          class ReadInput,
+          class WriteOuput>
+__device__ void simple_reduce_with_index(
+    Op op, T init, Input input, Output output, ReadInput read, WriteOuput write)
+{
+    Algo::template run<Output>([&](auto out_idx, auto r) {
+        auto x = r.reduce_with_index(op, init, read)(input);
+        r.outer([&] { output[out_idx] = write(x); });
+    });
+}
+
 template <class Algo, class Reduced, class Output, class Assign, class F>
 __device__ void fused_reduce(Output output_pack, Assign assign, F f)
 {
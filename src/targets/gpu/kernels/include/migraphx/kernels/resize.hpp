@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_RESIZE_HPP
+#define MIGRAPHX_GUARD_KERNELS_RESIZE_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/types.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/vec.hpp>
+
+namespace migraphx {
+
+// The positions of the input read along the resized axes for each position of the output, and
+// their weights. There are Count of them for each position, and the entries of each axis start at
+// its offset in the tables.
+template <index_int Count, class Offsets>
+struct resize_samples
+{
+    Offsets offsets;
+    const index_int* indices;
+    const float* weights;
+
+    constexpr index_int at(index_int axis, index_int i, index_int k) const
+    {
+        return offsets[axis] + i * Count + k;
+    }
+};
+
+template <index_int Count, class Offsets>
+constexpr resize_samples<Count, Offsets>
+make_resize_samples(Offsets offsets, const index_int* indices, const float* weights)
+{
+    return {offsets, indices, weights};
+}
+
+// Resizes the axes starting at Outer, while the leading axes, such as the batch and the channels,
+// are copied. Each thread looks up the positions read for one position of the resized axes once,
+// and then interpolates a group of Group channels at that position.
+template <index_int Outer,
+          index_int OuterElements,
+          index_int InnerElements,
+          index_int Neighbors,
+          index_int Group,
+          index_int Count,
+          class Offsets,
+          class Input,
+          class Output>
+__device__ void resize(const Input& input, Output& output, resize_samples<Count, Offsets> samples)
+{
+    auto idx       = make_index();
+    auto in_shape  = input.get_shape();
+    auto out_shape = output.get_shape();
+
+    constexpr index_int groups = (OuterElements + Group - 1) / Group;
+    idx.global_stride(InnerElements * groups, [&](auto gj) {
+        auto j = gj % InnerElements;
+        auto g = gj / InnerElements;
+        // The leading axes are zero here, so the offsets are only for the resized axes
+        auto out_multi = out_shape.multi(j);
+        array<index_int, Neighbors> offsets;
+        array<float, Neighbors> weights;
+        for(index_int n = 0; n < Neighbors; n++)
+        {
+            auto in_multi = out_multi;
+            float weight  = 1;
+            index_int k   = n;
+            for(index_int a = out_multi.size(); a > Outer; a--)
+            {
+                auto axis      = a - 1;
+                auto t         = samples.at(axis - Outer, out_multi[axis], k % Count);
+                in_multi[axis] = samples.indices[t];
+                weight *= samples.weights[t];
+                k /= Count;
+            }
+            offsets[n] = in_shape.index(in_multi);
+            weights[n] = weight;
+        }
+        auto last = min(OuterElements, (g + 1) * Group);
+        for(index_int o = g * Group; o < last; o++)
+        {
+            auto i    = o * InnerElements;
+            auto base = input.data() + in_shape.index(out_shape.multi(i));
+            // Nearest mode copies the value
+            if constexpr(Neighbors == 1)
+            {
+                output[i + j] = base[offsets[0]];
+            }
+            else
+            {
+                float acc = 0;
+                for(index_int n = 0; n < Neighbors; n++)
+                    acc += weights[n] * static_cast<float>(base[offsets[n]]);
+                output[i + j] = implicit_conversion(acc);
+            }
+        }
+    });
+}
+
+} // namespace migraphx
+#endif
@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_RNN_VARIABLE_SEQ_LENS_HPP
+#define MIGRAPHX_GUARD_KERNELS_RNN_VARIABLE_SEQ_LENS_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+// Moves each batch of the {seq, batch, ...} input to the end of the sequence, so shorter
+// sequences are padded with zeros at the front
+template <class Input, class SeqLens, class Output>
+__device__ void rnn_var_sl_shift_sequence(Input input, SeqLens seq_lens, Output output)
+{
+    using type   = typename Output::type;
+    auto idx     = make_index();
+    auto max_len = output.get_shape().lens[0];
+    idx.global_stride(output.get_shape().elements(), [&](auto i) {
+        auto out_idx    = output.get_shape().multi(i);
+        index_int shift = max_len - seq_lens[out_idx[1]];
+        if(out_idx[0] < shift)
+        {
+            output[out_idx] = type(0);
+            return;
+        }
+        auto in_idx = out_idx;
+        in_idx[0] -= shift;
+        output[out_idx] = input[in_idx];
+    });
+}
+
+// Moves the {seq, direction, batch, hidden} states back to the start of the sequence, the
+// reverse direction of the computation was run on the shifted sequence
+template <bool Reverse, class Input, class SeqLens, class Output>
+__device__ void rnn_var_sl_shift_output(Input input, SeqLens seq_lens, Output output)
+{
+    using type   = typename Output::type;
+    auto idx     = make_index();
+    auto max_len = output.get_shape().lens[0];
+    idx.global_stride(output.get_shape().elements(), [&](auto i) {
+        auto out_idx = output.get_shape().multi(i);
+        index_int l  = seq_lens[out_idx[2]];
+        if(out_idx[0] >= l)
+        {
+            output[out_idx] = type(0);
+            return;
+        }
+        auto in_idx = out_idx;
+        if(Reverse or out_idx[1] == 1)
+            in_idx[0] += max_len - l;
+        output[out_idx] = input[in_idx];
+    });
+}
+
+// Reads the {direction, batch, hidden} state of the last step of each sequence
+template <bool Reverse, class Input, class SeqLens, class Output>
+__device__ void rnn_var_sl_last_output(Input input, SeqLens seq_lens, Output output)
+{
+    auto idx = make_index();
+    idx.global_stride(output.get_shape().elements(), [&](auto i) {
+        auto out_idx    = output.get_shape().multi(i);
+        index_int l     = seq_lens[out_idx[1]];
+        index_int t     = (Reverse or out_idx[0] == 1) ? 0 : l - 1;
+        output[out_idx] = input[make_array<index_int>(t, out_idx[0], out_idx[1], out_idx[2])];
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_RNN_VARIABLE_SEQ_LENS_HPP
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_ROTARY_EMBEDDING_HPP
+#define MIGRAPHX_GUARD_KERNELS_ROTARY_EMBEDDING_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/shape.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+// Each element is computed with the one it is rotated with on the last axis, which is half the
+// axis away or its neighbour when interleaved
+template <bool Interleaved, class Input, class Cos, class Sin, class Output>
+__device__ void rotary_embedding(Input input, Cos c, Sin s, Output output)
+{
+    auto idx              = make_index();
+    constexpr index_int d = get_shape_c<Output>{}.lens.back();
+    using type            = typename Output::type;
+    idx.global_stride(output.get_shape().elements(), [&](auto i) {
+        auto out_idx       = output.get_shape().multi(i);
+        auto j             = out_idx.back();
+        auto partner_idx   = out_idx;
+        bool negate        = Interleaved ? (j % 2 == 0) : (j < d / 2);
+        partner_idx.back() = Interleaved ? (j ^ 1) : ((j + d / 2) % d);
+        auto rotated       = migraphx::convert<float>(input[partner_idx]);
+        if(negate)
+            rotated = -rotated;
+        auto x          = migraphx::convert<float>(input[out_idx]);
+        output[out_idx] = migraphx::convert<type>(x * migraphx::convert<float>(c[out_idx]) +
+                                                  rotated * migraphx::convert<float>(s[out_idx]));
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_ROTARY_EMBEDDING_HPP
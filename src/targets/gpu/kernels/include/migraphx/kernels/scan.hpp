@@ -0,0 +1,180 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_SCAN_HPP
+#define MIGRAPHX_GUARD_KERNELS_SCAN_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/array.hpp>
+#include <migraphx/kernels/ops.hpp>
+
+namespace migraphx {
+namespace scan {
+
+// Exclusive scan of one value per thread across the workgroup, the total of the workgroup is
+// stored in total
+template <class Op, class T>
+__device__ T block_exclusive(index idx, Op op, T init, T x, T& total)
+{
+    MIGRAPHX_ASSERT(idx.max_nlocal() == idx.nlocal());
+    __shared__ T buffer[idx.max_nlocal()];
+    buffer[idx.local] = x;
+    __syncthreads();
+    for(index_int s = 1; s < idx.nlocal(); s *= 2)
+    {
+        T y = idx.local >= s ? buffer[idx.local - s] : init;
+        __syncthreads();
+        buffer[idx.local] = op(y, buffer[idx.local]);
+        __syncthreads();
+    }
+    total    = buffer[idx.nlocal() - 1];
+    T result = idx.local == 0 ? init : buffer[idx.local - 1];
+    __syncthreads();
+    return result;
+}
+
+// The status of a tile is packed into one word so it can be published with a single atomic
+// store: the flag is in the upper half and the value in the lower half
+enum tile_flag : uint64_t
+{
+    tile_empty     = 0,
+    tile_aggregate = 1,
+    tile_prefix    = 2
+};
+
+constexpr uint64_t tile_status(tile_flag flag, index_int x) { return (uint64_t{flag} << 32) | x; }
+
+constexpr tile_flag get_tile_flag(uint64_t status) { return tile_flag(status >> 32); }
+
+constexpr index_int get_tile_value(uint64_t status) { return status & 0xffffffff; }
+
+// Number of words of state needed by exclusive_sum
+constexpr index_int state_size(index_int n, index_int tile) { return 2 + (n - 1) / tile; }
+
+// Takes the next tile from the counter in the first word of state, so tiles are started in order
+// and a tile only waits on tiles that are already running. The state must be zero before the
+// launch and have a word for the counter and one for every tile.
+template <class State>
+__device__ index_int next_tile(index idx, State state)
+{
+    __shared__ index_int tile_id;
+    if(idx.local == 0)
+        tile_id =
+            __hip_atomic_fetch_add(state.data(), 1, __ATOMIC_RELAXED, __HIP_MEMORY_SCOPE_AGENT);
+    __syncthreads();
+    index_int t = tile_id;
+    __syncthreads();
+    return t;
+}
+
+// Returns the sum of the totals of the tiles before tile t using a decoupled look-back. The tile
+// publishes its total and then adds up the totals published by the tiles before it until it finds
+// one with its full prefix.
+template <class State>
+__device__ index_int tile_exclusive_prefix(index idx, State state, index_int t, index_int total)
+{
+    uint64_t* status = state.data() + 1;
+    __shared__ index_int tile_start;
+    if(idx.local == 0)
+    {
+        index_int before = 0;
+        if(t > 0)
+        {
+            __hip_atomic_store(status + t,
+                               tile_status(tile_aggregate, total),
+                               __ATOMIC_RELEASE,
+                               __HIP_MEMORY_SCOPE_AGENT);
+            for(index_int j = t; j > 0; j--)
+            {
+                uint64_t s = 0;
+                do
+                {
+                    s = __hip_atomic_load(
+                        status + j - 1, __ATOMIC_ACQUIRE, __HIP_MEMORY_SCOPE_AGENT);
+                } while(get_tile_flag(s) == tile_empty);
+                before += get_tile_value(s);
+                if(get_tile_flag(s) == tile_prefix)
+                    break;
+            }
+        }
+        __hip_atomic_store(status + t,
+                           tile_status(tile_prefix, before + total),
+                           __ATOMIC_RELEASE,
+                           __HIP_MEMORY_SCOPE_AGENT);
+        tile_start = before;
+    }
+    __syncthreads();
+    index_int result = tile_start;
+    __syncthreads();
+    return result;
+}
+
+// Single-pass exclusive sum over the whole grid, where each workgroup scans one tile of
+// ItemsPerThread elements per thread. The state must be zero before the launch and have
+// state_size words. The input is read with input(i) and output(i, x) is called with the
+// exclusive sum x of every element i.
+template <index_int ItemsPerThread, class State, class Input, class Output>
+__device__ void exclusive_sum(index idx, State state, index_int n, Input input, Output output)
+{
+    constexpr auto tile = ItemsPerThread * idx.max_nlocal();
+    MIGRAPHX_ASSERT(state.get_shape().elements() >= state_size(n, tile));
+    const index_int t     = next_tile(idx, state);
+    const index_int start = t * tile + idx.local * ItemsPerThread;
+
+    array<index_int, ItemsPerThread> items;
+    index_int x = 0;
+    for(index_int k = 0; k < ItemsPerThread; k++)
+    {
+        items[k] = (start + k < n) ? index_int(input(start + k)) : 0;
+        x += items[k];
+    }
+    index_int total = 0;
+    auto prefix     = block_exclusive(idx, op::sum{}, index_int{0}, x, total);
+    prefix += tile_exclusive_prefix(idx, state, t, total);
+    for(index_int k = 0; k < ItemsPerThread; k++)
+    {
+        if(start + k < n)
+            output(start + k, prefix);
+        prefix += items[k];
+    }
+}
+
+// Writes every element i where pred(i) is true with write(i, j), where j is the position of the
+// element in the compacted output
+template <index_int ItemsPerThread, class State, class Predicate, class Write>
+__device__ void compact(index idx, State state, index_int n, Predicate pred, Write write)
+{
+    exclusive_sum<ItemsPerThread>(
+        idx,
+        state,
+        n,
+        [&](auto i) -> index_int { return pred(i) ? 1 : 0; },
+        [&](auto i, auto j) {
+            if(pred(i))
+                write(i, j);
+        });
+}
+
+} // namespace scan
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_SCAN_HPP
@@ -30,40 +30,62 @@
 
 namespace migraphx {
 
-// Checks and skips out of bounds indices if SkipOutOfBounds is true.
-// Otherwise does not check and underfined behavior if out of bounds.
-template <uint64_t Axis, bool SkipOutOfBounds, class T, class U, class V, class F>
-__device__ void scatter(const T& indices_t, const U& updates_t, const V& output_t, F f)
+// Calls f with the output index of the update at i. Checks and skips out of bounds indices if
+// SkipOutOfBounds is true. Otherwise does not check and underfined behavior if out of bounds.
+template <uint64_t Axis, bool SkipOutOfBounds, class T, class V, class F>
+__device__ void scatter_index(const T& indices_t, const V& output_t, index_int i, F f)
 {
-    auto gpu_index     = make_index();
     auto indices_shape = indices_t.get_shape();
     auto output_shape  = output_t.get_shape();
     auto axis_dim_size = output_shape.lens[Axis];
 
-    gpu_index.global_stride(indices_shape.elements(), [&](auto i) {
-        auto out_idx  = indices_shape.multi(i);
-        auto index    = indices_t[i];
-        index         = index < 0 ? index + axis_dim_size : index;
-        if constexpr(SkipOutOfBounds)
+    auto out_idx = indices_shape.multi(i);
+    auto index   = indices_t[i];
+    index        = index < 0 ? index + axis_dim_size : index;
+    if constexpr(SkipOutOfBounds)
+    {
+        if(index < 0)
         {
-            if(index < 0)
-            {
-                return;
-            }
+            return;
         }
-        out_idx[Axis] = index;
-        if constexpr(SkipOutOfBounds)
+    }
+    out_idx[Axis] = index;
+    if constexpr(SkipOutOfBounds)
+    {
+        if(not equal(
+               out_idx.begin(), out_idx.end(), output_shape.lens.begin(), [](auto x, auto y) {
+                   return x < y;
+               }))
         {
-            if(not equal(
-                   out_idx.begin(), out_idx.end(), output_shape.lens.begin(), [](auto x, auto y) {
-                       return x < y;
-                   }))
-            {
-                return;
-            }
+            return;
         }
-        f(output_t[out_idx], updates_t[i]);
+    }
+    f(out_idx);
+}
+
+template <uint64_t Axis, bool SkipOutOfBounds, class T, class U, class V, class F>
+__device__ void scatter(const T& indices_t, const U& updates_t, const V& output_t, F f)
+{
+    auto gpu_index = make_index();
+
+    gpu_index.global_stride(indices_t.get_shape().elements(), [&](auto i) {
+        scatter_index<Axis, SkipOutOfBounds>(
+            indices_t, output_t, i, [&](auto out_idx) { f(output_t[out_idx], updates_t[i]); });
+    });
+}
+
+// Sets the output offset of the update at i for the sorted scatter, which always skips out of
+// bounds indices
+template <uint64_t Axis, class T, class U, class V>
+__device__ bool
+scatter_offset(const T& indices_t, const U&, const V& output_t, index_int i, index_int& offset)
+{
+    bool valid = false;
+    scatter_index<Axis, true>(indices_t, output_t, i, [&](auto out_idx) {
+        offset = output_t.get_shape().index(out_idx);
+        valid  = true;
     });
+    return valid;
 }
 
 } // namespace migraphx
@@ -30,6 +30,9 @@
 
 namespace migraphx {
 
+// The call operator updates the output in place, with atomics when updates can collide, and
+// reduce combines two values for the sorted scatter which has no collisions
+
 struct assign_none
 {
     template <class T, class U>
@@ -37,6 +40,12 @@ struct assign_none
     {
         x = y;
     }
+
+    template <class T, class U>
+    static constexpr T reduce(T, U y)
+    {
+        return static_cast<T>(y);
+    }
 };
 
 struct assign_add
@@ -46,6 +55,12 @@ struct assign_add
     {
         atomic_assign(x, y, op::sum{});
     }
+
+    template <class T, class U>
+    static constexpr T reduce(T x, U y)
+    {
+        return static_cast<T>(op::sum{}(x, y));
+    }
 };
 
 struct assign_mul
@@ -55,6 +70,12 @@ struct assign_mul
     {
         atomic_assign(x, y, op::product{});
     }
+
+    template <class T, class U>
+    static constexpr T reduce(T x, U y)
+    {
+        return static_cast<T>(op::product{}(x, y));
+    }
 };
 
 struct assign_max
@@ -64,6 +85,12 @@ struct assign_max
     {
         atomic_assign(x, y, op::max{});
     }
+
+    template <class T, class U>
+    static constexpr T reduce(T x, U y)
+    {
+        return static_cast<T>(op::max{}(x, y));
+    }
 };
 
 struct assign_min
@@ -73,6 +100,12 @@ struct assign_min
     {
         atomic_assign(x, y, op::min{});
     }
+
+    template <class T, class U>
+    static constexpr T reduce(T x, U y)
+    {
+        return static_cast<T>(op::min{}(x, y));
+    }
 };
 
 } // namespace migraphx
@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_SCATTER_SORTED_HPP
+#define MIGRAPHX_GUARD_KERNELS_SCATTER_SORTED_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/algorithm.hpp>
+#include <migraphx/kernels/types.hpp>
+
+namespace migraphx {
+
+// Scatter without atomics: every update gets a key with the output offset in the upper 32 bits
+// and the update index in the lower 32 bits. Sorting the keys groups the updates to the same
+// element while keeping their original order, and each group is then reduced by one thread.
+constexpr uint64_t scatter_sorted_sentinel = ~uint64_t{0};
+
+constexpr index_int scatter_sorted_offset(uint64_t key) { return key >> 32u; }
+
+constexpr index_int scatter_sorted_update(uint64_t key) { return key & 0xffffffffu; }
+
+// Computes the keys of the n updates, where f returns false for the updates that are skipped,
+// and sorts every tile of Tile keys in LDS with a bitonic sort
+template <index_int Tile, class Keys, class F>
+__device__ void scatter_sorted_keys(Keys keys, index_int n, F f)
+{
+    auto idx = make_index();
+
+    __shared__ uint64_t tile[Tile];
+
+    idx.group_stride(keys.get_shape().elements() / Tile, [&](auto group) {
+        auto start = group * Tile;
+        idx.local_stride(Tile, [&](auto j) {
+            index_int i      = start + j;
+            index_int offset = 0;
+            if(i < n and f(i, offset))
+                tile[j] = (uint64_t{offset} << 32u) | i;
+            else
+                tile[j] = scatter_sorted_sentinel;
+        });
+        __syncthreads();
+
+        for(index_int size = 2; size <= Tile; size *= 2)
+        {
+            for(index_int stride = size / 2; stride > 0; stride /= 2)
+            {
+                idx.local_stride(Tile, [&](auto i) {
+                    index_int j = i ^ stride;
+                    if(j <= i)
+                        return;
+                    bool ascending = (i & size) == 0;
+                    if((tile[j] < tile[i]) == ascending)
+                    {
+                        auto t  = tile[i];
+                        tile[i] = tile[j];
+                        tile[j] = t;
+                    }
+                });
+                __syncthreads();
+            }
+        }
+
+        idx.local_stride(Tile, [&](auto j) { keys[start + j] = tile[j]; });
+        __syncthreads();
+    });
+}
+
+// Merges each pair of sorted runs of Width keys. Every key finds its position in the other run
+// with a binary search, and keys of the first run go before equal keys of the second run.
+template <index_int Width, class Input, class Output>
+__device__ void scatter_sorted_merge(Input input, Output output)
+{
+    auto idx = make_index();
+    idx.global_stride(input.get_shape().elements(), [&](auto i) {
+        auto key    = input[i];
+        auto run    = i / Width;
+        auto start  = (run / 2) * 2 * Width;
+        bool second = (run % 2) == 1;
+        auto first  = input.begin() + (second ? start : start + Width);
+        auto last   = first + Width;
+        auto pos    = second ? upper_bound(first, last, key, less{})
+                             : lower_bound(first, last, key, less{});
+        output[i - (second ? Width : 0) + (pos - first)] = key;
+    });
+}
+
+// Reduces the updates of every output element in their original order, starting from the value
+// that is already in the output
+template <class Keys, class Updates, class Output, class F>
+__device__ void scatter_sorted_reduce(Keys keys, Updates updates, Output output, F f)
+{
+    auto idx = make_index();
+    auto n   = updates.get_shape().elements();
+    idx.global_stride(n, [&](auto i) {
+        auto key = keys[i];
+        if(key == scatter_sorted_sentinel)
+            return;
+        auto offset = scatter_sorted_offset(key);
+        if(i > 0 and scatter_sorted_offset(keys[i - 1]) == offset)
+            return;
+        auto* out = output.data() + offset;
+        auto x    = *out;
+        for(index_int j = i; j < n and scatter_sorted_offset(keys[j]) == offset; j++)
+            x = f.reduce(x, updates[scatter_sorted_update(keys[j])]);
+        *out = x;
+    });
+}
+
+} // namespace migraphx
+#endif
@@ -30,32 +30,55 @@
 
 namespace migraphx {
 
-template <class T, class U, class V, class F>
-__device__ void scatternd(const T& indices_t, const U& updates_t, const V& output_t, F f)
+// Returns the output index of the update at i
+template <class T, class U, class V>
+__device__ auto
+scatternd_index(const T& indices_t, const U& updates_t, const V& output_t, index_int i)
 {
-    auto index         = make_index();
+    auto output_shape  = output_t.get_shape();
     auto updates_shape = updates_t.get_shape();
 
-    index.global_stride(updates_shape.elements(), [&](auto i) {
-        auto output_shape = output_t.get_shape();
+    auto indices_shape = indices_t.get_shape();
+    auto k             = indices_shape.lens.back();
+    auto q             = indices_shape.lens.size();
 
-        auto indices_shape = indices_t.get_shape();
-        auto k             = indices_shape.lens.back();
-        auto q             = indices_shape.lens.size();
+    auto updates_idx = updates_shape.multi(i);
+    auto indices_idx = indices_shape.multi(0);
+    copy(updates_idx.begin(), updates_idx.begin() + q - 1, indices_idx.begin());
 
-        auto updates_idx = updates_shape.multi(i);
-        auto indices_idx = indices_shape.multi(0);
-        copy(updates_idx.begin(), updates_idx.begin() + q - 1, indices_idx.begin());
+    auto index_start = indices_t.begin() + indices_shape.index(indices_idx);
+    auto index_end   = index_start + k;
+    auto out_idx     = output_shape.multi(0);
+    copy(index_start, index_end, out_idx.begin());
+    copy(updates_idx.begin() + q - 1, updates_idx.end(), out_idx.begin() + k);
+    return out_idx;
+}
 
-        auto index_start = indices_t.begin() + indices_shape.index(indices_idx);
-        auto index_end   = index_start + k;
-        auto out_idx     = output_shape.multi(0);
-        copy(index_start, index_end, out_idx.begin());
-        copy(updates_idx.begin() + q - 1, updates_idx.end(), out_idx.begin() + k);
+template <class T, class U, class V, class F>
+__device__ void scatternd(const T& indices_t, const U& updates_t, const V& output_t, F f)
+{
+    auto index = make_index();
 
-        f(output_t[out_idx], updates_t[i]);
+    index.global_stride(updates_t.get_shape().elements(), [&](auto i) {
+        f(output_t[scatternd_index(indices_t, updates_t, output_t, i)], updates_t[i]);
     });
 }
 
+// Sets the output offset of the update at i for the sorted scatter, which skips out of bounds
+// indices
+template <class T, class U, class V>
+__device__ bool scatternd_offset(
+    const T& indices_t, const U& updates_t, const V& output_t, index_int i, index_int& offset)
+{
+    auto out_idx     = scatternd_index(indices_t, updates_t, output_t, i);
+    const auto& lens = output_t.get_shape().lens;
+    if(not equal(out_idx.begin(), out_idx.end(), lens.begin(), [](auto x, auto y) {
+           return x < y;
+       }))
+        return false;
+    offset = output_t.get_shape().index(out_idx);
+    return true;
+}
+
 } // namespace migraphx
 #endif
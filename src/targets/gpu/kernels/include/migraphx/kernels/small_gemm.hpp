@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_SMALL_GEMM_HPP
+#define MIGRAPHX_GUARD_KERNELS_SMALL_GEMM_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/vec.hpp>
+
+namespace migraphx {
+
+// Computes output = epilogue(prologue(as...) * b, xs...), where as is a pack of the inputs of the
+// prologue and xs are the inputs of the epilogue, which are read at the index of the output. Each
+// workgroup computes TileM rows and nlocal columns of the output, staging the rows of the first
+// input through LDS in chunks of nlocal so the prologue runs once for each of its elements.
+template <index_int TileM,
+          class Prologue,
+          class Epilogue,
+          class Output,
+          class As,
+          class B,
+          class... Xs>
+__device__ void
+small_gemm(Prologue prologue, Epilogue epilogue, Output output, As as, B b, Xs... xs)
+{
+    auto idx             = make_index();
+    constexpr auto lens  = get_shape_c<Output>{}.lens;
+    constexpr auto rank  = lens.size();
+    constexpr auto m     = lens[rank - 2];
+    constexpr auto n     = lens[rank - 1];
+    constexpr auto k     = get_shape_c<B>{}.lens[rank - 2];
+    constexpr auto nrows = (m + TileM - 1) / TileM;
+    constexpr auto ncols = (n + idx.max_nlocal() - 1) / idx.max_nlocal();
+    constexpr auto batch = get_shape_c<Output>{}.elements() / (m * n);
+
+    auto a = [&](auto i) { return as([&](auto... ys) { return prologue(ys[i]...); }); };
+
+    __shared__ float tile[TileM][idx.max_nlocal()];
+    idx.group_stride(batch * nrows * ncols, [&](auto g) {
+        const auto row = output.get_shape().multi((g / (nrows * ncols)) * m * n);
+        auto at        = [&](index_int i, index_int j) {
+            auto result      = row;
+            result[rank - 2] = i;
+            result[rank - 1] = j;
+            return result;
+        };
+        const index_int m0 = ((g / ncols) % nrows) * TileM;
+        const index_int j  = (g % ncols) * idx.nlocal() + idx.local;
+
+        float acc[TileM] = {0};
+        for(index_int k0 = 0; k0 < k; k0 += idx.nlocal())
+        {
+            idx.local_stride(TileM * idx.nlocal(), [&](auto i) {
+                auto r  = i / idx.nlocal();
+                auto kk = k0 + i % idx.nlocal();
+                tile[r][i % idx.nlocal()] =
+                    (m0 + r < m and kk < k) ? migraphx::convert<float>(a(at(m0 + r, kk))) : 0.0f;
+            });
+            __syncthreads();
+            if(j < n)
+            {
+                for(index_int kk = 0; kk < idx.nlocal() and k0 + kk < k; kk++)
+                {
+                    auto x = migraphx::convert<float>(b[at(k0 + kk, j)]);
+                    for(index_int r = 0; r < TileM; r++)
+                        acc[r] += tile[r][kk] * x;
+                }
+            }
+            __syncthreads();
+        }
+        if(j >= n)
+            return;
+        using type = typename B::type;
+        for(index_int r = 0; r < TileM and m0 + r < m; r++)
+        {
+            auto i    = at(m0 + r, j);
+            output[i] = implicit_conversion(epilogue(migraphx::convert<type>(acc[r]), xs[i]...));
+        }
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_SMALL_GEMM_HPP
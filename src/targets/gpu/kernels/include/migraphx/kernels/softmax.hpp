@@ -26,24 +26,79 @@
 
 #include <migraphx/kernels/reduce.hpp>
 #include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/array.hpp>
 
 namespace migraphx {
 
-template <index_int Axis, class Input, class Output>
-__device__ void softmax(Input input1, Output output)
+// Combines two partial sums of exponentials that were each computed relative to their own max
+struct online_max_sum
+{
+    template <class T>
+    MIGRAPHX_DEVICE_CONSTEXPR array<T, 2> operator()(array<T, 2> x, array<T, 2> y) const
+    {
+        // An empty partial sum is skipped so its max doesn't shift the other one
+        if(x[1] == 0)
+            return y;
+        if(y[1] == 0)
+            return x;
+        auto m = max(x[0], y[0]);
+        return {m, x[1] * migraphx::exp(x[0] - m) + y[1] * migraphx::exp(y[0] - m)};
+    }
+};
+
+template <class T>
+constexpr auto online_max_sum_read(T x)
+{
+    auto xf = migraphx::convert<float>(x);
+    auto m  = vec_reduce(xf, op::max{});
+    return make_array(m, vec_reduce(migraphx::exp(xf - m), op::sum{}));
+}
+
+template <class Block>
+constexpr bool use_online_softmax()
+{
+#if defined(MIGRAPHX_USE_ONLINE_SOFTMAX)
+    return true;
+#elif defined(MIGRAPHX_USE_FAST_SOFTMAX)
+    return false;
+#else
+    // When the row doesn't fit in registers every pass reads it again from global memory, so the
+    // max and the sum are computed together
+    return is_same<Block, reduce::block_large>{};
+#endif
+}
+
+template <index_int Axis, class F, class Output, class Input, class... Inputs>
+__device__ void softmax(F compute, Output output, Input input1, Inputs... inputs)
 {
     using block = reduce::auto_block<reduce::reduce_elements_with_axis<Input, Axis>()>;
     block::template run<reduce::with_axis<Input, Axis>>([&](auto, auto r) {
-        auto x = r.inner(op::id{})(input1);
+        using value_type = vec_type<typename Input::type>;
+        auto x           = r.inner(op::id{})(input1);
+        if constexpr(use_online_softmax<block>())
+        {
+            auto ms = r.reduce(online_max_sum{},
+                               make_array<float>(lowest{}, 0),
+                               [](auto x1) { return online_max_sum_read(x1); })(x);
+            r.inner([&](auto& y, auto x1, auto... xs) {
+                auto e = migraphx::exp(migraphx::convert<float>(x1) - ms[0]) / ms[1];
+                y      = compute(migraphx::convert<value_type>(e), xs...);
+            })(output, x, inputs...);
+        }
+        else
+        {
 #ifdef MIGRAPHX_USE_FAST_SOFTMAX
-        const auto c = vec_at(r.slice(input1)[0], 0);
+            const auto c = vec_at(r.slice(input1)[0], 0);
 #else
-        const auto c = r.reduce(op::max{}, lowest{}, op::id{})(x);
+            const auto c = r.reduce(op::max{}, lowest{}, op::id{})(x);
 #endif
-        r.inner([&](auto& x1) { x1 = migraphx::exp(x1 - c); })(x);
-        auto batch_sum =
-            r.reduce(op::sum{}, 0, [](auto x1) { return migraphx::convert<float>(x1); })(x);
-        r.inner([&](auto& y, auto x1) { y = implicit_conversion(x1 / batch_sum); })(output, x);
+            auto e = r.inner([&](auto x1) { return migraphx::exp(x1 - c); })(x);
+            auto batch_sum =
+                r.reduce(op::sum{}, 0, [](auto x1) { return migraphx::convert<float>(x1); })(e);
+            r.inner([&](auto& y, auto x1, auto... xs) {
+                y = compute(migraphx::convert<value_type>(x1 / batch_sum), xs...);
+            })(output, e, inputs...);
+        }
     });
 }
 
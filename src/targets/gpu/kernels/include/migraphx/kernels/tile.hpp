@@ -34,60 +34,73 @@ namespace migraphx {
 
 struct tile
 {
-    template <class Shape>
-    static constexpr auto pad_shape(Shape)
+    // The tile is stored in the order it is read by the kernel, with each row padded by Pad
+    // elements to avoid memory bank conflicts while transposing. Padding by the vector size keeps
+    // the rows aligned so the kernel can still read them with vector loads.
+    template <class Shape, class Pad>
+    static constexpr auto pad_shape(Shape, Pad)
     {
         constexpr Shape s{};
-        constexpr auto axis    = s.strides.size() - _c<1>;
-        constexpr auto strides = transform_i(s.strides, [](auto stride, auto i) {
+        constexpr auto axis = s.lens.size() - _c<1>;
+        constexpr auto lens = transform_i(s.lens, [](auto len, auto i) {
             if constexpr(i == decltype(axis){})
             {
-                // Pad by 1 element extra to avoid memory bank conflicts
-                return stride + 1;
+                return len + Pad::value;
             }
             else
             {
-                return stride;
+                return len;
             }
         });
-        return make_shape(s.lens, strides);
+        return make_shape(s.lens, make_shape(lens).strides);
     }
+
+    // Copy in the order of the tensor in global memory so those accesses are coalesced
+    template <class Global, class T, class U>
+    static __device__ void transpose_copy(index idx, T src, U dst)
+    {
+        constexpr auto perm = find_permutation(get_shape_c<Global>{});
+        auto new_src        = reorder_tensor_view(src, perm);
+        auto new_dst        = reorder_tensor_view(dst, perm);
+        idx.local_stride(new_src.get_shape().elements(), [&](auto i) { new_dst[i] = new_src[i]; });
+    }
+
     struct load
     {
-        template <class T>
-        static __device__ auto copy(index idx, T x)
+        template <class T, class Pad>
+        static __device__ auto copy(index idx, T x, Pad)
         {
             return [=](auto f) {
                 using type          = typename T::type;
-                constexpr auto s    = pad_shape(make_packed_shape(get_shape_c<T>{}));
+                constexpr auto s    = pad_shape(get_shape_c<T>{}, Pad{});
                 constexpr auto size = s.element_space();
-                __shared__ type buffer[size];
+                __shared__ __attribute__((aligned(sizeof(type) * Pad::value))) type buffer[size];
                 auto b = make_tensor_view(buffer, s);
-                local_tensor_copy(idx, x, b);
+                transpose_copy<T>(idx, x, b);
                 f(b);
             };
         }
     };
     struct store
     {
-        template <class T>
-        static __device__ auto copy(index idx, T x)
+        template <class T, class Pad>
+        static __device__ auto copy(index idx, T x, Pad)
         {
             return [=](auto f) {
                 using type          = typename T::type;
-                constexpr auto s    = pad_shape(make_packed_shape(get_shape_c<T>{}));
+                constexpr auto s    = pad_shape(get_shape_c<T>{}, Pad{});
                 constexpr auto size = s.element_space();
-                __shared__ type buffer[size];
+                __shared__ __attribute__((aligned(sizeof(type) * Pad::value))) type buffer[size];
                 auto b = make_tensor_view(buffer, s);
                 f(b);
-                local_tensor_copy(idx, b, x);
+                transpose_copy<T>(idx, b, x);
             };
         }
     };
     struct none
     {
-        template <class T>
-        static __device__ auto copy(index, T x)
+        template <class T, class Pad>
+        static __device__ auto copy(index, T x, Pad)
         {
             return [=](auto f) { f(x); };
         }
@@ -119,8 +132,8 @@ struct tile
         });
     }
 
-    template <class... Modes>
-    static __device__ auto auto_copy(index idx)
+    template <class... Modes, class Pad>
+    static __device__ auto auto_copy(index idx, Pad pad)
     {
         return make_transform([=](auto f, auto... xs) {
             static_assert(sizeof...(Modes) == sizeof...(xs));
@@ -131,7 +144,7 @@ struct tile
                 if constexpr((is_same<Modes, store>{} or ...))
                     __syncthreads();
             };
-            join(invoke, Modes::copy(idx, xs)...);
+            join(invoke, Modes::copy(idx, xs, pad)...);
         });
     }
 };
@@ -149,8 +162,8 @@ __device__ auto tile_stride(index idx)
     }
 }
 
-template <class... Modes, class InnerLens, class OuterLens>
-__device__ auto auto_tile(InnerLens, OuterLens)
+template <class... Modes, class InnerLens, class OuterLens, class Pad = index_constant<1>>
+__device__ auto auto_tile(InnerLens, OuterLens, Pad pad = {})
 {
     if constexpr((is_same<Modes, tile::none>{} and ...))
     {
@@ -160,7 +173,7 @@ __device__ auto auto_tile(InnerLens, OuterLens)
     {
         auto idx = make_index();
         return transform_args(tile::auto_slice<InnerLens, OuterLens>(idx),
-                              tile::auto_copy<Modes...>(idx));
+                              tile::auto_copy<Modes...>(idx, pad));
     }
 }
 
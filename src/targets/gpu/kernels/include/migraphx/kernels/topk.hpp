@@ -0,0 +1,247 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_TOPK_HPP
+#define MIGRAPHX_GUARD_KERNELS_TOPK_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/bit_cast.hpp>
+#include <migraphx/kernels/reduce.hpp>
+#include <migraphx/kernels/type_traits.hpp>
+
+namespace migraphx {
+
+// Maps a value to an unsigned key where a smaller key comes first in the output
+template <bool Largest, class T>
+constexpr uint64_t topk_value_key(T x)
+{
+    using bits_type = conditional_t<
+        sizeof(T) == 1,
+        uint8_t,
+        conditional_t<sizeof(T) == 2, uint16_t, conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+    constexpr uint64_t sign = uint64_t{1} << (sizeof(T) * 8 - 1);
+    constexpr uint64_t mask = sign | (sign - 1);
+    uint64_t u              = bit_cast<bits_type>(x);
+    if constexpr(is_integral<T>{} and is_unsigned<T>{})
+    {
+        // Already ordered
+    }
+    else if constexpr(is_integral<T>{})
+    {
+        u ^= sign;
+    }
+    else
+    {
+        // Floating point types are sign-magnitude, so negative values are flipped
+        u = (u & sign) != 0 ? (~u & mask) : (u | sign);
+    }
+    if constexpr(Largest)
+        u = ~u & mask;
+    return u;
+}
+
+// The value key followed by the index, so every element of a row has a unique key and equal
+// values are ordered by their index
+struct topk_key
+{
+    uint64_t value;
+    uint32_t index;
+
+    friend constexpr bool operator<(const topk_key& x, const topk_key& y)
+    {
+        if(x.value != y.value)
+            return x.value < y.value;
+        return x.index < y.index;
+    }
+};
+
+// The bits of the k-th key that have been selected so far by the radix select
+struct topk_prefix
+{
+    topk_key key;
+    topk_key mask;
+    index_int remaining;
+    bool done;
+
+    constexpr bool match(const topk_key& x) const
+    {
+        return (x.value & mask.value) == key.value and (x.index & mask.index) == key.index;
+    }
+
+    constexpr bool selected(const topk_key& x) const
+    {
+        topk_key masked{x.value & mask.value, x.index & mask.index};
+        return not(key < masked);
+    }
+};
+
+template <index_int ValueBits>
+constexpr index_int topk_digit(const topk_key& x, index_int pass)
+{
+    constexpr index_int bits = ValueBits + 32;
+    const index_int pos      = bits - 8 * (pass + 1);
+    if(pos >= 32)
+        return (x.value >> (pos - 32)) & 0xff;
+    return (x.index >> pos) & 0xff;
+}
+
+template <index_int ValueBits>
+constexpr void topk_set_digit(topk_prefix& p, index_int pass, index_int digit)
+{
+    constexpr index_int bits = ValueBits + 32;
+    const index_int pos      = bits - 8 * (pass + 1);
+    if(pos >= 32)
+    {
+        p.key.value |= uint64_t{digit} << (pos - 32);
+        p.mask.value |= uint64_t{0xff} << (pos - 32);
+    }
+    else
+    {
+        p.key.index |= uint32_t(digit) << pos;
+        p.mask.index |= uint32_t{0xff} << pos;
+    }
+}
+
+constexpr index_int topk_pad(index_int k)
+{
+    index_int n = 1;
+    while(n < k)
+        n *= 2;
+    return n;
+}
+
+// Selects the K smallest of the N keys returned by key(j) with one workgroup, and calls
+// output(j, i) with the index i of the j-th key. The k-th key is found with a radix select over
+// 8 bits at a time, so each pass reads the keys once and builds a histogram in LDS, and the
+// selected keys are then sorted with a bitonic sort in LDS.
+template <index_int ValueBits, index_int N, index_int K, class Key, class Output>
+__device__ void topk_select(index idx, Key key, Output output)
+{
+    constexpr index_int passes = (ValueBits + 32) / 8;
+    constexpr index_int npad   = topk_pad(K);
+    static_assert(K <= N, "K is larger than the number of keys");
+
+    __shared__ index_int histogram[256];
+    __shared__ topk_prefix prefix;
+    __shared__ index_int nselected;
+    __shared__ topk_key selected[npad];
+
+    if(idx.local == 0)
+    {
+        prefix    = {{0, 0}, {0, 0}, K, false};
+        nselected = 0;
+    }
+    for(index_int pass = 0; pass < passes; pass++)
+    {
+        idx.local_stride(256, [&](auto i) { histogram[i] = 0; });
+        __syncthreads();
+        if(prefix.done)
+            break;
+        idx.local_stride(N, [&](auto j) {
+            auto x = key(j);
+            if(prefix.match(x))
+                atomicAdd(&histogram[topk_digit<ValueBits>(x, pass)], index_int{1});
+        });
+        __syncthreads();
+        if(idx.local == 0)
+        {
+            // Find the bucket that holds the k-th key
+            index_int before = 0;
+            index_int digit  = 0;
+            while(before + histogram[digit] < prefix.remaining)
+            {
+                before += histogram[digit];
+                digit++;
+            }
+            topk_set_digit<ValueBits>(prefix, pass, digit);
+            prefix.remaining -= before;
+            // Every key left in the bucket is selected
+            prefix.done = histogram[digit] == prefix.remaining;
+        }
+        __syncthreads();
+    }
+
+    idx.local_stride(N, [&](auto j) {
+        auto x = key(j);
+        if(prefix.selected(x))
+            selected[atomicAdd(&nselected, index_int{1})] = x;
+    });
+    idx.local_stride(npad - K, [&](auto i) { selected[K + i] = {~uint64_t{0}, ~uint32_t{0}}; });
+    __syncthreads();
+
+    // Bitonic sort of the selected keys
+    for(index_int size = 2; size <= npad; size *= 2)
+    {
+        for(index_int stride = size / 2; stride > 0; stride /= 2)
+        {
+            idx.local_stride(npad, [&](auto i) {
+                index_int j = i ^ stride;
+                if(j <= i)
+                    return;
+                bool ascending = (i & size) == 0;
+                if((selected[j] < selected[i]) == ascending)
+                {
+                    auto t      = selected[i];
+                    selected[i] = selected[j];
+                    selected[j] = t;
+                }
+            });
+            __syncthreads();
+        }
+    }
+
+    idx.local_stride(K, [&](auto j) { output(j, selected[j].index); });
+    __syncthreads();
+}
+
+// Computes the k smallest keys of every row along Axis, one workgroup per row
+template <index_int Axis, index_int K, bool Largest, class Input, class Values, class Indices>
+__device__ void topk(Input input, Values values, Indices indices)
+{
+    using type                     = typename Input::type;
+    using row_shape                = reduce::with_axis<Input, Axis>;
+    constexpr index_int n          = get_shape_c<Input>{}.lens[Axis];
+    constexpr index_int value_bits = sizeof(type) * 8;
+
+    auto idx = make_index();
+    idx.group_stride(get_shape_c<row_shape>{}.elements(), [&](auto group) {
+        auto row = get_shape_c<row_shape>{}.multi(group);
+        auto at  = [&](index_int j) {
+            auto i  = row;
+            i[Axis] = j;
+            return i;
+        };
+        topk_select<value_bits, n, K>(
+            idx,
+            [&](index_int j) -> topk_key {
+                return {topk_value_key<Largest>(input[at(j)]), uint32_t(j)};
+            },
+            [&](index_int j, index_int i) {
+                values[at(j)]  = input[at(i)];
+                indices[at(j)] = i;
+            });
+    });
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_TOPK_HPP
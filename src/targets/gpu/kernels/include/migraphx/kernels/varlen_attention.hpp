@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_KERNELS_VARLEN_ATTENTION_HPP
+#define MIGRAPHX_GUARD_KERNELS_VARLEN_ATTENTION_HPP
+
+#include <migraphx/kernels/index.hpp>
+#include <migraphx/kernels/reduce.hpp>
+#include <migraphx/kernels/ops.hpp>
+#include <migraphx/kernels/math.hpp>
+#include <migraphx/kernels/tensor_view.hpp>
+
+namespace migraphx {
+
+// Index of the first offset past token t, so the token is in the sequence just before it. This
+// is 0 or the number of offsets when t is not in any sequence.
+template <class CuSeqlens>
+__device__ index_int find_sequence(CuSeqlens cu_seqlens, index_int t)
+{
+    constexpr index_int noffsets = get_shape_c<CuSeqlens>{}.elements();
+    index_int lo                 = 0;
+    index_int hi                 = noffsets;
+    while(lo < hi)
+    {
+        auto mid = (lo + hi) / 2;
+        if(static_cast<int64_t>(cu_seqlens[mid]) > static_cast<int64_t>(t))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
+}
+
+// One workgroup computes one (token, head) row of the output. The keys of the token's sequence
+// are processed in tiles of nlocal with an online softmax, so no padding or scores are stored.
+template <class Query, class Key, class Value, class CuSeqlens, class Output>
+__device__ void varlen_attention(Query query,
+                                 Key key,
+                                 Value value,
+                                 CuSeqlens cu_seqlens,
+                                 Output output,
+                                 float scale,
+                                 bool causal)
+{
+    auto idx                 = make_index();
+    constexpr auto qlens     = get_shape_c<Query>{}.lens;
+    constexpr auto tokens    = qlens[0];
+    constexpr auto heads     = qlens[1];
+    constexpr auto head_dim  = qlens[2];
+    constexpr auto kv_heads  = get_shape_c<Key>{}.lens[1];
+    constexpr auto group     = heads / kv_heads;
+    constexpr index_int nseq = get_shape_c<CuSeqlens>{}.elements();
+    MIGRAPHX_ASSERT(idx.nlocal() >= head_dim);
+
+    auto h    = idx.group % heads;
+    auto t    = idx.group / heads;
+    auto kvh  = h / group;
+    auto qoff = idx.group * head_dim;
+
+    __shared__ float q[head_dim];
+    __shared__ float p[idx.max_nlocal()];
+    idx.local_stride(head_dim, [&](auto d) { q[d] = migraphx::convert<float>(query[qoff + d]); });
+    __syncthreads();
+
+    index_int start = 0;
+    index_int end   = 0;
+    auto s          = find_sequence(cu_seqlens, t);
+    if(s > 0 and s < nseq)
+    {
+        start = max(static_cast<int64_t>(cu_seqlens[s - 1]), int64_t{0});
+        end   = causal ? t + 1 : min(static_cast<index_int>(cu_seqlens[s]), tokens);
+    }
+
+    float m   = lowest{};
+    float l   = 0;
+    float acc = 0;
+    for(index_int first = start; first < end; first += idx.nlocal())
+    {
+        auto j      = first + idx.local;
+        float score = lowest{};
+        if(j < end)
+        {
+            auto koff = (j * kv_heads + kvh) * head_dim;
+            float dot = 0;
+            for(index_int d = 0; d < head_dim; d++)
+                dot += q[d] * migraphx::convert<float>(key[koff + d]);
+            score = dot * scale;
+        }
+        auto tile_max = block_reduce(
+            idx, op::max{}, float(lowest{}), idx.nlocal(), [&](auto) { return score; });
+        auto new_m   = max(m, tile_max);
+        float pj     = (score == float(lowest{})) ? 0.0f : migraphx::exp(score - new_m);
+        p[idx.local] = pj;
+        __syncthreads();
+        auto tile_sum = block_reduce(idx, op::sum{}, 0.0f, idx.nlocal(), [&](auto) { return pj; });
+        float correction = (m == float(lowest{})) ? 0.0f : migraphx::exp(m - new_m);
+        l                = l * correction + tile_sum;
+        if(idx.local < head_dim)
+        {
+            acc *= correction;
+            for(index_int jj = 0; jj < idx.nlocal() and first + jj < end; jj++)
+            {
+                auto voff = ((first + jj) * kv_heads + kvh) * head_dim;
+                acc += p[jj] * migraphx::convert<float>(value[voff + idx.local]);
+            }
+        }
+        m = new_m;
+        __syncthreads();
+    }
+    using type = typename Output::type;
+    if(idx.local < head_dim)
+        output[qoff + idx.local] = migraphx::convert<type>(l > 0 ? acc / l : 0.0f);
+}
+
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_KERNELS_VARLEN_ATTENTION_HPP
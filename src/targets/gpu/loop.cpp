@@ -25,7 +25,7 @@
 #include <migraphx/run_loop.hpp>
 #include <migraphx/gpu/loop.hpp>
 #include <migraphx/gpu/context.hpp>
-#include <migraphx/gpu/device/fill.hpp>
+#include <migraphx/gpu/hip.hpp>
 #include <unordered_map>
 
 namespace migraphx {
@@ -50,11 +50,12 @@ struct gpu_loop
         copy_from_gpu(ctx, src, arg_dst);
     }
 
+    // The iteration number and condition are written with a memset, which doesn't wait on a
+    // copy from pageable host memory
     template <class T>
     void copy(context& ctx, T src, const argument& dst) const
     {
-        argument arg_src{dst.get_shape(), &src};
-        copy_to_gpu(ctx, arg_src, dst);
+        gpu_fill(ctx, dst, static_cast<double>(src));
     }
 
     void append(const std::vector<argument>&,
@@ -79,7 +80,7 @@ struct gpu_loop
             lens[0]   = elem_num;
             shape ss{s.type(), lens};
             assert(ss.bytes() + iter * size <= out.get_shape().bytes());
-            device::fill(ctx.get_stream().get(), argument(ss, out.data() + iter * size), 0);
+            gpu_fill(ctx, argument(ss, out.data() + iter * size));
         }
     }
 
@@ -40,6 +40,7 @@
 #include <migraphx/op/reshape.hpp>
 #include <migraphx/op/quant_dot.hpp>
 #include <migraphx/op/reshape_lazy.hpp>
+#include <migraphx/op/select_module.hpp>
 
 #include <migraphx/gpu/context.hpp>
 #include <migraphx/gpu/lowering.hpp>
@@ -56,7 +57,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_HIPBLASLT_GEMM);
-MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_MIOPEN_POOLING)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_MIOPEN_POOLING)
 
 struct miopen_apply
 {
@@ -91,19 +92,10 @@ struct miopen_apply
 #endif
         offload_copy = (mod == mpm->get_root_module()) ? pass->offload_copy : false;
 
-        add_extend_op("argmax");
-        add_extend_op("argmin");
-        add_extend_op("logsoftmax");
-        add_extend_op("multinomial");
-        add_extend_op("nonzero");
         add_extend_op("prefix_scan_sum");
-        add_extend_op("reverse");
-        add_extend_op("rnn_var_sl_last_output");
-        add_extend_op("rnn_var_sl_shift_output");
-        add_extend_op("rnn_var_sl_shift_sequence");
-        add_extend_op("topk");
         add_generic_op("contiguous");
         add_pooling_op();
+        add_topk_op();
 #if MIGRAPHX_USE_MIOPEN
         add_convolution_op("convolution");
         add_convolution_op("convolution_backwards");
@@ -121,6 +113,8 @@ struct miopen_apply
         add_lrn_op();
         add_convolution_backwards_op();
         add_select_module_op();
+        add_dimensions_of_op();
+        add_random_seed_op();
         add_reshape_lazy_op();
         add_scan_slice_op();
     }
@@ -243,6 +237,21 @@ struct miopen_apply
         return mod->insert_instruction(ins, make_op("allocate", {{"shape", to_value(s)}}));
     }
 
+#if MIGRAPHX_USE_HIPBLASLT
+    // rocBLAS has no OCP fp8 gemms, so those always go to hipBLASLt when it is available
+    static bool use_hipblaslt(instruction_ref ins)
+    {
+        if(not hipblaslt_supported())
+            return false;
+        if(enabled(MIGRAPHX_ENABLE_HIPBLASLT_GEMM{}))
+            return true;
+        return std::any_of(ins->inputs().begin(), ins->inputs().end(), [](instruction_ref input) {
+            return contains({shape::fp8e4m3fn_type, shape::fp8e5m2_type},
+                            input->get_shape().type());
+        });
+    }
+#endif
+
 #if MIGRAPHX_USE_ROCBLAS or MIGRAPHX_USE_HIPBLASLT
     template <typename Op>
     void add_gemm_op(const std::string& name)
@@ -251,7 +260,8 @@ struct miopen_apply
             std::vector<instruction_ref> refs = ins->inputs();
             assert(refs.size() == 2);
 #if MIGRAPHX_USE_HIPBLASLT
-            if(enabled(MIGRAPHX_ENABLE_HIPBLASLT_GEMM{}))
+            const bool hipblaslt = use_hipblaslt(ins);
+            if(hipblaslt)
             {
                 shape workspace_shape{shape::uint8_type, {hipblaslt_workspace_size}};
                 auto workspace = insert_allocation(ins, workspace_shape);
@@ -259,15 +269,22 @@ struct miopen_apply
             }
 #endif
             auto output = insert_allocation(ins, ins->get_shape());
-            refs.push_back(output);
 #if MIGRAPHX_USE_HIPBLASLT
-            if(not enabled(MIGRAPHX_ENABLE_HIPBLASLT_GEMM{}) or not hipblaslt_supported())
+            if(not hipblaslt)
             {
 #endif
+                auto gemm_shapes = to_shapes(refs);
+                gemm_shapes.push_back(output->get_shape());
+                shape workspace_shape{
+                    shape::uint8_type,
+                    {gemm_workspace_size(get_context(), gemm_shapes, compute_fp32)}};
+                refs.push_back(insert_allocation(ins, workspace_shape));
+                refs.push_back(output);
                 return mod->replace_instruction(
                     ins, rocblas_gemm<Op>{Op{}, 1, 0, compute_fp32}, refs);
 #if MIGRAPHX_USE_HIPBLASLT
             }
+            refs.push_back(output);
             return mod->replace_instruction(ins, hip_gemm<Op>{Op{}, 1, 0}, refs);
 #endif
         });
@@ -321,7 +338,9 @@ struct miopen_apply
 
     static bool use_miopen_pooling(instruction_ref ins)
     {
-        if(enabled(MIGRAPHX_DISABLE_MIOPEN_POOLING{}))
+        if(not enabled(MIGRAPHX_ENABLE_MIOPEN_POOLING{}))
+            return false;
+        if(not contains({shape::float_type, shape::half_type}, ins->get_shape().type()))
             return false;
         auto&& op   = ins->get_operator();
         auto op_val = op.to_value();
@@ -330,6 +349,9 @@ struct miopen_apply
             return false;
         if(mode == op::pooling_mode::lpnorm)
             return false;
+        auto dilations = op_val.at("dilations").to_vector<size_t>();
+        if(std::any_of(dilations.begin(), dilations.end(), [](auto d) { return d != 1; }))
+            return false;
         auto op_padding = op_val.at("padding").to_vector<size_t>();
         auto kdims      = ins->get_shape().lens().size() - 2;
         return std::equal(op_padding.begin(),
@@ -355,6 +377,20 @@ struct miopen_apply
         });
     }
 
+    // The jit topk keeps the selected keys in LDS, so only small k is sent to it
+    void add_topk_op()
+    {
+        apply_map.emplace("topk", [=](instruction_ref ins) {
+            auto&& op = ins->get_operator();
+            if(op.to_value().at("k").to<std::size_t>() <= 1024)
+                return insert_precompile_op(ins);
+            auto output                       = insert_allocation(ins, ins->get_shape());
+            std::vector<instruction_ref> refs = ins->inputs();
+            refs.push_back(output);
+            return mod->replace_instruction(ins, make_op("gpu::topk", op.to_value()), refs);
+        });
+    }
+
     // use 0 - input to represent neg
     void add_neg_op()
     {
@@ -420,6 +456,10 @@ struct miopen_apply
     void add_nms_op()
     {
         apply_map.emplace("nonmaxsuppression", [=](instruction_ref ins) {
+            // The jit kernel needs a static output and scores that fit in its 32-bit sort key
+            if(not ins->get_shape().dynamic() and
+               ins->inputs().at(1)->get_shape().type_size() <= 4)
+                return insert_precompile_op(ins);
             auto s      = ins->get_shape();
             auto output = insert_allocation(ins, s);
             std::vector<instruction_ref> cpu_inputs;
@@ -478,7 +518,69 @@ struct miopen_apply
     }
 
     /**
-     * Adds dynamic allocation for submodule output parameter.
+     * Checks if the submodules only cover some of the sizes of the dynamic dimension, so the
+     * inputs may need to be padded up to a larger submodule. The padding copies only pad one axis
+     * of each input, so bucketing is only supported when every dynamic input has a single dynamic
+     * dimension.
+     */
+    static bool is_bucketed(instruction_ref ins)
+    {
+        std::size_t sizes = 1;
+        bool single_dim   = true;
+        for(auto input : ins->inputs())
+        {
+            if(not input->get_shape().dynamic())
+                continue;
+            std::size_t n       = 0;
+            std::size_t product = 1;
+            for(const auto& dd : input->get_shape().dyn_dims())
+            {
+                if(dd.is_fixed())
+                    continue;
+                product *= dd.max - dd.min + 1;
+                n++;
+            }
+            sizes      = std::max(sizes, product);
+            single_dim = single_dim and n <= 1;
+        }
+        if(ins->module_inputs().size() >= sizes)
+            return false;
+        if(not single_dim)
+            MIGRAPHX_THROW("select_module: submodules can only be bucketed along a single dynamic "
+                           "dimension of each input");
+        return true;
+    }
+
+    /**
+     * Returns the axis of the dynamic dimension and the sizes of it the submodules cover.
+     */
+    static std::pair<std::size_t, std::vector<std::size_t>> bucket_sizes(instruction_ref ins,
+                                                                         const shape& s)
+    {
+        const auto& dds = s.dyn_dims();
+        std::size_t axis =
+            std::find_if(dds.begin(), dds.end(), [](const auto& dd) { return not dd.is_fixed(); }) -
+            dds.begin();
+        std::vector<std::size_t> sizes;
+        for(auto* submod : ins->module_inputs())
+        {
+            for(const auto& ps : submod->get_parameter_shapes())
+            {
+                if(ps.second.ndim() == dds.size() and ps.second.type() == s.type())
+                    sizes.push_back(ps.second.lens().at(axis));
+            }
+        }
+        std::sort(sizes.begin(), sizes.end());
+        sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+        return {axis, sizes};
+    }
+
+    /**
+     * Adds dynamic allocation for submodule output parameter. When the submodules are bucketed,
+     * the dynamic inputs are also copied into allocations sized for the largest submodule, laid
+     * out for the bucket they are padded to. The submodule for each size of the dynamic
+     * dimension is looked up in a table built here, rather than found by matching the parameter
+     * shapes on each run.
      */
     void add_select_module_op()
     {
@@ -486,8 +588,54 @@ struct miopen_apply
             auto s                              = ins->get_shape();
             auto output                         = insert_allocation(ins, s);
             std::vector<instruction_ref> inputs = ins->inputs();
+            auto sm                             = any_cast<op::select_module>(ins->get_operator());
+            sm.make_dispatch_table(to_shapes(inputs), ins->module_inputs());
+            if(is_bucketed(ins))
+            {
+                for(auto& input : inputs)
+                {
+                    if(not input->get_shape().dynamic())
+                        continue;
+                    auto [axis, sizes] = bucket_sizes(ins, input->get_shape());
+                    auto buffer        = insert_allocation(ins, input->get_shape());
+                    input              = mod->insert_instruction(
+                        ins,
+                        make_op("hip::pad_copy", {{"axis", axis}, {"sizes", sizes}}),
+                        input,
+                        buffer);
+                }
+                sm.inputs_padded = true;
+            }
             inputs.push_back(output);
-            return mod->replace_instruction(ins, ins->get_operator(), inputs, ins->module_inputs());
+            return mod->replace_instruction(ins, sm, inputs, ins->module_inputs());
+        });
+    }
+
+    /**
+     * The size of the dynamic dimension is read from the shape on the host, then copied to the
+     * gpu for the submodules that use it.
+     */
+    void add_dimensions_of_op()
+    {
+        apply_map.emplace("dimensions_of", [=](instruction_ref ins) {
+            auto output = insert_allocation(ins, ins->get_shape());
+            auto cpu_out =
+                mod->insert_instruction(ins, ins->get_operator(), ins->inputs().front());
+            return mod->replace_instruction(ins, make_op("hip::copy_to_gpu"), cpu_out, output);
+        });
+    }
+
+    // Integer seeds are drawn from the context directly on the device, other types are
+    // computed on the host
+    void add_random_seed_op()
+    {
+        apply_map.emplace("random_seed", [=](instruction_ref ins) {
+            auto s      = ins->get_shape();
+            auto output = insert_allocation(ins, s);
+            if(s.type_size() <= 8 and s.type_size() % 4 == 0 and shape::is_integral(s.type()))
+                return mod->replace_instruction(ins, make_op("hip::random_seed"), output);
+            auto cpu_out = mod->insert_instruction(ins, ins->get_operator());
+            return mod->replace_instruction(ins, make_op("hip::copy_to_gpu"), cpu_out, output);
         });
     }
 
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <migraphx/shape.hpp>
 #include <migraphx/algorithm.hpp>
+#include <migraphx/compile_profile.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/dead_code_elimination.hpp>
@@ -195,21 +196,20 @@ std::string mlir_print(F f, T x)
 struct mlir_logger
 {
     std::stringstream ss;
-    mlir_context* ctx;
+    MlirContext ctx{};
     std::optional<MlirDiagnosticHandlerID> id;
 
-    mlir_logger() : ctx(nullptr), id(std::nullopt) {}
+    mlir_logger() : id(std::nullopt) {}
 
-    mlir_logger(mlir_context* context) : ctx(context)
+    mlir_logger(MlirContext context) : ctx(context)
     {
-        id =
-            mlirContextAttachDiagnosticHandler(ctx->get(), mlir_diagnostic_print_cb, this, nullptr);
+        id = mlirContextAttachDiagnosticHandler(ctx, mlir_diagnostic_print_cb, this, nullptr);
     }
 
     ~mlir_logger()
     {
         if(id.has_value())
-            mlirContextDetachDiagnosticHandler(ctx->get(), *id);
+            mlirContextDetachDiagnosticHandler(ctx, *id);
     }
 
     mlir_logger(const mlir_logger& other)            = delete;
@@ -218,7 +218,7 @@ struct mlir_logger
     mlir_logger(mlir_logger&& other) noexcept
         : ss(std::move(other.ss)), ctx(other.ctx), id(other.id)
     {
-        other.ctx = nullptr;
+        other.ctx = MlirContext{};
         other.id  = std::nullopt;
     }
 
@@ -263,17 +263,47 @@ MlirLogicalResult mlir_logger::handle(MlirDiagnostic diag)
     return mlirLogicalResultSuccess();
 }
 
-struct mlir_program
+// Creating a context and loading all of the dialects is a large part of the time spent lowering a
+// small module, so contexts are kept in a process-wide pool and each one is reused by many
+// programs, one at a time. Types and attributes are never freed from a context, so it is destroyed
+// instead of going back to the pool after a number of uses.
+struct mlir_context_pool
 {
-    mlir_program()
-        : ctx(mlirContextCreateWithRegistry(get_dialect_registry().get(),
-                                            /*threadingEnable=*/false)),
-          location(mlirLocationUnknownGet(ctx.get())),
-          mmodule(mlirModuleCreateEmpty(location)),
-          logger(&ctx)
+    struct entry
     {
-        mlirContextSetThreadPool(ctx.get(), get_thread_pool().get());
-        mlirContextLoadAllAvailableDialects(ctx.get());
+        mlir_context ctx;
+        std::size_t uses = 0;
+    };
+
+    static constexpr std::size_t max_uses = 64;
+
+    static entry acquire()
+    {
+        auto& p = get();
+        {
+            std::lock_guard<std::mutex> lock(p.mutex);
+            if(not p.idle.empty())
+            {
+                auto e = std::move(p.idle.back());
+                p.idle.pop_back();
+                return e;
+            }
+        }
+        entry e;
+        e.ctx = mlirContextCreateWithRegistry(get_dialect_registry().get(),
+                                              /*threadingEnable=*/false);
+        mlirContextSetThreadPool(e.ctx.get(), get_thread_pool().get());
+        mlirContextLoadAllAvailableDialects(e.ctx.get());
+        return e;
+    }
+
+    static void release(entry e)
+    {
+        if(++e.uses >= max_uses)
+            return;
+        auto& p = get();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        p.idle.push_back(std::move(e));
     }
 
     static mlir_dialect_registry& get_dialect_registry()
@@ -301,6 +331,41 @@ struct mlir_program
         return the_pool;
     }
 
+    private:
+    static mlir_context_pool& get()
+    {
+        // Leaked so the pooled contexts are never destroyed after the shared thread pool
+        static auto* pool = new mlir_context_pool; // NOLINT
+        return *pool;
+    }
+
+    std::mutex mutex;
+    std::vector<entry> idle;
+};
+
+// A context from the pool, which is returned once the module and logger using it are destroyed
+struct pooled_mlir_context
+{
+    pooled_mlir_context() : e(mlir_context_pool::acquire()) {}
+    pooled_mlir_context(const pooled_mlir_context&)            = delete;
+    pooled_mlir_context& operator=(const pooled_mlir_context&) = delete;
+    ~pooled_mlir_context() { mlir_context_pool::release(std::move(e)); }
+
+    MlirContext get() const { return e.ctx.get(); }
+
+    private:
+    mlir_context_pool::entry e;
+};
+
+struct mlir_program
+{
+    mlir_program()
+        : location(mlirLocationUnknownGet(ctx.get())),
+          mmodule(mlirModuleCreateEmpty(location)),
+          logger(ctx.get())
+    {
+    }
+
     MlirType make_type(shape::type_t t) const
     {
         MlirType result;
@@ -309,6 +374,8 @@ struct mlir_program
                 result = mlirF32TypeGet(ctx.get());
             else if(as.type_enum() == shape::half_type)
                 result = mlirF16TypeGet(ctx.get());
+            else if(as.type_enum() == shape::bf16_type)
+                result = mlirBF16TypeGet(ctx.get());
             else if(as.type_enum() == shape::fp8e4m3fnuz_type)
                 result = mlirFloat8E4M3FNUZTypeGet(ctx.get());
             else if(as.type_enum() == shape::fp8e4m3fn_type)
@@ -627,6 +694,8 @@ struct mlir_program
             return "migraphx.literal";
         if(ins->name() == "unpack_int4")
             return "migraphx.unpack";
+        if(ins->name() == "convolution_backwards")
+            return "migraphx.backwards_data_convolution";
         return "migraphx." + ins->name();
     }
 
@@ -640,7 +709,7 @@ struct mlir_program
         if(op.name() == "reshape")
             v["dims"] = ins->get_shape().lens();
 
-        if(op.name() == "convolution" or op.name() == "quant_convolution")
+        if(contains({"convolution", "quant_convolution", "convolution_backwards"}, op.name()))
         {
             // Adjust symetrical padding
             if(v.at("padding").size() == v.at("stride").size())
@@ -969,7 +1038,7 @@ struct mlir_program
         return true;
     }
 
-    mlir_context ctx;
+    pooled_mlir_context ctx;
     MlirLocation location;
     mlir_module mmodule;
     mlir_logger logger;
@@ -1077,6 +1146,8 @@ mlir_code_object compile_mlir(const context& migraphx_ctx,
                               const std::vector<shape>& in_shapes,
                               const value& solution)
 {
+    compile_profile_scope profile{"mlir", m.name()};
+    profile.add("solution", solution);
     adjust_param_shapes(m, in_shapes);
     rewrite_reduce(m);
     const bool trace = enabled(MIGRAPHX_TRACE_MLIR{});
@@ -1123,13 +1194,7 @@ mlir_code_object compile_mlir(const context& migraphx_ctx,
         std::transform(prefill_mlir_values.begin(),
                        prefill_mlir_values.end(),
                        prefill_values.begin(),
-                       [](const auto& v) {
-                           // mlir sets fill attribute as float but migx hip::fill operator only
-                           // supports integer type.
-                           // TODO: Need to add checks that it is indeed an integer.
-                           double dv = mlirFloatAttrGetValueDouble(v);
-                           return static_cast<int>(dv);
-                       });
+                       [](const auto& v) { return mlirFloatAttrGetValueDouble(v); });
         mco.prefill_indices = prefill_indices;
         mco.prefill_values  = prefill_values;
     }
@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/overlap_copy.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/algorithm.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+void overlap_copy::apply(module& m) const
+{
+    std::unordered_map<instruction_ref, std::size_t> position;
+    std::vector<instruction_ref> uploads;
+    for(auto ins : iterator_for(m))
+    {
+        // The schedule pass already placed the copies on its streams
+        if(ins->name() == "gpu::set_stream")
+            return;
+        position.emplace(ins, position.size());
+        if(ins->outputs().empty())
+            continue;
+        if(ins->name() == "hip::stream_literal")
+            uploads.push_back(ins);
+        if(ins->name() != "hip::copy_to_gpu" or ins->inputs().size() != 2)
+            continue;
+        if(ins->inputs().front()->name() != "@param")
+            continue;
+        uploads.push_back(ins);
+    }
+    if(uploads.empty())
+        return;
+
+    auto first_user = [&](instruction_ref ins) {
+        return *std::min_element(ins->outputs().begin(),
+                                 ins->outputs().end(),
+                                 by(std::less<>{}, [&](auto x) { return position.at(x); }));
+    };
+    std::stable_sort(uploads.begin(), uploads.end(), by(std::less<>{}, [&](auto ins) {
+                         return position.at(first_user(ins));
+                     }));
+    std::vector<instruction_ref> users(uploads.size());
+    std::transform(uploads.begin(), uploads.end(), users.begin(), first_user);
+
+    auto& device            = ctx->get_current_device();
+    std::size_t copy_stream = device.nstreams();
+    device.add_stream();
+
+    // Issue each copy when the compute for the previous one starts. The
+    // destination is only allocated from there, so memory_coloring can give it
+    // memory that the compute before it is still reading. The copy waits for
+    // that compute on an event recorded on stream 0, which is numbered after
+    // the events of the copies.
+    for(std::size_t i = 0; i < uploads.size(); i++)
+    {
+        auto ins   = uploads[i];
+        auto pos   = users[i == 0 ? 0 : i - 1];
+        auto alloc = ins->inputs().back();
+        if(alloc->name() == "hip::allocate")
+            m.move_instruction(alloc, pos);
+        auto op = ins->get_operator();
+        if(ins->name() == "hip::copy_to_gpu")
+            op = make_op("hip::copy_to_gpu", {{"staged", true}});
+        auto compute_event = uploads.size() + i;
+        m.insert_instruction(pos, make_op("gpu::record_event", {{"event", compute_event}}));
+        m.insert_instruction(pos, make_op("gpu::set_stream", {{"stream", copy_stream}}));
+        m.insert_instruction(pos, make_op("gpu::wait_event", {{"event", compute_event}}));
+        auto copy = m.insert_instruction(pos, op, ins->inputs());
+        m.insert_instruction(pos, make_op("gpu::record_event", {{"event", i}}));
+        m.insert_instruction(pos, make_op("gpu::set_stream", {{"stream", 0}}));
+        m.replace_instruction(ins, copy);
+        m.remove_instruction(ins);
+    }
+    for(std::size_t i = 0; i < uploads.size(); i++)
+        m.insert_instruction(users[i], make_op("gpu::wait_event", {{"event", i}}));
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -31,6 +31,13 @@ namespace gpu {
 std::vector<char> pack_args(const std::vector<kernel_argument>& args)
 {
     std::vector<char> kernargs;
+    pack_args(args, kernargs);
+    return kernargs;
+}
+
+void pack_args(const std::vector<kernel_argument>& args, std::vector<char>& kernargs)
+{
+    kernargs.clear();
     for(auto&& arg : args)
     {
         std::size_t n = arg.size;
@@ -40,7 +47,6 @@ std::vector<char> pack_args(const std::vector<kernel_argument>& args)
         kernargs.insert(kernargs.end(), padding, 0);
         kernargs.insert(kernargs.end(), p, p + n);
     }
-    return kernargs;
 }
 
 } // namespace gpu
@@ -0,0 +1,138 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/pack_weights.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/propagate_constant.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/env.hpp>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_PACK_WEIGHTS)
+
+namespace {
+
+// The permutation of the memory layout each input should be packed in, an empty permutation
+// leaves the input as is
+using layout_request = std::function<std::vector<std::vector<int64_t>>(instruction_ref)>;
+
+std::vector<int64_t> standard_permutation(std::size_t ndim)
+{
+    std::vector<int64_t> perm(ndim);
+    std::iota(perm.begin(), perm.end(), 0);
+    return perm;
+}
+
+// The gemm libraries are fastest with the weights transposed, which is the TN layout in their
+// column-major terms. The solution is only picked when the op is finalized, so it is chosen
+// for the packed layout.
+std::vector<std::vector<int64_t>> gemm_request(instruction_ref ins)
+{
+    const auto& b = ins->inputs().at(1)->get_shape();
+    if(contains({shape::int8_type, shape::uint8_type}, b.type()))
+        return {};
+    auto perm = standard_permutation(b.ndim());
+    std::swap(perm[perm.size() - 1], perm[perm.size() - 2]);
+    return {{}, perm};
+}
+
+// A copy of a constant into a standard layout only needs to be done once
+std::vector<std::vector<int64_t>> contiguous_request(instruction_ref ins)
+{
+    return {standard_permutation(ins->get_shape().ndim())};
+}
+
+const std::unordered_map<std::string, layout_request>& layout_requests()
+{
+    static const std::unordered_map<std::string, layout_request> requests = {
+        {"gpu::gemm", &gemm_request},
+        {"gpu::hip_gemm", &gemm_request},
+        {"gpu::contiguous", &contiguous_request},
+    };
+    return requests;
+}
+
+bool is_packable(instruction_ref input)
+{
+    if(not input->can_eval())
+        return false;
+    const auto& s = input->get_shape();
+    return not s.dynamic() and not s.broadcasted() and s.type() != shape::tuple_type;
+}
+
+} // namespace
+
+void pack_weights::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    for(auto ins : iterator_for(m))
+    {
+        auto it = layout_requests().find(ins->name());
+        if(it == layout_requests().end())
+            continue;
+        auto perms  = it->second(ins);
+        auto inputs = ins->inputs();
+        bool packed = false;
+        for(std::size_t i = 0; i < perms.size(); i++)
+        {
+            const auto& perm = perms[i];
+            auto input       = inputs.at(i);
+            if(perm.empty() or not is_packable(input))
+                continue;
+            const auto& s = input->get_shape();
+            if(s.packed() and find_permutation(s) == perm)
+                continue;
+            if(enabled(MIGRAPHX_TRACE_PACK_WEIGHTS{}))
+                std::cout << "Pack input " << i << " of " << ins->name() << ": " << s
+                          << std::endl;
+            inputs[i] = m.insert_instruction(
+                std::next(input), make_op("layout", {{"permutation", perm}}), input);
+            packed = true;
+        }
+        if(not packed)
+            continue;
+        // The copy is now done by the folded layout
+        if(ins->name() == "gpu::contiguous")
+            m.replace_instruction(ins, inputs.front());
+        else
+            m.replace_instruction(ins, ins->get_operator(), inputs, ins->module_inputs());
+    }
+    mpm.run_pass(propagate_constant{});
+    mpm.run_pass(dead_code_elimination{});
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -48,6 +48,7 @@ std::string get_type(const shape& s)
     static const std::unordered_map<shape::type_t, std::string> m = {
         {shape::float_type, "'FP32'"},
         {shape::half_type, "'FP16'"},
+        {shape::bf16_type, "'BF16'"},
         {shape::double_type, "'FP64'"},
         {shape::int8_type, "'INT8'"},
         {shape::int32_type, "'INT32'"},
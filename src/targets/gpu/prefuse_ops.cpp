@@ -22,10 +22,12 @@
  * THE SOFTWARE.
  */
 #include <migraphx/matcher.hpp>
+#include <migraphx/make_op.hpp>
 #include <migraphx/permutation.hpp>
 #include <migraphx/gpu/prefuse_ops.hpp>
 #include <migraphx/gpu/gemm_softmax_gemm.hpp>
 #include <migraphx/match/layernorm.hpp>
+#include <migraphx/op/convolution.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/dead_code_elimination.hpp>
@@ -39,6 +41,9 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_LAYERNORM_FUSION);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_NATIVE_ATTENTION);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_NATIVE_GROUP_CONV);
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_NATIVE_MOE);
 
 namespace {
 
@@ -46,10 +51,12 @@ template <class Derived, std::size_t N>
 struct layernorm_base
 {
     float epsilon = 1e-12f;
+    // Also output the sum of the inputs before the normalization
+    bool residual = false;
     template <class Self, class F>
     static auto reflect(Self& self, F f)
     {
-        return pack(f(self.epsilon, "epsilon"));
+        return pack(f(self.epsilon, "epsilon"), f(self.residual, "residual"));
     }
     shape compute_shape(std::vector<shape> inputs, std::vector<module_ref> mods) const
     {
@@ -69,15 +76,18 @@ struct layernorm_base
         if(inputs.front().elements() == 1 and
            all_of(inputs, [](const auto& ss) { return ss.scalar(); }))
             return inputs.front();
-        auto l_s = shape::from_permutation(
-            t, s.lens(), find_permutation(std::vector<shape>(inputs.begin(), inputs.begin() + N)));
-        // just prelayernorm or preadd_layernorm
-        if(nargs <= N)
+        auto perm = find_permutation(std::vector<shape>(inputs.begin(), inputs.begin() + N));
+        auto l_s  = shape::from_permutation(t, s.lens(), perm);
+        // layernorm + pointwise fusion, preserve layout of fused op
+        if(nargs > N)
+        {
+            std::vector<shape> lp_s(inputs.begin() + N, inputs.end());
+            lp_s.insert(lp_s.begin(), l_s);
+            l_s = shape::from_permutation(t, s.lens(), find_permutation(lp_s));
+        }
+        if(not residual)
             return l_s;
-        // else, layernorm + pointwise fusion, preserve layout of fused op
-        std::vector<shape> lp_s(inputs.begin() + N, inputs.end());
-        lp_s.insert(lp_s.begin(), l_s);
-        return shape::from_permutation(t, s.lens(), find_permutation(lp_s));
+        return shape{{l_s, shape::from_permutation(s.type(), s.lens(), perm)}};
     }
 };
 
@@ -94,6 +104,18 @@ struct add_layernorm : layernorm_base<add_layernorm, 2>
 };
 MIGRAPHX_REGISTER_OP(add_layernorm);
 
+struct rms_norm : layernorm_base<rms_norm, 1>
+{
+    std::string name() const { return "gpu::prerms_norm"; }
+};
+MIGRAPHX_REGISTER_OP(rms_norm);
+
+struct add_rms_norm : layernorm_base<add_rms_norm, 2>
+{
+    std::string name() const { return "gpu::preadd_rms_norm"; }
+};
+MIGRAPHX_REGISTER_OP(add_rms_norm);
+
 struct find_layernorm
 {
     auto matcher() const { return match::layernorm(); }
@@ -110,21 +132,356 @@ struct find_layernorm
     }
 };
 
-struct find_add_layernorm
+struct find_rms_norm
+{
+    auto matcher() const { return match::rms_norm(); }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins   = r.result;
+        auto x_ins = r.instructions["x"];
+        if(x_ins != r.instructions["sq_x"])
+            return;
+        float eps = 0;
+        if(contains(r.instructions, "eps"))
+            eps = r.instructions["eps"]->eval().at<float>();
+
+        m.replace_instruction(ins, rms_norm{eps}, x_ins);
+    }
+};
+
+template <class Norm, class AddNorm>
+struct find_add_norm
 {
     auto matcher() const
     {
-        return match::name("gpu::prelayernorm")(
-            match::args(match::name("add")(match::used_once()).bind("add")));
+        return match::name(Norm{}.name())(match::args(match::name("add").bind("add")));
     }
 
     void apply(module& m, const match::matcher_result& r) const
     {
         auto ins     = r.result;
         auto add_ins = r.instructions["add"];
-        auto op      = any_cast<layernorm>(ins->get_operator());
+        auto op      = any_cast<Norm>(ins->get_operator());
+        if(add_ins->outputs().size() == 1)
+        {
+            m.replace_instruction(ins, AddNorm{op.epsilon}, add_ins->inputs());
+            return;
+        }
+        // The sum is also written by the kernel when the other users come after it
+        if(add_ins->get_shape().type() == shape::tuple_type or
+           std::any_of(add_ins->outputs().begin(), add_ins->outputs().end(), [&](auto output) {
+               return output != ins and std::find(std::next(ins), m.end(), output) == m.end();
+           }))
+            return;
+        auto fused = m.insert_instruction(ins, AddNorm{op.epsilon, true}, add_ins->inputs());
+        auto sum   = m.insert_instruction(ins, make_op("get_tuple_elem", {{"index", 1}}), fused);
+        m.replace_instruction(ins, make_op("get_tuple_elem", {{"index", 0}}), fused);
+        m.replace_instruction(add_ins, sum);
+    }
+};
+
+// Multinomial sampling that generates its uniform values from the seed, rather than reading
+// them from the buffer written by random_uniform
+struct random_multinomial
+{
+    shape::type_t dtype     = shape::type_t::int32_type;
+    shape::type_t dist_type = shape::type_t::float_type;
+    std::size_t sample_size = 1;
 
-        m.replace_instruction(ins, add_layernorm{op.epsilon}, add_ins->inputs());
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.dtype, "dtype"),
+                    f(self.dist_type, "dist_type"),
+                    f(self.sample_size, "sample_size"));
+    }
+
+    std::string name() const { return "gpu::random_multinomial"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(2);
+        check_shapes{inputs.begin(), inputs.begin() + 1, *this}.only_dims(2).standard();
+        return {dtype, {inputs.front().lens().front(), sample_size}};
+    }
+};
+MIGRAPHX_REGISTER_OP(random_multinomial);
+
+struct find_random_multinomial
+{
+    auto matcher() const
+    {
+        return match::name("multinomial")(
+            match::arg(1)(match::name("random_uniform")(match::used_once()).bind("random")));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins        = r.result;
+        auto random_ins = r.instructions["random"];
+        auto s          = ins->get_shape();
+        if(s.dynamic() or random_ins->get_shape().dynamic())
+            return;
+        m.replace_instruction(
+            ins,
+            random_multinomial{s.type(), random_ins->get_shape().type(), s.lens().back()},
+            ins->inputs().front(),
+            random_ins->inputs().front());
+    }
+};
+
+// Matches the expanded rotary embedding of exported models,
+//
+//     x * cos + concat(-x[..., d/2:], x[..., :d/2]) * sin
+//
+// which otherwise takes several kernels and a copy of x for the concat
+struct find_rotary_embedding
+{
+    auto matcher() const
+    {
+        auto upper   = match::name("neg")(match::used_once(),
+                                          match::arg(0)(match::name("slice").bind("upper")));
+        auto rotate  = match::name("concat")(match::used_once(),
+                                             match::nargs(2),
+                                             match::arg(0)(upper),
+                                             match::arg(1)(match::name("slice").bind("lower")));
+        auto mul_sin = match::name("mul")(
+            match::used_once(),
+            match::either_arg(0, 1)(rotate.bind("rotate"), match::any().bind("sin")));
+        auto mul_cos = match::name("mul")(
+            match::used_once(),
+            match::either_arg(0, 1)(match::any().bind("x"), match::any().bind("cos")));
+        return match::name("add")(match::either_arg(0, 1)(mul_sin, mul_cos));
+    }
+
+    static bool is_half_slice(instruction_ref ins, std::size_t axis, bool upper)
+    {
+        auto v                      = ins->get_operator().to_value();
+        auto d                      = ins->inputs().front()->get_shape().lens()[axis];
+        std::vector<int64_t> starts = {upper ? int64_t(d / 2) : 0};
+        std::vector<int64_t> ends   = {upper ? int64_t(d) : int64_t(d / 2)};
+        return v["axes"].to_vector<int64_t>() == std::vector<int64_t>{int64_t(axis)} and
+               v["starts"].to_vector<int64_t>() == starts and
+               v["ends"].to_vector<int64_t>() == ends;
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins    = r.result;
+        auto upper  = r.instructions["upper"];
+        auto lower  = r.instructions["lower"];
+        auto rotate = r.instructions["rotate"];
+        auto x      = r.instructions["x"];
+        auto c      = r.instructions["cos"];
+        auto s      = r.instructions["sin"];
+        auto input  = lower->inputs().front();
+        if(c == input)
+            std::swap(x, c);
+        if(x != input or upper->inputs().front() != input)
+            return;
+        const auto& xs = input->get_shape();
+        if(xs.dynamic() or xs.ndim() == 0 or xs.lens().back() % 2 != 0)
+            return;
+        auto axis = xs.ndim() - 1;
+        if(rotate->get_operator().to_value()["axis"].to<int64_t>() != int64_t(axis))
+            return;
+        if(not is_half_slice(lower, axis, false) or not is_half_slice(upper, axis, true))
+            return;
+        if(c->get_shape().lens() != xs.lens() or s->get_shape().lens() != xs.lens() or
+           c->get_shape().type() != xs.type() or s->get_shape().type() != xs.type())
+            return;
+        m.replace_instruction(ins, make_op("rotary_embedding"), input, c, s);
+    }
+};
+
+// Depthwise and grouped convolutions compiled with the native jit kernel, since each output only
+// reads a few input channels and the gemm based convolutions leave most of the device idle
+struct group_conv
+{
+    op::convolution op;
+
+    // Largest number of input channels in each group that use the direct convolution
+    static constexpr std::size_t max_group_channels = 16;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return op::convolution::reflect(self.op, f);
+    }
+
+    std::string name() const { return "gpu::group_conv"; }
+
+    shape compute_shape(std::vector<shape> inputs, std::vector<module_ref> mods) const
+    {
+        std::size_t nargs = 2;
+        if(not mods.empty())
+            nargs += mods.front()->get_parameter_names().size() - 1;
+        check_shapes{inputs, *this}.has(nargs);
+        auto s = op.normalize_compute_shape({inputs[0], inputs[1]});
+        if(mods.empty())
+            return s;
+        // Fused pointwise, preserve layout of the fused inputs
+        auto t = mods.front()->get_output_shapes().front().type();
+        std::vector<shape> pw_s(inputs.begin() + 2, inputs.end());
+        pw_s.insert(pw_s.begin(), s);
+        return shape::from_permutation(t, s.lens(), find_permutation(pw_s));
+    }
+
+    static bool is_supported(instruction_ref ins)
+    {
+        if(ins->get_shape().dynamic())
+            return false;
+        if(not contains({shape::float_type, shape::half_type, shape::bf16_type},
+                        ins->get_shape().type()))
+            return false;
+        auto conv = any_cast<op::convolution>(ins->get_operator());
+        if(conv.group < 2 or conv.padding_mode != op::default_)
+            return false;
+        // Covers depthwise convolutions, where there is a single channel in each group
+        return ins->inputs().at(1)->get_shape().lens().at(1) <= max_group_channels;
+    }
+};
+MIGRAPHX_REGISTER_OP(group_conv);
+
+struct find_group_conv
+{
+    auto matcher() const
+    {
+        return match::name("convolution")(
+            match::make_basic_pred_matcher(&group_conv::is_supported));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins = r.result;
+        auto op  = any_cast<op::convolution>(ins->get_operator());
+        m.replace_instruction(ins, group_conv{op}, ins->inputs());
+    }
+};
+
+// Sorts the (token, slot) pairs picked by a mixture-of-experts router by their expert. The
+// output holds the offset of the pairs of each expert, followed by the flat index of each pair
+// into the indices.
+struct moe_route
+{
+    std::size_t experts = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.experts, "experts"));
+    }
+
+    std::string name() const { return "gpu::moe_route"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).only_dims(2).standard();
+        if(not shape::is_integral(inputs.front().type()))
+            MIGRAPHX_THROW("MOE_ROUTE: indices must be integral");
+        return {shape::int32_type, {experts + 1 + inputs.front().elements()}};
+    }
+};
+MIGRAPHX_REGISTER_OP(moe_route);
+
+// Grouped gemm of the tokens {tokens, k} with the weights of the experts {experts, k, n} routed
+// by moe_route, which only computes the experts each token was routed to. The output is
+// {tokens, slots, n} so the results can be weighted and summed over the slots.
+struct moe_gemm
+{
+    std::string name() const { return "gpu::moe_gemm"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(3);
+        const auto& x     = inputs[0];
+        const auto& w     = inputs[1];
+        const auto& route = inputs[2];
+        if(x.ndim() != 2 or w.ndim() != 3 or route.ndim() != 1)
+            MIGRAPHX_THROW("MOE_GEMM: expected 2D tokens, 3D weights and 1D routes");
+        if(x.type() != w.type() or x.lens()[1] != w.lens()[1])
+            MIGRAPHX_THROW("MOE_GEMM: tokens and weights do not match");
+        auto tokens = x.lens()[0];
+        auto pairs  = route.elements() - w.lens()[0] - 1;
+        if(tokens == 0 or pairs % tokens != 0)
+            MIGRAPHX_THROW("MOE_GEMM: invalid number of routes");
+        return {x.type(), {tokens, pairs / tokens, w.lens()[2]}};
+    }
+};
+MIGRAPHX_REGISTER_OP(moe_gemm);
+
+// Replaces the dense compute of every expert of a mixture of experts, which is how they are
+// exported without a loop:
+//
+//     gates = scatter_none(zeros, topk_indices, topk_values)  // {tokens, experts}
+//     y     = reduce_sum(dot(broadcast(x), w) * transpose(gates), {0})
+//
+// with moe_route and moe_gemm, so only the experts picked by topk are computed.
+struct find_moe
+{
+    static bool is_view(instruction_ref ins)
+    {
+        return contains({"transpose", "unsqueeze", "squeeze", "broadcast", "multibroadcast"},
+                        ins->name());
+    }
+
+    auto matcher() const
+    {
+        auto dot = match::name("dot")(match::used_once()).bind("dot");
+        return match::name("reduce_sum")(match::arg(0)(match::name("mul")(
+            match::used_once(), match::either_arg(0, 1)(dot, match::any().bind("gate_view")))));
+    }
+
+    static auto gates_matcher()
+    {
+        auto topk = match::name("get_tuple_elem")(match::arg(0)(match::name("topk")));
+        auto indices = match::skip(match::name("convert"))(topk);
+        return match::name("scatter_none")(match::arg(0)(match::has_value(0.0f)),
+                                           match::arg(1)(indices));
+    }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins       = r.result;
+        auto dot       = r.instructions["dot"];
+        auto gate_view = r.instructions["gate_view"];
+        if(ins->get_shape().dynamic() or
+           ins->get_operator().to_value()["axes"].to_vector<int64_t>() != std::vector<int64_t>{0})
+            return;
+        auto a = dot->inputs().front();
+        auto w = dot->inputs().back();
+        if(a->get_shape().ndim() != 3 or w->get_shape().ndim() != 3 or
+           a->get_shape().strides().front() != 0)
+            return;
+        auto experts = w->get_shape().lens()[0];
+        auto tokens  = a->get_shape().lens()[1];
+
+        // The gates must be viewed as {experts, tokens, n}, reading gates[token, expert]
+        const auto& gs = gate_view->get_shape();
+        if(gs.strides() != std::vector<std::size_t>{1, experts, 0})
+            return;
+        auto gates = gate_view;
+        while(is_view(gates))
+            gates = gates->inputs().front();
+        if(match::match_instruction(m, gates, gates_matcher()).result != gates)
+            return;
+        if(gates->get_shape().lens() != std::vector<std::size_t>{tokens, experts} or
+           gates->get_operator().to_value()["axis"].to<int64_t>() != 1)
+            return;
+        auto indices = gates->inputs()[1];
+        auto values  = gates->inputs()[2];
+        if(values->get_shape().type() != ins->get_shape().type())
+            return;
+
+        auto x = m.insert_instruction(
+            ins, make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {1}}}), a);
+        x          = m.insert_instruction(ins, make_op("squeeze", {{"axes", {0}}}), x);
+        auto route = m.insert_instruction(ins, moe_route{experts}, indices);
+        auto y     = m.insert_instruction(ins, moe_gemm{}, x, w, route);
+        auto weights = m.insert_instruction(ins, make_op("unsqueeze", {{"axes", {2}}}), values);
+        weights = m.insert_instruction(
+            ins, make_op("multibroadcast", {{"out_lens", y->get_shape().lens()}}), weights);
+        auto mul = m.insert_instruction(ins, make_op("mul"), y, weights);
+        auto sum = m.insert_instruction(ins, make_op("reduce_sum", {{"axes", {1}}}), mul);
+        m.replace_instruction(ins, make_op("reshape", {{"dims", ins->get_shape().lens()}}), sum);
     }
 };
 
@@ -134,21 +491,42 @@ struct pre_gemm_softmax_gemm : gemm_softmax_gemm
 };
 MIGRAPHX_REGISTER_OP(pre_gemm_softmax_gemm);
 
-auto is_ck_gemm()
+// Attention compiled with the native jit kernel when neither CK nor MLIR handle it
+struct attention : gemm_softmax_gemm
+{
+    std::string name() const { return "gpu::attention"; }
+
+    static bool is_supported_type(shape::type_t t)
+    {
+        return contains({shape::float_type, shape::half_type, shape::bf16_type}, t);
+    }
+};
+MIGRAPHX_REGISTER_OP(attention);
+
+bool use_ck_gemm(instruction_ref ins)
 {
-    return match::make_basic_pred_matcher([=](instruction_ref ins) {
 #ifdef MIGRAPHX_USE_COMPOSABLEKERNEL
-        if(not enabled(MIGRAPHX_ENABLE_CK{}))
-            return false;
-        if(ins->name() != "dot")
-            return false;
-        if(not pre_gemm_softmax_gemm::is_ck_supported_type(ins->get_shape().type()))
-            return false;
-        return true;
-#else
-        (void)ins;
+    if(not enabled(MIGRAPHX_ENABLE_CK{}))
         return false;
+    if(ins->name() != "dot")
+        return false;
+    if(not pre_gemm_softmax_gemm::is_ck_supported_type(ins->get_shape().type()))
+        return false;
+    return true;
+#else
+    (void)ins;
+    return false;
 #endif
+}
+
+auto is_ck_gemm() { return match::make_basic_pred_matcher(&use_ck_gemm); }
+
+auto is_native_attention_gemm(bool enable_attention, bool enable_native_attention)
+{
+    return match::make_basic_pred_matcher([=](instruction_ref ins) {
+        if(ins->name() != "dot" or enable_attention or not enable_native_attention)
+            return false;
+        return attention::is_supported_type(ins->get_shape().type());
     });
 }
 
@@ -172,14 +550,39 @@ auto is_bias_supported()
     });
 }
 
+// The native kernel reduces along the last axis, keeps a row of the first gemm in LDS and needs a
+// thread for each output column
+bool is_native_attention_supported(instruction_ref gemm1,
+                                   instruction_ref softmax,
+                                   instruction_ref gemm2,
+                                   bool single_scale)
+{
+    if(not single_scale)
+        return false;
+    if(gemm1->get_shape().type() != gemm2->get_shape().type())
+        return false;
+    auto ndim = static_cast<std::int64_t>(softmax->get_shape().ndim());
+    auto axis = softmax->get_operator().to_value()["axis"].to<std::int64_t>();
+    if(axis != ndim - 1 and axis != -1)
+        return false;
+    auto k = gemm1->inputs().front()->get_shape().lens().back();
+    auto o = gemm2->get_shape().lens().back();
+    return k <= 1024 and o <= 1024;
+}
+
 struct find_gemm_softmax_gemm
 {
-    bool enable_attention = false;
+    bool enable_attention        = false;
+    bool enable_native_attention = false;
 
     auto matcher() const
     {
-        auto gemm1 = match::skip(match::name("contiguous"))(match::name("dot")(
-            match::any_of(is_ck_gemm(), is_test_gemm(enable_attention)).bind("gemm1")));
+        auto gemm1 = match::skip(match::name("contiguous"))(
+            match::name("dot")(match::any_of(is_ck_gemm(),
+                                             is_test_gemm(enable_attention),
+                                             is_native_attention_gemm(enable_attention,
+                                                                      enable_native_attention))
+                                   .bind("gemm1")));
         auto mul   = match::name("mul")(
             match::nargs(2), match::either_arg(0, 1)(match::is_constant().bind("scale"), gemm1));
         auto where = match::name("where")(match::arg(2)(match::is_constant().bind("select_const")),
@@ -192,9 +595,11 @@ struct find_gemm_softmax_gemm
         auto softmax = match::name("softmax")(match::arg(0)(match::any_of(mul, add, gemm1, where)))
                            .bind("softmax");
 
-        return match::name("dot")(
-            match::any_of(is_ck_gemm(), is_test_gemm(enable_attention)).bind("gemm2"))(
-            match::arg(0)(softmax));
+        return match::name("dot")(match::any_of(is_ck_gemm(),
+                                                is_test_gemm(enable_attention),
+                                                is_native_attention_gemm(enable_attention,
+                                                                         enable_native_attention))
+                                      .bind("gemm2"))(match::arg(0)(softmax));
     }
 
     void apply(module_pass_manager& mpm, const match::matcher_result& r) const
@@ -202,8 +607,10 @@ struct find_gemm_softmax_gemm
         auto ins       = r.result;
         auto gemm2_ins = r.instructions["gemm2"];
         auto gemm1_ins = r.instructions["gemm1"];
+        bool native    = not enable_attention and not use_ck_gemm(gemm1_ins);
 
-        float scale = 1.0;
+        float scale       = 1.0;
+        bool single_scale = true;
         if(contains(r.instructions, "scale"))
         {
             auto scale_lit = r.instructions["scale"];
@@ -212,10 +619,16 @@ struct find_gemm_softmax_gemm
                 // CK only supports single-valued scale
                 if(not std::all_of(
                        s.begin() + 1, s.end(), [&](auto v) { return float_equal(v, s.front()); }))
+                {
+                    single_scale = false;
                     return;
+                }
                 scale = s.front();
             });
         }
+        if(native and not is_native_attention_supported(
+                          gemm1_ins, r.instructions["softmax"], gemm2_ins, single_scale))
+            return;
 
         auto inputs = gemm1_ins->inputs(); // A, B
         if(contains(r.instructions, "select_cond"))
@@ -230,8 +643,12 @@ struct find_gemm_softmax_gemm
 
         inputs.push_back(gemm2_ins->inputs().back()); // B1
 
-        mpm.get_module().replace_instruction(
-            ins, pre_gemm_softmax_gemm{gemm2_ins->get_operator(), scale}, inputs);
+        if(native)
+            mpm.get_module().replace_instruction(
+                ins, attention{gemm2_ins->get_operator(), scale}, inputs);
+        else
+            mpm.get_module().replace_instruction(
+                ins, pre_gemm_softmax_gemm{gemm2_ins->get_operator(), scale}, inputs);
     }
 };
 
@@ -243,9 +660,28 @@ void prefuse_ops::apply(module_pass_manager& mpm) const
     {
         match::find_matches(mpm.get_module(), find_layernorm{});
         mpm.run_pass(dead_code_elimination{});
-        match::find_matches(mpm.get_module(), find_add_layernorm{});
+        match::find_matches(mpm.get_module(), find_rms_norm{});
+        mpm.run_pass(dead_code_elimination{});
+        match::find_matches(mpm.get_module(),
+                            find_add_norm<layernorm, add_layernorm>{},
+                            find_add_norm<rms_norm, add_rms_norm>{});
+    }
+    match::find_matches(mpm.get_module(), find_random_multinomial{});
+    mpm.run_pass(dead_code_elimination{});
+    match::find_matches(mpm.get_module(), find_rotary_embedding{});
+    mpm.run_pass(dead_code_elimination{});
+    if(not enabled(MIGRAPHX_DISABLE_NATIVE_GROUP_CONV{}))
+        match::find_matches(mpm.get_module(), find_group_conv{});
+    if(not enabled(MIGRAPHX_DISABLE_NATIVE_MOE{}))
+    {
+        match::find_matches(mpm.get_module(), find_moe{});
+        mpm.run_pass(dead_code_elimination{});
     }
-    match::find_matches(mpm, find_gemm_softmax_gemm{enable_attention});
+    match::find_matches(
+        mpm,
+        find_gemm_softmax_gemm{enable_attention,
+                               enable_native_attention and
+                                   not enabled(MIGRAPHX_DISABLE_NATIVE_ATTENTION{})});
 }
 
 } // namespace gpu
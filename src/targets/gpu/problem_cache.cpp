@@ -25,9 +25,12 @@
 #include <migraphx/gpu/problem_cache.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/json.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/env.hpp>
 #include <migraphx/serialize.hpp>
 #include <migraphx/file_buffer.hpp>
+#include <migraphx/permutation.hpp>
+#include <cmath>
 #include <iostream>
 
 namespace migraphx {
@@ -35,12 +38,38 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PROBLEM_CACHE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_NEAREST_SOLUTION)
 
-void problem_cache::load()
+static bool is_sqlite_path(const fs::path& p)
+{
+    auto ext = p.extension().string();
+    return contains({".db", ".sqlite", ".sqlite3"}, ext);
+}
+
+static sqlite open_problem_db(const fs::path& pc_path)
+{
+    auto db = sqlite::write(pc_path);
+    // Wait for other processes writing to the database instead of failing
+    db.execute("PRAGMA busy_timeout = 60000;");
+    db.execute("CREATE TABLE IF NOT EXISTS problem_cache "
+               "(key TEXT PRIMARY KEY NOT NULL, solution TEXT NOT NULL);");
+    return db;
+}
+
+void problem_cache::load() { load(string_value_of(MIGRAPHX_PROBLEM_CACHE{})); }
+
+void problem_cache::load(const fs::path& pc_path)
 {
-    auto pc_path = string_value_of(MIGRAPHX_PROBLEM_CACHE{});
     if(pc_path.empty())
         return;
+    std::lock_guard<std::mutex> lock(m);
+    // The database is read again for the next search of the solved problems
+    db_solutions = nullopt;
+    if(is_sqlite_path(pc_path))
+    {
+        db = open_problem_db(pc_path);
+        return;
+    }
     if(not fs::exists(pc_path))
     {
         std::cout << "Problem cache not found. Creating new file.\n";
@@ -50,9 +79,13 @@ void problem_cache::load()
 }
 void problem_cache::save() const
 {
+    // Solutions are already written to the database when inserted
+    if(db.has_value())
+        return;
     auto pc_path = string_value_of(MIGRAPHX_PROBLEM_CACHE{});
     if(pc_path.empty())
         return;
+    std::lock_guard<std::mutex> lock(m);
     write_string(pc_path, to_pretty_json_string(to_value(cache)));
 }
 
@@ -63,26 +96,154 @@ static value create_key(const std::string& name, const value& problem)
 
 bool problem_cache::has(const std::string& name, const value& problem) const
 {
-    return contains(cache, create_key(name, problem));
+    return this->get(name, problem).has_value();
 }
 
 void problem_cache::insert(const std::string& name, const value& problem, const value& solution)
 {
     assert(not solution.is_null());
-    cache[create_key(name, problem)] = solution;
+    auto key = create_key(name, problem);
+    std::lock_guard<std::mutex> lock(m);
+    cache[key] = solution;
+    if(not db.has_value())
+        return;
+    // Another process may have stored a solution for the same problem, in
+    // which case the latest one wins
+    db->execute("INSERT OR REPLACE INTO problem_cache (key, solution) VALUES (?, ?);",
+                {to_json_string(key), to_json_string(solution)});
 }
 
 void problem_cache::mark(const std::string& name, const value& problem)
 {
-    cache.insert(std::make_pair(create_key(name, problem), value{}));
+    auto key = create_key(name, problem);
+    std::lock_guard<std::mutex> lock(m);
+    cache.insert(std::make_pair(key, value{}));
 }
 
 optional<value> problem_cache::get(const std::string& name, const value& problem) const
 {
-    auto it = cache.find(create_key(name, problem));
-    if(it == cache.end())
+    static auto& hits   = get_metric_counter("problem_cache_hit");
+    static auto& misses = get_metric_counter("problem_cache_miss");
+    auto key            = create_key(name, problem);
+    std::lock_guard<std::mutex> lock(m);
+    auto it = cache.find(key);
+    if(it != cache.end())
+    {
+        hits.add();
+        return it->second;
+    }
+    if(not db.has_value())
+    {
+        misses.add();
+        return nullopt;
+    }
+    // Copies of sqlite share the same connection
+    auto conn = *db;
+    auto rows =
+        conn.execute("SELECT solution FROM problem_cache WHERE key = ?;", {to_json_string(key)});
+    if(rows.empty())
+    {
+        misses.add();
         return nullopt;
-    return it->second;
+    }
+    hits.add();
+    // Keep the solution so the database is only queried once for each problem
+    auto solution = from_json_string(rows.front().at("solution"));
+    cache.emplace(key, solution);
+    return solution;
+}
+
+std::unordered_map<value, value> problem_cache::solutions() const
+{
+    std::lock_guard<std::mutex> lock(m);
+    if(db.has_value() and not db_solutions.has_value())
+    {
+        db_solutions.emplace();
+        auto conn = *db;
+        for(auto&& row : conn.execute("SELECT key, solution FROM problem_cache;"))
+            (*db_solutions)[from_json_string(row.at("key"))] = from_json_string(row.at("solution"));
+    }
+    auto result = db_solutions.value_or(std::unordered_map<value, value>{});
+    for(auto&& [key, solution] : cache)
+    {
+        // Problems marked while tuning don't have a solution yet
+        if(not solution.is_null())
+            result[key] = solution;
+    }
+    return result;
+}
+
+optional<value>
+problem_cache::nearest(const std::string& name,
+                       const std::function<optional<double>(const value&)>& distance) const
+{
+    static auto& hits = get_metric_counter("problem_cache_nearest_hit");
+    if(enabled(MIGRAPHX_DISABLE_NEAREST_SOLUTION{}))
+        return nullopt;
+    optional<value> best_key;
+    optional<value> result;
+    double best = 0;
+    for(auto&& [key, solution] : solutions())
+    {
+        if(key.get("name", std::string{}) != name)
+            continue;
+        auto d = distance(key.at("problem"));
+        if(not d.has_value())
+            continue;
+        // Ties are broken by the key so the pick doesn't depend on the order of the map
+        if(result.has_value() and (*d > best or (*d == best and not(key < *best_key))))
+            continue;
+        best     = *d;
+        best_key = key;
+        result   = solution;
+    }
+    if(result.has_value())
+        hits.add();
+    return result;
+}
+
+std::unordered_map<value, std::size_t>
+problem_cache::solution_counts(const std::string& name) const
+{
+    std::unordered_map<value, std::size_t> result;
+    for(auto&& [key, solution] : solutions())
+    {
+        if(key.get("name", std::string{}) == name)
+            result[solution]++;
+    }
+    return result;
+}
+
+static bool same_layout(const shape& x, const shape& y)
+{
+    if(x.type() != y.type() or x.ndim() != y.ndim() or x.dynamic() or y.dynamic())
+        return false;
+    if(find_permutation(x) != find_permutation(y))
+        return false;
+    return std::equal(x.strides().begin(),
+                      x.strides().end(),
+                      y.strides().begin(),
+                      y.strides().end(),
+                      [](auto a, auto b) { return (a == 0) == (b == 0); });
+}
+
+optional<double> shapes_distance(const std::vector<shape>& x, const std::vector<shape>& y)
+{
+    if(x.size() != y.size())
+        return nullopt;
+    double result = 0;
+    for(auto i : range(x.size()))
+    {
+        if(not same_layout(x[i], y[i]))
+            return nullopt;
+        for(auto j : range(x[i].ndim()))
+        {
+            auto a = std::max<std::size_t>(x[i].lens()[j], 1);
+            auto b = std::max<std::size_t>(y[i].lens()[j], 1);
+            result += std::abs(std::log(double(a)) - std::log(double(b)));
+        }
+    }
+    return result;
 }
 
 } // namespace gpu
@@ -23,10 +23,12 @@
  */
 #include <migraphx/gpu/schedule_model.hpp>
 #include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/kernel_costs.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/operation.hpp>
+#include <cmath>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -142,7 +144,7 @@ static const std::unordered_map<std::string, std::size_t>& weight_map()
     return m;
 }
 
-std::size_t schedule_model::weight(const operation& op) const
+static std::size_t static_weight(const operation& op)
 {
     if(weight_map().count(op.name()) == 0)
     {
@@ -151,6 +153,21 @@ std::size_t schedule_model::weight(const operation& op) const
     return weight_map().at(op.name());
 }
 
+std::size_t schedule_model::weight(const operation& op, const std::vector<shape>& inputs) const
+{
+    auto w = static_weight(op);
+    if(costs == nullptr or costs->empty())
+        return w;
+    // All weights are in microseconds once there are measured costs, so an
+    // operator that wasn't measured is estimated relative to the average
+    // measured kernel, which the default weight of 2 stands for
+    if(auto ms = costs->get(op, inputs))
+        return std::max<std::size_t>(1, std::lround(*ms * 1000.0));
+    if(w == 0)
+        return 0;
+    return std::max<std::size_t>(1, std::lround(w * costs->average() * 1000.0 / 2));
+}
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -0,0 +1,138 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/sparse_gemm.hpp>
+#include <migraphx/gpu/hipsparselt.hpp>
+#include <migraphx/gpu/hipsparselt_gemm.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/env.hpp>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_SPARSE_GEMM)
+
+#if MIGRAPHX_USE_HIPSPARSELT
+// hipSPARSELt needs every dimension to be a multiple of this
+constexpr std::size_t dim_multiple = 16;
+
+// Get the weights as a standard [k, n] argument, the batch dimensions must be broadcasted
+static argument get_weights(instruction_ref b)
+{
+    const auto& s = b->get_shape();
+    auto rank     = s.ndim();
+    if(std::any_of(s.strides().begin(), s.strides().end() - 2, [](auto x) { return x != 0; }))
+        return {};
+    auto arg = b->eval();
+    if(arg.empty())
+        return {};
+    shape ws{s.type(),
+             {s.lens()[rank - 2], s.lens()[rank - 1]},
+             {s.strides()[rank - 2], s.strides()[rank - 1]}};
+    argument view{ws, [=] { return arg.data(); }};
+    argument result{shape{s.type(), ws.lens()}};
+    visit_all(result, view)(
+        [&](auto output, auto input) { std::copy(input.begin(), input.end(), output.begin()); });
+    return result;
+}
+
+// At most two of every four consecutive elements along k are nonzero
+static bool is_sparse_2_4(const argument& weights)
+{
+    auto k      = weights.get_shape().lens().front();
+    auto n      = weights.get_shape().lens().back();
+    bool result = true;
+    weights.visit([&](auto w) {
+        for(std::size_t i = 0; i < k and result; i += 4)
+        {
+            for(std::size_t j = 0; j < n and result; j++)
+            {
+                std::size_t nonzeros = 0;
+                for(std::size_t x = i; x < i + 4; x++)
+                    nonzeros += static_cast<double>(w[x * n + j]) == 0 ? 0 : 1;
+                result = nonzeros <= 2;
+            }
+        }
+    });
+    return result;
+}
+#endif
+
+void sparse_gemm::apply(module& m) const
+{
+#if MIGRAPHX_USE_HIPSPARSELT
+    if(not hipsparselt_supported())
+        return;
+    assert(ctx != nullptr);
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "dot")
+            continue;
+        if(ins->get_shape().dynamic())
+            continue;
+        if(not hipsparselt_supported_type(ins->get_shape().type()))
+            continue;
+        auto a      = ins->inputs().front();
+        auto b      = ins->inputs().back();
+        auto a_lens = a->get_shape().lens();
+        auto rows   = std::accumulate(
+            a_lens.begin(), a_lens.end() - 1, std::size_t{1}, std::multiplies<>{});
+        auto k = a_lens.back();
+        auto n = b->get_shape().lens().back();
+        if(rows % dim_multiple != 0 or k % dim_multiple != 0 or n % dim_multiple != 0)
+            continue;
+        if(not b->can_eval())
+            continue;
+        auto weights = get_weights(b);
+        if(weights.empty() or not is_sparse_2_4(weights))
+            continue;
+        if(enabled(MIGRAPHX_TRACE_SPARSE_GEMM{}))
+            std::cout << "Sparse gemm for " << ins->get_shape() << std::endl;
+        auto compressed = m.add_literal(literal{hipsparselt_compress(*ctx, weights)});
+        if(not a->get_shape().standard())
+            a = m.insert_instruction(ins, make_op("contiguous"), a);
+        auto ra = m.insert_instruction(ins, make_op("reshape", {{"dims", {rows, k}}}), a);
+        auto alloc = m.insert_instruction(
+            ins,
+            make_op("allocate",
+                    {{"shape", to_value(shape{ins->get_shape().type(), {rows, n}})}}));
+        auto gemm = m.insert_instruction(
+            ins, hipsparselt_gemm{weights.get_shape()}, ra, compressed, alloc);
+        m.replace_instruction(ins, make_op("reshape", {{"dims", ins->get_shape().lens()}}), gemm);
+    }
+#else
+    (void)m;
+#endif
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,252 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/split_k.hpp>
+#include <migraphx/gpu/target.hpp>
+#include <migraphx/gpu/time_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/env.hpp>
+#include <iostream>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_SPLIT_K)
+
+// Candidates are powers of 2 up to this
+constexpr std::size_t max_splits = 16;
+// Smallest chunk of k that each partial product is computed over
+constexpr std::size_t min_split_k = 256;
+// Approximate size of the output tile computed by one CU
+constexpr std::size_t tile_size = 64;
+
+// Set while compiling the benchmarks so they are not split again
+static thread_local bool benchmarking = false; // NOLINT
+
+struct gemm_dims
+{
+    std::size_t batch = 1;
+    std::size_t m     = 0;
+    std::size_t n     = 0;
+    std::size_t k     = 0;
+};
+
+static gemm_dims get_gemm_dims(instruction_ref ins)
+{
+    gemm_dims d;
+    auto a_lens = ins->inputs().front()->get_shape().lens();
+    auto b_lens = ins->inputs().back()->get_shape().lens();
+    d.batch =
+        std::accumulate(a_lens.begin(), a_lens.end() - 2, std::size_t{1}, std::multiplies<>{});
+    d.m = a_lens[a_lens.size() - 2];
+    d.k = a_lens.back();
+    d.n = b_lens.back();
+    return d;
+}
+
+static bool is_splittable(instruction_ref ins)
+{
+    if(ins->name() != "dot")
+        return false;
+    if(ins->get_shape().dynamic())
+        return false;
+    if(not contains({shape::float_type, shape::half_type}, ins->get_shape().type()))
+        return false;
+    return get_gemm_dims(ins).k >= 2 * min_split_k;
+}
+
+static std::vector<std::size_t> split_candidates(const gemm_dims& d)
+{
+    std::vector<std::size_t> result;
+    for(std::size_t s = 2; s <= max_splits; s *= 2)
+    {
+        if(d.k % s != 0 or d.k / s < min_split_k)
+            break;
+        result.push_back(s);
+    }
+    return result;
+}
+
+// Pick the most splits that keeps the number of tiles within the number of CUs
+static std::size_t heuristic_splits(const gemm_dims& d, std::size_t cus)
+{
+    auto tiles_m = (d.m + tile_size - 1) / tile_size;
+    auto tiles_n = (d.n + tile_size - 1) / tile_size;
+    auto tiles   = d.batch * tiles_m * tiles_n;
+    if(tiles * 2 > cus)
+        return 1;
+    std::size_t result = 1;
+    for(auto s : split_candidates(d))
+    {
+        if(tiles * s > cus)
+            break;
+        result = s;
+    }
+    return result;
+}
+
+static instruction_ref insert_split_dot(module& m, instruction_ref ins, std::size_t splits)
+{
+    auto a      = ins->inputs().front();
+    auto b      = ins->inputs().back();
+    auto a_lens = a->get_shape().lens();
+    auto b_lens = b->get_shape().lens();
+    auto rank   = a_lens.size();
+    auto k      = a_lens.back();
+
+    // [..., m, k] -> [..., s, m, k/s]
+    std::vector<int64_t> a_dims(a_lens.begin(), a_lens.end() - 1);
+    a_dims.push_back(splits);
+    a_dims.push_back(k / splits);
+    std::vector<int64_t> perm(rank + 1);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::swap(perm[rank - 2], perm[rank - 1]);
+    auto ra = m.insert_instruction(ins, make_op("reshape", {{"dims", a_dims}}), a);
+    auto ta = m.insert_instruction(ins, make_op("transpose", {{"permutation", perm}}), ra);
+
+    // [..., k, n] -> [..., s, k/s, n]
+    std::vector<int64_t> b_dims(b_lens.begin(), b_lens.end() - 2);
+    b_dims.push_back(splits);
+    b_dims.push_back(k / splits);
+    b_dims.push_back(b_lens.back());
+    auto rb = m.insert_instruction(ins, make_op("reshape", {{"dims", b_dims}}), b);
+
+    auto partial = m.insert_instruction(ins, ins->get_operator(), ta, rb);
+    // Sum the partial products in float so only each partial product is rounded to the output
+    // type, not the running sum
+    auto type = ins->get_shape().type();
+    if(type != shape::float_type)
+        partial = m.insert_instruction(
+            ins, make_op("convert", {{"target_type", shape::float_type}}), partial);
+    auto axis = static_cast<int64_t>(rank - 2);
+    auto sum  = m.insert_instruction(ins, make_op("reduce_sum", {{"axes", {axis}}}), partial);
+    if(type != shape::float_type)
+        sum = m.insert_instruction(ins, make_op("convert", {{"target_type", type}}), sum);
+    return m.insert_instruction(ins, make_op("squeeze", {{"axes", {axis}}}), sum);
+}
+
+// Compile and time with a copy of the context being compiled for, so the benchmark runs on the
+// same device and with the same tuning options
+static double benchmark_splits(const context& ctx, instruction_ref ins, std::size_t splits)
+{
+    program p;
+    auto* mm = p.get_main_module();
+    std::vector<instruction_ref> inputs;
+    std::transform(ins->inputs().begin(),
+                   ins->inputs().end(),
+                   std::back_inserter(inputs),
+                   [&](auto input) {
+                       return mm->add_parameter(std::to_string(inputs.size()), input->get_shape());
+                   });
+    auto dot = mm->add_instruction(ins->get_operator(), inputs);
+    if(splits > 1)
+        mm->replace_instruction(dot, insert_split_dot(*mm, dot, splits));
+    migraphx::context gctx = ctx;
+    compile_options options;
+    options.exhaustive_tune = ctx.get_exhaustive_tune_flag();
+    benchmarking            = true;
+    try
+    {
+        run_passes(p, target{}.get_passes(gctx, options));
+    }
+    catch(...)
+    {
+        benchmarking = false;
+        throw;
+    }
+    benchmarking = false;
+    return time_program(ctx, p, 20);
+}
+
+static std::size_t tune_splits(const context& ctx, instruction_ref ins, const gemm_dims& d)
+{
+    std::vector<std::size_t> candidates = {1};
+    auto splits                         = split_candidates(d);
+    candidates.insert(candidates.end(), splits.begin(), splits.end());
+    std::vector<double> times;
+    std::transform(candidates.begin(),
+                   candidates.end(),
+                   std::back_inserter(times),
+                   [&](auto s) { return benchmark_splits(ctx, ins, s); });
+    auto i = std::distance(times.begin(), std::min_element(times.begin(), times.end()));
+    if(enabled(MIGRAPHX_TRACE_SPLIT_K{}))
+    {
+        std::cout << "Split k for " << ins->get_shape() << ":";
+        for(auto j : range(candidates.size()))
+            std::cout << " " << candidates[j] << "=" << times[j] << "ms";
+        std::cout << std::endl;
+    }
+    return candidates[i];
+}
+
+static value split_k_problem(instruction_ref ins)
+{
+    return to_value(to_shapes(ins->inputs()));
+}
+
+void split_k::apply(module& m) const
+{
+    if(benchmarking)
+        return;
+    assert(ctx != nullptr);
+    auto& pc = ctx->get_problem_cache();
+    for(auto ins : iterator_for(m))
+    {
+        if(not is_splittable(ins))
+            continue;
+        auto d             = get_gemm_dims(ins);
+        auto problem       = split_k_problem(ins);
+        std::size_t splits = 1;
+        if(auto sol = pc.get("split_k", problem); sol.has_value() and not sol->is_null())
+        {
+            splits = sol->to<std::size_t>();
+        }
+        else if(ctx->get_exhaustive_tune_flag())
+        {
+            splits = tune_splits(*ctx, ins, d);
+            pc.insert("split_k", problem, splits);
+        }
+        else
+        {
+            splits = heuristic_splits(d, ctx->get_current_device().get_cu_count());
+        }
+        if(enabled(MIGRAPHX_TRACE_SPLIT_K{}))
+            std::cout << "Split k of " << d.k << " in " << splits << " for " << ins->get_shape()
+                      << std::endl;
+        if(splits < 2)
+            continue;
+        m.replace_instruction(ins, insert_split_dot(m, ins, splits));
+    }
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
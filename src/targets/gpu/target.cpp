@@ -32,6 +32,7 @@
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/fuse_concat.hpp>
+#include <migraphx/fuse_horizontal_dots.hpp>
 #include <migraphx/fuse_pointwise_reduce.hpp>
 #include <migraphx/inline_module.hpp>
 #include <migraphx/insert_pad.hpp>
@@ -42,6 +43,7 @@
 #include <migraphx/preallocate_param.hpp>
 #include <migraphx/promote_literals.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/recompute_activations.hpp>
 #include <migraphx/replace_allocate.hpp>
 #include <migraphx/rewrite_gelu.hpp>
 #include <migraphx/rewrite_low_precision.hpp>
@@ -49,26 +51,36 @@
 #include <migraphx/rewrite_reduce.hpp>
 #include <migraphx/rewrite_quantization.hpp>
 #include <migraphx/rewrite_rnn.hpp>
-#include <migraphx/schedule.hpp>
 #include <migraphx/simplify_dyn_ops.hpp>
 #include <migraphx/simplify_qdq.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/split_reduce.hpp>
 #include <migraphx/split_single_dyn_dim.hpp>
+#include <migraphx/stringutils.hpp>
 #include <migraphx/gpu/allocation_model.hpp>
 #include <migraphx/gpu/compile_miopen.hpp>
 #include <migraphx/gpu/compile_ops.hpp>
 #include <migraphx/gpu/concat_gpu_opt.hpp>
 #include <migraphx/gpu/context.hpp>
 #include <migraphx/gpu/device_name.hpp>
+#include <migraphx/gpu/eliminate_fill.hpp>
 #include <migraphx/gpu/fuse_ck.hpp>
+#include <migraphx/gpu/fuse_dequant_dot.hpp>
+#include <migraphx/gpu/fuse_horizontal_pointwise.hpp>
 #include <migraphx/gpu/fuse_mlir.hpp>
 #include <migraphx/gpu/fuse_ops.hpp>
+#include <migraphx/gpu/fuse_small_gemm.hpp>
+#include <migraphx/gpu/hipblaslt.hpp>
+#include <migraphx/gpu/hip_graph.hpp>
 #include <migraphx/gpu/prefuse_ops.hpp>
 #include <migraphx/gpu/lowering.hpp>
-#include <migraphx/gpu/schedule_model.hpp>
+#include <migraphx/gpu/overlap_copy.hpp>
+#include <migraphx/gpu/pack_weights.hpp>
+#include <migraphx/gpu/sparse_gemm.hpp>
+#include <migraphx/gpu/split_k.hpp>
 #include <migraphx/gpu/sync_device.hpp>
 #include <migraphx/gpu/target.hpp>
+#include <migraphx/gpu/tune_schedule.hpp>
 #include <migraphx/gpu/write_literals.hpp>
 
 namespace migraphx {
@@ -76,8 +88,15 @@ inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_SCHEDULE_PASS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_HORIZONTAL_DOT_FUSION)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_HORIZONTAL_POINTWISE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_ELIMINATE_FILL)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_SPARSE_GEMM)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_PACK_WEIGHTS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_SPLIT_K)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_SPLIT_REDUCE)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_NHWC)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_LAYOUT_SELECTION)
 #ifndef _WIN32
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_ENABLE_CK)
 #endif
@@ -87,18 +106,27 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
     auto& ctx = any_cast<context>(gctx);
     ctx.set_exhaustive_tune_flag(options.exhaustive_tune);
     ctx.load_problem_cache();
+    ctx.get_kernel_costs().load();
     std::set<shape::type_t> unsupported_types(shape::types().begin(), shape::types().end());
     unsupported_types.erase(shape::type_t::float_type);
     unsupported_types.erase(shape::type_t::fp8e4m3fnuz_type);
     unsupported_types.erase(shape::type_t::fp8e4m3fn_type);
     unsupported_types.erase(shape::type_t::fp8e5m2_type);
     unsupported_types.erase(shape::type_t::half_type);
+    unsupported_types.erase(shape::type_t::bf16_type);
     unsupported_types.erase(shape::type_t::bool_type);
     unsupported_types.erase(shape::type_t::int8_type);
     unsupported_types.erase(shape::type_t::uint8_type);
     unsupported_types.erase(shape::type_t::int32_type);
     unsupported_types.erase(shape::type_t::tuple_type);
 
+    // The native attention kernel is only a fallback for when neither MLIR nor CK compile
+    // attention, and it targets the gfx9 and newer devices
+    const auto& device_name     = ctx.get_current_device().get_gfx_name();
+    const bool native_attention = not mlir_enabled() and not enabled(MIGRAPHX_ENABLE_CK{}) and
+                                  (starts_with(device_name, "gfx9") or
+                                   starts_with(device_name, "gfx1"));
+
     // whiltelist supported Ops for the FP8 types
     // different between fp8e4m3fnuz and OCP types because rocBLAS only has
     // support for fp8e4m3fnuz
@@ -108,49 +136,49 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         unsupported_fp8e4m3fnuz_ops.insert("dot");
         unsupported_fp8e4m3fnuz_ops.insert("quant_dot");
     }
-#if MIGRAPHX_USE_MIOPEN
-    // MIOpen doesn't have support for fp8 pooling yet.
-    unsupported_fp8e4m3fnuz_ops.insert("pooling");
-#endif
     if(not gpu::gfx_has_fp8fnuz_intrinsics())
     {
         unsupported_fp8e4m3fnuz_ops.insert("convolution");
         unsupported_fp8e4m3fnuz_ops.insert("quant_convolution");
     }
     // add all device kernels
-    unsupported_fp8e4m3fnuz_ops.insert("logsoftmax");
     unsupported_fp8e4m3fnuz_ops.insert("nonzero");
     unsupported_fp8e4m3fnuz_ops.insert("prefix_scan_sum");
     unsupported_fp8e4m3fnuz_ops.insert("scatter_none");
     unsupported_fp8e4m3fnuz_ops.insert("topk");
-    unsupported_fp8e4m3fnuz_ops.insert("rnn_var_sl_shift_output");
     unsupported_fp8e4m3fnuz_ops.insert("multinomial");
-    unsupported_fp8e4m3fnuz_ops.insert("argmax");
-    unsupported_fp8e4m3fnuz_ops.insert("argmin");
 
     std::set<std::string> unsupported_fp8ocp_ops = {};
-    // TODO update with hipBLASLt support
-    unsupported_fp8ocp_ops.insert("dot");
-    unsupported_fp8ocp_ops.insert("quant_dot");
-#if MIGRAPHX_USE_MIOPEN
-    // MIOpen doesn't have support for fp8 pooling yet.
-    unsupported_fp8ocp_ops.insert("pooling");
+#if MIGRAPHX_USE_HIPBLASLT
+    if(not gpu::hipblaslt_fp8ocp_supported())
 #endif
+    {
+        unsupported_fp8ocp_ops.insert("dot");
+        unsupported_fp8ocp_ops.insert("quant_dot");
+    }
     if(not gpu::gfx_has_fp8ocp_intrinsics())
     {
         unsupported_fp8ocp_ops.insert("convolution");
         unsupported_fp8ocp_ops.insert("quant_convolution");
     }
     // add all device kernels
-    unsupported_fp8ocp_ops.insert("logsoftmax");
     unsupported_fp8ocp_ops.insert("nonzero");
     unsupported_fp8ocp_ops.insert("prefix_scan_sum");
     unsupported_fp8ocp_ops.insert("scatter_none");
     unsupported_fp8ocp_ops.insert("topk");
-    unsupported_fp8ocp_ops.insert("rnn_var_sl_shift_output");
     unsupported_fp8ocp_ops.insert("multinomial");
-    unsupported_fp8ocp_ops.insert("argmax");
-    unsupported_fp8ocp_ops.insert("argmin");
+
+    // bf16 runs natively in the jit kernels, rocBLAS, hipBLASLt and MLIR, only the device
+    // kernels need to fall back to float
+    std::set<std::string> unsupported_bf16_ops = {};
+#if MIGRAPHX_USE_MIOPEN
+    unsupported_bf16_ops.insert("lrn");
+#endif
+    // add all device kernels
+    unsupported_bf16_ops.insert("nonzero");
+    unsupported_bf16_ops.insert("prefix_scan_sum");
+    unsupported_bf16_ops.insert("scatter_none");
+    unsupported_bf16_ops.insert("topk");
 
     // clang-format off
     return
@@ -162,37 +190,57 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         normalize_ops{},
         dead_code_elimination{},
         simplify_qdq{},
+        // MLIR fuses the dequantization of the weights into its own gemms
+        enable_pass(not mlir_enabled(), fuse_dequant_dot{}),
+        dead_code_elimination{},
         enable_pass(not mlir_enabled(), rewrite_quantization{}),
         dead_code_elimination{},
-        // workaround for rocBLAS unsupported error when using uint8 in quant_dot, quant_convolution & pooling
-        eliminate_data_type{{migraphx::shape::uint8_type}, shape::float_type, {"quant_convolution", "quant_dot", "pooling"}},
+        // workaround for rocBLAS unsupported error when using uint8 in quant_dot & quant_convolution
+        eliminate_data_type{{migraphx::shape::uint8_type}, shape::float_type, {"quant_convolution", "quant_dot"}},
         eliminate_data_type{unsupported_types, shape::type_t::float_type},
         simplify_reshapes{},
         eliminate_identity{},
         eliminate_pad{},
         dead_code_elimination{},
-        insert_pad{{"convolution"}},
-        dead_code_elimination{},
-        rewrite_rnn{},
+        rewrite_rnn{true},
         dead_code_elimination{},
         inline_module{},
-        rewrite_pooling{},
+        // The jit pooling handles dilations directly
+        rewrite_pooling{.rewrite_dilations = false},
         dead_code_elimination{},
         rewrite_gelu{options.fast_math},
         optimize_module{},
-        enable_pass(enabled(MIGRAPHX_ENABLE_NHWC{}), layout_nhwc{}),
+        // Pick nhwc per region of convolutions unless every convolution is forced to nhwc
+        enable_pass(enabled(MIGRAPHX_ENABLE_NHWC{}) or
+                        not enabled(MIGRAPHX_DISABLE_LAYOUT_SELECTION{}),
+                    layout_nhwc{not enabled(MIGRAPHX_ENABLE_NHWC{})}),
+        dead_code_elimination{},
+        prefuse_ops{.enable_native_attention = native_attention},
+        dead_code_elimination{},
+        enable_pass(not enabled(MIGRAPHX_DISABLE_HORIZONTAL_DOT_FUSION{}), fuse_horizontal_dots{}),
+        dead_code_elimination{},
+        enable_pass(not enabled(MIGRAPHX_DISABLE_SPARSE_GEMM{}), sparse_gemm{&ctx}),
         dead_code_elimination{},
-        prefuse_ops{},
+        // MLIR has its own split-k for the dots it compiles
+        enable_pass(not mlir_enabled() and not enabled(MIGRAPHX_DISABLE_SPLIT_K{}), split_k{&ctx}),
         dead_code_elimination{},
         eliminate_data_type{{migraphx::shape::fp8e4m3fnuz_type}, shape::float_type, unsupported_fp8e4m3fnuz_ops},
         eliminate_data_type{{migraphx::shape::fp8e4m3fn_type, migraphx::shape::fp8e5m2_type}, shape::float_type, unsupported_fp8ocp_ops},
+        eliminate_data_type{{migraphx::shape::bf16_type}, shape::float_type, unsupported_bf16_ops},
         dead_code_elimination{},
         rewrite_reduce{},
         rewrite_low_precision{},
         dead_code_elimination{},
         optimize_module{},
         fuse_pointwise_reduce{},
-        enable_pass(enabled(MIGRAPHX_ENABLE_SPLIT_REDUCE{}), split_reduce{}),
+        // Only split reductions with fewer outputs than it takes to fill the device with blocks.
+        // The groups are combined with atomics, so the result is not deterministic and it stays
+        // opt-in
+        enable_pass(enabled(MIGRAPHX_ENABLE_SPLIT_REDUCE{}),
+                    split_reduce{.max_outputs = 2 * ctx.get_current_device().get_cu_count()}),
+        dead_code_elimination{},
+        // MLIR and CK fuse the pointwise modules around their own gemms
+        enable_pass(not mlir_enabled() and not enabled(MIGRAPHX_ENABLE_CK{}), fuse_small_gemm{}),
         dead_code_elimination{},
 #ifndef _WIN32
         enable_pass(enabled(MIGRAPHX_ENABLE_CK{}), fuse_ck{}),
@@ -200,10 +248,16 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         dead_code_elimination{},
         enable_pass(mlir_enabled(), fuse_mlir{&ctx}),
         dead_code_elimination{},
+        // MLIR takes asymmetric padding directly, so only the convolutions left for MIOpen need
+        // an explicit pad
+        insert_pad{{"convolution"}},
+        dead_code_elimination{},
         fuse_concat{},
         dead_code_elimination{},
         auto_contiguous{},
         dead_code_elimination{},
+        enable_pass(options.memory_budget > 0, recompute_activations{options.memory_budget}),
+        dead_code_elimination{},
         lowering{&ctx, options.offload_copy},
         eliminate_contiguous{"gpu::contiguous"},
         dead_code_elimination{},
@@ -216,17 +270,24 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         dead_code_elimination{},
         fuse_ops{&ctx, options.fast_math},
         dead_code_elimination{},
+        enable_pass(not enabled(MIGRAPHX_DISABLE_HORIZONTAL_POINTWISE{}), fuse_horizontal_pointwise{}),
+        dead_code_elimination{},
         replace_allocate{gpu_allocation_model{}, options.offload_copy},
         dead_code_elimination{},
         adjust_allocation{gpu_allocation_model{}},
         dead_code_elimination{},
-        compile_ops{&ctx, options.exhaustive_tune},
+        compile_ops{&ctx, options.exhaustive_tune, options.background_tune, options.lazy_compile},
+        dead_code_elimination{},
+        enable_pass(not enabled(MIGRAPHX_DISABLE_PACK_WEIGHTS{}), pack_weights{}),
         dead_code_elimination{},
         promote_literals{},
         dead_code_elimination{},
-        write_literals{&ctx},
-        schedule{gpu::schedule_model{ctx.get_current_device().nstreams()}, not enabled(MIGRAPHX_DISABLE_SCHEDULE_PASS{})},
+        write_literals{&ctx, options.weight_budget},
+        tune_schedule{&ctx, not enabled(MIGRAPHX_DISABLE_SCHEDULE_PASS{})},
+        enable_pass((options.offload_copy or options.weight_budget > 0) and not options.capture_graph,
+                    overlap_copy{&ctx}),
         memory_coloring{"hip::allocate"},
+        enable_pass(not enabled(MIGRAPHX_DISABLE_ELIMINATE_FILL{}), eliminate_fill{}),
         sync_device{},
         preallocate_param{"scratch", gpu_allocation_model{}},
         dead_code_elimination{},
@@ -234,20 +295,42 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         check_context<context>{},
         normalize_ops{},
         dead_code_elimination{},
-        eliminate_identity{}
+        eliminate_identity{},
+        enable_pass(options.capture_graph, capture_hip_graph{}),
+        dead_code_elimination{}
     };
     // clang-format on
 }
 
 std::string target::name() const { return "gpu"; }
 
-migraphx::context target::get_context() const { return context(gpu::get_device_id()); }
+migraphx::context target::get_context() const
+{
+    return context(device_id.value_or(gpu::get_device_id()));
+}
 
-argument target::copy_to(const argument& arg) const { return gpu::to_gpu(arg); }
+argument target::copy_to(const argument& arg) const
+{
+    if(has_value(device_id))
+        set_device(*device_id);
+    return gpu::to_gpu(arg);
+}
 
 argument target::copy_from(const argument& arg) const { return gpu::from_gpu(arg); }
 
-argument target::allocate(const shape& s) const { return gpu::allocate_gpu(s); }
+argument target::allocate(const shape& s) const
+{
+    if(has_value(device_id))
+        set_device(*device_id);
+    return gpu::allocate_gpu(s);
+}
+
+argument target::allocate_pinned(const shape& s) const
+{
+    if(has_value(device_id))
+        set_device(*device_id);
+    return gpu::allocate_pinned(s);
+}
 
 MIGRAPHX_REGISTER_TARGET(target);
 
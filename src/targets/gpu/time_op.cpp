@@ -28,11 +28,20 @@
 #include <migraphx/generate.hpp>
 #include <migraphx/time.hpp>
 #include <migraphx/gpu/hip.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/functional.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace gpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_BENCHMARK_FLUSH_CACHE)
+
 std::vector<argument> generate_arguments(const std::vector<shape>& shapes,
                                          unsigned long seed = 0,
                                          random_mode rm     = random_mode::random)
@@ -44,21 +53,150 @@ std::vector<argument> generate_arguments(const std::vector<shape>& shapes,
     return args;
 }
 
-template <class F>
-double time_loop(migraphx::gpu::context& gctx, int n, F f)
+double timing::median() const
+{
+    if(samples.empty())
+        return 0;
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto n = sorted.size();
+    if(n % 2 == 1)
+        return sorted[n / 2];
+    return (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+double timing::trimmed_mean() const
+{
+    if(samples.empty())
+        return 0;
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto trim = sorted.size() / 10;
+    return std::accumulate(sorted.begin() + trim, sorted.end() - trim, 0.0) /
+           (sorted.size() - 2 * trim);
+}
+
+std::pair<double, double> timing::confidence_interval() const
+{
+    if(samples.empty())
+        return {0, 0};
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    // The rank of the median is binomial, which is close to a normal distribution with a
+    // standard deviation of sqrt(n)/2
+    double n    = sorted.size();
+    double half = 1.96 * std::sqrt(n) / 2;
+    auto lo     = std::max(std::floor(n / 2 - half), 0.0);
+    auto hi     = std::min(std::ceil(n / 2 + half), n - 1);
+    return {sorted[std::size_t(lo)], sorted[std::size_t(hi)]};
+}
+
+// Writes over a buffer twice the size of the L2 cache so a run doesn't find its data cached by
+// the run before it
+struct cache_flusher
 {
-    auto start = context::create_event_for_timing();
-    auto stop  = context::create_event_for_timing();
-    f();
-    gctx.get_stream().record(start.get());
-    for(auto i : range(n))
+    argument buffer;
+    int value = 0;
+
+    cache_flusher()
+    {
+        int device  = 0;
+        int l2      = 0;
+        auto status = hipGetDevice(&device);
+        if(status == hipSuccess)
+            status = hipDeviceGetAttribute(&l2, hipDeviceAttributeL2CacheSize, device);
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to get the L2 cache size: " + hip_error(status));
+        std::size_t bytes = std::max(2 * l2, 1);
+        buffer            = allocate_gpu(shape{shape::int8_type, {bytes}});
+    }
+
+    void flush(context& ctx)
+    {
+        value       = (value + 1) % 256;
+        auto status = hipMemsetAsync(
+            buffer.data(), value, buffer.get_shape().bytes(), ctx.get_stream().get());
+        if(status != hipSuccess)
+            MIGRAPHX_THROW("Failed to flush the cache: " + hip_error(status));
+    }
+};
+
+std::vector<timing> time_interleaved(context& ctx,
+                                     const std::vector<std::function<void()>>& runs,
+                                     const benchmark_options& options)
+{
+    bool flush        = options.flush_cache or enabled(MIGRAPHX_BENCHMARK_FLUSH_CACHE{});
+    std::size_t batch = flush ? 1 : std::max<std::size_t>(options.batch, 1);
+    optional<cache_flusher> flusher;
+    if(flush)
+        flusher.emplace();
+    auto start  = context::create_event_for_timing();
+    auto stop   = context::create_event_for_timing();
+    auto sample = [&](const std::function<void()>& f) {
+        if(flusher)
+            flusher->flush(ctx);
+        ctx.get_stream().record(start.get());
+        for(auto i : range(batch))
+        {
+            (void)i;
+            f();
+        }
+        ctx.get_stream().record(stop.get());
+        ctx.finish();
+        return context::get_elapsed_ms(start.get(), stop.get()) / batch;
+    };
+    // The first runs load code objects and raise the clocks, so each run is warmed up until two
+    // samples in a row are within 5% of each other
+    const std::size_t max_warmup = 10;
+    for(const auto& f : runs)
+    {
+        double last = sample(f);
+        for(auto i : range(max_warmup))
+        {
+            (void)i;
+            auto t = sample(f);
+            if(std::abs(t - last) <= 0.05 * std::max(t, last))
+                break;
+            last = t;
+        }
+    }
+    std::vector<timing> result(runs.size());
+    std::vector<std::size_t> active(runs.size());
+    std::iota(active.begin(), active.end(), 0);
+    auto max_samples = std::max(options.max_samples, options.min_samples);
+    for(auto n : range(max_samples))
     {
-        (void)i;
-        f();
+        for(auto i : active)
+            result[i].samples.push_back(sample(runs[i]));
+        if(n + 1 < options.min_samples or active.size() < 2)
+            continue;
+        // Stop timing the runs that are slower than the fastest one with confidence
+        auto fastest = *std::min_element(
+            active.begin(), active.end(), by(std::less<>{}, [&](auto i) {
+                return result[i].median();
+            }));
+        auto bound = result[fastest].confidence_interval().second;
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [&](auto i) {
+                                        return i != fastest and
+                                               result[i].confidence_interval().first > bound;
+                                    }),
+                     active.end());
+        if(active.size() < 2)
+            break;
     }
-    gctx.get_stream().record(stop.get());
-    gctx.finish();
-    return context::get_elapsed_ms(start.get(), stop.get()) / n;
+    return result;
+}
+
+static double time_loop(migraphx::gpu::context& gctx, int n, const std::function<void()>& f)
+{
+    // The runs are split into about 10 samples so the median isn't thrown off by a slow one
+    benchmark_options options;
+    options.batch       = std::max(n / 10, 1);
+    options.min_samples = std::max<std::size_t>(n / options.batch, 1);
+    options.max_samples = options.min_samples;
+    return time_interleaved(gctx, {f}, options).front().median();
 }
 
 double time_op(const context& ictx, operation op, const std::vector<shape>& inputs, int n)
@@ -79,23 +217,51 @@ double time_op(const context& ictx, operation op, int n)
     return time_op(ictx, op, inputs, n);
 }
 
-double time_program(const context& ictx, program p, int n)
+// Finalizes the program and generates its parameters, returning a function that runs it once
+static std::function<void()> prepare_program(const context& ictx, program p)
 {
-    std::vector<migraphx::context> ctx_vec = {ictx};
-    auto& gctx                             = any_cast<migraphx::gpu::context>(ctx_vec.front());
-    auto* mm                               = p.get_main_module();
-    mm->finalize(ctx_vec);
-    auto in_shapes = p.get_parameter_shapes();
-    std::unordered_map<std::string, migraphx::argument> param_map;
-    unsigned long seed = 0;
-    for(const auto& [name, shape] : in_shapes)
+    struct state
     {
-        param_map[name] = to_gpu(generate_argument(shape, seed++, random_mode::random));
-    }
-    auto run = [&] { p.eval_with_context(ctx_vec, param_map); };
+        std::vector<migraphx::context> ctx_vec;
+        program p;
+        parameter_map params;
+    };
+    auto s     = std::make_shared<state>();
+    s->ctx_vec = {ictx};
+    s->p       = std::move(p);
+    s->p.get_main_module()->finalize(s->ctx_vec);
+    unsigned long seed = 0;
+    for(const auto& [name, shape] : s->p.get_parameter_shapes())
+        s->params[name] = to_gpu(generate_argument(shape, seed++, random_mode::random));
+    return [s] { s->p.eval_with_context(s->ctx_vec, s->params); };
+}
+
+double time_program(const context& ictx, program p, int n)
+{
+    auto run              = prepare_program(ictx, std::move(p));
+    migraphx::context ctx = ictx;
+    auto& gctx            = any_cast<migraphx::gpu::context>(ctx);
     return time_loop(gctx, n, run);
 }
 
+std::vector<double>
+time_programs(const context& ictx, std::vector<program> ps, const benchmark_options& options)
+{
+    std::vector<std::function<void()>> runs;
+    std::transform(ps.begin(), ps.end(), std::back_inserter(runs), [&](auto& p) {
+        return prepare_program(ictx, std::move(p));
+    });
+    migraphx::context ctx = ictx;
+    auto& gctx            = any_cast<migraphx::gpu::context>(ctx);
+    auto timings          = time_interleaved(gctx, runs, options);
+    std::vector<double> result;
+    std::transform(timings.begin(),
+                   timings.end(),
+                   std::back_inserter(result),
+                   [](const timing& t) { return t.median(); });
+    return result;
+}
+
 } // namespace gpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
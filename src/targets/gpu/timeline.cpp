@@ -0,0 +1,288 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/timeline.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/functional.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/json.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+struct timeline::impl
+{
+    struct pending
+    {
+        std::string name;
+        operation op;
+        std::vector<shape> inputs;
+        value counters;
+        std::size_t stream = 0;
+        std::size_t start  = 0;
+        std::size_t stop   = 0;
+    };
+
+    context* ctx = nullptr;
+    std::vector<hip_event_ptr> pool;
+    std::size_t used = 0;
+    hip_event_ptr begin;
+    std::vector<pending> recorded;
+    std::vector<std::size_t> open;
+    std::vector<entry> entries;
+
+    // Record an event on the current stream and return its index in the pool
+    std::size_t record()
+    {
+        if(used == pool.size())
+            pool.push_back(context::create_event_for_timing());
+        ctx->get_stream().record(pool[used].get());
+        return used++;
+    }
+};
+
+// Instructions that do not launch any work on the device
+static bool is_skipped(instruction_ref ins)
+{
+    if(starts_with(ins->name(), "@"))
+        return true;
+    return contains({"load",
+                     "gpu::set_stream",
+                     "gpu::record_event",
+                     "gpu::wait_event",
+                     "hip::hip_allocate_memory",
+                     "hip::hip_copy_literal"},
+                    ins->name());
+}
+
+static std::string timeline_name(const value& attr, instruction_ref ins)
+{
+    if(attr.contains("group"))
+        return attr.at("group").to<std::string>();
+    return ins->name();
+}
+
+timeline::timeline(context& ctx) : pimpl(std::make_shared<impl>())
+{
+    pimpl->ctx   = &ctx;
+    pimpl->begin = context::create_event_for_timing();
+}
+
+void timeline::mark_start(const program&)
+{
+    pimpl->used = 0;
+    pimpl->recorded.clear();
+    pimpl->open.clear();
+    pimpl->entries.clear();
+    pimpl->ctx->get_stream(0).record(pimpl->begin.get());
+}
+
+void timeline::mark_start(instruction_ref ins)
+{
+    if(is_skipped(ins))
+        return;
+    auto& device  = pimpl->ctx->get_current_device();
+    auto attr     = ins->get_operator().attributes();
+    auto counters = attr.contains("counters") ? attr.at("counters") : value::object{};
+    pimpl->open.push_back(pimpl->recorded.size());
+    pimpl->recorded.push_back({timeline_name(attr, ins),
+                               ins->get_operator(),
+                               to_shapes(ins->inputs()),
+                               counters,
+                               device.stream_id(),
+                               pimpl->record(),
+                               0});
+}
+
+void timeline::mark_stop(instruction_ref ins)
+{
+    if(is_skipped(ins))
+        return;
+    if(pimpl->open.empty())
+        MIGRAPHX_THROW("TIMELINE: stop marker without a start for " + ins->name());
+    pimpl->recorded[pimpl->open.back()].stop = pimpl->record();
+    pimpl->open.pop_back();
+}
+
+void timeline::mark_stop(const program&)
+{
+    auto& device = pimpl->ctx->get_current_device();
+    for(std::size_t i = 0; i < device.nstreams(); i++)
+        device.get_stream(i).wait();
+    auto* begin = pimpl->begin.get();
+    std::transform(pimpl->recorded.begin(),
+                   pimpl->recorded.end(),
+                   std::back_inserter(pimpl->entries),
+                   [&](const auto& r) {
+                       entry e;
+                       e.name     = r.name;
+                       e.stream   = r.stream;
+                       e.counters = r.counters;
+                       e.start    = context::get_elapsed_ms(begin, pimpl->pool[r.start].get());
+                       e.end      = context::get_elapsed_ms(begin, pimpl->pool[r.stop].get());
+                       return e;
+                   });
+    // Feed the measured times back so a later compile can schedule with them
+    auto& costs = pimpl->ctx->get_kernel_costs();
+    for(std::size_t i = 0; i < pimpl->recorded.size(); i++)
+    {
+        const auto& r = pimpl->recorded[i];
+        costs.insert(r.op, r.inputs, pimpl->entries[i].end - pimpl->entries[i].start);
+    }
+    std::sort(pimpl->entries.begin(), pimpl->entries.end(), by(std::less<>{}, [](const auto& e) {
+                  return e.start;
+              }));
+}
+
+const std::vector<timeline::entry>& timeline::entries() const { return pimpl->entries; }
+
+static std::string json_escape(const std::string& s)
+{
+    std::string result;
+    for(char c : s)
+    {
+        if(c == '"' or c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+void timeline::write_trace(std::ostream& os) const
+{
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[" << std::endl;
+    std::set<std::size_t> streams;
+    std::transform(pimpl->entries.begin(),
+                   pimpl->entries.end(),
+                   std::inserter(streams, streams.end()),
+                   [](const auto& e) { return e.stream; });
+    for(auto s : streams)
+    {
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << s
+           << ",\"args\":{\"name\":\"stream " << s << "\"}}," << std::endl;
+    }
+    for(std::size_t i = 0; i < pimpl->entries.size(); i++)
+    {
+        const auto& e = pimpl->entries[i];
+        // Chrome traces are in microseconds
+        os << "{\"name\":\"" << json_escape(e.name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+           << e.stream << ",\"ts\":" << e.start * 1000.0
+           << ",\"dur\":" << (e.end - e.start) * 1000.0;
+        if(not e.counters.empty())
+            os << ",\"args\":" << to_json_string(e.counters);
+        os << "}";
+        if(i + 1 < pimpl->entries.size())
+            os << ",";
+        os << std::endl;
+    }
+    os << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+// Total length of the union of the intervals
+static double busy_time(std::vector<std::pair<double, double>> intervals)
+{
+    std::sort(intervals.begin(), intervals.end());
+    double total = 0;
+    double end   = std::numeric_limits<double>::lowest();
+    for(auto [s, e] : intervals)
+    {
+        s = std::max(s, end);
+        if(e > s)
+            total += e - s;
+        end = std::max(end, e);
+    }
+    return total;
+}
+
+void timeline::print_summary(std::ostream& os) const
+{
+    const auto& entries = pimpl->entries;
+    if(entries.empty())
+        return;
+    std::map<std::size_t, std::vector<std::pair<double, double>>> stream_intervals;
+    std::vector<std::pair<double, int>> edges;
+    double first = std::numeric_limits<double>::max();
+    double last  = std::numeric_limits<double>::lowest();
+    for(const auto& e : entries)
+    {
+        stream_intervals[e.stream].emplace_back(e.start, e.end);
+        first = std::min(first, e.start);
+        last  = std::max(last, e.end);
+    }
+    double span       = last - first;
+    double total_busy = 0;
+    os << "Timeline: " << entries.size() << " instructions over " << span << "ms" << std::endl;
+    for(auto&& [stream, intervals] : stream_intervals)
+    {
+        auto busy = busy_time(intervals);
+        total_busy += busy;
+        os << "    stream " << stream << ": " << intervals.size() << " instructions, " << busy
+           << "ms busy";
+        if(span > 0)
+            os << " (" << std::round(100.0 * busy / span) << "%)";
+        os << std::endl;
+        // Count each stream at most once while it is busy
+        std::sort(intervals.begin(), intervals.end());
+        double end = std::numeric_limits<double>::lowest();
+        for(auto [s, e] : intervals)
+        {
+            s = std::max(s, end);
+            if(e > s)
+            {
+                edges.emplace_back(s, 1);
+                edges.emplace_back(e, -1);
+            }
+            end = std::max(end, e);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    double overlap = 0;
+    int active     = 0;
+    double prev    = first;
+    for(auto [t, d] : edges)
+    {
+        if(active > 1)
+            overlap += t - prev;
+        active += d;
+        prev = t;
+    }
+    if(span > 0)
+        os << "Concurrency: " << total_busy / span << " streams on average, " << overlap
+           << "ms with more than one stream busy" << std::endl;
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/tune_schedule.hpp>
+#include <migraphx/gpu/schedule_model.hpp>
+#include <migraphx/gpu/time_op.hpp>
+#include <migraphx/memory_coloring.hpp>
+#include <migraphx/schedule.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/digest.hpp>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_TUNE_SCHEDULE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TUNE_STREAMS_LIMIT)
+
+static schedule_model make_model(const context& ctx, std::size_t streams)
+{
+    return schedule_model{streams, &ctx.get_kernel_costs()};
+}
+
+// Powers of 2 up to the limit, which defaults to 4 streams
+static std::vector<std::size_t> stream_candidates()
+{
+    auto limit = value_of(MIGRAPHX_TUNE_STREAMS_LIMIT{}, 4);
+    std::vector<std::size_t> result;
+    for(std::size_t n = 1; n <= std::max<std::size_t>(limit, 1); n *= 2)
+        result.push_back(n);
+    return result;
+}
+
+static double benchmark_streams(context& ctx, const module& m, std::size_t streams)
+{
+    program p;
+    auto* mm = p.get_main_module();
+    *mm      = m;
+    schedule{make_model(ctx, streams)}.apply(*mm);
+    memory_coloring{"hip::allocate"}.apply(*mm);
+    // The copy of the context shares its device, which has to own every stream that is used
+    ctx.get_current_device().reserve_streams(streams);
+    auto t = time_program(ctx, p, 20);
+    ctx.set_stream(0);
+    return t;
+}
+
+static std::size_t tune_streams(context& ctx, const module& m)
+{
+    auto candidates = stream_candidates();
+    std::vector<double> times;
+    std::transform(candidates.begin(),
+                   candidates.end(),
+                   std::back_inserter(times),
+                   [&](auto n) { return benchmark_streams(ctx, m, n); });
+    auto i = std::distance(times.begin(), std::min_element(times.begin(), times.end()));
+    if(enabled(MIGRAPHX_TRACE_TUNE_SCHEDULE{}))
+    {
+        std::cout << "Streams for " << m.name() << ":";
+        for(auto j : range(candidates.size()))
+            std::cout << " " << candidates[j] << "=" << times[j] << "ms";
+        std::cout << std::endl;
+    }
+    return candidates[i];
+}
+
+value tune_schedule::problem(const module& m)
+{
+    std::stringstream ss;
+    ss << m;
+    digest d;
+    d.update(ss.str());
+    return {{"instructions", m.size()}, {"hash", d.str()}};
+}
+
+void tune_schedule::apply(module& m) const
+{
+    if(not enable)
+        return;
+    assert(ctx != nullptr);
+    auto& pc             = ctx->get_problem_cache();
+    auto p               = problem(m);
+    std::size_t nstreams = ctx->get_current_device().nstreams();
+    if(auto sol = pc.get("schedule", p); sol.has_value() and not sol->is_null())
+    {
+        nstreams = sol->to<std::size_t>();
+    }
+    else if(ctx->get_exhaustive_tune_flag())
+    {
+        nstreams = tune_streams(*ctx, m);
+        pc.insert("schedule", p, nstreams);
+    }
+    if(enabled(MIGRAPHX_TRACE_TUNE_SCHEDULE{}))
+        std::cout << "Schedule " << m.name() << " over " << nstreams << " streams" << std::endl;
+    ctx->get_current_device().reserve_streams(nstreams);
+    schedule{make_model(*ctx, nstreams)}.apply(m);
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,238 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/tuning_bundle.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/hipblaslt.hpp>
+#include <migraphx/gpu/miopen.hpp>
+#include <migraphx/gpu/rocblas.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/reflect.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/version.h>
+#include <algorithm>
+#include <fstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace gpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PROBLEM_CACHE)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_MLIR_TUNING_DB)
+
+struct tuning_entry
+{
+    value target;
+    std::unordered_map<value, value> problem_cache;
+    std::vector<std::string> mlir_tuning_db;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.target, "target"),
+                    f(self.problem_cache, "problem_cache"),
+                    f(self.mlir_tuning_db, "mlir_tuning_db"));
+    }
+};
+
+struct tuning_bundle
+{
+    std::size_t version = 1;
+    std::vector<tuning_entry> entries;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.version, "version"), f(self.entries, "entries"));
+    }
+};
+
+static std::string version_string(std::size_t major, std::size_t minor, std::size_t patch)
+{
+    return std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch);
+}
+
+// The versions of the libraries that are loaded, which can differ from the
+// ones MIGraphX was built with
+static value get_library_versions()
+{
+    value result = {{"migraphx",
+                     version_string(
+                         MIGRAPHX_VERSION_MAJOR, MIGRAPHX_VERSION_MINOR, MIGRAPHX_VERSION_PATCH)}};
+    int hip_version = 0;
+    if(hipRuntimeGetVersion(&hip_version) == hipSuccess)
+        result["hip"] = std::to_string(hip_version);
+#if MIGRAPHX_USE_MIOPEN
+    std::size_t major = 0;
+    std::size_t minor = 0;
+    std::size_t patch = 0;
+    if(miopenGetVersion(&major, &minor, &patch) == miopenStatusSuccess)
+        result["miopen"] = version_string(major, minor, patch);
+#endif
+#if MIGRAPHX_USE_ROCBLAS
+    std::size_t size = 0;
+    if(rocblas_get_version_string_size(&size) == rocblas_status_success)
+    {
+        std::string rocblas_version(size, '\0');
+        rocblas_get_version_string(rocblas_version.data(), size);
+        result["rocblas"] = std::string(rocblas_version.c_str());
+    }
+#endif
+#if MIGRAPHX_USE_HIPBLASLT
+    if(hipblaslt_supported())
+    {
+        auto handle = create_hipblaslt_handle_ptr();
+        int version = 0;
+        hipblaslt_invoke([&] { return hipblasLtGetVersion(handle.get(), &version); });
+        result["hipblaslt"] = std::to_string(version);
+    }
+#endif
+    return result;
+}
+
+value get_tuning_target(const context& ctx)
+{
+    const auto& device = ctx.get_current_device();
+    return {{"gfx", device.get_gfx_name()},
+            {"cu", device.get_cu_count()},
+            {"versions", get_library_versions()}};
+}
+
+static tuning_bundle load_tuning_bundle(const fs::path& bundle_path)
+{
+    tuning_bundle bundle;
+    if(not fs::exists(bundle_path))
+        return bundle;
+    from_value(from_json_string(read_string(bundle_path)), bundle);
+    if(bundle.version != tuning_bundle{}.version)
+        MIGRAPHX_THROW("Unsupported tuning bundle version " + std::to_string(bundle.version) +
+                       ": " + bundle_path.string());
+    return bundle;
+}
+
+static std::vector<tuning_entry>::iterator find_entry(tuning_bundle& bundle, const value& target)
+{
+    return std::find_if(bundle.entries.begin(), bundle.entries.end(), [&](const tuning_entry& e) {
+        return e.target == target;
+    });
+}
+
+// The lines of the MLIR tuning db start with the arch and the number of CUs
+static bool is_mlir_tuning_line_for(const std::string& line, const value& target)
+{
+    auto tokens = split_string(line, '\t');
+    if(tokens.size() < 4)
+        return false;
+    auto arch = trim(split_string(tokens[0], ':').front());
+    return arch == target.at("gfx").to<std::string>() and
+           tokens[1] == std::to_string(target.at("cu").to<std::size_t>());
+}
+
+static std::vector<std::string> read_mlir_tuning_db(const fs::path& db_path)
+{
+    std::vector<std::string> lines;
+    std::ifstream is(db_path);
+    std::string line;
+    while(std::getline(is, line))
+    {
+        if(not trim(line).empty())
+            lines.push_back(line);
+    }
+    return lines;
+}
+
+void export_tuning_bundle(context& ctx, const fs::path& bundle_path)
+{
+    auto target = get_tuning_target(ctx);
+    auto bundle = load_tuning_bundle(bundle_path);
+    auto it     = find_entry(bundle, target);
+    if(it == bundle.entries.end())
+    {
+        bundle.entries.push_back({target, {}, {}});
+        it = std::prev(bundle.entries.end());
+    }
+    // The new results replace the old results for the same problem
+    for(auto&& [key, solution] : ctx.get_problem_cache().solutions())
+        it->problem_cache[key] = solution;
+
+    auto mlir_db_path = string_value_of(MIGRAPHX_MLIR_TUNING_DB{});
+    if(not mlir_db_path.empty())
+    {
+        for(auto&& line : read_mlir_tuning_db(mlir_db_path))
+        {
+            if(is_mlir_tuning_line_for(line, target) and not contains(it->mlir_tuning_db, line))
+                it->mlir_tuning_db.push_back(line);
+        }
+    }
+    write_string(bundle_path, to_pretty_json_string(to_value(bundle)));
+}
+
+std::size_t import_tuning_bundle(context& ctx, const fs::path& bundle_path)
+{
+    if(not fs::exists(bundle_path))
+        MIGRAPHX_THROW("Tuning bundle not found: " + bundle_path.string());
+    auto pc_path      = string_value_of(MIGRAPHX_PROBLEM_CACHE{});
+    auto mlir_db_path = string_value_of(MIGRAPHX_MLIR_TUNING_DB{});
+    if(pc_path.empty() and mlir_db_path.empty())
+        MIGRAPHX_THROW("Set MIGRAPHX_PROBLEM_CACHE or MIGRAPHX_MLIR_TUNING_DB to import a tuning "
+                       "bundle");
+
+    auto target = get_tuning_target(ctx);
+    auto bundle = load_tuning_bundle(bundle_path);
+    auto it     = find_entry(bundle, target);
+    if(it == bundle.entries.end())
+        return 0;
+
+    std::size_t n = 0;
+    if(not pc_path.empty())
+    {
+        auto& pc = ctx.get_problem_cache();
+        pc.load(pc_path);
+        for(auto&& [key, solution] : it->problem_cache)
+            pc.insert(key.at("name").to<std::string>(), key.at("problem"), solution);
+        pc.save();
+        n += it->problem_cache.size();
+    }
+    if(not mlir_db_path.empty())
+    {
+        auto lines = read_mlir_tuning_db(mlir_db_path);
+        std::ofstream os(mlir_db_path, std::ios::app);
+        for(auto&& line : it->mlir_tuning_db)
+        {
+            if(contains(lines, line))
+                continue;
+            os << line << std::endl;
+            n++;
+        }
+    }
+    return n;
+}
+
+} // namespace gpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
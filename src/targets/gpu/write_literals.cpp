@@ -27,6 +27,11 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/functional.hpp>
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -34,15 +39,61 @@ namespace gpu {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_COPY_LITERALS)
 
+// Pick the largest literals to stream until the ones left fit in the budget
+static std::unordered_set<instruction_ref> select_streamed_literals(const module& m,
+                                                                     std::size_t budget)
+{
+    std::vector<instruction_ref> literals;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "@literal" or ins->outputs().empty())
+            continue;
+        if(not ins->get_shape().standard())
+            continue;
+        literals.push_back(ins);
+    }
+    auto bytes = [](instruction_ref ins) { return ins->get_shape().bytes(); };
+    std::sort(literals.begin(), literals.end(), by(std::greater<>{}, bytes));
+    auto total = std::accumulate(
+        literals.begin(), literals.end(), std::size_t{0}, [&](auto n, auto ins) {
+            return n + bytes(ins);
+        });
+    std::unordered_set<instruction_ref> result;
+    for(auto ins : literals)
+    {
+        if(total <= budget)
+            break;
+        total -= bytes(ins);
+        result.insert(ins);
+    }
+    return result;
+}
+
 void write_literals::apply(module& m) const
 {
     assert(ctx != nullptr);
+    std::unordered_set<instruction_ref> streamed;
+    if(budget > 0)
+        streamed = select_streamed_literals(m, budget);
     std::size_t n = 0;
     for(auto ins : iterator_for(m))
     {
         if(ins->name() == "@literal")
         {
-            if(enabled(MIGRAPHX_COPY_LITERALS{}))
+            if(contains(streamed, ins))
+            {
+                // Copy it right before its first use, so the buffer is only live from there
+                auto first_use = std::next(ins);
+                while(not contains(ins->outputs(), first_use))
+                    first_use++;
+                std::string id = m.name() + ":@literal:" + std::to_string(n);
+                auto alloc     = m.insert_instruction(first_use, hip_allocate{ins->get_shape()});
+                auto copy      = m.insert_instruction(
+                    first_use, hip_stream_literal{ins->get_literal(), id}, alloc);
+                m.replace_instruction(ins, copy);
+                n++;
+            }
+            else if(enabled(MIGRAPHX_COPY_LITERALS{}))
             {
                 literal l  = ins->get_literal();
                 auto pre   = m.add_literal(l);
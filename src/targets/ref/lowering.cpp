@@ -207,6 +207,7 @@ struct ref_op
     }
     std::string name() const { return "ref::op"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
+    std::size_t flops(const std::vector<shape>& inputs) const { return op.flops(inputs); }
     argument compute(context&, const shape& output_shape, const std::vector<argument>& args) const
     {
         return op.compute(output_shape, args);
@@ -278,6 +279,7 @@ struct ref_gemm
     }
     std::string name() const { return "ref::dot"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
+    std::size_t flops(const std::vector<shape>& inputs) const { return op.flops(inputs); }
 
     argument compute(context&, const dyn_output& dyn_out, std::vector<argument> args) const
     {
@@ -301,6 +303,7 @@ struct ref_quant_gemm
 
     std::string name() const { return "ref::quant_dot"; }
     shape compute_shape(const std::vector<shape>& inputs) const { return op.compute_shape(inputs); }
+    std::size_t flops(const std::vector<shape>& inputs) const { return op.flops(inputs); }
 
     argument compute(context&, const shape& output_shape, std::vector<argument> args) const
     {
@@ -346,37 +349,27 @@ struct ref_softmax : auto_register_op<ref_softmax<Op>>
 
         visit_all(result, args[0])([&](auto output, auto input) {
             using value_type = accumulator_type<typename decltype(input)::value_type>;
-            std::vector<value_type> batch_max(batch_shape.elements(),
-                                              std::numeric_limits<value_type>::lowest());
-            std::vector<value_type> batch_sum(batch_shape.elements(), value_type(0));
+
+            const auto x_stride = input.get_shape().strides()[tuned_axis];
+            const auto y_stride = output.get_shape().strides()[tuned_axis];
             par_for(batch_shape.elements(), [&](auto i) {
-                auto idx = batch_shape.multi(i);
+                auto idx      = batch_shape.multi(i);
+                const auto* x = input.data() + input.get_shape().index(idx);
+                auto* y       = output.data() + output.get_shape().index(idx);
+
+                auto batch_max = std::numeric_limits<value_type>::lowest();
                 for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis] = j;
-                    batch_max[i] =
-                        std::max<value_type>(batch_max[i], input(idx.begin(), idx.end()));
-                }
+                    batch_max = std::max<value_type>(batch_max, x[j * x_stride]);
 
                 for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis]   = j;
-                    std::size_t index = dyn_out.computed_shape.index(idx);
-                    output[index]     = std::exp(input[index] - batch_max[i]);
-                }
+                    y[j * y_stride] = std::exp(x[j * x_stride] - batch_max);
 
+                value_type batch_sum = 0;
                 for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis] = j;
-                    batch_sum[i] += output(idx.begin(), idx.end());
-                }
+                    batch_sum += y[j * y_stride];
 
                 for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis] = j;
-                    output(idx.begin(), idx.end()) =
-                        op.output()(output(idx.begin(), idx.end()), batch_sum[i]);
-                }
+                    y[j * y_stride] = op.output()(y[j * y_stride], batch_sum);
             });
         });
 
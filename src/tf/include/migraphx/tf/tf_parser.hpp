@@ -84,17 +84,21 @@ struct tf_parser
 
     using node_map = std::map<std::string, tensorflow::NodeDef>;
     using op_func  = std::function<std::vector<instruction_ref>(
-        const tf_parser&, const node_info&, std::vector<instruction_ref>)>;
+        tf_parser&, const node_info&, std::vector<instruction_ref>)>;
     node_map nodes;
     std::vector<tensorflow::NodeDef> input_nodes;
     std::vector<std::string> output_node_names;
     std::unordered_map<std::string, instruction_ref> instructions;
+    // Constants of the graph, which are decoded in parallel before the nodes are parsed
+    std::unordered_map<std::string, literal> constants;
+    std::unordered_map<std::string, tensorflow::FunctionDef> functions;
     program prog                  = program();
     module* mm                    = prog.get_main_module();
     bool is_nhwc                  = true;
     unsigned int batch_size       = 1;
     std::size_t default_dim_value = 1;
     std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims;
+    int64_t max_loop_iterations = 10;
 
     std::unordered_map<std::string, op_func> ops;
 
@@ -127,6 +131,9 @@ struct tf_parser
     void parse_from(const void* data, std::size_t size);
     void parse_graph(const tensorflow::GraphDef& graph);
     void parse_node(const std::string& name);
+    std::vector<instruction_ref> parse_function(const std::string& name,
+                                                module* mod,
+                                                const std::vector<instruction_ref>& args);
     literal parse_tensor(const tensorflow::TensorProto& t) const;
     shape::type_t parse_type(tensorflow::DataType t) const;
     std::vector<std::string> find_outputs() const;
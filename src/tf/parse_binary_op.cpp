@@ -37,6 +37,8 @@ struct parse_binary_op : op_parser<parse_binary_op>
     {
         return {{"Add", "add"},
                 {"AddV2", "add"},
+                {"Greater", "greater"},
+                {"Less", "less"},
                 {"Mul", "mul"},
                 {"Pow", "pow"},
                 {"SquaredDifference", "sqdiff"},
@@ -0,0 +1,82 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/tf/op_parser.hpp>
+#include <migraphx/tf/tf_parser.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace tf {
+
+// Lowers the functional (control flow v2) while loop to a loop op. The cond function is evaluated
+// once on the initial values, and at the end of each iteration on the updated values.
+struct parse_while : op_parser<parse_while>
+{
+    std::vector<op_desc> operators() const { return {{"While"}, {"StatelessWhile"}}; }
+
+    std::vector<instruction_ref> parse(const op_desc& /*opd*/,
+                                       tf_parser& parser,
+                                       const tf_parser::node_info& info,
+                                       std::vector<instruction_ref> args) const
+    {
+        const auto& cond_name = info.attributes.at("cond").func().name();
+        const auto& body_name = info.attributes.at("body").func().name();
+        std::transform(args.begin(), args.end(), args.begin(), [&](auto arg) {
+            return info.make_contiguous(arg);
+        });
+
+        module_ref body = parser.prog.create_module(info.name + "_" + body_name);
+        body->add_parameter("iteration_num", shape{shape::int64_type});
+        body->add_parameter("cond", shape{shape::bool_type});
+        std::vector<instruction_ref> vars;
+        for(auto i : range(args.size()))
+        {
+            vars.push_back(
+                body->add_parameter("var" + std::to_string(i), args[i]->get_shape().as_standard()));
+        }
+        auto updated = parser.parse_function(body_name, body, vars);
+        auto cond    = parser.parse_function(cond_name, body, updated);
+        std::vector<instruction_ref> outputs{cond.front()};
+        outputs.insert(outputs.end(), updated.begin(), updated.end());
+        body->add_return(outputs);
+
+        auto init_cond = parser.parse_function(cond_name, info.mm, args).front();
+        auto max_iterations =
+            info.add_literal(literal{shape{shape::int64_type}, {parser.max_loop_iterations}});
+        args.insert(args.begin(), {max_iterations, init_cond});
+        auto ret = info.mm->add_instruction(
+            make_op("loop", {{"max_iterations", parser.max_loop_iterations}}), args, {body});
+
+        std::vector<instruction_ref> result;
+        for(auto i : range(ret->get_shape().sub_shapes().size()))
+            result.push_back(info.add_instruction(make_op("get_tuple_elem", {{"index", i}}), ret));
+        return result;
+    }
+};
+
+} // namespace tf
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
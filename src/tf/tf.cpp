@@ -41,10 +41,11 @@ template <class... Ts>
 program parse_tf_from(const tf_options& options, Ts&&... xs)
 {
     tf::tf_parser parser;
-    parser.is_nhwc           = options.is_nhwc;
-    parser.batch_size        = options.batch_size;
-    parser.map_input_dims    = options.map_input_dims;
-    parser.output_node_names = options.output_node_names;
+    parser.is_nhwc             = options.is_nhwc;
+    parser.batch_size          = options.batch_size;
+    parser.map_input_dims      = options.map_input_dims;
+    parser.output_node_names   = options.output_node_names;
+    parser.max_loop_iterations = options.max_loop_iterations;
 
 #ifndef NDEBUG
     // Log the program when it can't be parsed
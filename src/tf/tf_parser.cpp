@@ -42,6 +42,8 @@
 #include <migraphx/tf.hpp>
 #include <migraphx/common.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/thread_pool.hpp>
+#include <migraphx/stringutils.hpp>
 
 #include <migraphx/tf/tf_parser.hpp>
 #include <migraphx/tf/op_parser.hpp>
@@ -269,6 +271,24 @@ std::vector<std::string> tf_parser::find_outputs() const
 void tf_parser::parse_graph(const tensorflow::GraphDef& graph)
 {
     nodes = get_nodes(graph, input_nodes);
+    for(auto&& f : graph.library().function())
+        functions[f.signature().name()] = f;
+
+    // Decode the constant tensors in parallel, each one is a task so idle threads pick up the
+    // remaining tensors when the sizes are uneven
+    std::vector<const tensorflow::NodeDef*> const_nodes;
+    for(auto&& p : nodes)
+    {
+        if(p.second.op() == "Const" and contains(p.second.attr(), "value"))
+            const_nodes.push_back(&p.second);
+    }
+    std::vector<literal> literals(const_nodes.size());
+    get_thread_pool().run(literals.size(), [&](std::size_t i) {
+        literals[i] = this->parse_tensor(const_nodes[i]->attr().at("value").tensor());
+    });
+    for(auto i : range(const_nodes.size()))
+        constants[get_name(*const_nodes[i])] = std::move(literals[i]);
+
     for(auto&& input : input_nodes)
     {
         const std::string& name   = input.name();
@@ -358,17 +378,26 @@ void tf_parser::parse_node(const std::string& name)
             }
             else
             {
+                // input is a later output of a multi-output node, so parse that node first
+                auto node_name = input_name.substr(0, input_name.find(':'));
+                if(nodes.count(node_name) > 0 and node_name != name)
+                    this->parse_node(node_name);
                 args.push_back(instructions.at(input_name));
             }
         }
         std::vector<instruction_ref> result;
-        if(ops.count(node.op()) == 0)
+        if(contains(constants, name))
+        {
+            result.push_back(to_nhwc(mm->add_literal(std::move(constants.at(name)))));
+            constants.erase(name);
+        }
+        else if(ops.count(node.op()) == 0)
         {
             result.push_back(mm->add_instruction(op::unknown{node.op()}, args));
         }
         else
         {
-            result = ops[node.op()](*this, {get_attributes(node), node.op(), mm}, args);
+            result = ops[node.op()](*this, {get_attributes(node), name, mm}, args);
         }
         assert(not result.empty());
         // First output has no ":" delimiter
@@ -380,6 +409,64 @@ void tf_parser::parse_node(const std::string& name)
     }
 }
 
+// Function bodies refer to outputs as "node:out_arg:idx", map them to the names used in the graph
+static std::string get_function_input_name(const std::string& input)
+{
+    if(contains(input, "^"))
+        return input;
+    auto parts = split_string(input, ':');
+    if(parts.size() < 3)
+        return input;
+    if(parts.back() == "0")
+        return parts.front();
+    return parts.front() + ":" + parts.back();
+}
+
+std::vector<instruction_ref> tf_parser::parse_function(const std::string& name,
+                                                       module* mod,
+                                                       const std::vector<instruction_ref>& args)
+{
+    if(not contains(functions, name))
+        MIGRAPHX_THROW("PARSE_TF: function " + name + " not found in graph library");
+    const auto& f          = functions.at(name);
+    const auto& input_args = f.signature().input_arg();
+    if(input_args.size() != args.size())
+        MIGRAPHX_THROW("PARSE_TF: function " + name + " expects " +
+                       std::to_string(input_args.size()) + " inputs, but " +
+                       std::to_string(args.size()) + " are given");
+
+    // The function is parsed with its own names, so save the state of the enclosing graph
+    auto saved_nodes        = std::exchange(nodes, {});
+    auto saved_instructions = std::exchange(instructions, {});
+    auto saved_constants    = std::exchange(constants, {});
+    auto* saved_mm          = std::exchange(mm, mod);
+
+    for(auto i : range(args.size()))
+        instructions[input_args.Get(i).name()] = args[i];
+    for(auto node : f.node_def())
+    {
+        for(auto& input : *node.mutable_input())
+            input = get_function_input_name(input);
+        nodes[get_name(node)] = node;
+    }
+
+    std::vector<instruction_ref> result;
+    for(auto&& output_arg : f.signature().output_arg())
+    {
+        auto output_name = get_function_input_name(f.ret().at(output_arg.name()));
+        auto node_name   = output_name.substr(0, output_name.find(':'));
+        if(contains(nodes, node_name))
+            this->parse_node(node_name);
+        result.push_back(instructions.at(output_name));
+    }
+
+    nodes        = std::move(saved_nodes);
+    instructions = std::move(saved_instructions);
+    constants    = std::move(saved_constants);
+    mm           = saved_mm;
+    return result;
+}
+
 void tf_parser::parse_from(std::istream& is)
 {
     tensorflow::GraphDef graph;
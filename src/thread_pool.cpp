@@ -0,0 +1,276 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/thread_pool.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_NUM_THREADS)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_AFFINITY)
+
+// Parse a sysfs cpu list such as "0-15,32-47"
+static std::vector<std::size_t> parse_cpu_list(const std::string& s)
+{
+    std::vector<std::size_t> result;
+    for(const auto& r : split_string(trim(s), ','))
+    {
+        if(r.empty())
+            continue;
+        auto dash  = r.find('-');
+        auto first = std::stoul(r.substr(0, dash));
+        auto last  = dash == std::string::npos ? first : std::stoul(r.substr(dash + 1));
+        for(auto cpu = first; cpu <= last; cpu++)
+            result.push_back(cpu);
+    }
+    return result;
+}
+
+// The cpus of every numa node one node after another so consecutive workers share a node
+static std::vector<std::size_t> cpus_by_node()
+{
+    std::vector<std::size_t> result;
+    fs::path nodes{"/sys/devices/system/node"};
+    if(fs::is_directory(nodes))
+    {
+        std::vector<fs::path> dirs;
+        for(const auto& entry : fs::directory_iterator{nodes})
+        {
+            auto name = entry.path().filename().string();
+            if(starts_with(name, "node") and fs::exists(entry.path() / "cpulist"))
+                dirs.push_back(entry.path());
+        }
+        std::sort(dirs.begin(), dirs.end(), [](const fs::path& x, const fs::path& y) {
+            return std::stoul(x.filename().string().substr(4)) <
+                   std::stoul(y.filename().string().substr(4));
+        });
+        for(const auto& dir : dirs)
+        {
+            // sysfs files do not report their size so read them as a stream
+            std::ifstream is{(dir / "cpulist").string()};
+            std::string line;
+            std::getline(is, line);
+            auto cpus = parse_cpu_list(line);
+            result.insert(result.end(), cpus.begin(), cpus.end());
+        }
+    }
+    if(result.empty())
+    {
+        result.resize(std::max(1u, std::thread::hardware_concurrency()));
+        std::iota(result.begin(), result.end(), 0);
+    }
+    return result;
+}
+
+static void pin_thread(std::thread& t, std::size_t cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+    (void)t;
+    (void)cpu;
+#endif
+}
+
+namespace {
+
+struct task_block
+{
+    std::atomic<std::size_t> next{0};
+    std::size_t last = 0;
+};
+
+struct job
+{
+    job(std::size_t n, std::size_t nthreads, const std::function<void(std::size_t)>& pf)
+        : f(&pf), blocks(nthreads), total(n)
+    {
+        for(std::size_t t = 0; t < nthreads; t++)
+        {
+            blocks[t].next = (n * t) / nthreads;
+            blocks[t].last = (n * (t + 1)) / nthreads;
+        }
+    }
+
+    // Run the tasks of this thread's block first then steal from the others
+    void work(std::size_t tid)
+    {
+        for(std::size_t k = 0; k < blocks.size(); k++)
+        {
+            auto& b = blocks[(tid + k) % blocks.size()];
+            for(auto i = b.next++; i < b.last; i = b.next++)
+            {
+                try
+                {
+                    (*f)(i);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> guard(m);
+                    if(not exception)
+                        exception = std::current_exception();
+                }
+                if(++finished == total)
+                {
+                    std::lock_guard<std::mutex> guard(m);
+                    cv.notify_all();
+                }
+            }
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return finished == total; });
+    }
+
+    const std::function<void(std::size_t)>* f;
+    std::vector<task_block> blocks;
+    std::size_t total;
+    std::atomic<std::size_t> finished{0};
+    std::exception_ptr exception = nullptr;
+    std::mutex m;
+    std::condition_variable cv;
+};
+
+thread_local bool is_pool_worker = false;
+
+} // namespace
+
+struct thread_pool_impl
+{
+    std::vector<std::thread> workers;
+    std::mutex run_mutex;
+    std::mutex m;
+    std::condition_variable cv;
+    std::shared_ptr<job> current = nullptr;
+    std::size_t generation       = 0;
+    bool stop                    = false;
+    bool pinned                  = false;
+
+    void worker(std::size_t tid)
+    {
+        is_pool_worker   = true;
+        std::size_t seen = 0;
+        for(;;)
+        {
+            std::shared_ptr<job> j;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return stop or generation != seen; });
+                if(stop)
+                    return;
+                seen = generation;
+                j    = current;
+            }
+            if(j != nullptr)
+                j->work(tid);
+        }
+    }
+};
+
+thread_pool::thread_pool(std::size_t nthreads, bool pin)
+    : impl(std::make_unique<thread_pool_impl>())
+{
+    nthreads     = std::max<std::size_t>(nthreads, 1);
+    impl->pinned = pin;
+    auto cpus    = pin ? cpus_by_node() : std::vector<std::size_t>{};
+    for(std::size_t tid = 1; tid < nthreads; tid++)
+    {
+        impl->workers.emplace_back([this, tid] { impl->worker(tid); });
+        if(pin)
+            pin_thread(impl->workers.back(), cpus[tid % cpus.size()]);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        impl->stop = true;
+    }
+    impl->cv.notify_all();
+    for(auto& t : impl->workers)
+        t.join();
+}
+
+std::size_t thread_pool::size() const { return impl->workers.size() + 1; }
+
+bool thread_pool::pinned() const { return impl->pinned; }
+
+void thread_pool::run(std::size_t n, const std::function<void(std::size_t)>& f)
+{
+    std::unique_lock<std::mutex> run_lock(impl->run_mutex, std::defer_lock);
+    if(n < 2 or impl->workers.empty() or is_pool_worker or not run_lock.try_lock())
+    {
+        for(std::size_t i = 0; i < n; i++)
+            f(i);
+        return;
+    }
+    auto j = std::make_shared<job>(n, size(), f);
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        impl->current = j;
+        impl->generation++;
+    }
+    impl->cv.notify_all();
+    j->work(0);
+    j->wait();
+    {
+        std::lock_guard<std::mutex> lock(impl->m);
+        impl->current = nullptr;
+    }
+    if(j->exception)
+        std::rethrow_exception(j->exception);
+}
+
+thread_pool& get_thread_pool()
+{
+    static thread_pool pool{
+        value_of(MIGRAPHX_NUM_THREADS{}, std::max(1u, std::thread::hardware_concurrency())),
+        enabled(MIGRAPHX_CPU_AFFINITY{})};
+    return pool;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
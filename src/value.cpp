@@ -29,6 +29,7 @@
 #include <migraphx/value.hpp>
 #include <migraphx/optional.hpp>
 #include <migraphx/hash.hpp>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
@@ -44,10 +45,14 @@ struct value_base_impl : cloneable<value_base_impl>
     virtual std::vector<value>* if_array() { return nullptr; }
     virtual std::unordered_map<std::string, std::size_t>* if_object() { return nullptr; }
     virtual value_base_impl* if_value() const { return nullptr; }
-    value_base_impl()                       = default;
-    value_base_impl(const value_base_impl&) = default;
+    value_base_impl() = default;
+    // A fresh copy has no outstanding references into it so it can be shared again
+    value_base_impl(const value_base_impl&) {}
     value_base_impl& operator=(const value_base_impl&) = default;
     virtual ~value_base_impl() override {}
+    // Set once a mutable pointer into the elements has been handed out, after which copies can no
+    // longer share this holder
+    bool leaked = false;
 };
 
 #define MIGRAPHX_VALUE_GENERATE_BASE_TYPE(vt, cpp_type)                        \
@@ -83,7 +88,28 @@ struct object_value_holder : value_base_impl::derive<object_value_holder>
     std::unordered_map<std::string, std::size_t> lookup;
 };
 
-value::value(const value& rhs) : x(rhs.x ? rhs.x->clone() : nullptr), key(rhs.key) {}
+// Arrays and objects are copy-on-write: copies share the holder until one of them needs mutable
+// access to the elements.
+std::shared_ptr<value_base_impl> share_impl(const std::shared_ptr<value_base_impl>& x)
+{
+    if(x == nullptr)
+        return nullptr;
+    if(x->leaked)
+        return x->clone();
+    return x;
+}
+
+void detach_impl(std::shared_ptr<value_base_impl>& x)
+{
+    if(x == nullptr or x->if_array() == nullptr)
+        return;
+    if(x.use_count() > 1)
+        x = x->clone();
+    x->leaked = true;
+}
+
+value::value(const value& rhs) : x(share_impl(rhs.x)), key(rhs.key) {}
+value::value(value&& rhs) noexcept : x(std::move(rhs.x)), key(std::move(rhs.key)) {}
 value& value::operator=(value rhs)
 {
     std::swap(rhs.x, x);
@@ -93,7 +119,7 @@ value& value::operator=(value rhs)
 }
 
 void set_vector(std::shared_ptr<value_base_impl>& x,
-                const std::vector<value>& v,
+                std::vector<value> v,
                 bool array_on_empty = true)
 {
     if(v.empty())
@@ -106,7 +132,7 @@ void set_vector(std::shared_ptr<value_base_impl>& x,
     }
     if(v.front().get_key().empty())
     {
-        x = std::make_shared<array_value_holder>(v);
+        x = std::make_shared<array_value_holder>(std::move(v));
     }
     else
     {
@@ -117,7 +143,7 @@ void set_vector(std::shared_ptr<value_base_impl>& x,
             lookup[e.get_key()] = i;
             i++;
         }
-        x = std::make_shared<object_value_holder>(v, lookup);
+        x = std::make_shared<object_value_holder>(std::move(v), std::move(lookup));
     }
 }
 
@@ -126,8 +152,7 @@ value::value(const std::initializer_list<value>& i) : x(nullptr)
     if(i.size() == 2 and i.begin()->is_string() and i.begin()->get_key().empty())
     {
         key    = i.begin()->get_string();
-        auto r = (i.begin() + 1)->x;
-        x      = r ? r->clone() : nullptr;
+        x      = share_impl((i.begin() + 1)->x);
         return;
     }
     set_vector(x, std::vector<value>(i.begin(), i.end()));
@@ -138,6 +163,11 @@ value::value(const std::vector<value>& v, bool array_on_empty) : x(nullptr)
     set_vector(x, v, array_on_empty);
 }
 
+value::value(std::vector<value>&& v, bool array_on_empty) : x(nullptr)
+{
+    set_vector(x, std::move(v), array_on_empty);
+}
+
 value::value(const std::unordered_map<std::string, value>& m)
     : value(std::vector<value>(m.begin(), m.end()), false)
 {
@@ -149,6 +179,12 @@ value::value(const std::string& pkey, const std::vector<value>& v, bool array_on
     set_vector(x, v, array_on_empty);
 }
 
+value::value(const std::string& pkey, std::vector<value>&& v, bool array_on_empty)
+    : x(nullptr), key(pkey)
+{
+    set_vector(x, std::move(v), array_on_empty);
+}
+
 value::value(const std::string& pkey, const std::unordered_map<std::string, value>& m)
     : value(pkey, std::vector<value>(m.begin(), m.end()), false)
 {
@@ -159,7 +195,7 @@ value::value(const std::string& pkey, std::nullptr_t) : x(nullptr), key(pkey) {}
 value::value(std::nullptr_t) : x(nullptr) {}
 
 value::value(const std::string& pkey, const value& rhs)
-    : x(rhs.x ? rhs.x->clone() : nullptr), key(pkey)
+    : x(share_impl(rhs.x)), key(pkey)
 {
 }
 
@@ -271,7 +307,11 @@ T* find_impl(const std::shared_ptr<value_base_impl>& x, const std::string& key,
     return std::addressof((*a)[it->second]);
 }
 
-value* value::find(const std::string& pkey) { return find_impl(x, pkey, this->end()); }
+value* value::find(const std::string& pkey)
+{
+    detach_impl(x);
+    return find_impl(x, pkey, this->end());
+}
 
 const value* value::find(const std::string& pkey) const { return find_impl(x, pkey, this->end()); }
 bool value::contains(const std::string& pkey) const
@@ -300,6 +340,7 @@ const value* value::data() const
 }
 value* value::data()
 {
+    detach_impl(x);
     auto* a = if_array_impl(x);
     if(a == nullptr)
         return nullptr;
@@ -341,6 +382,7 @@ const value& value::back() const
 }
 value& value::at(std::size_t i)
 {
+    detach_impl(x);
     auto* a = if_array_impl(x);
     if(a == nullptr)
         MIGRAPHX_THROW("Not an array");
@@ -383,17 +425,23 @@ const value& value::operator[](std::size_t i) const
 }
 value& value::operator[](const std::string& pkey) { return *emplace(pkey, nullptr).first; }
 
-void value::clear() { get_array_throw(x).clear(); }
+void value::clear()
+{
+    detach_impl(x);
+    get_array_throw(x).clear();
+}
 void value::resize(std::size_t n)
 {
     if(not is_array())
         MIGRAPHX_THROW("Expected an array.");
+    detach_impl(x);
     get_array_impl(x).resize(n);
 }
 void value::resize(std::size_t n, const value& v)
 {
     if(not is_array())
         MIGRAPHX_THROW("Expected an array.");
+    detach_impl(x);
     get_array_impl(x).resize(n, v);
 }
 
@@ -403,6 +451,7 @@ std::pair<value*, bool> value::insert(const value& v)
     {
         if(not x)
             x = std::make_shared<array_value_holder>();
+        detach_impl(x);
         get_array_impl(x).push_back(v);
         assert(this->if_array());
         return std::make_pair(&back(), true);
@@ -411,6 +460,7 @@ std::pair<value*, bool> value::insert(const value& v)
     {
         if(not x)
             x = std::make_shared<object_value_holder>();
+        detach_impl(x);
         auto p = x->if_object()->emplace(v.key, get_array_impl(x).size());
         if(p.second)
             get_array_impl(x).push_back(v);
@@ -421,10 +471,13 @@ std::pair<value*, bool> value::insert(const value& v)
 value* value::insert(const value* pos, const value& v)
 {
     assert(v.key.empty());
+    // The position may point into a holder that is shared, so compute the offset before detaching
+    auto offset = pos - std::as_const(*this).begin();
     if(not x)
         x = std::make_shared<array_value_holder>();
+    detach_impl(x);
     auto&& a = get_array_impl(x);
-    auto it  = a.insert(a.begin() + (pos - begin()), v);
+    auto it  = a.insert(a.begin() + offset, v);
     return std::addressof(*it);
 }
 
@@ -476,6 +529,9 @@ bool operator==(const value& x, const value& y)
 {
     if(x.get_type() != y.get_type())
         return false;
+    // Copies share the same holder so there is no need to walk the elements
+    if(x.x == y.x)
+        return x.key == y.key;
     return compare(x, y, std::equal_to<>{});
 }
 bool operator!=(const value& x, const value& y) { return not(x == y); }
@@ -540,8 +596,8 @@ std::size_t value_hash(const std::string& key, const std::vector<value>& x)
 std::size_t value_hash(const std::string& key, const value::binary& x)
 {
     std::size_t h = hash_value(key);
-    for(const auto& v : x)
-        hash_combine(h, v);
+    // Hash the whole buffer at once rather than combining it byte by byte
+    hash_combine(h, std::string_view{reinterpret_cast<const char*>(x.data()), x.size()});
     return h;
 }
 
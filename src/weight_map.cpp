@@ -0,0 +1,286 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/weight_map.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/content_hash.hpp>
+#include <migraphx/digest.hpp>
+#include <migraphx/msgpack.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/thread_pool.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// Modules are visited by name since the unused modules are not returned in a fixed order
+static std::vector<const module*> sorted_modules(const program& p)
+{
+    auto mods = p.get_modules();
+    std::sort(mods.begin(), mods.end(), [](const module* x, const module* y) {
+        return x->name() < y->name();
+    });
+    return mods;
+}
+
+static std::vector<instruction_ref> source_literals(const program& p)
+{
+    std::vector<instruction_ref> result;
+    for(const auto* m : sorted_modules(p))
+    {
+        for(auto ins : iterator_for(*m))
+        {
+            if(ins->name() == "@literal")
+                result.push_back(ins);
+        }
+    }
+    return result;
+}
+
+static std::string digest_data(const literal& l)
+{
+    digest d;
+    d.update(to_string(l.get_shape()));
+    d.update(l.content_hash());
+    return d.str();
+}
+
+static std::vector<std::string> digest_literals(const std::vector<instruction_ref>& lits)
+{
+    std::vector<literal> ls(lits.size());
+    std::transform(
+        lits.begin(), lits.end(), ls.begin(), [](auto ins) { return ins->get_literal(); });
+    compute_content_hashes(ls);
+    std::vector<std::string> result(ls.size());
+    std::transform(ls.begin(), ls.end(), result.begin(), &digest_data);
+    return result;
+}
+
+// Targets lower literals to ops without inputs that keep the data in one of these fields
+static const std::vector<std::string>& weight_fields()
+{
+    static const std::vector<std::string> result = {"literal", "data"};
+    return result;
+}
+
+static optional<std::string> find_weight_field(const value& v)
+{
+    for(const auto& field : weight_fields())
+    {
+        if(not v.contains(field))
+            continue;
+        const auto& x = v.at(field);
+        if(x.contains("shape") and x.contains("data"))
+            return field;
+    }
+    return nullopt;
+}
+
+static optional<literal> get_weight(instruction_ref ins)
+{
+    if(ins->name() == "@literal")
+        return ins->get_literal();
+    if(not ins->inputs().empty())
+        return nullopt;
+    auto v     = ins->get_operator().to_value();
+    auto field = find_weight_field(v);
+    if(not field)
+        return nullopt;
+    return from_value<literal>(v.at(*field));
+}
+
+static instruction_ref set_weight(module& m, instruction_ref ins, const literal& l)
+{
+    if(ins->name() == "@literal")
+    {
+        // Insert the new literal in the same place so the indices of the instructions are kept
+        auto lit = m.insert_literal(ins, l);
+        lit->set_target_id(ins->get_target_id());
+        m.replace_instruction(ins, lit);
+        m.remove_instruction(ins);
+        return lit;
+    }
+    auto op    = ins->get_operator();
+    auto v     = op.to_value();
+    auto field = find_weight_field(v);
+    assert(field);
+    v[*field] = migraphx::to_value(l);
+    op.from_value(v);
+    return m.replace_instruction(ins, op, std::vector<instruction_ref>{});
+}
+
+std::string structure_fingerprint(const program& p)
+{
+    auto mods = sorted_modules(p);
+    std::unordered_map<instruction_ref, std::string> ids;
+    for(const auto* m : mods)
+    {
+        std::size_t i = 0;
+        for(auto ins : iterator_for(*m))
+            ids[ins] = m->name() + ":" + std::to_string(i++);
+    }
+    digest d;
+    for(const auto* m : mods)
+    {
+        d.update(m->name());
+        d.update(std::to_string(m->size()));
+        for(auto ins : iterator_for(*m))
+        {
+            d.update(ins->name());
+            d.update(to_string(ins->get_shape()));
+            // The data of the literals is left out, only their shape is part of the structure
+            if(ins->name() != "@literal")
+            {
+                auto v = to_msgpack(ins->get_operator().to_value());
+                d.update({v.data(), v.size()});
+            }
+            d.update(std::to_string(ins->inputs().size()));
+            for(auto input : ins->inputs())
+                d.update(contains(ids, input) ? ids.at(input) : "");
+            d.update(std::to_string(ins->module_inputs().size()));
+            for(const auto* smod : ins->module_inputs())
+                d.update(smod->name());
+        }
+    }
+    return d.str();
+}
+
+weight_map weight_map::from_source(const program& p)
+{
+    weight_map result;
+    result.fingerprint = structure_fingerprint(p);
+    auto digests       = digest_literals(source_literals(p));
+    std::transform(digests.begin(),
+                   digests.end(),
+                   std::back_inserter(result.entries),
+                   [](const std::string& d) { return entry{d}; });
+    return result;
+}
+
+void weight_map::locate(const program& compiled)
+{
+    struct candidate
+    {
+        std::string module;
+        std::size_t index;
+        instruction_ref ins;
+    };
+    std::vector<candidate> candidates;
+    for(const auto* m : sorted_modules(compiled))
+    {
+        std::size_t i = 0;
+        for(auto ins : iterator_for(*m))
+        {
+            if(ins->name() == "@literal" or ins->inputs().empty())
+                candidates.push_back({m->name(), i, ins});
+            i++;
+        }
+    }
+    std::vector<optional<literal>> weights(candidates.size());
+    get_thread_pool().run(candidates.size(),
+                          [&](std::size_t i) { weights[i] = get_weight(candidates[i].ins); });
+    std::vector<literal> ls;
+    for(const auto& w : weights)
+    {
+        if(w)
+            ls.push_back(*w);
+    }
+    compute_content_hashes(ls);
+    std::vector<std::string> digests(candidates.size());
+    std::transform(weights.begin(), weights.end(), digests.begin(), [](const auto& w) {
+        return w ? digest_data(*w) : std::string{};
+    });
+
+    std::unordered_map<std::string, std::vector<std::size_t>> found;
+    for(auto i : range(candidates.size()))
+    {
+        if(not digests[i].empty())
+            found[digests[i]].push_back(i);
+    }
+    std::unordered_map<std::string, std::size_t> source_count;
+    for(const auto& e : entries)
+        source_count[e.digest]++;
+    // Literals with the same data can't be told apart, so they are only located when there is
+    // a single copy on both sides
+    for(auto& e : entries)
+    {
+        e.located = false;
+        auto it   = found.find(e.digest);
+        if(it == found.end() or it->second.size() != 1 or source_count.at(e.digest) != 1)
+            continue;
+        const auto& c = candidates[it->second.front()];
+        e.module      = c.module;
+        e.index       = c.index;
+        e.located     = true;
+    }
+}
+
+bool weight_map::update(program& compiled, std::vector<context>& ctx, const program& p)
+{
+    if(this->empty() or structure_fingerprint(p) != fingerprint)
+        return false;
+    auto lits = source_literals(p);
+    if(lits.size() != entries.size())
+        return false;
+    auto digests = digest_literals(lits);
+
+    // Find all the instructions to update before changing anything
+    std::vector<std::pair<std::size_t, instruction_ref>> updates;
+    for(auto i : range(entries.size()))
+    {
+        const auto& e = entries[i];
+        if(digests[i] == e.digest)
+            continue;
+        if(not e.located)
+            return false;
+        auto* m = compiled.get_module(e.module);
+        if(m == nullptr or e.index >= m->size())
+            return false;
+        auto ins = std::next(m->begin(), e.index);
+        if(ins->name() != "@literal" and not ins->inputs().empty())
+            return false;
+        if(ins->get_shape() != lits[i]->get_shape())
+            return false;
+        updates.emplace_back(i, ins);
+    }
+
+    for(const auto& [i, ins] : updates)
+    {
+        auto* m     = compiled.get_module(entries[i].module);
+        auto result = set_weight(*m, ins, lits[i]->get_literal());
+        result->finalize(ctx[result->get_target_id()]);
+        entries[i].digest = digests[i];
+    }
+    return true;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -65,6 +65,66 @@ TEST_CASE(load_and_run_init_list)
     CHECK(bool{shapes_before.front() == outputs.front().get_shape()});
 }
 
+TEST_CASE(load_and_run_bound)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    auto expected = p.eval(pp);
+    p.bind(pp);
+    for(int i = 0; i < 2; i++)
+    {
+        auto outputs = p.run_bound();
+        CHECK(outputs.size() == expected.size());
+        CHECK(bool{outputs.front() == expected.front()});
+    }
+}
+
+TEST_CASE(load_and_run_many)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    auto param_shapes = p.get_parameter_shapes();
+    std::vector<migraphx::program_parameters> requests(4);
+    for(std::size_t i = 0; i < requests.size(); i++)
+    {
+        for(auto&& name : param_shapes.names())
+            requests[i].add(name, migraphx::argument::generate(param_shapes[name], i));
+    }
+    auto results = p.eval_many(requests, 2);
+    CHECK(results.size() == requests.size());
+    for(std::size_t i = 0; i < requests.size(); i++)
+    {
+        auto expected = p.eval(requests[i]);
+        auto outputs  = results[i];
+        CHECK(outputs.size() == expected.size());
+        CHECK(bool{outputs.front() == expected.front()});
+    }
+}
+
+TEST_CASE(metrics)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    p.compile(migraphx::target("ref"));
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    migraphx::reset_metrics();
+    p.eval(pp);
+    p.eval(pp);
+    CHECK(migraphx::get_metric("eval") == 2);
+    CHECK(migraphx::get_metric("eval_latency_us.count") == 2);
+    CHECK(migraphx::get_metric("unknown_metric") == 0);
+}
+
 TEST_CASE(quantize_fp16)
 {
     auto p1        = migraphx::parse_onnx("gemm_test.onnx");
@@ -21,6 +21,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <algorithm>
+#include <future>
 #include <numeric>
 #include <hip/hip_runtime_api.h>
 #include <migraphx/migraphx.h>
@@ -51,6 +53,72 @@ TEST_CASE(load_and_run)
     CHECK(bool{shapes_before.front() == outputs.front().get_shape()});
 }
 
+TEST_CASE(load_and_run_priority)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    migraphx::compile_options options;
+    options.set_offload_copy();
+    p.compile(migraphx::target("gpu"), options);
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+
+    auto gold = p.eval(pp);
+    int least    = 0;
+    int greatest = 0;
+    EXPECT(hipDeviceGetStreamPriorityRange(&least, &greatest) == hipSuccess);
+    // Run at the highest priority, at a value out of range, and back at the default priority
+    for(int priority : {greatest, greatest - 1, 0})
+    {
+        auto outputs = p.eval(pp, priority);
+        CHECK(bool{outputs.front() == gold.front()});
+    }
+}
+
+TEST_CASE(load_and_run_pinned)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    migraphx::compile_options options;
+    options.set_offload_copy();
+    migraphx::target t("gpu");
+    p.compile(t, options);
+    migraphx::program_parameters pp;
+    migraphx::program_parameters pinned_pp;
+    auto param_shapes = p.get_parameter_shapes();
+    for(auto&& name : param_shapes.names())
+    {
+        auto s   = param_shapes[name];
+        auto arg = migraphx::argument::generate(s);
+        auto pin = t.allocate_pinned(s);
+        std::copy(arg.data(), arg.data() + s.bytes(), pin.data());
+        pp.add(name, arg);
+        pinned_pp.add(name, pin);
+    }
+
+    auto gold    = p.eval(pp);
+    auto outputs = p.eval(pinned_pp);
+    CHECK(bool{outputs.front() == gold.front()});
+}
+
+TEST_CASE(memory_usage)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    migraphx::compile_options options;
+    options.set_offload_copy();
+    p.compile(migraphx::target("gpu"), options);
+    auto literals     = p.memory_usage("literals");
+    auto scratch      = p.memory_usage("scratch");
+    auto code_objects = p.memory_usage("code_objects");
+    auto allocations  = p.memory_usage("allocations");
+    EXPECT(literals > 0);
+    EXPECT(code_objects > 0);
+    EXPECT(p.memory_usage("total") == literals + scratch + code_objects + allocations);
+    EXPECT(p.memory_usage("unknown") == 0);
+}
+
 using hip_ptr    = MIGRAPHX_MANAGE_PTR(void, hipFree);
 using stream_ptr = MIGRAPHX_MANAGE_PTR(hipStream_t, hipStreamDestroy);
 
@@ -205,6 +273,36 @@ TEST_CASE(load_and_run_async)
     CHECK(bool{shapes_before.front() == outputs.front().get_shape()});
 }
 
+TEST_CASE(load_and_run_async_callback)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    migraphx::compile_options options;
+    options.set_offload_copy(false);
+    p.compile(migraphx::target("gpu"), options);
+    migraphx::program_parameters pp;
+    auto param_shapes = p.get_parameter_shapes();
+
+    stream_ptr stream = get_stream();
+
+    std::vector<hip_ptr> buffs;
+    for(auto&& name : param_shapes.names())
+    {
+        auto arg = migraphx::argument::generate(param_shapes[name]);
+        buffs.push_back(get_hip_buffer(arg.get_shape().bytes()));
+        auto err = hipMemcpy(
+            buffs.back().get(), arg.data(), arg.get_shape().bytes(), hipMemcpyHostToDevice);
+        EXPECT(err == hipSuccess);
+        pp.add(name, migraphx::argument(arg.get_shape(), buffs.back().get()));
+    }
+
+    std::promise<void> done;
+    auto outputs = p.run_async(pp, stream.get(), [&] { done.set_value(); });
+    CHECK(outputs.size() == 1);
+    // The callback runs once the stream reaches it, without synchronizing the stream here
+    EXPECT(done.get_future().wait_for(std::chrono::seconds{30}) == std::future_status::ready);
+    EXPECT(hipStreamQuery(stream.get()) == hipSuccess);
+}
+
 TEST_CASE(load_and_run_ctx)
 {
     auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cmath>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/bf16.hpp>
+#include <migraphx/ranges.hpp>
+#include "test.hpp"
+
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+static uint16_t bits_of(float f) { return migraphx::bf16(f).data; }
+
+TEST_CASE(test_bf16_cast_to_float)
+{
+    // Every bf16 value is exactly the upper half of a float
+    std::vector<uint32_t> bit_vals(1u << 16u);
+    std::iota(bit_vals.begin(), bit_vals.end(), 0);
+    EXPECT(bool{std::all_of(bit_vals.begin(), bit_vals.end(), [](uint32_t bit_val) {
+        migraphx::bf16 x(static_cast<uint16_t>(bit_val), migraphx::bf16::from_bits());
+        float expected = migraphx::bit_cast<float>(bit_val << 16u);
+        if(std::isnan(expected))
+            return std::isnan(float(x)) and x.is_nan();
+        return migraphx::bit_cast<uint32_t>(float(x)) == migraphx::bit_cast<uint32_t>(expected);
+    })});
+}
+
+TEST_CASE(test_bf16_cast_from_float)
+{
+    std::unordered_map<float, uint16_t> test_vals = {
+        {0, 0x0000},
+        {-0.0f, 0x8000},
+        {1, 0x3f80},
+        {-1, 0xbf80},
+        {2, 0x4000},
+        {0.5, 0x3f00},
+        {3.140625, 0x4049},
+        {1e-40f, 0x0001},
+        {65504, 0x4780},
+        {3.3895314e38f, 0x7f7f},
+    };
+
+    EXPECT(bool{std::all_of(test_vals.begin(), test_vals.end(), [](const auto sample) {
+        return bits_of(sample.first) == sample.second;
+    })});
+}
+
+TEST_CASE(test_round_to_nearest_even)
+{
+    // 1 + 2^-8 is halfway between 1 and the next bf16, so it rounds down to the even 1
+    EXPECT(bits_of(migraphx::bit_cast<float>(0x3f808000u)) == 0x3f80);
+    // 1 + 3 * 2^-8 is halfway with an odd lower neighbor, so it rounds up
+    EXPECT(bits_of(migraphx::bit_cast<float>(0x3f818000u)) == 0x3f82);
+    // Above halfway rounds up
+    EXPECT(bits_of(migraphx::bit_cast<float>(0x3f808001u)) == 0x3f81);
+    // Below halfway rounds down
+    EXPECT(bits_of(migraphx::bit_cast<float>(0x3f807fffu)) == 0x3f80);
+}
+
+TEST_CASE(test_positive_zero)
+{
+    float zero = 0.0;
+    migraphx::bf16 bf16_zero(zero);
+    EXPECT(bf16_zero.is_zero());
+    EXPECT(migraphx::float_equal(zero, float(bf16_zero)));
+}
+
+TEST_CASE(test_negative_zero)
+{
+    float nzero = -0.0;
+    migraphx::bf16 bf16_nzero(nzero);
+    EXPECT(bf16_nzero.is_zero());
+    EXPECT(std::signbit(float(bf16_nzero)));
+}
+
+TEST_CASE(test_nan)
+{
+    float fnan = std::numeric_limits<float>::quiet_NaN();
+    migraphx::bf16 bf16_nan(fnan);
+    EXPECT(bf16_nan.is_nan());
+    EXPECT(std::isnan(bf16_nan));
+    EXPECT(std::isnan(std::numeric_limits<migraphx::bf16>::quiet_NaN()));
+    // A nan whose payload is only in the lower bits must not become infinity
+    migraphx::bf16 bf16_low_nan(migraphx::bit_cast<float>(0x7f800001u));
+    EXPECT(bf16_low_nan.is_nan());
+}
+
+TEST_CASE(test_infinity)
+{
+    float finf = std::numeric_limits<float>::infinity();
+    migraphx::bf16 bf16_inf(finf);
+    EXPECT(bf16_inf.is_inf());
+    EXPECT(std::isinf(float(bf16_inf)));
+    EXPECT(bf16_inf == std::numeric_limits<migraphx::bf16>::infinity());
+    migraphx::bf16 bf16_ninf(-finf);
+    EXPECT(bf16_ninf.is_inf());
+    EXPECT(float(bf16_ninf) < 0);
+    // Values that round past the max become infinity
+    migraphx::bf16 bf16_overflow(std::numeric_limits<float>::max());
+    EXPECT(bf16_overflow.is_inf());
+}
+
+TEST_CASE(test_bool)
+{
+    migraphx::bf16 bf16_zero(0.0f);
+    migraphx::bf16 bf16_two(2.0f);
+    migraphx::bf16 bf16_other(-0.375f);
+    EXPECT(not static_cast<bool>(bf16_zero));
+    EXPECT(static_cast<bool>(bf16_two));
+    EXPECT(static_cast<bool>(bf16_other));
+}
+
+TEST_CASE(test_numeric_limits)
+{
+    using limits = std::numeric_limits<migraphx::bf16>;
+    EXPECT(migraphx::float_equal(float(limits::lowest()), -float(limits::max())));
+    EXPECT(migraphx::float_equal(float(limits::min()), std::numeric_limits<float>::min()));
+    EXPECT(migraphx::float_equal(float(limits::epsilon()), 0.0078125f));
+    EXPECT(std::isfinite(limits::max()));
+    EXPECT(not std::isfinite(limits::infinity()));
+    EXPECT(not std::isfinite(limits::quiet_NaN()));
+}
+
+TEST_CASE(test_binary_ops)
+{
+    auto a = migraphx::bf16(-1.0f);
+    auto b = migraphx::bf16(1.0f);
+    auto c = migraphx::bf16(0.0f);
+    EXPECT(migraphx::float_equal(a + b, c));
+
+    auto e = migraphx::bf16(10.0f);
+    auto f = migraphx::bf16(-10.0f);
+    EXPECT(bool{e > f});
+    EXPECT(bool{f < e});
+    EXPECT(bool{f <= e});
+    EXPECT(bool{e >= f});
+    EXPECT(not migraphx::float_equal(f, e));
+
+    auto g = migraphx::bf16(1.5f);
+    g += migraphx::bf16(2.0f);
+    g *= 2.0f;
+    EXPECT(migraphx::float_equal(g, migraphx::bf16(7.0f)));
+}
+
+TEST_CASE(test_fabs)
+{
+    auto a = migraphx::bf16(-1.0f);
+    auto b = migraphx::bf16(1.0f);
+    EXPECT(migraphx::float_equal(b, migraphx::fabs(a)));
+}
+
+TEST_CASE(test_stream_op)
+{
+    auto a = migraphx::bf16(-1.5f);
+    std::stringstream ss;
+    ss << a;
+    EXPECT(ss.str() == "-1.5");
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
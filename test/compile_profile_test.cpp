@@ -0,0 +1,109 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/compile_profile.hpp>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "test.hpp"
+
+struct profile_guard
+{
+    bool was_enabled = migraphx::compile_profile_enabled();
+    profile_guard(bool b)
+    {
+        migraphx::enable_compile_profile(b);
+        migraphx::reset_compile_profile();
+    }
+    ~profile_guard()
+    {
+        migraphx::reset_compile_profile();
+        migraphx::enable_compile_profile(was_enabled);
+    }
+};
+
+static const migraphx::compile_span& find_span(const std::vector<migraphx::compile_span>& spans,
+                                               const std::string& name)
+{
+    auto it =
+        std::find_if(spans.begin(), spans.end(), [&](const auto& s) { return s.name == name; });
+    if(it == spans.end())
+        throw std::runtime_error("Missing span: " + name);
+    return *it;
+}
+
+TEST_CASE(record_nested)
+{
+    profile_guard g{true};
+    {
+        migraphx::compile_profile_scope outer{"pass", "outer"};
+        EXPECT(outer.enabled());
+        {
+            migraphx::compile_profile_scope inner{"compile", "inner", {{"solution", 1}}};
+            inner.add("cache", "hit");
+        }
+    }
+    auto spans = migraphx::get_compile_profile();
+    EXPECT(spans.size() == 2);
+    const auto& outer = find_span(spans, "outer");
+    const auto& inner = find_span(spans, "inner");
+    EXPECT(outer.category == "pass");
+    EXPECT(inner.category == "compile");
+    EXPECT(inner.args.at("solution").to<int>() == 1);
+    EXPECT(inner.args.at("cache").to<std::string>() == "hit");
+    EXPECT(inner.thread == outer.thread);
+    EXPECT(inner.start >= outer.start);
+    EXPECT(inner.start + inner.duration <= outer.start + outer.duration);
+}
+
+TEST_CASE(disabled)
+{
+    profile_guard g{false};
+    {
+        migraphx::compile_profile_scope s{"pass", "p"};
+        EXPECT(not s.enabled());
+        s.add("x", 1);
+    }
+    EXPECT(migraphx::get_compile_profile().empty());
+}
+
+TEST_CASE(write_trace)
+{
+    profile_guard g{true};
+    {
+        migraphx::compile_profile_scope s{"benchmark", "gemm"};
+    }
+    std::stringstream ss;
+    migraphx::write_compile_profile(ss);
+    auto trace = ss.str();
+    EXPECT(trace.find("traceEvents") != std::string::npos);
+    EXPECT(trace.find("\"gemm\"") != std::string::npos);
+    EXPECT(trace.find("\"benchmark\"") != std::string::npos);
+
+    std::stringstream summary;
+    migraphx::print_compile_profile_summary(summary);
+    EXPECT(summary.str().find("benchmark") != std::string::npos);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
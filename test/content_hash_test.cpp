@@ -0,0 +1,141 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/content_hash.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+static std::string hash_bytes(const std::vector<char>& v)
+{
+    return migraphx::content_hash(v.data(), v.size());
+}
+
+static std::vector<char> iota_bytes(std::size_t n)
+{
+    std::vector<char> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+TEST_CASE(stable)
+{
+    // The hash is used in on-disk keys so it must not change between builds
+    EXPECT(hash_bytes({}) == "4b01edd5b4a318163a7c0fe9052f39fb");
+    EXPECT(hash_bytes(iota_bytes(1000)) == "0818e268c4c882538dbeadecfa495d83");
+}
+
+TEST_CASE(different_bytes)
+{
+    for(std::size_t n : {1, 63, 64, 65, 1024, 1025, 5000})
+    {
+        auto v = iota_bytes(n);
+        auto h = hash_bytes(v);
+        EXPECT(h.size() == 32);
+        for(std::size_t i : {std::size_t{0}, n / 2, n - 1})
+        {
+            auto w = v;
+            w[i] ^= 1;
+            EXPECT(hash_bytes(w) != h);
+        }
+    }
+}
+
+TEST_CASE(trailing_zeros)
+{
+    auto v = iota_bytes(10);
+    auto w = v;
+    w.push_back(0);
+    EXPECT(hash_bytes(v) != hash_bytes(w));
+}
+
+TEST_CASE(chunked)
+{
+    auto v = iota_bytes(9 << 20);
+    auto h = hash_bytes(v);
+    EXPECT(hash_bytes(v) == h);
+    for(std::size_t i : {std::size_t{0}, v.size() / 2, v.size() - 1})
+    {
+        auto w = v;
+        w[i] ^= 1;
+        EXPECT(hash_bytes(w) != h);
+    }
+    v.pop_back();
+    EXPECT(hash_bytes(v) != h);
+}
+
+TEST_CASE(literal_hash)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::literal l1{s, {1, 2, 3, 4, 5, 6}};
+    migraphx::literal l2{s, {1, 2, 3, 4, 5, 7}};
+    auto l3 = l1;
+    EXPECT(l1.content_hash() == migraphx::content_hash(l1.data(), s.bytes()));
+    EXPECT(l1.content_hash() != l2.content_hash());
+    EXPECT(&l3.content_hash() == &l1.content_hash());
+    EXPECT(migraphx::content_hash(l1.get_argument()) == l1.content_hash());
+}
+
+TEST_CASE(lazy_literal_hash)
+{
+    migraphx::shape s{migraphx::shape::int8_type, {1000}};
+    auto data = iota_bytes(1000);
+    migraphx::literal l{s, [&] {
+                            std::shared_ptr<char> p(new char[1000], std::default_delete<char[]>());
+                            std::copy(data.begin(), data.end(), p.get());
+                            return p;
+                        }};
+    EXPECT(l.content_hash() == hash_bytes(data));
+    EXPECT(l.is_loaded());
+}
+
+TEST_CASE(tuple_argument_hash)
+{
+    migraphx::literal l1{migraphx::shape{migraphx::shape::float_type, {2}}, {1, 2}};
+    migraphx::literal l2{migraphx::shape{migraphx::shape::int32_type, {3}}, {3, 4, 5}};
+    migraphx::argument a1{{l1.get_argument(), l2.get_argument()}};
+    migraphx::argument a2{{l2.get_argument(), l1.get_argument()}};
+    EXPECT(migraphx::content_hash(a1) != migraphx::content_hash(a2));
+    EXPECT(migraphx::content_hash(a1) == migraphx::content_hash(a1.share()));
+}
+
+TEST_CASE(compute_content_hashes)
+{
+    std::vector<migraphx::literal> lits;
+    for(std::size_t n : {16, 5 << 20, 100})
+    {
+        auto v = iota_bytes(n);
+        lits.emplace_back(migraphx::shape{migraphx::shape::int8_type, {n}}, v.data());
+    }
+    auto copies = lits;
+    migraphx::compute_content_hashes(lits);
+    for(const auto& l : copies)
+        EXPECT(l.content_hash() == migraphx::content_hash(l.data(), l.get_shape().bytes()));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
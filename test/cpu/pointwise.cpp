@@ -0,0 +1,157 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <algorithm>
+
+static bool has_instruction(const migraphx::program& p, const std::string& name)
+{
+    const auto* mm = p.get_main_module();
+    return std::any_of(
+        mm->begin(), mm->end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+static std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> v;
+    arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+    return v;
+}
+
+// Compile the program for the cpu and ref targets and compare every output
+static migraphx::program run_cpu(const migraphx::program& p)
+{
+    auto ref = p;
+    ref.compile(migraphx::make_target("ref"));
+    auto cpu = p;
+    cpu.compile(migraphx::make_target("cpu"));
+
+    migraphx::parameter_map params;
+    std::size_t seed = 0;
+    for(auto&& [name, s] : p.get_parameter_shapes())
+        params[name] = migraphx::generate_argument(s, seed++);
+    auto expected = ref.eval(params);
+    auto results  = cpu.eval(params);
+    EXPECT(results.size() == expected.size());
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        EXPECT(results[i].get_shape().lens() == expected[i].get_shape().lens());
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i]), to_vector(expected[i])));
+    }
+    return cpu;
+}
+
+TEST_CASE(pointwise_broadcast)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 4, 5}};
+    auto x    = mm->add_parameter("x", s);
+    auto b    = mm->add_parameter("b", {migraphx::shape::float_type, {3}});
+    auto bb   = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", s.lens()}}), b);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), x, bb);
+    auto mul  = mm->add_instruction(migraphx::make_op("mul"), add, x);
+    auto tanh = mm->add_instruction(migraphx::make_op("tanh"), mul);
+    mm->add_return({tanh});
+    auto cpu = run_cpu(p);
+    EXPECT(has_instruction(cpu, "cpu::pointwise"));
+}
+
+TEST_CASE(pointwise_transposed)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {4, 6, 5}});
+    auto y   = mm->add_parameter("y", {migraphx::shape::float_type, {5, 4, 6}});
+    auto xt =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {2, 0, 1}}}), x);
+    auto sub = mm->add_instruction(migraphx::make_op("sub"), xt, y);
+    auto exp = mm->add_instruction(migraphx::make_op("exp"), sub);
+    mm->add_return({exp});
+    auto cpu = run_cpu(p);
+    EXPECT(has_instruction(cpu, "cpu::pointwise"));
+}
+
+TEST_CASE(pointwise_scalar_broadcast)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {3, 7}};
+    migraphx::shape scalar{migraphx::shape::float_type};
+    auto x   = mm->add_parameter("x", s);
+    auto two = mm->add_literal(migraphx::literal{scalar, {2}});
+    auto mb =
+        mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), two);
+    auto mul = mm->add_instruction(migraphx::make_op("mul"), x, mb);
+    auto sig = mm->add_instruction(migraphx::make_op("sigmoid"), mul);
+    mm->add_return({sig});
+    auto cpu = run_cpu(p);
+    EXPECT(has_instruction(cpu, "cpu::pointwise"));
+}
+
+TEST_CASE(pointwise_multi_output)
+{
+    // The intermediate results are returned as well, so the fused modules have several users
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 8}};
+    auto x   = mm->add_parameter("x", s);
+    auto y   = mm->add_parameter("y", s);
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+    auto neg = mm->add_instruction(migraphx::make_op("neg"), add);
+    auto mul = mm->add_instruction(migraphx::make_op("mul"), add, y);
+    auto abs = mm->add_instruction(migraphx::make_op("abs"), mul);
+    mm->add_return({add, neg, abs});
+    run_cpu(p);
+}
+
+TEST_CASE(pointwise_tuple_output)
+{
+    // A pointwise module with several outputs is evaluated by the module rather than compiled
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 5}};
+    auto x   = mm->add_parameter("x", s);
+    auto y   = mm->add_parameter("y", s);
+    auto* pm = p.create_module("pointwise_tuple");
+    pm->set_bypass();
+    auto px  = pm->add_parameter("x0", migraphx::shape{migraphx::shape::float_type});
+    auto py  = pm->add_parameter("x1", migraphx::shape{migraphx::shape::float_type});
+    auto add = pm->add_instruction(migraphx::make_op("add"), px, py);
+    auto mul = pm->add_instruction(migraphx::make_op("mul"), add, py);
+    pm->add_return({add, mul});
+    auto pw = mm->add_instruction(migraphx::make_op("pointwise"), {x, y}, {pm});
+    auto r0 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), pw);
+    auto r1 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), pw);
+    mm->add_return({r0, r1});
+    run_cpu(p);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,163 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/verify.hpp>
+#include <algorithm>
+
+// Number of dnnl primitives that have post ops fused into them
+static std::size_t count_post_ops(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    return std::count_if(mm->begin(), mm->end(), [](const auto& ins) {
+        if(not migraphx::starts_with(ins.name(), "dnnl::"))
+            return false;
+        auto v = ins.get_operator().to_value();
+        return v.contains("post_ops") and not v.at("post_ops").empty();
+    });
+}
+
+static std::size_t count_instructions(const migraphx::program& p, const std::string& name)
+{
+    const auto* mm = p.get_main_module();
+    return std::count_if(
+        mm->begin(), mm->end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+static std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> v;
+    arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+    return v;
+}
+
+// Compile the program for the cpu and ref targets and compare the outputs
+static migraphx::program run_cpu(const migraphx::program& p)
+{
+    auto ref = p;
+    ref.compile(migraphx::make_target("ref"));
+    auto cpu = p;
+    cpu.compile(migraphx::make_target("cpu"));
+
+    migraphx::parameter_map params;
+    std::size_t seed = 0;
+    for(auto&& [name, s] : p.get_parameter_shapes())
+        params[name] = migraphx::generate_argument(s, seed++);
+    auto expected = ref.eval(params);
+    auto results  = cpu.eval(params);
+    EXPECT(results.size() == expected.size());
+    for(std::size_t i = 0; i < results.size(); i++)
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i]), to_vector(expected[i])));
+    return cpu;
+}
+
+static migraphx::instruction_ref add_scalar(migraphx::module& m, float x, const migraphx::shape& s)
+{
+    auto l = m.add_literal(migraphx::literal{migraphx::shape{s.type()}, {x}});
+    return m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), l);
+}
+
+TEST_CASE(conv_eltwise_chain)
+{
+    // bias add, relu and a scale after a convolution
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {1, 6, 8, 8}};
+    auto x    = mm->add_parameter("x", {migraphx::shape::float_type, {1, 4, 8, 8}});
+    auto w    = mm->add_parameter("w", {migraphx::shape::float_type, {6, 4, 3, 3}});
+    auto b    = mm->add_parameter("b", {migraphx::shape::float_type, {6}});
+    auto conv = mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w);
+    auto bb   = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", s.lens()}}), b);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), conv, bb);
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), add);
+    auto mul  = mm->add_instruction(migraphx::make_op("mul"), relu, add_scalar(*mm, 0.5f, s));
+    mm->add_return({mul});
+    auto cpu = run_cpu(p);
+    EXPECT(count_instructions(cpu, "dnnl::convolution") == 1);
+    EXPECT(count_post_ops(cpu) > 0);
+}
+
+TEST_CASE(conv_binary_chain)
+{
+    // A residual add and a clip after a convolution
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 6, 6}};
+    auto x    = mm->add_parameter("x", s);
+    auto w    = mm->add_parameter("w", {migraphx::shape::float_type, {3, 3, 1, 1}});
+    auto conv = mm->add_instruction(migraphx::make_op("convolution"), x, w);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), conv, x);
+    auto clip = mm->add_instruction(
+        migraphx::make_op("clip"), add, add_scalar(*mm, -1.0f, s), add_scalar(*mm, 1.0f, s));
+    mm->add_return({clip});
+    auto cpu = run_cpu(p);
+    EXPECT(count_instructions(cpu, "dnnl::convolution") == 1);
+    EXPECT(count_post_ops(cpu) > 0);
+}
+
+TEST_CASE(gemm_binary_chain)
+{
+    // A residual add, an activation and a gate after a gemm
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {16, 24}};
+    auto a    = mm->add_parameter("a", {migraphx::shape::float_type, {16, 32}});
+    auto b    = mm->add_parameter("b", {migraphx::shape::float_type, {32, 24}});
+    auto r1   = mm->add_parameter("r1", s);
+    auto r2   = mm->add_parameter("r2", s);
+    auto dot  = mm->add_instruction(migraphx::make_op("dot"), a, b);
+    auto add1 = mm->add_instruction(migraphx::make_op("add"), dot, r1);
+    auto tanh = mm->add_instruction(migraphx::make_op("tanh"), add1);
+    auto mul  = mm->add_instruction(migraphx::make_op("mul"), tanh, r2);
+    mm->add_return({mul});
+    auto cpu = run_cpu(p);
+    EXPECT(count_instructions(cpu, "dnnl::dot") == 1);
+    EXPECT(count_post_ops(cpu) > 0);
+}
+
+TEST_CASE(gemm_eltwise_chain)
+{
+    // A scale, offset and activation after a gemm
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {8, 12}};
+    auto a       = mm->add_parameter("a", {migraphx::shape::float_type, {8, 16}});
+    auto b       = mm->add_parameter("b", {migraphx::shape::float_type, {16, 12}});
+    auto dot     = mm->add_instruction(migraphx::make_op("dot"), a, b);
+    auto mul     = mm->add_instruction(migraphx::make_op("mul"), dot, add_scalar(*mm, 2.0f, s));
+    auto add     = mm->add_instruction(migraphx::make_op("add"), mul, add_scalar(*mm, 1.0f, s));
+    auto sigmoid = mm->add_instruction(migraphx::make_op("sigmoid"), add);
+    mm->add_return({sigmoid});
+    auto cpu = run_cpu(p);
+    EXPECT(count_instructions(cpu, "dnnl::dot") == 1);
+    EXPECT(count_post_ops(cpu) > 0);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <basic_ops.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/cpu/schedule_streams.hpp>
+#include <algorithm>
+#include <set>
+
+static void run_pass(migraphx::module& m, std::size_t streams)
+{
+    migraphx::run_passes(m, {migraphx::cpu::schedule_streams{streams}});
+}
+
+static std::set<std::size_t> get_streams(const migraphx::module& m)
+{
+    std::set<std::size_t> result;
+    for(const auto& ins : m)
+    {
+        if(ins.name() == "cpu::set_stream")
+            result.insert(ins.get_operator().to_value().at("stream").to<std::size_t>());
+    }
+    return result;
+}
+
+static std::size_t count_instructions(const migraphx::module& m, const std::string& name)
+{
+    return std::count_if(m.begin(), m.end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+// Two independent branches that are added together. The sum is returned, and also feeds the
+// instruction returned after it.
+static migraphx::instruction_ref add_branches(migraphx::module& m)
+{
+    migraphx::shape s{migraphx::shape::float_type, {8}};
+    auto x  = m.add_parameter("x", s);
+    auto y  = m.add_parameter("y", s);
+    auto a1 = m.add_instruction(sum_op{}, x, x);
+    auto a2 = m.add_instruction(sum_op{}, a1, a1);
+    auto b1 = m.add_instruction(minus_op{}, y, y);
+    auto b2 = m.add_instruction(minus_op{}, b1, b1);
+    return m.add_instruction(sum_op{}, a2, b2);
+}
+
+TEST_CASE(assign_streams)
+{
+    migraphx::module m;
+    auto sum    = add_branches(m);
+    auto logits = m.add_instruction(minus_op{}, sum, sum);
+    m.add_return({logits});
+    run_pass(m, 2);
+
+    EXPECT(get_streams(m) == std::set<std::size_t>{0, 1});
+    EXPECT(count_instructions(m, "cpu::record_event") > 0);
+    EXPECT(count_instructions(m, "cpu::wait_event") > 0);
+    EXPECT(count_instructions(m, "cpu::sync_stream") == 1);
+    EXPECT(bool{m.validate() == m.end()});
+}
+
+TEST_CASE(sync_only_rewires_return)
+{
+    migraphx::module m;
+    auto hidden = add_branches(m);
+    auto logits = m.add_instruction(minus_op{}, hidden, hidden);
+    m.add_return({hidden, logits});
+    run_pass(m, 2);
+
+    auto last = std::prev(m.end());
+    EXPECT(last->name() == "@return");
+    auto sync = last->inputs().front();
+    EXPECT(sync->name() == "cpu::sync_stream");
+    EXPECT(bool{sync->inputs() == std::vector<migraphx::instruction_ref>{hidden, logits}});
+    EXPECT(bool{last->inputs().back() == logits});
+    // The instructions before the sync still read the value itself
+    EXPECT(bool{logits->inputs() == std::vector<migraphx::instruction_ref>{hidden, hidden}});
+    EXPECT(bool{m.validate() == m.end()});
+}
+
+TEST_CASE(sync_without_return)
+{
+    migraphx::module m;
+    auto sum = add_branches(m);
+    m.add_instruction(minus_op{}, sum, sum);
+    run_pass(m, 2);
+
+    EXPECT(get_streams(m).size() == 2);
+    auto last = std::prev(m.end());
+    EXPECT(last->name() == "cpu::sync_stream");
+    EXPECT(bool{m.validate() == m.end()});
+}
+
+TEST_CASE(single_stream)
+{
+    migraphx::module m;
+    auto sum = add_branches(m);
+    m.add_return({sum});
+    auto before = m.size();
+    run_pass(m, 1);
+
+    EXPECT(m.size() == before);
+    EXPECT(get_streams(m).empty());
+    EXPECT(count_instructions(m, "cpu::sync_stream") == 0);
+}
+
+TEST_CASE(context_free_reader)
+{
+    // An instruction that reads its inputs without a context would run on the calling thread
+    // while the streams still write them, so the module is not scheduled
+    migraphx::module m;
+    auto sum = add_branches(m);
+    auto n   = m.add_instruction(nop{}, sum);
+    m.add_return({n});
+    auto before = m.size();
+    run_pass(m, 2);
+
+    EXPECT(m.size() == before);
+    EXPECT(get_streams(m).empty());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
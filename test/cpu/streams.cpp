@@ -0,0 +1,186 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/stream.hpp>
+#include <migraphx/cpu/target.hpp>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+TEST_CASE(event_wait_orders_streams)
+{
+    migraphx::cpu::stream s1;
+    migraphx::cpu::stream s2;
+    migraphx::cpu::event e;
+    std::mutex m;
+    std::vector<int> order;
+    auto push = [&](int i) {
+        std::lock_guard<std::mutex> lock(m);
+        order.push_back(i);
+    };
+    s1.enqueue([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        push(1);
+    });
+    e.record(s1);
+    e.wait(s2);
+    s2.enqueue([&] { push(2); });
+    s2.wait();
+    s1.wait();
+    EXPECT(order == std::vector<int>{1, 2});
+}
+
+TEST_CASE(event_wait_for_last_record)
+{
+    // A wait is for the last record issued before it, not for later ones
+    migraphx::cpu::stream s1;
+    migraphx::cpu::stream s2;
+    migraphx::cpu::event e;
+    std::mutex m;
+    std::vector<int> order;
+    auto push = [&](int i) {
+        std::lock_guard<std::mutex> lock(m);
+        order.push_back(i);
+    };
+    e.record(s1);
+    e.wait(s2);
+    s2.enqueue([&] { push(2); });
+    s2.wait();
+    s1.enqueue([&] { push(1); });
+    e.record(s1);
+    s1.wait();
+    EXPECT(order == std::vector<int>{2, 1});
+}
+
+TEST_CASE(stream_rethrows)
+{
+    migraphx::cpu::stream s;
+    s.enqueue([] { throw std::runtime_error("task failed"); });
+    EXPECT(test::throws([&] { s.wait(); }));
+    // The exception is only reported once
+    s.enqueue([] {});
+    s.wait();
+}
+
+// The cpu target with a fixed number of streams rather than MIGRAPHX_CPU_STREAMS
+struct cpu_streams_target : migraphx::cpu::target
+{
+    std::size_t streams = 3;
+    migraphx::context get_context() const
+    {
+        migraphx::cpu::context ctx;
+        ctx.nstreams = streams;
+        return ctx;
+    }
+};
+
+static migraphx::program create_branching_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {16, 32}};
+    migraphx::shape ws{migraphx::shape::float_type, {32, 32}};
+    auto x    = mm->add_parameter("x", s);
+    auto w1   = mm->add_literal(migraphx::generate_literal(ws, 1));
+    auto w2   = mm->add_literal(migraphx::generate_literal(ws, 2));
+    auto dot1 = mm->add_instruction(migraphx::make_op("dot"), x, w1);
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), dot1);
+    auto dot2 = mm->add_instruction(migraphx::make_op("dot"), x, w2);
+    auto tanh = mm->add_instruction(migraphx::make_op("tanh"), dot2);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), relu, tanh);
+    auto dot3 = mm->add_instruction(migraphx::make_op("dot"), add, w1);
+    auto sigm = mm->add_instruction(migraphx::make_op("sigmoid"), dot3);
+    mm->add_return({sigm, add});
+    return p;
+}
+
+TEST_CASE(schedule_branching_program)
+{
+    auto p = create_branching_program();
+    p.compile(cpu_streams_target{});
+    const auto* mm = p.get_main_module();
+
+    // The branches are spread over several streams
+    std::set<std::size_t> streams;
+    for(const auto& ins : *mm)
+    {
+        if(ins.name() == "cpu::set_stream")
+            streams.insert(ins.get_operator().to_value().at("stream").to<std::size_t>());
+    }
+    EXPECT(streams.size() > 1);
+
+    // Every wait comes after a record of the same event, and the results are only read once the
+    // streams are synchronized
+    std::unordered_map<std::size_t, std::size_t> records;
+    std::size_t waits = 0;
+    for(const auto& ins : *mm)
+    {
+        if(ins.name() == "cpu::record_event")
+            records[ins.get_operator().to_value().at("event").to<std::size_t>()]++;
+        if(ins.name() != "cpu::wait_event")
+            continue;
+        waits++;
+        EXPECT(records.count(ins.get_operator().to_value().at("event").to<std::size_t>()) > 0);
+    }
+    EXPECT(waits > 0);
+    auto last = std::prev(mm->end());
+    EXPECT(last->name() == "@return");
+    EXPECT(std::any_of(last->inputs().begin(), last->inputs().end(), [](auto input) {
+        return input->name() == "cpu::sync_stream";
+    }));
+
+    auto ref = create_branching_program();
+    ref.compile(migraphx::make_target("ref"));
+    auto to_vector = [](const migraphx::argument& arg) {
+        std::vector<float> v;
+        arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+        return v;
+    };
+    // Run several times so the events are recorded and waited on again
+    for(std::size_t seed = 0; seed < 4; seed++)
+    {
+        migraphx::parameter_map params;
+        params["x"]   = migraphx::generate_argument(p.get_parameter_shape("x"), seed);
+        auto results  = p.eval(params);
+        auto expected = ref.eval(params);
+        EXPECT(results.size() == expected.size());
+        for(std::size_t i = 0; i < results.size(); i++)
+            EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i]),
+                                                      to_vector(expected[i])));
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -25,6 +25,7 @@
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/instruction.hpp>
 #include <basic_ops.hpp>
+#include <pointwise.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/ranges.hpp>
 
@@ -286,4 +287,29 @@ TEST_CASE(tuple_test)
     EXPECT(std::distance(mm->begin(), mm->end()) == (count - 1));
 }
 
+TEST_CASE(many_submodules)
+{
+    // Independent submodules can be processed in parallel
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x = mm->add_parameter("x", s);
+    std::vector<migraphx::module_ref> pms;
+    for(int i = 0; i < 16; i++)
+    {
+        auto* pm = create_pointwise_module(
+            p, "pointwise" + std::to_string(i), {x}, [](auto* m, const auto& inputs) {
+                m->add_instruction(migraphx::make_op("exp"), inputs);
+                return m->add_instruction(migraphx::make_op("neg"), inputs);
+            });
+        pm->set_bypass(false);
+        pms.push_back(pm);
+        x = mm->add_instruction(migraphx::make_op("pointwise"), {x}, {pm});
+    }
+    mm->add_return({x});
+    run_pass(p);
+    EXPECT(migraphx::all_of(pms, [](auto* pm) { return pm->size() == 3; }));
+    EXPECT(mm->size() == 18);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -126,4 +126,21 @@ TEST_CASE(dom2)
     CHECK(not dom.strictly_dominate(ins5, ins6));
 }
 
+TEST_CASE(dom_cached)
+{
+    migraphx::module mm;
+    auto ins1 = mm.add_parameter("entry", {migraphx::shape::float_type});
+    auto ins2 = mm.add_instruction(pass_op{}, ins1);
+    auto ins3 = mm.add_instruction(pass_op{}, ins2);
+    auto dom  = migraphx::get_dominator_info(mm);
+    CHECK(dom == migraphx::get_dominator_info(mm));
+    CHECK(dom->strictly_dominate(ins2, ins3));
+
+    mm.replace_instruction(ins3, pass_op{}, ins1);
+    auto dom2 = migraphx::get_dominator_info(mm);
+    CHECK(dom != dom2);
+    CHECK(not dom2->strictly_dominate(ins2, ins3));
+    CHECK(dom2->strictly_dominate(ins1, ins3));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
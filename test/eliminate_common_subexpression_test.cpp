@@ -226,4 +226,80 @@ TEST_CASE(cse_test_submodule)
     EXPECT(p == create_program(true));
 }
 
+TEST_CASE(cse_wide_broadcasts)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::module m1;
+    {
+        auto x   = m1.add_parameter("x", s);
+        auto acc = x;
+        for(int i = 0; i < 8; i++)
+        {
+            auto l  = m1.add_literal(2.0f);
+            auto mb = m1.add_instruction(
+                migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), l);
+            auto mul = m1.add_instruction(migraphx::make_op("mul"), x, mb);
+            acc      = m1.add_instruction(migraphx::make_op("add"), acc, mul);
+        }
+        m1.add_return({acc});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x   = m2.add_parameter("x", s);
+        auto l   = m2.add_literal(2.0f);
+        auto mb  = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), l);
+        auto mul = m2.add_instruction(migraphx::make_op("mul"), x, mb);
+        auto acc = x;
+        for(int i = 0; i < 8; i++)
+            acc = m2.add_instruction(migraphx::make_op("add"), acc, mul);
+        m2.add_return({acc});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(cse_literals_same_shape)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    migraphx::module m1;
+    {
+        auto l1  = m1.add_literal(migraphx::literal{s, {1, 2, 3, 4}});
+        auto l2  = m1.add_literal(migraphx::literal{s, {1, 2, 3, 5}});
+        auto l3  = m1.add_literal(migraphx::literal{s, {1, 2, 3, 4}});
+        auto add = m1.add_instruction(migraphx::make_op("add"), l1, l2);
+        auto mul = m1.add_instruction(migraphx::make_op("mul"), add, l3);
+        m1.add_return({mul});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto l1  = m2.add_literal(migraphx::literal{s, {1, 2, 3, 4}});
+        auto l2  = m2.add_literal(migraphx::literal{s, {1, 2, 3, 5}});
+        auto add = m2.add_instruction(migraphx::make_op("add"), l1, l2);
+        auto mul = m2.add_instruction(migraphx::make_op("mul"), add, l1);
+        m2.add_return({mul});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(cse_random_seed)
+{
+    migraphx::module m1;
+    {
+        migraphx::shape s{migraphx::shape::float_type, {4}};
+        auto buffer = m1.add_literal(migraphx::literal{s, {0, 0, 0, 0}});
+        auto seed1  = m1.add_instruction(migraphx::make_op("random_seed"));
+        auto seed2  = m1.add_instruction(migraphx::make_op("random_seed"));
+        auto r1     = m1.add_instruction(migraphx::make_op("random_uniform"), seed1, buffer);
+        auto r2     = m1.add_instruction(migraphx::make_op("random_uniform"), seed2, buffer);
+        m1.add_return({r1, r2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -23,6 +23,7 @@
  */
 #include <migraphx/eliminate_concat.hpp>
 #include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/op/concat.hpp>
 #include <migraphx/op/load.hpp>
@@ -78,11 +79,20 @@ struct concat_test_optimization
     }
 };
 
-void run_pass(migraphx::module& m)
+struct concat_strided_test_optimization : concat_test_optimization
 {
-    migraphx::run_passes(m,
-                         {migraphx::eliminate_concat{concat_test_optimization{}},
-                          migraphx::dead_code_elimination{}});
+    /// Producers can write into a strided view of the concat output
+    bool supports_strided_output(migraphx::instruction_ref ins) const
+    {
+        return ins->name() == "simple_op";
+    }
+};
+
+template <class ConcatOpt = concat_test_optimization>
+void run_pass(migraphx::module& m, ConcatOpt concat_opt = {})
+{
+    migraphx::run_passes(
+        m, {migraphx::eliminate_concat{concat_opt}, migraphx::dead_code_elimination{}});
 }
 
 struct allocate
@@ -422,4 +432,48 @@ TEST_CASE(wont_work)
     EXPECT(m1 == m2);
 }
 
+TEST_CASE(strided)
+{
+    auto create_test_program = [] {
+        migraphx::module m;
+        auto a1 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 2, 8, 8}}});
+        auto m1 = m.add_instruction(simple_op{}, a1);
+        auto a2 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 3, 8, 8}}});
+        auto m2 = m.add_instruction(simple_op{}, a2);
+        auto a3 =
+            m.add_instruction(allocate{migraphx::shape{migraphx::shape::float_type, {2, 5, 8, 8}}});
+        auto p3          = m.add_instruction(simple_op{}, a3);
+        std::size_t axis = 1;
+        auto a4          = m.add_instruction(
+            allocate{migraphx::shape{migraphx::shape::float_type, {2, 10, 8, 8}}});
+        m.add_instruction(concat(axis), m1, m2, p3, a4);
+        return m;
+    };
+    auto create_control_program = [] {
+        migraphx::module m;
+        std::vector<std::size_t> strides = {640, 64, 8, 1};
+        auto a1                          = m.add_instruction(
+            allocate{migraphx::shape{migraphx::shape::float_type, {2, 10, 8, 8}}});
+        auto l1 = m.add_instruction(
+            load{migraphx::shape{migraphx::shape::float_type, {2, 2, 8, 8}, strides}, 0}, {a1});
+        auto m1 = m.add_instruction(simple_op{}, l1);
+        auto l2 = m.add_instruction(
+            load{migraphx::shape{migraphx::shape::float_type, {2, 3, 8, 8}, strides}, 512}, {a1});
+        auto m2 = m.add_instruction(simple_op{}, l2);
+        auto l3 = m.add_instruction(
+            load{migraphx::shape{migraphx::shape::float_type, {2, 5, 8, 8}, strides}, 1280}, {a1});
+        auto p3 = m.add_instruction(simple_op{}, l3);
+        m.add_instruction(identity{}, {a1, m1, m2, p3});
+        return m;
+    };
+
+    auto m1 = create_test_program();
+    auto m2 = create_control_program();
+    run_pass(m1, concat_strided_test_optimization{});
+
+    EXPECT(m1 == m2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -91,4 +91,23 @@ TEST_CASE(quant)
     EXPECT(mm1 == mm2);
 }
 
+TEST_CASE(supported_ops)
+{
+    migraphx::shape s{migraphx::shape::int8_type, {2, 2}};
+    migraphx::module mm1;
+    {
+        auto x = mm1.add_parameter("x", s);
+        auto y = mm1.add_parameter("y", s);
+        mm1.add_instruction(migraphx::make_op("quant_dot"), x, y);
+    }
+    migraphx::module mm2 = mm1;
+    migraphx::run_passes(mm1,
+                         {migraphx::eliminate_data_type{{migraphx::shape::int8_type},
+                                                        migraphx::shape::float_type,
+                                                        {"all"},
+                                                        {"quant_dot"}},
+                          migraphx::dead_code_elimination{}});
+    EXPECT(mm1 == mm2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
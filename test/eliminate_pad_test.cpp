@@ -28,6 +28,7 @@
 #include <migraphx/instruction.hpp>
 #include <basic_ops.hpp>
 #include <migraphx/op/common.hpp>
+#include <migraphx/op/pad.hpp>
 #include <migraphx/make_op.hpp>
 
 #include <test.hpp>
@@ -128,4 +129,84 @@ TEST_CASE(rewrite_pad_im2col_asymmetric)
         m.begin(), m.end(), [](const migraphx::instruction& ins) { return ins.name() == "pad"; }));
 }
 
+TEST_CASE(rewrite_pad_average_pooling_asymmetric)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {1, 3, 5, 5}};
+    auto x      = m.add_parameter("x", s);
+    auto padded = m.add_instruction(
+        migraphx::make_op("pad", {{"pads", {0, 0, 0, 1, 0, 0, 2, 1}}}), x);
+    auto pooling = m.add_instruction(
+        migraphx::make_op("pooling",
+                          {{"mode", migraphx::op::pooling_mode::average}, {"lengths", {3, 3}}}),
+        padded);
+    m.add_return({pooling});
+
+    auto s0 = pooling->get_shape();
+    run_pass(m);
+    EXPECT(pooling->get_shape() == s0);
+    auto v = pooling->get_operator().to_value();
+    EXPECT(v["padding"].to_vector<std::size_t>() == std::vector<std::size_t>{0, 1, 2, 1});
+    EXPECT(v["count_include_pad"].to<bool>());
+    EXPECT(std::none_of(
+        m.begin(), m.end(), [](const migraphx::instruction& ins) { return ins.name() == "pad"; }));
+}
+
+TEST_CASE(rewrite_pad_average_pooling_exclude_pad)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {1, 3, 5, 5}};
+    auto x      = m.add_parameter("x", s);
+    auto padded = m.add_instruction(
+        migraphx::make_op("pad", {{"pads", {0, 0, 0, 1, 0, 0, 2, 1}}}), x);
+    auto pooling = m.add_instruction(
+        migraphx::make_op("pooling",
+                          {{"mode", migraphx::op::pooling_mode::average},
+                           {"padding", {1, 1}},
+                           {"lengths", {3, 3}}}),
+        padded);
+    m.add_return({pooling});
+
+    run_pass(m);
+    EXPECT(bool{pooling->inputs().front() == padded});
+}
+
+TEST_CASE(rewrite_pad_nonzero_value)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {1, 3, 5, 5}};
+    auto x      = m.add_parameter("x", s);
+    auto w      = m.add_parameter("w", {migraphx::shape::float_type, {4, 3, 3, 3}});
+    auto padded = m.add_instruction(
+        migraphx::make_op("pad", {{"pads", {0, 0, 1, 1, 0, 0, 1, 1}}, {"value", 1.0f}}), x);
+    auto conv    = m.add_instruction(migraphx::make_op("convolution"), padded, w);
+    auto pooling = m.add_instruction(
+        migraphx::make_op("pooling",
+                          {{"mode", migraphx::op::pooling_mode::average}, {"lengths", {3, 3}}}),
+        padded);
+    m.add_return({conv, pooling});
+
+    run_pass(m);
+    EXPECT(bool{conv->inputs().front() == padded});
+    EXPECT(bool{pooling->inputs().front() == padded});
+}
+
+TEST_CASE(rewrite_pad_reflect)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {1, 3, 5, 5}};
+    auto x      = m.add_parameter("x", s);
+    auto w      = m.add_parameter("w", {migraphx::shape::float_type, {4, 3, 3, 3}});
+    auto padded = m.add_instruction(
+        migraphx::make_op("pad",
+                          {{"pads", {0, 0, 1, 1, 0, 0, 1, 1}},
+                           {"mode", migraphx::op::pad::reflect_pad}}),
+        x);
+    auto conv = m.add_instruction(migraphx::make_op("convolution"), padded, w);
+    m.add_return({conv});
+
+    run_pass(m);
+    EXPECT(bool{conv->inputs().front() == padded});
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
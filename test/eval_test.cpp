@@ -28,7 +28,9 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/compile_options.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
 #include <sstream>
+#include <thread>
 #include "test.hpp"
 #include <basic_ops.hpp>
 
@@ -499,6 +501,227 @@ TEST_CASE(eval_context3)
     EXPECT(not is_shared(t.ctx, p.get_context()));
 }
 
+TEST_CASE(eval_compiled_params)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto y   = mm->add_parameter("y", {migraphx::shape::int32_type});
+    auto sum = mm->add_instruction(sum_op{}, x, y);
+    auto sub = mm->add_instruction(minus_op{}, sum, y);
+    mm->add_return({sum, sub});
+    p.compile(id_target{});
+    auto results = p.eval({{"x", migraphx::literal{1}.get_argument()},
+                           {"y", migraphx::literal{2}.get_argument()}});
+    EXPECT(results.size() == 2);
+    EXPECT(results.front() == migraphx::literal{3});
+    EXPECT(results.back() == migraphx::literal{1});
+    EXPECT(test::throws<migraphx::exception>(
+        [&] {
+            p.eval({{"x", migraphx::literal{1}.get_argument()}});
+        },
+        "Parameter not found: y"));
+}
+
+TEST_CASE(eval_compiled_modified)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    auto sum = mm->add_instruction(sum_op{}, one, two);
+    p.compile(id_target{});
+    EXPECT(p.eval({}).back() == migraphx::literal{3});
+    mm->replace_instruction(sum, minus_op{}, one, two);
+    EXPECT(p.eval({}).back() == migraphx::literal{-1});
+}
+
+TEST_CASE(eval_compiled_copy)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    mm->add_instruction(sum_op{}, one, two);
+    p1.compile(id_target{});
+    migraphx::program p2 = p1;
+    EXPECT(p2.eval({}).back() == migraphx::literal{3});
+    auto* mm1 = p1.get_main_module();
+    mm1->replace_instruction(std::prev(mm1->end()), minus_op{}, one, two);
+    EXPECT(p1.eval({}).back() == migraphx::literal{-1});
+    EXPECT(p2.eval({}).back() == migraphx::literal{3});
+}
+
+TEST_CASE(eval_session)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    mm->add_instruction(sum_op{}, x, two);
+    p1.compile(id_target{});
+    auto p2 = p1.create_session();
+    EXPECT(p2.is_compiled());
+    EXPECT(not is_shared(p1.get_context(), p2.get_context()));
+    EXPECT(p1.eval({{"x", migraphx::literal{1}.get_argument()}}).back() == migraphx::literal{3});
+    EXPECT(p2.eval({{"x", migraphx::literal{5}.get_argument()}}).back() == migraphx::literal{7});
+}
+
+TEST_CASE(eval_concurrent)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    mm->add_instruction(sum_op{}, x, two);
+    p.compile(id_target{});
+    const int n = 4;
+    std::vector<int> results(n);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < n; i++)
+    {
+        threads.emplace_back([&, i] {
+            for(int j = 0; j < 100; j++)
+            {
+                auto r = p.eval({{"x", migraphx::literal{i + j}.get_argument()}}).back();
+                results[i] += r.at<int>() - j;
+            }
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+    for(int i = 0; i < n; i++)
+        EXPECT(results[i] == (i + 2) * 100);
+    // The program's own contexts are used again once the other calls finished
+    EXPECT(p.eval({{"x", migraphx::literal{1}.get_argument()}}).back() == migraphx::literal{3});
+}
+
+TEST_CASE(eval_many)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    mm->add_instruction(sum_op{}, x, two);
+    p.compile(id_target{});
+    std::vector<migraphx::parameter_map> requests;
+    for(int i = 0; i < 10; i++)
+        requests.push_back({{"x", migraphx::literal{i}.get_argument()}});
+    auto results = p.eval_many(requests, 3);
+    EXPECT(results.size() == requests.size());
+    for(int i = 0; i < 10; i++)
+        EXPECT(results[i].back() == migraphx::literal{i + 2});
+
+    std::vector<int> completed(requests.size());
+    auto empty = p.eval_many(requests, 2, [&](std::size_t i, std::vector<migraphx::argument> r) {
+        completed[i] = r.back().at<int>();
+    });
+    EXPECT(empty.size() == requests.size());
+    EXPECT(std::all_of(empty.begin(), empty.end(), [](const auto& r) { return r.empty(); }));
+    for(int i = 0; i < 10; i++)
+        EXPECT(completed[i] == i + 2);
+
+    requests[4].clear();
+    EXPECT(test::throws([&] { p.eval_many(requests); }));
+}
+
+TEST_CASE(eval_on_complete)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    mm->add_instruction(sum_op{}, x, two);
+    p.compile(id_target{});
+    int calls = 0;
+    migraphx::execution_environment exec_env;
+    exec_env.on_complete = [&] { calls++; };
+    EXPECT(p.eval({{"x", migraphx::literal{1}.get_argument()}}, exec_env).back() ==
+           migraphx::literal{3});
+    EXPECT(calls == 1);
+    // Contexts without queues call it once they are finished
+    exec_env.async = true;
+    EXPECT(p.eval({{"x", migraphx::literal{2}.get_argument()}}, exec_env).back() ==
+           migraphx::literal{4});
+    EXPECT(calls == 2);
+}
+
+TEST_CASE(eval_trace)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    auto sum = mm->add_instruction(sum_op{}, x, two);
+    mm->add_instruction(minus_op{}, sum, two);
+    p.compile(id_target{});
+    p.enable_trace(3);
+    for(int i = 0; i < 4; i++)
+        EXPECT(p.eval({{"x", migraphx::literal{i}.get_argument()}}).back() ==
+               migraphx::literal{i});
+    std::stringstream ss;
+    p.print_trace(ss);
+    auto trace = ss.str();
+    // Only the last three instructions are kept
+    EXPECT(not migraphx::contains(trace, "Run 1:"));
+    EXPECT(migraphx::contains(trace, "Run 2: @3 = minus"));
+    EXPECT(migraphx::contains(trace, "Run 3: @2 = sum"));
+    EXPECT(migraphx::contains(trace, "Run 3: @3 = minus"));
+    EXPECT(not migraphx::contains(trace, "@param"));
+
+    p.enable_trace(0);
+    std::stringstream empty;
+    p.print_trace(empty);
+    EXPECT(empty.str().empty());
+}
+
+TEST_CASE(eval_bound)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto y   = mm->add_parameter("y", {migraphx::shape::int32_type});
+    auto sum = mm->add_instruction(sum_op{}, x, y);
+    auto sub = mm->add_instruction(minus_op{}, sum, y);
+    mm->add_return({sum, sub});
+    p.compile(id_target{});
+    int xd = 1;
+    int yd = 2;
+    migraphx::shape s{migraphx::shape::int32_type};
+    p.bind({{"x", migraphx::argument{s, &xd}}, {"y", migraphx::argument{s, &yd}}});
+    auto& results = p.run_bound();
+    EXPECT(results.size() == 2);
+    EXPECT(results.front() == migraphx::literal{3});
+    EXPECT(results.back() == migraphx::literal{1});
+    // The bound buffers are read again on every run
+    xd = 5;
+    EXPECT(&p.run_bound() == &results);
+    EXPECT(results.front() == migraphx::literal{7});
+    EXPECT(results.back() == migraphx::literal{5});
+    EXPECT(test::throws<migraphx::exception>(
+        [&] {
+            p.bind({{"x", migraphx::argument{s, &xd}}});
+        },
+        "Parameter not found: y"));
+}
+
+TEST_CASE(eval_bound_modified)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    auto sum = mm->add_instruction(sum_op{}, x, two);
+    p.compile(id_target{});
+    p.bind({{"x", migraphx::literal{1}.get_argument()}});
+    EXPECT(p.run_bound().back() == migraphx::literal{3});
+    mm->replace_instruction(sum, minus_op{}, x, two);
+    EXPECT(p.run_bound().back() == migraphx::literal{-1});
+    // Copies don't share the bound parameters
+    migraphx::program p2 = p;
+    EXPECT(test::throws<migraphx::exception>([&] { p2.run_bound(); }, "Parameter not found: x"));
+}
+
 struct cout_redirect
 {
     cout_redirect()                     = delete;
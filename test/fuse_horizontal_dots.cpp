@@ -0,0 +1,204 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/fuse_horizontal_dots.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::fuse_horizontal_dots{}, migraphx::dead_code_elimination{}});
+}
+
+static migraphx::instruction_ref
+add_stack(migraphx::module& m, const std::vector<migraphx::instruction_ref>& inputs)
+{
+    std::vector<migraphx::instruction_ref> args;
+    std::transform(inputs.begin(), inputs.end(), std::back_inserter(args), [&](auto input) {
+        return m.add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), input);
+    });
+    return m.add_instruction(migraphx::make_op("concat", {{"axis", 0}}), args);
+}
+
+static migraphx::instruction_ref
+add_unstack(migraphx::module& m, migraphx::instruction_ref fused, std::size_t i)
+{
+    auto slice = m.add_instruction(
+        migraphx::make_op("slice", {{"axes", {0}}, {"starts", {i}}, {"ends", {i + 1}}}), fused);
+    return m.add_instruction(migraphx::make_op("squeeze", {{"axes", {0}}}), slice);
+}
+
+TEST_CASE(horizontal_dots)
+{
+    migraphx::shape as{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {8, 16}};
+    migraphx::module m1;
+    {
+        auto a1   = m1.add_parameter("a1", as);
+        auto b1   = m1.add_parameter("b1", bs);
+        auto a2   = m1.add_parameter("a2", as);
+        auto b2   = m1.add_parameter("b2", bs);
+        auto a3   = m1.add_parameter("a3", as);
+        auto b3   = m1.add_parameter("b3", bs);
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), a1, b1);
+        auto dot2 = m1.add_instruction(migraphx::make_op("dot"), a2, b2);
+        auto dot3 = m1.add_instruction(migraphx::make_op("dot"), a3, b3);
+        m1.add_return({dot1, dot2, dot3});
+    }
+    run_pass(m1);
+    migraphx::module m2;
+    {
+        auto a1    = m2.add_parameter("a1", as);
+        auto b1    = m2.add_parameter("b1", bs);
+        auto a2    = m2.add_parameter("a2", as);
+        auto b2    = m2.add_parameter("b2", bs);
+        auto a3    = m2.add_parameter("a3", as);
+        auto b3    = m2.add_parameter("b3", bs);
+        auto a     = add_stack(m2, {a1, a2, a3});
+        auto b     = add_stack(m2, {b1, b2, b3});
+        auto fused = m2.add_instruction(migraphx::make_op("dot"), a, b);
+        auto dot1  = add_unstack(m2, fused, 0);
+        auto dot2  = add_unstack(m2, fused, 1);
+        auto dot3  = add_unstack(m2, fused, 2);
+        m2.add_return({dot1, dot2, dot3});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(horizontal_dots_move_inputs)
+{
+    migraphx::shape as{migraphx::shape::float_type, {2, 4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {2, 8, 4}};
+    migraphx::module m1;
+    {
+        auto a1   = m1.add_parameter("a1", as);
+        auto b1   = m1.add_parameter("b1", bs);
+        auto a2   = m1.add_parameter("a2", as);
+        auto b2   = m1.add_parameter("b2", bs);
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), a1, b1);
+        auto relu = m1.add_instruction(migraphx::make_op("relu"), dot1);
+        auto tanh = m1.add_instruction(migraphx::make_op("tanh"), a2);
+        auto dot2 = m1.add_instruction(migraphx::make_op("dot"), tanh, b2);
+        m1.add_return({relu, dot2});
+    }
+    run_pass(m1);
+    migraphx::module m2;
+    {
+        auto a1    = m2.add_parameter("a1", as);
+        auto b1    = m2.add_parameter("b1", bs);
+        auto a2    = m2.add_parameter("a2", as);
+        auto b2    = m2.add_parameter("b2", bs);
+        auto tanh  = m2.add_instruction(migraphx::make_op("tanh"), a2);
+        auto a     = add_stack(m2, {a1, tanh});
+        auto b     = add_stack(m2, {b1, b2});
+        auto fused = m2.add_instruction(migraphx::make_op("dot"), a, b);
+        auto dot1  = add_unstack(m2, fused, 0);
+        auto dot2  = add_unstack(m2, fused, 1);
+        auto relu  = m2.add_instruction(migraphx::make_op("relu"), dot1);
+        m2.add_return({relu, dot2});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(horizontal_dots_dependent)
+{
+    migraphx::shape s{migraphx::shape::float_type, {8, 8}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", s);
+        auto w1   = m1.add_parameter("w1", s);
+        auto w2   = m1.add_parameter("w2", s);
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), x, w1);
+        auto dot2 = m1.add_instruction(migraphx::make_op("dot"), dot1, w2);
+        m1.add_return({dot2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(horizontal_dots_different_shapes)
+{
+    migraphx::module m1;
+    {
+        auto a1   = m1.add_parameter("a1", {migraphx::shape::float_type, {4, 8}});
+        auto b1   = m1.add_parameter("b1", {migraphx::shape::float_type, {8, 16}});
+        auto a2   = m1.add_parameter("a2", {migraphx::shape::float_type, {4, 8}});
+        auto b2   = m1.add_parameter("b2", {migraphx::shape::float_type, {8, 32}});
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), a1, b1);
+        auto dot2 = m1.add_instruction(migraphx::make_op("dot"), a2, b2);
+        m1.add_return({dot1, dot2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(horizontal_dots_large)
+{
+    migraphx::shape as{migraphx::shape::float_type, {256, 256}};
+    migraphx::shape bs{migraphx::shape::float_type, {256, 512}};
+    migraphx::module m1;
+    {
+        auto a1   = m1.add_parameter("a1", as);
+        auto b1   = m1.add_parameter("b1", bs);
+        auto a2   = m1.add_parameter("a2", as);
+        auto b2   = m1.add_parameter("b2", bs);
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), a1, b1);
+        auto dot2 = m1.add_instruction(migraphx::make_op("dot"), a2, b2);
+        m1.add_return({dot1, dot2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(horizontal_dots_max_multiply_adds)
+{
+    migraphx::shape as{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {8, 16}};
+    migraphx::module m1;
+    {
+        auto a1   = m1.add_parameter("a1", as);
+        auto b1   = m1.add_parameter("b1", bs);
+        auto a2   = m1.add_parameter("a2", as);
+        auto b2   = m1.add_parameter("b2", bs);
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), a1, b1);
+        auto dot2 = m1.add_instruction(migraphx::make_op("dot"), a2, b2);
+        m1.add_return({dot1, dot2});
+    }
+    migraphx::module m2 = m1;
+    // Each dot has 4 * 16 * 8 multiply-adds
+    migraphx::run_passes(m1, {migraphx::fuse_horizontal_dots{4 * 16 * 8 - 1}});
+    EXPECT(m1.sort() == m2.sort());
+    migraphx::run_passes(m1, {migraphx::fuse_horizontal_dots{4 * 16 * 8}});
+    EXPECT(std::count_if(m1.begin(), m1.end(), [](const auto& ins) {
+               return ins.name() == "dot";
+           }) == 1);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -612,4 +612,70 @@ TEST_CASE(add_broadcast_add)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(gather_add_relu)
+{
+    migraphx::shape ws{migraphx::shape::float_type, {16, 4}};
+    migraphx::shape is{migraphx::shape::int32_type, {2, 3}};
+    migraphx::shape ps{migraphx::shape::float_type, {2, 3, 4}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto w      = mm->add_parameter("w", ws);
+        auto ind    = mm->add_parameter("ind", is);
+        auto pos    = mm->add_parameter("pos", ps);
+        auto gather = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), w, ind);
+        auto add    = mm->add_instruction(migraphx::make_op("add"), pos, gather);
+        auto relu   = mm->add_instruction(migraphx::make_op("relu"), add);
+        mm->add_return({relu});
+    }
+    run_pass(p1, {.enable_gather_fusion = true});
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto w   = mm->add_parameter("w", ws);
+        auto ind = mm->add_parameter("ind", is);
+        auto pos = mm->add_parameter("pos", ps);
+        auto* pm = p2.create_module("main:pointwise0:gather");
+        pm->set_bypass();
+        auto x0   = pm->add_parameter("x0", migraphx::shape{migraphx::shape::float_type});
+        auto x1   = pm->add_parameter("!x1", migraphx::shape{migraphx::shape::float_type});
+        auto add  = pm->add_instruction(migraphx::make_op("add"), x0, x1);
+        auto relu = pm->add_instruction(migraphx::make_op("relu"), add);
+        pm->add_return({relu});
+        auto fused = mm->add_instruction(
+            migraphx::make_op("fused_gather", {{"axis", 0}}), {w, ind, pos}, {pm});
+        mm->add_return({fused});
+    }
+    EXPECT(p1.sort() == p2.sort());
+}
+
+TEST_CASE(gather_used_twice)
+{
+    migraphx::shape ws{migraphx::shape::float_type, {16, 4}};
+    migraphx::shape is{migraphx::shape::int32_type, {3}};
+    migraphx::shape ps{migraphx::shape::float_type, {3, 4}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto w      = mm->add_parameter("w", ws);
+        auto ind    = mm->add_parameter("ind", is);
+        auto pos    = mm->add_parameter("pos", ps);
+        auto gather = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), w, ind);
+        auto add    = mm->add_instruction(migraphx::make_op("add"), gather, pos);
+        mm->add_return({add, gather});
+    }
+    run_pass(p1, {.enable_gather_fusion = true});
+    migraphx::program p2;
+    {
+        auto* mm    = p2.get_main_module();
+        auto w      = mm->add_parameter("w", ws);
+        auto ind    = mm->add_parameter("ind", is);
+        auto pos    = mm->add_parameter("pos", ps);
+        auto gather = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), w, ind);
+        auto add = add_pointwise(p2, "main:pointwise0", {gather, pos}, single_pointwise("add"));
+        mm->add_return({add, gather});
+    }
+    EXPECT(p1.sort() == p2.sort());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -38,6 +38,13 @@ void run_pass(migraphx::program& p)
     migraphx::run_passes(p, {migraphx::fuse_reduce{}, migraphx::dead_code_elimination{}});
 }
 
+void run_multi_output_pass(migraphx::program& p)
+{
+    migraphx::run_passes(p,
+                         {migraphx::fuse_reduce{.enable_multi_output = true},
+                          migraphx::dead_code_elimination{}});
+}
+
 TEST_CASE(single)
 {
     migraphx::shape s{migraphx::shape::float_type, {2, 3}};
@@ -97,6 +104,116 @@ TEST_CASE(pointwise_reduce)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(pointwise_argmax)
+{
+    migraphx::shape s{migraphx::shape::half_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", s);
+        auto y   = mm->add_parameter("y", s);
+        auto mul = add_pointwise(p1, "main:pointwise0", {x, y}, single_pointwise("mul"));
+        auto argmax =
+            mm->add_instruction(migraphx::make_op("argmax", {{"axis", 1}}), mul);
+        mm->add_return({argmax});
+    }
+    run_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm    = p2.get_main_module();
+        auto x      = mm->add_parameter("x", s);
+        auto y      = mm->add_parameter("y", s);
+        auto argmax = add_reduce(
+            p2,
+            "main:pointwise0:main:argmax0",
+            {x, y},
+            {1},
+            [&](auto* rm, const auto& inputs, const auto& axes) {
+                auto mul =
+                    add_pointwise(p2, rm, "main:pointwise0", inputs, single_pointwise("mul"));
+                return rm->add_instruction(
+                    migraphx::make_op("argmax", {{"axis", axes.front()}}), mul);
+            });
+        mm->add_return({argmax});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(pointwise_reduce_multi_output)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto y    = mm->add_parameter("y", s);
+        auto z    = mm->add_parameter("z", s);
+        auto add  = add_pointwise(p1, "main:pointwise0", {x, y}, single_pointwise("add"));
+        auto rsum = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), add);
+        auto mul  = add_pointwise(p1, "main:pointwise1", {add, z}, single_pointwise("mul"));
+        mm->add_return({rsum, mul});
+    }
+    run_multi_output_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm   = p2.get_main_module();
+        auto x     = mm->add_parameter("x", s);
+        auto y     = mm->add_parameter("y", s);
+        auto z     = mm->add_parameter("z", s);
+        auto fused = add_reduce(
+            p2,
+            "main:pointwise0:main:reduce_sum0",
+            {x, y},
+            {1},
+            [&](auto* rm, const auto& inputs, const auto& axes) {
+                auto add =
+                    add_pointwise(p2, rm, "main:pointwise0", inputs, single_pointwise("add"));
+                auto rsum =
+                    rm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", axes}}), add);
+                return std::vector<migraphx::instruction_ref>{rsum, add};
+            });
+        auto add  = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), fused);
+        auto rsum = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), fused);
+        auto mul  = add_pointwise(p2, "main:pointwise1", {add, z}, single_pointwise("mul"));
+        mm->add_return({rsum, mul});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(pointwise_reduce_multi_output_used_before)
+{
+    // The other user of the pointwise comes before the reduction so it can't read the output
+    // of the fused reduction
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto y    = mm->add_parameter("y", s);
+        auto z    = mm->add_parameter("z", s);
+        auto add  = add_pointwise(p1, "main:pointwise0", {x, y}, single_pointwise("add"));
+        auto mul  = add_pointwise(p1, "main:pointwise1", {add, z}, single_pointwise("mul"));
+        auto rsum = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), add);
+        mm->add_return({rsum, mul});
+    }
+    run_multi_output_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm  = p2.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto y    = mm->add_parameter("y", s);
+        auto z    = mm->add_parameter("z", s);
+        auto add  = add_pointwise(p2, "main:pointwise0", {x, y}, single_pointwise("add"));
+        auto mul  = add_pointwise(p2, "main:pointwise1", {add, z}, single_pointwise("mul"));
+        auto rsum = add_reduce(p2, "main:reduce_sum0", {add}, {1}, single_reduce("reduce_sum"));
+        mm->add_return({rsum, mul});
+    }
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(scalar_multibroadcast)
 {
     // Matches the find_pointwise_reduce matcher, but input x has a (scalar) shape
@@ -996,4 +1113,43 @@ TEST_CASE(reshape_reduce_reduce_reduce_diff_axes)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(argmax_reshape_pointwise)
+{
+    // The reshape splits the reduced axis, which can't be done for argmax
+    migraphx::shape s1{migraphx::shape::float_type, {64, 4}};
+    migraphx::shape s2{migraphx::shape::int64_type, {8, 8, 2, 2}};
+    migraphx::program p1;
+    {
+        auto* mm     = p1.get_main_module();
+        auto x       = mm->add_parameter("x", s1);
+        auto y       = mm->add_parameter("y", s2);
+        auto argmax  = mm->add_instruction(migraphx::make_op("argmax", {{"axis", 1}}), x);
+        auto argmaxb = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s1.lens()}}), argmax);
+        auto argmaxr =
+            mm->add_instruction(migraphx::make_op("reshape", {{"dims", s2.lens()}}), argmaxb);
+        auto add = add_pointwise(p1, "main:pointwise0", {argmaxr, y}, single_pointwise("add"));
+        mm->add_return({add});
+    }
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm    = p2.get_main_module();
+        auto x      = mm->add_parameter("x", s1);
+        auto y      = mm->add_parameter("y", s2);
+        auto argmax = add_reduce(
+            p2, "main:argmax0", {x}, {1}, [&](auto* rm, const auto& inputs, const auto& axes) {
+                return rm->add_instruction(
+                    migraphx::make_op("argmax", {{"axis", axes.front()}}), inputs[0]);
+            });
+        auto argmaxr =
+            mm->add_instruction(migraphx::make_op("reshape", {{"dims", {8, 8, 1, 1}}}), argmax);
+        auto argmaxb = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s2.lens()}}), argmaxr);
+        auto add = add_pointwise(p2, "main:pointwise0", {argmaxb, y}, single_pointwise("add"));
+        mm->add_return({add});
+    }
+    EXPECT(p1.sort() == p2.sort());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
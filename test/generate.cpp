@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 #include <migraphx/generate.hpp>
+#include <algorithm>
+#include <vector>
 #include "test.hpp"
 
 TEST_CASE(generate)
@@ -61,4 +63,16 @@ TEST_CASE(generate_tuple)
     EXPECT(args.at(2) != migraphx::generate_argument(s2, 0));
 }
 
+TEST_CASE(generate_chunks)
+{
+    // Large enough to be generated in several chunks in parallel
+    migraphx::shape s{migraphx::shape::float_type, {3, 100003}};
+    auto l = migraphx::generate_literal(s, 2);
+    std::vector<float> gold(s.elements());
+    std::generate(gold.begin(),
+                  gold.end(),
+                  migraphx::xorshf96_generator<float>{2, migraphx::random_mode::legacy});
+    EXPECT(l.to_vector<float>() == gold);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
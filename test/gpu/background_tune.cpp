@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/gpu/code_object_op.hpp>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {64, 1024}};
+    auto x   = mm->add_parameter("x", s);
+    auto y   = mm->add_parameter("y", s);
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+    auto mul = mm->add_instruction(migraphx::make_op("mul"), add, y);
+    mm->add_return({mul});
+    return p;
+}
+
+static bool has_kernel_swap(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    return std::any_of(mm->begin(), mm->end(), [](const auto& ins) {
+        if(ins.name() != "gpu::code_object")
+            return false;
+        return migraphx::any_cast<migraphx::gpu::code_object_op>(ins.get_operator()).swap !=
+               nullptr;
+    });
+}
+
+TEST_CASE(background_tune_swap)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy    = true;
+    options.background_tune = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(has_kernel_swap(p));
+
+    // The results are the same whichever kernel is running while the tuner swaps them
+    for(auto seed : migraphx::range(8))
+    {
+        migraphx::parameter_map params;
+        params["x"]   = migraphx::generate_argument(p.get_parameter_shape("x"), seed);
+        params["y"]   = migraphx::generate_argument(p.get_parameter_shape("y"), seed + 1);
+        auto expected = ref.eval(params).back();
+        auto result   = p.eval(params).back();
+        EXPECT(migraphx::verify::verify_rms_range(result.to_vector<float>(),
+                                                  expected.to_vector<float>()));
+    }
+}
+
+TEST_CASE(background_tune_disabled)
+{
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(not has_kernel_swap(p));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
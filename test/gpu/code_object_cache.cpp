@@ -0,0 +1,82 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/code_object_cache.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+static std::vector<std::vector<char>> make_code_objects(std::size_t n, char c)
+{
+    return {std::vector<char>(n, c)};
+}
+
+TEST_CASE(code_object_cache_key)
+{
+    std::string src = "void f() {}";
+    std::vector<migraphx::src_file> srcs{{"main.cpp", src}};
+    auto k1 = migraphx::gpu::code_object_cache::make_key(srcs, {"-O3"}, "gfx90a");
+    auto k2 = migraphx::gpu::code_object_cache::make_key(srcs, {"-O3"}, "gfx90a");
+    auto k3 = migraphx::gpu::code_object_cache::make_key(srcs, {"-O2"}, "gfx90a");
+    auto k4 = migraphx::gpu::code_object_cache::make_key(srcs, {"-O3"}, "gfx942");
+    std::string src2 = "void g() {}";
+    std::vector<migraphx::src_file> srcs2{{"main.cpp", src2}};
+    auto k5 = migraphx::gpu::code_object_cache::make_key(srcs2, {"-O3"}, "gfx90a");
+    EXPECT(k1 == k2);
+    EXPECT(k1 != k3);
+    EXPECT(k1 != k4);
+    EXPECT(k1 != k5);
+}
+
+TEST_CASE(code_object_cache_store_load)
+{
+    migraphx::tmp_dir td{"co_cache"};
+    migraphx::gpu::code_object_cache cache{td.path / "cache", 1024 * 1024};
+    EXPECT(not cache.load("abc").has_value());
+    auto cos = make_code_objects(64, 'x');
+    cache.store("abc", cos);
+    auto result = cache.load("abc");
+    EXPECT(result.has_value());
+    EXPECT(*result == cos);
+}
+
+TEST_CASE(code_object_cache_evict)
+{
+    migraphx::tmp_dir td{"co_cache"};
+    migraphx::gpu::code_object_cache cache{td.path, 4096};
+    cache.store("a", make_code_objects(1500, 'a'));
+    cache.store("b", make_code_objects(1500, 'b'));
+    // Age all entries and then use "a" so "b" is the least recently used
+    auto old = migraphx::fs::file_time_type::clock::now() - std::chrono::hours{1};
+    for(const auto& e : migraphx::fs::directory_iterator(td.path))
+        migraphx::fs::last_write_time(e.path(), old);
+    EXPECT(cache.load("a").has_value());
+    cache.store("c", make_code_objects(1500, 'c'));
+    EXPECT(cache.load("a").has_value());
+    EXPECT(not cache.load("b").has_value());
+    EXPECT(cache.load("c").has_value());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -39,4 +39,27 @@ TEST_CASE(test_find_fast_axis)
                migraphx::shape{migraphx::shape::float_type, {64, 512, 32, 32}, {0, 0, 0, 0}}) == 3);
 }
 
+TEST_CASE(test_tile_transposed_inputs)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 64, 64}};
+    auto st = migraphx::shape::from_permutation(s.type(), s.lens(), {0, 2, 1});
+    auto t  = migraphx::gpu::gen::tile::elements({s, st, st, s}, 1);
+    EXPECT(t.ntiles > 0);
+    EXPECT(t.axis == 1);
+    EXPECT(t.args == std::vector<migraphx::gpu::gen::tile::mode>{
+                         migraphx::gpu::gen::tile::none,
+                         migraphx::gpu::gen::tile::load,
+                         migraphx::gpu::gen::tile::load,
+                         migraphx::gpu::gen::tile::none});
+}
+
+TEST_CASE(test_tile_different_transposes)
+{
+    migraphx::shape s{migraphx::shape::float_type, {8, 16, 32}};
+    auto st1 = migraphx::shape::from_permutation(s.type(), s.lens(), {0, 2, 1});
+    auto st2 = migraphx::shape::from_permutation(s.type(), s.lens(), {2, 1, 0});
+    auto t   = migraphx::gpu::gen::tile::elements({st1, st2, s}, 1);
+    EXPECT(t.ntiles == 0);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compile_miopen.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/context.hpp>
+#include <test.hpp>
+
+// gpu::convolution not supported since MIOpen is OFF
+#if MIGRAPHX_USE_MIOPEN
+static migraphx::instruction_ref add_convolution(migraphx::module& m,
+                                                 migraphx::instruction_ref x,
+                                                 migraphx::instruction_ref w)
+{
+    auto conv   = migraphx::make_op("convolution", {{"padding", {1, 1}}});
+    auto output = m.add_instruction(migraphx::make_op(
+        "allocate", {{"shape", to_value(conv.compute_shape({x->get_shape(), w->get_shape()}))}}));
+    auto op = migraphx::make_op("gpu::convolution", {{"op", conv.to_value()}});
+    return m.add_instruction(
+        migraphx::make_op("gpu::miopen_op", {{"op", to_value(op)}}), x, w, output);
+}
+
+static std::vector<migraphx::instruction_ref> find_convolutions(const migraphx::module& m)
+{
+    std::vector<migraphx::instruction_ref> result;
+    for(auto ins : migraphx::iterator_for(m))
+    {
+        if(ins->name() == "gpu::convolution")
+            result.push_back(ins);
+    }
+    return result;
+}
+
+TEST_CASE(compile_miopen_same_problem)
+{
+    migraphx::module m;
+    auto x  = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 16, 16}});
+    auto w  = m.add_parameter("w", {migraphx::shape::float_type, {8, 8, 3, 3}});
+    auto c1 = add_convolution(m, x, w);
+    auto c2 = add_convolution(m, c1, w);
+    m.add_return({c2});
+
+    migraphx::context ctx = migraphx::gpu::context{};
+    migraphx::run_passes(m, {migraphx::gpu::compile_miopen{&ctx}});
+
+    auto convs = find_convolutions(m);
+    EXPECT(convs.size() == 2);
+    // The second convolution takes the solution found for the first
+    EXPECT(convs.front()->get_operator() == convs.back()->get_operator());
+    for(auto conv : convs)
+    {
+        EXPECT(conv->inputs().size() == 4);
+        EXPECT(conv->inputs().at(2)->name() == "allocate");
+    }
+    EXPECT(bool{convs.back()->inputs().front() == convs.front()});
+}
+#endif
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/register_target.hpp>
+#include <numeric>
+#include <set>
+
+// Two updates with the same shapes compile to the same kernel, but each must keep writing to its
+// own cache
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {3, 2, 1, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 2, 1, 2}};
+    migraphx::shape ts{migraphx::shape::int32_type, {2, 2}};
+    migraphx::shape ps{migraphx::shape::int32_type, {2}};
+    std::vector<float> update(us.elements());
+    std::iota(update.begin(), update.end(), 1);
+    auto k_cache = mm->add_parameter("k_cache", cs);
+    auto v_cache = mm->add_parameter("v_cache", cs);
+    auto k       = mm->add_literal(migraphx::literal{us, update});
+    auto v       = mm->add_instruction(migraphx::make_op("neg"), k);
+    auto t       = mm->add_literal(migraphx::literal{ts, {2, 0, 1, -1}});
+    auto pos     = mm->add_literal(migraphx::literal{ps, {1, 0}});
+    auto k_update = mm->add_instruction(migraphx::make_op("kv_cache_update"), k_cache, k, t, pos);
+    auto v_update = mm->add_instruction(migraphx::make_op("kv_cache_update"), v_cache, v, t, pos);
+    mm->add_return({k_update, v_update});
+    return p;
+}
+
+TEST_CASE(duplicate_kernels_keep_inputs)
+{
+    auto p = create_program();
+    p.compile(migraphx::make_target("gpu"));
+    std::set<std::string> caches;
+    for(const auto& ins : *p.get_main_module())
+    {
+        if(ins.name() != "gpu::code_object")
+            continue;
+        auto output = ins.inputs().back();
+        if(output->name() != "@param")
+            continue;
+        const auto& param = migraphx::any_cast<migraphx::builtin::param>(output->get_operator());
+        caches.insert(param.parameter);
+    }
+    EXPECT(caches == std::set<std::string>{"k_cache", "v_cache"});
+}
+
+TEST_CASE(duplicate_kernels_results)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+
+    migraphx::shape cs = p.get_parameter_shape("k_cache");
+    std::vector<float> k_data(cs.elements(), 0);
+    std::vector<float> v_data(cs.elements(), 0);
+    std::vector<float> ref_k_data(cs.elements(), 0);
+    std::vector<float> ref_v_data(cs.elements(), 0);
+    migraphx::parameter_map params;
+    params["k_cache"] = migraphx::argument(cs, k_data.data());
+    params["v_cache"] = migraphx::argument(cs, v_data.data());
+    migraphx::parameter_map ref_params;
+    ref_params["k_cache"] = migraphx::argument(cs, ref_k_data.data());
+    ref_params["v_cache"] = migraphx::argument(cs, ref_v_data.data());
+    auto results          = p.eval(params);
+    auto expected         = ref.eval(ref_params);
+    EXPECT(results.at(0).to_vector<float>() == expected.at(0).to_vector<float>());
+    EXPECT(results.at(1).to_vector<float>() == expected.at(1).to_vector<float>());
+    EXPECT(results.at(0) != results.at(1));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
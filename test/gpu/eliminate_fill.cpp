@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/eliminate_fill.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <test.hpp>
+
+static void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::gpu::eliminate_fill{}, migraphx::dead_code_elimination{}});
+}
+
+static migraphx::instruction_ref
+add_load(migraphx::module& m, migraphx::instruction_ref mem, migraphx::shape s, std::size_t offset)
+{
+    return m.add_instruction(
+        migraphx::make_op("load", {{"shape", to_value(s)}, {"offset", offset}}), mem);
+}
+
+static migraphx::instruction_ref
+add_fill(migraphx::module& m, migraphx::instruction_ref x, int value)
+{
+    return m.add_instruction(migraphx::make_op("hip::fill", {{"value", value}}), x);
+}
+
+TEST_CASE(fill_overwritten_by_fill)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", s);
+        auto f1 = add_fill(m1, x, 0);
+        auto f2 = add_fill(m1, f1, 1);
+        m1.add_return({f2});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x = m2.add_parameter("x", s);
+        auto f = add_fill(m2, x, 1);
+        m2.add_return({f});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(fill_overwritten_by_copy)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", s);
+        auto y    = m1.add_parameter("y", s);
+        auto f    = add_fill(m1, y, 0);
+        auto copy = m1.add_instruction(migraphx::make_op("hip::copy"), x, f);
+        m1.add_return({copy});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x    = m2.add_parameter("x", s);
+        auto y    = m2.add_parameter("y", s);
+        auto copy = m2.add_instruction(migraphx::make_op("hip::copy"), x, y);
+        m2.add_return({copy});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(fill_partially_overwritten_by_copy)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {2, 8}};
+    migraphx::shape s2{migraphx::shape::float_type, {4, 8}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", s1);
+        auto y    = m1.add_parameter("y", s2);
+        auto f    = add_fill(m1, y, 0);
+        auto copy = m1.add_instruction(migraphx::make_op("hip::copy"), x, f);
+        m1.add_return({copy});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(fill_used_twice)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    migraphx::module m1;
+    {
+        auto x  = m1.add_parameter("x", s);
+        auto f1 = add_fill(m1, x, 0);
+        auto f2 = add_fill(m1, f1, 1);
+        m1.add_return({f1, f2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(zero_fills_adjacent)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape s2{migraphx::shape::half_type, {16}};
+    migraphx::shape ms{migraphx::shape::uint8_type, {1024}};
+    migraphx::module m1;
+    {
+        auto mem = m1.add_parameter("scratch", ms);
+        auto l1  = add_load(m1, mem, s1, 64);
+        auto f1  = add_fill(m1, l1, 0);
+        auto l2  = add_load(m1, mem, s2, 64 + s1.bytes());
+        auto f2  = add_fill(m1, l2, 0);
+        m1.add_return({f1, f2});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto mem = m2.add_parameter("scratch", ms);
+        migraphx::shape s{migraphx::shape::uint8_type, {s1.bytes() + s2.bytes()}};
+        auto l  = add_load(m2, mem, s, 64);
+        auto f  = add_fill(m2, l, 0);
+        auto l1 = add_load(m2, f, s1, 0);
+        auto l2 = add_load(m2, f, s2, s1.bytes());
+        m2.add_return({l1, l2});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(zero_fills_not_adjacent)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ms{migraphx::shape::uint8_type, {1024}};
+    migraphx::module m1;
+    {
+        auto mem = m1.add_parameter("scratch", ms);
+        auto l1  = add_load(m1, mem, s, 0);
+        auto f1  = add_fill(m1, l1, 0);
+        auto l2  = add_load(m1, mem, s, s.bytes() + 64);
+        auto f2  = add_fill(m1, l2, 0);
+        m1.add_return({f1, f2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(zero_fills_separated)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ms{migraphx::shape::uint8_type, {1024}};
+    migraphx::module m1;
+    {
+        auto mem  = m1.add_parameter("scratch", ms);
+        auto y    = m1.add_parameter("y", s);
+        auto l1   = add_load(m1, mem, s, 0);
+        auto f1   = add_fill(m1, l1, 0);
+        auto l2   = add_load(m1, mem, s, s.bytes());
+        auto copy = m1.add_instruction(migraphx::make_op("hip::copy"), f1, y);
+        auto f2   = add_fill(m1, l2, 0);
+        m1.add_return({copy, f2});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,157 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/fuse_dequant_dot.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/make_op.hpp>
+#include "test.hpp"
+
+static void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::gpu::fuse_dequant_dot{}, migraphx::dead_code_elimination{}});
+}
+
+static migraphx::instruction_ref add_scale(migraphx::module& m, const migraphx::shape& s)
+{
+    auto scale = m.add_literal(migraphx::literal{{s.type()}, {0.5f}});
+    return m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}),
+                             scale);
+}
+
+static migraphx::instruction_ref add_zero_point(migraphx::module& m, const migraphx::shape& s)
+{
+    auto zp = m.add_literal(migraphx::literal{{migraphx::shape::uint8_type}, {8}});
+    return m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), zp);
+}
+
+TEST_CASE(dequant_dot_int4)
+{
+    migraphx::shape as{migraphx::shape::float_type, {2, 64}};
+    migraphx::shape ws{migraphx::shape::uint8_type, {64, 16}};
+    migraphx::shape us{migraphx::shape::float_type, {64, 32}};
+    migraphx::module m1;
+    {
+        auto a     = m1.add_parameter("a", as);
+        auto w     = m1.add_parameter("w", ws);
+        auto unpk  = m1.add_instruction(migraphx::make_op("unpack_int4", {{"axis", 1}}), w);
+        auto scale = add_scale(m1, us);
+        auto zp    = add_zero_point(m1, us);
+        auto dq = m1.add_instruction(migraphx::make_op("dequantizelinear"), unpk, scale, zp);
+        auto dot = m1.add_instruction(migraphx::make_op("dot"), a, dq);
+        m1.add_return({dot});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto a     = m2.add_parameter("a", as);
+        auto w     = m2.add_parameter("w", ws);
+        auto scale = add_scale(m2, us);
+        auto zp    = add_zero_point(m2, us);
+        auto dot   = m2.add_instruction(
+            migraphx::make_op("gpu::dequant_dot", {{"int4", true}, {"axis", 1}}), a, w, scale, zp);
+        m2.add_return({dot});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(dequant_dot_int8_no_zero_point)
+{
+    migraphx::shape as{migraphx::shape::half_type, {2, 64}};
+    migraphx::shape ws{migraphx::shape::int8_type, {64, 32}};
+    migraphx::shape us{migraphx::shape::half_type, {64, 32}};
+    migraphx::module m1;
+    {
+        auto a     = m1.add_parameter("a", as);
+        auto w     = m1.add_parameter("w", ws);
+        auto scale = add_scale(m1, us);
+        auto dq    = m1.add_instruction(migraphx::make_op("dequantizelinear"), w, scale);
+        auto dot   = m1.add_instruction(migraphx::make_op("dot"), a, dq);
+        m1.add_return({dot});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto a     = m2.add_parameter("a", as);
+        auto w     = m2.add_parameter("w", ws);
+        auto scale = add_scale(m2, us);
+        auto dot   = m2.add_instruction(migraphx::make_op("gpu::dequant_dot"), a, w, scale);
+        m2.add_return({dot});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(dequant_dot_int4_broadcast_batch)
+{
+    migraphx::shape as{migraphx::shape::float_type, {3, 2, 64}};
+    migraphx::shape ws{migraphx::shape::uint8_type, {32, 32}};
+    migraphx::shape us{migraphx::shape::float_type, {64, 32}};
+    migraphx::module m1;
+    {
+        auto a     = m1.add_parameter("a", as);
+        auto w     = m1.add_parameter("w", ws);
+        auto unpk  = m1.add_instruction(migraphx::make_op("unpack_int4", {{"axis", 0}}), w);
+        auto scale = add_scale(m1, us);
+        auto dq    = m1.add_instruction(migraphx::make_op("dequantizelinear"), unpk, scale);
+        auto bdq   = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {3, 64, 32}}}), dq);
+        auto dot = m1.add_instruction(migraphx::make_op("dot"), a, bdq);
+        m1.add_return({dot});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto a     = m2.add_parameter("a", as);
+        auto w     = m2.add_parameter("w", ws);
+        auto scale = add_scale(m2, us);
+        auto bw    = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {3, 32, 32}}}), w);
+        auto bscale = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {3, 64, 32}}}), scale);
+        auto dot = m2.add_instruction(
+            migraphx::make_op("gpu::dequant_dot", {{"int4", true}, {"axis", 1}}), a, bw, bscale);
+        m2.add_return({dot});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(dequant_dot_float_weights)
+{
+    migraphx::module m1;
+    {
+        auto a   = m1.add_parameter("a", {migraphx::shape::float_type, {2, 64}});
+        auto w   = m1.add_parameter("w", {migraphx::shape::float_type, {64, 32}});
+        auto dot = m1.add_instruction(migraphx::make_op("dot"), a, w);
+        m1.add_return({dot});
+    }
+    auto m2 = m1;
+    run_pass(m1);
+    EXPECT(m1.sort() == m2.sort());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "make_precompile_op.hpp"
+#include <migraphx/gpu/fuse_horizontal_pointwise.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <pointwise.hpp>
+#include <test.hpp>
+
+static void run_pass(migraphx::program& p)
+{
+    migraphx::run_passes(
+        p, {migraphx::gpu::fuse_horizontal_pointwise{}, migraphx::dead_code_elimination{}});
+}
+
+static migraphx::instruction_ref
+add_precompile_pointwise(migraphx::program& p,
+                         const std::string& name,
+                         std::vector<migraphx::instruction_ref> inputs,
+                         const std::string& op)
+{
+    auto* mm   = p.get_main_module();
+    auto* pm   = create_pointwise_module(p, name, inputs, single_pointwise(op));
+    auto s     = inputs.front()->get_shape();
+    auto alloc = migraphx::make_op("allocate", {{"shape", to_value(s)}});
+    inputs.push_back(mm->add_instruction(alloc));
+    return mm->add_instruction(make_precompile_op("pointwise"), inputs, {pm});
+}
+
+TEST_CASE(horizontal_pointwise_independent)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 16}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto y    = mm->add_parameter("y", s);
+        auto z    = mm->add_parameter("z", s);
+        auto w    = mm->add_parameter("w", s);
+        auto add1 = add_precompile_pointwise(p1, "main:pointwise0", {x, y}, "add");
+        auto add2 = add_precompile_pointwise(p1, "main:pointwise1", {z, w}, "add");
+        auto mul  = add_precompile_pointwise(p1, "main:pointwise2", {add1, add2}, "mul");
+        mm->add_return({mul});
+    }
+    run_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto x   = mm->add_parameter("x", s);
+        auto y   = mm->add_parameter("y", s);
+        auto z   = mm->add_parameter("z", s);
+        auto w   = mm->add_parameter("w", s);
+        auto* pm0 =
+            create_pointwise_module(p2, "main:pointwise0", {x, y}, single_pointwise("add"));
+        auto* pm1 =
+            create_pointwise_module(p2, "main:pointwise1", {z, w}, single_pointwise("add"));
+        migraphx::shape ts{{s, s}};
+        auto alloc =
+            mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(ts)}}));
+        auto hop = migraphx::make_op("gpu::horizontal_pointwise", {{"ninputs", {2, 2}}});
+        auto op  = migraphx::make_op(
+            "gpu::precompile_op",
+            {{"op", migraphx::to_value(hop)}, {"output_shape", migraphx::to_value(ts)}});
+        auto packed = mm->add_instruction(op, {x, y, z, w, alloc}, {pm0, pm1});
+        auto add1 =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), packed);
+        auto add2 =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), packed);
+        auto mul = add_precompile_pointwise(p2, "main:pointwise2", {add1, add2}, "mul");
+        mm->add_return({mul});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(horizontal_pointwise_dependent)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 16}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto y    = mm->add_parameter("y", s);
+        auto add  = add_precompile_pointwise(p1, "main:pointwise0", {x, y}, "add");
+        auto mul  = add_precompile_pointwise(p1, "main:pointwise1", {add, y}, "mul");
+        auto relu = add_precompile_pointwise(p1, "main:pointwise2", {mul}, "relu");
+        mm->add_return({relu});
+    }
+    migraphx::program p2 = p1;
+    run_pass(p1);
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(horizontal_pointwise_large)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1024, 1024}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto y    = mm->add_parameter("y", s);
+        auto add1 = add_precompile_pointwise(p1, "main:pointwise0", {x, y}, "add");
+        auto add2 = add_precompile_pointwise(p1, "main:pointwise1", {y, x}, "mul");
+        auto mul  = add_precompile_pointwise(p1, "main:pointwise2", {add1, add2}, "mul");
+        mm->add_return({mul});
+    }
+    migraphx::program p2 = p1;
+    run_pass(p1);
+    EXPECT(p1 == p2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -28,6 +28,7 @@
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/op/common.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/stringutils.hpp>
 #include <migraphx/make_op.hpp>
 #include <basic_ops.hpp>
 #include <test.hpp>
@@ -465,6 +466,55 @@ TEST_CASE(int_quant_dot_tanh_fails)
     EXPECT(has_pointwise);
 }
 
+// Dots with a large k are normally left to rocBLAS, unless the result is requantized
+static migraphx::program create_large_k_quant_dot(bool requantize)
+{
+    migraphx::shape s_a{migraphx::shape::int8_type, {5, 2048}};
+    migraphx::shape s_b{migraphx::shape::int8_type, {2048, 3}};
+    migraphx::shape s_scale{migraphx::shape::float_type, {5, 3}};
+    migraphx::program p;
+    auto* mm    = p.get_main_module();
+    auto a      = mm->add_parameter("a", s_a);
+    auto b      = mm->add_parameter("b", s_b);
+    auto scale1 = mm->add_parameter("scale1", s_scale);
+    auto scale2 = mm->add_parameter("scale2", s_scale);
+    auto dot    = mm->add_instruction(migraphx::make_op("quant_dot"), a, b);
+    auto pw     = add_pointwise(
+        p, "main:pointwise0", {dot, scale1, scale2}, [=](auto* pm, const auto& inputs) {
+            auto dq =
+                pm->add_instruction(migraphx::make_op("dequantizelinear"), inputs[0], inputs[1]);
+            auto relu = pm->add_instruction(migraphx::make_op("relu"), dq);
+            if(not requantize)
+                return relu;
+            return pm->add_instruction(
+                migraphx::make_op("quantizelinear", {{"out_type", migraphx::shape::int8_type}}),
+                relu,
+                inputs[2]);
+        });
+    mm->add_return({pw});
+    return p;
+}
+
+TEST_CASE(int_quant_dot_requantize_large_k)
+{
+    auto p = create_large_k_quant_dot(true);
+    run_pass(p);
+    auto* mm = p.get_main_module();
+    EXPECT(std::any_of(
+        mm->begin(), mm->end(), [](const auto& i) { return i.name() == "gpu::mlir_op"; }));
+    EXPECT(std::none_of(
+        mm->begin(), mm->end(), [](const auto& i) { return i.name() == "pointwise"; }));
+}
+
+TEST_CASE(int_quant_dot_dequantize_large_k)
+{
+    auto p = create_large_k_quant_dot(false);
+    run_pass(p);
+    auto* mm = p.get_main_module();
+    EXPECT(std::any_of(
+        mm->begin(), mm->end(), [](const auto& i) { return i.name() == "pointwise"; }));
+}
+
 TEST_CASE(conv_split_reduce)
 {
     migraphx::shape s_x{migraphx::shape::float_type, {2, 4, 64, 64}};
@@ -1079,6 +1129,116 @@ TEST_CASE(gemm_pw_softmax_gemm_pw)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(gemm_mask_softmax_gemm)
+{
+    migraphx::shape s1{migraphx::shape::half_type, {1, 12, 256, 256}};
+    migraphx::shape s2{migraphx::shape::bool_type, {1, 1, 1, 256}};
+    auto s1_elements = s1.elements();
+
+    // The padding mask is negated with an op MLIR does not support, but it does not depend on
+    // the scores, so it is computed outside of the attention without being broadcasted
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto a      = mm->add_parameter("1", s1);
+        auto b      = mm->add_parameter("2", s1);
+        auto b1     = mm->add_parameter("3", s1);
+        auto padded = mm->add_parameter("4", s2);
+        std::vector<float> eights(s1_elements, 0.125);
+        std::vector<float> tens(s1_elements, 10);
+        auto eight = mm->add_literal(migraphx::literal{s1, eights});
+        auto ten   = mm->add_literal(migraphx::literal{s1, tens});
+        b = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), b);
+        b = mm->add_instruction(migraphx::make_op("contiguous"), b);
+        b1 = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}),
+                                 b1);
+        b1 = mm->add_instruction(migraphx::make_op("contiguous"), b1);
+        auto gemm1 = mm->add_instruction(migraphx::make_op("dot"), a, b);
+        auto padded_b = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s1.lens()}}), padded);
+
+        auto pw_reduce = add_reduce(
+            p1,
+            "main:fused_reduce0",
+            {gemm1, eight, padded_b, ten},
+            {3},
+            [&](auto* rm,
+                const auto& inputs,
+                const auto& axes) -> std::vector<migraphx::instruction_ref> {
+                auto pw = add_pointwise(
+                    p1, rm, "main:pointwise0", inputs, [](auto* pm, const auto& pw_inputs) {
+                        auto mul = pm->add_instruction(
+                            migraphx::make_op("mul"), pw_inputs[0], pw_inputs[1]);
+                        auto keep = pm->add_instruction(migraphx::make_op("not"), pw_inputs[2]);
+                        return pm->add_instruction(
+                            migraphx::make_op("where"), keep, mul, pw_inputs[3]);
+                    });
+                auto rmax =
+                    rm->add_instruction(migraphx::make_op("reduce_max", {{"axes", axes}}), pw);
+                rmax = rm->add_instruction(
+                    migraphx::make_op("multibroadcast", {{"out_lens", s1.lens()}}), rmax);
+
+                auto pw2 = add_pointwise(
+                    p1, rm, "main:pointwise2", {pw, rmax}, [](auto* pm, const auto& pw_inputs) {
+                        auto sub = pm->add_instruction(
+                            migraphx::make_op("sub"), pw_inputs[0], pw_inputs[1]);
+                        return pm->add_instruction(migraphx::make_op("exp"), sub);
+                    });
+                auto rsum =
+                    rm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", axes}}), pw2);
+                rsum = rm->add_instruction(
+                    migraphx::make_op("multibroadcast", {{"out_lens", s1.lens()}}), rsum);
+
+                return {
+                    add_pointwise(p1, rm, "main:pointwise4", {pw2, rsum}, single_pointwise("div"))};
+            });
+
+        auto gemm2 = mm->add_instruction(migraphx::make_op("dot"), pw_reduce, b1);
+        mm->add_return({gemm2});
+    }
+    run_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm    = p2.get_main_module();
+        auto a      = mm->add_parameter("1", s1);
+        auto b      = mm->add_parameter("2", s1);
+        auto b1     = mm->add_parameter("3", s1);
+        auto padded = mm->add_parameter("4", s2);
+        std::vector<float> eights(s1_elements, 0.125);
+        std::vector<float> tens(s1_elements, 10);
+        auto eight = mm->add_literal(migraphx::literal{s1, eights});
+        auto ten   = mm->add_literal(migraphx::literal{s1, tens});
+        auto keep =
+            add_pointwise(p2, "main:fused_reduce0:mask0", {padded}, single_pointwise("not"));
+        auto keep_b = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s1.lens()}}), keep);
+        auto fused = add_mlir(
+            p2,
+            "mlir_attn_main:fused_reduce0",
+            {a, b, eight, ten, keep_b, b1},
+            {"x0", "x1", "x2", "x4", "x5", "x6"},
+            [=](auto* pm, const auto& inputs) {
+                auto fb = pm->add_instruction(
+                    migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), inputs[1]);
+                fb         = pm->add_instruction(migraphx::make_op("contiguous"), fb);
+                auto gemm1 = pm->add_instruction(migraphx::make_op("dot"), inputs[0], fb);
+                auto mul   = pm->add_instruction(migraphx::make_op("mul"), gemm1, inputs[2]);
+                auto where =
+                    pm->add_instruction(migraphx::make_op("where"), inputs[4], mul, inputs[3]);
+                auto smax = pm->add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), where);
+
+                auto fb1 = pm->add_instruction(
+                    migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), inputs[5]);
+                fb1        = pm->add_instruction(migraphx::make_op("contiguous"), fb1);
+                auto gemm2 = pm->add_instruction(migraphx::make_op("dot"), smax, fb1);
+                return std::make_tuple(gemm2->get_operator(), gemm2);
+            });
+        mm->add_return({fused});
+    }
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(gemm_invalid_pw_softmax_gemm)
 {
     migraphx::shape s1{migraphx::shape::half_type, {1, 12, 256, 256}};
@@ -1205,6 +1365,80 @@ TEST_CASE(gemm_invalid_pw_softmax_gemm)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(gemm_silu_gemm)
+{
+    migraphx::shape s1{migraphx::shape::half_type, {1, 16, 64}};
+    migraphx::shape s2{migraphx::shape::half_type, {1, 64, 256}};
+    migraphx::shape s3{migraphx::shape::half_type, {1, 256, 64}};
+    migraphx::program p1;
+    {
+        auto* mm   = p1.get_main_module();
+        auto a     = mm->add_parameter("a", s1);
+        auto w1    = mm->add_parameter("w1", s2);
+        auto w2    = mm->add_parameter("w2", s3);
+        auto gemm1 = mm->add_instruction(migraphx::make_op("dot"), a, w1);
+        auto silu =
+            add_pointwise(p1, "main:pointwise0", {gemm1}, [](auto* pm, const auto& inputs) {
+                auto sig = pm->add_instruction(migraphx::make_op("sigmoid"), inputs[0]);
+                return pm->add_instruction(migraphx::make_op("mul"), inputs[0], sig);
+            });
+        auto gemm2 = mm->add_instruction(migraphx::make_op("dot"), silu, w2);
+        mm->add_return({gemm2});
+    }
+    run_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm   = p2.get_main_module();
+        auto a     = mm->add_parameter("a", s1);
+        auto w1    = mm->add_parameter("w1", s2);
+        auto w2    = mm->add_parameter("w2", s3);
+        auto fused = add_mlir(
+            p2,
+            "mlir_mlp_main:pointwise0",
+            {a, w1, w2},
+            {"x0", "x1", "x2"},
+            [=](auto* pm, const auto& inputs) {
+                auto gemm1 = pm->add_instruction(migraphx::make_op("dot"), inputs[0], inputs[1]);
+                auto sig   = pm->add_instruction(migraphx::make_op("sigmoid"), gemm1);
+                auto silu  = pm->add_instruction(migraphx::make_op("mul"), gemm1, sig);
+                auto gemm2 = pm->add_instruction(migraphx::make_op("dot"), silu, inputs[2]);
+                return std::make_tuple(gemm2->get_operator(), gemm2);
+            });
+        mm->add_return({fused});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(gemm_silu_gemm_large_m)
+{
+    migraphx::shape s1{migraphx::shape::half_type, {1, 256, 64}};
+    migraphx::shape s2{migraphx::shape::half_type, {1, 64, 256}};
+    migraphx::shape s3{migraphx::shape::half_type, {1, 256, 64}};
+    migraphx::program p1;
+    {
+        auto* mm   = p1.get_main_module();
+        auto a     = mm->add_parameter("a", s1);
+        auto w1    = mm->add_parameter("w1", s2);
+        auto w2    = mm->add_parameter("w2", s3);
+        auto gemm1 = mm->add_instruction(migraphx::make_op("dot"), a, w1);
+        auto silu =
+            add_pointwise(p1, "main:pointwise0", {gemm1}, [](auto* pm, const auto& inputs) {
+                auto sig = pm->add_instruction(migraphx::make_op("sigmoid"), inputs[0]);
+                return pm->add_instruction(migraphx::make_op("mul"), inputs[0], sig);
+            });
+        auto gemm2 = mm->add_instruction(migraphx::make_op("dot"), silu, w2);
+        mm->add_return({gemm2});
+    }
+    run_pass(p1);
+    // Too many rows for the mlp fusion
+    auto* mm = p1.get_main_module();
+    EXPECT(std::none_of(mm->begin(), mm->end(), [](const auto& ins) {
+        return not ins.module_inputs().empty() and
+               migraphx::starts_with(ins.module_inputs().front()->name(), "mlir_mlp");
+    }));
+}
+
 int main(int argc, const char* argv[])
 {
     if(migraphx::gpu::mlir_enabled())
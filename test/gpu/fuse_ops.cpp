@@ -24,6 +24,7 @@
 #include "make_precompile_op.hpp"
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/gpu/fuse_ops.hpp>
+#include <migraphx/gpu/hip_gemm.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/program.hpp>
@@ -108,6 +109,123 @@ TEST_CASE(layernorm_pointwise)
     }
 }
 
+TEST_CASE(add_rms_norm_residual_pointwise)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 4}};
+    migraphx::shape ts{{s, s}};
+    auto rms_norm_op = migraphx::make_op("gpu::preadd_rms_norm", {{"residual", true}});
+    auto create_program = [=] {
+        migraphx::program p;
+        auto* mm          = p.get_main_module();
+        auto x            = mm->add_parameter("x", s);
+        auto y            = mm->add_parameter("y", s);
+        auto z            = mm->add_parameter("z", s);
+        auto alloc        = migraphx::make_op("allocate", {{"shape", to_value(s)}});
+        auto alloc_ins    = mm->add_instruction(
+            migraphx::make_op("allocate", {{"shape", to_value(ts)}}));
+        auto rms_norm_ins =
+            mm->add_instruction(make_precompile_op(rms_norm_op), x, y, alloc_ins);
+        auto norm =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), rms_norm_ins);
+        auto* pw_mul =
+            create_pointwise_module(p, "main:pointwise0", {norm, z}, single_pointwise("mul"));
+        auto alloc_ins2 = mm->add_instruction(alloc);
+        auto mul =
+            mm->add_instruction(make_precompile_op("pointwise"), {norm, z, alloc_ins2}, {pw_mul});
+        auto sum =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), rms_norm_ins);
+        auto* pw_add =
+            create_pointwise_module(p, "main:pointwise1", {mul, sum}, single_pointwise("add"));
+        auto alloc_ins3 = mm->add_instruction(alloc);
+        auto add =
+            mm->add_instruction(make_precompile_op("pointwise"), {mul, sum, alloc_ins3}, {pw_add});
+        mm->add_return({add});
+        return p;
+    };
+
+    auto create_fused_program = [=] {
+        migraphx::program p;
+        auto* mm   = p.get_main_module();
+        auto x     = mm->add_parameter("x", s);
+        auto y     = mm->add_parameter("y", s);
+        auto z     = mm->add_parameter("z", s);
+        auto alloc = migraphx::make_op("allocate", {{"shape", to_value(s)}});
+        auto* pw_mul =
+            create_pointwise_module(p, "main:pointwise0", {x, z}, single_pointwise("mul"));
+        auto alloc_ins = mm->add_instruction(
+            migraphx::make_op("allocate", {{"shape", to_value(ts)}}));
+        auto pre_comp_op = migraphx::make_op(
+            "gpu::precompile_op",
+            {{"op", migraphx::to_value(rms_norm_op)}, {"output_shape", migraphx::to_value(ts)}});
+        auto rms_norm_ins = mm->add_instruction(pre_comp_op, {x, y, z, alloc_ins}, {pw_mul});
+        auto mul =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), rms_norm_ins);
+        auto sum =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), rms_norm_ins);
+        auto* pw_add =
+            create_pointwise_module(p, "main:pointwise1", {mul, sum}, single_pointwise("add"));
+        auto alloc_ins2 = mm->add_instruction(alloc);
+        auto add =
+            mm->add_instruction(make_precompile_op("pointwise"), {mul, sum, alloc_ins2}, {pw_add});
+        mm->add_return({add});
+        return p;
+    };
+
+    migraphx::program p1 = create_program();
+    run_pass(p1);
+    migraphx::program p2 = create_fused_program();
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(softmax_pointwise)
+{
+    migraphx::shape s{migraphx::shape::half_type, {2, 3, 4}};
+    migraphx::shape os{migraphx::shape::int8_type, {2, 3, 4}};
+    auto softmax_op  = migraphx::make_op("softmax", {{"axis", 2}});
+    auto quantize_pw = [](auto* pm, const auto& inputs) {
+        auto mul = pm->add_instruction(migraphx::make_op("mul"), inputs);
+        return pm->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::int8_type}}), mul);
+    };
+    auto create_program = [=] {
+        migraphx::program p;
+        auto* mm        = p.get_main_module();
+        auto x          = mm->add_parameter("x", s);
+        auto z          = mm->add_parameter("z", s);
+        auto alloc_ins  = mm->add_instruction(
+            migraphx::make_op("allocate", {{"shape", to_value(s)}}));
+        auto softmax    = mm->add_instruction(make_precompile_op(softmax_op), x, alloc_ins);
+        auto* pw        = create_pointwise_module(p, "main:pointwise0", {softmax, z}, quantize_pw);
+        auto alloc_ins2 = mm->add_instruction(
+            migraphx::make_op("allocate", {{"shape", to_value(os)}}));
+        auto quant =
+            mm->add_instruction(make_precompile_op("pointwise"), {softmax, z, alloc_ins2}, {pw});
+        mm->add_return({quant});
+        return p;
+    };
+
+    auto create_fused_program = [=] {
+        migraphx::program p;
+        auto* mm       = p.get_main_module();
+        auto x         = mm->add_parameter("x", s);
+        auto z         = mm->add_parameter("z", s);
+        auto* pw       = create_pointwise_module(p, "main:pointwise0", {x, z}, quantize_pw);
+        auto alloc_ins = mm->add_instruction(
+            migraphx::make_op("allocate", {{"shape", to_value(os)}}));
+        auto pre_comp_op = migraphx::make_op(
+            "gpu::precompile_op",
+            {{"op", migraphx::to_value(softmax_op)}, {"output_shape", migraphx::to_value(os)}});
+        auto softmax = mm->add_instruction(pre_comp_op, {x, z, alloc_ins}, {pw});
+        mm->add_return({softmax});
+        return p;
+    };
+
+    migraphx::program p1 = create_program();
+    run_pass(p1);
+    migraphx::program p2 = create_fused_program();
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(pointwise_contiguous)
 {
     migraphx::shape s1{migraphx::shape::float_type, {128, 4, 196, 32}};
@@ -164,6 +282,61 @@ TEST_CASE(pointwise_contiguous)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(pointwise_transpose_contiguous)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {2, 64, 12, 32}};
+    migraphx::shape s2{migraphx::shape::float_type, {2, 12, 64, 32}};
+
+    auto create_program = [=]() {
+        migraphx::program p;
+        auto* mm       = p.get_main_module();
+        auto x         = mm->add_parameter("x", s1);
+        auto y         = mm->add_parameter("y", s1);
+        auto alloc1    = migraphx::make_op("allocate", {{"shape", to_value(s1)}});
+        auto alloc_ins = mm->add_instruction(alloc1);
+        auto* pw_add1 =
+            create_pointwise_module(p, "main:pointwise0", {x, y}, single_pointwise("add"));
+        auto add1 =
+            mm->add_instruction(make_precompile_op("pointwise"), {x, y, alloc_ins}, {pw_add1});
+        auto add1_trans = mm->add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), add1);
+        auto alloc2     = migraphx::make_op("allocate", {{"shape", to_value(s2)}});
+        auto alloc_ins2 = mm->add_instruction(alloc2);
+        auto cont =
+            mm->add_instruction(migraphx::make_op("gpu::contiguous"), add1_trans, alloc_ins2);
+        mm->add_return({cont});
+        return p;
+    };
+
+    auto create_fused_program = [=]() {
+        migraphx::program p;
+        auto* mm       = p.get_main_module();
+        auto x         = mm->add_parameter("x", s1);
+        auto y         = mm->add_parameter("y", s1);
+        auto alloc2    = migraphx::make_op("allocate", {{"shape", to_value(s2)}});
+        auto alloc_ins = mm->add_instruction(alloc2);
+        auto alloc_trans = mm->add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), alloc_ins);
+        auto* pw_add1 =
+            create_pointwise_module(p, "main:pointwise0", {x, y}, single_pointwise("add"));
+        auto pw_op       = migraphx::make_op("pointwise");
+        auto out_shape   = alloc_trans->get_shape();
+        auto pre_comp_op = migraphx::make_op(
+            "gpu::precompile_op",
+            {{"op", migraphx::to_value(pw_op)}, {"output_shape", migraphx::to_value(out_shape)}});
+        auto add1 = mm->add_instruction(pre_comp_op, {x, y, alloc_trans}, {pw_add1});
+        auto add1_trans = mm->add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), add1);
+        mm->add_return({add1_trans});
+        return p;
+    };
+
+    migraphx::program p1 = create_program();
+    run_pass(p1);
+    migraphx::program p2 = create_fused_program();
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(layout_pointwise)
 {
     migraphx::shape s1{migraphx::shape::float_type, {1, 8, 4, 4}, {128, 1, 32, 8}};
@@ -357,6 +530,129 @@ TEST_CASE(pointwise_layout_convolution)
 }
 #endif
 
+#if MIGRAPHX_USE_HIPBLASLT
+static migraphx::program create_hip_gemm_pointwise(const migraphx::shape& ys, bool broadcast)
+{
+    migraphx::shape as{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {8, 16}};
+    migraphx::shape cs{migraphx::shape::float_type, {4, 16}};
+    migraphx::shape ws{migraphx::shape::uint8_type, {1024}};
+    migraphx::program p;
+    auto* mm       = p.get_main_module();
+    auto a         = mm->add_parameter("a", as);
+    auto b         = mm->add_parameter("b", bs);
+    auto y         = mm->add_parameter("y", ys);
+    auto workspace = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(ws)}}));
+    auto alloc1    = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(cs)}}));
+    auto gemm      = mm->add_instruction(
+        migraphx::gpu::hip_gemm<migraphx::op::dot>{migraphx::op::dot{}, 1, 0},
+        a,
+        b,
+        workspace,
+        alloc1);
+    if(broadcast)
+        y = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", cs.lens()}}), y);
+    auto* pw = create_pointwise_module(p, "main:pointwise0", {gemm, y}, [](auto* pm, auto inputs) {
+        auto add = pm->add_instruction(migraphx::make_op("add"), inputs);
+        return pm->add_instruction(migraphx::make_op("relu"), add);
+    });
+    auto alloc2 = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(cs)}}));
+    auto add_relu = mm->add_instruction(make_precompile_op("pointwise"), {gemm, y, alloc2}, {pw});
+    mm->add_return({add_relu});
+    return p;
+}
+
+TEST_CASE(hip_gemm_bias_relu)
+{
+    migraphx::shape ys{migraphx::shape::float_type, {16}};
+    migraphx::shape cs{migraphx::shape::float_type, {4, 16}};
+    migraphx::shape ws{migraphx::shape::uint8_type, {1024}};
+    migraphx::program p1 = create_hip_gemm_pointwise(ys, true);
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {4, 8}});
+        auto b   = mm->add_parameter("b", {migraphx::shape::float_type, {8, 16}});
+        auto y   = mm->add_parameter("y", ys);
+        auto workspace =
+            mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(ws)}}));
+        auto bias =
+            mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", cs.lens()}}), y);
+        auto alloc = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(cs)}}));
+        migraphx::gpu::hip_gemm<migraphx::op::dot> gemm{migraphx::op::dot{}, 1, 0};
+        gemm.bias       = true;
+        gemm.activation = "relu";
+        auto fused      = mm->add_instruction(gemm, a, b, bias, workspace, alloc);
+        mm->add_return({fused});
+    }
+    EXPECT(p1.sort() == p2.sort());
+}
+
+TEST_CASE(hip_gemm_add_not_bias)
+{
+    // Adding a full tensor is not a bias so it stays as a pointwise
+    migraphx::program p1 =
+        create_hip_gemm_pointwise({migraphx::shape::float_type, {4, 16}}, false);
+    migraphx::program p2 = p1;
+    run_pass(p1);
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(hip_quant_gemm_scale)
+{
+    migraphx::shape as{migraphx::shape::fp8e4m3fn_type, {4, 8}};
+    migraphx::shape bs{migraphx::shape::fp8e4m3fn_type, {8, 16}};
+    migraphx::shape ss{migraphx::shape::float_type, {1}};
+    migraphx::shape cs{migraphx::shape::float_type, {4, 16}};
+    migraphx::shape ws{migraphx::shape::uint8_type, {1024}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto a   = mm->add_parameter("a", as);
+        auto b   = mm->add_parameter("b", bs);
+        auto s   = mm->add_parameter("s", ss);
+        auto workspace =
+            mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(ws)}}));
+        auto alloc1 = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(cs)}}));
+        auto gemm   = mm->add_instruction(
+            migraphx::gpu::hip_gemm<migraphx::op::quant_dot>{migraphx::op::quant_dot{}, 1, 0},
+            a,
+            b,
+            workspace,
+            alloc1);
+        auto scale =
+            mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", cs.lens()}}), s);
+        auto* pm = create_pointwise_module(
+            p1, "main:pointwise0", {gemm, scale}, [](auto* pmod, auto inputs) {
+                return pmod->add_instruction(migraphx::make_op("mul"), inputs);
+            });
+        auto alloc2 = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(cs)}}));
+        auto mul =
+            mm->add_instruction(make_precompile_op("pointwise"), {gemm, scale, alloc2}, {pm});
+        mm->add_return({mul});
+    }
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto a   = mm->add_parameter("a", as);
+        auto b   = mm->add_parameter("b", bs);
+        auto s   = mm->add_parameter("s", ss);
+        auto workspace =
+            mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(ws)}}));
+        auto scale =
+            mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", cs.lens()}}), s);
+        auto alloc = mm->add_instruction(migraphx::make_op("allocate", {{"shape", to_value(cs)}}));
+        migraphx::gpu::hip_gemm<migraphx::op::quant_dot> gemm{migraphx::op::quant_dot{}, 1, 0};
+        gemm.scale = true;
+        auto fused = mm->add_instruction(gemm, a, b, scale, workspace, alloc);
+        mm->add_return({fused});
+    }
+    EXPECT(p1.sort() == p2.sort());
+}
+#endif
+
 TEST_CASE(concat_pointwise_contiguous)
 {
     migraphx::shape s1 = migraphx::shape::from_permutation(
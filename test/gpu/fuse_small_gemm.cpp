@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/fuse_small_gemm.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <pointwise.hpp>
+#include "test.hpp"
+
+static void run_pass(migraphx::program& p)
+{
+    migraphx::run_passes(p, {migraphx::gpu::fuse_small_gemm{}, migraphx::dead_code_elimination{}});
+}
+
+static std::vector<migraphx::instruction_ref> find_ops(migraphx::module& m,
+                                                       const std::string& name)
+{
+    std::vector<migraphx::instruction_ref> result;
+    for(auto ins = m.begin(); ins != m.end(); ins++)
+    {
+        if(ins->name() == name)
+            result.push_back(ins);
+    }
+    return result;
+}
+
+TEST_CASE(small_gemm_epilogue)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {2, 32}});
+    auto b   = mm->add_parameter("b", {migraphx::shape::float_type, {32, 16}});
+    auto c   = mm->add_parameter("c", {migraphx::shape::float_type, {2, 16}});
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), a, b);
+    auto add = add_pointwise(p, "main:pointwise0", {c, dot}, single_pointwise("add"));
+    mm->add_return({add});
+    auto s = add->get_shape();
+    run_pass(p);
+
+    auto gemms = find_ops(*mm, "gpu::small_gemm");
+    EXPECT(gemms.size() == 1);
+    EXPECT(find_ops(*mm, "dot").empty());
+    EXPECT(find_ops(*mm, "pointwise").empty());
+    auto gemm = gemms.front();
+    EXPECT(gemm->get_operator().to_value()["prologue"].to<std::size_t>() == 0);
+    EXPECT(gemm->get_operator().to_value()["epilogue"].to<bool>());
+    EXPECT(bool{gemm->inputs() == std::vector<migraphx::instruction_ref>{a, b, c}});
+    EXPECT(gemm->module_inputs().size() == 1);
+    EXPECT(gemm->get_shape() == s);
+}
+
+TEST_CASE(small_gemm_prologue_epilogue)
+{
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto x    = mm->add_parameter("x", {migraphx::shape::half_type, {3, 4, 64}});
+    auto y    = mm->add_parameter("y", {migraphx::shape::half_type, {3, 4, 64}});
+    auto b    = mm->add_parameter("b", {migraphx::shape::half_type, {3, 64, 8}});
+    auto mul  = add_pointwise(p, "main:pointwise0", {x, y}, single_pointwise("mul"));
+    auto dot  = mm->add_instruction(migraphx::make_op("dot"), mul, b);
+    auto relu = add_pointwise(p, "main:pointwise1", {dot}, single_pointwise("relu"));
+    mm->add_return({relu});
+    run_pass(p);
+
+    auto gemms = find_ops(*mm, "gpu::small_gemm");
+    EXPECT(gemms.size() == 1);
+    EXPECT(find_ops(*mm, "pointwise").empty());
+    auto gemm = gemms.front();
+    EXPECT(gemm->get_operator().to_value()["prologue"].to<std::size_t>() == 2);
+    EXPECT(gemm->get_operator().to_value()["epilogue"].to<bool>());
+    EXPECT(bool{gemm->inputs() == std::vector<migraphx::instruction_ref>{x, y, b}});
+    EXPECT(gemm->module_inputs().size() == 2);
+}
+
+TEST_CASE(small_gemm_shared_result)
+{
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto a    = mm->add_parameter("a", {migraphx::shape::float_type, {2, 32}});
+    auto b    = mm->add_parameter("b", {migraphx::shape::float_type, {32, 16}});
+    auto dot  = mm->add_instruction(migraphx::make_op("dot"), a, b);
+    auto relu = add_pointwise(p, "main:pointwise0", {dot}, single_pointwise("relu"));
+    mm->add_return({relu, dot});
+    run_pass(p);
+
+    auto gemms = find_ops(*mm, "gpu::small_gemm");
+    EXPECT(gemms.size() == 1);
+    EXPECT(find_ops(*mm, "pointwise").size() == 1);
+    EXPECT(not gemms.front()->get_operator().to_value()["epilogue"].to<bool>());
+    EXPECT(gemms.front()->module_inputs().empty());
+}
+
+TEST_CASE(small_gemm_large)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto a   = mm->add_parameter("a", {migraphx::shape::float_type, {128, 32}});
+    auto b   = mm->add_parameter("b", {migraphx::shape::float_type, {32, 16}});
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), a, b);
+    mm->add_return({dot});
+    run_pass(p);
+
+    EXPECT(find_ops(*mm, "gpu::small_gemm").empty());
+    EXPECT(find_ops(*mm, "dot").size() == 1);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
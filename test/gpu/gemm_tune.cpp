@@ -105,12 +105,14 @@ TEST_CASE(gemm_tune_strided)
     migraphx::shape sa{migraphx::shape::float_type, {4, 2, 2}};
     migraphx::shape sb{migraphx::shape::float_type, {4, 2, 2}};
     migraphx::shape s_output{migraphx::shape::float_type, {4, 2, 2}};
+    migraphx::shape s_workspace{migraphx::shape::uint8_type, {1024 * 1024}};
     auto a      = mm->add_parameter("a", sa);
     auto b      = mm->add_parameter("b", sb);
     auto output = mm->add_parameter("out", s_output);
+    auto ws     = mm->add_parameter("workspace", s_workspace);
 
     auto gemm_oper = migraphx::make_op("gpu::gemm", {{"beta", 2}});
-    mm->add_instruction(gemm_oper, a, b, output);
+    mm->add_instruction(gemm_oper, a, b, ws, output);
 
     migraphx::target gpu_t = migraphx::gpu::target{};
     migraphx::compile_options options;
@@ -192,12 +194,14 @@ TEST_CASE(gemm_tune_invalid_sol_index)
     migraphx::shape sa{migraphx::shape::float_type, {4, 2}};
     migraphx::shape sb{migraphx::shape::float_type, {2, 3}};
     migraphx::shape s_output{migraphx::shape::float_type, {4, 3}};
+    migraphx::shape s_workspace{migraphx::shape::uint8_type, {1024 * 1024}};
     auto a      = mm->add_parameter("a", sa);
     auto b      = mm->add_parameter("b", sb);
     auto output = mm->add_parameter("out", s_output);
+    auto ws     = mm->add_parameter("workspace", s_workspace);
 
     auto gemm_oper = migraphx::make_op("gpu::gemm", {{"solution_idx", 987654321}});
-    mm->add_instruction(gemm_oper, a, b, output);
+    mm->add_instruction(gemm_oper, a, b, ws, output);
 
     migraphx::target gpu_t = migraphx::gpu::target{};
     migraphx::compile_options options;
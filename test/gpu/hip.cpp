@@ -23,9 +23,14 @@
  */
 
 #include <test.hpp>
+#include <algorithm>
+#include <numeric>
 #include <migraphx/argument.hpp>
+#include <migraphx/gpu/context.hpp>
 #include <migraphx/gpu/hip.hpp>
 #include <migraphx/gpu/target.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/metrics.hpp>
 
 TEST_CASE(tuple_from_gpu)
 {
@@ -66,4 +71,123 @@ TEST_CASE(tuple_to_gpu)
     EXPECT(result2 == p2_data);
 }
 
+TEST_CASE(allocate_gpu_reuse)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {64, 64}};
+    migraphx::shape s2{migraphx::shape::float_type, {60, 64}};
+    const void* ptr = nullptr;
+    {
+        auto a = migraphx::gpu::allocate_gpu(s1);
+        ptr    = a.data();
+    }
+    // A released block is reused for a request of a similar size
+    auto b = migraphx::gpu::allocate_gpu(s2);
+    EXPECT(b.data() == ptr);
+    // But not while it is still in use
+    auto c = migraphx::gpu::allocate_gpu(s2);
+    EXPECT(c.data() != b.data());
+
+    std::vector<float> data(s2.elements(), 1.5f);
+    auto gpu_data = migraphx::gpu::to_gpu(migraphx::argument{s2, data.data()});
+    EXPECT(migraphx::gpu::from_gpu(gpu_data).to_vector<float>() == data);
+}
+
+TEST_CASE(trim_memory_pools)
+{
+    migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+    auto& mallocs = migraphx::get_metric_counter("hip_malloc");
+    {
+        auto a = migraphx::gpu::allocate_gpu(s);
+    }
+    // Reusing the released block doesn't allocate
+    auto before = mallocs.get();
+    {
+        auto b = migraphx::gpu::allocate_gpu(s);
+    }
+    EXPECT(mallocs.get() == before);
+    // Once the pools are trimmed the memory has to be allocated again
+    migraphx::gpu::trim_memory_pools();
+    auto c = migraphx::gpu::allocate_gpu(s);
+    EXPECT(mallocs.get() == before + 1);
+}
+
+TEST_CASE(fill_gpu)
+{
+    migraphx::gpu::context ctx;
+    for(auto t : {migraphx::shape::int8_type,
+                  migraphx::shape::half_type,
+                  migraphx::shape::float_type,
+                  migraphx::shape::double_type})
+    {
+        // The words of 1.1 as a double differ, so the fill can't be a single memset
+        migraphx::shape s{t, {3, 37}};
+        auto a = migraphx::gpu::allocate_gpu(s);
+        migraphx::gpu::gpu_fill(ctx, a, 1.1);
+        ctx.finish();
+        auto result = migraphx::gpu::from_gpu(a);
+        migraphx::literal expected{s, std::vector<double>(s.elements(), 1.1)};
+        EXPECT(result == expected.get_argument());
+    }
+}
+
+TEST_CASE(fill_gpu_not_packed)
+{
+    migraphx::gpu::context ctx;
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    std::vector<float> data(s.elements(), 2);
+    auto a = migraphx::gpu::to_gpu(migraphx::argument{s, data.data()});
+    // A slice of the columns would memset the columns of the other slices in its gaps
+    auto slice = a.reshape(migraphx::shape{s.type(), {4, 4}, {8, 1}});
+    EXPECT(test::throws([&] { migraphx::gpu::gpu_fill(ctx, slice, 1); }));
+    ctx.finish();
+    EXPECT(migraphx::gpu::from_gpu(a).to_vector<float>() == data);
+}
+
+TEST_CASE(generate_gpu)
+{
+    migraphx::gpu::context ctx;
+    for(auto t : {migraphx::shape::bool_type,
+                  migraphx::shape::int32_type,
+                  migraphx::shape::half_type,
+                  migraphx::shape::float_type})
+    {
+        migraphx::shape s{t, {3, 37}};
+        auto a = migraphx::gpu::allocate_gpu(s);
+        auto b = migraphx::gpu::allocate_gpu(s);
+        migraphx::gpu::gpu_generate(ctx, a, 7);
+        migraphx::gpu::gpu_generate(ctx, b, 7);
+        ctx.finish();
+        auto result = migraphx::gpu::from_gpu(a).to_vector<double>();
+        EXPECT(result == migraphx::gpu::from_gpu(b).to_vector<double>());
+        EXPECT(std::any_of(result.begin(), result.end(), [&](double x) {
+            return x != result.front();
+        }));
+        if(t == migraphx::shape::half_type or t == migraphx::shape::float_type)
+        {
+            EXPECT(std::all_of(
+                result.begin(), result.end(), [](double x) { return x >= -1 and x <= 1; }));
+        }
+    }
+}
+
+TEST_CASE(copy_gpu_transposed)
+{
+    migraphx::gpu::context ctx;
+    migraphx::shape s{migraphx::shape::float_type, {3, 5}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    auto src = migraphx::gpu::to_gpu(migraphx::argument{s, data.data()})
+                   .reshape(migraphx::shape{s.type(), {5, 3}, {1, 5}});
+    auto dst = migraphx::gpu::allocate_gpu(migraphx::shape{s.type(), {5, 3}});
+    migraphx::gpu::gpu_copy(ctx, src, dst);
+    ctx.finish();
+    std::vector<float> expected;
+    for(std::size_t i = 0; i < 5; i++)
+    {
+        for(std::size_t j = 0; j < 3; j++)
+            expected.push_back(data[j * 5 + i]);
+    }
+    EXPECT(migraphx::gpu::from_gpu(dst).to_vector<float>() == expected);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
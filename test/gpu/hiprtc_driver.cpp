@@ -0,0 +1,98 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/gpu/compile_hip.hpp>
+#include <migraphx/gpu/device_name.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <migraphx/gpu/kernel.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+// NOLINTNEXTLINE
+const std::string write_n = R"__migraphx__(
+#include <hip/hip_runtime.h>
+
+extern "C" {
+__global__ void write(char* data)
+{
+    int num = threadIdx.x + blockDim.x * blockIdx.x;
+    data[num] = ${n};
+}
+
+}
+
+int main() {}
+
+)__migraphx__";
+
+static void check_compile(std::size_t n)
+{
+    auto content  = migraphx::interpolate_string(write_n, {{"n", std::to_string(n)}});
+    auto binaries = migraphx::gpu::compile_hip_src(
+        {migraphx::src_file{"main.cpp", content}}, {}, migraphx::gpu::get_device_name());
+    EXPECT(binaries.size() == 1);
+
+    migraphx::argument input{{migraphx::shape::int8_type, {5}}};
+    auto ginput = migraphx::gpu::to_gpu(input);
+    migraphx::gpu::kernel k{binaries.front(), "write"};
+    k.launch(nullptr, input.get_shape().elements(), 1024)(ginput.cast<std::int8_t>());
+    auto data = migraphx::gpu::from_gpu(ginput).get<std::int8_t>();
+    EXPECT(migraphx::all_of(data, [&](auto x) { return x == static_cast<std::int8_t>(n); }));
+}
+
+// The driver crashes for every batch, so all of the kernels compiled together are compiled
+// in-process instead of waiting on the batch
+TEST_CASE(driver_crash)
+{
+    for(auto i : migraphx::range(2))
+        migraphx::par_for(16, 1, [&](auto j) { check_compile(i * 16 + j + 1); });
+}
+
+// Each compile becomes a runner, which has to give back its slot after the server and the
+// driver failed, or the later compiles wait for a runner that never comes
+TEST_CASE(driver_crash_serial)
+{
+    for(auto i : migraphx::range(8))
+        check_compile(64 + i);
+}
+
+int main(int argc, const char* argv[])
+{
+    // Started as the driver, either as a server or with the path of the output. The batch is
+    // read first so that writing it does not fail.
+    if(argc == 2 and std::string{argv[1]} == "--server")
+        std::abort();
+    if(argc == 2 and migraphx::ends_with(std::string{argv[1]}, "output"))
+    {
+        std::string batch{std::istreambuf_iterator<char>{std::cin}, {}};
+        std::abort();
+    }
+    test::run(argc, argv);
+}
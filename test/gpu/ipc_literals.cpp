@@ -0,0 +1,164 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/metrics.hpp>
+#include <migraphx/process.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/gpu/hip.hpp>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+// CMake sets MIGRAPHX_IPC_LITERALS for this test. It also starts itself as a child process that
+// publishes the literals the parent imports.
+static std::string self_path; // NOLINT
+
+// hip ipc isn't used on Windows
+#ifndef _WIN32
+static const migraphx::shape& literal_shape()
+{
+    // Larger than the literals that are packed together instead of shared
+    static const migraphx::shape s{migraphx::shape::float_type, {512, 1024}};
+    return s;
+}
+
+static std::vector<migraphx::fs::path> ipc_records()
+{
+    migraphx::fs::path dir = migraphx::string_value_of("MIGRAPHX_IPC_LITERALS");
+    std::vector<migraphx::fs::path> result;
+    std::error_code ec;
+    for(const auto& f : migraphx::fs::directory_iterator(dir, ec))
+    {
+        if(f.path().extension() == ".ipc")
+            result.push_back(f.path());
+    }
+    return result;
+}
+
+static migraphx::argument upload(migraphx::gpu::context& ctx, const migraphx::literal& l)
+{
+    auto a = migraphx::gpu::upload_literal(ctx, l);
+    migraphx::gpu::wait_for_literals(ctx);
+    return a;
+}
+
+static std::uint64_t imports() { return migraphx::get_metric("ipc_literal_imports"); }
+
+// Keeps a child process alive until the end of the scope
+struct child_process
+{
+    migraphx::process p;
+
+    explicit child_process(const std::string& mode) : p(self_path, {"--ipc-child", mode})
+    {
+        p.start();
+        char ready = 0;
+        p.receive(&ready, 1);
+    }
+    child_process(const child_process&)            = delete;
+    child_process& operator=(const child_process&) = delete;
+    ~child_process() { p.stop(); }
+};
+
+TEST_CASE(record_removed_on_release)
+{
+    migraphx::gpu::context ctx;
+    auto n = ipc_records().size();
+    {
+        auto a = upload(ctx, migraphx::generate_literal(literal_shape(), 1));
+        EXPECT(ipc_records().size() == n + 1);
+    }
+    EXPECT(ipc_records().size() == n);
+}
+
+TEST_CASE(import_live_record)
+{
+    auto l = migraphx::generate_literal(literal_shape(), 2);
+    child_process child{"live"};
+    migraphx::gpu::context ctx;
+    auto n = imports();
+    auto a = upload(ctx, l);
+    EXPECT(imports() == n + 1);
+    EXPECT(migraphx::gpu::from_gpu(a) == l.get_argument());
+}
+
+TEST_CASE(ignore_stale_record)
+{
+    // The child released the buffer, so its memory could be reused, and left its record behind
+    auto l = migraphx::generate_literal(literal_shape(), 3);
+    child_process child{"stale"};
+    migraphx::gpu::context ctx;
+    auto n = imports();
+    auto a = upload(ctx, l);
+    EXPECT(imports() == n);
+    EXPECT(migraphx::gpu::from_gpu(a) == l.get_argument());
+}
+
+// Publishes the literal the parent uploads, then waits until the parent is done
+static void run_child(const std::string& mode)
+{
+    migraphx::gpu::context ctx;
+    std::vector<migraphx::argument> keep;
+    if(mode == "live")
+    {
+        keep.push_back(upload(ctx, migraphx::generate_literal(literal_shape(), 2)));
+    }
+    else
+    {
+        std::vector<std::pair<migraphx::fs::path, std::vector<char>>> records;
+        {
+            auto a = upload(ctx, migraphx::generate_literal(literal_shape(), 3));
+            for(const auto& r : ipc_records())
+                records.emplace_back(r, migraphx::read_buffer(r));
+        }
+        // Restore the records removed on release, and fill the freed memory with other weights
+        for(const auto& [r, buffer] : records)
+            migraphx::write_buffer(r, buffer);
+        keep.push_back(upload(ctx, migraphx::generate_literal(literal_shape(), 4)));
+    }
+    std::cout << 'r' << std::flush;
+    std::string rest{std::istreambuf_iterator<char>{std::cin}, {}};
+}
+#endif
+
+int main(int argc, const char* argv[])
+{
+#ifndef _WIN32
+    if(argc == 3 and std::string{argv[1]} == "--ipc-child")
+    {
+        run_child(argv[2]);
+        return 0;
+    }
+#endif
+    self_path = migraphx::fs::absolute(argv[0]).string();
+    test::run(argc, argv);
+}
@@ -177,6 +177,27 @@ TEST_CASE(simple_compile_hip)
     EXPECT(migraphx::all_of(data, [](auto x) { return x == 2; }));
 }
 
+TEST_CASE(shared_module_compile_hip)
+{
+    auto binaries = migraphx::gpu::compile_hip_src(
+        {make_src_file("main.cpp", write_2s)}, {}, migraphx::gpu::get_device_name());
+    EXPECT(binaries.size() == 1);
+
+    migraphx::argument input{{migraphx::shape::int8_type, {5}}};
+    auto ginput = migraphx::gpu::to_gpu(input);
+    // The second kernel still runs after the first one, which loaded the module, is destroyed
+    migraphx::gpu::kernel k;
+    {
+        migraphx::gpu::kernel k1{binaries.front(), "write"};
+        k = migraphx::gpu::kernel{binaries.front(), "write"};
+    }
+    k.launch(nullptr, input.get_shape().elements(), 1024)(ginput.cast<std::int8_t>());
+    auto output = migraphx::gpu::from_gpu(ginput);
+
+    auto data = output.get<std::int8_t>();
+    EXPECT(migraphx::all_of(data, [](auto x) { return x == 2; }));
+}
+
 auto check_target(const std::string& arch)
 {
     auto define  = "__" + arch + "__";
@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/kernel_costs.hpp>
+#include <migraphx/gpu/schedule_model.hpp>
+#include <migraphx/gpu/code_object_op.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include "test.hpp"
+
+static migraphx::gpu::code_object_op make_code_object(std::size_t global)
+{
+    migraphx::gpu::code_object_op co;
+    co.symbol_name     = "pointwise_kernel";
+    co.global          = global;
+    co.local           = 256;
+    co.output          = migraphx::shape{migraphx::shape::float_type, {64, 64}};
+    co.expected_inputs = {co.output, co.output};
+    return co;
+}
+
+static std::vector<migraphx::shape> gemm_inputs(std::size_t n)
+{
+    migraphx::shape s{migraphx::shape::float_type, {n, n}};
+    return {s, s, s};
+}
+
+TEST_CASE(kernel_costs_code_object_key)
+{
+    auto co1 = make_code_object(1024);
+    auto co2 = co1;
+    // The binary is not part of the key
+    co2.code_object = migraphx::value::binary{std::string{"abc"}};
+    auto co3        = make_code_object(2048);
+    auto inputs     = co1.expected_inputs;
+
+    migraphx::gpu::kernel_costs kc;
+    kc.insert(co1, inputs, 0.5);
+    EXPECT(kc.get(co2, inputs).value() == 0.5);
+    EXPECT(not kc.get(co3, inputs).has_value());
+    EXPECT(not kc.get(migraphx::make_op("relu"), {inputs.front()}).has_value());
+}
+
+TEST_CASE(kernel_costs_input_shapes_key)
+{
+    auto gemm = migraphx::make_op("gpu::gemm");
+
+    migraphx::gpu::kernel_costs kc;
+    kc.insert(gemm, gemm_inputs(64), 0.5);
+    EXPECT(kc.get(gemm, gemm_inputs(64)).value() == 0.5);
+    // The same operator on other shapes is a different kernel
+    EXPECT(not kc.get(gemm, gemm_inputs(128)).has_value());
+}
+
+TEST_CASE(kernel_costs_save_load)
+{
+    migraphx::tmp_dir td{"kernel_costs"};
+    auto path = td.path / "costs.json";
+    auto co   = make_code_object(1024);
+    auto gemm = migraphx::make_op("gpu::gemm");
+
+    migraphx::gpu::kernel_costs kc1;
+    kc1.insert(co, co.expected_inputs, 0.25);
+    kc1.insert(gemm, gemm_inputs(64), 1.5);
+    kc1.save(path);
+
+    migraphx::gpu::kernel_costs kc2;
+    kc2.load(path);
+    EXPECT(kc2.get(co, co.expected_inputs).value() == 0.25);
+    EXPECT(kc2.get(gemm, gemm_inputs(64)).value() == 1.5);
+}
+
+TEST_CASE(schedule_model_measured_weight)
+{
+    auto co1 = make_code_object(1024);
+    auto co2 = make_code_object(2048);
+    migraphx::gpu::kernel_costs kc;
+    kc.insert(co1, co1.expected_inputs, 0.04);
+    kc.insert(co2, co2.expected_inputs, 0.0);
+
+    migraphx::gpu::schedule_model model{4, &kc};
+    // Measured costs are in microseconds
+    EXPECT(model.weight(co1, co1.expected_inputs) == 40);
+    // Every measured kernel keeps a weight
+    EXPECT(model.weight(co2, co2.expected_inputs) == 1);
+}
+
+TEST_CASE(schedule_model_estimated_weight)
+{
+    auto co = make_code_object(1024);
+    migraphx::gpu::kernel_costs kc;
+    kc.insert(co, co.expected_inputs, 0.01);
+    kc.insert(migraphx::make_op("gpu::gemm"), gemm_inputs(64), 0.03);
+
+    migraphx::gpu::schedule_model model{4, &kc};
+    // Unmeasured operators are estimated in microseconds from the average
+    // measured time, which stands for the default weight
+    auto unmeasured = make_code_object(4096);
+    EXPECT(model.weight(unmeasured, unmeasured.expected_inputs) == 20);
+    EXPECT(model.weight(migraphx::make_op("gpu::gemm"), gemm_inputs(128)) == 40);
+    EXPECT(model.weight(migraphx::make_op("hip::allocate"), {}) == 0);
+    // Without measurements the static weights are used
+    migraphx::gpu::schedule_model static_model{4};
+    EXPECT(static_model.weight(unmeasured, unmeasured.expected_inputs) == 2);
+    EXPECT(static_model.weight(migraphx::make_op("gpu::gemm"), gemm_inputs(128)) == 4);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cond_s{migraphx::shape::bool_type};
+    auto cond = mm->add_parameter("cond", cond_s);
+    migraphx::shape s{migraphx::shape::float_type, {64, 1024}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+
+    auto* then_mod = p.create_module("If_0_if");
+    auto add       = then_mod->add_instruction(migraphx::make_op("add"), x, y);
+    auto exp       = then_mod->add_instruction(migraphx::make_op("exp"), add);
+    then_mod->add_return({exp});
+
+    auto* else_mod = p.create_module("If_0_else");
+    auto mul       = else_mod->add_instruction(migraphx::make_op("mul"), x, y);
+    auto neg       = else_mod->add_instruction(migraphx::make_op("neg"), mul);
+    else_mod->add_return({neg});
+
+    auto ret = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    auto r   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), ret);
+    mm->add_return({r});
+    return p;
+}
+
+static std::size_t count_ops(const migraphx::program& p, const std::string& name)
+{
+    std::size_t n = 0;
+    for(const auto* m : p.get_modules())
+        n += std::count_if(
+            m->begin(), m->end(), [&](const auto& ins) { return ins.name() == name; });
+    return n;
+}
+
+TEST_CASE(lazy_compile_branches)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    options.lazy_compile = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(count_ops(p, "gpu::lazy_code_object") == 2);
+
+    // Run each branch more than once, so the kernels compiled by the first run are reused
+    for(auto b : {true, false, true, false})
+    {
+        migraphx::parameter_map params;
+        params["cond"] = migraphx::argument(p.get_parameter_shape("cond"), &b);
+        params["x"]    = migraphx::generate_argument(p.get_parameter_shape("x"), 0);
+        params["y"]    = migraphx::generate_argument(p.get_parameter_shape("y"), 1);
+        auto expected  = ref.eval(params).back();
+        auto result    = p.eval(params).back();
+        EXPECT(migraphx::verify::verify_rms_range(result.to_vector<float>(),
+                                                  expected.to_vector<float>()));
+    }
+}
+
+TEST_CASE(lazy_compile_disabled)
+{
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(count_ops(p, "gpu::lazy_code_object") == 0);
+    EXPECT(count_ops(p, "gpu::code_object") > 0);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
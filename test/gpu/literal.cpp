@@ -49,4 +49,49 @@ TEST_CASE(gpu_literal_test)
     }
 }
 
+TEST_CASE(gpu_literal_upload)
+{
+    // Mix of small literals that are packed together and large literals
+    // that span several staging buffers
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    std::vector<migraphx::literal> lits;
+    for(std::size_t i = 0; i < 64; i++)
+        lits.push_back(
+            generate_literal(migraphx::shape{migraphx::shape::float_type, {i + 1, 3}}, i));
+    lits.push_back(generate_literal(migraphx::shape{migraphx::shape::float_type, {4, 1024, 1024}}));
+    lits.push_back(generate_literal(migraphx::shape{migraphx::shape::half_type, {7}}));
+    std::vector<migraphx::instruction_ref> outputs;
+    std::transform(lits.begin(), lits.end(), std::back_inserter(outputs), [&](const auto& l) {
+        return mm->add_literal(l);
+    });
+    mm->add_return(outputs);
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    auto results = p.eval({});
+    EXPECT(results.size() == lits.size());
+    for(std::size_t i = 0; i < lits.size(); i++)
+        EXPECT(lits[i] == results[i]);
+}
+
+TEST_CASE(gpu_literal_shared)
+{
+    // Programs with the same weights share one copy on the device
+    auto lit = generate_literal(migraphx::shape{migraphx::shape::float_type, {256, 1024}});
+    auto create_program = [&] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        mm->add_return({mm->add_literal(lit)});
+        p.compile(migraphx::make_target("gpu"));
+        return p;
+    };
+    auto p1 = create_program();
+    auto p2 = create_program();
+    auto r1 = p1.eval({}).back();
+    auto r2 = p2.eval({}).back();
+    EXPECT(r1.data() == r2.data());
+    EXPECT(lit == migraphx::gpu::from_gpu(r2));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
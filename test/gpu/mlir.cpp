@@ -247,6 +247,37 @@ module {
     EXPECT(verify_mlir(m));
 }
 
+TEST_CASE(conv_backwards_add_relu)
+{
+    std::string mlir_output = R"__migraphx__(
+module {
+  func.func @mlir_convolution_backwards_add_relu(%arg0: !migraphx.shaped<1x2x6x6xf32, 72x36x6x1>, %arg1: !migraphx.shaped<8x2x3x3xf32, 18x9x3x1>, %arg2: !migraphx.shaped<1x8x4x4xf32, 128x16x4x1>) -> !migraphx.shaped<1x2x6x6xf32, 72x36x6x1> attributes ${attrs} {
+    %0 = migraphx.backwards_data_convolution %arg2, %arg1 {dilation = [1, 1], group = 1 : i64, padding = [0, 0, 0, 0], padding_mode = 0 : i64, stride = [1, 1]} : <1x8x4x4xf32, 128x16x4x1>, <8x2x3x3xf32, 18x9x3x1> -> <1x2x6x6xf32, 72x36x6x1>
+    %1 = migraphx.add %0, %arg0 : <1x2x6x6xf32, 72x36x6x1>, <1x2x6x6xf32, 72x36x6x1> -> <1x2x6x6xf32, 72x36x6x1>
+    %2 = migraphx.relu %1 : <1x2x6x6xf32, 72x36x6x1> -> <1x2x6x6xf32, 72x36x6x1>
+    return %2 : !migraphx.shaped<1x2x6x6xf32, 72x36x6x1>
+  }
+}
+)__migraphx__";
+    migraphx::module m;
+    auto x    = m.add_parameter("x", {migraphx::shape::float_type, {1, 8, 4, 4}});
+    auto w    = m.add_parameter("w", {migraphx::shape::float_type, {8, 2, 3, 3}});
+    auto b    = m.add_parameter("b", {migraphx::shape::float_type, {1, 2, 6, 6}});
+    auto conv = m.add_instruction(migraphx::make_op("convolution_backwards"), x, w);
+    auto add  = m.add_instruction(migraphx::make_op("add"), conv, b);
+    auto relu = m.add_instruction(migraphx::make_op("relu"), add);
+    m.add_return({relu});
+    auto s = migraphx::gpu::dump_mlir(m);
+    // Skip test if MLIR is not enabled
+    if(s.empty())
+        return;
+    auto mlir_output_with_attrs =
+        migraphx::interpolate_string(mlir_output, {{"attrs", get_attrs()}});
+    CHECK(encode(s) == encode(mlir_output_with_attrs));
+
+    EXPECT(verify_mlir(m));
+}
+
 // The following test checks that a dimension -1, within reshape operator is handled properly..
 TEST_CASE(conv_reshape_dim_minus_one)
 {
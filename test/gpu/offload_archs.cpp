@@ -0,0 +1,47 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/compile_hip.hpp>
+#include <test.hpp>
+
+// MIGRAPHX_GPU_OFFLOAD_ARCHS is set to "gfx90a, gfx1100,gfx942:xnack-,gfx90a" for this test
+
+TEST_CASE(offload_archs_same_wavefront)
+{
+    EXPECT(migraphx::gpu::get_offload_archs("gfx942") ==
+           std::vector<std::string>{"gfx942", "gfx90a"});
+}
+
+TEST_CASE(offload_archs_wave32)
+{
+    EXPECT(migraphx::gpu::get_offload_archs("gfx1100") == std::vector<std::string>{"gfx1100"});
+    EXPECT(migraphx::gpu::get_offload_archs("gfx1201") == std::vector<std::string>{"gfx1201"});
+}
+
+TEST_CASE(offload_archs_feature)
+{
+    EXPECT(migraphx::gpu::get_offload_archs("gfx90a:sramecc+:xnack-") ==
+           std::vector<std::string>{"gfx90a:sramecc+:xnack-", "gfx942:xnack-"});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
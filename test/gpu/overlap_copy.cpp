@@ -0,0 +1,245 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/verify.hpp>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+    auto x = mm->add_parameter("x", s);
+    for(auto i : migraphx::range(4))
+    {
+        auto w = mm->add_parameter("w" + std::to_string(i), s);
+        x      = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        x      = mm->add_instruction(migraphx::make_op("relu"), x);
+    }
+    mm->add_return({x});
+    return p;
+}
+
+static std::size_t count_staged(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    return std::count_if(mm->begin(), mm->end(), [](const auto& ins) {
+        if(ins.name() != "hip::copy_to_gpu")
+            return false;
+        return ins.get_operator().to_value()["staged"].template to<bool>();
+    });
+}
+
+TEST_CASE(overlap_copy_eval)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(count_staged(p) == 5);
+
+    // Consecutive runs reuse the staging buffers
+    for(auto seed : {0, 1, 2})
+    {
+        migraphx::parameter_map params;
+        std::size_t i = 0;
+        for(const auto& [name, s] : p.get_parameter_shapes())
+            params[name] = migraphx::generate_argument(s, seed * 8 + i++);
+        auto expected = ref.eval(params).front().to_vector<float>();
+        auto results  = p.eval(params).front().to_vector<float>();
+        EXPECT(migraphx::verify::verify_rms_range(results, expected));
+    }
+}
+
+// Each layer adds a parameter, whose upload can reuse the memory of the layers before it
+static migraphx::program create_bias_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {128, 128}};
+    auto x = mm->add_parameter("x", s);
+    for(auto i : migraphx::range(6))
+    {
+        auto w = mm->add_parameter("w" + std::to_string(i), s);
+        auto b = mm->add_parameter("b" + std::to_string(i), s);
+        x      = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        x      = mm->add_instruction(migraphx::make_op("relu"), x);
+        x      = mm->add_instruction(migraphx::make_op("add"), x, b);
+    }
+    mm->add_return({x});
+    return p;
+}
+
+static std::pair<std::size_t, std::size_t> load_interval(migraphx::instruction_ref ins)
+{
+    auto v      = ins->get_operator().to_value();
+    auto offset = v.at("offset").to<std::size_t>();
+    return {offset, offset + ins->get_shape().bytes()};
+}
+
+static bool is_upload(migraphx::instruction_ref ins)
+{
+    if(ins->name() == "hip::stream_literal")
+        return true;
+    if(ins->name() != "hip::copy_to_gpu")
+        return false;
+    return ins->get_operator().to_value()["staged"].to<bool>();
+}
+
+// The destination of an upload shares memory with a buffer used before the upload
+static bool reuses_scratch(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    std::vector<migraphx::instruction_ref> loads;
+    for(auto ins : migraphx::iterator_for(*mm))
+    {
+        if(ins->name() == "load")
+            loads.push_back(ins);
+        if(not is_upload(ins) or ins->inputs().back()->name() != "load")
+            continue;
+        auto dst     = ins->inputs().back();
+        auto overlap = [&](auto load) {
+            auto x = load_interval(load);
+            auto y = load_interval(dst);
+            return load != dst and std::max(x.first, y.first) < std::min(x.second, y.second);
+        };
+        if(std::any_of(loads.begin(), loads.end(), overlap))
+            return true;
+    }
+    return false;
+}
+
+// Each upload waits on the copy stream for an event recorded on stream 0 before it
+static bool uploads_wait_for_compute(const migraphx::program& p)
+{
+    const auto* mm = p.get_main_module();
+    auto event     = [](migraphx::instruction_ref ins) {
+        return ins->get_operator().to_value().at("event").to<std::size_t>();
+    };
+    for(auto ins : migraphx::iterator_for(*mm))
+    {
+        if(not is_upload(ins))
+            continue;
+        auto wait   = std::prev(ins);
+        auto stream = std::prev(wait);
+        auto record = std::prev(stream);
+        if(wait->name() != "gpu::wait_event" or stream->name() != "gpu::set_stream" or
+           record->name() != "gpu::record_event" or event(wait) != event(record))
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE(overlap_copy_scratch_reuse)
+{
+    auto ref = create_bias_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_bias_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(count_staged(p) == 13);
+    EXPECT(reuses_scratch(p));
+    EXPECT(uploads_wait_for_compute(p));
+
+    for(auto seed : {0, 1, 2})
+    {
+        migraphx::parameter_map params;
+        std::size_t i = 0;
+        for(const auto& [name, s] : p.get_parameter_shapes())
+            params[name] = migraphx::generate_argument(s, seed * 16 + i++);
+        auto expected = ref.eval(params).front().to_vector<float>();
+        auto results  = p.eval(params).front().to_vector<float>();
+        EXPECT(migraphx::verify::verify_rms_range(results, expected));
+    }
+}
+
+TEST_CASE(overlap_copy_disabled)
+{
+    auto p = create_program();
+    p.compile(migraphx::make_target("gpu"));
+    EXPECT(count_staged(p) == 0);
+}
+
+TEST_CASE(stream_weights_eval)
+{
+    auto create_weights_program = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+        auto x = mm->add_parameter("x", s);
+        for(auto i : migraphx::range(4))
+        {
+            auto w = mm->add_literal(migraphx::generate_literal(s, i));
+            x      = mm->add_instruction(migraphx::make_op("dot"), x, w);
+            x      = mm->add_instruction(migraphx::make_op("relu"), x);
+        }
+        mm->add_return({x});
+        return p;
+    };
+    auto ref = create_weights_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_weights_program();
+    migraphx::compile_options options;
+    options.offload_copy  = true;
+    options.weight_budget = 2 * 64 * 64 * sizeof(float);
+    p.compile(migraphx::make_target("gpu"), options);
+    const auto* mm = p.get_main_module();
+    EXPECT(std::any_of(mm->begin(), mm->end(), [](const auto& ins) {
+        return ins.name() == "hip::stream_literal";
+    }));
+
+    EXPECT(uploads_wait_for_compute(p));
+
+    // The same program with the weights kept on the gpu
+    auto resident = create_weights_program();
+    migraphx::compile_options resident_options;
+    resident_options.offload_copy = true;
+    resident.compile(migraphx::make_target("gpu"), resident_options);
+
+    // The weights are copied again on every run, into scratch that the layers before reuse
+    for(auto seed : {0, 1})
+    {
+        migraphx::parameter_map params;
+        params["x"]   = migraphx::generate_argument(p.get_parameter_shape("x"), seed);
+        auto expected = ref.eval(params).front().to_vector<float>();
+        auto results  = p.eval(params).front().to_vector<float>();
+        EXPECT(migraphx::verify::verify_rms_range(results, expected));
+        EXPECT(results == resident.eval(params).front().to_vector<float>());
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
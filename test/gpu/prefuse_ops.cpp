@@ -39,9 +39,18 @@ struct pre_gemm_softmax_gemm : migraphx::gpu::gemm_softmax_gemm
     std::string name() const { return "gpu::pre_gemm_softmax_gemm"; }
 };
 
-void run_pass(migraphx::module& m)
+struct attention : migraphx::gpu::gemm_softmax_gemm
 {
-    migraphx::run_passes(m, {migraphx::gpu::prefuse_ops{true}, migraphx::dead_code_elimination{}});
+    std::string name() const { return "gpu::attention"; }
+};
+
+void run_pass(migraphx::module& m,
+              bool enable_attention        = true,
+              bool enable_native_attention = false)
+{
+    migraphx::run_passes(m,
+                         {migraphx::gpu::prefuse_ops{enable_attention, enable_native_attention},
+                          migraphx::dead_code_elimination{}});
 }
 
 TEST_CASE(find_gemm_softmax_gemm)
@@ -140,4 +149,232 @@ TEST_CASE(find_gemm_softmax_gemm_no_scale)
     EXPECT(m1 == m2);
 }
 
+TEST_CASE(find_native_attention)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {8, 16, 32}};
+    migraphx::shape s2{migraphx::shape::float_type, {8, 32, 16}};
+
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", s1);
+        auto y     = m1.add_parameter("y", s2);
+        auto z     = m1.add_parameter("z", s1);
+        auto scale = m1.add_literal(2.0f);
+
+        auto dot1     = m1.add_instruction(migraphx::make_op("dot"), x, y);
+        auto scale_mb = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", dot1->get_shape().lens()}}), scale);
+        auto mul = m1.add_instruction(migraphx::make_op("mul"), dot1, scale_mb);
+        auto sm  = m1.add_instruction(migraphx::make_op("softmax", {{"axis", 2}}), mul);
+        m1.add_instruction(migraphx::make_op("dot"), sm, z);
+    }
+    run_pass(m1, false, true);
+
+    migraphx::module m2;
+    {
+        auto x = m2.add_parameter("x", s1);
+        auto y = m2.add_parameter("y", s2);
+        auto z = m2.add_parameter("z", s1);
+
+        m2.add_instruction(attention{migraphx::make_op("dot"), 2}, x, y, z);
+    }
+
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(find_native_attention_disabled)
+{
+    // The native kernel is only used when the target enables it
+    migraphx::shape s1{migraphx::shape::float_type, {8, 16, 32}};
+    migraphx::shape s2{migraphx::shape::float_type, {8, 32, 16}};
+
+    migraphx::module m1;
+    {
+        auto x = m1.add_parameter("x", s1);
+        auto y = m1.add_parameter("y", s2);
+        auto z = m1.add_parameter("z", s1);
+
+        auto dot1 = m1.add_instruction(migraphx::make_op("dot"), x, y);
+        auto sm   = m1.add_instruction(migraphx::make_op("softmax", {{"axis", 2}}), dot1);
+        m1.add_instruction(migraphx::make_op("dot"), sm, z);
+    }
+    auto m2 = m1;
+    run_pass(m1, false);
+
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(find_native_attention_multi_scale)
+{
+    // The native kernel only supports a single scale, so this is left unfused
+    migraphx::shape s1{migraphx::shape::float_type, {8, 16, 32}};
+    migraphx::shape s2{migraphx::shape::float_type, {8, 32, 16}};
+
+    migraphx::module m1;
+    {
+        auto x = m1.add_parameter("x", s1);
+        auto y = m1.add_parameter("y", s2);
+        auto z = m1.add_parameter("z", s1);
+        auto scale =
+            m1.add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16}}, 10));
+
+        auto dot1     = m1.add_instruction(migraphx::make_op("dot"), x, y);
+        auto scale_mb = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", dot1->get_shape().lens()}}), scale);
+        auto mul = m1.add_instruction(migraphx::make_op("mul"), dot1, scale_mb);
+        auto sm  = m1.add_instruction(migraphx::make_op("softmax", {{"axis", 2}}), mul);
+        m1.add_instruction(migraphx::make_op("dot"), sm, z);
+    }
+    auto m2 = m1;
+    run_pass(m1, false, true);
+
+    EXPECT(m1 == m2);
+}
+
+static migraphx::instruction_ref
+add_rms_norm_ops(migraphx::module& m, migraphx::instruction_ref x, float eps)
+{
+    auto lens    = x->get_shape().lens();
+    auto x_sq    = m.add_instruction(migraphx::make_op("mul"), x, x);
+    auto mean    = m.add_instruction(migraphx::make_op("reduce_mean", {{"axes", {2}}}), x_sq);
+    auto eps_lit = m.add_literal(migraphx::literal{migraphx::shape{x->get_shape().type()}, {eps}});
+    auto eps_mb  = m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", mean->get_shape().lens()}}), eps_lit);
+    auto add_eps = m.add_instruction(migraphx::make_op("add"), mean, eps_mb);
+    auto rrms    = m.add_instruction(migraphx::make_op("rsqrt"), add_eps);
+    auto rrms_mb =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", lens}}), rrms);
+    return m.add_instruction(migraphx::make_op("mul"), x, rrms_mb);
+}
+
+TEST_CASE(find_rms_norm)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 8}};
+
+    migraphx::module m1;
+    {
+        auto x = m1.add_parameter("x", s);
+        m1.add_return({add_rms_norm_ops(m1, x, 1e-5f)});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x = m2.add_parameter("x", s);
+        auto rms_norm =
+            m2.add_instruction(migraphx::make_op("gpu::prerms_norm", {{"epsilon", 1e-5f}}), x);
+        m2.add_return({rms_norm});
+    }
+
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(find_add_rms_norm_residual)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 8}};
+
+    migraphx::module m1;
+    {
+        auto x   = m1.add_parameter("x", s);
+        auto y   = m1.add_parameter("y", s);
+        auto add = m1.add_instruction(migraphx::make_op("add"), x, y);
+        m1.add_return({add_rms_norm_ops(m1, add, 1e-5f), add});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x        = m2.add_parameter("x", s);
+        auto y        = m2.add_parameter("y", s);
+        auto rms_norm = m2.add_instruction(
+            migraphx::make_op("gpu::preadd_rms_norm", {{"epsilon", 1e-5f}, {"residual", true}}),
+            x,
+            y);
+        auto sum =
+            m2.add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), rms_norm);
+        auto norm =
+            m2.add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), rms_norm);
+        m2.add_return({norm, sum});
+    }
+
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(find_random_multinomial)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 5}};
+    migraphx::shape rs{migraphx::shape::float_type, {2, 10}};
+
+    migraphx::module m1;
+    {
+        auto cdf    = m1.add_parameter("cdf", s);
+        auto buffer = m1.add_parameter("buffer", rs);
+        auto seed   = m1.add_instruction(migraphx::make_op("random_seed"));
+        auto randoms = m1.add_instruction(migraphx::make_op("random_uniform"), seed, buffer);
+        auto samples = m1.add_instruction(
+            migraphx::make_op("multinomial", {{"dtype", migraphx::shape::int64_type}}),
+            cdf,
+            randoms);
+        m1.add_return({samples});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto cdf = m2.add_parameter("cdf", s);
+        m2.add_parameter("buffer", rs);
+        auto seed    = m2.add_instruction(migraphx::make_op("random_seed"));
+        auto samples = m2.add_instruction(
+            migraphx::make_op("gpu::random_multinomial",
+                              {{"dtype", migraphx::shape::int64_type},
+                               {"dist_type", migraphx::shape::float_type},
+                               {"sample_size", 10}}),
+            cdf,
+            seed);
+        m2.add_return({samples});
+    }
+
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(find_rotary_embedding)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 4, 8, 16}};
+    migraphx::shape ts{migraphx::shape::float_type, {8, 16}};
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", s);
+        auto c     = m1.add_parameter("cos", ts);
+        auto sn    = m1.add_parameter("sin", ts);
+        auto lower = m1.add_instruction(
+            migraphx::make_op("slice", {{"axes", {3}}, {"starts", {0}}, {"ends", {8}}}), x);
+        auto upper = m1.add_instruction(
+            migraphx::make_op("slice", {{"axes", {3}}, {"starts", {8}}, {"ends", {16}}}), x);
+        auto neg    = m1.add_instruction(migraphx::make_op("neg"), upper);
+        auto rotate = m1.add_instruction(migraphx::make_op("concat", {{"axis", 3}}), neg, lower);
+        auto cb     = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), c);
+        auto sb = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), sn);
+        auto mul_cos = m1.add_instruction(migraphx::make_op("mul"), x, cb);
+        auto mul_sin = m1.add_instruction(migraphx::make_op("mul"), rotate, sb);
+        m1.add_instruction(migraphx::make_op("add"), mul_cos, mul_sin);
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x  = m2.add_parameter("x", s);
+        auto c  = m2.add_parameter("cos", ts);
+        auto sn = m2.add_parameter("sin", ts);
+        auto cb = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), c);
+        auto sb = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), sn);
+        m2.add_instruction(migraphx::make_op("rotary_embedding"), x, cb, sb);
+    }
+
+    EXPECT(m1 == m2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,207 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/problem_cache.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include "test.hpp"
+
+TEST_CASE(problem_cache_sqlite_shared)
+{
+    migraphx::tmp_dir td{"problem_cache"};
+    auto db                  = td.path / "tuning.db";
+    migraphx::value problem  = {{"m", 64}, {"n", 32}};
+    migraphx::value solution = {{"tile", 16}};
+
+    migraphx::gpu::problem_cache pc1;
+    pc1.load(db);
+    migraphx::gpu::problem_cache pc2;
+    pc2.load(db);
+    EXPECT(not pc2.has("gemm", problem));
+
+    pc1.insert("gemm", problem, solution);
+    // Visible to another cache opened on the same database without reloading
+    EXPECT(pc2.has("gemm", problem));
+    EXPECT(pc2.get("gemm", problem).value() == solution);
+    EXPECT(not pc2.has("conv", problem));
+
+    migraphx::value solution2 = {{"tile", 32}};
+    pc2.insert("gemm", problem, solution2);
+    migraphx::gpu::problem_cache pc3;
+    pc3.load(db);
+    EXPECT(pc3.get("gemm", problem).value() == solution2);
+}
+
+TEST_CASE(problem_cache_sqlite_memoize)
+{
+    migraphx::tmp_dir td{"problem_cache"};
+    auto db                  = td.path / "tuning.db";
+    migraphx::value problem  = {{"layout", "it's"}};
+    migraphx::value solution = {{"kernel", "a'b"}};
+
+    migraphx::gpu::problem_cache pc1;
+    pc1.load(db);
+    pc1.insert("gemm", problem, solution);
+
+    migraphx::gpu::problem_cache pc2;
+    pc2.load(db);
+    EXPECT(pc2.cache.empty());
+    EXPECT(pc2.get("gemm", problem).value() == solution);
+    // The solution read from the database is kept in memory
+    EXPECT(pc2.cache.size() == 1);
+    EXPECT(pc2.get("gemm", problem).value() == solution);
+}
+
+TEST_CASE(problem_cache_sqlite_mark)
+{
+    migraphx::tmp_dir td{"problem_cache"};
+    auto db                 = td.path / "tuning.db";
+    migraphx::value problem = {{"m", 64}};
+
+    migraphx::gpu::problem_cache pc1;
+    pc1.load(db);
+    pc1.mark("gemm", problem);
+    EXPECT(pc1.has("gemm", problem));
+    EXPECT(pc1.get("gemm", problem)->is_null());
+
+    // Marks are not written to the database
+    migraphx::gpu::problem_cache pc2;
+    pc2.load(db);
+    EXPECT(not pc2.has("gemm", problem));
+}
+
+TEST_CASE(problem_cache_solutions)
+{
+    migraphx::tmp_dir td{"problem_cache"};
+    auto db                   = td.path / "tuning.db";
+    migraphx::value problem1  = {{"m", 64}};
+    migraphx::value problem2  = {{"m", 32}};
+    migraphx::value problem3  = {{"m", 16}};
+    migraphx::value solution1 = {{"tile", 16}};
+    migraphx::value solution2 = {{"tile", 32}};
+
+    migraphx::gpu::problem_cache pc1;
+    pc1.load(db);
+    pc1.insert("gemm", problem1, solution1);
+
+    // Includes the solutions only in the database, but not the marks
+    migraphx::gpu::problem_cache pc2;
+    pc2.load(db);
+    pc2.insert("conv", problem2, solution2);
+    pc2.mark("gemm", problem3);
+    auto solutions = pc2.solutions();
+    EXPECT(solutions.size() == 2);
+    EXPECT(solutions.at({{"name", "gemm"}, {"problem", problem1}}) == solution1);
+    EXPECT(solutions.at({{"name", "conv"}, {"problem", problem2}}) == solution2);
+}
+
+TEST_CASE(problem_cache_solutions_read_once)
+{
+    migraphx::tmp_dir td{"problem_cache"};
+    auto db                   = td.path / "tuning.db";
+    migraphx::value problem1  = {{"m", 64}};
+    migraphx::value problem2  = {{"m", 32}};
+    migraphx::value solution1 = {{"tile", 16}};
+    migraphx::value solution2 = {{"tile", 32}};
+
+    migraphx::gpu::problem_cache pc1;
+    pc1.load(db);
+    pc1.insert("gemm", problem1, solution1);
+
+    migraphx::gpu::problem_cache pc2;
+    pc2.load(db);
+    EXPECT(pc2.solutions().size() == 1);
+    // The database is only read again after the next load
+    pc1.insert("gemm", problem2, solution2);
+    EXPECT(pc2.solutions().size() == 1);
+    pc2.load(db);
+    EXPECT(pc2.solutions().size() == 2);
+}
+
+TEST_CASE(problem_cache_solution_counts)
+{
+    migraphx::value solution1 = {{"tile", 16}};
+    migraphx::value solution2 = {{"tile", 32}};
+
+    migraphx::gpu::problem_cache pc;
+    pc.insert("gemm", {{"m", 64}}, solution1);
+    pc.insert("gemm", {{"m", 32}}, solution1);
+    pc.insert("gemm", {{"m", 16}}, solution2);
+    pc.insert("conv", {{"m", 16}}, solution2);
+    pc.mark("gemm", {{"m", 8}});
+    auto counts = pc.solution_counts("gemm");
+    EXPECT(counts.size() == 2);
+    EXPECT(counts.at(solution1) == 2);
+    EXPECT(counts.at(solution2) == 1);
+    EXPECT(pc.solution_counts("dot").empty());
+}
+
+static migraphx::value gemm_problem(std::size_t m, std::size_t n, std::size_t k, bool transposed)
+{
+    migraphx::shape a{migraphx::shape::half_type, {m, k}};
+    migraphx::shape b{migraphx::shape::half_type, {k, n}};
+    if(transposed)
+        b = migraphx::shape{migraphx::shape::half_type, {k, n}, {1, k}};
+    migraphx::shape c{migraphx::shape::half_type, {m, n}};
+    return migraphx::to_value(std::vector<migraphx::shape>{a, b, c});
+}
+
+TEST_CASE(problem_cache_nearest)
+{
+    migraphx::gpu::problem_cache pc;
+    pc.insert("gemm", gemm_problem(64, 64, 64, false), 1);
+    pc.insert("gemm", gemm_problem(256, 256, 256, false), 2);
+    pc.insert("gemm", gemm_problem(100, 100, 100, true), 3);
+    pc.insert("conv", gemm_problem(96, 64, 64, false), 4);
+    pc.mark("gemm", gemm_problem(96, 64, 64, false));
+
+    auto nearest = [&](const migraphx::value& problem) {
+        auto shapes = migraphx::from_value<std::vector<migraphx::shape>>(problem);
+        return pc.nearest("gemm", [&](const migraphx::value& v) {
+            return migraphx::gpu::shapes_distance(
+                shapes, migraphx::from_value<std::vector<migraphx::shape>>(v));
+        });
+    };
+    EXPECT(nearest(gemm_problem(80, 64, 64, false)).value() == 1);
+    EXPECT(nearest(gemm_problem(200, 256, 256, false)).value() == 2);
+    // Only problems with the same layout are considered
+    EXPECT(nearest(gemm_problem(64, 64, 64, true)).value() == 3);
+    EXPECT(not pc.nearest("dot", [](const migraphx::value&) { return 0.0; }).has_value());
+}
+
+TEST_CASE(shapes_distance)
+{
+    migraphx::shape a{migraphx::shape::float_type, {8, 16}};
+    migraphx::shape b{migraphx::shape::float_type, {16, 16}};
+    migraphx::shape t{migraphx::shape::float_type, {16, 8}, {1, 16}};
+    migraphx::shape h{migraphx::shape::half_type, {8, 16}};
+    EXPECT(migraphx::gpu::shapes_distance({a}, {a}).value() == 0);
+    EXPECT(migraphx::gpu::shapes_distance({a}, {b}).value() > 0);
+    EXPECT(migraphx::gpu::shapes_distance({a}, {b}).value() ==
+           migraphx::gpu::shapes_distance({b}, {a}).value());
+    EXPECT(not migraphx::gpu::shapes_distance({a}, {t}).has_value());
+    EXPECT(not migraphx::gpu::shapes_distance({a}, {h}).has_value());
+    EXPECT(not migraphx::gpu::shapes_distance({a}, {a, a}).has_value());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
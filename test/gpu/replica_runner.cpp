@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/replica_runner.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/gpu/target.hpp>
+#include <hip/hip_runtime_api.h>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+    auto x    = mm->add_parameter("x", s);
+    auto w    = mm->add_literal(migraphx::generate_literal(s, 1));
+    auto b    = mm->add_literal(migraphx::generate_literal(s, 2));
+    auto dot  = mm->add_instruction(migraphx::make_op("dot"), x, w);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), dot, b);
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), add);
+    mm->add_return({relu});
+    return p;
+}
+
+static std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> v;
+    arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+    return v;
+}
+
+static void run_replicas(migraphx::replica_runner::dispatch_mode mode)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+
+    // Replicas on the same device still get their own code objects and buffers
+    migraphx::replica_runner runner{p, {0, 0, 0}, mode};
+    EXPECT(runner.size() == 3);
+
+    const std::size_t n = 8;
+    std::vector<migraphx::parameter_map> batches;
+    std::vector<migraphx::argument> expected;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto x = migraphx::generate_argument(p.get_parameter_shape("x"), i + 3);
+        batches.push_back({{"x", x}});
+        expected.push_back(ref.eval({{"x", x}}).front());
+    }
+
+    auto results = runner.run_batches(batches);
+    EXPECT(results.size() == n);
+    for(std::size_t i = 0; i < n; i++)
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i].front()),
+                                                  to_vector(expected[i])));
+
+    auto result = runner.run(batches.front()).front();
+    EXPECT(migraphx::verify::verify_rms_range(to_vector(result), to_vector(expected.front())));
+}
+
+TEST_CASE(replica_runner_round_robin) { run_replicas(migraphx::replica_runner::round_robin); }
+
+TEST_CASE(replica_runner_queue_depth) { run_replicas(migraphx::replica_runner::queue_depth); }
+
+TEST_CASE(create_replica_keeps_current_device)
+{
+    int count = 0;
+    if(hipGetDeviceCount(&count) != hipSuccess or count < 2)
+        return;
+    auto p = create_program();
+    p.compile(migraphx::make_target("gpu"));
+    EXPECT(hipSetDevice(0) == hipSuccess);
+    auto replica = p.create_replica(1);
+    int device   = -1;
+    EXPECT(hipGetDevice(&device) == hipSuccess);
+    EXPECT(device == 0);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/load_save.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/gpu/target.hpp>
+
+// gpu::miopen_fusion not supported since MIOpen is OFF
+#if MIGRAPHX_USE_MIOPEN
+static migraphx::program create_conv_bias_relu()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape xs{migraphx::shape::float_type, {1, 8, 16, 16}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 8, 3, 3}};
+    migraphx::shape bs{migraphx::shape::float_type, {8}};
+    auto x    = mm->add_parameter("x", xs);
+    auto w    = mm->add_literal(migraphx::generate_literal(ws, 1));
+    auto b    = mm->add_literal(migraphx::generate_literal(bs, 2));
+    auto conv = mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w);
+    auto bias = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", conv->get_shape().lens()}}), b);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), conv, bias);
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), add);
+    mm->add_return({relu});
+    return p;
+}
+
+static std::vector<migraphx::operation> find_fusions(const migraphx::program& p)
+{
+    std::vector<migraphx::operation> result;
+    for(const auto& ins : *p.get_main_module())
+    {
+        if(ins.name() == "gpu::miopen_fusion")
+            result.push_back(ins.get_operator());
+    }
+    return result;
+}
+
+static std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> v;
+    arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+    return v;
+}
+
+TEST_CASE(conv_bias_relu_save_load)
+{
+    auto p = create_conv_bias_relu();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+
+    auto loaded = migraphx::load_buffer(migraphx::save_buffer(p));
+    // The fusions, with the solutions found for them, are loaded without compiling them again
+    auto fusions = find_fusions(p);
+    EXPECT(bool{find_fusions(loaded) == fusions});
+#ifdef MIGRAPHX_HAS_FIND_2_FUSION_API
+    for(const auto& op : fusions)
+        EXPECT(not op.to_value().at("solution_object").get_binary().empty());
+#endif
+
+    auto x        = migraphx::generate_argument(p.get_parameter_shape("x"));
+    auto gold     = p.eval({{"x", x}}).back();
+    auto result   = loaded.eval({{"x", x}}).back();
+    EXPECT(migraphx::verify::verify_rms_range(to_vector(result), to_vector(gold)));
+}
+#endif
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,159 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <test.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <migraphx/gpu/target.hpp>
+#include <algorithm>
+#include <thread>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+    auto x    = mm->add_parameter("x", s);
+    auto w    = mm->add_literal(migraphx::generate_literal(s, 1));
+    auto b    = mm->add_literal(migraphx::generate_literal(s, 2));
+    auto dot  = mm->add_instruction(migraphx::make_op("dot"), x, w);
+    auto add  = mm->add_instruction(migraphx::make_op("add"), dot, b);
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), add);
+    mm->add_return({relu});
+    return p;
+}
+
+TEST_CASE(gpu_session_concurrent)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+
+    const std::size_t n = 4;
+    std::vector<migraphx::program> sessions;
+    std::generate_n(std::back_inserter(sessions), n, [&] { return p.create_session(); });
+    std::vector<migraphx::argument> inputs;
+    std::vector<migraphx::argument> expected;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        inputs.push_back(migraphx::generate_argument(p.get_parameter_shape("x"), i + 3));
+        expected.push_back(ref.eval({{"x", inputs.back()}}).front());
+    }
+
+    std::vector<migraphx::argument> results(n);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        threads.emplace_back([&, i] {
+            for(std::size_t j = 0; j < 8; j++)
+                results[i] = sessions[i].eval({{"x", inputs[i]}}).front();
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+
+    auto to_vector = [](const migraphx::argument& arg) {
+        std::vector<float> v;
+        arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+        return v;
+    };
+    for(std::size_t i = 0; i < n; i++)
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i]), to_vector(expected[i])));
+}
+
+static bool has_instruction(const migraphx::program& p, const std::string& name)
+{
+    auto mods = p.get_modules();
+    return std::any_of(mods.begin(), mods.end(), [&](const auto* m) {
+        return std::any_of(
+            m->begin(), m->end(), [&](const auto& ins) { return ins.name() == name; });
+    });
+}
+
+// All the threads run the same program, so overlapping calls use pooled sessions
+static void run_concurrent(migraphx::program& p)
+{
+    auto ref = create_program();
+    ref.compile(migraphx::make_target("ref"));
+
+    const std::size_t n = 4;
+    std::vector<migraphx::argument> inputs;
+    std::vector<migraphx::argument> expected;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        inputs.push_back(migraphx::generate_argument(p.get_parameter_shape("x"), i + 3));
+        expected.push_back(ref.eval({{"x", inputs.back()}}).front());
+    }
+
+    std::vector<migraphx::argument> results(n);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        threads.emplace_back([&, i] {
+            for(std::size_t j = 0; j < 8; j++)
+                results[i] = p.eval({{"x", inputs[i]}}).front();
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+
+    auto to_vector = [](const migraphx::argument& arg) {
+        std::vector<float> v;
+        arg.visit([&](auto x) { v.assign(x.begin(), x.end()); });
+        return v;
+    };
+    for(std::size_t i = 0; i < n; i++)
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i]), to_vector(expected[i])));
+}
+
+TEST_CASE(gpu_eval_concurrent)
+{
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(has_instruction(p, "gpu::code_object"));
+    run_concurrent(p);
+}
+
+TEST_CASE(gpu_eval_concurrent_hip_graph)
+{
+    auto p = create_program();
+    migraphx::compile_options options;
+    options.offload_copy  = true;
+    options.capture_graph = true;
+    p.compile(migraphx::make_target("gpu"), options);
+    EXPECT(has_instruction(p, "gpu::hip_graph"));
+    EXPECT(has_instruction(p, "gpu::code_object"));
+    run_concurrent(p);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
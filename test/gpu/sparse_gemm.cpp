@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/sparse_gemm.hpp>
+#include <migraphx/gpu/hipsparselt.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include "test.hpp"
+
+// Keep the first two of every four weights along k when sparse
+static std::vector<float> make_weights(std::size_t k, std::size_t n, bool sparse)
+{
+    std::vector<float> result(k * n);
+    for(std::size_t i = 0; i < k; i++)
+    {
+        for(std::size_t j = 0; j < n; j++)
+        {
+            bool zero         = sparse and (i % 4) >= 2;
+            result[i * n + j] = zero ? 0.0f : static_cast<float>((i + j) % 7) - 3.0f;
+        }
+    }
+    return result;
+}
+
+static migraphx::module create_dot(const migraphx::shape& as, std::size_t n, bool sparse)
+{
+    migraphx::module m;
+    auto k = as.lens().back();
+    migraphx::shape bs{as.type(), {k, n}};
+    auto a   = m.add_parameter("a", as);
+    auto b   = m.add_literal(migraphx::literal{bs, make_weights(k, n, sparse)});
+    auto dot = m.add_instruction(migraphx::make_op("dot"), a, b);
+    m.add_return({dot});
+    return m;
+}
+
+static void run_pass(migraphx::module& m)
+{
+    migraphx::gpu::context ctx;
+    migraphx::run_passes(m, {migraphx::gpu::sparse_gemm{&ctx}, migraphx::dead_code_elimination{}});
+}
+
+static bool has_sparse_gemm(const migraphx::module& m)
+{
+    return std::any_of(m.begin(), m.end(), [](const auto& ins) {
+        return ins.name() == "gpu::hipsparselt_gemm";
+    });
+}
+
+static bool sparse_gemm_supported()
+{
+#if MIGRAPHX_USE_HIPSPARSELT
+    return migraphx::gpu::hipsparselt_supported();
+#else
+    return false;
+#endif
+}
+
+TEST_CASE(sparse_gemm_dense_weights)
+{
+    auto m1 = create_dot({migraphx::shape::half_type, {32, 64}}, 32, false);
+    auto m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(sparse_gemm_float)
+{
+    // hipSPARSELt has no fp32 sparse gemms
+    auto m1 = create_dot({migraphx::shape::float_type, {32, 64}}, 32, true);
+    auto m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(sparse_gemm_unaligned)
+{
+    auto m1 = create_dot({migraphx::shape::half_type, {32, 60}}, 32, true);
+    auto m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(sparse_gemm_sparse_weights)
+{
+    auto m = create_dot({migraphx::shape::half_type, {2, 16, 64}}, 32, true);
+    run_pass(m);
+    EXPECT(has_sparse_gemm(m) == sparse_gemm_supported());
+    EXPECT(m.get_output_shapes().front().lens() == std::vector<std::size_t>{2, 16, 32});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
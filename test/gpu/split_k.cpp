@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/split_k.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/make_op.hpp>
+#include "test.hpp"
+
+static migraphx::module create_dot(const migraphx::shape& as, const migraphx::shape& bs)
+{
+    migraphx::module m;
+    auto a   = m.add_parameter("a", as);
+    auto b   = m.add_parameter("b", bs);
+    auto dot = m.add_instruction(migraphx::make_op("dot"), a, b);
+    m.add_return({dot});
+    return m;
+}
+
+static void run_pass(migraphx::module& m, migraphx::value splits = nullptr)
+{
+    migraphx::gpu::context ctx;
+    if(not splits.is_null())
+    {
+        auto dot = std::find_if(m.begin(), m.end(), [](const auto& ins) {
+            return ins.name() == "dot";
+        });
+        ctx.get_problem_cache().insert(
+            "split_k", migraphx::to_value(migraphx::to_shapes(dot->inputs())), splits);
+    }
+    migraphx::run_passes(m, {migraphx::gpu::split_k{&ctx}, migraphx::dead_code_elimination{}});
+}
+
+TEST_CASE(split_k_cached)
+{
+    migraphx::shape as{migraphx::shape::float_type, {4, 2048}};
+    migraphx::shape bs{migraphx::shape::float_type, {2048, 32}};
+    auto m1 = create_dot(as, bs);
+    run_pass(m1, 4);
+
+    migraphx::module m2;
+    {
+        auto a  = m2.add_parameter("a", as);
+        auto b  = m2.add_parameter("b", bs);
+        auto ra = m2.add_instruction(migraphx::make_op("reshape", {{"dims", {4, 4, 512}}}), a);
+        auto ta =
+            m2.add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0, 2}}}), ra);
+        auto rb  = m2.add_instruction(migraphx::make_op("reshape", {{"dims", {4, 512, 32}}}), b);
+        auto dot = m2.add_instruction(migraphx::make_op("dot"), ta, rb);
+        auto sum = m2.add_instruction(migraphx::make_op("reduce_sum", {{"axes", {0}}}), dot);
+        auto sq  = m2.add_instruction(migraphx::make_op("squeeze", {{"axes", {0}}}), sum);
+        m2.add_return({sq});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(split_k_cached_half)
+{
+    // The partial products are summed in float
+    migraphx::shape as{migraphx::shape::half_type, {4, 2048}};
+    migraphx::shape bs{migraphx::shape::half_type, {2048, 32}};
+    auto m1 = create_dot(as, bs);
+    run_pass(m1, 4);
+
+    migraphx::module m2;
+    {
+        auto a  = m2.add_parameter("a", as);
+        auto b  = m2.add_parameter("b", bs);
+        auto ra = m2.add_instruction(migraphx::make_op("reshape", {{"dims", {4, 4, 512}}}), a);
+        auto ta =
+            m2.add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0, 2}}}), ra);
+        auto rb   = m2.add_instruction(migraphx::make_op("reshape", {{"dims", {4, 512, 32}}}), b);
+        auto dot  = m2.add_instruction(migraphx::make_op("dot"), ta, rb);
+        auto fdot = m2.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), dot);
+        auto sum  = m2.add_instruction(migraphx::make_op("reduce_sum", {{"axes", {0}}}), fdot);
+        auto hsum = m2.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::half_type}}), sum);
+        auto sq   = m2.add_instruction(migraphx::make_op("squeeze", {{"axes", {0}}}), hsum);
+        m2.add_return({sq});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(split_k_cached_no_split)
+{
+    auto m1 = create_dot({migraphx::shape::float_type, {4, 2048}},
+                         {migraphx::shape::float_type, {2048, 32}});
+    auto m2 = m1;
+    run_pass(m1, 1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(split_k_large_output)
+{
+    // Enough tiles to fill the device without splitting
+    auto m1 = create_dot({migraphx::shape::float_type, {2048, 1024}},
+                         {migraphx::shape::float_type, {1024, 2048}});
+    auto m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
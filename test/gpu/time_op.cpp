@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/time_op.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <chrono>
+#include <thread>
+#include "test.hpp"
+
+TEST_CASE(timing_stats)
+{
+    migraphx::gpu::timing t;
+    t.samples = {5, 1, 4, 2, 3, 100, 3, 2, 4, 3, 5, 1, 4, 2, 3, 3, 3, 2, 4, 3};
+    EXPECT(t.median() == 3);
+    // The outlier is trimmed
+    EXPECT(t.trimmed_mean() == 3.125);
+    auto [lo, hi] = t.confidence_interval();
+    EXPECT(lo == 2);
+    EXPECT(hi == 4);
+}
+
+TEST_CASE(time_interleaved_drops_slower)
+{
+    migraphx::gpu::context ctx{0, 1};
+    migraphx::gpu::benchmark_options options;
+    options.batch       = 1;
+    options.min_samples = 5;
+    options.max_samples = 50;
+    // The host blocks the stream between the events, so sleeping is timed
+    auto fast = [] {};
+    auto slow = [] { std::this_thread::sleep_for(std::chrono::milliseconds{2}); };
+    auto result = migraphx::gpu::time_interleaved(ctx, {fast, slow}, options);
+    EXPECT(result.size() == 2);
+    EXPECT(result[0].median() < result[1].median());
+    // Stopped once the slower run was dropped
+    EXPECT(result[1].samples.size() < options.max_samples);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
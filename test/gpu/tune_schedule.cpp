@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/gpu/tune_schedule.hpp>
+#include <migraphx/gpu/context.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/make_op.hpp>
+#include "test.hpp"
+
+static migraphx::module create_branches()
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {64, 64}};
+    auto x   = m.add_parameter("x", s);
+    auto y   = m.add_parameter("y", s);
+    auto e1  = m.add_instruction(migraphx::make_op("exp"), x);
+    auto r1  = m.add_instruction(migraphx::make_op("relu"), e1);
+    auto e2  = m.add_instruction(migraphx::make_op("exp"), y);
+    auto r2  = m.add_instruction(migraphx::make_op("relu"), e2);
+    auto sum = m.add_instruction(migraphx::make_op("add"), r1, r2);
+    m.add_return({sum});
+    return m;
+}
+
+static bool has_set_stream(const migraphx::module& m)
+{
+    return std::any_of(
+        m.begin(), m.end(), [](const auto& ins) { return ins.name() == "gpu::set_stream"; });
+}
+
+static void run_pass(migraphx::gpu::context& ctx, migraphx::module& m, migraphx::value streams)
+{
+    ctx.get_problem_cache().insert("schedule", migraphx::gpu::tune_schedule::problem(m), streams);
+    migraphx::run_passes(m, {migraphx::gpu::tune_schedule{&ctx}});
+}
+
+TEST_CASE(tune_schedule_cached)
+{
+    migraphx::gpu::context ctx{0, 1};
+    auto m = create_branches();
+    run_pass(ctx, m, 2);
+    EXPECT(has_set_stream(m));
+    EXPECT(ctx.get_current_device().nstreams() == 2);
+}
+
+TEST_CASE(tune_schedule_cached_one_stream)
+{
+    migraphx::gpu::context ctx{0, 1};
+    auto m1 = create_branches();
+    auto m2 = m1;
+    run_pass(ctx, m1, 1);
+    EXPECT(not has_set_stream(m1));
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(tune_schedule_disabled)
+{
+    migraphx::gpu::context ctx{0, 1};
+    auto m1 = create_branches();
+    auto m2 = m1;
+    ctx.get_problem_cache().insert("schedule", migraphx::gpu::tune_schedule::problem(m1), 2);
+    migraphx::run_passes(m1, {migraphx::gpu::tune_schedule{&ctx, false}});
+    EXPECT(m1 == m2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -62,3 +62,28 @@ inline migraphx::instruction_ref add_layernorm(migraphx::module& m,
         m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", dims}}), bias);
     return m.add_instruction(migraphx::make_op("add"), mul, bias_mbcast);
 }
+
+inline migraphx::instruction_ref add_rms_norm(migraphx::module& m,
+                                              migraphx::instruction_ref x,
+                                              const std::vector<size_t>& dims,
+                                              float eps = 1e-5f)
+{
+    auto mgx_type = x->get_shape().type();
+    auto axis     = dims.size() - 1;
+    auto scale    = m.add_parameter("scale", migraphx::shape{mgx_type, {dims.back()}});
+    auto epsilon  = m.add_literal(migraphx::literal{migraphx::shape{mgx_type}, {eps}});
+
+    auto x_sq = m.add_instruction(migraphx::make_op("mul"), x, x);
+    auto mean = m.add_instruction(migraphx::make_op("reduce_mean", {{"axes", {axis}}}), x_sq);
+    auto epsilon_mbcast = m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", mean->get_shape().lens()}}), epsilon);
+
+    auto add_epsilon = m.add_instruction(migraphx::make_op("add"), mean, epsilon_mbcast);
+    auto rsqrt       = m.add_instruction(migraphx::make_op("rsqrt"), add_epsilon);
+    auto rsqrt_mbcast =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", dims}}), rsqrt);
+    auto mul = m.add_instruction(migraphx::make_op("mul"), x, rsqrt_mbcast);
+    auto scale_mbcast =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", dims}}), scale);
+    return m.add_instruction(migraphx::make_op("mul"), mul, scale_mbcast);
+}
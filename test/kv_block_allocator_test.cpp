@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/kv_block_allocator.hpp>
+#include <test.hpp>
+
+TEST_CASE(reserve_release)
+{
+    migraphx::kv_block_allocator a{4, 16};
+    EXPECT(a.free_blocks() == 4);
+    EXPECT(a.reserve(0, 17));
+    EXPECT(a.blocks(0) == std::vector<int32_t>{0, 1});
+    EXPECT(a.reserve(1, 1));
+    EXPECT(a.blocks(1) == std::vector<int32_t>{2});
+    // Growing within the last block does not allocate
+    EXPECT(a.reserve(0, 32));
+    EXPECT(a.free_blocks() == 1);
+    EXPECT(a.reserve(1, 17));
+    EXPECT(a.blocks(1) == std::vector<int32_t>{2, 3});
+    EXPECT(a.free_blocks() == 0);
+    a.release(0);
+    EXPECT(a.free_blocks() == 2);
+    EXPECT(a.blocks(0).empty());
+    EXPECT(a.reserve(2, 20));
+    EXPECT(a.blocks(2) == std::vector<int32_t>{0, 1});
+}
+
+TEST_CASE(reserve_out_of_blocks)
+{
+    migraphx::kv_block_allocator a{2, 4};
+    EXPECT(a.reserve(0, 4));
+    EXPECT(not a.reserve(0, 16));
+    EXPECT(a.blocks(0) == std::vector<int32_t>{0});
+    EXPECT(not a.reserve(1, 9));
+    EXPECT(a.blocks(1).empty());
+    EXPECT(a.free_blocks() == 1);
+}
+
+TEST_CASE(block_table)
+{
+    migraphx::kv_block_allocator a{4, 2};
+    EXPECT(a.reserve(0, 3));
+    EXPECT(a.reserve(1, 1));
+    auto table = a.block_table({1, 5, 0}, 3);
+    EXPECT(table.get_shape() == migraphx::shape{migraphx::shape::int32_type, {3, 3}});
+    std::vector<int32_t> result;
+    table.visit([&](auto t) { result.assign(t.begin(), t.end()); });
+    EXPECT(result == std::vector<int32_t>{2, -1, -1, -1, -1, -1, 0, 1, -1});
+    EXPECT(test::throws([&] { a.block_table({0}, 1); }));
+}
+
+TEST_CASE(fork_partial_block)
+{
+    migraphx::kv_block_allocator a{8, 2};
+    EXPECT(a.reserve(0, 3));
+    EXPECT(a.reserve(1, 3));
+    EXPECT(a.reserve(2, 3));
+    auto copies = a.fork({0, 1, 2}, {1, 1, 0}, 3);
+    EXPECT(copies.get_shape() == migraphx::shape{migraphx::shape::int32_type, {3, 2}});
+    std::vector<int32_t> result;
+    copies.visit([&](auto c) { result.assign(c.begin(), c.end()); });
+    // Only the shared partially filled block is copied
+    EXPECT(result == std::vector<int32_t>{3, 4, -1, -1, -1, -1});
+    EXPECT(a.blocks(0) == std::vector<int32_t>{2, 4});
+    EXPECT(a.blocks(1) == std::vector<int32_t>{2, 3});
+    EXPECT(a.blocks(2) == std::vector<int32_t>{0, 1});
+    EXPECT(a.free_blocks() == 3);
+    a.release(0);
+    a.release(1);
+    a.release(2);
+    EXPECT(a.free_blocks() == 8);
+}
+
+TEST_CASE(fork_full_blocks)
+{
+    migraphx::kv_block_allocator a{8, 2};
+    EXPECT(a.reserve(0, 4));
+    EXPECT(a.reserve(1, 4));
+    auto copies = a.fork({0, 1}, {0, 0}, 4);
+    std::vector<int32_t> result;
+    copies.visit([&](auto c) { result.assign(c.begin(), c.end()); });
+    EXPECT(result == std::vector<int32_t>{-1, -1, -1, -1});
+    EXPECT(a.blocks(1) == std::vector<int32_t>{0, 1});
+    EXPECT(a.free_blocks() == 6);
+    // Shared blocks are freed with their last sequence
+    a.release(0);
+    EXPECT(a.free_blocks() == 6);
+    a.release(1);
+    EXPECT(a.free_blocks() == 8);
+}
+
+TEST_CASE(fork_invalid)
+{
+    migraphx::kv_block_allocator a{2, 2};
+    EXPECT(a.reserve(0, 3));
+    EXPECT(test::throws([&] { a.fork({0}, {1}, 3); }));
+    EXPECT(test::throws([&] { a.fork({0}, {0}, 5); }));
+    // Not enough blocks to copy the partially filled block
+    EXPECT(test::throws([&] { a.fork({0, 1}, {0, 0}, 3); }));
+    EXPECT(a.blocks(0) == std::vector<int32_t>{0, 1});
+    EXPECT(a.free_blocks() == 0);
+}
+
+TEST_CASE(invalid_block_size)
+{
+    EXPECT(test::throws([] { migraphx::kv_block_allocator(4, 0); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -225,4 +225,60 @@ TEST_CASE(conv_reduce)
     EXPECT(m1.sort() == m2.sort());
 }
 
+void run_select_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::layout_nhwc{true}, migraphx::dead_code_elimination{}});
+}
+
+migraphx::module make_conv_relu_chain(migraphx::shape::type_t t, std::size_t n)
+{
+    migraphx::module m;
+    auto x = m.add_parameter("x", {t, {1, 64, 32, 32}});
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto w    = m.add_literal(migraphx::generate_literal({t, {64, 64, 3, 3}}, i));
+        auto conv = m.add_instruction(
+            migraphx::make_op("convolution", {{"padding", {1, 1, 1, 1}}}), x, w);
+        x = m.add_instruction(migraphx::make_op("relu"), conv);
+    }
+    m.add_return({x});
+    return m;
+}
+
+std::size_t count_nhwc_layouts(const migraphx::module& m)
+{
+    return std::count_if(m.begin(), m.end(), [](const auto& ins) {
+        return ins.name() == "layout" and
+               ins.get_operator().to_value()["permutation"].template to_vector<int64_t>() ==
+                   std::vector<int64_t>{0, 2, 3, 1};
+    });
+}
+
+TEST_CASE(select_fp32_conv_chain)
+{
+    auto m1 = make_conv_relu_chain(migraphx::shape::float_type, 4);
+    run_select_pass(m1);
+    EXPECT(m1 == make_conv_relu_chain(migraphx::shape::float_type, 4));
+}
+
+TEST_CASE(select_fp16_single_conv)
+{
+    // A single convolution doesnt save enough to pay for transposing its input and output
+    auto m1 = make_conv_relu_chain(migraphx::shape::half_type, 1);
+    run_select_pass(m1);
+    EXPECT(m1 == make_conv_relu_chain(migraphx::shape::half_type, 1));
+}
+
+TEST_CASE(select_fp16_conv_chain)
+{
+    auto m1 = make_conv_relu_chain(migraphx::shape::half_type, 4);
+    run_select_pass(m1);
+    // The input and the weights are transposed, the activations between them stay in nhwc
+    EXPECT(count_nhwc_layouts(m1) == 5);
+
+    auto m2 = make_conv_relu_chain(migraphx::shape::half_type, 4);
+    run_pass(m2);
+    EXPECT(m1.sort() == m2.sort());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -24,6 +24,7 @@
 
 #include <migraphx/literal.hpp>
 #include <migraphx/serialize.hpp>
+#include <memory>
 #include <sstream>
 #include <string>
 #include "test.hpp"
@@ -183,4 +184,36 @@ TEST_CASE(literal_to_string_float_precision)
     EXPECT(x.to_string() != "127");
 }
 
+TEST_CASE(literal_shared_buffer)
+{
+    std::vector<float> data = {1, 2, 3, 4, 5};
+    auto buffer             = std::make_shared<std::vector<float>>(data);
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    // View into the buffer starting at the second element
+    auto* first = reinterpret_cast<char*>(buffer->data() + 1);
+    migraphx::literal l{s, std::shared_ptr<char>(buffer, first)};
+    EXPECT(l.data() == first);
+    EXPECT(l == migraphx::literal{s, {2, 3, 4, 5}});
+}
+
+TEST_CASE(literal_lazy_buffer)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    int loads = 0;
+    migraphx::literal l{s, [&] {
+                            loads++;
+                            std::vector<float> data = {1, 2, 3};
+                            auto* first             = reinterpret_cast<char*>(data.data());
+                            return migraphx::make_shared_array<char>(first, first + s.bytes());
+                        }};
+    auto copy = l;
+    EXPECT(not l.empty());
+    EXPECT(not l.is_loaded());
+    EXPECT(loads == 0);
+    EXPECT(copy == migraphx::literal{s, {1, 2, 3}});
+    EXPECT(l.is_loaded());
+    EXPECT(l.data() == copy.data());
+    EXPECT(loads == 1);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -25,6 +25,7 @@
 #include <migraphx/iterator_for.hpp>
 #include <test.hpp>
 #include <basic_ops.hpp>
+#include <set>
 
 namespace match = migraphx::match;
 
@@ -1191,4 +1192,64 @@ TEST_CASE(match_finder)
     match::find_matches(mm, match_find_sum{sum}, match_find_literal{sum});
 }
 
+TEST_CASE(match_root_names)
+{
+    auto names = [](auto m) {
+        auto r = match::root_names(m);
+        if(r == nullptr)
+            return std::set<std::string>{};
+        return std::set<std::string>(r->begin(), r->end());
+    };
+    using names_set = std::set<std::string>;
+    EXPECT(names(match::name("sum")) == names_set{"sum"});
+    EXPECT(names(match::name("sum", "pass")) == names_set{"pass", "sum"});
+    EXPECT(names(match::name("sum")(match::arg(0)(match::name("pass")))) == names_set{"sum"});
+    EXPECT(names(match::name("sum").bind("x")) == names_set{"sum"});
+    EXPECT(names(match::any_of(match::name("sum"), match::name("pass"))) ==
+           names_set{"pass", "sum"});
+    EXPECT(names(match::all_of(match::standard_shape(), match::name("sum"))) == names_set{"sum"});
+    EXPECT(match::root_names(match::any_of(match::name("sum"), match::standard_shape())) ==
+           nullptr);
+    EXPECT(match::root_names(match::arg(0)(match::name("sum"))) == nullptr);
+    EXPECT(match::root_names(match::none_of(match::name("sum"))) == nullptr);
+}
+
+inline auto counted_matcher(const std::shared_ptr<std::size_t>& count)
+{
+    return match::make_basic_pred_matcher([=](migraphx::instruction_ref) {
+        (*count)++;
+        return false;
+    });
+}
+
+struct match_find_counted_sum
+{
+    std::shared_ptr<std::size_t> count;
+    auto matcher() const { return match::name("sum")(counted_matcher(count)); }
+
+    void apply(migraphx::module&, const match::matcher_result&) const {}
+};
+
+struct match_find_counted_any
+{
+    std::shared_ptr<std::size_t> count;
+    auto matcher() const { return counted_matcher(count); }
+
+    void apply(migraphx::module&, const match::matcher_result&) const {}
+};
+
+TEST_CASE(match_finder_dispatch)
+{
+    migraphx::module mm;
+    auto one = mm.add_literal(1);
+    auto two = mm.add_literal(2);
+    auto sum = mm.add_instruction(sum_op{}, one, two);
+    mm.add_instruction(pass_op{}, sum);
+    auto rooted = std::make_shared<std::size_t>(0);
+    auto any    = std::make_shared<std::size_t>(0);
+    match::find_matches(mm, match_find_counted_sum{rooted}, match_find_counted_any{any});
+    EXPECT(*rooted == 1);
+    EXPECT(*any == 4);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -27,6 +27,9 @@
 #include <migraphx/generate.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
 #include <basic_ops.hpp>
 #include <test.hpp>
 
@@ -3805,4 +3808,202 @@ TEST_CASE(test_tuple)
     CHECK(is_disjoint({a1, a2}));
 }
 
+static std::vector<migraphx::instruction_ref> get_loads(const migraphx::module& m)
+{
+    std::vector<migraphx::instruction_ref> result;
+    for(auto ins : migraphx::iterator_for(m))
+    {
+        if(ins->name() == "load")
+            result.push_back(ins);
+    }
+    return result;
+}
+
+TEST_CASE(if_shared_scratch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {8}};
+    auto cond = mm->add_parameter("cond", migraphx::shape{migraphx::shape::bool_type, {1}});
+    auto a1   = add_alloc(*mm, s);
+    auto x    = mm->add_instruction(pass_op{}, a1);
+
+    auto* then_mod = p.create_module("then");
+    {
+        auto t = add_alloc(*then_mod, s);
+        then_mod->add_return({then_mod->add_instruction(pass_op{}, t)});
+    }
+    auto* else_mod = p.create_module("else");
+    {
+        auto e1 = add_alloc(*else_mod, s);
+        auto y  = else_mod->add_instruction(pass_op{}, e1);
+        auto e2 = add_alloc(*else_mod, s);
+        else_mod->add_return({else_mod->add_instruction(pass_op{}, e2, y)});
+    }
+    auto r = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    mm->add_instruction(pass_op{}, x, r);
+    migraphx::run_passes(p, {migraphx::memory_coloring{"allocate"}});
+
+    auto scratch = mm->get_parameter("scratch");
+    // The branches share one region after the allocation that is live over the call
+    CHECK(scratch->get_shape().bytes() == 96);
+    CHECK(no_allocate(*mm));
+    CHECK(not migraphx::contains(then_mod->get_parameter_names(), "scratch"));
+    CHECK(not migraphx::contains(else_mod->get_parameter_names(), "scratch"));
+    auto then_loads = get_loads(*then_mod);
+    auto else_loads = get_loads(*else_mod);
+    EXPECT(then_loads.size() == 1);
+    EXPECT(else_loads.size() == 2);
+    for(auto load : then_loads)
+    {
+        CHECK(bool{load->inputs().front() == scratch});
+        CHECK(is_disjoint({a1, load}));
+    }
+    for(auto load : else_loads)
+    {
+        CHECK(bool{load->inputs().front() == scratch});
+        CHECK(is_disjoint({a1, load}));
+    }
+    CHECK(is_disjoint(else_loads));
+}
+
+struct set_stream_op
+{
+    std::string name() const { return "test::set_stream"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>&) const { return {}; }
+};
+
+TEST_CASE(if_streams_own_scratch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {8}};
+    auto cond = mm->add_parameter("cond", migraphx::shape{migraphx::shape::bool_type, {1}});
+    mm->add_instruction(set_stream_op{});
+    auto a1 = add_alloc(*mm, s);
+    auto x  = mm->add_instruction(pass_op{}, a1);
+
+    auto* then_mod = p.create_module("then");
+    {
+        auto t = add_alloc(*then_mod, s);
+        then_mod->add_return({then_mod->add_instruction(pass_op{}, t)});
+    }
+    auto* else_mod = p.create_module("else");
+    {
+        auto e = add_alloc(*else_mod, s);
+        else_mod->add_return({else_mod->add_instruction(pass_op{}, e)});
+    }
+    auto r = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    mm->add_instruction(pass_op{}, x, r);
+    migraphx::run_passes(p, {migraphx::memory_coloring{"allocate"}});
+
+    // The scratch of the call site would not be live over the other streams
+    CHECK(no_allocate(*mm));
+    CHECK(migraphx::contains(then_mod->get_parameter_names(), "scratch"));
+    CHECK(migraphx::contains(else_mod->get_parameter_names(), "scratch"));
+    for(auto load : get_loads(*then_mod))
+        CHECK(bool{load->inputs().front() == then_mod->get_parameter("scratch")});
+}
+
+using packing = migraphx::memory_coloring::packing;
+
+static std::size_t run_packing(migraphx::module& m, packing strategy)
+{
+    migraphx::run_passes(m, {migraphx::memory_coloring{"allocate", true, strategy}});
+    return m.get_parameter_shape("scratch").bytes();
+}
+
+static std::vector<std::size_t> get_offsets(const std::vector<migraphx::instruction_ref>& inss)
+{
+    std::vector<std::size_t> result;
+    std::transform(inss.begin(), inss.end(), std::back_inserter(result), [](auto ins) {
+        return get_load_interval(ins).first;
+    });
+    return result;
+}
+
+// Each allocation is only live with the one before and the one after it
+static std::vector<migraphx::instruction_ref> add_alloc_chain(migraphx::module& m)
+{
+    auto a1 = add_alloc(m, {migraphx::shape::float_type, {8}});
+    auto a2 = add_alloc(m, {migraphx::shape::float_type, {12}});
+    m.add_instruction(pass_op{}, a1);
+    auto a3 = add_alloc(m, {migraphx::shape::float_type, {4}});
+    m.add_instruction(pass_op{}, a2);
+    auto a4 = add_alloc(m, {migraphx::shape::float_type, {12}});
+    m.add_instruction(pass_op{}, a3);
+    m.add_instruction(pass_op{}, a4);
+    return {a1, a2, a3, a4};
+}
+
+TEST_CASE(best_fit_chain)
+{
+    // First-fit puts a3 at the start, so a4 does not fit next to a1 or a3
+    migraphx::module m1;
+    auto allocs1 = add_alloc_chain(m1);
+    CHECK(run_packing(m1, packing::first_fit) == 112);
+    CHECK(get_offsets(allocs1) == std::vector<std::size_t>{48, 0, 48, 64});
+
+    // Best-fit places the largest allocations first, which reaches the max-live bound
+    migraphx::module m2;
+    auto allocs2 = add_alloc_chain(m2);
+    CHECK(run_packing(m2, packing::best_fit_size) == 80);
+    CHECK(get_offsets(allocs2) == std::vector<std::size_t>{48, 0, 48, 0});
+
+    migraphx::module m3;
+    auto allocs3 = add_alloc_chain(m3);
+    CHECK(run_packing(m3, packing::best_fit_lifetime) == 80);
+    CHECK(get_offsets(allocs3) == std::vector<std::size_t>{48, 0, 48, 0});
+
+    migraphx::module m4;
+    auto allocs4 = add_alloc_chain(m4);
+    CHECK(run_packing(m4, packing::smallest) == 80);
+    CHECK(get_offsets(allocs4) == std::vector<std::size_t>{48, 0, 48, 0});
+    CHECK(no_allocate(m4));
+    CHECK(is_disjoint({allocs4[0], allocs4[1]}));
+    CHECK(is_disjoint({allocs4[1], allocs4[2]}));
+    CHECK(is_disjoint({allocs4[2], allocs4[3]}));
+}
+
+// Same conflicts as the chain, but a3 is used last along with a4
+static std::vector<migraphx::instruction_ref> add_alloc_long_lived(migraphx::module& m)
+{
+    auto a1 = add_alloc(m, {migraphx::shape::float_type, {12}});
+    auto a2 = add_alloc(m, {migraphx::shape::float_type, {8}});
+    m.add_instruction(pass_op{}, a1);
+    auto a3 = add_alloc(m, {migraphx::shape::float_type, {12}});
+    m.add_instruction(pass_op{}, a2);
+    auto a4 = add_alloc(m, {migraphx::shape::float_type, {16}});
+    m.add_instruction(pass_op{}, a3, a4);
+    return {a1, a2, a3, a4};
+}
+
+TEST_CASE(best_fit_lifetime)
+{
+    migraphx::module m1;
+    auto allocs1 = add_alloc_long_lived(m1);
+    CHECK(run_packing(m1, packing::first_fit) == 128);
+    CHECK(get_offsets(allocs1) == std::vector<std::size_t>{80, 48, 0, 48});
+
+    // Placing by size alone is worse than first-fit here
+    migraphx::module m2;
+    auto allocs2 = add_alloc_long_lived(m2);
+    CHECK(run_packing(m2, packing::best_fit_size) == 144);
+    CHECK(get_offsets(allocs2) == std::vector<std::size_t>{0, 112, 64, 0});
+
+    // Weighting by the lifetime places a3 first and reaches the max-live bound
+    migraphx::module m3;
+    auto allocs3 = add_alloc_long_lived(m3);
+    CHECK(run_packing(m3, packing::best_fit_lifetime) == 112);
+    CHECK(get_offsets(allocs3) == std::vector<std::size_t>{0, 48, 0, 48});
+
+    // The smallest of the strategies is kept
+    migraphx::module m4;
+    auto allocs4 = add_alloc_long_lived(m4);
+    CHECK(run_packing(m4, packing::smallest) == 112);
+    CHECK(get_offsets(allocs4) == std::vector<std::size_t>{0, 48, 0, 48});
+    CHECK(no_allocate(m4));
+    CHECK(is_disjoint({allocs4[2], allocs4[3]}));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,98 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/metrics.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/register_target.hpp>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <test.hpp>
+
+TEST_CASE(counter)
+{
+    auto& c = migraphx::get_metric_counter("test_counter");
+    EXPECT(&c == &migraphx::get_metric_counter("test_counter"));
+    c.reset();
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; i++)
+        threads.emplace_back([&] {
+            for(int j = 0; j < 1000; j++)
+                c.add();
+        });
+    for(auto& t : threads)
+        t.join();
+    EXPECT(c.get() == 4000);
+    EXPECT(migraphx::get_metric("test_counter") == 4000);
+    EXPECT(migraphx::get_metric("test_unknown") == 0);
+}
+
+TEST_CASE(histogram)
+{
+    auto& h = migraphx::get_metric_histogram("test_histogram");
+    h.reset();
+    for(std::uint64_t x : {0, 1, 2, 3, 4, 100})
+        h.record(x);
+    EXPECT(h.count() == 6);
+    EXPECT(h.sum() == 110);
+    EXPECT(h.bucket(0) == 1);
+    EXPECT(h.bucket(1) == 1);
+    EXPECT(h.bucket(2) == 2);
+    EXPECT(h.bucket(3) == 1);
+    EXPECT(h.bucket(7) == 1);
+
+    auto metrics = migraphx::get_metrics();
+    EXPECT(metrics.at("test_histogram.count") == 6);
+    EXPECT(metrics.at("test_histogram.sum") == 110);
+    EXPECT(metrics.at("test_histogram.le_1") == 1);
+    EXPECT(metrics.at("test_histogram.le_4") == 4);
+    EXPECT(metrics.at("test_histogram.le_128") == 6);
+    EXPECT(metrics.count("test_histogram.le_256") == 0);
+}
+
+TEST_CASE(histogram_overflow)
+{
+    auto& h = migraphx::get_metric_histogram("test_histogram_overflow");
+    h.reset();
+    h.record(std::numeric_limits<std::uint64_t>::max());
+    EXPECT(h.bucket(migraphx::metric_histogram::nbuckets - 1) == 1);
+}
+
+TEST_CASE(eval_metrics)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {4}});
+    mm->add_instruction(migraphx::make_op("relu"), x);
+    p.compile(migraphx::make_target("ref"));
+    migraphx::reset_metrics();
+    std::vector<float> data(4);
+    for(int i = 0; i < 3; i++)
+        p.eval({{"x", migraphx::argument{p.get_parameter_shape("x"), data.data()}}});
+    EXPECT(migraphx::get_metric("eval") == 3);
+    EXPECT(migraphx::get_metric("eval_latency_us.count") == 3);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -761,4 +761,104 @@ TEST_CASE(add_params)
     EXPECT(bool{m1.get_parameter("x1") == map_ins[add]});
 }
 
+TEST_CASE(incremental_rewrites)
+{
+    migraphx::module m;
+    auto x = m.add_parameter("x", {migraphx::shape::float_type, {4}});
+    std::vector<migraphx::instruction_ref> chain;
+    auto ins = x;
+    for(int i = 0; i < 5; i++)
+    {
+        ins = m.add_instruction(migraphx::make_op("neg"), ins);
+        chain.push_back(ins);
+    }
+    m.add_return({ins});
+    auto dirty = [&] {
+        std::vector<bool> result;
+        std::transform(chain.begin(), chain.end(), std::back_inserter(result), [&](auto i) {
+            return m.is_dirty(i);
+        });
+        return result;
+    };
+
+    m.set_incremental_rewrites();
+    EXPECT(dirty() == std::vector<bool>{true, true, true, true, true});
+    m.next_rewrite_epoch();
+    EXPECT(dirty() == std::vector<bool>{false, false, false, false, false});
+
+    m.replace_instruction(chain[0], migraphx::make_op("abs"), x);
+    EXPECT(dirty() == std::vector<bool>{true, true, true, true, false});
+    m.next_rewrite_epoch();
+    EXPECT(dirty() == std::vector<bool>{true, true, true, true, false});
+    m.next_rewrite_epoch();
+    EXPECT(dirty() == std::vector<bool>{false, false, false, false, false});
+
+    m.set_incremental_rewrites(false);
+    EXPECT(dirty() == std::vector<bool>{true, true, true, true, true});
+}
+
+TEST_CASE(incremental_rewrites_siblings)
+{
+    // Matchers such as horizontal fusion look at the other outputs of an input, so a rewrite that
+    // gives an instruction a new sibling has to make the existing siblings dirty
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    auto x    = m.add_parameter("x", s);
+    auto y    = m.add_parameter("y", s);
+    auto negx = m.add_instruction(migraphx::make_op("neg"), x);
+    auto absx = m.add_instruction(migraphx::make_op("abs"), negx);
+    auto negy = m.add_instruction(migraphx::make_op("neg"), y);
+    auto absy = m.add_instruction(migraphx::make_op("abs"), negy);
+    auto add  = m.add_instruction(migraphx::make_op("add"), absx, absy);
+    m.add_return({add});
+
+    m.set_incremental_rewrites();
+    m.next_rewrite_epoch();
+    EXPECT(not m.is_dirty(negx));
+    EXPECT(not m.is_dirty(absy));
+
+    // neg(y) becomes a sibling of neg(x), which the rewrite didn't otherwise touch
+    m.replace_instruction(negy, migraphx::make_op("neg"), x);
+    EXPECT(m.is_dirty(negx));
+    EXPECT(m.is_dirty(x));
+    EXPECT(m.is_dirty(y));
+    m.next_rewrite_epoch();
+    EXPECT(m.is_dirty(negx));
+    m.next_rewrite_epoch();
+    EXPECT(not m.is_dirty(negx));
+}
+
+TEST_CASE(cached_analysis)
+{
+    migraphx::module m;
+    auto x   = m.add_parameter("x", {migraphx::shape::float_type, {4}});
+    auto neg = m.add_instruction(migraphx::make_op("neg"), x);
+    auto abs = m.add_instruction(migraphx::make_op("abs"), neg);
+    m.add_return({abs});
+    int computed = 0;
+    auto count   = [&](const migraphx::module& mm) {
+        computed++;
+        return mm.size();
+    };
+
+    EXPECT(*m.get_analysis<std::size_t>(count) == 4);
+    EXPECT(*m.get_analysis<std::size_t>(count) == 4);
+    EXPECT(computed == 1);
+
+    // Modifying the module invalidates the analysis
+    m.insert_instruction(abs, migraphx::make_op("relu"), neg);
+    EXPECT(*m.get_analysis<std::size_t>(count) == 5);
+    EXPECT(computed == 2);
+
+    // So does rewiring an instruction without going through the module
+    migraphx::instruction::replace_argument(abs, neg, x);
+    EXPECT(*m.get_analysis<std::size_t>(count) == 5);
+    EXPECT(computed == 3);
+
+    // Copies do not share the cache
+    auto m2 = m;
+    EXPECT(*m2.get_analysis<std::size_t>(count) == 5);
+    EXPECT(computed == 4);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
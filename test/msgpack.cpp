@@ -183,6 +183,23 @@ TEST_CASE(test_msgpack_binary)
     EXPECT(migraphx::from_msgpack(buffer) == bin);
 }
 
+TEST_CASE(test_msgpack_nested)
+{
+    migraphx::value::binary bin{16};
+    std::iota(bin.begin(), bin.end(), 1);
+    migraphx::value v = {{"a", {1, 2, 3}}, {"b", {{"c", "abc"}, {"d", bin}}}, {"e", nullptr}};
+    auto buffer       = migraphx::to_msgpack(v);
+    EXPECT(migraphx::from_msgpack(buffer) == v);
+}
+
+TEST_CASE(test_msgpack_truncated)
+{
+    migraphx::value v = {1, 2, 3};
+    auto buffer       = migraphx::to_msgpack(v);
+    buffer.pop_back();
+    EXPECT(test::throws([&] { migraphx::from_msgpack(buffer); }));
+}
+
 #ifndef MIGRAPHX_DISABLE_LARGE_BUFFER_TESTS
 TEST_CASE(test_msgpack_large_binary1)
 {
@@ -2875,6 +2875,37 @@ def einsum_bilinear_transformation_test():
     return ([node], [x1, x2, x3], [y])
 
 
+@onnx_test()
+def einsum_chain_test():
+    x1 = helper.make_tensor_value_info('x1', TensorProto.FLOAT, [2, 3])
+    x2 = helper.make_tensor_value_info('x2', TensorProto.FLOAT, [3, 4])
+    x3 = helper.make_tensor_value_info('x3', TensorProto.FLOAT, [4])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2])
+
+    node = onnx.helper.make_node('Einsum',
+                                 inputs=['x1', 'x2', 'x3'],
+                                 outputs=['y'],
+                                 equation='ij,jk,k->i')
+
+    return ([node], [x1, x2, x3], [y])
+
+
+@onnx_test()
+def einsum_4_inputs_test():
+    x1 = helper.make_tensor_value_info('x1', TensorProto.FLOAT, [2, 2, 3])
+    x2 = helper.make_tensor_value_info('x2', TensorProto.FLOAT, [2, 3, 4])
+    x3 = helper.make_tensor_value_info('x3', TensorProto.FLOAT, [2, 4, 3])
+    x4 = helper.make_tensor_value_info('x4', TensorProto.FLOAT, [2, 3])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2, 2])
+
+    node = onnx.helper.make_node('Einsum',
+                                 inputs=['x1', 'x2', 'x3', 'x4'],
+                                 outputs=['y'],
+                                 equation='bij,bjk,bkl,bl->bi')
+
+    return ([node], [x1, x2, x3, x4], [y])
+
+
 @onnx_test()
 def einsum_ellipsis_test():
     x1 = helper.make_tensor_value_info('x1', TensorProto.FLOAT, [2, 3, 2])
@@ -4650,6 +4681,36 @@ def group_norm_test(x_dims,
     return ([node], [x, scale, bias], [y])
 
 
+@onnx_test()
+def group_query_attention_test():
+    q = helper.make_tensor_value_info('q', TensorProto.FLOAT, [1, 2, 4])
+    k = helper.make_tensor_value_info('k', TensorProto.FLOAT, [1, 2, 2])
+    v = helper.make_tensor_value_info('v', TensorProto.FLOAT, [1, 2, 2])
+    past_k = helper.make_tensor_value_info('past_k', TensorProto.FLOAT,
+                                           [1, 1, 2, 2])
+    past_v = helper.make_tensor_value_info('past_v', TensorProto.FLOAT,
+                                           [1, 1, 2, 2])
+    seqlens_k = helper.make_tensor_value_info('seqlens_k', TensorProto.INT32,
+                                              [1])
+    total = helper.make_tensor_value_info('total', TensorProto.INT32, [])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [1, 2, 4])
+    present_k = helper.make_tensor_value_info('present_k', TensorProto.FLOAT,
+                                              [1, 1, 4, 2])
+    present_v = helper.make_tensor_value_info('present_v', TensorProto.FLOAT,
+                                              [1, 1, 4, 2])
+
+    node = onnx.helper.make_node(
+        'GroupQueryAttention',
+        inputs=['q', 'k', 'v', 'past_k', 'past_v', 'seqlens_k', 'total'],
+        outputs=['y', 'present_k', 'present_v'],
+        num_heads=2,
+        kv_num_heads=1,
+        domain='com.microsoft')
+
+    return ([node], [q, k, v, past_k, past_v, seqlens_k,
+                     total], [y, present_k, present_v])
+
+
 @onnx_test()
 def group_norm_3d_test():
     return group_norm_test([1, 4, 2], [2], [2], [1, 4, 2], 2)
@@ -7287,6 +7348,66 @@ def matmulinteger_int8_uint8_dual_zero_zp_test():
     return ([node], [m1, m2], [y], [zp1, zp2])
 
 
+@onnx_test()
+def matmulnbits_test():
+    a = helper.make_tensor_value_info('a', TensorProto.FLOAT, [2, 32])
+    b = helper.make_tensor_value_info('b', TensorProto.UINT8, [4, 2, 8])
+    scales = helper.make_tensor_value_info('scales', TensorProto.FLOAT, [8])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2, 4])
+
+    node = onnx.helper.make_node('MatMulNBits',
+                                 inputs=['a', 'b', 'scales'],
+                                 outputs=['y'],
+                                 K=32,
+                                 N=4,
+                                 bits=4,
+                                 block_size=16,
+                                 domain='com.microsoft')
+
+    return ([node], [a, b, scales], [y])
+
+
+@onnx_test()
+def matmulnbits_zp_bias_test():
+    a = helper.make_tensor_value_info('a', TensorProto.FLOAT, [2, 24])
+    b = helper.make_tensor_value_info('b', TensorProto.UINT8, [4, 2, 8])
+    scales = helper.make_tensor_value_info('scales', TensorProto.FLOAT, [8])
+    zp = helper.make_tensor_value_info('zp', TensorProto.UINT8, [4])
+    bias = helper.make_tensor_value_info('bias', TensorProto.FLOAT, [4])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2, 4])
+
+    node = onnx.helper.make_node('MatMulNBits',
+                                 inputs=['a', 'b', 'scales', 'zp', '', 'bias'],
+                                 outputs=['y'],
+                                 K=24,
+                                 N=4,
+                                 bits=4,
+                                 block_size=16,
+                                 domain='com.microsoft')
+
+    return ([node], [a, b, scales, zp, bias], [y])
+
+
+@onnx_test()
+def matmulnbits_act_order_test():
+    a = helper.make_tensor_value_info('a', TensorProto.FLOAT, [2, 32])
+    b = helper.make_tensor_value_info('b', TensorProto.UINT8, [4, 2, 8])
+    scales = helper.make_tensor_value_info('scales', TensorProto.FLOAT, [8])
+    g_idx = helper.make_tensor_value_info('g_idx', TensorProto.INT32, [32])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [2, 4])
+
+    node = onnx.helper.make_node('MatMulNBits',
+                                 inputs=['a', 'b', 'scales', '', 'g_idx'],
+                                 outputs=['y'],
+                                 K=32,
+                                 N=4,
+                                 bits=4,
+                                 block_size=16,
+                                 domain='com.microsoft')
+
+    return ([node], [a, b, scales, g_idx], [y])
+
+
 @onnx_test()
 def max_test():
     a = helper.make_tensor_value_info('0', TensorProto.FLOAT, [3])
@@ -7645,6 +7766,23 @@ def multinomial_dyn_test():
     return ([node], [input], [output])
 
 
+@onnx_test()
+def multi_head_attention_causal_test():
+    q = helper.make_tensor_value_info('q', TensorProto.FLOAT, [1, 3, 4])
+    k = helper.make_tensor_value_info('k', TensorProto.FLOAT, [1, 3, 4])
+    v = helper.make_tensor_value_info('v', TensorProto.FLOAT, [1, 3, 4])
+    y = helper.make_tensor_value_info('y', TensorProto.FLOAT, [1, 3, 4])
+
+    node = onnx.helper.make_node('MultiHeadAttention',
+                                 inputs=['q', 'k', 'v'],
+                                 outputs=['y'],
+                                 num_heads=2,
+                                 unidirectional=1,
+                                 domain='com.microsoft')
+
+    return ([node], [q, k, v], [y])
+
+
 @onnx_test()
 def multinomial_autoseed_dyn_test():
     # If seed attribute is not given, device should auto generate one at runtime
@@ -10286,6 +10424,54 @@ def resize_upsample_pc_test():
     return ([node], [X], [Y], [scale_tensor])
 
 
+@onnx_test()
+def resize_image_preprocess_test():
+    scales = np.array([1.0, 1.0, 0.5, 0.5], dtype=np.float32)
+    scale_tensor = helper.make_tensor(name='scales',
+                                      data_type=TensorProto.FLOAT,
+                                      dims=scales.shape,
+                                      vals=scales.flatten().astype(np.float32))
+    mean = np.array([123.675, 116.28, 103.53], dtype=np.float32)
+    mean_tensor = helper.make_tensor(name='mean',
+                                     data_type=TensorProto.FLOAT,
+                                     dims=[1, 3, 1, 1],
+                                     vals=mean.flatten().astype(np.float32))
+    std = np.array([58.395, 57.12, 57.375], dtype=np.float32)
+    std_tensor = helper.make_tensor(name='std',
+                                    data_type=TensorProto.FLOAT,
+                                    dims=[1, 3, 1, 1],
+                                    vals=std.flatten().astype(np.float32))
+
+    X = helper.make_tensor_value_info('X', TensorProto.UINT8, [1, 4, 4, 3])
+    Y = helper.make_tensor_value_info('Y', TensorProto.FLOAT16, [1, 3, 2, 2])
+
+    cast = onnx.helper.make_node('Cast',
+                                 inputs=['X'],
+                                 outputs=['x_float'],
+                                 to=TensorProto.FLOAT)
+    transpose = onnx.helper.make_node('Transpose',
+                                      inputs=['x_float'],
+                                      outputs=['x_nchw'],
+                                      perm=[0, 3, 1, 2])
+    resize = onnx.helper.make_node('Resize',
+                                   inputs=['x_nchw', '', 'scales'],
+                                   outputs=['resized'],
+                                   mode='linear')
+    sub = onnx.helper.make_node('Sub',
+                                inputs=['resized', 'mean'],
+                                outputs=['centered'])
+    div = onnx.helper.make_node('Div',
+                                inputs=['centered', 'std'],
+                                outputs=['normalized'])
+    cast_half = onnx.helper.make_node('Cast',
+                                      inputs=['normalized'],
+                                      outputs=['Y'],
+                                      to=TensorProto.FLOAT16)
+
+    return ([cast, transpose, resize, sub, div,
+             cast_half], [X], [Y], [scale_tensor, mean_tensor, std_tensor])
+
+
 @onnx_test()
 def reversesequence_4D_test():
     x = helper.make_tensor_value_info('x', TensorProto.FLOAT, [2, 2, 2, 2])
@@ -10622,6 +10808,25 @@ def roialign_test():
     return ([node], [x, roi, bi], [y])
 
 
+@onnx_test()
+def rotary_embedding_test():
+    x = helper.make_tensor_value_info('input', TensorProto.FLOAT, [1, 2, 8])
+    pos = helper.make_tensor_value_info('position_ids', TensorProto.INT64,
+                                        [1, 2])
+    cos = helper.make_tensor_value_info('cos_cache', TensorProto.FLOAT, [4, 2])
+    sin = helper.make_tensor_value_info('sin_cache', TensorProto.FLOAT, [4, 2])
+    y = helper.make_tensor_value_info('output', TensorProto.FLOAT, [1, 2, 8])
+
+    node = onnx.helper.make_node(
+        'RotaryEmbedding',
+        inputs=['input', 'position_ids', 'cos_cache', 'sin_cache'],
+        outputs=['output'],
+        domain='com.microsoft',
+        num_heads=2)
+
+    return ([node], [x, pos, cos, sin], [y])
+
+
 @onnx_test()
 def round_half_test():
     x = helper.make_tensor_value_info('x', TensorProto.FLOAT16, [4, 4])
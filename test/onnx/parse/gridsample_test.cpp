@@ -1,7 +1,7 @@
 /*
  * The MIT License (MIT)
  *
- * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -21,20 +21,22 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#include <migraphx/gpu/device/fill.hpp>
-#include <migraphx/gpu/device/nary.hpp>
 
-namespace migraphx {
-inline namespace MIGRAPHX_INLINE_NS {
-namespace gpu {
-namespace device {
+#include <onnx_test.hpp>
 
-void fill(hipStream_t stream, const argument& result, unsigned long val)
+TEST_CASE(gridsample_test)
 {
-    nary(stream, result)([=]() __device__ { return val; });
-}
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto x    = mm->add_parameter("x", {migraphx::shape::float_type, {1, 1, 4, 4}});
+    auto grid = mm->add_parameter("grid", {migraphx::shape::float_type, {1, 6, 6, 2}});
+    auto y    = mm->add_instruction(
+        migraphx::make_op("gridsample",
+                          {{"mode", "linear"}, {"padding_mode", "zeros"}, {"align_corners", false}}),
+        x,
+        grid);
+    mm->add_return({y});
 
-} // namespace device
-} // namespace gpu
-} // namespace MIGRAPHX_INLINE_NS
-} // namespace migraphx
+    auto prog = read_onnx("gridsample_test.onnx");
+    EXPECT(p == prog);
+}
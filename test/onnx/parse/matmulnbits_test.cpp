@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <onnx_test.hpp>
+
+TEST_CASE(matmulnbits_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    auto a = mm->add_parameter("a", migraphx::shape{migraphx::shape::float_type, {2, 32}});
+    auto b = mm->add_parameter("b", migraphx::shape{migraphx::shape::uint8_type, {4, 2, 8}});
+    auto scales = mm->add_parameter("scales", migraphx::shape{migraphx::shape::float_type, {8}});
+
+    auto perm = migraphx::make_op("transpose", {{"permutation", {1, 0}}});
+    auto w    = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4, 16}}}), b);
+    w         = mm->add_instruction(perm, w);
+    w         = mm->add_instruction(migraphx::make_op("unpack_int4", {{"axis", 0}}), w);
+    scales    = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4, 2}}}), scales);
+    scales    = mm->add_instruction(perm, scales);
+    auto zp   = mm->add_literal(
+        migraphx::literal{migraphx::shape{migraphx::shape::uint8_type}, {uint8_t{8}}});
+    zp = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", {2, 4}}}), zp);
+
+    auto blocked = [&](auto ins) {
+        ins = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {1}}}), ins);
+        ins = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {2, 16, 4}}}), ins);
+        return mm->add_instruction(migraphx::make_op("reshape", {{"dims", {32, 4}}}), ins);
+    };
+    scales = blocked(scales);
+    zp     = blocked(zp);
+    w      = mm->add_instruction(migraphx::make_op("dequantizelinear"), w, scales, zp);
+    mm->add_instruction(migraphx::make_op("dot"), a, w);
+
+    auto prog = optimize_onnx("matmulnbits_test.onnx");
+    EXPECT(p == prog);
+}
+
+TEST_CASE(matmulnbits_zp_bias_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    auto a = mm->add_parameter("a", migraphx::shape{migraphx::shape::float_type, {2, 24}});
+    auto b = mm->add_parameter("b", migraphx::shape{migraphx::shape::uint8_type, {4, 2, 8}});
+    auto scales = mm->add_parameter("scales", migraphx::shape{migraphx::shape::float_type, {8}});
+    auto zp     = mm->add_parameter("zp", migraphx::shape{migraphx::shape::uint8_type, {4}});
+    auto bias   = mm->add_parameter("bias", migraphx::shape{migraphx::shape::float_type, {4}});
+
+    auto perm = migraphx::make_op("transpose", {{"permutation", {1, 0}}});
+    auto w    = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4, 16}}}), b);
+    w         = mm->add_instruction(perm, w);
+    w         = mm->add_instruction(migraphx::make_op("unpack_int4", {{"axis", 0}}), w);
+    w         = mm->add_instruction(
+        migraphx::make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {24}}}), w);
+    scales = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4, 2}}}), scales);
+    scales = mm->add_instruction(perm, scales);
+    zp     = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {4, 1}}}), zp);
+    zp     = mm->add_instruction(perm, zp);
+    zp     = mm->add_instruction(migraphx::make_op("unpack_int4", {{"axis", 0}}), zp);
+
+    auto blocked = [&](auto ins) {
+        ins = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {1}}}), ins);
+        ins = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {2, 16, 4}}}), ins);
+        ins = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {32, 4}}}), ins);
+        return mm->add_instruction(
+            migraphx::make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {24}}}), ins);
+    };
+    scales   = blocked(scales);
+    zp       = blocked(zp);
+    w        = mm->add_instruction(migraphx::make_op("dequantizelinear"), w, scales, zp);
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), a, w);
+    bias = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", {2, 4}}}), bias);
+    mm->add_instruction(migraphx::make_op("add"), dot, bias);
+
+    auto prog = optimize_onnx("matmulnbits_zp_bias_test.onnx");
+    EXPECT(p == prog);
+}
+
+TEST_CASE(matmulnbits_act_order_test)
+{
+    EXPECT(test::throws([&] { read_onnx("matmulnbits_act_order_test.onnx"); }));
+}
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <onnx_test.hpp>
+
+TEST_CASE(resize_image_preprocess_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {4}}, {1.0f, 1.0f, 0.5f, 0.5f}});
+    auto mean   = mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {1, 3, 1, 1}},
+                                                  {123.675f, 116.28f, 103.53f}});
+    auto stddev = mm->add_literal(migraphx::literal{{migraphx::shape::float_type, {1, 3, 1, 1}},
+                                                    {58.395f, 57.12f, 57.375f}});
+    auto x      = mm->add_parameter("X", {migraphx::shape::uint8_type, {1, 4, 4, 3}});
+    auto xf     = mm->add_instruction(
+        migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), x);
+    mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 3, 1, 2}}}), xf);
+    mm->add_instruction(migraphx::make_op("undefined"));
+    // The image is resized without converting and transposing it first
+    auto image = mm->add_instruction(migraphx::make_op("image_preprocess",
+                                                       {{"sizes", {2, 2}},
+                                                        {"scales", {0.5, 0.5}},
+                                                        {"mode", "linear"},
+                                                        {"nearest_mode", "round_prefer_floor"},
+                                                        {"coordinate_transformation_mode",
+                                                         "half_pixel"}}),
+                                     x);
+    auto sub = add_common_op(*mm, migraphx::make_op("sub"), {image, mean});
+    auto div = add_common_op(*mm, migraphx::make_op("div"), {sub, stddev});
+    auto y   = mm->add_instruction(
+        migraphx::make_op("convert", {{"target_type", migraphx::shape::half_type}}), div);
+    mm->add_return({y});
+
+    auto prog = read_onnx("resize_image_preprocess_test.onnx");
+    EXPECT(p == prog);
+}
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <onnx_test.hpp>
+
+TEST_CASE(rotary_embedding_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("input", {migraphx::shape::float_type, {1, 2, 8}});
+    auto pos = mm->add_parameter("position_ids", {migraphx::shape::int64_type, {1, 2}});
+    auto cos = mm->add_parameter("cos_cache", {migraphx::shape::float_type, {4, 2}});
+    auto sin = mm->add_parameter("sin_cache", {migraphx::shape::float_type, {4, 2}});
+
+    x   = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {1, 2, 2, 4}}}), x);
+    cos = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), cos, pos);
+    sin = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), sin, pos);
+    cos = mm->add_instruction(migraphx::make_op("concat", {{"axis", 2}}), cos, cos);
+    sin = mm->add_instruction(migraphx::make_op("concat", {{"axis", 2}}), sin, sin);
+    cos = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {2}}}), cos);
+    sin = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {2}}}), sin);
+    cos = mm->add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", {1, 2, 2, 4}}}), cos);
+    sin = mm->add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", {1, 2, 2, 4}}}), sin);
+    auto y = mm->add_instruction(migraphx::make_op("rotary_embedding"), x, cos, sin);
+    auto r = mm->add_instruction(migraphx::make_op("reshape", {{"dims", {1, 2, 8}}}), y);
+    mm->add_return({r});
+
+    auto prog = read_onnx("rotary_embedding_test.onnx");
+    EXPECT(p == prog);
+}
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <onnx_test.hpp>
+
+static migraphx::program parse_onnx_file(const std::string& name)
+{
+    static migraphx::tmp_dir td{"stream_model"};
+    static auto onnx_files{::onnx_files()};
+    auto file = td.path / name;
+    migraphx::write_buffer(file, onnx_files.at(name).data(), onnx_files.at(name).size());
+    return migraphx::parse_onnx(file.string());
+}
+
+TEST_CASE(stream_model_raw_initializer_test)
+{
+    // The raw initializer is read from the mapped model file rather than from the proto
+    auto prog = parse_onnx_file("sum_type_test.onnx");
+    EXPECT(prog == read_onnx("sum_type_test.onnx"));
+}
+
+TEST_CASE(stream_model_initializer_test)
+{
+    auto prog = parse_onnx_file("initializer_not_an_input.onnx");
+    EXPECT(prog == read_onnx("initializer_not_an_input.onnx"));
+}
+
+TEST_CASE(stream_model_missing_file_test)
+{
+    EXPECT(test::throws([] { migraphx::parse_onnx("stream_model_missing_file.onnx"); }));
+}
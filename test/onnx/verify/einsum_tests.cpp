@@ -1031,6 +1031,79 @@ TEST_CASE(einsum_bilinear_transformation_test)
     EXPECT(migraphx::verify::verify_rms_range(result_vector, gold));
 }
 
+TEST_CASE(einsum_chain_test)
+{
+    // Contracting x2 and x3 first avoids the [2, 4] intermediate of the left to right order
+    migraphx::program p = read_onnx("einsum_chain_test.onnx");
+    p.compile(migraphx::make_target("ref"));
+
+    migraphx::shape x1_shape{migraphx::shape::float_type, {2, 3}};
+    std::vector<float> x1_data = {-0.3523, -0.6983, 0.3019, -0.8551, 0.0718, -0.2686};
+
+    migraphx::shape x2_shape{migraphx::shape::float_type, {3, 4}};
+    std::vector<float> x2_data = {
+        -0.884, 0.0149, -0.925, -0.1327, -0.8603, -0.8186, -0.151, 0.6537, -0.7524, -0.5535, 0.2549,
+        0.8954};
+
+    migraphx::shape x3_shape{migraphx::shape::float_type, {4}};
+    std::vector<float> x3_data = {0.1542, -0.2066, 0.9525, -0.9068};
+
+    migraphx::parameter_map pm;
+    pm["x1"] = migraphx::argument{x1_shape, x1_data.data()};
+    pm["x2"] = migraphx::argument{x2_shape, x2_data.data()};
+    pm["x3"] = migraphx::argument{x3_shape, x3_data.data()};
+
+    auto result = p.eval(pm).back();
+    EXPECT(result.get_shape() == make_shape({2}));
+
+    std::vector<float> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    std::vector<float> gold = {0.633688, 0.872747};
+    EXPECT(migraphx::verify::verify_rms_range(result_vector, gold));
+}
+
+TEST_CASE(einsum_4_inputs_test)
+{
+    migraphx::program p = read_onnx("einsum_4_inputs_test.onnx");
+    p.compile(migraphx::make_target("ref"));
+
+    migraphx::shape x1_shape{migraphx::shape::float_type, {2, 2, 3}};
+    std::vector<float> x1_data = {
+        0.7169, -0.4208, -0.7115, -0.7644, -0.383, 0.6323, -0.6385, 0.1632, 0.2778, -0.2552, 0.0955,
+        -0.8744};
+
+    migraphx::shape x2_shape{migraphx::shape::float_type, {2, 3, 4}};
+    std::vector<float> x2_data = {
+        -0.8808, -0.5881, 0.3608, -0.1448, -0.3717, 0.1711, -0.0936, -0.4005, 0.5888, 0.398,
+        -0.5118, 0.1488,  0.0504, 0.7503,  0.4589,  -0.4241, 0.9603, -0.7639, -0.1638, 0.5143,
+        -0.696,  -0.0221, -0.9216, 0.3364};
+
+    migraphx::shape x3_shape{migraphx::shape::float_type, {2, 4, 3}};
+    std::vector<float> x3_data = {
+        0.5291,  0.1461,  0.751,   -0.3725, 0.3906, 0.1887,  0.1598,  -0.0876, 0.6799, 0.8894,
+        -0.0518, 0.3283,  -0.8787, 0.403,   0.2943, 0.9862,  0.6438,  -0.4308, -0.2284, 0.3373,
+        -0.9549, -0.0766, -0.6639, -0.7658};
+
+    migraphx::shape x4_shape{migraphx::shape::float_type, {2, 3}};
+    std::vector<float> x4_data = {-0.8821, 0.5365, -0.7413, -0.5048, -0.2181, 0.7428};
+
+    migraphx::parameter_map pm;
+    pm["x1"] = migraphx::argument{x1_shape, x1_data.data()};
+    pm["x2"] = migraphx::argument{x2_shape, x2_data.data()};
+    pm["x3"] = migraphx::argument{x3_shape, x3_data.data()};
+    pm["x4"] = migraphx::argument{x4_shape, x4_data.data()};
+
+    auto result = p.eval(pm).back();
+    EXPECT(result.get_shape() == make_shape({2, 2}));
+
+    std::vector<float> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    std::vector<float> gold = {0.120712, -0.857659, 0.75654, 0.233031};
+    EXPECT(migraphx::verify::verify_rms_range(result_vector, gold));
+}
+
 TEST_CASE(einsum_ellipsis_test)
 {
     migraphx::program p = read_onnx("einsum_ellipsis_test.onnx");
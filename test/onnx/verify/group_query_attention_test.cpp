@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <onnx_test.hpp>
+#include <cmath>
+#include <numeric>
+
+// batch 1, sequence 2, 2 query heads sharing 1 kv head of size 2, past of 2
+static void verify_group_query_attention(int32_t seqlens_k)
+{
+    std::vector<float> q      = {0.1, -0.2, 0.3, 0.4, 0.5, 0.6, -0.7, 0.8};
+    std::vector<float> k      = {0.2, 0.1, -0.4, 0.3};
+    std::vector<float> v      = {1.0, 2.0, 3.0, 4.0};
+    std::vector<float> past_k = {0.6, -0.5, 0.8, 0.7};
+    std::vector<float> past_v = {5.0, 6.0, 7.0, 8.0};
+    std::vector<int32_t> seqlens{seqlens_k};
+    std::vector<int32_t> total{4};
+
+    auto p = read_onnx("group_query_attention_test.onnx");
+    p.compile(migraphx::make_target("ref"));
+
+    migraphx::parameter_map pp;
+    pp["q"]      = migraphx::argument({migraphx::shape::float_type, {1, 2, 4}}, q.data());
+    pp["k"]      = migraphx::argument({migraphx::shape::float_type, {1, 2, 2}}, k.data());
+    pp["v"]      = migraphx::argument({migraphx::shape::float_type, {1, 2, 2}}, v.data());
+    pp["past_k"] = migraphx::argument({migraphx::shape::float_type, {1, 1, 2, 2}}, past_k.data());
+    pp["past_v"] = migraphx::argument({migraphx::shape::float_type, {1, 1, 2, 2}}, past_v.data());
+    pp["seqlens_k"] = migraphx::argument({migraphx::shape::int32_type, {1}}, seqlens.data());
+    pp["total"]     = migraphx::argument({migraphx::shape::int32_type}, total.data());
+    auto result     = p.eval(pp).front();
+    std::vector<float> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    // Keys are the past followed by the new ones, and query i sees the valid past and the new
+    // keys up to itself
+    std::vector<float> keys(past_k);
+    keys.insert(keys.end(), k.begin(), k.end());
+    std::vector<float> values(past_v);
+    values.insert(values.end(), v.begin(), v.end());
+    std::size_t valid_past = seqlens_k + 1 - 2;
+    const float scale      = 1.0f / std::sqrt(2.0f);
+    std::vector<float> gold(q.size());
+    for(std::size_t h = 0; h < 2; ++h)
+    {
+        for(std::size_t i = 0; i < 2; ++i)
+        {
+            std::vector<float> w(4, 0.0f);
+            for(std::size_t j = 0; j < 4; ++j)
+            {
+                if(j < 2 ? j >= valid_past : j > 2 + i)
+                    continue;
+                float dot = q[i * 4 + h * 2] * keys[j * 2] + q[i * 4 + h * 2 + 1] * keys[j * 2 + 1];
+                w[j] = std::exp(dot * scale);
+            }
+            auto sum = std::accumulate(w.begin(), w.end(), 0.0f);
+            for(std::size_t e = 0; e < 2; ++e)
+            {
+                float out = 0;
+                for(std::size_t j = 0; j < 4; ++j)
+                    out += w[j] / sum * values[j * 2 + e];
+                gold[i * 4 + h * 2 + e] = out;
+            }
+        }
+    }
+    EXPECT(migraphx::verify::verify_rms_range(result_vector, gold));
+}
+
+TEST_CASE(group_query_attention_test) { verify_group_query_attention(3); }
+
+TEST_CASE(group_query_attention_partial_past_test) { verify_group_query_attention(2); }
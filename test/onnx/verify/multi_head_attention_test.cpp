@@ -0,0 +1,77 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <onnx_test.hpp>
+#include <cmath>
+#include <numeric>
+
+TEST_CASE(multi_head_attention_causal_test)
+{
+    // batch 1, sequence 3, 2 heads of size 2
+    std::vector<float> q = {0.1, -0.2, 0.3, 0.4, 0.5, 0.6, -0.7, 0.8, 0.9, 1.0, -1.1, 1.2};
+    std::vector<float> k = {0.2, 0.1, -0.4, 0.3, 0.6, -0.5, 0.8, 0.7, -1.0, 0.9, 1.2, 1.1};
+    std::vector<float> v = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0};
+
+    auto p = read_onnx("multi_head_attention_causal_test.onnx");
+    p.compile(migraphx::make_target("ref"));
+
+    migraphx::shape s{migraphx::shape::float_type, {1, 3, 4}};
+    migraphx::parameter_map pp;
+    pp["q"]     = migraphx::argument(s, q.data());
+    pp["k"]     = migraphx::argument(s, k.data());
+    pp["v"]     = migraphx::argument(s, v.data());
+    auto result = p.eval(pp).front();
+    std::vector<float> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    const std::size_t seq = 3;
+    const std::size_t d   = 2;
+    const float scale     = 1.0f / std::sqrt(2.0f);
+    std::vector<float> gold(q.size());
+    for(std::size_t h = 0; h < 2; ++h)
+    {
+        for(std::size_t i = 0; i < seq; ++i)
+        {
+            std::vector<float> w(i + 1);
+            for(std::size_t j = 0; j <= i; ++j)
+            {
+                float dot = 0;
+                for(std::size_t e = 0; e < d; ++e)
+                    dot += q[i * 4 + h * d + e] * k[j * 4 + h * d + e];
+                w[j] = std::exp(dot * scale);
+            }
+            auto sum = std::accumulate(w.begin(), w.end(), 0.0f);
+            for(std::size_t e = 0; e < d; ++e)
+            {
+                float out = 0;
+                for(std::size_t j = 0; j <= i; ++j)
+                    out += w[j] / sum * v[j * 4 + h * d + e];
+                gold[i * 4 + h * d + e] = out;
+            }
+        }
+    }
+    EXPECT(migraphx::verify::verify_rms_range(result_vector, gold));
+}
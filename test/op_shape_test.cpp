@@ -82,6 +82,32 @@ void throws_shape(const migraphx::shape&, Ts...)
                   "An expected shape should not be passed to throws_shape function");
 }
 
+TEST_CASE(all_gather_shape)
+{
+    migraphx::shape sx{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape sy{migraphx::shape::float_type, {4, 4}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {4, 16}},
+                 migraphx::make_op("all_gather", {{"axis", 1}}),
+                 sx,
+                 sx);
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {4, 12}},
+                 migraphx::make_op("all_gather", {{"axis", 1}}),
+                 sx,
+                 sy);
+    throws_shape(migraphx::make_op("all_gather", {{"axis", 0}}), sx, sy);
+    throws_shape(migraphx::make_op("all_gather", {{"axis", 2}}), sx, sx);
+}
+
+TEST_CASE(all_reduce_shape)
+{
+    migraphx::shape sx{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape sy{migraphx::shape::float_type, {4, 4}};
+    migraphx::shape sb{migraphx::shape::float_type, {4, 8}, {0, 1}};
+    expect_shape(sx, migraphx::make_op("all_reduce"), sx, sx, sx);
+    expect_shape(sx, migraphx::make_op("all_reduce"), sx, sb);
+    throws_shape(migraphx::make_op("all_reduce"), sx, sy);
+}
+
 TEST_CASE(allocate_static)
 {
     migraphx::shape out_shape{migraphx::shape::float_type, {2, 3, 4}};
@@ -1294,6 +1320,43 @@ TEST_CASE(get_tuple_elem_test)
     throws_shape(migraphx::make_op("get_tuple_elem", {{"index", 0}}), s2);
 }
 
+TEST_CASE(gridsample_shape)
+{
+    migraphx::shape x{migraphx::shape::float_type, {2, 3, 8, 8}};
+    migraphx::shape grid{migraphx::shape::float_type, {2, 4, 5, 2}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {2, 3, 4, 5}},
+                 migraphx::make_op("gridsample", {{"mode", "cubic"}}),
+                 x,
+                 grid);
+
+    migraphx::shape xi{migraphx::shape::int32_type, {2, 3, 8, 8}};
+    migraphx::shape grid_half{migraphx::shape::half_type, {2, 4, 5, 2}};
+    expect_shape(migraphx::shape{migraphx::shape::int32_type, {2, 3, 4, 5}},
+                 migraphx::make_op("gridsample"),
+                 xi,
+                 grid_half);
+}
+
+TEST_CASE(gridsample_shape_errors)
+{
+    migraphx::shape x{migraphx::shape::float_type, {2, 3, 8, 8}};
+    migraphx::shape grid{migraphx::shape::float_type, {2, 4, 5, 2}};
+    throws_shape(migraphx::make_op("gridsample"),
+                 x,
+                 migraphx::shape{migraphx::shape::int32_type, {2, 4, 5, 2}});
+    throws_shape(migraphx::make_op("gridsample"),
+                 x,
+                 migraphx::shape{migraphx::shape::float_type, {1, 4, 5, 2}});
+    throws_shape(migraphx::make_op("gridsample"),
+                 x,
+                 migraphx::shape{migraphx::shape::float_type, {2, 4, 5, 3}});
+    throws_shape(migraphx::make_op("gridsample"),
+                 migraphx::shape{migraphx::shape::float_type, {2, 3, 8, 8, 8}},
+                 migraphx::shape{migraphx::shape::float_type, {2, 4, 5, 6, 3}});
+    throws_shape(migraphx::make_op("gridsample", {{"mode", "area"}}), x, grid);
+    throws_shape(migraphx::make_op("gridsample", {{"padding_mode", "edge"}}), x, grid);
+}
+
 TEST_CASE(gru)
 {
     {
@@ -3588,6 +3651,38 @@ TEST_CASE(reshape_lazy_non_fixed_not_matching_error)
     throws_shape(migraphx::make_op("reshape_lazy", {{"dims", new_shape}}), input);
 }
 
+TEST_CASE(image_preprocess_shape)
+{
+    migraphx::shape input{migraphx::shape::uint8_type, {2, 480, 640, 3}};
+    expect_shape(migraphx::shape{migraphx::shape::half_type, {2, 3, 224, 224}},
+                 migraphx::make_op("image_preprocess",
+                                   {{"sizes", {224, 224}},
+                                    {"scales", {224.0 / 480, 224.0 / 640}},
+                                    {"mode", "linear"},
+                                    {"mean", {0.5, 0.5, 0.5}},
+                                    {"type", migraphx::shape::half_type}}),
+                 input);
+}
+
+TEST_CASE(image_preprocess_shape_errors)
+{
+    migraphx::value v = {{"sizes", {4, 4}}, {"scales", {2, 2}}};
+    throws_shape(migraphx::make_op("image_preprocess", v),
+                 migraphx::shape{migraphx::shape::float_type, {1, 2, 2, 3}});
+    throws_shape(migraphx::make_op("image_preprocess", v),
+                 migraphx::shape{migraphx::shape::uint8_type, {2, 2, 3}});
+    throws_shape(migraphx::make_op("image_preprocess", {{"sizes", {4}}, {"scales", {2}}}),
+                 migraphx::shape{migraphx::shape::uint8_type, {1, 2, 2, 3}});
+    throws_shape(
+        migraphx::make_op("image_preprocess",
+                          {{"sizes", {4, 4}}, {"scales", {2, 2}}, {"mode", "cubic"}}),
+        migraphx::shape{migraphx::shape::uint8_type, {1, 2, 2, 3}});
+    throws_shape(
+        migraphx::make_op("image_preprocess",
+                          {{"sizes", {4, 4}}, {"scales", {2, 2}}, {"mean", {0.5, 0.5}}}),
+        migraphx::shape{migraphx::shape::uint8_type, {1, 2, 2, 3}});
+}
+
 TEST_CASE(resize_single_input)
 {
     migraphx::shape input{migraphx::shape::float_type, {4, 16}, {32, 2}};
@@ -3614,6 +3709,18 @@ TEST_CASE(resize_single_scale_input)
                  input);
 }
 
+TEST_CASE(resize_single_input_cubic)
+{
+    migraphx::shape input{migraphx::shape::half_type, {1, 3, 4, 4}};
+    migraphx::shape output{migraphx::shape::half_type, {1, 3, 8, 8}};
+    expect_shape(output,
+                 migraphx::make_op("resize",
+                                   {{"scales", {1, 1, 2, 2}},
+                                    {"mode", "cubic"},
+                                    {"coordinate_transformation_mode", "half_pixel"}}),
+                 input);
+}
+
 TEST_CASE(resize_single_input_err1)
 {
     // doesn't have either sizes or scales attribute
@@ -5146,6 +5253,28 @@ TEST_CASE(where_dyn_input3)
     throws_shape(migraphx::make_op("where"), s3, s1, s2);
 }
 
+TEST_CASE(rotary_embedding_shape)
+{
+    migraphx::shape input{migraphx::shape::half_type, {1, 8, 16, 64}};
+    migraphx::shape table{migraphx::shape::half_type, {1, 8, 16, 64}, {0, 0, 64, 1}};
+    expect_shape(migraphx::shape{migraphx::shape::half_type, {1, 8, 16, 64}},
+                 migraphx::make_op("rotary_embedding"),
+                 input,
+                 table,
+                 table);
+}
+
+TEST_CASE(rotary_embedding_shape_errors)
+{
+    migraphx::shape input{migraphx::shape::float_type, {2, 4, 7}};
+    throws_shape(migraphx::make_op("rotary_embedding"), input, input, input);
+    migraphx::shape even{migraphx::shape::float_type, {2, 4, 8}};
+    migraphx::shape table{migraphx::shape::float_type, {4, 8}};
+    throws_shape(migraphx::make_op("rotary_embedding"), even, table, table);
+    migraphx::shape half_table{migraphx::shape::half_type, {2, 4, 8}};
+    throws_shape(migraphx::make_op("rotary_embedding"), even, half_table, half_table);
+}
+
 TEST_CASE(roialign_test)
 {
     migraphx::shape sx{migraphx::shape::float_type, {3, 4, 5, 6}};
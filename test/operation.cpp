@@ -24,6 +24,7 @@
 
 #include <migraphx/operation.hpp>
 #include <migraphx/context.hpp>
+#include <migraphx/make_op.hpp>
 #include <sstream>
 #include <string>
 #include "test.hpp"
@@ -270,4 +271,32 @@ TEST_CASE(compile_non_compilable)
     EXPECT(v.empty());
 }
 
+TEST_CASE(flops_default)
+{
+    migraphx::operation op = simple_operation{};
+    EXPECT(op.flops({migraphx::shape{migraphx::shape::float_type, {4, 8}}}) == 0);
+}
+
+TEST_CASE(flops_pointwise)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    EXPECT(migraphx::make_op("add").flops({s, s}) == 32);
+    EXPECT(migraphx::make_op("reduce_sum", {{"axes", {1}}}).flops({s}) == 32);
+}
+
+TEST_CASE(flops_dot)
+{
+    migraphx::shape a{migraphx::shape::float_type, {2, 4, 8}};
+    migraphx::shape b{migraphx::shape::float_type, {2, 8, 16}};
+    EXPECT(migraphx::make_op("dot").flops({a, b}) == 2 * 2 * 4 * 8 * 16);
+}
+
+TEST_CASE(flops_convolution)
+{
+    migraphx::shape x{migraphx::shape::float_type, {1, 3, 8, 8}};
+    migraphx::shape w{migraphx::shape::float_type, {4, 3, 3, 3}};
+    // 6x6 outputs for each of the 4 channels, with 27 weights each
+    EXPECT(migraphx::make_op("convolution").flops({x, w}) == 2 * 4 * 6 * 6 * 27);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -30,6 +30,7 @@
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/serialize.hpp>
 #include <test.hpp>
@@ -182,4 +183,37 @@ TEST_CASE(mul_add_transpose_dot)
     EXPECT(m1.sort() == m2.sort());
 }
 
+TEST_CASE(pass_stats)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    {
+        migraphx::shape s{migraphx::shape::float_type};
+        auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {2, 3}});
+        auto one = mm->add_literal(migraphx::literal{s, {1}});
+        auto two = mm->add_literal(migraphx::literal{s, {2}});
+        auto sum = mm->add_instruction(migraphx::make_op("add"), one, two);
+        auto mb =
+            mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", {2, 3}}}), sum);
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, mb);
+        mm->add_return({add});
+    }
+    migraphx::tracer trace;
+    trace.record_pass_stats();
+    migraphx::run_passes(p, {migraphx::optimize_module{}}, trace);
+    auto stats = trace.get_pass_stats();
+    auto opt   = std::find_if(stats.begin(), stats.end(), [](const auto& ps) {
+        return ps.name == "optimize_module" and not ps.module.empty();
+    });
+    EXPECT(bool{opt != stats.end()});
+    EXPECT(opt->module == "main");
+    EXPECT(opt->depth == 0);
+    EXPECT(opt->instructions_before == 7);
+    EXPECT(opt->instructions_after == mm->size());
+    EXPECT(opt->instructions_after < opt->instructions_before);
+    EXPECT(std::any_of(stats.begin(), stats.end(), [](const auto& ps) {
+        return ps.name == "simplify_algebra" and ps.depth == 1;
+    }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
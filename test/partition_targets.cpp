@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/partition_targets.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <test.hpp>
+
+using target_segments = std::vector<std::pair<std::string, migraphx::supported_segments>>;
+
+static migraphx::assignment_options copy_cost(double cost)
+{
+    migraphx::assignment_options options;
+    options.copy_cost = cost;
+    return options;
+}
+
+struct chain
+{
+    migraphx::module m;
+    migraphx::instruction_ref x;
+    migraphx::instruction_ref add;
+    migraphx::instruction_ref mul;
+    migraphx::instruction_ref relu;
+
+    chain()
+    {
+        migraphx::shape s{migraphx::shape::float_type, {2, 2}};
+        x    = m.add_parameter("x", s);
+        add  = m.add_instruction(migraphx::make_op("add"), x, x);
+        mul  = m.add_instruction(migraphx::make_op("mul"), add, add);
+        relu = m.add_instruction(migraphx::make_op("relu"), mul);
+        m.add_return({relu});
+    }
+};
+
+TEST_CASE(keep_single_target)
+{
+    chain c;
+    target_segments ts = {{"cpu", {{{c.x, c.add, c.mul, c.relu}, 4}}}};
+    auto a = migraphx::partition_targets(&c.m, ts, copy_cost(0));
+    EXPECT(a.size() == 4);
+    EXPECT(migraphx::all_of(a, [](const auto& p) { return p.second == "cpu"; }));
+}
+
+TEST_CASE(copy_cost_keeps_target)
+{
+    chain c;
+    // Moving add and mul saves 1.8 but the two copies of 16 bytes cost 32
+    target_segments ts = {{"cpu", {{{c.x, c.add, c.mul, c.relu}, 4}}},
+                          {"gpu", {{{c.add, c.mul}, 0.2}}}};
+    auto a = migraphx::partition_targets(&c.m, ts, copy_cost(1));
+    EXPECT(a.size() == 4);
+    EXPECT(migraphx::all_of(a, [](const auto& p) { return p.second == "cpu"; }));
+}
+
+TEST_CASE(cheap_copy_moves_segment)
+{
+    chain c;
+    target_segments ts = {{"cpu", {{{c.x, c.add, c.mul, c.relu}, 4}}},
+                          {"gpu", {{{c.add, c.mul}, 0.2}}}};
+    auto a = migraphx::partition_targets(&c.m, ts, copy_cost(0.001));
+    EXPECT(a.at(c.x) == "cpu");
+    EXPECT(a.at(c.add) == "gpu");
+    EXPECT(a.at(c.mul) == "gpu");
+    EXPECT(a.at(c.relu) == "cpu");
+}
+
+TEST_CASE(copy_cost_moves_neighbour)
+{
+    chain c;
+    // relu is slightly slower on the gpu, but running it there saves a copy back
+    target_segments ts = {{"cpu", {{{c.x, c.add, c.mul, c.relu}, 4}}},
+                          {"gpu", {{{c.add, c.mul}, 0.2}, {{c.relu}, 1.1}}}};
+    auto a = migraphx::partition_targets(&c.m, ts, copy_cost(0.01));
+    EXPECT(a.at(c.x) == "cpu");
+    EXPECT(a.at(c.add) == "gpu");
+    EXPECT(a.at(c.mul) == "gpu");
+    EXPECT(a.at(c.relu) == "gpu");
+}
+
+TEST_CASE(three_targets)
+{
+    chain c;
+    target_segments ts = {{"cpu", {{{c.x, c.add, c.mul, c.relu}, 4}}},
+                          {"gpu", {{{c.add, c.mul}, 0.2}}},
+                          {"fpga", {{{c.relu}, 0.1}}}};
+    auto a = migraphx::partition_targets(&c.m, ts, copy_cost(0.001));
+    EXPECT(a.at(c.x) == "cpu");
+    EXPECT(a.at(c.add) == "gpu");
+    EXPECT(a.at(c.mul) == "gpu");
+    EXPECT(a.at(c.relu) == "fpga");
+}
+
+TEST_CASE(unsupported_unassigned)
+{
+    chain c;
+    target_segments ts = {{"cpu", {{{c.add, c.mul}, 2}}}, {"gpu", {{{c.mul}, 0.5}}}};
+    auto a = migraphx::partition_targets(&c.m, ts, copy_cost(0.001));
+    EXPECT(a.size() == 2);
+    EXPECT(not migraphx::contains(a, c.x));
+    EXPECT(not migraphx::contains(a, c.relu));
+    EXPECT(a.at(c.add) == "cpu");
+    EXPECT(a.at(c.mul) == "gpu");
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -24,9 +24,30 @@
 #include <migraphx/program.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
 #include <migraphx/register_target.hpp>
 #include "test.hpp"
 
+// Reports a counter like a kernel compiled with MIGRAPHX_PERF_COUNTERS
+struct counters_op
+{
+    std::string name() const { return "counters"; }
+    migraphx::value attributes() const
+    {
+        migraphx::value counters = {{"occupancy", 50}};
+        return {{"counters", counters}};
+    }
+    migraphx::argument
+    compute(migraphx::context&, const migraphx::shape&, std::vector<migraphx::argument> args) const
+    {
+        return args.front();
+    }
+    migraphx::shape compute_shape(std::vector<migraphx::shape> inputs) const
+    {
+        return inputs.front();
+    }
+};
+
 TEST_CASE(perf_report)
 {
     migraphx::program p;
@@ -50,4 +71,45 @@ TEST_CASE(perf_report)
     EXPECT(not migraphx::contains(output, "fast"));
 }
 
+TEST_CASE(perf_report_roofline)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::stringstream ss;
+    migraphx::shape s{migraphx::shape::float_type, {16, 16}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+    mm->add_instruction(migraphx::make_op("dot"), x, y);
+    p.compile(migraphx::make_target("ref"));
+    migraphx::parameter_map m;
+    m["x"] = migraphx::fill_argument(s, 1);
+    m["y"] = migraphx::fill_argument(s, 1);
+    p.perf_report(ss, 2, m);
+
+    std::string output = ss.str();
+    EXPECT(migraphx::contains(output, "GB/s"));
+    EXPECT(migraphx::contains(output, "TFLOPs"));
+    // The ref target has no peaks to compare with
+    EXPECT(not migraphx::contains(output, "roofline"));
+}
+
+TEST_CASE(perf_report_counters)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::stringstream ss;
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    auto x = mm->add_parameter("x", s);
+    mm->add_instruction(counters_op{}, x);
+    p.compile(migraphx::make_target("ref"));
+    p.perf_report(ss, 2, {{"x", migraphx::fill_argument(s, 1)}});
+
+    std::string output = ss.str();
+    // Printed for the instruction and averaged for its group in the summary
+    EXPECT(migraphx::contains(output, "occupancy: 50"));
+    EXPECT(output.find("occupancy: 50") != output.rfind("occupancy: 50"));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
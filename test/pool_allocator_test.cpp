@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/pool_allocator.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <list>
+#include <test.hpp>
+
+TEST_CASE(reuse_nodes)
+{
+    migraphx::node_pool pool;
+    auto* x = pool.allocate(24);
+    auto* y = pool.allocate(24);
+    EXPECT(x != y);
+    EXPECT(pool.capacity() > 0);
+    pool.deallocate(x, 24);
+    // Freed nodes of the same size are handed out again
+    EXPECT(pool.allocate(20) == x);
+    pool.deallocate(y, 24);
+    pool.deallocate(x, 24);
+}
+
+TEST_CASE(large_nodes)
+{
+    migraphx::node_pool pool;
+    auto* x = pool.allocate(migraphx::node_pool::max_size + 1);
+    EXPECT(x != nullptr);
+    EXPECT(pool.capacity() == 0);
+    pool.deallocate(x, migraphx::node_pool::max_size + 1);
+}
+
+TEST_CASE(list_copy)
+{
+    std::list<int, migraphx::pool_allocator<int>> x = {1, 2, 3};
+    auto y = x;
+    // Copies do not share the pool
+    EXPECT(bool{x.get_allocator() != y.get_allocator()});
+    x.clear();
+    x.push_back(4);
+    EXPECT(y == std::list<int, migraphx::pool_allocator<int>>{1, 2, 3});
+    std::list<int, migraphx::pool_allocator<int>> z = std::move(x);
+    EXPECT(z.front() == 4);
+    EXPECT(bool{x.get_allocator() == z.get_allocator()});
+}
+
+TEST_CASE(module_rewrite)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    migraphx::module m;
+    auto x   = m.add_parameter("x", s);
+    auto ins = x;
+    for(int i = 0; i < 100; i++)
+        ins = m.add_instruction(migraphx::make_op("relu"), ins);
+    m.add_return({ins});
+    // Replacing instructions reuses the nodes of the removed ones
+    for(int i = 0; i < 10; i++)
+    {
+        auto relu = std::next(x);
+        auto abs  = m.insert_instruction(relu, migraphx::make_op("abs"), relu->inputs());
+        m.replace_instruction(relu, abs);
+        m.remove_instruction(relu);
+    }
+    EXPECT(m.size() == 102);
+    auto m2 = m;
+    EXPECT(m2.size() == 102);
+    EXPECT(m2 == m);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
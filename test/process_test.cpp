@@ -40,6 +40,7 @@
 
 #ifndef _WIN32
 #include <cstring>
+#include <unistd.h>
 #else
 #include <io.h>
 #include <fcntl.h>
@@ -163,6 +164,32 @@ TEST_CASE(environment_variable)
     EXPECT(buffer == reversed);
 }
 
+#ifndef _WIN32
+TEST_CASE(start_send_receive)
+{
+    migraphx::process p{executable, {"--echo"}};
+    p.start();
+    for(int i = 0; i < 3; i++)
+    {
+        p.send(string_data.data(), string_data.size());
+        std::string buffer(string_data.size(), '\0');
+        p.receive(buffer.data(), buffer.size());
+        EXPECT(buffer == string_data);
+    }
+    p.stop();
+}
+
+TEST_CASE(receive_after_exit)
+{
+    migraphx::process p{executable, {"--stdout"}};
+    p.start();
+    std::string buffer(string_data.size(), '\0');
+    p.receive(buffer.data(), buffer.size());
+    EXPECT(buffer == string_data);
+    EXPECT(test::throws([&] { p.receive(buffer.data(), 1); }));
+}
+#endif
+
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_PROCESS_TEST_ENVIRONMENT_VARIABLE)
 
 int main(int argc, const char* argv[])
@@ -183,6 +210,19 @@ int main(int argc, const char* argv[])
             std::fwrite(result.data(), 1, result.size(), stdout);
             return 0;
         }
+#ifndef _WIN32
+        if(arg == "--echo")
+        {
+            std::array<char, 1024> buffer{};
+            ssize_t len = 0;
+            while((len = ::read(STDIN_FILENO, buffer.data(), buffer.size())) > 0)
+            {
+                if(::write(STDOUT_FILENO, buffer.data(), len) != len)
+                    return 1;
+            }
+            return 0;
+        }
+#endif
     }
     else
     {
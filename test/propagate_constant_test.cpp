@@ -25,7 +25,9 @@
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/tmp_dir.hpp>
 #include <basic_ops.hpp>
 
 #include <test.hpp>
@@ -535,4 +537,77 @@ TEST_CASE(block_dequantize_int4)
     EXPECT(m1.sort() == m2.sort());
 }
 
+TEST_CASE(const_shared_subgraph)
+{
+    migraphx::module m1;
+    {
+        auto one  = m1.add_literal(1);
+        auto two  = m1.add_literal(2);
+        auto sum  = m1.add_instruction(migraphx::make_op("add"), one, two);
+        auto mul1 = m1.add_instruction(migraphx::make_op("mul"), sum, two);
+        auto mul2 = m1.add_instruction(migraphx::make_op("mul"), sum, sum);
+        m1.add_instruction(non_const_pass_op{}, sum, mul1, mul2);
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto sum  = m2.add_literal(3);
+        auto mul1 = m2.add_literal(6);
+        auto mul2 = m2.add_literal(9);
+        m2.add_instruction(non_const_pass_op{}, sum, mul1, mul2);
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(const_fold_cache)
+{
+    migraphx::tmp_dir td{};
+    migraphx::shape s{migraphx::shape::float_type, {128, 256}};
+    auto x      = migraphx::generate_literal(s);
+    auto create = [&] {
+        migraphx::module m;
+        auto lit = m.add_literal(x);
+        auto t = m.add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), lit);
+        auto c = m.add_instruction(migraphx::make_op("contiguous"), t);
+        m.add_instruction(non_const_pass_op{}, c);
+        return m;
+    };
+    auto entries = [&] {
+        return std::distance(migraphx::fs::directory_iterator(td.path),
+                             migraphx::fs::directory_iterator());
+    };
+
+    auto m1 = create();
+    migraphx::run_passes(
+        m1,
+        {migraphx::propagate_constant{{}, td.path.string()}, migraphx::dead_code_elimination{}});
+    EXPECT(entries() == 1);
+
+    auto m2 = create();
+    migraphx::run_passes(
+        m2,
+        {migraphx::propagate_constant{{}, td.path.string()}, migraphx::dead_code_elimination{}});
+    EXPECT(entries() == 1);
+    EXPECT(m1 == m2);
+    EXPECT(std::none_of(m2.begin(), m2.end(), [](const auto& ins) {
+        return ins.name() == "contiguous";
+    }));
+}
+
+TEST_CASE(const_random_seed)
+{
+    migraphx::module m1;
+    {
+        migraphx::shape s{migraphx::shape::float_type, {4}};
+        auto buffer = m1.add_literal(migraphx::literal{s, {0, 0, 0, 0}});
+        auto seed   = m1.add_instruction(migraphx::make_op("random_seed"));
+        auto r      = m1.add_instruction(migraphx::make_op("random_uniform"), seed, buffer);
+        m1.add_return({r});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
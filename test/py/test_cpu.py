@@ -21,7 +21,7 @@
 # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 # THE SOFTWARE.
 #####################################################################################
-import migraphx, array, sys
+import migraphx, array, sys, asyncio
 
 
 def test_conv_relu():
@@ -76,6 +76,61 @@ def test_add_scalar():
     print(r)
 
 
+def test_run_async():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    params = {}
+    for key, value in p.get_parameter_shapes().items():
+        params[key] = migraphx.generate_argument(value)
+
+    expected = p.run(params)[-1]
+    futures = [p.create_session().run_async(params) for i in range(4)]
+    for f in futures:
+        assert f.result()[-1] == expected
+
+    async def run():
+        return await asyncio.wrap_future(p.run_async(params))
+
+    assert asyncio.run(run())[-1] == expected
+
+
+def test_run_many():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    requests = []
+    for i in range(5):
+        params = {}
+        for key, value in p.get_parameter_shapes().items():
+            params[key] = migraphx.generate_argument(value, i)
+        requests.append(params)
+
+    expected = [p.run(params)[-1] for params in requests]
+    results = p.run_many(requests, depth=3)
+    assert [r[-1] for r in results] == expected
+
+    completed = {}
+
+    def on_result(i, r):
+        completed[i] = r[-1]
+
+    p.run_many(requests, callback=on_result)
+    assert [completed[i] for i in range(len(requests))] == expected
+
+
+def test_metrics():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    params = {}
+    for key, value in p.get_parameter_shapes().items():
+        params[key] = migraphx.generate_argument(value)
+
+    migraphx.reset_metrics()
+    p.run(params)
+    metrics = migraphx.get_metrics()
+    assert metrics["eval"] == 1
+    assert metrics["eval_latency_us.count"] == 1
+
+
 def test_module():
     p = migraphx.parse_onnx("add_scalar_test.onnx")
     mm = p.get_main_module()
@@ -84,6 +139,10 @@ def test_module():
 
 
 test_conv_relu()
+test_run_many()
+test_metrics()
 test_module()
 if sys.version_info >= (3, 0):
     test_add_scalar()
+if sys.version_info >= (3, 7):
+    test_run_async()
@@ -0,0 +1,72 @@
+#####################################################################################
+# The MIT License (MIT)
+#
+# Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#####################################################################################
+import migraphx
+
+
+def create_argument(data, lens):
+    return migraphx.create_argument(migraphx.shape(type="float", lens=lens),
+                                    data)
+
+
+# Only exposes the DLPack protocol, like tensors from other frameworks
+class dlpack_tensor:
+    def __init__(self, arg):
+        self.arg = arg
+
+    def __dlpack__(self, stream=None):
+        return self.arg.__dlpack__(stream=stream)
+
+    def __dlpack_device__(self):
+        return self.arg.__dlpack_device__()
+
+
+def test_roundtrip():
+    a = create_argument(list(range(6)), [2, 3])
+    assert a.__dlpack_device__() == (1, 0)
+    for x in [a, a.__dlpack__(), dlpack_tensor(a)]:
+        b = migraphx.from_dlpack(x)
+        assert b.get_shape() == a.get_shape()
+        assert b.data_ptr() == a.data_ptr()
+        assert b.tolist() == a.tolist()
+
+
+def test_run():
+    p = migraphx.program()
+    mm = p.get_main_module()
+    s = migraphx.shape(type="float", lens=[2, 3])
+    x = mm.add_parameter("x", s)
+    y = mm.add_parameter("y", s)
+    mm.add_return([mm.add_instruction(migraphx.op("add"), [x, y])])
+    p.compile(migraphx.get_target("ref"))
+
+    a = create_argument(list(range(6)), [2, 3])
+    b = create_argument([1] * 6, [2, 3])
+    r = p.run({"x": dlpack_tensor(a), "y": b})[-1]
+    assert r.tolist() == [float(i + 1) for i in range(6)]
+    assert migraphx.from_dlpack(r).tolist() == r.tolist()
+
+
+if __name__ == "__main__":
+    test_roundtrip()
+    test_run()
@@ -40,6 +40,21 @@ def test_conv_relu():
     print(r)
 
 
+def test_dlpack():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("gpu"), offload_copy=False)
+    params = {}
+    for key, value in p.get_parameter_shapes().items():
+        params[key] = migraphx.from_dlpack(
+            migraphx.to_gpu(migraphx.generate_argument(value)))
+
+    r = p.run(params)[-1]
+    assert r.__dlpack_device__()[0] == 10
+    d = migraphx.from_dlpack(r)
+    assert d.data_ptr() == r.data_ptr()
+    assert migraphx.from_gpu(d) == migraphx.from_gpu(r)
+
+
 # TODO: placeholder until tuple shapes and arguments exposed
 #def test_dyn_batch():
 #    a = migraphx.shape.dynamic_dimension(1, 4, {2, 4})
@@ -73,3 +88,4 @@ def test_conv_relu():
 #    run_prog(4)
 
 test_conv_relu()
+test_dlpack()
@@ -130,6 +130,59 @@ TEST_CASE(param_add)
     }
 }
 
+TEST_CASE(param_add_bf16)
+{
+    auto create_program_float = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+        auto p1  = mm->add_parameter("x", s);
+        auto p2  = mm->add_parameter("y", s);
+        auto sum = mm->add_instruction(migraphx::make_op("add"), p1, p2);
+        mm->add_return({sum});
+        return p;
+    };
+
+    auto create_program_bf16 = [] {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+        auto p1  = mm->add_parameter("x", s);
+        auto p2  = mm->add_parameter("y", s);
+        auto bp1 = mm->add_instruction(
+            migraphx::make_op("convert",
+                              {{"target_type", migraphx::to_value(migraphx::shape::bf16_type)}}),
+            p1);
+        auto bp2 = mm->add_instruction(
+            migraphx::make_op("convert",
+                              {{"target_type", migraphx::to_value(migraphx::shape::bf16_type)}}),
+            p2);
+        auto bs = mm->add_instruction(migraphx::make_op("add"), bp1, bp2);
+        auto fs = mm->add_instruction(
+            migraphx::make_op("convert",
+                              {{"target_type", migraphx::to_value(migraphx::shape::float_type)}}),
+            bs);
+        mm->add_return({fs});
+        return p;
+    };
+
+    {
+        auto p1 = create_program_float();
+        auto p2 = create_program_bf16();
+
+        migraphx::quantize_bf16(p1);
+        EXPECT(p1 == p2);
+    }
+
+    {
+        auto p1 = create_program_float();
+        auto p2 = create_program_bf16();
+
+        migraphx::quantize_bf16(p1, {"add"});
+        EXPECT(p1 == p2);
+    }
+}
+
 TEST_CASE(param_add_sub)
 {
     auto create_program_float = [] {
@@ -1356,4 +1409,201 @@ TEST_CASE(test_op_capture)
     EXPECT(migraphx::verify::verify_rms_range(vec, cap_vec));
 }
 
+static migraphx::program create_dot_weights_program(std::size_t rows = 2)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sa{migraphx::shape::float_type, {rows, 16}};
+    migraphx::shape sb{migraphx::shape::float_type, {16, 8}};
+    auto pa = mm->add_parameter("a", sa);
+    // Scale the columns differently so that one scale for all the weights loses precision
+    std::vector<float> wb(sb.elements());
+    auto gb = migraphx::generate_literal(sb, get_hash(std::string("b")));
+    gb.visit([&](auto g) {
+        for(std::size_t i = 0; i < wb.size(); i++)
+            wb[i] = g[i] * (1 << (i % 8));
+    });
+    auto lb  = mm->add_literal(migraphx::literal{sb, wb});
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), pa, lb);
+    mm->add_return({dot});
+    return p;
+}
+
+static std::vector<float> run_dot_weights_program(migraphx::program p,
+                                                  const migraphx::parameter_map& m,
+                                                  const migraphx::quantize_8bits_options* options)
+{
+    migraphx::target ref_t = migraphx::make_target("ref");
+    if(options != nullptr)
+        migraphx::quantize_int8(p, ref_t, {m}, {"dot", "convolution"}, *options);
+    p.compile(ref_t);
+    std::vector<float> res;
+    p.eval(m).back().visit([&](auto v) { res.assign(v.begin(), v.end()); });
+    return res;
+}
+
+static bool has_op(const migraphx::program& p, const std::string& name)
+{
+    const auto* mm = p.get_main_module();
+    return std::any_of(mm->begin(), mm->end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+TEST_CASE(int8_quantization_dot_per_channel)
+{
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {2, 16}},
+                                         get_hash(std::string("a")));
+    auto p               = create_dot_weights_program();
+    auto no_quant_result = run_dot_weights_program(p, m, nullptr);
+
+    migraphx::quantize_8bits_options options;
+    options.per_channel = true;
+    auto qp             = p;
+    migraphx::quantize_int8(qp, migraphx::make_target("ref"), {m}, {"dot", "convolution"}, options);
+    EXPECT(has_op(qp, "quant_dot"));
+
+    auto quant_result = run_dot_weights_program(p, m, &options);
+    EXPECT(migraphx::verify::verify_range_with_tolerance(
+        quant_result,
+        migraphx::verify::expected{no_quant_result},
+        migraphx::verify::tolerance{0.01}));
+}
+
+TEST_CASE(int8_quantization_dot_group)
+{
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {2, 16}},
+                                         get_hash(std::string("a")));
+    auto p               = create_dot_weights_program();
+    auto no_quant_result = run_dot_weights_program(p, m, nullptr);
+
+    migraphx::quantize_8bits_options options;
+    options.group_size = 4;
+    auto qp            = p;
+    migraphx::quantize_int8(qp, migraphx::make_target("ref"), {m}, {"dot", "convolution"}, options);
+    // The weights stay in int8 and the activations are not quantized
+    EXPECT(not has_op(qp, "quant_dot"));
+    EXPECT(not has_op(qp, "quantizelinear"));
+    EXPECT(has_op(qp, "dequantizelinear"));
+
+    auto quant_result = run_dot_weights_program(p, m, &options);
+    EXPECT(migraphx::verify::verify_range_with_tolerance(
+        quant_result,
+        migraphx::verify::expected{no_quant_result},
+        migraphx::verify::tolerance{0.01}));
+}
+
+TEST_CASE(int8_quantization_calibration_modes)
+{
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {64, 16}},
+                                         get_hash(std::string("a")));
+    auto p               = create_dot_weights_program(64);
+    auto no_quant_result = run_dot_weights_program(p, m, nullptr);
+    for(auto mode : {migraphx::calibration_mode::percentile, migraphx::calibration_mode::entropy})
+    {
+        migraphx::quantize_8bits_options options;
+        options.calibration = mode;
+        options.percentile  = 99.9f;
+        options.per_channel = true;
+        auto quant_result   = run_dot_weights_program(p, m, &options);
+        EXPECT(migraphx::verify::verify_range_with_tolerance(
+            quant_result,
+            migraphx::verify::expected{no_quant_result},
+            migraphx::verify::tolerance{0.01}));
+    }
+}
+
+TEST_CASE(int8_quantization_dot_smooth)
+{
+    // One input channel of the activations has much larger values than the others
+    migraphx::shape sa{migraphx::shape::float_type, {16, 16}};
+    std::vector<float> a(sa.elements());
+    auto ga = migraphx::generate_literal(sa, get_hash(std::string("a")));
+    ga.visit([&](auto g) {
+        for(std::size_t i = 0; i < a.size(); i++)
+            a[i] = i % 16 == 3 ? g[i] * 100 : g[i];
+    });
+    migraphx::parameter_map m;
+    m["a"] = migraphx::argument(sa, a.data());
+
+    auto p               = create_dot_weights_program(16);
+    auto no_quant_result = run_dot_weights_program(p, m, nullptr);
+
+    migraphx::quantize_8bits_options options;
+    options.per_channel = true;
+    auto quant_result   = run_dot_weights_program(p, m, &options);
+
+    options.smooth_alpha = 0.5f;
+    auto qp              = p;
+    migraphx::quantize_int8(qp, migraphx::make_target("ref"), {m}, {"dot", "convolution"}, options);
+    EXPECT(has_op(qp, "quant_dot"));
+    auto smooth_result = run_dot_weights_program(p, m, &options);
+
+    EXPECT(migraphx::verify::rms_range(smooth_result, no_quant_result) <
+           migraphx::verify::rms_range(quant_result, no_quant_result));
+}
+
+TEST_CASE(calibration_mode_names)
+{
+    EXPECT(bool{migraphx::to_calibration_mode("max") == migraphx::calibration_mode::max});
+    EXPECT(bool{migraphx::to_calibration_mode("percentile") ==
+                migraphx::calibration_mode::percentile});
+    EXPECT(bool{migraphx::to_calibration_mode("entropy") == migraphx::calibration_mode::entropy});
+    EXPECT(test::throws([] { migraphx::to_calibration_mode("minmax"); }));
+}
+
+static migraphx::program create_two_dots_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sa{migraphx::shape::float_type, {4, 16}};
+    migraphx::shape sb{migraphx::shape::float_type, {16, 16}};
+    auto pa = mm->add_parameter("a", sa);
+    auto lb = mm->add_literal(migraphx::generate_literal(sb, 1));
+    auto lc = mm->add_literal(migraphx::generate_literal(sb, 2));
+    auto d1 = mm->add_instruction(migraphx::make_op("dot"), pa, lb);
+    auto d2 = mm->add_instruction(migraphx::make_op("dot"), d1, lc);
+    mm->add_return({d2});
+    return p;
+}
+
+static std::size_t count_op(const migraphx::program& p, const std::string& name)
+{
+    const auto* mm = p.get_main_module();
+    return std::count_if(
+        mm->begin(), mm->end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+TEST_CASE(mixed_precision_within_tolerance)
+{
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {4, 16}}, 0);
+    auto p = create_two_dots_program();
+    migraphx::mixed_precision_options options;
+    options.tolerance = 1e-2;
+    auto qp           = p;
+    migraphx::quantize_mixed_precision(qp, {m}, options);
+    EXPECT(count_op(qp, "convert") > 0);
+
+    migraphx::target ref_t = migraphx::make_target("ref");
+    p.compile(ref_t);
+    qp.compile(ref_t);
+    auto expected = p.eval(m).back().to_vector<float>();
+    auto result   = qp.eval(m).back().to_vector<float>();
+    EXPECT(migraphx::verify::rms_range(result, expected) <= options.tolerance);
+}
+
+TEST_CASE(mixed_precision_zero_tolerance)
+{
+    migraphx::parameter_map m;
+    m["a"] = migraphx::generate_argument({migraphx::shape::float_type, {4, 16}}, 0);
+    auto p = create_two_dots_program();
+    migraphx::mixed_precision_options options;
+    options.tolerance = 0;
+    migraphx::quantize_mixed_precision(p, {m}, options);
+    // Any lowering changes the outputs, so everything stays in float
+    EXPECT(count_op(p, "convert") == 0);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
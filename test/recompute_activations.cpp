@@ -0,0 +1,139 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/recompute_activations.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <test.hpp>
+#include <pointwise.hpp>
+
+void run_pass(migraphx::program& p, std::size_t budget)
+{
+    migraphx::run_passes(
+        p, {migraphx::recompute_activations{budget}, migraphx::dead_code_elimination{}});
+}
+
+// A skip connection: relu(x) is read right away and again at the end
+migraphx::program create_skip_program()
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 32}};
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto x    = mm->add_parameter("x", s);
+    auto relu = add_pointwise(p, "main:pointwise0", {x}, single_pointwise("relu"));
+    auto exp  = add_pointwise(p, "main:pointwise1", {relu}, single_pointwise("exp"));
+    auto neg  = add_pointwise(p, "main:pointwise2", {exp}, single_pointwise("neg"));
+    auto add  = add_pointwise(p, "main:pointwise3", {relu, neg}, single_pointwise("add"));
+    mm->add_return({add});
+    return p;
+}
+
+TEST_CASE(skip_connection)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 32}};
+    migraphx::program p1 = create_skip_program();
+    run_pass(p1, 0);
+    migraphx::program p2;
+    {
+        auto* mm   = p2.get_main_module();
+        auto x     = mm->add_parameter("x", s);
+        auto relu  = add_pointwise(p2, "main:pointwise0", {x}, single_pointwise("relu"));
+        auto exp   = add_pointwise(p2, "main:pointwise1", {relu}, single_pointwise("exp"));
+        auto neg   = add_pointwise(p2, "main:pointwise2", {exp}, single_pointwise("neg"));
+        auto relu2 =
+            mm->add_instruction(migraphx::make_op("pointwise"), {x}, relu->module_inputs());
+        auto add   = add_pointwise(p2, "main:pointwise3", {relu2, neg}, single_pointwise("add"));
+        mm->add_return({add});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(skip_connection_within_budget)
+{
+    migraphx::program p1 = create_skip_program();
+    run_pass(p1, 1024);
+    migraphx::program p2 = create_skip_program();
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(skip_connection_view)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 32}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto relu = add_pointwise(p1, "main:pointwise0", {x}, single_pointwise("relu"));
+        auto view = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), relu);
+        auto exp  = add_pointwise(p1, "main:pointwise1", {relu}, single_pointwise("exp"));
+        auto neg  = add_pointwise(p1, "main:pointwise2", {exp}, single_pointwise("neg"));
+        auto flat = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), neg);
+        auto add  = add_pointwise(p1, "main:pointwise3", {view, flat}, single_pointwise("add"));
+        mm->add_return({add});
+    }
+    run_pass(p1, 0);
+    migraphx::program p2;
+    {
+        auto* mm   = p2.get_main_module();
+        auto x     = mm->add_parameter("x", s);
+        auto relu  = add_pointwise(p2, "main:pointwise0", {x}, single_pointwise("relu"));
+        auto exp   = add_pointwise(p2, "main:pointwise1", {relu}, single_pointwise("exp"));
+        auto neg   = add_pointwise(p2, "main:pointwise2", {exp}, single_pointwise("neg"));
+        auto flat  = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), neg);
+        auto relu2 =
+            mm->add_instruction(migraphx::make_op("pointwise"), {x}, relu->module_inputs());
+        auto view  = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), relu2);
+        auto add   = add_pointwise(p2, "main:pointwise3", {view, flat}, single_pointwise("add"));
+        mm->add_return({add});
+    }
+    EXPECT(p1 == p2);
+}
+
+// The input of the pointwise instruction isn't live at the late use, recomputing would keep it
+// live for longer
+TEST_CASE(input_not_live)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 32}};
+    auto create_program = [&] {
+        migraphx::program p;
+        auto* mm  = p.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto exp  = add_pointwise(p, "main:pointwise0", {x}, single_pointwise("exp"));
+        auto relu = add_pointwise(p, "main:pointwise1", {exp}, single_pointwise("relu"));
+        auto neg  = add_pointwise(p, "main:pointwise2", {relu}, single_pointwise("neg"));
+        auto abs  = add_pointwise(p, "main:pointwise3", {neg}, single_pointwise("abs"));
+        auto add  = add_pointwise(p, "main:pointwise4", {relu, abs}, single_pointwise("add"));
+        mm->add_return({add});
+        return p;
+    };
+    migraphx::program p1 = create_program();
+    run_pass(p1, 0);
+    migraphx::program p2 = create_program();
+    EXPECT(p1 == p2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
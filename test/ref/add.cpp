@@ -118,6 +118,40 @@ TEST_CASE(add_dyn_test)
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
 
+TEST_CASE(add_dyn_repeated_shapes_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    std::vector<migraphx::shape::dynamic_dimension> dd{{2, 6}};
+    migraphx::shape s{migraphx::shape::float_type, dd};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+    mm->add_instruction(migraphx::make_op("add"), x, y);
+    p.compile(migraphx::make_target("ref"));
+
+    auto run = [&](std::vector<float> x_data, std::vector<float> y_data) {
+        migraphx::parameter_map params;
+        migraphx::shape input_fixed_shape{migraphx::shape::float_type, {x_data.size()}};
+        params["x"] = migraphx::argument(input_fixed_shape, x_data.data());
+        params["y"] = migraphx::argument(input_fixed_shape, y_data.data());
+        auto result = p.eval(params).back();
+        EXPECT(result.get_shape() == input_fixed_shape);
+        std::vector<float> results_vector;
+        result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+        return results_vector;
+    };
+    // The output shape resolved for the first call is reused, then resolved again when the
+    // input shapes change
+    std::vector<float> gold0 = {0, 2, 4};
+    EXPECT(migraphx::verify::verify_rms_range(run({-1, 0, 1}, {1, 2, 3}), gold0));
+    std::vector<float> gold1 = {2, 3, 4};
+    EXPECT(migraphx::verify::verify_rms_range(run({1, 1, 1}, {1, 2, 3}), gold1));
+    std::vector<float> gold2 = {2, 3, 4, 5, 6};
+    EXPECT(migraphx::verify::verify_rms_range(run({1, 2, 3, 4, 5}, {1, 1, 1, 1, 1}), gold2));
+    std::vector<float> gold3 = {4, 6};
+    EXPECT(migraphx::verify::verify_rms_range(run({1, 2}, {3, 4}), gold3));
+}
+
 TEST_CASE(fp16_test)
 {
     migraphx::program p;
@@ -0,0 +1,85 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+static std::vector<migraphx::argument> run_beam_step(const std::vector<float>& logprobs,
+                                                     const std::vector<float>& scores,
+                                                     std::size_t beams)
+{
+    migraphx::program p;
+    auto* mm          = p.get_main_module();
+    std::size_t vocab = logprobs.size() / scores.size();
+    std::size_t batch = scores.size() / beams;
+    migraphx::shape ls{migraphx::shape::float_type, {batch, beams, vocab}};
+    migraphx::shape ss{migraphx::shape::float_type, {batch, beams}};
+    auto l = mm->add_literal(migraphx::literal{ls, logprobs});
+    auto s = mm->add_literal(migraphx::literal{ss, scores});
+    auto r = mm->add_instruction(migraphx::make_op("beam_step"), l, s);
+    std::vector<migraphx::instruction_ref> outputs;
+    for(auto i : {0, 1, 2})
+        outputs.push_back(
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", i}}), r));
+    mm->add_return(outputs);
+    p.compile(migraphx::make_target("ref"));
+    return p.eval({});
+}
+
+TEST_CASE(beam_step_test)
+{
+    std::vector<float> logprobs = {-1, -2, -0.5, -0.25, -3, -0.75};
+    auto results                = run_beam_step(logprobs, {-1, -0.5}, 2);
+    std::vector<float> new_scores;
+    std::vector<int64_t> tokens;
+    std::vector<int64_t> parents;
+    results[0].visit([&](auto v) { new_scores.assign(v.begin(), v.end()); });
+    results[1].visit([&](auto v) { tokens.assign(v.begin(), v.end()); });
+    results[2].visit([&](auto v) { parents.assign(v.begin(), v.end()); });
+    // Both kept beams continue the second beam
+    EXPECT(new_scores == std::vector<float>{-0.75, -1.25});
+    EXPECT(tokens == std::vector<int64_t>{0, 2});
+    EXPECT(parents == std::vector<int64_t>{1, 1});
+}
+
+TEST_CASE(beam_step_first_step_test)
+{
+    // On the first step only the first beam is live, and equal scores are ordered by token
+    std::vector<float> logprobs = {-1, -1, -2, -1, -1, -2, -3, -1, -0.5, -3, -1, -0.5};
+    auto results                = run_beam_step(logprobs, {0, -1000, 0, -1000}, 2);
+    std::vector<float> new_scores;
+    std::vector<int64_t> tokens;
+    std::vector<int64_t> parents;
+    results[0].visit([&](auto v) { new_scores.assign(v.begin(), v.end()); });
+    results[1].visit([&](auto v) { tokens.assign(v.begin(), v.end()); });
+    results[2].visit([&](auto v) { parents.assign(v.begin(), v.end()); });
+    EXPECT(new_scores == std::vector<float>{-1, -1, -0.5, -1});
+    EXPECT(tokens == std::vector<int64_t>{0, 1, 2, 1});
+    EXPECT(parents == std::vector<int64_t>{0, 0, 0, 0});
+}
@@ -0,0 +1,66 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+static std::vector<float> run_gridsample(const migraphx::value& v, const std::vector<float>& grid)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape xs{migraphx::shape::float_type, {1, 1, 2, 2}};
+    migraphx::shape gs{migraphx::shape::float_type, {1, 1, grid.size() / 2, 2}};
+    auto x = mm->add_literal(migraphx::literal{xs, {1.0f, 2.0f, 3.0f, 4.0f}});
+    auto g = mm->add_literal(migraphx::literal{gs, grid});
+    mm->add_instruction(migraphx::make_op("gridsample", v), x, g);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+TEST_CASE(gridsample_linear_align_corners)
+{
+    // The corners of the grid land on the corners of the input
+    std::vector<float> grid = {-1.0f, -1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, -1.0f};
+    auto result = run_gridsample({{"mode", "linear"}, {"align_corners", true}}, grid);
+    std::vector<float> gold = {1.0f, 4.0f, 2.5f, 2.0f};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(gridsample_nearest_padding)
+{
+    // The first point is past the right edge, the second one is inside
+    std::vector<float> grid = {2.0f, -0.5f, -0.5f, 0.5f};
+    auto zeros  = run_gridsample({{"mode", "nearest"}, {"padding_mode", "zeros"}}, grid);
+    auto border = run_gridsample({{"mode", "nearest"}, {"padding_mode", "border"}}, grid);
+    EXPECT(zeros == std::vector<float>{0.0f, 3.0f});
+    EXPECT(border == std::vector<float>{2.0f, 3.0f});
+}
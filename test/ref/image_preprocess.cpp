@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+TEST_CASE(image_preprocess_nearest)
+{
+    // Same as converting, transposing and then resizing the image
+    migraphx::shape s{migraphx::shape::uint8_type, {2, 4, 6, 3}};
+    auto data = migraphx::generate_literal(s, 1);
+
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_literal(data);
+        mm->add_instruction(migraphx::make_op("image_preprocess",
+                                              {{"sizes", {8, 3}},
+                                               {"scales", {2.0, 0.5}},
+                                               {"nearest_mode", "round_prefer_ceil"}}),
+                            x);
+    }
+    p1.compile(migraphx::make_target("ref"));
+    auto result = p1.eval({}).back();
+
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto x   = mm->add_literal(data);
+        auto xf  = mm->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), x);
+        auto xt  = mm->add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 3, 1, 2}}}), xf);
+        mm->add_instruction(migraphx::make_op("resize",
+                                              {{"sizes", {2, 3, 8, 3}},
+                                               {"nearest_mode", "round_prefer_ceil"},
+                                               {"coordinate_transformation_mode", "half_pixel"}}),
+                            xt);
+    }
+    p2.compile(migraphx::make_target("ref"));
+    auto expected = p2.eval({}).back();
+
+    EXPECT(result.get_shape() == expected.get_shape());
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold;
+    expected.visit([&](auto output) { gold.assign(output.begin(), output.end()); });
+    EXPECT(results_vector == gold);
+}
+
+TEST_CASE(image_preprocess_linear)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::uint8_type, {1, 2, 2, 2}};
+    std::vector<uint8_t> data = {0, 100, 10, 100, 20, 100, 30, 100};
+    auto x                    = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(migraphx::make_op("image_preprocess",
+                                          {{"sizes", {3, 3}},
+                                           {"scales", {1.5, 1.5}},
+                                           {"mode", "linear"},
+                                           {"mean", {10, 50}},
+                                           {"stddev", {5, 25}}}),
+                        x);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    EXPECT(result.get_shape() == migraphx::shape{migraphx::shape::float_type, {1, 2, 3, 3}});
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    // clang-format off
+    std::vector<float> gold = {-2, -1, 0,
+                                0,  1, 2,
+                                2,  3, 4,
+                                2,  2, 2,
+                                2,  2, 2,
+                                2,  2, 2};
+    // clang-format on
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(image_preprocess_half)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::uint8_type, {1, 1, 2, 1}};
+    auto x = mm->add_literal(migraphx::literal{s, {64, 128}});
+    mm->add_instruction(migraphx::make_op("image_preprocess",
+                                          {{"sizes", {1, 4}},
+                                           {"scales", {1.0, 2.0}},
+                                           {"mode", "linear"},
+                                           {"coordinate_transformation_mode", "align_corners"},
+                                           {"stddev", {64}},
+                                           {"type", migraphx::shape::half_type}}),
+                        x);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    EXPECT(result.get_shape().type() == migraphx::shape::half_type);
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {1, 4.0f / 3, 5.0f / 3, 2};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
@@ -0,0 +1,55 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+TEST_CASE(kv_cache_copy_blocks_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {4, 2, 1, 1}};
+    migraphx::shape ps{migraphx::shape::int32_type, {3, 2}};
+    std::vector<int32_t> copies{0, 2, -1, -1, 1, 4};
+    auto cache = mm->add_parameter("cache", cs);
+    auto c     = mm->add_literal(migraphx::literal{ps, copies});
+    mm->add_instruction(migraphx::make_op("kv_cache_copy_blocks"), cache, c);
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> cache_data{1, 2, 3, 4, 5, 6, 7, 8};
+    migraphx::parameter_map params;
+    params["cache"] = migraphx::argument(cs, cache_data.data());
+    auto result     = p.eval(params).back();
+    std::vector<float> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    // The cache is updated in place, and out of range blocks are skipped
+    std::vector<float> gold{1, 2, 3, 4, 1, 2, 7, 8};
+    EXPECT(cache_data == gold);
+    EXPECT(res_data == gold);
+}
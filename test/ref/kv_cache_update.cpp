@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+static std::vector<float> run_kv_cache_update(const std::vector<int32_t>& positions)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {3, 2, 1, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 2, 1, 2}};
+    migraphx::shape ts{migraphx::shape::int32_type, {2, 2}};
+    migraphx::shape ps{migraphx::shape::int32_type, {2}};
+    std::vector<float> update(us.elements());
+    std::iota(update.begin(), update.end(), 1);
+    std::vector<int32_t> table{2, 0, 1, -1};
+
+    auto cache = mm->add_parameter("cache", cs);
+    auto u     = mm->add_literal(migraphx::literal{us, update});
+    auto t     = mm->add_literal(migraphx::literal{ts, table});
+    auto pos   = mm->add_literal(migraphx::literal{ps, positions});
+    mm->add_instruction(migraphx::make_op("kv_cache_update"), cache, u, t, pos);
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> cache_data(cs.elements(), 0);
+    migraphx::parameter_map params;
+    params["cache"] = migraphx::argument(cs, cache_data.data());
+    auto result     = p.eval(params).back();
+    std::vector<float> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    // The cache is updated in place
+    EXPECT(res_data == cache_data);
+    return res_data;
+}
+
+TEST_CASE(kv_cache_update_test)
+{
+    auto result = run_kv_cache_update({1, 0});
+    std::vector<float> gold{3, 4, 0, 0, 5, 6, 7, 8, 0, 0, 1, 2};
+    EXPECT(result == gold);
+}
+
+TEST_CASE(kv_cache_update_skip_test)
+{
+    // A negative position skips the sequence, and tokens past the last mapped block are dropped
+    auto result = run_kv_cache_update({1, -1});
+    std::vector<float> gold{3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2};
+    EXPECT(result == gold);
+    result = run_kv_cache_update({3, 1});
+    gold   = {0, 0, 1, 2, 0, 0, 5, 6, 0, 0, 0, 0};
+    EXPECT(result == gold);
+}
+
+TEST_CASE(kv_cache_update_quantized_test)
+{
+    // Each head is divided by its scale, rounded and saturated to int8
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::int8_type, {1, 2, 2, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {1, 1, 2, 2}};
+    migraphx::shape ts{migraphx::shape::int32_type, {1, 1}};
+    migraphx::shape ps{migraphx::shape::int32_type, {1}};
+    migraphx::shape ss{migraphx::shape::float_type, {2}};
+    std::vector<float> update{1.2f, -2.6f, 3.0f, 400.0f};
+    std::vector<float> scales{0.5f, 1.0f};
+
+    auto cache = mm->add_parameter("cache", cs);
+    auto u     = mm->add_literal(migraphx::literal{us, update});
+    auto t     = mm->add_literal(migraphx::literal{ts, {0}});
+    auto pos   = mm->add_literal(migraphx::literal{ps, {1}});
+    auto sc    = mm->add_literal(migraphx::literal{ss, scales});
+    mm->add_instruction(migraphx::make_op("kv_cache_update"), cache, u, t, pos, sc);
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<int8_t> cache_data(cs.elements(), 0);
+    migraphx::parameter_map params;
+    params["cache"] = migraphx::argument(cs, cache_data.data());
+    p.eval(params);
+    std::vector<int8_t> gold{0, 0, 0, 0, 2, -5, 3, 127};
+    EXPECT(cache_data == gold);
+}
@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <cmath>
+#include <test.hpp>
+
+static std::vector<float> run_paged_attention(const migraphx::operation& op,
+                                              const migraphx::literal& query,
+                                              const migraphx::literal& key_cache,
+                                              const migraphx::literal& value_cache,
+                                              const std::vector<int32_t>& table,
+                                              const std::vector<int32_t>& context_lens,
+                                              const std::vector<migraphx::literal>& scales = {})
+{
+    migraphx::program p;
+    auto* mm     = p.get_main_module();
+    auto batch   = query.get_shape().lens().front();
+    auto nblocks = table.size() / batch;
+    auto q       = mm->add_literal(query);
+    auto kc      = mm->add_literal(key_cache);
+    auto vc      = mm->add_literal(value_cache);
+    auto t =
+        mm->add_literal(migraphx::literal{{migraphx::shape::int32_type, {batch, nblocks}}, table});
+    auto lens =
+        mm->add_literal(migraphx::literal{{migraphx::shape::int32_type, {batch}}, context_lens});
+    std::vector<migraphx::instruction_ref> inputs{q, kc, vc, t, lens};
+    for(const auto& s : scales)
+        inputs.push_back(mm->add_literal(s));
+    mm->add_instruction(op, inputs);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    return res_data;
+}
+
+// Tokens 0 and 1 are in block 1 and token 2 is in block 0, followed by an unused slot
+static const std::vector<float>& paged_values()
+{
+    static const std::vector<float> values{5, 6, 100, 100, 1, 2, 3, 4};
+    return values;
+}
+
+TEST_CASE(paged_attention_block_table_test)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {1, 1, 1, 2}};
+    migraphx::shape cs{migraphx::shape::float_type, {2, 2, 1, 2}};
+    // A zero query weights all the visible tokens equally
+    auto result = run_paged_attention(migraphx::make_op("paged_attention"),
+                                      migraphx::literal{qs, std::vector<float>(2, 0)},
+                                      migraphx::literal{cs, std::vector<float>(8, 1)},
+                                      migraphx::literal{cs, paged_values()},
+                                      {1, 0},
+                                      {3});
+    std::vector<float> gold{3, 4};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(paged_attention_causal_gqa_test)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {1, 2, 2, 2}};
+    migraphx::shape cs{migraphx::shape::float_type, {2, 2, 1, 2}};
+    auto result = run_paged_attention(migraphx::make_op("paged_attention"),
+                                      migraphx::literal{qs, std::vector<float>(8, 0)},
+                                      migraphx::literal{cs, std::vector<float>(8, 1)},
+                                      migraphx::literal{cs, paged_values()},
+                                      {1, 0},
+                                      {3});
+    std::vector<float> gold{2, 3, 2, 3, 3, 4, 3, 4};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(paged_attention_scale_test)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {1, 1, 1, 2}};
+    migraphx::shape cs{migraphx::shape::float_type, {1, 2, 1, 2}};
+    std::vector<float> keys{0, 0, std::log(3.0f), 0};
+    std::vector<float> values{4, 0, 0, 8};
+    auto result = run_paged_attention(migraphx::make_op("paged_attention", {{"scale", 1.0f}}),
+                                      migraphx::literal{qs, std::vector<float>{1, 0}},
+                                      migraphx::literal{cs, keys},
+                                      migraphx::literal{cs, values},
+                                      {0},
+                                      {2});
+    std::vector<float> gold{1, 6};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(paged_attention_quantized_test)
+{
+    // Same as the scale test with the caches stored in int8
+    migraphx::shape qs{migraphx::shape::float_type, {1, 1, 1, 2}};
+    migraphx::shape cs{migraphx::shape::int8_type, {1, 2, 1, 2}};
+    migraphx::shape ss{migraphx::shape::float_type, {1}};
+    std::vector<int8_t> keys{0, 0, 2, 0};
+    std::vector<int8_t> values{2, 0, 0, 4};
+    auto result = run_paged_attention(migraphx::make_op("paged_attention", {{"scale", 1.0f}}),
+                                      migraphx::literal{qs, std::vector<float>{1, 0}},
+                                      migraphx::literal{cs, keys},
+                                      migraphx::literal{cs, values},
+                                      {0},
+                                      {2},
+                                      {migraphx::literal{ss, {std::log(3.0f) / 2}},
+                                       migraphx::literal{ss, {2.0f}}});
+    std::vector<float> gold{1, 6};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
@@ -152,6 +152,32 @@ TEST_CASE(avgpool_rank3_pad_dil_test)
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
 
+TEST_CASE(avgpool_rank3_asym_pad_include_test)
+{
+    // The last window extends past the end padding and is clipped to it
+    migraphx::program p;
+    auto* mm             = p.get_main_module();
+    auto s               = migraphx::shape{migraphx::shape::float_type, {1, 1, 5}};
+    auto op              = migraphx::op::pooling{migraphx::op::pooling_mode::average};
+    op.lengths           = {3};
+    op.padding           = {0, 1};
+    op.stride            = {2};
+    op.dilations         = {1};
+    op.ceil_mode         = true;
+    op.count_include_pad = true;
+
+    std::vector<float> data{1, 2, 3, 4, 5};
+    auto l0 = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(op, l0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{2, 4, 2.5};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
 TEST_CASE(avgpool_dyn_test)
 {
     // Dynamic input, no padding
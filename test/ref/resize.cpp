@@ -346,6 +346,76 @@ TEST_CASE(resize_upsample_test_4_1_input)
     EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
 }
 
+TEST_CASE(resize_linear_1_input)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto a0 = mm->add_literal(migraphx::literal{s, {1.0f, 2.0f, 3.0f, 4.0f}});
+
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"scales", {1.0, 1.0, 2.0, 2.0}},
+                                           {"mode", "linear"},
+                                           {"coordinate_transformation_mode", "half_pixel"}}),
+                        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 4 * 4);
+    // clang-format off
+    std::vector<float> golden = {
+        1.0f, 1.25f, 1.75f, 2.0f,
+        1.5f, 1.75f, 2.25f, 2.5f,
+        2.5f, 2.75f, 3.25f, 3.5f,
+        3.0f, 3.25f, 3.75f, 4.0f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_cubic_1_input)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::vector<float> data(4 * 4);
+    std::iota(data.begin(), data.end(), 1);
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 4, 4}};
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"sizes", {1, 1, 8, 8}},
+                                           {"mode", "cubic"},
+                                           {"coordinate_transformation_mode", "half_pixel"}}),
+                        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 8 * 8);
+    // clang-format off
+    std::vector<float> golden = {
+        0.47265625, 0.76953125, 1.24609375, 1.875,
+        2.28125, 2.91015625, 3.38671875, 3.68359375,
+        1.66015625, 1.95703125, 2.43359375, 3.0625,
+        3.46875, 4.09765625, 4.57421875, 4.87109375,
+        3.56640625, 3.86328125, 4.33984375, 4.96875,
+        5.375, 6.00390625, 6.48046875, 6.77734375,
+        6.08203125, 6.37890625, 6.85546875, 7.484375,
+        7.890625, 8.51953125, 8.99609375, 9.29296875,
+        7.70703125, 8.00390625, 8.48046875, 9.109375,
+        9.515625, 10.14453125, 10.62109375, 10.91796875,
+        10.22265625, 10.51953125, 10.99609375, 11.625,
+        12.03125, 12.66015625, 13.13671875, 13.43359375,
+        12.12890625, 12.42578125, 12.90234375, 13.53125,
+        13.9375, 14.56640625, 15.04296875, 15.33984375,
+        13.31640625, 13.61328125, 14.08984375, 14.71875,
+        15.125, 15.75390625, 16.23046875, 16.52734375};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
 TEST_CASE(resize_optimize_test)
 {
     // matcher/optimized code should produce the same result as Resize op.
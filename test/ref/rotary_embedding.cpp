@@ -0,0 +1,66 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+static std::vector<float> run_rotary_embedding(bool interleaved)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 4}};
+    migraphx::shape ts{migraphx::shape::float_type, {4}};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6, 7, 8}});
+    auto c   = mm->add_literal(migraphx::literal{ts, std::vector<float>{1, 0.5, 0, -1}});
+    auto sn  = mm->add_literal(migraphx::literal{ts, {0, 1, 2, 3}});
+
+    c  = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), c);
+    sn = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), sn);
+    mm->add_instruction(
+        migraphx::make_op("rotary_embedding", {{"interleaved", interleaved}}), x, c, sn);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+TEST_CASE(rotary_embedding_test)
+{
+    auto results_vector     = run_rotary_embedding(false);
+    std::vector<float> gold = {1, -3, 2, 2, 5, -5, 10, 10};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(rotary_embedding_interleaved_test)
+{
+    auto results_vector     = run_rotary_embedding(true);
+    std::vector<float> gold = {1, 2, -8, 5, 5, 8, -16, 13};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
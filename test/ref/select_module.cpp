@@ -21,11 +21,15 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/op/select_module.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/split_single_dyn_dim.hpp>
 #include <migraphx/verify.hpp>
 
 #include <test.hpp>
@@ -169,6 +173,258 @@ TEST_CASE(select_module_reduce_test1)
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
 
+TEST_CASE(select_module_bucket_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape lit_s{migraphx::shape{migraphx::shape::float_type, {1}}};
+    auto literal_ins = mm->add_literal(migraphx::literal{lit_s, {6}});
+
+    // create batch submodules only for some of the sizes
+    auto create_submodule = [&](std::size_t batch_size, const std::string& module_name) {
+        auto* submod = p.create_module(module_name);
+        migraphx::shape sm_shape{migraphx::shape::float_type, {batch_size, 4}};
+        auto sm_input = submod->add_parameter("data", sm_shape);
+        auto broadcast_lit =
+            submod->add_instruction(migraphx::make_op("multibroadcast"), literal_ins, sm_input);
+        auto add_ins = submod->add_instruction(migraphx::make_op("add"), sm_input, broadcast_lit);
+        submod->add_return({add_ins});
+        return submod;
+    };
+    auto* batch4 = create_submodule(4, "batch_4");
+    auto* batch2 = create_submodule(2, "batch_2");
+
+    migraphx::shape s{migraphx::shape::float_type, {{1, 4}, {4, 4}}};
+    auto input                              = mm->add_parameter("data", s);
+    std::vector<migraphx::shape> sub_shapes = {};
+    sub_shapes.push_back(migraphx::shape{migraphx::shape::float_type, {{1, 4}, {4, 4}}});
+    migraphx::shape out_attr = migraphx::shape{sub_shapes};
+    auto sm_ins              = mm->add_instruction(
+        migraphx::make_op("select_module", {{"output_dyn_shapes", migraphx::to_value(out_attr)}}),
+        {input},
+        {batch4, batch2});
+    auto ret = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> input_data{-4, 8, -1, 4, -1, 8, 8, -4, 1, 2, 3, 4};
+    migraphx::parameter_map params;
+    migraphx::shape input_fixed_shape{migraphx::shape::float_type, {3, 4}};
+    params["data"] = migraphx::argument(input_fixed_shape, input_data.data());
+    auto result    = p.eval(params).back();
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{3, 4});
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{2, 14, 5, 10, 5, 14, 14, 2, 7, 8, 9, 10};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(select_module_dispatch_table_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape lit_s{migraphx::shape{migraphx::shape::float_type, {1}}};
+    auto literal_ins = mm->add_literal(migraphx::literal{lit_s, {6}});
+
+    auto create_submodule = [&](std::size_t batch_size, const std::string& module_name) {
+        auto* submod = p.create_module(module_name);
+        migraphx::shape sm_shape{migraphx::shape::float_type, {batch_size, 4}};
+        auto sm_input = submod->add_parameter("data", sm_shape);
+        auto broadcast_lit =
+            submod->add_instruction(migraphx::make_op("multibroadcast"), literal_ins, sm_input);
+        auto add_ins = submod->add_instruction(migraphx::make_op("add"), sm_input, broadcast_lit);
+        submod->add_return({add_ins});
+        return submod;
+    };
+    auto* batch4 = create_submodule(4, "batch_4");
+    auto* batch2 = create_submodule(2, "batch_2");
+
+    migraphx::shape s{migraphx::shape::float_type, {{1, 4}, {4, 4}}};
+    auto input                              = mm->add_parameter("data", s);
+    std::vector<migraphx::shape> sub_shapes = {};
+    sub_shapes.push_back(migraphx::shape{migraphx::shape::float_type, {{1, 4}, {4, 4}}});
+    migraphx::op::select_module op;
+    op.output_dyn_shapes = migraphx::shape{sub_shapes};
+    op.make_dispatch_table({s}, {batch4, batch2});
+    EXPECT(op.dispatch_min == 1);
+    EXPECT(op.dispatch_table == std::vector<std::size_t>{1, 1, 0, 0});
+    auto sm_ins = mm->add_instruction(op, {input}, {batch4, batch2});
+    auto ret    = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> input_data{-4, 8, -1, 4, -1, 8, 8, -4, 1, 2, 3, 4};
+    for(std::size_t batch : {1, 2, 3})
+    {
+        migraphx::parameter_map params;
+        migraphx::shape input_fixed_shape{migraphx::shape::float_type, {batch, 4}};
+        params["data"] = migraphx::argument(input_fixed_shape, input_data.data());
+        auto result    = p.eval(params).back();
+        EXPECT(result.get_shape().lens() == std::vector<std::size_t>{batch, 4});
+        std::vector<float> results_vector;
+        result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+        std::vector<float> gold(batch * 4);
+        std::transform(input_data.begin(),
+                       input_data.begin() + gold.size(),
+                       gold.begin(),
+                       [](auto x) { return x + 6; });
+        EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+    }
+}
+
+TEST_CASE(select_module_dispatch_table_fallback_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto create_submodule = [&](std::size_t batch_size,
+                                std::size_t seq_len,
+                                const std::string& name) {
+        auto* submod = p.create_module(name);
+        migraphx::shape sm_shape{migraphx::shape::float_type, {batch_size, seq_len}};
+        auto sm_input = submod->add_parameter("data", sm_shape);
+        auto neg      = submod->add_instruction(migraphx::make_op("neg"), sm_input);
+        submod->add_return({neg});
+        return submod;
+    };
+    auto* small = create_submodule(2, 2, "small");
+    auto* large = create_submodule(8, 7, "large");
+
+    // No table is built when more than one dimension is dynamic, even with the same ranges
+    migraphx::shape s{migraphx::shape::float_type, {{1, 8}, {1, 8}}};
+    migraphx::op::select_module op;
+    op.output_dyn_shapes = migraphx::shape{std::vector<migraphx::shape>{s}};
+    op.make_dispatch_table({s}, {small, large});
+    EXPECT(op.dispatch_table.empty());
+
+    // A table entry that doesn't fit the inputs falls back to matching the shapes
+    op.dispatch_input = 0;
+    op.dispatch_axis  = 0;
+    op.dispatch_min   = 1;
+    op.dispatch_table = std::vector<std::size_t>(8, 0);
+    auto input        = mm->add_parameter("data", s);
+    auto sm_ins       = mm->add_instruction(op, {input}, {small, large});
+    auto ret = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> input_data(14);
+    std::iota(input_data.begin(), input_data.end(), 1);
+    migraphx::parameter_map params;
+    params["data"] = migraphx::argument({migraphx::shape::float_type, {2, 7}}, input_data.data());
+    auto result    = p.eval(params).back();
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{2, 7});
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold(input_data.size());
+    std::transform(input_data.begin(), input_data.end(), gold.begin(), [](auto x) { return -x; });
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(select_module_independent_dims_test)
+{
+    // The batch and sequence dimensions have the same range but are independent, so the
+    // submodule can't be looked up from the batch size alone
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto create_submodule = [&](std::size_t batch_size,
+                                std::size_t seq_len,
+                                const std::string& name) {
+        auto* submod = p.create_module(name);
+        migraphx::shape sm_shape{migraphx::shape::float_type, {batch_size, seq_len}};
+        auto sm_input = submod->add_parameter("data", sm_shape);
+        auto neg      = submod->add_instruction(migraphx::make_op("neg"), sm_input);
+        submod->add_return({neg});
+        return submod;
+    };
+    auto* b1s1 = create_submodule(1, 1, "b1s1");
+    auto* b1s4 = create_submodule(1, 4, "b1s4");
+    auto* b4s4 = create_submodule(4, 4, "b4s4");
+
+    migraphx::shape s{migraphx::shape::float_type, {{1, 4}, {1, 4}}};
+    migraphx::op::select_module op;
+    op.output_dyn_shapes = migraphx::shape{std::vector<migraphx::shape>{s}};
+    op.make_dispatch_table({s}, {b1s1, b1s4, b4s4});
+    EXPECT(op.dispatch_table.empty());
+    auto input  = mm->add_parameter("data", s);
+    auto sm_ins = mm->add_instruction(op, {input}, {b1s1, b1s4, b4s4});
+    auto ret = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> input_data{1, 2, 3, 4};
+    migraphx::parameter_map params;
+    params["data"] = migraphx::argument({migraphx::shape::float_type, {1, 4}}, input_data.data());
+    auto result    = p.eval(params).back();
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{1, 4});
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{-1, -2, -3, -4};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(select_module_inputs_padded_test)
+{
+    // The dynamic dimension is the inner axis, so the padded input has the strides of the
+    // submodule rather than being a prefix of its buffer
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sm_shape{migraphx::shape::float_type, {2, 4}};
+    auto* submod  = p.create_module("pad4");
+    auto sm_input = submod->add_parameter("data", sm_shape);
+    auto neg      = submod->add_instruction(migraphx::make_op("neg"), sm_input);
+    submod->add_return({neg});
+
+    migraphx::shape s{migraphx::shape::float_type, {{2, 2}, {2, 4}}};
+    migraphx::op::select_module op;
+    op.output_dyn_shapes = migraphx::shape{std::vector<migraphx::shape>{s}};
+    op.inputs_padded     = true;
+    auto input           = mm->add_parameter("data", s);
+    auto sm_ins          = mm->add_instruction(op, {input}, {submod});
+    auto ret = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> buffer{1, 2, 3, 0, 4, 5, 6, 0};
+    migraphx::shape padded{migraphx::shape::float_type, {2, 3}, {4, 1}};
+    migraphx::parameter_map params;
+    params["data"] = migraphx::argument(padded, buffer.data());
+    auto result    = p.eval(params).back();
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{2, 3});
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{-1, -2, -3, -4, -5, -6};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+
+    // A standard input isn't laid out for the padded shape
+    std::vector<float> input_data{1, 2, 3, 4, 5, 6};
+    params["data"] = migraphx::argument({migraphx::shape::float_type, {2, 3}}, input_data.data());
+    EXPECT(test::throws([&] { std::ignore = p.eval(params); }));
+}
+
+TEST_CASE(select_module_bucket_softmax_test)
+{
+    // the sequence is padded from 3 to 4, the padding must not change the softmax
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{2, 2}, {2, 4, {2, 4}}}};
+    auto input   = mm->add_parameter("scores", s);
+    auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), input);
+    mm->add_return({softmax});
+    migraphx::run_passes(p, {migraphx::split_single_dyn_dim{}, migraphx::dead_code_elimination{}});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> input_data{1, 2, 3, -1, 0, 1};
+    migraphx::parameter_map params;
+    migraphx::shape input_fixed_shape{migraphx::shape::float_type, {2, 3}};
+    params["scores"] = migraphx::argument(input_fixed_shape, input_data.data());
+    auto result      = p.eval(params).back();
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{2, 3});
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{0.0900306, 0.244728, 0.665241, 0.0900306, 0.244728, 0.665241};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
 TEST_CASE(select_module_not_found_error)
 {
     migraphx::program p;
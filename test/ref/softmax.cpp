@@ -106,6 +106,23 @@ TEST_CASE(softmax_test)
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
 
+TEST_CASE(softmax_transposed_test)
+{
+    migraphx::program p;
+    auto* mm             = p.get_main_module();
+    std::vector<float> a = {0, 1, 2, 3, 4, 5};
+    migraphx::shape a_shape{migraphx::shape::float_type, {2, 3}};
+    auto al = mm->add_literal(migraphx::literal{a_shape, a});
+    auto tr = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), al);
+    mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), tr);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold = {0.0474259, 0.952574, 0.0474259, 0.952574, 0.0474259, 0.952574};
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
 TEST_CASE(softmax_dyn_test)
 {
     migraphx::program p;
@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <cmath>
+#include <test.hpp>
+
+static std::vector<float> run_varlen_attention(const migraphx::operation& op,
+                                               const migraphx::literal& query,
+                                               const migraphx::literal& key,
+                                               const migraphx::literal& value,
+                                               const std::vector<int32_t>& cu_seqlens)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto q   = mm->add_literal(query);
+    auto k   = mm->add_literal(key);
+    auto v   = mm->add_literal(value);
+    auto cu  = mm->add_literal(
+        migraphx::literal{{migraphx::shape::int32_type, {cu_seqlens.size()}}, cu_seqlens});
+    mm->add_instruction(op, q, k, v, cu);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    return res_data;
+}
+
+// Two sequences of 2 and 1 tokens, followed by a token that is not in any sequence
+static const std::vector<float>& packed_values()
+{
+    static const std::vector<float> values{1, 2, 3, 4, 5, 6, 100, 100};
+    return values;
+}
+
+TEST_CASE(varlen_attention_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 1, 2}};
+    // A zero query weights all the visible tokens equally
+    auto result = run_varlen_attention(migraphx::make_op("varlen_attention"),
+                                       migraphx::literal{s, std::vector<float>(8, 0)},
+                                       migraphx::literal{s, std::vector<float>(8, 1)},
+                                       migraphx::literal{s, packed_values()},
+                                       {0, 2, 3});
+    std::vector<float> gold{2, 3, 2, 3, 5, 6, 0, 0};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(varlen_attention_causal_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 1, 2}};
+    auto result = run_varlen_attention(migraphx::make_op("varlen_attention", {{"causal", true}}),
+                                       migraphx::literal{s, std::vector<float>(8, 0)},
+                                       migraphx::literal{s, std::vector<float>(8, 1)},
+                                       migraphx::literal{s, packed_values()},
+                                       {0, 2, 3});
+    std::vector<float> gold{1, 2, 2, 3, 5, 6, 0, 0};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(varlen_attention_gqa_test)
+{
+    // Both query heads share the single kv head
+    migraphx::shape qs{migraphx::shape::float_type, {4, 2, 2}};
+    migraphx::shape ks{migraphx::shape::float_type, {4, 1, 2}};
+    auto result = run_varlen_attention(migraphx::make_op("varlen_attention"),
+                                       migraphx::literal{qs, std::vector<float>(16, 0)},
+                                       migraphx::literal{ks, std::vector<float>(8, 1)},
+                                       migraphx::literal{ks, packed_values()},
+                                       {0, 2, 3});
+    std::vector<float> gold{2, 3, 2, 3, 2, 3, 2, 3, 5, 6, 5, 6, 0, 0, 0, 0};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(varlen_attention_scale_test)
+{
+    // The second key scores log(3) higher, so it gets 3/4 of the weight
+    migraphx::shape s{migraphx::shape::float_type, {2, 1, 2}};
+    std::vector<float> keys{0, 0, std::log(3.0f), 0};
+    std::vector<float> values{4, 0, 0, 8};
+    auto result = run_varlen_attention(migraphx::make_op("varlen_attention", {{"scale", 1.0f}}),
+                                       migraphx::literal{s, std::vector<float>{1, 0, 1, 0}},
+                                       migraphx::literal{s, keys},
+                                       migraphx::literal{s, values},
+                                       {0, 2});
+    std::vector<float> gold{1, 6, 1, 6};
+    EXPECT(migraphx::verify::verify_rms_range(result, gold));
+}
+
+TEST_CASE(varlen_attention_shape_test)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {4, 3, 2}};
+    migraphx::shape ks{migraphx::shape::float_type, {4, 2, 2}};
+    migraphx::shape cs{migraphx::shape::int32_type, {3}};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto q   = mm->add_parameter("q", qs);
+    auto k   = mm->add_parameter("k", ks);
+    auto v   = mm->add_parameter("v", ks);
+    auto cu  = mm->add_parameter("cu", cs);
+    EXPECT(test::throws(
+        [&] { mm->add_instruction(migraphx::make_op("varlen_attention"), q, k, v, cu); }));
+}
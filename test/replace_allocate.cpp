@@ -108,6 +108,25 @@ struct allocation_with_out_model
     bool needs_out_params() const { return true; }
 };
 
+// Writes its output transposed into the allocation passed as the first argument
+struct transpose_out_op
+{
+    std::string name() const { return "transpose_out"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>& inputs) const
+    {
+        migraphx::check_shapes{inputs, *this}.has(1);
+        auto lens = inputs.front().lens();
+        return {inputs.front().type(), lens, {1, lens[0]}};
+    }
+    migraphx::argument compute(migraphx::context&,
+                               const migraphx::shape& output_shape,
+                               const std::vector<migraphx::argument>& args) const
+    {
+        return args.front().reshape(output_shape);
+    }
+    int output_alias(const std::vector<migraphx::shape>&) const { return 0; }
+};
+
 void run_pass(migraphx::module& m, migraphx::allocation_model model, bool offload_copy = false)
 {
     migraphx::run_passes(m,
@@ -165,6 +184,21 @@ TEST_CASE(allocate_with_out_return)
     }));
 }
 
+TEST_CASE(allocate_with_out_transposed)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto alloc =
+        m.add_instruction(migraphx::make_op("allocate", {{"shape", migraphx::to_value(s)}}));
+    auto t = m.add_instruction(transpose_out_op{}, alloc);
+    m.add_return({t});
+    run_pass(m, allocation_with_out_model{});
+
+    auto out_shape = m.get_parameter_shape(m.name() + ":#output_0");
+    EXPECT(out_shape == t->get_shape());
+    EXPECT(out_shape.transposed());
+}
+
 TEST_CASE(allocate_with_out_no_params)
 {
     migraphx::module m;
@@ -24,6 +24,7 @@
 #include <migraphx/rewrite_pooling.hpp>
 #include <migraphx/op/pooling.hpp>
 #include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/instruction.hpp>
@@ -129,6 +130,28 @@ TEST_CASE(rewrite_pooling_dialtions_test)
     test_rewrite(migraphx::op::pooling_mode::max);
 }
 
+TEST_CASE(rewrite_pooling_keep_dilations_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 5, 5}};
+    migraphx::module m1;
+    {
+        auto input = m1.add_parameter("x", s);
+        auto ret   = m1.add_instruction(migraphx::make_op("pooling",
+                                                          {{"mode", migraphx::op::pooling_mode::max},
+                                                           {"padding", {0, 0}},
+                                                           {"stride", {1, 1}},
+                                                           {"lengths", {2, 2}},
+                                                           {"dilations", {2, 2}}}),
+                                      input);
+        m1.add_return({ret});
+    }
+    migraphx::module m2 = m1;
+    migraphx::run_passes(m1,
+                         {migraphx::rewrite_pooling{.rewrite_dilations = false},
+                          migraphx::dead_code_elimination{}});
+    EXPECT(m1 == m2);
+}
+
 TEST_CASE(rewrite_pooling_dialtions_test2)
 {
     migraphx::shape s{migraphx::shape::float_type, {1, 1, 5, 5, 5}};
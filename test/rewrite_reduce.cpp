@@ -59,6 +59,35 @@ TEST_CASE(softmax)
     }));
 }
 
+TEST_CASE(logsoftmax)
+{
+    migraphx::shape s{migraphx::shape::float_type, {10, 1000}};
+    migraphx::module m1;
+    {
+        auto x          = m1.add_parameter("x", s);
+        auto logsoftmax = m1.add_instruction(migraphx::make_op("logsoftmax", {{"axis", 1}}), x);
+        m1.add_return({logsoftmax});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x    = m2.add_parameter("x", s);
+        auto max  = m2.add_instruction(migraphx::make_op("reduce_max", {{"axes", {1}}}), x);
+        auto maxb = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), max);
+        auto sub  = m2.add_instruction(migraphx::make_op("sub"), x, maxb);
+        auto exp  = m2.add_instruction(migraphx::make_op("exp"), sub);
+        auto sum  = m2.add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), exp);
+        auto log  = m2.add_instruction(migraphx::make_op("log"), sum);
+        auto logb = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), log);
+        auto logsoftmax = m2.add_instruction(migraphx::make_op("sub"), sub, logb);
+        m2.add_return({logsoftmax});
+    }
+    EXPECT(m1 == m2);
+}
+
 TEST_CASE(reduce_mean)
 {
     migraphx::shape s{migraphx::shape::float_type, {1, 3, 9}};
@@ -200,6 +200,37 @@ static auto create_program(int64_t max_loop_iterations = 10)
     return p;
 };
 
+// The body returns its condition parameter unchanged, so the loop runs for iter_num iterations
+static auto create_program_invariant_cond(int64_t max_loop_iterations = 10)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape si{migraphx::shape::int64_type};
+    migraphx::shape s{migraphx::shape::int64_type, {1}};
+    migraphx::shape sc{migraphx::shape::bool_type};
+
+    auto in_iter = mm->add_parameter("iter_num", si);
+    auto in_cond = mm->add_parameter("ccond", sc);
+    auto in_val  = mm->add_parameter("val", s);
+
+    auto* body = p.create_module("loop_module");
+    auto iter  = body->add_parameter("#loop_module_in_0", si);
+    auto cond  = body->add_parameter("#loop_module_in_1", sc);
+    auto in_v  = body->add_parameter("#loop_module_in_2", s);
+    auto val   = body->add_instruction(migraphx::make_op("add"), in_v, iter);
+    auto out2  = body->add_parameter("loop_module:#output_2", val->get_shape());
+    auto r_val = body->add_instruction(copy_op{}, val, out2);
+    body->add_return({cond, r_val, r_val});
+
+    auto rl =
+        mm->add_instruction(test_loop_op{max_loop_iterations}, {in_iter, in_cond, in_val}, {body});
+    auto r0 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), rl);
+    auto r1 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), rl);
+    mm->add_return({r0, r1});
+
+    return p;
+};
+
 static auto run_prog(migraphx::program p, int64_t iter_num, bool cond, int64_t ini_val)
 {
     migraphx::shape si{migraphx::shape::int64_type};
@@ -265,4 +296,14 @@ TEST_CASE(loop_test4)
     EXPECT(ress.back() == gold_concat);
 }
 
+TEST_CASE(loop_invariant_cond)
+{
+    auto p                         = create_program_invariant_cond(6);
+    auto ress                      = run_prog(p, 4, true, 1);
+    std::vector<int64_t> gold_last = {7};
+    EXPECT(ress.front() == gold_last);
+    std::vector<int64_t> gold_concat = {1, 2, 4, 7, 0, 0};
+    EXPECT(ress.back() == gold_concat);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -154,7 +154,7 @@ struct schedule_model_test
     {
         (*wait2stream)[wait_id] = ins2stream->at(ins);
     }
-    std::size_t weight(const migraphx::operation& op) const
+    std::size_t weight(const migraphx::operation& op, const std::vector<migraphx::shape>&) const
     {
         if(op.name() == "stream_free")
             return 0;
@@ -822,6 +822,32 @@ TEST_CASE(dominate_conflicts)
     t.check_conflicts(m, {{binary1}, {binary2}}, false);
 }
 
+TEST_CASE(transitive_wait)
+{
+    scheduler t{};
+    migraphx::module m;
+
+    auto one    = m.add_literal(1);
+    auto i1     = m.add_instruction(unary_op{}, one);
+    auto c1     = chain(m, 2, unary_op{}, one);
+    auto binary = m.add_instruction(nary_op{}, c1.back(), i1);
+    auto c2     = chain(m, 4, unary_op{}, one);
+    auto output = m.add_instruction(nary_op{}, c2.back(), binary, i1);
+    t.run_pass(m);
+    EXPECT(not t.has_stream(one));
+    for(auto ins : c2)
+        EXPECT(t.get_stream(ins) == 0);
+    EXPECT(t.get_stream(output) == 0);
+    EXPECT(t.get_stream(binary) == t.get_stream(c1.back()));
+    EXPECT(t.get_stream(binary) != 0);
+    EXPECT(t.get_stream(i1) != 0);
+    EXPECT(t.get_stream(i1) != t.get_stream(binary));
+    EXPECT(get_wait_for(binary) == get_wait_for({t.get_stream(i1)}));
+    // Waiting for binary already waits for i1
+    EXPECT(get_wait_for(output) == get_wait_for({t.get_stream(binary)}));
+    t.check_conflicts(m, {c1, {i1}});
+}
+
 TEST_CASE(inception1)
 {
     scheduler t{};
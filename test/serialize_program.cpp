@@ -24,11 +24,27 @@
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/load_save.hpp>
+#include <migraphx/file_buffer.hpp>
 #include "test.hpp"
 #include <migraphx/make_op.hpp>
+#include <migraphx/register_op.hpp>
 
 #include <cstdio>
 
+struct code_object_op : migraphx::auto_register_op<code_object_op>
+{
+    migraphx::value::binary code_object{};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::pack(f(self.code_object, "code_object"));
+    }
+
+    std::string name() const { return "serialize_program::code_object"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>&) const { return {}; }
+};
+
 migraphx::program create_program()
 {
     migraphx::program p;
@@ -69,6 +85,62 @@ TEST_CASE(as_json)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(as_chunked)
+{
+    migraphx::file_options options;
+    options.format           = "chunked";
+    migraphx::program p1     = create_program();
+    std::vector<char> buffer = migraphx::save_buffer(p1, options);
+    migraphx::program p2     = migraphx::load_buffer(buffer, options);
+    EXPECT(p1.sort() == p2.sort());
+}
+
+TEST_CASE(chunked_detected)
+{
+    migraphx::file_options options;
+    options.format           = "chunked";
+    migraphx::program p1     = create_program();
+    std::vector<char> buffer = migraphx::save_buffer(p1, options);
+    migraphx::program p2     = migraphx::load_buffer(buffer);
+    EXPECT(p1.sort() == p2.sort());
+}
+
+TEST_CASE(chunked_truncated)
+{
+    migraphx::file_options options;
+    options.format           = "chunked";
+    std::vector<char> buffer = migraphx::save_buffer(create_program(), options);
+    buffer.pop_back();
+    EXPECT(test::throws([&] { migraphx::load_buffer(buffer, options); }));
+}
+
+TEST_CASE(chunked_unknown_compression)
+{
+    migraphx::file_options options;
+    options.format      = "chunked";
+    options.compression = "???";
+    EXPECT(test::throws([&] { migraphx::save_buffer(create_program(), options); }));
+}
+
+TEST_CASE(chunked_code_objects)
+{
+    std::string filename = "migraphx_chunked_program.mxr";
+    migraphx::file_options options;
+    options.format      = "chunked";
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    code_object_op op;
+    op.code_object = migraphx::value::binary{std::string{"code"}};
+    mm->add_return({mm->add_instruction(op)});
+    migraphx::save(p, filename, options);
+    auto code_objects    = migraphx::load_code_objects(filename);
+    migraphx::program p2 = migraphx::load(filename);
+    std::remove(filename.c_str());
+    EXPECT(code_objects.size() == 1);
+    EXPECT(code_objects.front() == op.code_object);
+    EXPECT(p.sort() == p2.sort());
+}
+
 TEST_CASE(as_file)
 {
     std::string filename = "migraphx_program.mxr";
@@ -79,6 +151,20 @@ TEST_CASE(as_file)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(mapped_file)
+{
+    std::string filename = "migraphx_mapped_program.mxr";
+    migraphx::program p1 = create_program();
+    migraphx::save(p1, filename);
+    auto buffer = migraphx::map_buffer(filename);
+    auto data   = migraphx::read_buffer(filename);
+    std::remove(filename.c_str());
+    EXPECT(buffer.size() == data.size());
+    EXPECT(std::equal(data.begin(), data.end(), buffer.data()));
+    migraphx::program p2 = migraphx::load_buffer(buffer.data(), buffer.size());
+    EXPECT(p1.sort() == p2.sort());
+}
+
 TEST_CASE(compiled)
 {
     migraphx::program p1 = create_program();
@@ -88,6 +174,38 @@ TEST_CASE(compiled)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(checkpoint_resume)
+{
+    std::string filename = "migraphx_checkpoint.mxr";
+    migraphx::compile_options options;
+    options.checkpoint_pass = "auto_contiguous";
+    options.checkpoint_file = filename;
+    migraphx::program p1    = create_program();
+    p1.compile(migraphx::make_target("ref"), options);
+
+    migraphx::program checkpoint = migraphx::load(filename);
+    std::remove(filename.c_str());
+    EXPECT(not checkpoint.is_compiled());
+
+    migraphx::compile_options resume;
+    resume.resume_pass = "auto_contiguous";
+    checkpoint.compile(migraphx::make_target("ref"), resume);
+    EXPECT(p1.sort() == checkpoint.sort());
+
+    migraphx::parameter_map m;
+    m["x"] = migraphx::literal{migraphx::shape{migraphx::shape::int32_type}, {3}}.get_argument();
+    auto result = checkpoint.eval(m).back();
+    EXPECT(result.at<int>() == 5);
+}
+
+TEST_CASE(checkpoint_unknown_pass)
+{
+    migraphx::compile_options options;
+    options.resume_pass = "???";
+    migraphx::program p = create_program();
+    EXPECT(test::throws([&] { p.compile(migraphx::make_target("ref"), options); }));
+}
+
 TEST_CASE(unknown_format)
 {
     migraphx::file_options options;
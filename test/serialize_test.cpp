@@ -194,4 +194,15 @@ TEST_CASE(from_value_binary)
     EXPECT(out == data);
 }
 
+TEST_CASE(to_value_binary)
+{
+    std::vector<std::uint8_t> data(10);
+    std::iota(data.begin(), data.end(), 0);
+
+    migraphx::value::binary x{data};
+    migraphx::value v = migraphx::to_value(x);
+    EXPECT(v.is_binary());
+    EXPECT(migraphx::from_value<migraphx::value::binary>(v) == x);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -97,6 +97,40 @@ TEST_CASE(test_shape_standard_stray_singleton_dim)
     EXPECT(not s.broadcasted());
 }
 
+TEST_CASE(test_shape_same_lens)
+{
+    // Shapes with the same lens share storage, but only when the type and strides match
+    migraphx::shape s1{migraphx::shape::float_type, {5, 1, 1, 8}};
+    migraphx::shape s2{migraphx::shape::float_type, {5, 1, 1, 8}, {8, 3, 4, 1}};
+    migraphx::shape s3{migraphx::shape::float_type, {5, 1, 1, 8}, {8, 8, 8, 1}};
+    migraphx::shape s4{migraphx::shape::half_type, {5, 1, 1, 8}};
+    EXPECT(s1.strides() == std::vector<std::size_t>{8, 8, 8, 1});
+    EXPECT(s2.strides() == std::vector<std::size_t>{8, 3, 4, 1});
+    EXPECT(s1 != s2);
+    EXPECT(s1 == s3);
+    EXPECT(s4.type() == migraphx::shape::half_type);
+    EXPECT(s4.lens() == s1.lens());
+}
+
+TEST_CASE(test_shape_hash)
+{
+    migraphx::shape s1{migraphx::shape::float_type, {2, 3}};
+    migraphx::shape s2{migraphx::shape::float_type, {2, 3}, {3, 1}};
+    migraphx::shape s3{migraphx::shape::float_type, {2, 3}, {1, 2}};
+    migraphx::shape s4{migraphx::shape::float_type, {{1, 4}, {3, 3}}};
+    migraphx::shape s5{migraphx::shape::float_type, {{1, 4}, {3, 3}}};
+    migraphx::shape s6{{s1, s4}};
+    migraphx::shape s7{{s2, s5}};
+    EXPECT(s1.hash() == s2.hash());
+    EXPECT(s1.hash() != s3.hash());
+    EXPECT(s4.hash() == s5.hash());
+    EXPECT(s6.hash() == s7.hash());
+    EXPECT(s6 == s7);
+    EXPECT(s1.with_type(migraphx::shape::int8_type) ==
+           migraphx::shape{migraphx::shape::int8_type, {2, 3}});
+    EXPECT(s1.with_type(migraphx::shape::int8_type).bytes() == 6);
+}
+
 TEST_CASE(test_shape_min_max_opt)
 {
     migraphx::shape s{migraphx::shape::float_type, {2, 2, 3}, {6, 3, 1}};
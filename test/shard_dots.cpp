@@ -0,0 +1,182 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/shard_dots.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <test.hpp>
+
+static void run_pass(migraphx::program& p, std::size_t shards)
+{
+    migraphx::run_passes(p, {migraphx::shard_dots{shards}});
+}
+
+static std::size_t count(const migraphx::module& m, const std::string& name)
+{
+    return std::count_if(m.begin(), m.end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+static std::vector<float> run(migraphx::program p, std::size_t shards)
+{
+    std::vector<migraphx::target> targets(shards, migraphx::make_target("ref"));
+    if(shards == 1)
+        p.compile(targets.front());
+    else
+        p.compile(targets);
+    migraphx::parameter_map params;
+    for(auto&& [name, s] : p.get_parameter_shapes())
+        params[name] = migraphx::generate_argument(s);
+    std::vector<float> result;
+    p.eval(params).back().visit([&](auto output) { result.assign(output.begin(), output.end()); });
+    return result;
+}
+
+static void expect_same_result(const migraphx::program& p1, const migraphx::program& p2)
+{
+    EXPECT(migraphx::verify::verify_rms_range(run(p2, 2), run(p1, 1)));
+}
+
+TEST_CASE(shard_column)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 16}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", xs);
+        auto w   = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        mm->add_return({dot});
+    }
+    auto p2 = p1;
+    run_pass(p2, 2);
+    const auto* mm = p2.get_main_module();
+    EXPECT(count(*mm, "dot") == 0);
+    EXPECT(count(*mm, "run_on_target") == 2);
+    EXPECT(count(*mm, "all_gather") == 1);
+    EXPECT(count(*mm, "all_reduce") == 0);
+    EXPECT(p2.get_modules().size() == 3);
+    for(const auto* sm : p2.get_modules())
+    {
+        if(sm == mm)
+            continue;
+        EXPECT(sm->get_output_shapes().front().lens() == std::vector<std::size_t>{4, 8});
+    }
+    expect_same_result(p1, p2);
+}
+
+TEST_CASE(shard_mlp)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape w1s{migraphx::shape::float_type, {8, 16}};
+    migraphx::shape w2s{migraphx::shape::float_type, {16, 8}};
+    migraphx::shape bs{migraphx::shape::float_type, {16}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", xs);
+        auto w1   = mm->add_literal(migraphx::generate_literal(w1s, 1));
+        auto w2   = mm->add_literal(migraphx::generate_literal(w2s, 2));
+        auto b    = mm->add_literal(migraphx::generate_literal(bs, 3));
+        auto dot1 = mm->add_instruction(migraphx::make_op("dot"), x, w1);
+        auto bb   = mm->add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", {4, 16}}}), b);
+        auto add  = mm->add_instruction(migraphx::make_op("add"), dot1, bb);
+        auto relu = mm->add_instruction(migraphx::make_op("relu"), add);
+        auto dot2 = mm->add_instruction(migraphx::make_op("dot"), relu, w2);
+        mm->add_return({dot2});
+    }
+    auto p2 = p1;
+    run_pass(p2, 2);
+    const auto* mm = p2.get_main_module();
+    EXPECT(count(*mm, "dot") == 0);
+    EXPECT(count(*mm, "relu") == 0);
+    EXPECT(count(*mm, "run_on_target") == 2);
+    EXPECT(count(*mm, "all_gather") == 0);
+    EXPECT(count(*mm, "all_reduce") == 1);
+    expect_same_result(p1, p2);
+}
+
+TEST_CASE(shard_batched)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {2, 4, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 16}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", xs);
+        auto w   = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto bw  = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {2, 8, 16}}}), w);
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), x, bw);
+        mm->add_return({dot});
+    }
+    auto p2 = p1;
+    run_pass(p2, 2);
+    const auto* mm = p2.get_main_module();
+    EXPECT(count(*mm, "run_on_target") == 2);
+    EXPECT(count(*mm, "all_gather") == 1);
+    expect_same_result(p1, p2);
+}
+
+TEST_CASE(shard_uneven)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 15}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", xs);
+        auto w   = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        mm->add_return({dot});
+    }
+    auto p2 = p1;
+    run_pass(p2, 2);
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(shard_variable_weights)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 16}};
+    migraphx::program p1;
+    {
+        auto* mm = p1.get_main_module();
+        auto x   = mm->add_parameter("x", xs);
+        auto w   = mm->add_parameter("w", ws);
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        mm->add_return({dot});
+    }
+    auto p2 = p1;
+    run_pass(p2, 2);
+    EXPECT(p1 == p2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
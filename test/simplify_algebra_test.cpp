@@ -4333,4 +4333,71 @@ TEST_CASE(find_concat_different_broadcast_axes)
     EXPECT(m1.sort() == m2.sort());
 }
 
+TEST_CASE(simplify_image_preprocess_normalize)
+{
+    migraphx::shape s{migraphx::shape::uint8_type, {1, 4, 4, 3}};
+    migraphx::value v = {{"sizes", {2, 2}}, {"scales", {0.5, 0.5}}, {"mode", "linear"}};
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", s);
+        auto image = m1.add_instruction(migraphx::make_op("image_preprocess", v), x);
+        auto lens  = image->get_shape().lens();
+        auto mean  = m1.add_literal(migraphx::literal{{migraphx::shape::float_type, {3}},
+                                                      {0.485f, 0.456f, 0.406f}});
+        auto stddev = m1.add_literal(migraphx::literal{{migraphx::shape::float_type, {3}},
+                                                        {0.229f, 0.224f, 0.225f}});
+        auto scale  = m1.add_literal(migraphx::literal{{migraphx::shape::float_type, {1}}, {255}});
+        auto bscale = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", lens}}), scale);
+        auto bmean = m1.add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", lens}}), mean);
+        auto bstddev = m1.add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", lens}}), stddev);
+        auto div1 = m1.add_instruction(migraphx::make_op("div"), image, bscale);
+        auto sub  = m1.add_instruction(migraphx::make_op("sub"), div1, bmean);
+        auto div2 = m1.add_instruction(migraphx::make_op("div"), sub, bstddev);
+        m1.add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::half_type}}), div2);
+    }
+    run_pass(m1);
+
+    EXPECT(std::count_if(m1.begin(), m1.end(), [](const auto& ins) {
+               return ins.name() != "@param";
+           }) == 1);
+    auto image = std::find_if(
+        m1.begin(), m1.end(), [](const auto& ins) { return ins.name() == "image_preprocess"; });
+    EXPECT(bool{image != m1.end()});
+    EXPECT(image->get_shape().type() == migraphx::shape::half_type);
+    auto op     = image->get_operator().to_value();
+    auto mean   = op.at("mean").to_vector<float>();
+    auto stddev = op.at("stddev").to_vector<float>();
+    EXPECT(mean.size() == 3);
+    EXPECT(stddev.size() == 3);
+    EXPECT(std::abs(mean[0] / 255 - 0.485f) < 1e-6);
+    EXPECT(std::abs(stddev[2] / 255 - 0.225f) < 1e-6);
+}
+
+TEST_CASE(simplify_image_preprocess_not_per_channel)
+{
+    migraphx::shape s{migraphx::shape::uint8_type, {1, 4, 4, 3}};
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", s);
+        auto image = m1.add_instruction(
+            migraphx::make_op("image_preprocess", {{"sizes", {2, 2}}, {"scales", {0.5, 0.5}}}), x);
+        auto lens = image->get_shape().lens();
+        auto c    = m1.add_literal(migraphx::literal{{migraphx::shape::float_type, {2}}, {1, 2}});
+        auto bc   = m1.add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 3}, {"out_lens", lens}}), c);
+        m1.add_instruction(migraphx::make_op("sub"), image, bc);
+    }
+    run_pass(m1);
+
+    // The constant changes along the width, so it is not folded into the mean
+    auto image = std::find_if(
+        m1.begin(), m1.end(), [](const auto& ins) { return ins.name() == "image_preprocess"; });
+    EXPECT(bool{image != m1.end()});
+    EXPECT(image->get_operator().to_value().at("mean").empty());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
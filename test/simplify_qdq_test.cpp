@@ -1592,4 +1592,43 @@ TEST_CASE(dot_asymmetric_correctness)
     EXPECT(migraphx::verify::verify_rms_range(rv1, rv2));
 }
 
+TEST_CASE(int4_dequantize_transpose)
+{
+    migraphx::shape sx{migraphx::shape::float_type, {4, 16}};
+    migraphx::shape sw{migraphx::shape::uint8_type, {8, 8}};
+    migraphx::shape ss{migraphx::shape::float_type, {8, 16}};
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", sx);
+        auto w     = m1.add_parameter("w", sw);
+        auto scale = m1.add_parameter("scale", ss);
+        auto zp    = m1.add_parameter("zp", {migraphx::shape::uint8_type, {8, 16}});
+        auto perm  = migraphx::make_op("transpose", {{"permutation", {1, 0}}});
+        auto unpk  = m1.add_instruction(migraphx::make_op("unpack_int4"), w);
+        auto dq    = m1.add_instruction(migraphx::make_op("dequantizelinear"), unpk, scale, zp);
+        auto t     = m1.add_instruction(perm, dq);
+        auto dot   = m1.add_instruction(migraphx::make_op("dot"), x, t);
+        m1.add_return({dot});
+    }
+
+    migraphx::module m2;
+    {
+        auto x     = m2.add_parameter("x", sx);
+        auto w     = m2.add_parameter("w", sw);
+        auto scale = m2.add_parameter("scale", ss);
+        auto zp    = m2.add_parameter("zp", {migraphx::shape::uint8_type, {8, 16}});
+        auto perm  = migraphx::make_op("transpose", {{"permutation", {1, 0}}});
+        auto tw    = m2.add_instruction(perm, w);
+        auto unpk  = m2.add_instruction(migraphx::make_op("unpack_int4", {{"axis", 0}}), tw);
+        auto ts    = m2.add_instruction(perm, scale);
+        auto tzp   = m2.add_instruction(perm, zp);
+        auto dq    = m2.add_instruction(migraphx::make_op("dequantizelinear"), unpk, ts, tzp);
+        auto dot   = m2.add_instruction(migraphx::make_op("dot"), x, dq);
+        m2.add_return({dot});
+    }
+
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,177 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/split_pipeline_stages.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <test.hpp>
+
+static void run_pass(migraphx::program& p, std::size_t stages)
+{
+    migraphx::run_passes(p, {migraphx::split_pipeline_stages{stages}});
+}
+
+static std::size_t count(const migraphx::module& m, const std::string& name)
+{
+    return std::count_if(m.begin(), m.end(), [&](const auto& ins) { return ins.name() == name; });
+}
+
+static migraphx::program create_mlp(std::size_t layers)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 8}};
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", xs);
+    for(auto i : migraphx::range(layers))
+    {
+        auto w = mm->add_literal(migraphx::generate_literal(ws, i));
+        x      = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        x      = mm->add_instruction(migraphx::make_op("relu"), x);
+    }
+    mm->add_return({x});
+    return p;
+}
+
+static std::vector<migraphx::parameter_map> micro_batches(const migraphx::program& p,
+                                                          std::size_t n)
+{
+    std::vector<migraphx::parameter_map> result(n);
+    for(auto i : migraphx::range(n))
+    {
+        for(auto&& [name, s] : p.get_parameter_shapes())
+            result[i][name] = migraphx::generate_argument(s, i);
+    }
+    return result;
+}
+
+static std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> result;
+    arg.visit([&](auto output) { result.assign(output.begin(), output.end()); });
+    return result;
+}
+
+TEST_CASE(split_stages)
+{
+    auto p1 = create_mlp(4);
+    auto p2 = p1;
+    run_pass(p2, 2);
+    const auto* mm = p2.get_main_module();
+    EXPECT(count(*mm, "dot") == 0);
+    EXPECT(count(*mm, "run_on_target") == 2);
+    EXPECT(count(*mm, "@literal") == 0);
+    for(const auto* sm : p2.get_modules())
+    {
+        if(sm == mm)
+            continue;
+        EXPECT(count(*sm, "dot") == 2);
+        EXPECT(count(*sm, "@literal") == 2);
+    }
+
+    p1.compile(migraphx::make_target("ref"));
+    p2.compile({migraphx::make_target("ref"), migraphx::make_target("ref")});
+    auto batches = micro_batches(p1, 5);
+    auto results = p2.eval_pipeline(batches);
+    EXPECT(results.size() == batches.size());
+    for(auto i : migraphx::range(batches.size()))
+    {
+        auto gold = to_vector(p1.eval(batches[i]).back());
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i].back()), gold));
+    }
+}
+
+TEST_CASE(split_stages_skip_connection)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {4, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {8, 8}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", xs);
+        auto w1   = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto w2   = mm->add_literal(migraphx::generate_literal(ws, 2));
+        auto w3   = mm->add_literal(migraphx::generate_literal(ws, 3));
+        auto dot1 = mm->add_instruction(migraphx::make_op("dot"), x, w1);
+        auto dot2 = mm->add_instruction(migraphx::make_op("dot"), dot1, w2);
+        auto dot3 = mm->add_instruction(migraphx::make_op("dot"), dot2, w3);
+        auto add  = mm->add_instruction(migraphx::make_op("add"), dot3, dot1);
+        mm->add_return({add, dot2});
+    }
+    auto p2 = p1;
+    run_pass(p2, 3);
+    EXPECT(count(*p2.get_main_module(), "run_on_target") == 3);
+
+    p1.compile(migraphx::make_target("ref"));
+    std::vector<migraphx::target> targets(3, migraphx::make_target("ref"));
+    p2.compile(targets);
+    auto batches = micro_batches(p1, 4);
+    auto results = p2.eval_pipeline(batches);
+    for(auto i : migraphx::range(batches.size()))
+    {
+        auto gold = p1.eval(batches[i]);
+        EXPECT(results[i].size() == 2);
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i][0]), to_vector(gold[0])));
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i][1]), to_vector(gold[1])));
+    }
+}
+
+TEST_CASE(split_stages_too_small)
+{
+    auto p1 = create_mlp(1);
+    auto p2 = p1;
+    run_pass(p2, 3);
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(eval_pipeline_single_target)
+{
+    auto p = create_mlp(2);
+    p.compile(migraphx::make_target("ref"));
+    auto batches = micro_batches(p, 3);
+    auto results = p.eval_pipeline(batches);
+    for(auto i : migraphx::range(batches.size()))
+    {
+        auto gold = to_vector(p.eval(batches[i]).back());
+        EXPECT(migraphx::verify::verify_rms_range(to_vector(results[i].back()), gold));
+    }
+}
+
+TEST_CASE(eval_pipeline_error)
+{
+    auto p = create_mlp(4);
+    run_pass(p, 2);
+    p.compile({migraphx::make_target("ref"), migraphx::make_target("ref")});
+    auto batches = micro_batches(p, 4);
+    batches[1].clear();
+    EXPECT(test::throws([&] { p.eval_pipeline(batches); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -73,6 +73,50 @@ TEST_CASE(single)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(single_max)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3, 327680}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto rmax = mm->add_instruction(migraphx::make_op("reduce_max", {{"axes", {2}}}), x);
+        mm->add_return({rmax});
+    }
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm  = p2.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto rmax = add_reduce(
+            p2, "main:reduce_max0_split", {x}, {2}, "assign_max", single_reduce("reduce_max"));
+        mm->add_return({rmax});
+    }
+    EXPECT(p1 == p2);
+    auto split = std::find_if(p1.get_main_module()->begin(),
+                              p1.get_main_module()->end(),
+                              [](const auto& ins) { return ins.name() == "split_fused_reduce"; });
+    EXPECT(split->get_operator().attributes().at("prefill").to<float>() ==
+           -std::numeric_limits<float>::infinity());
+}
+
+TEST_CASE(half_max)
+{
+    migraphx::shape s{migraphx::shape::half_type, {2, 3, 327680}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto rmax = mm->add_instruction(migraphx::make_op("reduce_max", {{"axes", {2}}}), x);
+        mm->add_return({rmax});
+    }
+    migraphx::program p2 = p1;
+    run_fuse_pass(p2);
+    run_pass(p1);
+
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(fused)
 {
     migraphx::shape s{migraphx::shape::float_type, {2, 3, 327680}};
@@ -125,6 +169,27 @@ TEST_CASE(small)
     EXPECT(p1 == p2);
 }
 
+TEST_CASE(many_outputs)
+{
+    migraphx::shape s{migraphx::shape::float_type, {64, 3, 327680}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", s);
+        auto rsum = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {2}}}), x);
+        mm->add_return({rsum});
+    }
+    migraphx::program p2 = p1;
+    run_fuse_pass(p2);
+    migraphx::run_passes(p1,
+                         {migraphx::fuse_pointwise{},
+                          migraphx::fuse_reduce{},
+                          migraphx::split_reduce{.split_size = 8192, .max_outputs = 192},
+                          migraphx::dead_code_elimination{}});
+
+    EXPECT(p1 == p2);
+}
+
 TEST_CASE(split_pointwise)
 {
     migraphx::shape s{migraphx::shape::float_type, {2, 3, 327680}};
@@ -31,6 +31,7 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/builtin.hpp>
+#include <migraphx/ranges.hpp>
 #include <test.hpp>
 
 // Forward declare any_cast
@@ -101,6 +102,62 @@ TEST_CASE(dynamic_batch)
     EXPECT(p0 == p1);
 }
 
+TEST_CASE(dynamic_batch_optimals)
+{
+    // Only the optimal sizes and the max get a submodule
+    migraphx::program p0;
+    {
+        auto* mm0 = p0.get_main_module();
+
+        auto create_submodule = [&](std::size_t batch_size, const std::string& module_name) {
+            auto* submod = p0.create_module(module_name);
+            migraphx::shape sm_shape{migraphx::shape::float_type, {batch_size, 4}};
+            auto sm_input = submod->add_parameter("data", sm_shape);
+            migraphx::shape lit_s{migraphx::shape{migraphx::shape::float_type, {1}}};
+            auto literal_ins   = submod->add_literal(migraphx::literal{lit_s, {6}});
+            auto broadcast_lit =
+                submod->add_instruction(migraphx::make_op("multibroadcast"), literal_ins, sm_input);
+            auto add_ins =
+                submod->add_instruction(migraphx::make_op("add"), sm_input, broadcast_lit);
+            submod->add_return({add_ins});
+            return submod;
+        };
+        auto* dim2 = create_submodule(2, "dim_2");
+        auto* dim8 = create_submodule(8, "dim_8");
+
+        migraphx::shape s{migraphx::shape::float_type, {{1, 8, {2, 16}}, {4, 4}}};
+        auto input0                             = mm0->add_parameter("data", s);
+        std::vector<migraphx::shape> sub_shapes = {};
+        sub_shapes.push_back(
+            migraphx::shape{migraphx::shape::float_type, {{1, 8, {2, 16}}, {4, 4}}});
+        migraphx::shape out_attr = migraphx::shape{sub_shapes};
+        auto sm_ins              = mm0->add_instruction(
+            migraphx::make_op("select_module",
+                              {{"output_dyn_shapes", migraphx::to_value(out_attr)}}),
+            {input0},
+            {dim2, dim8});
+        auto ret =
+            mm0->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+        mm0->add_return({ret});
+    }
+
+    migraphx::program p1;
+    {
+        auto* mm1 = p1.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {{1, 8, {2, 16}}, {4, 4}}};
+        auto input1 = mm1->add_parameter("data", s);
+        migraphx::shape lit_s{migraphx::shape{migraphx::shape::float_type, {1}}};
+        auto literal_ins = mm1->add_literal(migraphx::literal{lit_s, {6}});
+        auto broadcast_lit =
+            mm1->add_instruction(migraphx::make_op("multibroadcast"), literal_ins, input1);
+        auto add_ins = mm1->add_instruction(migraphx::make_op("add"), input1, broadcast_lit);
+        mm1->add_return({add_ins});
+    }
+    run_pass(p1);
+
+    EXPECT(p0 == p1);
+}
+
 TEST_CASE(dynamic_batch_multiple_input)
 {
     migraphx::program p0;
@@ -294,6 +351,49 @@ TEST_CASE(different_non_fixed_dd)
     EXPECT(p0 == p1);
 }
 
+// softmax along a bucketed dimension ignores the padded positions
+TEST_CASE(bucketed_softmax_mask)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{1, 1}, {2, 8, {4, 8}}}};
+    auto input   = mm->add_parameter("scores", s);
+    auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", -1}}), input);
+    mm->add_return({softmax});
+    run_pass(p);
+
+    auto sm_ins = std::find_if(
+        mm->begin(), mm->end(), [&](auto&& ins) { return ins.name() == "select_module"; });
+    EXPECT(bool{sm_ins != mm->end()});
+    EXPECT(sm_ins->inputs().front()->name() == "dimensions_of");
+    for(auto* submod : sm_ins->module_inputs())
+    {
+        auto names = submod->get_parameter_names();
+        EXPECT(migraphx::contains(names, migraphx::split_single_dyn_dim::dim_size_name));
+        auto sm = std::find_if(submod->begin(), submod->end(), [](auto&& ins) {
+            return ins.name() == "softmax";
+        });
+        EXPECT(sm->inputs().front()->name() == "where");
+    }
+}
+
+TEST_CASE(bucketed_softmax_other_axis)
+{
+    // softmax along a fixed dimension needs no mask
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{2, 8, {4, 8}}, {4, 4}}};
+    auto input   = mm->add_parameter("scores", s);
+    auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), input);
+    mm->add_return({softmax});
+    run_pass(p);
+
+    auto sm_ins = std::find_if(
+        mm->begin(), mm->end(), [&](auto&& ins) { return ins.name() == "select_module"; });
+    EXPECT(sm_ins->inputs().size() == 1);
+    EXPECT(sm_ins->inputs().front()->name() == "@param");
+}
+
 // check that the parameter inputs into select_module are lexiographically ordered
 TEST_CASE(ordered_inputs_to_select_module)
 {
@@ -55,4 +55,19 @@ TEST_CASE(read_write)
     }
 }
 
+TEST_CASE(bound_parameters)
+{
+    migraphx::tmp_dir td{};
+    auto db = migraphx::sqlite::write(td.path / "test.db");
+    db.execute("CREATE TABLE test_db (key TEXT PRIMARY KEY NOT NULL, data TEXT NOT NULL);");
+    // Quotes in the values don't need to be escaped
+    const std::string key = R"({"name": "it's"})";
+    db.execute("INSERT INTO test_db (key, data) VALUES (?, ?);", {key, "'; DROP TABLE test_db;"});
+    auto rows = db.execute("SELECT data FROM test_db WHERE key = ?;", {key});
+    EXPECT(rows.size() == 1);
+    EXPECT(rows.front().at("data") == "'; DROP TABLE test_db;");
+    EXPECT(db.execute("SELECT data FROM test_db WHERE key = ?;", {"it's"}).empty());
+    EXPECT(test::throws([&] { db.execute("SELECT data FROM missing WHERE key = ?;", {key}); }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
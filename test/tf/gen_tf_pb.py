@@ -697,6 +697,21 @@ def variable_batch_test(g1):
         tf.identity(g1_input, name='identity')
 
 
+@tf_test
+def while_test(g1):
+    with g1.as_default():
+        g1_input = tf.compat.v1.placeholder(tf.float32,
+                                            shape=(2, 3),
+                                            name='0')
+        # control flow v2 emits a functional While with cond/body functions
+        tf.compat.v1.enable_control_flow_v2()
+        i = tf.constant(0)
+        tf.while_loop(lambda i, x: tf.less(i, 3),
+                      lambda i, x: (tf.add(i, 1), tf.add(x, x)),
+                      [i, g1_input],
+                      name='while')
+
+
 if __name__ == '__main__':
     add_test()
     addv2_test()
@@ -754,3 +769,4 @@ if __name__ == '__main__':
     tanh_test()
     transpose_test()
     variable_batch_test()
+    while_test()
@@ -0,0 +1,65 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <tf_test.hpp>
+
+TEST_CASE(while_test)
+{
+    migraphx::program p;
+
+    auto* mm = p.get_main_module();
+    auto l0  = mm->add_parameter("0", migraphx::shape{migraphx::shape::float_type, {2, 3}});
+    auto l1 =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int32_type}, {0}});
+
+    auto* body = p.create_module("while_while_body_8");
+    body->add_parameter("iteration_num", migraphx::shape{migraphx::shape::int64_type});
+    body->add_parameter("cond", migraphx::shape{migraphx::shape::bool_type});
+    auto i = body->add_parameter("var0", migraphx::shape{migraphx::shape::int32_type});
+    auto x = body->add_parameter("var1", migraphx::shape{migraphx::shape::float_type, {2, 3}});
+    auto one =
+        body->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int32_type}, {1}});
+    auto add   = body->add_instruction(migraphx::make_op("add"), i, one);
+    auto add_1 = body->add_instruction(migraphx::make_op("add"), x, x);
+    auto three =
+        body->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int32_type}, {3}});
+    auto less = body->add_instruction(migraphx::make_op("less"), add, three);
+    auto cond = body->add_instruction(migraphx::make_op("identity"), less);
+    body->add_return({cond, add, add_1});
+
+    auto l3 = mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int32_type}, {3}});
+    auto init_less = mm->add_instruction(migraphx::make_op("less"), l1, l3);
+    auto init_cond = mm->add_instruction(migraphx::make_op("identity"), init_less);
+    auto max_iter =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int64_type}, {10}});
+    auto loop = mm->add_instruction(migraphx::make_op("loop", {{"max_iterations", 10}}),
+                                    {max_iter, init_cond, l1, l0},
+                                    {body});
+    mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+    auto r = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), loop);
+    mm->add_instruction(migraphx::make_op("identity"), r);
+    auto prog = optimize_tf("while_test.pb", false);
+
+    EXPECT(p == prog);
+}
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/thread_pool.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/simple_par_for.hpp>
+#include <atomic>
+#include <numeric>
+#include <vector>
+#include <test.hpp>
+
+TEST_CASE(run_all_tasks)
+{
+    migraphx::thread_pool pool{4};
+    EXPECT(pool.size() == 4);
+    std::vector<std::size_t> counts(1000);
+    pool.run(counts.size(), [&](std::size_t i) { counts[i]++; });
+    EXPECT(std::all_of(counts.begin(), counts.end(), [](auto c) { return c == 1; }));
+}
+
+TEST_CASE(run_repeated)
+{
+    migraphx::thread_pool pool{3};
+    std::atomic<std::size_t> sum{0};
+    for(std::size_t k = 0; k < 100; k++)
+        pool.run(10, [&](std::size_t i) { sum += i; });
+    EXPECT(sum.load() == 4500);
+}
+
+TEST_CASE(run_nested)
+{
+    migraphx::thread_pool pool{4};
+    std::atomic<std::size_t> count{0};
+    pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { count++; }); });
+    EXPECT(count.load() == 64);
+}
+
+TEST_CASE(run_exception)
+{
+    migraphx::thread_pool pool{4};
+    std::atomic<std::size_t> count{0};
+    EXPECT(test::throws([&] {
+        pool.run(16, [&](std::size_t i) {
+            count++;
+            if(i == 5)
+                MIGRAPHX_THROW("task failed");
+        });
+    }));
+    EXPECT(count.load() == 16);
+}
+
+TEST_CASE(single_thread)
+{
+    migraphx::thread_pool pool{1};
+    EXPECT(pool.size() == 1);
+    std::vector<std::size_t> order;
+    pool.run(4, [&](std::size_t i) { order.push_back(i); });
+    EXPECT(order == std::vector<std::size_t>{0, 1, 2, 3});
+}
+
+TEST_CASE(simple_par_for_thread_ids)
+{
+    std::vector<std::size_t> tids(1024);
+    migraphx::simple_par_for(
+        tids.size(), 8, [&](std::size_t i, std::size_t tid) { tids[i] = tid; });
+    EXPECT(std::is_sorted(tids.begin(), tids.end()));
+    EXPECT(tids.back() < migraphx::get_thread_pool().size());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
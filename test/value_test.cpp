@@ -172,6 +172,25 @@ TEST_CASE(value_copy_assign)
     EXPECT(v1 == v2);
 }
 
+TEST_CASE(value_move_construct)
+{
+    migraphx::value v1("key", std::vector<int>{1, 2, 3});
+    migraphx::value v2 = v1;
+    migraphx::value v3 = std::move(v2);
+    EXPECT(v3 == v1);
+    EXPECT(v3.get_key() == "key");
+}
+
+TEST_CASE(value_move_vector)
+{
+    std::vector<migraphx::value> x = {{"a", 1}, {"b", 2}};
+    migraphx::value v1(x);
+    migraphx::value v2(std::move(x));
+    EXPECT(v1 == v2);
+    EXPECT(v2.is_object());
+    EXPECT(v2.at("b").to<int>() == 2);
+}
+
 TEST_CASE(value_reassign)
 {
     migraphx::value v1(1);
@@ -958,4 +977,50 @@ TEST_CASE(value_get_default_string_literal_vector)
     EXPECT(v.get("missing", {"none"}) == fallback);
 }
 
+TEST_CASE(value_copy_mutate)
+{
+    migraphx::value v1 = {{"a", 1}, {"b", {1, 2, 3}}};
+    migraphx::value v2 = v1;
+    v2["a"]            = 5;
+    v2.at("b").push_back(4);
+    EXPECT(v1.at("a").to<int>() == 1);
+    EXPECT(v1.at("b").size() == 3);
+    EXPECT(v2.at("a").to<int>() == 5);
+    EXPECT(v2.at("b").size() == 4);
+    EXPECT(v1 != v2);
+}
+
+TEST_CASE(value_copy_after_mutable_ref)
+{
+    migraphx::value v1 = {{"a", 1}, {"b", 2}};
+    migraphx::value& a = v1["a"];
+    migraphx::value v2 = v1;
+    a                  = 3;
+    EXPECT(v1.at("a").to<int>() == 3);
+    EXPECT(v2.at("a").to<int>() == 1);
+}
+
+TEST_CASE(value_copy_insert_shared_pos)
+{
+    migraphx::value v1       = {1, 2, 3};
+    migraphx::value v2       = v1;
+    const migraphx::value& c = v2;
+    v2.insert(c.begin() + 1, 5);
+    EXPECT(v1.to_vector<int>() == std::vector<int>{1, 2, 3});
+    EXPECT(v2.to_vector<int>() == std::vector<int>{1, 5, 2, 3});
+}
+
+TEST_CASE(value_copy_compare_hash)
+{
+    std::vector<std::uint8_t> data = {1, 2, 3};
+    migraphx::value v1             = {{"a", 1}, {"b", migraphx::value::binary{data}}};
+    migraphx::value v2 = v1;
+    EXPECT(v1 == v2);
+    EXPECT(v1.hash() == v2.hash());
+    EXPECT(v1.with_key("x") != v2);
+    data.back() = 4;
+    v2["b"]     = migraphx::value::binary{data};
+    EXPECT(v1 != v2);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -41,6 +41,7 @@ struct test_abs : verify_program<test_abs<DType>>
 };
 
 template struct test_abs<migraphx::shape::half_type>;
+template struct test_abs<migraphx::shape::bf16_type>;
 template struct test_abs<migraphx::shape::float_type>;
 template struct test_abs<migraphx::shape::fp8e4m3fnuz_type>;
 template struct test_abs<migraphx::shape::fp8e4m3fn_type>;
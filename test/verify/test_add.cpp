@@ -43,6 +43,7 @@ struct test_add : verify_program<test_add<DType>>
 };
 
 template struct test_add<migraphx::shape::half_type>;
+template struct test_add<migraphx::shape::bf16_type>;
 template struct test_add<migraphx::shape::float_type>;
 template struct test_add<migraphx::shape::fp8e4m3fnuz_type>;
 template struct test_add<migraphx::shape::fp8e4m3fn_type>;
@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType>
+struct test_attention_causal : verify_program<test_attention_causal<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm        = p.get_main_module();
+        std::size_t seq = 300;
+        migraphx::shape s{DType, {2, 4, seq, 64}};
+        migraphx::shape ms{migraphx::shape::bool_type, {seq, seq}};
+        std::vector<char> mask(ms.elements());
+        for(std::size_t i = 0; i < seq; i++)
+        {
+            for(std::size_t j = 0; j < seq; j++)
+                mask[i * seq + j] = j <= i ? 1 : 0;
+        }
+        auto q     = mm->add_parameter("q", s);
+        auto k     = mm->add_parameter("k", s);
+        auto v     = mm->add_parameter("v", s);
+        auto kt    = mm->add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 1, 3, 2}}}), k);
+        auto gemm1 = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto lens  = gemm1->get_shape().lens();
+        auto scale = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", lens}}),
+                                         mm->add_literal(migraphx::literal{{DType, {1}}, {0.125}}));
+        auto cond  = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", lens}}),
+                                        mm->add_literal(migraphx::literal{ms, mask}));
+        auto ninf  = mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", lens}}),
+                                        mm->add_literal(migraphx::literal{{DType, {1}}, {-1e4}}));
+        auto mul   = mm->add_instruction(migraphx::make_op("mul"), gemm1, scale);
+        auto where = mm->add_instruction(migraphx::make_op("where"), cond, mul, ninf);
+        auto sm    = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), where);
+        mm->add_instruction(migraphx::make_op("dot"), sm, v);
+        return p;
+    }
+    std::string section() const { return "gemm"; }
+};
+
+template struct test_attention_causal<migraphx::shape::float_type>;
+template struct test_attention_causal<migraphx::shape::half_type>;
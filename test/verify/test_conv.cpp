@@ -43,6 +43,7 @@ struct test_conv : verify_program<test_conv<DType>>
 };
 
 template struct test_conv<migraphx::shape::float_type>;
+template struct test_conv<migraphx::shape::bf16_type>;
 template struct test_conv<migraphx::shape::fp8e4m3fnuz_type>;
 template struct test_conv<migraphx::shape::fp8e4m3fn_type>;
 template struct test_conv<migraphx::shape::fp8e5m2_type>;
@@ -0,0 +1,64 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType, bool Int4>
+struct test_dequant_dot : verify_program<test_dequant_dot<DType, Int4>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm      = p.get_main_module();
+        std::size_t k = 128;
+        std::size_t n = 48;
+        migraphx::shape ws{migraphx::shape::uint8_type, {k, Int4 ? n / 2 : n}};
+        migraphx::shape us{DType, {k, n}};
+        auto x = mm->add_parameter("x", migraphx::shape{DType, {4, k}});
+        auto w = mm->add_literal(migraphx::generate_literal(ws, 3));
+        if(Int4)
+            w = mm->add_instruction(migraphx::make_op("unpack_int4", {{"axis", 1}}), w);
+
+        // One scale for each group of 32 rows of the weights
+        auto scale = mm->add_literal(migraphx::generate_literal({DType, {k / 32, 1, n}}, 1));
+        scale      = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {k / 32, 32, n}}}), scale);
+        scale = mm->add_instruction(migraphx::make_op("contiguous"), scale);
+        scale = mm->add_instruction(migraphx::make_op("reshape", {{"dims", us.lens()}}), scale);
+
+        auto zp  = mm->add_literal(migraphx::literal{{migraphx::shape::uint8_type}, {8}});
+        zp       = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", us.lens()}}), zp);
+        auto dq  = mm->add_instruction(migraphx::make_op("dequantizelinear"), w, scale, zp);
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), x, dq);
+        mm->add_return({dot});
+        return p;
+    }
+};
+
+template struct test_dequant_dot<migraphx::shape::float_type, true>;
+template struct test_dequant_dot<migraphx::shape::half_type, true>;
+template struct test_dequant_dot<migraphx::shape::float_type, false>;
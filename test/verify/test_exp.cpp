@@ -43,6 +43,7 @@ struct test_exp : verify_program<test_exp<DType>>
 
 template struct test_exp<migraphx::shape::float_type>;
 template struct test_exp<migraphx::shape::half_type>;
+template struct test_exp<migraphx::shape::bf16_type>;
 template struct test_exp<migraphx::shape::fp8e4m3fnuz_type>;
 template struct test_exp<migraphx::shape::fp8e4m3fn_type>;
 template struct test_exp<migraphx::shape::fp8e5m2_type>;
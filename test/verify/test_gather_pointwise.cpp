@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_gather_pointwise : verify_program<test_gather_pointwise>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape ws{migraphx::shape::float_type, {32, 8}};
+        migraphx::shape s_indices{migraphx::shape::int32_type, {2, 5}};
+        migraphx::shape ps{migraphx::shape::float_type, {2, 5, 8}};
+        std::vector<int> indices{0, 31, -1, 4, 17, 9, 9, 2, -32, 23};
+        auto w      = mm->add_parameter("w", ws);
+        auto ind    = mm->add_literal(migraphx::literal{s_indices, indices});
+        auto pos    = mm->add_parameter("pos", ps);
+        auto gather = mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), w, ind);
+        auto scale  = mm->add_literal(2.0f);
+        auto mscale = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", ps.lens()}}), scale);
+        auto mul = mm->add_instruction(migraphx::make_op("mul"), gather, mscale);
+        auto add = mm->add_instruction(migraphx::make_op("add"), mul, pos);
+        mm->add_instruction(migraphx::make_op("relu"), add);
+        return p;
+    }
+};
@@ -50,6 +50,7 @@ struct test_gemm_2args_mm_1 : verify_program<test_gemm_2args_mm_1<DType>>
 
 template struct test_gemm_2args_mm_1<migraphx::shape::float_type>;
 template struct test_gemm_2args_mm_1<migraphx::shape::half_type>;
+template struct test_gemm_2args_mm_1<migraphx::shape::bf16_type>;
 template struct test_gemm_2args_mm_1<migraphx::shape::fp8e4m3fnuz_type>;
 template struct test_gemm_2args_mm_1<migraphx::shape::fp8e4m3fn_type>;
 template struct test_gemm_2args_mm_1<migraphx::shape::fp8e5m2_type>;
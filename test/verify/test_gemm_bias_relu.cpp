@@ -0,0 +1,50 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType>
+struct test_gemm_bias_relu : verify_program<test_gemm_bias_relu<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto x   = mm->add_parameter("x", migraphx::shape{DType, {32, 64}});
+        auto w   = mm->add_literal(migraphx::generate_literal({DType, {64, 128}}, 1));
+        auto b   = mm->add_literal(migraphx::generate_literal({DType, {128}}, 2));
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), x, w);
+        auto bb =
+            mm->add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", {32, 128}}}), b);
+        auto add  = mm->add_instruction(migraphx::make_op("add"), dot, bb);
+        auto relu = mm->add_instruction(migraphx::make_op("relu"), add);
+        mm->add_return({relu});
+        return p;
+    }
+};
+
+template struct test_gemm_bias_relu<migraphx::shape::float_type>;
+template struct test_gemm_bias_relu<migraphx::shape::half_type>;
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType>
+struct test_gridsample : verify_program<test_gridsample<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto x    = mm->add_parameter("x", {DType, {2, 3, 8, 10}});
+        auto grid = mm->add_parameter("grid", {DType, {2, 5, 6, 2}});
+        for(const std::string mode : {"nearest", "linear", "cubic"})
+        {
+            for(const std::string padding : {"zeros", "border", "reflection"})
+            {
+                for(bool align_corners : {false, true})
+                {
+                    mm->add_instruction(migraphx::make_op("gridsample",
+                                                          {{"mode", mode},
+                                                           {"padding_mode", padding},
+                                                           {"align_corners", align_corners}}),
+                                        x,
+                                        grid);
+                }
+            }
+        }
+        return p;
+    }
+};
+
+template struct test_gridsample<migraphx::shape::float_type>;
+template struct test_gridsample<migraphx::shape::half_type>;
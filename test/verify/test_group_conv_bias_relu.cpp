@@ -0,0 +1,82 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType>
+struct test_depthwise_conv_bias_relu : verify_program<test_depthwise_conv_bias_relu<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm     = p.get_main_module();
+        auto input   = mm->add_parameter("x", migraphx::shape{DType, {2, 32, 14, 14}});
+        auto weights = mm->add_literal(migraphx::generate_literal({DType, {32, 1, 3, 3}}, 1));
+        auto bias    = mm->add_literal(migraphx::generate_literal({DType, {32}}, 2));
+        auto conv    = mm->add_instruction(
+            migraphx::make_op("convolution",
+                              {{"padding", {1, 1}}, {"stride", {2, 2}}, {"group", 32}}),
+            input,
+            weights);
+        auto bcast_bias = mm->add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", conv->get_shape().lens()}}),
+            bias);
+        auto bias_add = mm->add_instruction(migraphx::make_op("add"), conv, bcast_bias);
+        mm->add_instruction(migraphx::make_op("relu"), bias_add);
+        return p;
+    }
+    std::string section() const { return "conv"; }
+};
+
+template struct test_depthwise_conv_bias_relu<migraphx::shape::float_type>;
+template struct test_depthwise_conv_bias_relu<migraphx::shape::half_type>;
+
+// Grouped convolution with several channels in each group on nhwc tensors
+struct test_group_conv_nhwc_bias : verify_program<test_group_conv_nhwc_bias>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {1, 16, 9, 9}});
+        auto w   = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {24, 4, 5, 5}}, 1));
+        auto bias     = mm->add_parameter("b", {migraphx::shape::float_type, {24}});
+        auto layout_x = mm->add_instruction(
+            migraphx::make_op("layout", {{"permutation", {0, 2, 3, 1}}}), x);
+        auto conv = mm->add_instruction(
+            migraphx::make_op("convolution",
+                              {{"padding", {2, 2, 1, 1}}, {"dilation", {1, 2}}, {"group", 4}}),
+            layout_x,
+            w);
+        auto bcast_bias = mm->add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", conv->get_shape().lens()}}),
+            bias);
+        mm->add_instruction(migraphx::make_op("add"), conv, bcast_bias);
+        return p;
+    }
+    std::string section() const { return "conv"; }
+};
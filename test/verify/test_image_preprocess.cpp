@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType>
+struct test_image_preprocess : verify_program<test_image_preprocess<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::uint8_type, {2, 48, 64, 3}};
+        auto x = mm->add_parameter("x", s);
+        mm->add_instruction(migraphx::make_op("image_preprocess",
+                                              {{"sizes", {32, 40}},
+                                               {"scales", {32.0 / 48, 40.0 / 64}},
+                                               {"mode", "linear"},
+                                               {"mean", {123.675, 116.28, 103.53}},
+                                               {"stddev", {58.395, 57.12, 57.375}},
+                                               {"type", DType}}),
+                            x);
+        mm->add_instruction(migraphx::make_op("image_preprocess",
+                                              {{"sizes", {96, 100}},
+                                               {"scales", {2.0, 100.0 / 64}},
+                                               {"nearest_mode", "floor"},
+                                               {"coordinate_transformation_mode", "asymmetric"},
+                                               {"type", DType}}),
+                            x);
+        return p;
+    }
+};
+
+template struct test_image_preprocess<migraphx::shape::float_type>;
+template struct test_image_preprocess<migraphx::shape::half_type>;
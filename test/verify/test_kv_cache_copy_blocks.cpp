@@ -0,0 +1,54 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// Give two beams their own copy of a shared block, then append to the cache
+struct test_kv_cache_copy_blocks : verify_program<test_kv_cache_copy_blocks>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape cs{migraphx::shape::float_type, {6, 4, 2, 16}};
+        migraphx::shape us{migraphx::shape::float_type, {3, 1, 2, 16}};
+        migraphx::shape ps{migraphx::shape::int32_type, {3, 2}};
+        migraphx::shape ts{migraphx::shape::int32_type, {3, 2}};
+        migraphx::shape ls{migraphx::shape::int32_type, {3}};
+        std::vector<int32_t> copies{-1, -1, 1, 3, 1, 5};
+        std::vector<int32_t> table{0, 1, 0, 3, 0, 5};
+        std::vector<int32_t> positions{6, 6, 6};
+
+        auto cache = mm->add_parameter("cache", cs);
+        auto key   = mm->add_parameter("key", us);
+        auto c     = mm->add_literal(migraphx::literal{ps, copies});
+        auto t     = mm->add_literal(migraphx::literal{ts, table});
+        auto pos   = mm->add_literal(migraphx::literal{ls, positions});
+        auto kc    = mm->add_instruction(migraphx::make_op("kv_cache_copy_blocks"), cache, c);
+        mm->add_instruction(migraphx::make_op("kv_cache_update"), kc, key, t, pos);
+        return p;
+    }
+};
@@ -167,6 +167,22 @@ struct test_layernorm_triadd_large : verify_program<test_layernorm_triadd_large>
     }
 };
 
+struct test_layernorm_residual : verify_program<test_layernorm_residual>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm                 = p.get_main_module();
+        std::vector<size_t> dims = {1, 384, 1024};
+        auto x   = mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, dims});
+        auto y   = mm->add_parameter("y", migraphx::shape{migraphx::shape::float_type, dims});
+        auto add = mm->add_instruction(migraphx::make_op("add"), x, y);
+        auto layernorm_ins = add_layernorm(*mm, add, dims);
+        mm->add_return({layernorm_ins, add});
+        return p;
+    }
+};
+
 struct test_add_layernorm_add_gemm_nonstd : verify_program<test_add_layernorm_add_gemm_nonstd>
 {
     migraphx::program create_program() const
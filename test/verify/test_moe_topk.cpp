@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2025 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// Mixture of experts computed densely for every expert and masked by the top-2 gates
+template <migraphx::shape::type_t DType>
+struct test_moe_topk : verify_program<test_moe_topk<DType>>
+{
+    migraphx::program create_program() const
+    {
+        const std::size_t tokens  = 8;
+        const std::size_t hidden  = 32;
+        const std::size_t experts = 4;
+        const std::size_t n       = 16;
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto x   = mm->add_parameter("x", migraphx::shape{DType, {tokens, hidden}});
+        auto wg  = mm->add_literal(migraphx::generate_literal({DType, {hidden, experts}}, 1));
+        auto w   = mm->add_literal(migraphx::generate_literal({DType, {experts, hidden, n}}, 2));
+        auto zeros =
+            mm->add_literal(migraphx::literal{migraphx::shape{DType, {tokens, experts}},
+                                              std::vector<float>(tokens * experts, 0.0f)});
+        auto logits = mm->add_instruction(migraphx::make_op("dot"), x, wg);
+        auto probs  = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), logits);
+        auto topk   = mm->add_instruction(
+            migraphx::make_op("topk", {{"k", 2}, {"axis", 1}, {"largest", 1}}), probs);
+        auto values =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), topk);
+        auto indices =
+            mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), topk);
+        auto gates = mm->add_instruction(
+            migraphx::make_op("scatter_none", {{"axis", 1}}), zeros, indices, values);
+        gates = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}),
+                                    gates);
+        gates = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {2}}}), gates);
+        gates = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {experts, tokens, n}}}), gates);
+        auto xb = mm->add_instruction(migraphx::make_op("unsqueeze", {{"axes", {0}}}), x);
+        xb      = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {experts, tokens, hidden}}}), xb);
+        auto dot = mm->add_instruction(migraphx::make_op("dot"), xb, w);
+        auto mul = mm->add_instruction(migraphx::make_op("mul"), dot, gates);
+        auto sum = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {0}}}), mul);
+        mm->add_instruction(migraphx::make_op("squeeze", {{"axes", {0}}}), sum);
+        return p;
+    }
+    std::string section() const { return "gemm"; }
+};
+
+template struct test_moe_topk<migraphx::shape::float_type>;
+template struct test_moe_topk<migraphx::shape::half_type>;
@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// One decode step: append the new key and value to the paged cache and attend over it
+struct test_paged_decode : verify_program<test_paged_decode>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {2, 1, 4, 32}};
+        migraphx::shape us{migraphx::shape::float_type, {2, 1, 4, 32}};
+        migraphx::shape cs{migraphx::shape::float_type, {6, 8, 4, 32}};
+        migraphx::shape ts{migraphx::shape::int32_type, {2, 3}};
+        migraphx::shape ls{migraphx::shape::int32_type, {2}};
+        std::vector<int32_t> table{4, 0, -1, 2, 5, 1};
+        std::vector<int32_t> positions{9, 20};
+        std::vector<int32_t> context_lens{10, 21};
+
+        auto query       = mm->add_parameter("query", qs);
+        auto key         = mm->add_parameter("key", us);
+        auto value       = mm->add_parameter("value", us);
+        auto key_cache   = mm->add_parameter("key_cache", cs);
+        auto value_cache = mm->add_parameter("value_cache", cs);
+        auto block_table = mm->add_literal(migraphx::literal{ts, table});
+        auto pos         = mm->add_literal(migraphx::literal{ls, positions});
+        auto lens        = mm->add_literal(migraphx::literal{ls, context_lens});
+        auto kc = mm->add_instruction(
+            migraphx::make_op("kv_cache_update"), key_cache, key, block_table, pos);
+        auto vc = mm->add_instruction(
+            migraphx::make_op("kv_cache_update"), value_cache, value, block_table, pos);
+        mm->add_instruction(migraphx::make_op("paged_attention"), query, kc, vc, block_table, lens);
+        return p;
+    }
+};
@@ -0,0 +1,70 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// One decode step with the key and value caches stored in a quantized type with per-head scales
+template <migraphx::shape::type_t CacheType>
+struct test_paged_decode_quantized : verify_program<test_paged_decode_quantized<CacheType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {2, 1, 4, 32}};
+        migraphx::shape us{migraphx::shape::float_type, {2, 1, 2, 32}};
+        migraphx::shape cs{CacheType, {6, 8, 2, 32}};
+        migraphx::shape ts{migraphx::shape::int32_type, {2, 3}};
+        migraphx::shape ls{migraphx::shape::int32_type, {2}};
+        migraphx::shape ss{migraphx::shape::float_type, {2}};
+        std::vector<int32_t> table{4, 0, -1, 2, 5, 1};
+        std::vector<int32_t> positions{9, 20};
+        std::vector<int32_t> context_lens{10, 21};
+        std::vector<float> key_scales{0.02f, 0.03f};
+        std::vector<float> value_scales{0.05f, 0.04f};
+
+        auto query       = mm->add_parameter("query", qs);
+        auto key         = mm->add_parameter("key", us);
+        auto value       = mm->add_parameter("value", us);
+        auto key_cache   = mm->add_parameter("key_cache", cs);
+        auto value_cache = mm->add_parameter("value_cache", cs);
+        auto block_table = mm->add_literal(migraphx::literal{ts, table});
+        auto pos         = mm->add_literal(migraphx::literal{ls, positions});
+        auto lens        = mm->add_literal(migraphx::literal{ls, context_lens});
+        auto ks          = mm->add_literal(migraphx::literal{ss, key_scales});
+        auto vs          = mm->add_literal(migraphx::literal{ss, value_scales});
+        auto kc          = mm->add_instruction(
+            migraphx::make_op("kv_cache_update"), key_cache, key, block_table, pos, ks);
+        auto vc = mm->add_instruction(
+            migraphx::make_op("kv_cache_update"), value_cache, value, block_table, pos, vs);
+        mm->add_instruction(
+            migraphx::make_op("paged_attention"), query, kc, vc, block_table, lens, ks, vs);
+        return p;
+    }
+};
+
+template struct test_paged_decode_quantized<migraphx::shape::int8_type>;
+template struct test_paged_decode_quantized<migraphx::shape::fp8e4m3fn_type>;
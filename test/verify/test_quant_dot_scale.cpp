@@ -0,0 +1,57 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/float8.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <typename DType>
+struct test_quant_dot_scale : verify_program<test_quant_dot_scale<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm   = p.get_main_module();
+        auto dtype = migraphx::shape::get_type<DType>();
+        migraphx::shape m1_shape{dtype, {16, 32}};
+        migraphx::shape m2_shape{dtype, {32, 64}};
+
+        auto l1    = mm->add_parameter("a", m1_shape);
+        auto l2    = mm->add_parameter("b", m2_shape);
+        auto scale = mm->add_parameter("scale", {migraphx::shape::float_type, {1}});
+        auto dot   = mm->add_instruction(migraphx::make_op("quant_dot"), l1, l2);
+        scale      = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", {16, 64}}}), scale);
+        auto mul = mm->add_instruction(migraphx::make_op("mul"), dot, scale);
+        mm->add_return({mul});
+        return p;
+    }
+    std::string section() const { return "gemm"; }
+};
+
+template struct test_quant_dot_scale<migraphx::fp8::fp8e4m3fnuz>;
+template struct test_quant_dot_scale<migraphx::fp8::fp8e4m3fn>;
+template struct test_quant_dot_scale<migraphx::fp8::fp8e5m2>;
@@ -0,0 +1,49 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// All of the probability is in one class, so every sample is the same regardless of the random
+// values
+struct test_random_multinomial : verify_program<test_random_multinomial>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm           = p.get_main_module();
+        size_t sample_size = 10;
+        size_t batch_size  = 2;
+        migraphx::shape s{migraphx::shape::float_type, {batch_size, 5}};
+        auto cdf = mm->add_literal(migraphx::literal{s, {0, 0, 1, 1, 1, 0, 0, 0, 0, 1}});
+        migraphx::shape rs{migraphx::shape::float_type, {batch_size, sample_size}};
+        auto buffer  = mm->add_literal(migraphx::literal{rs, std::vector<float>(rs.elements())});
+        auto seed    = mm->add_instruction(migraphx::make_op("random_seed"));
+        auto randoms = mm->add_instruction(migraphx::make_op("random_uniform"), seed, buffer);
+        auto r       = mm->add_instruction(migraphx::make_op("multinomial"), cdf, randoms);
+        mm->add_return({r});
+        return p;
+    }
+};
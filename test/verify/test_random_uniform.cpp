@@ -0,0 +1,57 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// The generators differ between targets, so only check that every value is in [0, 1]. The upper
+// bound is inclusive since the reference rounds its doubles to the output type.
+template <migraphx::shape::type_t DType>
+struct test_random_uniform : verify_program<test_random_uniform<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{DType, {4, 1024}};
+        auto buffer  = mm->add_literal(migraphx::literal{s, std::vector<float>(s.elements())});
+        auto seed    = mm->add_instruction(migraphx::make_op("random_seed"));
+        auto randoms = mm->add_instruction(migraphx::make_op("random_uniform"), seed, buffer);
+        auto bcast   = [&](float x) {
+            auto l = mm->add_literal(migraphx::literal{migraphx::shape{DType}, {x}});
+            return mm->add_instruction(
+                migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), l);
+        };
+        auto above_one = mm->add_instruction(migraphx::make_op("greater"), randoms, bcast(1));
+        auto negative  = mm->add_instruction(migraphx::make_op("less"), randoms, bcast(0));
+        auto outside   = mm->add_instruction(migraphx::make_op("logical_or"), above_one, negative);
+        auto r         = mm->add_instruction(migraphx::make_op("not"), outside);
+        mm->add_return({r});
+        return p;
+    }
+};
+
+template struct test_random_uniform<migraphx::shape::float_type>;
+template struct test_random_uniform<migraphx::shape::half_type>;
@@ -0,0 +1,68 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <layernorm.hpp>
+
+template <migraphx::shape::type_t DType, std::size_t Hidden>
+struct test_rms_norm : verify_program<test_rms_norm<DType, Hidden>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm                 = p.get_main_module();
+        std::vector<size_t> dims = {2, 16, Hidden};
+        auto x                   = mm->add_parameter("x", migraphx::shape{DType, dims});
+        add_rms_norm(*mm, x, dims);
+        return p;
+    }
+};
+
+template struct test_rms_norm<migraphx::shape::float_type, 64>;
+template struct test_rms_norm<migraphx::shape::half_type, 1024>;
+template struct test_rms_norm<migraphx::shape::float_type, 8192>;
+
+template <migraphx::shape::type_t DType>
+struct test_add_rms_norm_residual : verify_program<test_add_rms_norm_residual<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm                 = p.get_main_module();
+        std::vector<size_t> dims = {1, 384, 1024};
+        auto x                   = mm->add_parameter("x", migraphx::shape{DType, dims});
+        auto y                   = mm->add_parameter("y", migraphx::shape{DType, dims});
+        auto add                 = mm->add_instruction(migraphx::make_op("add"), x, y);
+        auto rms_norm            = add_rms_norm(*mm, add, dims);
+        mm->add_return({rms_norm, add});
+        return p;
+    }
+};
+
+template struct test_add_rms_norm_residual<migraphx::shape::float_type>;
+template struct test_add_rms_norm_residual<migraphx::shape::half_type>;
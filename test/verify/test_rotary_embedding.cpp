@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// Rotary embedding as exported, with the rotation done by slices, a neg and a concat
+template <migraphx::shape::type_t DType>
+struct test_rotary_embedding : verify_program<test_rotary_embedding<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::shape s{DType, {2, 4, 8, 32}};
+        migraphx::program p;
+        auto* mm   = p.get_main_module();
+        auto x     = mm->add_parameter("x", s);
+        auto c     = mm->add_literal(migraphx::generate_literal({DType, {8, 32}}, 1));
+        auto sn    = mm->add_literal(migraphx::generate_literal({DType, {8, 32}}, 2));
+        auto lower = mm->add_instruction(
+            migraphx::make_op("slice", {{"axes", {-1}}, {"starts", {0}}, {"ends", {16}}}), x);
+        auto upper = mm->add_instruction(
+            migraphx::make_op("slice", {{"axes", {-1}}, {"starts", {16}}, {"ends", {32}}}), x);
+        auto neg    = mm->add_instruction(migraphx::make_op("neg"), upper);
+        auto rotate = mm->add_instruction(migraphx::make_op("concat", {{"axis", -1}}), neg, lower);
+        auto cb     = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), c);
+        auto sb = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", s.lens()}}), sn);
+        auto mul_cos = mm->add_instruction(migraphx::make_op("mul"), x, cb);
+        auto mul_sin = mm->add_instruction(migraphx::make_op("mul"), rotate, sb);
+        mm->add_instruction(migraphx::make_op("add"), mul_cos, mul_sin);
+        return p;
+    }
+};
+
+template struct test_rotary_embedding<migraphx::shape::float_type>;
+template struct test_rotary_embedding<migraphx::shape::half_type>;
@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// More updates than output elements, so the updates are sorted and reduced without atomics. The
+// updates span several tiles so the tiles are merged as well.
+template <class Derived>
+struct test_scatter_sorted_base : verify_program<Derived>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape sd{migraphx::shape::float_type, {16, 4}};
+        migraphx::shape si{migraphx::shape::int32_type, {600, 4}};
+        migraphx::shape su{migraphx::shape::float_type, {600, 4}};
+        std::vector<int> vi(si.elements());
+        for(std::size_t i = 0; i < vi.size(); i++)
+            vi[i] = (i * 7 + i / 5) % 17 - 1;
+
+        auto pd              = mm->add_parameter("data", sd);
+        auto li              = mm->add_literal(migraphx::literal{si, vi});
+        auto pu              = mm->add_parameter("update", su);
+        const auto reduction = static_cast<const Derived&>(*this).reduction();
+        auto r               = mm->add_instruction(
+            migraphx::make_op("scatter_" + reduction, {{"axis", 0}}), pd, li, pu);
+        mm->add_return({r});
+
+        return p;
+    }
+};
+
+struct test_scatter_sorted_add : test_scatter_sorted_base<test_scatter_sorted_add>
+{
+    std::string reduction() const { return "add"; }
+};
+
+struct test_scatter_sorted_max : test_scatter_sorted_base<test_scatter_sorted_max>
+{
+    std::string reduction() const { return "max"; }
+};
+
+struct test_scatter_sorted_min : test_scatter_sorted_base<test_scatter_sorted_min>
+{
+    std::string reduction() const { return "min"; }
+};
+
+struct test_scatternd_sorted_add : verify_program<test_scatternd_sorted_add>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape ds{migraphx::shape::float_type, {16, 4}};
+        migraphx::shape is{migraphx::shape::int64_type, {300, 1}};
+        migraphx::shape us{migraphx::shape::float_type, {300, 4}};
+        std::vector<int64_t> ind_vec(is.elements());
+        for(std::size_t i = 0; i < ind_vec.size(); i++)
+            ind_vec[i] = (i * 5) % 16;
+
+        auto data    = mm->add_parameter("data", ds);
+        auto indices = mm->add_literal(migraphx::literal{is, ind_vec});
+        auto updates = mm->add_parameter("update", us);
+        auto scatternd =
+            mm->add_instruction(migraphx::make_op("scatternd_add"), data, indices, updates);
+        mm->add_return({scatternd});
+
+        return p;
+    }
+};
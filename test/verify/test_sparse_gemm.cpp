@@ -0,0 +1,54 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+// Dot with 2:4 sparse constant weights, which the gpu runs through hipSPARSELt when available
+template <migraphx::shape::type_t DType>
+struct test_sparse_gemm : verify_program<test_sparse_gemm<DType>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape as{DType, {2, 32, 64}};
+        migraphx::shape bs{DType, {64, 48}};
+        std::vector<float> weights(bs.elements());
+        for(std::size_t i = 0; i < weights.size(); i++)
+        {
+            auto k     = i / 48;
+            weights[i] = (k % 4) == (i % 3) or (k % 4) == 3 ? 0.125f * (i % 9) - 0.5f : 0.0f;
+        }
+        auto a = mm->add_parameter("a", as);
+        auto b = mm->add_literal(migraphx::literal{bs, weights});
+        mm->add_instruction(migraphx::make_op("dot"), a, b);
+        return p;
+    }
+    std::string section() const { return "gemm"; }
+};
+
+template struct test_sparse_gemm<migraphx::shape::half_type>;
+template struct test_sparse_gemm<migraphx::shape::bf16_type>;
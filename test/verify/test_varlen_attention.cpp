@@ -0,0 +1,54 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+template <migraphx::shape::type_t DType, bool Causal>
+struct test_varlen_attention : verify_program<test_varlen_attention<DType, Causal>>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        // Sequences of 17, 40 and 3 tokens packed together, and 4 tokens left over
+        migraphx::shape qs{DType, {64, 4, 64}};
+        migraphx::shape ks{DType, {64, 2, 64}};
+        migraphx::shape cs{migraphx::shape::int32_type, {4}};
+        std::vector<int32_t> cu_seqlens{0, 17, 57, 60};
+
+        auto query = mm->add_parameter("query", qs);
+        auto key   = mm->add_parameter("key", ks);
+        auto value = mm->add_parameter("value", ks);
+        auto cu    = mm->add_literal(migraphx::literal{cs, cu_seqlens});
+        mm->add_instruction(
+            migraphx::make_op("varlen_attention", {{"causal", Causal}}), query, key, value, cu);
+        return p;
+    }
+};
+
+template struct test_varlen_attention<migraphx::shape::float_type, false>;
+template struct test_varlen_attention<migraphx::shape::float_type, true>;
+template struct test_varlen_attention<migraphx::shape::half_type, true>;
@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/load_save.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/weight_map.hpp>
+#include "test.hpp"
+
+static migraphx::program
+create_program(const std::vector<float>& w, const std::vector<float>& b, bool relu = false)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    auto x   = mm->add_parameter("x", s);
+    auto wl  = mm->add_literal(migraphx::literal{s, w});
+    auto bl  = mm->add_literal(migraphx::literal{s, b});
+    auto mul = mm->add_instruction(migraphx::make_op("mul"), x, wl);
+    auto add = mm->add_instruction(migraphx::make_op("add"), mul, bl);
+    if(relu)
+        add = mm->add_instruction(migraphx::make_op("relu"), add);
+    mm->add_return({add});
+    return p;
+}
+
+static migraphx::program compile_program(migraphx::program p)
+{
+    migraphx::compile_options options;
+    options.record_weights = true;
+    p.compile(migraphx::make_target("ref"), options);
+    return p;
+}
+
+static std::vector<float> run(const migraphx::program& p)
+{
+    std::vector<float> x = {1, 2, 3, 4};
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{migraphx::shape{migraphx::shape::float_type, {4}}, x.data()};
+    auto result = p.eval(params).back();
+    std::vector<float> output;
+    result.visit([&](auto v) { output.assign(v.begin(), v.end()); });
+    return output;
+}
+
+TEST_CASE(same_structure)
+{
+    auto p1 = create_program({1, 1, 1, 1}, {0, 0, 0, 0});
+    auto p2 = create_program({2, 2, 2, 2}, {1, 1, 1, 1});
+    auto p3 = create_program({1, 1, 1, 1}, {0, 0, 0, 1});
+    EXPECT(migraphx::structure_fingerprint(p1) == migraphx::structure_fingerprint(p2));
+    EXPECT(migraphx::structure_fingerprint(p1) == migraphx::structure_fingerprint(p3));
+}
+
+TEST_CASE(different_structure)
+{
+    auto p1 = create_program({1, 1, 1, 1}, {0, 0, 0, 0});
+    auto p2 = create_program({1, 1, 1, 1}, {0, 0, 0, 0}, true);
+    EXPECT(migraphx::structure_fingerprint(p1) != migraphx::structure_fingerprint(p2));
+}
+
+TEST_CASE(update_weights)
+{
+    auto compiled = compile_program(create_program({1, 2, 3, 4}, {0, 1, 2, 3}));
+    EXPECT(run(compiled) == std::vector<float>{1, 5, 11, 19});
+    EXPECT(compiled.update_weights(create_program({2, 2, 2, 2}, {1, 1, 1, 1})));
+    EXPECT(run(compiled) == std::vector<float>{3, 5, 7, 9});
+    // Weights can be updated again after they have been updated
+    EXPECT(compiled.update_weights(create_program({1, 1, 1, 1}, {5, 6, 7, 8})));
+    EXPECT(run(compiled) == std::vector<float>{6, 8, 10, 12});
+}
+
+TEST_CASE(update_weights_serialized)
+{
+    auto compiled = compile_program(create_program({1, 2, 3, 4}, {0, 1, 2, 3}));
+    auto loaded   = migraphx::load_buffer(migraphx::save_buffer(compiled));
+    EXPECT(loaded.update_weights(create_program({2, 2, 2, 2}, {1, 1, 1, 1})));
+    EXPECT(run(loaded) == std::vector<float>{3, 5, 7, 9});
+}
+
+TEST_CASE(update_weights_not_recorded)
+{
+    auto p = create_program({1, 2, 3, 4}, {0, 1, 2, 3});
+    p.compile(migraphx::make_target("ref"));
+    EXPECT(not p.update_weights(create_program({2, 2, 2, 2}, {1, 1, 1, 1})));
+    EXPECT(run(p) == std::vector<float>{1, 5, 11, 19});
+}
+
+TEST_CASE(update_weights_different_structure)
+{
+    auto compiled = compile_program(create_program({1, 2, 3, 4}, {0, 1, 2, 3}));
+    EXPECT(not compiled.update_weights(create_program({2, 2, 2, 2}, {1, 1, 1, 1}, true)));
+    EXPECT(run(compiled) == std::vector<float>{1, 5, 11, 19});
+}
+
+TEST_CASE(update_weights_ambiguous)
+{
+    // Both literals have the same data so the compiled program can't tell them apart
+    auto compiled = compile_program(create_program({1, 1, 1, 1}, {1, 1, 1, 1}));
+    EXPECT(not compiled.update_weights(create_program({2, 2, 2, 2}, {1, 1, 1, 1})));
+    EXPECT(run(compiled) == std::vector<float>{2, 3, 4, 5});
+    // Unchanged weights don't need to be located
+    EXPECT(compiled.update_weights(create_program({1, 1, 1, 1}, {1, 1, 1, 1})));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -27,12 +27,14 @@
 #include <migraphx/ranges.hpp>
 #include <migraphx/shape.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/replica_runner.hpp>
 #include <migraphx/onnx.hpp>
 #include <migraphx/tf.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/quantization.hpp>
+#include <migraphx/metrics.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/register_op.hpp>
@@ -209,6 +211,47 @@ run_async(program& p, const parameter_map& params, void* s, std::string_view nam
     return p.eval(params, exec_env);
 }
 
+std::vector<argument> run_async_with_callback(program& p,
+                                              const parameter_map& params,
+                                              void* s,
+                                              std::string_view name,
+                                              migraphx_completion_callback callback,
+                                              void* data)
+{
+    execution_environment exec_env{any_ptr(s, name), true};
+    if(callback != nullptr)
+        exec_env.on_complete = [=] { callback(data); };
+    return p.eval(params, exec_env);
+}
+
+std::vector<argument> run_with_priority(program& p, const parameter_map& params, int priority)
+{
+    execution_environment exec_env;
+    exec_env.priority = priority;
+    return p.eval(params, exec_env);
+}
+
+template <class T>
+std::vector<std::vector<argument>>
+run_many(const program& p, const T* params, std::size_t size, std::size_t depth)
+{
+    return p.eval_many(to_obj_vector(params, size), depth);
+}
+
+std::size_t memory_usage(const program& p, const char* name)
+{
+    return p.memory_report().get(name, std::size_t{0});
+}
+
+replica_runner make_replica_runner(const program& p,
+                                   const std::vector<std::size_t>& device_ids,
+                                   bool queue_depth)
+{
+    return {p,
+            device_ids,
+            queue_depth ? replica_runner::queue_depth : replica_runner::round_robin};
+}
+
 template <class Value>
 std::vector<const char*> get_names(const std::unordered_map<std::string, Value>& m)
 {
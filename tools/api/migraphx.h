@@ -47,7 +47,8 @@
     m(uint64_type, uint64_t) \
     m(fp8e4m3fnuz_type, migraphx::fp8::fp8e4m3fnuz) \
     m(fp8e4m3fn_type, migraphx::fp8::fp8e4m3fn) \
-    m(fp8e5m2_type, migraphx::fp8::fp8e5m2)
+    m(fp8e5m2_type, migraphx::fp8::fp8e5m2) \
+    m(bf16_type, migraphx::bf16)
 // clang-format on
 
 #ifdef __cplusplus
@@ -73,6 +74,10 @@ typedef enum
 } migraphx_shape_datatype_t;
 #undef MIGRAPHX_SHAPE_GENERATE_ENUM_TYPES
 
+/// Called with the data passed to migraphx_program_run_async_with_callback once the outputs are
+/// ready. It runs on a thread of the runtime and should return quickly.
+typedef void (*migraphx_completion_callback)(void* data);
+
 <%
     generate_c_header()
 %>
@@ -31,6 +31,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <migraphx/instruction_ref.hpp>
 #include <migraphx/operation.hpp>
 #include <migraphx/op/concat.hpp>
 #include <migraphx/optional.hpp>
@@ -48,16 +49,34 @@ struct concat_optimization
     std::string allocate() const;
     /// Return the target-independent concat operator
     optional<op::concat> get_concat(const operation& op) const;
+    /// Whether the instruction can write its output into a strided view of the concat buffer,
+    /// which is needed to concat along an axis that is not the outermost
+    bool supports_strided_output(instruction_ref ins) const;
 };
 
 #else
 
+namespace detail {
+
+template <class T>
+bool concat_opt_supports_strided_output(const T&, instruction_ref)
+{
+    return false;
+}
+
+} // namespace detail
+
 <%
     interface(
         'concat_optimization',
         virtual('allocate', returns = 'std::string', const = True),
         virtual(
-            'get_concat', returns = 'optional<op::concat>', op = 'const operation&', const = True))
+            'get_concat', returns = 'optional<op::concat>', op = 'const operation&', const = True),
+        virtual('supports_strided_output',
+                returns = 'bool',
+                ins     = 'instruction_ref',
+                const   = True,
+                default = 'migraphx::detail::concat_opt_supports_strided_output'))
 %>
 
 #endif
@@ -50,6 +50,8 @@ struct context
 
 #else
 
+struct context;
+
 template <class T>
 value to_value_context(const T&)
 {
@@ -75,6 +77,30 @@ void wait_for_context(T&, any_ptr)
 template <class T>
 void finish_on_context(T&, any_ptr){}
 
+template <class T>
+void on_finish_context(T& ctx, any_ptr, std::function<void()> callback)
+{
+    ctx.finish();
+    callback();
+}
+
+template <class T>
+void set_priority_context(T&, int)
+{
+}
+
+template <class T>
+value memory_usage_context(const T&)
+{
+    return value::object{};
+}
+
+template <class T>
+context create_session_context(const T& x);
+
+template <class T>
+context create_replica_context(const T& x, std::size_t);
+
 <%
  interface('context',
            virtual('to_value', returns = 'value', const = True, default = 'to_value_context'),
@@ -82,8 +108,25 @@ void finish_on_context(T&, any_ptr){}
            virtual('get_queue', returns = 'any_ptr', default = 'get_queue_context'),
            virtual('wait_for', queue = 'any_ptr', returns = 'void', default = 'wait_for_context'),
            virtual('finish_on', queue = 'any_ptr', returns = 'void', default = 'finish_on_context'),
+           virtual('on_finish', queue = 'any_ptr', callback = 'std::function<void()>', returns = 'void', default = 'on_finish_context'),
+           virtual('set_priority', priority = 'int', returns = 'void', default = 'set_priority_context'),
+           virtual('memory_usage', returns = 'value', const = True, default = 'memory_usage_context'),
+           virtual('create_session', returns = 'context', const = True, default = 'create_session_context'),
+           virtual('create_replica', device_id = 'std::size_t', returns = 'context', const = True, default = 'create_replica_context'),
            virtual('finish', returns = 'void', const = True)) %>
 
+template <class T>
+context create_session_context(const T& x)
+{
+    return x;
+}
+
+template <class T>
+context create_replica_context(const T& x, std::size_t)
+{
+    return x;
+}
+
     inline void migraphx_to_value(value& v, const context& ctx)
 {
     v = ctx.to_value();
@@ -82,6 +82,9 @@ struct operation
     /// An optional method to return which argument the output will alias. If
     /// there is no aliased output then -1 can be returned.
     std::ptrdiff_t output_alias(const std::vector<shape>& input) const;
+    /// An optional estimate of the arithmetic operations done for these inputs, used to report
+    /// the achieved flops. Pointwise and reduce operators count one per element by default.
+    std::size_t flops(const std::vector<shape>& input) const;
     /// An optional stream operator to print the operation. When this is not
     /// implemented, it will just print the operation's name.
     friend std::ostream& operator<<(std::ostream& os, const operation& op);
@@ -474,6 +477,30 @@ value attributes_op(const T&)
     return value::object{};
 }
 
+template <class T>
+auto flops_attributes(rank<1>, const T& x) -> decltype(x.attributes())
+{
+    return x.attributes();
+}
+
+template <class T>
+value flops_attributes(rank<0>, const T&)
+{
+    return value::object{};
+}
+
+template <class T>
+std::size_t flops_op(const T& x, const std::vector<shape>& inputs)
+{
+    auto attr = flops_attributes(rank<1>{}, x);
+    if(not attr.contains("pointwise") and not attr.contains("reduce"))
+        return 0;
+    std::size_t n = 0;
+    for(const auto& s : inputs)
+        n = std::max(n, s.elements());
+    return n;
+}
+
 template <class T>
 value to_value_op(const T& x)
 {
@@ -573,6 +600,11 @@ lifetime get_lifetime_op(const T&)
      virtual('to_value', returns = 'value', const = True, default = 'detail::to_value_op'),
      virtual('from_value', v = 'const value&', default = 'detail::from_value_op'),
      virtual('attributes', returns = 'value', const = True, default = 'detail::attributes_op'),
+     virtual('flops',
+             returns = 'std::size_t',
+             input   = 'const std::vector<shape>&',
+             const   = True,
+             default = 'detail::flops_op'),
      friend('operator<<',
             returns = 'std::ostream &',
             os      = 'std::ostream &',
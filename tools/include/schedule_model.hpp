@@ -40,6 +40,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 struct module;
 struct operation;
+struct shape;
 
 #ifdef DOXYGEN
 
@@ -54,8 +55,8 @@ struct schedule_model
     void wait(module& m, instruction_ref ins, std::size_t wait_id) const;
     // Insert necessary records after an instruction
     void record(module& m, instruction_ref ins, std::size_t wait_id) const;
-    /// Compute weights for an operation
-    std::size_t weight(const operation& op) const;
+    /// Compute weights for an operation given the shapes of its inputs
+    std::size_t weight(const operation& op, const std::vector<shape>& inputs) const;
 };
 
 #else
@@ -66,7 +67,11 @@ interface('schedule_model',
     virtual('sched', m='module&', ins='instruction_ref', n='std::size_t', const=True),
     virtual('wait', m='module&', ins='instruction_ref', wait_id='std::size_t', const=True),
     virtual('record', m='module&', ins='instruction_ref', wait_id='std::size_t', const=True),
-    virtual('weight', returns='std::size_t', op='const operation&', const=True)
+    virtual('weight',
+            returns='std::size_t',
+            op='const operation&',
+            inputs='const std::vector<shape>&',
+            const=True)
 )
 %>
 
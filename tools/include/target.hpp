@@ -95,6 +95,14 @@ struct target
      * @return Allocated argument in the target.
      */
     argument allocate(const shape& s) const;
+    /**
+     * @brief Allocate a host argument that the target can transfer from asynchronously
+     *
+     * @param s Shape of the argument to be allocated on the host
+     * @return Allocated argument in page-locked host memory, or pageable host memory when the
+     * target has no pinned allocator.
+     */
+    argument allocate_pinned(const shape& s) const;
 };
 
 #else
@@ -106,6 +114,12 @@ argument target_allocate(T& x, const shape&)
     MIGRAPHX_THROW("Not computable: " + name);
 }
 
+template <class T>
+argument target_allocate_pinned(T&, const shape& s)
+{
+    return argument{s};
+}
+
 template <class T>
 argument copy_to_target(T&, const argument& arg)
 {
@@ -153,7 +167,12 @@ supported_segments target_find_supported(T&, const_module_ref, support_metric)
                    s       = 'const shape&',
                    returns = 'argument',
                    const   = True,
-                   default = 'target_allocate')) %>
+                   default = 'target_allocate'),
+           virtual('allocate_pinned',
+                   s       = 'const shape&',
+                   returns = 'argument',
+                   const   = True,
+                   default = 'target_allocate_pinned')) %>
 
 #endif
 